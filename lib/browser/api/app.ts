@@ -1,7 +1,7 @@
 import * as fs from 'fs'
 import * as path from 'path'
 
-import { deprecate, Menu } from 'electron'
+import { deprecate, Menu, webContents } from 'electron'
 import { EventEmitter } from 'events'
 
 const bindings = process.electronBinding('app')
@@ -18,6 +18,7 @@ Object.setPrototypeOf(App.prototype, EventEmitter.prototype)
 EventEmitter.call(app as any)
 
 Object.assign(app, {
+  getStartupTimeline: () => process.getStartupTimeline(),
   commandLine: {
     hasSwitch: (theSwitch: string) => commandLine.hasSwitch(String(theSwitch)),
     getSwitchValue: (theSwitch: string) => commandLine.getSwitchValue(String(theSwitch)),
@@ -104,6 +105,47 @@ if (process.platform === 'linux') {
   }
 }
 
+app.purgeMemory = (level) => {
+  if (level !== 'moderate' && level !== 'critical') {
+    throw new TypeError('level must be \'moderate\' or \'critical\'')
+  }
+  app._purgeMemory(level)
+  // Renderers are notified once per process, through any of their frames.
+  let notified: number[] = []
+  for (const contents of webContents.getAllWebContents()) {
+    notified = contents._notifyMemoryPressure(level, notified)
+  }
+}
+
+// The state handed off to the relaunched app is kept in one file of the
+// userData directory, which the relaunched app reads and removes.
+const getHandoffPath = () => path.join(app.getPath('userData'), 'Relaunch Handoff')
+
+const nativeRelaunch = app.relaunch
+app.relaunch = (options?: Electron.RelaunchOptions) => {
+  if (!options || options.handoff === undefined) {
+    return nativeRelaunch.call(app, options)
+  }
+  fs.writeFileSync(getHandoffPath(), JSON.stringify(options.handoff))
+  return nativeRelaunch.call(app, { ...options, _handoff: true } as Electron.RelaunchOptions)
+}
+
+let relaunchHandoff: any
+app.getRelaunchHandoff = () => {
+  if (relaunchHandoff !== undefined) return relaunchHandoff
+  relaunchHandoff = null
+  if (commandLine.hasSwitch('relaunch-handoff')) {
+    const handoffPath = getHandoffPath()
+    try {
+      relaunchHandoff = JSON.parse(fs.readFileSync(handoffPath, 'utf8'))
+      fs.unlinkSync(handoffPath)
+    } catch {
+      // The handoff was already read by another instance.
+    }
+  }
+  return relaunchHandoff
+}
+
 // Routes the events to webContents.
 const events = ['certificate-error', 'select-client-certificate']
 for (const name of events) {
@@ -50,15 +50,28 @@ class AutoUpdater extends EventEmitter {
       }
       this.updateAvailable = true
       this.emit('update-available')
+      const updateStarted = Date.now()
       squirrelUpdate.update(this.updateURL, (error) => {
         if (error != null) {
           return this.emitError(error)
         }
         const { releaseNotes, version } = update
-        // Date is not available on Windows, so fake it.
-        const date = new Date()
-        this.emit('update-downloaded', {}, releaseNotes, version, date, this.updateURL, () => {
-          this.quitAndInstall()
+        const emitDownloaded = () => {
+          // Date is not available on Windows, so fake it.
+          const date = new Date()
+          this.emit('update-downloaded', {}, releaseNotes, version, date, this.updateURL, () => {
+            this.quitAndInstall()
+          })
+        }
+        if (this.listenerCount('update-delta-downloaded') === 0) {
+          return emitDownloaded()
+        }
+        squirrelUpdate.getDeltaStats(version, updateStarted, (error, stats) => {
+          // The stats are informative, and never fail the update.
+          if (error == null && stats != null) {
+            this.emit('update-delta-downloaded', {}, stats)
+          }
+          emitDownloaded()
         })
       })
     })
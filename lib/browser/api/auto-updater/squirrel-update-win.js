@@ -9,6 +9,9 @@ const appFolder = path.dirname(process.execPath)
 
 // i.e. my-app/Update.exe
 const updateExe = path.resolve(appFolder, '..', 'Update.exe')
+
+// i.e. my-app/packages/
+const packagesFolder = path.resolve(appFolder, '..', 'packages')
 const exeName = path.basename(process.execPath)
 let spawnedArgs = []
 let spawnedProcess
@@ -108,6 +111,38 @@ exports.update = function (updateURL, callback) {
   return spawnUpdate(['--update', updateURL], false, callback)
 }
 
+// Measure the packages an update written since |since| downloaded. Squirrel
+// downloads the delta packages listed in RELEASES when it can apply them, and
+// builds the full package of |version| from them, which it would download
+// otherwise.
+exports.getDeltaStats = function (version, since, callback) {
+  fs.readdir(packagesFolder, (error, names) => {
+    if (error != null) return callback(error)
+
+    let deltaBytes = 0
+    let fullBytes = 0
+    try {
+      for (const name of names) {
+        const stats = fs.statSync(path.join(packagesFolder, name))
+        if (name.endsWith('-delta.nupkg') && stats.mtimeMs >= since) {
+          deltaBytes += stats.size
+        } else if (name.endsWith(`-${version}-full.nupkg`)) {
+          fullBytes = stats.size
+        }
+      }
+    } catch (error) {
+      return callback(error)
+    }
+
+    if (deltaBytes === 0 || fullBytes === 0) return callback(null, null)
+    callback(null, {
+      deltaBytes,
+      fullBytes,
+      bytesSaved: Math.max(fullBytes - deltaBytes, 0)
+    })
+  })
+}
+
 // Is the Update.exe installed with the current application?
 exports.supported = function () {
   try {
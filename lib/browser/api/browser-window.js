@@ -1,8 +1,10 @@
 'use strict'
 
+const { EventEmitter } = require('events')
 const electron = require('electron')
 const { WebContentsView, TopLevelWindow, deprecate } = electron
 const { BrowserWindow } = process.electronBinding('window')
+const { createVersionedCache } = require('@electron/internal/browser/versioned-cache')
 
 Object.setPrototypeOf(BrowserWindow.prototype, TopLevelWindow.prototype)
 
@@ -81,6 +83,18 @@ BrowserWindow.prototype._init = function () {
     this.on(event, visibilityChanged)
   }
 
+  // A discarded page is reloaded once the user gets back to its window.
+  const restoreDiscarded = () => {
+    clearTimeout(this._discardTimer)
+    this._discardTimer = null
+    if (this.webContents.isDiscarded()) this.webContents.restore()
+  }
+  this.on('show', restoreDiscarded)
+  this.on('focus', restoreDiscarded)
+  this.on('blur', () => this._scheduleDiscard())
+  this.on('hide', () => this._scheduleDiscard())
+  this.once('closed', () => clearTimeout(this._discardTimer))
+
   // Notify the creation of the window.
   const event = process.electronBinding('event').createEmpty()
   app.emit('browser-window-created', event, this)
@@ -103,19 +117,23 @@ BrowserWindow.fromId = (id) => {
   return isBrowserWindow(win) ? win : null
 }
 
+const getAllBrowserWindows = createVersionedCache(TopLevelWindow._getAllVersion, () => {
+  return TopLevelWindow._getAllCached().filter(isBrowserWindow)
+})
+
 BrowserWindow.getAllWindows = () => {
-  return TopLevelWindow.getAllWindows().filter(isBrowserWindow)
+  return getAllBrowserWindows().slice()
 }
 
 BrowserWindow.getFocusedWindow = () => {
-  for (const window of BrowserWindow.getAllWindows()) {
+  for (const window of getAllBrowserWindows()) {
     if (window.isFocused() || window.isDevToolsFocused()) return window
   }
   return null
 }
 
 BrowserWindow.fromWebContents = (webContents) => {
-  for (const window of BrowserWindow.getAllWindows()) {
+  for (const window of getAllBrowserWindows()) {
     if (window.webContents && window.webContents.equal(webContents)) return window
   }
 
@@ -123,13 +141,174 @@ BrowserWindow.fromWebContents = (webContents) => {
 }
 
 BrowserWindow.fromBrowserView = (browserView) => {
-  for (const window of BrowserWindow.getAllWindows()) {
+  for (const window of getAllBrowserWindows()) {
     if (window.getBrowserView() === browserView) return window
   }
 
   return null
 }
 
+BrowserWindow.prototype.setDiscardPolicy = function (policy) {
+  if (policy !== null) {
+    const { timeout, minFreeMemory } = policy
+    if (!Number.isInteger(timeout) || timeout <= 0) {
+      throw new TypeError('timeout must be a positive integer')
+    }
+    if (minFreeMemory !== undefined && !(minFreeMemory > 0)) {
+      throw new TypeError('minFreeMemory must be a positive number')
+    }
+  }
+  this._discardPolicy = policy
+  clearTimeout(this._discardTimer)
+  this._discardTimer = null
+  if (!this.isFocused()) this._scheduleDiscard()
+}
+
+BrowserWindow.prototype._scheduleDiscard = function () {
+  const policy = this._discardPolicy
+  if (!policy || this._discardTimer) return
+  this._discardTimer = setTimeout(() => {
+    this._discardTimer = null
+    if (this.isDestroyed() || this.isFocused()) return
+    if (policy.minFreeMemory !== undefined &&
+        process.getSystemMemoryInfo().free >= policy.minFreeMemory) {
+      // Checks again later, the memory may have run low by then.
+      this._scheduleDiscard()
+      return
+    }
+    this.webContents.discard()
+  }, policy.timeout)
+}
+
+// Keeps hidden windows with their renderer started and preload run on an
+// about:blank document, so that a window can be shown without waiting for
+// them.
+class BrowserWindowPool extends EventEmitter {
+  constructor (options) {
+    super()
+    const { size = 1, windowOptions = {}, maxMemory, refillDelay = 1000 } = options
+    if (!Number.isInteger(size) || size < 0) {
+      throw new TypeError('size must be a non-negative integer')
+    }
+    if (maxMemory !== undefined && !(maxMemory > 0)) {
+      throw new TypeError('maxMemory must be a positive number')
+    }
+    this.size = size
+    this._windowOptions = { ...windowOptions, show: false }
+    this._maxMemory = maxMemory
+    this._refillDelay = refillDelay
+    this._windows = []
+    this._filling = false
+    this._loading = false
+    this._destroyed = false
+    this._refillTimer = null
+
+    // The hidden windows must not keep the app running once the other windows
+    // are closed.
+    const { app } = electron
+    this._onWindowClosed = () => {
+      if (BrowserWindow.getAllWindows().every(win => this._windows.includes(win))) {
+        this.destroy()
+      }
+    }
+    this._onWindowCreated = (event, win) => {
+      if (!this._filling) win.once('closed', this._onWindowClosed)
+    }
+    app.on('browser-window-created', this._onWindowCreated)
+    for (const win of BrowserWindow.getAllWindows()) {
+      win.once('closed', this._onWindowClosed)
+    }
+    this._scheduleRefill(0)
+  }
+
+  // Returns a prewarmed window, or a new one when none is ready.
+  acquire () {
+    if (this._destroyed) throw new Error('The pool has been destroyed')
+    const index = this._windows.findIndex(win => win._poolReady)
+    let win
+    if (index === -1) {
+      win = new BrowserWindow(this._windowOptions)
+    } else {
+      win = this._windows.splice(index, 1)[0]
+      win.removeListener('closed', win._poolRemove)
+      win.webContents.removeListener('crashed', win._poolRemove)
+      delete win._poolReady
+      delete win._poolRemove
+      win.once('closed', this._onWindowClosed)
+    }
+    this._scheduleRefill(this._refillDelay)
+    return win
+  }
+
+  get readyCount () {
+    return this._windows.filter(win => win._poolReady).length
+  }
+
+  destroy () {
+    if (this._destroyed) return
+    this._destroyed = true
+    clearTimeout(this._refillTimer)
+    electron.app.removeListener('browser-window-created', this._onWindowCreated)
+    const windows = this._windows
+    this._windows = []
+    for (const win of windows) {
+      if (!win.isDestroyed()) win.destroy()
+    }
+  }
+
+  _scheduleRefill (delay) {
+    if (this._destroyed || this._refillTimer) return
+    this._refillTimer = setTimeout(() => {
+      this._refillTimer = null
+      this._refill()
+    }, delay)
+  }
+
+  async _refill () {
+    if (this._destroyed || this._loading || this._windows.length >= this.size) return
+    if (this._maxMemory !== undefined && this._getMemoryUsage() >= this._maxMemory) return
+
+    this._filling = true
+    const win = new BrowserWindow(this._windowOptions)
+    this._filling = false
+    this._windows.push(win)
+    const remove = () => {
+      const index = this._windows.indexOf(win)
+      if (index !== -1) this._windows.splice(index, 1)
+      if (!win.isDestroyed()) win.destroy()
+    }
+    win._poolRemove = remove
+    win.once('closed', remove)
+    win.webContents.once('crashed', remove)
+    this._loading = true
+    try {
+      await win.loadURL('about:blank')
+    } catch {
+      remove()
+      return
+    } finally {
+      this._loading = false
+    }
+    if (!this._windows.includes(win)) return
+    win._poolReady = true
+    this.emit('window-ready', process.electronBinding('event').createEmpty(), win)
+    // One window at a time, so the refill does not compete with the app.
+    this._scheduleRefill(this._refillDelay)
+  }
+
+  // The memory used by the renderers of the pooled windows, in Kilobytes.
+  _getMemoryUsage () {
+    const pids = new Set(this._windows.map(win => win.webContents.getOSProcessId()))
+    return electron.app.getAppMetrics()
+      .filter(metric => pids.has(metric.pid))
+      .reduce((total, metric) => total + metric.memory.workingSetSize, 0)
+  }
+}
+
+BrowserWindow.createPool = (options = {}) => {
+  return new BrowserWindowPool(options)
+}
+
 // Helpers.
 Object.assign(BrowserWindow.prototype, {
   loadURL (...args) {
@@ -1,12 +1,23 @@
 'use strict'
 
 const CrashReporter = require('@electron/internal/common/crash-reporter')
-const { crashReporterInit } = require('@electron/internal/browser/crash-reporter-init')
+const { crashReporterInit, setDeferUploads } = require('@electron/internal/browser/crash-reporter-init')
 
 class CrashReporterMain extends CrashReporter {
   init (options) {
+    // Only the Linux reporter leaves the uploads to the main process.
+    setDeferUploads(options.deferUploads && process.platform === 'linux')
     return crashReporterInit(options)
   }
+
+  start (options) {
+    super.start(options)
+    const { deferUploads, submitURL, compress = false } = options || {}
+    if (deferUploads && process.platform === 'linux') {
+      const { scheduleUploads } = require('@electron/internal/browser/crash-report-uploader')
+      scheduleUploads({ submitURL, crashesDirectory: this.crashesDirectory, compress: Boolean(compress) })
+    }
+  }
 }
 
 module.exports = new CrashReporterMain()
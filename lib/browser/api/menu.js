@@ -8,6 +8,7 @@ const bindings = process.electronBinding('menu')
 
 const { Menu } = bindings
 let applicationMenu = null
+let applicationMenuRefreshPending = false
 let groupIdIndex = 0
 
 Object.setPrototypeOf(Menu.prototype, EventEmitter.prototype)
@@ -152,15 +153,33 @@ Menu.setApplicationMenu = function (menu) {
     throw new TypeError('Invalid menu')
   }
 
+  const isRefresh = menu != null && menu === applicationMenu
   applicationMenu = menu
   v8Util.setHiddenValue(global, 'applicationMenuSet', true)
 
+  // Apps set the same menu again after changing its items, often many times
+  // in a row, so those updates are applied once per task.
+  if (isRefresh) {
+    if (!applicationMenuRefreshPending) {
+      applicationMenuRefreshPending = true
+      process.nextTick(() => {
+        applicationMenuRefreshPending = false
+        if (applicationMenu === menu) applyApplicationMenu(menu)
+      })
+    }
+    return
+  }
+
+  return applyApplicationMenu(menu)
+}
+
+const applyApplicationMenu = function (menu) {
   if (process.platform === 'darwin') {
     if (!menu) return
     menu._callMenuWillShow()
     bindings.setApplicationMenu(menu)
   } else {
-    const windows = TopLevelWindow.getAllWindows()
+    const windows = TopLevelWindow._getAllCached()
     return windows.map(w => w.setMenu(menu))
   }
 }
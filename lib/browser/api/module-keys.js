@@ -30,13 +30,15 @@ module.exports = [
   { name: 'protocol' },
   { name: 'screen' },
   { name: 'session' },
+  { name: 'sharedMemory' },
   { name: 'systemPreferences' },
   { name: 'TopLevelWindow' },
   { name: 'TouchBar' },
   { name: 'Tray' },
   { name: 'View' },
   { name: 'webContents' },
-  { name: 'WebContentsView' }
+  { name: 'WebContentsView' },
+  { name: 'workerPool' }
 ]
 
 if (features.isViewApiEnabled()) {
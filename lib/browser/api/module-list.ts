@@ -25,13 +25,15 @@ export const browserModuleList: ElectronInternal.ModuleEntry[] = [
   { name: 'protocol', loader: () => require('./protocol') },
   { name: 'screen', loader: () => require('./screen') },
   { name: 'session', loader: () => require('./session') },
+  { name: 'sharedMemory', loader: () => require('./shared-memory') },
   { name: 'systemPreferences', loader: () => require('./system-preferences') },
   { name: 'TopLevelWindow', loader: () => require('./top-level-window') },
   { name: 'TouchBar', loader: () => require('./touch-bar') },
   { name: 'Tray', loader: () => require('./tray') },
   { name: 'View', loader: () => require('./view') },
   { name: 'webContents', loader: () => require('./web-contents') },
-  { name: 'WebContentsView', loader: () => require('./web-contents-view') }
+  { name: 'WebContentsView', loader: () => require('./web-contents-view') },
+  { name: 'workerPool', loader: () => require('./worker-pool') }
 ]
 
 if (features.isViewApiEnabled()) {
@@ -4,7 +4,8 @@ const url = require('url')
 const { EventEmitter } = require('events')
 const { Readable, Writable } = require('stream')
 const { app } = require('electron')
-const { Session } = process.electronBinding('session')
+const { Session, fromPartition } = process.electronBinding('session')
+const backgroundRequests = require('@electron/internal/browser/background-requests')
 const { net, Net, _isValidHeaderName, _isValidHeaderValue } = process.electronBinding('net')
 const { URLLoader } = net
 
@@ -12,6 +13,14 @@ Object.setPrototypeOf(URLLoader.prototype, EventEmitter.prototype)
 
 const kSupportedProtocols = new Set(['http:', 'https:'])
 
+const kPriorities = new Set(['throttled', 'idle', 'lowest', 'low', 'medium', 'highest'])
+
+const validatePriority = (priority) => {
+  if (!kPriorities.has(priority)) {
+    throw new TypeError(`priority should be one of ${[...kPriorities].join(', ')}`)
+  }
+}
+
 // set of headers that Node.js discards duplicates for
 // see https://nodejs.org/api/http.html#http_message_headers
 const discardableDuplicateHeaders = new Set([
@@ -92,6 +101,10 @@ class IncomingMessage extends Readable {
     return this._responseHead.httpVersion.minor
   }
 
+  get metrics () {
+    return this._metrics
+  }
+
   get rawTrailers () {
     throw new Error('HTTP trailers are not supported')
   }
@@ -230,12 +243,42 @@ function parseOptions (options) {
     throw new TypeError('headers must be an object')
   }
 
+  if (options.isBackground != null && typeof options.isBackground !== 'boolean') {
+    throw new TypeError('`isBackground` should be a boolean')
+  }
+  const isBackground = !!options.isBackground
+
   const urlLoaderOptions = {
     method: method,
     url: urlStr,
     redirectPolicy,
+    isBackground,
     extraHeaders: options.headers || {}
   }
+  if (options.priority != null) {
+    validatePriority(options.priority)
+    urlLoaderOptions.priority = options.priority
+  } else if (isBackground) {
+    urlLoaderOptions.priority = 'throttled'
+  }
+  if (options.uploadFile != null) {
+    if (typeof options.uploadFile !== 'object' || typeof options.uploadFile.path !== 'string') {
+      throw new TypeError('`uploadFile` should be an object with a path')
+    }
+    urlLoaderOptions.uploadFile = options.uploadFile
+  }
+  if (options.downloadPath != null) {
+    if (typeof options.downloadPath !== 'string') {
+      throw new TypeError('`downloadPath` should be a string')
+    }
+    urlLoaderOptions.downloadPath = options.downloadPath
+  }
+  if (options.progressInterval != null) {
+    if (typeof options.progressInterval !== 'number' || options.progressInterval < 0) {
+      throw new TypeError('`progressInterval` should be a non-negative number')
+    }
+    urlLoaderOptions.progressInterval = options.progressInterval
+  }
   for (const [name, value] of Object.entries(urlLoaderOptions.extraHeaders)) {
     if (!_isValidHeaderName(name)) {
       throw new Error(`Invalid header name: '${name}'`)
@@ -272,9 +315,10 @@ class ClientRequest extends Writable {
       this.once('response', callback)
     }
 
-    const { redirectPolicy, ...urlLoaderOptions } = parseOptions(options)
+    const { redirectPolicy, isBackground, ...urlLoaderOptions } = parseOptions(options)
     this._urlLoaderOptions = urlLoaderOptions
     this._redirectPolicy = redirectPolicy
+    this._isBackground = isBackground
     this._started = false
   }
 
@@ -338,6 +382,10 @@ class ClientRequest extends Writable {
   }
 
   _write (chunk, encoding, callback) {
+    if (this._urlLoaderOptions.uploadFile) {
+      callback(new Error('Can\'t write a body to a request uploading a file'))
+      return
+    }
     this._firstWrite = true
     if (!this._body) {
       this._body = new SlurpStream()
@@ -361,8 +409,25 @@ class ClientRequest extends Writable {
     }
   }
 
+  setPriority (priority) {
+    validatePriority(priority)
+    this._urlLoaderOptions.priority = priority
+    if (this._urlLoader) this._urlLoader.setPriority(priority)
+  }
+
   _startRequest () {
     this._started = true
+    if (!this._isBackground) {
+      this._startURLLoader()
+      return
+    }
+    const { session, partition } = this._urlLoaderOptions
+    this._backgroundRequestDone = backgroundRequests.startBackgroundRequest(
+      session || fromPartition(partition || ''), () => this._startURLLoader(),
+      (error) => this._die(error))
+  }
+
+  _startURLLoader () {
     const stringifyValues = (obj) => {
       const ret = {}
       for (const k in obj) {
@@ -379,8 +444,12 @@ class ClientRequest extends Writable {
     this._urlLoader.on('data', (event, data) => {
       this._response._storeInternalData(Buffer.from(data))
     })
-    this._urlLoader.on('complete', () => {
-      if (this._response) { this._response._storeInternalData(null) }
+    this._urlLoader.on('complete', (event, metrics) => {
+      this._finishBackground()
+      if (this._response) {
+        this._response._metrics = metrics
+        this._response._storeInternalData(null)
+      }
     })
     this._urlLoader.on('error', (event, netErrorString) => {
       const error = new Error(netErrorString)
@@ -454,7 +523,12 @@ class ClientRequest extends Writable {
     this._die()
   }
 
+  _finishBackground () {
+    if (this._backgroundRequestDone) this._backgroundRequestDone()
+  }
+
   _die (err) {
+    this._finishBackground()
     this.destroy(err)
     if (this._urlLoader) {
       this._urlLoader.cancel()
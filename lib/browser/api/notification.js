@@ -1,10 +1,11 @@
 'use strict'
 
 const { EventEmitter } = require('events')
-const { Notification, isSupported } = process.electronBinding('notification')
+const { Notification, isSupported, setMaxRate } = process.electronBinding('notification')
 
 Object.setPrototypeOf(Notification.prototype, EventEmitter.prototype)
 
 Notification.isSupported = isSupported
+Notification.setMaxRate = setMaxRate
 
 module.exports = Notification
@@ -1,8 +1,11 @@
 'use strict'
 
 const { EventEmitter } = require('events')
+const { Readable } = require('stream')
 const { app, deprecate } = require('electron')
 const { fromPartition, Session, Cookies, NetLog, Protocol } = process.electronBinding('session')
+const preloadCodeCache = require('@electron/internal/browser/preload-code-cache')
+const backgroundRequests = require('@electron/internal/browser/background-requests')
 
 // Public API.
 Object.defineProperties(exports, {
@@ -23,6 +26,160 @@ Session.prototype._init = function () {
   app.emit('session-created', this)
 }
 
+Session.prototype.broadcast = function (channel, ...args) {
+  const { webContents } = require('electron')
+  const contentsList = webContents.getAllWebContents()
+    .filter(contents => contents.session === this)
+  return webContents._broadcast(contentsList, channel, args)
+}
+
+Session.prototype.setPreloadBundle = function (source) {
+  if (source !== null && typeof source !== 'string') {
+    throw new TypeError('source must be a string or null')
+  }
+  preloadCodeCache.setPreloadBundle(this, source)
+}
+
+Session.prototype.getPreloadBundle = function () {
+  const bundle = preloadCodeCache.getPreloadBundle(this)
+  return bundle ? bundle.source : null
+}
+
+Session.prototype.setMaxBackgroundRequests = function (limit) {
+  if (!Number.isSafeInteger(limit) || limit < 1) {
+    throw new TypeError('limit must be a positive integer')
+  }
+  backgroundRequests.setMaxBackgroundRequests(this, limit)
+}
+
+Session.prototype.getMaxBackgroundRequests = function () {
+  return backgroundRequests.getMaxBackgroundRequests(this)
+}
+
+const isNonNegativeInteger = (value) => Number.isSafeInteger(value) && value >= 0
+
+const createBlobReader = function (session, identifier, options) {
+  const { offset = 0, length } = options
+  if (!isNonNegativeInteger(offset)) {
+    throw new TypeError('offset must be a non-negative integer')
+  }
+  if (length !== undefined && !isNonNegativeInteger(length)) {
+    throw new TypeError('length must be a non-negative integer')
+  }
+  return session._createBlobReader(identifier, offset, length)
+}
+
+// The chunks are read natively, at most 4GB at a time.
+const kMaxChunkSize = 0xFFFFFFFF
+
+const _originalGetBlobData = Session.prototype.getBlobData
+Session.prototype.getBlobData = async function (identifier, options) {
+  if (options == null) return _originalGetBlobData.call(this, identifier)
+
+  const reader = createBlobReader(this, identifier, options)
+  const chunks = []
+  let remaining = options.length === undefined ? Infinity : options.length
+  while (remaining > 0) {
+    const chunk = await reader.read(Math.min(remaining, kMaxChunkSize))
+    if (chunk === null) break
+    chunks.push(chunk)
+    remaining -= chunk.length
+  }
+  reader.cancel()
+  return Buffer.concat(chunks)
+}
+
+Session.prototype.createBlobDataStream = function (identifier, options = {}) {
+  const { chunkSize = 64 * 1024 } = options
+  if (!Number.isSafeInteger(chunkSize) || chunkSize <= 0 || chunkSize > kMaxChunkSize) {
+    throw new TypeError('chunkSize must be a positive integer')
+  }
+
+  const reader = createBlobReader(this, identifier, options)
+  const stream = new Readable({
+    highWaterMark: chunkSize,
+    read () {
+      reader.read(chunkSize).then((chunk) => {
+        if (!stream.destroyed) stream.push(chunk)
+      }, (error) => {
+        stream.destroy(error)
+      })
+    },
+    destroy (error, callback) {
+      reader.cancel()
+      callback(error)
+    }
+  })
+  return stream
+}
+
+// The storage types cleared one at a time by an incremental clearStorageData().
+const kStorageTypes = [
+  'appcache', 'cookies', 'filesystem', 'indexdb', 'localstorage', 'shadercache',
+  'websql', 'serviceworkers', 'cachestorage'
+]
+
+// Resolves once none of the WebContents using |session| is loading.
+const waitForIdle = function (session) {
+  const { webContents } = require('electron')
+  const busy = webContents.getAllWebContents()
+    .filter(contents => contents.session === session && contents.isLoading())
+  if (busy.length === 0) return Promise.resolve()
+  return Promise.all(busy.map(contents => new Promise((resolve) => {
+    const done = () => {
+      contents.removeListener('did-stop-loading', done)
+      contents.removeListener('destroyed', done)
+      resolve()
+    }
+    contents.once('did-stop-loading', done)
+    contents.once('destroyed', done)
+  }))).then(() => waitForIdle(session))
+}
+
+Session.prototype.getRendererProcesses = function () {
+  const { webContents } = require('electron')
+  const processes = new Map()
+  for (const contents of webContents.getAllWebContents()) {
+    if (contents.session !== this || contents.isDestroyed()) continue
+    const pid = contents.getOSProcessId()
+    if (!processes.has(pid)) processes.set(pid, [])
+    processes.get(pid).push(contents.id)
+  }
+  return Array.from(processes, ([pid, webContentsIds]) => ({ pid, webContentsIds }))
+}
+
+const _originalClearStorageData = Session.prototype.clearStorageData
+Session.prototype.clearStorageData = async function (options = {}) {
+  const { origins, incremental = false, whenIdle = false, onProgress } = options
+  if (origins === undefined && !incremental && !whenIdle && !onProgress) {
+    return _originalClearStorageData.call(this, options)
+  }
+  if (origins !== undefined &&
+      (!Array.isArray(origins) || !origins.every(origin => typeof origin === 'string'))) {
+    throw new TypeError('origins must be an array of strings')
+  }
+  if (onProgress !== undefined && typeof onProgress !== 'function') {
+    throw new TypeError('onProgress must be a function')
+  }
+
+  // Each step clears a single origin, and a single storage type when it is
+  // incremental, so that no pass holds the disk for long.
+  const originSteps = origins || [options.origin]
+  const storageSteps = incremental
+    ? (options.storages || kStorageTypes).map(storage => [storage])
+    : [options.storages]
+  const total = originSteps.length * storageSteps.length
+  let completed = 0
+  for (const origin of originSteps) {
+    for (const storages of storageSteps) {
+      if (whenIdle) await waitForIdle(this)
+      await _originalClearStorageData.call(this, { origin, storages, quotas: options.quotas })
+      completed++
+      if (onProgress) onProgress({ completed, total, origin, storages })
+    }
+  }
+}
+
 const _originalStartLogging = NetLog.prototype.startLogging
 NetLog.prototype.startLogging = function (path, ...args) {
   this._currentlyLoggingPath = path
@@ -3,8 +3,11 @@
 const electron = require('electron')
 const { EventEmitter } = require('events')
 const { TopLevelWindow } = process.electronBinding('top_level_window')
+const { trackListeners } = require('@electron/internal/browser/track-listeners')
+const { createVersionedCache } = require('@electron/internal/browser/versioned-cache')
 
 Object.setPrototypeOf(TopLevelWindow.prototype, EventEmitter.prototype)
+trackListeners(TopLevelWindow.prototype)
 
 TopLevelWindow.prototype._init = function () {
   // Avoid recursive require.
@@ -17,8 +20,16 @@ TopLevelWindow.prototype._init = function () {
   }
 }
 
+// The windows are only fetched again after one was added or removed. Internal
+// callers which do not keep or change the array use it without a copy.
+TopLevelWindow._getAllCached = createVersionedCache(TopLevelWindow._getAllVersion, TopLevelWindow._getAll)
+
+TopLevelWindow.getAllWindows = () => {
+  return TopLevelWindow._getAllCached().slice()
+}
+
 TopLevelWindow.getFocusedWindow = () => {
-  return TopLevelWindow.getAllWindows().find((win) => win.isFocused())
+  return TopLevelWindow._getAllCached().find((win) => win.isFocused())
 }
 
 module.exports = TopLevelWindow
@@ -35,8 +35,8 @@ class TouchBar extends EventEmitter {
       items = []
     }
 
-    this.changeListener = (item) => {
-      this.emit('change', item.id, item.type)
+    this.changeListener = (item, property) => {
+      this.emit('change', item.id, item.type, property)
     }
 
     this.windowListeners = {}
@@ -86,8 +86,26 @@ class TouchBar extends EventEmitter {
 
     window._touchBar = this
 
-    const changeListener = (itemID) => {
-      window._refreshTouchBarItem(itemID)
+    // The changes made in one tick are sent together, each item being updated
+    // once with the properties which changed, or all of them when the change
+    // did not name one.
+    const pendingChanges = new Map()
+    const flushChanges = () => {
+      if (window.isDestroyed()) return
+      for (const [itemID, properties] of pendingChanges) {
+        window._refreshTouchBarItem(itemID, properties ? Array.from(properties) : [])
+      }
+      pendingChanges.clear()
+    }
+    const changeListener = (itemID, itemType, property) => {
+      if (pendingChanges.size === 0) process.nextTick(flushChanges)
+      const properties = pendingChanges.has(itemID) ? pendingChanges.get(itemID) : new Set()
+      if (properties && property) {
+        properties.add(property)
+        pendingChanges.set(itemID, properties)
+      } else {
+        pendingChanges.set(itemID, null)
+      }
     }
     this.on('change', changeListener)
 
@@ -108,6 +126,7 @@ class TouchBar extends EventEmitter {
     window.on('-touch-bar-interaction', interactionListener)
 
     const removeListeners = () => {
+      pendingChanges.clear()
       this.removeListener('change', changeListener)
       this.removeListener('escape-item-change', escapeItemListener)
       window.removeListener('-touch-bar-interaction', interactionListener)
@@ -169,7 +188,7 @@ class TouchBarItem extends EventEmitter {
       },
       set: function (value) {
         this[privateName] = value
-        this.emit('change', this)
+        this.emit('change', this, name)
       },
       enumerable: true
     })
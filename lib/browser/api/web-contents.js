@@ -4,6 +4,7 @@ const features = process.electronBinding('features')
 const { EventEmitter } = require('events')
 const electron = require('electron')
 const path = require('path')
+const { Readable } = require('stream')
 const url = require('url')
 const { app, ipcMain, session, deprecate } = electron
 
@@ -11,6 +12,9 @@ const { internalWindowOpen } = require('@electron/internal/browser/guest-window-
 const NavigationController = require('@electron/internal/browser/navigation-controller')
 const { ipcMainInternal } = require('@electron/internal/browser/ipc-main-internal')
 const ipcMainUtils = require('@electron/internal/browser/ipc-main-internal-utils')
+const { trackListeners } = require('@electron/internal/browser/track-listeners')
+const { createVersionedCache } = require('@electron/internal/browser/versioned-cache')
+const { IpcBatcher, emitBatch } = require('@electron/internal/common/ipc-batcher')
 
 // session is not used here, the purpose is to make sure session is initalized
 // before the webContents module.
@@ -99,6 +103,7 @@ const { WebContents } = binding
 
 Object.setPrototypeOf(NavigationController.prototype, EventEmitter.prototype)
 Object.setPrototypeOf(WebContents.prototype, NavigationController.prototype)
+trackListeners(WebContents.prototype)
 
 // WebContents::send(channel, args..)
 // WebContents::sendToAll(channel, args..)
@@ -107,17 +112,55 @@ WebContents.prototype.send = function (channel, ...args) {
     throw new Error('Missing required channel argument')
   }
 
+  if (this._ipcBatcher) {
+    if (this._ipcBatcher.accepts(channel)) {
+      this._ipcBatcher.push(channel, args)
+      return true
+    }
+    this._ipcBatcher.flush()
+  }
+
   const internal = false
   const sendToAll = false
 
   return this._send(internal, sendToAll, channel, args)
 }
 
+// Moves the ArrayBuffers in |transfer| to the renderer instead of copying them.
+WebContents.prototype.sendWithTransfer = function (channel, transfer, ...args) {
+  if (typeof channel !== 'string') {
+    throw new Error('Missing required channel argument')
+  } else if (!Array.isArray(transfer)) {
+    throw new Error('Missing required transfer argument')
+  }
+
+  if (this._ipcBatcher) this._ipcBatcher.flush()
+
+  const internal = false
+
+  return this._sendWithTransfer(internal, channel, args, transfer)
+}
+
+// The frame maps the region of |memory| instead of receiving a copy of it.
+WebContents.prototype.sendSharedMemory = function (channel, memory, options = {}) {
+  if (typeof channel !== 'string') {
+    throw new Error('Missing required channel argument')
+  } else if (typeof options !== 'object' || options === null) {
+    throw new TypeError('options must be an object')
+  }
+
+  if (this._ipcBatcher) this._ipcBatcher.flush()
+
+  return this._sendSharedMemory(channel, memory, options)
+}
+
 WebContents.prototype.sendToAll = function (channel, ...args) {
   if (typeof channel !== 'string') {
     throw new Error('Missing required channel argument')
   }
 
+  if (this._ipcBatcher) this._ipcBatcher.flush()
+
   const internal = false
   const sendToAll = true
 
@@ -151,11 +194,30 @@ WebContents.prototype.sendToFrame = function (frameId, channel, ...args) {
     throw new Error('Missing required frameId argument')
   }
 
+  if (this._ipcBatcher) this._ipcBatcher.flush()
+
   const internal = false
   const sendToAll = false
 
   return this._sendToFrame(internal, sendToAll, frameId, channel, args)
 }
+
+// Batches the messages sent with webContents.send().
+WebContents.prototype.enableIpcBatching = function (options) {
+  const batcher = new IpcBatcher(options, (channels, args, asArrays) => {
+    const internal = false
+    this._sendBatch(internal, channels, args, asArrays)
+  })
+  this.disableIpcBatching()
+  this._ipcBatcher = batcher
+}
+
+WebContents.prototype.disableIpcBatching = function () {
+  if (this._ipcBatcher) {
+    this._ipcBatcher.flush()
+    this._ipcBatcher = null
+  }
+}
 WebContents.prototype._sendToFrameInternal = function (frameId, channel, ...args) {
   if (typeof channel !== 'string') {
     throw new Error('Missing required channel argument')
@@ -204,6 +266,11 @@ WebContents.prototype.executeJavaScriptInIsolatedWorld = async function (code, h
   return ipcMainUtils.invokeInWebContents(this, false, 'ELECTRON_INTERNAL_RENDERER_WEB_FRAME_METHOD', 'executeJavaScriptInIsolatedWorld', code, hasUserGesture)
 }
 
+WebContents.prototype.executeJavaScriptInFrames = async function (frameIds, code) {
+  await waitTillCanExecuteJavaScript(this)
+  return ipcMainUtils.invokeInWebContents(this, false, 'ELECTRON_INTERNAL_RENDERER_WEB_FRAME_METHOD', 'executeJavaScriptInFrames', frameIds, code)
+}
+
 // Translate the options of printToPDF.
 WebContents.prototype.printToPDF = function (options) {
   const printingSetting = {
@@ -228,6 +295,9 @@ WebContents.prototype.printToPDF = function (options) {
   if (options.printBackground) {
     printingSetting.shouldPrintBackgrounds = options.printBackground
   }
+  if (options.path != null && typeof options.path !== 'string') {
+    return Promise.reject(new Error('path must be a string'))
+  }
 
   if (options.pageSize) {
     const pageSize = options.pageSize
@@ -257,7 +327,7 @@ WebContents.prototype.printToPDF = function (options) {
   // PrinterType enum from //printing/print_job_constants.h
   printingSetting.printerType = 2
   if (features.isPrintingEnabled()) {
-    return this._printToPDF(printingSetting)
+    return this._printToPDF(printingSetting, options.path || '')
   } else {
     return Promise.reject(new Error('Printing feature is disabled'))
   }
@@ -280,6 +350,50 @@ WebContents.prototype.getPrinters = function () {
   }
 }
 
+// The printers are shared by all the WebContents, and enumerated at most once
+// per interval.
+const kPrintersCacheTTL = 5 * 1000
+let printersCache = null
+
+WebContents.prototype.getPrintersAsync = function () {
+  if (!features.isPrintingEnabled()) {
+    return Promise.reject(new Error('Printing feature is disabled'))
+  }
+  if (!printersCache || Date.now() - printersCache.time > kPrintersCacheTTL) {
+    const printers = this._getPrintersAsync()
+    printersCache = { time: Date.now(), printers }
+    // A failed enumeration is not cached.
+    printers.catch(() => {
+      if (printersCache && printersCache.printers === printers) printersCache = null
+    })
+  }
+  return printersCache.printers.then(printers => printers.map(printer => ({ ...printer })))
+}
+
+WebContents.prototype.takeHeapSnapshotStream = function (options = {}) {
+  const { chunkSize = 64 * 1024 } = options
+  if (!Number.isSafeInteger(chunkSize) || chunkSize <= 0 || chunkSize > 0xFFFFFFFF) {
+    throw new TypeError('chunkSize must be a positive integer')
+  }
+
+  const reader = this._takeHeapSnapshotStream()
+  const stream = new Readable({
+    highWaterMark: chunkSize,
+    read () {
+      reader.read(chunkSize).then((chunk) => {
+        if (!stream.destroyed) stream.push(chunk)
+      }, (error) => {
+        stream.destroy(error)
+      })
+    },
+    destroy (error, callback) {
+      reader.cancel()
+      callback(error)
+    }
+  })
+  return stream
+}
+
 WebContents.prototype.loadFile = function (filePath, options = {}) {
   if (typeof filePath !== 'string') {
     throw new Error('Must pass filePath as a string')
@@ -319,6 +433,39 @@ const addReturnValueToEvent = (event) => {
   })
 }
 
+// Keeps the last frame of the page, for the app to display while it is
+// discarded.
+WebContents.prototype.discard = async function () {
+  if (this.isDiscarded()) return true
+  let snapshot = null
+  try {
+    snapshot = await this.capturePage()
+  } catch {
+    // A page which can not be captured is still discarded.
+  }
+  if (this.isDestroyed() || !this._discard()) return false
+  this._discardSnapshot = snapshot
+  return true
+}
+
+WebContents.prototype.getDiscardSnapshot = function () {
+  return this.isDiscarded() ? this._discardSnapshot || null : null
+}
+
+// Handles the window.open calls of the page before the new-window event, and
+// caches the decisions the handler asks to.
+WebContents.prototype.setWindowOpenHandler = function (handler) {
+  if (handler !== null && typeof handler !== 'function') {
+    throw new TypeError('handler must be a function or null')
+  }
+  this._windowOpenHandler = handler
+  this._windowOpenDecisions = []
+}
+
+WebContents.prototype.clearWindowOpenDecisions = function () {
+  this._windowOpenDecisions = []
+}
+
 // Add JavaScript wrappers for WebContents class.
 WebContents.prototype._init = function () {
   // The navigation controller.
@@ -340,6 +487,29 @@ WebContents.prototype._init = function () {
     }
   })
 
+  this.on('-ipc-message-batch', function (event, internal, channels, args, asArrays) {
+    if (internal) {
+      addReplyInternalToEvent(event)
+    } else {
+      addReplyToEvent(event)
+    }
+    // All the messages of a batch share one event object.
+    emitBatch((channel, ...messageArgs) => {
+      if (internal) {
+        ipcMainInternal.emit(channel, event, ...messageArgs)
+      } else {
+        this.emit('ipc-message', event, channel, ...messageArgs)
+        ipcMain.emit(channel, event, ...messageArgs)
+      }
+    }, channels, args, asArrays)
+  })
+
+  this.on('-ipc-ring-buffer', function (event, channel, records) {
+    addReplyToEvent(event)
+    this.emit('ipc-message', event, channel, records)
+    ipcMain.emit(channel, event, records)
+  })
+
   this.on('-ipc-invoke', function (event, internal, channel, args) {
     event._reply = (result) => event.sendReply({ result })
     event._throw = (error) => {
@@ -443,8 +613,35 @@ deprecate.fnToProperty(WebContents.prototype, 'frameRate', '_getFrameRate', '_se
 const { Debugger } = process.electronBinding('debugger')
 Object.setPrototypeOf(Debugger.prototype, EventEmitter.prototype)
 
+// Sends a message to the main frames of |contentsList|, serializing it only
+// once.
+const broadcast = function (contentsList, channel, args) {
+  if (typeof channel !== 'string') {
+    throw new Error('Missing required channel argument')
+  }
+
+  const ids = []
+  for (const contents of contentsList) {
+    if (contents.isDestroyed()) continue
+    if (contents._ipcBatcher) contents._ipcBatcher.flush()
+    ids.push(contents.id)
+  }
+
+  return binding.broadcast(channel, args, ids)
+}
+
+// The web contents are only fetched again after one was added or removed.
+const getAllWebContents = createVersionedCache(binding.getAllWebContentsVersion, binding.getAllWebContents)
+
 // Public APIs.
 module.exports = {
+  _broadcast: broadcast,
+  _getAllCached: getAllWebContents,
+
+  broadcast (channel, ...args) {
+    return broadcast(getAllWebContents(), channel, args)
+  },
+
   create (options = {}) {
     return binding.create(options)
   },
@@ -455,7 +652,7 @@ module.exports = {
 
   getFocusedWebContents () {
     let focused = null
-    for (const contents of binding.getAllWebContents()) {
+    for (const contents of getAllWebContents()) {
       if (!contents.isFocused()) continue
       if (focused == null) focused = contents
       // Return webview web contents which may be embedded inside another
@@ -466,6 +663,6 @@ module.exports = {
   },
 
   getAllWebContents () {
-    return binding.getAllWebContents()
+    return getAllWebContents().slice()
   }
 }
@@ -0,0 +1,85 @@
+// The background requests of the net module that each session runs at the
+// same time are limited, the others wait for their turn in the order they
+// were started.
+
+const kDefaultMaxBackgroundRequests = 6
+
+interface PendingRequest {
+  start: () => void
+  fail: (error: Error) => void
+}
+
+interface SessionRequests {
+  limit: number
+  active: number
+  pending: PendingRequest[]
+}
+
+const sessionRequests = new WeakMap<Electron.Session, SessionRequests>()
+
+const getSessionRequests = (session: Electron.Session) => {
+  let requests = sessionRequests.get(session)
+  if (!requests) {
+    requests = { limit: kDefaultMaxBackgroundRequests, active: 0, pending: [] }
+    sessionRequests.set(session, requests)
+  }
+  return requests
+}
+
+const startPending = (requests: SessionRequests) => {
+  while (requests.active < requests.limit && requests.pending.length > 0) {
+    requests.active++
+    const request = requests.pending.shift()!
+    try {
+      request.start()
+    } catch (error) {
+      request.fail(error)
+    }
+  }
+}
+
+export function setMaxBackgroundRequests (session: Electron.Session, limit: number) {
+  const requests = getSessionRequests(session)
+  requests.limit = limit
+  startPending(requests)
+}
+
+export function getMaxBackgroundRequests (session: Electron.Session) {
+  return getSessionRequests(session).limit
+}
+
+// Calls |start| once |session| has room for another background request.
+// When |start| throws, the request is done and |fail| is called with the error.
+// Returns the function to call when the request is done, which also drops it
+// when it is still waiting.
+export function startBackgroundRequest (
+  session: Electron.Session, start: () => void, fail: (error: Error) => void
+) {
+  const requests = getSessionRequests(session)
+  let started = false
+  let done = false
+  const finish = () => {
+    if (done) return
+    done = true
+    if (started) {
+      requests.active--
+      startPending(requests)
+    } else {
+      requests.pending.splice(requests.pending.indexOf(pending), 1)
+    }
+  }
+  const pending = {
+    start: () => {
+      started = true
+      start()
+    },
+    fail: (error: Error) => {
+      finish()
+      fail(error)
+    }
+  }
+  requests.pending.push(pending)
+  startPending(requests)
+
+  return finish
+}
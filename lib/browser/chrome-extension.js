@@ -6,6 +6,7 @@ if (process.electronBinding('features').isExtensionsEnabled()) {
 
 const { app, webContents, BrowserWindow } = require('electron')
 const { getAllWebContents } = process.electronBinding('web_contents')
+const commandLine = process.electronBinding('command_line')
 const { ipcMainInternal } = require('@electron/internal/browser/ipc-main-internal')
 const ipcMainUtils = require('@electron/internal/browser/ipc-main-internal-utils')
 
@@ -357,6 +358,11 @@ const injectContentScripts = function (manifest) {
       contentScripts: manifest.content_scripts.map(contentScriptToEntry)
     }
     contentScripts[manifest.name] = entry
+    // The renderers launched from now on load the Electron APIs in the sub
+    // frames, which inject these scripts.
+    if (entry.contentScripts.some(script => script.allFrames)) {
+      commandLine.appendSwitch('content-scripts-in-subframes')
+    }
   } catch (e) {
     console.error('Failed to read content scripts', e)
   }
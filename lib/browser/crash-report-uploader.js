@@ -0,0 +1,151 @@
+'use strict'
+
+const { app, net, powerMonitor } = require('electron')
+const fs = require('fs')
+const path = require('path')
+const util = require('util')
+const zlib = require('zlib')
+
+const gzip = util.promisify(zlib.gzip)
+
+const binding = process.electronBinding('crash_reporter')
+
+// The reports are uploaded once the app was idle for this long after its
+// first window painted, so they do not compete with its startup.
+const kIdleDelay = 10 * 1000
+// Apps which do not show a window upload this long after they are ready.
+const kNoWindowDelay = 30 * 1000
+
+// The delay after a failed pass doubles up to the maximum.
+const kInitialRetryDelay = 60 * 1000
+const kMaxRetryDelay = 60 * 60 * 1000
+
+// The passes wait this long while the app saves battery.
+const kBatterySaverDelay = 5 * 60 * 1000
+
+const kReportIdPattern = /^[0-9a-fA-F-]+$/
+
+let config = null
+let timer = null
+let uploading = false
+let failures = 0
+
+const schedulePass = (delay) => {
+  if (uploading) return
+  clearTimeout(timer)
+  timer = setTimeout(uploadPendingReports, delay)
+}
+
+const getPendingReports = async (crashesDirectory) => {
+  let names
+  try {
+    names = await fs.promises.readdir(crashesDirectory)
+  } catch {
+    return []
+  }
+  return names.filter(name => name.endsWith('.dmp'))
+    .map(name => path.join(crashesDirectory, name))
+}
+
+// The reports are saved as the MIME block they are uploaded as, which starts
+// with its boundary.
+const readReport = async (file) => {
+  const data = await fs.promises.readFile(file)
+  const end = data.indexOf('\r\n')
+  if (end <= 2 || data.toString('latin1', 0, 2) !== '--') {
+    throw new Error(`${file} is not a saved crash report`)
+  }
+  return { boundary: data.toString('latin1', 2, end), data }
+}
+
+const uploadReport = async (file, { boundary, data }) => {
+  const body = config.compress ? await gzip(data) : data
+  const id = await new Promise((resolve, reject) => {
+    const request = net.request({ method: 'POST', url: config.submitURL })
+    request.setHeader('Content-Type', `multipart/form-data; boundary=${boundary}`)
+    if (config.compress) request.setHeader('Content-Encoding', 'gzip')
+    request.on('response', (response) => {
+      const chunks = []
+      response.on('data', (chunk) => chunks.push(chunk))
+      response.on('end', () => {
+        if (response.statusCode < 200 || response.statusCode >= 300) {
+          reject(new Error(`Crash report upload failed with ${response.statusCode}`))
+        } else {
+          resolve(Buffer.concat(chunks).toString().trim())
+        }
+      })
+      response.on('error', reject)
+    })
+    request.on('error', reject)
+    request.end(body)
+  })
+
+  // Recorded like the uploads of the crash handler, as seconds_since_epoch,id.
+  if (kReportIdPattern.test(id)) {
+    const uploadsLog = path.join(config.crashesDirectory, 'uploads.log')
+    await fs.promises.appendFile(uploadsLog, `${Math.floor(Date.now() / 1000)},${id}\n`)
+  }
+  await fs.promises.unlink(file)
+}
+
+// Uploads the pending reports one after the other, which reuses the
+// connection to the server.
+const uploadPendingReports = async () => {
+  if (!binding.getUploadToServer()) return
+  if (powerMonitor.isBatterySaverActive()) {
+    schedulePass(kBatterySaverDelay)
+    return
+  }
+
+  uploading = true
+  let failed = false
+  for (const file of await getPendingReports(config.crashesDirectory)) {
+    let report
+    try {
+      report = await readReport(file)
+    } catch {
+      // Dumps which could not be saved as reports are never uploaded.
+      continue
+    }
+    try {
+      await uploadReport(file, report)
+    } catch {
+      failed = true
+      break
+    }
+  }
+  uploading = false
+
+  if (failed) {
+    const delay = Math.min(kInitialRetryDelay * Math.pow(2, failures), kMaxRetryDelay)
+    failures++
+    schedulePass(delay)
+  } else {
+    failures = 0
+  }
+}
+
+const waitForFirstPaint = () => {
+  const noWindowTimer = setTimeout(() => schedulePass(0), kNoWindowDelay)
+  app.once('browser-window-created', (event, window) => {
+    window.once('ready-to-show', () => {
+      clearTimeout(noWindowTimer)
+      schedulePass(kIdleDelay)
+    })
+  })
+}
+
+exports.scheduleUploads = function (options) {
+  const started = config !== null
+  config = options
+  if (started) return
+
+  app.whenReady().then(waitForFirstPaint)
+
+  // A crash of another process is uploaded once the app is idle again.
+  const onCrashed = () => {
+    if (!failures) schedulePass(kIdleDelay)
+  }
+  app.on('renderer-process-crashed', onCrashed)
+  app.on('gpu-process-crashed', onCrashed)
+}
@@ -13,6 +13,10 @@ const getTempDirectory = function () {
   }
 }
 
+// Whether the main process uploads the reports of all the processes, set by
+// its own crashReporter.start().
+let deferUploads = false
+
 exports.crashReporterInit = function (options) {
   const productName = options.productName || app.name
   const crashesDirectory = path.join(getTempDirectory(), `${productName} Crashes`)
@@ -20,6 +24,11 @@ exports.crashReporterInit = function (options) {
   return {
     productName,
     crashesDirectory,
-    appVersion: app.getVersion()
+    appVersion: app.getVersion(),
+    deferUploads
   }
 }
+
+exports.setDeferUploads = function (defer) {
+  deferUploads = defer
+}
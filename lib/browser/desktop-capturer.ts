@@ -9,9 +9,20 @@ let currentlyRunning: {
   getSources: Promise<ElectronInternal.GetSourcesResult[]>;
 }[] = []
 
+const toResult = (source: Electron.DesktopCapturerSource, fetchWindowIcons: boolean, withThumbnail: boolean) => ({
+  id: source.id,
+  name: source.name,
+  thumbnail: withThumbnail ? source.thumbnail.toDataURL() : '',
+  display_id: source.display_id,
+  appIcon: (fetchWindowIcons && source.appIcon) ? source.appIcon.toDataURL() : null
+})
+
 export const getSources = (event: Electron.IpcMainEvent, options: ElectronInternal.GetSourcesOptions) => {
+  const { streamId } = options
+  const streaming = typeof streamId === 'number'
+  const streamThumbnails = streaming && !!options.streamThumbnails
   for (const running of currentlyRunning) {
-    if (deepEqual(running.options, options)) {
+    if (!streaming && deepEqual(running.options, options)) {
       // If a request is currently running for the same options
       // return that promise
       return running.getSources
@@ -39,17 +50,25 @@ export const getSources = (event: Electron.IpcMainEvent, options: ElectronIntern
 
     emitter.once('finished', (event, sources: Electron.DesktopCapturerSource[], fetchWindowIcons: boolean) => {
       stopRunning()
-      resolve(sources.map(source => ({
-        id: source.id,
-        name: source.name,
-        thumbnail: source.thumbnail.toDataURL(),
-        display_id: source.display_id,
-        appIcon: (fetchWindowIcons && source.appIcon) ? source.appIcon.toDataURL() : null
-      })))
+      // The streamed thumbnails were already sent.
+      resolve(sources.map(source => toResult(source, fetchWindowIcons, !streamThumbnails)))
     })
 
+    if (streaming) {
+      emitter.on('source-added', (_event, source: Electron.DesktopCapturerSource) => {
+        if (capturer) {
+          event.sender._sendInternal('ELECTRON_RENDERER_DESKTOP_CAPTURER_SOURCE_ADDED', streamId, toResult(source, options.fetchWindowIcons, false))
+        }
+      })
+      emitter.on('thumbnail-changed', (_event, id: string, thumbnail: Buffer) => {
+        if (capturer) {
+          event.sender._sendInternal('ELECTRON_RENDERER_DESKTOP_CAPTURER_THUMBNAIL_CHANGED', streamId, id, thumbnail)
+        }
+      })
+    }
+
     capturer.emit = emitter.emit.bind(emitter)
-    capturer.startHandling(options.captureWindow, options.captureScreen, options.thumbnailSize, options.fetchWindowIcons)
+    capturer.startHandling(options.captureWindow, options.captureScreen, options.thumbnailSize, options.fetchWindowIcons, streaming, streamThumbnails)
 
     // If the WebContents is destroyed before receiving result, just remove the
     // reference to emit and the capturer itself so that it never dispatches
@@ -67,7 +67,11 @@ const mergeBrowserWindowOptions = function (embedder, options) {
     mergeOptions(options.webPreferences, embedder.getLastWebPreferences())
   }
 
-  // Inherit certain option values from parent window
+  return inheritWebPreferences(embedder, options)
+}
+
+// Inherit certain option values from parent window
+const inheritWebPreferences = function (embedder, options) {
   const webPreferences = embedder.getLastWebPreferences()
   for (const [name, value] of inheritedWebPreferences) {
     if (webPreferences[name] === value) {
@@ -83,6 +87,55 @@ const mergeBrowserWindowOptions = function (embedder, options) {
   return options
 }
 
+// Turns a URL pattern, where "*" matches any characters, into a RegExp.
+const patternToRegExp = function (pattern) {
+  const source = pattern.split('*').map(part => part.replace(/[.+?^${}()|[\]\\]/g, '\\$&')).join('.*')
+  return new RegExp(`^${source}$`)
+}
+
+// Returns the decision of the window open handler of |embedder|, or null when
+// the window.open call goes through the new-window event.
+const getWindowOpenDecision = function (embedder, details) {
+  const handler = embedder._windowOpenHandler
+  if (!handler) return null
+
+  const cached = embedder._windowOpenDecisions.find(({ pattern }) => pattern.test(details.url))
+  if (cached) return cached.decision
+
+  const decision = handler(details)
+  if (decision == null || typeof decision !== 'object') return null
+  if (decision.action !== 'allow' && decision.action !== 'deny') {
+    throw new TypeError('action must be "allow" or "deny"')
+  }
+  if (decision.cacheFor != null) {
+    if (typeof decision.cacheFor !== 'string') {
+      throw new TypeError('cacheFor must be a string')
+    }
+    embedder._windowOpenDecisions.push({ pattern: patternToRegExp(decision.cacheFor), decision })
+  }
+  return decision
+}
+
+// Takes a prewarmed window of |pool| when its web preferences are at least as
+// restricted as those the guest would inherit from |embedder|.
+const acquirePoolWindow = function (pool, embedder, options) {
+  if (!pool || options.webContents || pool.readyCount === 0) return null
+  const candidate = pool._windows.find(win => win._poolReady)
+  const webPreferences = candidate.webContents.getLastWebPreferences()
+  for (const name of inheritedWebPreferences.keys()) {
+    if (name in options.webPreferences && webPreferences[name] !== options.webPreferences[name]) {
+      return null
+    }
+  }
+
+  const guest = pool.acquire()
+  if (options.x != null && options.y != null) guest.setPosition(options.x, options.y)
+  if (options.width != null && options.height != null) guest.setSize(options.width, options.height)
+  if (options.title != null) guest.setTitle(options.title)
+  if (options.show !== false) guest.show()
+  return guest
+}
+
 // Setup a new guest with |embedder|
 const setupGuest = function (embedder, frameName, guest, options) {
   // When |embedder| is destroyed we should also destroy attached guest, and if
@@ -109,8 +162,9 @@ const setupGuest = function (embedder, frameName, guest, options) {
   return guestId
 }
 
-// Create a new guest created by |embedder| with |options|.
-const createGuest = function (embedder, url, referrer, frameName, options, postData) {
+// Create a new guest created by |embedder| with |options|, or take it from
+// |pool|.
+const createGuest = function (embedder, url, referrer, frameName, options, postData, pool) {
   let guest = frameToGuest.get(frameName)
   if (frameName && (guest != null)) {
     guest.loadURL(url)
@@ -122,7 +176,7 @@ const createGuest = function (embedder, url, referrer, frameName, options, postD
     options.webPreferences = {}
   }
 
-  guest = new BrowserWindow(options)
+  guest = acquirePoolWindow(pool, embedder, options) || new BrowserWindow(options)
   if (!options.webContents) {
     // We should not call `loadURL` if the window was constructed from an
     // existing webContents (window.open in a sandboxed renderer).
@@ -252,6 +306,22 @@ ipcMainInternal.on('ELECTRON_GUEST_WINDOW_MANAGER_WINDOW_OPEN', (event, url, fra
 
 // Routed window.open messages with fully parsed options
 function internalWindowOpen (event, url, referrer, frameName, disposition, options, additionalFeatures, postData) {
+  // The window open handler decides without merging the options of the
+  // embedder or emitting the new-window event.
+  const decision = getWindowOpenDecision(event.sender, { url, frameName, disposition, features: additionalFeatures })
+  if (decision && decision.action === 'deny') {
+    // Destroys the webContents of the native window.open.
+    if (options.webContents) event.preventDefault()
+    event.returnValue = null
+    return
+  } else if (decision) {
+    options = { ...options, ...decision.overrideBrowserWindowOptions }
+    options.webPreferences = { ...options.webPreferences }
+    options = inheritWebPreferences(event.sender, options)
+    event.returnValue = createGuest(event.sender, url, referrer, frameName, options, postData, decision.pool)
+    return
+  }
+
   options = mergeBrowserWindowOptions(event.sender, options)
   event.sender.emit('new-window', event, url, frameName, disposition, options, additionalFeatures, referrer)
   const { newGuest } = event
@@ -4,6 +4,9 @@ import * as path from 'path'
 import * as util from 'util'
 
 const Module = require('module')
+const v8Util = process.electronBinding('v8_util')
+
+v8Util.beginStartupPhase('browser-init')
 
 // We modified the original process.argv to let node.js load the init.js,
 // we need to restore it here.
@@ -204,10 +207,17 @@ const { setDefaultApplicationMenu } = require('@electron/internal/browser/defaul
 // menu may show even when user explicitly hides the menu.
 app.once('ready', setDefaultApplicationMenu)
 
+v8Util.endStartupPhase('browser-init')
+
 if (packagePath) {
+  // Cache the code of the modules required from the app's archive.
+  require('@electron/internal/common/asar-code-cache').enableAsarCodeCache()
+
   // Finally load app's main.js and transfer control to C++.
   process._firstFileName = Module._resolveFilename(path.join(packagePath, mainStartupScript), null, false)
+  v8Util.beginStartupPhase('main-script')
   Module._load(path.join(packagePath, mainStartupScript), Module, true)
+  v8Util.endStartupPhase('main-script')
 } else {
   console.error('Failed to locate a valid package to load (app, app.asar or default_app.asar)')
   console.error('This normally means you\'ve damaged the Electron package somehow')
@@ -30,4 +30,25 @@ export class IpcMainImpl extends EventEmitter {
   removeHandler (method: string) {
     this._invokeHandlers.delete(method)
   }
+
+  // The metrics are recorded natively by the WebContents receiving the
+  // messages, see shell/browser/ipc_metrics.h.
+  setMetricsEnabled (enabled: boolean) {
+    process.electronBinding('web_contents').setIpcMetricsEnabled(enabled)
+  }
+
+  getMetrics (): Electron.IpcChannelMetrics[] {
+    return process.electronBinding('web_contents').getIpcMetrics()
+  }
+
+  resetMetrics () {
+    process.electronBinding('web_contents').resetIpcMetrics()
+  }
+
+  setSyncBudget (milliseconds: number) {
+    if (typeof milliseconds !== 'number' || !(milliseconds >= 0)) {
+      throw new Error('The budget must be a non-negative number')
+    }
+    process.electronBinding('web_contents').setIpcSyncBudget(milliseconds)
+  }
 }
@@ -0,0 +1,101 @@
+import * as crypto from 'crypto'
+import * as fs from 'fs'
+import * as path from 'path'
+import * as vm from 'vm'
+
+import { wrapPreloadSource } from '@electron/internal/common/preload-wrapper'
+
+// V8 code caches of the preload scripts of sandboxed renderers, keyed by the
+// hash of the preload source. They are kept in memory for the lifetime of
+// the session, and on disk for persistent sessions.
+//
+// The caches are only ever built here, never taken from a renderer, so that a
+// compromised renderer can not hand its bytecode to the other renderers.
+
+let sessionCaches = new WeakMap<Electron.Session, Map<string, Buffer | null>>()
+
+// The caches being written to disk.
+const pendingWrites = new Set<string>()
+
+const getSessionCache = (session: Electron.Session) => {
+  let cache = sessionCaches.get(session)
+  if (!cache) {
+    cache = new Map()
+    sessionCaches.set(session, cache)
+  }
+  return cache
+}
+
+export function hashPreloadSource (preloadSrc: string) {
+  return crypto.createHash('sha256').update(preloadSrc).digest('hex')
+}
+
+// Compiles the wrapper the renderers run, without running it. Returns null
+// when the script does not compile, the renderer then reports the error.
+const buildCodeCache = (preloadSrc: string) => {
+  try {
+    return new vm.Script(wrapPreloadSource(preloadSrc)).createCachedData()
+  } catch {
+    return null
+  }
+}
+
+const writeCodeCache = (file: string, buffer: Buffer) => {
+  if (pendingWrites.has(file)) return
+  const cachePath = path.dirname(file)
+
+  // Write through a temporary file, so that a partially written cache is
+  // never read.
+  pendingWrites.add(file)
+  const tempFile = `${file}.${process.pid}.tmp`
+  fs.promises.mkdir(cachePath, { recursive: true })
+    .then(() => fs.promises.writeFile(tempFile, buffer))
+    .then(() => fs.promises.rename(tempFile, file))
+    .catch(() => fs.promises.unlink(tempFile).catch(() => {}))
+    .then(() => { pendingWrites.delete(file) })
+}
+
+export async function getPreloadCodeCache (session: Electron.Session, hash: string, preloadSrc: string) {
+  const cache = getSessionCache(session)
+  if (cache.has(hash)) return cache.get(hash)!
+
+  const cachePath = session._getPreloadCodeCachePath()
+  if (cachePath) {
+    try {
+      const data = await fs.promises.readFile(path.join(cachePath, hash))
+      if (!cache.has(hash)) cache.set(hash, data)
+      return cache.get(hash)!
+    } catch {
+      // There is no cache for this preload script yet.
+    }
+  }
+
+  // Another load may have built the cache in the meantime.
+  if (cache.has(hash)) return cache.get(hash)!
+  const buffer = buildCodeCache(preloadSrc)
+  cache.set(hash, buffer)
+  if (buffer && cachePath) writeCodeCache(path.join(cachePath, hash), buffer)
+  return buffer
+}
+
+// The preload bundles of the sessions, which are kept in memory and hashed
+// once, so the renderers can run them without reading any file.
+const preloadBundles = new WeakMap<Electron.Session, { source: string, hash: string }>()
+
+export function setPreloadBundle (session: Electron.Session, source: string | null) {
+  if (source === null) {
+    preloadBundles.delete(session)
+  } else {
+    preloadBundles.set(session, { source, hash: hashPreloadSource(source) })
+  }
+}
+
+export function getPreloadBundle (session: Electron.Session) {
+  return preloadBundles.get(session) || null
+}
+
+// Drops the caches kept in memory, the ones on disk are read again when
+// needed.
+export function purgePreloadCodeCaches () {
+  sessionCaches = new WeakMap()
+}
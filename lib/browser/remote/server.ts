@@ -54,10 +54,20 @@ const getObjectMembers = function (object: any): ObjectMember[] {
       if (descriptor.set || descriptor.writable) writable = true
       type = 'get'
     }
-    return { name, enumerable: descriptor.enumerable, writable, type }
+    const member: ObjectMember = { name, enumerable: descriptor.enumerable, writable, type }
+    // The primitive values which can never change are sent along, so that
+    // reading them does not need another round-trip.
+    if (type === 'get' && !writable && !descriptor.configurable && 'value' in descriptor && isPrimitive(descriptor.value)) {
+      member.value = descriptor.value
+    }
+    return member
   })
 }
 
+const isPrimitive = function (value: any) {
+  return value === null || (typeof value !== 'object' && typeof value !== 'function' && typeof value !== 'symbol')
+}
+
 type ObjProtoDescriptor = {
   members: ObjectMember[],
   proto: ObjProtoDescriptor
@@ -512,7 +522,7 @@ handleRemoteCommand('ELECTRON_BROWSER_MEMBER_CALL', function (event, contextId,
   }
 })
 
-handleRemoteCommand('ELECTRON_BROWSER_MEMBER_SET', function (event, contextId, id, name, args) {
+const setMember = function (event: ElectronInternal.IpcMainInternalEvent, contextId: string, id: number, name: string, args: any[]) {
   args = unwrapArgs(event.sender, event.frameId, contextId, args)
   const obj = objectsRegistry.get(id)
 
@@ -521,6 +531,18 @@ handleRemoteCommand('ELECTRON_BROWSER_MEMBER_SET', function (event, contextId, i
   }
 
   obj[name] = args[0]
+}
+
+handleRemoteCommand('ELECTRON_BROWSER_MEMBER_SET', function (event, contextId, id, name, args) {
+  setMember(event, contextId, id, name, args)
+  return null
+})
+
+// The properties set in a remote.batch(), in order.
+handleRemoteCommand('ELECTRON_BROWSER_MEMBER_SET_BATCH', function (event, contextId, sets: { id: number, name: string, args: any[] }[]) {
+  for (const { id, name, args } of sets) {
+    setMember(event, contextId, id, name, args)
+  }
   return null
 })
 
@@ -534,8 +556,38 @@ handleRemoteCommand('ELECTRON_BROWSER_MEMBER_GET', function (event, contextId, i
   return valueToMeta(event.sender, contextId, obj[name])
 })
 
-handleRemoteCommand('ELECTRON_BROWSER_DEREFERENCE', function (event, contextId, id, rendererSideRefCount) {
-  objectsRegistry.remove(event.sender, contextId, id, rendererSideRefCount)
+// Returns the metas of the own properties of an object, and of the properties
+// of the objects among them down to |depth| levels.
+const prefetchMembers = function (sender: electron.WebContents, contextId: string, object: any, depth: number) {
+  const members: Record<string, any> = {}
+  for (const { name, type } of getObjectMembers(object)) {
+    if (type !== 'get') continue
+    const value = object[name]
+    const meta = valueToMeta(sender, contextId, value) as any
+    if (depth > 1 && meta.type === 'object') {
+      meta.prefetched = prefetchMembers(sender, contextId, value, depth - 1)
+    }
+    members[name] = meta
+  }
+  return members
+}
+
+handleRemoteCommand('ELECTRON_BROWSER_MEMBER_PREFETCH', function (event, contextId, id, depth) {
+  const obj = objectsRegistry.get(id)
+
+  if (obj == null) {
+    throwRPCError(`Cannot prefetch properties of missing remote object ${id}`)
+  }
+
+  return { type: 'value', value: prefetchMembers(event.sender, contextId, obj, depth) }
+})
+
+// The objects collected in one task of the renderer, as pairs of the id and
+// the number of references the renderer got.
+handleRemoteCommand('ELECTRON_BROWSER_DEREFERENCE', function (event, contextId, ...refs) {
+  for (let i = 0; i + 1 < refs.length; i += 2) {
+    objectsRegistry.remove(event.sender, contextId, refs[i], refs[i + 1])
+  }
 })
 
 handleRemoteCommand('ELECTRON_BROWSER_CONTEXT_RELEASE', (event, contextId) => {
@@ -4,13 +4,13 @@ const electron = require('electron')
 const fs = require('fs')
 
 const eventBinding = process.electronBinding('event')
-const clipboard = process.electronBinding('clipboard')
 const features = process.electronBinding('features')
 
 const { crashReporterInit } = require('@electron/internal/browser/crash-reporter-init')
 const { ipcMainInternal } = require('@electron/internal/browser/ipc-main-internal')
 const ipcMainUtils = require('@electron/internal/browser/ipc-main-internal-utils')
 const guestViewManager = require('@electron/internal/browser/guest-view-manager')
+const preloadCodeCache = require('@electron/internal/browser/preload-code-cache')
 const typeUtils = require('@electron/internal/common/type-utils')
 
 const emitCustomEvent = function (contents, eventName, ...args) {
@@ -28,6 +28,12 @@ const logStack = function (contents, code, stack) {
   }
 }
 
+electron.app.on('memory-pressure', function (event, level) {
+  if (level === 'critical') {
+    preloadCodeCache.purgePreloadCodeCaches()
+  }
+})
+
 // Implements window.close()
 ipcMainInternal.on('ELECTRON_BROWSER_WINDOW_CLOSE', function (event) {
   const window = event.sender.getOwnerBrowserWindow()
@@ -46,19 +52,27 @@ ipcMainInternal.handle('ELECTRON_BROWSER_GET_LAST_WEB_PREFERENCES', function (ev
 })
 
 // Methods not listed in this set are called directly in the renderer process.
-const allowedClipboardMethods = (() => {
-  switch (process.platform) {
-    case 'darwin':
-      return new Set(['readFindText', 'writeFindText'])
-    case 'linux':
-      return new Set(Object.keys(clipboard))
-    default:
-      return new Set()
+// Computed on first use, so that the clipboard binding is only initialized by
+// apps that use it.
+let allowedClipboardMethods = null
+const getAllowedClipboardMethods = () => {
+  if (!allowedClipboardMethods) {
+    switch (process.platform) {
+      case 'darwin':
+        allowedClipboardMethods = new Set(['readFindText', 'writeFindText'])
+        break
+      case 'linux':
+        allowedClipboardMethods = new Set(Object.keys(process.electronBinding('clipboard')))
+        break
+      default:
+        allowedClipboardMethods = new Set()
+    }
   }
-})()
+  return allowedClipboardMethods
+}
 
 ipcMainUtils.handleSync('ELECTRON_BROWSER_CLIPBOARD', function (event, method, ...args) {
-  if (!allowedClipboardMethods.has(method)) {
+  if (!getAllowedClipboardMethods().has(method)) {
     throw new Error(`Invalid method: ${method}`)
   }
 
@@ -66,8 +80,6 @@ ipcMainUtils.handleSync('ELECTRON_BROWSER_CLIPBOARD', function (event, method, .
 })
 
 if (features.isDesktopCapturerEnabled()) {
-  const desktopCapturer = require('@electron/internal/browser/desktop-capturer')
-
   ipcMainInternal.handle('ELECTRON_BROWSER_DESKTOP_CAPTURER_GET_SOURCES', function (event, options, stack) {
     logStack(event.sender, 'desktopCapturer.getSources()', stack)
     const customEvent = emitCustomEvent(event.sender, 'desktop-capturer-get-sources')
@@ -77,6 +89,8 @@ if (features.isDesktopCapturerEnabled()) {
       return []
     }
 
+    // Loaded on first use, since it initializes the desktop_capturer binding.
+    const desktopCapturer = require('@electron/internal/browser/desktop-capturer')
     return desktopCapturer.getSources(event, options)
   })
 }
@@ -85,15 +99,28 @@ const isRemoteModuleEnabled = features.isRemoteModuleEnabled()
   ? require('@electron/internal/browser/remote/server').isRemoteModuleEnabled
   : () => false
 
-const getPreloadScript = async function (preloadPath) {
+const getPreloadScript = async function (session, preloadPath) {
   let preloadSrc = null
+  let preloadCache = null
   let preloadError = null
   try {
     preloadSrc = (await fs.promises.readFile(preloadPath)).toString()
+    const preloadHash = preloadCodeCache.hashPreloadSource(preloadSrc)
+    preloadCache = await preloadCodeCache.getPreloadCodeCache(session, preloadHash, preloadSrc)
   } catch (error) {
     preloadError = error
   }
-  return { preloadPath, preloadSrc, preloadError }
+  return { preloadPath, preloadSrc, preloadCache, preloadError }
+}
+
+// A renderer process keeps the bundle it got last, which is only sent again
+// once the session has a different one.
+const getPreloadBundle = async function (session, cachedHash) {
+  const bundle = preloadCodeCache.getPreloadBundle(session)
+  if (!bundle) return null
+  if (bundle.hash === cachedHash) return { hash: bundle.hash }
+  const cache = await preloadCodeCache.getPreloadCodeCache(session, bundle.hash, bundle.source)
+  return { hash: bundle.hash, source: bundle.source, cache }
 }
 
 if (features.isExtensionsEnabled()) {
@@ -103,7 +130,7 @@ if (features.isExtensionsEnabled()) {
   ipcMainUtils.handleSync('ELECTRON_GET_CONTENT_SCRIPTS', () => getContentScripts())
 }
 
-ipcMainUtils.handleSync('ELECTRON_BROWSER_SANDBOX_LOAD', async function (event) {
+ipcMainUtils.handleSync('ELECTRON_BROWSER_SANDBOX_LOAD', async function (event, cachedBundleHash) {
   const preloadPaths = event.sender._getPreloadPaths()
 
   let contentScripts = []
@@ -116,7 +143,8 @@ ipcMainUtils.handleSync('ELECTRON_BROWSER_SANDBOX_LOAD', async function (event)
 
   return {
     contentScripts,
-    preloadScripts: await Promise.all(preloadPaths.map(path => getPreloadScript(path))),
+    preloadBundle: await getPreloadBundle(event.sender.session, cachedBundleHash),
+    preloadScripts: await Promise.all(preloadPaths.map(path => getPreloadScript(event.sender.session, path))),
     isRemoteModuleEnabled: isRemoteModuleEnabled(event.sender),
     isWebViewTagEnabled: guestViewManager.isWebViewTagEnabled(event.sender),
     guestInstanceId: webPreferences.guestInstanceId,
@@ -0,0 +1,44 @@
+interface TrackedEmitter extends NodeJS.EventEmitter {
+  _setListening (name: string, listening: boolean): void;
+  isDestroyed (): boolean;
+}
+
+// Reports to the native side of the emitters created from |prototype| whether
+// each event has listeners, which lets it skip emitting the events nobody
+// listens to without entering JavaScript.
+export function trackListeners (prototype: TrackedEmitter) {
+  const update = (emitter: TrackedEmitter, names: (string | symbol)[]) => {
+    if (emitter.isDestroyed()) return
+    for (const name of names) {
+      if (typeof name === 'string') {
+        emitter._setListening(name, emitter.listenerCount(name) > 0)
+      }
+    }
+  }
+
+  // once() and prependOnceListener() go through on() and prependListener(),
+  // and their listeners are removed through removeListener().
+  const methods = ['on', 'addListener', 'prependListener', 'off', 'removeListener'] as const
+  for (const method of methods) {
+    const original = prototype[method] as (name: string | symbol, listener: Function) => TrackedEmitter
+    prototype[method] = function (this: TrackedEmitter, name: string | symbol, listener: (...args: any[]) => void) {
+      const result = original.call(this, name, listener)
+      update(this, [name])
+      return result
+    }
+  }
+
+  const { removeAllListeners } = prototype
+  prototype.removeAllListeners = function (this: TrackedEmitter, name?: string | symbol) {
+    // Calling it with an undefined name does not remove every listener.
+    if (name === undefined) {
+      const names = this.eventNames()
+      const result = removeAllListeners.call(this)
+      update(this, names)
+      return result
+    }
+    const result = removeAllListeners.call(this, name)
+    update(this, [name])
+    return result
+  }
+}
@@ -0,0 +1,15 @@
+// Returns a function which calls |getValues| only when |getVersion| changed
+// since its last call. The cached array is shared by the callers, so the ones
+// which hand it out to the app should copy it.
+export function createVersionedCache<T> (getVersion: () => number, getValues: () => T[]) {
+  let version = -1
+  let values: T[] = []
+  return () => {
+    const current = getVersion()
+    if (current !== version) {
+      values = getValues()
+      version = current
+    }
+    return values
+  }
+}
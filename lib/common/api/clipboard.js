@@ -14,6 +14,9 @@ if (process.type === 'renderer') {
     }
   }
 
+  // The data it provides is asked for in the main process.
+  delete clipboard.writeBufferLazily
+
   if (process.platform === 'linux') {
     // On Linux we could not access clipboard in renderer process.
     for (const method of Object.keys(clipboard)) {
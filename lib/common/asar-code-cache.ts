@@ -0,0 +1,114 @@
+import * as crypto from 'crypto'
+import * as fs from 'fs'
+import * as path from 'path'
+import { Script } from 'vm'
+
+const Module = require('module')
+const vm = require('vm')
+const asar = process.electronBinding('asar')
+
+// V8 code caches of the modules required from asar archives, so that the
+// modules of a packaged app are not compiled from scratch on every launch.
+//
+// Each module has one cache file named after the hash of its path, which
+// starts with the hash of the source it was created for. V8 only checks the
+// length of the source, so a changed module of the same length must not use
+// the cache of the old one.
+
+const kSourceHashSize = 32
+
+// The caches are created once the app had the time to run the functions it
+// needs at startup, so they are compiled eagerly on the next launch.
+const kWriteDelay = 10 * 1000
+
+let cacheDir: string | null = null
+const pendingScripts = new Map<string, { sourceHash: Buffer, script: Script }>()
+let writeTimer: NodeJS.Timeout | null = null
+
+const getCacheFile = (filename: string) => {
+  if (cacheDir === null) cacheDir = asar.getCodeCacheDir() as string
+  if (!cacheDir) return null
+  return path.join(cacheDir, crypto.createHash('sha1').update(filename).digest('hex'))
+}
+
+const readCachedData = (file: string, sourceHash: Buffer) => {
+  let data: Buffer
+  try {
+    data = fs.readFileSync(file)
+  } catch {
+    return undefined
+  }
+  if (data.length <= kSourceHashSize || !sourceHash.equals(data.slice(0, kSourceHashSize))) {
+    return undefined
+  }
+  return data.slice(kSourceHashSize)
+}
+
+const writePendingCaches = async () => {
+  writeTimer = null
+  const scripts = [...pendingScripts]
+  pendingScripts.clear()
+  try {
+    await fs.promises.mkdir(cacheDir!, { recursive: true })
+  } catch {
+    return
+  }
+  for (const [file, { sourceHash, script }] of scripts) {
+    // Written through a temporary file, since other processes may read or
+    // write the same cache.
+    const tempFile = `${file}.${process.pid}.tmp`
+    try {
+      await fs.promises.writeFile(tempFile, Buffer.concat([sourceHash, script.createCachedData()]))
+      await fs.promises.rename(tempFile, file)
+    } catch {
+      fs.promises.unlink(tempFile).catch(() => {})
+    }
+  }
+}
+
+const runInThisContext = vm.runInThisContext
+const runWithCodeCache = function (this: any, code: string, options?: any) {
+  // Only the compilation of the module itself uses the cache, not the calls
+  // its code makes.
+  vm.runInThisContext = runInThisContext
+  const filename = options && typeof options === 'object' ? options.filename : undefined
+  if (typeof filename !== 'string' || options.cachedData) {
+    return runInThisContext.apply(this, arguments as any)
+  }
+  const file = getCacheFile(filename)
+  if (!file) return runInThisContext.apply(this, arguments as any)
+
+  const sourceHash = crypto.createHash('sha256').update(code).digest()
+  const cachedData = readCachedData(file, sourceHash)
+  const script = new Script(code, { ...options, cachedData })
+  if (!cachedData || script.cachedDataRejected) {
+    pendingScripts.set(file, { sourceHash, script })
+    if (!writeTimer) {
+      writeTimer = setTimeout(writePendingCaches, kWriteDelay)
+      writeTimer.unref()
+    }
+  }
+  return script.runInThisContext(options)
+}
+
+// Node compiles the modules through vm.runInThisContext once Module.wrapper
+// was set, which the renderers already do. Setting it to a copy of itself
+// keeps the code of the wrapper as it is. vm.runInThisContext is only
+// replaced while Module.prototype._compile compiles a module of an archive,
+// so the other callers of vm do not go through the cache.
+export function enableAsarCodeCache () {
+  Module.wrapper = [...Module.wrapper]
+  const compile = Module.prototype._compile
+  Module.prototype._compile = function (this: any, content: string, filename: string) {
+    if (typeof filename !== 'string' || !asar.splitPath(filename).isAsar) {
+      return compile.apply(this, arguments)
+    }
+    vm.runInThisContext = runWithCodeCache
+    try {
+      return compile.apply(this, arguments)
+    } finally {
+      // Unless the module was compiled another way, it was already restored.
+      if (vm.runInThisContext === runWithCodeCache) vm.runInThisContext = runInThisContext
+    }
+  }
+}
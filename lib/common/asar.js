@@ -229,6 +229,21 @@
       fs.writeSync(logFDs[asarPath], `${offset}: ${filePath}\n`)
     }
 
+    // Reads a packed file synchronously, straight from the memory mapped
+    // archive when possible. Compressed files can only be read natively.
+    const readFromArchive = (archive, filePath, info) => {
+      const mapped = archive.read(filePath)
+      if (mapped || info.compressed) return mapped
+
+      const fd = archive.getFd()
+      if (!(fd >= 0)) return
+
+      const buffer = Buffer.alloc(info.size)
+      archive.recordRead(info.offset, info.size)
+      fs.readSync(fd, buffer, 0, info.size, info.offset)
+      return buffer
+    }
+
     const { lstatSync } = fs
     fs.lstatSync = (pathArgument, options) => {
       const { isAsar, asarPath, filePath } = splitPath(pathArgument)
@@ -520,6 +535,21 @@
         return fs.readFile(realPath, options, callback)
       }
 
+      logASARAccess(asarPath, filePath, info.offset)
+
+      // Compressed files are inflated natively, the fd only has the
+      // compressed bytes.
+      if (info.compressed) {
+        const buffer = archive.read(filePath)
+        if (!buffer) {
+          const error = createError(AsarError.NOT_FOUND, { asarPath, filePath })
+          nextTick(callback, [error])
+          return
+        }
+        nextTick(callback, [null, encoding ? buffer.toString(encoding) : buffer])
+        return
+      }
+
       const buffer = Buffer.alloc(info.size)
       const fd = archive.getFd()
       if (!(fd >= 0)) {
@@ -528,7 +558,7 @@
         return
       }
 
-      logASARAccess(asarPath, filePath, info.offset)
+      archive.recordRead(info.offset, info.size)
       fs.read(fd, buffer, 0, info.size, info.offset, error => {
         callback(error, encoding ? buffer.toString(encoding) : buffer)
       })
@@ -562,12 +592,10 @@
       }
 
       const { encoding } = options
-      const buffer = Buffer.alloc(info.size)
-      const fd = archive.getFd()
-      if (!(fd >= 0)) throw createError(AsarError.NOT_FOUND, { asarPath, filePath })
-
       logASARAccess(asarPath, filePath, info.offset)
-      fs.readSync(fd, buffer, 0, info.size, info.offset)
+
+      const buffer = readFromArchive(archive, filePath, info)
+      if (!buffer) throw createError(AsarError.NOT_FOUND, { asarPath, filePath })
       return (encoding) ? buffer.toString(encoding) : buffer
     }
 
@@ -633,15 +661,31 @@
         return fs.readFileSync(realPath, { encoding: 'utf8' })
       }
 
-      const buffer = Buffer.alloc(info.size)
-      const fd = archive.getFd()
-      if (!(fd >= 0)) return
-
       logASARAccess(asarPath, filePath, info.offset)
-      fs.readSync(fd, buffer, 0, info.size, info.offset)
+
+      const buffer = readFromArchive(archive, filePath, info)
+      if (!buffer) return
       return buffer.toString('utf8')
     }
 
+    // Module resolution stats thousands of paths at startup, so the types of
+    // all entries of an archive are fetched in one call on first use. Paths
+    // through links are not in the cache and fall back to archive.stat.
+    const moduleStatCaches = new Map()
+
+    const getModuleStatCache = (asarPath, archive) => {
+      let cache = moduleStatCaches.get(asarPath)
+      if (!cache) {
+        cache = new Map([['', 1]])
+        const entries = archive.walk('') || []
+        for (const entry of entries) {
+          cache.set(entry.path, entry.isDirectory ? 1 : 0)
+        }
+        moduleStatCaches.set(asarPath, cache)
+      }
+      return cache
+    }
+
     const { internalModuleStat } = internalBinding('fs')
     internalBinding('fs').internalModuleStat = pathArgument => {
       const { isAsar, asarPath, filePath } = splitPath(pathArgument)
@@ -651,6 +695,9 @@
       const archive = getOrCreateArchive(asarPath)
       if (!archive) return -34
 
+      const type = getModuleStatCache(asarPath, archive).get(filePath)
+      if (type !== undefined) return type
+
       // -ENOENT
       const stats = archive.stat(filePath)
       if (!stats) return -34
@@ -21,15 +21,20 @@ class CrashReporter {
       extra = {},
       ignoreSystemCrashHandler = false,
       submitURL,
-      uploadToServer = true
+      uploadToServer = true,
+      compress = false,
+      dumpProfile = 'full',
+      deferUploads = false
     } = options
 
     if (companyName == null) throw new Error('companyName is a required option to crashReporter.start')
     if (submitURL == null) throw new Error('submitURL is a required option to crashReporter.start')
+    if (dumpProfile !== 'full' && dumpProfile !== 'small') throw new Error('dumpProfile must be \'full\' or \'small\'')
 
     const ret = this.init({
       submitURL,
-      productName
+      productName,
+      deferUploads: Boolean(deferUploads)
     })
 
     this.productName = ret.productName
@@ -39,6 +44,9 @@ class CrashReporter {
     if (extra._companyName == null) extra._companyName = companyName
     if (extra._version == null) extra._version = ret.appVersion
 
+    // The main process decides for all the processes whether it uploads
+    // their reports.
+    binding._setDumpOptions(Boolean(compress), dumpProfile === 'small', ret.deferUploads)
     binding.start(ret.productName, companyName, submitURL, ret.crashesDirectory, uploadToServer, ignoreSystemCrashHandler, extra)
   }
 
@@ -0,0 +1,192 @@
+// Buffers the messages of an IPC sender, and ships them as one IPC call at the
+// next microtask checkpoint or task boundary.
+
+export type SendBatch = (channels: string[], args: any[][], asArrays: boolean) => void
+
+export class IpcBatcher {
+  private channels: Set<string> | null
+  private flushMode: string
+  private asArrays: boolean
+  private pendingChannels: string[] = []
+  private pendingArgs: any[][] = []
+  private scheduled = false
+
+  constructor (options: Electron.IpcBatchingOptions = {}, private sendBatch: SendBatch) {
+    const { channels, flush = 'microtask', deliverAs = 'events' } = options
+    if (flush !== 'microtask' && flush !== 'task') {
+      throw new Error(`Invalid flush mode '${flush}'`)
+    }
+    if (deliverAs !== 'events' && deliverAs !== 'array') {
+      throw new Error(`Invalid delivery mode '${deliverAs}'`)
+    }
+    this.channels = channels ? new Set(channels) : null
+    this.flushMode = flush
+    this.asArrays = deliverAs === 'array'
+  }
+
+  accepts (channel: string) {
+    return !this.channels || this.channels.has(channel)
+  }
+
+  push (channel: string, args: any[]) {
+    this.pendingChannels.push(channel)
+    this.pendingArgs.push(args)
+    if (this.scheduled) return
+    this.scheduled = true
+    const flush = () => this.flush()
+    if (this.flushMode === 'microtask') {
+      Promise.resolve().then(flush)
+    } else if (typeof setImmediate === 'function') {
+      setImmediate(flush)
+    } else {
+      setTimeout(flush, 0)
+    }
+  }
+
+  // Sends the pending messages now, which keeps them ahead of messages that
+  // are not batched.
+  flush () {
+    this.scheduled = false
+    if (this.pendingChannels.length === 0) return
+    const channels = this.pendingChannels
+    const args = this.pendingArgs
+    this.pendingChannels = []
+    this.pendingArgs = []
+    this.sendBatch(channels, args, this.asArrays)
+  }
+}
+
+// Emits a batch the way the sender asked for: either one event per message, or
+// one event per channel with the arguments of all its messages.
+export const emitBatch = function (
+  emit: (channel: string, ...args: any[]) => void,
+  channels: string[], args: any[][], asArrays: boolean
+) {
+  if (!asArrays) {
+    for (let i = 0; i < channels.length; i++) {
+      emit(channels[i], ...args[i])
+    }
+    return
+  }
+  const grouped = new Map<string, any[][]>()
+  for (let i = 0; i < channels.length; i++) {
+    const messages = grouped.get(channels[i])
+    if (messages) {
+      messages.push(args[i])
+    } else {
+      grouped.set(channels[i], [args[i]])
+    }
+  }
+  for (const [channel, messages] of grouped) {
+    emit(channel, messages)
+  }
+}
+
+// The listeners which get the messages of a channel that were delivered
+// together all at once, as an array of their arguments.
+const batchListeners = new WeakMap<NodeJS.EventEmitter, Map<string, Set<Function>>>()
+
+export const addBatchListener = function (
+  emitter: NodeJS.EventEmitter, channel: string, listener: Function
+) {
+  let listeners = batchListeners.get(emitter)
+  if (!listeners) {
+    listeners = new Map()
+    batchListeners.set(emitter, listeners)
+  }
+  const channelListeners = listeners.get(channel)
+  if (channelListeners) {
+    channelListeners.add(listener)
+  } else {
+    listeners.set(channel, new Set([listener]))
+  }
+}
+
+// Removes |listener|, all the listeners of |channel| when it is not given, or
+// all the listeners when neither is.
+export const removeBatchListener = function (
+  emitter: NodeJS.EventEmitter, channel?: string, listener?: Function
+) {
+  const listeners = batchListeners.get(emitter)
+  if (!listeners) return
+  if (channel === undefined) {
+    listeners.clear()
+  } else if (listener === undefined) {
+    listeners.delete(channel)
+  } else {
+    const channelListeners = listeners.get(channel)
+    if (!channelListeners) return
+    channelListeners.delete(listener)
+    if (channelListeners.size === 0) listeners.delete(channel)
+  }
+}
+
+// Calls |listener|, and reports what it throws in a task of its own, so the
+// messages delivered together with the one it handles are still emitted.
+const dispatch = function (listener: () => void) {
+  try {
+    listener()
+  } catch (error) {
+    setTimeout(() => { throw error })
+  }
+}
+
+// Calls the batch listeners of each channel once with the messages of the
+// channel that were delivered together by each sender.
+export const emitToBatchListeners = function (
+  emitter: NodeJS.EventEmitter, channels: string[], args: any[][], senderIds: number[]
+) {
+  const listeners = batchListeners.get(emitter)
+  if (!listeners || listeners.size === 0) return
+  const grouped = new Map<string, Map<number, any[][]>>()
+  for (let i = 0; i < channels.length; i++) {
+    if (!listeners.has(channels[i])) continue
+    let senders = grouped.get(channels[i])
+    if (!senders) {
+      senders = new Map()
+      grouped.set(channels[i], senders)
+    }
+    const messages = senders.get(senderIds[i])
+    if (messages) {
+      messages.push(args[i])
+    } else {
+      senders.set(senderIds[i], [args[i]])
+    }
+  }
+  for (const [channel, senders] of grouped) {
+    for (const [senderId, messages] of senders) {
+      const channelListeners = listeners.get(channel)
+      if (!channelListeners) break
+      const event = { sender: emitter, senderId }
+      // Copied, since a listener may remove itself.
+      for (const listener of [...channelListeners]) {
+        dispatch(() => listener(event, messages))
+      }
+    }
+  }
+}
+
+// Emits the messages the renderer received in one task, each from the emitter
+// it was sent to and with the id of its own sender. At most one event is
+// emitted to each batch listener for each sender.
+export const emitMessages = function (
+  emitter: NodeJS.EventEmitter, internalEmitter: NodeJS.EventEmitter,
+  internal: boolean[], channels: string[], args: any[][], senderIds: number[]
+) {
+  const batchChannels: string[] = []
+  const batchArgs: any[][] = []
+  const batchSenderIds: number[] = []
+  for (let i = 0; i < channels.length; i++) {
+    const sender = internal[i] ? internalEmitter : emitter
+    dispatch(() => {
+      sender.emit(channels[i], { sender, senderId: senderIds[i] }, ...args[i])
+    })
+    if (!internal[i]) {
+      batchChannels.push(channels[i])
+      batchArgs.push(args[i])
+      batchSenderIds.push(senderIds[i])
+    }
+  }
+  if (batchChannels.length === 0) return
+  emitToBatchListeners(emitter, batchChannels, batchArgs, batchSenderIds)
+}
@@ -0,0 +1,16 @@
+// Wraps a sandboxed preload script into a function executed in global scope.
+// It won't have access to the current scope, so a few objects are exposed as
+// arguments:
+//
+// - `require`: The `preloadRequire` function
+// - `process`: The `preloadProcess` object
+// - `Buffer`: Shim of `Buffer` implementation
+// - `global`: The window object, which is aliased to `global` by webpack.
+//
+// The browser process builds the code caches of preload scripts from the same
+// wrapper, since V8 only accepts a cache for the exact source it was made for.
+export function wrapPreloadSource (preloadSrc: string) {
+  return `(function(require, process, Buffer, global, setImmediate, clearImmediate, exports) {
+  ${preloadSrc}
+  })`
+}
@@ -8,10 +8,11 @@ const checkContextIsolationEnabled = () => {
 }
 
 const contextBridge = {
-  exposeInMainWorld: (key: string, api: Record<string, any>) => {
+  exposeInMainWorld: (key: string, api: Record<string, any>, options: { lazy?: boolean } = {}) => {
     checkContextIsolationEnabled()
-    return binding.exposeAPIInMainWorld(key, api)
+    return binding.exposeAPIInMainWorld(key, api, !!options.lazy)
   },
+  getStats: () => binding.getStats({}),
   debugGC: () => binding._debugGCMaps({})
 }
 
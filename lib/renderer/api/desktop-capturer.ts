@@ -19,6 +19,16 @@ function getCurrentStack () {
   return (target as any).stack
 }
 
+const toSource = (source: ElectronInternal.GetSourcesResult) => ({
+  id: source.id,
+  name: source.name,
+  thumbnail: source.thumbnail ? nativeImage.createFromDataURL(source.thumbnail) : nativeImage.createEmpty(),
+  display_id: source.display_id,
+  appIcon: source.appIcon ? nativeImage.createFromDataURL(source.appIcon) : null
+})
+
+let nextStreamId = 0
+
 export async function getSources (options: Electron.SourcesOptions) {
   if (!isValid(options)) throw new Error('Invalid options')
 
@@ -27,19 +37,38 @@ export async function getSources (options: Electron.SourcesOptions) {
 
   const { thumbnailSize = { width: 150, height: 150 } } = options
   const { fetchWindowIcons = false } = options
+  const { onSourceAdded, onThumbnailChanged } = options
+
+  // The sources are streamed as they are found when a callback is given.
+  const streaming = typeof onSourceAdded === 'function' || typeof onThumbnailChanged === 'function'
+  const streamId = streaming ? ++nextStreamId : undefined
 
-  const sources = await ipcRendererInternal.invoke<ElectronInternal.GetSourcesResult[]>('ELECTRON_BROWSER_DESKTOP_CAPTURER_GET_SOURCES', {
-    captureWindow,
-    captureScreen,
-    thumbnailSize,
-    fetchWindowIcons
-  } as ElectronInternal.GetSourcesOptions, getCurrentStack())
-
-  return sources.map(source => ({
-    id: source.id,
-    name: source.name,
-    thumbnail: nativeImage.createFromDataURL(source.thumbnail),
-    display_id: source.display_id,
-    appIcon: source.appIcon ? nativeImage.createFromDataURL(source.appIcon) : null
-  }))
+  const sourceAddedListener = (_event: Electron.IpcRendererEvent, id: number, source: ElectronInternal.GetSourcesResult) => {
+    if (id === streamId && typeof onSourceAdded === 'function') onSourceAdded(toSource(source))
+  }
+  const thumbnailChangedListener = (_event: Electron.IpcRendererEvent, id: number, sourceId: string, thumbnail: Buffer) => {
+    if (id === streamId && typeof onThumbnailChanged === 'function') onThumbnailChanged(sourceId, thumbnail)
+  }
+  if (streaming) {
+    ipcRendererInternal.on('ELECTRON_RENDERER_DESKTOP_CAPTURER_SOURCE_ADDED', sourceAddedListener)
+    ipcRendererInternal.on('ELECTRON_RENDERER_DESKTOP_CAPTURER_THUMBNAIL_CHANGED', thumbnailChangedListener)
+  }
+
+  try {
+    const sources = await ipcRendererInternal.invoke<ElectronInternal.GetSourcesResult[]>('ELECTRON_BROWSER_DESKTOP_CAPTURER_GET_SOURCES', {
+      captureWindow,
+      captureScreen,
+      thumbnailSize,
+      fetchWindowIcons,
+      streamId,
+      streamThumbnails: typeof onThumbnailChanged === 'function'
+    } as ElectronInternal.GetSourcesOptions, getCurrentStack())
+
+    return sources.map(toSource)
+  } finally {
+    if (streaming) {
+      ipcRendererInternal.removeListener('ELECTRON_RENDERER_DESKTOP_CAPTURER_SOURCE_ADDED', sourceAddedListener)
+      ipcRendererInternal.removeListener('ELECTRON_RENDERER_DESKTOP_CAPTURER_THUMBNAIL_CHANGED', thumbnailChangedListener)
+    }
+  }
 }
@@ -1,3 +1,7 @@
+import { IpcBatcher, addBatchListener, removeBatchListener } from '@electron/internal/common/ipc-batcher'
+import { IpcRendererChannel } from '@electron/internal/renderer/ipc-renderer-channel'
+import { IpcRingBuffer } from '@electron/internal/renderer/ipc-ring-buffer'
+
 const { ipc } = process.electronBinding('ipc')
 const v8Util = process.electronBinding('v8_util')
 
@@ -5,28 +9,162 @@ const v8Util = process.electronBinding('v8_util')
 const ipcRenderer = v8Util.getHiddenValue<Electron.IpcRenderer>(global, 'ipc')
 const internal = false
 
+let batcher: IpcBatcher | null = null
+let syncDeadline = 0
+
+// The IDs of the channels registered with registerChannel(), which the
+// browser assigns in the same order.
+const channelIds = new Map<string, number>()
+
+// Channels whose messages are sent over the priority lane.
+const highPriorityChannels = new Set<string>()
+
+// Messages that are not batched must not overtake the batched ones.
+const flushBatch = function () {
+  if (batcher) batcher.flush()
+}
+
+ipcRenderer.onBatch = function (channel, listener) {
+  addBatchListener(ipcRenderer, channel, listener)
+  return ipcRenderer
+}
+
+const { removeListener, removeAllListeners } = ipcRenderer
+
+ipcRenderer.removeListener = function (channel: string, listener: (...args: any[]) => void) {
+  removeBatchListener(ipcRenderer, channel, listener)
+  return removeListener.call(ipcRenderer, channel, listener)
+}
+ipcRenderer.off = ipcRenderer.removeListener
+
+ipcRenderer.removeAllListeners = function (...args: [string?]) {
+  removeBatchListener(ipcRenderer, ...args)
+  return removeAllListeners.apply(ipcRenderer, args)
+}
+
 ipcRenderer.send = function (channel, ...args) {
-  return ipc.send(internal, channel, args)
+  // High priority messages are meant to overtake the others, so they neither
+  // get batched nor wait for the pending batch.
+  if (highPriorityChannels.has(channel)) {
+    return ipc.send(internal, channel, args, true)
+  }
+  if (batcher) {
+    if (batcher.accepts(channel)) return batcher.push(channel, args)
+    batcher.flush()
+  }
+  return ipc.send(internal, channel, args, false)
+}
+
+ipcRenderer.registerChannel = function (channel) {
+  if (typeof channel !== 'string') {
+    throw new Error('Missing required channel argument')
+  }
+  let id = channelIds.get(channel)
+  if (id === undefined) {
+    id = channelIds.size
+    ipc.registerChannel(id, channel)
+    channelIds.set(channel, id)
+  }
+  return id
+}
+
+ipcRenderer.sendById = function (channelId, ...args) {
+  // An unknown ID would make the browser kill the renderer.
+  if (!Number.isInteger(channelId) || channelId < 0 || channelId >= channelIds.size) {
+    throw new Error(`Unknown channel ID ${channelId}`)
+  }
+  flushBatch()
+  return ipc.sendById(channelId, args)
+}
+
+ipcRenderer.sendWithTransfer = function (channel, transfer, ...args) {
+  flushBatch()
+  return ipc.sendWithTransfer(internal, channel, args, transfer)
 }
 
 ipcRenderer.sendSync = function (channel, ...args) {
+  flushBatch()
+  if (syncDeadline > 0) {
+    return ipc.sendSyncWithDeadline(internal, channel, args, syncDeadline)[0]
+  }
   return ipc.sendSync(internal, channel, args)[0]
 }
 
+ipcRenderer.setSyncDeadline = function (milliseconds) {
+  if (typeof milliseconds !== 'number' || !(milliseconds >= 0)) {
+    throw new Error('The deadline must be a non-negative number')
+  }
+  syncDeadline = milliseconds
+}
+
 ipcRenderer.sendToHost = function (channel, ...args) {
+  flushBatch()
   return ipc.sendToHost(channel, args)
 }
 
 ipcRenderer.sendTo = function (webContentsId, channel, ...args) {
+  flushBatch()
   return ipc.sendTo(internal, false, webContentsId, channel, args)
 }
 
+ipcRenderer.setChannelPriority = function (channel, priority) {
+  if (priority === 'high') {
+    ipc.bindPriorityLane()
+    highPriorityChannels.add(channel)
+  } else if (priority === 'normal') {
+    highPriorityChannels.delete(channel)
+  } else {
+    throw new Error(`Invalid priority '${priority}'`)
+  }
+}
+
+ipcRenderer.enableBatching = function (options) {
+  const newBatcher = new IpcBatcher(options, (channels, args, asArrays) => {
+    ipc.sendBatch(internal, channels, args, asArrays)
+  })
+  flushBatch()
+  batcher = newBatcher
+}
+
+ipcRenderer.disableBatching = function () {
+  flushBatch()
+  batcher = null
+}
+
 ipcRenderer.invoke = async function (channel, ...args) {
-  const { error, result } = await ipc.invoke(internal, channel, args)
+  const highPriority = highPriorityChannels.has(channel)
+  if (!highPriority) flushBatch()
+  const { error, result } = await ipc.invoke(internal, channel, args, highPriority)
   if (error) {
     throw new Error(`Error invoking remote method '${channel}': ${error}`)
   }
   return result
 }
 
+ipcRenderer.invokeWithTransfer = async function (channel, transfer, ...args) {
+  flushBatch()
+  const { error, result } = await ipc.invokeWithTransfer(internal, channel, args, transfer)
+  if (error) {
+    throw new Error(`Error invoking remote method '${channel}': ${error}`)
+  }
+  return result
+}
+
+ipcRenderer.openChannel = async function (webContentsId, channel) {
+  const handle = await ipc.openChannel(webContentsId, channel)
+  if (!handle) {
+    throw new Error(`Could not open channel '${channel}' to WebContents ${webContentsId}`)
+  }
+  return new IpcRendererChannel(handle)
+}
+
+ipcRenderer.openRingBuffer = async function (channel, options = {}) {
+  const { capacity = 1024 * 1024, doorbell = 'frame' } = options
+  const handle = await ipc.openRingBuffer(channel, capacity)
+  if (!handle) {
+    throw new Error(`Could not open ring buffer with capacity ${capacity} on '${channel}'`)
+  }
+  return new IpcRingBuffer(handle, doorbell)
+}
+
 export default ipcRenderer
@@ -31,6 +31,40 @@ process.on('exit', () => {
   ipcRendererInternal.send(command, contextId)
 })
 
+// The properties set in a remote.batch(), which are sent before any other
+// command.
+let pendingSets = null
+
+const flushPendingSets = () => {
+  if (!pendingSets || pendingSets.length === 0) return
+  const sets = pendingSets
+  pendingSets = []
+  const meta = ipcRendererInternal.sendSync('ELECTRON_BROWSER_MEMBER_SET_BATCH', contextId, sets)
+  if (meta != null) metaToValue(meta)
+}
+
+const sendSync = (command, ...args) => {
+  flushPendingSets()
+  return ipcRendererInternal.sendSync(command, ...args)
+}
+
+// The property values prefetched by remote.prefetch(), by remote object, which
+// are only used by the code running synchronously since they may change.
+let prefetchedMembers = null
+
+const getPrefetchedMembers = (object) => {
+  if (!prefetchedMembers) {
+    prefetchedMembers = new WeakMap()
+    Promise.resolve().then(() => { prefetchedMembers = null })
+  }
+  let members = prefetchedMembers.get(object)
+  if (!members) {
+    members = new Map()
+    prefetchedMembers.set(object, members)
+  }
+  return members
+}
+
 // Convert the arguments object into an array of meta data.
 function wrapArgs (args, visited = new Set()) {
   const valueToMeta = (value) => {
@@ -129,7 +163,7 @@ function setObjectMembers (ref, object, metaId, members) {
         } else {
           command = 'ELECTRON_BROWSER_MEMBER_CALL'
         }
-        const ret = ipcRendererInternal.sendSync(command, contextId, metaId, member.name, wrapArgs(args))
+        const ret = sendSync(command, contextId, metaId, member.name, wrapArgs(args))
         return metaToValue(ret)
       }
 
@@ -145,18 +179,29 @@ function setObjectMembers (ref, object, metaId, members) {
         return value
       }
       descriptor.configurable = true
+    } else if (member.type === 'get' && 'value' in member) {
+      // The value can not change.
+      descriptor.get = () => member.value
     } else if (member.type === 'get') {
       descriptor.get = () => {
+        const prefetched = prefetchedMembers && prefetchedMembers.get(ref)
+        if (prefetched && prefetched.has(member.name)) return prefetched.get(member.name)
         const command = 'ELECTRON_BROWSER_MEMBER_GET'
-        const meta = ipcRendererInternal.sendSync(command, contextId, metaId, member.name)
+        const meta = sendSync(command, contextId, metaId, member.name)
         return metaToValue(meta)
       }
 
       if (member.writable) {
         descriptor.set = (value) => {
+          const prefetched = prefetchedMembers && prefetchedMembers.get(ref)
+          if (prefetched) prefetched.delete(member.name)
           const args = wrapArgs([value])
+          if (pendingSets) {
+            pendingSets.push({ id: metaId, name: member.name, args })
+            return value
+          }
           const command = 'ELECTRON_BROWSER_MEMBER_SET'
-          const meta = ipcRendererInternal.sendSync(command, contextId, metaId, member.name, args)
+          const meta = sendSync(command, contextId, metaId, member.name, args)
           if (meta != null) metaToValue(meta)
           return value
         }
@@ -186,7 +231,7 @@ function proxyFunctionProperties (remoteMemberFunction, metaId, name) {
     if (loaded) return
     loaded = true
     const command = 'ELECTRON_BROWSER_MEMBER_GET'
-    const meta = ipcRendererInternal.sendSync(command, contextId, metaId, name)
+    const meta = sendSync(command, contextId, metaId, name)
     setObjectMembers(remoteMemberFunction, remoteMemberFunction, meta.id, meta.members)
   }
 
@@ -246,7 +291,7 @@ function metaToValue (meta) {
         } else {
           command = 'ELECTRON_BROWSER_FUNCTION_CALL'
         }
-        const obj = ipcRendererInternal.sendSync(command, contextId, meta.id, wrapArgs(args))
+        const obj = sendSync(command, contextId, meta.id, wrapArgs(args))
         return metaToValue(obj)
       }
       ret = remoteFunction
@@ -267,6 +312,18 @@ function metaToValue (meta) {
   }
 }
 
+// Converts the prefetched metas of the properties of |object|, which takes
+// the references the browser added for the remote objects among them.
+function setPrefetchedMembers (object, metas) {
+  const members = getPrefetchedMembers(object)
+  for (const name of Object.keys(metas)) {
+    const meta = metas[name]
+    const value = metaToValue(meta)
+    if (meta.prefetched) setPrefetchedMembers(value, meta.prefetched)
+    members.set(name, value)
+  }
+}
+
 function metaToError (meta) {
   const obj = meta.value
   for (const { name, value } of meta.members) {
@@ -301,44 +358,77 @@ handleMessage('ELECTRON_RENDERER_CALLBACK', (id, args) => {
   callbacksRegistry.apply(id, metaToValue(args))
 })
 
-// A callback in browser is released.
-handleMessage('ELECTRON_RENDERER_RELEASE_CALLBACK', (id) => {
-  callbacksRegistry.remove(id)
+// The callbacks in browser which were released in one task.
+handleMessage('ELECTRON_RENDERER_RELEASE_CALLBACKS', (...ids) => {
+  for (const id of ids) callbacksRegistry.remove(id)
 })
 
 exports.require = (module) => {
   const command = 'ELECTRON_BROWSER_REQUIRE'
-  const meta = ipcRendererInternal.sendSync(command, contextId, module, getCurrentStack())
+  const meta = sendSync(command, contextId, module, getCurrentStack())
   return metaToValue(meta)
 }
 
 // Alias to remote.require('electron').xxx.
 exports.getBuiltin = (module) => {
   const command = 'ELECTRON_BROWSER_GET_BUILTIN'
-  const meta = ipcRendererInternal.sendSync(command, contextId, module, getCurrentStack())
+  const meta = sendSync(command, contextId, module, getCurrentStack())
   return metaToValue(meta)
 }
 
 exports.getCurrentWindow = () => {
   const command = 'ELECTRON_BROWSER_CURRENT_WINDOW'
-  const meta = ipcRendererInternal.sendSync(command, contextId, getCurrentStack())
+  const meta = sendSync(command, contextId, getCurrentStack())
   return metaToValue(meta)
 }
 
 // Get current WebContents object.
 exports.getCurrentWebContents = () => {
   const command = 'ELECTRON_BROWSER_CURRENT_WEB_CONTENTS'
-  const meta = ipcRendererInternal.sendSync(command, contextId, getCurrentStack())
+  const meta = sendSync(command, contextId, getCurrentStack())
   return metaToValue(meta)
 }
 
 // Get a global object in browser.
 exports.getGlobal = (name) => {
   const command = 'ELECTRON_BROWSER_GLOBAL'
-  const meta = ipcRendererInternal.sendSync(command, contextId, name, getCurrentStack())
+  const meta = sendSync(command, contextId, name, getCurrentStack())
   return metaToValue(meta)
 }
 
+// Fetch the properties of a remote object, and of the objects they hold down
+// to |depth| levels, in one round-trip. Reading them before the code running
+// yields or awaits does not need another one.
+exports.prefetch = (object, depth = 1) => {
+  const id = object != null ? v8Util.getHiddenValue(object, 'atomId') : undefined
+  if (id == null) {
+    throw new TypeError('Expected a remote object')
+  }
+  if (!Number.isInteger(depth) || depth < 1) {
+    throw new TypeError('depth must be a positive integer')
+  }
+  const command = 'ELECTRON_BROWSER_MEMBER_PREFETCH'
+  const meta = sendSync(command, contextId, id, depth)
+  setPrefetchedMembers(object, metaToValue(meta))
+  return object
+}
+
+// Send the properties set while |fn| runs in one round-trip, before the next
+// command that needs an answer from the browser.
+exports.batch = (fn) => {
+  if (pendingSets) return fn()
+  pendingSets = []
+  try {
+    return fn()
+  } finally {
+    try {
+      flushPendingSets()
+    } finally {
+      pendingSets = null
+    }
+  }
+}
+
 // Get the process object in browser.
 Object.defineProperty(exports, 'process', {
   get: () => exports.getGlobal('process')
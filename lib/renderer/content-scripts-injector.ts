@@ -3,6 +3,7 @@ import { webFrame } from 'electron'
 import * as ipcRendererUtils from '@electron/internal/renderer/ipc-renderer-internal-utils'
 
 const v8Util = process.electronBinding('v8_util')
+const webFrameBinding = process.electronBinding('web_frame')
 
 const IsolatedWorldIDs = {
   /**
@@ -25,17 +26,22 @@ const escapePattern = function (pattern: string) {
   return pattern.replace(/[\\^$+?.()|[\]{}]/g, '\\$&')
 }
 
+const patternRegExps = new Map<string, RegExp>()
+
 // Check whether pattern matches.
 // https://developer.chrome.com/extensions/match_patterns
-const matchesPattern = function (pattern: string) {
+const matchesPattern = function (url: string, pattern: string) {
   if (pattern === '<all_urls>') return true
-  const regexp = new RegExp(`^${pattern.split('*').map(escapePattern).join('.*')}$`)
-  const url = `${location.protocol}//${location.host}${location.pathname}`
-  return url.match(regexp)
+  let regexp = patternRegExps.get(pattern)
+  if (!regexp) {
+    regexp = new RegExp(`^${pattern.split('*').map(escapePattern).join('.*')}$`)
+    patternRegExps.set(pattern, regexp)
+  }
+  return regexp.test(url)
 }
 
-// Run the code with chrome API integrated.
-const runContentScript = function (this: any, extensionId: string, url: string, code: string) {
+// Set up the isolated world of the extension, with chrome API integrated.
+const getWorldId = function (extensionId: string) {
   // Assign unique world ID to each extension
   const worldId = extensionWorldId[extensionId] ||
     (extensionWorldId[extensionId] = getIsolatedWorldIdForInstance())
@@ -49,13 +55,21 @@ const runContentScript = function (this: any, extensionId: string, url: string,
     // csp: manifest.content_security_policy,
   })
 
+  return worldId
+}
+
+// Run the code with chrome API integrated.
+const runContentScript = function (this: any, extensionId: string, url: string, code: string) {
   const sources = [{ code, url }]
-  return webFrame.executeJavaScriptInIsolatedWorld(worldId, sources)
+  return webFrame.executeJavaScriptInIsolatedWorld(getWorldId(extensionId), sources)
 }
 
+// The content scripts of the manifests are compiled once per renderer
+// process, the other frames use the code cache.
 const runAllContentScript = function (scripts: Array<Electron.InjectionBase>, extensionId: string) {
+  const worldId = getWorldId(extensionId)
   for (const { url, code } of scripts) {
-    runContentScript.call(window, extensionId, url, code)
+    webFrameBinding._executeContentScript(window, worldId, url, code)
   }
 }
 
@@ -73,7 +87,8 @@ const runAllStylesheet = function (css: Array<Electron.InjectionBase>) {
 // https://developer.chrome.com/extensions/content_scripts
 const injectContentScript = function (extensionId: string, script: Electron.ContentScript) {
   if (!process.isMainFrame && !script.allFrames) return
-  if (!script.matches.some(matchesPattern)) return
+  const url = `${location.protocol}//${location.host}${location.pathname}`
+  if (!script.matches.some(pattern => matchesPattern(url, pattern))) return
 
   if (script.js) {
     const fire = runAllContentScript.bind(window, script.js, extensionId)
@@ -1,6 +1,9 @@
 import { EventEmitter } from 'events'
 import * as path from 'path'
 
+import { emitBatch, emitMessages, emitToBatchListeners } from '@electron/internal/common/ipc-batcher'
+import { IpcRendererChannel } from '@electron/internal/renderer/ipc-renderer-channel'
+
 const Module = require('module')
 
 // Make sure globals like "process" and "global" are always available in preload
@@ -48,6 +51,21 @@ v8Util.setHiddenValue(global, 'ipcNative', {
   onMessage (internal: boolean, channel: string, args: any[], senderId: number) {
     const sender = internal ? ipcInternalEmitter : ipcEmitter
     sender.emit(channel, { sender, senderId }, ...args)
+    if (!internal) emitToBatchListeners(sender, [channel], [args], [senderId])
+  },
+  onMessages (internal: boolean[], channels: string[], args: any[][], senderIds: number[]) {
+    emitMessages(ipcEmitter, ipcInternalEmitter, internal, channels, args, senderIds)
+  },
+  onMessageBatch (internal: boolean, channels: string[], args: any[][], asArrays: boolean, senderId: number) {
+    const sender = internal ? ipcInternalEmitter : ipcEmitter
+    const event = { sender, senderId }
+    emitBatch((channel, ...messageArgs) => {
+      sender.emit(channel, event, ...messageArgs)
+    }, channels, args, asArrays)
+    if (!internal) emitToBatchListeners(sender, channels, args, channels.map(() => senderId))
+  },
+  onPeerChannel (channel: string, handle: any, senderId: number) {
+    ipcEmitter.emit(channel, { sender: ipcEmitter, senderId, peer: new IpcRendererChannel(handle) })
   }
 })
 
@@ -198,7 +216,11 @@ if (nodeIntegration) {
   }
 }
 
+// Cache the code of the modules required from archives.
+require('@electron/internal/common/asar-code-cache').enableAsarCodeCache()
+
 // Load the preload scripts.
+v8Util.beginStartupPhase('preload')
 for (const preloadScript of preloadScripts) {
   try {
     Module._load(preloadScript)
@@ -209,6 +231,7 @@ for (const preloadScript of preloadScripts) {
     ipcRendererInternal.send('ELECTRON_BROWSER_PRELOAD_ERROR', preloadScript, error)
   }
 }
+v8Util.endStartupPhase('preload')
 
 // Warn about security issues
 if (process.isMainFrame) {
@@ -0,0 +1,29 @@
+import { EventEmitter } from 'events'
+
+// Wraps the native end of a channel opened with ipcRenderer.openChannel().
+export class IpcRendererChannel extends EventEmitter implements Electron.IpcRendererChannel {
+  private handle: any
+
+  constructor (handle: any) {
+    super()
+    this.handle = handle
+    handle._onmessage = (args: any[]) => {
+      this.emit('message', { sender: this }, ...args)
+    }
+    handle._onclose = () => {
+      this.emit('close')
+    }
+    // Like a MessagePort, messages are queued until someone listens for them.
+    this.on('newListener', (event: string) => {
+      if (event === 'message') handle.start()
+    })
+  }
+
+  send (...args: any[]) {
+    this.handle.send(args)
+  }
+
+  close () {
+    this.handle.close()
+  }
+}
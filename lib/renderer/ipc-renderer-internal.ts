@@ -6,7 +6,7 @@ export const ipcRendererInternal = v8Util.getHiddenValue<Electron.IpcRendererInt
 const internal = true
 
 ipcRendererInternal.send = function (channel, ...args) {
-  return ipc.send(internal, channel, args)
+  return ipc.send(internal, channel, args, false)
 }
 
 ipcRendererInternal.sendSync = function (channel, ...args) {
@@ -22,7 +22,7 @@ ipcRendererInternal.sendToAll = function (webContentsId, channel, ...args) {
 }
 
 ipcRendererInternal.invoke = async function<T> (channel: string, ...args: any[]) {
-  const { error, result } = await ipc.invoke<T>(internal, channel, args)
+  const { error, result } = await ipc.invoke<T>(internal, channel, args, false)
   if (error) {
     throw new Error(`Error invoking remote method '${channel}': ${error}`)
   }
@@ -0,0 +1,51 @@
+// Wraps the native producer end of a ring buffer opened with
+// ipcRenderer.openRingBuffer().
+export class IpcRingBuffer implements Electron.IpcRingBuffer {
+  private handle: any
+  private doorbell: string
+  private notifyScheduled = false
+
+  constructor (handle: any, doorbell: string) {
+    this.handle = handle
+    this.doorbell = doorbell
+  }
+
+  get capacity (): number {
+    return this.handle.capacity
+  }
+
+  write (record: ArrayBufferView) {
+    if (this.handle.write(record)) {
+      if (this.doorbell === 'frame') this.scheduleNotify()
+      return true
+    }
+    // The buffer is full, let the main process drain it right away.
+    this.notify()
+    return false
+  }
+
+  notify () {
+    this.notifyScheduled = false
+    this.handle.notify()
+  }
+
+  close () {
+    this.notifyScheduled = false
+    this.handle.close()
+  }
+
+  // Rings the doorbell once per frame, however many records were written.
+  private scheduleNotify () {
+    if (this.notifyScheduled) return
+    this.notifyScheduled = true
+    const notify = () => {
+      if (this.notifyScheduled) this.notify()
+    }
+    // Hidden pages do not get animation frames.
+    if (typeof requestAnimationFrame === 'function' && document.visibilityState === 'visible') {
+      requestAnimationFrame(notify)
+    } else {
+      setTimeout(notify, 16)
+    }
+  }
+}
@@ -289,4 +289,5 @@ WebViewImpl.prototype.setupWebViewAttributes = function () {
   this.attributes[WEB_VIEW_CONSTANTS.ATTRIBUTE_BLINKFEATURES] = new BlinkFeaturesAttribute(this)
   this.attributes[WEB_VIEW_CONSTANTS.ATTRIBUTE_DISABLEBLINKFEATURES] = new DisableBlinkFeaturesAttribute(this)
   this.attributes[WEB_VIEW_CONSTANTS.ATTRIBUTE_WEBPREFERENCES] = new WebPreferencesAttribute(this)
+  this.attributes[WEB_VIEW_CONSTANTS.ATTRIBUTE_LAZY] = new BooleanAttribute(WEB_VIEW_CONSTANTS.ATTRIBUTE_LAZY, this)
 }
@@ -15,6 +15,7 @@ export const enum WEB_VIEW_CONSTANTS {
   ATTRIBUTE_BLINKFEATURES = 'blinkfeatures',
   ATTRIBUTE_DISABLEBLINKFEATURES = 'disableblinkfeatures',
   ATTRIBUTE_WEBPREFERENCES = 'webpreferences',
+  ATTRIBUTE_LAZY = 'lazy',
 
   // Internal attribute.
   ATTRIBUTE_INTERNALINSTANCEID = 'internalinstanceid',
@@ -32,7 +32,8 @@ const defineWebViewElement = (v8Util: NodeJS.V8UtilBinding, webViewImpl: typeof
         WEB_VIEW_CONSTANTS.ATTRIBUTE_PRELOAD,
         WEB_VIEW_CONSTANTS.ATTRIBUTE_BLINKFEATURES,
         WEB_VIEW_CONSTANTS.ATTRIBUTE_DISABLEBLINKFEATURES,
-        WEB_VIEW_CONSTANTS.ATTRIBUTE_WEBPREFERENCES
+        WEB_VIEW_CONSTANTS.ATTRIBUTE_WEBPREFERENCES,
+        WEB_VIEW_CONSTANTS.ATTRIBUTE_LAZY
       ]
     }
 
@@ -24,6 +24,7 @@ export class WebViewImpl {
   public guestInstanceId?: number
   public hasFocus = false
   public internalInstanceId?: number;
+  public intersectionObserver?: IntersectionObserver;
   public resizeObserver?: ResizeObserver;
   public userAgentOverride?: string;
   public viewInstanceId: number
@@ -75,6 +76,9 @@ export class WebViewImpl {
       this.guestInstanceId = void 0
     }
 
+    // A lazy guest which was not created yet is created on the next attach.
+    this.cancelLazyGuest()
+
     this.beforeFirstNavigation = true
     this.attributes[WEB_VIEW_CONSTANTS.ATTRIBUTE_PARTITION].validPartitionId = true
 
@@ -111,6 +115,29 @@ export class WebViewImpl {
   }
 
   createGuest () {
+    // A lazy <webview> creates its guest once the element enters the viewport,
+    // so the guests of the hidden ones do not cost a WebContents and a process.
+    if (this.attributes[WEB_VIEW_CONSTANTS.ATTRIBUTE_LAZY].getValue()) {
+      this.intersectionObserver = new IntersectionObserver(entries => {
+        if (entries.some(entry => entry.isIntersecting)) {
+          this.cancelLazyGuest()
+          this.createGuestNow()
+        }
+      })
+      this.intersectionObserver.observe(this.webviewNode)
+      return
+    }
+    this.createGuestNow()
+  }
+
+  cancelLazyGuest () {
+    if (this.intersectionObserver) {
+      this.intersectionObserver.disconnect()
+      this.intersectionObserver = void 0
+    }
+  }
+
+  createGuestNow () {
     guestViewInternal.createGuest(this.buildParams()).then(guestInstanceId => {
       this.attachGuestInstance(guestInstanceId)
     })
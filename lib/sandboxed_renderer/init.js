@@ -28,16 +28,22 @@ Object.setPrototypeOf(process, EventEmitter.prototype)
 
 const { ipcRendererInternal } = require('@electron/internal/renderer/ipc-renderer-internal')
 const ipcRendererUtils = require('@electron/internal/renderer/ipc-renderer-internal-utils')
+const { wrapPreloadSource } = require('@electron/internal/common/preload-wrapper')
+
+// The frames of this process share the preload bundle of the session, which
+// the browser process only sends when this process does not have it yet.
+const cachedBundle = binding.getPreloadBundle()
 
 const {
   contentScripts,
+  preloadBundle,
   preloadScripts,
   isRemoteModuleEnabled,
   isWebViewTagEnabled,
   guestInstanceId,
   openerId,
   process: processProps
-} = ipcRendererUtils.invokeSync('ELECTRON_BROWSER_SANDBOX_LOAD')
+} = ipcRendererUtils.invokeSync('ELECTRON_BROWSER_SANDBOX_LOAD', cachedBundle ? cachedBundle.hash : null)
 
 process.isRemoteModuleEnabled = isRemoteModuleEnabled
 
@@ -55,8 +61,28 @@ const loadedModules = new Map([
 // invoking the 'onMessage' callback.
 v8Util.setHiddenValue(global, 'ipcNative', {
   onMessage (internal, channel, args, senderId) {
+    const { emitToBatchListeners } = require('@electron/internal/common/ipc-batcher')
     const sender = internal ? ipcRendererInternal : electron.ipcRenderer
     sender.emit(channel, { sender, senderId }, ...args)
+    if (!internal) emitToBatchListeners(sender, [channel], [args], [senderId])
+  },
+  onMessages (internal, channels, args, senderIds) {
+    const { emitMessages } = require('@electron/internal/common/ipc-batcher')
+    emitMessages(electron.ipcRenderer, ipcRendererInternal, internal, channels, args, senderIds)
+  },
+  onMessageBatch (internal, channels, args, asArrays, senderId) {
+    const { emitBatch, emitToBatchListeners } = require('@electron/internal/common/ipc-batcher')
+    const sender = internal ? ipcRendererInternal : electron.ipcRenderer
+    const event = { sender, senderId }
+    emitBatch((channel, ...messageArgs) => {
+      sender.emit(channel, event, ...messageArgs)
+    }, channels, args, asArrays)
+    if (!internal) emitToBatchListeners(sender, channels, args, channels.map(() => senderId))
+  },
+  onPeerChannel (channel, handle, senderId) {
+    const { IpcRendererChannel } = require('@electron/internal/renderer/ipc-renderer-channel')
+    const sender = electron.ipcRenderer
+    sender.emit(channel, { sender, senderId, peer: new IpcRendererChannel(handle) })
   }
 })
 
@@ -160,29 +186,37 @@ if (contextIsolation) {
   v8Util.setHiddenValue(global, 'isolated-world-args', isolatedWorldArgs)
 }
 
-// Wrap the script into a function executed in global scope. It won't have
-// access to the current scope, so we'll expose a few objects as arguments:
-//
-// - `require`: The `preloadRequire` function
-// - `process`: The `preloadProcess` object
-// - `Buffer`: Shim of `Buffer` implementation
-// - `global`: The window object, which is aliased to `global` by webpack.
-function runPreloadScript (preloadSrc) {
-  const preloadWrapperSrc = `(function(require, process, Buffer, global, setImmediate, clearImmediate, exports) {
-  ${preloadSrc}
-  })`
-
+// Runs the script with the code cache the browser process built for it. A new
+// cache is returned when it was missing or rejected, which is only kept for
+// the frames of this process: the browser process never takes code caches
+// from renderers.
+function runPreloadScript (preloadSrc, preloadCache) {
   // eval in window scope
-  const preloadFn = binding.createPreloadScript(preloadWrapperSrc)
+  const { preloadFn, codeCache } = binding.createPreloadScript(wrapPreloadSource(preloadSrc), preloadCache)
   const { setImmediate, clearImmediate } = require('timers')
 
   preloadFn(preloadRequire, preloadProcess, Buffer, global, setImmediate, clearImmediate, {})
+  return codeCache
 }
 
-for (const { preloadPath, preloadSrc, preloadError } of preloadScripts) {
+v8Util.beginStartupPhase('preload')
+if (preloadBundle) {
+  const received = preloadBundle.source !== undefined
+  const { hash, source, cache } = received ? preloadBundle : cachedBundle
+  try {
+    const codeCache = runPreloadScript(source, cache)
+    if (received || codeCache) binding.setPreloadBundle(hash, source, codeCache || cache)
+  } catch (error) {
+    console.error('Unable to load the preload bundle')
+    console.error(error)
+
+    ipcRendererInternal.send('ELECTRON_BROWSER_PRELOAD_ERROR', '', error)
+  }
+}
+for (const { preloadPath, preloadSrc, preloadCache, preloadError } of preloadScripts) {
   try {
     if (preloadSrc) {
-      runPreloadScript(preloadSrc)
+      runPreloadScript(preloadSrc, preloadCache)
     } else if (preloadError) {
       throw preloadError
     }
@@ -193,6 +227,7 @@ for (const { preloadPath, preloadSrc, preloadError } of preloadScripts) {
     ipcRendererInternal.send('ELECTRON_BROWSER_PRELOAD_ERROR', preloadPath, error)
   }
 }
+v8Util.endStartupPhase('preload')
 
 // Warn about security issues
 if (process.isMainFrame) {
@@ -0,0 +1,208 @@
+// Rewrites the JSON header of an asar archive into the pre-indexed binary
+// ("v2") header that Electron can read without parsing JSON, see
+// shell/common/asar/header_index.h for the layout.
+//
+// With --compress every packed file that gets smaller is stored as a brotli
+// stream, which Electron inflates when reading it.
+//
+// With --order the files listed in a readahead manifest recorded with
+// ELECTRON_RECORD_ASAR_READAHEAD are stored first, in the order they were
+// read, so that startup reads one contiguous region of the archive.
+//
+// Usage: node script/convert-asar-header.js [--compress] [--order <manifest>]
+//                                          <in.asar> <out.asar>
+
+const assert = require('assert')
+const fs = require('fs')
+const zlib = require('zlib')
+
+const MAGIC = 0x32525341
+const ENTRY_SIZE = 32
+
+const FLAG_DIRECTORY = 1 << 0
+const FLAG_LINK = 1 << 1
+const FLAG_UNPACKED = 1 << 2
+const FLAG_EXECUTABLE = 1 << 3
+const FLAG_COMPRESSED = 1 << 4
+
+const align4 = n => (n + 3) & ~3
+
+const readV1Header = (archive) => {
+  const sizePickleSize = 8
+  const headerPickleSize = archive.readUInt32LE(4)
+  const header = archive.slice(sizePickleSize, sizePickleSize + headerPickleSize)
+  // Header pickle: uint32 payload size, then a string as uint32 length + bytes.
+  const stringSize = header.readUInt32LE(4)
+  assert(stringSize !== MAGIC, 'archive already has a v2 header')
+  const json = header.slice(8, 8 + stringSize).toString()
+  return {
+    root: JSON.parse(json),
+    data: archive.slice(sizePickleSize + headerPickleSize),
+    dataOffset: sizePickleSize + headerPickleSize
+  }
+}
+
+const flatten = (root) => {
+  const nodes = []
+  const visit = (node, nodePath) => {
+    nodes.push({ node, path: nodePath, key: Buffer.from(nodePath) })
+    if (node.files) {
+      for (const name of Object.keys(node.files)) {
+        visit(node.files[name], nodePath ? `${nodePath}/${name}` : name)
+      }
+    }
+  }
+  visit(root, '')
+  nodes.sort((a, b) => Buffer.compare(a.key, b.key))
+  nodes.forEach((entry, index) => { entry.index = index })
+  return nodes
+}
+
+// Returns the rank of every file in a readahead manifest, keyed by its offset
+// in the data section.
+const readManifest = (manifestPath, dataOffset) => {
+  const lines = fs.readFileSync(manifestPath, 'utf8').split('\n')
+  assert(lines[0] === '# asar readahead manifest', 'not a readahead manifest')
+  const ranks = new Map()
+  for (const line of lines.slice(1)) {
+    if (!line.trim()) continue
+    const offset = Number(line.split(' ')[0]) - dataOffset
+    if (!ranks.has(offset)) ranks.set(offset, ranks.size)
+  }
+  return ranks
+}
+
+// Rewrites the data section so that files are stored in the order they are
+// read at startup and then in path order, which keeps the files of a
+// directory together, optionally compressing them.
+const repack = (nodes, data, compress, ranks) => {
+  const rankOf = ({ node }) => {
+    const rank = ranks.get(Number(node.offset))
+    return rank === undefined ? Infinity : rank
+  }
+  const files = nodes.filter(({ node }) =>
+    !node.files && node.link === undefined && !node.unpacked)
+  // Array.prototype.sort is stable, so unranked files stay in path order.
+  files.sort((a, b) => rankOf(a) === rankOf(b) ? 0 : rankOf(a) - rankOf(b))
+
+  const chunks = []
+  let offset = 0
+  for (const { node } of files) {
+    let chunk = data.slice(Number(node.offset), Number(node.offset) + node.size)
+    if (compress && node.size > 0) {
+      const compressed = zlib.brotliCompressSync(chunk, {
+        params: {
+          [zlib.constants.BROTLI_PARAM_QUALITY]: zlib.constants.BROTLI_MAX_QUALITY,
+          [zlib.constants.BROTLI_PARAM_SIZE_HINT]: node.size
+        }
+      })
+      if (compressed.length < chunk.length) {
+        chunk = compressed
+        node.storedSize = compressed.length
+      }
+    }
+    node.offset = String(offset)
+    offset += chunk.length
+    chunks.push(chunk)
+  }
+  return Buffer.concat(chunks)
+}
+
+const buildIndex = (nodes) => {
+  const byPath = new Map(nodes.map(entry => [entry.path, entry]))
+
+  const children = []
+  const strings = []
+  let stringSize = 0
+  const entries = Buffer.alloc(nodes.length * ENTRY_SIZE)
+
+  nodes.forEach((entry, index) => {
+    const { node } = entry
+    let flags = 0
+    let size = 0
+    let offset = BigInt(0)
+    let first = 0
+    let count = 0
+
+    if (node.link !== undefined) {
+      const target = byPath.get(node.link)
+      assert(target, `link ${entry.path} points to missing ${node.link}`)
+      flags |= FLAG_LINK
+      first = target.index
+    } else if (node.files) {
+      flags |= FLAG_DIRECTORY
+      first = children.length
+      const prefix = entry.path ? `${entry.path}/` : ''
+      // Entries are sorted, so sorting by index lists children by name.
+      const indices = Object.keys(node.files)
+        .map(name => byPath.get(prefix + name).index)
+        .sort((a, b) => a - b)
+      children.push(...indices)
+      count = indices.length
+    } else {
+      size = node.size
+      if (node.unpacked) flags |= FLAG_UNPACKED
+      else offset = BigInt(node.offset)
+      if (node.executable) flags |= FLAG_EXECUTABLE
+      if (node.storedSize !== undefined) {
+        flags |= FLAG_COMPRESSED
+        count = node.storedSize
+      }
+    }
+
+    const base = index * ENTRY_SIZE
+    entries.writeUInt32LE(stringSize, base)
+    entries.writeUInt32LE(entry.key.length, base + 4)
+    entries.writeUInt32LE(flags, base + 8)
+    entries.writeUInt32LE(size, base + 12)
+    entries.writeBigUInt64LE(offset, base + 16)
+    entries.writeUInt32LE(first, base + 24)
+    entries.writeUInt32LE(count, base + 28)
+
+    strings.push(entry.key)
+    stringSize += entry.key.length
+  })
+
+  const preamble = Buffer.alloc(16)
+  preamble.writeUInt32LE(MAGIC, 0)
+  preamble.writeUInt32LE(nodes.length, 4)
+  preamble.writeUInt32LE(children.length, 8)
+  preamble.writeUInt32LE(stringSize, 12)
+
+  const childTable = Buffer.alloc(children.length * 4)
+  children.forEach((child, i) => childTable.writeUInt32LE(child, i * 4))
+
+  return Buffer.concat([preamble, entries, childTable, ...strings])
+}
+
+const writeV2Archive = (payload, data) => {
+  const paddedSize = align4(payload.length)
+  const headerPickle = Buffer.alloc(4 + paddedSize)
+  headerPickle.writeUInt32LE(paddedSize, 0)
+  payload.copy(headerPickle, 4)
+
+  const sizePickle = Buffer.alloc(8)
+  sizePickle.writeUInt32LE(4, 0)
+  sizePickle.writeUInt32LE(headerPickle.length, 4)
+
+  return Buffer.concat([sizePickle, headerPickle, data])
+}
+
+const args = process.argv.slice(2)
+let compress = false
+let manifest = null
+while (args[0] === '--compress' || args[0] === '--order') {
+  if (args.shift() === '--compress') compress = true
+  else manifest = args.shift()
+}
+const [input, output] = args
+if (!input || !output || args.length !== 2) {
+  console.error('Usage: node script/convert-asar-header.js [--compress] [--order <manifest>] <in.asar> <out.asar>')
+  process.exit(1)
+}
+
+const { root, data, dataOffset } = readV1Header(fs.readFileSync(input))
+const nodes = flatten(root)
+const ranks = manifest ? readManifest(manifest, dataOffset) : new Map()
+const packed = repack(nodes, data, compress, ranks)
+fs.writeFileSync(output, writeV2Archive(buildIndex(nodes), packed))
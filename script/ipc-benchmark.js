@@ -0,0 +1,15 @@
+// Runs the IPC benchmarks in script/ipc-benchmark with the Electron in the out
+// directory, forwarding the arguments:
+//
+// * --iterations=N - number of operations measured per benchmark (default 1000).
+// * --filter=REGEX - only runs the benchmarks whose "name/payload" matches.
+// * --output=FILE  - writes the JSON results to FILE instead of stdout.
+
+const cp = require('child_process')
+const path = require('path')
+const utils = require('./lib/utils')
+const electronPath = utils.getAbsoluteElectronExec()
+
+const appPath = path.join(__dirname, 'ipc-benchmark')
+const child = cp.spawn(electronPath, [appPath, ...process.argv.slice(2)], { stdio: 'inherit' })
+child.on('close', (code) => process.exit(code))
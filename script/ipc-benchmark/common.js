@@ -0,0 +1,98 @@
+'use strict'
+
+// Code shared by the main process and the renderers of the IPC benchmarks.
+
+const { performance } = require('perf_hooks')
+const v8 = require('v8')
+
+const createNestedObject = (depth) => {
+  const object = { id: depth, name: `node-${depth}`, enabled: true, tags: ['a', 'b', 'c'] }
+  if (depth > 0) {
+    object.children = [createNestedObject(depth - 1), createNestedObject(depth - 1)]
+  }
+  return object
+}
+
+// Large payloads run with fewer iterations, so all benchmarks take a comparable
+// amount of time.
+const payloads = {
+  'small-string': { create: () => 'hello world', iterationScale: 1 },
+  number: { create: () => 42.5, iterationScale: 1 },
+  'flat-object': {
+    create: () => ({ id: 42, name: 'item', enabled: true, ratio: 0.5, parent: null }),
+    iterationScale: 1
+  },
+  'typed-array-1kb': { create: () => new Uint8Array(1024).fill(1), iterationScale: 1 },
+  'nested-object': { create: () => createNestedObject(5), iterationScale: 0.5 },
+  'typed-array-1mb': { create: () => new Uint8Array(1024 * 1024).fill(1), iterationScale: 0.02 }
+}
+
+const payloadCache = new Map()
+
+exports.payloadNames = Object.keys(payloads)
+
+exports.getPayload = (name) => {
+  if (!payloadCache.has(name)) {
+    payloadCache.set(name, payloads[name].create())
+  }
+  return payloadCache.get(name)
+}
+
+exports.getIterations = (name, iterations) => {
+  return Math.max(10, Math.round(iterations * payloads[name].iterationScale))
+}
+
+// The size of the payload once serialized with the structured clone algorithm,
+// which is close to the size of the IPC message.
+exports.getPayloadSize = (name) => v8.serialize(exports.getPayload(name)).length
+
+const percentile = (sorted, fraction) => {
+  const index = Math.max(Math.ceil(fraction * sorted.length) - 1, 0)
+  return sorted[index]
+}
+
+const summarize = (samples) => {
+  const sorted = [...samples].sort((a, b) => a - b)
+  const sum = sorted.reduce((total, sample) => total + sample, 0)
+  return {
+    mean: sum / sorted.length,
+    p50: percentile(sorted, 0.5),
+    p90: percentile(sorted, 0.9),
+    p99: percentile(sorted, 0.99),
+    max: sorted[sorted.length - 1]
+  }
+}
+
+// Runs a benchmark, which is an object with:
+// * latency(payload) - performs one operation and waits for its completion.
+// * throughput(payload, iterations) - performs |iterations| operations without
+//   waiting for each of them, and waits for the completion of all. Optional,
+//   when missing the throughput is derived from the latency.
+//
+// Durations are in milliseconds.
+exports.runBenchmark = async (benchmark, payloadName, iterations) => {
+  const payload = exports.getPayload(payloadName)
+  iterations = exports.getIterations(payloadName, iterations)
+
+  const warmup = Math.min(iterations, 100)
+  for (let i = 0; i < warmup; i++) {
+    await benchmark.latency(payload)
+  }
+
+  const samples = []
+  for (let i = 0; i < iterations; i++) {
+    const start = performance.now()
+    await benchmark.latency(payload)
+    samples.push(performance.now() - start)
+  }
+  const latency = summarize(samples)
+
+  let opsPerSecond = 1000 / latency.mean
+  if (benchmark.throughput) {
+    const start = performance.now()
+    await benchmark.throughput(payload, iterations)
+    opsPerSecond = iterations * 1000 / (performance.now() - start)
+  }
+
+  return { iterations, opsPerSecond, latency }
+}
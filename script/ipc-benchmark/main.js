@@ -0,0 +1,117 @@
+'use strict'
+
+// Measures the latency and throughput of IPC messages, see the Benchmarks
+// section of docs/development/testing.md.
+
+const { app, BrowserWindow, ipcMain } = require('electron')
+const fs = require('fs')
+const path = require('path')
+const { getPayloadSize, payloadNames, runBenchmark } = require('./common')
+
+const getOption = (name, defaultValue) => {
+  const prefix = `--${name}=`
+  const arg = process.argv.find(arg => arg.startsWith(prefix))
+  return arg ? arg.substr(prefix.length) : defaultValue
+}
+
+const iterations = parseInt(getOption('iterations', '1000'), 10)
+const filter = new RegExp(getOption('filter', '.'))
+const output = getOption('output')
+
+ipcMain.on('bench:data', () => {})
+ipcMain.on('bench:ping', (event) => { event.reply('bench:pong') })
+ipcMain.on('bench:sync', (event) => { event.returnValue = null })
+ipcMain.handle('bench:invoke', () => null)
+ipcMain.handle('bench:flush', () => null)
+
+const waitForPong = (contents) => new Promise(resolve => {
+  const listener = (event) => {
+    if (event.sender !== contents) return
+    ipcMain.removeListener('bench:pong', listener)
+    resolve()
+  }
+  ipcMain.on('bench:pong', listener)
+})
+
+const mainBenchmarks = {
+  'webContents.send': (contents) => ({
+    latency (payload) {
+      const pong = waitForPong(contents)
+      contents.send('bench:ping', payload)
+      return pong
+    },
+    throughput (payload, iterations) {
+      for (let i = 0; i < iterations; i++) {
+        contents.send('bench:data', payload)
+      }
+      const pong = waitForPong(contents)
+      contents.send('bench:ping')
+      return pong
+    }
+  })
+}
+
+const rendererBenchmarks = ['send', 'sendCall', 'invoke', 'sendSync', 'sendTo']
+
+const createWindow = async () => {
+  const w = new BrowserWindow({
+    show: false,
+    webPreferences: { nodeIntegration: true }
+  })
+  await w.loadFile(path.join(__dirname, 'index.html'))
+  return w
+}
+
+const main = async () => {
+  const [w, peer] = await Promise.all([createWindow(), createWindow()])
+  const names = [...rendererBenchmarks, ...Object.keys(mainBenchmarks)]
+
+  const results = []
+  for (const name of names) {
+    for (const payloadName of payloadNames) {
+      const id = `${name}/${payloadName}`
+      if (!filter.test(id)) continue
+
+      let result
+      if (mainBenchmarks[name]) {
+        const benchmark = mainBenchmarks[name](w.webContents)
+        result = await runBenchmark(benchmark, payloadName, iterations)
+      } else {
+        const args = [name, payloadName, iterations, peer.webContents.id]
+        const code = `runBenchmark(${args.map(arg => JSON.stringify(arg)).join(', ')})`
+        result = await w.webContents.executeJavaScript(code)
+      }
+
+      const payloadBytes = getPayloadSize(payloadName)
+      results.push({
+        benchmark: name,
+        payload: payloadName,
+        payloadBytes,
+        ...result,
+        bytesPerSecond: result.opsPerSecond * payloadBytes
+      })
+      console.error(`${id}: ${result.opsPerSecond.toFixed(0)} ops/s, p50 ${result.latency.p50.toFixed(3)} ms`)
+    }
+  }
+
+  const report = JSON.stringify({
+    electron: process.versions.electron,
+    platform: process.platform,
+    arch: process.arch,
+    results
+  }, null, 2)
+  if (output) {
+    fs.writeFileSync(output, report)
+  } else {
+    console.log(report)
+  }
+}
+
+app.disableHardwareAcceleration()
+
+app.whenReady().then(main).then(() => {
+  app.quit()
+}, (error) => {
+  console.error(error)
+  app.exit(1)
+})
@@ -0,0 +1,83 @@
+'use strict'
+
+const { ipcRenderer } = require('electron')
+const { runBenchmark } = require('./common')
+
+const waitForPong = () => new Promise(resolve => {
+  ipcRenderer.once('bench:pong', () => resolve())
+})
+
+// Used by the benchmarks that send messages to this renderer.
+ipcRenderer.on('bench:data', () => {})
+ipcRenderer.on('bench:ping', (event) => {
+  if (event.senderId) {
+    ipcRenderer.sendTo(event.senderId, 'bench:pong')
+  } else {
+    ipcRenderer.send('bench:pong')
+  }
+})
+
+// Messages sent on one pipe are handled in order, so the reply to the last
+// message means that all the previous ones have been received.
+const benchmarks = {
+  send: () => ({
+    latency (payload) {
+      const pong = waitForPong()
+      ipcRenderer.send('bench:ping', payload)
+      return pong
+    },
+    throughput (payload, iterations) {
+      for (let i = 0; i < iterations; i++) {
+        ipcRenderer.send('bench:data', payload)
+      }
+      return ipcRenderer.invoke('bench:flush')
+    }
+  }),
+
+  invoke: () => ({
+    latency (payload) {
+      return ipcRenderer.invoke('bench:invoke', payload)
+    },
+    throughput (payload, iterations) {
+      const replies = []
+      for (let i = 0; i < iterations; i++) {
+        replies.push(ipcRenderer.invoke('bench:invoke', payload))
+      }
+      return Promise.all(replies)
+    }
+  }),
+
+  // The time spent in ipcRenderer.send itself, mostly serializing the
+  // payload, without waiting for the message to be received.
+  sendCall: () => ({
+    latency (payload) {
+      ipcRenderer.send('bench:data', payload)
+    }
+  }),
+
+  sendSync: () => ({
+    latency (payload) {
+      ipcRenderer.sendSync('bench:sync', payload)
+    }
+  }),
+
+  sendTo: (peerId) => ({
+    latency (payload) {
+      const pong = waitForPong()
+      ipcRenderer.sendTo(peerId, 'bench:ping', payload)
+      return pong
+    },
+    throughput (payload, iterations) {
+      for (let i = 0; i < iterations; i++) {
+        ipcRenderer.sendTo(peerId, 'bench:data', payload)
+      }
+      const pong = waitForPong()
+      ipcRenderer.sendTo(peerId, 'bench:ping')
+      return pong
+    }
+  })
+}
+
+window.runBenchmark = (name, payloadName, iterations, peerId) => {
+  return runBenchmark(benchmarks[name](peerId), payloadName, iterations)
+}
@@ -0,0 +1,21 @@
+// Runs the memory benchmarks in script/memory-benchmark with the Electron in
+// the out directory, forwarding the arguments, and exits with 1 when a
+// threshold is exceeded:
+//
+// * --counts=N,N   - numbers of windows opened at once (default 1,10,50).
+// * --filter=REGEX - only runs the configurations whose name matches.
+// * --max-renderer-mb=N      - fails when a renderer uses more on average.
+// * --max-browser-growth-mb=N - fails when the browser process grows more per
+//                               window.
+// * --thresholds=FILE - JSON of the two thresholds above per configuration,
+//                       like { "sandbox": { "maxRendererMB": 60 } }.
+// * --output=FILE  - writes the JSON results to FILE instead of stdout.
+
+const cp = require('child_process')
+const path = require('path')
+const utils = require('./lib/utils')
+const electronPath = utils.getAbsoluteElectronExec()
+
+const appPath = path.join(__dirname, 'memory-benchmark')
+const child = cp.spawn(electronPath, [appPath, ...process.argv.slice(2)], { stdio: 'inherit' })
+child.on('close', (code) => process.exit(code))
@@ -0,0 +1,161 @@
+'use strict'
+
+// Measures what windows cost in memory with common web preferences, and fails
+// when it exceeds the thresholds, see the Benchmarks section of
+// docs/development/testing.md.
+
+const { app, BrowserWindow, webContents } = require('electron')
+const fs = require('fs')
+const path = require('path')
+
+const getOption = (name, defaultValue) => {
+  const prefix = `--${name}=`
+  const arg = process.argv.find(arg => arg.startsWith(prefix))
+  return arg ? arg.substr(prefix.length) : defaultValue
+}
+
+const counts = getOption('counts', '1,10,50').split(',').map(count => parseInt(count, 10))
+const filter = new RegExp(getOption('filter', '.'))
+const output = getOption('output')
+const thresholdsFile = getOption('thresholds')
+const defaultThresholds = {
+  maxRendererMB: parseFloat(getOption('max-renderer-mb', 'Infinity')),
+  maxBrowserGrowthMB: parseFloat(getOption('max-browser-growth-mb', 'Infinity'))
+}
+const thresholds = thresholdsFile ? JSON.parse(fs.readFileSync(thresholdsFile, 'utf8')) : {}
+
+const configurations = {
+  default: { webPreferences: {} },
+  sandbox: { webPreferences: { sandbox: true } },
+  'context-isolation': { webPreferences: { contextIsolation: true } },
+  'node-integration': { webPreferences: { nodeIntegration: true } },
+  offscreen: { webPreferences: { offscreen: true } },
+  webview: { webPreferences: { webviewTag: true }, page: 'webview.html' }
+}
+
+// How long the windows settle after loading before they are measured.
+const kSettleDelay = 2000
+
+const delay = (ms) => new Promise(resolve => setTimeout(resolve, ms))
+
+// The memory of the browser process, in KB.
+const getBrowserMemory = async () => (await process.getProcessMemoryInfo()).private
+
+// The memory of each process, in KB. Only Windows reports the private memory
+// of the other processes, elsewhere their working set is used.
+const getProcessMemory = () => {
+  const memory = new Map()
+  for (const metric of app.getAppMetrics()) {
+    memory.set(metric.pid, metric.memory.privateBytes || metric.memory.workingSetSize)
+  }
+  return memory
+}
+
+const openWindow = async (configuration) => {
+  const w = new BrowserWindow({
+    show: false,
+    webPreferences: configuration.webPreferences
+  })
+  const attached = configuration.page === 'webview.html'
+    ? new Promise(resolve => w.webContents.once('did-attach-webview', (event, guest) => {
+      guest.once('did-finish-load', resolve)
+    }))
+    : null
+  await w.loadFile(path.join(__dirname, configuration.page || 'index.html'))
+  await attached
+  return w
+}
+
+const runBenchmark = async (configuration, count) => {
+  const browserBefore = await getBrowserMemory()
+
+  const windows = []
+  for (let i = 0; i < count; i++) {
+    windows.push(await openWindow(configuration))
+  }
+  await delay(kSettleDelay)
+
+  // The renderers of the windows and of their webviews, which may share
+  // processes.
+  const ids = new Set(windows.map(w => w.webContents.id))
+  const pids = new Set()
+  for (const contents of webContents.getAllWebContents()) {
+    const host = contents.hostWebContents
+    if (ids.has(contents.id) || (host && ids.has(host.id))) {
+      pids.add(contents.getOSProcessId())
+    }
+  }
+  const processMemory = getProcessMemory()
+  let rendererMemory = 0
+  for (const pid of pids) rendererMemory += processMemory.get(pid) || 0
+  const browserGrowth = await getBrowserMemory() - browserBefore
+
+  for (const w of windows) w.destroy()
+  await delay(kSettleDelay)
+
+  return {
+    windows: count,
+    rendererProcesses: pids.size,
+    rendererMB: pids.size ? rendererMemory / 1024 / pids.size : 0,
+    rendererMBPerWindow: rendererMemory / 1024 / count,
+    browserGrowthMBPerWindow: browserGrowth / 1024 / count
+  }
+}
+
+const main = async () => {
+  const results = []
+  const failures = []
+  for (const name of Object.keys(configurations)) {
+    if (!filter.test(name)) continue
+    const limits = { ...defaultThresholds, ...thresholds[name] }
+
+    for (const count of counts) {
+      const result = await runBenchmark(configurations[name], count)
+      results.push({ configuration: name, ...result })
+      // Without renderers there is nothing the thresholds could be checked on.
+      if (result.rendererProcesses === 0) {
+        failures.push(`${name}/${count}: no renderer process was found`)
+        continue
+      }
+      console.error(`${name}/${count}: renderer ${result.rendererMB.toFixed(1)} MB, ` +
+        `browser +${result.browserGrowthMBPerWindow.toFixed(1)} MB per window`)
+
+      if (result.rendererMB > limits.maxRendererMB) {
+        failures.push(`${name}/${count}: a renderer uses ${result.rendererMB.toFixed(1)} MB, ` +
+          `over ${limits.maxRendererMB} MB`)
+      }
+      if (result.browserGrowthMBPerWindow > limits.maxBrowserGrowthMB) {
+        failures.push(`${name}/${count}: the browser grows ${result.browserGrowthMBPerWindow.toFixed(1)} MB ` +
+          `per window, over ${limits.maxBrowserGrowthMB} MB`)
+      }
+    }
+  }
+
+  const report = JSON.stringify({
+    electron: process.versions.electron,
+    platform: process.platform,
+    arch: process.arch,
+    results,
+    failures
+  }, null, 2)
+  if (output) {
+    fs.writeFileSync(output, report)
+  } else {
+    console.log(report)
+  }
+  for (const failure of failures) console.error(failure)
+  return failures.length === 0
+}
+
+app.disableHardwareAcceleration()
+
+// The windows of each count are destroyed before the next count opens its
+// own, which must not quit the app.
+app.on('window-all-closed', () => {})
+
+app.whenReady().then(main).then((passed) => {
+  app.exit(passed ? 0 : 1)
+}, (error) => {
+  console.error(error)
+  app.exit(1)
+})
@@ -0,0 +1,16 @@
+// Runs the offscreen rendering benchmarks in script/osr-benchmark with the
+// Electron in the out directory, forwarding the arguments:
+//
+// * --duration=SECONDS - how long each benchmark is measured (default 5).
+// * --frame-rate=N     - frame rate of the offscreen windows (default 60).
+// * --filter=REGEX     - only runs the benchmarks whose "mode/size" matches.
+// * --output=FILE      - writes the JSON results to FILE instead of stdout.
+
+const cp = require('child_process')
+const path = require('path')
+const utils = require('./lib/utils')
+const electronPath = utils.getAbsoluteElectronExec()
+
+const appPath = path.join(__dirname, 'osr-benchmark')
+const child = cp.spawn(electronPath, [appPath, ...process.argv.slice(2)], { stdio: 'inherit' })
+child.on('close', (code) => process.exit(code))
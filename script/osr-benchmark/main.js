@@ -0,0 +1,190 @@
+'use strict'
+
+// Measures how fast offscreen windows and frame subscriptions deliver the
+// frames of an animated page, see the Benchmarks section of
+// docs/development/testing.md.
+
+const { app, BrowserWindow } = require('electron')
+const fs = require('fs')
+const path = require('path')
+
+const getOption = (name, defaultValue) => {
+  const prefix = `--${name}=`
+  const arg = process.argv.find(arg => arg.startsWith(prefix))
+  return arg ? arg.substr(prefix.length) : defaultValue
+}
+
+const duration = parseFloat(getOption('duration', '5')) * 1000
+const frameRate = parseInt(getOption('frame-rate', '60'), 10)
+const filter = new RegExp(getOption('filter', '.'))
+const output = getOption('output')
+
+const sizes = {
+  '720p': { width: 1280, height: 720 },
+  '1080p': { width: 1920, height: 1080 },
+  '4k': { width: 3840, height: 2160 }
+}
+
+// How each mode receives the frames, |onFrame| is called with the BGRA pixels
+// of each frame, which start with the top left corner.
+const modes = {
+  paint: {
+    webPreferences: { offscreen: true },
+    subscribe (contents, onFrame) {
+      contents.on('paint', (event, dirty, image) => onFrame(image.getBitmap()))
+    }
+  },
+  'paint-zero-copy': {
+    webPreferences: { offscreen: true, offscreenZeroCopy: true },
+    subscribe (contents, onFrame) {
+      contents.on('paint', (event, dirty, image) => onFrame(image.getBitmap()))
+    }
+  },
+  'paint-buffer': {
+    webPreferences: { offscreen: true },
+    subscribe (contents, onFrame) {
+      contents.on('paint-buffer', (event, dirty, buffer) => onFrame(buffer))
+    }
+  },
+  'frame-subscription': {
+    webPreferences: {},
+    subscribe (contents, onFrame) {
+      contents.beginFrameSubscription((image) => onFrame(image.getBitmap()))
+    }
+  },
+  'frame-subscription-zero-copy': {
+    webPreferences: {},
+    subscribe (contents, onFrame) {
+      contents.beginFrameSubscription({ zeroCopy: true }, (image) => onFrame(image.getBitmap()))
+    }
+  }
+}
+
+const percentile = (sorted, fraction) => {
+  const index = Math.max(Math.ceil(fraction * sorted.length) - 1, 0)
+  return sorted[index]
+}
+
+const summarize = (samples) => {
+  if (samples.length === 0) return null
+  const sorted = [...samples].sort((a, b) => a - b)
+  const sum = sorted.reduce((total, sample) => total + sample, 0)
+  return {
+    mean: sum / sorted.length,
+    p50: percentile(sorted, 0.5),
+    p90: percentile(sorted, 0.9),
+    p99: percentile(sorted, 0.99),
+    max: sorted[sorted.length - 1]
+  }
+}
+
+// The milliseconds since the page drew the frame, from the time it encoded in
+// the color of the top left pixel, or null for a frame it did not draw.
+const getFrameLatency = (pixels) => {
+  if (pixels.length < 4) return null
+  const stamp = (pixels[2] << 16) | (pixels[1] << 8) | pixels[0]
+  const latency = ((Date.now() & 0xffffff) - stamp + 0x1000000) % 0x1000000
+  return latency < 10000 ? latency : null
+}
+
+// The CPU time all the processes of the app used, in milliseconds, since the
+// call before.
+const getCPUTime = (() => {
+  let last = Date.now()
+  return () => {
+    const now = Date.now()
+    const percent = app.getAppMetrics()
+      .reduce((total, metric) => total + metric.cpu.percentCPUUsage, 0)
+    const cpuTime = percent / 100 * (now - last)
+    last = now
+    return cpuTime
+  }
+})()
+
+const runBenchmark = async (mode, size) => {
+  const w = new BrowserWindow({
+    ...size,
+    show: !mode.webPreferences.offscreen,
+    useContentSize: true,
+    frame: false,
+    webPreferences: { ...mode.webPreferences, backgroundThrottling: false }
+  })
+  if (mode.webPreferences.offscreen) w.webContents.setFrameRate(frameRate)
+  await w.loadFile(path.join(__dirname, 'index.html'))
+
+  let measuring = false
+  let frames = 0
+  const latencies = []
+  mode.subscribe(w.webContents, (pixels) => {
+    if (!measuring) return
+    const latency = getFrameLatency(pixels)
+    if (latency !== null) latencies.push(latency)
+    frames++
+  })
+
+  // Frames of the first second are not measured, while the page warms up.
+  await new Promise(resolve => setTimeout(resolve, 1000))
+  const droppedBefore = mode.webPreferences.offscreen ? w.webContents.getPaintStats().droppedFrames : 0
+  const mainCPUBefore = process.cpuUsage()
+  getCPUTime()
+  measuring = true
+  await new Promise(resolve => setTimeout(resolve, duration))
+  measuring = false
+  const cpuTime = getCPUTime()
+  const mainCPU = process.cpuUsage(mainCPUBefore)
+  const droppedFrames = mode.webPreferences.offscreen
+    ? w.webContents.getPaintStats().droppedFrames - droppedBefore
+    : null
+
+  if (!mode.webPreferences.offscreen) w.webContents.endFrameSubscription()
+  w.destroy()
+
+  return {
+    frames,
+    fps: frames * 1000 / duration,
+    droppedFrames,
+    latency: summarize(latencies),
+    cpuPerFrame: frames ? {
+      total: cpuTime / frames,
+      main: (mainCPU.user + mainCPU.system) / 1000 / frames
+    } : null
+  }
+}
+
+const main = async () => {
+  const results = []
+  for (const modeName of Object.keys(modes)) {
+    for (const sizeName of Object.keys(sizes)) {
+      const id = `${modeName}/${sizeName}`
+      if (!filter.test(id)) continue
+
+      const result = await runBenchmark(modes[modeName], sizes[sizeName])
+      results.push({ mode: modeName, size: sizeName, frameRate, ...result })
+      const latency = result.latency ? result.latency.p50.toFixed(1) : '-'
+      console.error(`${id}: ${result.fps.toFixed(1)} fps, latency p50 ${latency} ms`)
+    }
+  }
+
+  const report = JSON.stringify({
+    electron: process.versions.electron,
+    platform: process.platform,
+    arch: process.arch,
+    results
+  }, null, 2)
+  if (output) {
+    fs.writeFileSync(output, report)
+  } else {
+    console.log(report)
+  }
+}
+
+// Each mode and size is measured in a window of its own, which is destroyed
+// before the next one is created, so the app must not quit then.
+app.on('window-all-closed', () => {})
+
+app.whenReady().then(main).then(() => {
+  app.quit()
+}, (error) => {
+  console.error(error)
+  app.exit(1)
+})
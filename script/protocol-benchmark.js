@@ -0,0 +1,16 @@
+// Runs the webRequest and protocol benchmarks in script/protocol-benchmark with
+// the Electron in the out directory, forwarding the arguments:
+//
+// * --resources=N  - number of subresources of the page (default 2000).
+// * --runs=N       - number of loads measured per setup (default 5).
+// * --filter=REGEX - only runs the setups whose name matches.
+// * --output=FILE  - writes the JSON results to FILE instead of stdout.
+
+const cp = require('child_process')
+const path = require('path')
+const utils = require('./lib/utils')
+const electronPath = utils.getAbsoluteElectronExec()
+
+const appPath = path.join(__dirname, 'protocol-benchmark')
+const child = cp.spawn(electronPath, [appPath, ...process.argv.slice(2)], { stdio: 'inherit' })
+child.on('close', (code) => process.exit(code))
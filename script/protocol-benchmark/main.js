@@ -0,0 +1,227 @@
+'use strict'
+
+// Measures the cost of webRequest listeners and custom protocols on the load
+// of a page with many subresources, see the Benchmarks section of
+// docs/development/testing.md.
+
+const { app, BrowserWindow, protocol, session } = require('electron')
+const fs = require('fs')
+const http = require('http')
+const os = require('os')
+const path = require('path')
+const { performance } = require('perf_hooks')
+const { PassThrough } = require('stream')
+
+const getOption = (name, defaultValue) => {
+  const prefix = `--${name}=`
+  const arg = process.argv.find(arg => arg.startsWith(prefix))
+  return arg ? arg.substr(prefix.length) : defaultValue
+}
+
+const resources = parseInt(getOption('resources', '2000'), 10)
+const runs = parseInt(getOption('runs', '5'), 10)
+const filter = new RegExp(getOption('filter', '.'))
+const output = getOption('output')
+
+// A transparent 1x1 GIF.
+const image = Buffer.from('R0lGODlhAQABAIAAAAAAAP///yH5BAEAAAAALAAAAAABAAEAAAIBRAA7', 'base64')
+
+// The resource timing buffer holds 250 entries by default.
+const page = [
+  '<!DOCTYPE html><html><head><meta charset="utf-8">',
+  '<script>performance.setResourceTimingBufferSize(1e6)</script>',
+  '</head><body>',
+  ...Array.from({ length: resources }, (v, i) => `<img src="r/${i}.gif">`),
+  '</body></html>'
+].join('\n')
+
+protocol.registerSchemesAsPrivileged([
+  { scheme: 'bench', privileges: { standard: true, secure: true } }
+])
+
+const isPage = (url) => !new URL(url).pathname.startsWith('/r/')
+
+const promisify = (register) => new Promise((resolve, reject) => {
+  register((error) => error ? reject(error) : resolve())
+})
+
+let server
+let baseURL
+
+const startServer = () => new Promise(resolve => {
+  server = http.createServer((request, response) => {
+    const headers = { 'Cache-Control': 'no-store' }
+    if (isPage(`http://localhost${request.url}`)) {
+      response.writeHead(200, { ...headers, 'Content-Type': 'text/html' })
+      response.end(page)
+    } else {
+      response.writeHead(200, { ...headers, 'Content-Type': 'image/gif' })
+      response.end(image)
+    }
+  })
+  server.listen(0, '127.0.0.1', () => {
+    baseURL = `http://127.0.0.1:${server.address().port}/`
+    resolve()
+  })
+})
+
+let tmpDir
+const writeFiles = () => {
+  tmpDir = fs.mkdtempSync(path.join(os.tmpdir(), 'electron-protocol-benchmark-'))
+  fs.writeFileSync(path.join(tmpDir, 'index.html'), page)
+  fs.writeFileSync(path.join(tmpDir, 'image.gif'), image)
+}
+
+// Each setup prepares the session a page is loaded in, and returns the URL of
+// the page.
+const addBeforeRequestListener = (patterns) => (ses) => {
+  // Only the last pattern matches the requests.
+  const urls = Array.from({ length: patterns - 1 }, (v, i) => `*://example-${i}.invalid/*`)
+  urls.push(`${baseURL}*`)
+  ses.webRequest.onBeforeRequest({ urls }, (details, callback) => callback({}))
+  return baseURL
+}
+
+const setups = {
+  'no-listeners': () => baseURL,
+  'on-before-request/1-pattern': addBeforeRequestListener(1),
+  'on-before-request/10-patterns': addBeforeRequestListener(10),
+  'on-before-request/100-patterns': addBeforeRequestListener(100),
+  'on-headers-received': (ses) => {
+    ses.webRequest.onHeadersReceived((details, callback) => {
+      const responseHeaders = { ...details.responseHeaders, 'X-Benchmark': ['1'] }
+      callback({ responseHeaders })
+    })
+    return baseURL
+  },
+  'buffer-protocol': async (ses) => {
+    await promisify(done => ses.protocol.registerBufferProtocol('bench', (request, callback) => {
+      if (isPage(request.url)) {
+        callback({ mimeType: 'text/html', data: Buffer.from(page) })
+      } else {
+        callback({ mimeType: 'image/gif', data: image })
+      }
+    }, done))
+    return 'bench://app/'
+  },
+  'stream-protocol': async (ses) => {
+    await promisify(done => ses.protocol.registerStreamProtocol('bench', (request, callback) => {
+      const data = new PassThrough()
+      const pageRequest = isPage(request.url)
+      data.end(pageRequest ? page : image)
+      callback({
+        statusCode: 200,
+        headers: { 'Content-Type': pageRequest ? 'text/html' : 'image/gif' },
+        data
+      })
+    }, done))
+    return 'bench://app/'
+  },
+  'file-protocol': async (ses) => {
+    await promisify(done => ses.protocol.registerFileProtocol('bench', (request, callback) => {
+      callback({ path: path.join(tmpDir, isPage(request.url) ? 'index.html' : 'image.gif') })
+    }, done))
+    return 'bench://app/'
+  }
+}
+
+const percentile = (sorted, fraction) => {
+  const index = Math.max(Math.ceil(fraction * sorted.length) - 1, 0)
+  return sorted[index]
+}
+
+const summarize = (samples) => {
+  const sorted = [...samples].sort((a, b) => a - b)
+  const sum = sorted.reduce((total, sample) => total + sample, 0)
+  return {
+    mean: sum / sorted.length,
+    p50: percentile(sorted, 0.5),
+    p90: percentile(sorted, 0.9),
+    p99: percentile(sorted, 0.99),
+    max: sorted[sorted.length - 1]
+  }
+}
+
+let partitionId = 0
+
+// Loads the page in a new in-memory session, so nothing is cached between
+// the loads. Returns the load time and the durations of the subresource loads.
+const load = async (setup) => {
+  const ses = session.fromPartition(`protocol-benchmark-${partitionId++}`)
+  const url = await setup(ses)
+  const w = new BrowserWindow({ show: false, webPreferences: { session: ses } })
+  try {
+    const start = performance.now()
+    await w.loadURL(url)
+    const loadTime = performance.now() - start
+    const durations = await w.webContents.executeJavaScript(
+      'performance.getEntriesByType("resource").map(entry => entry.duration)')
+    return { loadTime, durations }
+  } finally {
+    w.destroy()
+  }
+}
+
+const main = async () => {
+  await startServer()
+  writeFiles()
+
+  // The first load warms up the renderer and the network service.
+  await load(setups['no-listeners'])
+
+  const results = []
+  let baseline = null
+  for (const name of Object.keys(setups)) {
+    if (!filter.test(name)) continue
+
+    const loadTimes = []
+    const durations = []
+    for (let i = 0; i < runs; i++) {
+      const result = await load(setups[name])
+      loadTimes.push(result.loadTime)
+      durations.push(...result.durations)
+    }
+
+    const loadTime = summarize(loadTimes)
+    if (name === 'no-listeners') baseline = loadTime
+    results.push({
+      setup: name,
+      resources,
+      runs,
+      loadTime,
+      requestDuration: summarize(durations),
+      // What each request costs over loading from the server without
+      // listeners, from the median load times.
+      overheadPerRequest: baseline ? (loadTime.p50 - baseline.p50) / (resources + 1) : null
+    })
+    console.error(`${name}: load p50 ${loadTime.p50.toFixed(1)} ms`)
+  }
+
+  const report = JSON.stringify({
+    electron: process.versions.electron,
+    platform: process.platform,
+    arch: process.arch,
+    results
+  }, null, 2)
+  if (output) {
+    fs.writeFileSync(output, report)
+  } else {
+    console.log(report)
+  }
+}
+
+app.disableHardwareAcceleration()
+
+// Every load destroys its window once it is measured, which must not quit
+// the app before the other setups were loaded.
+app.on('window-all-closed', () => {})
+
+app.whenReady().then(main).then(() => {
+  app.quit()
+}, (error) => {
+  console.error(error)
+  app.exit(1)
+}).finally(() => {
+  if (server) server.close()
+  if (tmpDir) fs.rmdirSync(tmpDir, { recursive: true })
+})
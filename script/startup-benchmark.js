@@ -0,0 +1,178 @@
+// Measures the startup of the app in script/startup-benchmark with the Electron
+// in the out directory, see the Benchmarks section of
+// docs/development/testing.md. The arguments are:
+//
+// * --runs=N      - number of launches measured per variant and mode
+//                   (default 20).
+// * --filter=REGEX - only runs the variants whose "mode/variant" matches, like
+//                   "warm/asar".
+// * --output=FILE  - writes the JSON results to FILE instead of stdout.
+
+const asar = require('asar')
+const cp = require('child_process')
+const fs = require('fs')
+const os = require('os')
+const path = require('path')
+const utils = require('./lib/utils')
+const electronPath = utils.getAbsoluteElectronExec()
+
+const getOption = (name, defaultValue) => {
+  const prefix = `--${name}=`
+  const arg = process.argv.find(arg => arg.startsWith(prefix))
+  return arg ? arg.substr(prefix.length) : defaultValue
+}
+
+const runs = parseInt(getOption('runs', '20'), 10)
+const filter = new RegExp(getOption('filter', '.'))
+const output = getOption('output')
+
+const appPath = path.join(__dirname, 'startup-benchmark')
+
+// The phases reported, as the name of the phase in a timeline. Each is
+// measured from the launch of the executable until the end of the phase.
+const phases = [
+  { name: 'main-process-init', process: 'main', phase: 'AtomBrowserMainParts::PreMainMessageLoopRun' },
+  { name: 'main-script', process: 'main', phase: 'main-script' },
+  { name: 'ready', process: 'main', phase: 'ready' },
+  { name: 'first-window', process: 'main', phase: 'BrowserWindow::BrowserWindow' },
+  { name: 'preload', process: 'renderer', phase: 'preload' },
+  { name: 'first-paint', process: 'main', phase: 'first-paint' },
+  { name: 'ready-to-show', process: 'main', phase: 'ready-to-show' }
+]
+
+const variants = []
+for (const packaged of [false, true]) {
+  for (const sandbox of [false, true]) {
+    for (const contextIsolation of [false, true]) {
+      variants.push({
+        name: [
+          packaged ? 'asar' : 'no-asar',
+          sandbox ? 'sandbox' : 'no-sandbox',
+          contextIsolation ? 'context-isolation' : 'no-context-isolation'
+        ].join('/'),
+        packaged,
+        sandbox,
+        contextIsolation
+      })
+    }
+  }
+}
+
+// Drops the file system caches, which needs root on Linux and macOS. Returns
+// whether they were dropped.
+const dropCaches = () => {
+  try {
+    if (process.platform === 'linux') {
+      cp.execSync('sync && echo 3 > /proc/sys/vm/drop_caches', { stdio: 'ignore' })
+      return true
+    } else if (process.platform === 'darwin') {
+      cp.execSync('sync && purge', { stdio: 'ignore' })
+      return true
+    }
+  } catch {}
+  return false
+}
+
+const launch = (variant, userDataDir, packagedAppPath) => new Promise((resolve, reject) => {
+  const env = {
+    ...process.env,
+    ELECTRON_BENCHMARK_SANDBOX: variant.sandbox ? '1' : '0',
+    ELECTRON_BENCHMARK_CONTEXT_ISOLATION: variant.contextIsolation ? '1' : '0'
+  }
+  const args = [
+    variant.packaged ? packagedAppPath : appPath,
+    `--user-data-dir=${userDataDir}`
+  ]
+  const launchTime = Date.now()
+  const child = cp.spawn(electronPath, args, { env, stdio: ['ignore', 'pipe', 'inherit'] })
+  let stdout = ''
+  child.stdout.on('data', (data) => { stdout += data })
+  child.on('error', reject)
+  child.on('close', (code) => {
+    if (code !== 0) return reject(new Error(`The app exited with ${code}`))
+    const timelines = JSON.parse(stdout.trim().split('\n').pop())
+    const result = {}
+    for (const { name, process: processType, phase } of phases) {
+      const found = timelines[processType].find(entry => entry.name === phase)
+      if (found) result[name] = found.startTime + found.duration - launchTime
+    }
+    resolve(result)
+  })
+})
+
+const percentile = (sorted, fraction) => {
+  const index = Math.max(Math.ceil(fraction * sorted.length) - 1, 0)
+  return sorted[index]
+}
+
+const summarize = (samples) => {
+  const sorted = [...samples].sort((a, b) => a - b)
+  return {
+    p50: percentile(sorted, 0.5),
+    p90: percentile(sorted, 0.9),
+    p99: percentile(sorted, 0.99),
+    max: sorted[sorted.length - 1]
+  }
+}
+
+const main = async () => {
+  const tmpDir = fs.mkdtempSync(path.join(os.tmpdir(), 'electron-startup-benchmark-'))
+  const packagedAppPath = path.join(tmpDir, 'app.asar')
+  await asar.createPackageWithOptions(appPath, packagedAppPath, {})
+
+  const results = []
+  try {
+    for (const mode of ['cold', 'warm']) {
+      for (const variant of variants) {
+        const id = `${mode}/${variant.name}`
+        if (!filter.test(id)) continue
+
+        // A warm launch reuses the caches of the launch before, which is not
+        // measured.
+        const warmDataDir = path.join(tmpDir, `warm-${results.length}`)
+        if (mode === 'warm') await launch(variant, warmDataDir, packagedAppPath)
+
+        const samples = {}
+        let cachesDropped = mode === 'cold'
+        for (let i = 0; i < runs; i++) {
+          let userDataDir = warmDataDir
+          if (mode === 'cold') {
+            userDataDir = path.join(tmpDir, `cold-${results.length}-${i}`)
+            cachesDropped = dropCaches() && cachesDropped
+          }
+          const result = await launch(variant, userDataDir, packagedAppPath)
+          for (const name of Object.keys(result)) {
+            if (!samples[name]) samples[name] = []
+            samples[name].push(result[name])
+          }
+        }
+
+        const phaseResults = {}
+        for (const { name } of phases) {
+          if (samples[name]) phaseResults[name] = summarize(samples[name])
+        }
+        results.push({ mode, variant: variant.name, runs, cachesDropped, phases: phaseResults })
+        const readyToShow = phaseResults['ready-to-show']
+        console.error(`${id}: ready-to-show p50 ${readyToShow ? readyToShow.p50.toFixed(1) : '-'} ms`)
+      }
+    }
+  } finally {
+    fs.rmdirSync(tmpDir, { recursive: true })
+  }
+
+  const report = JSON.stringify({
+    platform: process.platform,
+    arch: process.arch,
+    results
+  }, null, 2)
+  if (output) {
+    fs.writeFileSync(output, report)
+  } else {
+    console.log(report)
+  }
+}
+
+main().catch((error) => {
+  console.error(error)
+  process.exit(1)
+})
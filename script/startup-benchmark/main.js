@@ -0,0 +1,41 @@
+'use strict'
+
+// Launched once per run by script/startup-benchmark.js, which passes the
+// variant in the environment. Prints the startup timelines of the main process
+// and of the renderer as one line of JSON, then quits.
+
+const { app, BrowserWindow, ipcMain } = require('electron')
+const path = require('path')
+
+const sandbox = process.env.ELECTRON_BENCHMARK_SANDBOX === '1'
+const contextIsolation = process.env.ELECTRON_BENCHMARK_CONTEXT_ISOLATION === '1'
+
+const rendererTimeline = new Promise(resolve => {
+  ipcMain.once('bench:renderer-timeline', (event, timeline) => resolve(timeline))
+})
+
+const main = async () => {
+  const w = new BrowserWindow({
+    show: false,
+    webPreferences: {
+      sandbox,
+      contextIsolation,
+      preload: path.join(__dirname, 'preload.js')
+    }
+  })
+  const readyToShow = new Promise(resolve => w.once('ready-to-show', resolve))
+  await w.loadFile(path.join(__dirname, 'index.html'))
+  const [renderer] = await Promise.all([rendererTimeline, readyToShow])
+
+  process.stdout.write(JSON.stringify({
+    main: app.getStartupTimeline(),
+    renderer
+  }) + '\n')
+}
+
+app.whenReady().then(main).then(() => {
+  app.quit()
+}, (error) => {
+  console.error(error)
+  app.exit(1)
+})
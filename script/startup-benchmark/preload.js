@@ -0,0 +1,10 @@
+'use strict'
+
+// Reports the timeline of the renderer once the page is loaded, which has the
+// phases of the preload scripts.
+
+const { ipcRenderer } = require('electron')
+
+window.addEventListener('load', () => {
+  ipcRenderer.send('bench:renderer-timeline', process.getStartupTimeline())
+})
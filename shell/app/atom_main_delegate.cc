@@ -33,6 +33,7 @@
 #include "shell/browser/feature_list.h"
 #include "shell/browser/relauncher.h"
 #include "shell/common/options_switches.h"
+#include "shell/common/startup_timeline.h"
 #include "shell/renderer/atom_renderer_client.h"
 #include "shell/renderer/atom_sandboxed_renderer_client.h"
 #include "shell/utility/atom_content_utility_client.h"
@@ -139,6 +140,7 @@ const size_t AtomMainDelegate::kNonWildcardDomainNonPortSchemesSize =
     base::size(kNonWildcardDomainNonPortSchemes);
 
 bool AtomMainDelegate::BasicStartupComplete(int* exit_code) {
+  ScopedStartupPhase startup_phase("AtomMainDelegate::BasicStartupComplete");
   auto* command_line = base::CommandLine::ForCurrentProcess();
 
   logging::LoggingSettings settings;
@@ -10,6 +10,7 @@
 
 #include "base/command_line.h"
 #include "base/feature_list.h"
+#include "base/strings/string_util.h"
 #include "base/task/thread_pool/thread_pool_instance.h"
 #include "base/threading/thread_task_runner_handle.h"
 #include "electron/electron_version.h"
@@ -31,6 +32,30 @@
 
 namespace electron {
 
+namespace {
+
+// Node runs V8's background tasks on this many threads by default, while the
+// default pool of Chromium is sized for a browser.
+const int kMaxForegroundThreads = 4;
+
+// Parsing the command line for the options of the inspector is only worth it
+// when one of them was passed, which most short-lived node processes do not.
+bool HasInspectorOptions(int argc, char* argv[]) {
+  for (int i = 1; i < argc; ++i) {
+    base::StringPiece arg(argv[i]);
+    // The options of the script start with its name.
+    if (arg == "--" ||
+        !base::StartsWith(arg, "-", base::CompareCase::SENSITIVE))
+      break;
+    if (base::StartsWith(arg, "--inspect", base::CompareCase::SENSITIVE) ||
+        base::StartsWith(arg, "--debug", base::CompareCase::SENSITIVE))
+      return true;
+  }
+  return false;
+}
+
+}  // namespace
+
 #if !defined(OS_LINUX)
 void AddExtraParameter(const std::string& key, const std::string& value) {
   crash_reporter::CrashReporter::GetInstance()->AddExtraParameter(key, value);
@@ -43,6 +68,8 @@ void RemoveExtraParameter(const std::string& key) {
 
 int NodeMain(int argc, char* argv[]) {
   base::CommandLine::Init(argc, argv);
+  // node::Init() removes the options of node from |argv|.
+  const bool parse_inspector_options = HasInspectorOptions(argc, argv);
 
   int exit_code = 1;
   {
@@ -72,7 +99,9 @@ int NodeMain(int argc, char* argv[]) {
         gin::V8Initializer::V8SnapshotFileType::kWithAdditionalContext);
 
     // V8 requires a task scheduler apparently
-    base::ThreadPoolInstance::CreateAndStartWithDefaultParams("Electron");
+    base::ThreadPoolInstance::Create("Electron");
+    base::ThreadPoolInstance::Get()->Start(
+        base::ThreadPoolInstance::InitParams(kMaxForegroundThreads));
 
     // Initialize gin::IsolateHolder.
     JavascriptEnvironment gin_env(loop);
@@ -86,9 +115,10 @@ int NodeMain(int argc, char* argv[]) {
                                 exec_argc, exec_argv, false);
     CHECK_NE(nullptr, env);
 
-    // Enable support for v8 inspector.
+    // Enable support for v8 inspector. The command line is only parsed again
+    // when it has inspector options.
     NodeDebugger node_debugger(env);
-    node_debugger.Start();
+    node_debugger.Start(parse_inspector_options);
 
     node::BootstrapEnvironment(env);
 
@@ -2,6 +2,8 @@
 // Use of this source code is governed by the MIT license that can be
 // found in the LICENSE file.
 
+#include <algorithm>
+#include <functional>
 #include <utility>
 
 #include "shell/app/uv_task_runner.h"
@@ -10,23 +12,47 @@
 
 namespace electron {
 
-UvTaskRunner::UvTaskRunner(uv_loop_t* loop) : loop_(loop) {}
+UvTaskRunner::DelayedTask::DelayedTask(uint64_t run_time,
+                                       uint64_t sequence_num,
+                                       base::OnceClosure task)
+    : run_time(run_time), sequence_num(sequence_num), task(std::move(task)) {}
+UvTaskRunner::DelayedTask::DelayedTask(DelayedTask&&) = default;
+UvTaskRunner::DelayedTask& UvTaskRunner::DelayedTask::operator=(
+    DelayedTask&&) = default;
+UvTaskRunner::DelayedTask::~DelayedTask() = default;
+
+bool UvTaskRunner::DelayedTask::operator>(const DelayedTask& other) const {
+  if (run_time != other.run_time)
+    return run_time > other.run_time;
+  return sequence_num > other.sequence_num;
+}
+
+UvTaskRunner::UvTaskRunner(uv_loop_t* loop)
+    : loop_(loop), timer_(new uv_timer_t) {
+  timer_->data = this;
+  uv_timer_init(loop_, timer_);
+}
 
 UvTaskRunner::~UvTaskRunner() {
-  for (auto& iter : tasks_) {
-    uv_unref(reinterpret_cast<uv_handle_t*>(iter.first));
-    delete iter.first;
-  }
+  // The pending tasks are dropped, like when their timers were deleted.
+  uv_timer_stop(timer_);
+  timer_->data = nullptr;
+  uv_close(reinterpret_cast<uv_handle_t*>(timer_), UvTaskRunner::OnClose);
 }
 
 bool UvTaskRunner::PostDelayedTask(const base::Location& from_here,
                                    base::OnceClosure task,
                                    base::TimeDelta delay) {
-  auto* timer = new uv_timer_t;
-  timer->data = this;
-  uv_timer_init(loop_, timer);
-  uv_timer_start(timer, UvTaskRunner::OnTimeout, delay.InMilliseconds(), 0);
-  tasks_[timer] = std::move(task);
+  int64_t delay_ms = std::max<int64_t>(delay.InMilliseconds(), 0);
+  if (delay_ms == 0) {
+    immediate_tasks_.push_back(std::move(task));
+  } else {
+    delayed_tasks_.emplace_back(uv_now(loop_) + delay_ms, next_sequence_num_++,
+                                std::move(task));
+    std::push_heap(delayed_tasks_.begin(), delayed_tasks_.end(),
+                   std::greater<DelayedTask>());
+  }
+  ScheduleTimer();
   return true;
 }
 
@@ -40,17 +66,54 @@ bool UvTaskRunner::PostNonNestableDelayedTask(const base::Location& from_here,
   return PostDelayedTask(from_here, std::move(task), delay);
 }
 
+void UvTaskRunner::ScheduleTimer() {
+  uint64_t now = uv_now(loop_);
+  uint64_t next_time = UINT64_MAX;
+  if (!immediate_tasks_.empty())
+    next_time = now;
+  else if (!delayed_tasks_.empty())
+    next_time = std::max(delayed_tasks_.front().run_time, now);
+
+  if (next_time == UINT64_MAX) {
+    if (timer_time_ != UINT64_MAX)
+      uv_timer_stop(timer_);
+  } else if (next_time < timer_time_) {
+    uv_timer_start(timer_, UvTaskRunner::OnTimeout, next_time - now, 0);
+  } else {
+    return;
+  }
+  timer_time_ = next_time;
+}
+
+void UvTaskRunner::RunTasks() {
+  // The tasks posted while these run wait for the next time the timer fires,
+  // so that they do not starve the loop.
+  base::circular_deque<base::OnceClosure> immediate_tasks;
+  immediate_tasks.swap(immediate_tasks_);
+  for (auto& task : immediate_tasks)
+    std::move(task).Run();
+
+  uint64_t now = uv_now(loop_);
+  while (!delayed_tasks_.empty() && delayed_tasks_.front().run_time <= now) {
+    std::pop_heap(delayed_tasks_.begin(), delayed_tasks_.end(),
+                  std::greater<DelayedTask>());
+    base::OnceClosure task = std::move(delayed_tasks_.back().task);
+    delayed_tasks_.pop_back();
+    std::move(task).Run();
+  }
+
+  ScheduleTimer();
+}
+
 // static
 void UvTaskRunner::OnTimeout(uv_timer_t* timer) {
-  auto& tasks = static_cast<UvTaskRunner*>(timer->data)->tasks_;
-  const auto iter = tasks.find(timer);
-  if (iter == std::end(tasks))
+  auto* self = static_cast<UvTaskRunner*>(timer->data);
+  if (!self)
     return;
-
-  std::move(iter->second).Run();
-  tasks.erase(iter);
-  uv_timer_stop(timer);
-  uv_close(reinterpret_cast<uv_handle_t*>(timer), UvTaskRunner::OnClose);
+  // A task may release the last reference to the runner.
+  scoped_refptr<UvTaskRunner> protect(self);
+  self->timer_time_ = UINT64_MAX;
+  self->RunTasks();
 }
 
 // static
@@ -5,9 +5,10 @@
 #ifndef SHELL_APP_UV_TASK_RUNNER_H_
 #define SHELL_APP_UV_TASK_RUNNER_H_
 
-#include <map>
+#include <vector>
 
 #include "base/callback.h"
+#include "base/containers/circular_deque.h"
 #include "base/location.h"
 #include "base/single_thread_task_runner.h"
 #include "uv.h"  // NOLINT(build/include)
@@ -15,6 +16,9 @@
 namespace electron {
 
 // TaskRunner implementation that posts tasks into libuv's default loop.
+//
+// All the tasks share one timer, which is set for the earliest of them, so
+// posting a task neither creates nor closes a libuv handle.
 class UvTaskRunner : public base::SingleThreadTaskRunner {
  public:
   explicit UvTaskRunner(uv_loop_t* loop);
@@ -29,13 +33,43 @@ class UvTaskRunner : public base::SingleThreadTaskRunner {
                                   base::TimeDelta delay) override;
 
  private:
+  struct DelayedTask {
+    DelayedTask(uint64_t run_time,
+                uint64_t sequence_num,
+                base::OnceClosure task);
+    DelayedTask(DelayedTask&&);
+    DelayedTask& operator=(DelayedTask&&);
+    ~DelayedTask();
+
+    // Orders the heap by the earliest run time, then by posting order.
+    bool operator>(const DelayedTask& other) const;
+
+    // In the milliseconds of uv_now().
+    uint64_t run_time;
+    uint64_t sequence_num;
+    base::OnceClosure task;
+  };
+
   ~UvTaskRunner() override;
+
+  // Sets the timer for the next task, when it would run earlier than the
+  // timer is set for.
+  void ScheduleTimer();
+  void RunTasks();
+
   static void OnTimeout(uv_timer_t* timer);
   static void OnClose(uv_handle_t* handle);
 
   uv_loop_t* loop_;
+  uv_timer_t* timer_;
+  // When |timer_| fires, or UINT64_MAX when it is stopped.
+  uint64_t timer_time_ = UINT64_MAX;
 
-  std::map<uv_timer_t*, base::OnceClosure> tasks_;
+  // The tasks posted without a delay, which run in order.
+  base::circular_deque<base::OnceClosure> immediate_tasks_;
+  // A min-heap of the delayed tasks.
+  std::vector<DelayedTask> delayed_tasks_;
+  uint64_t next_sequence_num_ = 0;
 
   DISALLOW_COPY_AND_ASSIGN(UvTaskRunner);
 };
@@ -0,0 +1,218 @@
+// Copyright (c) 2020 GitHub, Inc.
+// Use of this source code is governed by the MIT license that can be
+// found in the LICENSE file.
+
+#include "shell/browser/addon_hooks.h"
+
+#include <map>
+#include <string>
+#include <vector>
+
+#include "base/no_destructor.h"
+#include "base/stl_util.h"
+#include "content/public/browser/browser_thread.h"
+#include "shell/browser/api/atom_api_top_level_window.h"
+#include "shell/browser/api/atom_api_web_contents.h"
+#include "third_party/skia/include/core/SkBitmap.h"
+#include "ui/gfx/geometry/rect.h"
+
+namespace electron {
+
+namespace addon_hooks {
+
+namespace {
+
+// The events which can be hooked, the others are only emitted to JavaScript.
+const char* const kWebContentsEvents[] = {"dom-ready", "did-finish-load",
+                                          "crashed", "destroyed"};
+const char* const kWindowEvents[] = {"resize", "move", "focus", "blur",
+                                     "closed"};
+
+struct PaintHook {
+  int32_t web_contents_id;
+  electron_frame_callback callback;
+  void* user_data;
+};
+
+struct EventHook {
+  electron_event_target target;
+  int32_t target_id;
+  std::string event_name;
+  electron_event_callback callback;
+  void* user_data;
+};
+
+// The ids of both kinds of hooks, which do not overlap.
+uint32_t next_hook_id = 1;
+
+std::map<uint32_t, PaintHook>& GetPaintHooks() {
+  static base::NoDestructor<std::map<uint32_t, PaintHook>> hooks;
+  return *hooks;
+}
+
+std::map<uint32_t, EventHook>& GetEventHooks() {
+  static base::NoDestructor<std::map<uint32_t, EventHook>> hooks;
+  return *hooks;
+}
+
+bool IsHookableEvent(electron_event_target target,
+                     const std::string& event_name) {
+  if (target == ELECTRON_EVENT_TARGET_WEB_CONTENTS)
+    return base::Contains(kWebContentsEvents, event_name);
+  return base::Contains(kWindowEvents, event_name);
+}
+
+uint32_t AddPaintHook(int32_t web_contents_id,
+                      electron_frame_callback callback,
+                      void* user_data) {
+  DCHECK_CURRENTLY_ON(content::BrowserThread::UI);
+  auto* web_contents = api::WebContents::FromWeakMapID(
+      v8::Isolate::GetCurrent(), web_contents_id);
+  if (!callback || !web_contents || !web_contents->IsOffScreen())
+    return 0;
+  uint32_t hook_id = next_hook_id++;
+  GetPaintHooks()[hook_id] = {web_contents_id, callback, user_data};
+  return hook_id;
+}
+
+void RemovePaintHook(uint32_t hook_id) {
+  DCHECK_CURRENTLY_ON(content::BrowserThread::UI);
+  GetPaintHooks().erase(hook_id);
+}
+
+uint32_t AddEventHook(electron_event_target target,
+                      int32_t target_id,
+                      const char* event_name,
+                      electron_event_callback callback,
+                      void* user_data) {
+  DCHECK_CURRENTLY_ON(content::BrowserThread::UI);
+  if (!callback || !event_name)
+    return 0;
+  v8::Isolate* isolate = v8::Isolate::GetCurrent();
+  bool exists;
+  switch (target) {
+    case ELECTRON_EVENT_TARGET_WEB_CONTENTS:
+      exists = !!api::WebContents::FromWeakMapID(isolate, target_id);
+      break;
+    case ELECTRON_EVENT_TARGET_WINDOW:
+      exists = !!api::TopLevelWindow::FromWeakMapID(isolate, target_id);
+      break;
+    default:
+      return 0;
+  }
+  if (!exists || !IsHookableEvent(target, event_name))
+    return 0;
+  uint32_t hook_id = next_hook_id++;
+  GetEventHooks()[hook_id] = {target, target_id, event_name, callback,
+                              user_data};
+  return hook_id;
+}
+
+void RemoveEventHook(uint32_t hook_id) {
+  DCHECK_CURRENTLY_ON(content::BrowserThread::UI);
+  GetEventHooks().erase(hook_id);
+}
+
+const electron_addon_api kAddonApi = {
+    ELECTRON_ADDON_API_VERSION,
+    &AddPaintHook,
+    &RemovePaintHook,
+    &AddEventHook,
+    &RemoveEventHook,
+};
+
+}  // namespace
+
+bool HasPaintHooks(int32_t web_contents_id) {
+  for (const auto& it : GetPaintHooks()) {
+    if (it.second.web_contents_id == web_contents_id)
+      return true;
+  }
+  return false;
+}
+
+void DispatchPaint(int32_t web_contents_id,
+                   const gfx::Rect& dirty_rect,
+                   const SkBitmap& bitmap) {
+  if (bitmap.drawsNothing())
+    return;
+
+  electron_frame frame = {
+      bitmap.getPixels(),
+      bitmap.width(),
+      bitmap.height(),
+      static_cast<int32_t>(bitmap.rowBytes()),
+      dirty_rect.x(),
+      dirty_rect.y(),
+      dirty_rect.width(),
+      dirty_rect.height(),
+  };
+
+  // The callbacks may remove hooks, theirs included.
+  std::vector<uint32_t> hook_ids;
+  for (const auto& it : GetPaintHooks()) {
+    if (it.second.web_contents_id == web_contents_id)
+      hook_ids.push_back(it.first);
+  }
+  for (uint32_t hook_id : hook_ids) {
+    auto& hooks = GetPaintHooks();
+    auto it = hooks.find(hook_id);
+    if (it != hooks.end())
+      it->second.callback(&frame, it->second.user_data);
+  }
+}
+
+void RemovePaintHooks(int32_t web_contents_id) {
+  auto& hooks = GetPaintHooks();
+  for (auto it = hooks.begin(); it != hooks.end();) {
+    if (it->second.web_contents_id == web_contents_id)
+      it = hooks.erase(it);
+    else
+      ++it;
+  }
+}
+
+void DispatchEvent(electron_event_target target,
+                   int32_t target_id,
+                   const char* event_name) {
+  auto& hooks = GetEventHooks();
+  if (hooks.empty())
+    return;
+
+  // The callbacks may remove hooks, theirs included.
+  std::vector<uint32_t> hook_ids;
+  for (const auto& it : hooks) {
+    if (it.second.target == target && it.second.target_id == target_id &&
+        it.second.event_name == event_name)
+      hook_ids.push_back(it.first);
+  }
+  for (uint32_t hook_id : hook_ids) {
+    auto it = hooks.find(hook_id);
+    if (it != hooks.end())
+      it->second.callback(event_name, target_id, it->second.user_data);
+  }
+}
+
+void RemoveEventHooks(electron_event_target target, int32_t target_id) {
+  auto& hooks = GetEventHooks();
+  for (auto it = hooks.begin(); it != hooks.end();) {
+    if (it->second.target == target && it->second.target_id == target_id)
+      it = hooks.erase(it);
+    else
+      ++it;
+  }
+}
+
+}  // namespace addon_hooks
+
+}  // namespace electron
+
+extern "C" {
+
+const electron_addon_api* electron_get_addon_api(uint32_t version) {
+  if (version == 0 || version > ELECTRON_ADDON_API_VERSION)
+    return nullptr;
+  return &electron::addon_hooks::kAddonApi;
+}
+
+}  // extern "C"
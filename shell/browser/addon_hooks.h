@@ -0,0 +1,47 @@
+// Copyright (c) 2020 GitHub, Inc.
+// Use of this source code is governed by the MIT license that can be
+// found in the LICENSE file.
+
+#ifndef SHELL_BROWSER_ADDON_HOOKS_H_
+#define SHELL_BROWSER_ADDON_HOOKS_H_
+
+#include <stdint.h>
+
+#include "shell/browser/electron_addon_api.h"
+
+class SkBitmap;
+
+namespace gfx {
+class Rect;
+}
+
+namespace electron {
+
+// Implements the hooks of electron_addon_api.h, on the UI thread.
+namespace addon_hooks {
+
+// Whether a native addon hooked the frames of |web_contents_id|, which is
+// checked on each paint.
+bool HasPaintHooks(int32_t web_contents_id);
+
+void DispatchPaint(int32_t web_contents_id,
+                   const gfx::Rect& dirty_rect,
+                   const SkBitmap& bitmap);
+
+// Removes the hooks of a web contents which is destroyed.
+void RemovePaintHooks(int32_t web_contents_id);
+
+// Calls the hooks of |event_name| emitted by |target_id|, which is cheap when
+// there are none.
+void DispatchEvent(electron_event_target target,
+                   int32_t target_id,
+                   const char* event_name);
+
+// Removes the event hooks of a target which is destroyed.
+void RemoveEventHooks(electron_event_target target, int32_t target_id);
+
+}  // namespace addon_hooks
+
+}  // namespace electron
+
+#endif  // SHELL_BROWSER_ADDON_HOOKS_H_
@@ -0,0 +1,90 @@
+// Copyright (c) 2020 GitHub, Inc.
+// Use of this source code is governed by the MIT license that can be
+// found in the LICENSE file.
+
+#include "shell/browser/after_startup_tasks.h"
+
+#include <atomic>
+#include <utility>
+#include <vector>
+
+#include "base/bind.h"
+#include "base/callback.h"
+#include "base/lazy_instance.h"
+#include "base/location.h"
+#include "base/sequenced_task_runner.h"
+#include "base/synchronization/lock.h"
+#include "base/threading/thread_task_runner_handle.h"
+#include "base/time/time.h"
+
+namespace electron {
+
+namespace {
+
+// Apps that never paint a window complete startup after this delay.
+const int kMaxStartupDelaySeconds = 10;
+
+struct AfterStartupTask {
+  base::Location from_here;
+  scoped_refptr<base::SequencedTaskRunner> task_runner;
+  base::OnceClosure task;
+};
+
+struct AfterStartupTasks {
+  base::Lock lock;
+  std::vector<AfterStartupTask> tasks;
+};
+
+base::LazyInstance<AfterStartupTasks>::Leaky g_tasks =
+    LAZY_INSTANCE_INITIALIZER;
+
+// Checked without the lock by IsBrowserStartupComplete().
+std::atomic<bool> g_startup_complete{true};
+
+}  // namespace
+
+void EnableDeferredStartup() {
+  g_startup_complete.store(false);
+}
+
+void StartDeferredStartupTimeout() {
+  if (IsBrowserStartupComplete())
+    return;
+  base::ThreadTaskRunnerHandle::Get()->PostDelayedTask(
+      FROM_HERE, base::BindOnce(&SetBrowserStartupIsComplete),
+      base::TimeDelta::FromSeconds(kMaxStartupDelaySeconds));
+}
+
+void PostAfterStartupTask(
+    const base::Location& from_here,
+    const scoped_refptr<base::SequencedTaskRunner>& task_runner,
+    base::OnceClosure task) {
+  {
+    AfterStartupTasks& tasks = g_tasks.Get();
+    base::AutoLock auto_lock(tasks.lock);
+    if (!g_startup_complete.load()) {
+      tasks.tasks.push_back({from_here, task_runner, std::move(task)});
+      return;
+    }
+  }
+  task_runner->PostTask(from_here, std::move(task));
+}
+
+bool IsBrowserStartupComplete() {
+  return g_startup_complete.load(std::memory_order_relaxed);
+}
+
+void SetBrowserStartupIsComplete() {
+  std::vector<AfterStartupTask> queued;
+  {
+    AfterStartupTasks& tasks = g_tasks.Get();
+    base::AutoLock auto_lock(tasks.lock);
+    if (g_startup_complete.exchange(true))
+      return;
+    queued.swap(tasks.tasks);
+  }
+  for (auto& task : queued)
+    task.task_runner->PostTask(task.from_here, std::move(task.task));
+}
+
+}  // namespace electron
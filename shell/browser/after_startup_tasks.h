@@ -0,0 +1,46 @@
+// Copyright (c) 2020 GitHub, Inc.
+// Use of this source code is governed by the MIT license that can be
+// found in the LICENSE file.
+
+#ifndef SHELL_BROWSER_AFTER_STARTUP_TASKS_H_
+#define SHELL_BROWSER_AFTER_STARTUP_TASKS_H_
+
+#include "base/callback_forward.h"
+#include "base/memory/scoped_refptr.h"
+
+namespace base {
+class Location;
+class SequencedTaskRunner;
+}  // namespace base
+
+namespace electron {
+
+// Tasks that can wait until the app has started, posted by Chromium through
+// ContentBrowserClient::PostAfterStartupTask and by Electron for its own
+// non-critical startup work.
+//
+// With --enable-deferred-startup the tasks are held until the first paint of
+// a window, or until a timeout for apps that do not show one. Otherwise they
+// are posted right away.
+
+// Holds the tasks posted from now on, until startup completes.
+void EnableDeferredStartup();
+
+// Completes startup after the timeout unless it completed before. Called once
+// the main message loop is about to run.
+void StartDeferredStartupTimeout();
+
+// Posts |task| to |task_runner| once startup has completed.
+void PostAfterStartupTask(
+    const base::Location& from_here,
+    const scoped_refptr<base::SequencedTaskRunner>& task_runner,
+    base::OnceClosure task);
+
+bool IsBrowserStartupComplete();
+
+// Completes startup and posts the tasks held until now.
+void SetBrowserStartupIsComplete();
+
+}  // namespace electron
+
+#endif  // SHELL_BROWSER_AFTER_STARTUP_TASKS_H_
@@ -13,9 +13,12 @@
 #include "base/environment.h"
 #include "base/files/file_path.h"
 #include "base/files/file_util.h"
+#include "base/json/json_writer.h"
 #include "base/optional.h"
 #include "base/path_service.h"
+#include "base/strings/string_number_conversions.h"
 #include "base/system/sys_info.h"
+#include "base/task/post_task.h"
 #include "chrome/browser/browser_process.h"
 #include "chrome/browser/icon_manager.h"
 #include "chrome/common/chrome_paths.h"
@@ -44,6 +47,7 @@
 #include "shell/common/application_info.h"
 #include "shell/common/atom_command_line.h"
 #include "shell/common/gin_converters/callback_converter.h"
+#include "shell/common/gin_converters/content_converter.h"
 #include "shell/common/gin_converters/file_path_converter.h"
 #include "shell/common/gin_converters/gurl_converter.h"
 #include "shell/common/gin_converters/image_converter.h"
@@ -53,6 +57,7 @@
 #include "shell/common/gin_helper/object_template_builder.h"
 #include "shell/common/node_includes.h"
 #include "shell/common/options_switches.h"
+#include "shell/common/startup_timeline.h"
 #include "ui/gfx/image/image.h"
 
 #if defined(OS_WIN)
@@ -381,6 +386,11 @@ namespace api {
 
 namespace {
 
+// Tells the relaunched app that the state was handed off to it, see
+// app.getRelaunchHandoff().
+const relauncher::CharType kRelaunchHandoffArg[] =
+    FILE_PATH_LITERAL("--relaunch-handoff");
+
 IconLoader::IconSize GetIconSizeByString(const std::string& size) {
   if (size == "small") {
     return IconLoader::IconSize::SMALL;
@@ -532,9 +542,99 @@ void OnIconDataAvailable(gin_helper::Promise<gfx::Image> promise,
   }
 }
 
+template <typename ArrayType, typename T>
+v8::Local<v8::Value> ToTypedArray(v8::Isolate* isolate,
+                                  const std::vector<T>& values) {
+  auto buffer = v8::ArrayBuffer::New(isolate, values.size() * sizeof(T));
+  if (!values.empty())
+    memcpy(buffer->GetBackingStore()->Data(), values.data(),
+           values.size() * sizeof(T));
+  return ArrayType::New(buffer, 0, values.size());
+}
+
+const char kCpuProfileTitle[] = "electron-main";
+
+// The default sampling interval of the profiler, which samples 1000 times per
+// second.
+const int kDefaultProfilingIntervalUs = 1000;
+
+base::Value CpuProfileNodeToValue(v8::Isolate* isolate,
+                                  const v8::CpuProfileNode* node) {
+  base::Value call_frame(base::Value::Type::DICTIONARY);
+  std::string function_name, url;
+  gin::ConvertFromV8(isolate, node->GetFunctionName(), &function_name);
+  gin::ConvertFromV8(isolate, node->GetScriptResourceName(), &url);
+  call_frame.SetStringKey("functionName", function_name);
+  call_frame.SetStringKey("scriptId",
+                          base::NumberToString(node->GetScriptId()));
+  call_frame.SetStringKey("url", url);
+  // The profile counts from 0, and V8 from 1.
+  call_frame.SetIntKey("lineNumber", node->GetLineNumber() - 1);
+  call_frame.SetIntKey("columnNumber", node->GetColumnNumber() - 1);
+
+  base::Value result(base::Value::Type::DICTIONARY);
+  result.SetIntKey("id", node->GetNodeId());
+  result.SetKey("callFrame", std::move(call_frame));
+  result.SetIntKey("hitCount", node->GetHitCount());
+  base::Value children(base::Value::Type::LIST);
+  for (int i = 0; i < node->GetChildrenCount(); ++i)
+    children.Append(node->GetChild(i)->GetNodeId());
+  result.SetKey("children", std::move(children));
+  return result;
+}
+
+// Returns the profile in the format of the .cpuprofile files of the DevTools.
+base::Value CpuProfileToValue(v8::Isolate* isolate,
+                              const v8::CpuProfile* profile) {
+  base::Value nodes(base::Value::Type::LIST);
+  std::vector<const v8::CpuProfileNode*> pending = {profile->GetTopDownRoot()};
+  while (!pending.empty()) {
+    const v8::CpuProfileNode* node = pending.back();
+    pending.pop_back();
+    nodes.Append(CpuProfileNodeToValue(isolate, node));
+    for (int i = node->GetChildrenCount() - 1; i >= 0; --i)
+      pending.push_back(node->GetChild(i));
+  }
+
+  base::Value samples(base::Value::Type::LIST);
+  base::Value time_deltas(base::Value::Type::LIST);
+  int64_t last_timestamp = profile->GetStartTime();
+  for (int i = 0; i < profile->GetSamplesCount(); ++i) {
+    samples.Append(profile->GetSample(i)->GetNodeId());
+    int64_t timestamp = profile->GetSampleTimestamp(i);
+    time_deltas.Append(static_cast<int>(timestamp - last_timestamp));
+    last_timestamp = timestamp;
+  }
+
+  base::Value result(base::Value::Type::DICTIONARY);
+  result.SetKey("nodes", std::move(nodes));
+  result.SetDoubleKey("startTime", profile->GetStartTime());
+  result.SetDoubleKey("endTime", profile->GetEndTime());
+  result.SetKey("samples", std::move(samples));
+  result.SetKey("timeDeltas", std::move(time_deltas));
+  return result;
+}
+
+bool WriteCpuProfile(const base::FilePath& path, base::Value profile) {
+  std::string json;
+  if (!base::JSONWriter::Write(profile, &json))
+    return false;
+  return base::WriteFile(path, json.data(), json.size()) ==
+         static_cast<int>(json.size());
+}
+
+void OnCpuProfileWritten(gin_helper::Promise<void> promise, bool success) {
+  if (success)
+    promise.Resolve();
+  else
+    promise.RejectWithErrorMessage("Failed to write the profile");
+}
+
 }  // namespace
 
-App::App(v8::Isolate* isolate) {
+App::App(v8::Isolate* isolate)
+    : memory_pressure_listener_(
+          base::BindRepeating(&App::OnMemoryPressure, base::Unretained(this))) {
   static_cast<AtomBrowserClient*>(AtomBrowserClient::Get())->set_delegate(this);
   Browser::Get()->AddObserver(this);
   content::GpuDataManager::GetInstance()->AddObserver(this);
@@ -548,6 +648,8 @@ App::App(v8::Isolate* isolate) {
 }
 
 App::~App() {
+  if (cpu_profiler_)
+    cpu_profiler_->Dispose();
   static_cast<AtomBrowserClient*>(AtomBrowserClient::Get())
       ->set_delegate(nullptr);
   Browser::Get()->RemoveObserver(this);
@@ -605,6 +707,7 @@ void App::OnFinishLaunching(const base::DictionaryValue& launch_info) {
   // applications. Only affects pulseaudio currently.
   media::AudioManager::SetGlobalAppName(Browser::Get()->GetName());
 #endif
+  MarkStartupPhase("ready");
   Emit("ready", launch_info);
 }
 
@@ -778,6 +881,9 @@ void App::BrowserChildProcessKilled(
 void App::RenderProcessReady(content::RenderProcessHost* host) {
   ChildProcessLaunched(content::PROCESS_TYPE_RENDERER,
                        host->GetProcess().Handle());
+  auto iter = app_metrics_.find(host->GetProcess().Pid());
+  if (iter != app_metrics_.end())
+    iter->second->render_process_id = host->GetID();
 
   // TODO(jeremy): this isn't really the right place to be creating
   // `WebContents` instances, but this was implicitly happening before in
@@ -978,6 +1084,7 @@ void App::ReleaseSingleInstanceLock() {
 bool App::Relaunch(gin_helper::Arguments* js_args) {
   // Parse parameters.
   bool override_argv = false;
+  bool handoff = false;
   base::FilePath exec_path;
   relauncher::StringVector args;
 
@@ -985,15 +1092,22 @@ bool App::Relaunch(gin_helper::Arguments* js_args) {
   if (js_args->GetNext(&options)) {
     if (options.Get("execPath", &exec_path) | options.Get("args", &args))
       override_argv = true;
+    options.Get("_handoff", &handoff);
   }
 
+  relauncher::StringVector argv;
   if (!override_argv) {
-    const relauncher::StringVector& argv = electron::AtomCommandLine::argv();
+    // The flag of an earlier handoff is only kept when there is a new one.
+    for (const auto& arg : electron::AtomCommandLine::argv()) {
+      if (arg != kRelaunchHandoffArg)
+        argv.push_back(arg);
+    }
+    if (handoff)
+      argv.push_back(kRelaunchHandoffArg);
     return relauncher::RelaunchApp(argv);
   }
 
-  relauncher::StringVector argv;
-  argv.reserve(1 + args.size());
+  argv.reserve(2 + args.size());
 
   if (exec_path.empty()) {
     base::FilePath current_exe_path;
@@ -1004,6 +1118,8 @@ bool App::Relaunch(gin_helper::Arguments* js_args) {
   }
 
   argv.insert(argv.end(), args.begin(), args.end());
+  if (handoff)
+    argv.push_back(kRelaunchHandoffArg);
 
   return relauncher::RelaunchApp(argv);
 }
@@ -1248,6 +1364,224 @@ std::vector<gin_helper::Dictionary> App::GetAppMetrics(v8::Isolate* isolate) {
   return result;
 }
 
+void App::StartProcessMetricsSampling(gin_helper::ErrorThrower thrower,
+                                      int interval_ms) {
+  if (interval_ms <= 0) {
+    thrower.ThrowError("interval must be a positive number");
+    return;
+  }
+  // The next sample measures from now.
+  for (const auto& process_metric : app_metrics_) {
+    ProcessMetric* metric = process_metric.second.get();
+    metric->last_cpu_time = metric->metrics->GetCumulativeCPUUsage();
+    base::IoCounters io_counters;
+    if (metric->metrics->GetIOCounters(&io_counters)) {
+      metric->last_read_bytes = io_counters.ReadTransferCount;
+      metric->last_write_bytes = io_counters.WriteTransferCount;
+    }
+  }
+  last_process_metrics_sample_ = base::TimeTicks::Now();
+  process_metrics_timer_.Start(
+      FROM_HERE, base::TimeDelta::FromMilliseconds(interval_ms),
+      base::BindRepeating(&App::SampleProcessMetrics, base::Unretained(this)));
+}
+
+void App::StopProcessMetricsSampling() {
+  process_metrics_timer_.Stop();
+}
+
+void App::SampleProcessMetrics() {
+  // The GPU memory arrives with the next sample.
+  content::GpuDataManager::GetInstance()->RequestVideoMemoryUsageStatsUpdate(
+      base::BindOnce(&App::OnVideoMemoryUsageStats,
+                     weak_factory_.GetWeakPtr()));
+
+  v8::Isolate* isolate = v8::Isolate::GetCurrent();
+  v8::Locker locker(isolate);
+  v8::HandleScope handle_scope(isolate);
+
+  // One entry per process in each array, so that sampling many processes
+  // often creates a handful of objects.
+  const size_t count = app_metrics_.size();
+  std::vector<int32_t> pids, web_contents_ids, handle_counts;
+  std::vector<double> cpu_time, private_memory, gpu_memory, read_bytes,
+      write_bytes;
+  pids.reserve(count);
+  web_contents_ids.reserve(count);
+  handle_counts.reserve(count);
+  cpu_time.reserve(count);
+  private_memory.reserve(count);
+  gpu_memory.reserve(count);
+  read_bytes.reserve(count);
+  write_bytes.reserve(count);
+  std::vector<std::string> types;
+  types.reserve(count);
+
+  for (const auto& process_metric : app_metrics_) {
+    ProcessMetric* metric = process_metric.second.get();
+    pids.push_back(metric->process.Pid());
+    types.push_back(content::GetProcessTypeNameInEnglish(metric->type));
+
+    int web_contents_id = -1;
+    if (metric->render_process_id != -1) {
+      auto* web_contents =
+          AtomBrowserClient::Get()->GetWebContentsFromProcessID(
+              metric->render_process_id);
+      auto api_web_contents =
+          web_contents ? WebContents::From(isolate, web_contents)
+                       : gin::Handle<WebContents>();
+      if (!api_web_contents.IsEmpty())
+        web_contents_id = api_web_contents->ID();
+    }
+    web_contents_ids.push_back(web_contents_id);
+
+    base::TimeDelta cpu = metric->metrics->GetCumulativeCPUUsage();
+    cpu_time.push_back((cpu - metric->last_cpu_time).InMillisecondsF());
+    metric->last_cpu_time = cpu;
+
+    base::IoCounters io_counters;
+    if (metric->metrics->GetIOCounters(&io_counters)) {
+      read_bytes.push_back(io_counters.ReadTransferCount -
+                           metric->last_read_bytes);
+      write_bytes.push_back(io_counters.WriteTransferCount -
+                            metric->last_write_bytes);
+      metric->last_read_bytes = io_counters.ReadTransferCount;
+      metric->last_write_bytes = io_counters.WriteTransferCount;
+    } else {
+      read_bytes.push_back(0);
+      write_bytes.push_back(0);
+    }
+
+    private_memory.push_back(metric->GetPrivateMemoryFootprint() >> 10);
+    auto gpu = video_memory_usage_stats_.process_map.find(
+        metric->process.Pid());
+    gpu_memory.push_back(
+        gpu == video_memory_usage_stats_.process_map.end()
+            ? 0
+            : static_cast<double>(gpu->second.video_memory >> 10));
+    handle_counts.push_back(metric->GetHandleCount());
+  }
+
+  base::TimeTicks now = base::TimeTicks::Now();
+  gin_helper::Dictionary sample = gin::Dictionary::CreateEmpty(isolate);
+  sample.Set("interval",
+             (now - last_process_metrics_sample_).InMillisecondsF());
+  last_process_metrics_sample_ = now;
+  sample.Set("pid", ToTypedArray<v8::Int32Array>(isolate, pids));
+  sample.Set("type", types);
+  sample.Set("webContentsId",
+             ToTypedArray<v8::Int32Array>(isolate, web_contents_ids));
+  sample.Set("cpuTime", ToTypedArray<v8::Float64Array>(isolate, cpu_time));
+  sample.Set("privateMemory",
+             ToTypedArray<v8::Float64Array>(isolate, private_memory));
+  sample.Set("gpuMemory", ToTypedArray<v8::Float64Array>(isolate, gpu_memory));
+  sample.Set("ioReadBytes",
+             ToTypedArray<v8::Float64Array>(isolate, read_bytes));
+  sample.Set("ioWriteBytes",
+             ToTypedArray<v8::Float64Array>(isolate, write_bytes));
+  sample.Set("handles", ToTypedArray<v8::Int32Array>(isolate, handle_counts));
+  Emit("process-metrics", sample);
+}
+
+void App::OnVideoMemoryUsageStats(const gpu::VideoMemoryUsageStats& stats) {
+  video_memory_usage_stats_ = stats;
+}
+
+void App::StartHangWatchdog(gin_helper::ErrorThrower thrower,
+                            const gin_helper::Dictionary& options) {
+  int threshold_ms = 0;
+  if (!options.Get("threshold", &threshold_ms) || threshold_ms <= 0) {
+    thrower.ThrowError("threshold must be a positive number");
+    return;
+  }
+  bool write_minidump = false;
+  options.Get("writeMinidump", &write_minidump);
+  // Replaces the previous watchdog, and its settings.
+  hang_watchdog_.reset();
+  hang_watchdog_ = std::make_unique<HangWatchdog>(
+      isolate(), base::TimeDelta::FromMilliseconds(threshold_ms),
+      write_minidump,
+      base::BindRepeating(&App::OnMainThreadHang, base::Unretained(this)));
+}
+
+void App::StopHangWatchdog() {
+  hang_watchdog_.reset();
+}
+
+void App::StartProfiling(gin_helper::ErrorThrower thrower,
+                         gin::Arguments* args) {
+  if (cpu_profiler_) {
+    thrower.ThrowError("The main process is already profiled");
+    return;
+  }
+  int interval_us = kDefaultProfilingIntervalUs;
+  gin_helper::Dictionary options;
+  if (args->GetNext(&options))
+    options.Get("intervalUs", &interval_us);
+  if (interval_us <= 0) {
+    thrower.ThrowError("intervalUs must be a positive number");
+    return;
+  }
+
+  v8::HandleScope handle_scope(isolate());
+  cpu_profiler_ = v8::CpuProfiler::New(isolate());
+  cpu_profiler_->SetSamplingInterval(interval_us);
+  cpu_profiler_->StartProfiling(gin::StringToV8(isolate(), kCpuProfileTitle),
+                                true /* record_samples */);
+}
+
+v8::Local<v8::Promise> App::StopProfiling(const base::FilePath& path) {
+  gin_helper::Promise<void> promise(isolate());
+  v8::Local<v8::Promise> handle = promise.GetHandle();
+  if (!cpu_profiler_) {
+    promise.RejectWithErrorMessage("The main process is not profiled");
+    return handle;
+  }
+
+  v8::HandleScope handle_scope(isolate());
+  v8::CpuProfile* profile = cpu_profiler_->StopProfiling(
+      gin::StringToV8(isolate(), kCpuProfileTitle));
+  cpu_profiler_->Dispose();
+  cpu_profiler_ = nullptr;
+  if (!profile) {
+    promise.RejectWithErrorMessage("Failed to stop the profiler");
+    return handle;
+  }
+
+  // The profile belongs to V8, so only its serialization and the write happen
+  // on another thread.
+  base::Value value = CpuProfileToValue(isolate(), profile);
+  profile->Delete();
+  base::PostTaskAndReplyWithResult(
+      FROM_HERE, {base::ThreadPool(), base::MayBlock()},
+      base::BindOnce(&WriteCpuProfile, path, std::move(value)),
+      base::BindOnce(&OnCpuProfileWritten, std::move(promise)));
+  return handle;
+}
+
+void App::OnMainThreadHang(const HangWatchdog::Hang& hang) {
+  v8::Locker locker(isolate());
+  v8::HandleScope handle_scope(isolate());
+  gin_helper::Dictionary details = gin::Dictionary::CreateEmpty(isolate());
+  details.Set("duration", hang.duration.InMillisecondsF());
+  details.Set("jsStack", hang.js_stack);
+  details.Set("nativeStacks", hang.native_stacks);
+  details.Set("minidumpWritten", hang.minidump_written);
+  Emit("main-process-unresponsive", details);
+}
+
+void App::OnMemoryPressure(
+    base::MemoryPressureListener::MemoryPressureLevel level) {
+  v8::Locker locker(isolate());
+  v8::HandleScope handle_scope(isolate());
+  Emit("memory-pressure", level);
+}
+
+void App::PurgeMemory(base::MemoryPressureListener::MemoryPressureLevel level) {
+  // The listeners are notified asynchronously, including OnMemoryPressure.
+  base::MemoryPressureListener::NotifyMemoryPressure(level);
+}
+
 v8::Local<v8::Value> App::GetGPUFeatureStatus(v8::Isolate* isolate) {
   auto status = content::GetFeatureStatus();
   base::DictionaryValue temp;
@@ -1501,6 +1835,15 @@ void App::BuildPrototype(v8::Isolate* isolate,
                  &App::DisableDomainBlockingFor3DAPIs)
       .SetMethod("getFileIcon", &App::GetFileIcon)
       .SetMethod("getAppMetrics", &App::GetAppMetrics)
+      .SetMethod("startProcessMetricsSampling",
+                 &App::StartProcessMetricsSampling)
+      .SetMethod("stopProcessMetricsSampling",
+                 &App::StopProcessMetricsSampling)
+      .SetMethod("startHangWatchdog", &App::StartHangWatchdog)
+      .SetMethod("stopHangWatchdog", &App::StopHangWatchdog)
+      .SetMethod("startProfiling", &App::StartProfiling)
+      .SetMethod("stopProfiling", &App::StopProfiling)
+      .SetMethod("_purgeMemory", &App::PurgeMemory)
       .SetMethod("getGPUFeatureStatus", &App::GetGPUFeatureStatus)
       .SetMethod("getGPUInfo", &App::GetGPUInfo)
 #if defined(MAS_BUILD)
@@ -11,13 +11,18 @@
 #include <utility>
 #include <vector>
 
+#include "base/memory/memory_pressure_listener.h"
+#include "base/memory/weak_ptr.h"
 #include "base/task/cancelable_task_tracker.h"
+#include "base/time/time.h"
+#include "base/timer/timer.h"
 #include "chrome/browser/icon_manager.h"
 #include "chrome/browser/process_singleton.h"
 #include "content/public/browser/browser_child_process_observer.h"
 #include "content/public/browser/gpu_data_manager_observer.h"
 #include "content/public/browser/render_process_host.h"
 #include "gin/handle.h"
+#include "gpu/ipc/common/memory_stats.h"
 #include "net/base/completion_once_callback.h"
 #include "net/base/completion_repeating_callback.h"
 #include "net/ssl/client_cert_identity.h"
@@ -25,10 +30,12 @@
 #include "shell/browser/atom_browser_client.h"
 #include "shell/browser/browser.h"
 #include "shell/browser/browser_observer.h"
+#include "shell/browser/hang_watchdog.h"
 #include "shell/common/gin_helper/dictionary.h"
 #include "shell/common/gin_helper/error_thrower.h"
 #include "shell/common/gin_helper/event_emitter.h"
 #include "shell/common/gin_helper/promise.h"
+#include "v8/include/v8-profiler.h"
 
 #if defined(USE_NSS_CERTS)
 #include "chrome/browser/certificate_manager_model.h"
@@ -191,6 +198,23 @@ class App : public AtomBrowserClient::Delegate,
                                      gin_helper::Arguments* args);
 
   std::vector<gin_helper::Dictionary> GetAppMetrics(v8::Isolate* isolate);
+  void StartProcessMetricsSampling(gin_helper::ErrorThrower thrower,
+                                   int interval_ms);
+  void StopProcessMetricsSampling();
+  // Emits "process-metrics" with the counters of all the processes.
+  void SampleProcessMetrics();
+  void OnVideoMemoryUsageStats(const gpu::VideoMemoryUsageStats& stats);
+  void StartHangWatchdog(gin_helper::ErrorThrower thrower,
+                         const gin_helper::Dictionary& options);
+  void StopHangWatchdog();
+  void OnMainThreadHang(const HangWatchdog::Hang& hang);
+  void OnMemoryPressure(
+      base::MemoryPressureListener::MemoryPressureLevel level);
+  // Runs the memory pressure listeners of the main process as if the system
+  // had signaled |level|.
+  void PurgeMemory(base::MemoryPressureListener::MemoryPressureLevel level);
+  void StartProfiling(gin_helper::ErrorThrower thrower, gin::Arguments* args);
+  v8::Local<v8::Promise> StopProfiling(const base::FilePath& path);
   v8::Local<v8::Value> GetGPUFeatureStatus(v8::Isolate* isolate);
   v8::Local<v8::Promise> GetGPUInfo(v8::Isolate* isolate,
                                     const std::string& info_type);
@@ -237,6 +261,20 @@ class App : public AtomBrowserClient::Delegate,
                          std::unique_ptr<electron::ProcessMetric>>;
   ProcessMetricMap app_metrics_;
 
+  base::RepeatingTimer process_metrics_timer_;
+  base::TimeTicks last_process_metrics_sample_;
+  // The GPU memory of each process, from the last answer of the GPU process.
+  gpu::VideoMemoryUsageStats video_memory_usage_stats_;
+
+  std::unique_ptr<HangWatchdog> hang_watchdog_;
+
+  base::MemoryPressureListener memory_pressure_listener_;
+
+  // Samples the JavaScript of the main process while it is profiled.
+  v8::CpuProfiler* cpu_profiler_ = nullptr;
+
+  base::WeakPtrFactory<App> weak_factory_{this};
+
   DISALLOW_COPY_AND_ASSIGN(App);
 };
 
@@ -12,10 +12,12 @@
 #include "content/browser/web_contents/web_contents_impl.h"  // nogncheck
 #include "content/public/browser/render_process_host.h"
 #include "content/public/browser/render_view_host.h"
+#include "shell/browser/after_startup_tasks.h"
 #include "shell/browser/browser.h"
 #include "shell/browser/unresponsive_suppressor.h"
 #include "shell/browser/web_contents_preferences.h"
 #include "shell/browser/window_list.h"
+#include "shell/common/asar/readahead.h"
 #include "shell/common/color_util.h"
 #include "shell/common/gin_converters/value_converter.h"
 #include "shell/common/gin_helper/constructor.h"
@@ -23,6 +25,7 @@
 #include "shell/common/gin_helper/object_template_builder.h"
 #include "shell/common/node_includes.h"
 #include "shell/common/options_switches.h"
+#include "shell/common/startup_timeline.h"
 #include "ui/gl/gpu_switching_manager.h"
 
 namespace electron {
@@ -32,6 +35,7 @@ namespace api {
 BrowserWindow::BrowserWindow(gin::Arguments* args,
                              const gin_helper::Dictionary& options)
     : TopLevelWindow(args->isolate(), options), weak_factory_(this) {
+  ScopedStartupPhase startup_phase("BrowserWindow::BrowserWindow");
   gin::Handle<class WebContents> web_contents;
 
   // Use options.webPreferences in WebContents.
@@ -91,7 +95,7 @@ BrowserWindow::BrowserWindow(gin::Arguments* args,
 
   auto* host = web_contents->web_contents()->GetRenderViewHost();
   if (host)
-    host->GetWidget()->AddInputEventObserver(this);
+    ObserveWidget(host->GetWidget());
 
   InitWithArgs(args);
 
@@ -113,6 +117,12 @@ BrowserWindow::~BrowserWindow() {
     Cleanup();
 }
 
+void BrowserWindow::OnLocalSurfaceIdChanged(
+    const cc::RenderFrameMetadata& metadata) {
+  // The page submits a frame with a new surface when its size changed.
+  window()->NotifyWindowResizeFramePresented();
+}
+
 void BrowserWindow::OnInputEvent(const blink::WebInputEvent& event) {
   switch (event.GetType()) {
     case blink::WebInputEvent::kGestureScrollBegin:
@@ -128,9 +138,9 @@ void BrowserWindow::OnInputEvent(const blink::WebInputEvent& event) {
 void BrowserWindow::RenderViewHostChanged(content::RenderViewHost* old_host,
                                           content::RenderViewHost* new_host) {
   if (old_host)
-    old_host->GetWidget()->RemoveInputEventObserver(this);
+    UnobserveWidget(old_host->GetWidget());
   if (new_host)
-    new_host->GetWidget()->AddInputEventObserver(this);
+    ObserveWidget(new_host->GetWidget());
 }
 
 void BrowserWindow::RenderViewCreated(
@@ -146,6 +156,8 @@ void BrowserWindow::RenderViewCreated(
 }
 
 void BrowserWindow::DidFirstVisuallyNonEmptyPaint() {
+  MarkStartupPhase("first-paint");
+  SetBrowserStartupIsComplete();
   if (window()->IsVisible())
     return;
 
@@ -159,6 +171,10 @@ void BrowserWindow::DidFirstVisuallyNonEmptyPaint() {
   base::ThreadTaskRunnerHandle::Get()->PostTask(
       FROM_HERE, base::BindOnce(
                      [](base::WeakPtr<BrowserWindow> self) {
+                       // The app has started once its first window can be
+                       // shown.
+                       asar::FinishStartupRecording();
+                       MarkStartupPhase("ready-to-show");
                        if (self)
                          self->Emit("ready-to-show");
                      },
@@ -423,10 +439,24 @@ void BrowserWindow::NotifyWindowUnresponsive() {
   }
 }
 
+void BrowserWindow::ObserveWidget(content::RenderWidgetHost* widget) {
+  widget->AddInputEventObserver(this);
+  content::RenderWidgetHostImpl::From(widget)
+      ->render_frame_metadata_provider()
+      ->AddObserver(this);
+}
+
+void BrowserWindow::UnobserveWidget(content::RenderWidgetHost* widget) {
+  widget->RemoveInputEventObserver(this);
+  content::RenderWidgetHostImpl::From(widget)
+      ->render_frame_metadata_provider()
+      ->RemoveObserver(this);
+}
+
 void BrowserWindow::Cleanup() {
   auto* host = web_contents()->GetRenderViewHost();
   if (host)
-    host->GetWidget()->RemoveInputEventObserver(this);
+    UnobserveWidget(host->GetWidget());
 
   // Destroy WebContents asynchronously unless app is shutting down,
   // because destroy() might be called inside WebContents's event handler.
@@ -440,10 +470,51 @@ void BrowserWindow::OnWindowShow() {
 }
 
 void BrowserWindow::OnWindowHide() {
-  web_contents()->WasOccluded();
+  // A window covered by other windows gets hidden on macOS, but the page may
+  // ask to keep running.
+  if (!window_->is_occluded() || ThrottlesOccludedPage())
+    web_contents()->WasOccluded();
   TopLevelWindow::OnWindowHide();
 }
 
+void BrowserWindow::OnWindowOcclusionChanged(bool occluded) {
+#if defined(USE_X11)
+  // The X11 windows are not hidden when they are covered.
+  if (!ThrottlesOccludedPage())
+    return;
+  if (occluded)
+    web_contents()->WasOccluded();
+  else if (window_->IsVisible())
+    web_contents()->WasShown();
+#endif
+}
+
+void BrowserWindow::OnVisibilityChanged(content::Visibility visibility) {
+#if defined(OS_WIN)
+  // Chromium tracks the occlusion of the windows by itself on Windows, which
+  // is undone for the pages that ask to keep running.
+  if (visibility == content::Visibility::OCCLUDED && window_->IsVisible() &&
+      !window_->IsMinimized() && !ThrottlesOccludedPage()) {
+    base::ThreadTaskRunnerHandle::Get()->PostTask(
+        FROM_HERE, base::BindOnce(&BrowserWindow::ShowOccludedPage,
+                                  GetWeakPtr()));
+  }
+#endif
+}
+
+bool BrowserWindow::ThrottlesOccludedPage() const {
+  return !api_web_contents_ ||
+         api_web_contents_->GetBackgroundThrottlingPolicy().occlusion;
+}
+
+#if defined(OS_WIN)
+void BrowserWindow::ShowOccludedPage() {
+  if (web_contents() &&
+      web_contents()->GetVisibility() == content::Visibility::OCCLUDED)
+    web_contents()->WasShown();
+}
+#endif
+
 // static
 gin_helper::WrappableBase* BrowserWindow::New(gin_helper::ErrorThrower thrower,
                                               gin::Arguments* args) {
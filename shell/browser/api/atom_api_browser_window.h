@@ -10,6 +10,7 @@
 #include <vector>
 
 #include "base/cancelable_callback.h"
+#include "content/public/browser/render_frame_metadata_provider.h"
 #include "shell/browser/api/atom_api_top_level_window.h"
 #include "shell/browser/api/atom_api_web_contents.h"
 #include "shell/common/gin_helper/error_thrower.h"
@@ -20,6 +21,7 @@ namespace api {
 
 class BrowserWindow : public TopLevelWindow,
                       public content::RenderWidgetHost::InputEventObserver,
+                      public content::RenderFrameMetadataProvider::Observer,
                       public content::WebContentsObserver,
                       public ExtendedWebContentsObserver {
  public:
@@ -41,6 +43,14 @@ class BrowserWindow : public TopLevelWindow,
   BrowserWindow(gin::Arguments* args, const gin_helper::Dictionary& options);
   ~BrowserWindow() override;
 
+  // content::RenderFrameMetadataProvider::Observer:
+  void OnRenderFrameMetadataChangedBeforeActivation(
+      const cc::RenderFrameMetadata& metadata) override {}
+  void OnRenderFrameMetadataChangedAfterActivation() override {}
+  void OnRenderFrameSubmission() override {}
+  void OnLocalSurfaceIdChanged(
+      const cc::RenderFrameMetadata& metadata) override;
+
   // content::RenderWidgetHost::InputEventObserver:
   void OnInputEvent(const blink::WebInputEvent& event) override;
 
@@ -51,6 +61,7 @@ class BrowserWindow : public TopLevelWindow,
   void DidFirstVisuallyNonEmptyPaint() override;
   void BeforeUnloadDialogCancelled() override;
   void OnRendererUnresponsive(content::RenderProcessHost*) override;
+  void OnVisibilityChanged(content::Visibility visibility) override;
 
   // ExtendedWebContentsObserver:
   void OnCloseContents() override;
@@ -78,6 +89,7 @@ class BrowserWindow : public TopLevelWindow,
   void SetVibrancy(v8::Isolate* isolate, v8::Local<v8::Value> value) override;
   void OnWindowShow() override;
   void OnWindowHide() override;
+  void OnWindowOcclusionChanged(bool occluded) override;
 
   // BrowserWindow APIs.
   void FocusOnWebView();
@@ -106,9 +118,19 @@ class BrowserWindow : public TopLevelWindow,
   // Dispatch unresponsive event to observers.
   void NotifyWindowUnresponsive();
 
+  // Observes the input and the frames of the page's widget.
+  void ObserveWidget(content::RenderWidgetHost* widget);
+  void UnobserveWidget(content::RenderWidgetHost* widget);
+
   // Cleanup our WebContents observers.
   void Cleanup();
 
+  // Whether the page is hidden while the window is covered by other windows.
+  bool ThrottlesOccludedPage() const;
+#if defined(OS_WIN)
+  void ShowOccludedPage();
+#endif
+
   // Closure that would be called when window is unresponsive when closing,
   // it should be cancelled when we can prove that the window is responsive.
   base::CancelableClosure window_unresponsive_closure_;
@@ -4,6 +4,7 @@
 
 #include "shell/browser/api/atom_api_browser_window.h"
 
+#include <algorithm>
 #include <memory>
 #include <vector>
 
@@ -90,15 +91,6 @@ void BrowserWindow::UpdateDraggableRegions(
     [webView setMouseDownCanMoveWindow:YES];
   }
 
-  // Remove all ControlRegionViews that are added last time.
-  // Note that [webView subviews] returns the view's mutable internal array and
-  // it should be copied to avoid mutating the original array while enumerating
-  // it.
-  base::scoped_nsobject<NSArray> subviews([[webView subviews] copy]);
-  for (NSView* subview in subviews.get())
-    if ([subview isKindOfClass:[ControlRegionView class]])
-      [subview removeFromSuperview];
-
   // Draggable regions is implemented by having the whole web view draggable
   // (mouseDownCanMoveWindow) and overlaying regions that are not draggable.
   if (&draggable_regions_ != &regions) {
@@ -119,13 +111,34 @@ void BrowserWindow::UpdateDraggableRegions(
     view->UpdateDraggableRegions(drag_exclude_rects);
   }
 
-  // Create and add a ControlRegionView for each region that needs to be
-  // excluded from the dragging.
+  // A ControlRegionView is needed for each region that needs to be excluded
+  // from the dragging. The views added last time are kept when their region is
+  // still excluded, and only the others are removed or added.
+  std::vector<NSRect> frames;
   for (const auto& rect : drag_exclude_rects) {
+    frames.push_back(NSMakeRect(rect.x(), webViewHeight - rect.bottom(),
+                                rect.width(), rect.height()));
+  }
+
+  // Note that [webView subviews] returns the view's mutable internal array and
+  // it should be copied to avoid mutating the original array while enumerating
+  // it.
+  base::scoped_nsobject<NSArray> subviews([[webView subviews] copy]);
+  for (NSView* subview in subviews.get()) {
+    if (![subview isKindOfClass:[ControlRegionView class]])
+      continue;
+    auto iter = std::find_if(frames.begin(), frames.end(), [&](NSRect frame) {
+      return NSEqualRects(frame, [subview frame]);
+    });
+    if (iter == frames.end())
+      [subview removeFromSuperview];
+    else
+      frames.erase(iter);
+  }
+
+  for (const auto& frame : frames) {
     base::scoped_nsobject<NSView> controlRegion(
-        [[ControlRegionView alloc] initWithFrame:NSZeroRect]);
-    [controlRegion setFrame:NSMakeRect(rect.x(), webViewHeight - rect.bottom(),
-                                       rect.width(), rect.height())];
+        [[ControlRegionView alloc] initWithFrame:frame]);
     [webView addSubview:controlRegion];
   }
 
@@ -2,6 +2,7 @@
 // Use of this source code is governed by the MIT license that can be
 // found in the LICENSE file.
 
+#include <memory>
 #include <set>
 #include <string>
 #include <utility>
@@ -14,6 +15,7 @@
 #include "shell/common/gin_converters/file_path_converter.h"
 #include "shell/common/gin_converters/value_converter.h"
 #include "shell/common/gin_helper/dictionary.h"
+#include "shell/common/gin_helper/locker.h"
 #include "shell/common/gin_helper/promise.h"
 #include "shell/common/node_includes.h"
 
@@ -97,6 +99,35 @@ v8::Local<v8::Promise> StopRecording(gin_helper::Arguments* args) {
   return handle;
 }
 
+void ResolveWithTraceData(gin_helper::Promise<v8::Local<v8::Value>> promise,
+                          std::unique_ptr<std::string> data) {
+  v8::Isolate* isolate = promise.isolate();
+  gin_helper::Locker locker(isolate);
+  v8::HandleScope handle_scope(isolate);
+  v8::Context::Scope context_scope(promise.GetContext());
+  promise.Resolve(
+      node::Buffer::Copy(isolate, data->data(), data->size()).ToLocalChecked());
+}
+
+// Keeps the trace in memory, so that it can be sent somewhere without going
+// through a file.
+v8::Local<v8::Promise> StopRecordingToBuffer(v8::Isolate* isolate) {
+  gin_helper::Promise<v8::Local<v8::Value>> promise(isolate);
+  v8::Local<v8::Promise> handle = promise.GetHandle();
+
+  // StopTracing would drop the endpoint, and the promise with it.
+  if (!TracingController::GetInstance()->IsTracing()) {
+    promise.RejectWithErrorMessage(
+        "Failed to stop tracing - no trace in progress");
+    return handle;
+  }
+
+  auto endpoint = TracingController::CreateStringEndpoint(
+      base::BindOnce(&ResolveWithTraceData, std::move(promise)));
+  TracingController::GetInstance()->StopTracing(endpoint);
+  return handle;
+}
+
 v8::Local<v8::Promise> GetCategories(v8::Isolate* isolate) {
   gin_helper::Promise<const std::set<std::string>&> promise(isolate);
   v8::Local<v8::Promise> handle = promise.GetHandle();
@@ -157,6 +188,7 @@ void Initialize(v8::Local<v8::Object> exports,
   dict.SetMethod("getCategories", &GetCategories);
   dict.SetMethod("startRecording", &StartTracing);
   dict.SetMethod("stopRecording", &StopRecording);
+  dict.SetMethod("stopRecordingToBuffer", &StopRecordingToBuffer);
   dict.SetMethod("getTraceBufferUsage", &GetTraceBufferUsage);
 }
 
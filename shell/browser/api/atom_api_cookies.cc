@@ -5,8 +5,13 @@
 #include "shell/browser/api/atom_api_cookies.h"
 
 #include <memory>
+#include <string>
 #include <utility>
+#include <vector>
 
+#include "base/barrier_closure.h"
+#include "base/strings/string_number_conversions.h"
+#include "base/strings/string_util.h"
 #include "base/time/time.h"
 #include "base/values.h"
 #include "content/public/browser/browser_context.h"
@@ -18,6 +23,7 @@
 #include "net/cookies/canonical_cookie.h"
 #include "net/cookies/cookie_store.h"
 #include "net/cookies/cookie_util.h"
+#include "services/network/public/mojom/cookie_manager.mojom.h"
 #include "shell/browser/atom_browser_context.h"
 #include "shell/browser/cookie_change_notifier.h"
 #include "shell/common/gin_converters/gurl_converter.h"
@@ -105,6 +111,9 @@ bool MatchesCookie(const base::Value& filter,
   const std::string* str;
   if ((str = filter.FindStringKey("name")) && *str != cookie.Name())
     return false;
+  if ((str = filter.FindStringKey("namePrefix")) &&
+      !base::StartsWith(cookie.Name(), *str, base::CompareCase::SENSITIVE))
+    return false;
   if ((str = filter.FindStringKey("path")) && *str != cookie.Path())
     return false;
   if ((str = filter.FindStringKey("domain")) &&
@@ -119,26 +128,59 @@ bool MatchesCookie(const base::Value& filter,
   return true;
 }
 
+using CookieListCallback = base::OnceCallback<void(const net::CookieList&)>;
+
 // Remove cookies from |list| not matching |filter|, and pass it to |callback|.
 void FilterCookies(const base::Value& filter,
-                   gin_helper::Promise<net::CookieList> promise,
+                   CookieListCallback callback,
                    const net::CookieList& cookies) {
   net::CookieList result;
   for (const auto& cookie : cookies) {
     if (MatchesCookie(filter, cookie))
       result.push_back(cookie);
   }
-  promise.Resolve(result);
+  std::move(callback).Run(result);
 }
 
 void FilterCookieWithStatuses(const base::Value& filter,
-                              gin_helper::Promise<net::CookieList> promise,
+                              CookieListCallback callback,
                               const net::CookieStatusList& list,
                               const net::CookieStatusList& excluded_list) {
-  FilterCookies(filter, std::move(promise),
+  FilterCookies(filter, std::move(callback),
                 net::cookie_util::StripStatuses(list));
 }
 
+// Get the cookies matching |filter| with a single query of |manager|, which
+// only returns the cookies of the URL when the filter has one.
+void GetMatchingCookies(network::mojom::CookieManager* manager,
+                        base::DictionaryValue filter,
+                        CookieListCallback callback) {
+  const std::string* url = filter.FindStringKey("url");
+  if (!url || url->empty()) {
+    manager->GetAllCookies(base::BindOnce(&FilterCookies, std::move(filter),
+                                          std::move(callback)));
+    return;
+  }
+
+  net::CookieOptions options;
+  options.set_include_httponly();
+  options.set_same_site_cookie_context(
+      net::CookieOptions::SameSiteCookieContext::SAME_SITE_STRICT);
+  options.set_do_not_update_access_time();
+
+  GURL gurl(*url);
+  manager->GetCookieList(
+      gurl, options,
+      base::BindOnce(&FilterCookieWithStatuses, std::move(filter),
+                     std::move(callback)));
+}
+
+network::mojom::CookieManager* GetCookieManager(
+    AtomBrowserContext* browser_context) {
+  return content::BrowserContext::GetDefaultStoragePartition(browser_context)
+      ->GetCookieManagerForBrowserProcess();
+}
+
 // Parse dictionary property to CanonicalCookie time correctly.
 base::Time ParseTimeProperty(const base::Optional<double>& value) {
   if (!value)  // empty time means ignoring the parameter
@@ -171,6 +213,87 @@ std::string InclusionStatusToString(
   return "Setting cookie failed";
 }
 
+// Create the cookie described by |details|, or set |error| to the reason it
+// can not be created.
+std::unique_ptr<net::CanonicalCookie> CreateCookie(
+    const base::Value& details,
+    GURL* url,
+    net::CookieOptions* options,
+    std::string* error) {
+  const std::string* url_string = details.FindStringKey("url");
+  const std::string* name = details.FindStringKey("name");
+  const std::string* value = details.FindStringKey("value");
+  const std::string* domain = details.FindStringKey("domain");
+  const std::string* path = details.FindStringKey("path");
+  bool secure = details.FindBoolKey("secure").value_or(false);
+  bool http_only = details.FindBoolKey("httpOnly").value_or(false);
+
+  *url = GURL(url_string ? *url_string : "");
+  if (!url->is_valid()) {
+    *error =
+        InclusionStatusToString(net::CanonicalCookie::CookieInclusionStatus(
+            net::CanonicalCookie::CookieInclusionStatus::
+                EXCLUDE_INVALID_DOMAIN));
+    return nullptr;
+  }
+
+  auto canonical_cookie = net::CanonicalCookie::CreateSanitizedCookie(
+      *url, name ? *name : "", value ? *value : "", domain ? *domain : "",
+      path ? *path : "",
+      ParseTimeProperty(details.FindDoubleKey("creationDate")),
+      ParseTimeProperty(details.FindDoubleKey("expirationDate")),
+      ParseTimeProperty(details.FindDoubleKey("lastAccessDate")), secure,
+      http_only, net::CookieSameSite::NO_RESTRICTION,
+      net::COOKIE_PRIORITY_DEFAULT);
+  if (!canonical_cookie || !canonical_cookie->IsCanonical()) {
+    *error =
+        InclusionStatusToString(net::CanonicalCookie::CookieInclusionStatus(
+            net::CanonicalCookie::CookieInclusionStatus::
+                EXCLUDE_FAILURE_TO_STORE));
+    return nullptr;
+  }
+  if (http_only)
+    options->set_include_httponly();
+  return canonical_cookie;
+}
+
+struct SetCookieRequest {
+  std::unique_ptr<net::CanonicalCookie> cookie;
+  GURL url;
+  net::CookieOptions options;
+};
+
+// Settles the promise of a setMany() call once the callbacks of all cookies
+// have released it, rejecting with the first failure.
+class SetManyState : public base::RefCounted<SetManyState> {
+ public:
+  explicit SetManyState(gin_helper::Promise<void> promise)
+      : promise_(std::move(promise)) {}
+
+  void OnCookieSet(size_t index,
+                   net::CanonicalCookie::CookieInclusionStatus status) {
+    if (!status.IsInclude() && error_.empty()) {
+      error_ = "Failed to set cookie at index " + base::NumberToString(index) +
+               ": " + InclusionStatusToString(status);
+    }
+  }
+
+ private:
+  friend class base::RefCounted<SetManyState>;
+
+  ~SetManyState() {
+    if (error_.empty())
+      promise_.Resolve();
+    else
+      promise_.RejectWithErrorMessage(error_);
+  }
+
+  gin_helper::Promise<void> promise_;
+  std::string error_;
+
+  DISALLOW_COPY_AND_ASSIGN(SetManyState);
+};
+
 }  // namespace
 
 Cookies::Cookies(v8::Isolate* isolate, AtomBrowserContext* browser_context)
@@ -188,29 +311,15 @@ v8::Local<v8::Promise> Cookies::Get(const gin_helper::Dictionary& filter) {
   gin_helper::Promise<net::CookieList> promise(isolate());
   v8::Local<v8::Promise> handle = promise.GetHandle();
 
-  auto* storage_partition = content::BrowserContext::GetDefaultStoragePartition(
-      browser_context_.get());
-  auto* manager = storage_partition->GetCookieManagerForBrowserProcess();
-
   base::DictionaryValue dict;
   gin::ConvertFromV8(isolate(), filter.GetHandle(), &dict);
 
-  std::string url;
-  filter.Get("url", &url);
-  if (url.empty()) {
-    manager->GetAllCookies(
-        base::BindOnce(&FilterCookies, std::move(dict), std::move(promise)));
-  } else {
-    net::CookieOptions options;
-    options.set_include_httponly();
-    options.set_same_site_cookie_context(
-        net::CookieOptions::SameSiteCookieContext::SAME_SITE_STRICT);
-    options.set_do_not_update_access_time();
-
-    manager->GetCookieList(GURL(url), options,
-                           base::BindOnce(&FilterCookieWithStatuses,
-                                          std::move(dict), std::move(promise)));
-  }
+  GetMatchingCookies(
+      GetCookieManager(browser_context_.get()), std::move(dict),
+      base::BindOnce(
+          [](gin_helper::Promise<net::CookieList> promise,
+             const net::CookieList& cookies) { promise.Resolve(cookies); },
+          std::move(promise)));
 
   return handle;
 }
@@ -243,62 +352,103 @@ v8::Local<v8::Promise> Cookies::Set(base::DictionaryValue details) {
   gin_helper::Promise<void> promise(isolate());
   v8::Local<v8::Promise> handle = promise.GetHandle();
 
-  const std::string* url_string = details.FindStringKey("url");
-  const std::string* name = details.FindStringKey("name");
-  const std::string* value = details.FindStringKey("value");
-  const std::string* domain = details.FindStringKey("domain");
-  const std::string* path = details.FindStringKey("path");
-  bool secure = details.FindBoolKey("secure").value_or(false);
-  bool http_only = details.FindBoolKey("httpOnly").value_or(false);
-
-  GURL url(url_string ? *url_string : "");
-  if (!url.is_valid()) {
-    promise.RejectWithErrorMessage(
-        InclusionStatusToString(net::CanonicalCookie::CookieInclusionStatus(
-            net::CanonicalCookie::CookieInclusionStatus::
-                EXCLUDE_INVALID_DOMAIN)));
+  GURL url;
+  net::CookieOptions options;
+  std::string error;
+  auto canonical_cookie = CreateCookie(details, &url, &options, &error);
+  if (!canonical_cookie) {
+    promise.RejectWithErrorMessage(error);
     return handle;
   }
 
-  auto canonical_cookie = net::CanonicalCookie::CreateSanitizedCookie(
-      url, name ? *name : "", value ? *value : "", domain ? *domain : "",
-      path ? *path : "",
-      ParseTimeProperty(details.FindDoubleKey("creationDate")),
-      ParseTimeProperty(details.FindDoubleKey("expirationDate")),
-      ParseTimeProperty(details.FindDoubleKey("lastAccessDate")), secure,
-      http_only, net::CookieSameSite::NO_RESTRICTION,
-      net::COOKIE_PRIORITY_DEFAULT);
-  if (!canonical_cookie || !canonical_cookie->IsCanonical()) {
-    promise.RejectWithErrorMessage(
-        InclusionStatusToString(net::CanonicalCookie::CookieInclusionStatus(
-            net::CanonicalCookie::CookieInclusionStatus::
-                EXCLUDE_FAILURE_TO_STORE)));
-    return handle;
+  GetCookieManager(browser_context_.get())
+      ->SetCanonicalCookie(
+          *canonical_cookie, url.scheme(), options,
+          base::BindOnce(
+              [](gin_helper::Promise<void> promise,
+                 net::CanonicalCookie::CookieInclusionStatus status) {
+                if (status.IsInclude()) {
+                  promise.Resolve();
+                } else {
+                  promise.RejectWithErrorMessage(
+                      InclusionStatusToString(status));
+                }
+              },
+              std::move(promise)));
+
+  return handle;
+}
+
+v8::Local<v8::Promise> Cookies::SetMany(base::ListValue cookies_details) {
+  gin_helper::Promise<void> promise(isolate());
+  v8::Local<v8::Promise> handle = promise.GetHandle();
+
+  // Nothing is set when any of the cookies is invalid.
+  std::vector<SetCookieRequest> requests;
+  const auto& list = cookies_details.GetList();
+  for (size_t i = 0; i < list.size(); ++i) {
+    SetCookieRequest request;
+    std::string error;
+    if (list[i].is_dict()) {
+      request.cookie =
+          CreateCookie(list[i], &request.url, &request.options, &error);
+    } else {
+      error = "Each cookie must be an object";
+    }
+    if (!request.cookie) {
+      promise.RejectWithErrorMessage("Invalid cookie at index " +
+                                     base::NumberToString(i) + ": " + error);
+      return handle;
+    }
+    requests.push_back(std::move(request));
   }
-  net::CookieOptions options;
-  if (http_only) {
-    options.set_include_httponly();
+
+  // The state settles the promise when the last cookie has been set.
+  auto state = base::MakeRefCounted<SetManyState>(std::move(promise));
+  auto* manager = GetCookieManager(browser_context_.get());
+  for (size_t i = 0; i < requests.size(); ++i) {
+    manager->SetCanonicalCookie(
+        *requests[i].cookie, requests[i].url.scheme(), requests[i].options,
+        base::BindOnce(&SetManyState::OnCookieSet, state, i));
   }
 
-  auto* storage_partition = content::BrowserContext::GetDefaultStoragePartition(
-      browser_context_.get());
-  auto* manager = storage_partition->GetCookieManagerForBrowserProcess();
-  manager->SetCanonicalCookie(
-      *canonical_cookie, url.scheme(), options,
-      base::BindOnce(
-          [](gin_helper::Promise<void> promise,
-             net::CanonicalCookie::CookieInclusionStatus status) {
-            if (status.IsInclude()) {
-              promise.Resolve();
-            } else {
-              promise.RejectWithErrorMessage(InclusionStatusToString(status));
-            }
-          },
-          std::move(promise)));
+  return handle;
+}
+
+v8::Local<v8::Promise> Cookies::RemoveMany(base::DictionaryValue filter) {
+  gin_helper::Promise<uint32_t> promise(isolate());
+  v8::Local<v8::Promise> handle = promise.GetHandle();
+
+  GetMatchingCookies(
+      GetCookieManager(browser_context_.get()), std::move(filter),
+      base::BindOnce(&Cookies::DeleteCookies, browser_context_,
+                     std::move(promise)));
 
   return handle;
 }
 
+// static
+void Cookies::DeleteCookies(scoped_refptr<AtomBrowserContext> browser_context,
+                            gin_helper::Promise<uint32_t> promise,
+                            const net::CookieList& cookies) {
+  const uint32_t count = static_cast<uint32_t>(cookies.size());
+  base::RepeatingClosure barrier = base::BarrierClosure(
+      static_cast<int>(count),
+      base::BindOnce(
+          [](gin_helper::Promise<uint32_t> promise, uint32_t count) {
+            promise.Resolve(count);
+          },
+          std::move(promise), count));
+  auto* manager = GetCookieManager(browser_context.get());
+  for (const auto& cookie : cookies) {
+    manager->DeleteCanonicalCookie(
+        cookie,
+        base::BindOnce(
+            [](base::RepeatingClosure done, bool deleted) { done.Run(); },
+            barrier));
+  }
+}
+
 v8::Local<v8::Promise> Cookies::FlushStore() {
   gin_helper::Promise<void> promise(isolate());
   v8::Local<v8::Promise> handle = promise.GetHandle();
@@ -313,11 +463,61 @@ v8::Local<v8::Promise> Cookies::FlushStore() {
   return handle;
 }
 
+void Cookies::SetChangedEventOptions(const gin_helper::Dictionary& options) {
+  changed_domain_filter_.clear();
+  changed_name_filter_.clear();
+  options.Get("domain", &changed_domain_filter_);
+  options.Get("name", &changed_name_filter_);
+
+  // Changes collected with the previous options are not held back.
+  EmitChangedBatch();
+  changed_batch_interval_.reset();
+  int interval_ms;
+  if (options.Get("batchInterval", &interval_ms) && interval_ms >= 0)
+    changed_batch_interval_ = base::TimeDelta::FromMilliseconds(interval_ms);
+}
+
 void Cookies::OnCookieChanged(const net::CookieChangeInfo& change) {
-  Emit("changed", gin::ConvertToV8(isolate(), change.cookie),
-       gin::ConvertToV8(isolate(), change.cause),
-       gin::ConvertToV8(isolate(),
-                        change.cause != net::CookieChangeCause::INSERTED));
+  if (!changed_name_filter_.empty() &&
+      change.cookie.Name() != changed_name_filter_)
+    return;
+  if (!changed_domain_filter_.empty() &&
+      !MatchesDomain(changed_domain_filter_, change.cookie.Domain()))
+    return;
+
+  if (!changed_batch_interval_) {
+    Emit("changed", gin::ConvertToV8(isolate(), change.cookie),
+         gin::ConvertToV8(isolate(), change.cause),
+         gin::ConvertToV8(isolate(),
+                          change.cause != net::CookieChangeCause::INSERTED));
+    return;
+  }
+
+  pending_changes_.push_back(change);
+  if (!changed_batch_timer_.IsRunning()) {
+    changed_batch_timer_.Start(FROM_HERE, *changed_batch_interval_,
+                               base::BindOnce(&Cookies::EmitChangedBatch,
+                                              base::Unretained(this)));
+  }
+}
+
+void Cookies::EmitChangedBatch() {
+  changed_batch_timer_.Stop();
+  if (pending_changes_.empty())
+    return;
+
+  v8::HandleScope handle_scope(isolate());
+  std::vector<gin::Dictionary> changes;
+  changes.reserve(pending_changes_.size());
+  for (const auto& change : pending_changes_) {
+    gin::Dictionary dict = gin::Dictionary::CreateEmpty(isolate());
+    dict.Set("cookie", change.cookie);
+    dict.Set("cause", change.cause);
+    dict.Set("removed", change.cause != net::CookieChangeCause::INSERTED);
+    changes.push_back(dict);
+  }
+  pending_changes_.clear();
+  Emit("changed-batch", changes);
 }
 
 // static
@@ -334,7 +534,10 @@ void Cookies::BuildPrototype(v8::Isolate* isolate,
       .SetMethod("get", &Cookies::Get)
       .SetMethod("remove", &Cookies::Remove)
       .SetMethod("set", &Cookies::Set)
-      .SetMethod("flushStore", &Cookies::FlushStore);
+      .SetMethod("setMany", &Cookies::SetMany)
+      .SetMethod("removeMany", &Cookies::RemoveMany)
+      .SetMethod("flushStore", &Cookies::FlushStore)
+      .SetMethod("setChangedEventOptions", &Cookies::SetChangedEventOptions);
 }
 
 }  // namespace api
@@ -7,8 +7,12 @@
 
 #include <memory>
 #include <string>
+#include <vector>
 
 #include "base/callback_list.h"
+#include "base/optional.h"
+#include "base/time/time.h"
+#include "base/timer/timer.h"
 #include "gin/handle.h"
 #include "net/cookies/canonical_cookie.h"
 #include "net/cookies/cookie_change_dispatcher.h"
@@ -17,6 +21,7 @@
 
 namespace base {
 class DictionaryValue;
+class ListValue;
 }
 
 namespace gin_helper {
@@ -48,18 +53,39 @@ class Cookies : public gin_helper::TrackableObject<Cookies> {
 
   v8::Local<v8::Promise> Get(const gin_helper::Dictionary& filter);
   v8::Local<v8::Promise> Set(base::DictionaryValue details);
+  v8::Local<v8::Promise> SetMany(base::ListValue cookies_details);
   v8::Local<v8::Promise> Remove(const GURL& url, const std::string& name);
+  v8::Local<v8::Promise> RemoveMany(base::DictionaryValue filter);
   v8::Local<v8::Promise> FlushStore();
+  void SetChangedEventOptions(const gin_helper::Dictionary& options);
 
   // CookieChangeNotifier subscription:
   void OnCookieChanged(const net::CookieChangeInfo& change);
 
  private:
+  // Emit the changes collected since the last batch.
+  void EmitChangedBatch();
+
+  // Delete |cookies| and resolve |promise| with their number.
+  static void DeleteCookies(scoped_refptr<AtomBrowserContext> browser_context,
+                            gin_helper::Promise<uint32_t> promise,
+                            const net::CookieList& cookies);
+
   std::unique_ptr<base::CallbackList<void(
       const net::CookieChangeInfo& change)>::Subscription>
       cookie_change_subscription_;
   scoped_refptr<AtomBrowserContext> browser_context_;
 
+  // The changes not matching the filters are dropped before reaching JS.
+  std::string changed_domain_filter_;
+  std::string changed_name_filter_;
+
+  // When set, the changes are collected and emitted together once the
+  // interval has passed since the first of them.
+  base::Optional<base::TimeDelta> changed_batch_interval_;
+  std::vector<net::CookieChangeInfo> pending_changes_;
+  base::OneShotTimer changed_batch_timer_;
+
   DISALLOW_COPY_AND_ASSIGN(Cookies);
 };
 
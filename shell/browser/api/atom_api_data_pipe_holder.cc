@@ -4,11 +4,13 @@
 
 #include "shell/browser/api/atom_api_data_pipe_holder.h"
 
+#include <algorithm>
 #include <utility>
 #include <vector>
 
 #include "base/memory/weak_ptr.h"
 #include "base/strings/string_number_conversions.h"
+#include "gin/object_template_builder.h"
 #include "mojo/public/cpp/system/data_pipe.h"
 #include "mojo/public/cpp/system/simple_watcher.h"
 #include "net/base/net_errors.h"
@@ -136,6 +138,277 @@ class DataPipeReader {
   DISALLOW_COPY_AND_ASSIGN(DataPipeReader);
 };
 
+// Reads a range of the data pipe in chunks, each read() resolving with the
+// next chunk or with null after the end. Nothing is read from the pipe until
+// a chunk is requested, so a slow consumer also holds back the producer.
+class DataPipeChunkReader : public gin::Wrappable<DataPipeChunkReader> {
+ public:
+  static gin::WrapperInfo kWrapperInfo;
+
+  static gin::Handle<DataPipeChunkReader> Create(
+      v8::Isolate* isolate,
+      mojo::Remote<network::mojom::DataPipeGetter> data_pipe_getter,
+      uint64_t offset,
+      base::Optional<uint64_t> length) {
+    return gin::CreateHandle(
+        isolate, new DataPipeChunkReader(isolate, std::move(data_pipe_getter),
+                                         offset, length));
+  }
+
+  // Reads all of |data_pipe|, whose writer reports through the returned
+  // callback whether all of the data was written.
+  static gin::Handle<DataPipeChunkReader> Create(
+      v8::Isolate* isolate,
+      mojo::ScopedDataPipeConsumerHandle data_pipe,
+      const std::string& error_message,
+      base::OnceCallback<void(bool)>* on_writer_done) {
+    auto* reader =
+        new DataPipeChunkReader(isolate, std::move(data_pipe), error_message);
+    *on_writer_done = base::BindOnce(&DataPipeChunkReader::OnWriterDone,
+                                     reader->weak_factory_.GetWeakPtr());
+    return gin::CreateHandle(isolate, reader);
+  }
+
+  // gin::Wrappable
+  gin::ObjectTemplateBuilder GetObjectTemplateBuilder(
+      v8::Isolate* isolate) override {
+    return gin::Wrappable<DataPipeChunkReader>::GetObjectTemplateBuilder(
+               isolate)
+        .SetMethod("read", &DataPipeChunkReader::Read)
+        .SetMethod("cancel", &DataPipeChunkReader::Cancel);
+  }
+
+ private:
+  DataPipeChunkReader(
+      v8::Isolate* isolate,
+      mojo::Remote<network::mojom::DataPipeGetter> data_pipe_getter,
+      uint64_t offset,
+      base::Optional<uint64_t> length)
+      : isolate_(isolate),
+        data_pipe_getter_(std::move(data_pipe_getter)),
+        handle_watcher_(FROM_HERE,
+                        mojo::SimpleWatcher::ArmingPolicy::MANUAL,
+                        base::SequencedTaskRunnerHandle::Get()),
+        offset_(offset) {
+    if (length)
+      end_ = offset + *length;
+    mojo::DataPipe data_pipe;
+    data_pipe_getter_->Read(
+        std::move(data_pipe.producer_handle),
+        base::BindOnce(&DataPipeChunkReader::ReadCallback,
+                       weak_factory_.GetWeakPtr()));
+    data_pipe_getter_.set_disconnect_handler(
+        base::BindOnce(&DataPipeChunkReader::OnGetterDisconnected,
+                       weak_factory_.GetWeakPtr()));
+    data_pipe_ = std::move(data_pipe.consumer_handle);
+    handle_watcher_.Watch(
+        data_pipe_.get(), MOJO_HANDLE_SIGNAL_READABLE,
+        base::BindRepeating(&DataPipeChunkReader::OnHandleReadable,
+                            weak_factory_.GetWeakPtr()));
+  }
+
+  DataPipeChunkReader(v8::Isolate* isolate,
+                      mojo::ScopedDataPipeConsumerHandle data_pipe,
+                      const std::string& error_message)
+      : isolate_(isolate),
+        data_pipe_(std::move(data_pipe)),
+        handle_watcher_(FROM_HERE,
+                        mojo::SimpleWatcher::ArmingPolicy::MANUAL,
+                        base::SequencedTaskRunnerHandle::Get()),
+        offset_(0),
+        error_message_(error_message) {
+    handle_watcher_.Watch(
+        data_pipe_.get(), MOJO_HANDLE_SIGNAL_READABLE,
+        base::BindRepeating(&DataPipeChunkReader::OnHandleReadable,
+                            weak_factory_.GetWeakPtr()));
+  }
+
+  ~DataPipeChunkReader() override = default;
+
+  v8::Local<v8::Promise> Read(uint32_t max_size) {
+    gin_helper::Promise<v8::Local<v8::Value>> promise(isolate_);
+    v8::Local<v8::Promise> handle = promise.GetHandle();
+    if (pending_read_) {
+      promise.RejectWithErrorMessage("Only one read can be pending at a time");
+      return handle;
+    }
+    if (max_size == 0) {
+      promise.RejectWithErrorMessage("Chunk size must be greater than 0");
+      return handle;
+    }
+    pending_read_ = std::move(promise);
+    pending_size_ = max_size;
+    ReadPending();
+    return handle;
+  }
+
+  // Stop reading, a pending read resolves with null.
+  void Cancel() {
+    if (!done_)
+      Finish();
+  }
+
+  // Callback invoked by DataPipeGetter::Read.
+  void ReadCallback(int32_t status, uint64_t size) {
+    if (status != net::OK) {
+      OnFailure();
+      return;
+    }
+    total_size_ = size;
+    ReadPending();
+  }
+
+  void OnGetterDisconnected() {
+    // The data after the size is known is still in the pipe.
+    if (!total_size_)
+      OnFailure();
+  }
+
+  // The writer of a pipe without a getter closes it, and then reports
+  // whether it was done.
+  void OnWriterDone(bool success) {
+    if (done_)
+      return;
+    if (!success) {
+      OnFailure();
+      return;
+    }
+    writer_done_ = true;
+    ReadPending();
+  }
+
+  void OnHandleReadable(MojoResult result) { ReadPending(); }
+
+  // Returns where the reading stops, when it is known.
+  base::Optional<uint64_t> GetEnd() const {
+    if (end_ && total_size_)
+      return std::min(*end_, *total_size_);
+    return end_ ? end_ : total_size_;
+  }
+
+  void ReadPending() {
+    if (!pending_read_)
+      return;
+    if (failed_) {
+      RejectPending();
+      return;
+    }
+
+    while (true) {
+      base::Optional<uint64_t> end = GetEnd();
+      if (done_ || (end && bytes_read_ >= *end)) {
+        Finish();
+        return;
+      }
+
+      const void* buffer = nullptr;
+      uint32_t available = 0;
+      MojoResult result = data_pipe_->BeginReadData(&buffer, &available,
+                                                    MOJO_READ_DATA_FLAG_NONE);
+      if (result == MOJO_RESULT_SHOULD_WAIT) {
+        handle_watcher_.ArmOrNotify();
+        return;
+      }
+      if (result != MOJO_RESULT_OK) {
+        // The pipe is closed, which is the end of the data once the size is
+        // known to have been read, or once its writer is done.
+        if (total_size_)
+          OnFailure();
+        else if (writer_done_)
+          Finish();
+        return;
+      }
+
+      // Skip the data before |offset_| without copying it.
+      if (bytes_read_ < offset_) {
+        uint32_t size = static_cast<uint32_t>(
+            std::min<uint64_t>(available, offset_ - bytes_read_));
+        data_pipe_->EndReadData(size);
+        bytes_read_ += size;
+        continue;
+      }
+
+      uint64_t size = std::min(available, pending_size_);
+      if (end)
+        size = std::min(size, *end - bytes_read_);
+      v8::Locker locker(isolate_);
+      v8::HandleScope handle_scope(isolate_);
+      v8::Local<v8::Value> chunk =
+          node::Buffer::Copy(isolate_, static_cast<const char*>(buffer), size)
+              .ToLocalChecked();
+      data_pipe_->EndReadData(static_cast<uint32_t>(size));
+      bytes_read_ += size;
+      ResolvePending(chunk);
+      return;
+    }
+  }
+
+  void ResolvePending(v8::Local<v8::Value> value) {
+    auto promise = std::move(*pending_read_);
+    pending_read_.reset();
+    promise.Resolve(value);
+  }
+
+  void RejectPending() {
+    auto promise = std::move(*pending_read_);
+    pending_read_.reset();
+    promise.RejectWithErrorMessage(error_message_);
+  }
+
+  // Release the pipe, the following reads resolve with null.
+  void Finish() {
+    done_ = true;
+    Close();
+    if (pending_read_) {
+      v8::Locker locker(isolate_);
+      v8::HandleScope handle_scope(isolate_);
+      ResolvePending(v8::Null(isolate_));
+    }
+  }
+
+  void OnFailure() {
+    failed_ = true;
+    Close();
+    if (pending_read_)
+      RejectPending();
+  }
+
+  void Close() {
+    handle_watcher_.Cancel();
+    data_pipe_.reset();
+    data_pipe_getter_.reset();
+  }
+
+  v8::Isolate* isolate_;
+
+  mojo::Remote<network::mojom::DataPipeGetter> data_pipe_getter_;
+  mojo::ScopedDataPipeConsumerHandle data_pipe_;
+  mojo::SimpleWatcher handle_watcher_;
+
+  // The range to read, and the size of all data once it is known.
+  uint64_t offset_;
+  base::Optional<uint64_t> end_;
+  base::Optional<uint64_t> total_size_;
+
+  // The bytes consumed from the pipe, including the skipped ones.
+  uint64_t bytes_read_ = 0;
+
+  std::string error_message_ = "Could not get blob data";
+  bool writer_done_ = false;
+
+  base::Optional<gin_helper::Promise<v8::Local<v8::Value>>> pending_read_;
+  uint32_t pending_size_ = 0;
+
+  bool done_ = false;
+  bool failed_ = false;
+
+  base::WeakPtrFactory<DataPipeChunkReader> weak_factory_{this};
+
+  DISALLOW_COPY_AND_ASSIGN(DataPipeChunkReader);
+};
+
+gin::WrapperInfo DataPipeChunkReader::kWrapperInfo = {gin::kEmbedderNativeGin};
+
 }  // namespace
 
 gin::WrapperInfo DataPipeHolder::kWrapperInfo = {gin::kEmbedderNativeGin};
@@ -155,10 +428,36 @@ v8::Local<v8::Promise> DataPipeHolder::ReadAll(v8::Isolate* isolate) {
     return handle;
   }
 
-  new DataPipeReader(std::move(promise), std::move(data_pipe_));
+  new DataPipeReader(std::move(promise), CloneDataPipeGetter());
   return handle;
 }
 
+v8::Local<v8::Value> DataPipeHolder::CreateReader(
+    v8::Isolate* isolate,
+    uint64_t offset,
+    base::Optional<uint64_t> length) {
+  return DataPipeChunkReader::Create(isolate, CloneDataPipeGetter(), offset,
+                                     length)
+      .ToV8();
+}
+
+v8::Local<v8::Value> CreateDataPipeReader(
+    v8::Isolate* isolate,
+    mojo::ScopedDataPipeConsumerHandle data_pipe,
+    const std::string& error_message,
+    base::OnceCallback<void(bool)>* on_writer_done) {
+  return DataPipeChunkReader::Create(isolate, std::move(data_pipe),
+                                     error_message, on_writer_done)
+      .ToV8();
+}
+
+mojo::Remote<network::mojom::DataPipeGetter>
+DataPipeHolder::CloneDataPipeGetter() {
+  mojo::Remote<network::mojom::DataPipeGetter> data_pipe_getter;
+  data_pipe_->Clone(data_pipe_getter.BindNewPipeAndPassReceiver());
+  return data_pipe_getter;
+}
+
 // static
 gin::Handle<DataPipeHolder> DataPipeHolder::Create(
     v8::Isolate* isolate,
@@ -7,9 +7,12 @@
 
 #include <string>
 
+#include "base/callback.h"
+#include "base/optional.h"
 #include "gin/handle.h"
 #include "gin/wrappable.h"
 #include "mojo/public/cpp/bindings/remote.h"
+#include "mojo/public/cpp/system/data_pipe.h"
 #include "services/network/public/cpp/data_element.h"
 #include "services/network/public/mojom/data_pipe_getter.mojom.h"
 
@@ -17,6 +20,16 @@ namespace electron {
 
 namespace api {
 
+// Creates a reader like DataPipeHolder::CreateReader's for all the data
+// written to |data_pipe|. The writer must run |on_writer_done| once it closed
+// the pipe, the reads after the data are rejected with |error_message| unless
+// it reports that all of it was written.
+v8::Local<v8::Value> CreateDataPipeReader(
+    v8::Isolate* isolate,
+    mojo::ScopedDataPipeConsumerHandle data_pipe,
+    const std::string& error_message,
+    base::OnceCallback<void(bool)>* on_writer_done);
+
 // Retains reference to the data pipe.
 class DataPipeHolder : public gin::Wrappable<DataPipeHolder> {
  public:
@@ -29,11 +42,15 @@ class DataPipeHolder : public gin::Wrappable<DataPipeHolder> {
                                           const std::string& id);
 
   // Read all data at once.
-  //
-  // TODO(zcbenz): This is apparently not suitable for really large data, but
-  // no one has complained about it yet.
   v8::Local<v8::Promise> ReadAll(v8::Isolate* isolate);
 
+  // Create a reader that returns the data in chunks, starting at |offset| and
+  // stopping after |length| bytes when it is set. Unlike ReadAll only one
+  // chunk is held in memory at a time.
+  v8::Local<v8::Value> CreateReader(v8::Isolate* isolate,
+                                    uint64_t offset,
+                                    base::Optional<uint64_t> length);
+
   // The unique ID that can be used to receive the object.
   const std::string& id() const { return id_; }
 
@@ -41,6 +58,9 @@ class DataPipeHolder : public gin::Wrappable<DataPipeHolder> {
   explicit DataPipeHolder(const network::DataElement& element);
   ~DataPipeHolder() override;
 
+  // Each reader reads from its own clone, so that the data can be read again.
+  mojo::Remote<network::mojom::DataPipeGetter> CloneDataPipeGetter();
+
   std::string id_;
   mojo::Remote<network::mojom::DataPipeGetter> data_pipe_;
 
@@ -7,15 +7,19 @@
 #include <memory>
 #include <string>
 #include <utility>
+#include <vector>
 
-#include "base/json/json_reader.h"
-#include "base/json/json_writer.h"
+#include "base/base64.h"
+#include "base/memory/ref_counted.h"
 #include "content/public/browser/devtools_agent_host.h"
 #include "content/public/browser/web_contents.h"
-#include "shell/common/gin_converters/value_converter.h"
 #include "shell/common/gin_helper/dictionary.h"
 #include "shell/common/gin_helper/object_template_builder.h"
 #include "shell/common/node_includes.h"
+#include "third_party/inspector_protocol/crdtp/cbor.h"
+#include "third_party/inspector_protocol/crdtp/parser_handler.h"
+#include "third_party/inspector_protocol/crdtp/span.h"
+#include "third_party/inspector_protocol/crdtp/status.h"
 
 using content::DevToolsAgentHost;
 
@@ -23,6 +27,255 @@ namespace electron {
 
 namespace api {
 
+namespace {
+
+// Deeper parameters are rejected, like the JSON writer did.
+const int kMaxEncodingDepth = 200;
+
+// Builds the V8 value of a CBOR message as it is parsed, without the JSON
+// string and the base::Value of the text protocol in between.
+class V8ValueBuilder : public crdtp::ParserHandler {
+ public:
+  explicit V8ValueBuilder(v8::Local<v8::Context> context)
+      : isolate_(context->GetIsolate()), context_(context) {}
+  ~V8ValueBuilder() override = default;
+
+  // Returns an empty handle when the message was invalid.
+  v8::Local<v8::Value> result() const {
+    return failed_ ? v8::Local<v8::Value>() : result_;
+  }
+
+  // crdtp::ParserHandler:
+  void HandleMapBegin() override { Push(v8::Object::New(isolate_)); }
+  void HandleMapEnd() override { Pop(); }
+  void HandleArrayBegin() override { Push(v8::Array::New(isolate_)); }
+  void HandleArrayEnd() override { Pop(); }
+  void HandleString8(crdtp::span<uint8_t> chars) override {
+    Add(v8::String::NewFromUtf8(isolate_,
+                                reinterpret_cast<const char*>(chars.data()),
+                                v8::NewStringType::kNormal, chars.size()));
+  }
+  void HandleString16(crdtp::span<uint16_t> chars) override {
+    Add(v8::String::NewFromTwoByte(isolate_, chars.data(),
+                                   v8::NewStringType::kNormal, chars.size()));
+  }
+  void HandleBinary(crdtp::span<uint8_t> bytes) override {
+    // The text protocol sends the binaries as base64 strings.
+    std::string encoded;
+    base::Base64Encode(
+        base::StringPiece(reinterpret_cast<const char*>(bytes.data()),
+                          bytes.size()),
+        &encoded);
+    Add(v8::String::NewFromUtf8(isolate_, encoded.data(),
+                                v8::NewStringType::kNormal, encoded.size()));
+  }
+  void HandleDouble(double value) override {
+    Add(v8::Number::New(isolate_, value));
+  }
+  void HandleInt32(int32_t value) override {
+    Add(v8::Integer::New(isolate_, value));
+  }
+  void HandleBool(bool value) override {
+    Add(v8::Boolean::New(isolate_, value));
+  }
+  void HandleNull() override { Add(v8::Null(isolate_)); }
+  void HandleError(crdtp::Status error) override { failed_ = true; }
+
+ private:
+  struct Container {
+    v8::Local<v8::Object> object;
+    // The key of the next value of a map, empty while the key is expected.
+    v8::Local<v8::Value> key;
+    uint32_t length = 0;
+  };
+
+  void Push(v8::Local<v8::Object> object) {
+    Container container;
+    container.object = object;
+    containers_.push_back(container);
+  }
+
+  void Pop() {
+    if (containers_.empty()) {
+      failed_ = true;
+      return;
+    }
+    v8::Local<v8::Object> object = containers_.back().object;
+    containers_.pop_back();
+    Add(object);
+  }
+
+  void Add(v8::MaybeLocal<v8::Value> maybe_value) {
+    v8::Local<v8::Value> value;
+    if (failed_ || !maybe_value.ToLocal(&value)) {
+      failed_ = true;
+      return;
+    }
+    if (containers_.empty()) {
+      result_ = value;
+      return;
+    }
+    Container& container = containers_.back();
+    bool added;
+    if (container.object->IsArray()) {
+      added = container.object
+                  ->CreateDataProperty(context_, container.length++, value)
+                  .FromMaybe(false);
+    } else if (container.key.IsEmpty()) {
+      if (!value->IsString()) {
+        failed_ = true;
+        return;
+      }
+      container.key = value;
+      return;
+    } else {
+      added = container.object
+                  ->CreateDataProperty(context_, container.key.As<v8::Name>(),
+                                       value)
+                  .FromMaybe(false);
+      container.key.Clear();
+    }
+    if (!added)
+      failed_ = true;
+  }
+
+  v8::Isolate* isolate_;
+  v8::Local<v8::Context> context_;
+  std::vector<Container> containers_;
+  v8::Local<v8::Value> result_;
+  bool failed_ = false;
+
+  DISALLOW_COPY_AND_ASSIGN(V8ValueBuilder);
+};
+
+void EncodeString(const std::string& value, crdtp::ParserHandler* encoder) {
+  encoder->HandleString8(crdtp::SpanFrom(value));
+}
+
+// Encodes |value| like JSON.stringify would, the properties holding undefined
+// or a function are left out. Returns false when |value| can not be encoded.
+bool EncodeValue(v8::Local<v8::Context> context,
+                 v8::Local<v8::Value> value,
+                 crdtp::ParserHandler* encoder,
+                 int depth) {
+  v8::Isolate* isolate = context->GetIsolate();
+  if (depth > kMaxEncodingDepth)
+    return false;
+  if (value->IsNull() || value->IsUndefined() || value->IsFunction()) {
+    encoder->HandleNull();
+  } else if (value->IsBoolean()) {
+    encoder->HandleBool(value->IsTrue());
+  } else if (value->IsInt32()) {
+    encoder->HandleInt32(value.As<v8::Int32>()->Value());
+  } else if (value->IsNumber()) {
+    encoder->HandleDouble(value.As<v8::Number>()->Value());
+  } else if (value->IsString()) {
+    v8::String::Value chars(isolate, value);
+    encoder->HandleString16(crdtp::span<uint16_t>(*chars, chars.length()));
+  } else if (value->IsArray()) {
+    v8::Local<v8::Array> array = value.As<v8::Array>();
+    encoder->HandleArrayBegin();
+    for (uint32_t i = 0; i < array->Length(); ++i) {
+      v8::Local<v8::Value> element;
+      if (!array->Get(context, i).ToLocal(&element) ||
+          !EncodeValue(context, element, encoder, depth + 1))
+        return false;
+    }
+    encoder->HandleArrayEnd();
+  } else if (value->IsObject()) {
+    v8::Local<v8::Object> object = value.As<v8::Object>();
+    v8::Local<v8::Array> keys;
+    if (!object->GetOwnPropertyNames(context).ToLocal(&keys))
+      return false;
+    encoder->HandleMapBegin();
+    for (uint32_t i = 0; i < keys->Length(); ++i) {
+      v8::Local<v8::Value> key;
+      v8::Local<v8::Value> property;
+      if (!keys->Get(context, i).ToLocal(&key) ||
+          !object->Get(context, key).ToLocal(&property))
+        return false;
+      if (property->IsUndefined() || property->IsFunction())
+        continue;
+      v8::String::Utf8Value key_chars(isolate, key);
+      if (!*key_chars)
+        return false;
+      encoder->HandleString8(crdtp::span<uint8_t>(
+          reinterpret_cast<const uint8_t*>(*key_chars), key_chars.length()));
+      if (!EncodeValue(context, property, encoder, depth + 1))
+        return false;
+    }
+    encoder->HandleMapEnd();
+  } else {
+    return false;
+  }
+  return true;
+}
+
+}  // namespace
+
+class Debugger::CommandBatch : public base::RefCounted<CommandBatch> {
+ public:
+  // A batch of one command resolves with its result, the others with the
+  // array of their results.
+  CommandBatch(v8::Isolate* isolate, size_t size, bool single)
+      : promise_(isolate),
+        results_(isolate, v8::Array::New(isolate, size)),
+        remaining_(size),
+        single_(single) {}
+
+  v8::Local<v8::Promise> GetHandle() const { return promise_.GetHandle(); }
+
+  void Resolve(v8::Local<v8::Context> context,
+               size_t index,
+               v8::Local<v8::Value> result) {
+    if (settled_)
+      return;
+    if (single_) {
+      settled_ = true;
+      promise_.Resolve(result);
+      return;
+    }
+    v8::Local<v8::Array> results = results_.Get(context->GetIsolate());
+    results->CreateDataProperty(context, index, result).Check();
+    if (--remaining_ == 0)
+      ResolveAll(context->GetIsolate());
+  }
+
+  // Only resolves while no command is being waited for.
+  void ResolveAll(v8::Isolate* isolate) {
+    if (settled_ || remaining_ > 0)
+      return;
+    settled_ = true;
+    promise_.Resolve(results_.Get(isolate));
+  }
+
+  // The first error rejects the whole batch.
+  void Reject(base::StringPiece message) {
+    if (settled_)
+      return;
+    settled_ = true;
+    promise_.RejectWithErrorMessage(message);
+  }
+
+ private:
+  friend class base::RefCounted<CommandBatch>;
+  ~CommandBatch() = default;
+
+  gin_helper::Promise<v8::Local<v8::Value>> promise_;
+  v8::Global<v8::Array> results_;
+  size_t remaining_;
+  const bool single_;
+  bool settled_ = false;
+
+  DISALLOW_COPY_AND_ASSIGN(CommandBatch);
+};
+
+Debugger::PendingRequest::PendingRequest(scoped_refptr<CommandBatch> batch,
+                                         size_t index)
+    : batch(std::move(batch)), index(index) {}
+Debugger::PendingRequest::PendingRequest(PendingRequest&&) = default;
+Debugger::PendingRequest::~PendingRequest() = default;
+
 Debugger::Debugger(v8::Isolate* isolate, content::WebContents* web_contents)
     : content::WebContentsObserver(web_contents), web_contents_(web_contents) {
   Init(isolate);
@@ -43,50 +296,52 @@ void Debugger::DispatchProtocolMessage(DevToolsAgentHost* agent_host,
 
   v8::Locker locker(isolate());
   v8::HandleScope handle_scope(isolate());
-
-  base::StringPiece message_str(reinterpret_cast<const char*>(message.data()),
-                                message.size());
-  std::unique_ptr<base::Value> parsed_message =
-      base::JSONReader::ReadDeprecated(message_str,
-                                       base::JSON_REPLACE_INVALID_CHARACTERS);
-  if (!parsed_message || !parsed_message->is_dict())
+  v8::Local<v8::Context> context = GetWrapper()->CreationContext();
+  v8::Context::Scope context_scope(context);
+
+  V8ValueBuilder builder(context);
+  crdtp::cbor::ParseCBOR(crdtp::span<uint8_t>(message.data(), message.size()),
+                         &builder);
+  v8::Local<v8::Value> parsed_message = builder.result();
+  if (parsed_message.IsEmpty() || !parsed_message->IsObject())
     return;
-  base::DictionaryValue* dict =
-      static_cast<base::DictionaryValue*>(parsed_message.get());
+  gin_helper::Dictionary dict(isolate(), parsed_message.As<v8::Object>());
   int id;
-  if (!dict->GetInteger("id", &id)) {
+  if (!dict.Get("id", &id)) {
     std::string method;
-    if (!dict->GetString("method", &method))
+    if (!dict.Get("method", &method))
       return;
-    base::DictionaryValue* params_value = nullptr;
-    base::DictionaryValue params;
-    if (dict->GetDictionary("params", &params_value))
-      params.Swap(params_value);
+    v8::Local<v8::Value> params;
+    if (!dict.Get("params", &params) || !params->IsObject())
+      params = v8::Object::New(isolate());
     Emit("message", method, params);
   } else {
     auto it = pending_requests_.find(id);
     if (it == pending_requests_.end())
       return;
 
-    gin_helper::Promise<base::DictionaryValue> promise = std::move(it->second);
+    PendingRequest request = std::move(it->second);
     pending_requests_.erase(it);
 
-    base::DictionaryValue* error = nullptr;
-    if (dict->GetDictionary("error", &error)) {
+    v8::Local<v8::Value> error;
+    if (dict.Get("error", &error) && error->IsObject()) {
       std::string message;
-      error->GetString("message", &message);
-      promise.RejectWithErrorMessage(message);
+      gin_helper::Dictionary(isolate(), error.As<v8::Object>())
+          .Get("message", &message);
+      request.batch->Reject(message);
     } else {
-      base::DictionaryValue* result_body = nullptr;
-      base::DictionaryValue result;
-      if (dict->GetDictionary("result", &result_body)) {
-        result.Swap(result_body);
-      }
-      promise.Resolve(result);
+      v8::Local<v8::Value> result;
+      if (!dict.Get("result", &result) || !result->IsObject())
+        result = v8::Object::New(isolate());
+      request.batch->Resolve(context, request.index, result);
     }
   }
 }
 
+bool Debugger::UsesBinaryProtocol() {
+  return true;
+}
+
 void Debugger::RenderFrameHostChanged(content::RenderFrameHost* old_rfh,
                                       content::RenderFrameHost* new_rfh) {
   if (agent_host_) {
@@ -132,43 +387,107 @@ void Debugger::Detach() {
 }
 
 v8::Local<v8::Promise> Debugger::SendCommand(gin_helper::Arguments* args) {
-  gin_helper::Promise<base::DictionaryValue> promise(isolate());
-  v8::Local<v8::Promise> handle = promise.GetHandle();
+  auto batch = base::MakeRefCounted<CommandBatch>(isolate(), 1, true);
+  v8::Local<v8::Promise> handle = batch->GetHandle();
 
   if (!agent_host_) {
-    promise.RejectWithErrorMessage("No target available");
+    batch->Reject("No target available");
     return handle;
   }
 
   std::string method;
   if (!args->GetNext(&method)) {
-    promise.RejectWithErrorMessage("Invalid method");
+    batch->Reject("Invalid method");
     return handle;
   }
 
-  base::DictionaryValue command_params;
+  v8::Local<v8::Value> command_params;
   args->GetNext(&command_params);
 
-  base::DictionaryValue request;
-  int request_id = ++previous_request_id_;
-  pending_requests_.emplace(request_id, std::move(promise));
-  request.SetInteger("id", request_id);
-  request.SetString("method", method);
-  if (!command_params.empty())
-    request.Set("params",
-                base::Value::ToUniquePtrValue(command_params.Clone()));
-
-  std::string json_args;
-  base::JSONWriter::Write(request, &json_args);
-  agent_host_->DispatchProtocolMessage(
-      this, base::as_bytes(base::make_span(json_args)));
+  if (!DispatchCommand(isolate()->GetCurrentContext(), method, command_params,
+                       batch, 0))
+    batch->Reject("Invalid parameters");
+  return handle;
+}
+
+v8::Local<v8::Promise> Debugger::SendCommands(v8::Local<v8::Value> commands) {
+  v8::Local<v8::Context> context = isolate()->GetCurrentContext();
+  uint32_t size =
+      commands->IsArray() ? commands.As<v8::Array>()->Length() : 0;
+  auto batch = base::MakeRefCounted<CommandBatch>(isolate(), size, false);
+  v8::Local<v8::Promise> handle = batch->GetHandle();
+
+  if (!commands->IsArray()) {
+    batch->Reject("Invalid commands");
+    return handle;
+  }
+  if (!agent_host_) {
+    batch->Reject("No target available");
+    return handle;
+  }
 
+  for (uint32_t i = 0; i < size; ++i) {
+    v8::Local<v8::Value> command;
+    gin_helper::Dictionary dict;
+    std::string method;
+    if (!commands.As<v8::Array>()->Get(context, i).ToLocal(&command) ||
+        !gin::ConvertFromV8(isolate(), command, &dict) ||
+        !dict.Get("method", &method)) {
+      batch->Reject("Invalid method");
+      return handle;
+    }
+    v8::Local<v8::Value> command_params;
+    dict.Get("params", &command_params);
+    // The agent host may close while a command is dispatched.
+    if (!agent_host_) {
+      batch->Reject("No target available");
+      return handle;
+    }
+    if (!DispatchCommand(context, method, command_params, batch, i)) {
+      batch->Reject("Invalid parameters");
+      return handle;
+    }
+  }
+  // Resolves an empty batch.
+  batch->ResolveAll(isolate());
   return handle;
 }
 
+bool Debugger::DispatchCommand(v8::Local<v8::Context> context,
+                               const std::string& method,
+                               v8::Local<v8::Value> params,
+                               scoped_refptr<CommandBatch> batch,
+                               size_t index) {
+  std::vector<uint8_t> message;
+  crdtp::Status status;
+  std::unique_ptr<crdtp::ParserHandler> encoder =
+      crdtp::cbor::NewCBOREncoder(&message, &status);
+  int request_id = ++previous_request_id_;
+  encoder->HandleMapBegin();
+  EncodeString("id", encoder.get());
+  encoder->HandleInt32(request_id);
+  EncodeString("method", encoder.get());
+  EncodeString(method, encoder.get());
+  if (!params.IsEmpty() && params->IsObject() && !params->IsArray()) {
+    EncodeString("params", encoder.get());
+    if (!EncodeValue(context, params, encoder.get(), 0))
+      return false;
+  }
+  encoder->HandleMapEnd();
+  if (!status.ok())
+    return false;
+
+  pending_requests_.emplace(request_id,
+                            PendingRequest(std::move(batch), index));
+  agent_host_->DispatchProtocolMessage(this, message);
+  return true;
+}
+
 void Debugger::ClearPendingRequests() {
-  for (auto& it : pending_requests_)
-    it.second.RejectWithErrorMessage("target closed while handling command");
+  PendingRequestMap pending_requests;
+  pending_requests.swap(pending_requests_);
+  for (auto& it : pending_requests)
+    it.second.batch->Reject("target closed while handling command");
 }
 
 // static
@@ -185,7 +504,8 @@ void Debugger::BuildPrototype(v8::Isolate* isolate,
       .SetMethod("attach", &Debugger::Attach)
       .SetMethod("isAttached", &Debugger::IsAttached)
       .SetMethod("detach", &Debugger::Detach)
-      .SetMethod("sendCommand", &Debugger::SendCommand);
+      .SetMethod("sendCommand", &Debugger::SendCommand)
+      .SetMethod("sendCommands", &Debugger::SendCommands);
 }
 
 }  // namespace api
@@ -9,7 +9,7 @@
 #include <string>
 
 #include "base/callback.h"
-#include "base/values.h"
+#include "base/memory/scoped_refptr.h"
 #include "content/public/browser/devtools_agent_host_client.h"
 #include "content/public/browser/web_contents_observer.h"
 #include "gin/handle.h"
@@ -44,19 +44,40 @@ class Debugger : public gin_helper::TrackableObject<Debugger>,
   void AgentHostClosed(content::DevToolsAgentHost* agent_host) override;
   void DispatchProtocolMessage(content::DevToolsAgentHost* agent_host,
                                base::span<const uint8_t> message) override;
+  bool UsesBinaryProtocol() override;
 
   // content::WebContentsObserver:
   void RenderFrameHostChanged(content::RenderFrameHost* old_rfh,
                               content::RenderFrameHost* new_rfh) override;
 
  private:
-  using PendingRequestMap =
-      std::map<int, gin_helper::Promise<base::DictionaryValue>>;
+  // The commands sent by one call, which settle one promise.
+  class CommandBatch;
+
+  struct PendingRequest {
+    PendingRequest(scoped_refptr<CommandBatch> batch, size_t index);
+    PendingRequest(PendingRequest&&);
+    ~PendingRequest();
+
+    scoped_refptr<CommandBatch> batch;
+    // The position of the command in |batch|.
+    size_t index;
+  };
+
+  using PendingRequestMap = std::map<int, PendingRequest>;
 
   void Attach(gin_helper::Arguments* args);
   bool IsAttached();
   void Detach();
   v8::Local<v8::Promise> SendCommand(gin_helper::Arguments* args);
+  v8::Local<v8::Promise> SendCommands(v8::Local<v8::Value> commands);
+  // Encodes the command in CBOR and sends it. Returns false when |params|
+  // can not be encoded.
+  bool DispatchCommand(v8::Local<v8::Context> context,
+                       const std::string& method,
+                       v8::Local<v8::Value> params,
+                       scoped_refptr<CommandBatch> batch,
+                       size_t index);
   void ClearPendingRequests();
 
   content::WebContents* web_contents_;  // Weak Reference.
@@ -8,8 +8,10 @@
 #include <utility>
 #include <vector>
 
+#include "base/bind.h"
 #include "base/strings/string_number_conversions.h"
 #include "base/strings/utf_string_conversions.h"
+#include "base/task/post_task.h"
 #include "base/threading/thread_restrictions.h"
 #include "chrome/browser/media/webrtc/desktop_media_list.h"
 #include "chrome/browser/media/webrtc/window_icon_util.h"
@@ -17,10 +19,12 @@
 #include "shell/common/api/atom_api_native_image.h"
 #include "shell/common/gin_converters/gfx_converter.h"
 #include "shell/common/gin_helper/dictionary.h"
+#include "shell/common/gin_helper/locker.h"
 #include "shell/common/gin_helper/object_template_builder.h"
 #include "shell/common/node_includes.h"
 #include "third_party/webrtc/modules/desktop_capture/desktop_capture_options.h"
 #include "third_party/webrtc/modules/desktop_capture/desktop_capturer.h"
+#include "ui/gfx/codec/png_codec.h"
 
 #if defined(OS_WIN)
 #include "third_party/webrtc/modules/desktop_capture/win/dxgi_duplicator_controller.h"
@@ -59,6 +63,18 @@ namespace electron {
 
 namespace api {
 
+namespace {
+
+std::unique_ptr<std::vector<unsigned char>> EncodeThumbnail(
+    const SkBitmap& bitmap) {
+  auto png = std::make_unique<std::vector<unsigned char>>();
+  if (!bitmap.drawsNothing())
+    gfx::PNGCodec::EncodeBGRASkBitmap(bitmap, false, png.get());
+  return png;
+}
+
+}  // namespace
+
 DesktopCapturer::DesktopCapturer(v8::Isolate* isolate) {
   Init(isolate);
 }
@@ -68,8 +84,12 @@ DesktopCapturer::~DesktopCapturer() = default;
 void DesktopCapturer::StartHandling(bool capture_window,
                                     bool capture_screen,
                                     const gfx::Size& thumbnail_size,
-                                    bool fetch_window_icons) {
+                                    bool fetch_window_icons,
+                                    bool stream_sources,
+                                    bool stream_thumbnails) {
   fetch_window_icons_ = fetch_window_icons;
+  stream_sources_ = stream_sources;
+  stream_thumbnails_ = stream_thumbnails;
 #if defined(OS_WIN)
   if (content::desktop_capture::CreateDesktopCaptureOptions()
           .allow_directx_capturer()) {
@@ -114,10 +134,102 @@ void DesktopCapturer::StartHandling(bool capture_window,
   }
 }
 
+void DesktopCapturer::OnSourceAdded(DesktopMediaList* list, int index) {
+  if (!stream_sources_)
+    return;
+
+  const DesktopMediaList::Source& media_list_source = list->GetSource(index);
+  if (list->GetMediaListType() == content::DesktopMediaID::TYPE_WINDOW) {
+    Emit("source-added",
+         DesktopCapturer::Source{media_list_source, std::string(),
+                                 fetch_window_icons_});
+    return;
+  }
+
+  std::vector<std::string> display_ids;
+  if (!GetDisplayIds(list->GetSources(), &display_ids))
+    return;
+  Emit("source-added",
+       DesktopCapturer::Source{media_list_source, display_ids[index]});
+}
+
+void DesktopCapturer::OnSourceThumbnailChanged(DesktopMediaList* list,
+                                               int index) {
+  if (!stream_thumbnails_)
+    return;
+
+  // The thumbnails are encoded in parallel, the bitmaps sharing their pixels
+  // with the list.
+  const DesktopMediaList::Source& source = list->GetSource(index);
+  const SkBitmap* bitmap = source.thumbnail.bitmap();
+  if (!bitmap)
+    return;
+  encoding_thumbnails_++;
+  base::PostTaskAndReplyWithResult(
+      FROM_HERE, {base::ThreadPool(), base::TaskPriority::USER_BLOCKING},
+      base::BindOnce(&EncodeThumbnail, *bitmap),
+      base::BindOnce(&DesktopCapturer::OnThumbnailEncoded,
+                     weak_ptr_factory_.GetWeakPtr(), source.id.ToString()));
+}
+
 void DesktopCapturer::OnSourceUnchanged(DesktopMediaList* list) {
   UpdateSourcesList(list);
 }
 
+void DesktopCapturer::OnThumbnailEncoded(
+    const std::string& id,
+    std::unique_ptr<std::vector<unsigned char>> png) {
+  encoding_thumbnails_--;
+  gin_helper::Locker locker(isolate());
+  v8::HandleScope handle_scope(isolate());
+  Emit("thumbnail-changed", id,
+       node::Buffer::Copy(isolate(), reinterpret_cast<const char*>(png->data()),
+                          png->size())
+           .ToLocalChecked());
+  MaybeFinish();
+}
+
+bool DesktopCapturer::GetDisplayIds(
+    const std::vector<DesktopMediaList::Source>& sources,
+    std::vector<std::string>* display_ids) {
+  display_ids->assign(sources.size(), std::string());
+#if defined(OS_WIN)
+  // Gather the same unique screen IDs used by the electron.screen API in
+  // order to provide an association between it and
+  // desktopCapturer/getUserMedia. This is only required when using the
+  // DirectX capturer, otherwise the IDs across the APIs already match.
+  if (using_directx_capturer_) {
+    std::vector<std::string> device_names;
+    // Crucially, this list of device names will be in the same order as
+    // |sources|.
+    if (!webrtc::DxgiDuplicatorController::Instance()->GetDeviceNames(
+            &device_names)) {
+      Emit("error", "Failed to get sources.");
+      return false;
+    }
+
+    for (size_t i = 0; i < sources.size() && i < device_names.size(); ++i) {
+      const auto& device_name = device_names[i];
+      std::wstring wide_device_name;
+      base::UTF8ToWide(device_name.c_str(), device_name.size(),
+                       &wide_device_name);
+      const int64_t device_id =
+          display::win::DisplayInfo::DeviceIdFromDeviceName(
+              wide_device_name.c_str());
+      (*display_ids)[i] = base::NumberToString(device_id);
+    }
+  }
+#elif defined(OS_MACOSX)
+  // On Mac, the IDs across the APIs match.
+  for (size_t i = 0; i < sources.size(); ++i)
+    (*display_ids)[i] = base::NumberToString(sources[i].id.id);
+#endif  // defined(OS_WIN)
+  // TODO(ajmacd): Add Linux support. The IDs across APIs differ but Chrome
+  // only supports capturing the entire desktop on Linux. Revisit this if
+  // individual screen support is added.
+  return true;
+}
+
 void DesktopCapturer::UpdateSourcesList(DesktopMediaList* list) {
   if (capture_window_ &&
       list->GetMediaListType() == content::DesktopMediaID::TYPE_WINDOW) {
@@ -137,53 +249,20 @@ void DesktopCapturer::UpdateSourcesList(DesktopMediaList* list) {
       list->GetMediaListType() == content::DesktopMediaID::TYPE_SCREEN) {
     capture_screen_ = false;
     const auto& media_list_sources = list->GetSources();
-    std::vector<DesktopCapturer::Source> screen_sources;
-    screen_sources.reserve(media_list_sources.size());
-    for (const auto& media_list_source : media_list_sources) {
-      screen_sources.emplace_back(
-          DesktopCapturer::Source{media_list_source, std::string()});
+    std::vector<std::string> display_ids;
+    if (!GetDisplayIds(media_list_sources, &display_ids))
+      return;
+    for (size_t i = 0; i < media_list_sources.size(); ++i) {
+      captured_sources_.emplace_back(
+          DesktopCapturer::Source{media_list_sources[i], display_ids[i]});
     }
-#if defined(OS_WIN)
-    // Gather the same unique screen IDs used by the electron.screen API in
-    // order to provide an association between it and
-    // desktopCapturer/getUserMedia. This is only required when using the
-    // DirectX capturer, otherwise the IDs across the APIs already match.
-    if (using_directx_capturer_) {
-      std::vector<std::string> device_names;
-      // Crucially, this list of device names will be in the same order as
-      // |media_list_sources|.
-      if (!webrtc::DxgiDuplicatorController::Instance()->GetDeviceNames(
-              &device_names)) {
-        Emit("error", "Failed to get sources.");
-        return;
-      }
-
-      int device_name_index = 0;
-      for (auto& source : screen_sources) {
-        const auto& device_name = device_names[device_name_index++];
-        std::wstring wide_device_name;
-        base::UTF8ToWide(device_name.c_str(), device_name.size(),
-                         &wide_device_name);
-        const int64_t device_id =
-            display::win::DisplayInfo::DeviceIdFromDeviceName(
-                wide_device_name.c_str());
-        source.display_id = base::NumberToString(device_id);
-      }
-    }
-#elif defined(OS_MACOSX)
-    // On Mac, the IDs across the APIs match.
-    for (auto& source : screen_sources) {
-      source.display_id = base::NumberToString(source.media_list_source.id.id);
-    }
-#endif  // defined(OS_WIN)
-    // TODO(ajmacd): Add Linux support. The IDs across APIs differ but Chrome
-    // only supports capturing the entire desktop on Linux. Revisit this if
-    // individual screen support is added.
-    std::move(screen_sources.begin(), screen_sources.end(),
-              std::back_inserter(captured_sources_));
   }
 
-  if (!capture_window_ && !capture_screen_)
+  MaybeFinish();
+}
+
+void DesktopCapturer::MaybeFinish() {
+  if (!capture_window_ && !capture_screen_ && encoding_thumbnails_ == 0)
     Emit("finished", captured_sources_, fetch_window_icons_);
 }
 
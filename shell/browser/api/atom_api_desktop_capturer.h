@@ -35,34 +35,54 @@ class DesktopCapturer : public gin_helper::TrackableObject<DesktopCapturer>,
   static void BuildPrototype(v8::Isolate* isolate,
                              v8::Local<v8::FunctionTemplate> prototype);
 
+  // With |stream_sources|, the sources are also emitted as they are found,
+  // and with |stream_thumbnails| their thumbnails once they are captured,
+  // encoded as PNG.
   void StartHandling(bool capture_window,
                      bool capture_screen,
                      const gfx::Size& thumbnail_size,
-                     bool fetch_window_icons);
+                     bool fetch_window_icons,
+                     bool stream_sources,
+                     bool stream_thumbnails);
 
  protected:
   explicit DesktopCapturer(v8::Isolate* isolate);
   ~DesktopCapturer() override;
 
   // DesktopMediaListObserver:
-  void OnSourceAdded(DesktopMediaList* list, int index) override {}
+  void OnSourceAdded(DesktopMediaList* list, int index) override;
   void OnSourceRemoved(DesktopMediaList* list, int index) override {}
   void OnSourceMoved(DesktopMediaList* list,
                      int old_index,
                      int new_index) override {}
   void OnSourceNameChanged(DesktopMediaList* list, int index) override {}
-  void OnSourceThumbnailChanged(DesktopMediaList* list, int index) override {}
+  void OnSourceThumbnailChanged(DesktopMediaList* list, int index) override;
   void OnSourceUnchanged(DesktopMediaList* list) override;
 
  private:
   void UpdateSourcesList(DesktopMediaList* list);
 
+  // Gets the ids of the displays of the screen |sources|, in the same order,
+  // which match the ids of the screen API. Returns false on failure.
+  bool GetDisplayIds(const std::vector<DesktopMediaList::Source>& sources,
+                     std::vector<std::string>* display_ids);
+
+  void OnThumbnailEncoded(const std::string& id,
+                          std::unique_ptr<std::vector<unsigned char>> png);
+  // Emits "finished" once all the sources are listed and all the streamed
+  // thumbnails are emitted.
+  void MaybeFinish();
+
   std::unique_ptr<DesktopMediaList> window_capturer_;
   std::unique_ptr<DesktopMediaList> screen_capturer_;
   std::vector<DesktopCapturer::Source> captured_sources_;
   bool capture_window_ = false;
   bool capture_screen_ = false;
   bool fetch_window_icons_ = false;
+  bool stream_sources_ = false;
+  bool stream_thumbnails_ = false;
+  // The number of streamed thumbnails which are being encoded.
+  int encoding_thumbnails_ = 0;
 #if defined(OS_WIN)
   bool using_directx_capturer_ = false;
 #endif  // defined(OS_WIN)
@@ -6,6 +6,7 @@
 
 #include <map>
 
+#include "base/bind.h"
 #include "base/strings/utf_string_conversions.h"
 #include "base/threading/thread_task_runner_handle.h"
 #include "net/base/filename_util.h"
@@ -78,15 +79,35 @@ DownloadItem::~DownloadItem() {
 
 void DownloadItem::OnDownloadUpdated(download::DownloadItem* item) {
   if (download_item_->IsDone()) {
+    updated_timer_.Stop();
     Emit("done", item->GetState());
     // Destroy the item once item is downloaded.
     base::ThreadTaskRunnerHandle::Get()->PostTask(FROM_HERE,
                                                   GetDestroyClosure());
-  } else {
-    Emit("updated", item->GetState());
+  } else if (updated_interval_.is_zero() ||
+             item->GetState() != last_updated_state_ ||
+             item->IsPaused() != last_updated_paused_) {
+    updated_timer_.Stop();
+    EmitUpdated();
+  } else if (!updated_timer_.IsRunning()) {
+    base::TimeDelta elapsed = base::TimeTicks::Now() - last_updated_;
+    if (elapsed >= updated_interval_) {
+      EmitUpdated();
+    } else {
+      updated_timer_.Start(
+          FROM_HERE, updated_interval_ - elapsed,
+          base::BindOnce(&DownloadItem::EmitUpdated, base::Unretained(this)));
+    }
   }
 }
 
+void DownloadItem::EmitUpdated() {
+  last_updated_ = base::TimeTicks::Now();
+  last_updated_state_ = download_item_->GetState();
+  last_updated_paused_ = download_item_->IsPaused();
+  Emit("updated", last_updated_state_);
+}
+
 void DownloadItem::OnDownloadDestroyed(download::DownloadItem* download_item) {
   download_item_ = nullptr;
   // Destroy the native class immediately when downloadItem is destroyed.
@@ -186,6 +207,15 @@ double DownloadItem::GetStartTime() const {
   return download_item_->GetStartTime().ToDoubleT();
 }
 
+void DownloadItem::SetUpdatedEventInterval(gin_helper::ErrorThrower thrower,
+                                           int interval) {
+  if (interval < 0) {
+    thrower.ThrowError("interval must be a non-negative integer");
+    return;
+  }
+  updated_interval_ = base::TimeDelta::FromMilliseconds(interval);
+}
+
 // static
 void DownloadItem::BuildPrototype(v8::Isolate* isolate,
                                   v8::Local<v8::FunctionTemplate> prototype) {
@@ -215,7 +245,9 @@ void DownloadItem::BuildPrototype(v8::Isolate* isolate,
       .SetMethod("getSaveDialogOptions", &DownloadItem::GetSaveDialogOptions)
       .SetMethod("getLastModifiedTime", &DownloadItem::GetLastModifiedTime)
       .SetMethod("getETag", &DownloadItem::GetETag)
-      .SetMethod("getStartTime", &DownloadItem::GetStartTime);
+      .SetMethod("getStartTime", &DownloadItem::GetStartTime)
+      .SetMethod("setUpdatedEventInterval",
+                 &DownloadItem::SetUpdatedEventInterval);
 }
 
 // static
@@ -9,9 +9,12 @@
 #include <vector>
 
 #include "base/files/file_path.h"
+#include "base/time/time.h"
+#include "base/timer/timer.h"
 #include "components/download/public/common/download_item.h"
 #include "gin/handle.h"
 #include "shell/browser/ui/file_dialog.h"
+#include "shell/common/gin_helper/error_thrower.h"
 #include "shell/common/gin_helper/trackable_object.h"
 #include "url/gurl.h"
 
@@ -50,6 +53,7 @@ class DownloadItem : public gin_helper::TrackableObject<DownloadItem>,
   std::string GetLastModifiedTime() const;
   std::string GetETag() const;
   double GetStartTime() const;
+  void SetUpdatedEventInterval(gin_helper::ErrorThrower thrower, int interval);
 
  protected:
   DownloadItem(v8::Isolate* isolate, download::DownloadItem* download_item);
@@ -60,10 +64,21 @@ class DownloadItem : public gin_helper::TrackableObject<DownloadItem>,
   void OnDownloadDestroyed(download::DownloadItem* download) override;
 
  private:
+  void EmitUpdated();
+
   base::FilePath save_path_;
   file_dialog::DialogSettings dialog_options_;
   download::DownloadItem* download_item_;
 
+  // The progress of the download is emitted at most once per interval, while
+  // the changes of its state are emitted right away.
+  base::TimeDelta updated_interval_;
+  base::TimeTicks last_updated_;
+  download::DownloadItem::DownloadState last_updated_state_ =
+      download::DownloadItem::IN_PROGRESS;
+  bool last_updated_paused_ = false;
+  base::OneShotTimer updated_timer_;
+
   DISALLOW_COPY_AND_ASSIGN(DownloadItem);
 };
 
@@ -84,11 +84,25 @@ bool Menu::GetAcceleratorForCommandIdWithParams(
     int command_id,
     bool use_default_accelerator,
     ui::Accelerator* accelerator) const {
-  v8::Locker locker(isolate());
-  v8::HandleScope handle_scope(isolate());
-  v8::Local<v8::Value> val =
-      get_accelerator_.Run(GetWrapper(), command_id, use_default_accelerator);
-  return gin::ConvertFromV8(isolate(), val, accelerator);
+  // The accelerators of the items can not change, so each is only asked for
+  // once, and the lookups while handling keys do not call into JavaScript.
+  auto key = std::make_pair(command_id, use_default_accelerator);
+  auto it = accelerators_.find(key);
+  if (it == accelerators_.end()) {
+    v8::Locker locker(isolate());
+    v8::HandleScope handle_scope(isolate());
+    v8::Local<v8::Value> val =
+        get_accelerator_.Run(GetWrapper(), command_id, use_default_accelerator);
+    base::Optional<ui::Accelerator> result;
+    ui::Accelerator parsed;
+    if (gin::ConvertFromV8(isolate(), val, &parsed))
+      result = parsed;
+    it = accelerators_.emplace(key, result).first;
+  }
+  if (!it->second)
+    return false;
+  *accelerator = *it->second;
+  return true;
 }
 
 bool Menu::ShouldRegisterAcceleratorForCommandId(int command_id) const {
@@ -160,6 +174,7 @@ void Menu::SetRole(int index, const base::string16& role) {
 
 void Menu::Clear() {
   model_->Clear();
+  accelerators_.clear();
 }
 
 int Menu::GetIndexOfCommandId(int command_id) {
@@ -5,14 +5,18 @@
 #ifndef SHELL_BROWSER_API_ATOM_API_MENU_H_
 #define SHELL_BROWSER_API_ATOM_API_MENU_H_
 
+#include <map>
 #include <memory>
 #include <string>
+#include <utility>
 
 #include "base/callback.h"
+#include "base/optional.h"
 #include "gin/arguments.h"
 #include "shell/browser/api/atom_api_top_level_window.h"
 #include "shell/browser/ui/atom_menu_model.h"
 #include "shell/common/gin_helper/trackable_object.h"
+#include "ui/base/accelerators/accelerator.h"
 
 namespace electron {
 
@@ -120,6 +124,11 @@ class Menu : public gin_helper::TrackableObject<Menu>,
       execute_command_;
   base::RepeatingCallback<void(v8::Local<v8::Value>)> menu_will_show_;
 
+  // The accelerators by command id and whether the default accelerator of
+  // the role is used, null when the item has none.
+  mutable std::map<std::pair<int, bool>, base::Optional<ui::Accelerator>>
+      accelerators_;
+
   DISALLOW_COPY_AND_ASSIGN(Menu);
 };
 
@@ -150,6 +150,14 @@ void MenuMac::OnClosed(int32_t window_id, base::OnceClosure callback) {
 // static
 void Menu::SetApplicationMenu(Menu* base_menu) {
   MenuMac* menu = static_cast<MenuMac*>(base_menu);
+
+  // Setting the application menu again, after its items changed, updates them
+  // in place when none was added or removed.
+  if (menu->menu_controller_ && applicationMenu_ &&
+      applicationMenu_.get() == [menu->menu_controller_ menu] &&
+      [menu->menu_controller_ updateFromModel])
+    return;
+
   base::scoped_nsobject<AtomMenuController> menu_controller(
       [[AtomMenuController alloc] initWithModel:menu->model_.get()
                           useDefaultAccelerator:YES]);
@@ -21,6 +21,14 @@ namespace electron {
 
 namespace api {
 
+namespace {
+
+// The theme sends several updates while it changes, and "updated" is emitted
+// once they stopped for this long.
+constexpr base::TimeDelta kUpdatedDelay = base::TimeDelta::FromMilliseconds(50);
+
+}  // namespace
+
 NativeTheme::NativeTheme(v8::Isolate* isolate, ui::NativeTheme* theme)
     : theme_(theme) {
   theme_->AddObserver(this);
@@ -32,6 +40,12 @@ NativeTheme::~NativeTheme() {
 }
 
 void NativeTheme::OnNativeThemeUpdatedOnUI() {
+  updated_timer_.Start(
+      FROM_HERE, kUpdatedDelay,
+      base::BindOnce(&NativeTheme::EmitUpdated, base::Unretained(this)));
+}
+
+void NativeTheme::EmitUpdated() {
   Emit("updated");
 }
 
@@ -5,6 +5,7 @@
 #ifndef SHELL_BROWSER_API_ATOM_API_NATIVE_THEME_H_
 #define SHELL_BROWSER_API_ATOM_API_NATIVE_THEME_H_
 
+#include "base/timer/timer.h"
 #include "shell/common/gin_helper/event_emitter.h"
 #include "ui/native_theme/native_theme.h"
 #include "ui/native_theme/native_theme_observer.h"
@@ -40,8 +41,13 @@ class NativeTheme : public gin_helper::EventEmitter<NativeTheme>,
   void OnNativeThemeUpdatedOnUI();
 
  private:
+  void EmitUpdated();
+
   ui::NativeTheme* theme_;
 
+  // Coalesces the updates of a burst into one "updated" event.
+  base::OneShotTimer updated_timer_;
+
   DISALLOW_COPY_AND_ASSIGN(NativeTheme);
 };
 
@@ -4,9 +4,17 @@
 
 #include "shell/browser/api/atom_api_net_log.h"
 
+#include <set>
+#include <string>
 #include <utility>
 
 #include "base/command_line.h"
+#include "base/files/file.h"
+#include "base/files/file_util.h"
+#include "base/json/json_reader.h"
+#include "base/macros.h"
+#include "base/strings/string_piece.h"
+#include "base/strings/string_util.h"
 #include "chrome/browser/browser_process.h"
 #include "components/net_log/chrome_net_log.h"
 #include "content/public/browser/storage_partition.h"
@@ -14,6 +22,7 @@
 #include "shell/browser/atom_browser_context.h"
 #include "shell/browser/net/system_network_context_manager.h"
 #include "shell/common/gin_converters/file_path_converter.h"
+#include "shell/common/gin_converters/std_converter.h"
 #include "shell/common/gin_helper/dictionary.h"
 #include "shell/common/gin_helper/object_template_builder.h"
 #include "shell/common/node_includes.h"
@@ -62,6 +71,179 @@ base::File OpenFileForWriting(base::FilePath path) {
                     base::File::FLAG_CREATE_ALWAYS | base::File::FLAG_WRITE);
 }
 
+// Returns the values of the types named in |names|, looked up in the
+// |constants| of the log.
+std::set<int> GetTypeValues(const base::Value* constants,
+                            const std::set<std::string>& names) {
+  std::set<int> values;
+  if (!constants || !constants->is_dict())
+    return values;
+  for (const auto& name : names) {
+    base::Optional<int> value = constants->FindIntKey(name);
+    if (value)
+      values.insert(*value);
+  }
+  return values;
+}
+
+// Reads a file line by line, without the line breaks.
+class LineReader {
+ public:
+  explicit LineReader(base::File* file) : file_(file) {}
+
+  bool ReadLine(std::string* line) {
+    line->clear();
+    while (true) {
+      size_t end = buffer_.find('\n', position_);
+      if (end != std::string::npos) {
+        line->append(buffer_, position_, end - position_);
+        position_ = end + 1;
+        return true;
+      }
+      line->append(buffer_, position_, std::string::npos);
+      buffer_.resize(kBufferSize);
+      position_ = 0;
+      int read = file_->ReadAtCurrentPos(&buffer_[0], kBufferSize);
+      if (read <= 0) {
+        buffer_.clear();
+        return !line->empty();
+      }
+      buffer_.resize(read);
+    }
+  }
+
+ private:
+  static constexpr int kBufferSize = 64 * 1024;
+
+  base::File* file_;
+  std::string buffer_;
+  size_t position_ = 0;
+
+  DISALLOW_COPY_AND_ASSIGN(LineReader);
+};
+
+bool WriteString(base::File* file, base::StringPiece data) {
+  return file->WriteAtCurrentPos(data.data(), data.size()) ==
+         static_cast<int>(data.size());
+}
+
+// Writes the log at |source| to |dest|, keeping only the events of one of
+// |event_types| and from one of |source_types|. Either is ignored when empty.
+//
+// The log is streamed, relying on the format of FileNetLogObserver: the
+// constants come first, then each event on a line of its own after the
+// line which opens the "events" list, and the line closing the list starts
+// with "]". Only the constants and one event are parsed at a time.
+bool FilterNetLogFile(const base::FilePath& source,
+                      const base::FilePath& dest,
+                      const std::set<std::string>& event_types,
+                      const std::set<std::string>& source_types) {
+  if (event_types.empty() && source_types.empty())
+    return source == dest || base::CopyFile(source, dest);
+
+  base::File source_file(source,
+                         base::File::FLAG_OPEN | base::File::FLAG_READ);
+  if (!source_file.IsValid())
+    return false;
+  // Written next to |dest|, which can be |source|, and moved over it once
+  // complete.
+  base::FilePath temp_path;
+  if (!base::CreateTemporaryFileInDir(dest.DirName(), &temp_path))
+    return false;
+  base::File temp_file = OpenFileForWriting(temp_path);
+
+  LineReader reader(&source_file);
+  std::string line;
+  std::string header;
+  bool in_events = false;
+  while (reader.ReadLine(&line)) {
+    if (base::TrimWhitespaceASCII(line, base::TRIM_ALL) == "\"events\": [") {
+      in_events = true;
+      break;
+    }
+    header.append(line).append("\n");
+  }
+
+  // The constants are the part of the log before the events.
+  base::Optional<base::Value> constants;
+  if (in_events) {
+    base::StringPiece prefix =
+        base::TrimWhitespaceASCII(header, base::TRIM_TRAILING);
+    if (base::EndsWith(prefix, ",", base::CompareCase::SENSITIVE))
+      prefix.remove_suffix(1);
+    base::Optional<base::Value> log =
+        base::JSONReader::Read(prefix.as_string() + "}");
+    if (log && log->is_dict()) {
+      base::Value* value = log->FindDictKey("constants");
+      if (value)
+        constants = std::move(*value);
+    }
+  }
+  if (!constants || !WriteString(&temp_file, header) ||
+      !WriteString(&temp_file, line) || !WriteString(&temp_file, "\n")) {
+    temp_file.Close();
+    base::DeleteFile(temp_path, false);
+    return false;
+  }
+
+  std::set<int> event_values =
+      GetTypeValues(constants->FindKey("logEventTypes"), event_types);
+  std::set<int> source_values =
+      GetTypeValues(constants->FindKey("logSourceType"), source_types);
+  bool success = true;
+  bool first_event = true;
+  while (success && reader.ReadLine(&line)) {
+    base::StringPiece text = base::TrimWhitespaceASCII(line, base::TRIM_ALL);
+    if (base::StartsWith(text, "]", base::CompareCase::SENSITIVE)) {
+      // The rest of the log follows the events.
+      success = (first_event || WriteString(&temp_file, "\n")) &&
+                WriteString(&temp_file, line) && WriteString(&temp_file, "\n");
+      while (success && reader.ReadLine(&line))
+        success =
+            WriteString(&temp_file, line) && WriteString(&temp_file, "\n");
+      break;
+    }
+    if (base::EndsWith(text, ",", base::CompareCase::SENSITIVE))
+      text.remove_suffix(1);
+    if (text.empty())
+      continue;
+
+    base::Optional<base::Value> event = base::JSONReader::Read(text);
+    if (!event || !event->is_dict())
+      continue;
+    base::Optional<int> type = event->FindIntKey("type");
+    base::Optional<int> source_type = event->FindIntPath("source.type");
+    if (!event_types.empty() && (!type || !event_values.count(*type)))
+      continue;
+    if (!source_types.empty() &&
+        (!source_type || !source_values.count(*source_type)))
+      continue;
+    // The kept events are separated like in the source.
+    success = (first_event || WriteString(&temp_file, ",\n")) &&
+              WriteString(&temp_file, text);
+    first_event = false;
+  }
+
+  source_file.Close();
+  temp_file.Close();
+  if (!success || !base::ReplaceFile(temp_path, dest, nullptr)) {
+    base::DeleteFile(temp_path, false);
+    return false;
+  }
+  return true;
+}
+
+// Writes the dump of the log at |log_path|, then recreates it for the logging
+// to continue in.
+base::File DumpNetLogFile(const base::FilePath& log_path,
+                          const base::FilePath& dump_path,
+                          const std::set<std::string>& event_types,
+                          const std::set<std::string>& source_types) {
+  if (!FilterNetLogFile(log_path, dump_path, event_types, source_types))
+    return base::File();
+  return OpenFileForWriting(log_path);
+}
+
 void ResolvePromiseWithNetError(gin_helper::Promise<void> promise,
                                 int32_t error) {
   if (error == net::OK) {
@@ -92,6 +274,8 @@ v8::Local<v8::Promise> NetLog::StartLogging(base::FilePath log_path,
 
   net::NetLogCaptureMode capture_mode = net::NetLogCaptureMode::kDefault;
   uint64_t max_file_size = network::mojom::NetLogExporter::kUnlimitedFileSize;
+  std::set<std::string> event_types;
+  std::set<std::string> source_types;
 
   gin_helper::Dictionary dict;
   if (args->GetNext(&dict)) {
@@ -111,6 +295,21 @@ v8::Local<v8::Promise> NetLog::StartLogging(base::FilePath log_path,
         return v8::Local<v8::Promise>();
       }
     }
+    v8::Local<v8::Value> event_types_v8;
+    if (dict.Get("eventTypes", &event_types_v8)) {
+      if (!gin::ConvertFromV8(args->isolate(), event_types_v8, &event_types)) {
+        args->ThrowError("Invalid value for eventTypes");
+        return v8::Local<v8::Promise>();
+      }
+    }
+    v8::Local<v8::Value> source_types_v8;
+    if (dict.Get("sourceTypes", &source_types_v8)) {
+      if (!gin::ConvertFromV8(args->isolate(), source_types_v8,
+                              &source_types)) {
+        args->ThrowError("Invalid value for sourceTypes");
+        return v8::Local<v8::Promise>();
+      }
+    }
   }
 
   if (net_log_exporter_) {
@@ -137,6 +336,14 @@ v8::Local<v8::Promise> NetLog::StartLogging(base::FilePath log_path,
   net_log_exporter_.set_connection_error_handler(
       base::BindOnce(&NetLog::OnConnectionError, base::Unretained(this)));
 
+  // Kept to restart the logging after a dump.
+  log_path_ = log_path;
+  capture_mode_ = capture_mode;
+  max_file_size_ = max_file_size;
+  custom_constants_ = custom_constants.Clone();
+  event_types_ = std::move(event_types);
+  source_types_ = std::move(source_types);
+
   base::PostTaskAndReplyWithResult(
       file_task_runner_.get(), FROM_HERE,
       base::BindOnce(OpenFileForWriting, log_path),
@@ -192,7 +399,9 @@ v8::Local<v8::Promise> NetLog::StopLogging(gin_helper::Arguments* args) {
   gin_helper::Promise<void> promise(isolate());
   v8::Local<v8::Promise> handle = promise.GetHandle();
 
-  if (net_log_exporter_) {
+  if (dumping_) {
+    promise.RejectWithErrorMessage("A net log dump is in progress");
+  } else if (net_log_exporter_) {
     // Move the net_log_exporter_ into the callback to ensure that the mojo
     // pointer lives long enough to resolve the promise. Moving it into the
     // callback will cause the instance variable to become empty.
@@ -200,10 +409,31 @@ v8::Local<v8::Promise> NetLog::StopLogging(gin_helper::Arguments* args) {
         base::Value(base::Value::Type::DICTIONARY),
         base::BindOnce(
             [](network::mojom::NetLogExporterPtr,
+               scoped_refptr<base::TaskRunner> file_task_runner,
+               base::FilePath log_path, std::set<std::string> event_types,
+               std::set<std::string> source_types,
                gin_helper::Promise<void> promise, int32_t error) {
-              ResolvePromiseWithNetError(std::move(promise), error);
+              if (error != net::OK ||
+                  (event_types.empty() && source_types.empty())) {
+                ResolvePromiseWithNetError(std::move(promise), error);
+                return;
+              }
+              // The events are filtered once the log is complete.
+              base::PostTaskAndReplyWithResult(
+                  file_task_runner.get(), FROM_HERE,
+                  base::BindOnce(&FilterNetLogFile, log_path, log_path,
+                                 std::move(event_types),
+                                 std::move(source_types)),
+                  base::BindOnce(
+                      [](gin_helper::Promise<void> promise, bool success) {
+                        ResolvePromiseWithNetError(
+                            std::move(promise),
+                            success ? net::OK : net::ERR_FAILED);
+                      },
+                      std::move(promise)));
             },
-            std::move(net_log_exporter_), std::move(promise)));
+            std::move(net_log_exporter_), file_task_runner_, log_path_,
+            event_types_, source_types_, std::move(promise)));
   } else {
     promise.RejectWithErrorMessage("No net log in progress");
   }
@@ -211,6 +441,69 @@ v8::Local<v8::Promise> NetLog::StopLogging(gin_helper::Arguments* args) {
   return handle;
 }
 
+v8::Local<v8::Promise> NetLog::Dump(const base::FilePath& dump_path,
+                                    gin_helper::Arguments* args) {
+  if (dump_path.empty()) {
+    args->ThrowError("The first parameter must be a valid string");
+    return v8::Local<v8::Promise>();
+  }
+
+  gin_helper::Promise<void> promise(isolate());
+  v8::Local<v8::Promise> handle = promise.GetHandle();
+  if (!net_log_exporter_ || pending_start_promise_) {
+    promise.RejectWithErrorMessage("No net log in progress");
+    return handle;
+  }
+  if (dumping_) {
+    promise.RejectWithErrorMessage("A net log dump is in progress");
+    return handle;
+  }
+
+  // The exporter only writes a complete log when it is stopped, so it is
+  // stopped for the dump and restarted right after.
+  dumping_ = true;
+  net_log_exporter_->Stop(
+      base::Value(base::Value::Type::DICTIONARY),
+      base::BindOnce(&NetLog::OnStoppedForDump, weak_ptr_factory_.GetWeakPtr(),
+                     dump_path, std::move(promise)));
+  return handle;
+}
+
+void NetLog::OnStoppedForDump(const base::FilePath& dump_path,
+                              gin_helper::Promise<void> promise,
+                              int32_t error) {
+  if (error != net::OK) {
+    dumping_ = false;
+    ResolvePromiseWithNetError(std::move(promise), error);
+    return;
+  }
+  base::PostTaskAndReplyWithResult(
+      file_task_runner_.get(), FROM_HERE,
+      base::BindOnce(&DumpNetLogFile, log_path_, dump_path, event_types_,
+                     source_types_),
+      base::BindOnce(&NetLog::OnNetLogDumped, weak_ptr_factory_.GetWeakPtr(),
+                     std::move(promise)));
+}
+
+void NetLog::OnNetLogDumped(gin_helper::Promise<void> promise,
+                            base::File log_file) {
+  dumping_ = false;
+  if (!net_log_exporter_) {
+    promise.RejectWithErrorMessage("Failed to start net log exporter");
+    return;
+  }
+  if (!log_file.IsValid()) {
+    // The logging can not go on without its file.
+    net_log_exporter_.reset();
+    promise.RejectWithErrorMessage("Failed to write the net log dump");
+    return;
+  }
+  net_log_exporter_->Start(std::move(log_file), custom_constants_.Clone(),
+                           capture_mode_, max_file_size_,
+                           base::BindOnce(&ResolvePromiseWithNetError,
+                                          std::move(promise)));
+}
+
 // static
 gin::Handle<NetLog> NetLog::Create(v8::Isolate* isolate,
                                    AtomBrowserContext* browser_context) {
@@ -224,7 +517,8 @@ void NetLog::BuildPrototype(v8::Isolate* isolate,
   gin_helper::ObjectTemplateBuilder(isolate, prototype->PrototypeTemplate())
       .SetProperty("currentlyLogging", &NetLog::IsCurrentlyLogging)
       .SetMethod("startLogging", &NetLog::StartLogging)
-      .SetMethod("stopLogging", &NetLog::StopLogging);
+      .SetMethod("stopLogging", &NetLog::StopLogging)
+      .SetMethod("dump", &NetLog::Dump);
 }
 
 }  // namespace api
@@ -7,9 +7,12 @@
 
 #include <list>
 #include <memory>
+#include <set>
 #include <string>
 
 #include "base/callback.h"
+#include "base/files/file.h"
+#include "base/files/file_path.h"
 #include "base/optional.h"
 #include "base/values.h"
 #include "gin/handle.h"
@@ -34,6 +37,9 @@ class NetLog : public gin_helper::TrackableObject<NetLog> {
   v8::Local<v8::Promise> StartLogging(base::FilePath log_path,
                                       gin_helper::Arguments* args);
   v8::Local<v8::Promise> StopLogging(gin_helper::Arguments* args);
+  // Writes what was logged so far to |dump_path| and goes on logging.
+  v8::Local<v8::Promise> Dump(const base::FilePath& dump_path,
+                              gin_helper::Arguments* args);
   bool IsCurrentlyLogging() const;
 
  protected:
@@ -47,6 +53,10 @@ class NetLog : public gin_helper::TrackableObject<NetLog> {
                                   base::Value custom_constants,
                                   base::File output_file);
   void NetLogStarted(int32_t error);
+  void OnStoppedForDump(const base::FilePath& dump_path,
+                        gin_helper::Promise<void> promise,
+                        int32_t error);
+  void OnNetLogDumped(gin_helper::Promise<void> promise, base::File log_file);
 
  private:
   AtomBrowserContext* browser_context_;
@@ -55,6 +65,17 @@ class NetLog : public gin_helper::TrackableObject<NetLog> {
 
   base::Optional<gin_helper::Promise<void>> pending_start_promise_;
 
+  // How the current log is written.
+  base::FilePath log_path_;
+  net::NetLogCaptureMode capture_mode_ = net::NetLogCaptureMode::kDefault;
+  uint64_t max_file_size_ = 0;
+  base::Value custom_constants_;
+  // The names of the event and source types the log is filtered to when it is
+  // stopped or dumped, all of them when empty.
+  std::set<std::string> event_types_;
+  std::set<std::string> source_types_;
+  bool dumping_ = false;
+
   scoped_refptr<base::TaskRunner> file_task_runner_;
 
   base::WeakPtrFactory<NetLog> weak_ptr_factory_;
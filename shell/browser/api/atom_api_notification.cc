@@ -204,8 +204,13 @@ void Notification::NotificationClosed() {
 
 void Notification::Close() {
   if (notification_) {
-    notification_->Dismiss();
-    notification_->set_delegate(nullptr);
+    if (presenter_)
+      presenter_->DismissNotification(notification_.get());
+    else
+      notification_->Dismiss();
+    // Dropping a held back notification destroys it.
+    if (notification_)
+      notification_->set_delegate(nullptr);
     notification_.reset();
   }
 }
@@ -230,7 +235,7 @@ void Notification::Show() {
       options.sound = sound_;
       options.close_button_text = close_button_text_;
       options.urgency = urgency_;
-      notification_->Show(options);
+      presenter_->ShowNotification(notification_.get(), options);
     }
   }
 }
@@ -240,6 +245,19 @@ bool Notification::IsSupported() {
                ->GetNotificationPresenter();
 }
 
+// static
+void Notification::SetMaxRate(gin_helper::ErrorThrower thrower,
+                              int max_per_minute) {
+  if (max_per_minute < 0) {
+    thrower.ThrowError("maxPerMinute must not be negative");
+    return;
+  }
+  auto* presenter = static_cast<AtomBrowserClient*>(AtomBrowserClient::Get())
+                        ->GetNotificationPresenter();
+  if (presenter)
+    presenter->SetMaxRate(max_per_minute);
+}
+
 // static
 void Notification::BuildPrototype(v8::Isolate* isolate,
                                   v8::Local<v8::FunctionTemplate> prototype) {
@@ -290,6 +308,7 @@ void Initialize(v8::Local<v8::Object> exports,
                                .ToLocalChecked());
 
   dict.SetMethod("isSupported", &Notification::IsSupported);
+  dict.SetMethod("setMaxRate", &Notification::SetMaxRate);
 }
 
 }  // namespace
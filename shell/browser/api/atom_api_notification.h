@@ -31,6 +31,7 @@ class Notification : public gin_helper::TrackableObject<Notification>,
   static gin_helper::WrappableBase* New(gin_helper::ErrorThrower thrower,
                                         gin::Arguments* args);
   static bool IsSupported();
+  static void SetMaxRate(gin_helper::ErrorThrower thrower, int max_per_minute);
 
   static void BuildPrototype(v8::Isolate* isolate,
                              v8::Local<v8::FunctionTemplate> prototype);
@@ -39,6 +39,14 @@ namespace electron {
 
 namespace api {
 
+namespace {
+
+// The system may notify the resume several times while it wakes, and
+// "resume" is emitted once the notifications stopped for this long.
+constexpr base::TimeDelta kResumeDelay = base::TimeDelta::FromMilliseconds(100);
+
+}  // namespace
+
 PowerMonitor::PowerMonitor(v8::Isolate* isolate) {
 #if defined(OS_LINUX)
   SetShutdownHandler(base::BindRepeating(&PowerMonitor::ShouldShutdown,
@@ -48,6 +56,7 @@ PowerMonitor::PowerMonitor(v8::Isolate* isolate) {
       &PowerMonitor::ShouldShutdown, base::Unretained(this)));
 #endif
   base::PowerMonitor::AddObserver(this);
+  PowerPolicy::Get()->AddObserver(this);
   Init(isolate);
 #if defined(OS_MACOSX) || defined(OS_WIN)
   InitPlatformSpecificMonitors();
@@ -56,6 +65,7 @@ PowerMonitor::PowerMonitor(v8::Isolate* isolate) {
 
 PowerMonitor::~PowerMonitor() {
   base::PowerMonitor::RemoveObserver(this);
+  PowerPolicy::Get()->RemoveObserver(this);
 }
 
 bool PowerMonitor::ShouldShutdown() {
@@ -80,13 +90,29 @@ void PowerMonitor::OnPowerStateChange(bool on_battery_power) {
 }
 
 void PowerMonitor::OnSuspend() {
+  // The resume which is waiting is emitted first, so each "suspend" is
+  // followed by a "resume".
+  if (resume_timer_.IsRunning()) {
+    resume_timer_.Stop();
+    EmitResume();
+  }
   Emit("suspend");
 }
 
 void PowerMonitor::OnResume() {
+  resume_timer_.Start(
+      FROM_HERE, kResumeDelay,
+      base::BindOnce(&PowerMonitor::EmitResume, base::Unretained(this)));
+}
+
+void PowerMonitor::EmitResume() {
   Emit("resume");
 }
 
+void PowerMonitor::OnBatterySaverChanged(bool saving) {
+  Emit("battery-saver-changed", saving);
+}
+
 ui::IdleState PowerMonitor::GetSystemIdleState(v8::Isolate* isolate,
                                                int idle_threshold) {
   if (idle_threshold > 0) {
@@ -102,6 +128,40 @@ int PowerMonitor::GetSystemIdleTime() {
   return ui::CalculateIdleTime();
 }
 
+void PowerMonitor::SetBatterySaverPolicy(v8::Isolate* isolate,
+                                         const std::string& policy) {
+  PowerPolicy::Mode mode;
+  if (policy == "off") {
+    mode = PowerPolicy::Mode::kOff;
+  } else if (policy == "on-battery") {
+    mode = PowerPolicy::Mode::kOnBattery;
+  } else if (policy == "always") {
+    mode = PowerPolicy::Mode::kAlways;
+  } else {
+    isolate->ThrowException(v8::Exception::TypeError(gin::StringToV8(
+        isolate, "Invalid battery saver policy, must be 'off', "
+                 "'on-battery' or 'always'")));
+    return;
+  }
+  PowerPolicy::Get()->SetMode(mode);
+}
+
+std::string PowerMonitor::GetBatterySaverPolicy() {
+  switch (PowerPolicy::Get()->mode()) {
+    case PowerPolicy::Mode::kOnBattery:
+      return "on-battery";
+    case PowerPolicy::Mode::kAlways:
+      return "always";
+    case PowerPolicy::Mode::kOff:
+    default:
+      return "off";
+  }
+}
+
+bool PowerMonitor::IsBatterySaverActive() {
+  return PowerPolicy::Get()->IsSaving();
+}
+
 // static
 v8::Local<v8::Value> PowerMonitor::Create(v8::Isolate* isolate) {
   if (!Browser::Get()->is_ready()) {
@@ -126,7 +186,10 @@ void PowerMonitor::BuildPrototype(v8::Isolate* isolate,
       .SetMethod("unblockShutdown", &PowerMonitor::UnblockShutdown)
 #endif
       .SetMethod("getSystemIdleState", &PowerMonitor::GetSystemIdleState)
-      .SetMethod("getSystemIdleTime", &PowerMonitor::GetSystemIdleTime);
+      .SetMethod("getSystemIdleTime", &PowerMonitor::GetSystemIdleTime)
+      .SetMethod("setBatterySaverPolicy", &PowerMonitor::SetBatterySaverPolicy)
+      .SetMethod("getBatterySaverPolicy", &PowerMonitor::GetBatterySaverPolicy)
+      .SetMethod("isBatterySaverActive", &PowerMonitor::IsBatterySaverActive);
 }
 
 }  // namespace api
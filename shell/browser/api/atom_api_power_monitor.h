@@ -5,8 +5,12 @@
 #ifndef SHELL_BROWSER_API_ATOM_API_POWER_MONITOR_H_
 #define SHELL_BROWSER_API_ATOM_API_POWER_MONITOR_H_
 
+#include <string>
+
 #include "base/compiler_specific.h"
+#include "base/timer/timer.h"
 #include "shell/browser/lib/power_observer.h"
+#include "shell/browser/power_policy.h"
 #include "shell/common/gin_helper/trackable_object.h"
 #include "ui/base/idle/idle.h"
 
@@ -15,7 +19,8 @@ namespace electron {
 namespace api {
 
 class PowerMonitor : public gin_helper::TrackableObject<PowerMonitor>,
-                     public PowerObserver {
+                     public PowerObserver,
+                     public PowerPolicy::Observer {
  public:
   static v8::Local<v8::Value> Create(v8::Isolate* isolate);
 
@@ -44,9 +49,20 @@ class PowerMonitor : public gin_helper::TrackableObject<PowerMonitor>,
   void OnSuspend() override;
   void OnResume() override;
 
+  // PowerPolicy::Observer:
+  void OnBatterySaverChanged(bool saving) override;
+
  private:
   ui::IdleState GetSystemIdleState(v8::Isolate* isolate, int idle_threshold);
   int GetSystemIdleTime();
+  void SetBatterySaverPolicy(v8::Isolate* isolate, const std::string& policy);
+  std::string GetBatterySaverPolicy();
+  bool IsBatterySaverActive();
+
+  void EmitResume();
+
+  // Coalesces the resume notifications of one wake into one "resume" event.
+  base::OneShotTimer resume_timer_;
 
 #if defined(OS_WIN)
   // Static callback invoked when a message comes in to our messaging window.
@@ -14,10 +14,12 @@
 #include "shell/browser/browser.h"
 #include "shell/common/deprecate_util.h"
 #include "shell/common/gin_converters/callback_converter.h"
+#include "shell/common/gin_converters/file_path_converter.h"
 #include "shell/common/gin_converters/net_converter.h"
 #include "shell/common/gin_helper/dictionary.h"
 #include "shell/common/gin_helper/object_template_builder.h"
 #include "shell/common/gin_helper/promise.h"
+#include "shell/common/node_includes.h"
 #include "shell/common/options_switches.h"
 #include "url/url_util.h"
 
@@ -138,6 +140,9 @@ void RegisterSchemesAsPrivileged(gin_helper::ErrorThrower thrower,
 
 namespace {
 
+// The default size of the response caches, in bytes.
+const uint32_t kDefaultResponseCacheSize = 32 * 1024 * 1024;
+
 const char* kBuiltinSchemes[] = {
     "about", "file", "http", "https", "data", "filesystem",
 };
@@ -158,6 +163,40 @@ std::string ErrorCodeToString(ProtocolError error) {
   }
 }
 
+// Reads a route of a native protocol from |value|, returning the error when
+// it is invalid.
+const char* ReadNativeProtocolRoute(v8::Isolate* isolate,
+                                    v8::Local<v8::Value> value,
+                                    NativeProtocolRoute* route) {
+  gin_helper::Dictionary dict;
+  if (!gin::ConvertFromV8(isolate, value, &dict))
+    return "Each route must be an object";
+
+  v8::Local<v8::Value> data;
+  if (dict.Get("data", &data)) {
+    std::string contents;
+    if (node::Buffer::HasInstance(data))
+      contents.assign(node::Buffer::Data(data), node::Buffer::Length(data));
+    else if (!gin::ConvertFromV8(isolate, data, &contents))
+      return "Route data must be a Buffer or a String";
+    if (!dict.Get("path", &route->path) || route->path.empty() ||
+        route->path[0] != '/')
+      return "Routes with data must have a path starting with '/'";
+    route->data = base::RefCountedString::TakeString(&contents);
+    dict.Get("mimeType", &route->mime_type);
+    return nullptr;
+  }
+
+  if (!dict.Get("directory", &route->directory) ||
+      !route->directory.IsAbsolute())
+    return "Routes must have data or an absolute directory";
+  if (!dict.Get("prefix", &route->prefix))
+    route->prefix = "/";
+  if (route->prefix.empty() || route->prefix[0] != '/')
+    return "Route prefixes must start with '/'";
+  return nullptr;
+}
+
 }  // namespace
 
 Protocol::Protocol(v8::Isolate* isolate, AtomBrowserContext* browser_context) {
@@ -170,28 +209,94 @@ Protocol::~Protocol() = default;
 void Protocol::RegisterURLLoaderFactories(
     content::ContentBrowserClient::NonNetworkURLLoaderFactoryMap* factories) {
   for (const auto& it : handlers_) {
-    factories->emplace(it.first, std::make_unique<AtomURLLoaderFactory>(
-                                     it.second.first, it.second.second));
+    auto cache = response_caches_.find(it.first);
+    factories->emplace(
+        it.first,
+        std::make_unique<AtomURLLoaderFactory>(
+            it.second.first, it.second.second,
+            cache == response_caches_.end() ? nullptr : cache->second));
+  }
+  for (const auto& it : native_handlers_) {
+    factories->emplace(it.first,
+                       std::make_unique<NativeURLLoaderFactory>(it.second));
   }
 }
 
 ProtocolError Protocol::RegisterProtocol(ProtocolType type,
                                          const std::string& scheme,
                                          const ProtocolHandler& handler) {
+  if (base::Contains(native_handlers_, scheme))
+    return ProtocolError::REGISTERED;
   const bool added = base::TryEmplace(handlers_, scheme, type, handler).second;
   return added ? ProtocolError::OK : ProtocolError::REGISTERED;
 }
 
 void Protocol::UnregisterProtocol(const std::string& scheme,
                                   gin::Arguments* args) {
-  const bool removed = handlers_.erase(scheme) != 0;
+  const bool removed =
+      handlers_.erase(scheme) != 0 || native_handlers_.erase(scheme) != 0;
   const auto error =
       removed ? ProtocolError::OK : ProtocolError::NOT_REGISTERED;
   HandleOptionalCallback(args, error);
 }
 
 bool Protocol::IsProtocolRegistered(const std::string& scheme) {
-  return base::Contains(handlers_, scheme);
+  return base::Contains(handlers_, scheme) ||
+         base::Contains(native_handlers_, scheme);
+}
+
+bool Protocol::RegisterNativeProtocol(const std::string& scheme,
+                                      v8::Local<v8::Value> routes,
+                                      gin::Arguments* args) {
+  if (!routes->IsArray()) {
+    args->ThrowTypeError("Must pass an Array of routes");
+    return false;
+  }
+
+  v8::Local<v8::Context> context = args->isolate()->GetCurrentContext();
+  v8::Local<v8::Array> array = routes.As<v8::Array>();
+  NativeProtocolRoutes native_routes(array->Length());
+  for (uint32_t i = 0; i < array->Length(); ++i) {
+    if (const char* error = ReadNativeProtocolRoute(
+            args->isolate(), array->Get(context, i).ToLocalChecked(),
+            &native_routes[i])) {
+      args->ThrowTypeError(error);
+      return false;
+    }
+  }
+
+  if (IsProtocolRegistered(scheme))
+    return false;
+  native_handlers_[scheme] = std::move(native_routes);
+  return true;
+}
+
+void Protocol::EnableResponseCache(const std::string& scheme,
+                                   gin::Arguments* args) {
+  gin_helper::Dictionary options;
+  uint32_t max_size = kDefaultResponseCacheSize;
+  if (args->GetNext(&options))
+    options.Get("maxSize", &max_size);
+  if (max_size == 0) {
+    args->ThrowTypeError("maxSize must be a positive number");
+    return;
+  }
+
+  auto& cache = response_caches_[scheme];
+  if (cache)
+    cache->SetMaxSize(max_size);
+  else
+    cache = base::MakeRefCounted<ProtocolResponseCache>(max_size);
+}
+
+void Protocol::DisableResponseCache(const std::string& scheme) {
+  auto iter = response_caches_.find(scheme);
+  if (iter == response_caches_.end())
+    return;
+  // The factories of existing pages keep referencing the cache until they are
+  // recreated, so it has to stop storing responses right away.
+  iter->second->SetMaxSize(0);
+  response_caches_.erase(iter);
 }
 
 ProtocolError Protocol::InterceptProtocol(ProtocolType type,
@@ -276,7 +381,10 @@ void Protocol::BuildPrototype(v8::Isolate* isolate,
                  &Protocol::RegisterProtocolFor<ProtocolType::kStream>)
       .SetMethod("registerProtocol",
                  &Protocol::RegisterProtocolFor<ProtocolType::kFree>)
+      .SetMethod("registerNativeProtocol", &Protocol::RegisterNativeProtocol)
       .SetMethod("unregisterProtocol", &Protocol::UnregisterProtocol)
+      .SetMethod("enableResponseCache", &Protocol::EnableResponseCache)
+      .SetMethod("disableResponseCache", &Protocol::DisableResponseCache)
       .SetMethod("isProtocolRegistered", &Protocol::IsProtocolRegistered)
       .SetMethod("isProtocolHandled", &Protocol::IsProtocolHandled)
       .SetMethod("interceptStringProtocol",
@@ -5,12 +5,14 @@
 #ifndef SHELL_BROWSER_API_ATOM_API_PROTOCOL_H_
 #define SHELL_BROWSER_API_ATOM_API_PROTOCOL_H_
 
+#include <map>
 #include <string>
 #include <vector>
 
 #include "content/public/browser/content_browser_client.h"
 #include "gin/handle.h"
 #include "shell/browser/net/atom_url_loader_factory.h"
+#include "shell/browser/net/native_url_loader_factory.h"
 #include "shell/common/gin_helper/dictionary.h"
 #include "shell/common/gin_helper/trackable_object.h"
 
@@ -64,6 +66,16 @@ class Protocol : public gin_helper::TrackableObject<Protocol> {
   void UnregisterProtocol(const std::string& scheme, gin::Arguments* args);
   bool IsProtocolRegistered(const std::string& scheme);
 
+  // Registers |scheme| to be served from a table of routes, without calling
+  // into JavaScript for each request.
+  bool RegisterNativeProtocol(const std::string& scheme,
+                              v8::Local<v8::Value> routes,
+                              gin::Arguments* args);
+
+  // Stores the buffer and string responses of |scheme| in memory.
+  void EnableResponseCache(const std::string& scheme, gin::Arguments* args);
+  void DisableResponseCache(const std::string& scheme);
+
   ProtocolError InterceptProtocol(ProtocolType type,
                                   const std::string& scheme,
                                   const ProtocolHandler& handler);
@@ -93,6 +105,9 @@ class Protocol : public gin_helper::TrackableObject<Protocol> {
 
   HandlersMap handlers_;
   HandlersMap intercept_handlers_;
+  std::map<std::string, NativeProtocolRoutes> native_handlers_;
+  // scheme => cache of the responses, shared by the factories of all pages.
+  std::map<std::string, scoped_refptr<ProtocolResponseCache>> response_caches_;
 };
 
 }  // namespace api
@@ -14,6 +14,7 @@
 #include "shell/common/gin_converters/callback_converter.h"
 #include "shell/common/gin_converters/gfx_converter.h"
 #include "shell/common/gin_converters/native_window_converter.h"
+#include "shell/common/gin_helper/dictionary.h"
 #include "shell/common/gin_helper/object_template_builder.h"
 #include "shell/common/node_includes.h"
 #include "ui/display/display.h"
@@ -53,18 +54,36 @@ std::vector<std::string> MetricsToArray(uint32_t metrics) {
   return array;
 }
 
+// Freezes |value| and the objects it holds, so that it can be shared by all
+// the callers.
+void DeepFreeze(v8::Local<v8::Context> context, v8::Local<v8::Value> value) {
+  if (!value->IsObject())
+    return;
+  v8::Local<v8::Object> object = value.As<v8::Object>();
+  v8::Local<v8::Array> names;
+  if (object->GetOwnPropertyNames(context).ToLocal(&names)) {
+    for (uint32_t i = 0; i < names->Length(); ++i) {
+      v8::Local<v8::Value> name;
+      v8::Local<v8::Value> property;
+      if (names->Get(context, i).ToLocal(&name) &&
+          object->Get(context, name).ToLocal(&property))
+        DeepFreeze(context, property);
+    }
+  }
+  object->SetIntegrityLevel(context, v8::IntegrityLevel::kFrozen)
+      .FromMaybe(false);
+}
+
 void DelayEmit(Screen* screen,
                base::StringPiece name,
                const display::Display& display) {
   screen->Emit(name, display);
 }
 
-void DelayEmitWithMetrics(Screen* screen,
-                          base::StringPiece name,
-                          const display::Display& display,
-                          const std::vector<std::string>& metrics) {
-  screen->Emit(name, display, metrics);
-}
+// The displays change several times while they sleep or wake, and the
+// changes of a display are emitted once they stopped for this long.
+constexpr base::TimeDelta kMetricsChangesDelay =
+    base::TimeDelta::FromMilliseconds(100);
 
 }  // namespace
 
@@ -98,6 +117,32 @@ display::Display Screen::GetDisplayMatching(const gfx::Rect& match_rect) {
   return screen_->GetDisplayMatching(match_rect);
 }
 
+v8::Local<v8::Value> Screen::GetDisplaysSnapshot(v8::Isolate* isolate) {
+  if (displays_snapshot_.IsEmpty()) {
+    gin_helper::Dictionary snapshot = gin::Dictionary::CreateEmpty(isolate);
+    snapshot.Set("version", displays_version_);
+    snapshot.Set("displays", screen_->GetAllDisplays());
+    DeepFreeze(isolate->GetCurrentContext(), snapshot.GetHandle());
+    displays_snapshot_.Reset(isolate, snapshot.GetHandle());
+  }
+  return displays_snapshot_.Get(isolate);
+}
+
+v8::Local<v8::Value> Screen::SampleCursor(v8::Isolate* isolate) {
+  gfx::Point point = screen_->GetCursorScreenPoint();
+  gin_helper::Dictionary sample = gin::Dictionary::CreateEmpty(isolate);
+  sample.Set("x", point.x());
+  sample.Set("y", point.y());
+  sample.Set("displayId", screen_->GetDisplayNearestPoint(point).id());
+  sample.Set("displaysVersion", displays_version_);
+  return sample.GetHandle();
+}
+
+void Screen::InvalidateDisplaysSnapshot() {
+  displays_snapshot_.Reset();
+  ++displays_version_;
+}
+
 #if defined(OS_WIN)
 
 static gfx::Rect ScreenToDIPRect(electron::NativeWindow* window,
@@ -115,12 +160,16 @@ static gfx::Rect DIPToScreenRect(electron::NativeWindow* window,
 #endif
 
 void Screen::OnDisplayAdded(const display::Display& new_display) {
+  InvalidateDisplaysSnapshot();
+  PostFlushDisplayMetricsChanges();
   base::ThreadTaskRunnerHandle::Get()->PostNonNestableTask(
       FROM_HERE, base::Bind(&DelayEmit, base::Unretained(this), "display-added",
                             new_display));
 }
 
 void Screen::OnDisplayRemoved(const display::Display& old_display) {
+  InvalidateDisplaysSnapshot();
+  PostFlushDisplayMetricsChanges();
   base::ThreadTaskRunnerHandle::Get()->PostNonNestableTask(
       FROM_HERE, base::Bind(&DelayEmit, base::Unretained(this),
                             "display-removed", old_display));
@@ -128,10 +177,33 @@ void Screen::OnDisplayRemoved(const display::Display& old_display) {
 
 void Screen::OnDisplayMetricsChanged(const display::Display& display,
                                      uint32_t changed_metrics) {
+  InvalidateDisplaysSnapshot();
+  auto& change = pending_metrics_changes_[display.id()];
+  change.first = display;
+  change.second |= changed_metrics;
+  metrics_changes_timer_.Start(
+      FROM_HERE, kMetricsChangesDelay,
+      base::BindOnce(&Screen::PostFlushDisplayMetricsChanges,
+                     base::Unretained(this)));
+}
+
+void Screen::PostFlushDisplayMetricsChanges() {
+  metrics_changes_timer_.Stop();
+  if (pending_metrics_changes_.empty())
+    return;
+  // Posted like the other events, so they keep their order.
   base::ThreadTaskRunnerHandle::Get()->PostNonNestableTask(
-      FROM_HERE, base::Bind(&DelayEmitWithMetrics, base::Unretained(this),
-                            "display-metrics-changed", display,
-                            MetricsToArray(changed_metrics)));
+      FROM_HERE, base::BindOnce(&Screen::FlushDisplayMetricsChanges,
+                                base::Unretained(this)));
+}
+
+void Screen::FlushDisplayMetricsChanges() {
+  auto changes = std::move(pending_metrics_changes_);
+  pending_metrics_changes_.clear();
+  for (const auto& change : changes) {
+    Emit("display-metrics-changed", change.second.first,
+         MetricsToArray(change.second.second));
+  }
 }
 
 // static
@@ -162,6 +234,8 @@ void Screen::BuildPrototype(v8::Isolate* isolate,
       .SetMethod("getPrimaryDisplay", &Screen::GetPrimaryDisplay)
       .SetMethod("getAllDisplays", &Screen::GetAllDisplays)
       .SetMethod("getDisplayNearestPoint", &Screen::GetDisplayNearestPoint)
+      .SetMethod("getDisplaysSnapshot", &Screen::GetDisplaysSnapshot)
+      .SetMethod("sampleCursor", &Screen::SampleCursor)
 #if defined(OS_WIN)
       .SetMethod("screenToDipPoint", &display::win::ScreenWin::ScreenToDIPPoint)
       .SetMethod("dipToScreenPoint", &display::win::ScreenWin::DIPToScreenPoint)
@@ -5,8 +5,11 @@
 #ifndef SHELL_BROWSER_API_ATOM_API_SCREEN_H_
 #define SHELL_BROWSER_API_ATOM_API_SCREEN_H_
 
+#include <map>
+#include <utility>
 #include <vector>
 
+#include "base/timer/timer.h"
 #include "shell/common/gin_helper/error_thrower.h"
 #include "shell/common/gin_helper/event_emitter.h"
 #include "ui/display/display_observer.h"
@@ -39,6 +42,8 @@ class Screen : public gin_helper::EventEmitter<Screen>,
   std::vector<display::Display> GetAllDisplays();
   display::Display GetDisplayNearestPoint(const gfx::Point& point);
   display::Display GetDisplayMatching(const gfx::Rect& match_rect);
+  v8::Local<v8::Value> GetDisplaysSnapshot(v8::Isolate* isolate);
+  v8::Local<v8::Value> SampleCursor(v8::Isolate* isolate);
 
   // display::DisplayObserver:
   void OnDisplayAdded(const display::Display& new_display) override;
@@ -47,8 +52,26 @@ class Screen : public gin_helper::EventEmitter<Screen>,
                                uint32_t changed_metrics) override;
 
  private:
+  // Drops the snapshot of the displays, once they changed.
+  void InvalidateDisplaysSnapshot();
+
+  // Emits "display-metrics-changed" for the changes coalesced so far.
+  void FlushDisplayMetricsChanges();
+  void PostFlushDisplayMetricsChanges();
+
   display::Screen* screen_;
 
+  // The frozen snapshot handed out until the displays change, and how many
+  // times they changed.
+  v8::Global<v8::Value> displays_snapshot_;
+  uint32_t displays_version_ = 0;
+
+  // The last state of each display whose metrics changed during the current
+  // burst of changes, with all the metrics which changed.
+  std::map<int64_t, std::pair<display::Display, uint32_t>>
+      pending_metrics_changes_;
+  base::OneShotTimer metrics_changes_timer_;
+
   DISALLOW_COPY_AND_ASSIGN(Screen);
 };
 
@@ -40,6 +40,7 @@
 #include "net/http/http_cache.h"
 #include "services/network/network_service.h"
 #include "services/network/public/cpp/features.h"
+#include "services/network/public/mojom/cors_origin_pattern.mojom.h"
 #include "shell/browser/api/atom_api_cookies.h"
 #include "shell/browser/api/atom_api_data_pipe_holder.h"
 #include "shell/browser/api/atom_api_download_item.h"
@@ -50,9 +51,12 @@
 #include "shell/browser/atom_browser_main_parts.h"
 #include "shell/browser/atom_permission_manager.h"
 #include "shell/browser/browser.h"
+#include "shell/browser/coalescing_pref_store.h"
 #include "shell/browser/media/media_device_id_salt.h"
 #include "shell/browser/net/cert_verifier_client.h"
+#include "shell/browser/net/preconnect_predictor.h"
 #include "shell/browser/session_preferences.h"
+#include "shell/browser/zoom_level_delegate.h"
 #include "shell/common/gin_converters/callback_converter.h"
 #include "shell/common/gin_converters/content_converter.h"
 #include "shell/common/gin_converters/file_path_converter.h"
@@ -106,12 +110,82 @@ PreconnectRequest::PreconnectRequest(
 
 namespace {
 
+// The size of the HTTP cache, and how many requests it served.
+struct HttpCacheStats {
+  int64_t size = 0;
+  uint64_t hits = 0;
+  uint64_t misses = 0;
+};
+
 struct ClearStorageDataOptions {
   GURL origin;
   uint32_t storage_types = StoragePartition::REMOVE_DATA_MASK_ALL;
   uint32_t quota_types = StoragePartition::QUOTA_MANAGED_STORAGE_MASK_ALL;
 };
 
+// Reads a pattern of a CORS access list, which is
+// {protocol, domain, port?, allowSubdomains?}.
+bool ReadCorsOriginPattern(v8::Isolate* isolate,
+                           v8::Local<v8::Value> value,
+                           network::mojom::CorsOriginPatternPtr* out) {
+  gin::Dictionary dict(isolate);
+  std::string protocol, domain;
+  if (!gin::ConvertFromV8(isolate, value, &dict) ||
+      !dict.Get("protocol", &protocol) || !dict.Get("domain", &domain))
+    return false;
+  int port = 0;
+  bool has_port = dict.Get("port", &port);
+  if (has_port && (port <= 0 || port > 65535))
+    return false;
+  bool allow_subdomains = false;
+  dict.Get("allowSubdomains", &allow_subdomains);
+  *out = network::mojom::CorsOriginPattern::New(
+      protocol, domain, has_port ? port : 0,
+      allow_subdomains
+          ? network::mojom::CorsDomainMatchMode::kAllowSubdomains
+          : network::mojom::CorsDomainMatchMode::kDisallowSubdomains,
+      has_port ? network::mojom::CorsPortMatchMode::kAllowOnlySpecifiedPort
+               : network::mojom::CorsPortMatchMode::kAllowAnyPort,
+      network::mojom::CorsOriginAccessMatchPriority::kDefaultPriority);
+  return true;
+}
+
+bool ReadCorsOriginPatterns(
+    v8::Isolate* isolate,
+    const gin::Dictionary& entry,
+    const char* key,
+    std::vector<network::mojom::CorsOriginPatternPtr>* out) {
+  std::vector<v8::Local<v8::Value>> values;
+  if (!entry.Get(key, &values))
+    return true;
+  for (auto value : values) {
+    network::mojom::CorsOriginPatternPtr pattern;
+    if (!ReadCorsOriginPattern(isolate, value, &pattern))
+      return false;
+    out->push_back(std::move(pattern));
+  }
+  return true;
+}
+
+// Reads an entry of session.setCorsOriginAccessLists, which is
+// {origin, allowList?, blockList?}.
+bool ReadCorsOriginAccessList(
+    v8::Isolate* isolate,
+    v8::Local<v8::Value> value,
+    network::mojom::CorsOriginAccessPatternsPtr* out) {
+  gin::Dictionary entry(isolate);
+  GURL origin;
+  if (!gin::ConvertFromV8(isolate, value, &entry) ||
+      !entry.Get("origin", &origin) || !origin.is_valid())
+    return false;
+  *out = network::mojom::CorsOriginAccessPatterns::New();
+  (*out)->source_origin = url::Origin::Create(origin);
+  return ReadCorsOriginPatterns(isolate, entry, "allowList",
+                                &(*out)->allow_patterns) &&
+         ReadCorsOriginPatterns(isolate, entry, "blockList",
+                                &(*out)->block_patterns);
+}
+
 uint32_t GetStorageMask(const std::vector<std::string>& storage_types) {
   uint32_t storage_mask = 0;
   for (const auto& it : storage_types) {
@@ -174,6 +248,84 @@ struct Converter<ClearStorageDataOptions> {
   }
 };
 
+template <>
+struct Converter<electron::AtomBrowserContext::Options> {
+  static bool FromV8(v8::Isolate* isolate,
+                     v8::Local<v8::Value> val,
+                     electron::AtomBrowserContext::Options* out) {
+    gin_helper::Dictionary options;
+    if (!ConvertFromV8(isolate, val, &options))
+      return false;
+    bool cache;
+    if (options.Get("cache", &cache))
+      out->cache = cache;
+    options.Get("lightweight", &out->lightweight);
+    std::string cache_type;
+    if (options.Get("cacheType", &cache_type)) {
+      using CacheType = electron::AtomBrowserContext::Options::CacheType;
+      if (cache_type == "disk")
+        out->cache_type = CacheType::kDisk;
+      else if (cache_type == "memory")
+        out->cache_type = CacheType::kMemory;
+      else if (cache_type == "none")
+        out->cache_type = CacheType::kNone;
+    }
+    int cache_max_size;
+    if (options.Get("cacheMaxSize", &cache_max_size) && cache_max_size >= 0)
+      out->cache_max_size = cache_max_size;
+    return true;
+  }
+};
+
+template <>
+struct Converter<HttpCacheStats> {
+  static v8::Local<v8::Value> ToV8(v8::Isolate* isolate,
+                                   const HttpCacheStats& stats) {
+    gin::Dictionary dict = gin::Dictionary::CreateEmpty(isolate);
+    dict.Set("size", static_cast<double>(stats.size));
+    dict.Set("hits", static_cast<double>(stats.hits));
+    dict.Set("misses", static_cast<double>(stats.misses));
+    return ConvertToV8(isolate, dict);
+  }
+};
+
+template <>
+struct Converter<electron::PreconnectPredictor::Stats> {
+  static v8::Local<v8::Value> ToV8(
+      v8::Isolate* isolate,
+      const electron::PreconnectPredictor::Stats& stats) {
+    gin::Dictionary dict = gin::Dictionary::CreateEmpty(isolate);
+    dict.Set("preconnects", static_cast<double>(stats.preconnects));
+    dict.Set("hits", static_cast<double>(stats.hits));
+    dict.Set("misses", static_cast<double>(stats.misses));
+    dict.Set("hosts", static_cast<double>(stats.hosts));
+    return ConvertToV8(isolate, dict);
+  }
+};
+
+template <>
+struct Converter<electron::AtomPermissionManager::CheckResult> {
+  static bool FromV8(v8::Isolate* isolate,
+                     v8::Local<v8::Value> val,
+                     electron::AtomPermissionManager::CheckResult* out) {
+    if (!val->IsObject()) {
+      out->granted = val->BooleanValue(isolate);
+      return true;
+    }
+    gin_helper::Dictionary result;
+    if (!ConvertFromV8(isolate, val, &result))
+      return false;
+    result.Get("granted", &out->granted);
+    result.Get("cache", &out->cache);
+    double ttl;
+    if (result.Get("cacheTTL", &ttl) && ttl >= 0) {
+      out->cache = true;
+      out->cache_ttl = base::TimeDelta::FromMillisecondsD(ttl);
+    }
+    return true;
+  }
+};
+
 }  // namespace gin
 
 namespace electron {
@@ -288,6 +440,41 @@ v8::Local<v8::Promise> Session::ResolveProxy(gin_helper::Arguments* args) {
   return handle;
 }
 
+v8::Local<v8::Promise> Session::GetCacheStats(v8::Isolate* isolate) {
+  gin_helper::Promise<HttpCacheStats> promise(isolate);
+  auto handle = promise.GetHandle();
+
+  // The requests are only counted while the webRequest metrics are enabled.
+  HttpCacheStats stats;
+  auto web_request = WebRequest::From(isolate, browser_context());
+  if (!web_request.IsEmpty()) {
+    for (const auto& it : web_request->metrics().classes()) {
+      stats.hits += it.second.cache_hits;
+      stats.misses += it.second.requests - it.second.cache_hits;
+    }
+  }
+
+  content::BrowserContext::GetDefaultStoragePartition(browser_context_.get())
+      ->GetNetworkContext()
+      ->ComputeHttpCacheSize(
+          base::Time(), base::Time::Max(),
+          base::BindOnce(
+              [](gin_helper::Promise<HttpCacheStats> promise,
+                 HttpCacheStats stats, bool is_upper_bound,
+                 int64_t size_or_error) {
+                if (size_or_error < 0) {
+                  promise.RejectWithErrorMessage(
+                      net::ErrorToString(size_or_error));
+                } else {
+                  stats.size = size_or_error;
+                  promise.Resolve(stats);
+                }
+              },
+              std::move(promise), stats));
+
+  return handle;
+}
+
 v8::Local<v8::Promise> Session::GetCacheSize() {
   auto* isolate = v8::Isolate::GetCurrent();
   gin_helper::Promise<int64_t> promise(isolate);
@@ -356,6 +543,34 @@ void Session::FlushStorageData() {
   storage_partition->Flush();
 }
 
+void Session::SetPreferencesCommitInterval(gin_helper::ErrorThrower thrower,
+                                           int interval) {
+  if (interval < 0) {
+    thrower.ThrowError("interval must be a non-negative integer");
+    return;
+  }
+  auto* pref_store = browser_context_->coalescing_pref_store();
+  if (pref_store)
+    pref_store->SetCommitInterval(base::TimeDelta::FromMilliseconds(interval));
+}
+
+v8::Local<v8::Promise> Session::FlushPreferences(v8::Isolate* isolate) {
+  gin_helper::Promise<void> promise(isolate);
+  v8::Local<v8::Promise> handle = promise.GetHandle();
+  // The zoom levels changed lately are not in the preferences yet.
+  content::BrowserContext::ForEachStoragePartition(
+      browser_context_.get(),
+      base::BindRepeating([](content::StoragePartition* partition) {
+        auto* delegate =
+            static_cast<ZoomLevelDelegate*>(partition->GetZoomLevelDelegate());
+        if (delegate)
+          delegate->CommitPendingZoomLevels();
+      }));
+  browser_context_->prefs()->CommitPendingWrite(base::BindOnce(
+      gin_helper::Promise<void>::ResolvePromise, std::move(promise)));
+  return handle;
+}
+
 v8::Local<v8::Promise> Session::SetProxy(gin_helper::Arguments* args) {
   v8::Isolate* isolate = args->isolate();
   gin_helper::Promise<void> promise(isolate);
@@ -389,6 +604,8 @@ v8::Local<v8::Promise> Session::SetProxy(gin_helper::Arguments* args) {
             proxy_rules, bypass_list)),
         WriteablePrefStore::DEFAULT_PREF_WRITE_FLAGS);
   }
+  // The results of resolveProxy for the old settings must not be reused.
+  browser_context_->GetResolveProxyHelper()->ClearCache();
 
   base::ThreadTaskRunnerHandle::Get()->PostTask(
       FROM_HERE, base::BindOnce(gin_helper::Promise<void>::ResolvePromise,
@@ -490,6 +707,14 @@ void Session::SetPermissionCheckHandler(v8::Local<v8::Value> val,
   permission_manager->SetPermissionCheckHandler(handler);
 }
 
+void Session::ClearPermissionCheckCache(gin_helper::Arguments* args) {
+  GURL origin;
+  args->GetNext(&origin);
+  auto* permission_manager = static_cast<AtomPermissionManager*>(
+      browser_context()->GetPermissionControllerDelegate());
+  permission_manager->ClearPermissionCheckCache(origin);
+}
+
 v8::Local<v8::Promise> Session::ClearHostResolverCache(
     gin_helper::Arguments* args) {
   v8::Isolate* isolate = args->isolate();
@@ -531,6 +756,32 @@ void Session::AllowNTLMCredentialsForDomains(const std::string& domains) {
       std::move(auth_dynamic_params));
 }
 
+v8::Local<v8::Promise> Session::SetCorsOriginAccessLists(
+    const std::vector<v8::Local<v8::Value>>& entries) {
+  auto* isolate = v8::Isolate::GetCurrent();
+  gin_helper::Promise<void> promise(isolate);
+  v8::Local<v8::Promise> handle = promise.GetHandle();
+
+  std::vector<network::mojom::CorsOriginAccessPatternsPtr> lists;
+  lists.reserve(entries.size());
+  for (auto entry : entries) {
+    network::mojom::CorsOriginAccessPatternsPtr list;
+    if (!ReadCorsOriginAccessList(isolate, entry, &list)) {
+      promise.RejectWithErrorMessage(
+          "Each entry must have a valid 'origin', and each pattern a "
+          "'protocol', a 'domain' and an optional valid 'port'");
+      return handle;
+    }
+    lists.push_back(std::move(list));
+  }
+
+  browser_context_->SetCorsOriginAccessLists(
+      std::move(lists),
+      base::BindOnce(gin_helper::Promise<void>::ResolvePromise,
+                     std::move(promise)));
+  return handle;
+}
+
 void Session::SetUserAgent(const std::string& user_agent,
                            gin_helper::Arguments* args) {
   browser_context_->SetUserAgent(user_agent);
@@ -555,6 +806,23 @@ v8::Local<v8::Promise> Session::GetBlobData(v8::Isolate* isolate,
   return holder->ReadAll(isolate);
 }
 
+v8::Local<v8::Value> Session::CreateBlobReader(const std::string& uuid,
+                                               uint64_t offset,
+                                               gin_helper::Arguments* args) {
+  gin::Handle<DataPipeHolder> holder =
+      DataPipeHolder::From(args->isolate(), uuid);
+  if (holder.IsEmpty()) {
+    args->ThrowError("Could not get blob data handle");
+    return v8::Undefined(args->isolate());
+  }
+
+  base::Optional<uint64_t> length;
+  uint64_t value;
+  if (args->GetNext(&value))
+    length = value;
+  return holder->CreateReader(args->isolate(), offset, length);
+}
+
 void Session::DownloadURL(const GURL& url) {
   auto* download_manager =
       content::BrowserContext::GetDownloadManager(browser_context());
@@ -607,6 +875,14 @@ std::vector<base::FilePath::StringType> Session::GetPreloads() const {
   return prefs->preloads();
 }
 
+base::FilePath Session::GetPreloadCodeCachePath() {
+  // In-memory sessions keep their code caches in memory only.
+  if (browser_context()->IsOffTheRecord())
+    return base::FilePath();
+  return browser_context()->GetPath().Append(
+      FILE_PATH_LITERAL("Preload Code Cache"));
+}
+
 #if BUILDFLAG(ENABLE_ELECTRON_EXTENSIONS)
 v8::Local<v8::Promise> Session::LoadExtension(
     const base::FilePath& extension_path) {
@@ -628,6 +904,33 @@ v8::Local<v8::Promise> Session::LoadExtension(
   return handle;
 }
 
+v8::Local<v8::Promise> Session::LoadExtensions(
+    const std::vector<base::FilePath>& extension_paths) {
+  gin_helper::Promise<std::vector<v8::Local<v8::Value>>> promise(isolate());
+  v8::Local<v8::Promise> handle = promise.GetHandle();
+
+  auto* extension_system = static_cast<extensions::AtomExtensionSystem*>(
+      extensions::ExtensionSystem::Get(browser_context()));
+  extension_system->LoadExtensions(
+      extension_paths,
+      base::BindOnce(
+          [](gin_helper::Promise<std::vector<v8::Local<v8::Value>>> promise,
+             const std::vector<const extensions::Extension*>& extensions) {
+            v8::Isolate* isolate = promise.isolate();
+            v8::HandleScope handle_scope(isolate);
+            v8::Context::Scope context_scope(promise.GetContext());
+            std::vector<v8::Local<v8::Value>> result;
+            for (const auto* extension : extensions) {
+              result.push_back(extension ? gin::ConvertToV8(isolate, extension)
+                                         : v8::Null(isolate));
+            }
+            promise.Resolve(result);
+          },
+          std::move(promise)));
+
+  return handle;
+}
+
 void Session::RemoveExtension(const std::string& extension_id) {
   auto* extension_system = static_cast<extensions::AtomExtensionSystem*>(
       extensions::ExtensionSystem::Get(browser_context()));
@@ -645,6 +948,18 @@ v8::Local<v8::Value> Session::GetExtension(const std::string& extension_id) {
   }
 }
 
+v8::Local<v8::Value> Session::GetExtensionMessageMetrics(
+    const std::string& extension_id) {
+  auto* extension_system = static_cast<extensions::AtomExtensionSystem*>(
+      extensions::ExtensionSystem::Get(browser_context()));
+  auto metrics = extension_system->GetMessageMetrics(extension_id);
+  gin_helper::Dictionary dict = gin::Dictionary::CreateEmpty(isolate());
+  dict.Set("messageCount", static_cast<double>(metrics.message_count));
+  dict.Set("byteCount", static_cast<double>(metrics.byte_count));
+  dict.Set("messagesPerSecond", metrics.messages_per_second);
+  return dict.GetHandle();
+}
+
 v8::Local<v8::Value> Session::GetAllExtensions() {
   auto* registry = extensions::ExtensionRegistry::Get(browser_context());
   auto installed_extensions = registry->GenerateInstalledExtensionsSet();
@@ -721,6 +1036,29 @@ void Session::Preconnect(const gin_helper::Dictionary& options,
                      url, num_sockets_to_preconnect));
 }
 
+void Session::SetRendererProcessPolicy(const gin_helper::Dictionary& policy) {
+  bool share = false;
+  if (policy.Get("shareProcesses", &share))
+    browser_context_->set_share_renderer_processes(share);
+}
+
+void Session::SetPreconnectPredictorEnabled(bool enabled) {
+  browser_context_->SetPreconnectPredictorEnabled(enabled);
+}
+
+v8::Local<v8::Value> Session::GetPreconnectPredictorStats(
+    v8::Isolate* isolate) {
+  auto* predictor = browser_context_->preconnect_predictor();
+  if (!predictor)
+    return v8::Null(isolate);
+  return gin::ConvertToV8(isolate, predictor->stats());
+}
+
+void Session::ClearPreconnectPredictor() {
+  if (browser_context_->preconnect_predictor())
+    browser_context_->preconnect_predictor()->Clear();
+}
+
 #if BUILDFLAG(ENABLE_BUILTIN_SPELLCHECKER)
 base::Value Session::GetSpellCheckerLanguages() {
   return browser_context_->prefs()
@@ -790,19 +1128,19 @@ gin::Handle<Session> Session::CreateFrom(v8::Isolate* isolate,
 }
 
 // static
-gin::Handle<Session> Session::FromPartition(v8::Isolate* isolate,
-                                            const std::string& partition,
-                                            base::DictionaryValue options) {
+gin::Handle<Session> Session::FromPartition(
+    v8::Isolate* isolate,
+    const std::string& partition,
+    const AtomBrowserContext::Options& options) {
   scoped_refptr<AtomBrowserContext> browser_context;
   if (partition.empty()) {
-    browser_context = AtomBrowserContext::From("", false, std::move(options));
+    browser_context = AtomBrowserContext::From("", false, options);
   } else if (base::StartsWith(partition, kPersistPrefix,
                               base::CompareCase::SENSITIVE)) {
     std::string name = partition.substr(8);
-    browser_context = AtomBrowserContext::From(name, false, std::move(options));
+    browser_context = AtomBrowserContext::From(name, false, options);
   } else {
-    browser_context =
-        AtomBrowserContext::From(partition, true, std::move(options));
+    browser_context = AtomBrowserContext::From(partition, true, options);
   }
   return CreateFrom(isolate, browser_context.get());
 }
@@ -815,9 +1153,13 @@ void Session::BuildPrototype(v8::Isolate* isolate,
   gin_helper::ObjectTemplateBuilder(isolate, prototype->PrototypeTemplate())
       .SetMethod("resolveProxy", &Session::ResolveProxy)
       .SetMethod("getCacheSize", &Session::GetCacheSize)
+      .SetMethod("getCacheStats", &Session::GetCacheStats)
       .SetMethod("clearCache", &Session::ClearCache)
       .SetMethod("clearStorageData", &Session::ClearStorageData)
       .SetMethod("flushStorageData", &Session::FlushStorageData)
+      .SetMethod("setPreferencesCommitInterval",
+                 &Session::SetPreferencesCommitInterval)
+      .SetMethod("flushPreferences", &Session::FlushPreferences)
       .SetMethod("setProxy", &Session::SetProxy)
       .SetMethod("setDownloadPath", &Session::SetDownloadPath)
       .SetMethod("enableNetworkEmulation", &Session::EnableNetworkEmulation)
@@ -827,23 +1169,32 @@ void Session::BuildPrototype(v8::Isolate* isolate,
                  &Session::SetPermissionRequestHandler)
       .SetMethod("setPermissionCheckHandler",
                  &Session::SetPermissionCheckHandler)
+      .SetMethod("clearPermissionCheckCache",
+                 &Session::ClearPermissionCheckCache)
       .SetMethod("clearHostResolverCache", &Session::ClearHostResolverCache)
       .SetMethod("clearAuthCache", &Session::ClearAuthCache)
       .SetMethod("allowNTLMCredentialsForDomains",
                  &Session::AllowNTLMCredentialsForDomains)
+      .SetMethod("setCorsOriginAccessLists",
+                 &Session::SetCorsOriginAccessLists)
       .SetMethod("setUserAgent", &Session::SetUserAgent)
       .SetMethod("getUserAgent", &Session::GetUserAgent)
       .SetMethod("getBlobData", &Session::GetBlobData)
+      .SetMethod("_createBlobReader", &Session::CreateBlobReader)
       .SetMethod("downloadURL", &Session::DownloadURL)
       .SetMethod("createInterruptedDownload",
                  &Session::CreateInterruptedDownload)
       .SetMethod("setPreloads", &Session::SetPreloads)
       .SetMethod("getPreloads", &Session::GetPreloads)
+      .SetMethod("_getPreloadCodeCachePath", &Session::GetPreloadCodeCachePath)
 #if BUILDFLAG(ENABLE_ELECTRON_EXTENSIONS)
       .SetMethod("loadExtension", &Session::LoadExtension)
+      .SetMethod("loadExtensions", &Session::LoadExtensions)
       .SetMethod("removeExtension", &Session::RemoveExtension)
       .SetMethod("getExtension", &Session::GetExtension)
       .SetMethod("getAllExtensions", &Session::GetAllExtensions)
+      .SetMethod("getExtensionMessageMetrics",
+                 &Session::GetExtensionMessageMetrics)
 #endif
 #if BUILDFLAG(ENABLE_BUILTIN_SPELLCHECKER)
       .SetMethod("getSpellCheckerLanguages", &Session::GetSpellCheckerLanguages)
@@ -856,6 +1207,14 @@ void Session::BuildPrototype(v8::Isolate* isolate,
                  &Session::AddWordToSpellCheckerDictionary)
 #endif
       .SetMethod("preconnect", &Session::Preconnect)
+      .SetMethod("setRendererProcessPolicy",
+                 &Session::SetRendererProcessPolicy)
+      .SetMethod("setPreconnectPredictorEnabled",
+                 &Session::SetPreconnectPredictorEnabled)
+      .SetMethod("getPreconnectPredictorStats",
+                 &Session::GetPreconnectPredictorStats)
+      .SetMethod("clearPreconnectPredictor",
+                 &Session::ClearPreconnectPredictor)
       .SetProperty("cookies", &Session::Cookies)
       .SetProperty("netLog", &Session::NetLog)
       .SetProperty("protocol", &Session::Protocol)
@@ -879,10 +1238,9 @@ v8::Local<v8::Value> FromPartition(const std::string& partition,
     args->ThrowError("Session can only be received when app is ready");
     return v8::Null(args->isolate());
   }
-  base::DictionaryValue options;
+  AtomBrowserContext::Options options;
   args->GetNext(&options);
-  return Session::FromPartition(args->isolate(), partition, std::move(options))
-      .ToV8();
+  return Session::FromPartition(args->isolate(), partition, options).ToV8();
 }
 
 void Initialize(v8::Local<v8::Object> exports,
@@ -12,7 +12,9 @@
 #include "content/public/browser/download_manager.h"
 #include "electron/buildflags/buildflags.h"
 #include "gin/handle.h"
+#include "shell/browser/atom_browser_context.h"
 #include "shell/browser/net/resolve_proxy_helper.h"
+#include "shell/common/gin_helper/error_thrower.h"
 #include "shell/common/gin_helper/promise.h"
 #include "shell/common/gin_helper/trackable_object.h"
 
@@ -32,8 +34,6 @@ class ProxyConfig;
 
 namespace electron {
 
-class AtomBrowserContext;
-
 namespace api {
 
 class Session : public gin_helper::TrackableObject<Session>,
@@ -47,7 +47,8 @@ class Session : public gin_helper::TrackableObject<Session>,
   static gin::Handle<Session> FromPartition(
       v8::Isolate* isolate,
       const std::string& partition,
-      base::DictionaryValue options = base::DictionaryValue());
+      const AtomBrowserContext::Options& options =
+          AtomBrowserContext::Options());
 
   AtomBrowserContext* browser_context() const { return browser_context_.get(); }
 
@@ -58,9 +59,13 @@ class Session : public gin_helper::TrackableObject<Session>,
   // Methods.
   v8::Local<v8::Promise> ResolveProxy(gin_helper::Arguments* args);
   v8::Local<v8::Promise> GetCacheSize();
+  v8::Local<v8::Promise> GetCacheStats(v8::Isolate* isolate);
   v8::Local<v8::Promise> ClearCache();
   v8::Local<v8::Promise> ClearStorageData(gin_helper::Arguments* args);
   void FlushStorageData();
+  void SetPreferencesCommitInterval(gin_helper::ErrorThrower thrower,
+                                    int interval);
+  v8::Local<v8::Promise> FlushPreferences(v8::Isolate* isolate);
   v8::Local<v8::Promise> SetProxy(gin_helper::Arguments* args);
   void SetDownloadPath(const base::FilePath& path);
   void EnableNetworkEmulation(const gin_helper::Dictionary& options);
@@ -71,23 +76,34 @@ class Session : public gin_helper::TrackableObject<Session>,
                                    gin_helper::Arguments* args);
   void SetPermissionCheckHandler(v8::Local<v8::Value> val,
                                  gin_helper::Arguments* args);
+  void ClearPermissionCheckCache(gin_helper::Arguments* args);
   v8::Local<v8::Promise> ClearHostResolverCache(gin_helper::Arguments* args);
   v8::Local<v8::Promise> ClearAuthCache();
   void AllowNTLMCredentialsForDomains(const std::string& domains);
+  v8::Local<v8::Promise> SetCorsOriginAccessLists(
+      const std::vector<v8::Local<v8::Value>>& entries);
   void SetUserAgent(const std::string& user_agent, gin_helper::Arguments* args);
   std::string GetUserAgent();
   v8::Local<v8::Promise> GetBlobData(v8::Isolate* isolate,
                                      const std::string& uuid);
+  v8::Local<v8::Value> CreateBlobReader(const std::string& uuid,
+                                        uint64_t offset,
+                                        gin_helper::Arguments* args);
   void DownloadURL(const GURL& url);
   void CreateInterruptedDownload(const gin_helper::Dictionary& options);
   void SetPreloads(const std::vector<base::FilePath::StringType>& preloads);
   std::vector<base::FilePath::StringType> GetPreloads() const;
+  base::FilePath GetPreloadCodeCachePath();
   v8::Local<v8::Value> Cookies(v8::Isolate* isolate);
   v8::Local<v8::Value> Protocol(v8::Isolate* isolate);
   v8::Local<v8::Value> WebRequest(v8::Isolate* isolate);
   v8::Local<v8::Value> NetLog(v8::Isolate* isolate);
   void Preconnect(const gin_helper::Dictionary& options,
                   gin_helper::Arguments* args);
+  void SetRendererProcessPolicy(const gin_helper::Dictionary& policy);
+  void SetPreconnectPredictorEnabled(bool enabled);
+  v8::Local<v8::Value> GetPreconnectPredictorStats(v8::Isolate* isolate);
+  void ClearPreconnectPredictor();
 #if BUILDFLAG(ENABLE_BUILTIN_SPELLCHECKER)
   base::Value GetSpellCheckerLanguages();
   void SetSpellCheckerLanguages(gin_helper::ErrorThrower thrower,
@@ -97,9 +113,13 @@ class Session : public gin_helper::TrackableObject<Session>,
 
 #if BUILDFLAG(ENABLE_ELECTRON_EXTENSIONS)
   v8::Local<v8::Promise> LoadExtension(const base::FilePath& extension_path);
+  v8::Local<v8::Promise> LoadExtensions(
+      const std::vector<base::FilePath>& extension_paths);
   void RemoveExtension(const std::string& extension_id);
   v8::Local<v8::Value> GetExtension(const std::string& extension_id);
   v8::Local<v8::Value> GetAllExtensions();
+  v8::Local<v8::Value> GetExtensionMessageMetrics(
+      const std::string& extension_id);
 #endif
 
  protected:
@@ -0,0 +1,104 @@
+// Copyright (c) 2020 GitHub, Inc.
+// Use of this source code is governed by the MIT license that can be
+// found in the LICENSE file.
+
+#include "shell/browser/api/atom_api_shared_memory.h"
+
+#include <memory>
+#include <utility>
+
+#include "base/memory/shared_memory_mapping.h"
+#include "gin/object_template_builder.h"
+#include "shell/common/gin_helper/dictionary.h"
+#include "shell/common/gin_helper/error_thrower.h"
+#include "shell/common/node_includes.h"
+
+namespace electron {
+
+namespace api {
+
+gin::WrapperInfo SharedMemory::kWrapperInfo = {gin::kEmbedderNativeGin};
+
+// static
+gin::Handle<SharedMemory> SharedMemory::Create(v8::Isolate* isolate,
+                                               size_t size) {
+  auto region = base::UnsafeSharedMemoryRegion::Create(size);
+  if (!region.IsValid())
+    return gin::Handle<SharedMemory>();
+  base::WritableSharedMemoryMapping mapping = region.Map();
+  if (!mapping.IsValid())
+    return gin::Handle<SharedMemory>();
+  return gin::CreateHandle(isolate, new SharedMemory(isolate, std::move(region),
+                                                     std::move(mapping)));
+}
+
+SharedMemory::SharedMemory(v8::Isolate* isolate,
+                           base::UnsafeSharedMemoryRegion region,
+                           base::WritableSharedMemoryMapping mapping)
+    : region_(std::move(region)) {
+  // The mapping lives as long as the ArrayBuffer, which may outlive this.
+  auto* owned_mapping =
+      new base::WritableSharedMemoryMapping(std::move(mapping));
+  std::unique_ptr<v8::BackingStore> backing_store =
+      v8::ArrayBuffer::NewBackingStore(
+          owned_mapping->memory(), owned_mapping->size(),
+          [](void* data, size_t length, void* mapping) {
+            delete static_cast<base::WritableSharedMemoryMapping*>(mapping);
+          },
+          owned_mapping);
+  buffer_.Reset(isolate,
+                v8::ArrayBuffer::New(isolate, std::move(backing_store)));
+}
+
+SharedMemory::~SharedMemory() = default;
+
+v8::Local<v8::ArrayBuffer> SharedMemory::GetBuffer(v8::Isolate* isolate) const {
+  return buffer_.Get(isolate);
+}
+
+size_t SharedMemory::GetSize() const {
+  return region_.GetSize();
+}
+
+gin::ObjectTemplateBuilder SharedMemory::GetObjectTemplateBuilder(
+    v8::Isolate* isolate) {
+  return gin::Wrappable<SharedMemory>::GetObjectTemplateBuilder(isolate)
+      .SetProperty("buffer", &SharedMemory::GetBuffer)
+      .SetProperty("size", &SharedMemory::GetSize);
+}
+
+const char* SharedMemory::GetTypeName() {
+  return "SharedMemory";
+}
+
+}  // namespace api
+
+}  // namespace electron
+
+namespace {
+
+v8::Local<v8::Value> CreateSharedMemory(gin_helper::ErrorThrower thrower,
+                                        int64_t size) {
+  if (size <= 0 || size > static_cast<int64_t>(node::Buffer::kMaxLength)) {
+    thrower.ThrowError("size must be a positive integer");
+    return v8::Undefined(thrower.isolate());
+  }
+  auto memory = electron::api::SharedMemory::Create(thrower.isolate(), size);
+  if (memory.IsEmpty()) {
+    thrower.ThrowError("Failed to allocate shared memory");
+    return v8::Undefined(thrower.isolate());
+  }
+  return memory.ToV8();
+}
+
+void Initialize(v8::Local<v8::Object> exports,
+                v8::Local<v8::Value> unused,
+                v8::Local<v8::Context> context,
+                void* priv) {
+  gin_helper::Dictionary dict(context->GetIsolate(), exports);
+  dict.SetMethod("create", &CreateSharedMemory);
+}
+
+}  // namespace
+
+NODE_LINKED_MODULE_CONTEXT_AWARE(atom_browser_shared_memory, Initialize)
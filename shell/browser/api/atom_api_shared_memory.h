@@ -0,0 +1,57 @@
+// Copyright (c) 2020 GitHub, Inc.
+// Use of this source code is governed by the MIT license that can be
+// found in the LICENSE file.
+
+#ifndef SHELL_BROWSER_API_ATOM_API_SHARED_MEMORY_H_
+#define SHELL_BROWSER_API_ATOM_API_SHARED_MEMORY_H_
+
+#include "base/macros.h"
+#include "base/memory/unsafe_shared_memory_region.h"
+#include "gin/handle.h"
+#include "gin/wrappable.h"
+
+namespace electron {
+
+namespace api {
+
+// A region of shared memory that the main process fills, and that is mapped
+// by each frame it is sent to, so that its pages exist once however many
+// frames use it.
+class SharedMemory : public gin::Wrappable<SharedMemory> {
+ public:
+  static gin::WrapperInfo kWrapperInfo;
+
+  // Returns an empty handle when the region could not be allocated.
+  static gin::Handle<SharedMemory> Create(v8::Isolate* isolate, size_t size);
+
+  // The frames map their own duplicate of the region.
+  base::UnsafeSharedMemoryRegion DuplicateRegion() const {
+    return region_.Duplicate();
+  }
+
+  // gin::Wrappable:
+  gin::ObjectTemplateBuilder GetObjectTemplateBuilder(
+      v8::Isolate* isolate) override;
+  const char* GetTypeName() override;
+
+ private:
+  SharedMemory(v8::Isolate* isolate,
+               base::UnsafeSharedMemoryRegion region,
+               base::WritableSharedMemoryMapping mapping);
+  ~SharedMemory() override;
+
+  v8::Local<v8::ArrayBuffer> GetBuffer(v8::Isolate* isolate) const;
+  size_t GetSize() const;
+
+  base::UnsafeSharedMemoryRegion region_;
+  // Backed by the mapping of the main process, which it owns.
+  v8::Global<v8::ArrayBuffer> buffer_;
+
+  DISALLOW_COPY_AND_ASSIGN(SharedMemory);
+};
+
+}  // namespace api
+
+}  // namespace electron
+
+#endif  // SHELL_BROWSER_API_ATOM_API_SHARED_MEMORY_H_
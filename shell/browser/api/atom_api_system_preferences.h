@@ -8,6 +8,7 @@
 #include <memory>
 #include <string>
 
+#include "base/timer/timer.h"
 #include "base/values.h"
 #include "gin/handle.h"
 #include "shell/common/gin_helper/error_thrower.h"
@@ -150,7 +151,13 @@ class SystemPreferences : public gin_helper::EventEmitter<SystemPreferences>
   // The window used for processing events.
   HWND window_;
 
+  void EmitAccentColorChanged();
+
   std::string current_color_;
+  // The accent color changes several times while the user picks one, and
+  // only the last one is emitted.
+  std::string pending_color_;
+  base::OneShotTimer accent_color_timer_;
 
   bool invertered_color_scheme_;
 
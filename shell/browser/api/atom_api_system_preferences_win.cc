@@ -7,6 +7,7 @@
 
 #include "shell/browser/api/atom_api_system_preferences.h"
 
+#include "base/bind.h"
 #include "base/win/wrapped_window_proc.h"
 #include "shell/common/color_util.h"
 #include "ui/base/win/shell.h"
@@ -20,6 +21,11 @@ namespace {
 const wchar_t kSystemPreferencesWindowClass[] =
     L"Electron_SystemPreferencesHostWindow";
 
+// "accent-color-changed" is emitted once the color stopped changing for this
+// long.
+constexpr base::TimeDelta kAccentColorDelay =
+    base::TimeDelta::FromMilliseconds(100);
+
 }  // namespace
 
 namespace api {
@@ -165,15 +171,22 @@ LRESULT CALLBACK SystemPreferences::WndProc(HWND hwnd,
                                             LPARAM lparam) {
   if (message == WM_DWMCOLORIZATIONCOLORCHANGED) {
     DWORD new_color = (DWORD)wparam;
-    std::string new_color_string = hexColorDWORDToRGBA(new_color);
-    if (new_color_string != current_color_) {
-      Emit("accent-color-changed", hexColorDWORDToRGBA(new_color));
-      current_color_ = new_color_string;
-    }
+    pending_color_ = hexColorDWORDToRGBA(new_color);
+    accent_color_timer_.Start(
+        FROM_HERE, kAccentColorDelay,
+        base::BindOnce(&SystemPreferences::EmitAccentColorChanged,
+                       base::Unretained(this)));
   }
   return ::DefWindowProc(hwnd, message, wparam, lparam);
 }
 
+void SystemPreferences::EmitAccentColorChanged() {
+  if (pending_color_ != current_color_) {
+    current_color_ = pending_color_;
+    Emit("accent-color-changed", current_color_);
+  }
+}
+
 void SystemPreferences::OnSysColorChange() {
   bool new_invertered_color_scheme = IsInvertedColorScheme();
   if (new_invertered_color_scheme != invertered_color_scheme_) {
@@ -8,8 +8,10 @@
 #include <utility>
 #include <vector>
 
+#include "base/stl_util.h"
 #include "electron/buildflags/buildflags.h"
 #include "gin/dictionary.h"
+#include "shell/browser/addon_hooks.h"
 #include "shell/browser/api/atom_api_browser_view.h"
 #include "shell/browser/api/atom_api_menu.h"
 #include "shell/browser/api/atom_api_view.h"
@@ -156,6 +158,12 @@ void TopLevelWindow::OnWindowClosed() {
   // also do not want any method to be used, so just mark as destroyed here.
   MarkDestroyed();
 
+  // The weak pointers are already invalidated, but the hooks can not destroy
+  // |this| any more: JavaScript no longer reaches it once it is marked as
+  // destroyed, and it is only deleted by the task posted below.
+  addon_hooks::DispatchEvent(ELECTRON_EVENT_TARGET_WINDOW, weak_map_id(),
+                             "closed");
+  addon_hooks::RemoveEventHooks(ELECTRON_EVENT_TARGET_WINDOW, weak_map_id());
   Emit("closed");
 
   RemoveFromParentChildWindows();
@@ -170,11 +178,20 @@ void TopLevelWindow::OnWindowEndSession() {
 }
 
 void TopLevelWindow::OnWindowBlur() {
-  EmitEventSoon("blur");
+  // The hooks may destroy |this|.
+  auto weak_this = GetWeakPtr();
+  addon_hooks::DispatchEvent(ELECTRON_EVENT_TARGET_WINDOW, weak_map_id(),
+                             "blur");
+  if (weak_this)
+    EmitEventSoon("blur");
 }
 
 void TopLevelWindow::OnWindowFocus() {
-  EmitEventSoon("focus");
+  auto weak_this = GetWeakPtr();
+  addon_hooks::DispatchEvent(ELECTRON_EVENT_TARGET_WINDOW, weak_map_id(),
+                             "focus");
+  if (weak_this)
+    EmitEventSoon("focus");
 }
 
 void TopLevelWindow::OnWindowShow() {
@@ -209,7 +226,11 @@ void TopLevelWindow::OnWindowWillResize(const gfx::Rect& new_bounds,
 }
 
 void TopLevelWindow::OnWindowResize() {
-  Emit("resize");
+  auto weak_this = GetWeakPtr();
+  addon_hooks::DispatchEvent(ELECTRON_EVENT_TARGET_WINDOW, weak_map_id(),
+                             "resize");
+  if (weak_this)
+    Emit("resize");
 }
 
 void TopLevelWindow::OnWindowWillMove(const gfx::Rect& new_bounds,
@@ -220,7 +241,11 @@ void TopLevelWindow::OnWindowWillMove(const gfx::Rect& new_bounds,
 }
 
 void TopLevelWindow::OnWindowMove() {
-  Emit("move");
+  auto weak_this = GetWeakPtr();
+  addon_hooks::DispatchEvent(ELECTRON_EVENT_TARGET_WINDOW, weak_map_id(),
+                             "move");
+  if (weak_this)
+    Emit("move");
 }
 
 void TopLevelWindow::OnWindowMoved() {
@@ -615,6 +640,25 @@ bool TopLevelWindow::IsKiosk() {
   return window_->IsKiosk();
 }
 
+void TopLevelWindow::SetCoalesceResizeEvents(bool coalesce) {
+  window_->SetCoalesceResizeEvents(coalesce);
+}
+
+bool TopLevelWindow::IsCoalescingResizeEvents() {
+  return window_->coalesce_resize_events();
+}
+
+v8::Local<v8::Value> TopLevelWindow::GetResizeLatency(v8::Isolate* isolate) {
+  const auto& latency = window_->resize_latency();
+  gin_helper::Dictionary dict = gin::Dictionary::CreateEmpty(isolate);
+  dict.Set("count", static_cast<double>(latency.count));
+  dict.Set("last", latency.last.InMillisecondsF());
+  dict.Set("average",
+           latency.count ? latency.total.InMillisecondsF() / latency.count : 0);
+  dict.Set("max", latency.max.InMillisecondsF());
+  return dict.GetHandle();
+}
+
 void TopLevelWindow::SetBackgroundColor(const std::string& color_name) {
   SkColor color = ParseHexColor(color_name);
   window_->SetBackgroundColor(color);
@@ -813,8 +857,10 @@ void TopLevelWindow::SetTouchBar(
   window_->SetTouchBar(std::move(items));
 }
 
-void TopLevelWindow::RefreshTouchBarItem(const std::string& item_id) {
-  window_->RefreshTouchBarItem(item_id);
+void TopLevelWindow::RefreshTouchBarItem(
+    const std::string& item_id,
+    const std::vector<std::string>& properties) {
+  window_->RefreshTouchBarItem(item_id, properties);
 }
 
 void TopLevelWindow::SetEscapeTouchBarItem(
@@ -927,6 +973,31 @@ v8::Local<v8::Value> TopLevelWindow::GetBrowserView(
   }
 }
 
+void TopLevelWindow::SetBrowserViewBounds(
+    gin_helper::ErrorThrower thrower,
+    const std::vector<gin_helper::Dictionary>& layout) {
+  // Nothing is applied unless every entry is valid.
+  std::vector<std::pair<NativeBrowserView*, gfx::Rect>> bounds;
+  for (const auto& entry : layout) {
+    gin::Handle<BrowserView> browser_view;
+    gfx::Rect rect;
+    if (!entry.Get("view", &browser_view) || browser_view.IsEmpty()) {
+      thrower.ThrowError("Each entry must have a 'view' BrowserView");
+      return;
+    }
+    if (!entry.Get("bounds", &rect)) {
+      thrower.ThrowError("Each entry must have a 'bounds' Rectangle");
+      return;
+    }
+    if (!base::Contains(browser_views_, browser_view->weak_map_id())) {
+      thrower.ThrowError("The BrowserView is not attached to this window");
+      return;
+    }
+    bounds.emplace_back(browser_view->view(), rect);
+  }
+  window_->SetBrowserViewsBounds(bounds);
+}
+
 std::vector<v8::Local<v8::Value>> TopLevelWindow::GetBrowserViews() const {
   std::vector<v8::Local<v8::Value>> ret;
 
@@ -1068,6 +1139,7 @@ void TopLevelWindow::BuildPrototype(v8::Isolate* isolate,
   prototype->SetClassName(gin::StringToV8(isolate, "TopLevelWindow"));
   gin_helper::Destroyable::MakeDestroyable(isolate, prototype);
   gin_helper::ObjectTemplateBuilder(isolate, prototype->PrototypeTemplate())
+      .SetMethod("_setListening", &TopLevelWindow::SetListening)
       .SetMethod("setContentView", &TopLevelWindow::SetContentView)
       .SetMethod("close", &TopLevelWindow::Close)
       .SetMethod("focus", &TopLevelWindow::Focus)
@@ -1143,6 +1215,11 @@ void TopLevelWindow::BuildPrototype(v8::Isolate* isolate,
       .SetMethod("isSimpleFullScreen", &TopLevelWindow::IsSimpleFullScreen)
       .SetMethod("setKiosk", &TopLevelWindow::SetKiosk)
       .SetMethod("isKiosk", &TopLevelWindow::IsKiosk)
+      .SetMethod("setCoalesceResizeEvents",
+                 &TopLevelWindow::SetCoalesceResizeEvents)
+      .SetMethod("isCoalescingResizeEvents",
+                 &TopLevelWindow::IsCoalescingResizeEvents)
+      .SetMethod("getResizeLatency", &TopLevelWindow::GetResizeLatency)
       .SetMethod("setBackgroundColor", &TopLevelWindow::SetBackgroundColor)
       .SetMethod("getBackgroundColor", &TopLevelWindow::GetBackgroundColor)
       .SetMethod("setHasShadow", &TopLevelWindow::SetHasShadow)
@@ -1209,6 +1286,7 @@ void TopLevelWindow::BuildPrototype(v8::Isolate* isolate,
       .SetMethod("getChildWindows", &TopLevelWindow::GetChildWindows)
       .SetMethod("getBrowserView", &TopLevelWindow::GetBrowserView)
       .SetMethod("getBrowserViews", &TopLevelWindow::GetBrowserViews)
+      .SetMethod("setBrowserViewBounds", &TopLevelWindow::SetBrowserViewBounds)
       .SetMethod("isModal", &TopLevelWindow::IsModal)
       .SetMethod("setThumbarButtons", &TopLevelWindow::SetThumbarButtons)
 #if defined(TOOLKIT_VIEWS)
@@ -1249,7 +1327,8 @@ void Initialize(v8::Local<v8::Object> exports,
                                          ->GetFunction(context)
                                          .ToLocalChecked());
   constructor.SetMethod("fromId", &TopLevelWindow::FromWeakMapID);
-  constructor.SetMethod("getAllWindows", &TopLevelWindow::GetAll);
+  constructor.SetMethod("_getAll", &TopLevelWindow::GetAll);
+  constructor.SetMethod("_getAllVersion", &TopLevelWindow::GetAllVersion);
 
   gin_helper::Dictionary dict(isolate, exports);
   dict.Set("TopLevelWindow", constructor);
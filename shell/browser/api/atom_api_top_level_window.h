@@ -17,6 +17,8 @@
 #include "shell/browser/native_window.h"
 #include "shell/browser/native_window_observer.h"
 #include "shell/common/api/atom_api_native_image.h"
+#include "shell/common/gin_helper/dictionary.h"
+#include "shell/common/gin_helper/error_thrower.h"
 #include "shell/common/gin_helper/trackable_object.h"
 
 namespace electron {
@@ -154,6 +156,9 @@ class TopLevelWindow : public gin_helper::TrackableObject<TopLevelWindow>,
   bool IsSimpleFullScreen();
   void SetKiosk(bool kiosk);
   bool IsKiosk();
+  void SetCoalesceResizeEvents(bool coalesce);
+  bool IsCoalescingResizeEvents();
+  v8::Local<v8::Value> GetResizeLatency(v8::Isolate* isolate);
   virtual void SetBackgroundColor(const std::string& color_name);
   std::string GetBackgroundColor();
   void SetHasShadow(bool has_shadow);
@@ -175,6 +180,8 @@ class TopLevelWindow : public gin_helper::TrackableObject<TopLevelWindow>,
   virtual void AddBrowserView(v8::Local<v8::Value> value);
   virtual void RemoveBrowserView(v8::Local<v8::Value> value);
   virtual std::vector<v8::Local<v8::Value>> GetBrowserViews() const;
+  void SetBrowserViewBounds(gin_helper::ErrorThrower thrower,
+                            const std::vector<gin_helper::Dictionary>& layout);
   virtual void ResetBrowserViews();
   std::string GetMediaSourceId() const;
   v8::Local<v8::Value> GetNativeWindowHandle();
@@ -186,7 +193,8 @@ class TopLevelWindow : public gin_helper::TrackableObject<TopLevelWindow>,
   void SetAutoHideCursor(bool auto_hide);
   virtual void SetVibrancy(v8::Isolate* isolate, v8::Local<v8::Value> value);
   void SetTouchBar(std::vector<gin_helper::PersistentDictionary> items);
-  void RefreshTouchBarItem(const std::string& item_id);
+  void RefreshTouchBarItem(const std::string& item_id,
+                           const std::vector<std::string>& properties);
   void SetEscapeTouchBarItem(gin_helper::PersistentDictionary item);
   void SelectPreviousTab();
   void SelectNextTab();
@@ -4,8 +4,11 @@
 
 #include "shell/browser/api/atom_api_tray.h"
 
+#include <algorithm>
 #include <string>
+#include <utility>
 
+#include "base/bind.h"
 #include "base/threading/thread_task_runner_handle.h"
 #include "shell/browser/api/atom_api_menu.h"
 #include "shell/browser/browser.h"
@@ -54,6 +57,14 @@ namespace electron {
 
 namespace api {
 
+namespace {
+
+// The tray icon is shown at most once per display refresh.
+constexpr base::TimeDelta kIconUpdateInterval =
+    base::TimeDelta::FromMicroseconds(base::Time::kMicrosecondsPerSecond / 60);
+
+}  // namespace
+
 Tray::Tray(gin::Handle<NativeImage> image, gin_helper::Arguments* args)
     : tray_icon_(TrayIcon::Create()) {
   SetImage(args->isolate(), image);
@@ -146,13 +157,93 @@ void Tray::OnDragEnded() {
 }
 
 void Tray::SetImage(v8::Isolate* isolate, gin::Handle<NativeImage> image) {
+  StopAnimation();
+  UpdateIcon(isolate, image.ToV8(), ToIcon(image.get()));
+}
+
+void Tray::SetAnimation(gin_helper::ErrorThrower thrower,
+                        const std::vector<gin::Handle<NativeImage>>& frames,
+                        double interval) {
+  if (!(interval > 0)) {
+    thrower.ThrowError("The interval must be a positive number");
+    return;
+  }
+
+  StopAnimation();
+  if (frames.empty())
+    return;
+
+  for (const auto& frame : frames) {
+    frames_.push_back(ToIcon(frame.get()));
+    frame_handles_.emplace_back(thrower.isolate(), frame.ToV8());
+  }
+
+  // The first frame replaces the pending image.
+  pending_icon_timer_.Stop();
+  pending_icon_.reset();
+  last_icon_update_ = base::TimeTicks::Now();
+  tray_icon_->SetImage(frames_[current_frame_]);
+
+  animation_timer_.Start(
+      FROM_HERE,
+      std::max(base::TimeDelta::FromMillisecondsD(interval),
+               kIconUpdateInterval),
+      base::BindRepeating(&Tray::ShowNextFrame, base::Unretained(this)));
+}
+
+// static
+Tray::Icon Tray::ToIcon(NativeImage* image) {
 #if defined(OS_WIN)
-  tray_icon_->SetImage(image->GetHICON(GetSystemMetrics(SM_CXSMICON)));
+  return image->GetHICON(GetSystemMetrics(SM_CXSMICON));
 #else
-  tray_icon_->SetImage(image->image());
+  return image->image();
 #endif
 }
 
+void Tray::UpdateIcon(v8::Isolate* isolate,
+                      v8::Local<v8::Value> handle,
+                      const Icon& icon) {
+  base::TimeTicks now = base::TimeTicks::Now();
+  base::TimeDelta since_update = now - last_icon_update_;
+  if (!pending_icon_timer_.IsRunning() && since_update >= kIconUpdateInterval) {
+    last_icon_update_ = now;
+    tray_icon_->SetImage(icon);
+    return;
+  }
+
+  // The NativeImage is kept until the icon is shown, since it owns the
+  // native icon on Windows.
+  pending_icon_.emplace();
+  pending_icon_->icon = icon;
+  pending_icon_->handle.Reset(isolate, handle);
+  if (!pending_icon_timer_.IsRunning()) {
+    pending_icon_timer_.Start(
+        FROM_HERE, kIconUpdateInterval - since_update,
+        base::BindOnce(&Tray::ShowPendingIcon, base::Unretained(this)));
+  }
+}
+
+void Tray::ShowPendingIcon() {
+  if (!pending_icon_)
+    return;
+  last_icon_update_ = base::TimeTicks::Now();
+  tray_icon_->SetImage(pending_icon_->icon);
+  pending_icon_.reset();
+}
+
+void Tray::ShowNextFrame() {
+  current_frame_ = (current_frame_ + 1) % frames_.size();
+  last_icon_update_ = base::TimeTicks::Now();
+  tray_icon_->SetImage(frames_[current_frame_]);
+}
+
+void Tray::StopAnimation() {
+  animation_timer_.Stop();
+  frames_.clear();
+  frame_handles_.clear();
+  current_frame_ = 0;
+}
+
 void Tray::SetPressedImage(v8::Isolate* isolate,
                            gin::Handle<NativeImage> image) {
 #if defined(OS_WIN)
@@ -264,6 +355,7 @@ void Tray::BuildPrototype(v8::Isolate* isolate,
   gin_helper::Destroyable::MakeDestroyable(isolate, prototype);
   gin_helper::ObjectTemplateBuilder(isolate, prototype->PrototypeTemplate())
       .SetMethod("setImage", &Tray::SetImage)
+      .SetMethod("setAnimation", &Tray::SetAnimation)
       .SetMethod("setPressedImage", &Tray::SetPressedImage)
       .SetMethod("setToolTip", &Tray::SetToolTip)
       .SetMethod("setTitle", &Tray::SetTitle)
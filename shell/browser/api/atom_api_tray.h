@@ -9,15 +9,15 @@
 #include <string>
 #include <vector>
 
+#include "base/optional.h"
+#include "base/time/time.h"
+#include "base/timer/timer.h"
 #include "gin/handle.h"
 #include "shell/browser/ui/tray_icon.h"
 #include "shell/browser/ui/tray_icon_observer.h"
 #include "shell/common/gin_helper/error_thrower.h"
 #include "shell/common/gin_helper/trackable_object.h"
-
-namespace gfx {
-class Image;
-}
+#include "ui/gfx/image/image.h"
 
 namespace gin_helper {
 class Dictionary;
@@ -67,6 +67,9 @@ class Tray : public gin_helper::TrackableObject<Tray>, public TrayIconObserver {
   void OnMouseMoved(const gfx::Point& location, int modifiers) override;
 
   void SetImage(v8::Isolate* isolate, gin::Handle<NativeImage> image);
+  void SetAnimation(gin_helper::ErrorThrower thrower,
+                    const std::vector<gin::Handle<NativeImage>>& frames,
+                    double interval);
   void SetPressedImage(v8::Isolate* isolate, gin::Handle<NativeImage> image);
   void SetToolTip(const std::string& tool_tip);
   void SetTitle(const std::string& title);
@@ -83,9 +86,44 @@ class Tray : public gin_helper::TrackableObject<Tray>, public TrayIconObserver {
   gfx::Rect GetBounds();
 
  private:
+#if defined(OS_WIN)
+  using Icon = HICON;
+#else
+  using Icon = gfx::Image;
+#endif
+
+  // The image of the tray icon, owned by the NativeImage |handle|.
+  struct PendingIcon {
+    Icon icon;
+    v8::Global<v8::Value> handle;
+  };
+
+  static Icon ToIcon(NativeImage* image);
+
+  // Shows |icon| now, or once the current one was shown for a display refresh
+  // interval, so that changing the image more often does not recreate the
+  // icon of the OS more often.
+  void UpdateIcon(v8::Isolate* isolate,
+                  v8::Local<v8::Value> handle,
+                  const Icon& icon);
+  void ShowPendingIcon();
+  void ShowNextFrame();
+  void StopAnimation();
+
   v8::Global<v8::Value> menu_;
   std::unique_ptr<TrayIcon> tray_icon_;
 
+  base::TimeTicks last_icon_update_;
+  base::Optional<PendingIcon> pending_icon_;
+  base::OneShotTimer pending_icon_timer_;
+
+  // The frames of the animation, converted once, and the NativeImages which
+  // own them.
+  std::vector<Icon> frames_;
+  std::vector<v8::Global<v8::Value>> frame_handles_;
+  size_t current_frame_ = 0;
+  base::RepeatingTimer animation_timer_;
+
   DISALLOW_COPY_AND_ASSIGN(Tray);
 };
 
@@ -5,6 +5,7 @@
 #include "shell/browser/api/atom_api_url_loader.h"
 
 #include <algorithm>
+#include <limits>
 #include <map>
 #include <memory>
 #include <string>
@@ -12,17 +13,23 @@
 #include <vector>
 
 #include "base/containers/id_map.h"
+#include "base/optional.h"
 #include "gin/handle.h"
 #include "gin/object_template_builder.h"
 #include "gin/wrappable.h"
+#include "mojo/public/cpp/bindings/receiver.h"
+#include "mojo/public/cpp/bindings/remote.h"
 #include "mojo/public/cpp/system/data_pipe_producer.h"
 #include "services/network/public/cpp/resource_request.h"
+#include "services/network/public/cpp/shared_url_loader_factory.h"
 #include "services/network/public/cpp/simple_url_loader.h"
 #include "services/network/public/mojom/chunked_data_pipe_getter.mojom.h"
+#include "services/network/public/mojom/url_loader.mojom.h"
 #include "services/network/public/mojom/url_loader_factory.mojom.h"
 #include "shell/browser/api/atom_api_session.h"
 #include "shell/browser/atom_browser_context.h"
 #include "shell/common/gin_converters/callback_converter.h"
+#include "shell/common/gin_converters/file_path_converter.h"
 #include "shell/common/gin_converters/gurl_converter.h"
 #include "shell/common/gin_converters/net_converter.h"
 #include "shell/common/gin_helper/dictionary.h"
@@ -245,10 +252,94 @@ base::IDMap<SimpleURLLoaderWrapper*>& GetAllRequests() {
 
 }  // namespace
 
+// Sits between the SimpleURLLoader and the URL loader factory of the session,
+// so the priority of the request can be changed while it is in flight, which
+// SimpleURLLoader does not allow. The other calls are forwarded as they are.
+class SimpleURLLoaderWrapper::LoaderForwarder
+    : public network::mojom::URLLoaderFactory,
+      public network::mojom::URLLoader {
+ public:
+  explicit LoaderForwarder(
+      scoped_refptr<network::SharedURLLoaderFactory> factory)
+      : factory_(std::move(factory)) {}
+  ~LoaderForwarder() override = default;
+
+  // network::mojom::URLLoaderFactory:
+  void CreateLoaderAndStart(
+      mojo::PendingReceiver<network::mojom::URLLoader> loader,
+      int32_t routing_id,
+      int32_t request_id,
+      uint32_t options,
+      const network::ResourceRequest& request,
+      mojo::PendingRemote<network::mojom::URLLoaderClient> client,
+      const net::MutableNetworkTrafficAnnotationTag& traffic_annotation)
+      override {
+    receiver_.reset();
+    target_loader_.reset();
+    receiver_.Bind(std::move(loader));
+    receiver_.set_disconnect_handler(base::BindOnce(
+        &LoaderForwarder::OnDisconnect, base::Unretained(this)));
+    factory_->CreateLoaderAndStart(
+        target_loader_.BindNewPipeAndPassReceiver(), routing_id, request_id,
+        options, request, std::move(client), traffic_annotation);
+    // SimpleURLLoader starts the retries with the priority of the original
+    // request.
+    if (priority_)
+      target_loader_->SetPriority(*priority_, intra_priority_value_);
+  }
+  void Clone(mojo::PendingReceiver<network::mojom::URLLoaderFactory> receiver)
+      override {
+    factory_->Clone(std::move(receiver));
+  }
+
+  // network::mojom::URLLoader:
+  void FollowRedirect(const std::vector<std::string>& removed_headers,
+                      const net::HttpRequestHeaders& modified_headers,
+                      const base::Optional<GURL>& new_url) override {
+    if (target_loader_.is_bound())
+      target_loader_->FollowRedirect(removed_headers, modified_headers,
+                                     new_url);
+  }
+  void SetPriority(net::RequestPriority priority,
+                   int32_t intra_priority_value) override {
+    priority_ = priority;
+    intra_priority_value_ = intra_priority_value;
+    if (target_loader_.is_bound())
+      target_loader_->SetPriority(priority, intra_priority_value);
+  }
+  void PauseReadingBodyFromNet() override {
+    if (target_loader_.is_bound())
+      target_loader_->PauseReadingBodyFromNet();
+  }
+  void ResumeReadingBodyFromNet() override {
+    if (target_loader_.is_bound())
+      target_loader_->ResumeReadingBodyFromNet();
+  }
+
+ private:
+  // The network service cancels the request when its loader is gone.
+  void OnDisconnect() { target_loader_.reset(); }
+
+  scoped_refptr<network::SharedURLLoaderFactory> factory_;
+  mojo::Receiver<network::mojom::URLLoader> receiver_{this};
+  mojo::Remote<network::mojom::URLLoader> target_loader_;
+
+  // The priority last set, which also applies to the loaders started later.
+  base::Optional<net::RequestPriority> priority_;
+  int32_t intra_priority_value_ = 0;
+
+  DISALLOW_COPY_AND_ASSIGN(LoaderForwarder);
+};
+
 SimpleURLLoaderWrapper::SimpleURLLoaderWrapper(
     std::unique_ptr<network::ResourceRequest> request,
-    network::mojom::URLLoaderFactory* url_loader_factory)
-    : id_(GetAllRequests().Add(this)) {
+    scoped_refptr<network::SharedURLLoaderFactory> url_loader_factory,
+    const base::FilePath& download_path,
+    base::TimeDelta progress_interval)
+    : id_(GetAllRequests().Add(this)),
+      forwarder_(std::make_unique<LoaderForwarder>(
+          std::move(url_loader_factory))),
+      progress_interval_(progress_interval) {
   // We slightly abuse the |render_frame_id| field in ResourceRequest so that
   // we can correlate any authentication events that arrive with this request.
   request->render_frame_id = id_;
@@ -273,7 +364,17 @@ SimpleURLLoaderWrapper::SimpleURLLoaderWrapper(
   loader_->SetOnDownloadProgressCallback(base::BindRepeating(
       &SimpleURLLoaderWrapper::OnDownloadProgress, base::Unretained(this)));
 
-  loader_->DownloadAsStream(url_loader_factory, this);
+  // Large downloads are written by the SimpleURLLoader on a background
+  // sequence, without passing through JavaScript.
+  if (download_path.empty()) {
+    loader_->DownloadAsStream(forwarder_.get(), this);
+  } else {
+    loader_->DownloadToFile(
+        forwarder_.get(),
+        base::BindOnce(&SimpleURLLoaderWrapper::OnDownloadedToFile,
+                       base::Unretained(this)),
+        download_path);
+  }
 }
 
 void SimpleURLLoaderWrapper::Pin() {
@@ -335,6 +436,10 @@ void SimpleURLLoaderWrapper::Cancel() {
   // for additional guards.
 }
 
+void SimpleURLLoaderWrapper::SetPriority(net::RequestPriority priority) {
+  forwarder_->SetPriority(priority, 0);
+}
+
 // static
 gin_helper::WrappableBase* SimpleURLLoaderWrapper::New(gin::Arguments* args) {
   gin_helper::Dictionary opts;
@@ -345,6 +450,10 @@ gin_helper::WrappableBase* SimpleURLLoaderWrapper::New(gin::Arguments* args) {
   auto request = std::make_unique<network::ResourceRequest>();
   opts.Get("method", &request->method);
   opts.Get("url", &request->url);
+  if (opts.Has("priority") && !opts.Get("priority", &request->priority)) {
+    args->ThrowTypeError("Invalid priority");
+    return nullptr;
+  }
   std::map<std::string, std::string> extra_headers;
   if (opts.Get("extraHeaders", &extra_headers)) {
     for (const auto& it : extra_headers) {
@@ -384,6 +493,27 @@ gin_helper::WrappableBase* SimpleURLLoaderWrapper::New(gin::Arguments* args) {
     }
   }
 
+  // The network service reads the file, so it is never loaded into memory.
+  gin_helper::Dictionary upload_file;
+  if (opts.Get("uploadFile", &upload_file)) {
+    base::FilePath path;
+    if (!upload_file.Get("path", &path) || path.empty()) {
+      args->ThrowTypeError("uploadFile must have a path");
+      return nullptr;
+    }
+    uint64_t offset = 0;
+    uint64_t length = std::numeric_limits<uint64_t>::max();
+    upload_file.Get("offset", &offset);
+    upload_file.Get("length", &length);
+    request->request_body = new network::ResourceRequestBody();
+    request->request_body->AppendFileRange(path, offset, length, base::Time());
+  }
+
+  base::FilePath download_path;
+  opts.Get("downloadPath", &download_path);
+  double progress_interval = 0;
+  opts.Get("progressInterval", &progress_interval);
+
   std::string partition;
   gin::Handle<Session> session;
   if (!opts.Get("session", &session)) {
@@ -395,8 +525,9 @@ gin_helper::WrappableBase* SimpleURLLoaderWrapper::New(gin::Arguments* args) {
 
   auto url_loader_factory = session->browser_context()->GetURLLoaderFactory();
 
-  auto* ret =
-      new SimpleURLLoaderWrapper(std::move(request), url_loader_factory.get());
+  auto* ret = new SimpleURLLoaderWrapper(
+      std::move(request), std::move(url_loader_factory), download_path,
+      base::TimeDelta::FromMillisecondsD(progress_interval));
   ret->InitWithArgs(args);
   ret->Pin();
   if (!chunk_pipe_getter.IsEmpty()) {
@@ -418,7 +549,12 @@ void SimpleURLLoaderWrapper::OnDataReceived(base::StringPiece string_piece,
 
 void SimpleURLLoaderWrapper::OnComplete(bool success) {
   if (success) {
-    Emit("complete");
+    const network::URLLoaderCompletionStatus* status =
+        loader_->CompletionStatus();
+    if (status)
+      Emit("complete", RequestMetrics(load_timing_, *status));
+    else
+      Emit("complete");
   } else {
     Emit("error", net::ErrorToString(loader_->NetError()));
   }
@@ -432,6 +568,7 @@ void SimpleURLLoaderWrapper::OnRetry(base::OnceClosure start_retry) {}
 void SimpleURLLoaderWrapper::OnResponseStarted(
     const GURL& final_url,
     const network::mojom::URLResponseHead& response_head) {
+  load_timing_ = response_head.load_timing;
   gin::Dictionary dict = gin::Dictionary::CreateEmpty(isolate());
   dict.Set("statusCode", response_head.headers->response_code());
   dict.Set("statusMessage", response_head.headers->GetStatusText());
@@ -453,11 +590,27 @@ void SimpleURLLoaderWrapper::OnRedirect(
 
 void SimpleURLLoaderWrapper::OnUploadProgress(uint64_t position,
                                               uint64_t total) {
-  Emit("upload-progress", position, total);
+  // The end of the upload is always reported.
+  if (position == total || ShouldEmitProgress(&last_upload_progress_))
+    Emit("upload-progress", position, total);
 }
 
 void SimpleURLLoaderWrapper::OnDownloadProgress(uint64_t current) {
-  Emit("download-progress", current);
+  if (ShouldEmitProgress(&last_download_progress_))
+    Emit("download-progress", current);
+}
+
+void SimpleURLLoaderWrapper::OnDownloadedToFile(base::FilePath path) {
+  OnComplete(!path.empty());
+}
+
+bool SimpleURLLoaderWrapper::ShouldEmitProgress(
+    base::TimeTicks* last_progress) {
+  base::TimeTicks now = base::TimeTicks::Now();
+  if (!last_progress->is_null() && now - *last_progress < progress_interval_)
+    return false;
+  *last_progress = now;
+  return true;
 }
 
 // static
@@ -466,7 +619,8 @@ void SimpleURLLoaderWrapper::BuildPrototype(
     v8::Local<v8::FunctionTemplate> prototype) {
   prototype->SetClassName(gin::StringToV8(isolate, "SimpleURLLoaderWrapper"));
   gin_helper::ObjectTemplateBuilder(isolate, prototype->PrototypeTemplate())
-      .SetMethod("cancel", &SimpleURLLoaderWrapper::Cancel);
+      .SetMethod("cancel", &SimpleURLLoaderWrapper::Cancel)
+      .SetMethod("setPriority", &SimpleURLLoaderWrapper::SetPriority);
 }
 
 }  // namespace api
@@ -9,12 +9,17 @@
 #include <string>
 #include <vector>
 
+#include "base/files/file_path.h"
+#include "base/memory/scoped_refptr.h"
 #include "base/memory/weak_ptr.h"
+#include "base/time/time.h"
 #include "net/base/auth.h"
+#include "net/base/request_priority.h"
 #include "services/network/public/cpp/simple_url_loader_stream_consumer.h"
 #include "services/network/public/mojom/network_context.mojom.h"
 #include "services/network/public/mojom/url_loader_factory.mojom-forward.h"
 #include "services/network/public/mojom/url_response_head.mojom.h"
+#include "shell/browser/net/request_metrics.h"
 #include "shell/common/gin_helper/event_emitter.h"
 #include "url/gurl.h"
 #include "v8/include/v8.h"
@@ -24,6 +29,7 @@ class Arguments;
 }
 
 namespace network {
+class SharedURLLoaderFactory;
 class SimpleURLLoader;
 struct ResourceRequest;
 }  // namespace network
@@ -55,9 +61,20 @@ class SimpleURLLoaderWrapper
 
   void Cancel();
 
+  // Changes the priority of the request, also while it is in flight.
+  void SetPriority(net::RequestPriority priority);
+
  private:
-  SimpleURLLoaderWrapper(std::unique_ptr<network::ResourceRequest> loader,
-                         network::mojom::URLLoaderFactory* url_loader_factory);
+  class LoaderForwarder;
+
+  // The body is written to |download_path| instead of being emitted when it
+  // is not empty, and progress events are emitted at most once per
+  // |progress_interval|.
+  SimpleURLLoaderWrapper(
+      std::unique_ptr<network::ResourceRequest> loader,
+      scoped_refptr<network::SharedURLLoaderFactory> url_loader_factory,
+      const base::FilePath& download_path,
+      base::TimeDelta progress_interval);
 
   // SimpleURLLoaderStreamConsumer:
   void OnDataReceived(base::StringPiece string_piece,
@@ -73,16 +90,30 @@ class SimpleURLLoaderWrapper
                   std::vector<std::string>* removed_headers);
   void OnUploadProgress(uint64_t position, uint64_t total);
   void OnDownloadProgress(uint64_t current);
+  void OnDownloadedToFile(base::FilePath path);
+
+  // Returns whether a progress event last emitted at |last_progress| can be
+  // emitted again, updating it when so.
+  bool ShouldEmitProgress(base::TimeTicks* last_progress);
 
   void Start();
   void Pin();
   void PinBodyGetter(v8::Local<v8::Value>);
 
   uint32_t id_;
+  // Declared before |loader_|, which uses it.
+  std::unique_ptr<LoaderForwarder> forwarder_;
   std::unique_ptr<network::SimpleURLLoader> loader_;
   v8::Global<v8::Value> pinned_wrapper_;
   v8::Global<v8::Value> pinned_chunk_pipe_getter_;
 
+  // Kept from the response for the metrics emitted on completion.
+  net::LoadTimingInfo load_timing_;
+
+  base::TimeDelta progress_interval_;
+  base::TimeTicks last_upload_progress_;
+  base::TimeTicks last_download_progress_;
+
   base::WeakPtrFactory<SimpleURLLoaderWrapper> weak_factory_{this};
 };
 
@@ -4,16 +4,22 @@
 
 #include "shell/browser/api/atom_api_web_contents.h"
 
+#include <algorithm>
 #include <memory>
 #include <set>
 #include <string>
 #include <utility>
 #include <vector>
 
+#include "base/bits.h"
+#include "base/memory/read_only_shared_memory_region.h"
+#include "base/memory/unsafe_shared_memory_region.h"
 #include "base/message_loop/message_loop_current.h"
 #include "base/no_destructor.h"
 #include "base/optional.h"
+#include "base/strings/string_number_conversions.h"
 #include "base/strings/utf_string_conversions.h"
+#include "base/task/post_task.h"
 #include "base/threading/thread_restrictions.h"
 #include "base/threading/thread_task_runner_handle.h"
 #include "base/values.h"
@@ -24,6 +30,8 @@
 #include "content/browser/renderer_host/render_widget_host_impl.h"  // nogncheck
 #include "content/browser/renderer_host/render_widget_host_view_base.h"  // nogncheck
 #include "content/common/widget_messages.h"
+#include "content/public/browser/browser_task_traits.h"
+#include "content/public/browser/browser_thread.h"
 #include "content/public/browser/child_process_security_policy.h"
 #include "content/public/browser/download_request_utils.h"
 #include "content/public/browser/favicon_status.h"
@@ -45,11 +53,20 @@
 #include "electron/buildflags/buildflags.h"
 #include "electron/shell/common/api/api.mojom.h"
 #include "mojo/public/cpp/bindings/associated_remote.h"
+#include "mojo/public/cpp/bindings/callback_helpers.h"
+#include "mojo/public/cpp/bindings/message.h"
+#include "mojo/public/cpp/bindings/pending_remote.h"
+#include "mojo/public/cpp/bindings/remote.h"
+#include "mojo/public/cpp/system/data_pipe.h"
 #include "mojo/public/cpp/system/platform_handle.h"
+#include "net/base/url_util.h"
 #include "ppapi/buildflags/buildflags.h"
+#include "shell/browser/addon_hooks.h"
 #include "shell/browser/api/atom_api_browser_window.h"
+#include "shell/browser/api/atom_api_data_pipe_holder.h"
 #include "shell/browser/api/atom_api_debugger.h"
 #include "shell/browser/api/atom_api_session.h"
+#include "shell/browser/api/atom_api_shared_memory.h"
 #include "shell/browser/atom_autofill_driver_factory.h"
 #include "shell/browser/atom_browser_client.h"
 #include "shell/browser/atom_browser_context.h"
@@ -58,8 +75,11 @@
 #include "shell/browser/atom_navigation_throttle.h"
 #include "shell/browser/browser.h"
 #include "shell/browser/child_web_contents_tracker.h"
+#include "shell/browser/ipc_metrics.h"
+#include "shell/browser/ipc_ring_buffer_host.h"
 #include "shell/browser/lib/bluetooth_chooser.h"
 #include "shell/browser/native_window.h"
+#include "shell/browser/net/preconnect_predictor.h"
 #include "shell/browser/session_preferences.h"
 #include "shell/browser/ui/drag_util.h"
 #include "shell/browser/ui/inspectable_web_contents.h"
@@ -78,10 +98,15 @@
 #include "shell/common/gin_converters/gurl_converter.h"
 #include "shell/common/gin_converters/image_converter.h"
 #include "shell/common/gin_converters/net_converter.h"
+#include "shell/common/gin_converters/std_converter.h"
 #include "shell/common/gin_converters/value_converter.h"
 #include "shell/common/gin_helper/dictionary.h"
+#include "shell/common/gin_helper/locker.h"
 #include "shell/common/gin_helper/object_template_builder.h"
+#include "shell/common/ipc_ring_buffer.h"
+#include "shell/common/ipc_trace.h"
 #include "shell/common/mouse_util.h"
+#include "shell/common/native_image_cache.h"
 #include "shell/common/node_includes.h"
 #include "shell/common/options_switches.h"
 #include "third_party/blink/public/common/associated_interfaces/associated_interface_provider.h"
@@ -92,10 +117,13 @@
 #include "third_party/blink/public/platform/web_cursor_info.h"
 #include "ui/display/screen.h"
 #include "ui/events/base_event_utils.h"
+#include "ui/gfx/codec/jpeg_codec.h"
+#include "ui/gfx/codec/png_codec.h"
 
 #if BUILDFLAG(ENABLE_OSR)
 #include "shell/browser/osr/osr_render_widget_host_view.h"
 #include "shell/browser/osr/osr_web_contents_view.h"
+#include "ui/gfx/skbitmap_operations.h"
 #endif
 
 #if !defined(OS_MACOSX)
@@ -113,6 +141,11 @@
 #include "ui/gfx/font_render_params.h"
 #endif
 
+#if defined(OS_WIN)
+#include "base/feature_list.h"
+#include "ui/base/ui_base_features.h"
+#endif
+
 #if BUILDFLAG(ENABLE_PRINTING)
 #include "chrome/browser/printing/print_view_manager_basic.h"
 #include "components/printing/common/print_messages.h"
@@ -300,6 +333,35 @@ struct Converter<electron::api::WebContents::Type> {
   }
 };
 
+template <>
+struct Converter<electron::api::WebContents::BackgroundThrottlingPolicy> {
+  static v8::Local<v8::Value> ToV8(
+      v8::Isolate* isolate,
+      const electron::api::WebContents::BackgroundThrottlingPolicy& val) {
+    gin_helper::Dictionary dict = gin::Dictionary::CreateEmpty(isolate);
+    dict.Set("timers", val.timers);
+    dict.Set("animationFrames", val.animation_frames);
+    dict.Set("media", val.media);
+    dict.Set("occlusion", val.occlusion);
+    return dict.GetHandle();
+  }
+
+  // The fields which are not passed keep their values.
+  static bool FromV8(
+      v8::Isolate* isolate,
+      v8::Local<v8::Value> val,
+      electron::api::WebContents::BackgroundThrottlingPolicy* out) {
+    gin_helper::Dictionary dict;
+    if (!ConvertFromV8(isolate, val, &dict))
+      return false;
+    dict.Get("timers", &out->timers);
+    dict.Get("animationFrames", &out->animation_frames);
+    dict.Get("media", &out->media);
+    dict.Get("occlusion", &out->occlusion);
+    return true;
+  }
+};
+
 template <>
 struct Converter<scoped_refptr<content::DevToolsAgentHost>> {
   static v8::Local<v8::Value> ToV8(
@@ -320,6 +382,44 @@ namespace api {
 
 namespace {
 
+// The snapshot is streamed through a pipe of this size, which is how much of
+// it is buffered while the reader is slower than the renderer.
+const uint32_t kHeapSnapshotPipeCapacity = 1024 * 1024;
+
+// Returns a callback which traces the reply to the message with |trace_id|,
+// as the continuation of its flow, before running |callback|.
+mojom::ElectronBrowser::InvokeCallback WrapTracedReply(
+    uint64_t trace_id,
+    mojom::ElectronBrowser::InvokeCallback callback) {
+  if (!trace_id)
+    return callback;
+  return base::BindOnce(
+      [](uint64_t trace_id, mojom::ElectronBrowser::InvokeCallback callback,
+         blink::CloneableMessage result) {
+        TRACE_EVENT_WITH_FLOW0(
+            "electron", "WebContents::Reply", TRACE_ID_GLOBAL(trace_id),
+            TRACE_EVENT_FLAG_FLOW_IN | TRACE_EVENT_FLAG_FLOW_OUT);
+        std::move(callback).Run(std::move(result));
+      },
+      trace_id, std::move(callback));
+}
+
+base::File OpenHeapSnapshotFile(const base::FilePath& file_path) {
+  return base::File(file_path,
+                    base::File::FLAG_CREATE_ALWAYS | base::File::FLAG_WRITE);
+}
+
+#if BUILDFLAG(ENABLE_PRINTING)
+// Blocks, for seconds with the network printers of some Windows domains.
+std::vector<printing::PrinterBasicInfo> EnumeratePrinters(
+    const std::string& locale) {
+  std::vector<printing::PrinterBasicInfo> printers;
+  auto print_backend = printing::PrintBackend::CreateInstance(nullptr, locale);
+  print_backend->EnumeratePrinters(&printers);
+  return printers;
+}
+#endif
+
 // Called when CapturePage is done.
 void OnCapturePageDone(gin_helper::Promise<gfx::Image> promise,
                        const SkBitmap& bitmap) {
@@ -327,6 +427,158 @@ void OnCapturePageDone(gin_helper::Promise<gfx::Image> promise,
   promise.Resolve(gfx::Image::CreateFrom1xBitmap(bitmap));
 }
 
+// Reads the [rect, ][options] arguments of capturePage, and computes the area
+// of |view| that is copied and the size the copy is scaled to on the GPU.
+// Returns the error to reject with when they are invalid.
+const char* GetCapturePageArea(content::RenderWidgetHostView* view,
+                               gin_helper::Arguments* args,
+                               gin_helper::Dictionary* options,
+                               gfx::Rect* source_rect,
+                               gfx::Size* output_size) {
+  // get rect arguments if they exist
+  gfx::Rect rect;
+  if (!args->GetNext(&rect)) {
+    // The rect can be left undefined when options are passed.
+    v8::Local<v8::Value> next = args->PeekNext();
+    if (!next.IsEmpty() && next->IsNullOrUndefined())
+      args->Skip();
+  }
+  if (!args->GetNext(options))
+    *options = gin::Dictionary::CreateEmpty(args->isolate());
+
+  // Capture full page if user doesn't specify a |rect|.
+  const gfx::Size view_size =
+      rect.IsEmpty() ? view->GetViewBounds().size() : rect.size();
+  *source_rect = gfx::Rect(rect.origin(), view_size);
+
+  if (options->Has("size")) {
+    if (!options->Get("size", output_size) || output_size->IsEmpty())
+      return "size must have a positive width and height";
+    return nullptr;
+  }
+
+  // By default, the requested bitmap size is the view size in screen
+  // coordinates.  However, if there's more pixel detail available on the
+  // current system, increase the requested bitmap size to capture it all.
+  const gfx::NativeView native_view = view->GetNativeView();
+  float scale = std::max(1.0f, display::Screen::GetScreen()
+                                   ->GetDisplayNearestView(native_view)
+                                   .device_scale_factor());
+  if (options->Has("scale") &&
+      (!options->Get("scale", &scale) || !(scale > 0)))
+    return "scale must be greater than 0";
+  *output_size = gfx::ScaleToCeiledSize(view_size, scale);
+  return nullptr;
+}
+
+enum class CaptureFormat {
+  kPNG,
+  kJPEG,
+  kRaw,
+};
+
+// Encodes a captured page, which is done on the thread pool.
+base::Optional<std::string> EncodeCapturedPage(CaptureFormat format,
+                                               int quality,
+                                               const SkBitmap& bitmap) {
+  if (bitmap.drawsNothing())
+    return base::nullopt;
+
+  std::vector<unsigned char> output;
+  switch (format) {
+    case CaptureFormat::kPNG:
+      if (!gfx::PNGCodec::EncodeBGRASkBitmap(bitmap, false, &output))
+        return base::nullopt;
+      break;
+    case CaptureFormat::kJPEG:
+      if (!gfx::JPEGCodec::Encode(bitmap, quality, &output))
+        return base::nullopt;
+      break;
+    case CaptureFormat::kRaw: {
+      // The rows are packed, without the padding of the bitmap.
+      SkImageInfo info = SkImageInfo::MakeN32Premul(bitmap.width(),
+                                                    bitmap.height());
+      std::string pixels(info.computeMinByteSize(), '\0');
+      if (!bitmap.readPixels(info, &pixels[0], info.minRowBytes(), 0, 0))
+        return base::nullopt;
+      return pixels;
+    }
+  }
+  return std::string(output.begin(), output.end());
+}
+
+void OnCapturedPageEncoded(gin_helper::Promise<v8::Local<v8::Value>> promise,
+                           base::Optional<std::string> data) {
+  v8::Isolate* isolate = promise.isolate();
+  gin_helper::Locker locker(isolate);
+  v8::HandleScope handle_scope(isolate);
+  v8::Context::Scope context_scope(promise.GetContext());
+  if (!data) {
+    promise.RejectWithErrorMessage("Failed to capture the page");
+    return;
+  }
+  promise.Resolve(
+      node::Buffer::Copy(isolate, data->data(), data->size()).ToLocalChecked());
+}
+
+// Called when CapturePageBuffer has copied the page, which is then encoded
+// off the UI thread.
+void OnCapturePageBufferDone(gin_helper::Promise<v8::Local<v8::Value>> promise,
+                             CaptureFormat format,
+                             int quality,
+                             const SkBitmap& bitmap) {
+  base::PostTaskAndReplyWithResult(
+      FROM_HERE, {base::ThreadPool(), base::TaskPriority::USER_VISIBLE},
+      base::BindOnce(&EncodeCapturedPage, format, quality, bitmap),
+      base::BindOnce(&OnCapturedPageEncoded, std::move(promise)));
+}
+
+// Messages this large are put in shared memory when they are sent to more than
+// one frame, like mojo_base::BigBuffer does for a single receiver.
+const size_t kSharedMessageThreshold = 64 * 1024;
+
+// Sends |message| to every frame in |frame_hosts|, copying it only once when
+// it is large.
+void SendMessageToFrames(
+    const std::vector<content::RenderFrameHost*>& frame_hosts,
+    bool internal,
+    const std::string& channel,
+    const blink::CloneableMessage& message,
+    int32_t sender_id) {
+  base::ReadOnlySharedMemoryRegion region;
+  size_t size = message.encoded_message.size();
+  if (frame_hosts.size() > 1 && size >= kSharedMessageThreshold) {
+    auto mapped_region = base::ReadOnlySharedMemoryRegion::Create(size);
+    if (mapped_region.IsValid()) {
+      memcpy(mapped_region.mapping.memory(), message.encoded_message.data(),
+             size);
+      region = std::move(mapped_region.region);
+    }
+  }
+
+  for (auto* frame_host : frame_hosts) {
+    mojo::AssociatedRemote<mojom::ElectronRenderer> electron_renderer;
+    frame_host->GetRemoteAssociatedInterfaces()->GetInterface(
+        &electron_renderer);
+    if (region.IsValid()) {
+      electron_renderer->MessageShared(internal, channel, region.Duplicate(),
+                                       sender_id);
+    } else {
+      electron_renderer->Message(internal, false, channel,
+                                 message.ShallowClone(), sender_id,
+                                 0 /* trace_id */);
+    }
+  }
+}
+
+size_t GetMessageSize(const blink::CloneableMessage& message,
+                      const std::vector<mojo_base::BigBuffer>& array_buffers) {
+  size_t size = message.encoded_message.size();
+  for (const auto& buffer : array_buffers)
+    size += buffer.size();
+  return size;
+}
+
 base::Optional<base::TimeDelta> GetCursorBlinkInterval() {
 #if defined(OS_MACOSX)
   base::TimeDelta interval;
@@ -346,8 +598,40 @@ base::Optional<base::TimeDelta> GetCursorBlinkInterval() {
   return base::nullopt;
 }
 
+// The draggable regions are applied at most once per frame.
+constexpr base::TimeDelta kDraggableRegionsInterval =
+    base::TimeDelta::FromMilliseconds(16);
+
+// The drags of an app usually show the same icon, so an icon given as a path
+// is taken from the native image cache without checking its file on the UI
+// thread. The cached image is revalidated on the thread pool for the next drag.
+gfx::Image LoadDragIcon(v8::Isolate* isolate, const base::FilePath& path) {
+  NativeImageCache* cache = NativeImageCache::GetInstance();
+  gfx::ImageSkia image = cache->GetCachedImage(path);
+  if (image.isNull())
+    return NativeImage::CreateFromPath(isolate, path)->image();
+  base::PostTask(FROM_HERE,
+                 {base::ThreadPool(), base::MayBlock(),
+                  base::TaskPriority::BEST_EFFORT},
+                 base::BindOnce(base::IgnoreResult(&NativeImageCache::GetImage),
+                                base::Unretained(cache), path));
+  return gfx::Image(image);
+}
+
 }  // namespace
 
+WebContents::BackgroundThrottlingPolicy::BackgroundThrottlingPolicy() {
+  // Follows what the platform does for the covered windows.
+#if defined(OS_MACOSX)
+  occlusion = true;
+#elif defined(OS_WIN)
+  occlusion =
+      base::FeatureList::IsEnabled(features::kCalculateNativeWinOcclusion);
+#else
+  occlusion = false;
+#endif
+}
+
 WebContents::WebContents(v8::Isolate* isolate,
                          content::WebContents* web_contents)
     : content::WebContentsObserver(web_contents),
@@ -367,6 +651,8 @@ WebContents::WebContents(v8::Isolate* isolate,
                                              base::Unretained(this)));
   bindings_.set_connection_error_handler(base::BindRepeating(
       &WebContents::OnElectronBrowserConnectionError, base::Unretained(this)));
+  ring_buffers_.set_disconnect_handler(base::BindRepeating(
+      &WebContents::OnRingBufferConnectionError, base::Unretained(this)));
 }
 
 WebContents::WebContents(v8::Isolate* isolate,
@@ -387,7 +673,13 @@ WebContents::WebContents(v8::Isolate* isolate,
                          const gin_helper::Dictionary& options)
     : weak_factory_(this) {
   // Read options.
-  options.Get("backgroundThrottling", &background_throttling_);
+  bool background_throttling = true;
+  if (options.Get("backgroundThrottling", &background_throttling)) {
+    background_throttling_policy_.timers = background_throttling;
+    background_throttling_policy_.animation_frames = background_throttling;
+  }
+  options.Get(options::kBackgroundThrottlingPolicy,
+              &background_throttling_policy_);
 
   // Get type
   options.Get("type", &type_);
@@ -436,7 +728,7 @@ WebContents::WebContents(v8::Isolate* isolate,
 #if BUILDFLAG(ENABLE_OSR)
     if (embedder_ && embedder_->IsOffScreen()) {
       auto* view = new OffScreenWebContentsView(
-          false,
+          false, false,
           base::BindRepeating(&WebContents::OnPaint, base::Unretained(this)));
       params.view = view;
       params.delegate_view = view;
@@ -451,10 +743,13 @@ WebContents::WebContents(v8::Isolate* isolate,
   } else if (IsOffScreen()) {
     bool transparent = false;
     options.Get("transparent", &transparent);
+    bool zero_copy = false;
+    options.Get(options::kOffscreenZeroCopy, &zero_copy);
+    options.Get(options::kOffscreenOnlyDirty, &paint_only_dirty_);
 
     content::WebContents::CreateParams params(session->browser_context());
     auto* view = new OffScreenWebContentsView(
-        transparent,
+        transparent, zero_copy,
         base::BindRepeating(&WebContents::OnPaint, base::Unretained(this)));
     params.view = view;
     params.delegate_view = view;
@@ -529,6 +824,8 @@ void WebContents::InitWithSessionAndOptions(
                                              base::Unretained(this)));
   bindings_.set_connection_error_handler(base::BindRepeating(
       &WebContents::OnElectronBrowserConnectionError, base::Unretained(this)));
+  ring_buffers_.set_disconnect_handler(base::BindRepeating(
+      &WebContents::OnRingBufferConnectionError, base::Unretained(this)));
   AutofillDriverFactory::CreateForWebContents(web_contents());
 
   web_contents()->SetUserAgentOverride(GetBrowserContext()->GetUserAgent(),
@@ -579,6 +876,10 @@ WebContents::~WebContents() {
       WebContentsDestroyed();
     }
   }
+  addon_hooks::RemoveEventHooks(ELECTRON_EVENT_TARGET_WEB_CONTENTS, ID());
+#if BUILDFLAG(ENABLE_OSR)
+  addon_hooks::RemovePaintHooks(ID());
+#endif
 }
 
 void WebContents::DestroyWebContents(bool async) {
@@ -872,7 +1173,7 @@ void WebContents::BeforeUnloadFired(bool proceed,
 }
 
 void WebContents::RenderViewCreated(content::RenderViewHost* render_view_host) {
-  if (!background_throttling_)
+  if (!background_throttling_policy_.timers)
     render_view_host->SetSchedulerThrottling(false);
 }
 
@@ -885,7 +1186,7 @@ void WebContents::RenderFrameCreated(
   auto* rwh_impl =
       static_cast<content::RenderWidgetHostImpl*>(rwhv->GetRenderWidgetHost());
   if (rwh_impl)
-    rwh_impl->disable_hidden_ = !background_throttling_;
+    rwh_impl->disable_hidden_ = !background_throttling_policy_.animation_frames;
 }
 
 void WebContents::RenderViewHostChanged(content::RenderViewHost* old_host,
@@ -914,6 +1215,15 @@ void WebContents::RenderViewDeleted(content::RenderViewHost* render_view_host) {
 }
 
 void WebContents::RenderProcessGone(base::TerminationStatus status) {
+  // A discarded page did not crash.
+  if (discarded_)
+    return;
+  // The hooks may destroy |this|.
+  auto weak_this = GetWeakPtr();
+  addon_hooks::DispatchEvent(ELECTRON_EVENT_TARGET_WEB_CONTENTS, ID(),
+                             "crashed");
+  if (!weak_this)
+    return;
   Emit("crashed", status == base::TERMINATION_STATUS_PROCESS_WAS_KILLED);
 }
 
@@ -961,8 +1271,13 @@ void WebContents::DidAcquireFullscreen(content::RenderFrameHost* rfh) {
 
 void WebContents::DOMContentLoaded(
     content::RenderFrameHost* render_frame_host) {
-  if (!render_frame_host->GetParent())
-    Emit("dom-ready");
+  if (!render_frame_host->GetParent()) {
+    auto weak_this = GetWeakPtr();
+    addon_hooks::DispatchEvent(ELECTRON_EVENT_TARGET_WEB_CONTENTS, ID(),
+                               "dom-ready");
+    if (weak_this)
+      Emit("dom-ready");
+  }
 }
 
 void WebContents::DidFinishLoad(content::RenderFrameHost* render_frame_host,
@@ -977,8 +1292,13 @@ void WebContents::DidFinishLoad(content::RenderFrameHost* render_frame_host,
   // ⚠️WARNING!⚠️
   // Emit() triggers JS which can call destroy() on |this|. It's not safe to
   // assume that |this| points to valid memory at this point.
-  if (is_main_frame && weak_this)
-    Emit("did-finish-load");
+  if (is_main_frame && weak_this) {
+    addon_hooks::DispatchEvent(ELECTRON_EVENT_TARGET_WEB_CONTENTS, ID(),
+                               "did-finish-load");
+    // The hooks may destroy |this| as well.
+    if (weak_this)
+      Emit("did-finish-load");
+  }
 }
 
 void WebContents::DidFailLoad(content::RenderFrameHost* render_frame_host,
@@ -1001,9 +1321,12 @@ void WebContents::DidStopLoading() {
 }
 
 bool WebContents::EmitNavigationEvent(
-    const std::string& event,
+    base::StringPiece event,
     content::NavigationHandle* navigation_handle) {
   bool is_main_frame = navigation_handle->IsInMainFrame();
+  if ((!is_main_frame && main_frame_navigation_events_only_) ||
+      !HasListeners(event))
+    return false;
   int frame_tree_node_id = navigation_handle->GetFrameTreeNodeId();
   content::FrameTreeNode* frame_tree_node =
       content::FrameTreeNode::GloballyFindByID(frame_tree_node_id);
@@ -1021,7 +1344,7 @@ bool WebContents::EmitNavigationEvent(
     frame_routing_id = frame_host->GetRoutingID();
   }
   bool is_same_document = navigation_handle->IsSameDocument();
-  auto url = navigation_handle->GetURL();
+  const GURL& url = navigation_handle->GetURL();
   return Emit(event, url, is_same_document, is_main_frame, frame_process_id,
               frame_routing_id);
 }
@@ -1037,37 +1360,224 @@ void WebContents::OnElectronBrowserConnectionError() {
   auto binding_id = bindings_.dispatch_binding();
   auto* frame_host = bindings_.dispatch_context();
   base::Erase(frame_to_bindings_map_[frame_host], binding_id);
+  registered_channels_.erase(binding_id);
+}
+
+void WebContents::OnRingBufferConnectionError() {
+  auto* frame_host = ring_buffers_.current_context();
+  base::Erase(frame_to_ring_buffers_map_[frame_host],
+              ring_buffers_.current_receiver());
 }
 
 void WebContents::Message(bool internal,
                           const std::string& channel,
-                          blink::CloneableMessage arguments) {
-  TRACE_EVENT1("electron", "WebContents::Message", "channel", channel);
+                          blink::CloneableMessage arguments,
+                          uint64_t trace_id) {
+  TRACE_EVENT_WITH_FLOW1(
+      "electron", "WebContents::Message", TRACE_ID_GLOBAL(trace_id),
+      IpcTraceFlowFlags(trace_id, TRACE_EVENT_FLAG_FLOW_IN), "channel",
+      channel);
+  IpcMetrics::Scope metrics(internal, channel,
+                            arguments.encoded_message.size());
   // webContents.emit('-ipc-message', new Event(), internal, channel,
   // arguments);
   EmitWithSender("-ipc-message", bindings_.dispatch_context(), InvokeCallback(),
                  internal, channel, std::move(arguments));
 }
 
+void WebContents::MessageBatch(bool internal,
+                               const std::vector<std::string>& channels,
+                               blink::CloneableMessage arguments,
+                               bool as_arrays) {
+  TRACE_EVENT1("electron", "WebContents::MessageBatch", "messages",
+               channels.size());
+  v8::Locker locker(isolate());
+  v8::HandleScope handle_scope(isolate());
+  // |arguments| must hold one argument array for each channel.
+  v8::Local<v8::Value> args = gin::ConvertToV8(isolate(), arguments);
+  if (!args->IsArray() || args.As<v8::Array>()->Length() != channels.size()) {
+    mojo::ReportBadMessage("The batch has the wrong number of messages");
+    return;
+  }
+  // webContents.emit('-ipc-message-batch', new Event(), internal, channels,
+  // arguments, as_arrays);
+  EmitWithSender("-ipc-message-batch", bindings_.dispatch_context(),
+                 InvokeCallback(), internal, channels, args, as_arrays);
+}
+
+WebContents::RegisteredChannel::RegisteredChannel(v8::Isolate* isolate,
+                                                  const std::string& name)
+    : name(name),
+      v8_name(isolate,
+              v8::String::NewFromUtf8(isolate, name.data(),
+                                      v8::NewStringType::kInternalized,
+                                      name.size())
+                  .ToLocalChecked()) {}
+
+WebContents::RegisteredChannel::RegisteredChannel(RegisteredChannel&&) =
+    default;
+
+WebContents::RegisteredChannel::~RegisteredChannel() = default;
+
+void WebContents::RegisterChannel(uint32_t id, const std::string& channel) {
+  auto& channels = registered_channels_[bindings_.dispatch_binding()];
+  if (id != channels.size()) {
+    mojo::ReportBadMessage("Channel IDs must be registered in order");
+    return;
+  }
+  v8::Locker locker(isolate());
+  v8::HandleScope handle_scope(isolate());
+  channels.emplace_back(isolate(), channel);
+}
+
+void WebContents::MessageById(uint32_t channel_id,
+                              blink::CloneableMessage arguments) {
+  auto it = registered_channels_.find(bindings_.dispatch_binding());
+  if (it == registered_channels_.end() || channel_id >= it->second.size()) {
+    mojo::ReportBadMessage("Unknown channel ID");
+    return;
+  }
+  const RegisteredChannel& channel = it->second[channel_id];
+  TRACE_EVENT1("electron", "WebContents::MessageById", "channel",
+               channel.name);
+  IpcMetrics::Scope metrics(false, channel.name,
+                            arguments.encoded_message.size());
+  v8::Locker locker(isolate());
+  v8::HandleScope handle_scope(isolate());
+  // The listeners can delete the frame, and |channel| with it.
+  v8::Local<v8::String> name = channel.v8_name.Get(isolate());
+  // webContents.emit('-ipc-message', new Event(), internal, channel,
+  // arguments);
+  EmitWithSender("-ipc-message", bindings_.dispatch_context(), InvokeCallback(),
+                 false /* internal */, name, std::move(arguments));
+}
+
 void WebContents::Invoke(bool internal,
                          const std::string& channel,
                          blink::CloneableMessage arguments,
+                         uint64_t trace_id,
                          InvokeCallback callback) {
-  TRACE_EVENT1("electron", "WebContents::Invoke", "channel", channel);
+  TRACE_EVENT_WITH_FLOW1(
+      "electron", "WebContents::Invoke", TRACE_ID_GLOBAL(trace_id),
+      IpcTraceFlowFlags(trace_id,
+                        TRACE_EVENT_FLAG_FLOW_IN | TRACE_EVENT_FLAG_FLOW_OUT),
+      "channel", channel);
+  IpcMetrics::Scope metrics(internal, channel,
+                            arguments.encoded_message.size());
+  // webContents.emit('-ipc-invoke', new Event(), internal, channel, arguments);
+  EmitWithSender(
+      "-ipc-invoke", bindings_.dispatch_context(),
+      metrics.WrapReply(WrapTracedReply(trace_id, std::move(callback))),
+      internal, channel, std::move(arguments));
+}
+
+void WebContents::MessageWithTransfer(
+    bool internal,
+    const std::string& channel,
+    blink::CloneableMessage arguments,
+    std::vector<mojo_base::BigBuffer> array_buffers) {
+  TRACE_EVENT1("electron", "WebContents::MessageWithTransfer", "channel",
+               channel);
+  IpcMetrics::Scope metrics(internal, channel,
+                            GetMessageSize(arguments, array_buffers));
+  v8::Locker locker(isolate());
+  v8::HandleScope handle_scope(isolate());
+  v8::Local<v8::Value> args = gin::DeserializeWithTransfer(
+      isolate(), arguments, std::move(array_buffers));
+  // webContents.emit('-ipc-message', new Event(), internal, channel,
+  // arguments);
+  EmitWithSender("-ipc-message", bindings_.dispatch_context(), InvokeCallback(),
+                 internal, channel, args);
+}
+
+void WebContents::InvokeWithTransfer(
+    bool internal,
+    const std::string& channel,
+    blink::CloneableMessage arguments,
+    std::vector<mojo_base::BigBuffer> array_buffers,
+    InvokeWithTransferCallback callback) {
+  TRACE_EVENT1("electron", "WebContents::InvokeWithTransfer", "channel",
+               channel);
+  IpcMetrics::Scope metrics(internal, channel,
+                            GetMessageSize(arguments, array_buffers));
+  v8::Locker locker(isolate());
+  v8::HandleScope handle_scope(isolate());
+  v8::Local<v8::Value> args = gin::DeserializeWithTransfer(
+      isolate(), arguments, std::move(array_buffers));
   // webContents.emit('-ipc-invoke', new Event(), internal, channel, arguments);
   EmitWithSender("-ipc-invoke", bindings_.dispatch_context(),
-                 std::move(callback), internal, channel, std::move(arguments));
+                 metrics.WrapReply(std::move(callback)), internal, channel,
+                 args);
 }
 
 void WebContents::MessageSync(bool internal,
                               const std::string& channel,
                               blink::CloneableMessage arguments,
+                              uint64_t trace_id,
                               MessageSyncCallback callback) {
-  TRACE_EVENT1("electron", "WebContents::MessageSync", "channel", channel);
+  TRACE_EVENT_WITH_FLOW1(
+      "electron", "WebContents::MessageSync", TRACE_ID_GLOBAL(trace_id),
+      IpcTraceFlowFlags(trace_id,
+                        TRACE_EVENT_FLAG_FLOW_IN | TRACE_EVENT_FLAG_FLOW_OUT),
+      "channel", channel);
+  IpcMetrics::Scope metrics(internal, channel,
+                            arguments.encoded_message.size());
   // webContents.emit('-ipc-message-sync', new Event(sender, message), internal,
   // channel, arguments);
   EmitWithSender("-ipc-message-sync", bindings_.dispatch_context(),
-                 std::move(callback), internal, channel, std::move(arguments));
+                 metrics.WrapReply(WrapSyncReply(
+                     internal, channel,
+                     WrapTracedReply(trace_id, std::move(callback)))),
+                 internal, channel, std::move(arguments));
+}
+
+void WebContents::MessageSyncWithReply(
+    bool internal,
+    const std::string& channel,
+    blink::CloneableMessage arguments,
+    uint64_t trace_id,
+    mojo::PendingRemote<mojom::ElectronSyncReply> reply) {
+  auto callback = base::BindOnce(
+      [](mojo::Remote<mojom::ElectronSyncReply> reply,
+         blink::CloneableMessage result) { reply->Reply(std::move(result)); },
+      mojo::Remote<mojom::ElectronSyncReply>(std::move(reply)));
+  MessageSync(internal, channel, std::move(arguments), trace_id,
+              std::move(callback));
+}
+
+WebContents::MessageSyncCallback WebContents::WrapSyncReply(
+    bool internal,
+    const std::string& channel,
+    MessageSyncCallback callback) {
+  base::TimeDelta budget = IpcMetrics::GetInstance()->sync_budget();
+  if (internal || budget.is_zero())
+    return callback;
+  return base::BindOnce(&WebContents::OnSyncReply, GetWeakPtr(), channel,
+                        base::TimeTicks::Now(), budget, std::move(callback));
+}
+
+// static
+void WebContents::OnSyncReply(base::WeakPtr<WebContents> web_contents,
+                              std::string channel,
+                              base::TimeTicks start,
+                              base::TimeDelta budget,
+                              MessageSyncCallback callback,
+                              blink::CloneableMessage result) {
+  // Unblock the renderer first.
+  std::move(callback).Run(std::move(result));
+  base::TimeDelta duration = base::TimeTicks::Now() - start;
+  if (duration <= budget)
+    return;
+  IpcMetrics::GetInstance()->RecordOverBudget(channel);
+  // The reply is sent from JavaScript, so emit the event after it returns.
+  base::ThreadTaskRunnerHandle::Get()->PostTask(
+      FROM_HERE, base::BindOnce(&WebContents::EmitSlowSyncReply, web_contents,
+                                channel, duration));
+}
+
+void WebContents::EmitSlowSyncReply(const std::string& channel,
+                                    base::TimeDelta duration) {
+  Emit("ipc-message-sync-slow", channel, duration.InMillisecondsF());
 }
 
 void WebContents::MessageTo(bool internal,
@@ -1093,24 +1603,156 @@ void WebContents::MessageHost(const std::string& channel,
                  InvokeCallback(), channel, std::move(arguments));
 }
 
+void WebContents::OpenPeerChannel(int32_t web_contents_id,
+                                  const std::string& channel,
+                                  OpenPeerChannelCallback callback) {
+  TRACE_EVENT1("electron", "WebContents::OpenPeerChannel", "channel", channel);
+  auto* web_contents = gin_helper::TrackableObject<WebContents>::FromWeakMapID(
+      isolate(), web_contents_id);
+  content::RenderFrameHost* frame_host =
+      web_contents ? web_contents->web_contents()->GetMainFrame() : nullptr;
+  if (!frame_host || !frame_host->IsRenderFrameLive()) {
+    std::move(callback).Run(nullptr);
+    return;
+  }
+
+  // The browser only hands out the pipes; once both ends are bound in the
+  // renderers the messages no longer pass through this process.
+  mojo::PendingRemote<mojom::ElectronPeerChannel> to_target;
+  mojo::PendingRemote<mojom::ElectronPeerChannel> to_sender;
+  auto target_receiver = to_target.InitWithNewPipeAndPassReceiver();
+  auto sender_receiver = to_sender.InitWithNewPipeAndPassReceiver();
+
+  mojo::AssociatedRemote<mojom::ElectronRenderer> electron_renderer;
+  frame_host->GetRemoteAssociatedInterfaces()->GetInterface(&electron_renderer);
+  electron_renderer->ReceivePeerChannel(
+      channel,
+      mojom::ElectronPeerChannelEndpoint::New(std::move(to_sender),
+                                              std::move(target_receiver)),
+      ID());
+
+  std::move(callback).Run(mojom::ElectronPeerChannelEndpoint::New(
+      std::move(to_target), std::move(sender_receiver)));
+}
+
+void WebContents::BindPriorityLane(
+    mojo::PendingReceiver<mojom::ElectronBrowser> receiver) {
+  // The pipe is watched from the UI thread's user blocking queue, so its
+  // messages get dispatched before the default priority work that handles the
+  // other pipes of the frame.
+  auto* frame_host = bindings_.dispatch_context();
+  auto id = bindings_.AddBinding(
+      this, mojom::ElectronBrowserRequest(receiver.PassPipe()), frame_host,
+      base::CreateSingleThreadTaskRunner(
+          {content::BrowserThread::UI, base::TaskPriority::USER_BLOCKING}));
+  frame_to_bindings_map_[frame_host].push_back(id);
+}
+
+void WebContents::OpenRingBuffer(const std::string& channel,
+                                 uint32_t capacity,
+                                 OpenRingBufferCallback callback) {
+  TRACE_EVENT1("electron", "WebContents::OpenRingBuffer", "channel", channel);
+  base::UnsafeSharedMemoryRegion region;
+  base::WritableSharedMemoryMapping mapping;
+  if (IpcRingBuffer::IsValidCapacity(capacity)) {
+    region = base::UnsafeSharedMemoryRegion::Create(
+        IpcRingBuffer::GetMemorySize(capacity));
+    mapping = region.Map();
+  }
+  if (!mapping.IsValid()) {
+    std::move(callback).Run(base::UnsafeSharedMemoryRegion(),
+                            mojo::NullRemote());
+    return;
+  }
+
+  // The ring buffers are removed in RenderFrameDeleted, so the frame outlives
+  // the callback.
+  auto* frame_host = bindings_.dispatch_context();
+  mojo::PendingRemote<mojom::ElectronRingBuffer> doorbell;
+  auto id = ring_buffers_.Add(
+      std::make_unique<IpcRingBufferHost>(
+          channel, capacity, std::move(mapping),
+          base::BindRepeating(&WebContents::OnRingBufferRecords,
+                              base::Unretained(this), frame_host)),
+      doorbell.InitWithNewPipeAndPassReceiver(), frame_host);
+  frame_to_ring_buffers_map_[frame_host].push_back(id);
+  std::move(callback).Run(std::move(region), std::move(doorbell));
+}
+
+void WebContents::OnRingBufferRecords(content::RenderFrameHost* frame_host,
+                                      const std::string& channel,
+                                      std::vector<uint8_t> data,
+                                      std::vector<uint32_t> sizes) {
+  v8::Locker locker(isolate());
+  v8::HandleScope handle_scope(isolate());
+  // All the records of a batch share one ArrayBuffer, each record starting 8
+  // byte aligned so that it can be viewed as any typed array.
+  auto buffer = v8::ArrayBuffer::New(isolate(), data.size());
+  memcpy(buffer->GetContents().Data(), data.data(), data.size());
+  auto records = v8::Array::New(isolate(), sizes.size());
+  auto context = isolate()->GetCurrentContext();
+  size_t offset = 0;
+  for (size_t i = 0; i < sizes.size(); ++i) {
+    ignore_result(records->Set(context, i,
+                               v8::Uint8Array::New(buffer, offset, sizes[i])));
+    offset += base::bits::Align(sizes[i], 8);
+  }
+  // webContents.emit('-ipc-ring-buffer', new Event(), channel, records);
+  EmitWithSender("-ipc-ring-buffer", frame_host, InvokeCallback(), channel,
+                 records);
+}
+
 #if BUILDFLAG(ENABLE_REMOTE_MODULE)
-void WebContents::DereferenceRemoteJSObject(const std::string& context_id,
-                                            int object_id,
-                                            int ref_count) {
+void WebContents::DereferenceRemoteJSObjects(
+    const std::string& context_id,
+    std::vector<mojom::RemoteObjectRefPtr> refs) {
+  // One message for the whole batch, as pairs of the id and the ref count.
   base::ListValue args;
   args.Append(context_id);
-  args.Append(object_id);
-  args.Append(ref_count);
+  for (const auto& ref : refs) {
+    args.Append(ref->object_id);
+    args.Append(ref->ref_count);
+  }
   EmitWithSender("-ipc-message", bindings_.dispatch_context(), InvokeCallback(),
                  /* internal */ true, "ELECTRON_BROWSER_DEREFERENCE",
                  std::move(args));
 }
 #endif
 
+void WebContents::NotifyNearHeapLimit(uint64_t current_heap_limit,
+                                      uint64_t initial_heap_limit) {
+  Emit("near-heap-limit", current_heap_limit, initial_heap_limit);
+}
+
 void WebContents::UpdateDraggableRegions(
     std::vector<mojom::DraggableRegionPtr> regions) {
+  // The renderer sends the regions on each layout, which happens on every
+  // frame of an animation, so only the last regions of a frame are used.
+  pending_draggable_regions_ = std::move(regions);
+  if (!draggable_regions_timer_.IsRunning()) {
+    draggable_regions_timer_.Start(
+        FROM_HERE, kDraggableRegionsInterval,
+        base::BindOnce(&WebContents::FlushDraggableRegions,
+                       base::Unretained(this)));
+  }
+}
+
+void WebContents::FlushDraggableRegions() {
+  if (!pending_draggable_regions_)
+    return;
+  std::vector<mojom::DraggableRegionPtr> regions =
+      std::move(*pending_draggable_regions_);
+  pending_draggable_regions_.reset();
+
+  // Rebuilding the regions of the window is skipped when they did not change.
+  if (regions.size() == draggable_regions_.size() &&
+      std::equal(regions.begin(), regions.end(), draggable_regions_.begin(),
+                 [](const auto& a, const auto& b) { return a.Equals(b); }))
+    return;
+  draggable_regions_ = std::move(regions);
+
   for (ExtendedWebContentsObserver& observer : observers_)
-    observer.OnDraggableRegionsUpdated(regions);
+    observer.OnDraggableRegionsUpdated(draggable_regions_);
 }
 
 void WebContents::RenderFrameDeleted(
@@ -1120,16 +1762,33 @@ void WebContents::RenderFrameDeleted(
   // that no longer exist. To prevent this from happening, when a
   // RenderFrameHost goes away, we close all the bindings related to that
   // frame.
+  auto ring_buffers = frame_to_ring_buffers_map_.find(render_frame_host);
+  if (ring_buffers != frame_to_ring_buffers_map_.end()) {
+    for (auto id : ring_buffers->second)
+      ring_buffers_.Remove(id);
+    frame_to_ring_buffers_map_.erase(ring_buffers);
+  }
+  zoom_observers_.erase(render_frame_host);
+
   auto it = frame_to_bindings_map_.find(render_frame_host);
   if (it == frame_to_bindings_map_.end())
     return;
-  for (auto id : it->second)
+  for (auto id : it->second) {
     bindings_.RemoveBinding(id);
+    registered_channels_.erase(id);
+  }
   frame_to_bindings_map_.erase(it);
 }
 
 void WebContents::DidStartNavigation(
     content::NavigationHandle* navigation_handle) {
+  // Any navigation brings a discarded page back.
+  if (navigation_handle->IsInMainFrame())
+    discarded_ = false;
+  auto* predictor = GetBrowserContext()->preconnect_predictor();
+  if (predictor && navigation_handle->IsInMainFrame() &&
+      !navigation_handle->IsSameDocument())
+    predictor->OnMainFrameNavigationStarted(navigation_handle->GetURL());
   EmitNavigationEvent("did-start-navigation", navigation_handle);
 }
 
@@ -1150,16 +1809,24 @@ void WebContents::DidFinishNavigation(
     frame_process_id = frame_host->GetProcess()->GetID();
     frame_routing_id = frame_host->GetRoutingID();
   }
+  auto* predictor = GetBrowserContext()->preconnect_predictor();
+  if (predictor && is_main_frame && !navigation_handle->IsErrorPage() &&
+      !navigation_handle->IsSameDocument())
+    predictor->OnMainFrameNavigationCommitted(navigation_handle->GetURL());
   if (!navigation_handle->IsErrorPage()) {
     // FIXME: All the Emit() calls below could potentially result in |this|
     // being destroyed (by JS listening for the event and calling
     // webContents.destroy()).
     auto url = navigation_handle->GetURL();
     bool is_same_document = navigation_handle->IsSameDocument();
+    bool emit_frame_events =
+        is_main_frame || !main_frame_navigation_events_only_;
     if (is_same_document) {
-      Emit("did-navigate-in-page", url, is_main_frame, frame_process_id,
-           frame_routing_id);
-    } else {
+      if (emit_frame_events)
+        Emit("did-navigate-in-page", url, is_main_frame, frame_process_id,
+             frame_routing_id);
+    } else if (HasListeners("did-navigate") ||
+               (emit_frame_events && HasListeners("did-frame-navigate"))) {
       const net::HttpResponseHeaders* http_response =
           navigation_handle->GetResponseHeaders();
       std::string http_status_text;
@@ -1168,8 +1835,9 @@ void WebContents::DidFinishNavigation(
         http_status_text = http_response->GetStatusText();
         http_response_code = http_response->response_code();
       }
-      Emit("did-frame-navigate", url, http_response_code, http_status_text,
-           is_main_frame, frame_process_id, frame_routing_id);
+      if (emit_frame_events)
+        Emit("did-frame-navigate", url, http_response_code, http_status_text,
+             is_main_frame, frame_process_id, frame_routing_id);
       if (is_main_frame) {
         Emit("did-navigate", url, http_response_code, http_status_text);
       }
@@ -1289,6 +1957,11 @@ void WebContents::WebContentsDestroyed() {
   // also do not want any method to be used, so just mark as destroyed here.
   MarkDestroyed();
 
+  auto weak_this = GetWeakPtr();
+  addon_hooks::DispatchEvent(ELECTRON_EVENT_TARGET_WEB_CONTENTS, ID(),
+                             "destroyed");
+  if (!weak_this)
+    return;
   Emit("destroyed");
 
   // For guest view based on OOPIF, the WebContents is released by the embedder
@@ -1309,8 +1982,28 @@ void WebContents::NavigationEntryCommitted(
 }
 
 void WebContents::SetBackgroundThrottling(bool allowed) {
-  background_throttling_ = allowed;
+  background_throttling_policy_.timers = allowed;
+  background_throttling_policy_.animation_frames = allowed;
+  ApplyBackgroundThrottlingPolicy();
+}
+
+void WebContents::SetBackgroundThrottlingPolicy(
+    const BackgroundThrottlingPolicy& policy) {
+  background_throttling_policy_ = policy;
+
+  // The media switch is passed to the renderer processes when they start.
+  auto* web_preferences = WebContentsPreferences::From(web_contents());
+  if (web_preferences) {
+    base::DictionaryValue media;
+    media.SetPath({options::kBackgroundThrottlingPolicy, "media"},
+                  base::Value(policy.media));
+    web_preferences->Merge(media);
+  }
 
+  ApplyBackgroundThrottlingPolicy();
+}
+
+void WebContents::ApplyBackgroundThrottlingPolicy() {
   auto* rfh = web_contents()->GetMainFrame();
   if (!rfh)
     return;
@@ -1324,10 +2017,11 @@ void WebContents::SetBackgroundThrottling(bool allowed) {
   if (!rwh_impl)
     return;
 
-  rwh_impl->disable_hidden_ = !background_throttling_;
-  web_contents()->GetRenderViewHost()->SetSchedulerThrottling(allowed);
+  const auto& policy = background_throttling_policy_;
+  rwh_impl->disable_hidden_ = !policy.animation_frames;
+  web_contents()->GetRenderViewHost()->SetSchedulerThrottling(policy.timers);
 
-  if (rwh_impl->is_hidden()) {
+  if (rwh_impl->is_hidden() && rwh_impl->disable_hidden_) {
     rwh_impl->WasShown(base::nullopt);
   }
 }
@@ -1507,6 +2201,35 @@ bool WebContents::IsCrashed() const {
   return web_contents()->IsCrashed();
 }
 
+bool WebContents::Discard() {
+  if (discarded_)
+    return true;
+  // Mirrors the tab discarding of Chrome: the renderer is shut down when this
+  // is its only page, and the navigation entries are kept to reload it.
+  discarded_ = true;
+  web_contents()->SetWasDiscarded(true);
+  auto* process = web_contents()->GetMainFrame()->GetProcess();
+  if (!process->FastShutdownIfPossible(1, true /* skip_unload_handlers */)) {
+    discarded_ = false;
+    web_contents()->SetWasDiscarded(false);
+    return false;
+  }
+  web_contents()->GetController().SetNeedsReload();
+  Emit("discarded");
+  return true;
+}
+
+bool WebContents::IsDiscarded() const {
+  return discarded_;
+}
+
+void WebContents::Restore() {
+  if (!discarded_)
+    return;
+  discarded_ = false;
+  web_contents()->GetController().LoadIfNecessary();
+}
+
 void WebContents::SetUserAgent(const std::string& user_agent,
                                gin_helper::Arguments* args) {
   web_contents()->SetUserAgentOverride(user_agent, false);
@@ -1874,23 +2597,33 @@ void WebContents::Print(gin_helper::Arguments* args) {
 }
 
 std::vector<printing::PrinterBasicInfo> WebContents::GetPrinterList() {
-  std::vector<printing::PrinterBasicInfo> printers;
-  auto print_backend = printing::PrintBackend::CreateInstance(
-      nullptr, g_browser_process->GetApplicationLocale());
-  {
-    // TODO(deepak1556): Deprecate this api in favor of an
-    // async version and post a non blocing task call.
-    base::ThreadRestrictions::ScopedAllowIO allow_io;
-    print_backend->EnumeratePrinters(&printers);
-  }
-  return printers;
+  // TODO(deepak1556): Deprecate this api in favor of GetPrinterListAsync.
+  base::ThreadRestrictions::ScopedAllowIO allow_io;
+  return EnumeratePrinters(g_browser_process->GetApplicationLocale());
 }
 
-v8::Local<v8::Promise> WebContents::PrintToPDF(base::DictionaryValue settings) {
+v8::Local<v8::Promise> WebContents::GetPrinterListAsync() {
+  using PrintersPromise =
+      gin_helper::Promise<std::vector<printing::PrinterBasicInfo>>;
+  PrintersPromise promise(isolate());
+  v8::Local<v8::Promise> handle = promise.GetHandle();
+  base::PostTaskAndReplyWithResult(
+      FROM_HERE,
+      {base::ThreadPool(), base::MayBlock(), base::TaskPriority::USER_VISIBLE,
+       base::TaskShutdownBehavior::SKIP_ON_SHUTDOWN},
+      base::BindOnce(&EnumeratePrinters,
+                     g_browser_process->GetApplicationLocale()),
+      base::BindOnce(&PrintersPromise::ResolvePromise, std::move(promise)));
+  return handle;
+}
+
+v8::Local<v8::Promise> WebContents::PrintToPDF(
+    base::DictionaryValue settings,
+    const base::FilePath& output_path) {
   gin_helper::Promise<v8::Local<v8::Value>> promise(isolate());
   v8::Local<v8::Promise> handle = promise.GetHandle();
   PrintPreviewMessageHandler::FromWebContents(web_contents())
-      ->PrintToPDF(std::move(settings), std::move(promise));
+      ->PrintToPDF(std::move(settings), output_path, std::move(promise));
   return handle;
 }
 #endif
@@ -2048,13 +2781,34 @@ bool WebContents::SendIPCMessageWithSender(bool internal,
     target_hosts = web_contents()->GetAllFrames();
   }
 
-  for (auto* frame_host : target_hosts) {
-    mojo::AssociatedRemote<mojom::ElectronRenderer> electron_renderer;
-    frame_host->GetRemoteAssociatedInterfaces()->GetInterface(
-        &electron_renderer);
-    electron_renderer->Message(internal, false, channel, args.ShallowClone(),
-                               sender_id);
+  SendMessageToFrames(target_hosts, internal, channel, args, sender_id);
+  return true;
+}
+
+// static
+bool WebContents::Broadcast(v8::Isolate* isolate,
+                            const std::string& channel,
+                            v8::Local<v8::Value> args,
+                            const std::vector<int32_t>& web_contents_ids) {
+  blink::CloneableMessage message;
+  if (!gin::ConvertFromV8(isolate, args, &message)) {
+    isolate->ThrowException(v8::Exception::Error(
+        gin::StringToV8(isolate, "Failed to serialize arguments")));
+    return false;
   }
+
+  std::vector<content::RenderFrameHost*> frame_hosts;
+  for (int32_t id : web_contents_ids) {
+    auto* web_contents =
+        gin_helper::TrackableObject<WebContents>::FromWeakMapID(isolate, id);
+    if (!web_contents)
+      continue;
+    auto* frame_host = web_contents->web_contents()->GetMainFrame();
+    if (frame_host)
+      frame_hosts.push_back(frame_host);
+  }
+  SendMessageToFrames(frame_hosts, false /* internal */, channel, message,
+                      0 /* sender_id */);
   return true;
 }
 
@@ -2078,93 +2832,348 @@ bool WebContents::SendIPCMessageToFrame(bool internal,
   if (!(*iter)->IsRenderFrameLive())
     return false;
 
+  uint64_t trace_id = NewIpcTraceId();
+  TRACE_EVENT_WITH_FLOW1(
+      "electron", "WebContents::SendIPCMessage", TRACE_ID_GLOBAL(trace_id),
+      IpcTraceFlowFlags(trace_id, TRACE_EVENT_FLAG_FLOW_OUT), "channel",
+      channel);
   mojo::AssociatedRemote<mojom::ElectronRenderer> electron_renderer;
   (*iter)->GetRemoteAssociatedInterfaces()->GetInterface(&electron_renderer);
   electron_renderer->Message(internal, send_to_all, channel, std::move(message),
-                             0 /* sender_id */);
+                             0 /* sender_id */, trace_id);
   return true;
 }
 
+bool WebContents::SendIPCMessageBatch(bool internal,
+                                      const std::vector<std::string>& channels,
+                                      v8::Local<v8::Value> args,
+                                      bool as_arrays) {
+  blink::CloneableMessage message;
+  if (!gin::ConvertFromV8(isolate(), args, &message)) {
+    isolate()->ThrowException(v8::Exception::Error(
+        gin::StringToV8(isolate(), "Failed to serialize arguments")));
+    return false;
+  }
+  auto* frame_host = web_contents()->GetMainFrame();
+  if (!frame_host)
+    return false;
+
+  mojo::AssociatedRemote<mojom::ElectronRenderer> electron_renderer;
+  frame_host->GetRemoteAssociatedInterfaces()->GetInterface(&electron_renderer);
+  electron_renderer->MessageBatch(internal, channels, std::move(message),
+                                  as_arrays, 0 /* sender_id */);
+  return true;
+}
+
+bool WebContents::SendIPCMessageWithTransfer(
+    bool internal,
+    const std::string& channel,
+    v8::Local<v8::Value> args,
+    const std::vector<v8::Local<v8::Value>>& transfer) {
+  blink::CloneableMessage message;
+  std::vector<mojo_base::BigBuffer> array_buffers;
+  // The serializer throws when |transfer| holds something it cannot move.
+  if (!gin::SerializeWithTransfer(isolate(), args, transfer, &message,
+                                  &array_buffers))
+    return false;
+  auto* frame_host = web_contents()->GetMainFrame();
+  if (!frame_host)
+    return false;
+
+  mojo::AssociatedRemote<mojom::ElectronRenderer> electron_renderer;
+  frame_host->GetRemoteAssociatedInterfaces()->GetInterface(&electron_renderer);
+  electron_renderer->MessageWithTransfer(internal, channel, std::move(message),
+                                         std::move(array_buffers),
+                                         0 /* sender_id */);
+  return true;
+}
+
+bool WebContents::SendSharedMemory(const std::string& channel,
+                                   gin::Handle<SharedMemory> memory,
+                                   const gin_helper::Dictionary& options) {
+  content::RenderFrameHost* frame_host = web_contents()->GetMainFrame();
+  int32_t frame_id;
+  if (options.Get("frameId", &frame_id)) {
+    auto frames = web_contents()->GetAllFrames();
+    auto iter = std::find_if(frames.begin(), frames.end(), [frame_id](auto* f) {
+      return f->GetRoutingID() == frame_id;
+    });
+    frame_host = iter == frames.end() ? nullptr : *iter;
+  }
+  if (!frame_host || !frame_host->IsRenderFrameLive())
+    return false;
+
+  bool shared = false;
+  options.Get("shared", &shared);
+  mojo::AssociatedRemote<mojom::ElectronRenderer> electron_renderer;
+  frame_host->GetRemoteAssociatedInterfaces()->GetInterface(&electron_renderer);
+  electron_renderer->ReceiveSharedMemory(channel, memory->DuplicateRegion(),
+                                         shared, 0 /* sender_id */);
+  return true;
+}
+
+std::set<int> WebContents::NotifyMemoryPressure(
+    base::MemoryPressureListener::MemoryPressureLevel level,
+    std::set<int> notified) {
+  for (auto* frame_host : web_contents()->GetAllFrames()) {
+    if (!frame_host->IsRenderFrameLive() ||
+        !notified.insert(frame_host->GetProcess()->GetID()).second)
+      continue;
+    mojo::AssociatedRemote<mojom::ElectronRenderer> electron_renderer;
+    frame_host->GetRemoteAssociatedInterfaces()->GetInterface(
+        &electron_renderer);
+    electron_renderer->NotifyMemoryPressure(level);
+  }
+  return notified;
+}
+
 void WebContents::SendInputEvent(v8::Isolate* isolate,
                                  v8::Local<v8::Value> input_event) {
-  content::RenderWidgetHostView* view =
-      web_contents()->GetRenderWidgetHostView();
-  if (!view)
+  if (!web_contents()->GetRenderWidgetHostView())
+    return;
+
+  if (!ForwardInputEvent(isolate, input_event, nullptr))
+    isolate->ThrowException(v8::Exception::Error(
+        gin::StringToV8(isolate, "Invalid event object")));
+}
+
+void WebContents::SendInputEvents(v8::Isolate* isolate,
+                                  v8::Local<v8::Value> input_events) {
+  if (!input_events->IsArray()) {
+    isolate->ThrowException(v8::Exception::TypeError(
+        gin::StringToV8(isolate, "inputEvents must be an array")));
     return;
+  }
+  if (!web_contents()->GetRenderWidgetHostView())
+    return;
+
+  // The events are converted and forwarded in a single call, with the mouse
+  // moves between other events merged into the last of them.
+  v8::Local<v8::Context> context = isolate->GetCurrentContext();
+  v8::Local<v8::Array> array = input_events.As<v8::Array>();
+  base::Optional<blink::WebMouseEvent> pending_move;
+  for (uint32_t i = 0; i < array->Length(); ++i) {
+    v8::Local<v8::Value> input_event;
+    if (!array->Get(context, i).ToLocal(&input_event) ||
+        !ForwardInputEvent(isolate, input_event, &pending_move)) {
+      FlushMouseMove(&pending_move);
+      std::string error =
+          "Invalid event object at index " + base::NumberToString(i);
+      isolate->ThrowException(
+          v8::Exception::Error(gin::StringToV8(isolate, error)));
+      return;
+    }
+  }
+  FlushMouseMove(&pending_move);
+}
+
+void WebContents::ForwardMouseEvent(const blink::WebMouseEvent& mouse_event) {
+  if (IsOffScreen()) {
+#if BUILDFLAG(ENABLE_OSR)
+    GetOffScreenRenderWidgetHostView()->SendMouseEvent(mouse_event);
+#endif
+  } else {
+    content::RenderWidgetHostView* view =
+        web_contents()->GetRenderWidgetHostView();
+    view->GetRenderWidgetHost()->ForwardMouseEvent(mouse_event);
+  }
+}
 
-  content::RenderWidgetHost* rwh = view->GetRenderWidgetHost();
+bool WebContents::ForwardInputEvent(
+    v8::Isolate* isolate,
+    v8::Local<v8::Value> input_event,
+    base::Optional<blink::WebMouseEvent>* pending_move) {
+  content::RenderWidgetHost* rwh =
+      web_contents()->GetRenderWidgetHostView()->GetRenderWidgetHost();
   blink::WebInputEvent::Type type =
       gin::GetWebInputEventType(isolate, input_event);
   if (blink::WebInputEvent::IsMouseEventType(type)) {
     blink::WebMouseEvent mouse_event;
-    if (gin::ConvertFromV8(isolate, input_event, &mouse_event)) {
-      if (IsOffScreen()) {
-#if BUILDFLAG(ENABLE_OSR)
-        GetOffScreenRenderWidgetHostView()->SendMouseEvent(mouse_event);
-#endif
-      } else {
-        rwh->ForwardMouseEvent(mouse_event);
-      }
-      return;
+    if (!gin::ConvertFromV8(isolate, input_event, &mouse_event))
+      return false;
+    if (pending_move && type == blink::WebInputEvent::kMouseMove) {
+      CoalesceMouseMove(mouse_event, pending_move);
+      return true;
     }
+    FlushMouseMove(pending_move);
+    ForwardMouseEvent(mouse_event);
+    return true;
   } else if (blink::WebInputEvent::IsKeyboardEventType(type)) {
     content::NativeWebKeyboardEvent keyboard_event(
         blink::WebKeyboardEvent::kRawKeyDown,
         blink::WebInputEvent::kNoModifiers, ui::EventTimeForNow());
-    if (gin::ConvertFromV8(isolate, input_event, &keyboard_event)) {
-      rwh->ForwardKeyboardEvent(keyboard_event);
-      return;
-    }
+    if (!gin::ConvertFromV8(isolate, input_event, &keyboard_event))
+      return false;
+    FlushMouseMove(pending_move);
+    rwh->ForwardKeyboardEvent(keyboard_event);
+    return true;
   } else if (type == blink::WebInputEvent::kMouseWheel) {
     blink::WebMouseWheelEvent mouse_wheel_event;
-    if (gin::ConvertFromV8(isolate, input_event, &mouse_wheel_event)) {
-      if (IsOffScreen()) {
+    if (!gin::ConvertFromV8(isolate, input_event, &mouse_wheel_event))
+      return false;
+    FlushMouseMove(pending_move);
+    if (IsOffScreen()) {
 #if BUILDFLAG(ENABLE_OSR)
-        GetOffScreenRenderWidgetHostView()->SendMouseWheelEvent(
-            mouse_wheel_event);
+      GetOffScreenRenderWidgetHostView()->SendMouseWheelEvent(
+          mouse_wheel_event);
 #endif
-      } else {
-        // Chromium expects phase info in wheel events (and applies a
-        // DCHECK to verify it). See: https://crbug.com/756524.
-        mouse_wheel_event.phase = blink::WebMouseWheelEvent::kPhaseBegan;
-        mouse_wheel_event.dispatch_type = blink::WebInputEvent::kBlocking;
-        rwh->ForwardWheelEvent(mouse_wheel_event);
-
-        // Send a synthetic wheel event with phaseEnded to finish scrolling.
-        mouse_wheel_event.has_synthetic_phase = true;
-        mouse_wheel_event.delta_x = 0;
-        mouse_wheel_event.delta_y = 0;
-        mouse_wheel_event.phase = blink::WebMouseWheelEvent::kPhaseEnded;
-        mouse_wheel_event.dispatch_type =
-            blink::WebInputEvent::kEventNonBlocking;
-        rwh->ForwardWheelEvent(mouse_wheel_event);
-      }
-      return;
+    } else {
+      // Chromium expects phase info in wheel events (and applies a
+      // DCHECK to verify it). See: https://crbug.com/756524.
+      mouse_wheel_event.phase = blink::WebMouseWheelEvent::kPhaseBegan;
+      mouse_wheel_event.dispatch_type = blink::WebInputEvent::kBlocking;
+      rwh->ForwardWheelEvent(mouse_wheel_event);
+
+      // Send a synthetic wheel event with phaseEnded to finish scrolling.
+      mouse_wheel_event.has_synthetic_phase = true;
+      mouse_wheel_event.delta_x = 0;
+      mouse_wheel_event.delta_y = 0;
+      mouse_wheel_event.phase = blink::WebMouseWheelEvent::kPhaseEnded;
+      mouse_wheel_event.dispatch_type =
+          blink::WebInputEvent::kEventNonBlocking;
+      rwh->ForwardWheelEvent(mouse_wheel_event);
     }
+    return true;
+  }
+  return false;
+}
+
+void WebContents::CoalesceMouseMove(
+    const blink::WebMouseEvent& mouse_event,
+    base::Optional<blink::WebMouseEvent>* pending_move) {
+  // Moves can only be merged while the buttons and modifiers held stay the
+  // same, otherwise the page would miss the moves they changed in.
+  if (*pending_move &&
+      (*pending_move)->GetModifiers() == mouse_event.GetModifiers() &&
+      (*pending_move)->button == mouse_event.button &&
+      (*pending_move)->pointer_type == mouse_event.pointer_type) {
+    int movement_x = (*pending_move)->movement_x + mouse_event.movement_x;
+    int movement_y = (*pending_move)->movement_y + mouse_event.movement_y;
+    *pending_move = mouse_event;
+    (*pending_move)->movement_x = movement_x;
+    (*pending_move)->movement_y = movement_y;
+    return;
   }
+  FlushMouseMove(pending_move);
+  *pending_move = mouse_event;
+}
 
-  isolate->ThrowException(
-      v8::Exception::Error(gin::StringToV8(isolate, "Invalid event object")));
+void WebContents::FlushMouseMove(
+    base::Optional<blink::WebMouseEvent>* pending_move) {
+  if (!pending_move || !*pending_move)
+    return;
+  ForwardMouseEvent(**pending_move);
+  pending_move->reset();
 }
 
 void WebContents::BeginFrameSubscription(gin_helper::Arguments* args) {
-  bool only_dirty = false;
-  FrameSubscriber::FrameCaptureCallback callback;
+  FrameSubscriber::Options options;
+
+  // The first argument is either onlyDirty or the options.
+  v8::Local<v8::Value> next = args->PeekNext();
+  if (!args->GetNext(&options.only_dirty) && !next.IsEmpty() &&
+      next->IsObject() && !next->IsFunction()) {
+    gin_helper::Dictionary dict;
+    args->GetNext(&dict);
+    dict.Get("onlyDirty", &options.only_dirty);
+    std::string pixel_format;
+    if (dict.Get("pixelFormat", &pixel_format)) {
+      if (pixel_format == "i420") {
+        options.pixel_format = media::PIXEL_FORMAT_I420;
+      } else if (pixel_format != "bgra") {
+        args->ThrowError("pixelFormat must be 'bgra' or 'i420'");
+        return;
+      }
+    }
+    if (dict.Has("size") &&
+        (!dict.Get("size", &options.size) || options.size.IsEmpty())) {
+      args->ThrowError("size must have a positive width and height");
+      return;
+    }
+    if (dict.Has("rect") &&
+        (!dict.Get("rect", &options.rect) || options.rect.IsEmpty())) {
+      args->ThrowError("rect must have a positive width and height");
+      return;
+    }
+    if (dict.Has("scale") &&
+        (!dict.Get("scale", &options.scale) || !(options.scale > 0))) {
+      args->ThrowError("scale must be greater than 0");
+      return;
+    }
+    dict.Get("zeroCopy", &options.zero_copy);
+  }
 
-  args->GetNext(&only_dirty);
+  if (options.pixel_format == media::PIXEL_FORMAT_I420) {
+    FrameSubscriber::I420FrameCaptureCallback callback;
+    if (!args->GetNext(&callback)) {
+      args->ThrowError();
+      return;
+    }
+    frame_subscriber_ =
+        std::make_unique<FrameSubscriber>(web_contents(), callback, options);
+    return;
+  }
+
+  FrameSubscriber::FrameCaptureCallback callback;
   if (!args->GetNext(&callback)) {
     args->ThrowError();
     return;
   }
 
   frame_subscriber_ =
-      std::make_unique<FrameSubscriber>(web_contents(), callback, only_dirty);
+      std::make_unique<FrameSubscriber>(web_contents(), callback, options);
 }
 
 void WebContents::EndFrameSubscription() {
   frame_subscriber_.reset();
 }
 
+void WebContents::StartVideoStream(gin_helper::Arguments* args) {
+  VideoStream::Options options;
+  gin_helper::Dictionary dict;
+  if (args->GetNext(&dict)) {
+    if (dict.Has("codec") && !dict.Get("codec", &options.codec)) {
+      args->ThrowError("codec must be 'vp8' or 'vp9'");
+      return;
+    }
+    int bitrate;
+    if (dict.Get("bitrate", &bitrate)) {
+      if (bitrate < 1000) {
+        args->ThrowError("bitrate must be at least 1000");
+        return;
+      }
+      options.bitrate = bitrate / 1000;
+    }
+    if (dict.Get("fps", &options.frame_rate) &&
+        (options.frame_rate < 1 || options.frame_rate > 60)) {
+      args->ThrowError("fps must be between 1 and 60");
+      return;
+    }
+    if (dict.Has("size") &&
+        (!dict.Get("size", &options.size) || options.size.IsEmpty())) {
+      args->ThrowError("size must have a positive width and height");
+      return;
+    }
+  }
+
+  VideoStream::ChunkCallback callback;
+  if (!args->GetNext(&callback)) {
+    args->ThrowError();
+    return;
+  }
+
+  // The previous stream is stopped before the capturer of the next one is
+  // created.
+  video_stream_.reset();
+  video_stream_ = VideoStream::Create(web_contents(), options, callback);
+  if (!video_stream_)
+    args->ThrowError("Failed to create the video encoder");
+}
+
+void WebContents::StopVideoStream() {
+  video_stream_.reset();
+}
+
 void WebContents::StartDrag(const gin_helper::Dictionary& item,
                             gin_helper::Arguments* args) {
   base::FilePath file;
@@ -2173,8 +3182,17 @@ void WebContents::StartDrag(const gin_helper::Dictionary& item,
     files.push_back(file);
   }
 
-  gin::Handle<NativeImage> icon;
-  if (!item.Get("icon", &icon)) {
+  gfx::Image icon;
+  v8::Local<v8::Value> icon_value;
+  base::FilePath icon_path;
+  gin::Handle<NativeImage> native_image;
+  if (item.Get("icon", &icon_value) && icon_value->IsString() &&
+      gin::ConvertFromV8(isolate(), icon_value, &icon_path)) {
+    icon = LoadDragIcon(isolate(), icon_path);
+  } else if (item.Get("icon", &native_image)) {
+    icon = native_image->image();
+  }
+  if (icon.IsEmpty()) {
     args->ThrowError("Must specify non-empty 'icon' option");
     return;
   }
@@ -2182,47 +3200,86 @@ void WebContents::StartDrag(const gin_helper::Dictionary& item,
   // Start dragging.
   if (!files.empty()) {
     base::MessageLoopCurrent::ScopedNestableTaskAllower allow;
-    DragFileItems(files, icon->image(), web_contents()->GetNativeView());
+    DragFileItems(files, icon, web_contents()->GetNativeView());
   } else {
     args->ThrowError("Must specify either 'file' or 'files' option");
   }
 }
 
 v8::Local<v8::Promise> WebContents::CapturePage(gin_helper::Arguments* args) {
-  gfx::Rect rect;
   gin_helper::Promise<gfx::Image> promise(isolate());
   v8::Local<v8::Promise> handle = promise.GetHandle();
 
-  // get rect arguments if they exist
-  args->GetNext(&rect);
-
   auto* const view = web_contents()->GetRenderWidgetHostView();
   if (!view) {
     promise.Resolve(gfx::Image());
     return handle;
   }
 
-  // Capture full page if user doesn't specify a |rect|.
-  const gfx::Size view_size =
-      rect.IsEmpty() ? view->GetViewBounds().size() : rect.size();
-
-  // By default, the requested bitmap size is the view size in screen
-  // coordinates.  However, if there's more pixel detail available on the
-  // current system, increase the requested bitmap size to capture it all.
-  gfx::Size bitmap_size = view_size;
-  const gfx::NativeView native_view = view->GetNativeView();
-  const float scale = display::Screen::GetScreen()
-                          ->GetDisplayNearestView(native_view)
-                          .device_scale_factor();
-  if (scale > 1.0f)
-    bitmap_size = gfx::ScaleToCeiledSize(view_size, scale);
+  gin_helper::Dictionary options;
+  gfx::Rect source_rect;
+  gfx::Size bitmap_size;
+  if (const char* error = GetCapturePageArea(view, args, &options,
+                                             &source_rect, &bitmap_size)) {
+    promise.RejectWithErrorMessage(error);
+    return handle;
+  }
 
-  view->CopyFromSurface(gfx::Rect(rect.origin(), view_size), bitmap_size,
+  view->CopyFromSurface(source_rect, bitmap_size,
                         base::BindOnce(&OnCapturePageDone, std::move(promise)));
   return handle;
 }
 
+v8::Local<v8::Promise> WebContents::CapturePageBuffer(
+    gin_helper::Arguments* args) {
+  gin_helper::Promise<v8::Local<v8::Value>> promise(isolate());
+  v8::Local<v8::Promise> handle = promise.GetHandle();
+
+  auto* const view = web_contents()->GetRenderWidgetHostView();
+  if (!view) {
+    promise.RejectWithErrorMessage("The page can not be captured");
+    return handle;
+  }
+
+  gin_helper::Dictionary options;
+  gfx::Rect source_rect;
+  gfx::Size bitmap_size;
+  if (const char* error = GetCapturePageArea(view, args, &options,
+                                             &source_rect, &bitmap_size)) {
+    promise.RejectWithErrorMessage(error);
+    return handle;
+  }
+
+  CaptureFormat format = CaptureFormat::kPNG;
+  std::string format_name;
+  if (options.Get("format", &format_name)) {
+    if (format_name == "jpeg") {
+      format = CaptureFormat::kJPEG;
+    } else if (format_name == "raw") {
+      format = CaptureFormat::kRaw;
+    } else if (format_name != "png") {
+      promise.RejectWithErrorMessage("format must be 'png', 'jpeg' or 'raw'");
+      return handle;
+    }
+  }
+  int quality = 90;
+  if (options.Get("quality", &quality) && (quality < 0 || quality > 100)) {
+    promise.RejectWithErrorMessage("quality must be between 0 and 100");
+    return handle;
+  }
+
+  view->CopyFromSurface(
+      source_rect, bitmap_size,
+      base::BindOnce(&OnCapturePageBufferDone, std::move(promise), format,
+                     quality));
+  return handle;
+}
+
 void WebContents::OnCursorChange(const content::WebCursor& cursor) {
+  // Avoid converting the custom cursor image when nobody is listening.
+  if (!HasListeners("cursor-changed"))
+    return;
+
   const content::CursorInfo& info = cursor.info();
 
   if (info.type == ui::CursorType::kCustom) {
@@ -2256,7 +3313,44 @@ bool WebContents::IsOffScreen() const {
 
 #if BUILDFLAG(ENABLE_OSR)
 void WebContents::OnPaint(const gfx::Rect& dirty_rect, const SkBitmap& bitmap) {
-  Emit("paint", dirty_rect, gfx::Image::CreateFrom1xBitmap(bitmap));
+  if (HasListeners("paint")) {
+    if (paint_only_dirty_ &&
+        dirty_rect != gfx::Rect(bitmap.width(), bitmap.height())) {
+      // Only the repainted pixels are copied, into an image of their own.
+      Emit("paint", dirty_rect,
+           gfx::Image::CreateFrom1xBitmap(SkBitmapOperations::CreateTiledBitmap(
+               bitmap, dirty_rect.x(), dirty_rect.y(), dirty_rect.width(),
+               dirty_rect.height())));
+    } else {
+      Emit("paint", dirty_rect, gfx::Image::CreateFrom1xBitmap(bitmap));
+    }
+  }
+  if (HasListeners("paint-buffer"))
+    EmitPaintBuffer(dirty_rect, bitmap);
+  if (addon_hooks::HasPaintHooks(ID()))
+    addon_hooks::DispatchPaint(ID(), dirty_rect, bitmap);
+}
+
+void WebContents::EmitPaintBuffer(const gfx::Rect& dirty_rect,
+                                  const SkBitmap& bitmap) {
+  if (bitmap.drawsNothing())
+    return;
+
+  gin_helper::Locker locker(isolate());
+  v8::HandleScope handle_scope(isolate());
+
+  // The buffer is a view over the pixels of the frame, which are recycled once
+  // the frame has been painted, so it is detached when the handlers return.
+  v8::Local<v8::Object> buffer;
+  if (!node::Buffer::New(isolate(), static_cast<char*>(bitmap.getPixels()),
+                         bitmap.computeByteSize(), [](char*, void*) {},
+                         nullptr)
+           .ToLocal(&buffer))
+    return;
+  Emit("paint-buffer", dirty_rect, buffer,
+       gfx::Size(bitmap.width(), bitmap.height()),
+       static_cast<int>(bitmap.rowBytes()));
+  buffer.As<v8::Uint8Array>()->Buffer()->Detach();
 }
 
 void WebContents::StartPainting() {
@@ -2286,6 +3380,16 @@ int WebContents::GetFrameRate() const {
   auto* osr_wcv = GetOffScreenWebContentsView();
   return osr_wcv ? osr_wcv->GetFrameRate() : 0;
 }
+
+v8::Local<v8::Value> WebContents::GetPaintStats(v8::Isolate* isolate) const {
+  auto* osr_rwhv = GetOffScreenRenderWidgetHostView();
+  gin_helper::Dictionary dict = gin::Dictionary::CreateEmpty(isolate);
+  dict.Set("frameRate",
+           osr_rwhv ? osr_rwhv->GetPacedFrameRate() : GetFrameRate());
+  dict.Set("droppedFrames", osr_rwhv ? osr_rwhv->GetDroppedFrames() : 0);
+  dict.Set("queueDepth", osr_rwhv ? osr_rwhv->GetFramesInFlight() : 0);
+  return dict.GetHandle();
+}
 #endif
 
 void WebContents::Invalidate() {
@@ -2316,6 +3420,8 @@ gfx::Size WebContents::GetSizeForNewRenderView(content::WebContents* wc) {
 
 void WebContents::SetZoomLevel(double level) {
   zoom_controller_->SetZoomLevel(level);
+  // The manual zoom mode does not change the zoom map.
+  ScheduleZoomLevelUpdate();
 }
 
 double WebContents::GetZoomLevel() const {
@@ -2332,7 +3438,8 @@ double WebContents::GetZoomFactor() const {
   return blink::PageZoomLevelToZoomFactor(level);
 }
 
-void WebContents::SetTemporaryZoomLevel(double level) {
+void WebContents::SetTemporaryZoomLevel(double level, uint32_t sequence) {
+  zoom_observers_[bindings_.dispatch_context()].sequence = sequence;
   zoom_controller_->SetTemporaryZoomLevel(level);
 }
 
@@ -2340,6 +3447,62 @@ void WebContents::DoGetZoomLevel(DoGetZoomLevelCallback callback) {
   std::move(callback).Run(GetZoomLevel());
 }
 
+void WebContents::ObserveZoomLevel(
+    mojo::PendingRemote<mojom::ElectronZoomObserver> observer) {
+  if (!host_zoom_subscription_) {
+    host_zoom_subscription_ =
+        content::HostZoomMap::GetForWebContents(web_contents())
+            ->AddZoomLevelChangedCallback(base::BindRepeating(
+                [](base::WeakPtr<WebContents> self,
+                   const content::HostZoomMap::ZoomLevelChange& change) {
+                  if (self)
+                    self->OnHostZoomLevelChanged(change);
+                },
+                GetWeakPtr()));
+  }
+  ZoomObserver& zoom_observer = zoom_observers_[bindings_.dispatch_context()];
+  zoom_observer.remote.reset();
+  zoom_observer.remote.Bind(std::move(observer));
+  zoom_observer.remote->OnZoomLevelChanged(GetZoomLevel(),
+                                           zoom_observer.sequence);
+}
+
+void WebContents::OnHostZoomLevelChanged(
+    const content::HostZoomMap::ZoomLevelChange& change) {
+  if (change.mode == content::HostZoomMap::ZOOM_CHANGED_FOR_HOST ||
+      change.mode == content::HostZoomMap::ZOOM_CHANGED_FOR_SCHEME_AND_HOST) {
+    content::NavigationEntry* entry =
+        web_contents()->GetController().GetLastCommittedEntry();
+    if (!entry)
+      return;
+    GURL url = content::HostZoomMap::GetURLFromEntry(entry);
+    if (change.host != net::GetHostOrSpecFromURL(url))
+      return;
+    if (change.mode == content::HostZoomMap::ZOOM_CHANGED_FOR_SCHEME_AND_HOST &&
+        change.scheme != url.scheme())
+      return;
+  }
+  ScheduleZoomLevelUpdate();
+}
+
+void WebContents::ScheduleZoomLevelUpdate() {
+  if (zoom_observers_.empty() || zoom_level_update_pending_)
+    return;
+  zoom_level_update_pending_ = true;
+  base::ThreadTaskRunnerHandle::Get()->PostTask(
+      FROM_HERE,
+      base::BindOnce(&WebContents::SendZoomLevelUpdate, GetWeakPtr()));
+}
+
+void WebContents::SendZoomLevelUpdate() {
+  zoom_level_update_pending_ = false;
+  double level = GetZoomLevel();
+  for (auto& it : zoom_observers_) {
+    if (it.second.remote.is_bound())
+      it.second.remote->OnZoomLevelChanged(level, it.second.sequence);
+  }
+}
+
 std::vector<base::FilePath::StringType> WebContents::GetPreloadPaths() const {
   auto result = SessionPreferences::GetValidPreloads(GetBrowserContext());
 
@@ -2450,18 +3613,29 @@ v8::Local<v8::Promise> WebContents::TakeHeapSnapshot(
   gin_helper::Promise<void> promise(isolate());
   v8::Local<v8::Promise> handle = promise.GetHandle();
 
-  base::ThreadRestrictions::ScopedAllowIO allow_io;
-  base::File file(file_path,
-                  base::File::FLAG_CREATE_ALWAYS | base::File::FLAG_WRITE);
+  // The file is created on the thread pool, the UI thread does no file I/O.
+  base::PostTaskAndReplyWithResult(
+      FROM_HERE, {base::ThreadPool(), base::MayBlock()},
+      base::BindOnce(&OpenHeapSnapshotFile, file_path),
+      base::BindOnce(&WebContents::OnHeapSnapshotFileOpened,
+                     weak_factory_.GetWeakPtr(), std::move(promise)));
+  return handle;
+}
+
+void WebContents::OnHeapSnapshotFileOpened(gin_helper::Promise<void> promise,
+                                           base::File file) {
   if (!file.IsValid()) {
     promise.RejectWithErrorMessage("takeHeapSnapshot failed");
-    return handle;
+    return;
   }
 
   auto* frame_host = web_contents()->GetMainFrame();
   if (!frame_host) {
+    // Closing the file may block as well.
+    base::PostTask(FROM_HERE, {base::ThreadPool(), base::MayBlock()},
+                   base::BindOnce([](base::File file) {}, std::move(file)));
     promise.RejectWithErrorMessage("takeHeapSnapshot failed");
-    return handle;
+    return;
   }
 
   // This dance with `base::Owned` is to ensure that the interface stays alive
@@ -2484,7 +3658,44 @@ v8::Local<v8::Promise> WebContents::TakeHeapSnapshot(
             }
           },
           base::Owned(std::move(electron_renderer)), std::move(promise)));
-  return handle;
+}
+
+v8::Local<v8::Value> WebContents::TakeHeapSnapshotStream(
+    gin_helper::ErrorThrower thrower) {
+  auto* frame_host = web_contents()->GetMainFrame();
+  mojo::ScopedDataPipeProducerHandle producer;
+  mojo::ScopedDataPipeConsumerHandle consumer;
+  MojoCreateDataPipeOptions options = {sizeof(MojoCreateDataPipeOptions),
+                                       MOJO_CREATE_DATA_PIPE_FLAG_NONE, 1,
+                                       kHeapSnapshotPipeCapacity};
+  if (!frame_host ||
+      mojo::CreateDataPipe(&options, &producer, &consumer) != MOJO_RESULT_OK) {
+    thrower.ThrowError("takeHeapSnapshotStream failed");
+    return v8::Undefined(isolate());
+  }
+
+  base::OnceCallback<void(bool)> on_writer_done;
+  v8::Local<v8::Value> reader =
+      CreateDataPipeReader(isolate(), std::move(consumer),
+                           "takeHeapSnapshotStream failed", &on_writer_done);
+
+  auto electron_renderer =
+      std::make_unique<mojo::AssociatedRemote<mojom::ElectronRenderer>>();
+  frame_host->GetRemoteAssociatedInterfaces()->GetInterface(
+      electron_renderer.get());
+  auto* raw_ptr = electron_renderer.get();
+  // The reader fails when the renderer goes away before it replied.
+  (*raw_ptr)->TakeHeapSnapshotToPipe(
+      std::move(producer),
+      mojo::WrapCallbackWithDefaultInvokeIfNotRun(
+          base::BindOnce(
+              [](mojo::AssociatedRemote<mojom::ElectronRenderer>* ep,
+                 base::OnceCallback<void(bool)> on_writer_done,
+                 bool success) { std::move(on_writer_done).Run(success); },
+              base::Owned(std::move(electron_renderer)),
+              std::move(on_writer_done)),
+          false));
+  return reader;
 }
 
 // static
@@ -2493,8 +3704,17 @@ void WebContents::BuildPrototype(v8::Isolate* isolate,
   prototype->SetClassName(gin::StringToV8(isolate, "WebContents"));
   gin_helper::Destroyable::MakeDestroyable(isolate, prototype);
   gin_helper::ObjectTemplateBuilder(isolate, prototype->PrototypeTemplate())
+      .SetMethod("_setListening", &WebContents::SetListening)
       .SetMethod("setBackgroundThrottling",
                  &WebContents::SetBackgroundThrottling)
+      .SetMethod("setBackgroundThrottlingPolicy",
+                 &WebContents::SetBackgroundThrottlingPolicy)
+      .SetMethod("getBackgroundThrottlingPolicy",
+                 &WebContents::GetBackgroundThrottlingPolicy)
+      .SetMethod("setMainFrameNavigationEventsOnly",
+                 &WebContents::SetMainFrameNavigationEventsOnly)
+      .SetMethod("isMainFrameNavigationEventsOnly",
+                 &WebContents::IsMainFrameNavigationEventsOnly)
       .SetMethod("getProcessId", &WebContents::GetProcessID)
       .SetMethod("getOSProcessId", &WebContents::GetOSProcessID)
       .SetMethod("_getOSProcessIdForFrame",
@@ -2512,6 +3732,9 @@ void WebContents::BuildPrototype(v8::Isolate* isolate,
       .SetMethod("_goForward", &WebContents::GoForward)
       .SetMethod("_goToOffset", &WebContents::GoToOffset)
       .SetMethod("isCrashed", &WebContents::IsCrashed)
+      .SetMethod("_discard", &WebContents::Discard)
+      .SetMethod("isDiscarded", &WebContents::IsDiscarded)
+      .SetMethod("restore", &WebContents::Restore)
       .SetMethod("_setUserAgent", &WebContents::SetUserAgent)
       .SetMethod("_getUserAgent", &WebContents::GetUserAgent)
       .SetProperty("userAgent", &WebContents::GetUserAgent,
@@ -2549,9 +3772,16 @@ void WebContents::BuildPrototype(v8::Isolate* isolate,
       .SetMethod("tabTraverse", &WebContents::TabTraverse)
       .SetMethod("_send", &WebContents::SendIPCMessage)
       .SetMethod("_sendToFrame", &WebContents::SendIPCMessageToFrame)
+      .SetMethod("_sendBatch", &WebContents::SendIPCMessageBatch)
+      .SetMethod("_sendWithTransfer", &WebContents::SendIPCMessageWithTransfer)
+      .SetMethod("_sendSharedMemory", &WebContents::SendSharedMemory)
+      .SetMethod("_notifyMemoryPressure", &WebContents::NotifyMemoryPressure)
       .SetMethod("sendInputEvent", &WebContents::SendInputEvent)
+      .SetMethod("sendInputEvents", &WebContents::SendInputEvents)
       .SetMethod("beginFrameSubscription", &WebContents::BeginFrameSubscription)
       .SetMethod("endFrameSubscription", &WebContents::EndFrameSubscription)
+      .SetMethod("startVideoStream", &WebContents::StartVideoStream)
+      .SetMethod("stopVideoStream", &WebContents::StopVideoStream)
       .SetMethod("startDrag", &WebContents::StartDrag)
       .SetMethod("attachToIframe", &WebContents::AttachToIframe)
       .SetMethod("detachFromOuterFrame", &WebContents::DetachFromOuterFrame)
@@ -2564,6 +3794,7 @@ void WebContents::BuildPrototype(v8::Isolate* isolate,
       .SetMethod("_getFrameRate", &WebContents::GetFrameRate)
       .SetProperty("frameRate", &WebContents::GetFrameRate,
                    &WebContents::SetFrameRate)
+      .SetMethod("getPaintStats", &WebContents::GetPaintStats)
 #endif
       .SetMethod("invalidate", &WebContents::Invalidate)
       .SetMethod("_setZoomLevel", &WebContents::SetZoomLevel)
@@ -2587,6 +3818,7 @@ void WebContents::BuildPrototype(v8::Isolate* isolate,
 #if BUILDFLAG(ENABLE_PRINTING)
       .SetMethod("_print", &WebContents::Print)
       .SetMethod("_getPrinters", &WebContents::GetPrinterList)
+      .SetMethod("_getPrintersAsync", &WebContents::GetPrinterListAsync)
       .SetMethod("_printToPDF", &WebContents::PrintToPDF)
 #endif
       .SetMethod("addWorkSpace", &WebContents::AddWorkSpace)
@@ -2595,6 +3827,7 @@ void WebContents::BuildPrototype(v8::Isolate* isolate,
                  &WebContents::ShowDefinitionForSelection)
       .SetMethod("copyImageAt", &WebContents::CopyImageAt)
       .SetMethod("capturePage", &WebContents::CapturePage)
+      .SetMethod("capturePageBuffer", &WebContents::CapturePageBuffer)
       .SetMethod("setEmbedder", &WebContents::SetEmbedder)
       .SetMethod("setDevToolsWebContents", &WebContents::SetDevToolsWebContents)
       .SetMethod("getNativeView", &WebContents::GetNativeView)
@@ -2604,6 +3837,8 @@ void WebContents::BuildPrototype(v8::Isolate* isolate,
                  &WebContents::GetWebRTCIPHandlingPolicy)
       .SetMethod("_grantOriginAccess", &WebContents::GrantOriginAccess)
       .SetMethod("takeHeapSnapshot", &WebContents::TakeHeapSnapshot)
+      .SetMethod("_takeHeapSnapshotStream",
+                 &WebContents::TakeHeapSnapshotStream)
       .SetProperty("id", &WebContents::ID)
       .SetProperty("session", &WebContents::Session)
       .SetProperty("hostWebContents", &WebContents::HostWebContents)
@@ -2660,6 +3895,23 @@ namespace {
 
 using electron::api::WebContents;
 
+void SetIpcMetricsEnabled(bool enabled) {
+  electron::IpcMetrics::GetInstance()->SetEnabled(enabled);
+}
+
+base::Value GetIpcMetrics() {
+  return electron::IpcMetrics::GetInstance()->GetMetrics();
+}
+
+void SetIpcSyncBudget(double milliseconds) {
+  electron::IpcMetrics::GetInstance()->set_sync_budget(
+      base::TimeDelta::FromMillisecondsD(milliseconds));
+}
+
+void ResetIpcMetrics() {
+  electron::IpcMetrics::GetInstance()->Reset();
+}
+
 void Initialize(v8::Local<v8::Object> exports,
                 v8::Local<v8::Value> unused,
                 v8::Local<v8::Context> context,
@@ -2672,6 +3924,12 @@ void Initialize(v8::Local<v8::Object> exports,
   dict.SetMethod("create", &WebContents::Create);
   dict.SetMethod("fromId", &WebContents::FromWeakMapID);
   dict.SetMethod("getAllWebContents", &WebContents::GetAll);
+  dict.SetMethod("getAllWebContentsVersion", &WebContents::GetAllVersion);
+  dict.SetMethod("broadcast", &WebContents::Broadcast);
+  dict.SetMethod("setIpcMetricsEnabled", &SetIpcMetricsEnabled);
+  dict.SetMethod("getIpcMetrics", &GetIpcMetrics);
+  dict.SetMethod("resetIpcMetrics", &ResetIpcMetrics);
+  dict.SetMethod("setIpcSyncBudget", &SetIpcSyncBudget);
 }
 
 }  // namespace
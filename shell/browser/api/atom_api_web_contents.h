@@ -7,13 +7,20 @@
 
 #include <map>
 #include <memory>
+#include <set>
 #include <string>
 #include <vector>
 
+#include "base/files/file.h"
+#include "base/memory/memory_pressure_listener.h"
 #include "base/observer_list.h"
 #include "base/observer_list_types.h"
+#include "base/optional.h"
+#include "base/strings/string_piece.h"
+#include "base/timer/timer.h"
 #include "content/common/cursors/webcursor.h"
 #include "content/public/browser/devtools_agent_host.h"
+#include "content/public/browser/host_zoom_map.h"
 #include "content/public/browser/keyboard_event_processing_result.h"
 #include "content/public/browser/render_widget_host.h"
 #include "content/public/browser/web_contents.h"
@@ -23,11 +30,16 @@
 #include "electron/shell/common/api/api.mojom.h"
 #include "gin/handle.h"
 #include "mojo/public/cpp/bindings/binding_set.h"
+#include "mojo/public/cpp/bindings/remote.h"
+#include "mojo/public/cpp/bindings/unique_receiver_set.h"
 #include "printing/buildflags/buildflags.h"
 #include "services/service_manager/public/cpp/binder_registry.h"
 #include "shell/browser/api/frame_subscriber.h"
 #include "shell/browser/api/save_page_handler.h"
+#include "shell/browser/api/video_stream.h"
 #include "shell/browser/common_web_contents_delegate.h"
+#include "shell/common/gin_helper/error_thrower.h"
+#include "shell/common/gin_helper/promise.h"
 #include "shell/common/gin_helper/trackable_object.h"
 #include "ui/gfx/image/image.h"
 
@@ -41,6 +53,7 @@
 #endif
 
 namespace blink {
+class WebMouseEvent;
 struct WebDeviceEmulationParams;
 }
 
@@ -67,6 +80,8 @@ class OffScreenRenderWidgetHostView;
 
 namespace api {
 
+class SharedMemory;
+
 // Certain events are only in WebContentsDelegate, provide our own Observer to
 // dispatch those events.
 class ExtendedWebContentsObserver : public base::CheckedObserver {
@@ -95,6 +110,21 @@ class WebContents : public gin_helper::TrackableObject<WebContents>,
     OFF_SCREEN,       // Used for offscreen rendering
   };
 
+  // What is throttled while the page is hidden.
+  struct BackgroundThrottlingPolicy {
+    BackgroundThrottlingPolicy();
+
+    // The timers of the page are aligned to one second.
+    bool timers = true;
+    // The page stops producing frames, so requestAnimationFrame stops too.
+    bool animation_frames = true;
+    // The videos of the page are suspended, which only applies to the renderer
+    // processes started afterwards.
+    bool media = true;
+    // A window covered by other windows is treated as hidden.
+    bool occlusion;
+  };
+
   // Create a new WebContents and return the V8 wrapper of it.
   static gin::Handle<WebContents> Create(v8::Isolate* isolate,
                                          const gin_helper::Dictionary& options);
@@ -140,6 +170,17 @@ class WebContents : public gin_helper::TrackableObject<WebContents>,
   void DestroyWebContents(bool async);
 
   void SetBackgroundThrottling(bool allowed);
+  void SetBackgroundThrottlingPolicy(const BackgroundThrottlingPolicy& policy);
+  const BackgroundThrottlingPolicy& GetBackgroundThrottlingPolicy() const {
+    return background_throttling_policy_;
+  }
+  // Stops emitting the navigation events of the sub frames.
+  void SetMainFrameNavigationEventsOnly(bool only) {
+    main_frame_navigation_events_only_ = only;
+  }
+  bool IsMainFrameNavigationEventsOnly() const {
+    return main_frame_navigation_events_only_;
+  }
   int GetProcessID() const;
   base::ProcessId GetOSProcessID() const;
   base::ProcessId GetOSProcessIdForFrame(const std::string& name,
@@ -161,6 +202,12 @@ class WebContents : public gin_helper::TrackableObject<WebContents>,
   const std::string GetWebRTCIPHandlingPolicy() const;
   void SetWebRTCIPHandlingPolicy(const std::string& webrtc_ip_handling_policy);
   bool IsCrashed() const;
+  // Tears down the renderer of the page while keeping its navigation entries,
+  // returns false when the renderer is shared with other pages.
+  bool Discard();
+  bool IsDiscarded() const;
+  // Reloads a discarded page.
+  void Restore();
   void SetUserAgent(const std::string& user_agent, gin_helper::Arguments* args);
   std::string GetUserAgent();
   void InsertCSS(const std::string& css);
@@ -189,8 +236,10 @@ class WebContents : public gin_helper::TrackableObject<WebContents>,
 #if BUILDFLAG(ENABLE_PRINTING)
   void Print(gin_helper::Arguments* args);
   std::vector<printing::PrinterBasicInfo> GetPrinterList();
+  v8::Local<v8::Promise> GetPrinterListAsync();
   // Print current page as PDF.
-  v8::Local<v8::Promise> PrintToPDF(base::DictionaryValue settings);
+  v8::Local<v8::Promise> PrintToPDF(base::DictionaryValue settings,
+                                    const base::FilePath& output_path);
 #endif
 
   // DevTools workspace api.
@@ -237,12 +286,50 @@ class WebContents : public gin_helper::TrackableObject<WebContents>,
                              const std::string& channel,
                              v8::Local<v8::Value> args);
 
+  // Sends a message to the main frames of the WebContents specified by
+  // |web_contents_ids|, serializing it only once.
+  static bool Broadcast(v8::Isolate* isolate,
+                        const std::string& channel,
+                        v8::Local<v8::Value> args,
+                        const std::vector<int32_t>& web_contents_ids);
+
+  // Sends a batch of messages to the main frame in one IPC call, see
+  // mojom::ElectronRenderer::MessageBatch.
+  bool SendIPCMessageBatch(bool internal,
+                           const std::vector<std::string>& channels,
+                           v8::Local<v8::Value> args,
+                           bool as_arrays);
+
+  // Sends a message to the main frame and moves the ArrayBuffers in |transfer|
+  // to it, see mojom::ElectronRenderer::MessageWithTransfer.
+  bool SendIPCMessageWithTransfer(
+      bool internal,
+      const std::string& channel,
+      v8::Local<v8::Value> args,
+      const std::vector<v8::Local<v8::Value>>& transfer);
+
+  // Sends |memory| to the frame |options.frameId|, or to the main frame, which
+  // maps the region instead of receiving a copy of it.
+  bool SendSharedMemory(const std::string& channel,
+                        gin::Handle<SharedMemory> memory,
+                        const gin_helper::Dictionary& options);
+
+  // Sends |level| to the renderer processes of the frames, except those in
+  // |notified|, and returns the processes notified so far.
+  std::set<int> NotifyMemoryPressure(
+      base::MemoryPressureListener::MemoryPressureLevel level,
+      std::set<int> notified);
+
   // Send WebInputEvent to the page.
   void SendInputEvent(v8::Isolate* isolate, v8::Local<v8::Value> input_event);
+  void SendInputEvents(v8::Isolate* isolate,
+                       v8::Local<v8::Value> input_events);
 
   // Subscribe to the frame updates.
   void BeginFrameSubscription(gin_helper::Arguments* args);
   void EndFrameSubscription();
+  void StartVideoStream(gin_helper::Arguments* args);
+  void StopVideoStream();
 
   // Dragging native items.
   void StartDrag(const gin_helper::Dictionary& item,
@@ -251,6 +338,7 @@ class WebContents : public gin_helper::TrackableObject<WebContents>,
   // Captures the page with |rect|, |callback| would be called when capturing is
   // done.
   v8::Local<v8::Promise> CapturePage(gin_helper::Arguments* args);
+  v8::Local<v8::Promise> CapturePageBuffer(gin_helper::Arguments* args);
 
   // Methods for creating <webview>.
   bool IsGuest() const;
@@ -267,6 +355,7 @@ class WebContents : public gin_helper::TrackableObject<WebContents>,
   bool IsPainting() const;
   void SetFrameRate(int frame_rate);
   int GetFrameRate() const;
+  v8::Local<v8::Value> GetPaintStats(v8::Isolate* isolate) const;
 #endif
   void Invalidate();
   gfx::Size GetSizeForNewRenderView(content::WebContents*) override;
@@ -307,6 +396,8 @@ class WebContents : public gin_helper::TrackableObject<WebContents>,
   void GrantOriginAccess(const GURL& url);
 
   v8::Local<v8::Promise> TakeHeapSnapshot(const base::FilePath& file_path);
+  // Returns a reader of the snapshot's chunks as the renderer serializes it.
+  v8::Local<v8::Value> TakeHeapSnapshotStream(gin_helper::ErrorThrower thrower);
 
   // Properties.
   int32_t ID() const;
@@ -326,7 +417,9 @@ class WebContents : public gin_helper::TrackableObject<WebContents>,
       observers_.RemoveObserver(obs);
   }
 
-  bool EmitNavigationEvent(const std::string& event,
+  // Returns whether a listener prevented the default action. Nothing is
+  // computed for the events which have no listeners.
+  bool EmitNavigationEvent(base::StringPiece event,
                            content::NavigationHandle* navigation_handle);
 
   WebContents* embedder() { return embedder_; }
@@ -491,26 +584,97 @@ class WebContents : public gin_helper::TrackableObject<WebContents>,
   void BindElectronBrowser(mojom::ElectronBrowserRequest request,
                            content::RenderFrameHost* render_frame_host);
   void OnElectronBrowserConnectionError();
+  void OnRingBufferConnectionError();
 
   uint32_t GetNextRequestId() { return ++request_id_; }
 
+  // Passes the draggable regions received during the last frame to the
+  // observers.
+  void FlushDraggableRegions();
+
+  // Applies |background_throttling_policy_| to the current widget.
+  void ApplyBackgroundThrottlingPolicy();
+
+  // Converts and forwards |input_event|, returning false when it is not a
+  // valid event. When |pending_move| is passed, mouse moves are held in it to
+  // be merged with the moves that follow them.
+  bool ForwardInputEvent(v8::Isolate* isolate,
+                         v8::Local<v8::Value> input_event,
+                         base::Optional<blink::WebMouseEvent>* pending_move);
+  void ForwardMouseEvent(const blink::WebMouseEvent& mouse_event);
+  void CoalesceMouseMove(const blink::WebMouseEvent& mouse_event,
+                         base::Optional<blink::WebMouseEvent>* pending_move);
+  void FlushMouseMove(base::Optional<blink::WebMouseEvent>* pending_move);
+
+  // Emits a batch of records drained from a ring buffer of |frame_host|.
+  void OnRingBufferRecords(content::RenderFrameHost* frame_host,
+                           const std::string& channel,
+                           std::vector<uint8_t> data,
+                           std::vector<uint32_t> sizes);
+
+  // Returns a callback that reports replies to sync messages on |channel|
+  // which took longer than the sync budget, before running |callback|.
+  MessageSyncCallback WrapSyncReply(bool internal,
+                                    const std::string& channel,
+                                    MessageSyncCallback callback);
+  static void OnSyncReply(base::WeakPtr<WebContents> web_contents,
+                          std::string channel,
+                          base::TimeTicks start,
+                          base::TimeDelta budget,
+                          MessageSyncCallback callback,
+                          blink::CloneableMessage result);
+  void EmitSlowSyncReply(const std::string& channel, base::TimeDelta duration);
+
+  // Sends the snapshot file, opened on the thread pool, to the renderer.
+  void OnHeapSnapshotFileOpened(gin_helper::Promise<void> promise,
+                                base::File file);
+
 #if BUILDFLAG(ENABLE_OSR)
   OffScreenWebContentsView* GetOffScreenWebContentsView() const override;
   OffScreenRenderWidgetHostView* GetOffScreenRenderWidgetHostView() const;
+
+  // Emits "paint-buffer" with a buffer over the pixels of |bitmap|.
+  void EmitPaintBuffer(const gfx::Rect& dirty_rect, const SkBitmap& bitmap);
 #endif
 
   // mojom::ElectronBrowser
   void Message(bool internal,
                const std::string& channel,
-               blink::CloneableMessage arguments) override;
+               blink::CloneableMessage arguments,
+               uint64_t trace_id) override;
+  void MessageBatch(bool internal,
+                    const std::vector<std::string>& channels,
+                    blink::CloneableMessage arguments,
+                    bool as_arrays) override;
+  void RegisterChannel(uint32_t id, const std::string& channel) override;
+  void MessageById(uint32_t channel_id,
+                   blink::CloneableMessage arguments) override;
   void Invoke(bool internal,
               const std::string& channel,
               blink::CloneableMessage arguments,
+              uint64_t trace_id,
               InvokeCallback callback) override;
+  void MessageWithTransfer(
+      bool internal,
+      const std::string& channel,
+      blink::CloneableMessage arguments,
+      std::vector<mojo_base::BigBuffer> array_buffers) override;
+  void InvokeWithTransfer(bool internal,
+                          const std::string& channel,
+                          blink::CloneableMessage arguments,
+                          std::vector<mojo_base::BigBuffer> array_buffers,
+                          InvokeWithTransferCallback callback) override;
   void MessageSync(bool internal,
                    const std::string& channel,
                    blink::CloneableMessage arguments,
+                   uint64_t trace_id,
                    MessageSyncCallback callback) override;
+  void MessageSyncWithReply(
+      bool internal,
+      const std::string& channel,
+      blink::CloneableMessage arguments,
+      uint64_t trace_id,
+      mojo::PendingRemote<mojom::ElectronSyncReply> reply) override;
   void MessageTo(bool internal,
                  bool send_to_all,
                  int32_t web_contents_id,
@@ -518,15 +682,37 @@ class WebContents : public gin_helper::TrackableObject<WebContents>,
                  blink::CloneableMessage arguments) override;
   void MessageHost(const std::string& channel,
                    blink::CloneableMessage arguments) override;
+  void OpenPeerChannel(int32_t web_contents_id,
+                       const std::string& channel,
+                       OpenPeerChannelCallback callback) override;
+  void OpenRingBuffer(const std::string& channel,
+                      uint32_t capacity,
+                      OpenRingBufferCallback callback) override;
+  void BindPriorityLane(
+      mojo::PendingReceiver<mojom::ElectronBrowser> receiver) override;
 #if BUILDFLAG(ENABLE_REMOTE_MODULE)
-  void DereferenceRemoteJSObject(const std::string& context_id,
-                                 int object_id,
-                                 int ref_count) override;
+  void DereferenceRemoteJSObjects(
+      const std::string& context_id,
+      std::vector<mojom::RemoteObjectRefPtr> refs) override;
 #endif
   void UpdateDraggableRegions(
       std::vector<mojom::DraggableRegionPtr> regions) override;
-  void SetTemporaryZoomLevel(double level) override;
+  void NotifyNearHeapLimit(uint64_t current_heap_limit,
+                           uint64_t initial_heap_limit) override;
+  void SetTemporaryZoomLevel(double level, uint32_t sequence) override;
   void DoGetZoomLevel(DoGetZoomLevelCallback callback) override;
+  void ObserveZoomLevel(
+      mojo::PendingRemote<mojom::ElectronZoomObserver> observer) override;
+
+  // Sends the zoom level to the frames observing it once the current task is
+  // done, after the zoom controller settled.
+  void ScheduleZoomLevelUpdate();
+  void SendZoomLevelUpdate();
+  // Only the changes for the host of the page, or for no host in particular,
+  // schedule an update, so that zooming one host does not wake up the pages
+  // of all the others.
+  void OnHostZoomLevelChanged(
+      const content::HostZoomMap::ZoomLevelChange& change);
 
   // Called when we receive a CursorChange message from chromium.
   void OnCursorChange(const content::WebCursor& cursor);
@@ -546,6 +732,7 @@ class WebContents : public gin_helper::TrackableObject<WebContents>,
   std::unique_ptr<AtomJavaScriptDialogManager> dialog_manager_;
   std::unique_ptr<WebViewGuestDelegate> guest_delegate_;
   std::unique_ptr<FrameSubscriber> frame_subscriber_;
+  std::unique_ptr<VideoStream> video_stream_;
 
 #if BUILDFLAG(ENABLE_ELECTRON_EXTENSIONS)
   std::unique_ptr<extensions::ScriptExecutor> script_executor_;
@@ -557,18 +744,51 @@ class WebContents : public gin_helper::TrackableObject<WebContents>,
   // The zoom controller for this webContents.
   WebContentsZoomController* zoom_controller_ = nullptr;
 
+  // A frame which caches the zoom level, and the last sequence number it
+  // passed to SetTemporaryZoomLevel.
+  struct ZoomObserver {
+    mojo::Remote<mojom::ElectronZoomObserver> remote;
+    uint32_t sequence = 0;
+  };
+
+  // The frames which cache the zoom level, removed with their frame like the
+  // bindings below, and the subscription to the zoom levels of the hosts
+  // which tells them it changed.
+  std::map<content::RenderFrameHost*, ZoomObserver> zoom_observers_;
+  std::unique_ptr<content::HostZoomMap::Subscription> host_zoom_subscription_;
+  bool zoom_level_update_pending_ = false;
+
   // The type of current WebContents.
   Type type_ = Type::BROWSER_WINDOW;
 
   // Request id used for findInPage request.
   uint32_t request_id_ = 0;
 
-  // Whether background throttling is disabled.
-  bool background_throttling_ = true;
+  // Read from the web preferences, and changed by
+  // setBackgroundThrottlingPolicy().
+  BackgroundThrottlingPolicy background_throttling_policy_;
+
+  // Whether the renderer was torn down by Discard().
+  bool discarded_ = false;
+
+  // Whether the navigation events of the sub frames are not emitted.
+  bool main_frame_navigation_events_only_ = false;
+
+  // The draggable regions the observers were last given, and those waiting
+  // for the end of the frame.
+  std::vector<mojom::DraggableRegionPtr> draggable_regions_;
+  base::Optional<std::vector<mojom::DraggableRegionPtr>>
+      pending_draggable_regions_;
+  base::OneShotTimer draggable_regions_timer_;
 
   // Whether to enable devtools.
   bool enable_devtools_ = true;
 
+#if BUILDFLAG(ENABLE_OSR)
+  // Whether the paint event only carries the repainted area.
+  bool paint_only_dirty_ = false;
+#endif
+
   // Observers of this WebContents.
   base::ObserverList<ExtendedWebContentsObserver> observers_;
 
@@ -581,6 +801,29 @@ class WebContents : public gin_helper::TrackableObject<WebContents>,
   std::map<content::RenderFrameHost*, std::vector<mojo::BindingId>>
       frame_to_bindings_map_;
 
+  // Ring buffers opened by the frames, closed with their frame like the
+  // bindings above.
+  mojo::UniqueReceiverSet<mojom::ElectronRingBuffer, content::RenderFrameHost*>
+      ring_buffers_;
+  std::map<content::RenderFrameHost*, std::vector<mojo::ReceiverId>>
+      frame_to_ring_buffers_map_;
+
+  // A channel registered with mojom::ElectronBrowser::RegisterChannel. The
+  // name is also kept as an internalized V8 string, so that messages sent by
+  // ID are emitted without converting it.
+  struct RegisteredChannel {
+    RegisteredChannel(v8::Isolate* isolate, const std::string& name);
+    RegisteredChannel(RegisteredChannel&&);
+    ~RegisteredChannel();
+
+    std::string name;
+    v8::Global<v8::String> v8_name;
+  };
+
+  // The channels registered on every ElectronBrowser pipe, indexed by ID.
+  std::map<mojo::BindingId, std::vector<RegisteredChannel>>
+      registered_channels_;
+
   base::WeakPtrFactory<WebContents> weak_factory_;
 
   DISALLOW_COPY_AND_ASSIGN(WebContents);
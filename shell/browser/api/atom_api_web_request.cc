@@ -7,8 +7,10 @@
 #include <memory>
 #include <string>
 #include <utility>
+#include <vector>
 
 #include "base/stl_util.h"
+#include "base/trace_event/trace_event.h"
 #include "base/values.h"
 #include "gin/converter.h"
 #include "gin/dictionary.h"
@@ -16,6 +18,8 @@
 #include "shell/browser/api/atom_api_session.h"
 #include "shell/browser/api/atom_api_web_contents.h"
 #include "shell/browser/atom_browser_context.h"
+#include "shell/browser/net/preconnect_predictor.h"
+#include "shell/browser/net/web_request_rules.h"
 #include "shell/common/gin_converters/callback_converter.h"
 #include "shell/common/gin_converters/gurl_converter.h"
 #include "shell/common/gin_converters/net_converter.h"
@@ -41,33 +45,7 @@ template <>
 struct Converter<content::ResourceType> {
   static v8::Local<v8::Value> ToV8(v8::Isolate* isolate,
                                    content::ResourceType type) {
-    const char* result;
-    switch (type) {
-      case content::ResourceType::kMainFrame:
-        result = "mainFrame";
-        break;
-      case content::ResourceType::kSubFrame:
-        result = "subFrame";
-        break;
-      case content::ResourceType::kStylesheet:
-        result = "stylesheet";
-        break;
-      case content::ResourceType::kScript:
-        result = "script";
-        break;
-      case content::ResourceType::kImage:
-        result = "image";
-        break;
-      case content::ResourceType::kObject:
-        result = "object";
-        break;
-      case content::ResourceType::kXhr:
-        result = "xhr";
-        break;
-      default:
-        result = "other";
-    }
-    return StringToV8(isolate, result);
+    return StringToV8(isolate, electron::GetResourceTypeName(type));
   }
 };
 
@@ -87,19 +65,87 @@ struct UserData : public base::SupportsUserData::Data {
   WebRequest* data;
 };
 
-// Test whether the URL of |request| matches |patterns|.
-bool MatchesFilterCondition(extensions::WebRequestInfo* info,
-                            const std::set<URLPattern>& patterns) {
-  if (patterns.empty())
-    return true;
-
-  for (const auto& pattern : patterns) {
-    if (pattern.MatchesURL(info->url))
+// Test whether the filter of any of |listeners| matches |url|.
+template <typename Listeners>
+bool AnyListenerMatches(const Listeners& listeners, const GURL& url) {
+  for (const auto& iter : listeners) {
+    const auto& patterns = iter.second.url_patterns;
+    if (patterns.empty() || patterns.Matches(url))
       return true;
   }
   return false;
 }
 
+// Parses |filter_patterns| into |patterns|, returning the error when one of
+// them is invalid.
+bool ParseURLPatterns(const std::vector<std::string>& filter_patterns,
+                      std::vector<URLPattern>* patterns,
+                      std::string* error) {
+  for (const std::string& filter_pattern : filter_patterns) {
+    URLPattern pattern(URLPattern::SCHEME_ALL);
+    const URLPattern::ParseResult result = pattern.Parse(filter_pattern);
+    if (result != URLPattern::ParseResult::kSuccess) {
+      *error = "Invalid url pattern " + filter_pattern + ": " +
+               URLPattern::GetParseResultString(result);
+      return false;
+    }
+    patterns->push_back(std::move(pattern));
+  }
+  return true;
+}
+
+// Reads a declarative rule from |value|, returning the error when it is
+// invalid.
+bool ReadRule(v8::Isolate* isolate,
+              v8::Local<v8::Value> value,
+              WebRequestRules::Rule* rule,
+              std::string* error) {
+  gin::Dictionary dict(isolate);
+  if (!gin::ConvertFromV8(isolate, value, &dict)) {
+    *error = "Each rule must be an object";
+    return false;
+  }
+
+  std::string action;
+  dict.Get("action", &action);
+  if (action == "block") {
+    rule->action = WebRequestRules::Rule::Action::kBlock;
+  } else if (action == "redirect") {
+    rule->action = WebRequestRules::Rule::Action::kRedirect;
+    if (!dict.Get("redirectURL", &rule->redirect_url) ||
+        !rule->redirect_url.is_valid()) {
+      *error = "Redirect rules must have a valid 'redirectURL'";
+      return false;
+    }
+  } else if (action == "modifyHeaders") {
+    rule->action = WebRequestRules::Rule::Action::kModifyHeaders;
+    dict.Get("setRequestHeaders", &rule->set_request_headers);
+    dict.Get("removeRequestHeaders", &rule->remove_request_headers);
+    dict.Get("setResponseHeaders", &rule->set_response_headers);
+    dict.Get("removeResponseHeaders", &rule->remove_response_headers);
+  } else {
+    *error = "Rule action must be 'block', 'redirect' or 'modifyHeaders'";
+    return false;
+  }
+
+  std::vector<std::string> filter_patterns;
+  dict.Get("urls", &filter_patterns);
+  if (!ParseURLPatterns(filter_patterns, &rule->url_patterns, error))
+    return false;
+
+  static const char* const kResourceTypes[] = {
+      "mainFrame", "subFrame", "stylesheet", "script",
+      "image",     "object",   "xhr",        "other"};
+  dict.Get("resourceTypes", &rule->resource_types);
+  for (const auto& type : rule->resource_types) {
+    if (!base::Contains(kResourceTypes, type)) {
+      *error = "Invalid resource type " + type;
+      return false;
+    }
+  }
+  return true;
+}
+
 // Convert HttpResponseHeaders to V8.
 //
 // Note that while we already have converters for HttpResponseHeaders, we can
@@ -122,6 +168,38 @@ v8::Local<v8::Value> HttpResponseHeadersToV8(
   return gin::ConvertToV8(v8::Isolate::GetCurrent(), response_headers);
 }
 
+// Converts the responseHeaders of the details the first time a listener
+// reads them, which most listeners never do. |info.Data()| holds the raw
+// headers as a one byte string, so the details do not keep the request alive.
+void GetLazyResponseHeaders(v8::Local<v8::Name> name,
+                            const v8::PropertyCallbackInfo<v8::Value>& info) {
+  v8::Local<v8::String> raw = info.Data().As<v8::String>();
+  std::string raw_headers(raw->Length(), '\0');
+  raw->WriteOneByte(info.GetIsolate(),
+                    reinterpret_cast<uint8_t*>(base::data(raw_headers)), 0,
+                    raw->Length(), v8::String::NO_NULL_TERMINATION);
+  auto headers = base::MakeRefCounted<net::HttpResponseHeaders>(raw_headers);
+  info.GetReturnValue().Set(HttpResponseHeadersToV8(headers.get()));
+}
+
+void SetLazyResponseHeaders(gin::Dictionary* details,
+                            const net::HttpResponseHeaders& headers) {
+  v8::Isolate* isolate = details->isolate();
+  const std::string& raw_headers = headers.raw_headers();
+  v8::Local<v8::String> data;
+  if (!v8::String::NewFromOneByte(
+           isolate, reinterpret_cast<const uint8_t*>(raw_headers.data()),
+           v8::NewStringType::kNormal, raw_headers.size())
+           .ToLocal(&data))
+    return;
+  gin::ConvertToV8(isolate, *details)
+      .As<v8::Object>()
+      ->SetLazyDataProperty(isolate->GetCurrentContext(),
+                            gin::StringToV8(isolate, "responseHeaders"),
+                            &GetLazyResponseHeaders, data)
+      .Check();
+}
+
 // Overloaded by multiple types to fill the |details| object.
 void ToDictionary(gin::Dictionary* details, extensions::WebRequestInfo* info) {
   details->Set("id", info->id);
@@ -135,8 +213,7 @@ void ToDictionary(gin::Dictionary* details, extensions::WebRequestInfo* info) {
     details->Set("fromCache", info->response_from_cache);
     details->Set("statusLine", info->response_headers->GetStatusLine());
     details->Set("statusCode", info->response_headers->response_code());
-    details->Set("responseHeaders",
-                 HttpResponseHeadersToV8(info->response_headers.get()));
+    SetLazyResponseHeaders(details, *info->response_headers);
   }
 
   auto* web_contents = content::WebContents::FromRenderFrameHost(
@@ -168,6 +245,10 @@ void ToDictionary(gin::Dictionary* details, int net_error) {
   details->Set("error", net::ErrorToString(net_error));
 }
 
+void ToDictionary(gin::Dictionary* details, const RequestMetrics& metrics) {
+  details->Set("metrics", metrics);
+}
+
 // Helper function to fill |details| with arbitrary |args|.
 template <typename Arg>
 void FillDetails(gin::Dictionary* details, Arg arg) {
@@ -215,16 +296,16 @@ void ReadFromResponse(v8::Isolate* isolate,
 gin::WrapperInfo WebRequest::kWrapperInfo = {gin::kEmbedderNativeGin};
 
 WebRequest::SimpleListenerInfo::SimpleListenerInfo(
-    std::set<URLPattern> patterns_,
+    const std::set<URLPattern>& patterns_,
     SimpleListener listener_)
-    : url_patterns(std::move(patterns_)), listener(listener_) {}
+    : url_patterns(patterns_), listener(listener_) {}
 WebRequest::SimpleListenerInfo::SimpleListenerInfo() = default;
 WebRequest::SimpleListenerInfo::~SimpleListenerInfo() = default;
 
 WebRequest::ResponseListenerInfo::ResponseListenerInfo(
-    std::set<URLPattern> patterns_,
+    const std::set<URLPattern>& patterns_,
     ResponseListener listener_)
-    : url_patterns(std::move(patterns_)), listener(listener_) {}
+    : url_patterns(patterns_), listener(listener_) {}
 WebRequest::ResponseListenerInfo::ResponseListenerInfo() = default;
 WebRequest::ResponseListenerInfo::~ResponseListenerInfo() = default;
 
@@ -255,7 +336,12 @@ gin::ObjectTemplateBuilder WebRequest::GetObjectTemplateBuilder(
                  &WebRequest::SetSimpleListener<kOnResponseStarted>)
       .SetMethod("onErrorOccurred",
                  &WebRequest::SetSimpleListener<kOnErrorOccurred>)
-      .SetMethod("onCompleted", &WebRequest::SetSimpleListener<kOnCompleted>);
+      .SetMethod("onCompleted", &WebRequest::SetSimpleListener<kOnCompleted>)
+      .SetMethod("setRules", &WebRequest::SetRules)
+      .SetMethod("getStats", &WebRequest::GetStats)
+      .SetMethod("setMetricsEnabled", &WebRequest::SetMetricsEnabled)
+      .SetMethod("getMetrics", &WebRequest::GetMetrics)
+      .SetMethod("clearMetrics", &WebRequest::ClearMetrics);
 }
 
 const char* WebRequest::GetTypeName() {
@@ -263,13 +349,39 @@ const char* WebRequest::GetTypeName() {
 }
 
 bool WebRequest::HasListener() const {
-  return !(simple_listeners_.empty() && response_listeners_.empty());
+  return !(simple_listeners_.empty() && response_listeners_.empty() &&
+           rules_.empty());
+}
+
+bool WebRequest::ShouldProxyRequest(const GURL& url) {
+  // The preconnect predictor learns from the completed requests.
+  if (metrics_enabled_ ||
+      static_cast<AtomBrowserContext*>(browser_context_)
+          ->preconnect_predictor()) {
+    ++proxied_requests_;
+    return true;
+  }
+  if (!HasListener())
+    return false;
+
+  bool should_proxy = rules_.MatchesURL(url) ||
+                      AnyListenerMatches(simple_listeners_, url) ||
+                      AnyListenerMatches(response_listeners_, url);
+
+  if (should_proxy)
+    ++proxied_requests_;
+  else
+    ++bypassed_requests_;
+  return should_proxy;
 }
 
 int WebRequest::OnBeforeRequest(extensions::WebRequestInfo* info,
                                 const network::ResourceRequest& request,
                                 net::CompletionOnceCallback callback,
                                 GURL* new_url) {
+  int result = rules_.OnBeforeRequest(*info, new_url);
+  if (result != net::OK)
+    return result;
   return HandleResponseEvent(kOnBeforeRequest, info, std::move(callback),
                              new_url, request);
 }
@@ -278,6 +390,7 @@ int WebRequest::OnBeforeSendHeaders(extensions::WebRequestInfo* info,
                                     const network::ResourceRequest& request,
                                     BeforeSendHeadersCallback callback,
                                     net::HttpRequestHeaders* headers) {
+  rules_.OnBeforeSendHeaders(*info, headers);
   return HandleResponseEvent(
       kOnBeforeSendHeaders, info,
       base::BindOnce(std::move(callback), std::set<std::string>(),
@@ -292,6 +405,8 @@ int WebRequest::OnHeadersReceived(
     const net::HttpResponseHeaders* original_response_headers,
     scoped_refptr<net::HttpResponseHeaders>* override_response_headers,
     GURL* allowed_unsafe_redirect_url) {
+  rules_.OnHeadersReceived(*info, original_response_headers,
+                           override_response_headers);
   return HandleResponseEvent(
       kOnHeadersReceived, info, std::move(callback),
       std::make_pair(override_response_headers,
@@ -326,14 +441,84 @@ void WebRequest::OnErrorOccurred(extensions::WebRequestInfo* info,
 
 void WebRequest::OnCompleted(extensions::WebRequestInfo* info,
                              const network::ResourceRequest& request,
-                             int net_error) {
+                             int net_error,
+                             const RequestMetrics& metrics) {
   callbacks_.erase(info->id);
 
-  HandleSimpleEvent(kOnCompleted, info, request, net_error);
+  metrics_.Add(GetResourceTypeName(info->type), metrics);
+  auto* predictor = static_cast<AtomBrowserContext*>(browser_context_)
+                        ->preconnect_predictor();
+  if (predictor && info->type != content::ResourceType::kMainFrame &&
+      request.request_initiator && net_error == net::OK)
+    predictor->OnSubresourceCompleted(*request.request_initiator, info->url);
+  HandleSimpleEvent(kOnCompleted, info, request, net_error, metrics);
 }
 
 void WebRequest::OnRequestWillBeDestroyed(extensions::WebRequestInfo* info) {
   callbacks_.erase(info->id);
+  filter_matches_.erase(info->id);
+}
+
+bool WebRequest::MatchesFilterCondition(extensions::WebRequestInfo* info,
+                                        uint32_t event_bit,
+                                        const URLPatternIndex& patterns) {
+  if (patterns.empty())
+    return true;
+
+  // The URL only changes on redirects, so the result is computed once for
+  // each phase of the request that has a listener.
+  FilterMatches& matches = filter_matches_[info->id];
+  if (matches.url != info->url) {
+    matches.url = info->url;
+    matches.checked = 0;
+    matches.matched = 0;
+  }
+  if (!(matches.checked & event_bit)) {
+    matches.checked |= event_bit;
+    if (patterns.Matches(info->url))
+      matches.matched |= event_bit;
+  }
+  return matches.matched & event_bit;
+}
+
+void WebRequest::SetRules(gin::Arguments* args) {
+  v8::Local<v8::Value> value;
+  if (!args->GetNext(&value) || !value->IsArray()) {
+    args->ThrowTypeError("Must pass an Array of rules");
+    return;
+  }
+
+  v8::Local<v8::Context> context = args->isolate()->GetCurrentContext();
+  v8::Local<v8::Array> array = value.As<v8::Array>();
+  std::vector<WebRequestRules::Rule> rules(array->Length());
+  for (uint32_t i = 0; i < array->Length(); ++i) {
+    std::string error;
+    if (!ReadRule(args->isolate(), array->Get(context, i).ToLocalChecked(),
+                  &rules[i], &error)) {
+      args->ThrowTypeError(error);
+      return;
+    }
+  }
+  rules_.SetRules(std::move(rules));
+}
+
+v8::Local<v8::Value> WebRequest::GetStats(v8::Isolate* isolate) {
+  gin::Dictionary dict = gin::Dictionary::CreateEmpty(isolate);
+  dict.Set("proxiedRequests", static_cast<double>(proxied_requests_));
+  dict.Set("bypassedRequests", static_cast<double>(bypassed_requests_));
+  return gin::ConvertToV8(isolate, dict);
+}
+
+void WebRequest::SetMetricsEnabled(bool enabled) {
+  metrics_enabled_ = enabled;
+}
+
+v8::Local<v8::Value> WebRequest::GetMetrics(v8::Isolate* isolate) {
+  return gin::ConvertToV8(isolate, metrics_);
+}
+
+void WebRequest::ClearMetrics() {
+  metrics_.Clear();
 }
 
 template <WebRequest::SimpleEvent event>
@@ -393,7 +578,9 @@ void WebRequest::SetListener(Event event,
   if (listener.is_null())
     listeners->erase(event);
   else
-    (*listeners)[event] = {std::move(patterns), std::move(listener)};
+    (*listeners)[event] = {patterns, std::move(listener)};
+  // The requests in progress have to be matched against the new patterns.
+  filter_matches_.clear();
 }
 
 template <typename... Args>
@@ -405,11 +592,13 @@ void WebRequest::HandleSimpleEvent(SimpleEvent event,
     return;
 
   const auto& info = iter->second;
-  if (!MatchesFilterCondition(request_info, info.url_patterns))
+  if (!MatchesFilterCondition(request_info, EventBit(event), info.url_patterns))
     return;
 
   v8::Isolate* isolate = v8::Isolate::GetCurrent();
   v8::HandleScope handle_scope(isolate);
+  TRACE_EVENT1("electron.web_request", "WebRequest::SimpleListener", "url",
+               request_info->url.spec());
   gin::Dictionary details(isolate, v8::Object::New(isolate));
   FillDetails(&details, request_info, args...);
   info.listener.Run(gin::ConvertToV8(isolate, details));
@@ -426,10 +615,14 @@ int WebRequest::HandleResponseEvent(ResponseEvent event,
     return net::OK;
 
   const auto& info = iter->second;
-  if (!MatchesFilterCondition(request_info, info.url_patterns))
+  if (!MatchesFilterCondition(request_info, EventBit(event), info.url_patterns))
     return net::OK;
 
   callbacks_[request_info->id] = std::move(callback);
+  // Lasts until the listener called back, which may be after other events.
+  TRACE_EVENT_NESTABLE_ASYNC_BEGIN1(
+      "electron.web_request", "WebRequest::ResponseListener",
+      TRACE_ID_LOCAL(request_info->id), "url", request_info->url.spec());
 
   v8::Isolate* isolate = v8::Isolate::GetCurrent();
   v8::HandleScope handle_scope(isolate);
@@ -450,6 +643,9 @@ void WebRequest::OnListenerResult(uint64_t id,
   const auto iter = callbacks_.find(id);
   if (iter == std::end(callbacks_))
     return;
+  TRACE_EVENT_NESTABLE_ASYNC_END0("electron.web_request",
+                                  "WebRequest::ResponseListener",
+                                  TRACE_ID_LOCAL(id));
 
   int result = net::OK;
   if (response->IsObject()) {
@@ -14,6 +14,8 @@
 #include "gin/handle.h"
 #include "gin/wrappable.h"
 #include "shell/browser/net/proxying_url_loader_factory.h"
+#include "shell/browser/net/url_pattern_index.h"
+#include "shell/browser/net/web_request_rules.h"
 
 namespace content {
 class BrowserContext;
@@ -49,12 +51,16 @@ class WebRequest : public gin::Wrappable<WebRequest>, public WebRequestAPI {
       v8::Isolate* isolate) override;
   const char* GetTypeName() override;
 
+  // The metrics collected while they are enabled.
+  const RequestMetricsHistogram& metrics() const { return metrics_; }
+
  private:
   WebRequest(v8::Isolate* isolate, content::BrowserContext* browser_context);
   ~WebRequest() override;
 
   // WebRequestAPI:
   bool HasListener() const override;
+  bool ShouldProxyRequest(const GURL& url) override;
   int OnBeforeRequest(extensions::WebRequestInfo* info,
                       const network::ResourceRequest& request,
                       net::CompletionOnceCallback callback,
@@ -83,7 +89,8 @@ class WebRequest : public gin::Wrappable<WebRequest>, public WebRequestAPI {
                        int net_error) override;
   void OnCompleted(extensions::WebRequestInfo* info,
                    const network::ResourceRequest& request,
-                   int net_error) override;
+                   int net_error,
+                   const RequestMetrics& metrics) override;
   void OnRequestWillBeDestroyed(extensions::WebRequestInfo* info) override;
 
   enum SimpleEvent {
@@ -99,11 +106,29 @@ class WebRequest : public gin::Wrappable<WebRequest>, public WebRequestAPI {
     kOnHeadersReceived,
   };
 
+  // The bits identifying each event in FilterMatches.
+  static uint32_t EventBit(SimpleEvent event) { return 1u << event; }
+  static uint32_t EventBit(ResponseEvent event) { return 1u << (8 + event); }
+
   using SimpleListener = base::RepeatingCallback<void(v8::Local<v8::Value>)>;
   using ResponseCallback = base::OnceCallback<void(v8::Local<v8::Value>)>;
   using ResponseListener =
       base::RepeatingCallback<void(v8::Local<v8::Value>, ResponseCallback)>;
 
+  // Replaces the declarative rules, which are applied before the listeners
+  // are called.
+  void SetRules(gin::Arguments* args);
+
+  // Returns the number of requests that went through the proxy, and of those
+  // that bypassed it while there were listeners.
+  v8::Local<v8::Value> GetStats(v8::Isolate* isolate);
+
+  // Makes every request go through the proxy so that the metrics of all of
+  // them are aggregated, and returns or clears those metrics.
+  void SetMetricsEnabled(bool enabled);
+  v8::Local<v8::Value> GetMetrics(v8::Isolate* isolate);
+  void ClearMetrics();
+
   template <SimpleEvent event>
   void SetSimpleListener(gin::Arguments* args);
   template <ResponseEvent event>
@@ -125,20 +150,26 @@ class WebRequest : public gin::Wrappable<WebRequest>, public WebRequestAPI {
   template <typename T>
   void OnListenerResult(uint64_t id, T out, v8::Local<v8::Value> response);
 
+  // Test whether the URL of |info| matches the |patterns| of the listener of
+  // the event identified by |event_bit|.
+  bool MatchesFilterCondition(extensions::WebRequestInfo* info,
+                              uint32_t event_bit,
+                              const URLPatternIndex& patterns);
+
   struct SimpleListenerInfo {
-    std::set<URLPattern> url_patterns;
+    URLPatternIndex url_patterns;
     SimpleListener listener;
 
-    SimpleListenerInfo(std::set<URLPattern>, SimpleListener);
+    SimpleListenerInfo(const std::set<URLPattern>&, SimpleListener);
     SimpleListenerInfo();
     ~SimpleListenerInfo();
   };
 
   struct ResponseListenerInfo {
-    std::set<URLPattern> url_patterns;
+    URLPatternIndex url_patterns;
     ResponseListener listener;
 
-    ResponseListenerInfo(std::set<URLPattern>, ResponseListener);
+    ResponseListenerInfo(const std::set<URLPattern>&, ResponseListener);
     ResponseListenerInfo();
     ~ResponseListenerInfo();
   };
@@ -147,6 +178,22 @@ class WebRequest : public gin::Wrappable<WebRequest>, public WebRequestAPI {
   std::map<ResponseEvent, ResponseListenerInfo> response_listeners_;
   std::map<uint64_t, net::CompletionOnceCallback> callbacks_;
 
+  // Which of the listeners match a request in progress, as bits of the events
+  // they were checked for.
+  struct FilterMatches {
+    GURL url;
+    uint32_t checked = 0;
+    uint32_t matched = 0;
+  };
+  std::map<uint64_t, FilterMatches> filter_matches_;
+
+  uint64_t proxied_requests_ = 0;
+  uint64_t bypassed_requests_ = 0;
+  bool metrics_enabled_ = false;
+  // The metrics of completed requests by resource type.
+  RequestMetricsHistogram metrics_;
+  WebRequestRules rules_;
+
   // Weak-ref, it manages us.
   content::BrowserContext* browser_context_;
 };
@@ -0,0 +1,235 @@
+// Copyright (c) 2020 GitHub, Inc.
+// Use of this source code is governed by the MIT license that can be
+// found in the LICENSE file.
+
+#include <string>
+#include <utility>
+
+#include "base/bind.h"
+#include "base/optional.h"
+#include "base/strings/string_number_conversions.h"
+#include "base/strings/string_util.h"
+#include "base/task/post_task.h"
+#include "shell/common/api/atom_api_native_image.h"
+#include "shell/common/gin_helper/dictionary.h"
+#include "shell/common/gin_helper/locker.h"
+#include "shell/common/gin_helper/promise.h"
+#include "shell/common/node_includes.h"
+#include "shell/common/skia_util.h"
+#include "third_party/boringssl/src/include/openssl/md5.h"
+#include "third_party/boringssl/src/include/openssl/sha.h"
+#include "third_party/zlib/google/compression_utils.h"
+#include "ui/gfx/image/image.h"
+#include "ui/gfx/image/image_skia.h"
+
+namespace gin {
+
+template <>
+struct Converter<base::TaskPriority> {
+  static bool FromV8(v8::Isolate* isolate,
+                     v8::Local<v8::Value> val,
+                     base::TaskPriority* out) {
+    std::string priority;
+    if (!ConvertFromV8(isolate, val, &priority))
+      return false;
+    if (priority == "background")
+      *out = base::TaskPriority::BEST_EFFORT;
+    else if (priority == "user-visible")
+      *out = base::TaskPriority::USER_VISIBLE;
+    else if (priority == "user-blocking")
+      *out = base::TaskPriority::USER_BLOCKING;
+    else
+      return false;
+    return true;
+  }
+};
+
+}  // namespace gin
+
+namespace {
+
+using BufferPromise = gin_helper::Promise<v8::Local<v8::Value>>;
+
+// Reads the Buffer the task works on, and the priority in its options.
+// Returns the error to reject with when they are invalid.
+const char* GetTaskArguments(v8::Local<v8::Value> buffer,
+                             gin::Arguments* args,
+                             std::string* data,
+                             base::TaskPriority* priority) {
+  if (!node::Buffer::HasInstance(buffer))
+    return "buffer must be a node Buffer";
+  data->assign(node::Buffer::Data(buffer), node::Buffer::Length(buffer));
+
+  *priority = base::TaskPriority::USER_VISIBLE;
+  gin_helper::Dictionary options;
+  if (args->GetNext(&options) && options.Has("priority") &&
+      !options.Get("priority", priority))
+    return "priority must be 'background', 'user-visible' or 'user-blocking'";
+  return nullptr;
+}
+
+void ResolveWithBuffer(BufferPromise promise,
+                       const char* error,
+                       base::Optional<std::string> result) {
+  v8::Isolate* isolate = promise.isolate();
+  gin_helper::Locker locker(isolate);
+  v8::HandleScope handle_scope(isolate);
+  v8::Context::Scope context_scope(promise.GetContext());
+  if (!result) {
+    promise.RejectWithErrorMessage(error);
+    return;
+  }
+  promise.Resolve(
+      node::Buffer::Copy(isolate, result->data(), result->size())
+          .ToLocalChecked());
+}
+
+base::Optional<std::string> Gzip(std::string data) {
+  std::string output;
+  if (!compression::GzipCompress(data, &output))
+    return base::nullopt;
+  return output;
+}
+
+base::Optional<std::string> Gunzip(std::string data) {
+  std::string output;
+  if (!compression::GzipUncompress(data, &output))
+    return base::nullopt;
+  return output;
+}
+
+v8::Local<v8::Promise> RunBufferTask(
+    v8::Local<v8::Value> buffer,
+    gin::Arguments* args,
+    base::Optional<std::string> (*task)(std::string),
+    const char* error) {
+  BufferPromise promise(args->isolate());
+  v8::Local<v8::Promise> handle = promise.GetHandle();
+
+  std::string data;
+  base::TaskPriority priority;
+  if (const char* invalid = GetTaskArguments(buffer, args, &data, &priority)) {
+    promise.RejectWithErrorMessage(invalid);
+    return handle;
+  }
+
+  base::PostTaskAndReplyWithResult(
+      FROM_HERE, {base::ThreadPool(), priority},
+      base::BindOnce(task, std::move(data)),
+      base::BindOnce(&ResolveWithBuffer, std::move(promise), error));
+  return handle;
+}
+
+v8::Local<v8::Promise> GzipBuffer(v8::Local<v8::Value> buffer,
+                                  gin::Arguments* args) {
+  return RunBufferTask(buffer, args, &Gzip, "Failed to compress");
+}
+
+v8::Local<v8::Promise> GunzipBuffer(v8::Local<v8::Value> buffer,
+                                    gin::Arguments* args) {
+  return RunBufferTask(buffer, args, &Gunzip, "Failed to decompress");
+}
+
+std::string HashData(const std::string& algorithm, std::string data) {
+  const auto* bytes = reinterpret_cast<const uint8_t*>(data.data());
+  uint8_t digest[SHA256_DIGEST_LENGTH];
+  size_t length;
+  if (algorithm == "md5") {
+    MD5(bytes, data.size(), digest);
+    length = MD5_DIGEST_LENGTH;
+  } else if (algorithm == "sha1") {
+    SHA1(bytes, data.size(), digest);
+    length = SHA_DIGEST_LENGTH;
+  } else {
+    SHA256(bytes, data.size(), digest);
+    length = SHA256_DIGEST_LENGTH;
+  }
+  return base::ToLowerASCII(base::HexEncode(digest, length));
+}
+
+v8::Local<v8::Promise> Hash(const std::string& algorithm,
+                            v8::Local<v8::Value> buffer,
+                            gin::Arguments* args) {
+  gin_helper::Promise<std::string> promise(args->isolate());
+  v8::Local<v8::Promise> handle = promise.GetHandle();
+
+  if (algorithm != "md5" && algorithm != "sha1" && algorithm != "sha256") {
+    promise.RejectWithErrorMessage(
+        "algorithm must be 'md5', 'sha1' or 'sha256'");
+    return handle;
+  }
+
+  std::string data;
+  base::TaskPriority priority;
+  if (const char* invalid = GetTaskArguments(buffer, args, &data, &priority)) {
+    promise.RejectWithErrorMessage(invalid);
+    return handle;
+  }
+
+  base::PostTaskAndReplyWithResult(
+      FROM_HERE, {base::ThreadPool(), priority},
+      base::BindOnce(&HashData, algorithm, std::move(data)),
+      base::BindOnce(&gin_helper::Promise<std::string>::ResolvePromise,
+                     std::move(promise)));
+  return handle;
+}
+
+// The image is decoded off the main thread, so its storage is detached from
+// the decoding sequence before it is handed back.
+base::Optional<gfx::ImageSkia> DecodeImageData(std::string data) {
+  gfx::ImageSkia image;
+  if (!electron::util::AddImageSkiaRepFromBuffer(
+          &image, reinterpret_cast<const unsigned char*>(data.data()),
+          data.size(), 0, 0, 1.0))
+    return base::nullopt;
+  image.MakeThreadSafe();
+  return image;
+}
+
+void ResolveWithImage(BufferPromise promise,
+                      base::Optional<gfx::ImageSkia> image) {
+  v8::Isolate* isolate = promise.isolate();
+  gin_helper::Locker locker(isolate);
+  v8::HandleScope handle_scope(isolate);
+  v8::Context::Scope context_scope(promise.GetContext());
+  if (!image) {
+    promise.RejectWithErrorMessage("Failed to decode image");
+    return;
+  }
+  promise.Resolve(
+      electron::api::NativeImage::Create(isolate, gfx::Image(*image)).ToV8());
+}
+
+v8::Local<v8::Promise> DecodeImage(v8::Local<v8::Value> buffer,
+                                   gin::Arguments* args) {
+  BufferPromise promise(args->isolate());
+  v8::Local<v8::Promise> handle = promise.GetHandle();
+
+  std::string data;
+  base::TaskPriority priority;
+  if (const char* invalid = GetTaskArguments(buffer, args, &data, &priority)) {
+    promise.RejectWithErrorMessage(invalid);
+    return handle;
+  }
+
+  base::PostTaskAndReplyWithResult(
+      FROM_HERE, {base::ThreadPool(), priority},
+      base::BindOnce(&DecodeImageData, std::move(data)),
+      base::BindOnce(&ResolveWithImage, std::move(promise)));
+  return handle;
+}
+
+void Initialize(v8::Local<v8::Object> exports,
+                v8::Local<v8::Value> unused,
+                v8::Local<v8::Context> context,
+                void* priv) {
+  gin_helper::Dictionary dict(context->GetIsolate(), exports);
+  dict.SetMethod("gzip", &GzipBuffer);
+  dict.SetMethod("gunzip", &GunzipBuffer);
+  dict.SetMethod("hash", &Hash);
+  dict.SetMethod("decodeImage", &DecodeImage);
+}
+
+}  // namespace
+
+NODE_LINKED_MODULE_CONTEXT_AWARE(atom_browser_worker_pool, Initialize)
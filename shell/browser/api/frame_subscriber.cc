@@ -5,35 +5,61 @@
 #include "shell/browser/api/frame_subscriber.h"
 
 #include <utility>
+#include <vector>
 
 #include "content/public/browser/render_view_host.h"
 #include "content/public/browser/render_widget_host.h"
 #include "content/public/browser/render_widget_host_view.h"
+#include "media/base/video_frame.h"
 #include "media/capture/mojom/video_capture_types.mojom.h"
 #include "mojo/public/cpp/bindings/remote.h"
+#include "shell/common/gin_converters/gfx_converter.h"
+#include "shell/common/gin_helper/dictionary.h"
+#include "shell/common/node_includes.h"
 #include "ui/gfx/geometry/size_conversions.h"
 #include "ui/gfx/image/image.h"
 #include "ui/gfx/skbitmap_operations.h"
+#include "ui/gfx/skia_util.h"
 
 namespace electron {
 
 namespace api {
 
-constexpr static int kMaxFrameRate = 30;
+I420Frame::I420Frame() = default;
+I420Frame::I420Frame(I420Frame&&) = default;
+I420Frame::~I420Frame() = default;
 
 FrameSubscriber::FrameSubscriber(content::WebContents* web_contents,
                                  const FrameCaptureCallback& callback,
-                                 bool only_dirty)
+                                 const Options& options)
     : content::WebContentsObserver(web_contents),
       callback_(callback),
-      only_dirty_(only_dirty),
+      options_(options),
       weak_ptr_factory_(this) {
+  PowerPolicy::Get()->AddObserver(this);
+  DCHECK_EQ(options_.pixel_format, media::PIXEL_FORMAT_ARGB);
   content::RenderViewHost* rvh = web_contents->GetRenderViewHost();
   if (rvh)
     AttachToHost(rvh->GetWidget());
 }
 
-FrameSubscriber::~FrameSubscriber() = default;
+FrameSubscriber::FrameSubscriber(content::WebContents* web_contents,
+                                 const I420FrameCaptureCallback& callback,
+                                 const Options& options)
+    : content::WebContentsObserver(web_contents),
+      i420_callback_(callback),
+      options_(options),
+      weak_ptr_factory_(this) {
+  PowerPolicy::Get()->AddObserver(this);
+  DCHECK_EQ(options_.pixel_format, media::PIXEL_FORMAT_I420);
+  content::RenderViewHost* rvh = web_contents->GetRenderViewHost();
+  if (rvh)
+    AttachToHost(rvh->GetWidget());
+}
+
+FrameSubscriber::~FrameSubscriber() {
+  PowerPolicy::Get()->RemoveObserver(this);
+}
 
 void FrameSubscriber::AttachToHost(content::RenderWidgetHost* host) {
   host_ = host;
@@ -43,16 +69,16 @@ void FrameSubscriber::AttachToHost(content::RenderWidgetHost* host) {
   if (!host_->GetView())
     return;
 
-  // Create and configure the video capturer.
-  gfx::Size size = GetRenderViewSize();
+  // Create and configure the video capturer. The capturer scales and converts
+  // the frames on the GPU when they are requested in another size or format.
+  gfx::Size size = GetFrameSize();
   video_capturer_ = host_->GetView()->CreateVideoCapturer();
   video_capturer_->SetResolutionConstraints(size, size, true);
   video_capturer_->SetAutoThrottlingEnabled(false);
   video_capturer_->SetMinSizeChangePeriod(base::TimeDelta());
-  video_capturer_->SetFormat(media::PIXEL_FORMAT_ARGB,
+  video_capturer_->SetFormat(options_.pixel_format,
                              gfx::ColorSpace::CreateREC709());
-  video_capturer_->SetMinCapturePeriod(base::TimeDelta::FromSeconds(1) /
-                                       kMaxFrameRate);
+  video_capturer_->SetMinCapturePeriod(GetMinCapturePeriod());
   video_capturer_->Start(this);
 }
 
@@ -88,8 +114,10 @@ void FrameSubscriber::OnFrameCaptured(
     const gfx::Rect& content_rect,
     mojo::PendingRemote<viz::mojom::FrameSinkVideoConsumerFrameCallbacks>
         callbacks) {
-  gfx::Size size = GetRenderViewSize();
-  if (size != content_rect.size()) {
+  // Frames of a fixed size are letterboxed by the capturer when the aspect
+  // ratio of the view differs, so only frames of the view size are checked.
+  gfx::Size size = GetFrameSize();
+  if (options_.size.IsEmpty() && size != content_rect.size()) {
     video_capturer_->SetResolutionConstraints(size, size, true);
     video_capturer_->RequestRefreshFrame();
     return;
@@ -112,6 +140,34 @@ void FrameSubscriber::OnFrameCaptured(
     return;
   }
 
+  gfx::Rect crop_rect = GetCropRect(content_rect);
+  if (crop_rect.IsEmpty()) {
+    callbacks_remote->Done();
+    return;
+  }
+
+  if (info->pixel_format == media::PIXEL_FORMAT_I420) {
+    // The frame is released once the callback has copied it.
+    I420Frame frame;
+    frame.mapping = std::move(mapping);
+    frame.coded_size = info->coded_size;
+    frame.visible_rect = info->visible_rect;
+    if (options_.rect.IsEmpty()) {
+      i420_callback_.Run(frame, content_rect);
+      return;
+    }
+
+    // The chroma planes have half the resolution, so the area is cropped at
+    // even pixels.
+    int left = crop_rect.x() & ~1;
+    int top = crop_rect.y() & ~1;
+    frame.visible_rect.Intersect(
+        gfx::Rect(left, top, ((crop_rect.right() + 1) & ~1) - left,
+                  ((crop_rect.bottom() + 1) & ~1) - top));
+    i420_callback_.Run(frame, gfx::Rect(frame.visible_rect.size()));
+    return;
+  }
+
   // The SkBitmap's pixels will be marked as immutable, but the installPixels()
   // API requires a non-const pointer. So, cast away the const.
   void* const pixels = const_cast<void*>(mapping.memory());
@@ -129,7 +185,7 @@ void FrameSubscriber::OnFrameCaptured(
 
   SkBitmap bitmap;
   bitmap.installPixels(
-      SkImageInfo::MakeN32(content_rect.width(), content_rect.height(),
+      SkImageInfo::MakeN32(content_rect.right(), content_rect.bottom(),
                            kPremul_SkAlphaType),
       pixels,
       media::VideoFrame::RowBytes(media::VideoFrame::kARGBPlane,
@@ -140,19 +196,47 @@ void FrameSubscriber::OnFrameCaptured(
       new FramePinner{std::move(mapping), std::move(callbacks_remote)});
   bitmap.setImmutable();
 
-  Done(content_rect, bitmap);
+  if (crop_rect == gfx::Rect(content_rect.size())) {
+    Done(content_rect, bitmap);
+    return;
+  }
+
+  // The subset shares the pixels, and the pinner, of the frame.
+  SkBitmap subset;
+  if (!bitmap.extractSubset(&subset, gfx::RectToSkIRect(crop_rect)))
+    return;
+  Done(gfx::Rect(crop_rect.size()), subset);
 }
 
 void FrameSubscriber::OnStopped() {}
 
+void FrameSubscriber::OnBatterySaverChanged(bool saving) {
+  if (video_capturer_)
+    video_capturer_->SetMinCapturePeriod(GetMinCapturePeriod());
+}
+
+base::TimeDelta FrameSubscriber::GetMinCapturePeriod() const {
+  return base::TimeDelta::FromSeconds(1) /
+         PowerPolicy::Get()->LimitFrameRate(options_.frame_rate);
+}
+
 void FrameSubscriber::Done(const gfx::Rect& damage, const SkBitmap& frame) {
   if (frame.drawsNothing())
     return;
 
-  const SkBitmap& bitmap = only_dirty_ ? SkBitmapOperations::CreateTiledBitmap(
-                                             frame, damage.x(), damage.y(),
-                                             damage.width(), damage.height())
-                                       : frame;
+  const SkBitmap& bitmap =
+      options_.only_dirty
+          ? SkBitmapOperations::CreateTiledBitmap(frame, damage.x(), damage.y(),
+                                                  damage.width(),
+                                                  damage.height())
+          : frame;
+
+  // The image shares the memory of the frame, which the capturer does not
+  // reuse while the image is alive.
+  if (options_.zero_copy) {
+    callback_.Run(gfx::Image::CreateFrom1xBitmap(bitmap), damage);
+    return;
+  }
 
   // Copying SkBitmap does not copy the internal pixels, we have to manually
   // allocate and write pixels otherwise crash may happen when the original
@@ -175,6 +259,68 @@ gfx::Size FrameSubscriber::GetRenderViewSize() const {
       gfx::ScaleSize(gfx::SizeF(size), view->GetDeviceScaleFactor()));
 }
 
+gfx::Size FrameSubscriber::GetFrameSize() const {
+  if (!options_.size.IsEmpty())
+    return options_.size;
+  return gfx::ToRoundedSize(
+      gfx::ScaleSize(gfx::SizeF(GetRenderViewSize()), options_.scale));
+}
+
+gfx::Rect FrameSubscriber::GetCropRect(const gfx::Rect& content_rect) const {
+  gfx::Size view_size = host_->GetView()->GetViewBounds().size();
+  if (options_.rect.IsEmpty() || view_size.IsEmpty())
+    return content_rect;
+
+  // The content is scaled into |content_rect| of the frame.
+  gfx::Rect crop_rect = gfx::ScaleToEnclosingRect(
+      options_.rect,
+      static_cast<float>(content_rect.width()) / view_size.width(),
+      static_cast<float>(content_rect.height()) / view_size.height());
+  crop_rect.Offset(content_rect.OffsetFromOrigin());
+  crop_rect.Intersect(content_rect);
+  return crop_rect;
+}
+
 }  // namespace api
 
 }  // namespace electron
+
+namespace gin {
+
+v8::Local<v8::Value> Converter<electron::api::I420Frame>::ToV8(
+    v8::Isolate* isolate,
+    const electron::api::I420Frame& frame) {
+  const media::VideoPixelFormat format = media::PIXEL_FORMAT_I420;
+  const auto* memory = static_cast<const char*>(frame.mapping.memory());
+  const gfx::Rect& visible = frame.visible_rect;
+
+  // Each plane is described by the offset of its first visible pixel, so that
+  // the visible area can be read without knowing the coded size.
+  std::vector<gin_helper::Dictionary> planes;
+  size_t plane_offset = 0;
+  for (size_t plane = media::VideoFrame::kYPlane;
+       plane <= media::VideoFrame::kVPlane; ++plane) {
+    int stride = media::VideoFrame::RowBytes(plane, format,
+                                             frame.coded_size.width());
+    gfx::Size sample_size = media::VideoFrame::SampleSize(format, plane);
+    size_t origin = (visible.y() / sample_size.height()) * stride +
+                    visible.x() / sample_size.width();
+    gin_helper::Dictionary dict = gin::Dictionary::CreateEmpty(isolate);
+    dict.Set("offset", static_cast<double>(plane_offset + origin));
+    dict.Set("stride", stride);
+    planes.push_back(dict);
+    plane_offset +=
+        stride * media::VideoFrame::Rows(plane, format,
+                                         frame.coded_size.height());
+  }
+
+  gin_helper::Dictionary dict = gin::Dictionary::CreateEmpty(isolate);
+  dict.Set("format", "i420");
+  dict.Set("size", visible.size());
+  dict.Set("planes", planes);
+  dict.Set("data",
+           node::Buffer::Copy(isolate, memory, plane_offset).ToLocalChecked());
+  return dict.GetHandle();
+}
+
+}  // namespace gin
@@ -8,11 +8,17 @@
 #include <memory>
 
 #include "base/callback.h"
+#include "base/memory/read_only_shared_memory_region.h"
 #include "base/memory/weak_ptr.h"
 #include "components/viz/host/client_frame_sink_video_capturer.h"
 #include "content/public/browser/web_contents.h"
 #include "content/public/browser/web_contents_observer.h"
+#include "gin/converter.h"
+#include "media/base/video_types.h"
 #include "mojo/public/cpp/bindings/pending_remote.h"
+#include "shell/browser/power_policy.h"
+#include "ui/gfx/geometry/rect.h"
+#include "ui/gfx/geometry/size.h"
 #include "v8/include/v8.h"
 
 namespace gfx {
@@ -25,15 +31,52 @@ namespace api {
 
 class WebContents;
 
+// A frame captured in the I420 format, whose Y, U and V planes follow each
+// other in |mapping|.
+struct I420Frame {
+  I420Frame();
+  I420Frame(I420Frame&&);
+  ~I420Frame();
+
+  base::ReadOnlySharedMemoryMapping mapping;
+  gfx::Size coded_size;
+  gfx::Rect visible_rect;
+};
+
 class FrameSubscriber : public content::WebContentsObserver,
-                        public viz::mojom::FrameSinkVideoConsumer {
+                        public viz::mojom::FrameSinkVideoConsumer,
+                        public PowerPolicy::Observer {
  public:
   using FrameCaptureCallback =
       base::RepeatingCallback<void(const gfx::Image&, const gfx::Rect&)>;
-
+  using I420FrameCaptureCallback =
+      base::RepeatingCallback<void(const I420Frame&, const gfx::Rect&)>;
+
+  struct Options {
+    bool only_dirty = false;
+    media::VideoPixelFormat pixel_format = media::PIXEL_FORMAT_ARGB;
+    // The size of the frames, or the size of the view when empty.
+    gfx::Size size;
+    // The scale of the frames relative to the pixels of the view, when they
+    // have the size of the view.
+    float scale = 1.0f;
+    // The area of the view that is delivered, in DIPs, or the whole view when
+    // empty.
+    gfx::Rect rect;
+    // Whether the images share the memory of the captured frames.
+    bool zero_copy = false;
+    // The maximum rate the frames are captured at.
+    int frame_rate = 30;
+  };
+
+  // Captures BGRA frames.
   FrameSubscriber(content::WebContents* web_contents,
                   const FrameCaptureCallback& callback,
-                  bool only_dirty);
+                  const Options& options);
+  // Captures I420 frames.
+  FrameSubscriber(content::WebContents* web_contents,
+                  const I420FrameCaptureCallback& callback,
+                  const Options& options);
   ~FrameSubscriber() override;
 
  private:
@@ -54,13 +97,26 @@ class FrameSubscriber : public content::WebContentsObserver,
           callbacks) override;
   void OnStopped() override;
 
+  // PowerPolicy::Observer:
+  void OnBatterySaverChanged(bool saving) override;
+
+  // The shortest time between two captured frames.
+  base::TimeDelta GetMinCapturePeriod() const;
+
   void Done(const gfx::Rect& damage, const SkBitmap& frame);
 
   // Get the pixel size of render view.
   gfx::Size GetRenderViewSize() const;
 
+  // The size of the captured frames.
+  gfx::Size GetFrameSize() const;
+
+  // The area of the captured frames that is delivered.
+  gfx::Rect GetCropRect(const gfx::Rect& content_rect) const;
+
   FrameCaptureCallback callback_;
-  bool only_dirty_;
+  I420FrameCaptureCallback i420_callback_;
+  Options options_;
 
   content::RenderWidgetHost* host_;
   std::unique_ptr<viz::ClientFrameSinkVideoCapturer> video_capturer_;
@@ -74,4 +130,14 @@ class FrameSubscriber : public content::WebContentsObserver,
 
 }  // namespace electron
 
+namespace gin {
+
+template <>
+struct Converter<electron::api::I420Frame> {
+  static v8::Local<v8::Value> ToV8(v8::Isolate* isolate,
+                                   const electron::api::I420Frame& frame);
+};
+
+}  // namespace gin
+
 #endif  // SHELL_BROWSER_API_FRAME_SUBSCRIBER_H_
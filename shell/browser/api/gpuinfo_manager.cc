@@ -6,15 +6,63 @@
 
 #include <utility>
 
+#include "base/json/json_file_value_serializer.h"
+#include "base/json/json_writer.h"
 #include "base/memory/singleton.h"
+#include "base/path_service.h"
+#include "base/strings/stringprintf.h"
+#include "base/task/post_task.h"
 #include "base/threading/thread_task_runner_handle.h"
 #include "content/public/browser/browser_thread.h"
 #include "gpu/config/gpu_info_collector.h"
 #include "shell/browser/api/gpu_info_enumerator.h"
+#include "shell/browser/atom_paths.h"
 #include "shell/common/gin_converters/value_converter.h"
 
 namespace electron {
 
+namespace {
+
+const base::FilePath::CharType kCacheFileName[] =
+    FILE_PATH_LITERAL("GPUInfoCache");
+
+// Only macOS and Windows collect the complete info after launch, elsewhere
+// it is there from the start and is not cached.
+#if defined(OS_MACOSX) || defined(OS_WIN)
+constexpr bool kCacheCompleteInfo = true;
+#else
+constexpr bool kCacheCompleteInfo = false;
+#endif
+
+const char kDriverKey[] = "driver";
+const char kInfoKey[] = "info";
+
+base::FilePath GetCachePath() {
+  base::FilePath path;
+  if (!base::PathService::Get(DIR_USER_DATA, &path))
+    return base::FilePath();
+  return path.Append(kCacheFileName);
+}
+
+// Identifies the driver of the active GPU, which the cached info is only
+// valid for.
+std::string GetDriverKey() {
+  gpu::GPUInfo gpu_info;
+  CollectBasicGraphicsInfo(&gpu_info);
+  const gpu::GPUInfo::GPUDevice& gpu = gpu_info.active_gpu();
+  return base::StringPrintf("%04x:%04x:%s", gpu.vendor_id, gpu.device_id,
+                            gpu.driver_version.c_str());
+}
+
+std::pair<std::string, std::unique_ptr<base::Value>> ReadCache(
+    const base::FilePath& path) {
+  JSONFileValueDeserializer deserializer(path);
+  return std::make_pair(GetDriverKey(),
+                        deserializer.Deserialize(nullptr, nullptr));
+}
+
+}  // namespace
+
 GPUInfoManager* GPUInfoManager::GetInstance() {
   return base::Singleton<GPUInfoManager>::get();
 }
@@ -50,6 +98,12 @@ void GPUInfoManager::ProcessCompleteInfo() {
     promise.Resolve(*result);
   }
   complete_info_promise_set_.clear();
+
+  if (cache_state_ == CacheState::kLoaded &&
+      (!cached_info_ || *cached_info_ != *result)) {
+    cached_info_ = result->CreateDeepCopy();
+    WriteCache();
+  }
 }
 
 void GPUInfoManager::OnGpuInfoUpdate() {
@@ -76,6 +130,36 @@ void GPUInfoManager::CompleteInfoFetcher(
 
 void GPUInfoManager::FetchCompleteInfo(
     gin_helper::Promise<base::DictionaryValue> promise) {
+  if (kCacheCompleteInfo && cache_state_ != CacheState::kLoaded) {
+    cache_waiters_.emplace_back(std::move(promise));
+    if (cache_state_ == CacheState::kNotLoaded) {
+      cache_state_ = CacheState::kLoading;
+      file_task_runner_ = base::CreateSequencedTaskRunner(
+          {base::ThreadPool(), base::MayBlock(),
+           base::TaskPriority::USER_VISIBLE,
+           base::TaskShutdownBehavior::BLOCK_SHUTDOWN});
+      base::PostTaskAndReplyWithResult(
+          file_task_runner_.get(), FROM_HERE,
+          base::BindOnce(&ReadCache, GetCachePath()),
+          base::BindOnce(&GPUInfoManager::OnCacheLoaded,
+                         weak_factory_.GetWeakPtr()));
+    }
+    return;
+  }
+
+  // The cached info stands in until the GPU collected the complete info.
+  if (cached_info_ && NeedsCompleteGpuInfoCollection()) {
+    promise.Resolve(*cached_info_);
+    // The info is collected again once the app is done starting, so that
+    // the cache follows what changed without a new driver.
+    if (!refresh_requested_) {
+      refresh_requested_ = true;
+      gpu_data_manager_->RequestDxdiagDx12VulkanGpuInfoIfNeeded(
+          content::kGpuInfoRequestAll, /* delayed */ true);
+    }
+    return;
+  }
+
   base::ThreadTaskRunnerHandle::Get()->PostTask(
       FROM_HERE, base::BindOnce(&GPUInfoManager::CompleteInfoFetcher,
                                 base::Unretained(this), std::move(promise)));
@@ -90,6 +174,41 @@ void GPUInfoManager::FetchBasicInfo(
   promise.Resolve(*EnumerateGPUInfo(gpu_info));
 }
 
+void GPUInfoManager::OnCacheLoaded(CacheContents contents) {
+  cache_state_ = CacheState::kLoaded;
+  driver_key_ = std::move(contents.first);
+  const base::Value* cache = contents.second.get();
+  if (cache && cache->is_dict()) {
+    const std::string* driver = cache->FindStringKey(kDriverKey);
+    const base::Value* info = cache->FindDictKey(kInfoKey);
+    if (driver && *driver == driver_key_ && info) {
+      cached_info_ = base::DictionaryValue::From(
+          base::Value::ToUniquePtrValue(info->Clone()));
+    }
+  }
+
+  auto waiters = std::move(cache_waiters_);
+  cache_waiters_.clear();
+  for (auto& promise : waiters)
+    FetchCompleteInfo(std::move(promise));
+}
+
+void GPUInfoManager::WriteCache() {
+  base::FilePath path = GetCachePath();
+  if (path.empty())
+    return;
+  base::Value cache(base::Value::Type::DICTIONARY);
+  cache.SetStringKey(kDriverKey, driver_key_);
+  cache.SetKey(kInfoKey, cached_info_->Clone());
+  auto data = std::make_unique<std::string>();
+  if (!base::JSONWriter::Write(cache, data.get()))
+    return;
+  if (!writer_)
+    writer_ = std::make_unique<base::ImportantFileWriter>(path,
+                                                          file_task_runner_);
+  writer_->WriteNow(std::move(data));
+}
+
 std::unique_ptr<base::DictionaryValue> GPUInfoManager::EnumerateGPUInfo(
     gpu::GPUInfo gpu_info) const {
   GPUInfoEnumerator enumerator;
@@ -6,9 +6,14 @@
 #define SHELL_BROWSER_API_GPUINFO_MANAGER_H_
 
 #include <memory>
+#include <string>
 #include <unordered_set>
+#include <utility>
 #include <vector>
 
+#include "base/files/important_file_writer.h"
+#include "base/memory/weak_ptr.h"
+#include "base/sequenced_task_runner.h"
 #include "content/browser/gpu/gpu_data_manager_impl.h"  // nogncheck
 #include "content/public/browser/gpu_data_manager.h"
 #include "content/public/browser/gpu_data_manager_observer.h"
@@ -29,9 +34,15 @@ class GPUInfoManager : public content::GpuDataManagerObserver {
   void OnGpuInfoUpdate() override;
 
  private:
+  // The driver the info was cached for, and the cached file.
+  using CacheContents = std::pair<std::string, std::unique_ptr<base::Value>>;
+
   std::unique_ptr<base::DictionaryValue> EnumerateGPUInfo(
       gpu::GPUInfo gpu_info) const;
 
+  void OnCacheLoaded(CacheContents contents);
+  void WriteCache();
+
   // These should be posted to the task queue
   void CompleteInfoFetcher(gin_helper::Promise<base::DictionaryValue> promise);
   void ProcessCompleteInfo();
@@ -42,6 +53,20 @@ class GPUInfoManager : public content::GpuDataManagerObserver {
       complete_info_promise_set_;
   content::GpuDataManager* gpu_data_manager_;
 
+  // The complete info is cached on disk for the driver it was collected with,
+  // so the later launches do not wait for the GPU to collect it again.
+  enum class CacheState { kNotLoaded, kLoading, kLoaded };
+  CacheState cache_state_ = CacheState::kNotLoaded;
+  std::vector<gin_helper::Promise<base::DictionaryValue>> cache_waiters_;
+  std::string driver_key_;
+  std::unique_ptr<base::DictionaryValue> cached_info_;
+  // Whether the cached info was refreshed in the background since launch.
+  bool refresh_requested_ = false;
+  scoped_refptr<base::SequencedTaskRunner> file_task_runner_;
+  std::unique_ptr<base::ImportantFileWriter> writer_;
+
+  base::WeakPtrFactory<GPUInfoManager> weak_factory_{this};
+
   DISALLOW_COPY_AND_ASSIGN(GPUInfoManager);
 };
 
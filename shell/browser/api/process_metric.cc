@@ -5,10 +5,22 @@
 #include "shell/browser/api/process_metric.h"
 
 #include <memory>
+#include <string>
 #include <utility>
+#include <vector>
 
 #include "base/optional.h"
 
+#if defined(OS_LINUX)
+#include <unistd.h>
+
+#include "base/files/file_path.h"
+#include "base/files/file_util.h"
+#include "base/strings/string_number_conversions.h"
+#include "base/strings/string_split.h"
+#include "base/strings/stringprintf.h"
+#endif
+
 #if defined(OS_WIN)
 #include <windows.h>
 
@@ -44,6 +56,16 @@ base::Optional<mach_task_basic_info_data_t> GetTaskInfo(mach_port_t task) {
   return (kr == KERN_SUCCESS) ? base::make_optional(info) : base::nullopt;
 }
 
+base::Optional<task_vm_info_data_t> GetTaskVMInfo(mach_port_t task) {
+  if (task == MACH_PORT_NULL)
+    return base::nullopt;
+  task_vm_info_data_t info = {};
+  mach_msg_type_number_t count = TASK_VM_INFO_COUNT;
+  kern_return_t kr = task_info(task, TASK_VM_INFO,
+                               reinterpret_cast<task_info_t>(&info), &count);
+  return (kr == KERN_SUCCESS) ? base::make_optional(info) : base::nullopt;
+}
+
 }  // namespace
 
 #endif  // defined(OS_MACOSX)
@@ -68,6 +90,30 @@ ProcessMetric::ProcessMetric(int type,
 
 ProcessMetric::~ProcessMetric() = default;
 
+#if !defined(OS_WIN)
+int ProcessMetric::GetHandleCount() const {
+  return metrics->GetOpenFdCount();
+}
+#endif
+
+#if defined(OS_LINUX)
+size_t ProcessMetric::GetPrivateMemoryFootprint() const {
+  // The resident pages which are not shared, see proc(5).
+  std::string statm;
+  if (!base::ReadFileToString(
+          base::FilePath(base::StringPrintf("/proc/%d/statm", process.Pid())),
+          &statm))
+    return 0;
+  std::vector<base::StringPiece> fields = base::SplitStringPiece(
+      statm, " ", base::TRIM_WHITESPACE, base::SPLIT_WANT_NONEMPTY);
+  size_t resident = 0, shared = 0;
+  if (fields.size() < 3 || !base::StringToSizeT(fields[1], &resident) ||
+      !base::StringToSizeT(fields[2], &shared) || shared > resident)
+    return 0;
+  return (resident - shared) * getpagesize();
+}
+#endif
+
 #if defined(OS_WIN)
 
 ProcessMemoryInfo ProcessMetric::GetMemoryInfo() const {
@@ -85,6 +131,17 @@ ProcessMemoryInfo ProcessMetric::GetMemoryInfo() const {
   return result;
 }
 
+size_t ProcessMetric::GetPrivateMemoryFootprint() const {
+  return GetMemoryInfo().private_bytes;
+}
+
+int ProcessMetric::GetHandleCount() const {
+  DWORD count = 0;
+  if (!::GetProcessHandleCount(process.Handle(), &count))
+    return -1;
+  return static_cast<int>(count);
+}
+
 ProcessIntegrityLevel ProcessMetric::GetIntegrityLevel() const {
   HANDLE token = nullptr;
   if (!::OpenProcessToken(process.Handle(), TOKEN_QUERY, &token)) {
@@ -155,6 +212,13 @@ ProcessMemoryInfo ProcessMetric::GetMemoryInfo() const {
   return result;
 }
 
+size_t ProcessMetric::GetPrivateMemoryFootprint() const {
+  // What the Activity Monitor shows as the memory of the process.
+  if (auto info = GetTaskVMInfo(TaskForPid(process.Pid())))
+    return info->phys_footprint;
+  return 0;
+}
+
 bool ProcessMetric::IsSandboxed() const {
 #if defined(MAS_BUILD)
   return true;
@@ -10,6 +10,7 @@
 #include "base/process/process.h"
 #include "base/process/process_handle.h"
 #include "base/process/process_metrics.h"
+#include "base/time/time.h"
 
 namespace electron {
 
@@ -38,6 +39,14 @@ struct ProcessMetric {
   base::Process process;
   std::unique_ptr<base::ProcessMetrics> metrics;
 
+  // The id of the RenderProcessHost, for the renderer processes.
+  int render_process_id = -1;
+
+  // The counters of the previous sample, which the samples are relative to.
+  base::TimeDelta last_cpu_time;
+  uint64_t last_read_bytes = 0;
+  uint64_t last_write_bytes = 0;
+
   ProcessMetric(int type,
                 base::ProcessHandle handle,
                 std::unique_ptr<base::ProcessMetrics> metrics);
@@ -47,6 +56,13 @@ struct ProcessMetric {
   ProcessMemoryInfo GetMemoryInfo() const;
 #endif
 
+  // The memory only this process uses, in bytes, or 0 when it can not be read.
+  size_t GetPrivateMemoryFootprint() const;
+
+  // The number of handles on Windows, and of file descriptors elsewhere, or -1
+  // when it can not be read.
+  int GetHandleCount() const;
+
 #if defined(OS_WIN)
   ProcessIntegrityLevel GetIntegrityLevel() const;
   static bool IsSandboxed(ProcessIntegrityLevel integrity_level);
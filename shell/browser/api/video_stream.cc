@@ -0,0 +1,270 @@
+// Copyright (c) 2020 GitHub, Inc.
+// Use of this source code is governed by the MIT license that can be
+// found in the LICENSE file.
+
+#include "shell/browser/api/video_stream.h"
+
+#include <algorithm>
+#include <cstring>
+#include <utility>
+
+#include "base/bind.h"
+#include "base/logging.h"
+#include "base/memory/ptr_util.h"
+#include "base/task/post_task.h"
+#include "base/task_runner_util.h"
+#include "content/public/browser/render_widget_host_view.h"
+#include "content/public/browser/web_contents.h"
+#include "media/base/video_frame.h"
+#include "shell/browser/api/frame_subscriber.h"
+#include "shell/common/gin_helper/dictionary.h"
+#include "shell/common/node_includes.h"
+#include "third_party/libvpx/source/libvpx/vpx/vp8cx.h"
+#include "third_party/libvpx/source/libvpx/vpx/vpx_encoder.h"
+#include "ui/gfx/geometry/rect.h"
+#include "ui/gfx/geometry/size_conversions.h"
+
+namespace electron {
+
+namespace api {
+
+namespace {
+
+// Frames are dropped while this many are waiting for the encoder, which keeps
+// the latency of the stream bounded when the encoder falls behind.
+constexpr int kMaxPendingFrames = 2;
+
+// The longest time between key frames, so that clients joining the stream
+// can start decoding it.
+constexpr int kKeyFrameIntervalSeconds = 2;
+
+// Copies the visible area of |frame| into tightly packed I420 planes.
+std::vector<uint8_t> CopyVisiblePlanes(const I420Frame& frame) {
+  const media::VideoPixelFormat format = media::PIXEL_FORMAT_I420;
+  const gfx::Rect& visible = frame.visible_rect;
+  std::vector<uint8_t> data(
+      media::VideoFrame::AllocationSize(format, visible.size()));
+
+  const auto* src = static_cast<const uint8_t*>(frame.mapping.memory());
+  uint8_t* dst = data.data();
+  for (size_t plane = media::VideoFrame::kYPlane;
+       plane <= media::VideoFrame::kVPlane; ++plane) {
+    int src_stride = media::VideoFrame::RowBytes(plane, format,
+                                                 frame.coded_size.width());
+    int dst_stride = media::VideoFrame::RowBytes(plane, format,
+                                                 visible.width());
+    gfx::Size sample_size = media::VideoFrame::SampleSize(format, plane);
+    const uint8_t* src_row =
+        src + (visible.y() / sample_size.height()) * src_stride +
+        visible.x() / sample_size.width();
+    int rows = media::VideoFrame::Rows(plane, format, visible.height());
+    for (int row = 0; row < rows; ++row) {
+      memcpy(dst, src_row, dst_stride);
+      dst += dst_stride;
+      src_row += src_stride;
+    }
+    src += src_stride *
+           media::VideoFrame::Rows(plane, format, frame.coded_size.height());
+  }
+  return data;
+}
+
+}  // namespace
+
+// Wraps the libvpx encoder, which is used on the encoder sequence once it has
+// been initialized.
+class VideoStream::Encoder {
+ public:
+  Encoder() { memset(&codec_, 0, sizeof(codec_)); }
+
+  ~Encoder() {
+    if (initialized_)
+      vpx_codec_destroy(&codec_);
+  }
+
+  bool Initialize(const Options& options) {
+    vpx_codec_iface_t* iface = options.codec == Codec::kVP9
+                                   ? vpx_codec_vp9_cx()
+                                   : vpx_codec_vp8_cx();
+    vpx_codec_enc_cfg_t config;
+    if (vpx_codec_enc_config_default(iface, &config, 0) != VPX_CODEC_OK)
+      return false;
+
+    // The timestamps are in microseconds, and frames are never held back so
+    // that each one is encoded as soon as it is captured.
+    config.g_w = options.size.width();
+    config.g_h = options.size.height();
+    config.g_timebase.num = 1;
+    config.g_timebase.den = base::Time::kMicrosecondsPerSecond;
+    config.g_lag_in_frames = 0;
+    config.rc_end_usage = VPX_CBR;
+    config.rc_target_bitrate = options.bitrate;
+    config.kf_mode = VPX_KF_AUTO;
+    config.kf_max_dist = options.frame_rate * kKeyFrameIntervalSeconds;
+    if (vpx_codec_enc_init(&codec_, iface, &config, 0) != VPX_CODEC_OK)
+      return false;
+    initialized_ = true;
+
+    // Favor speed, as the frames are encoded in real time.
+    vpx_codec_control(&codec_, VP8E_SET_CPUUSED,
+                      options.codec == Codec::kVP9 ? 7 : -6);
+
+    size_ = options.size;
+    frame_duration_ = base::TimeDelta::FromSeconds(1) / options.frame_rate;
+    return true;
+  }
+
+  std::vector<EncodedVideoChunk> Encode(std::vector<uint8_t> frame,
+                                        base::TimeDelta timestamp) {
+    std::vector<EncodedVideoChunk> chunks;
+    vpx_image_t image;
+    vpx_img_wrap(&image, VPX_IMG_FMT_I420, size_.width(), size_.height(), 1,
+                 frame.data());
+    if (vpx_codec_encode(&codec_, &image, timestamp.InMicroseconds(),
+                         frame_duration_.InMicroseconds(), 0,
+                         VPX_DL_REALTIME) != VPX_CODEC_OK) {
+      LOG(ERROR) << "Failed to encode frame: " << vpx_codec_error(&codec_);
+      return chunks;
+    }
+
+    vpx_codec_iter_t iter = nullptr;
+    while (const vpx_codec_cx_pkt_t* packet =
+               vpx_codec_get_cx_data(&codec_, &iter)) {
+      if (packet->kind != VPX_CODEC_CX_FRAME_PKT)
+        continue;
+      EncodedVideoChunk chunk;
+      chunk.data.assign(static_cast<const char*>(packet->data.frame.buf),
+                        packet->data.frame.sz);
+      chunk.key_frame = packet->data.frame.flags & VPX_FRAME_IS_KEY;
+      chunk.timestamp =
+          base::TimeDelta::FromMicroseconds(packet->data.frame.pts);
+      chunks.push_back(std::move(chunk));
+    }
+    return chunks;
+  }
+
+ private:
+  vpx_codec_ctx_t codec_;
+  bool initialized_ = false;
+  gfx::Size size_;
+  base::TimeDelta frame_duration_;
+
+  DISALLOW_COPY_AND_ASSIGN(Encoder);
+};
+
+// static
+std::unique_ptr<VideoStream> VideoStream::Create(
+    content::WebContents* web_contents,
+    const Options& options,
+    const ChunkCallback& callback) {
+  Options encoder_options = options;
+  if (encoder_options.size.IsEmpty()) {
+    content::RenderWidgetHostView* view =
+        web_contents->GetRenderWidgetHostView();
+    if (!view)
+      return nullptr;
+    encoder_options.size = gfx::ToRoundedSize(
+        gfx::ScaleSize(gfx::SizeF(view->GetViewBounds().size()),
+                       view->GetDeviceScaleFactor()));
+  }
+  // The chroma planes of I420 frames have half the size of the frames, which
+  // the encoder expects to be even.
+  encoder_options.size.SetSize(
+      std::max(2, encoder_options.size.width() & ~1),
+      std::max(2, encoder_options.size.height() & ~1));
+
+  auto encoder = std::make_unique<Encoder>();
+  if (!encoder->Initialize(encoder_options))
+    return nullptr;
+
+  auto stream = base::WrapUnique(
+      new VideoStream(std::move(encoder), encoder_options.size, callback));
+
+  FrameSubscriber::Options subscriber_options;
+  subscriber_options.pixel_format = media::PIXEL_FORMAT_I420;
+  subscriber_options.size = encoder_options.size;
+  subscriber_options.frame_rate = encoder_options.frame_rate;
+  stream->frame_subscriber_ = std::make_unique<FrameSubscriber>(
+      web_contents,
+      base::BindRepeating(&VideoStream::OnFrameCaptured,
+                          stream->weak_factory_.GetWeakPtr()),
+      subscriber_options);
+  return stream;
+}
+
+VideoStream::VideoStream(std::unique_ptr<Encoder> encoder,
+                         const gfx::Size& size,
+                         const ChunkCallback& callback)
+    : callback_(callback),
+      size_(size),
+      encoder_task_runner_(base::CreateSequencedTaskRunner(
+          {base::ThreadPool(), base::TaskPriority::USER_VISIBLE})),
+      encoder_(std::move(encoder)) {}
+
+VideoStream::~VideoStream() {
+  frame_subscriber_.reset();
+  // The encoder is deleted after the frames that were posted to it.
+  encoder_task_runner_->DeleteSoon(FROM_HERE, std::move(encoder_));
+}
+
+void VideoStream::OnFrameCaptured(const I420Frame& frame,
+                                  const gfx::Rect& damage) {
+  if (frame.visible_rect.size() != size_)
+    return;
+  if (pending_frames_ >= kMaxPendingFrames)
+    return;
+
+  base::TimeTicks now = base::TimeTicks::Now();
+  if (start_time_.is_null())
+    start_time_ = now;
+
+  ++pending_frames_;
+  base::PostTaskAndReplyWithResult(
+      encoder_task_runner_.get(), FROM_HERE,
+      base::BindOnce(&Encoder::Encode, base::Unretained(encoder_.get()),
+                     CopyVisiblePlanes(frame), now - start_time_),
+      base::BindOnce(&VideoStream::OnFrameEncoded,
+                     weak_factory_.GetWeakPtr()));
+}
+
+void VideoStream::OnFrameEncoded(std::vector<EncodedVideoChunk> chunks) {
+  --pending_frames_;
+  for (const auto& chunk : chunks)
+    callback_.Run(chunk);
+}
+
+}  // namespace api
+
+}  // namespace electron
+
+namespace gin {
+
+bool Converter<electron::api::VideoStream::Codec>::FromV8(
+    v8::Isolate* isolate,
+    v8::Local<v8::Value> val,
+    electron::api::VideoStream::Codec* out) {
+  std::string codec;
+  if (!ConvertFromV8(isolate, val, &codec))
+    return false;
+  if (codec == "vp8")
+    *out = electron::api::VideoStream::Codec::kVP8;
+  else if (codec == "vp9")
+    *out = electron::api::VideoStream::Codec::kVP9;
+  else
+    return false;
+  return true;
+}
+
+v8::Local<v8::Value> Converter<electron::api::EncodedVideoChunk>::ToV8(
+    v8::Isolate* isolate,
+    const electron::api::EncodedVideoChunk& chunk) {
+  gin_helper::Dictionary dict = gin::Dictionary::CreateEmpty(isolate);
+  dict.Set("data", node::Buffer::Copy(isolate, chunk.data.data(),
+                                      chunk.data.size())
+                       .ToLocalChecked());
+  dict.Set("keyFrame", chunk.key_frame);
+  dict.Set("timestamp", chunk.timestamp.InMillisecondsF());
+  return dict.GetHandle();
+}
+
+}  // namespace gin
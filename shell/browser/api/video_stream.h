@@ -0,0 +1,126 @@
+// Copyright (c) 2020 GitHub, Inc.
+// Use of this source code is governed by the MIT license that can be
+// found in the LICENSE file.
+
+#ifndef SHELL_BROWSER_API_VIDEO_STREAM_H_
+#define SHELL_BROWSER_API_VIDEO_STREAM_H_
+
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "base/callback.h"
+#include "base/macros.h"
+#include "base/memory/scoped_refptr.h"
+#include "base/memory/weak_ptr.h"
+#include "base/sequenced_task_runner.h"
+#include "base/time/time.h"
+#include "gin/converter.h"
+#include "ui/gfx/geometry/size.h"
+
+namespace content {
+class WebContents;
+}
+
+namespace gfx {
+class Rect;
+}
+
+namespace electron {
+
+namespace api {
+
+class FrameSubscriber;
+struct I420Frame;
+
+// A frame of the stream, as produced by the encoder.
+struct EncodedVideoChunk {
+  std::string data;
+  bool key_frame = false;
+  // The time the frame was captured at, since the stream began.
+  base::TimeDelta timestamp;
+};
+
+// Encodes the frames captured from a WebContents into a VP8 or VP9 stream.
+//
+// The frames are captured in I420 and encoded on the thread pool, so the only
+// work left on the UI thread is copying the frames out of the capturer and
+// emitting the chunks.
+class VideoStream {
+ public:
+  using ChunkCallback =
+      base::RepeatingCallback<void(const EncodedVideoChunk& chunk)>;
+
+  enum class Codec {
+    kVP8,
+    kVP9,
+  };
+
+  struct Options {
+    Codec codec = Codec::kVP8;
+    // The target bitrate, in kilobits per second.
+    int bitrate = 2000;
+    int frame_rate = 30;
+    // The size of the frames, or the size of the view when empty.
+    gfx::Size size;
+  };
+
+  // Returns nullptr when the encoder can not be created.
+  static std::unique_ptr<VideoStream> Create(content::WebContents* web_contents,
+                                             const Options& options,
+                                             const ChunkCallback& callback);
+
+  ~VideoStream();
+
+ private:
+  class Encoder;
+
+  VideoStream(std::unique_ptr<Encoder> encoder,
+              const gfx::Size& size,
+              const ChunkCallback& callback);
+
+  void OnFrameCaptured(const I420Frame& frame, const gfx::Rect& damage);
+  void OnFrameEncoded(std::vector<EncodedVideoChunk> chunks);
+
+  ChunkCallback callback_;
+  // The size of the encoded frames.
+  gfx::Size size_;
+
+  scoped_refptr<base::SequencedTaskRunner> encoder_task_runner_;
+  // Only used on |encoder_task_runner_|, where it is deleted.
+  std::unique_ptr<Encoder> encoder_;
+
+  std::unique_ptr<FrameSubscriber> frame_subscriber_;
+
+  base::TimeTicks start_time_;
+  // The number of frames posted to the encoder that it has not encoded yet.
+  int pending_frames_ = 0;
+
+  base::WeakPtrFactory<VideoStream> weak_factory_{this};
+
+  DISALLOW_COPY_AND_ASSIGN(VideoStream);
+};
+
+}  // namespace api
+
+}  // namespace electron
+
+namespace gin {
+
+template <>
+struct Converter<electron::api::VideoStream::Codec> {
+  static bool FromV8(v8::Isolate* isolate,
+                     v8::Local<v8::Value> val,
+                     electron::api::VideoStream::Codec* out);
+};
+
+template <>
+struct Converter<electron::api::EncodedVideoChunk> {
+  static v8::Local<v8::Value> ToV8(
+      v8::Isolate* isolate,
+      const electron::api::EncodedVideoChunk& chunk);
+};
+
+}  // namespace gin
+
+#endif  // SHELL_BROWSER_API_VIDEO_STREAM_H_
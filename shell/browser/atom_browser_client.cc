@@ -21,6 +21,7 @@
 #include "base/stl_util.h"
 #include "base/strings/string_number_conversions.h"
 #include "base/strings/string_util.h"
+#include "base/strings/stringprintf.h"
 #include "base/strings/utf_string_conversions.h"
 #include "base/task/post_task.h"
 #include "chrome/browser/browser_process.h"
@@ -55,6 +56,7 @@
 #include "services/network/public/cpp/resource_request_body.h"
 #include "services/service_manager/public/cpp/binder_map.h"
 #include "shell/app/manifests.h"
+#include "shell/browser/after_startup_tasks.h"
 #include "shell/browser/api/atom_api_app.h"
 #include "shell/browser/api/atom_api_protocol.h"
 #include "shell/browser/api/atom_api_session.h"
@@ -85,6 +87,7 @@
 #include "shell/browser/window_list.h"
 #include "shell/common/api/api.mojom.h"
 #include "shell/common/application_info.h"
+#include "shell/common/asar/extraction_cache.h"
 #include "shell/common/options_switches.h"
 #include "shell/common/platform_util.h"
 #include "ui/base/resource/resource_bundle.h"
@@ -134,6 +137,7 @@
 #include "extensions/browser/process_map.h"
 #include "extensions/common/extension.h"
 #include "shell/browser/extensions/atom_extension_system.h"
+#include "shell/browser/extensions/electron_message_metrics_filter.h"
 #endif
 
 #if defined(OS_MACOSX)
@@ -332,6 +336,23 @@ std::string AtomBrowserClient::GetAffinityPreference(
       web_preferences->GetPreference("affinity", &affinity) &&
       !affinity.empty()) {
     affinity = base::ToLowerASCII(affinity);
+  } else if (web_preferences) {
+    // The pages of a session sharing its renderer processes get an implicit
+    // affinity, which only groups the pages whose process would be started
+    // with the same switches and get the same process preferences.
+    auto* browser_context =
+        static_cast<AtomBrowserContext*>(web_contents->GetBrowserContext());
+    if (browser_context->share_renderer_processes()) {
+      base::CommandLine switches(base::CommandLine::NO_PROGRAM);
+      web_preferences->AppendCommandLineSwitches(&switches, !!rfh->GetParent());
+      base::CommandLine::StringType args =
+          base::JoinString(switches.argv(), FILE_PATH_LITERAL(" "));
+      affinity = base::StringPrintf(
+          "session:%p:%d%d:%s", browser_context,
+          web_preferences->parsed().disable_popups,
+          web_preferences->parsed().web_security,
+          base::FilePath(args).AsUTF8Unsafe().c_str());
+    }
   }
 
   return affinity;
@@ -382,6 +403,7 @@ void AtomBrowserClient::RenderProcessWillLaunch(
 #endif
 
 #if BUILDFLAG(ENABLE_ELECTRON_EXTENSIONS)
+  host->AddFilter(new extensions::ElectronMessageMetricsFilter(process_id));
   host->AddFilter(
       new extensions::ExtensionMessageFilter(process_id, browser_context));
 #endif
@@ -390,12 +412,11 @@ void AtomBrowserClient::RenderProcessWillLaunch(
   auto* web_preferences =
       WebContentsPreferences::From(GetWebContentsFromProcessID(process_id));
   if (web_preferences) {
-    prefs.sandbox = web_preferences->IsEnabled(options::kSandbox);
-    prefs.native_window_open =
-        web_preferences->IsEnabled(options::kNativeWindowOpen);
-    prefs.disable_popups = web_preferences->IsEnabled("disablePopups");
-    prefs.web_security = web_preferences->IsEnabled(options::kWebSecurity,
-                                                    true /* default value */);
+    const auto& parsed = web_preferences->parsed();
+    prefs.sandbox = parsed.sandbox;
+    prefs.native_window_open = parsed.native_window_open;
+    prefs.disable_popups = parsed.disable_popups;
+    prefs.web_security = parsed.web_security;
     prefs.browser_context = host->GetBrowserContext();
   }
 
@@ -586,6 +607,16 @@ void AtomBrowserClient::AppendExtraCommandLineSwitches(
       command_line->AppendSwitchPath(switches::kAppPath, app_path);
     }
 
+    static const char* const kRendererSwitchNames[] = {
+        switches::kContentScriptsInSubFrames};
+    command_line->CopySwitchesFrom(*base::CommandLine::ForCurrentProcess(),
+                                   kRendererSwitchNames,
+                                   base::size(kRendererSwitchNames));
+
+    base::FilePath asar_cache_dir = asar::GetExtractionCacheDir();
+    if (!asar_cache_dir.empty())
+      command_line->AppendSwitchPath(switches::kAsarCacheDir, asar_cache_dir);
+
     content::WebContents* web_contents =
         GetWebContentsFromProcessID(process_id);
     if (web_contents) {
@@ -1017,6 +1048,21 @@ std::string AtomBrowserClient::GetProduct() {
   return "Chrome/" CHROME_VERSION_STRING;
 }
 
+void AtomBrowserClient::PostAfterStartupTask(
+    const base::Location& from_here,
+    const scoped_refptr<base::SequencedTaskRunner>& task_runner,
+    base::OnceClosure task) {
+  electron::PostAfterStartupTask(from_here, task_runner, std::move(task));
+}
+
+bool AtomBrowserClient::IsBrowserStartupComplete() {
+  return electron::IsBrowserStartupComplete();
+}
+
+void AtomBrowserClient::SetBrowserStartupIsCompleteForTesting() {
+  electron::SetBrowserStartupIsComplete();
+}
+
 std::string AtomBrowserClient::GetUserAgent() {
   if (user_agent_override_.empty())
     return GetApplicationUserAgent();
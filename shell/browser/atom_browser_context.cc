@@ -8,6 +8,7 @@
 
 #include <utility>
 
+#include "base/barrier_closure.h"
 #include "base/command_line.h"
 #include "base/files/file_path.h"
 #include "base/path_service.h"
@@ -18,6 +19,7 @@
 #include "chrome/common/chrome_paths.h"
 #include "chrome/common/pref_names.h"
 #include "components/keyed_service/content/browser_context_dependency_manager.h"
+#include "components/prefs/in_memory_pref_store.h"
 #include "components/prefs/json_pref_store.h"
 #include "components/prefs/pref_registry_simple.h"
 #include "components/prefs/pref_service.h"
@@ -28,6 +30,7 @@
 #include "content/browser/blob_storage/chrome_blob_storage_context.h"  // nogncheck
 #include "content/public/browser/browser_thread.h"
 #include "content/public/browser/storage_partition.h"
+#include "mojo/public/cpp/bindings/clone_traits.h"
 #include "mojo/public/cpp/bindings/self_owned_receiver.h"
 #include "net/base/escape.h"
 #include "services/network/public/cpp/features.h"
@@ -39,7 +42,9 @@
 #include "shell/browser/atom_download_manager_delegate.h"
 #include "shell/browser/atom_paths.h"
 #include "shell/browser/atom_permission_manager.h"
+#include "shell/browser/coalescing_pref_store.h"
 #include "shell/browser/cookie_change_notifier.h"
+#include "shell/browser/net/preconnect_predictor.h"
 #include "shell/browser/net/resolve_proxy_helper.h"
 #include "shell/browser/pref_store_delegate.h"
 #include "shell/browser/special_storage_policy.h"
@@ -94,7 +99,7 @@ AtomBrowserContext::BrowserContextMap AtomBrowserContext::browser_context_map_;
 
 AtomBrowserContext::AtomBrowserContext(const std::string& partition,
                                        bool in_memory,
-                                       base::DictionaryValue options)
+                                       const Options& options)
     : base::RefCountedDeleteOnSequence<AtomBrowserContext>(
           base::ThreadTaskRunnerHandle::Get()),
       in_memory_pref_store_(nullptr),
@@ -106,10 +111,30 @@ AtomBrowserContext::AtomBrowserContext(const std::string& partition,
   // Read options.
   base::CommandLine* command_line = base::CommandLine::ForCurrentProcess();
   use_cache_ = !command_line->HasSwitch(switches::kDisableHttpCache);
-  options.GetBoolean("cache", &use_cache_);
+  lightweight_ = in_memory && options.lightweight;
+  if (lightweight_)
+    use_cache_ = false;
+  if (options.cache)
+    use_cache_ = *options.cache;
+  switch (options.cache_type) {
+    case Options::CacheType::kDefault:
+      break;
+    case Options::CacheType::kDisk:
+      use_cache_ = true;
+      break;
+    case Options::CacheType::kMemory:
+      use_cache_ = true;
+      use_memory_cache_ = true;
+      break;
+    case Options::CacheType::kNone:
+      use_cache_ = false;
+      break;
+  }
 
   base::StringToInt(command_line->GetSwitchValueASCII(switches::kDiskCacheSize),
                     &max_cache_size_);
+  if (options.cache_max_size)
+    max_cache_size_ = *options.cache_max_size;
 
   if (!base::PathService::Get(DIR_USER_DATA, &path_)) {
     base::PathService::Get(DIR_APP_DATA, &path_);
@@ -130,8 +155,6 @@ AtomBrowserContext::AtomBrowserContext(const std::string& partition,
   // Initialize Pref Registry.
   InitPrefs();
 
-  cookie_change_notifier_ = std::make_unique<CookieChangeNotifier>(this);
-
 #if BUILDFLAG(ENABLE_ELECTRON_EXTENSIONS)
   BrowserContextDependencyManager::GetInstance()->CreateBrowserContextServices(
       this);
@@ -156,13 +179,21 @@ AtomBrowserContext::~AtomBrowserContext() {
 }
 
 void AtomBrowserContext::InitPrefs() {
-  auto prefs_path = GetPath().Append(FILE_PATH_LITERAL("Preferences"));
   base::ThreadRestrictions::ScopedAllowIO allow_io;
   PrefServiceFactory prefs_factory;
-  scoped_refptr<JsonPrefStore> pref_store =
-      base::MakeRefCounted<JsonPrefStore>(prefs_path);
-  pref_store->ReadPrefs();  // Synchronous.
-  prefs_factory.set_user_prefs(pref_store);
+  if (lightweight_) {
+    // Otherwise every in-memory partition would read and write the
+    // Preferences file of the default session.
+    prefs_factory.set_user_prefs(base::MakeRefCounted<InMemoryPrefStore>());
+  } else {
+    auto prefs_path = GetPath().Append(FILE_PATH_LITERAL("Preferences"));
+    scoped_refptr<JsonPrefStore> pref_store =
+        base::MakeRefCounted<JsonPrefStore>(prefs_path);
+    pref_store->ReadPrefs();  // Synchronous.
+    coalescing_pref_store_ =
+        base::MakeRefCounted<CoalescingPrefStore>(std::move(pref_store));
+    prefs_factory.set_user_prefs(coalescing_pref_store_);
+  }
 
 #if BUILDFLAG(ENABLE_ELECTRON_EXTENSIONS)
   auto* ext_pref_store = new ExtensionPrefStore(
@@ -241,6 +272,10 @@ bool AtomBrowserContext::CanUseHttpCache() const {
   return use_cache_;
 }
 
+bool AtomBrowserContext::UseDiskCache() const {
+  return use_cache_ && !in_memory_ && !use_memory_cache_;
+}
+
 int AtomBrowserContext::GetMaxCacheSize() const {
   return max_cache_size_;
 }
@@ -305,6 +340,13 @@ predictors::PreconnectManager* AtomBrowserContext::GetPreconnectManager() {
   return preconnect_manager_.get();
 }
 
+void AtomBrowserContext::SetPreconnectPredictorEnabled(bool enabled) {
+  if (!enabled)
+    preconnect_predictor_.reset();
+  else if (!preconnect_predictor_)
+    preconnect_predictor_ = std::make_unique<PreconnectPredictor>(this);
+}
+
 scoped_refptr<network::SharedURLLoaderFactory>
 AtomBrowserContext::GetURLLoaderFactory() {
   if (url_loader_factory_)
@@ -417,9 +459,46 @@ void AtomBrowserContext::SetCorsOriginAccessListForOrigin(
     std::vector<network::mojom::CorsOriginPatternPtr> allow_patterns,
     std::vector<network::mojom::CorsOriginPatternPtr> block_patterns,
     base::OnceClosure closure) {
-  // TODO(nornagon): actually set the CORS access lists. This is called from
-  // extensions/browser/renderer_startup_helper.cc.
-  base::ThreadTaskRunnerHandle::Get()->PostTask(FROM_HERE, std::move(closure));
+  // Called from extensions/browser/renderer_startup_helper.cc.
+  std::vector<network::mojom::CorsOriginAccessPatternsPtr> lists;
+  lists.push_back(network::mojom::CorsOriginAccessPatterns::New(
+      source_origin, std::move(allow_patterns), std::move(block_patterns)));
+  SetCorsOriginAccessLists(std::move(lists), std::move(closure));
+}
+
+void AtomBrowserContext::SetCorsOriginAccessLists(
+    std::vector<network::mojom::CorsOriginAccessPatternsPtr> lists,
+    base::OnceClosure closure) {
+  auto* network_context =
+      content::BrowserContext::GetDefaultStoragePartition(this)
+          ->GetNetworkContext();
+  base::RepeatingClosure barrier =
+      base::BarrierClosure(lists.size(), std::move(closure));
+  for (auto& list : lists) {
+    network_context->SetCorsOriginAccessListsForOrigin(
+        list->source_origin, mojo::Clone(list->allow_patterns),
+        mojo::Clone(list->block_patterns), barrier);
+    url::Origin source_origin = list->source_origin;
+    if (list->allow_patterns.empty() && list->block_patterns.empty())
+      cors_origin_access_lists_.erase(source_origin);
+    else
+      cors_origin_access_lists_[source_origin] = std::move(list);
+  }
+}
+
+std::vector<network::mojom::CorsOriginAccessPatternsPtr>
+AtomBrowserContext::CloneCorsOriginAccessLists() const {
+  std::vector<network::mojom::CorsOriginAccessPatternsPtr> lists;
+  lists.reserve(cors_origin_access_lists_.size());
+  for (const auto& it : cors_origin_access_lists_)
+    lists.push_back(it.second.Clone());
+  return lists;
+}
+
+CookieChangeNotifier* AtomBrowserContext::cookie_change_notifier() {
+  if (!cookie_change_notifier_)
+    cookie_change_notifier_ = std::make_unique<CookieChangeNotifier>(this);
+  return cookie_change_notifier_.get();
 }
 
 ResolveProxyHelper* AtomBrowserContext::GetResolveProxyHelper() {
@@ -433,14 +512,14 @@ ResolveProxyHelper* AtomBrowserContext::GetResolveProxyHelper() {
 scoped_refptr<AtomBrowserContext> AtomBrowserContext::From(
     const std::string& partition,
     bool in_memory,
-    base::DictionaryValue options) {
+    const Options& options) {
   PartitionKey key(partition, in_memory);
   auto* browser_context = browser_context_map_[key].get();
   if (browser_context)
     return scoped_refptr<AtomBrowserContext>(browser_context);
 
   auto* new_context =
-      new AtomBrowserContext(partition, in_memory, std::move(options));
+      new AtomBrowserContext(partition, in_memory, options);
   browser_context_map_[key] = new_context->GetWeakPtr();
   return scoped_refptr<AtomBrowserContext>(new_context);
 }
@@ -12,11 +12,13 @@
 
 #include "base/memory/ref_counted_delete_on_sequence.h"
 #include "base/memory/weak_ptr.h"
+#include "base/optional.h"
 #include "chrome/browser/net/proxy_config_monitor.h"
 #include "chrome/browser/predictors/preconnect_manager.h"
 #include "content/public/browser/browser_context.h"
 #include "content/public/browser/resource_context.h"
 #include "electron/buildflags/buildflags.h"
+#include "services/network/public/mojom/cors_origin_pattern.mojom.h"
 #include "services/network/public/mojom/network_context.mojom.h"
 #include "services/network/public/mojom/url_loader_factory.mojom.h"
 #include "shell/browser/media/media_device_id_salt.h"
@@ -44,7 +46,9 @@ namespace electron {
 class AtomBrowserContext;
 class AtomDownloadManagerDelegate;
 class AtomPermissionManager;
+class CoalescingPrefStore;
 class CookieChangeNotifier;
+class PreconnectPredictor;
 class ResolveProxyHelper;
 class SpecialStoragePolicy;
 class WebViewManager;
@@ -54,6 +58,27 @@ class AtomBrowserContext
       public content::BrowserContext,
       public network::mojom::TrustedURLLoaderAuthClient {
  public:
+  // The options of session.fromPartition(), read straight from the JS object.
+  struct Options {
+    enum class CacheType {
+      kDefault,
+      kDisk,
+      kMemory,
+      kNone,
+    };
+
+    // Overrides the --disable-http-cache switch when set.
+    base::Optional<bool> cache;
+    // Overrides |cache| when it is not kDefault, in-memory partitions can only
+    // have a memory cache.
+    CacheType cache_type = CacheType::kDefault;
+    // Overrides the --disk-cache-size switch when set, in bytes.
+    base::Optional<int> cache_max_size;
+    // Whether an in-memory partition keeps its preferences in memory too, and
+    // skips the HTTP cache unless |cache| enables it.
+    bool lightweight = false;
+  };
+
   // partition_id => browser_context
   struct PartitionKey {
     std::string partition;
@@ -81,7 +106,7 @@ class AtomBrowserContext
   static scoped_refptr<AtomBrowserContext> From(
       const std::string& partition,
       bool in_memory,
-      base::DictionaryValue options = base::DictionaryValue());
+      const Options& options = Options());
 
   static BrowserContextMap browser_context_map() {
     return browser_context_map_;
@@ -90,9 +115,16 @@ class AtomBrowserContext
   void SetUserAgent(const std::string& user_agent);
   std::string GetUserAgent() const;
   bool CanUseHttpCache() const;
+  // Whether the HTTP cache is kept on disk rather than in memory.
+  bool UseDiskCache() const;
   int GetMaxCacheSize() const;
   ResolveProxyHelper* GetResolveProxyHelper();
   predictors::PreconnectManager* GetPreconnectManager();
+  // The predictor is only created while it is enabled.
+  void SetPreconnectPredictorEnabled(bool enabled);
+  PreconnectPredictor* preconnect_predictor() const {
+    return preconnect_predictor_.get();
+  }
   scoped_refptr<network::SharedURLLoaderFactory> GetURLLoaderFactory();
 
   // content::BrowserContext:
@@ -124,13 +156,33 @@ class AtomBrowserContext
       std::vector<network::mojom::CorsOriginPatternPtr> block_patterns,
       base::OnceClosure closure) override;
 
-  CookieChangeNotifier* cookie_change_notifier() const {
-    return cookie_change_notifier_.get();
-  }
+  // Replaces the CORS access lists of the source origins of |lists|, and runs
+  // |closure| once the network service applied all of them. The messages for
+  // the origins are pipelined, so none of them waits for the ones before.
+  void SetCorsOriginAccessLists(
+      std::vector<network::mojom::CorsOriginAccessPatternsPtr> lists,
+      base::OnceClosure closure);
+  // The lists set so far, which a new network context starts with.
+  std::vector<network::mojom::CorsOriginAccessPatternsPtr>
+  CloneCorsOriginAccessLists() const;
+
+  // Created when it is first used, so the partitions that never observe
+  // cookies do not listen to the cookie changes.
+  CookieChangeNotifier* cookie_change_notifier();
   ProxyConfigMonitor* proxy_config_monitor() {
     return proxy_config_monitor_.get();
   }
   PrefService* prefs() const { return prefs_.get(); }
+  // Whether the pages of the session with the same site and the same
+  // preferences share their renderer process.
+  bool share_renderer_processes() const { return share_renderer_processes_; }
+  void set_share_renderer_processes(bool share) {
+    share_renderer_processes_ = share;
+  }
+  // Unset for the partitions which keep their preferences in memory.
+  CoalescingPrefStore* coalescing_pref_store() const {
+    return coalescing_pref_store_.get();
+  }
   void set_in_memory_pref_store(ValueMapPrefStore* pref_store) {
     in_memory_pref_store_ = pref_store;
   }
@@ -150,7 +202,7 @@ class AtomBrowserContext
  protected:
   AtomBrowserContext(const std::string& partition,
                      bool in_memory,
-                     base::DictionaryValue options);
+                     const Options& options);
   ~AtomBrowserContext() override;
 
  private:
@@ -170,6 +222,7 @@ class AtomBrowserContext
 
   std::unique_ptr<content::ResourceContext> resource_context_;
   std::unique_ptr<CookieChangeNotifier> cookie_change_notifier_;
+  scoped_refptr<CoalescingPrefStore> coalescing_pref_store_;
   std::unique_ptr<PrefService> prefs_;
   std::unique_ptr<AtomDownloadManagerDelegate> download_manager_delegate_;
   std::unique_ptr<WebViewManager> guest_manager_;
@@ -183,11 +236,18 @@ class AtomBrowserContext
   std::unique_ptr<ProxyConfigMonitor> proxy_config_monitor_;
 
   std::unique_ptr<predictors::PreconnectManager> preconnect_manager_;
+  std::unique_ptr<PreconnectPredictor> preconnect_predictor_;
+
+  std::map<url::Origin, network::mojom::CorsOriginAccessPatternsPtr>
+      cors_origin_access_lists_;
 
   std::string user_agent_;
   base::FilePath path_;
   bool in_memory_ = false;
+  bool lightweight_ = false;
+  bool share_renderer_processes_ = false;
   bool use_cache_ = true;
+  bool use_memory_cache_ = false;
   int max_cache_size_ = 0;
 
 #if BUILDFLAG(ENABLE_ELECTRON_EXTENSIONS)
@@ -32,6 +32,7 @@
 #include "services/network/public/cpp/features.h"
 #include "services/tracing/public/cpp/stack_sampling/tracing_sampler_profiler.h"
 #include "shell/app/atom_main_delegate.h"
+#include "shell/browser/after_startup_tasks.h"
 #include "shell/browser/api/atom_api_app.h"
 #include "shell/browser/atom_browser_client.h"
 #include "shell/browser/atom_browser_context.h"
@@ -47,9 +48,12 @@
 #include "shell/common/api/electron_bindings.h"
 #include "shell/common/application_info.h"
 #include "shell/common/asar/asar_util.h"
+#include "shell/common/asar/extraction_cache.h"
+#include "shell/common/asar/readahead.h"
 #include "shell/common/gin_helper/trackable_object.h"
 #include "shell/common/node_bindings.h"
 #include "shell/common/node_includes.h"
+#include "shell/common/startup_timeline.h"
 #include "ui/base/idle/idle.h"
 #include "ui/base/material_design/material_design_controller.h"
 #include "ui/base/ui_base_switches.h"
@@ -210,6 +214,18 @@ int X11EmptyIOErrorHandler(Display* d) {
 }
 #endif
 
+// The user data directory is only decided once the app is ready, so before
+// that the default one is used like AtomBrowserContext does.
+base::FilePath GetAsarExtractionCacheDir() {
+  base::FilePath path;
+  if (!base::PathService::Get(DIR_USER_DATA, &path)) {
+    if (!base::PathService::Get(DIR_APP_DATA, &path))
+      return base::FilePath();
+    path = path.Append(base::FilePath::FromUTF8Unsafe(GetApplicationName()));
+  }
+  return path.Append(FILE_PATH_LITERAL("Asar Cache"));
+}
+
 }  // namespace
 
 // static
@@ -266,6 +282,8 @@ void AtomBrowserMainParts::RegisterDestructionCallback(
 }
 
 int AtomBrowserMainParts::PreEarlyInitialization() {
+  ScopedStartupPhase startup_phase(
+      "AtomBrowserMainParts::PreEarlyInitialization");
   field_trial_list_ = std::make_unique<base::FieldTrialList>(nullptr);
 #if defined(USE_X11)
   views::LinuxUI::SetInstance(BuildGtkUi());
@@ -285,10 +303,20 @@ int AtomBrowserMainParts::PreEarlyInitialization() {
 }
 
 void AtomBrowserMainParts::PostEarlyInitialization() {
+  ScopedStartupPhase startup_phase(
+      "AtomBrowserMainParts::PostEarlyInitialization");
   // A workaround was previously needed because there was no ThreadTaskRunner
   // set.  If this check is failing we may need to re-add that workaround
   DCHECK(base::ThreadTaskRunnerHandle::IsSet());
 
+  // Prefetch or record the archives read by the app while it starts.
+  asar::EnableStartupReadahead();
+
+  // Keep the native modules and executables extracted from archives between
+  // runs.
+  asar::SetExtractionCacheDirGetter(
+      base::BindRepeating(&GetAsarExtractionCacheDir));
+
   // The ProxyResolverV8 has setup a complete V8 environment, in order to
   // avoid conflicts we only initialize our V8 environment after that.
   js_env_ = std::make_unique<JavascriptEnvironment>(node_bindings_->uv_loop());
@@ -319,7 +347,7 @@ void AtomBrowserMainParts::PostEarlyInitialization() {
 
   // Enable support for v8 inspector
   node_debugger_ = std::make_unique<NodeDebugger>(env);
-  node_debugger_->Start();
+  node_debugger_->Start(true /* parse_command_line */);
 
   // Only run the node bootstrapper after we have initialized the inspector
   // TODO(MarshallOfSound): Figured out a better way to init the inspector
@@ -373,9 +401,6 @@ int AtomBrowserMainParts::PreCreateThreads() {
   // Force MediaCaptureDevicesDispatcher to be created on UI thread.
   MediaCaptureDevicesDispatcher::GetInstance();
 
-  // Force MediaCaptureDevicesDispatcher to be created on UI thread.
-  MediaCaptureDevicesDispatcher::GetInstance();
-
 #if defined(OS_MACOSX)
   ui::InitIdleMonitor();
 #endif
@@ -431,11 +456,18 @@ void AtomBrowserMainParts::ToolkitInitialized() {
 }
 
 void AtomBrowserMainParts::PreMainMessageLoopRun() {
+  ScopedStartupPhase startup_phase(
+      "AtomBrowserMainParts::PreMainMessageLoopRun");
   // Run user's main script before most things get initialized, so we can have
   // a chance to setup everything.
   node_bindings_->PrepareMessageLoop();
   node_bindings_->RunMessageLoop();
 
+  // The main script has run, so it had a chance to set the switch.
+  auto* command_line = base::CommandLine::ForCurrentProcess();
+  if (command_line->HasSwitch(switches::kEnableDeferredStartup))
+    EnableDeferredStartup();
+
 #if BUILDFLAG(ENABLE_ELECTRON_EXTENSIONS)
   extensions_client_ = std::make_unique<AtomExtensionsClient>();
   extensions::ExtensionsClient::Set(extensions_client_.get());
@@ -465,7 +497,6 @@ void AtomBrowserMainParts::PreMainMessageLoopRun() {
       AtomWebUIControllerFactory::GetInstance());
 
   // --remote-debugging-port
-  auto* command_line = base::CommandLine::ForCurrentProcess();
   if (command_line->HasSwitch(switches::kRemoteDebuggingPort))
     DevToolsManagerDelegate::StartHttpHandler();
 
@@ -475,6 +506,16 @@ void AtomBrowserMainParts::PreMainMessageLoopRun() {
   Browser::Get()->DidFinishLaunching(base::DictionaryValue());
 #endif
 
+  PostAfterStartupTask(FROM_HERE, base::ThreadTaskRunnerHandle::Get(),
+                       base::BindOnce(&asar::ScheduleExtractionCacheTrim));
+  PostAfterStartupTask(
+      FROM_HERE, base::ThreadTaskRunnerHandle::Get(),
+      base::BindOnce(&MediaCaptureDevicesDispatcher::StartDeviceMonitoring,
+                     base::Unretained(
+                         MediaCaptureDevicesDispatcher::GetInstance())));
+  asar::ClearArchivesOnMemoryPressure();
+  StartDeferredStartupTimeout();
+
   // Notify observers that main thread message loop was initialized.
   Browser::Get()->PreMainMessageLoopRun();
 }
@@ -8,6 +8,7 @@
 #include <utility>
 #include <vector>
 
+#include "base/stl_util.h"
 #include "content/public/browser/child_process_security_policy.h"
 #include "content/public/browser/permission_controller.h"
 #include "content/public/browser/permission_type.h"
@@ -23,6 +24,9 @@ namespace electron {
 
 namespace {
 
+// The most answers of the check handler that are cached.
+const size_t kMaxCachedChecks = 1024;
+
 bool WebContentsDestroyed(int process_id) {
   content::WebContents* web_contents =
       static_cast<AtomBrowserClient*>(AtomBrowserClient::Get())
@@ -110,6 +114,18 @@ void AtomPermissionManager::SetPermissionRequestHandler(
 void AtomPermissionManager::SetPermissionCheckHandler(
     const CheckHandler& handler) {
   check_handler_ = handler;
+  check_cache_.clear();
+}
+
+void AtomPermissionManager::ClearPermissionCheckCache(const GURL& origin) {
+  if (origin.is_empty()) {
+    check_cache_.clear();
+    return;
+  }
+  const std::string origin_spec = origin.GetOrigin().spec();
+  base::EraseIf(check_cache_, [&origin_spec](const auto& entry) {
+    return std::get<0>(entry.first) == origin_spec;
+  });
 }
 
 int AtomPermissionManager::RequestPermission(
@@ -245,16 +261,42 @@ bool AtomPermissionManager::CheckPermissionWithDetails(
   if (check_handler_.is_null()) {
     return true;
   }
+  const bool is_main_frame = render_frame_host->GetParent() == nullptr;
+  const std::string* media_type =
+      details ? details->FindStringKey("mediaType") : nullptr;
+  CheckCacheKey key(requesting_origin.GetOrigin().spec(), permission,
+                    media_type ? *media_type : std::string(), is_main_frame);
+  auto iter = check_cache_.find(key);
+  if (iter != check_cache_.end()) {
+    if (!iter->second.expiry || *iter->second.expiry > base::TimeTicks::Now())
+      return iter->second.granted;
+    check_cache_.erase(iter);
+  }
+
   auto* web_contents =
       content::WebContents::FromRenderFrameHost(render_frame_host);
   auto mutable_details =
       details == nullptr ? base::DictionaryValue() : details->Clone();
   mutable_details.SetStringKey("requestingUrl",
                                render_frame_host->GetLastCommittedURL().spec());
-  mutable_details.SetBoolKey("isMainFrame",
-                             render_frame_host->GetParent() == nullptr);
-  return check_handler_.Run(web_contents, permission, requesting_origin,
-                            mutable_details);
+  mutable_details.SetBoolKey("isMainFrame", is_main_frame);
+  CheckResult result = check_handler_.Run(web_contents, permission,
+                                          requesting_origin, mutable_details);
+  if (result.cache) {
+    if (check_cache_.size() >= kMaxCachedChecks) {
+      const base::TimeTicks now = base::TimeTicks::Now();
+      base::EraseIf(check_cache_, [now](const auto& entry) {
+        return entry.second.expiry && *entry.second.expiry <= now;
+      });
+      if (check_cache_.size() >= kMaxCachedChecks)
+        check_cache_.erase(check_cache_.begin());
+    }
+    CachedCheck& cached = check_cache_[key];
+    cached.granted = result.granted;
+    if (result.cache_ttl)
+      cached.expiry = base::TimeTicks::Now() + *result.cache_ttl;
+  }
+  return result.granted;
 }
 
 blink::mojom::PermissionStatus
@@ -7,10 +7,14 @@
 
 #include <map>
 #include <memory>
+#include <string>
+#include <tuple>
 #include <vector>
 
 #include "base/callback.h"
 #include "base/containers/id_map.h"
+#include "base/optional.h"
+#include "base/time/time.h"
 #include "base/values.h"
 #include "content/public/browser/permission_controller_delegate.h"
 
@@ -33,15 +37,27 @@ class AtomPermissionManager : public content::PermissionControllerDelegate {
                                              content::PermissionType,
                                              StatusCallback,
                                              const base::Value&)>;
-  using CheckHandler = base::Callback<bool(content::WebContents*,
-                                           content::PermissionType,
-                                           const GURL& requesting_origin,
-                                           const base::Value&)>;
+  // The answer of the check handler, which is reused for the following
+  // checks of the same kind when |cache| is set, until |cache_ttl| passes
+  // when it is set as well.
+  struct CheckResult {
+    bool granted = false;
+    bool cache = false;
+    base::Optional<base::TimeDelta> cache_ttl;
+  };
+  using CheckHandler = base::Callback<CheckResult(content::WebContents*,
+                                                  content::PermissionType,
+                                                  const GURL& requesting_origin,
+                                                  const base::Value&)>;
 
   // Handler to dispatch permission requests in JS.
   void SetPermissionRequestHandler(const RequestHandler& handler);
   void SetPermissionCheckHandler(const CheckHandler& handler);
 
+  // Forget the cached answers of the check handler, only those for |origin|
+  // when it is not empty.
+  void ClearPermissionCheckCache(const GURL& origin);
+
   // content::PermissionControllerDelegate:
   int RequestPermission(content::PermissionType permission,
                         content::RenderFrameHost* render_frame_host,
@@ -102,9 +118,20 @@ class AtomPermissionManager : public content::PermissionControllerDelegate {
   class PendingRequest;
   using PendingRequestsMap = base::IDMap<std::unique_ptr<PendingRequest>>;
 
+  // The cached answers are keyed by the requesting origin, the permission,
+  // the media type and whether the frame is the main frame.
+  using CheckCacheKey =
+      std::tuple<std::string, content::PermissionType, std::string, bool>;
+  struct CachedCheck {
+    bool granted;
+    base::Optional<base::TimeTicks> expiry;
+  };
+
   RequestHandler request_handler_;
   CheckHandler check_handler_;
 
+  mutable std::map<CheckCacheKey, CachedCheck> check_cache_;
+
   PendingRequestsMap pending_requests_;
 
   DISALLOW_COPY_AND_ASSIGN(AtomPermissionManager);
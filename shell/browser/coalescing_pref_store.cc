@@ -0,0 +1,141 @@
+// Copyright (c) 2020 GitHub, Inc.
+// Use of this source code is governed by the MIT license that can be
+// found in the LICENSE file.
+
+#include "shell/browser/coalescing_pref_store.h"
+
+#include <utility>
+
+#include "base/bind.h"
+#include "base/values.h"
+
+namespace electron {
+
+CoalescingPrefStore::CoalescingPrefStore(
+    scoped_refptr<PersistentPrefStore> store)
+    : store_(std::move(store)) {}
+
+CoalescingPrefStore::~CoalescingPrefStore() {
+  // The store writes its pending lossy changes when it is destroyed, but it
+  // may outlive this wrapper.
+  if (commit_timer_.IsRunning())
+    Commit();
+}
+
+void CoalescingPrefStore::SetCommitInterval(base::TimeDelta interval) {
+  commit_interval_ = interval;
+  if (commit_timer_.IsRunning()) {
+    commit_timer_.Stop();
+    Commit();
+  }
+}
+
+void CoalescingPrefStore::AddObserver(PrefStore::Observer* observer) {
+  store_->AddObserver(observer);
+}
+
+void CoalescingPrefStore::RemoveObserver(PrefStore::Observer* observer) {
+  store_->RemoveObserver(observer);
+}
+
+bool CoalescingPrefStore::HasObservers() const {
+  return store_->HasObservers();
+}
+
+bool CoalescingPrefStore::IsInitializationComplete() const {
+  return store_->IsInitializationComplete();
+}
+
+bool CoalescingPrefStore::GetValue(const std::string& key,
+                                   const base::Value** result) const {
+  return store_->GetValue(key, result);
+}
+
+std::unique_ptr<base::DictionaryValue> CoalescingPrefStore::GetValues() const {
+  return store_->GetValues();
+}
+
+void CoalescingPrefStore::SetValue(const std::string& key,
+                                   std::unique_ptr<base::Value> value,
+                                   uint32_t flags) {
+  store_->SetValue(key, std::move(value), Coalesce(flags));
+}
+
+void CoalescingPrefStore::RemoveValue(const std::string& key, uint32_t flags) {
+  store_->RemoveValue(key, Coalesce(flags));
+}
+
+bool CoalescingPrefStore::GetMutableValue(const std::string& key,
+                                          base::Value** result) {
+  return store_->GetMutableValue(key, result);
+}
+
+void CoalescingPrefStore::ReportValueChanged(const std::string& key,
+                                             uint32_t flags) {
+  store_->ReportValueChanged(key, Coalesce(flags));
+}
+
+void CoalescingPrefStore::SetValueSilently(const std::string& key,
+                                           std::unique_ptr<base::Value> value,
+                                           uint32_t flags) {
+  store_->SetValueSilently(key, std::move(value), Coalesce(flags));
+}
+
+void CoalescingPrefStore::RemoveValuesByPrefixSilently(
+    const std::string& prefix) {
+  store_->RemoveValuesByPrefixSilently(prefix);
+}
+
+bool CoalescingPrefStore::ReadOnly() const {
+  return store_->ReadOnly();
+}
+
+PersistentPrefStore::PrefReadError CoalescingPrefStore::GetReadError() const {
+  return store_->GetReadError();
+}
+
+PersistentPrefStore::PrefReadError CoalescingPrefStore::ReadPrefs() {
+  return store_->ReadPrefs();
+}
+
+void CoalescingPrefStore::ReadPrefsAsync(ReadErrorDelegate* error_delegate) {
+  store_->ReadPrefsAsync(error_delegate);
+}
+
+void CoalescingPrefStore::CommitPendingWrite(
+    base::OnceClosure reply_callback,
+    base::OnceClosure synchronous_done_callback) {
+  commit_timer_.Stop();
+  store_->CommitPendingWrite(std::move(reply_callback),
+                             std::move(synchronous_done_callback));
+}
+
+void CoalescingPrefStore::SchedulePendingLossyWrites() {
+  store_->SchedulePendingLossyWrites();
+}
+
+void CoalescingPrefStore::ClearMutableValues() {
+  store_->ClearMutableValues();
+}
+
+void CoalescingPrefStore::OnStoreDeletionFromDisk() {
+  store_->OnStoreDeletionFromDisk();
+}
+
+uint32_t CoalescingPrefStore::Coalesce(uint32_t flags) {
+  if (commit_interval_.is_zero() || (flags & LOSSY_PREF_WRITE_FLAG))
+    return flags;
+  if (!commit_timer_.IsRunning()) {
+    commit_timer_.Start(
+        FROM_HERE, commit_interval_,
+        base::BindOnce(&CoalescingPrefStore::Commit, base::Unretained(this)));
+  }
+  return flags | LOSSY_PREF_WRITE_FLAG;
+}
+
+void CoalescingPrefStore::Commit() {
+  // Serializes the changes now, and writes them on the store's task runner.
+  store_->CommitPendingWrite(base::OnceClosure(), base::OnceClosure());
+}
+
+}  // namespace electron
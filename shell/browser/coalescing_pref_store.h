@@ -0,0 +1,82 @@
+// Copyright (c) 2020 GitHub, Inc.
+// Use of this source code is governed by the MIT license that can be
+// found in the LICENSE file.
+
+#ifndef SHELL_BROWSER_COALESCING_PREF_STORE_H_
+#define SHELL_BROWSER_COALESCING_PREF_STORE_H_
+
+#include <memory>
+#include <string>
+
+#include "base/macros.h"
+#include "base/memory/scoped_refptr.h"
+#include "base/time/time.h"
+#include "base/timer/timer.h"
+#include "components/prefs/persistent_pref_store.h"
+
+namespace electron {
+
+// Forwards to a persistent store, but makes its writes lossy and commits them
+// once per interval, so that the preferences changed often, like the zoom
+// levels, do not serialize the whole file for each change. The store still
+// writes the file on its own task runner.
+class CoalescingPrefStore : public PersistentPrefStore {
+ public:
+  explicit CoalescingPrefStore(scoped_refptr<PersistentPrefStore> store);
+
+  // The writes are scheduled by the store itself while |interval| is zero.
+  void SetCommitInterval(base::TimeDelta interval);
+  base::TimeDelta commit_interval() const { return commit_interval_; }
+
+  // PrefStore:
+  void AddObserver(PrefStore::Observer* observer) override;
+  void RemoveObserver(PrefStore::Observer* observer) override;
+  bool HasObservers() const override;
+  bool IsInitializationComplete() const override;
+  bool GetValue(const std::string& key,
+                const base::Value** result) const override;
+  std::unique_ptr<base::DictionaryValue> GetValues() const override;
+
+  // WriteablePrefStore:
+  void SetValue(const std::string& key,
+                std::unique_ptr<base::Value> value,
+                uint32_t flags) override;
+  void RemoveValue(const std::string& key, uint32_t flags) override;
+  bool GetMutableValue(const std::string& key, base::Value** result) override;
+  void ReportValueChanged(const std::string& key, uint32_t flags) override;
+  void SetValueSilently(const std::string& key,
+                        std::unique_ptr<base::Value> value,
+                        uint32_t flags) override;
+  void RemoveValuesByPrefixSilently(const std::string& prefix) override;
+
+  // PersistentPrefStore:
+  bool ReadOnly() const override;
+  PrefReadError GetReadError() const override;
+  PrefReadError ReadPrefs() override;
+  void ReadPrefsAsync(ReadErrorDelegate* error_delegate) override;
+  void CommitPendingWrite(
+      base::OnceClosure reply_callback,
+      base::OnceClosure synchronous_done_callback) override;
+  void SchedulePendingLossyWrites() override;
+  void ClearMutableValues() override;
+  void OnStoreDeletionFromDisk() override;
+
+ private:
+  ~CoalescingPrefStore() override;
+
+  // Returns the flags to write with, and schedules the commit of a write which
+  // was not lossy.
+  uint32_t Coalesce(uint32_t flags);
+  void Commit();
+
+  scoped_refptr<PersistentPrefStore> store_;
+
+  base::TimeDelta commit_interval_;
+  base::OneShotTimer commit_timer_;
+
+  DISALLOW_COPY_AND_ASSIGN(CoalescingPrefStore);
+};
+
+}  // namespace electron
+
+#endif  // SHELL_BROWSER_COALESCING_PREF_STORE_H_
@@ -0,0 +1,114 @@
+/* Copyright (c) 2020 GitHub, Inc.
+ * Use of this source code is governed by the MIT license that can be
+ * found in the LICENSE file.
+ */
+
+/* The C interface that native addons loaded in the main process look up with
+ * dlsym() or GetProcAddress() on the executable, so that they can receive data
+ * without converting it to JavaScript values. It only uses C types, and new
+ * versions only append to the table of functions.
+ */
+
+#ifndef SHELL_BROWSER_ELECTRON_ADDON_API_H_
+#define SHELL_BROWSER_ELECTRON_ADDON_API_H_
+
+#include <stdint.h>
+
+#if defined(_WIN32)
+#define ELECTRON_ADDON_EXTERN __declspec(dllexport)
+#else
+#define ELECTRON_ADDON_EXTERN __attribute__((visibility("default")))
+#endif
+
+#define ELECTRON_ADDON_API_VERSION 2
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* A frame painted by an offscreen web contents. The pixels are 32 bit BGRA
+ * with premultiplied alpha, and are only valid during the callback.
+ */
+typedef struct electron_frame {
+  const void* pixels;
+  int32_t width;
+  int32_t height;
+  int32_t stride;
+  /* The part of the frame which was repainted. */
+  int32_t dirty_x;
+  int32_t dirty_y;
+  int32_t dirty_width;
+  int32_t dirty_height;
+} electron_frame;
+
+/* Called on the main thread of the main process, which must not block. To
+ * process a frame on another thread the callback copies its pixels.
+ */
+typedef void (*electron_frame_callback)(const electron_frame* frame,
+                                        void* user_data);
+
+/* What emits the events an addon hooks, with the `id` of its JavaScript
+ * object.
+ */
+typedef enum electron_event_target {
+  ELECTRON_EVENT_TARGET_WEB_CONTENTS = 0,
+  ELECTRON_EVENT_TARGET_WINDOW = 1,
+} electron_event_target;
+
+/* Called on the main thread of the main process when |target_id| emits
+ * |event_name|, before the JavaScript listeners run.
+ */
+typedef void (*electron_event_callback)(const char* event_name,
+                                        int32_t target_id,
+                                        void* user_data);
+
+typedef struct electron_addon_api {
+  /* The version of the table, which has all the functions of this version
+   * and of the ones before it.
+   */
+  uint32_t version;
+
+  /* Calls |callback| with each frame painted by the offscreen web contents
+   * |web_contents_id|, which is `webContents.id`. Returns the non-zero id of
+   * the hook, or 0 when there is no such web contents.
+   */
+  uint32_t (*add_paint_hook)(int32_t web_contents_id,
+                             electron_frame_callback callback,
+                             void* user_data);
+
+  /* Stops calling the callback of |hook_id|. */
+  void (*remove_paint_hook)(uint32_t hook_id);
+
+  /* Added in version 2. */
+
+  /* Calls |callback| each time |target_id| emits |event_name|, which is one
+   * of "dom-ready", "did-finish-load", "crashed" and "destroyed" for a web
+   * contents, and one of "resize", "move", "focus", "blur" and "closed" for a
+   * window. Returns the non-zero id of the hook, or 0 when there is no such
+   * target or event. The hooks are removed when their target is destroyed.
+   */
+  uint32_t (*add_event_hook)(electron_event_target target,
+                             int32_t target_id,
+                             const char* event_name,
+                             electron_event_callback callback,
+                             void* user_data);
+
+  /* Stops calling the callback of |hook_id|. */
+  void (*remove_event_hook)(uint32_t hook_id);
+} electron_addon_api;
+
+/* Returns the table of functions, or NULL when the executable is older than
+ * |version|. Must be called on the main thread, like the functions of the
+ * table.
+ */
+ELECTRON_ADDON_EXTERN const electron_addon_api* electron_get_addon_api(
+    uint32_t version);
+
+typedef const electron_addon_api* (*electron_get_addon_api_func)(
+    uint32_t version);
+
+#ifdef __cplusplus
+}  // extern "C"
+#endif
+
+#endif  // SHELL_BROWSER_ELECTRON_ADDON_API_H_
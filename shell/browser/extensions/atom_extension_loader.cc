@@ -4,17 +4,24 @@
 
 #include "shell/browser/extensions/atom_extension_loader.h"
 
+#include <map>
+#include <utility>
+
 #include "base/auto_reset.h"
+#include "base/barrier_closure.h"
 #include "base/bind.h"
 #include "base/files/file_path.h"
 #include "base/files/file_util.h"
 #include "base/logging.h"
 #include "base/sequenced_task_runner.h"
+#include "base/synchronization/lock.h"
+#include "base/task/post_task.h"
 #include "base/task_runner_util.h"
 #include "base/threading/thread_restrictions.h"
 #include "extensions/browser/extension_file_task_runner.h"
 #include "extensions/browser/extension_prefs.h"
 #include "extensions/browser/extension_registry.h"
+#include "extensions/common/constants.h"
 #include "extensions/common/file_util.h"
 
 namespace extensions {
@@ -56,12 +63,66 @@ scoped_refptr<const Extension> LoadUnpacked(
   return extension;
 }
 
+base::Time GetLastModified(const base::FilePath& path) {
+  base::File::Info info;
+  if (!base::GetFileInfo(path, &info))
+    return base::Time();
+  return info.last_modified;
+}
+
 }  // namespace
 
+// The extensions are immutable once loaded, so the ones loaded from a
+// directory are reused until the directory or its manifest is modified.
+// Used on the thread pool.
+class AtomExtensionLoader::ExtensionCache
+    : public base::RefCountedThreadSafe<ExtensionCache> {
+ public:
+  ExtensionCache() = default;
+
+  scoped_refptr<const Extension> Load(const base::FilePath& extension_dir) {
+    base::Time dir_modified = GetLastModified(extension_dir);
+    base::Time manifest_modified =
+        GetLastModified(extension_dir.Append(kManifestFilename));
+    {
+      base::AutoLock auto_lock(lock_);
+      auto it = entries_.find(extension_dir);
+      if (it != entries_.end() && !dir_modified.is_null() &&
+          it->second.dir_modified == dir_modified &&
+          it->second.manifest_modified == manifest_modified)
+        return it->second.extension;
+    }
+
+    scoped_refptr<const Extension> extension = LoadUnpacked(extension_dir);
+    base::AutoLock auto_lock(lock_);
+    if (extension)
+      entries_[extension_dir] = {dir_modified, manifest_modified, extension};
+    else
+      entries_.erase(extension_dir);
+    return extension;
+  }
+
+ private:
+  friend class base::RefCountedThreadSafe<ExtensionCache>;
+  ~ExtensionCache() = default;
+
+  struct Entry {
+    base::Time dir_modified;
+    base::Time manifest_modified;
+    scoped_refptr<const Extension> extension;
+  };
+
+  base::Lock lock_;
+  std::map<base::FilePath, Entry> entries_;
+
+  DISALLOW_COPY_AND_ASSIGN(ExtensionCache);
+};
+
 AtomExtensionLoader::AtomExtensionLoader(
     content::BrowserContext* browser_context)
     : browser_context_(browser_context),
       extension_registrar_(browser_context, this),
+      extension_cache_(base::MakeRefCounted<ExtensionCache>()),
       weak_factory_(this) {}
 
 AtomExtensionLoader::~AtomExtensionLoader() = default;
@@ -71,13 +132,55 @@ const Extension* AtomExtensionLoader::LoadExtension(
   // TODO(nornagon): load extensions asynchronously on
   // GetExtensionFileTaskRunner()
   base::ScopedAllowBlockingForTesting allow_blocking;
-  scoped_refptr<const Extension> extension = LoadUnpacked(extension_dir);
+  scoped_refptr<const Extension> extension =
+      extension_cache_->Load(extension_dir);
   if (extension)
     extension_registrar_.AddExtension(extension);
 
   return extension.get();
 }
 
+void AtomExtensionLoader::LoadExtensions(
+    const std::vector<base::FilePath>& extension_dirs,
+    LoadExtensionsCallback callback) {
+  // Each task fills its own slot, and the list is freed along with the
+  // barrier once all the tasks replied.
+  auto* extensions = new LoadedExtensions(extension_dirs.size());
+  base::RepeatingClosure barrier = base::BarrierClosure(
+      extension_dirs.size(),
+      base::BindOnce(&AtomExtensionLoader::FinishLoadExtensions,
+                     weak_factory_.GetWeakPtr(), std::move(callback),
+                     base::Owned(extensions)));
+  for (size_t i = 0; i < extension_dirs.size(); ++i) {
+    base::PostTaskAndReply(
+        FROM_HERE,
+        {base::ThreadPool(), base::MayBlock(),
+         base::TaskPriority::USER_BLOCKING},
+        base::BindOnce(
+            [](scoped_refptr<ExtensionCache> cache,
+               const base::FilePath& extension_dir,
+               scoped_refptr<const Extension>* extension) {
+              *extension = cache->Load(extension_dir);
+            },
+            extension_cache_, extension_dirs[i],
+            base::Unretained(&(*extensions)[i])),
+        barrier);
+  }
+}
+
+void AtomExtensionLoader::FinishLoadExtensions(
+    LoadExtensionsCallback callback,
+    LoadedExtensions* extensions) {
+  std::vector<const Extension*> result;
+  result.reserve(extensions->size());
+  for (const auto& extension : *extensions) {
+    if (extension)
+      extension_registrar_.AddExtension(extension);
+    result.push_back(extension.get());
+  }
+  std::move(callback).Run(result);
+}
+
 void AtomExtensionLoader::ReloadExtension(const ExtensionId& extension_id) {
   const Extension* extension = ExtensionRegistry::Get(browser_context_)
                                    ->GetInstalledExtension(extension_id);
@@ -7,7 +7,9 @@
 
 #include <memory>
 #include <string>
+#include <vector>
 
+#include "base/callback.h"
 #include "base/macros.h"
 #include "base/memory/ref_counted.h"
 #include "base/memory/weak_ptr.h"
@@ -36,6 +38,15 @@ class AtomExtensionLoader : public ExtensionRegistrar::Delegate {
   // extension on success, or nullptr otherwise.
   const Extension* LoadExtension(const base::FilePath& extension_dir);
 
+  // Loads the unpacked extensions from several directories in parallel on the
+  // thread pool, and adds them once they are all loaded. The extensions are
+  // passed in the order of their directories, nullptr for the ones which
+  // failed to load.
+  using LoadExtensionsCallback =
+      base::OnceCallback<void(const std::vector<const Extension*>&)>;
+  void LoadExtensions(const std::vector<base::FilePath>& extension_dirs,
+                      LoadExtensionsCallback callback);
+
   // Starts reloading the extension. A keep-alive is maintained until the
   // reload succeeds/fails. If the extension is an app, it will be launched upon
   // reloading.
@@ -47,6 +58,12 @@ class AtomExtensionLoader : public ExtensionRegistrar::Delegate {
                        extensions::UnloadedExtensionReason reason);
 
  private:
+  class ExtensionCache;
+  using LoadedExtensions = std::vector<scoped_refptr<const Extension>>;
+
+  void FinishLoadExtensions(LoadExtensionsCallback callback,
+                            LoadedExtensions* extensions);
+
   // If the extension loaded successfully, enables it. If it's an app, launches
   // it. If the load failed, updates ShellKeepAliveRequester.
   void FinishExtensionReload(const ExtensionId& old_extension_id,
@@ -71,6 +88,9 @@ class AtomExtensionLoader : public ExtensionRegistrar::Delegate {
   // Registers and unregisters extensions.
   ExtensionRegistrar extension_registrar_;
 
+  // The extensions loaded from directories which did not change since.
+  scoped_refptr<ExtensionCache> extension_cache_;
+
   // Holds keep-alives for relaunching apps.
   //   ShellKeepAliveRequester keep_alive_requester_;
 
@@ -6,6 +6,8 @@
 
 #include <memory>
 #include <string>
+#include <utility>
+#include <vector>
 
 #include "base/bind.h"
 #include "base/files/file_path.h"
@@ -48,6 +50,61 @@ const Extension* AtomExtensionSystem::LoadExtension(
   return extension_loader_->LoadExtension(extension_dir);
 }
 
+void AtomExtensionSystem::LoadExtensions(
+    const std::vector<base::FilePath>& extension_dirs,
+    base::OnceCallback<void(const std::vector<const Extension*>&)> callback) {
+  extension_loader_->LoadExtensions(extension_dirs, std::move(callback));
+}
+
+void AtomExtensionSystem::OpenMessageChannel(
+    const base::UnguessableToken& channel_id,
+    const ExtensionId& extension_id) {
+  message_channels_[channel_id] = extension_id;
+}
+
+void AtomExtensionSystem::RecordMessage(
+    const base::UnguessableToken& channel_id,
+    size_t size) {
+  auto it = message_channels_.find(channel_id);
+  if (it == message_channels_.end())
+    return;
+  MessageMetrics& metrics = message_metrics_[it->second];
+  base::TimeTicks now = base::TimeTicks::Now();
+  base::TimeDelta elapsed = now - metrics.window_start;
+  if (elapsed >= base::TimeDelta::FromSeconds(1)) {
+    // A window older than two seconds ended with no message since.
+    metrics.messages_per_second =
+        elapsed < base::TimeDelta::FromSeconds(2)
+            ? metrics.window_message_count / elapsed.InSecondsF()
+            : 0;
+    metrics.window_start = now;
+    metrics.window_message_count = 0;
+  }
+  ++metrics.window_message_count;
+  ++metrics.message_count;
+  metrics.byte_count += size;
+}
+
+void AtomExtensionSystem::CloseMessageChannel(
+    const base::UnguessableToken& channel_id) {
+  message_channels_.erase(channel_id);
+}
+
+AtomExtensionSystem::MessageMetrics AtomExtensionSystem::GetMessageMetrics(
+    const ExtensionId& extension_id) const {
+  auto it = message_metrics_.find(extension_id);
+  if (it == message_metrics_.end())
+    return MessageMetrics();
+  MessageMetrics metrics = it->second;
+  base::TimeDelta elapsed = base::TimeTicks::Now() - metrics.window_start;
+  if (elapsed >= base::TimeDelta::FromSeconds(2))
+    metrics.messages_per_second = 0;
+  else if (elapsed >= base::TimeDelta::FromSeconds(1))
+    metrics.messages_per_second =
+        metrics.window_message_count / elapsed.InSecondsF();
+  return metrics;
+}
+
 const Extension* AtomExtensionSystem::LoadApp(const base::FilePath& app_dir) {
   NOTIMPLEMENTED() << "Attempted to load platform app in Electron";
   return nullptr;
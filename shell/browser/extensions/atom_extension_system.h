@@ -5,15 +5,19 @@
 #ifndef SHELL_BROWSER_EXTENSIONS_ATOM_EXTENSION_SYSTEM_H_
 #define SHELL_BROWSER_EXTENSIONS_ATOM_EXTENSION_SYSTEM_H_
 
+#include <map>
 #include <memory>
 #include <string>
 #include <vector>
 
+#include "base/callback.h"
 #include "base/compiler_specific.h"
 #include "base/macros.h"
 #include "base/memory/ref_counted.h"
 #include "base/memory/weak_ptr.h"
 #include "base/one_shot_event.h"
+#include "base/time/time.h"
+#include "base/unguessable_token.h"
 #include "extensions/browser/extension_system.h"
 
 namespace base {
@@ -41,6 +45,12 @@ class AtomExtensionSystem : public ExtensionSystem {
   // success, or nullptr otherwise.
   const Extension* LoadExtension(const base::FilePath& extension_dir);
 
+  // Loads the unpacked extensions from several directories in parallel, see
+  // AtomExtensionLoader::LoadExtensions().
+  void LoadExtensions(
+      const std::vector<base::FilePath>& extension_dirs,
+      base::OnceCallback<void(const std::vector<const Extension*>&)> callback);
+
   // Loads an unpacked platform app from a directory. Returns the extension on
   // success, or nullptr otherwise.
   // Currently this just calls LoadExtension, as apps are not loaded differently
@@ -55,6 +65,23 @@ class AtomExtensionSystem : public ExtensionSystem {
 
   void RemoveExtension(const ExtensionId& extension_id);
 
+  // The runtime messages posted to the channels of an extension, from both of
+  // their ends.
+  struct MessageMetrics {
+    uint64_t message_count = 0;
+    uint64_t byte_count = 0;
+    // The messages per second over the last full second.
+    double messages_per_second = 0;
+
+    base::TimeTicks window_start;
+    uint64_t window_message_count = 0;
+  };
+  void OpenMessageChannel(const base::UnguessableToken& channel_id,
+                          const ExtensionId& extension_id);
+  void RecordMessage(const base::UnguessableToken& channel_id, size_t size);
+  void CloseMessageChannel(const base::UnguessableToken& channel_id);
+  MessageMetrics GetMessageMetrics(const ExtensionId& extension_id) const;
+
   // KeyedService implementation:
   void Shutdown() override;
 
@@ -110,6 +137,9 @@ class AtomExtensionSystem : public ExtensionSystem {
   // Signaled when the extension system has completed its startup tasks.
   base::OneShotEvent ready_;
 
+  std::map<base::UnguessableToken, ExtensionId> message_channels_;
+  std::map<ExtensionId, MessageMetrics> message_metrics_;
+
   base::WeakPtrFactory<AtomExtensionSystem> weak_factory_;
 
   DISALLOW_COPY_AND_ASSIGN(AtomExtensionSystem);
@@ -0,0 +1,113 @@
+// Copyright (c) 2020 GitHub, Inc.
+// Use of this source code is governed by the MIT license that can be
+// found in the LICENSE file.
+
+#include "shell/browser/extensions/electron_message_metrics_filter.h"
+
+#include "base/bind.h"
+#include "base/task/post_task.h"
+#include "base/unguessable_token.h"
+#include "content/public/browser/browser_task_traits.h"
+#include "content/public/browser/browser_thread.h"
+#include "content/public/browser/render_process_host.h"
+#include "extensions/common/api/messaging/message.h"
+#include "extensions/common/api/messaging/port_context.h"
+#include "extensions/common/api/messaging/port_id.h"
+#include "extensions/common/extension_messages.h"
+#include "shell/browser/extensions/atom_extension_system.h"
+
+namespace extensions {
+
+namespace {
+
+AtomExtensionSystem* GetExtensionSystem(int render_process_id) {
+  auto* host = content::RenderProcessHost::FromID(render_process_id);
+  if (!host)
+    return nullptr;
+  return static_cast<AtomExtensionSystem*>(
+      ExtensionSystem::Get(host->GetBrowserContext()));
+}
+
+void OpenMessageChannel(int render_process_id,
+                        const base::UnguessableToken& channel_id,
+                        const std::string& extension_id) {
+  if (auto* extension_system = GetExtensionSystem(render_process_id))
+    extension_system->OpenMessageChannel(channel_id, extension_id);
+}
+
+void RecordMessage(int render_process_id,
+                   const base::UnguessableToken& channel_id,
+                   size_t size) {
+  if (auto* extension_system = GetExtensionSystem(render_process_id))
+    extension_system->RecordMessage(channel_id, size);
+}
+
+void CloseMessageChannel(int render_process_id,
+                         const base::UnguessableToken& channel_id) {
+  if (auto* extension_system = GetExtensionSystem(render_process_id))
+    extension_system->CloseMessageChannel(channel_id);
+}
+
+}  // namespace
+
+ElectronMessageMetricsFilter::ElectronMessageMetricsFilter(
+    int render_process_id)
+    : BrowserMessageFilter(ExtensionMsgStart),
+      render_process_id_(render_process_id) {}
+
+ElectronMessageMetricsFilter::~ElectronMessageMetricsFilter() = default;
+
+bool ElectronMessageMetricsFilter::OnMessageReceived(
+    const IPC::Message& message) {
+  IPC_BEGIN_MESSAGE_MAP(ElectronMessageMetricsFilter, message)
+    IPC_MESSAGE_HANDLER(ExtensionHostMsg_OpenChannelToExtension,
+                        OnOpenChannelToExtension)
+    IPC_MESSAGE_HANDLER(ExtensionHostMsg_OpenChannelToTab, OnOpenChannelToTab)
+    IPC_MESSAGE_HANDLER(ExtensionHostMsg_PostMessage, OnPostMessage)
+    IPC_MESSAGE_HANDLER(ExtensionHostMsg_CloseMessagePort, OnCloseMessagePort)
+  IPC_END_MESSAGE_MAP()
+  // The messages are only observed, ExtensionMessageFilter handles them.
+  return false;
+}
+
+// The two ports of a channel share its context id. The metrics are kept on
+// the UI thread, where the messages are posted to in the order they arrive,
+// before ExtensionMessageFilter passes them on.
+void ElectronMessageMetricsFilter::OnOpenChannelToExtension(
+    const PortContext& source_context,
+    const ExtensionMsg_ExternalConnectionInfo& info,
+    const std::string& channel_name,
+    const PortId& port_id) {
+  base::PostTask(FROM_HERE, {content::BrowserThread::UI},
+                 base::BindOnce(&OpenMessageChannel, render_process_id_,
+                                port_id.context_id, info.target_id));
+}
+
+void ElectronMessageMetricsFilter::OnOpenChannelToTab(
+    const PortContext& source_context,
+    const ExtensionMsg_TabTargetConnectionInfo& info,
+    const std::string& extension_id,
+    const std::string& channel_name,
+    const PortId& port_id) {
+  base::PostTask(FROM_HERE, {content::BrowserThread::UI},
+                 base::BindOnce(&OpenMessageChannel, render_process_id_,
+                                port_id.context_id, extension_id));
+}
+
+void ElectronMessageMetricsFilter::OnPostMessage(const PortId& port_id,
+                                                 const Message& message) {
+  base::PostTask(FROM_HERE, {content::BrowserThread::UI},
+                 base::BindOnce(&RecordMessage, render_process_id_,
+                                port_id.context_id, message.data.size()));
+}
+
+void ElectronMessageMetricsFilter::OnCloseMessagePort(
+    const PortContext& port_context,
+    const PortId& port_id,
+    bool force_close) {
+  base::PostTask(FROM_HERE, {content::BrowserThread::UI},
+                 base::BindOnce(&CloseMessageChannel, render_process_id_,
+                                port_id.context_id));
+}
+
+}  // namespace extensions
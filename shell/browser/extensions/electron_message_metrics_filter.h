@@ -0,0 +1,59 @@
+// Copyright (c) 2020 GitHub, Inc.
+// Use of this source code is governed by the MIT license that can be
+// found in the LICENSE file.
+
+#ifndef SHELL_BROWSER_EXTENSIONS_ELECTRON_MESSAGE_METRICS_FILTER_H_
+#define SHELL_BROWSER_EXTENSIONS_ELECTRON_MESSAGE_METRICS_FILTER_H_
+
+#include <string>
+
+#include "base/macros.h"
+#include "content/public/browser/browser_message_filter.h"
+
+struct ExtensionMsg_ExternalConnectionInfo;
+struct ExtensionMsg_TabTargetConnectionInfo;
+
+namespace extensions {
+
+struct Message;
+struct PortContext;
+struct PortId;
+
+// Observes the runtime messaging of a render process, the channels opened by
+// runtime.sendMessage(), runtime.connect(), tabs.sendMessage() and
+// tabs.connect() and the messages posted to them from both of their ends,
+// which are counted in the metrics of the extension of their channel. The
+// messages are still handled by ExtensionMessageFilter, which must be added
+// after this filter.
+class ElectronMessageMetricsFilter : public content::BrowserMessageFilter {
+ public:
+  explicit ElectronMessageMetricsFilter(int render_process_id);
+
+  // content::BrowserMessageFilter:
+  bool OnMessageReceived(const IPC::Message& message) override;
+
+ private:
+  ~ElectronMessageMetricsFilter() override;
+
+  void OnOpenChannelToExtension(const PortContext& source_context,
+                                const ExtensionMsg_ExternalConnectionInfo& info,
+                                const std::string& channel_name,
+                                const PortId& port_id);
+  void OnOpenChannelToTab(const PortContext& source_context,
+                          const ExtensionMsg_TabTargetConnectionInfo& info,
+                          const std::string& extension_id,
+                          const std::string& channel_name,
+                          const PortId& port_id);
+  void OnPostMessage(const PortId& port_id, const Message& message);
+  void OnCloseMessagePort(const PortContext& port_context,
+                          const PortId& port_id,
+                          bool force_close);
+
+  const int render_process_id_;
+
+  DISALLOW_COPY_AND_ASSIGN(ElectronMessageMetricsFilter);
+};
+
+}  // namespace extensions
+
+#endif  // SHELL_BROWSER_EXTENSIONS_ELECTRON_MESSAGE_METRICS_FILTER_H_
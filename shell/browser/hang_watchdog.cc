@@ -0,0 +1,252 @@
+// Copyright (c) 2020 GitHub, Inc.
+// Use of this source code is governed by the MIT license that can be
+// found in the LICENSE file.
+
+#include "shell/browser/hang_watchdog.h"
+
+#include <inttypes.h>
+
+#include <algorithm>
+#include <utility>
+
+#include "base/bind.h"
+#include "base/memory/ref_counted.h"
+#include "base/profiler/module_cache.h"
+#include "base/profiler/profile_builder.h"
+#include "base/profiler/stack_sampling_profiler.h"
+#include "base/strings/stringprintf.h"
+#include "base/threading/thread_task_runner_handle.h"
+#include "gin/converter.h"
+#include "shell/common/crash_reporter/crash_reporter.h"
+
+namespace electron {
+
+namespace {
+
+// How many JavaScript frames are kept.
+const int kMaxJsFrames = 32;
+
+#if defined(OS_WIN) || defined(OS_MACOSX)
+// The native stacks are sampled this often during a hang, up to a number of
+// samples, so a long hang does not keep suspending the UI thread.
+constexpr base::TimeDelta kNativeSamplingInterval =
+    base::TimeDelta::FromMilliseconds(100);
+const int kMaxNativeSamples = 10;
+#endif
+
+// The UI thread is checked this many times per threshold.
+const int kChecksPerThreshold = 4;
+constexpr base::TimeDelta kMinCheckInterval =
+    base::TimeDelta::FromMilliseconds(10);
+
+std::string FrameToString(v8::Isolate* isolate,
+                          v8::Local<v8::StackFrame> frame) {
+  std::string function, script;
+  v8::Local<v8::String> function_name = frame->GetFunctionName();
+  if (!function_name.IsEmpty())
+    gin::ConvertFromV8(isolate, function_name, &function);
+  if (function.empty())
+    function = "<anonymous>";
+  v8::Local<v8::String> script_name = frame->GetScriptName();
+  if (!script_name.IsEmpty())
+    gin::ConvertFromV8(isolate, script_name, &script);
+  return base::StringPrintf("%s (%s:%d:%d)", function.c_str(), script.c_str(),
+                            frame->GetLineNumber(), frame->GetColumn());
+}
+
+}  // namespace
+
+// What is sampled of one hang, shared by the watchdog thread, the profiler
+// and the interrupt which runs on the UI thread.
+class HangWatchdog::Samples
+    : public base::RefCountedThreadSafe<HangWatchdog::Samples> {
+ public:
+  Samples() = default;
+
+  // Runs on the UI thread, inside of the JavaScript which holds it.
+  static void CaptureJsStack(v8::Isolate* isolate, void* data) {
+    std::unique_ptr<scoped_refptr<Samples>> samples(
+        static_cast<scoped_refptr<Samples>*>(data));
+    v8::HandleScope handle_scope(isolate);
+    v8::Local<v8::StackTrace> trace =
+        v8::StackTrace::CurrentStackTrace(isolate, kMaxJsFrames);
+    std::vector<std::string> js_stack;
+    for (int i = 0; i < trace->GetFrameCount(); ++i)
+      js_stack.push_back(FrameToString(isolate, trace->GetFrame(isolate, i)));
+
+    base::AutoLock auto_lock((*samples)->lock_);
+    // The interrupt only runs once JavaScript does, which may be after a
+    // native hang is over.
+    if (!(*samples)->closed_)
+      (*samples)->hang_.js_stack = std::move(js_stack);
+  }
+
+  void AddNativeStack(std::vector<std::string> stack) {
+    base::AutoLock auto_lock(lock_);
+    if (!closed_)
+      hang_.native_stacks.push_back(std::move(stack));
+  }
+
+  void SetMinidumpWritten() {
+    base::AutoLock auto_lock(lock_);
+    hang_.minidump_written = true;
+  }
+
+  // Returns what was sampled, and ignores what is sampled after.
+  Hang Close(base::TimeDelta duration) {
+    base::AutoLock auto_lock(lock_);
+    closed_ = true;
+    hang_.duration = duration;
+    return hang_;
+  }
+
+ private:
+  friend class base::RefCountedThreadSafe<Samples>;
+  ~Samples() = default;
+
+  base::Lock lock_;
+  bool closed_ = false;
+  Hang hang_;
+
+  DISALLOW_COPY_AND_ASSIGN(Samples);
+};
+
+#if defined(OS_WIN) || defined(OS_MACOSX)
+namespace {
+
+class NativeStackBuilder : public base::ProfileBuilder {
+ public:
+  explicit NativeStackBuilder(scoped_refptr<HangWatchdog::Samples> samples)
+      : samples_(std::move(samples)) {}
+  ~NativeStackBuilder() override = default;
+
+  // base::ProfileBuilder:
+  base::ModuleCache* GetModuleCache() override { return &module_cache_; }
+
+  void OnSampleCompleted(std::vector<base::Frame> frames) override {
+    std::vector<std::string> stack;
+    stack.reserve(frames.size());
+    for (const auto& frame : frames) {
+      if (frame.module) {
+        stack.push_back(base::StringPrintf(
+            "%s+0x%" PRIxPTR,
+            frame.module->GetDebugBasename().AsUTF8Unsafe().c_str(),
+            frame.instruction_pointer - frame.module->GetBaseAddress()));
+      } else {
+        stack.push_back(
+            base::StringPrintf("0x%" PRIxPTR, frame.instruction_pointer));
+      }
+    }
+    samples_->AddNativeStack(std::move(stack));
+  }
+
+  void OnProfileCompleted(base::TimeDelta profile_duration,
+                          base::TimeDelta sampling_period) override {}
+
+ private:
+  scoped_refptr<HangWatchdog::Samples> samples_;
+  base::ModuleCache module_cache_;
+
+  DISALLOW_COPY_AND_ASSIGN(NativeStackBuilder);
+};
+
+}  // namespace
+#endif
+
+HangWatchdog::Hang::Hang() = default;
+HangWatchdog::Hang::Hang(const Hang&) = default;
+HangWatchdog::Hang::~Hang() = default;
+
+HangWatchdog::HangWatchdog(v8::Isolate* isolate,
+                           base::TimeDelta threshold,
+                           bool write_minidump,
+                           const HangCallback& callback)
+    : isolate_(isolate),
+      threshold_(threshold),
+      write_minidump_(write_minidump),
+      callback_(callback),
+      ui_task_runner_(base::ThreadTaskRunnerHandle::Get()),
+#if defined(OS_WIN) || defined(OS_MACOSX)
+      ui_thread_token_(base::GetSamplingProfilerCurrentThreadToken()),
+#endif
+      thread_("ElectronHangWatchdog") {
+  weak_this_ = weak_factory_.GetWeakPtr();
+  thread_.Start();
+  thread_.task_runner()->PostTask(
+      FROM_HERE, base::BindOnce(&HangWatchdog::Check, base::Unretained(this)));
+}
+
+HangWatchdog::~HangWatchdog() {
+  // The tasks of the thread use |this| unretained.
+  thread_.Stop();
+}
+
+void HangWatchdog::Check() {
+  base::TimeTicks now = base::TimeTicks::Now();
+  bool hang_started = false;
+  bool hung = false;
+  {
+    base::AutoLock auto_lock(lock_);
+    if (heartbeat_posted_.is_null()) {
+      heartbeat_posted_ = now;
+      ui_task_runner_->PostTask(
+          FROM_HERE, base::BindOnce(&HangWatchdog::Heartbeat, weak_this_));
+    } else if (!samples_ && now - heartbeat_posted_ >= threshold_) {
+      samples_ = base::MakeRefCounted<Samples>();
+      hang_started = true;
+    }
+    hung = !!samples_;
+  }
+
+  if (hang_started)
+    OnHangStarted();
+  else if (!hung)
+    profiler_.reset();
+
+  thread_.task_runner()->PostDelayedTask(
+      FROM_HERE, base::BindOnce(&HangWatchdog::Check, base::Unretained(this)),
+      std::max(threshold_ / kChecksPerThreshold, kMinCheckInterval));
+}
+
+void HangWatchdog::OnHangStarted() {
+  scoped_refptr<Samples> samples;
+  {
+    base::AutoLock auto_lock(lock_);
+    samples = samples_;
+  }
+
+  // Deleted by the interrupt.
+  isolate_->RequestInterrupt(&Samples::CaptureJsStack,
+                             new scoped_refptr<Samples>(samples));
+
+#if defined(OS_WIN) || defined(OS_MACOSX)
+  base::StackSamplingProfiler::SamplingParams params;
+  params.initial_delay = base::TimeDelta();
+  params.samples_per_profile = kMaxNativeSamples;
+  params.sampling_interval = kNativeSamplingInterval;
+  profiler_ = std::make_unique<base::StackSamplingProfiler>(
+      ui_thread_token_, params, std::make_unique<NativeStackBuilder>(samples));
+  profiler_->Start();
+#endif
+
+  // The dump holds the stacks of all the threads as they are during the hang.
+  auto* crash_reporter = crash_reporter::CrashReporter::GetInstance();
+  if (write_minidump_ && crash_reporter->IsInitialized() &&
+      crash_reporter->DumpWithoutCrashing())
+    samples->SetMinidumpWritten();
+}
+
+void HangWatchdog::Heartbeat() {
+  scoped_refptr<Samples> samples;
+  base::TimeDelta duration;
+  {
+    base::AutoLock auto_lock(lock_);
+    duration = base::TimeTicks::Now() - heartbeat_posted_;
+    heartbeat_posted_ = base::TimeTicks();
+    samples = std::move(samples_);
+  }
+  if (samples)
+    callback_.Run(samples->Close(duration));
+}
+
+}  // namespace electron
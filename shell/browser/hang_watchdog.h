@@ -0,0 +1,102 @@
+// Copyright (c) 2020 GitHub, Inc.
+// Use of this source code is governed by the MIT license that can be
+// found in the LICENSE file.
+
+#ifndef SHELL_BROWSER_HANG_WATCHDOG_H_
+#define SHELL_BROWSER_HANG_WATCHDOG_H_
+
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "base/callback.h"
+#include "base/macros.h"
+#include "base/memory/scoped_refptr.h"
+#include "base/memory/weak_ptr.h"
+#include "base/profiler/sampling_profiler_thread_token.h"
+#include "base/single_thread_task_runner.h"
+#include "base/synchronization/lock.h"
+#include "base/threading/thread.h"
+#include "base/time/time.h"
+#include "v8/include/v8.h"
+
+namespace base {
+class StackSamplingProfiler;
+}
+
+namespace electron {
+
+// Watches the UI thread from a thread of its own, and when a task keeps it
+// busy for longer than the threshold, samples the stacks of the UI thread
+// until it is done. The hang is reported on the UI thread once it is over,
+// since nothing can run there before.
+class HangWatchdog {
+ public:
+  struct Hang {
+    Hang();
+    Hang(const Hang&);
+    ~Hang();
+
+    base::TimeDelta duration;
+    // The JavaScript frames which were running during the hang, as
+    // "function (url:line:column)", innermost first. Empty when the UI thread
+    // was blocked outside of JavaScript.
+    std::vector<std::string> js_stack;
+    // The native stacks sampled during the hang, as "module+0xoffset",
+    // innermost first. Only sampled on Windows and macOS.
+    std::vector<std::vector<std::string>> native_stacks;
+    bool minidump_written = false;
+  };
+
+  using HangCallback = base::RepeatingCallback<void(const Hang&)>;
+
+  // What is sampled of one hang.
+  class Samples;
+
+  // Must be created on the UI thread, which runs |isolate|.
+  HangWatchdog(v8::Isolate* isolate,
+               base::TimeDelta threshold,
+               bool write_minidump,
+               const HangCallback& callback);
+  ~HangWatchdog();
+
+ private:
+  // On the watchdog thread.
+  void Check();
+  void OnHangStarted();
+
+  // On the UI thread.
+  void Heartbeat();
+
+  v8::Isolate* isolate_;
+  const base::TimeDelta threshold_;
+  const bool write_minidump_;
+  HangCallback callback_;
+
+  scoped_refptr<base::SingleThreadTaskRunner> ui_task_runner_;
+#if defined(OS_WIN) || defined(OS_MACOSX)
+  base::SamplingProfilerThreadToken ui_thread_token_;
+#endif
+  base::Thread thread_;
+
+  // Guards the state below, which both threads use.
+  base::Lock lock_;
+  // When the heartbeat task waiting in the UI thread was posted, null when
+  // none is waiting.
+  base::TimeTicks heartbeat_posted_;
+  // What is sampled of the current hang, null when there is none.
+  scoped_refptr<Samples> samples_;
+
+  // Samples the native stacks of the current hang, only used on the watchdog
+  // thread.
+  std::unique_ptr<base::StackSamplingProfiler> profiler_;
+
+  base::WeakPtr<HangWatchdog> weak_this_;
+  base::WeakPtrFactory<HangWatchdog> weak_factory_{this};
+
+  DISALLOW_COPY_AND_ASSIGN(HangWatchdog);
+};
+
+}  // namespace electron
+
+#endif  // SHELL_BROWSER_HANG_WATCHDOG_H_
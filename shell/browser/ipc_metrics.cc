@@ -0,0 +1,176 @@
+// Copyright (c) 2020 GitHub, Inc.
+// Use of this source code is governed by the MIT license that can be
+// found in the LICENSE file.
+
+#include "shell/browser/ipc_metrics.h"
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <utility>
+
+#include "base/bind.h"
+#include "base/bits.h"
+#include "base/memory/singleton.h"
+#include "content/public/browser/browser_thread.h"
+
+namespace electron {
+
+namespace {
+
+// Buckets 0 to 3 hold exactly 0 to 3 microseconds, and every following
+// power of two is split into 4 buckets.
+size_t GetBucket(uint32_t microseconds) {
+  if (microseconds < 4)
+    return microseconds;
+  int log = base::bits::Log2Floor(microseconds);
+  uint32_t sub_bucket = (microseconds >> (log - 2)) & 3;
+  return (log - 1) * 4 + sub_bucket;
+}
+
+uint64_t GetBucketStart(size_t bucket) {
+  if (bucket < 4)
+    return bucket;
+  int log = bucket / 4 + 1;
+  return static_cast<uint64_t>(4 + bucket % 4) << (log - 2);
+}
+
+uint64_t GetBucketEnd(size_t bucket) {
+  if (bucket < 4)
+    return bucket + 1;
+  int log = bucket / 4 + 1;
+  return GetBucketStart(bucket) + (static_cast<uint64_t>(1) << (log - 2));
+}
+
+}  // namespace
+
+IpcMetrics::Scope::Scope(bool internal,
+                         const std::string& channel,
+                         size_t bytes)
+    : metrics_(nullptr) {
+  IpcMetrics* metrics = IpcMetrics::GetInstance();
+  if (internal || !metrics->enabled())
+    return;
+  metrics_ = metrics;
+  channel_ = channel;
+  start_ = base::TimeTicks::Now();
+  ChannelMetrics& channel_metrics = metrics_->GetChannel(channel_);
+  channel_metrics.messages++;
+  channel_metrics.bytes += bytes;
+}
+
+IpcMetrics::Scope::~Scope() {
+  if (!metrics_ || !metrics_->enabled())
+    return;
+  base::TimeDelta duration = base::TimeTicks::Now() - start_;
+  metrics_->GetChannel(channel_).handler_time.Record(duration);
+}
+
+IpcMetrics::ReplyCallback IpcMetrics::Scope::WrapReply(
+    ReplyCallback callback) {
+  if (!metrics_)
+    return callback;
+  return base::BindOnce(&IpcMetrics::RunReply, channel_, start_,
+                        std::move(callback));
+}
+
+IpcMetrics::LatencyHistogram::LatencyHistogram() = default;
+
+IpcMetrics::LatencyHistogram::~LatencyHistogram() = default;
+
+void IpcMetrics::LatencyHistogram::Record(base::TimeDelta duration) {
+  int64_t microseconds = std::max<int64_t>(duration.InMicroseconds(), 0);
+  microseconds =
+      std::min<int64_t>(microseconds, std::numeric_limits<uint32_t>::max());
+  buckets_[GetBucket(static_cast<uint32_t>(microseconds))]++;
+  count_++;
+  sum_ += duration;
+  max_ = std::max(max_, duration);
+}
+
+double IpcMetrics::LatencyHistogram::GetPercentile(double fraction) const {
+  auto rank = static_cast<uint64_t>(std::ceil(fraction * count_));
+  rank = std::max<uint64_t>(rank, 1);
+  uint64_t seen = 0;
+  for (size_t bucket = 0; bucket < kBucketCount; ++bucket) {
+    seen += buckets_[bucket];
+    if (seen >= rank) {
+      double middle = (GetBucketStart(bucket) + GetBucketEnd(bucket)) / 2.0;
+      return std::min(middle / 1000, max_.InMillisecondsF());
+    }
+  }
+  return max_.InMillisecondsF();
+}
+
+base::Value IpcMetrics::LatencyHistogram::ToValue() const {
+  base::Value value(base::Value::Type::DICTIONARY);
+  value.SetDoubleKey("count", count_);
+  value.SetDoubleKey("mean", count_ ? sum_.InMillisecondsF() / count_ : 0);
+  value.SetDoubleKey("p50", count_ ? GetPercentile(0.5) : 0);
+  value.SetDoubleKey("p90", count_ ? GetPercentile(0.9) : 0);
+  value.SetDoubleKey("p99", count_ ? GetPercentile(0.99) : 0);
+  value.SetDoubleKey("max", max_.InMillisecondsF());
+  return value;
+}
+
+// static
+IpcMetrics* IpcMetrics::GetInstance() {
+  return base::Singleton<IpcMetrics>::get();
+}
+
+IpcMetrics::IpcMetrics() = default;
+
+IpcMetrics::~IpcMetrics() = default;
+
+void IpcMetrics::SetEnabled(bool enabled) {
+  DCHECK_CURRENTLY_ON(content::BrowserThread::UI);
+  enabled_ = enabled;
+}
+
+void IpcMetrics::RecordOverBudget(const std::string& channel) {
+  if (enabled_)
+    GetChannel(channel).over_budget++;
+}
+
+void IpcMetrics::Reset() {
+  DCHECK_CURRENTLY_ON(content::BrowserThread::UI);
+  channels_.clear();
+}
+
+base::Value IpcMetrics::GetMetrics() const {
+  DCHECK_CURRENTLY_ON(content::BrowserThread::UI);
+  base::Value list(base::Value::Type::LIST);
+  for (const auto& it : channels_) {
+    base::Value channel(base::Value::Type::DICTIONARY);
+    channel.SetStringKey("channel", it.first);
+    // Doubles, since base::Value only has 32-bit integers.
+    channel.SetDoubleKey("messages", it.second.messages);
+    channel.SetDoubleKey("bytes", it.second.bytes);
+    channel.SetDoubleKey("overBudget", it.second.over_budget);
+    channel.SetKey("handlerTime", it.second.handler_time.ToValue());
+    channel.SetKey("replyTime", it.second.reply_time.ToValue());
+    list.Append(std::move(channel));
+  }
+  return list;
+}
+
+IpcMetrics::ChannelMetrics& IpcMetrics::GetChannel(
+    const std::string& channel) {
+  DCHECK_CURRENTLY_ON(content::BrowserThread::UI);
+  return channels_[channel];
+}
+
+// static
+void IpcMetrics::RunReply(std::string channel,
+                          base::TimeTicks start,
+                          ReplyCallback callback,
+                          blink::CloneableMessage result) {
+  IpcMetrics* metrics = IpcMetrics::GetInstance();
+  if (metrics->enabled()) {
+    base::TimeDelta duration = base::TimeTicks::Now() - start;
+    metrics->GetChannel(channel).reply_time.Record(duration);
+  }
+  std::move(callback).Run(std::move(result));
+}
+
+}  // namespace electron
@@ -0,0 +1,134 @@
+// Copyright (c) 2020 GitHub, Inc.
+// Use of this source code is governed by the MIT license that can be
+// found in the LICENSE file.
+
+#ifndef SHELL_BROWSER_IPC_METRICS_H_
+#define SHELL_BROWSER_IPC_METRICS_H_
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include <array>
+#include <string>
+#include <unordered_map>
+
+#include "base/callback.h"
+#include "base/macros.h"
+#include "base/time/time.h"
+#include "base/values.h"
+#include "third_party/blink/public/common/messaging/cloneable_message.h"
+
+namespace base {
+template <typename T>
+struct DefaultSingletonTraits;
+}
+
+namespace electron {
+
+// IpcMetrics is a singleton that records, per channel, the messages the
+// ipcMain module received from renderers. It is disabled by default, and
+// recording costs nothing but a flag check while it is.
+//
+// It also holds the budget of the handlers of sync messages, which is used
+// independently of whether recording is enabled.
+//
+// Must only be used on the UI thread.
+class IpcMetrics {
+ public:
+  using ReplyCallback = base::OnceCallback<void(blink::CloneableMessage)>;
+
+  // Measures the handling of one message received on |channel|. The time
+  // from its construction to its destruction counts as time spent in the
+  // handlers of the channel.
+  class Scope {
+   public:
+    Scope(bool internal, const std::string& channel, size_t bytes);
+    ~Scope();
+
+    // Returns a callback that records the time until the reply is sent before
+    // running |callback|.
+    ReplyCallback WrapReply(ReplyCallback callback);
+
+   private:
+    // Null when the message is not recorded, in which case |channel_| stays
+    // empty.
+    IpcMetrics* metrics_;
+    std::string channel_;
+    base::TimeTicks start_;
+
+    DISALLOW_COPY_AND_ASSIGN(Scope);
+  };
+
+  static IpcMetrics* GetInstance();
+
+  bool enabled() const { return enabled_; }
+  void SetEnabled(bool enabled);
+
+  // A zero budget disables the detection of slow sync handlers.
+  base::TimeDelta sync_budget() const { return sync_budget_; }
+  void set_sync_budget(base::TimeDelta budget) { sync_budget_ = budget; }
+
+  // Counts a sync message on |channel| that was replied to after the budget.
+  void RecordOverBudget(const std::string& channel);
+
+  // Forgets everything recorded so far.
+  void Reset();
+
+  // Returns a list with a dictionary of the metrics of every channel, see
+  // docs/api/structures/ipc-channel-metrics.md.
+  base::Value GetMetrics() const;
+
+ private:
+  friend struct base::DefaultSingletonTraits<IpcMetrics>;
+
+  // Approximates the distribution of durations with 4 buckets per power of
+  // two microseconds, so percentiles are off by at most 12.5%.
+  class LatencyHistogram {
+   public:
+    LatencyHistogram();
+    ~LatencyHistogram();
+
+    void Record(base::TimeDelta duration);
+    base::Value ToValue() const;
+
+   private:
+    // Enough for durations up to UINT32_MAX microseconds, which is what
+    // Record() clamps them to.
+    static const size_t kBucketCount = 124;
+
+    double GetPercentile(double fraction) const;
+
+    std::array<uint32_t, kBucketCount> buckets_ = {};
+    uint64_t count_ = 0;
+    base::TimeDelta sum_;
+    base::TimeDelta max_;
+  };
+
+  struct ChannelMetrics {
+    uint64_t messages = 0;
+    uint64_t bytes = 0;
+    uint64_t over_budget = 0;
+    LatencyHistogram handler_time;
+    LatencyHistogram reply_time;
+  };
+
+  IpcMetrics();
+  ~IpcMetrics();
+
+  ChannelMetrics& GetChannel(const std::string& channel);
+
+  static void RunReply(std::string channel,
+                       base::TimeTicks start,
+                       ReplyCallback callback,
+                       blink::CloneableMessage result);
+
+  bool enabled_ = false;
+  base::TimeDelta sync_budget_;
+  std::unordered_map<std::string, ChannelMetrics> channels_;
+
+  DISALLOW_COPY_AND_ASSIGN(IpcMetrics);
+};
+
+}  // namespace electron
+
+#endif  // SHELL_BROWSER_IPC_METRICS_H_
@@ -0,0 +1,37 @@
+// Copyright (c) 2020 GitHub, Inc.
+// Use of this source code is governed by the MIT license that can be
+// found in the LICENSE file.
+
+#include "shell/browser/ipc_ring_buffer_host.h"
+
+#include <utility>
+
+#include "base/trace_event/trace_event.h"
+#include "mojo/public/cpp/bindings/message.h"
+
+namespace electron {
+
+IpcRingBufferHost::IpcRingBufferHost(const std::string& channel,
+                                     uint32_t capacity,
+                                     base::WritableSharedMemoryMapping mapping,
+                                     const RecordsCallback& callback)
+    : channel_(channel),
+      mapping_(std::move(mapping)),
+      ring_buffer_(mapping_.memory(), capacity),
+      callback_(callback) {}
+
+IpcRingBufferHost::~IpcRingBufferHost() = default;
+
+void IpcRingBufferHost::Notify() {
+  TRACE_EVENT1("electron", "IpcRingBufferHost::Notify", "channel", channel_);
+  std::vector<uint8_t> data;
+  std::vector<uint32_t> sizes;
+  if (!ring_buffer_.Read(&data, &sizes)) {
+    mojo::ReportBadMessage("Corrupted IPC ring buffer");
+    return;
+  }
+  if (!sizes.empty())
+    callback_.Run(channel_, std::move(data), std::move(sizes));
+}
+
+}  // namespace electron
@@ -0,0 +1,48 @@
+// Copyright (c) 2020 GitHub, Inc.
+// Use of this source code is governed by the MIT license that can be
+// found in the LICENSE file.
+
+#ifndef SHELL_BROWSER_IPC_RING_BUFFER_HOST_H_
+#define SHELL_BROWSER_IPC_RING_BUFFER_HOST_H_
+
+#include <string>
+#include <vector>
+
+#include "base/callback.h"
+#include "base/memory/shared_memory_mapping.h"
+#include "shell/common/api/api.mojom.h"
+#include "shell/common/ipc_ring_buffer.h"
+
+namespace electron {
+
+// The browser end of a ring buffer opened with ElectronBrowser.OpenRingBuffer,
+// which drains the buffer every time the frame rings the doorbell.
+class IpcRingBufferHost : public mojom::ElectronRingBuffer {
+ public:
+  // Called with the records of one batch, see IpcRingBuffer::Read.
+  using RecordsCallback =
+      base::RepeatingCallback<void(const std::string& channel,
+                                   std::vector<uint8_t> data,
+                                   std::vector<uint32_t> sizes)>;
+
+  IpcRingBufferHost(const std::string& channel,
+                    uint32_t capacity,
+                    base::WritableSharedMemoryMapping mapping,
+                    const RecordsCallback& callback);
+  ~IpcRingBufferHost() override;
+
+  // mojom::ElectronRingBuffer:
+  void Notify() override;
+
+ private:
+  std::string channel_;
+  base::WritableSharedMemoryMapping mapping_;
+  IpcRingBuffer ring_buffer_;
+  RecordsCallback callback_;
+
+  DISALLOW_COPY_AND_ASSIGN(IpcRingBufferHost);
+};
+
+}  // namespace electron
+
+#endif  // SHELL_BROWSER_IPC_RING_BUFFER_HOST_H_
@@ -58,6 +58,17 @@ MediaCaptureDevicesDispatcher::GetVideoCaptureDevices() {
   return content::MediaCaptureDevices::GetInstance()->GetVideoCaptureDevices();
 }
 
+void MediaCaptureDevicesDispatcher::StartDeviceMonitoring() {
+  DCHECK(BrowserThread::CurrentlyOn(BrowserThread::UI));
+  if (is_device_enumeration_disabled_)
+    return;
+  // Getting the lists starts the device monitor of the media stream manager,
+  // which also makes it answer the enumerations of the frames from its cache.
+  auto* devices = content::MediaCaptureDevices::GetInstance();
+  devices->GetAudioCaptureDevices();
+  devices->GetVideoCaptureDevices();
+}
+
 void MediaCaptureDevicesDispatcher::GetDefaultDevices(
     bool audio,
     bool video,
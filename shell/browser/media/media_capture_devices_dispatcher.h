@@ -24,6 +24,13 @@ class MediaCaptureDevicesDispatcher : public content::MediaObserver {
   const blink::MediaStreamDevices& GetAudioCaptureDevices();
   const blink::MediaStreamDevices& GetVideoCaptureDevices();
 
+  // Starts watching the capture devices of the OS. They are enumerated once,
+  // and their lists are then kept up to date from the device change
+  // notifications, for all the sessions. Called once the app has started, so
+  // that neither the permission requests nor enumerateDevices wait for a scan
+  // of the devices.
+  void StartDeviceMonitoring();
+
   // Helper to get the default devices which can be used by the media request.
   // Uses the first available devices if the default devices are not available.
   // If the return list is empty, it means there is no available device on the
@@ -1,21 +1,56 @@
-
 // Copyright (c) 2018 GitHub, Inc.
 // Use of this source code is governed by the MIT license that can be
 // found in the LICENSE file.
 
 #include "shell/browser/microtasks_runner.h"
+
+#include "base/logging.h"
+#include "base/trace_event/trace_event.h"
 #include "v8/include/v8.h"
 
 namespace electron {
 
-MicrotasksRunner::MicrotasksRunner(v8::Isolate* isolate) : isolate_(isolate) {}
+namespace {
+
+// The runner of the browser process, the only isolate that has one.
+MicrotasksRunner* g_microtasks_runner = nullptr;
+
+}  // namespace
+
+MicrotasksRunner::MicrotasksRunner(v8::Isolate* isolate) : isolate_(isolate) {
+  DCHECK(!g_microtasks_runner);
+  g_microtasks_runner = this;
+  // V8 calls this whenever the outermost call into it returns, which covers
+  // both running JavaScript and queueing microtasks through the V8 API.
+  isolate_->AddCallCompletedCallback(&MicrotasksRunner::OnCallCompleted);
+}
+
+MicrotasksRunner::~MicrotasksRunner() {
+  isolate_->RemoveCallCompletedCallback(&MicrotasksRunner::OnCallCompleted);
+  g_microtasks_runner = nullptr;
+}
 
 void MicrotasksRunner::WillProcessTask(const base::PendingTask& pending_task,
                                        bool was_blocked_or_low_priority) {}
 
 void MicrotasksRunner::DidProcessTask(const base::PendingTask& pending_task) {
-  v8::Isolate::Scope scope(isolate_);
-  v8::MicrotasksScope::PerformCheckpoint(isolate_);
+  if (!entered_v8_) {
+    skipped_checkpoints_++;
+  } else {
+    // Cleared before the checkpoint, which enters V8 when it runs microtasks.
+    entered_v8_ = false;
+    checkpoints_++;
+    v8::Isolate::Scope scope(isolate_);
+    v8::MicrotasksScope::PerformCheckpoint(isolate_);
+  }
+  TRACE_COUNTER2("electron", "MicrotasksRunner", "checkpoints", checkpoints_,
+                 "skipped", skipped_checkpoints_);
+}
+
+// static
+void MicrotasksRunner::OnCallCompleted(v8::Isolate* isolate) {
+  if (g_microtasks_runner && g_microtasks_runner->isolate_ == isolate)
+    g_microtasks_runner->entered_v8_ = true;
 }
 
 }  // namespace electron
@@ -5,6 +5,9 @@
 #ifndef SHELL_BROWSER_MICROTASKS_RUNNER_H_
 #define SHELL_BROWSER_MICROTASKS_RUNNER_H_
 
+#include <stdint.h>
+
+#include "base/macros.h"
 #include "base/task/task_observer.h"
 
 namespace v8 {
@@ -19,9 +22,13 @@ namespace electron {
 // Node follows the kExplicit MicrotasksPolicy, and we do the same in browser
 // process. Hence, we need to have this task observer to flush the queued
 // microtasks.
+//
+// Most tasks of the UI thread never enter V8, so the checkpoint is skipped
+// for the tasks during which no call into V8 completed.
 class MicrotasksRunner : public base::TaskObserver {
  public:
   explicit MicrotasksRunner(v8::Isolate* isolate);
+  ~MicrotasksRunner() override;
 
   // base::TaskObserver
   void WillProcessTask(const base::PendingTask& pending_task,
@@ -29,7 +36,17 @@ class MicrotasksRunner : public base::TaskObserver {
   void DidProcessTask(const base::PendingTask& pending_task) override;
 
  private:
+  static void OnCallCompleted(v8::Isolate* isolate);
+
   v8::Isolate* isolate_;
+
+  // Whether V8 was entered since the last checkpoint.
+  bool entered_v8_ = true;
+
+  uint64_t checkpoints_ = 0;
+  uint64_t skipped_checkpoints_ = 0;
+
+  DISALLOW_COPY_AND_ASSIGN(MicrotasksRunner);
 };
 
 }  // namespace electron
@@ -9,9 +9,11 @@
 #include <utility>
 #include <vector>
 
+#include "base/bind.h"
 #include "base/memory/ptr_util.h"
 #include "base/strings/utf_string_conversions.h"
 #include "shell/browser/browser.h"
+#include "shell/browser/native_browser_view.h"
 #include "shell/browser/window_list.h"
 #include "shell/common/color_util.h"
 #include "shell/common/gin_helper/dictionary.h"
@@ -28,6 +30,11 @@ namespace electron {
 
 namespace {
 
+// The resize observers are notified at most this often while the resize
+// events are coalesced, which is about once per frame.
+constexpr base::TimeDelta kResizeEventInterval =
+    base::TimeDelta::FromMilliseconds(16);
+
 #if defined(OS_WIN)
 gfx::Size GetExpandedWindowSize(const NativeWindow* window, gfx::Size size) {
   if (!window->transparent() || !ui::win::IsAeroGlassEnabled())
@@ -155,6 +162,10 @@ void NativeWindow::InitFromOptions(const gin_helper::Dictionary& options) {
   if (options.Get(options::kKiosk, &kiosk) && kiosk) {
     SetKiosk(kiosk);
   }
+  bool coalesce_resize_events;
+  if (options.Get(options::kCoalesceResizeEvents, &coalesce_resize_events)) {
+    SetCoalesceResizeEvents(coalesce_resize_events);
+  }
 #if defined(OS_MACOSX)
   std::string type;
   if (options.Get(options::kVibrancyType, &type)) {
@@ -328,6 +339,12 @@ void NativeWindow::SetParentWindow(NativeWindow* parent) {
   parent_ = parent;
 }
 
+void NativeWindow::SetBrowserViewsBounds(
+    const std::vector<std::pair<NativeBrowserView*, gfx::Rect>>& bounds) {
+  for (const auto& view_bounds : bounds)
+    view_bounds.first->SetBounds(view_bounds.second);
+}
+
 void NativeWindow::SetAutoHideCursor(bool auto_hide) {}
 
 void NativeWindow::SelectPreviousTab() {}
@@ -349,7 +366,9 @@ void NativeWindow::SetVibrancy(const std::string& filename) {}
 void NativeWindow::SetTouchBar(
     std::vector<gin_helper::PersistentDictionary> items) {}
 
-void NativeWindow::RefreshTouchBarItem(const std::string& item_id) {}
+void NativeWindow::RefreshTouchBarItem(
+    const std::string& item_id,
+    const std::vector<std::string>& properties) {}
 
 void NativeWindow::SetEscapeTouchBarItem(
     gin_helper::PersistentDictionary item) {}
@@ -449,6 +468,14 @@ void NativeWindow::NotifyWindowHide() {
     observer.OnWindowHide();
 }
 
+void NativeWindow::NotifyWindowOcclusionChanged(bool occluded) {
+  if (is_occluded_ == occluded)
+    return;
+  is_occluded_ = occluded;
+  for (NativeWindowObserver& observer : observers_)
+    observer.OnWindowOcclusionChanged(occluded);
+}
+
 void NativeWindow::NotifyWindowMaximize() {
   for (NativeWindowObserver& observer : observers_)
     observer.OnWindowMaximize();
@@ -482,10 +509,51 @@ void NativeWindow::NotifyWindowWillMove(const gfx::Rect& new_bounds,
 }
 
 void NativeWindow::NotifyWindowResize() {
+  if (resize_start_time_.is_null())
+    resize_start_time_ = base::TimeTicks::Now();
+
+  if (coalesce_resize_events_) {
+    if (resize_timer_.IsRunning()) {
+      resize_pending_ = true;
+      return;
+    }
+    resize_timer_.Start(FROM_HERE, kResizeEventInterval,
+                        base::BindOnce(&NativeWindow::OnResizeTimer,
+                                       base::Unretained(this)));
+  }
+
   for (NativeWindowObserver& observer : observers_)
     observer.OnWindowResize();
 }
 
+void NativeWindow::NotifyWindowResizeFramePresented() {
+  if (resize_start_time_.is_null())
+    return;
+  base::TimeDelta latency = base::TimeTicks::Now() - resize_start_time_;
+  resize_start_time_ = base::TimeTicks();
+  ++resize_latency_.count;
+  resize_latency_.last = latency;
+  resize_latency_.total += latency;
+  resize_latency_.max = std::max(resize_latency_.max, latency);
+}
+
+void NativeWindow::SetCoalesceResizeEvents(bool coalesce) {
+  coalesce_resize_events_ = coalesce;
+  if (!coalesce && resize_timer_.IsRunning()) {
+    resize_timer_.Stop();
+    OnResizeTimer();
+  }
+}
+
+void NativeWindow::OnResizeTimer() {
+  // The last resize of the frame is notified at its end, which also starts the
+  // next frame.
+  if (resize_pending_) {
+    resize_pending_ = false;
+    NotifyWindowResize();
+  }
+}
+
 void NativeWindow::NotifyWindowMove() {
   for (NativeWindowObserver& observer : observers_)
     observer.OnWindowMove();
@@ -10,12 +10,15 @@
 #include <memory>
 #include <string>
 #include <tuple>
+#include <utility>
 #include <vector>
 
 #include "base/memory/weak_ptr.h"
 #include "base/observer_list.h"
 #include "base/strings/string16.h"
 #include "base/supports_user_data.h"
+#include "base/time/time.h"
+#include "base/timer/timer.h"
 #include "base/values.h"
 #include "content/public/browser/desktop_media_id.h"
 #include "content/public/browser/web_contents_user_data.h"
@@ -165,6 +168,9 @@ class NativeWindow : public base::SupportsUserData,
   virtual void SetParentWindow(NativeWindow* parent);
   virtual void AddBrowserView(NativeBrowserView* browser_view) = 0;
   virtual void RemoveBrowserView(NativeBrowserView* browser_view) = 0;
+  // Sets the bounds of several browser views in one layout pass.
+  virtual void SetBrowserViewsBounds(
+      const std::vector<std::pair<NativeBrowserView*, gfx::Rect>>& bounds);
   virtual content::DesktopMediaID GetDesktopMediaID() const = 0;
   virtual gfx::NativeView GetNativeView() const = 0;
   virtual gfx::NativeWindow GetNativeWindow() const = 0;
@@ -196,7 +202,10 @@ class NativeWindow : public base::SupportsUserData,
 
   // Touchbar API
   virtual void SetTouchBar(std::vector<gin_helper::PersistentDictionary> items);
-  virtual void RefreshTouchBarItem(const std::string& item_id);
+  // Updates the given properties of the item, or all of them when
+  // |properties| is empty.
+  virtual void RefreshTouchBarItem(const std::string& item_id,
+                                   const std::vector<std::string>& properties);
   virtual void SetEscapeTouchBarItem(gin_helper::PersistentDictionary item);
 
   // Native Tab API
@@ -253,6 +262,9 @@ class NativeWindow : public base::SupportsUserData,
   void NotifyWindowFocus();
   void NotifyWindowShow();
   void NotifyWindowHide();
+  void NotifyWindowOcclusionChanged(bool occluded);
+  // Called when the page drew its first frame after the window was resized.
+  void NotifyWindowResizeFramePresented();
   void NotifyWindowMaximize();
   void NotifyWindowUnmaximize();
   void NotifyWindowMinimize();
@@ -300,6 +312,24 @@ class NativeWindow : public base::SupportsUserData,
   NativeWindow* parent() const { return parent_; }
   bool is_modal() const { return is_modal_; }
 
+  // Whether the window is covered by other windows while it is shown.
+  bool is_occluded() const { return is_occluded_; }
+
+  // The time the pages took to draw a frame after the window was resized.
+  struct ResizeLatency {
+    uint64_t count = 0;
+    base::TimeDelta last;
+    base::TimeDelta total;
+    base::TimeDelta max;
+  };
+  const ResizeLatency& resize_latency() const { return resize_latency_; }
+
+  // The resize observers are notified at most once per frame while the resize
+  // events are coalesced. The will-resize notifications are never coalesced,
+  // since they can prevent the resize.
+  void SetCoalesceResizeEvents(bool coalesce);
+  bool coalesce_resize_events() const { return coalesce_resize_events_; }
+
   std::list<NativeBrowserView*> browser_views() const { return browser_views_; }
 
  protected:
@@ -320,6 +350,8 @@ class NativeWindow : public base::SupportsUserData,
   }
 
  private:
+  void OnResizeTimer();
+
   std::unique_ptr<views::Widget> widget_;
 
   // The content view, weak ref.
@@ -356,6 +388,17 @@ class NativeWindow : public base::SupportsUserData,
   // Is this a modal window.
   bool is_modal_ = false;
 
+  bool is_occluded_ = false;
+
+  bool coalesce_resize_events_ = false;
+  // Whether a resize happened while the observers could not be notified.
+  bool resize_pending_ = false;
+  base::OneShotTimer resize_timer_;
+
+  // The first resize which the page did not draw a frame for yet.
+  base::TimeTicks resize_start_time_;
+  ResizeLatency resize_latency_;
+
   // The browser view layer.
   std::list<NativeBrowserView*> browser_views_;
 
@@ -107,6 +107,9 @@ class NativeWindowMac : public NativeWindow {
   void SetFocusable(bool focusable) override;
   void AddBrowserView(NativeBrowserView* browser_view) override;
   void RemoveBrowserView(NativeBrowserView* browser_view) override;
+  void SetBrowserViewsBounds(
+      const std::vector<std::pair<NativeBrowserView*, gfx::Rect>>& bounds)
+      override;
   void SetParentWindow(NativeWindow* parent) override;
   content::DesktopMediaID GetDesktopMediaID() const override;
   gfx::NativeView GetNativeView() const override;
@@ -134,7 +137,9 @@ class NativeWindowMac : public NativeWindow {
   void SetVibrancy(const std::string& type) override;
   void SetTouchBar(
       std::vector<gin_helper::PersistentDictionary> items) override;
-  void RefreshTouchBarItem(const std::string& item_id) override;
+  void RefreshTouchBarItem(
+      const std::string& item_id,
+      const std::vector<std::string>& properties) override;
   void SetEscapeTouchBarItem(gin_helper::PersistentDictionary item) override;
   void SetGTKDarkThemeEnabled(bool use_dark_theme) override {}
 
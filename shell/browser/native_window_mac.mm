@@ -7,6 +7,7 @@
 #include <AvailabilityMacros.h>
 #include <objc/objc-runtime.h>
 
+#include <set>
 #include <string>
 #include <vector>
 
@@ -1198,6 +1199,15 @@ void NativeWindowMac::RemoveBrowserView(NativeBrowserView* view) {
   [CATransaction commit];
 }
 
+void NativeWindowMac::SetBrowserViewsBounds(
+    const std::vector<std::pair<NativeBrowserView*, gfx::Rect>>& bounds) {
+  // The frames are committed together, without animating.
+  [CATransaction begin];
+  [CATransaction setDisableActions:YES];
+  NativeWindow::SetBrowserViewsBounds(bounds);
+  [CATransaction commit];
+}
+
 void NativeWindowMac::SetParentWindow(NativeWindow* parent) {
   InternalSetParentWindow(parent, IsVisible());
 }
@@ -1496,10 +1506,15 @@ void NativeWindowMac::SetTouchBar(
   }
 }
 
-void NativeWindowMac::RefreshTouchBarItem(const std::string& item_id) {
+void NativeWindowMac::RefreshTouchBarItem(
+    const std::string& item_id,
+    const std::vector<std::string>& properties) {
   if (@available(macOS 10.12.2, *)) {
     if (touch_bar_ && [window_ touchBar])
-      [touch_bar_ refreshTouchBarItem:[window_ touchBar] id:item_id];
+      [touch_bar_ refreshTouchBarItem:[window_ touchBar]
+                                   id:item_id
+                           properties:std::set<std::string>(properties.begin(),
+                                                            properties.end())];
   }
 }
 
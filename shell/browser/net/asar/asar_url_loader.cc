@@ -4,13 +4,17 @@
 
 #include "shell/browser/net/asar/asar_url_loader.h"
 
+#include <algorithm>
 #include <memory>
 #include <string>
 #include <utility>
 #include <vector>
 
+#include "base/memory/ref_counted_memory.h"
+#include "base/stl_util.h"
 #include "base/strings/stringprintf.h"
 #include "base/task/post_task.h"
+#include "base/trace_event/trace_event.h"
 #include "content/public/browser/file_url_loader.h"
 #include "mojo/public/cpp/bindings/receiver.h"
 #include "mojo/public/cpp/bindings/remote.h"
@@ -24,6 +28,8 @@
 #include "services/network/public/mojom/url_response_head.mojom.h"
 #include "shell/common/asar/archive.h"
 #include "shell/common/asar/asar_util.h"
+#include "shell/common/asar/entry_decompressor.h"
+#include "shell/common/asar/readahead.h"
 
 namespace asar {
 
@@ -53,6 +59,108 @@ static_assert(kDefaultFileUrlPipeSize >= net::kMaxBytesToSniff,
               "Default file data pipe size must be at least as large as a MIME-"
               "type sniffing buffer.");
 
+// Large responses get a pipe that holds a good part of them, so that the
+// producer is not woken up again for every 64 KB the renderer consumes.
+// Together with the memory mapped archive this streams large WASM and media
+// files with a single copy, at close to disk speed.
+constexpr size_t kMaxFileUrlPipeSize = 4 * 1024 * 1024;
+
+uint32_t GetPipeSize(uint64_t bytes_to_send) {
+  uint32_t size = kDefaultFileUrlPipeSize;
+  while (size < bytes_to_send && size < kMaxFileUrlPipeSize)
+    size *= 2;
+  return size;
+}
+
+// Reads a range of a memory mapped archive. It holds a reference to the
+// archive because the producer may still read from it on its own sequence
+// after the loader is gone.
+class MappedDataSource : public mojo::DataPipeProducer::DataSource {
+ public:
+  MappedDataSource(std::shared_ptr<Archive> archive,
+                   base::span<const uint8_t> data)
+      : archive_(std::move(archive)), data_(data) {}
+  ~MappedDataSource() override = default;
+
+  // mojo::DataPipeProducer::DataSource:
+  uint64_t GetLength() const override { return data_.size(); }
+  ReadResult Read(uint64_t offset, base::span<char> buffer) override {
+    ReadResult result;
+    if (offset > data_.size()) {
+      result.result = MOJO_RESULT_OUT_OF_RANGE;
+      return result;
+    }
+    size_t read_size = std::min<uint64_t>(data_.size() - offset, buffer.size());
+    memcpy(buffer.data(), data_.data() + offset, read_size);
+    result.bytes_read = read_size;
+    return result;
+  }
+
+ private:
+  std::shared_ptr<Archive> archive_;
+  base::span<const uint8_t> data_;
+
+  DISALLOW_COPY_AND_ASSIGN(MappedDataSource);
+};
+
+// Streams a range of a compressed entry, inflating it chunk by chunk as the
+// producer asks for more data. Compressed entries can only be read from their
+// start, so a range starting at |skip| is served by inflating and dropping
+// everything before it. The compressed bytes are either kept alive by holding
+// a reference to the memory mapped archive, or owned in |stored|.
+class CompressedDataSource : public mojo::DataPipeProducer::DataSource {
+ public:
+  CompressedDataSource(std::shared_ptr<Archive> archive,
+                       scoped_refptr<base::RefCountedString> stored,
+                       base::span<const uint8_t> input,
+                       uint64_t skip,
+                       uint64_t length)
+      : archive_(std::move(archive)),
+        stored_(std::move(stored)),
+        decompressor_(input),
+        skip_(skip),
+        length_(length) {}
+  ~CompressedDataSource() override = default;
+
+  // mojo::DataPipeProducer::DataSource:
+  uint64_t GetLength() const override { return length_; }
+  ReadResult Read(uint64_t offset, base::span<char> buffer) override {
+    ReadResult result;
+    // The producer always reads sequentially.
+    if (offset != produced_ || offset > length_) {
+      result.result = MOJO_RESULT_OUT_OF_RANGE;
+      return result;
+    }
+    if (skip_ > 0) {
+      if (!decompressor_.Skip(skip_)) {
+        result.result = MOJO_RESULT_DATA_LOSS;
+        return result;
+      }
+      skip_ = 0;
+    }
+
+    size_t read_size = std::min<uint64_t>(length_ - offset, buffer.size());
+    int bytes_read = decompressor_.Read(buffer.first(read_size));
+    if (bytes_read < 0) {
+      result.result = MOJO_RESULT_DATA_LOSS;
+      return result;
+    }
+    produced_ += bytes_read;
+    result.bytes_read = bytes_read;
+    return result;
+  }
+
+ private:
+  std::shared_ptr<Archive> archive_;
+  scoped_refptr<base::RefCountedString> stored_;
+  EntryDecompressor decompressor_;
+  uint64_t skip_;
+  uint64_t length_;
+  uint64_t produced_ = 0;
+
+  DISALLOW_COPY_AND_ASSIGN(CompressedDataSource);
+};
+
 // Modified from the |FileURLLoader| in |file_url_loader_factory.cc|, to serve
 // asar files instead of normal files.
 class AsarURLLoader : public network::mojom::URLLoader {
@@ -87,6 +195,8 @@ class AsarURLLoader : public network::mojom::URLLoader {
              mojo::PendingReceiver<network::mojom::URLLoader> loader,
              mojo::PendingRemote<network::mojom::URLLoaderClient> client,
              scoped_refptr<net::HttpResponseHeaders> extra_response_headers) {
+    TRACE_EVENT1("electron.asar", "AsarURLLoader::Start", "url",
+                 request.url.spec());
     auto head = network::mojom::URLResponseHead::New();
     head->request_start = base::TimeTicks::Now();
     head->response_start = base::TimeTicks::Now();
@@ -132,24 +242,54 @@ class AsarURLLoader : public network::mojom::URLLoader {
       info.offset = 0;
     }
 
-    mojo::DataPipe pipe(kDefaultFileUrlPipeSize);
-    if (!pipe.consumer_handle.is_valid()) {
-      OnClientComplete(net::ERR_FAILED);
-      return;
+    // Packed files are served straight from the memory mapped archive when
+    // possible, which needs neither a new file handle nor any copy on our side.
+    base::span<const uint8_t> view;
+    const bool is_mapped =
+        !info.unpacked && archive->ReadView(relative_path, &view);
+
+    // Compressed files are inflated while streaming, when the archive is not
+    // mapped their compressed bytes are read into memory first.
+    scoped_refptr<base::RefCountedString> stored;
+    if (info.compressed && !is_mapped) {
+      RecordArchiveRead(archive->path(), info.offset, info.stored_size);
+      stored = base::MakeRefCounted<base::RefCountedString>();
+      stored->data().resize(info.stored_size);
+      base::File file(archive->path(),
+                      base::File::FLAG_OPEN | base::File::FLAG_READ);
+      if (file.Read(info.offset, base::data(stored->data()),
+                    info.stored_size) != static_cast<int>(info.stored_size)) {
+        OnClientComplete(net::ERR_FAILED);
+        return;
+      }
+      view = base::make_span(stored->front(), stored->size());
     }
 
-    // Note that while the |Archive| already opens a |base::File|, we still need
-    // to create a new |base::File| here, as it might be accessed by multiple
-    // requests at the same time.
-    base::File file(info.unpacked ? real_path : archive->path(),
-                    base::File::FLAG_OPEN | base::File::FLAG_READ);
-    auto file_data_source =
-        std::make_unique<mojo::FileDataSource>(std::move(file));
-    mojo::DataPipeProducer::DataSource* data_source = file_data_source.get();
+    std::unique_ptr<mojo::FileDataSource> file_data_source;
+    std::unique_ptr<mojo::DataPipeProducer::DataSource> data_source;
+    if (info.compressed) {
+      data_source = std::make_unique<CompressedDataSource>(archive, stored,
+                                                           view, 0, info.size);
+    } else if (is_mapped) {
+      data_source = std::make_unique<MappedDataSource>(archive, view);
+    } else {
+      // Note that while the |Archive| already opens a |base::File|, we still
+      // need to create a new |base::File| here, as it might be accessed by
+      // multiple requests at the same time.
+      base::File file(info.unpacked ? real_path : archive->path(),
+                      base::File::FLAG_OPEN | base::File::FLAG_READ);
+      if (!info.unpacked)
+        RecordArchiveRead(archive->path(), info.offset, info.size);
+      file_data_source =
+          std::make_unique<mojo::FileDataSource>(std::move(file));
+    }
 
     std::vector<char> initial_read_buffer(net::kMaxBytesToSniff);
     auto read_result =
-        data_source->Read(info.offset, base::span<char>(initial_read_buffer));
+        data_source
+            ? data_source->Read(0, base::span<char>(initial_read_buffer))
+            : file_data_source->Read(info.offset,
+                                     base::span<char>(initial_read_buffer));
     if (read_result.result != MOJO_RESULT_OK) {
       OnClientComplete(ConvertMojoResultToNetError(read_result.result));
       return;
@@ -188,6 +328,15 @@ class AsarURLLoader : public network::mojom::URLLoader {
 
     total_bytes_written_ = total_bytes_to_send;
 
+    auto pipe =
+        std::make_unique<mojo::DataPipe>(GetPipeSize(total_bytes_to_send));
+    if (!pipe->consumer_handle.is_valid())
+      pipe = std::make_unique<mojo::DataPipe>(kDefaultFileUrlPipeSize);
+    if (!pipe->consumer_handle.is_valid()) {
+      OnClientComplete(net::ERR_FAILED);
+      return;
+    }
+
     head->content_length = base::saturated_cast<int64_t>(total_bytes_to_send);
 
     if (first_byte_to_send < read_result.bytes_read) {
@@ -198,7 +347,7 @@ class AsarURLLoader : public network::mojom::URLLoader {
           static_cast<uint32_t>(read_result.bytes_read - first_byte_to_send),
           static_cast<uint32_t>(total_bytes_to_send));
       const uint32_t expected_write_size = write_size;
-      MojoResult result = pipe.producer_handle->WriteData(
+      MojoResult result = pipe->producer_handle->WriteData(
           &initial_read_buffer[first_byte_to_send], &write_size,
           MOJO_WRITE_DATA_FLAG_NONE);
       if (result != MOJO_RESULT_OK || write_size != expected_write_size) {
@@ -225,7 +374,7 @@ class AsarURLLoader : public network::mojom::URLLoader {
                              head->mime_type.c_str()));
     }
     client_->OnReceiveResponse(std::move(head));
-    client_->OnStartLoadingResponseBody(std::move(pipe.consumer_handle));
+    client_->OnStartLoadingResponseBody(std::move(pipe->consumer_handle));
 
     if (total_bytes_to_send == 0) {
       // There's definitely no more data, so we're already done.
@@ -233,19 +382,33 @@ class AsarURLLoader : public network::mojom::URLLoader {
       return;
     }
 
-    // In case of a range request, seek to the appropriate position before
-    // sending the remaining bytes asynchronously. Under normal conditions
-    // (i.e., no range request) this Seek is effectively a no-op.
-    //
-    // Note that in Electron we also need to add file offset.
-    file_data_source->SetRange(
-        first_byte_to_send + info.offset,
-        first_byte_to_send + info.offset + total_bytes_to_send);
+    if (info.compressed) {
+      // Range requests on compressed files inflate and drop everything before
+      // the first requested byte.
+      data_source = std::make_unique<CompressedDataSource>(
+          archive, stored, view, first_byte_to_send, total_bytes_to_send);
+    } else if (is_mapped) {
+      data_source = std::make_unique<MappedDataSource>(
+          archive, view.subspan(first_byte_to_send, total_bytes_to_send));
+    } else {
+      // In case of a range request, seek to the appropriate position before
+      // sending the remaining bytes asynchronously. Under normal conditions
+      // (i.e., no range request) this Seek is effectively a no-op.
+      //
+      // Note that in Electron we also need to add file offset.
+      file_data_source->SetRange(
+          first_byte_to_send + info.offset,
+          first_byte_to_send + info.offset + total_bytes_to_send);
+      data_source = std::move(file_data_source);
+    }
 
+    TRACE_EVENT_NESTABLE_ASYNC_BEGIN1("electron.asar", "AsarURLLoader::Write",
+                                      TRACE_ID_LOCAL(this), "bytes",
+                                      total_bytes_to_send);
     data_producer_ = std::make_unique<mojo::DataPipeProducer>(
-        std::move(pipe.producer_handle));
+        std::move(pipe->producer_handle));
     data_producer_->Write(
-        std::move(file_data_source),
+        std::move(data_source),
         base::BindOnce(&AsarURLLoader::OnFileWritten, base::Unretained(this)));
   }
 
@@ -268,6 +431,10 @@ class AsarURLLoader : public network::mojom::URLLoader {
   void OnFileWritten(MojoResult result) {
     // All the data has been written now. Close the data pipe. The consumer will
     // be notified that there will be no more data to read from now.
+    if (data_producer_) {
+      TRACE_EVENT_NESTABLE_ASYNC_END1("electron.asar", "AsarURLLoader::Write",
+                                      TRACE_ID_LOCAL(this), "result", result);
+    }
     data_producer_.reset();
 
     if (result == MOJO_RESULT_OK) {
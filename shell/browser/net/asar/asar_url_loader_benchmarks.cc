@@ -0,0 +1,81 @@
+// Copyright (c) 2020 GitHub, Inc.
+// Use of this source code is governed by the MIT license that can be
+// found in the LICENSE file.
+
+#include "shell/browser/net/asar/asar_url_loader.h"
+
+#include <string>
+#include <vector>
+
+#include "base/files/scoped_temp_dir.h"
+#include "base/strings/string_number_conversions.h"
+#include "base/test/task_environment.h"
+#include "base/timer/elapsed_timer.h"
+#include "mojo/public/cpp/bindings/pending_remote.h"
+#include "mojo/public/cpp/system/data_pipe_utils.h"
+#include "net/base/filename_util.h"
+#include "services/network/public/cpp/resource_request.h"
+#include "services/network/test/test_url_loader_client.h"
+#include "shell/common/asar/asar_util.h"
+#include "shell/common/asar/synthetic_archive.h"
+#include "testing/gtest/include/gtest/gtest.h"
+#include "testing/perf/perf_test.h"
+
+namespace asar {
+
+namespace {
+
+const size_t kMegabyte = 1024 * 1024;
+const size_t kFileSizes[] = {1 * kMegabyte, 16 * kMegabyte, 64 * kMegabyte};
+const int kIterations = 5;
+
+class AsarURLLoaderBenchmark : public testing::Test {
+ protected:
+  void SetUp() override { ASSERT_TRUE(temp_dir_.CreateUniqueTempDir()); }
+
+  void TearDown() override { ClearArchives(); }
+
+  // Loads |url| and returns the size of the response body.
+  size_t Load(const GURL& url) {
+    network::ResourceRequest request;
+    request.url = url;
+    mojo::PendingRemote<network::mojom::URLLoader> loader;
+    network::TestURLLoaderClient client;
+    CreateAsarURLLoader(request, loader.InitWithNewPipeAndPassReceiver(),
+                        client.CreateRemote(), nullptr);
+    client.RunUntilResponseBodyArrived();
+    std::string body;
+    EXPECT_TRUE(mojo::BlockingCopyToString(client.response_body_release(),
+                                           &body));
+    client.RunUntilComplete();
+    EXPECT_EQ(net::OK, client.completion_status().error_code);
+    return body.size();
+  }
+
+  base::test::TaskEnvironment task_environment_;
+  base::ScopedTempDir temp_dir_;
+};
+
+}  // namespace
+
+TEST_F(AsarURLLoaderBenchmark, Streaming) {
+  for (size_t size : kFileSizes) {
+    std::string name = base::NumberToString(size / kMegabyte) + "MB";
+    std::vector<SyntheticFile> files = {{"file.bin", std::string(size, 'x')}};
+    base::FilePath archive_path =
+        temp_dir_.GetPath().AppendASCII(name + ".asar");
+    ASSERT_TRUE(WriteSyntheticArchive(archive_path, files, true));
+    GURL url = net::FilePathToFileURL(archive_path.AppendASCII("file.bin"));
+
+    // The first load maps the archive and warms the page cache.
+    ASSERT_EQ(size, Load(url));
+    base::ElapsedTimer timer;
+    for (int i = 0; i < kIterations; ++i)
+      ASSERT_EQ(size, Load(url));
+    base::TimeDelta elapsed = timer.Elapsed() / kIterations;
+    perf_test::PrintResult("asar_url_loader_streaming", "", name,
+                           size / elapsed.InSecondsF() / 1e6, "MB/s", true);
+  }
+}
+
+}  // namespace asar
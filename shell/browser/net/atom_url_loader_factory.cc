@@ -9,12 +9,15 @@
 #include <utility>
 
 #include "base/guid.h"
+#include "base/numerics/ranges.h"
+#include "base/trace_event/trace_event.h"
 #include "content/public/browser/browser_thread.h"
 #include "content/public/browser/storage_partition.h"
 #include "mojo/public/cpp/bindings/binding.h"
 #include "mojo/public/cpp/system/data_pipe_producer.h"
 #include "mojo/public/cpp/system/string_data_source.h"
 #include "net/base/filename_util.h"
+#include "net/http/http_request_headers.h"
 #include "net/http/http_status_code.h"
 #include "services/network/public/cpp/url_loader_completion_status.h"
 #include "services/network/public/mojom/url_loader_factory.mojom.h"
@@ -65,6 +68,10 @@ namespace electron {
 
 namespace {
 
+// The range of the pipe capacities stream responses can ask for.
+constexpr uint32_t kMinPipeCapacity = 4 * 1024;
+constexpr uint32_t kMaxPipeCapacity = 64 * 1024 * 1024;
+
 // Determine whether a protocol type can accept non-object response.
 bool ResponseMustBeObject(ProtocolType type) {
   switch (type) {
@@ -161,9 +168,13 @@ void OnWrite(std::unique_ptr<WriteData> write_data, MojoResult result) {
 
 }  // namespace
 
-AtomURLLoaderFactory::AtomURLLoaderFactory(ProtocolType type,
-                                           const ProtocolHandler& handler)
-    : type_(type), handler_(handler) {}
+AtomURLLoaderFactory::AtomURLLoaderFactory(
+    ProtocolType type,
+    const ProtocolHandler& handler,
+    scoped_refptr<ProtocolResponseCache> response_cache)
+    : type_(type),
+      handler_(handler),
+      response_cache_(std::move(response_cache)) {}
 
 AtomURLLoaderFactory::~AtomURLLoaderFactory() = default;
 
@@ -176,11 +187,33 @@ void AtomURLLoaderFactory::CreateLoaderAndStart(
     mojo::PendingRemote<network::mojom::URLLoaderClient> client,
     const net::MutableNetworkTrafficAnnotationTag& traffic_annotation) {
   DCHECK_CURRENTLY_ON(content::BrowserThread::UI);
+  TRACE_EVENT1("electron.protocol",
+               "AtomURLLoaderFactory::CreateLoaderAndStart", "url",
+               request.url.spec());
+  scoped_refptr<ProtocolResponseCache> response_cache;
+  network::ResourceRequest handler_request = request;
+  if (response_cache_ && ProtocolResponseCache::IsCacheable(request)) {
+    response_cache = response_cache_;
+    // Repeated loads are served without calling into JavaScript until the
+    // stored response expires.
+    const ProtocolResponseCache::Entry* entry =
+        response_cache->Get(request.url);
+    if (entry && ProtocolResponseCache::IsFresh(*entry)) {
+      SendContents(std::move(client), entry->CreateHead(), entry->data);
+      return;
+    }
+    if (entry && !entry->etag.empty()) {
+      handler_request.headers.SetHeader(
+          net::HttpRequestHeaders::kIfNoneMatch, entry->etag);
+    }
+  }
+
   handler_.Run(
-      request,
+      handler_request,
       base::BindOnce(&AtomURLLoaderFactory::StartLoading, std::move(loader),
                      routing_id, request_id, options, request,
-                     std::move(client), traffic_annotation, nullptr, type_));
+                     std::move(client), traffic_annotation, nullptr, type_,
+                     std::move(response_cache)));
 }
 
 void AtomURLLoaderFactory::Clone(
@@ -199,7 +232,10 @@ void AtomURLLoaderFactory::StartLoading(
     const net::MutableNetworkTrafficAnnotationTag& traffic_annotation,
     network::mojom::URLLoaderFactory* proxy_factory,
     ProtocolType type,
+    scoped_refptr<ProtocolResponseCache> response_cache,
     gin::Arguments* args) {
+  TRACE_EVENT2("electron.protocol", "AtomURLLoaderFactory::StartLoading", "url",
+               request.url.spec(), "type", static_cast<int>(type));
   // Send network error when there is no argument passed.
   //
   // Note that we should not throw JS error in the callback no matter what is
@@ -227,6 +263,18 @@ void AtomURLLoaderFactory::StartLoading(
 
   network::mojom::URLResponseHeadPtr head = ToResponseHead(dict);
 
+  // The handler confirmed that the stored response is still valid.
+  if (response_cache &&
+      head->headers->response_code() == net::HTTP_NOT_MODIFIED) {
+    const ProtocolResponseCache::Entry* entry =
+        response_cache->Get(request.url);
+    if (entry) {
+      response_cache->Refresh(request.url, *head->headers);
+      SendContents(std::move(client), entry->CreateHead(), entry->data);
+      return;
+    }
+  }
+
   // Handle redirection.
   //
   // Note that with NetworkService, sending the "Location" header no longer
@@ -273,11 +321,13 @@ void AtomURLLoaderFactory::StartLoading(
 
   switch (type) {
     case ProtocolType::kBuffer:
-      StartLoadingBuffer(std::move(client), std::move(head), dict);
+      StartLoadingBuffer(std::move(client), std::move(head), dict,
+                         request.url, response_cache.get());
       break;
     case ProtocolType::kString:
       StartLoadingString(std::move(client), std::move(head), dict,
-                         args->isolate(), response);
+                         args->isolate(), response, request.url,
+                         response_cache.get());
       break;
     case ProtocolType::kFile:
       StartLoadingFile(std::move(loader), request, std::move(client),
@@ -302,7 +352,7 @@ void AtomURLLoaderFactory::StartLoading(
       }
       StartLoading(std::move(loader), routing_id, request_id, options, request,
                    std::move(client), traffic_annotation, proxy_factory, type,
-                   args);
+                   std::move(response_cache), args);
       break;
   }
 }
@@ -311,7 +361,9 @@ void AtomURLLoaderFactory::StartLoading(
 void AtomURLLoaderFactory::StartLoadingBuffer(
     mojo::PendingRemote<network::mojom::URLLoaderClient> client,
     network::mojom::URLResponseHeadPtr head,
-    const gin_helper::Dictionary& dict) {
+    const gin_helper::Dictionary& dict,
+    const GURL& url,
+    ProtocolResponseCache* response_cache) {
   v8::Local<v8::Value> buffer = dict.GetHandle();
   dict.Get("data", &buffer);
   if (!node::Buffer::HasInstance(buffer)) {
@@ -322,9 +374,10 @@ void AtomURLLoaderFactory::StartLoadingBuffer(
     return;
   }
 
-  SendContents(
+  SendCacheableContents(
       std::move(client), std::move(head),
-      std::string(node::Buffer::Data(buffer), node::Buffer::Length(buffer)));
+      std::string(node::Buffer::Data(buffer), node::Buffer::Length(buffer)),
+      url, response_cache);
 }
 
 // static
@@ -333,7 +386,9 @@ void AtomURLLoaderFactory::StartLoadingString(
     network::mojom::URLResponseHeadPtr head,
     const gin_helper::Dictionary& dict,
     v8::Isolate* isolate,
-    v8::Local<v8::Value> response) {
+    v8::Local<v8::Value> response,
+    const GURL& url,
+    ProtocolResponseCache* response_cache) {
   std::string contents;
   if (response->IsString()) {
     contents = gin::V8ToString(isolate, response);
@@ -347,7 +402,8 @@ void AtomURLLoaderFactory::StartLoadingString(
     return;
   }
 
-  SendContents(std::move(client), std::move(head), std::move(contents));
+  SendCacheableContents(std::move(client), std::move(head),
+                        std::move(contents), url, response_cache);
 }
 
 // static
@@ -390,6 +446,10 @@ void AtomURLLoaderFactory::StartLoadingHttp(
   auto request = std::make_unique<network::ResourceRequest>();
   request->headers = original_request.headers;
   request->cors_exempt_headers = original_request.cors_exempt_headers;
+  // Reloads bypass or validate the HTTP cache like they would for the
+  // original URL.
+  request->load_flags = original_request.load_flags;
+  request->priority = original_request.priority;
 
   dict.Get("url", &request->url);
   dict.Get("referrer", &request->referrer);
@@ -405,6 +465,7 @@ void AtomURLLoaderFactory::StartLoadingHttp(
   v8::Local<v8::Value> value;
   if (dict.Get("session", &value)) {
     if (value->IsNull()) {
+      // The request keeps its in-memory session alive until it is done.
       browser_context = AtomBrowserContext::From(base::GenerateGUID(), true);
     } else {
       gin::Handle<api::Session> session;
@@ -416,7 +477,7 @@ void AtomURLLoaderFactory::StartLoadingHttp(
   }
 
   new URLPipeLoader(
-      browser_context->GetURLLoaderFactory(), std::move(request),
+      std::move(browser_context), std::move(request),
       std::move(loader), std::move(client),
       static_cast<net::NetworkTrafficAnnotationTag>(traffic_annotation),
       std::move(upload_data));
@@ -471,8 +532,26 @@ void AtomURLLoaderFactory::StartLoadingStream(
     return;
   }
 
+  // Larger pipes let the stream be read in fewer, bigger steps.
+  uint32_t pipe_capacity = NodeStreamLoader::kDefaultPipeCapacity;
+  if (dict.Get("pipeCapacity", &pipe_capacity))
+    pipe_capacity =
+        base::ClampToRange(pipe_capacity, kMinPipeCapacity, kMaxPipeCapacity);
+
   new NodeStreamLoader(std::move(head), std::move(loader), std::move(client),
-                       data.isolate(), data.GetHandle());
+                       data.isolate(), data.GetHandle(), pipe_capacity);
+}
+
+// static
+void AtomURLLoaderFactory::SendCacheableContents(
+    mojo::PendingRemote<network::mojom::URLLoaderClient> client,
+    network::mojom::URLResponseHeadPtr head,
+    std::string data,
+    const GURL& url,
+    ProtocolResponseCache* response_cache) {
+  if (response_cache)
+    response_cache->Put(url, *head, data);
+  SendContents(std::move(client), std::move(head), std::move(data));
 }
 
 // static
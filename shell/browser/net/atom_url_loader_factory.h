@@ -16,6 +16,7 @@
 #include "net/url_request/url_request_job_factory.h"
 #include "services/network/public/mojom/url_loader_factory.mojom.h"
 #include "services/network/public/mojom/url_response_head.mojom.h"
+#include "shell/browser/net/protocol_response_cache.h"
 #include "shell/common/gin_helper/dictionary.h"
 
 namespace electron {
@@ -41,7 +42,11 @@ using HandlersMap =
 // Implementation of URLLoaderFactory.
 class AtomURLLoaderFactory : public network::mojom::URLLoaderFactory {
  public:
-  AtomURLLoaderFactory(ProtocolType type, const ProtocolHandler& handler);
+  // The buffer and string responses are stored in |response_cache| when it is
+  // not null.
+  AtomURLLoaderFactory(ProtocolType type,
+                       const ProtocolHandler& handler,
+                       scoped_refptr<ProtocolResponseCache> response_cache);
   ~AtomURLLoaderFactory() override;
 
   // network::mojom::URLLoaderFactory:
@@ -67,19 +72,37 @@ class AtomURLLoaderFactory : public network::mojom::URLLoaderFactory {
       const net::MutableNetworkTrafficAnnotationTag& traffic_annotation,
       network::mojom::URLLoaderFactory* proxy_factory,
       ProtocolType type,
+      scoped_refptr<ProtocolResponseCache> response_cache,
       gin::Arguments* args);
 
+  // Helper to send string as response.
+  static void SendContents(
+      mojo::PendingRemote<network::mojom::URLLoaderClient> client,
+      network::mojom::URLResponseHeadPtr head,
+      std::string data);
+
  private:
   static void StartLoadingBuffer(
       mojo::PendingRemote<network::mojom::URLLoaderClient> client,
       network::mojom::URLResponseHeadPtr head,
-      const gin_helper::Dictionary& dict);
+      const gin_helper::Dictionary& dict,
+      const GURL& url,
+      ProtocolResponseCache* response_cache);
   static void StartLoadingString(
       mojo::PendingRemote<network::mojom::URLLoaderClient> client,
       network::mojom::URLResponseHeadPtr head,
       const gin_helper::Dictionary& dict,
       v8::Isolate* isolate,
-      v8::Local<v8::Value> response);
+      v8::Local<v8::Value> response,
+      const GURL& url,
+      ProtocolResponseCache* response_cache);
+  // Sends the response, storing it in |response_cache| when it is not null.
+  static void SendCacheableContents(
+      mojo::PendingRemote<network::mojom::URLLoaderClient> client,
+      network::mojom::URLResponseHeadPtr head,
+      std::string data,
+      const GURL& url,
+      ProtocolResponseCache* response_cache);
   static void StartLoadingFile(
       mojo::PendingReceiver<network::mojom::URLLoader> loader,
       network::ResourceRequest request,
@@ -100,12 +123,6 @@ class AtomURLLoaderFactory : public network::mojom::URLLoaderFactory {
       network::mojom::URLResponseHeadPtr head,
       const gin_helper::Dictionary& dict);
 
-  // Helper to send string as response.
-  static void SendContents(
-      mojo::PendingRemote<network::mojom::URLLoaderClient> client,
-      network::mojom::URLResponseHeadPtr head,
-      std::string data);
-
   // TODO(zcbenz): This comes from extensions/browser/extension_protocols.cc
   // but I don't know what it actually does, find out the meanings of |Clone|
   // and |bindings_| and add comments for them.
@@ -113,6 +130,7 @@ class AtomURLLoaderFactory : public network::mojom::URLLoaderFactory {
 
   ProtocolType type_;
   ProtocolHandler handler_;
+  scoped_refptr<ProtocolResponseCache> response_cache_;
 
   DISALLOW_COPY_AND_ASSIGN(AtomURLLoaderFactory);
 };
@@ -6,8 +6,20 @@
 
 #include "shell/browser/net/cert_verifier_client.h"
 
+#include "gin/arguments.h"
+#include "shell/common/gin_helper/dictionary.h"
+
 namespace electron {
 
+namespace {
+
+// How long a cached verdict is reused when the proc does not say.
+const int kDefaultVerdictTTLMs = 5 * 60 * 1000;
+
+const size_t kMaxCachedVerdicts = 1024;
+
+}  // namespace
+
 VerifyRequestParams::VerifyRequestParams() = default;
 
 VerifyRequestParams::~VerifyRequestParams() = default;
@@ -27,17 +39,52 @@ void CertVerifierClient::Verify(
     int flags,
     const base::Optional<std::string>& ocsp_response,
     VerifyCallback callback) {
+  VerdictKey key(hostname, certificate->CalculateChainFingerprint256(),
+                 default_error);
+  auto cached = verdicts_.find(key);
+  if (cached != verdicts_.end()) {
+    if (base::TimeTicks::Now() < cached->second.expiry) {
+      std::move(callback).Run(cached->second.error_code, default_result);
+      return;
+    }
+    verdicts_.erase(cached);
+  }
+
   VerifyRequestParams params;
   params.hostname = hostname;
   params.default_result = net::ErrorToString(default_error);
   params.error_code = default_error;
   params.certificate = certificate;
   cert_verify_proc_.Run(
-      params,
-      base::AdaptCallbackForRepeating(base::BindOnce(
-          [](VerifyCallback callback, const net::CertVerifyResult& result,
-             int err) { std::move(callback).Run(err, result); },
-          std::move(callback), default_result)));
+      params, base::AdaptCallbackForRepeating(base::BindOnce(
+                  &CertVerifierClient::OnVerifyProcResult,
+                  weak_factory_.GetWeakPtr(), std::move(key),
+                  std::move(callback), default_result)));
+}
+
+void CertVerifierClient::OnVerifyProcResult(
+    const VerdictKey& key,
+    VerifyCallback callback,
+    const net::CertVerifyResult& default_result,
+    gin::Arguments* args) {
+  int error_code;
+  if (!args->GetNext(&error_code)) {
+    args->ThrowTypeError("Expected a verification result");
+    return;
+  }
+
+  gin_helper::Dictionary options;
+  bool cache = false;
+  if (args->GetNext(&options) && options.Get("cache", &cache) && cache) {
+    int ttl = kDefaultVerdictTTLMs;
+    options.Get("cacheTTL", &ttl);
+    if (verdicts_.size() >= kMaxCachedVerdicts)
+      verdicts_.clear();
+    verdicts_[key] = {error_code, base::TimeTicks::Now() +
+                                      base::TimeDelta::FromMilliseconds(ttl)};
+  }
+
+  std::move(callback).Run(error_code, default_result);
 }
 
 }  // namespace electron
@@ -5,11 +5,20 @@
 #ifndef SHELL_BROWSER_NET_CERT_VERIFIER_CLIENT_H_
 #define SHELL_BROWSER_NET_CERT_VERIFIER_CLIENT_H_
 
+#include <map>
 #include <string>
+#include <tuple>
 
+#include "base/memory/weak_ptr.h"
+#include "base/time/time.h"
+#include "net/base/hash_value.h"
 #include "net/cert/x509_certificate.h"
 #include "services/network/public/mojom/network_context.mojom.h"
 
+namespace gin {
+class Arguments;
+}
+
 namespace electron {
 
 struct VerifyRequestParams {
@@ -25,9 +34,11 @@ struct VerifyRequestParams {
 
 class CertVerifierClient : public network::mojom::CertVerifierClient {
  public:
-  using CertVerifyProc =
-      base::RepeatingCallback<void(const VerifyRequestParams& request,
-                                   base::RepeatingCallback<void(int)>)>;
+  // The callback of the proc takes the verdict, and optionally whether to
+  // cache it.
+  using CertVerifyProc = base::RepeatingCallback<void(
+      const VerifyRequestParams& request,
+      base::RepeatingCallback<void(gin::Arguments*)>)>;
 
   explicit CertVerifierClient(CertVerifyProc proc);
   ~CertVerifierClient() override;
@@ -42,7 +53,26 @@ class CertVerifierClient : public network::mojom::CertVerifierClient {
               VerifyCallback callback) override;
 
  private:
+  // (hostname, fingerprint of the certificate chain, default error).
+  using VerdictKey = std::tuple<std::string, net::SHA256HashValue, int>;
+
+  struct Verdict {
+    int error_code;
+    base::TimeTicks expiry;
+  };
+
+  void OnVerifyProcResult(const VerdictKey& key,
+                          VerifyCallback callback,
+                          const net::CertVerifyResult& default_result,
+                          gin::Arguments* args);
+
   CertVerifyProc cert_verify_proc_;
+
+  // The verdicts the proc asked to be reused, so that reconnecting to a host
+  // does not wait for JavaScript.
+  std::map<VerdictKey, Verdict> verdicts_;
+
+  base::WeakPtrFactory<CertVerifierClient> weak_factory_{this};
 };
 
 }  // namespace electron
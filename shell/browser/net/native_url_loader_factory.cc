@@ -0,0 +1,146 @@
+// Copyright (c) 2020 GitHub, Inc.
+// Use of this source code is governed by the MIT license that can be
+// found in the LICENSE file.
+
+#include "shell/browser/net/native_url_loader_factory.h"
+
+#include <utility>
+
+#include "base/strings/string_util.h"
+#include "content/public/browser/browser_thread.h"
+#include "mojo/public/cpp/bindings/remote.h"
+#include "net/base/escape.h"
+#include "net/base/filename_util.h"
+#include "net/base/mime_util.h"
+#include "net/http/http_response_headers.h"
+#include "services/network/public/cpp/url_loader_completion_status.h"
+#include "services/network/public/mojom/url_response_head.mojom.h"
+#include "shell/browser/net/asar/asar_url_loader.h"
+#include "shell/browser/net/atom_url_loader_factory.h"
+#include "shell/common/atom_constants.h"
+#include "url/gurl.h"
+
+namespace electron {
+
+namespace {
+
+// The file served for the paths which name a directory.
+const char kIndexFile[] = "index.html";
+
+void CompleteWithError(
+    mojo::PendingRemote<network::mojom::URLLoaderClient> client,
+    int error_code) {
+  mojo::Remote<network::mojom::URLLoaderClient> client_remote(
+      std::move(client));
+  client_remote->OnComplete(network::URLLoaderCompletionStatus(error_code));
+}
+
+// Returns the path of |url|, which for the schemes not registered as standard
+// still holds the "//host" part.
+std::string GetRoutePath(const GURL& url) {
+  std::string path = url.path();
+  if (url.IsStandard() ||
+      !base::StartsWith(path, "//", base::CompareCase::SENSITIVE))
+    return path;
+  size_t slash = path.find('/', 2);
+  return slash == std::string::npos ? "/" : path.substr(slash);
+}
+
+// Returns whether |path| is |prefix| or below it, so that "/app" matches
+// "/app/index.html" but not "/apple".
+bool IsUnderPrefix(const std::string& path, const std::string& prefix) {
+  if (!base::StartsWith(path, prefix, base::CompareCase::SENSITIVE))
+    return false;
+  return path.size() == prefix.size() || prefix.back() == '/' ||
+         path[prefix.size()] == '/';
+}
+
+}  // namespace
+
+NativeProtocolRoute::NativeProtocolRoute() = default;
+NativeProtocolRoute::NativeProtocolRoute(const NativeProtocolRoute&) = default;
+NativeProtocolRoute::~NativeProtocolRoute() = default;
+
+NativeURLLoaderFactory::NativeURLLoaderFactory(
+    const NativeProtocolRoutes& routes)
+    : routes_(routes) {}
+
+NativeURLLoaderFactory::~NativeURLLoaderFactory() = default;
+
+void NativeURLLoaderFactory::CreateLoaderAndStart(
+    mojo::PendingReceiver<network::mojom::URLLoader> loader,
+    int32_t routing_id,
+    int32_t request_id,
+    uint32_t options,
+    const network::ResourceRequest& request,
+    mojo::PendingRemote<network::mojom::URLLoaderClient> client,
+    const net::MutableNetworkTrafficAnnotationTag& traffic_annotation) {
+  DCHECK_CURRENTLY_ON(content::BrowserThread::UI);
+  const std::string path = GetRoutePath(request.url);
+  const NativeProtocolRoute* route = FindRoute(path);
+  if (!route) {
+    CompleteWithError(std::move(client), net::ERR_FILE_NOT_FOUND);
+    return;
+  }
+
+  if (route->data) {
+    auto head = network::mojom::URLResponseHead::New();
+    head->headers = new net::HttpResponseHeaders("HTTP/1.1 200 OK");
+    head->charset = "utf-8";
+    head->mime_type = route->mime_type;
+    if (head->mime_type.empty()) {
+      base::FilePath::StringType extension =
+          base::FilePath::FromUTF8Unsafe(path).Extension();
+      if (extension.empty() ||
+          !net::GetWellKnownMimeTypeFromExtension(extension.substr(1),
+                                                  &head->mime_type))
+        head->mime_type = "text/html";
+    }
+    head->headers->AddHeader("content-type: " + head->mime_type);
+    AtomURLLoaderFactory::SendContents(std::move(client), std::move(head),
+                                       route->data->data());
+    return;
+  }
+
+  std::string relative_path = net::UnescapeBinaryURLComponent(
+      base::StringPiece(path).substr(route->prefix.size()));
+  base::TrimString(relative_path, "/", &relative_path);
+  base::FilePath file_path = base::FilePath::FromUTF8Unsafe(relative_path);
+  // The requests can not reach the files outside of the directory.
+  if (file_path.ReferencesParent() || file_path.IsAbsolute()) {
+    CompleteWithError(std::move(client), net::ERR_ACCESS_DENIED);
+    return;
+  }
+  if (relative_path.empty() || base::EndsWith(path, "/"))
+    file_path = file_path.AppendASCII(kIndexFile);
+
+  network::ResourceRequest file_request = request;
+  file_request.url =
+      net::FilePathToFileURL(route->directory.Append(file_path));
+  auto headers = base::MakeRefCounted<net::HttpResponseHeaders>("");
+  headers->AddHeader(kCORSHeader);
+  asar::CreateAsarURLLoader(file_request, std::move(loader), std::move(client),
+                            std::move(headers));
+}
+
+void NativeURLLoaderFactory::Clone(
+    mojo::PendingReceiver<network::mojom::URLLoaderFactory> receiver) {
+  receivers_.Add(this, std::move(receiver));
+}
+
+const NativeProtocolRoute* NativeURLLoaderFactory::FindRoute(
+    const std::string& path) const {
+  const NativeProtocolRoute* match = nullptr;
+  for (const auto& route : routes_) {
+    if (route.data) {
+      if (route.path == path)
+        return &route;
+    } else if (IsUnderPrefix(path, route.prefix) &&
+               (!match || route.prefix.size() > match->prefix.size())) {
+      match = &route;
+    }
+  }
+  return match;
+}
+
+}  // namespace electron
@@ -0,0 +1,74 @@
+// Copyright (c) 2020 GitHub, Inc.
+// Use of this source code is governed by the MIT license that can be
+// found in the LICENSE file.
+
+#ifndef SHELL_BROWSER_NET_NATIVE_URL_LOADER_FACTORY_H_
+#define SHELL_BROWSER_NET_NATIVE_URL_LOADER_FACTORY_H_
+
+#include <string>
+#include <vector>
+
+#include "base/files/file_path.h"
+#include "base/macros.h"
+#include "base/memory/ref_counted_memory.h"
+#include "mojo/public/cpp/bindings/pending_receiver.h"
+#include "mojo/public/cpp/bindings/pending_remote.h"
+#include "mojo/public/cpp/bindings/receiver_set.h"
+#include "services/network/public/mojom/url_loader_factory.mojom.h"
+
+namespace electron {
+
+// A route of a native protocol, which serves either the files under a
+// directory, or a single response from memory.
+struct NativeProtocolRoute {
+  NativeProtocolRoute();
+  NativeProtocolRoute(const NativeProtocolRoute&);
+  ~NativeProtocolRoute();
+
+  // The files of |directory|, which may be inside an asar archive, are served
+  // for the paths starting with |prefix|.
+  std::string prefix;
+  base::FilePath directory;
+
+  // |data| is served for |path| when set.
+  std::string path;
+  scoped_refptr<base::RefCountedString> data;
+  std::string mime_type;
+};
+
+using NativeProtocolRoutes = std::vector<NativeProtocolRoute>;
+
+// Serves the requests of a scheme from a table of routes, without calling
+// into JavaScript. Files are read on the thread pool by the asar loader.
+class NativeURLLoaderFactory : public network::mojom::URLLoaderFactory {
+ public:
+  explicit NativeURLLoaderFactory(const NativeProtocolRoutes& routes);
+  ~NativeURLLoaderFactory() override;
+
+  // network::mojom::URLLoaderFactory:
+  void CreateLoaderAndStart(
+      mojo::PendingReceiver<network::mojom::URLLoader> loader,
+      int32_t routing_id,
+      int32_t request_id,
+      uint32_t options,
+      const network::ResourceRequest& request,
+      mojo::PendingRemote<network::mojom::URLLoaderClient> client,
+      const net::MutableNetworkTrafficAnnotationTag& traffic_annotation)
+      override;
+  void Clone(mojo::PendingReceiver<network::mojom::URLLoaderFactory> receiver)
+      override;
+
+ private:
+  // Returns the route with the longest match for |path|, or nullptr.
+  const NativeProtocolRoute* FindRoute(const std::string& path) const;
+
+  mojo::ReceiverSet<network::mojom::URLLoaderFactory> receivers_;
+
+  NativeProtocolRoutes routes_;
+
+  DISALLOW_COPY_AND_ASSIGN(NativeURLLoaderFactory);
+};
+
+}  // namespace electron
+
+#endif  // SHELL_BROWSER_NET_NATIVE_URL_LOADER_FACTORY_H_
@@ -44,20 +44,27 @@ NetworkContextService::CreateNetworkContextParams(bool in_memory,
       net::HttpUtil::GenerateAcceptLanguageHeader(
           AtomBrowserClient::Get()->GetApplicationLocale());
 
-  // Enable the HTTP cache.
+  // Enable the HTTP cache, whose size limit applies to the memory cache as
+  // well as the disk one.
   network_context_params->http_cache_enabled =
       browser_context_->CanUseHttpCache();
+  network_context_params->http_cache_max_size =
+      browser_context_->GetMaxCacheSize();
 
   network_context_params->cookie_manager_params =
       network::mojom::CookieManagerParams::New();
 
+  // Restores the CORS access lists after a restart of the network service.
+  network_context_params->cors_origin_access_list =
+      browser_context_->CloneCorsOriginAccessLists();
+
   // Configure on-disk storage for persistent sessions.
   if (!in_memory) {
-    // Configure the HTTP cache path and size.
-    network_context_params->http_cache_path =
-        path.Append(chrome::kCacheDirname);
-    network_context_params->http_cache_max_size =
-        browser_context_->GetMaxCacheSize();
+    // Configure the HTTP cache path, without which the cache is in memory.
+    if (browser_context_->UseDiskCache()) {
+      network_context_params->http_cache_path =
+          path.Append(chrome::kCacheDirname);
+    }
 
     // Currently this just contains HttpServerProperties
     network_context_params->http_server_properties_path =
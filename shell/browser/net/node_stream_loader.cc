@@ -6,28 +6,43 @@
 
 #include <utility>
 
-#include "mojo/public/cpp/system/string_data_source.h"
+#include "base/threading/sequenced_task_runner_handle.h"
 #include "shell/common/gin_converters/callback_converter.h"
 #include "shell/common/node_includes.h"
 
 namespace electron {
 
+namespace {
+
+// The most data written to the pipe in one task, so that a fast consumer does
+// not keep the UI thread busy for the whole stream.
+constexpr size_t kMaxBytesPerTask = 1024 * 1024;
+
+}  // namespace
+
+// static
+constexpr uint32_t NodeStreamLoader::kDefaultPipeCapacity;
+
 NodeStreamLoader::NodeStreamLoader(
     network::mojom::URLResponseHeadPtr head,
     network::mojom::URLLoaderRequest loader,
     mojo::PendingRemote<network::mojom::URLLoaderClient> client,
     v8::Isolate* isolate,
-    v8::Local<v8::Object> emitter)
+    v8::Local<v8::Object> emitter,
+    uint32_t pipe_capacity)
     : binding_(this, std::move(loader)),
       client_(std::move(client)),
       isolate_(isolate),
       emitter_(isolate, emitter),
+      handle_watcher_(FROM_HERE,
+                      mojo::SimpleWatcher::ArmingPolicy::MANUAL,
+                      base::SequencedTaskRunnerHandle::Get()),
       weak_factory_(this) {
   binding_.set_connection_error_handler(
       base::BindOnce(&NodeStreamLoader::NotifyComplete,
                      weak_factory_.GetWeakPtr(), net::ERR_FAILED));
 
-  Start(std::move(head));
+  Start(std::move(head), pipe_capacity);
 }
 
 NodeStreamLoader::~NodeStreamLoader() {
@@ -44,18 +59,25 @@ NodeStreamLoader::~NodeStreamLoader() {
   }
 }
 
-void NodeStreamLoader::Start(network::mojom::URLResponseHeadPtr head) {
-  mojo::ScopedDataPipeProducerHandle producer;
+void NodeStreamLoader::Start(network::mojom::URLResponseHeadPtr head,
+                             uint32_t pipe_capacity) {
+  MojoCreateDataPipeOptions options;
+  options.struct_size = sizeof(MojoCreateDataPipeOptions);
+  options.flags = MOJO_CREATE_DATA_PIPE_FLAG_NONE;
+  options.element_num_bytes = 1;
+  options.capacity_num_bytes = pipe_capacity;
   mojo::ScopedDataPipeConsumerHandle consumer;
-  MojoResult rv = mojo::CreateDataPipe(nullptr, &producer, &consumer);
+  MojoResult rv = mojo::CreateDataPipe(&options, &producer_, &consumer);
   if (rv != MOJO_RESULT_OK) {
     NotifyComplete(net::ERR_INSUFFICIENT_RESOURCES);
     return;
   }
 
-  producer_ = std::make_unique<mojo::DataPipeProducer>(std::move(producer));
   client_->OnReceiveResponse(std::move(head));
   client_->OnStartLoadingResponseBody(std::move(consumer));
+  handle_watcher_.Watch(producer_.get(), MOJO_HANDLE_SIGNAL_WRITABLE,
+                        base::BindRepeating(&NodeStreamLoader::OnHandleWritable,
+                                            weak_factory_.GetWeakPtr()));
 
   auto weak = weak_factory_.GetWeakPtr();
   On("end",
@@ -66,14 +88,14 @@ void NodeStreamLoader::Start(network::mojom::URLResponseHeadPtr head) {
 }
 
 void NodeStreamLoader::NotifyReadable() {
-  if (!readable_)
-    ReadMore();
   readable_ = true;
+  WriteMore();
 }
 
 void NodeStreamLoader::NotifyComplete(int result) {
-  // Wait until write finishes or fails.
-  if (is_reading_ || is_writing_) {
+  // Wait until the write finishes, and until the chunk being written has been
+  // written unless the stream failed.
+  if (is_writing_ || (result == net::OK && !buffer_.IsEmpty())) {
     ended_ = true;
     result_ = result;
     return;
@@ -83,57 +105,97 @@ void NodeStreamLoader::NotifyComplete(int result) {
   delete this;
 }
 
-void NodeStreamLoader::ReadMore() {
-  if (is_reading_) {
+void NodeStreamLoader::WriteMore() {
+  if (is_writing_) {
     // Calling read() can trigger the "readable" event again, making this
-    // function re-entrant. If we're already reading, we don't want to start
-    // a nested read, so short-circuit.
+    // function re-entrant. If we're already writing, we don't want to start
+    // a nested write, so short-circuit.
     return;
   }
-  is_reading_ = true;
-  auto weak = weak_factory_.GetWeakPtr();
+  is_writing_ = true;
+
+  v8::Locker locker(isolate_);
+  v8::Isolate::Scope isolate_scope(isolate_);
+  v8::HandleScope handle_scope(isolate_);
+
+  int result = net::OK;
+  size_t bytes_written = 0;
+  // The chunk being written is still written after the stream has ended, but
+  // not after it failed.
+  while (!paused_ && result_ == net::OK) {
+    if (buffer_.IsEmpty() && !(readable_ && ReadChunk()))
+      break;
+
+    v8::Local<v8::Value> buffer = buffer_.Get(isolate_);
+    size_t length = node::Buffer::Length(buffer);
+    uint32_t size = static_cast<uint32_t>(length - buffer_offset_);
+    MojoResult rv =
+        producer_->WriteData(node::Buffer::Data(buffer) + buffer_offset_,
+                             &size, MOJO_WRITE_DATA_FLAG_NONE);
+    if (rv == MOJO_RESULT_SHOULD_WAIT) {
+      handle_watcher_.ArmOrNotify();
+      break;
+    }
+    if (rv != MOJO_RESULT_OK) {
+      result = net::ERR_FAILED;
+      break;
+    }
+
+    buffer_offset_ += size;
+    if (buffer_offset_ == length) {
+      buffer_.Reset();
+      buffer_offset_ = 0;
+    }
+    bytes_written += size;
+    if (bytes_written >= kMaxBytesPerTask) {
+      base::SequencedTaskRunnerHandle::Get()->PostTask(
+          FROM_HERE, base::BindOnce(&NodeStreamLoader::WriteMore,
+                                    weak_factory_.GetWeakPtr()));
+      break;
+    }
+  }
+
+  is_writing_ = false;
+  if (result != net::OK)
+    NotifyComplete(result);
+  else if (ended_)
+    NotifyComplete(result_);
+}
+
+bool NodeStreamLoader::ReadChunk() {
   // buffer = emitter.read()
   v8::MaybeLocal<v8::Value> ret = node::MakeCallback(
       isolate_, emitter_.Get(isolate_), "read", 0, nullptr, {0, 0});
-  DCHECK(weak) << "We shouldn't have been destroyed when calling read()";
 
   // If there is no buffer read, wait until |readable| is emitted again.
   v8::Local<v8::Value> buffer;
   if (!ret.ToLocal(&buffer) || !node::Buffer::HasInstance(buffer)) {
     readable_ = false;
-    is_reading_ = false;
-    if (ended_) {
-      NotifyComplete(result_);
-    }
-    return;
+    return false;
   }
 
-  // Hold the buffer until the write is done.
+  // Hold the buffer until it has been written.
   buffer_.Reset(isolate_, buffer);
-
-  // Write buffer to mojo pipe asyncronously.
-  is_reading_ = false;
-  is_writing_ = true;
-  producer_->Write(std::make_unique<mojo::StringDataSource>(
-                       base::StringPiece(node::Buffer::Data(buffer),
-                                         node::Buffer::Length(buffer)),
-                       mojo::StringDataSource::AsyncWritingMode::
-                           STRING_STAYS_VALID_UNTIL_COMPLETION),
-                   base::BindOnce(&NodeStreamLoader::DidWrite, weak));
+  buffer_offset_ = 0;
+  return true;
 }
 
-void NodeStreamLoader::DidWrite(MojoResult result) {
-  is_writing_ = false;
-  // We were told to end streaming.
-  if (ended_) {
-    NotifyComplete(result_);
+void NodeStreamLoader::OnHandleWritable(MojoResult result) {
+  // The consumer has closed the pipe.
+  if (result != MOJO_RESULT_OK) {
+    NotifyComplete(net::ERR_FAILED);
     return;
   }
+  WriteMore();
+}
 
-  if (result == MOJO_RESULT_OK && readable_)
-    ReadMore();
-  else
-    NotifyComplete(net::ERR_FAILED);
+void NodeStreamLoader::PauseReadingBodyFromNet() {
+  paused_ = true;
+}
+
+void NodeStreamLoader::ResumeReadingBodyFromNet() {
+  paused_ = false;
+  WriteMore();
 }
 
 void NodeStreamLoader::On(const char* event, EventCallback callback) {
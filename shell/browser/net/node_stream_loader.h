@@ -13,7 +13,8 @@
 #include "mojo/public/cpp/bindings/pending_remote.h"
 #include "mojo/public/cpp/bindings/remote.h"
 #include "mojo/public/cpp/bindings/strong_binding.h"
-#include "mojo/public/cpp/system/data_pipe_producer.h"
+#include "mojo/public/cpp/system/data_pipe.h"
+#include "mojo/public/cpp/system/simple_watcher.h"
 #include "services/network/public/mojom/url_loader.mojom.h"
 #include "services/network/public/mojom/url_response_head.mojom.h"
 #include "v8/include/v8.h"
@@ -25,27 +26,39 @@ namespace electron {
 // This class manages its own lifetime and should delete itself when the
 // connection is lost or finished.
 //
-// We use |paused mode| to read data from |Readable| stream, so we don't need to
-// copy data from buffer and hold it in memory, and we only need to make sure
-// the passed |Buffer| is alive while writing data to pipe.
+// We use |paused mode| to read data from |Readable| stream, and write the
+// chunks straight from their |Buffer| into the pipe, so the data is only
+// copied once. The stream is only read while the pipe has room and the
+// loader is not paused, which lets the stream apply its own backpressure to
+// the source.
 class NodeStreamLoader : public network::mojom::URLLoader {
  public:
+  // The pipe capacity used when the response asks for none.
+  static constexpr uint32_t kDefaultPipeCapacity = 512 * 1024;
+
   NodeStreamLoader(network::mojom::URLResponseHeadPtr head,
                    network::mojom::URLLoaderRequest loader,
                    mojo::PendingRemote<network::mojom::URLLoaderClient> client,
                    v8::Isolate* isolate,
-                   v8::Local<v8::Object> emitter);
+                   v8::Local<v8::Object> emitter,
+                   uint32_t pipe_capacity = kDefaultPipeCapacity);
 
  private:
   ~NodeStreamLoader() override;
 
   using EventCallback = base::RepeatingCallback<void()>;
 
-  void Start(network::mojom::URLResponseHeadPtr head);
+  void Start(network::mojom::URLResponseHeadPtr head, uint32_t pipe_capacity);
   void NotifyReadable();
   void NotifyComplete(int result);
-  void ReadMore();
-  void DidWrite(MojoResult result);
+
+  // Writes the chunks of the stream to the pipe until it is full, the stream
+  // has nothing to read, or a task's worth of data has been written.
+  void WriteMore();
+  // Reads the next chunk of the stream into |buffer_|, returning false when
+  // there is none.
+  bool ReadChunk();
+  void OnHandleWritable(MojoResult result);
 
   // Subscribe to events of |emitter|.
   void On(const char* event, EventCallback callback);
@@ -56,33 +69,37 @@ class NodeStreamLoader : public network::mojom::URLLoader {
                       const base::Optional<GURL>& new_url) override {}
   void SetPriority(net::RequestPriority priority,
                    int32_t intra_priority_value) override {}
-  void PauseReadingBodyFromNet() override {}
-  void ResumeReadingBodyFromNet() override {}
+  void PauseReadingBodyFromNet() override;
+  void ResumeReadingBodyFromNet() override;
 
   mojo::Binding<network::mojom::URLLoader> binding_;
   mojo::Remote<network::mojom::URLLoaderClient> client_;
 
   v8::Isolate* isolate_;
   v8::Global<v8::Object> emitter_;
+
+  // The chunk being written, and how much of it has been written.
   v8::Global<v8::Value> buffer_;
+  size_t buffer_offset_ = 0;
 
   // Mojo data pipe where the data that is being read is written to.
-  std::unique_ptr<mojo::DataPipeProducer> producer_;
+  mojo::ScopedDataPipeProducerHandle producer_;
+  mojo::SimpleWatcher handle_watcher_;
 
-  // Whether we are in the middle of write.
+  // Whether we are in the middle of WriteMore(), which reading the stream can
+  // re-enter by emitting events.
   bool is_writing_ = false;
 
-  // Whether we are in the middle of a stream.read().
-  bool is_reading_ = false;
+  // Whether the consumer asked to stop reading the body.
+  bool paused_ = false;
 
   // When NotifyComplete is called while writing, we will save the result and
   // quit with it after the write is done.
   bool ended_ = false;
   int result_ = net::OK;
 
-  // When the stream emits the readable event, we only want to start reading
-  // data if the stream was not readable before, so we store the state in a
-  // flag.
+  // Whether the stream may have data to read, which is the case until read()
+  // returns nothing, and again once it emits the readable event.
   bool readable_ = false;
 
   // Store the V8 callbacks to unsubscribe them later.
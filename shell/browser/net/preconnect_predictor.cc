@@ -0,0 +1,241 @@
+// Copyright (c) 2020 GitHub, Inc.
+// Use of this source code is governed by the MIT license that can be
+// found in the LICENSE file.
+
+#include "shell/browser/net/preconnect_predictor.h"
+
+#include <algorithm>
+#include <set>
+#include <utility>
+#include <vector>
+
+#include "base/bind.h"
+#include "base/json/json_file_value_serializer.h"
+#include "base/json/json_writer.h"
+#include "base/optional.h"
+#include "base/task/post_task.h"
+#include "base/time/time.h"
+#include "base/values.h"
+#include "chrome/browser/predictors/preconnect_manager.h"
+#include "content/public/browser/browser_thread.h"
+#include "net/base/network_isolation_key.h"
+#include "shell/browser/atom_browser_context.h"
+
+namespace electron {
+
+namespace {
+
+const base::FilePath::CharType kModelFileName[] =
+    FILE_PATH_LITERAL("Preconnect Predictor");
+
+// Bounds the size of the model, and so of the file it is written to.
+const size_t kMaxHosts = 100;
+const size_t kMaxOriginsPerHost = 8;
+
+// The counts of a host are halved past this many pages, so that the origins
+// it stopped using fade out of the model.
+const int kMaxNavigations = 32;
+
+// The model is written at most this often.
+constexpr base::TimeDelta kWriteInterval = base::TimeDelta::FromSeconds(10);
+
+const char kNavigationsKey[] = "navigations";
+const char kOriginsKey[] = "origins";
+
+std::unique_ptr<base::Value> ReadModel(const base::FilePath& path) {
+  JSONFileValueDeserializer deserializer(path);
+  return deserializer.Deserialize(nullptr, nullptr);
+}
+
+// An origin is preconnected to when at least half of the pages of the host
+// loaded from it.
+bool IsConfident(int origin_count, int navigations) {
+  return origin_count * 2 >= navigations;
+}
+
+}  // namespace
+
+PreconnectPredictor::HostStats::HostStats() = default;
+PreconnectPredictor::HostStats::HostStats(const HostStats&) = default;
+PreconnectPredictor::HostStats::~HostStats() = default;
+
+PreconnectPredictor::PreconnectPredictor(AtomBrowserContext* browser_context)
+    : browser_context_(browser_context) {
+  DCHECK_CURRENTLY_ON(content::BrowserThread::UI);
+  if (browser_context_->IsOffTheRecord())
+    return;
+  base::FilePath path = browser_context_->GetPath().Append(kModelFileName);
+  file_task_runner_ = base::CreateSequencedTaskRunner(
+      {base::ThreadPool(), base::MayBlock(), base::TaskPriority::BEST_EFFORT,
+       base::TaskShutdownBehavior::BLOCK_SHUTDOWN});
+  writer_ = std::make_unique<base::ImportantFileWriter>(
+      path, file_task_runner_, kWriteInterval);
+  base::PostTaskAndReplyWithResult(
+      file_task_runner_.get(), FROM_HERE, base::BindOnce(&ReadModel, path),
+      base::BindOnce(&PreconnectPredictor::OnModelLoaded,
+                     weak_factory_.GetWeakPtr()));
+}
+
+PreconnectPredictor::~PreconnectPredictor() {
+  if (writer_ && writer_->HasPendingWrite())
+    writer_->DoScheduledWrite();
+}
+
+void PreconnectPredictor::OnMainFrameNavigationStarted(const GURL& url) {
+  DCHECK_CURRENTLY_ON(content::BrowserThread::UI);
+  if (!url.SchemeIsHTTPOrHTTPS())
+    return;
+  std::string host = url::Origin::Create(url).Serialize();
+
+  // The predictions the previous page of the host did not use.
+  auto pending = pending_predictions_.find(host);
+  if (pending != pending_predictions_.end()) {
+    stats_.misses += pending->second.size();
+    pending_predictions_.erase(pending);
+  }
+
+  auto iter = model_.find(host);
+  if (iter == model_.end())
+    return;
+  std::vector<predictors::PreconnectRequest> requests;
+  std::set<std::string> predicted;
+  for (const auto& origin : iter->second.origins) {
+    if (!IsConfident(origin.second, iter->second.navigations))
+      continue;
+    requests.emplace_back(url::Origin::Create(GURL(origin.first)), 1,
+                          net::NetworkIsolationKey());
+    predicted.insert(origin.first);
+  }
+  if (requests.empty())
+    return;
+  stats_.preconnects += requests.size();
+  pending_predictions_[host] = std::move(predicted);
+  browser_context_->GetPreconnectManager()->Start(url, std::move(requests));
+}
+
+void PreconnectPredictor::OnMainFrameNavigationCommitted(const GURL& url) {
+  DCHECK_CURRENTLY_ON(content::BrowserThread::UI);
+  if (!url.SchemeIsHTTPOrHTTPS())
+    return;
+  std::string host = url::Origin::Create(url).Serialize();
+  HostStats& stats = model_[host];
+  stats.last_navigation = ++navigation_count_;
+  if (++stats.navigations > kMaxNavigations) {
+    stats.navigations /= 2;
+    for (auto iter = stats.origins.begin(); iter != stats.origins.end();) {
+      iter->second /= 2;
+      if (iter->second == 0)
+        iter = stats.origins.erase(iter);
+      else
+        ++iter;
+    }
+  }
+  page_origins_[host].clear();
+  EvictHosts();
+  ScheduleWrite();
+}
+
+void PreconnectPredictor::OnSubresourceCompleted(const url::Origin& initiator,
+                                                 const GURL& url) {
+  DCHECK_CURRENTLY_ON(content::BrowserThread::UI);
+  if (initiator.opaque() || !url.SchemeIsHTTPOrHTTPS())
+    return;
+  std::string host = initiator.Serialize();
+  std::string origin = url::Origin::Create(url).Serialize();
+  if (origin == host)
+    return;
+  // Only the hosts navigated to in a main frame are learned.
+  auto iter = model_.find(host);
+  if (iter == model_.end())
+    return;
+
+  auto pending = pending_predictions_.find(host);
+  if (pending != pending_predictions_.end() && pending->second.erase(origin))
+    ++stats_.hits;
+
+  if (!page_origins_[host].insert(origin).second)
+    return;
+  auto& origins = iter->second.origins;
+  ++origins[origin];
+  if (origins.size() > kMaxOriginsPerHost) {
+    // Drops the least used of the other origins.
+    auto least_used = origins.end();
+    for (auto it = origins.begin(); it != origins.end(); ++it) {
+      if (it->first != origin &&
+          (least_used == origins.end() || it->second < least_used->second))
+        least_used = it;
+    }
+    origins.erase(least_used);
+  }
+  ScheduleWrite();
+}
+
+void PreconnectPredictor::Clear() {
+  DCHECK_CURRENTLY_ON(content::BrowserThread::UI);
+  model_.clear();
+  page_origins_.clear();
+  pending_predictions_.clear();
+  stats_ = Stats();
+  if (writer_) {
+    // Writes the empty model, which also replaces a pending write.
+    writer_->WriteNow(std::make_unique<std::string>("{}"));
+  }
+}
+
+bool PreconnectPredictor::SerializeData(std::string* data) {
+  base::Value model(base::Value::Type::DICTIONARY);
+  for (const auto& host : model_) {
+    base::Value origins(base::Value::Type::DICTIONARY);
+    for (const auto& origin : host.second.origins)
+      origins.SetIntKey(origin.first, origin.second);
+    base::Value stats(base::Value::Type::DICTIONARY);
+    stats.SetIntKey(kNavigationsKey, host.second.navigations);
+    stats.SetKey(kOriginsKey, std::move(origins));
+    model.SetKey(host.first, std::move(stats));
+  }
+  return base::JSONWriter::Write(model, data);
+}
+
+void PreconnectPredictor::OnModelLoaded(std::unique_ptr<base::Value> model) {
+  if (!model || !model->is_dict())
+    return;
+  // What was learned before the model was read takes precedence.
+  for (const auto& host : model->DictItems()) {
+    if (!host.second.is_dict() || model_.count(host.first))
+      continue;
+    base::Optional<int> navigations =
+        host.second.FindIntKey(kNavigationsKey);
+    const base::Value* origins = host.second.FindDictKey(kOriginsKey);
+    if (!navigations || *navigations <= 0 || !origins)
+      continue;
+    HostStats stats;
+    stats.navigations = std::min(*navigations, kMaxNavigations);
+    for (const auto& origin : origins->DictItems()) {
+      if (origin.second.is_int() && origin.second.GetInt() > 0 &&
+          stats.origins.size() < kMaxOriginsPerHost)
+        stats.origins[origin.first] = origin.second.GetInt();
+    }
+    model_[host.first] = std::move(stats);
+  }
+  EvictHosts();
+}
+
+void PreconnectPredictor::EvictHosts() {
+  while (model_.size() > kMaxHosts) {
+    auto oldest = std::min_element(
+        model_.begin(), model_.end(), [](const auto& a, const auto& b) {
+          return a.second.last_navigation < b.second.last_navigation;
+        });
+    page_origins_.erase(oldest->first);
+    pending_predictions_.erase(oldest->first);
+    model_.erase(oldest);
+  }
+  stats_.hosts = model_.size();
+}
+
+void PreconnectPredictor::ScheduleWrite() {
+  if (writer_)
+    writer_->ScheduleWrite(this);
+}
+
+}  // namespace electron
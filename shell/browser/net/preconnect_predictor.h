@@ -0,0 +1,106 @@
+// Copyright (c) 2020 GitHub, Inc.
+// Use of this source code is governed by the MIT license that can be
+// found in the LICENSE file.
+
+#ifndef SHELL_BROWSER_NET_PRECONNECT_PREDICTOR_H_
+#define SHELL_BROWSER_NET_PRECONNECT_PREDICTOR_H_
+
+#include <map>
+#include <memory>
+#include <set>
+#include <string>
+
+#include "base/files/important_file_writer.h"
+#include "base/macros.h"
+#include "base/memory/scoped_refptr.h"
+#include "base/memory/weak_ptr.h"
+#include "base/sequenced_task_runner.h"
+#include "url/gurl.h"
+#include "url/origin.h"
+
+namespace base {
+class Value;
+}
+
+namespace electron {
+
+class AtomBrowserContext;
+
+// Learns which origins the pages of a host load their subresources from, and
+// preconnects to them when a navigation to the host starts. The model is kept
+// in the partition's directory, unless the partition is in memory.
+class PreconnectPredictor : public base::ImportantFileWriter::DataSerializer {
+ public:
+  struct Stats {
+    // The number of origins preconnected to.
+    uint64_t preconnects = 0;
+    // The preconnected origins which the page then loaded from, and those it
+    // did not.
+    uint64_t hits = 0;
+    uint64_t misses = 0;
+    // The number of hosts in the model.
+    size_t hosts = 0;
+  };
+
+  explicit PreconnectPredictor(AtomBrowserContext* browser_context);
+  ~PreconnectPredictor() override;
+
+  // Preconnects to the origins learned for the host of |url|.
+  void OnMainFrameNavigationStarted(const GURL& url);
+  // Starts recording the subresource origins of a new page of |url|.
+  void OnMainFrameNavigationCommitted(const GURL& url);
+  // Records that a page of |initiator| loaded a subresource from |url|.
+  void OnSubresourceCompleted(const url::Origin& initiator, const GURL& url);
+
+  // Forgets the model and removes it from disk.
+  void Clear();
+
+  const Stats& stats() const { return stats_; }
+
+  // base::ImportantFileWriter::DataSerializer:
+  bool SerializeData(std::string* data) override;
+
+ private:
+  struct HostStats {
+    HostStats();
+    HostStats(const HostStats&);
+    ~HostStats();
+
+    // The number of pages of the host, and how many of them loaded from each
+    // origin.
+    int navigations = 0;
+    std::map<std::string, int> origins;
+    // Orders the hosts for eviction.
+    uint64_t last_navigation = 0;
+  };
+
+  void OnModelLoaded(std::unique_ptr<base::Value> model);
+  void EvictHosts();
+  void ScheduleWrite();
+
+  AtomBrowserContext* browser_context_;
+
+  std::map<std::string, HostStats> model_;
+  uint64_t navigation_count_ = 0;
+
+  // The origins seen by the current page of each host, so each is only
+  // counted once per page.
+  std::map<std::string, std::set<std::string>> page_origins_;
+  // The origins preconnected for the current page of each host, which were
+  // not used yet.
+  std::map<std::string, std::set<std::string>> pending_predictions_;
+
+  Stats stats_;
+
+  // Unset for the in-memory partitions.
+  scoped_refptr<base::SequencedTaskRunner> file_task_runner_;
+  std::unique_ptr<base::ImportantFileWriter> writer_;
+
+  base::WeakPtrFactory<PreconnectPredictor> weak_factory_{this};
+
+  DISALLOW_COPY_AND_ASSIGN(PreconnectPredictor);
+};
+
+}  // namespace electron
+
+#endif  // SHELL_BROWSER_NET_PRECONNECT_PREDICTOR_H_
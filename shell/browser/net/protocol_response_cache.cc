@@ -0,0 +1,135 @@
+// Copyright (c) 2020 GitHub, Inc.
+// Use of this source code is governed by the MIT license that can be
+// found in the LICENSE file.
+
+#include "shell/browser/net/protocol_response_cache.h"
+
+#include <iterator>
+#include <utility>
+
+#include "base/bind.h"
+#include "net/http/http_request_headers.h"
+#include "net/http/http_response_headers.h"
+
+namespace electron {
+
+namespace {
+
+// Returns when the response with |headers| stops being fresh.
+base::Time GetExpiry(const net::HttpResponseHeaders& headers) {
+  base::Time now = base::Time::Now();
+  return now + headers.GetFreshnessLifetimes(now).freshness;
+}
+
+}  // namespace
+
+ProtocolResponseCache::Entry::Entry() = default;
+ProtocolResponseCache::Entry::Entry(Entry&&) = default;
+ProtocolResponseCache::Entry::~Entry() = default;
+ProtocolResponseCache::Entry& ProtocolResponseCache::Entry::operator=(
+    Entry&&) = default;
+
+network::mojom::URLResponseHeadPtr ProtocolResponseCache::Entry::CreateHead()
+    const {
+  auto copy = head.Clone();
+  // The headers are ref counted, and would otherwise be shared with the cache.
+  copy->headers = base::MakeRefCounted<net::HttpResponseHeaders>(
+      head->headers->raw_headers());
+  return copy;
+}
+
+ProtocolResponseCache::ProtocolResponseCache(size_t max_size)
+    : entries_(base::MRUCache<std::string, Entry>::NO_AUTO_EVICT),
+      max_size_(max_size),
+      memory_pressure_listener_(
+          base::BindRepeating(&ProtocolResponseCache::OnMemoryPressure,
+                              base::Unretained(this))) {}
+
+ProtocolResponseCache::~ProtocolResponseCache() = default;
+
+// static
+bool ProtocolResponseCache::IsCacheable(
+    const network::ResourceRequest& request) {
+  return request.method == net::HttpRequestHeaders::kGetMethod &&
+         !request.headers.HasHeader(net::HttpRequestHeaders::kRange);
+}
+
+const ProtocolResponseCache::Entry* ProtocolResponseCache::Get(
+    const GURL& url) {
+  auto iter = entries_.Get(url.spec());
+  return iter == entries_.end() ? nullptr : &iter->second;
+}
+
+// static
+bool ProtocolResponseCache::IsFresh(const Entry& entry) {
+  return base::Time::Now() < entry.expiry;
+}
+
+void ProtocolResponseCache::Put(const GURL& url,
+                                const network::mojom::URLResponseHead& head,
+                                const std::string& data) {
+  auto iter = entries_.Peek(url.spec());
+  if (iter != entries_.end())
+    Erase(iter);
+
+  const net::HttpResponseHeaders& headers = *head.headers;
+  if (max_size_ == 0 || headers.response_code() != 200 ||
+      data.size() > max_size_ ||
+      headers.HasHeaderValue("cache-control", "no-store"))
+    return;
+
+  Entry entry;
+  headers.EnumerateHeader(nullptr, "etag", &entry.etag);
+  entry.expiry = GetExpiry(headers);
+  // Responses which are stale right away are only worth keeping when they
+  // can be revalidated.
+  if (!IsFresh(entry) && entry.etag.empty())
+    return;
+
+  entry.head = head.Clone();
+  entry.head->headers =
+      base::MakeRefCounted<net::HttpResponseHeaders>(headers.raw_headers());
+  entry.data = data;
+  size_ += data.size();
+  entries_.Put(url.spec(), std::move(entry));
+  SetMaxSize(max_size_);
+}
+
+void ProtocolResponseCache::Refresh(const GURL& url,
+                                    const net::HttpResponseHeaders& headers) {
+  auto iter = entries_.Peek(url.spec());
+  if (iter != entries_.end())
+    iter->second.expiry = GetExpiry(headers);
+}
+
+void ProtocolResponseCache::SetMaxSize(size_t max_size) {
+  max_size_ = max_size;
+  EvictTo(max_size_);
+}
+
+void ProtocolResponseCache::Erase(
+    base::MRUCache<std::string, Entry>::iterator iter) {
+  size_ -= iter->second.data.size();
+  entries_.Erase(iter);
+}
+
+void ProtocolResponseCache::EvictTo(size_t size) {
+  while (size_ > size)
+    Erase(std::prev(entries_.end()));
+}
+
+void ProtocolResponseCache::OnMemoryPressure(
+    base::MemoryPressureListener::MemoryPressureLevel level) {
+  switch (level) {
+    case base::MemoryPressureListener::MEMORY_PRESSURE_LEVEL_MODERATE:
+      EvictTo(max_size_ / 2);
+      break;
+    case base::MemoryPressureListener::MEMORY_PRESSURE_LEVEL_CRITICAL:
+      EvictTo(0);
+      break;
+    default:
+      break;
+  }
+}
+
+}  // namespace electron
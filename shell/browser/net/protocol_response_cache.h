@@ -0,0 +1,97 @@
+// Copyright (c) 2020 GitHub, Inc.
+// Use of this source code is governed by the MIT license that can be
+// found in the LICENSE file.
+
+#ifndef SHELL_BROWSER_NET_PROTOCOL_RESPONSE_CACHE_H_
+#define SHELL_BROWSER_NET_PROTOCOL_RESPONSE_CACHE_H_
+
+#include <string>
+
+#include "base/containers/mru_cache.h"
+#include "base/macros.h"
+#include "base/memory/memory_pressure_listener.h"
+#include "base/memory/ref_counted.h"
+#include "base/time/time.h"
+#include "services/network/public/cpp/resource_request.h"
+#include "services/network/public/mojom/url_response_head.mojom.h"
+#include "url/gurl.h"
+
+namespace electron {
+
+// An in-memory cache of the buffer and string responses of a custom protocol,
+// which is shared by all the pages of a session. Responses are kept while the
+// Cache-Control and Expires headers of the handler say they are fresh, and
+// revalidated with If-None-Match when they have an ETag, evicting the least
+// recently used responses once |max_size| bytes are stored.
+class ProtocolResponseCache
+    : public base::RefCounted<ProtocolResponseCache> {
+ public:
+  struct Entry {
+    Entry();
+    Entry(Entry&&);
+    ~Entry();
+    Entry& operator=(Entry&&);
+
+    // Returns a copy of the cached response head, which can be modified.
+    network::mojom::URLResponseHeadPtr CreateHead() const;
+
+    network::mojom::URLResponseHeadPtr head;
+    std::string data;
+    std::string etag;
+    base::Time expiry;
+  };
+
+  explicit ProtocolResponseCache(size_t max_size);
+
+  // Only the GET requests of whole resources are cached.
+  static bool IsCacheable(const network::ResourceRequest& request);
+
+  // Returns the response stored for |url|, or nullptr.
+  const Entry* Get(const GURL& url);
+
+  // Returns whether |entry| can be sent without calling the handler.
+  static bool IsFresh(const Entry& entry);
+
+  // Stores the response of |url| when its headers allow it.
+  void Put(const GURL& url,
+           const network::mojom::URLResponseHead& head,
+           const std::string& data);
+
+  // Updates the expiry of the response of |url| after the handler confirmed
+  // with a 304 response that it has not changed.
+  void Refresh(const GURL& url, const net::HttpResponseHeaders& headers);
+
+  // Evicts responses until at most |max_size| bytes are stored, a size of 0
+  // disabling the cache.
+  void SetMaxSize(size_t max_size);
+
+  size_t max_size() const { return max_size_; }
+  size_t size() const { return size_; }
+
+ private:
+  friend class base::RefCounted<ProtocolResponseCache>;
+  ~ProtocolResponseCache();
+
+  void Erase(base::MRUCache<std::string, Entry>::iterator iter);
+
+  // Evicts responses until at most |size| bytes are stored.
+  void EvictTo(size_t size);
+
+  // The dropped responses are asked from their handlers again on the next
+  // request: half of |max_size_| is kept under moderate memory pressure, and
+  // nothing under critical pressure.
+  void OnMemoryPressure(
+      base::MemoryPressureListener::MemoryPressureLevel level);
+
+  base::MRUCache<std::string, Entry> entries_;
+  size_t max_size_;
+  size_t size_ = 0;
+
+  base::MemoryPressureListener memory_pressure_listener_;
+
+  DISALLOW_COPY_AND_ASSIGN(ProtocolResponseCache);
+};
+
+}  // namespace electron
+
+#endif  // SHELL_BROWSER_NET_PROTOCOL_RESPONSE_CACHE_H_
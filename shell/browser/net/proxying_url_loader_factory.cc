@@ -277,8 +277,10 @@ void ProxyingURLLoaderFactory::InProgressRequest::OnComplete(
   }
 
   target_client_->OnComplete(status);
+  RequestMetrics metrics(load_timing_, status);
+  metrics.from_cache = info_->response_from_cache;
   factory_->web_request_api()->OnCompleted(&info_.value(), request_,
-                                           status.error_code);
+                                           status.error_code, metrics);
 
   // Deletes |this|.
   factory_->RemoveRequest(network_service_request_id_, request_id_);
@@ -520,6 +522,7 @@ void ProxyingURLLoaderFactory::InProgressRequest::ContinueToResponseStarted(
   proxied_client_receiver_.Resume();
 
   factory_->web_request_api()->OnResponseStarted(&info_.value(), request_);
+  load_timing_ = current_response_->load_timing;
   target_client_->OnReceiveResponse(std::move(current_response_));
 }
 
@@ -670,6 +673,136 @@ void ProxyingURLLoaderFactory::InProgressRequest::OnRequestError(
   factory_->RemoveRequest(network_service_request_id_, request_id_);
 }
 
+ProxyingURLLoaderFactory::PassThroughRequest::PassThroughRequest(
+    ProxyingURLLoaderFactory* factory,
+    int32_t routing_id,
+    int32_t network_service_request_id,
+    uint32_t options,
+    const network::ResourceRequest& request,
+    const net::MutableNetworkTrafficAnnotationTag& traffic_annotation,
+    mojo::PendingReceiver<network::mojom::URLLoader> loader_receiver,
+    mojo::PendingRemote<network::mojom::URLLoaderClient> client)
+    : factory_(factory),
+      request_(request),
+      routing_id_(routing_id),
+      network_service_request_id_(network_service_request_id),
+      options_(options),
+      traffic_annotation_(traffic_annotation),
+      target_client_(std::move(client)) {
+  loader_receiver_.Bind(std::move(loader_receiver));
+  loader_receiver_.set_disconnect_handler(base::BindOnce(
+      &PassThroughRequest::OnDisconnect, base::Unretained(this)));
+  target_client_.set_disconnect_handler(base::BindOnce(
+      &PassThroughRequest::OnDisconnect, base::Unretained(this)));
+
+  factory_->target_factory_->CreateLoaderAndStart(
+      target_loader_.BindNewPipeAndPassReceiver(), routing_id,
+      network_service_request_id, options, request,
+      client_receiver_.BindNewPipeAndPassRemote(), traffic_annotation);
+  client_receiver_.set_disconnect_handler(base::BindOnce(
+      &PassThroughRequest::OnDisconnect, base::Unretained(this)));
+}
+
+ProxyingURLLoaderFactory::PassThroughRequest::~PassThroughRequest() = default;
+
+void ProxyingURLLoaderFactory::PassThroughRequest::FollowRedirect(
+    const std::vector<std::string>& removed_headers,
+    const net::HttpRequestHeaders& modified_headers,
+    const base::Optional<GURL>& new_url) {
+  if (!redirect_info_)
+    return;
+  const GURL& redirect_url =
+      new_url ? new_url.value() : redirect_info_->new_url;
+  if (!factory_->web_request_api()->ShouldProxyRequest(redirect_url)) {
+    redirect_info_.reset();
+    target_loader_->FollowRedirect(removed_headers, modified_headers, new_url);
+    return;
+  }
+
+  // The filters apply to the new URL, so the request starts again there as an
+  // InProgressRequest, exactly as the network service would follow it.
+  if (request_.method != redirect_info_->new_method)
+    request_.request_body = nullptr;
+  request_.url = redirect_url;
+  request_.method = redirect_info_->new_method;
+  request_.site_for_cookies = redirect_info_->new_site_for_cookies;
+  request_.referrer = GURL(redirect_info_->new_referrer);
+  request_.referrer_policy = redirect_info_->new_referrer_policy;
+  for (const std::string& header : removed_headers)
+    request_.headers.RemoveHeader(header);
+  request_.headers.MergeFrom(modified_headers);
+
+  target_loader_.reset();
+  client_receiver_.reset();
+  factory_->StartProxiedRequest(loader_receiver_.Unbind(), routing_id_,
+                                network_service_request_id_, options_,
+                                request_, target_client_.Unbind(),
+                                traffic_annotation_);
+  // Deletes |this|.
+  factory_->RemovePassThroughRequest(this);
+}
+
+void ProxyingURLLoaderFactory::PassThroughRequest::SetPriority(
+    net::RequestPriority priority,
+    int32_t intra_priority_value) {
+  target_loader_->SetPriority(priority, intra_priority_value);
+}
+
+void ProxyingURLLoaderFactory::PassThroughRequest::PauseReadingBodyFromNet() {
+  target_loader_->PauseReadingBodyFromNet();
+}
+
+void ProxyingURLLoaderFactory::PassThroughRequest::ResumeReadingBodyFromNet() {
+  target_loader_->ResumeReadingBodyFromNet();
+}
+
+void ProxyingURLLoaderFactory::PassThroughRequest::OnReceiveResponse(
+    network::mojom::URLResponseHeadPtr head) {
+  target_client_->OnReceiveResponse(std::move(head));
+}
+
+void ProxyingURLLoaderFactory::PassThroughRequest::OnReceiveRedirect(
+    const net::RedirectInfo& redirect_info,
+    network::mojom::URLResponseHeadPtr head) {
+  redirect_info_ = redirect_info;
+  target_client_->OnReceiveRedirect(redirect_info, std::move(head));
+}
+
+void ProxyingURLLoaderFactory::PassThroughRequest::OnUploadProgress(
+    int64_t current_position,
+    int64_t total_size,
+    OnUploadProgressCallback callback) {
+  target_client_->OnUploadProgress(current_position, total_size,
+                                   std::move(callback));
+}
+
+void ProxyingURLLoaderFactory::PassThroughRequest::OnReceiveCachedMetadata(
+    mojo_base::BigBuffer data) {
+  target_client_->OnReceiveCachedMetadata(std::move(data));
+}
+
+void ProxyingURLLoaderFactory::PassThroughRequest::OnTransferSizeUpdated(
+    int32_t transfer_size_diff) {
+  target_client_->OnTransferSizeUpdated(transfer_size_diff);
+}
+
+void ProxyingURLLoaderFactory::PassThroughRequest::OnStartLoadingResponseBody(
+    mojo::ScopedDataPipeConsumerHandle body) {
+  target_client_->OnStartLoadingResponseBody(std::move(body));
+}
+
+void ProxyingURLLoaderFactory::PassThroughRequest::OnComplete(
+    const network::URLLoaderCompletionStatus& status) {
+  target_client_->OnComplete(status);
+  // Deletes |this|.
+  factory_->RemovePassThroughRequest(this);
+}
+
+void ProxyingURLLoaderFactory::PassThroughRequest::OnDisconnect() {
+  // Deletes |this|.
+  factory_->RemovePassThroughRequest(this);
+}
+
 ProxyingURLLoaderFactory::ProxyingURLLoaderFactory(
     WebRequestAPI* web_request_api,
     const HandlersMap& intercepted_handlers,
@@ -738,7 +871,8 @@ void ProxyingURLLoaderFactory::CreateLoaderAndStart(
         request, base::BindOnce(&AtomURLLoaderFactory::StartLoading,
                                 std::move(loader), routing_id, request_id,
                                 options, request, std::move(client),
-                                traffic_annotation, this, it->second.first));
+                                traffic_annotation, this, it->second.first,
+                                nullptr));
     return;
   }
 
@@ -749,14 +883,25 @@ void ProxyingURLLoaderFactory::CreateLoaderAndStart(
     return;
   }
 
-  if (!web_request_api()->HasListener()) {
-    // Pass-through to the original factory.
-    target_factory_->CreateLoaderAndStart(
-        std::move(loader), routing_id, request_id, options, request,
-        std::move(client), traffic_annotation);
+  if (!web_request_api()->ShouldProxyRequest(request.url)) {
+    pass_through_requests_.insert(std::make_unique<PassThroughRequest>(
+        this, routing_id, request_id, options, request, traffic_annotation,
+        std::move(loader), std::move(client)));
     return;
   }
 
+  StartProxiedRequest(std::move(loader), routing_id, request_id, options,
+                      request, std::move(client), traffic_annotation);
+}
+
+void ProxyingURLLoaderFactory::StartProxiedRequest(
+    mojo::PendingReceiver<network::mojom::URLLoader> loader,
+    int32_t routing_id,
+    int32_t request_id,
+    uint32_t options,
+    const network::ResourceRequest& request,
+    mojo::PendingRemote<network::mojom::URLLoaderClient> client,
+    const net::MutableNetworkTrafficAnnotationTag& traffic_annotation) {
   // The request ID doesn't really matter. It just needs to be unique
   // per-BrowserContext so extensions can make sense of it.  Note that
   // |network_service_request_id_| by contrast is not necessarily unique, so we
@@ -822,10 +967,20 @@ void ProxyingURLLoaderFactory::RemoveRequest(int32_t network_service_request_id,
   MaybeDeleteThis();
 }
 
+void ProxyingURLLoaderFactory::RemovePassThroughRequest(
+    PassThroughRequest* request) {
+  auto it = pass_through_requests_.find(request);
+  DCHECK(it != pass_through_requests_.end());
+  pass_through_requests_.erase(it);
+
+  MaybeDeleteThis();
+}
+
 void ProxyingURLLoaderFactory::MaybeDeleteThis() {
   // Even if all URLLoaderFactory pipes connected to this object have been
   // closed it has to stay alive until all active requests have completed.
-  if (target_factory_.is_bound() || !requests_.empty())
+  if (target_factory_.is_bound() || !requests_.empty() ||
+      !pass_through_requests_.empty())
     return;
 
   delete this;
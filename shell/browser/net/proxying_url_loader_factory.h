@@ -11,6 +11,7 @@
 #include <string>
 #include <vector>
 
+#include "base/containers/unique_ptr_adapters.h"
 #include "base/optional.h"
 #include "content/public/browser/content_browser_client.h"
 #include "extensions/browser/api/web_request/web_request_info.h"
@@ -24,6 +25,7 @@
 #include "services/network/public/mojom/url_loader.mojom.h"
 #include "services/network/public/mojom/url_response_head.mojom.h"
 #include "shell/browser/net/atom_url_loader_factory.h"
+#include "shell/browser/net/request_metrics.h"
 
 namespace electron {
 
@@ -38,6 +40,9 @@ class WebRequestAPI {
                               int error_code)>;
 
   virtual bool HasListener() const = 0;
+  // Whether a request to |url| has to go through the proxy, which is only the
+  // case when a listener or rule can apply to it.
+  virtual bool ShouldProxyRequest(const GURL& url) = 0;
   virtual int OnBeforeRequest(extensions::WebRequestInfo* info,
                               const network::ResourceRequest& request,
                               net::CompletionOnceCallback callback,
@@ -66,7 +71,8 @@ class WebRequestAPI {
                                int net_error) = 0;
   virtual void OnCompleted(extensions::WebRequestInfo* info,
                            const network::ResourceRequest& request,
-                           int net_error) = 0;
+                           int net_error,
+                           const RequestMetrics& metrics) = 0;
   virtual void OnRequestWillBeDestroyed(extensions::WebRequestInfo* info) = 0;
 };
 
@@ -164,6 +170,8 @@ class ProxyingURLLoaderFactory
 
     network::mojom::URLResponseHeadPtr current_response_;
     scoped_refptr<net::HttpResponseHeaders> override_headers_;
+    // Kept from the response for the metrics reported on completion.
+    net::LoadTimingInfo load_timing_;
     GURL redirect_url_;
 
     mojo::Receiver<network::mojom::URLLoaderClient> proxied_client_receiver_{
@@ -205,6 +213,64 @@ class ProxyingURLLoaderFactory
     DISALLOW_COPY_AND_ASSIGN(InProgressRequest);
   };
 
+  // A request no listener or rule applies to, which skips the webRequest
+  // machinery. The filters are checked again on each redirect, and the
+  // request continues as an InProgressRequest once they apply to the new URL.
+  class PassThroughRequest : public network::mojom::URLLoader,
+                             public network::mojom::URLLoaderClient {
+   public:
+    PassThroughRequest(
+        ProxyingURLLoaderFactory* factory,
+        int32_t routing_id,
+        int32_t network_service_request_id,
+        uint32_t options,
+        const network::ResourceRequest& request,
+        const net::MutableNetworkTrafficAnnotationTag& traffic_annotation,
+        mojo::PendingReceiver<network::mojom::URLLoader> loader_receiver,
+        mojo::PendingRemote<network::mojom::URLLoaderClient> client);
+    ~PassThroughRequest() override;
+
+    // network::mojom::URLLoader:
+    void FollowRedirect(const std::vector<std::string>& removed_headers,
+                        const net::HttpRequestHeaders& modified_headers,
+                        const base::Optional<GURL>& new_url) override;
+    void SetPriority(net::RequestPriority priority,
+                     int32_t intra_priority_value) override;
+    void PauseReadingBodyFromNet() override;
+    void ResumeReadingBodyFromNet() override;
+
+    // network::mojom::URLLoaderClient:
+    void OnReceiveResponse(network::mojom::URLResponseHeadPtr head) override;
+    void OnReceiveRedirect(const net::RedirectInfo& redirect_info,
+                           network::mojom::URLResponseHeadPtr head) override;
+    void OnUploadProgress(int64_t current_position,
+                          int64_t total_size,
+                          OnUploadProgressCallback callback) override;
+    void OnReceiveCachedMetadata(mojo_base::BigBuffer data) override;
+    void OnTransferSizeUpdated(int32_t transfer_size_diff) override;
+    void OnStartLoadingResponseBody(
+        mojo::ScopedDataPipeConsumerHandle body) override;
+    void OnComplete(const network::URLLoaderCompletionStatus& status) override;
+
+   private:
+    void OnDisconnect();
+
+    ProxyingURLLoaderFactory* factory_;
+    network::ResourceRequest request_;
+    const int32_t routing_id_;
+    const int32_t network_service_request_id_;
+    const uint32_t options_;
+    const net::MutableNetworkTrafficAnnotationTag traffic_annotation_;
+    base::Optional<net::RedirectInfo> redirect_info_;
+
+    mojo::Receiver<network::mojom::URLLoader> loader_receiver_{this};
+    mojo::Remote<network::mojom::URLLoaderClient> target_client_;
+    mojo::Receiver<network::mojom::URLLoaderClient> client_receiver_{this};
+    mojo::Remote<network::mojom::URLLoader> target_loader_;
+
+    DISALLOW_COPY_AND_ASSIGN(PassThroughRequest);
+  };
+
   ProxyingURLLoaderFactory(
       WebRequestAPI* web_request_api,
       const HandlersMap& intercepted_handlers,
@@ -250,6 +316,15 @@ class ProxyingURLLoaderFactory
   void OnTargetFactoryError();
   void OnProxyBindingError();
   void RemoveRequest(int32_t network_service_request_id, uint64_t request_id);
+  void RemovePassThroughRequest(PassThroughRequest* request);
+  void StartProxiedRequest(
+      mojo::PendingReceiver<network::mojom::URLLoader> loader,
+      int32_t routing_id,
+      int32_t request_id,
+      uint32_t options,
+      const network::ResourceRequest& request,
+      mojo::PendingRemote<network::mojom::URLLoaderClient> client,
+      const net::MutableNetworkTrafficAnnotationTag& traffic_annotation);
   void MaybeDeleteThis();
 
   bool ShouldIgnoreConnectionsLimit(const network::ResourceRequest& request);
@@ -280,6 +355,9 @@ class ProxyingURLLoaderFactory
   // InProgressRequest instance.
   std::map<uint64_t, std::unique_ptr<InProgressRequest>> requests_;
 
+  std::set<std::unique_ptr<PassThroughRequest>, base::UniquePtrComparator>
+      pass_through_requests_;
+
   // A mapping from the network stack's notion of request ID to our own
   // internally generated request ID for the same request.
   std::map<int32_t, uint64_t> network_request_id_to_web_request_id_;
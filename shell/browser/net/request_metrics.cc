@@ -0,0 +1,168 @@
+// Copyright (c) 2020 GitHub, Inc.
+// Use of this source code is governed by the MIT license that can be
+// found in the LICENSE file.
+
+#include "shell/browser/net/request_metrics.h"
+
+#include <algorithm>
+
+#include "base/no_destructor.h"
+#include "gin/dictionary.h"
+
+namespace electron {
+
+namespace {
+
+// Returns the time between |start| and |end|, when both happened.
+base::Optional<base::TimeDelta> Elapsed(base::TimeTicks start,
+                                        base::TimeTicks end) {
+  if (start.is_null() || end.is_null() || end < start)
+    return base::nullopt;
+  return end - start;
+}
+
+}  // namespace
+
+RequestMetrics::RequestMetrics() = default;
+
+RequestMetrics::RequestMetrics(
+    const net::LoadTimingInfo& load_timing,
+    const network::URLLoaderCompletionStatus& status)
+    : dns(Elapsed(load_timing.connect_timing.dns_start,
+                  load_timing.connect_timing.dns_end)),
+      connect(Elapsed(load_timing.connect_timing.connect_start,
+                      load_timing.connect_timing.connect_end)),
+      ssl(Elapsed(load_timing.connect_timing.ssl_start,
+                  load_timing.connect_timing.ssl_end)),
+      ttfb(Elapsed(load_timing.send_start, load_timing.receive_headers_end)),
+      total(Elapsed(load_timing.request_start, status.completion_time)),
+      socket_reused(load_timing.socket_reused),
+      encoded_data_length(status.encoded_data_length),
+      encoded_body_length(status.encoded_body_length),
+      decoded_body_length(status.decoded_body_length) {}
+
+RequestMetrics::RequestMetrics(const RequestMetrics&) = default;
+
+RequestMetrics::~RequestMetrics() = default;
+
+RequestMetricsHistogram::Histogram::Histogram()
+    : counts(GetBucketBounds().size() + 1) {}
+
+RequestMetricsHistogram::Histogram::Histogram(const Histogram&) = default;
+
+RequestMetricsHistogram::Histogram::~Histogram() = default;
+
+void RequestMetricsHistogram::Histogram::Add(base::TimeDelta duration) {
+  const auto& bounds = GetBucketBounds();
+  auto bucket = std::upper_bound(bounds.begin(), bounds.end(),
+                                 duration.InMillisecondsF());
+  ++counts[bucket - bounds.begin()];
+}
+
+RequestMetricsHistogram::RequestMetricsHistogram() = default;
+
+RequestMetricsHistogram::~RequestMetricsHistogram() = default;
+
+// static
+const std::vector<double>& RequestMetricsHistogram::GetBucketBounds() {
+  static base::NoDestructor<std::vector<double>> bounds(
+      {1, 2, 5, 10, 20, 50, 100, 200, 500, 1000, 2000, 5000, 10000});
+  return *bounds;
+}
+
+void RequestMetricsHistogram::Add(const std::string& request_class,
+                                  const RequestMetrics& metrics) {
+  ClassMetrics& class_metrics = classes_[request_class];
+  ++class_metrics.requests;
+  if (metrics.from_cache)
+    ++class_metrics.cache_hits;
+  class_metrics.encoded_data_length += metrics.encoded_data_length;
+  class_metrics.decoded_body_length += metrics.decoded_body_length;
+  if (metrics.dns)
+    class_metrics.dns.Add(*metrics.dns);
+  if (metrics.connect)
+    class_metrics.connect.Add(*metrics.connect);
+  if (metrics.ssl)
+    class_metrics.ssl.Add(*metrics.ssl);
+  if (metrics.ttfb)
+    class_metrics.ttfb.Add(*metrics.ttfb);
+  if (metrics.total)
+    class_metrics.total.Add(*metrics.total);
+}
+
+}  // namespace electron
+
+namespace gin {
+
+namespace {
+
+void SetDuration(gin::Dictionary* dict,
+                 const char* key,
+                 const base::Optional<base::TimeDelta>& duration) {
+  if (duration)
+    dict->Set(key, duration->InMillisecondsF());
+}
+
+v8::Local<v8::Value> HistogramToV8(
+    v8::Isolate* isolate,
+    const electron::RequestMetricsHistogram::Histogram& histogram) {
+  std::vector<double> counts(histogram.counts.begin(), histogram.counts.end());
+  return gin::ConvertToV8(isolate, counts);
+}
+
+}  // namespace
+
+// static
+v8::Local<v8::Value> Converter<electron::RequestMetrics>::ToV8(
+    v8::Isolate* isolate,
+    const electron::RequestMetrics& metrics) {
+  gin::Dictionary timing = gin::Dictionary::CreateEmpty(isolate);
+  SetDuration(&timing, "dns", metrics.dns);
+  SetDuration(&timing, "connect", metrics.connect);
+  SetDuration(&timing, "ssl", metrics.ssl);
+  SetDuration(&timing, "ttfb", metrics.ttfb);
+  SetDuration(&timing, "total", metrics.total);
+
+  gin::Dictionary dict = gin::Dictionary::CreateEmpty(isolate);
+  dict.Set("timing", timing);
+  dict.Set("socketReused", metrics.socket_reused);
+  dict.Set("fromCache", metrics.from_cache);
+  dict.Set("encodedDataLength",
+           static_cast<double>(metrics.encoded_data_length));
+  dict.Set("encodedBodyLength",
+           static_cast<double>(metrics.encoded_body_length));
+  dict.Set("decodedBodyLength",
+           static_cast<double>(metrics.decoded_body_length));
+  return ConvertToV8(isolate, dict);
+}
+
+// static
+v8::Local<v8::Value> Converter<electron::RequestMetricsHistogram>::ToV8(
+    v8::Isolate* isolate,
+    const electron::RequestMetricsHistogram& histogram) {
+  gin::Dictionary classes = gin::Dictionary::CreateEmpty(isolate);
+  for (const auto& it : histogram.classes()) {
+    const auto& metrics = it.second;
+    gin::Dictionary dict = gin::Dictionary::CreateEmpty(isolate);
+    dict.Set("requests", static_cast<double>(metrics.requests));
+    dict.Set("cacheHits", static_cast<double>(metrics.cache_hits));
+    dict.Set("encodedDataLength",
+             static_cast<double>(metrics.encoded_data_length));
+    dict.Set("decodedBodyLength",
+             static_cast<double>(metrics.decoded_body_length));
+    dict.Set("dns", HistogramToV8(isolate, metrics.dns));
+    dict.Set("connect", HistogramToV8(isolate, metrics.connect));
+    dict.Set("ssl", HistogramToV8(isolate, metrics.ssl));
+    dict.Set("ttfb", HistogramToV8(isolate, metrics.ttfb));
+    dict.Set("total", HistogramToV8(isolate, metrics.total));
+    classes.Set(it.first, dict);
+  }
+
+  gin::Dictionary dict = gin::Dictionary::CreateEmpty(isolate);
+  dict.Set("bucketBounds",
+           electron::RequestMetricsHistogram::GetBucketBounds());
+  dict.Set("classes", classes);
+  return ConvertToV8(isolate, dict);
+}
+
+}  // namespace gin
@@ -0,0 +1,112 @@
+// Copyright (c) 2020 GitHub, Inc.
+// Use of this source code is governed by the MIT license that can be
+// found in the LICENSE file.
+
+#ifndef SHELL_BROWSER_NET_REQUEST_METRICS_H_
+#define SHELL_BROWSER_NET_REQUEST_METRICS_H_
+
+#include <map>
+#include <string>
+#include <vector>
+
+#include "base/macros.h"
+#include "base/optional.h"
+#include "base/time/time.h"
+#include "gin/converter.h"
+#include "net/base/load_timing_info.h"
+#include "services/network/public/cpp/url_loader_completion_status.h"
+
+namespace electron {
+
+// The timing and sizes of a completed request.
+struct RequestMetrics {
+  RequestMetrics();
+  RequestMetrics(const net::LoadTimingInfo& load_timing,
+                 const network::URLLoaderCompletionStatus& status);
+  RequestMetrics(const RequestMetrics&);
+  ~RequestMetrics();
+
+  // The phases are unset when they did not happen, like the DNS lookup and
+  // connection of a request on a reused socket.
+  base::Optional<base::TimeDelta> dns;
+  base::Optional<base::TimeDelta> connect;
+  base::Optional<base::TimeDelta> ssl;
+  // From sending the request to receiving the response headers.
+  base::Optional<base::TimeDelta> ttfb;
+  // From the start of the request to its completion.
+  base::Optional<base::TimeDelta> total;
+
+  bool socket_reused = false;
+  // Whether the response came from the HTTP cache.
+  bool from_cache = false;
+  int64_t encoded_data_length = 0;
+  int64_t encoded_body_length = 0;
+  int64_t decoded_body_length = 0;
+};
+
+// Aggregates the metrics of requests into histograms per class of request.
+class RequestMetricsHistogram {
+ public:
+  // The counts of a duration, where |counts[i]| is the number of durations
+  // below |GetBucketBounds()[i]| milliseconds, and the last count is those
+  // above all the bounds.
+  struct Histogram {
+    Histogram();
+    Histogram(const Histogram&);
+    ~Histogram();
+
+    void Add(base::TimeDelta duration);
+
+    std::vector<uint64_t> counts;
+  };
+
+  struct ClassMetrics {
+    uint64_t requests = 0;
+    uint64_t cache_hits = 0;
+    uint64_t encoded_data_length = 0;
+    uint64_t decoded_body_length = 0;
+    Histogram dns;
+    Histogram connect;
+    Histogram ssl;
+    Histogram ttfb;
+    Histogram total;
+  };
+
+  RequestMetricsHistogram();
+  ~RequestMetricsHistogram();
+
+  static const std::vector<double>& GetBucketBounds();
+
+  void Add(const std::string& request_class, const RequestMetrics& metrics);
+  void Clear() { classes_.clear(); }
+
+  const std::map<std::string, ClassMetrics>& classes() const {
+    return classes_;
+  }
+
+ private:
+  std::map<std::string, ClassMetrics> classes_;
+
+  DISALLOW_COPY_AND_ASSIGN(RequestMetricsHistogram);
+};
+
+}  // namespace electron
+
+namespace gin {
+
+template <>
+struct Converter<electron::RequestMetrics> {
+  static v8::Local<v8::Value> ToV8(v8::Isolate* isolate,
+                                   const electron::RequestMetrics& metrics);
+};
+
+template <>
+struct Converter<electron::RequestMetricsHistogram> {
+  static v8::Local<v8::Value> ToV8(
+      v8::Isolate* isolate,
+      const electron::RequestMetricsHistogram& histogram);
+};
+
+}  // namespace gin
+
+#endif  // SHELL_BROWSER_NET_REQUEST_METRICS_H_
@@ -7,24 +7,43 @@
 #include <utility>
 
 #include "base/bind.h"
+#include "base/threading/sequenced_task_runner_handle.h"
 #include "content/public/browser/browser_thread.h"
 #include "content/public/browser/storage_partition.h"
 #include "mojo/public/cpp/bindings/pending_remote.h"
 #include "net/proxy_resolution/proxy_info.h"
 #include "services/network/public/mojom/network_context.mojom.h"
 #include "shell/browser/atom_browser_context.h"
+#include "url/origin.h"
 
 using content::BrowserThread;
 
 namespace electron {
 
+namespace {
+
+// The lookups sent to the network service at once, which evaluates them on
+// its own threads.
+const size_t kMaxConcurrentLookups = 8;
+
+// How long the result for a host is reused, which is short enough to follow
+// changes to the system settings or to the PAC script.
+constexpr base::TimeDelta kCacheTTL = base::TimeDelta::FromSeconds(10);
+
+const size_t kMaxCacheEntries = 256;
+
+}  // namespace
+
 ResolveProxyHelper::ResolveProxyHelper(AtomBrowserContext* browser_context)
-    : browser_context_(browser_context) {}
+    : browser_context_(browser_context) {
+  receivers_.set_disconnect_handler(base::BindRepeating(
+      &ResolveProxyHelper::OnLookupDisconnected, base::Unretained(this)));
+}
 
 ResolveProxyHelper::~ResolveProxyHelper() {
   DCHECK_CURRENTLY_ON(BrowserThread::UI);
   DCHECK(!owned_self_);
-  DCHECK(!receiver_.is_bound());
+  DCHECK(receivers_.empty());
   // Clear all pending requests if the ProxyService is still alive.
   pending_requests_.clear();
 }
@@ -32,70 +51,100 @@ ResolveProxyHelper::~ResolveProxyHelper() {
 void ResolveProxyHelper::ResolveProxy(const GURL& url,
                                       ResolveProxyCallback callback) {
   DCHECK_CURRENTLY_ON(BrowserThread::UI);
-  // Enqueue the pending request.
-  pending_requests_.emplace_back(url, std::move(callback));
-
-  // If nothing is in progress, start.
-  if (!receiver_.is_bound()) {
-    DCHECK_EQ(1u, pending_requests_.size());
-    StartPendingRequest();
+  const std::string cache_key = GetCacheKey(url);
+  auto cached = cache_.find(cache_key);
+  if (cached != cache_.end()) {
+    if (base::TimeTicks::Now() < cached->second.expiry) {
+      // Keep the callback asynchronous, like that of a lookup.
+      base::SequencedTaskRunnerHandle::Get()->PostTask(
+          FROM_HERE, base::BindOnce(std::move(callback), cached->second.proxy));
+      return;
+    }
+    cache_.erase(cached);
   }
+
+  // Wait for the lookup of the same URL when there is one.
+  auto& callbacks = pending_requests_[url];
+  callbacks.push_back(std::move(callback));
+  if (callbacks.size() > 1)
+    return;
+
+  queued_urls_.push_back(url);
+  StartQueuedLookups();
 }
 
-void ResolveProxyHelper::StartPendingRequest() {
+void ResolveProxyHelper::ClearCache() {
+  cache_.clear();
+  ++cache_generation_;
+}
+
+void ResolveProxyHelper::StartQueuedLookups() {
   DCHECK_CURRENTLY_ON(BrowserThread::UI);
-  DCHECK(!receiver_.is_bound());
-  DCHECK(!pending_requests_.empty());
-
-  // Start the request.
-  mojo::PendingRemote<network::mojom::ProxyLookupClient> proxy_lookup_client =
-      receiver_.BindNewPipeAndPassRemote();
-  receiver_.set_disconnect_handler(
-      base::BindOnce(&ResolveProxyHelper::OnProxyLookupComplete,
-                     base::Unretained(this), net::ERR_ABORTED, base::nullopt));
-  content::BrowserContext::GetDefaultStoragePartition(browser_context_)
-      ->GetNetworkContext()
-      ->LookUpProxyForURL(pending_requests_.front().url,
-                          net::NetworkIsolationKey::Todo(),
-                          std::move(proxy_lookup_client));
+  while (!queued_urls_.empty() && receivers_.size() < kMaxConcurrentLookups) {
+    GURL url = std::move(queued_urls_.front());
+    queued_urls_.pop_front();
+
+    mojo::PendingRemote<network::mojom::ProxyLookupClient> proxy_lookup_client;
+    receivers_.Add(this, proxy_lookup_client.InitWithNewPipeAndPassReceiver(),
+                   LookupContext{url, cache_generation_});
+    content::BrowserContext::GetDefaultStoragePartition(browser_context_)
+        ->GetNetworkContext()
+        ->LookUpProxyForURL(url, net::NetworkIsolationKey::Todo(),
+                            std::move(proxy_lookup_client));
+  }
+
+  if (!receivers_.empty())
+    owned_self_ = this;
 }
 
 void ResolveProxyHelper::OnProxyLookupComplete(
     int32_t net_error,
     const base::Optional<net::ProxyInfo>& proxy_info) {
   DCHECK_CURRENTLY_ON(BrowserThread::UI);
-  DCHECK(!pending_requests_.empty());
-
-  receiver_.reset();
-
-  // Clear the current (completed) request.
-  PendingRequest completed_request = std::move(pending_requests_.front());
-  pending_requests_.pop_front();
-
   std::string proxy;
   if (proxy_info)
     proxy = proxy_info->ToPacString();
+  CompleteLookup(net_error, proxy);
+}
 
-  if (!completed_request.callback.is_null())
-    std::move(completed_request.callback).Run(proxy);
-
-  // Start the next request.
-  if (!pending_requests_.empty())
-    StartPendingRequest();
+void ResolveProxyHelper::OnLookupDisconnected() {
+  CompleteLookup(net::ERR_ABORTED, std::string());
 }
 
-ResolveProxyHelper::PendingRequest::PendingRequest(
-    const GURL& url,
-    ResolveProxyCallback callback)
-    : url(url), callback(std::move(callback)) {}
+void ResolveProxyHelper::CompleteLookup(int32_t net_error,
+                                        const std::string& proxy) {
+  const LookupContext context = receivers_.current_context();
+  receivers_.Remove(receivers_.current_receiver());
+
+  const std::string cache_key = GetCacheKey(context.url);
+  if (net_error == net::OK && !cache_key.empty() &&
+      context.cache_generation == cache_generation_) {
+    if (cache_.size() >= kMaxCacheEntries)
+      cache_.clear();
+    cache_[cache_key] = {proxy, base::TimeTicks::Now() + kCacheTTL};
+  }
 
-ResolveProxyHelper::PendingRequest::PendingRequest(
-    ResolveProxyHelper::PendingRequest&& pending_request) = default;
+  std::vector<ResolveProxyCallback> callbacks;
+  auto iter = pending_requests_.find(context.url);
+  if (iter != pending_requests_.end()) {
+    callbacks = std::move(iter->second);
+    pending_requests_.erase(iter);
+  }
 
-ResolveProxyHelper::PendingRequest::~PendingRequest() noexcept = default;
+  // Keep alive while running the callbacks, which may make new requests.
+  scoped_refptr<ResolveProxyHelper> self = std::move(owned_self_);
+  StartQueuedLookups();
+  for (auto& callback : callbacks) {
+    if (!callback.is_null())
+      std::move(callback).Run(proxy);
+  }
+}
 
-ResolveProxyHelper::PendingRequest& ResolveProxyHelper::PendingRequest::
-operator=(ResolveProxyHelper::PendingRequest&& pending_request) noexcept =
-    default;
+// static
+std::string ResolveProxyHelper::GetCacheKey(const GURL& url) {
+  // The URLs without a host are not cached.
+  url::Origin origin = url::Origin::Create(url);
+  return origin.opaque() ? std::string() : origin.Serialize();
+}
 
 }  // namespace electron
@@ -6,11 +6,14 @@
 #define SHELL_BROWSER_NET_RESOLVE_PROXY_HELPER_H_
 
 #include <deque>
+#include <map>
 #include <string>
+#include <vector>
 
 #include "base/memory/ref_counted.h"
 #include "base/optional.h"
-#include "mojo/public/cpp/bindings/receiver.h"
+#include "base/time/time.h"
+#include "mojo/public/cpp/bindings/receiver_set.h"
 #include "services/network/public/mojom/proxy_lookup_client.mojom.h"
 #include "url/gurl.h"
 
@@ -28,41 +31,60 @@ class ResolveProxyHelper
 
   void ResolveProxy(const GURL& url, ResolveProxyCallback callback);
 
+  // Drops the cached results, which have to be called when the proxy settings
+  // change.
+  void ClearCache();
+
  protected:
   ~ResolveProxyHelper() override;
 
  private:
   friend class base::RefCountedThreadSafe<ResolveProxyHelper>;
-  // A PendingRequest is a resolve request that is in progress, or queued.
-  struct PendingRequest {
-   public:
-    PendingRequest(const GURL& url, ResolveProxyCallback callback);
-    PendingRequest(PendingRequest&& pending_request) noexcept;
-    ~PendingRequest();
-
-    PendingRequest& operator=(PendingRequest&& pending_request) noexcept;
 
+  // Identifies the lookup each receiver is for.
+  struct LookupContext {
     GURL url;
-    ResolveProxyCallback callback;
+    // The |cache_generation_| the lookup was started in, so that results from
+    // before the cache was cleared are not stored.
+    uint64_t cache_generation;
+  };
 
-   private:
-    DISALLOW_COPY_AND_ASSIGN(PendingRequest);
+  struct CachedProxy {
+    std::string proxy;
+    base::TimeTicks expiry;
   };
 
-  // Starts the first pending request.
-  void StartPendingRequest();
+  // Starts the queued lookups until |kMaxConcurrentLookups| are in progress.
+  void StartQueuedLookups();
 
   // network::mojom::ProxyLookupClient implementation.
   void OnProxyLookupComplete(
       int32_t net_error,
       const base::Optional<net::ProxyInfo>& proxy_info) override;
 
+  void OnLookupDisconnected();
+
+  // Runs the callbacks waiting for the lookup |context| of the current
+  // receiver, and removes it.
+  void CompleteLookup(int32_t net_error, const std::string& proxy);
+
+  // Returns the key of the cached result of |url|, which PAC scripts mostly
+  // decide by host, or an empty string when it is not cached.
+  static std::string GetCacheKey(const GURL& url);
+
   // Self-reference. Owned as long as there's an outstanding proxy lookup.
   scoped_refptr<ResolveProxyHelper> owned_self_;
 
-  std::deque<PendingRequest> pending_requests_;
-  // Receiver for the currently in-progress request, if any.
-  mojo::Receiver<network::mojom::ProxyLookupClient> receiver_{this};
+  // URL => callbacks waiting for its lookup, which is in progress or queued.
+  // Identical URLs requested at the same time share a single lookup.
+  std::map<GURL, std::vector<ResolveProxyCallback>> pending_requests_;
+  std::deque<GURL> queued_urls_;
+  // Receivers of the lookups in progress.
+  mojo::ReceiverSet<network::mojom::ProxyLookupClient, LookupContext>
+      receivers_;
+
+  std::map<std::string, CachedProxy> cache_;
+  uint64_t cache_generation_ = 0;
 
   // Weak Ref
   AtomBrowserContext* browser_context_;
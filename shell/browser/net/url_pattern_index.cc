@@ -0,0 +1,110 @@
+// Copyright (c) 2020 GitHub, Inc.
+// Use of this source code is governed by the MIT license that can be
+// found in the LICENSE file.
+
+#include "shell/browser/net/url_pattern_index.h"
+
+#include "base/strings/string_piece.h"
+#include "base/strings/string_util.h"
+
+namespace electron {
+
+namespace {
+
+// Hosts are compared without case and without the trailing dot, which the
+// patterns ignore as well.
+std::string NormalizeHost(base::StringPiece host) {
+  if (!host.empty() && host.back() == '.')
+    host.remove_suffix(1);
+  return base::ToLowerASCII(host);
+}
+
+}  // namespace
+
+URLPatternIndex::URLPatternIndex() = default;
+
+URLPatternIndex::URLPatternIndex(const std::set<URLPattern>& patterns) {
+  size_t id = 0;
+  for (const auto& pattern : patterns)
+    Add(pattern, id++);
+}
+
+URLPatternIndex::URLPatternIndex(const URLPatternIndex&) = default;
+
+URLPatternIndex::~URLPatternIndex() = default;
+
+URLPatternIndex& URLPatternIndex::operator=(const URLPatternIndex&) = default;
+
+void URLPatternIndex::Add(const URLPattern& pattern, size_t id) {
+  ++size_;
+  std::string host = NormalizeHost(pattern.host());
+  if (pattern.match_all_urls() || host.empty())
+    any_host_.push_back({pattern, id});
+  else if (pattern.match_subdomains())
+    domains_[host].push_back({pattern, id});
+  else
+    hosts_[host].push_back({pattern, id});
+}
+
+void URLPatternIndex::AddMatchAll(size_t id) {
+  ++size_;
+  match_all_.push_back(id);
+}
+
+template <typename Visitor>
+bool URLPatternIndex::VisitCandidates(const GURL& url, Visitor visitor) const {
+  for (const auto& entry : any_host_) {
+    if (visitor(entry))
+      return true;
+  }
+
+  std::string host = NormalizeHost(url.host_piece());
+  if (host.empty())
+    return false;
+
+  auto iter = hosts_.find(host);
+  if (iter != hosts_.end()) {
+    for (const auto& entry : iter->second) {
+      if (visitor(entry))
+        return true;
+    }
+  }
+
+  // The host itself and each of its parent domains, "a.b.c", "b.c" and "c".
+  if (domains_.empty())
+    return false;
+  base::StringPiece domain(host);
+  while (!domain.empty()) {
+    iter = domains_.find(domain.as_string());
+    if (iter != domains_.end()) {
+      for (const auto& entry : iter->second) {
+        if (visitor(entry))
+          return true;
+      }
+    }
+    size_t dot = domain.find('.');
+    if (dot == base::StringPiece::npos)
+      break;
+    domain.remove_prefix(dot + 1);
+  }
+  return false;
+}
+
+bool URLPatternIndex::Matches(const GURL& url) const {
+  if (!match_all_.empty())
+    return true;
+  return VisitCandidates(url, [&url](const Entry& entry) {
+    return entry.pattern.MatchesURL(url);
+  });
+}
+
+void URLPatternIndex::GetMatches(const GURL& url, std::set<size_t>* ids) const {
+  ids->insert(match_all_.begin(), match_all_.end());
+  VisitCandidates(url, [&url, ids](const Entry& entry) {
+    if (entry.pattern.MatchesURL(url))
+      ids->insert(entry.id);
+    return false;
+  });
+}
+
+}  // namespace electron
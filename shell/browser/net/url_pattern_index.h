@@ -0,0 +1,67 @@
+// Copyright (c) 2020 GitHub, Inc.
+// Use of this source code is governed by the MIT license that can be
+// found in the LICENSE file.
+
+#ifndef SHELL_BROWSER_NET_URL_PATTERN_INDEX_H_
+#define SHELL_BROWSER_NET_URL_PATTERN_INDEX_H_
+
+#include <set>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "extensions/common/url_pattern.h"
+#include "url/gurl.h"
+
+namespace electron {
+
+// Indexes URL patterns by their hosts, so that only the patterns which can
+// match the host of a URL are tested against it, instead of all of them.
+//
+// Each pattern is added with an id, and a URL is matched by the ids of the
+// patterns matching it.
+class URLPatternIndex {
+ public:
+  URLPatternIndex();
+  explicit URLPatternIndex(const std::set<URLPattern>& patterns);
+  URLPatternIndex(const URLPatternIndex&);
+  ~URLPatternIndex();
+
+  URLPatternIndex& operator=(const URLPatternIndex&);
+
+  void Add(const URLPattern& pattern, size_t id);
+  // Makes |id| match all URLs.
+  void AddMatchAll(size_t id);
+
+  bool empty() const { return size_ == 0; }
+
+  // Returns whether any of the patterns matches |url|.
+  bool Matches(const GURL& url) const;
+  // Adds the ids of the patterns matching |url| to |ids|.
+  void GetMatches(const GURL& url, std::set<size_t>* ids) const;
+
+ private:
+  struct Entry {
+    URLPattern pattern;
+    size_t id;
+  };
+  using Bucket = std::vector<Entry>;
+
+  // Calls |visitor| with the entries that can match |url|, until it returns
+  // true. Returns whether it did.
+  template <typename Visitor>
+  bool VisitCandidates(const GURL& url, Visitor visitor) const;
+
+  std::vector<size_t> match_all_;
+  // The patterns matching any host, such as <all_urls> or file:///*.
+  Bucket any_host_;
+  // The patterns matching a single host, by host.
+  std::unordered_map<std::string, Bucket> hosts_;
+  // The patterns matching a host and its subdomains, by host.
+  std::unordered_map<std::string, Bucket> domains_;
+  size_t size_ = 0;
+};
+
+}  // namespace electron
+
+#endif  // SHELL_BROWSER_NET_URL_PATTERN_INDEX_H_
@@ -9,17 +9,19 @@
 #include "mojo/public/cpp/bindings/pending_remote.h"
 #include "mojo/public/cpp/system/string_data_source.h"
 #include "services/network/public/cpp/shared_url_loader_factory.h"
+#include "shell/browser/atom_browser_context.h"
 
 namespace electron {
 
 URLPipeLoader::URLPipeLoader(
-    scoped_refptr<network::SharedURLLoaderFactory> factory,
+    scoped_refptr<AtomBrowserContext> browser_context,
     std::unique_ptr<network::ResourceRequest> request,
     network::mojom::URLLoaderRequest loader,
     mojo::PendingRemote<network::mojom::URLLoaderClient> client,
     const net::NetworkTrafficAnnotationTag& annotation,
     base::DictionaryValue upload_data)
-    : binding_(this, std::move(loader)),
+    : browser_context_(std::move(browser_context)),
+      binding_(this, std::move(loader)),
       client_(std::move(client)),
       weak_factory_(this) {
   binding_.set_connection_error_handler(base::BindOnce(
@@ -28,18 +30,20 @@ URLPipeLoader::URLPipeLoader(
   // PostTask since it might destruct.
   base::SequencedTaskRunnerHandle::Get()->PostTask(
       FROM_HERE,
-      base::BindOnce(&URLPipeLoader::Start, weak_factory_.GetWeakPtr(), factory,
+      base::BindOnce(&URLPipeLoader::Start, weak_factory_.GetWeakPtr(),
                      std::move(request), annotation, std::move(upload_data)));
 }
 
 URLPipeLoader::~URLPipeLoader() = default;
 
 void URLPipeLoader::Start(
-    scoped_refptr<network::SharedURLLoaderFactory> factory,
     std::unique_ptr<network::ResourceRequest> request,
     const net::NetworkTrafficAnnotationTag& annotation,
     base::DictionaryValue upload_data) {
   loader_ = network::SimpleURLLoader::Create(std::move(request), annotation);
+  // The bodies of error responses are forwarded too, like they would be when
+  // loading the URL directly.
+  loader_->SetAllowHttpErrorResults(true);
   loader_->SetOnResponseStartedCallback(base::Bind(
       &URLPipeLoader::OnResponseStarted, weak_factory_.GetWeakPtr()));
 
@@ -50,7 +54,8 @@ void URLPipeLoader::Start(
       upload_data.GetString("data", &data))
     loader_->AttachStringForUpload(data, content_type);
 
-  loader_->DownloadAsStream(factory.get(), this);
+  loader_->DownloadAsStream(browser_context_->GetURLLoaderFactory().get(),
+                            this);
 }
 
 void URLPipeLoader::NotifyComplete(int result) {
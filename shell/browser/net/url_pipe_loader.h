@@ -9,6 +9,7 @@
 #include <string>
 #include <vector>
 
+#include "base/memory/scoped_refptr.h"
 #include "mojo/public/cpp/bindings/receiver.h"
 #include "mojo/public/cpp/bindings/remote.h"
 #include "mojo/public/cpp/bindings/strong_binding.h"
@@ -17,12 +18,10 @@
 #include "services/network/public/cpp/simple_url_loader_stream_consumer.h"
 #include "services/network/public/mojom/url_loader.mojom.h"
 
-namespace network {
-class SharedURLLoaderFactory;
-}
-
 namespace electron {
 
+class AtomBrowserContext;
+
 // Read data from URL and pipe it to NetworkService.
 //
 // Different from creating a new loader for the URL directly, protocol handlers
@@ -33,7 +32,9 @@ namespace electron {
 class URLPipeLoader : public network::mojom::URLLoader,
                       public network::SimpleURLLoaderStreamConsumer {
  public:
-  URLPipeLoader(scoped_refptr<network::SharedURLLoaderFactory> factory,
+  // The request is made with the URL loader factory of |browser_context|,
+  // which is kept alive until it is done.
+  URLPipeLoader(scoped_refptr<AtomBrowserContext> browser_context,
                 std::unique_ptr<network::ResourceRequest> request,
                 network::mojom::URLLoaderRequest loader,
                 mojo::PendingRemote<network::mojom::URLLoaderClient> client,
@@ -43,8 +44,7 @@ class URLPipeLoader : public network::mojom::URLLoader,
  private:
   ~URLPipeLoader() override;
 
-  void Start(scoped_refptr<network::SharedURLLoaderFactory> factory,
-             std::unique_ptr<network::ResourceRequest> request,
+  void Start(std::unique_ptr<network::ResourceRequest> request,
              const net::NetworkTrafficAnnotationTag& annotation,
              base::DictionaryValue upload_data);
   void NotifyComplete(int result);
@@ -67,6 +67,8 @@ class URLPipeLoader : public network::mojom::URLLoader,
   void PauseReadingBodyFromNet() override {}
   void ResumeReadingBodyFromNet() override {}
 
+  scoped_refptr<AtomBrowserContext> browser_context_;
+
   mojo::Binding<network::mojom::URLLoader> binding_;
   mojo::Remote<network::mojom::URLLoaderClient> client_;
 
@@ -0,0 +1,158 @@
+// Copyright (c) 2020 GitHub, Inc.
+// Use of this source code is governed by the MIT license that can be
+// found in the LICENSE file.
+
+#include "shell/browser/net/web_request_rules.h"
+
+#include <utility>
+
+#include "base/stl_util.h"
+#include "net/base/net_errors.h"
+
+namespace electron {
+
+const char* GetResourceTypeName(content::ResourceType type) {
+  switch (type) {
+    case content::ResourceType::kMainFrame:
+      return "mainFrame";
+    case content::ResourceType::kSubFrame:
+      return "subFrame";
+    case content::ResourceType::kStylesheet:
+      return "stylesheet";
+    case content::ResourceType::kScript:
+      return "script";
+    case content::ResourceType::kImage:
+      return "image";
+    case content::ResourceType::kObject:
+      return "object";
+    case content::ResourceType::kXhr:
+      return "xhr";
+    default:
+      return "other";
+  }
+}
+
+WebRequestRules::Rule::Rule() = default;
+WebRequestRules::Rule::Rule(const Rule&) = default;
+WebRequestRules::Rule::~Rule() = default;
+
+WebRequestRules::WebRequestRules() = default;
+
+WebRequestRules::~WebRequestRules() = default;
+
+namespace {
+
+void AddRule(const WebRequestRules::Rule& rule,
+             size_t id,
+             URLPatternIndex* index) {
+  if (rule.url_patterns.empty()) {
+    index->AddMatchAll(id);
+    return;
+  }
+  for (const auto& pattern : rule.url_patterns)
+    index->Add(pattern, id);
+}
+
+}  // namespace
+
+void WebRequestRules::SetRules(std::vector<Rule> rules) {
+  rules_ = std::move(rules);
+  block_rules_ = URLPatternIndex();
+  redirect_rules_ = URLPatternIndex();
+  request_header_rules_ = URLPatternIndex();
+  response_header_rules_ = URLPatternIndex();
+  for (size_t i = 0; i < rules_.size(); ++i) {
+    const Rule& rule = rules_[i];
+    switch (rule.action) {
+      case Rule::Action::kBlock:
+        AddRule(rule, i, &block_rules_);
+        break;
+      case Rule::Action::kRedirect:
+        AddRule(rule, i, &redirect_rules_);
+        break;
+      case Rule::Action::kModifyHeaders:
+        if (!rule.set_request_headers.empty() ||
+            !rule.remove_request_headers.empty())
+          AddRule(rule, i, &request_header_rules_);
+        if (!rule.set_response_headers.empty() ||
+            !rule.remove_response_headers.empty())
+          AddRule(rule, i, &response_header_rules_);
+        break;
+    }
+  }
+}
+
+bool WebRequestRules::MatchesURL(const GURL& url) const {
+  return block_rules_.Matches(url) || redirect_rules_.Matches(url) ||
+         request_header_rules_.Matches(url) ||
+         response_header_rules_.Matches(url);
+}
+
+int WebRequestRules::OnBeforeRequest(const extensions::WebRequestInfo& info,
+                                     GURL* new_url) const {
+  // Blocking takes precedence over redirecting, whatever the order of the
+  // rules is.
+  if (!GetMatchingRules(block_rules_, info).empty())
+    return net::ERR_BLOCKED_BY_CLIENT;
+  for (size_t index : GetMatchingRules(redirect_rules_, info)) {
+    const Rule& rule = rules_[index];
+    // A rule redirecting to the URL it was matched with would never finish.
+    if (rule.redirect_url != info.url) {
+      *new_url = rule.redirect_url;
+      break;
+    }
+  }
+  return net::OK;
+}
+
+void WebRequestRules::OnBeforeSendHeaders(
+    const extensions::WebRequestInfo& info,
+    net::HttpRequestHeaders* headers) const {
+  for (size_t index : GetMatchingRules(request_header_rules_, info)) {
+    const Rule& rule = rules_[index];
+    for (const auto& header : rule.remove_request_headers)
+      headers->RemoveHeader(header);
+    for (const auto& header : rule.set_request_headers)
+      headers->SetHeader(header.first, header.second);
+  }
+}
+
+void WebRequestRules::OnHeadersReceived(
+    const extensions::WebRequestInfo& info,
+    const net::HttpResponseHeaders* original_response_headers,
+    scoped_refptr<net::HttpResponseHeaders>* override_response_headers) const {
+  if (!original_response_headers)
+    return;
+  for (size_t index : GetMatchingRules(response_header_rules_, info)) {
+    const Rule& rule = rules_[index];
+    if (!*override_response_headers) {
+      *override_response_headers = new net::HttpResponseHeaders(
+          original_response_headers->raw_headers());
+    }
+    for (const auto& header : rule.remove_response_headers)
+      (*override_response_headers)->RemoveHeader(header);
+    for (const auto& header : rule.set_response_headers) {
+      (*override_response_headers)->RemoveHeader(header.first);
+      (*override_response_headers)
+          ->AddHeader(header.first + ": " + header.second);
+    }
+  }
+}
+
+std::set<size_t> WebRequestRules::GetMatchingRules(
+    const URLPatternIndex& index,
+    const extensions::WebRequestInfo& info) const {
+  std::set<size_t> matches;
+  if (index.empty())
+    return matches;
+  index.GetMatches(info.url, &matches);
+  const char* resource_type = GetResourceTypeName(info.type);
+  base::EraseIf(matches, [this, resource_type](size_t match) {
+    const auto& resource_types = rules_[match].resource_types;
+    return !resource_types.empty() &&
+           !base::Contains(resource_types, resource_type);
+  });
+  return matches;
+}
+
+}  // namespace electron
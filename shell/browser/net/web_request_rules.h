@@ -0,0 +1,99 @@
+// Copyright (c) 2020 GitHub, Inc.
+// Use of this source code is governed by the MIT license that can be
+// found in the LICENSE file.
+
+#ifndef SHELL_BROWSER_NET_WEB_REQUEST_RULES_H_
+#define SHELL_BROWSER_NET_WEB_REQUEST_RULES_H_
+
+#include <map>
+#include <set>
+#include <string>
+#include <vector>
+
+#include "base/macros.h"
+#include "base/memory/scoped_refptr.h"
+#include "content/public/common/resource_type.h"
+#include "extensions/browser/api/web_request/web_request_info.h"
+#include "extensions/common/url_pattern.h"
+#include "net/http/http_request_headers.h"
+#include "net/http/http_response_headers.h"
+#include "shell/browser/net/url_pattern_index.h"
+#include "url/gurl.h"
+
+namespace electron {
+
+// Returns the name the webRequest API uses for |type|.
+const char* GetResourceTypeName(content::ResourceType type);
+
+// The declarative rules of the webRequest API, which block, redirect or modify
+// the headers of requests without calling into JavaScript.
+class WebRequestRules {
+ public:
+  struct Rule {
+    enum class Action {
+      kBlock,
+      kRedirect,
+      kModifyHeaders,
+    };
+
+    Rule();
+    Rule(const Rule&);
+    ~Rule();
+
+    Action action = Action::kBlock;
+
+    // The conditions of the rule, which match all requests when empty.
+    std::vector<URLPattern> url_patterns;
+    std::set<std::string> resource_types;
+
+    GURL redirect_url;
+    std::map<std::string, std::string> set_request_headers;
+    std::vector<std::string> remove_request_headers;
+    std::map<std::string, std::string> set_response_headers;
+    std::vector<std::string> remove_response_headers;
+  };
+
+  WebRequestRules();
+  ~WebRequestRules();
+
+  void SetRules(std::vector<Rule> rules);
+  bool empty() const { return rules_.empty(); }
+
+  // Returns whether the URL patterns of any rule match |url|.
+  bool MatchesURL(const GURL& url) const;
+
+  // Returns net::ERR_BLOCKED_BY_CLIENT when a rule blocks the request, and
+  // sets |new_url| when a rule redirects it.
+  int OnBeforeRequest(const extensions::WebRequestInfo& info,
+                      GURL* new_url) const;
+  void OnBeforeSendHeaders(const extensions::WebRequestInfo& info,
+                           net::HttpRequestHeaders* headers) const;
+  // Sets |override_response_headers| when a rule modifies the headers.
+  void OnHeadersReceived(
+      const extensions::WebRequestInfo& info,
+      const net::HttpResponseHeaders* original_response_headers,
+      scoped_refptr<net::HttpResponseHeaders>* override_response_headers)
+      const;
+
+ private:
+  // Returns the indices into |rules_| of the rules in |index| which match
+  // |info|, in the order of the rules.
+  std::set<size_t> GetMatchingRules(
+      const URLPatternIndex& index,
+      const extensions::WebRequestInfo& info) const;
+
+  std::vector<Rule> rules_;
+
+  // The URL patterns of the rules with each action, so that each stage of a
+  // request only checks the rules that can apply to it.
+  URLPatternIndex block_rules_;
+  URLPatternIndex redirect_rules_;
+  URLPatternIndex request_header_rules_;
+  URLPatternIndex response_header_rules_;
+
+  DISALLOW_COPY_AND_ASSIGN(WebRequestRules);
+};
+
+}  // namespace electron
+
+#endif  // SHELL_BROWSER_NET_WEB_REQUEST_RULES_H_
@@ -22,11 +22,25 @@ NodeDebugger::NodeDebugger(node::Environment* env) : env_(env) {}
 
 NodeDebugger::~NodeDebugger() = default;
 
-void NodeDebugger::Start() {
+void NodeDebugger::Start(bool parse_command_line) {
   auto* inspector = env_->inspector_agent();
   if (inspector == nullptr)
     return;
 
+  node::DebugOptions options;
+  if (parse_command_line)
+    ParseCommandLine(&options);
+  else
+    options = env_->options()->debug_options();
+
+  const char* path = "";
+  if (inspector->Start(path, options,
+                       std::make_shared<node::HostPort>(options.host_port),
+                       true /* is_main */))
+    DCHECK(env_->inspector_agent()->IsListening());
+}
+
+void NodeDebugger::ParseCommandLine(node::DebugOptions* options) {
   std::vector<std::string> args;
   for (auto& arg : base::CommandLine::ForCurrentProcess()->argv()) {
 #if defined(OS_WIN)
@@ -36,12 +50,11 @@ void NodeDebugger::Start() {
 #endif
   }
 
-  node::DebugOptions options;
   std::vector<std::string> exec_args;
   std::vector<std::string> v8_args;
   std::vector<std::string> errors;
 
-  node::options_parser::Parse(&args, &exec_args, &v8_args, &options,
+  node::options_parser::Parse(&args, &exec_args, &v8_args, options,
                               node::options_parser::kDisallowedInEnvironment,
                               &errors);
 
@@ -50,12 +63,6 @@ void NodeDebugger::Start() {
     LOG(ERROR) << "Error parsing node options: "
                << base::JoinString(errors, " ");
   }
-
-  const char* path = "";
-  if (inspector->Start(path, options,
-                       std::make_shared<node::HostPort>(options.host_port),
-                       true /* is_main */))
-    DCHECK(env_->inspector_agent()->IsListening());
 }
 
 void NodeDebugger::Stop() {
@@ -8,6 +8,7 @@
 #include "base/macros.h"
 
 namespace node {
+class DebugOptions;
 class Environment;
 }  // namespace node
 
@@ -19,10 +20,16 @@ class NodeDebugger {
   explicit NodeDebugger(node::Environment* env);
   ~NodeDebugger();
 
-  void Start();
+  // Starts the inspector agent, which inspector sessions and SIGUSR1 need
+  // even when no inspector option was passed. The options are parsed from the
+  // command line when |parse_command_line|, otherwise the ones node parsed
+  // for the environment, which include NODE_OPTIONS, are used.
+  void Start(bool parse_command_line);
   void Stop();
 
  private:
+  void ParseCommandLine(node::DebugOptions* options);
+
   node::Environment* env_;
 
   DISALLOW_COPY_AND_ASSIGN(NodeDebugger);
@@ -5,11 +5,28 @@
 #include "shell/browser/notifications/notification_presenter.h"
 
 #include <algorithm>
+#include <utility>
 
+#include "base/bind.h"
 #include "shell/browser/notifications/notification.h"
 
 namespace electron {
 
+namespace {
+
+// The window over which the rate of the notifications is limited.
+constexpr base::TimeDelta kRateInterval = base::TimeDelta::FromMinutes(1);
+
+}  // namespace
+
+NotificationPresenter::PendingNotification::PendingNotification() = default;
+NotificationPresenter::PendingNotification::PendingNotification(
+    PendingNotification&&) = default;
+NotificationPresenter::PendingNotification&
+NotificationPresenter::PendingNotification::operator=(PendingNotification&&) =
+    default;
+NotificationPresenter::PendingNotification::~PendingNotification() = default;
+
 NotificationPresenter::NotificationPresenter() = default;
 
 NotificationPresenter::~NotificationPresenter() {
@@ -38,7 +55,81 @@ void NotificationPresenter::CloseNotificationWithId(
                            return n->notification_id() == notification_id;
                          });
   if (it != notifications_.end())
-    (*it)->Dismiss();
+    DismissNotification(*it);
+}
+
+void NotificationPresenter::ShowNotification(
+    Notification* notification,
+    const NotificationOptions& options) {
+  auto it = pending_.end();
+  if (!options.tag.empty()) {
+    it = std::find_if(pending_.begin(), pending_.end(),
+                      [&options](const PendingNotification& pending) {
+                        return pending.notification &&
+                               pending.options.tag == options.tag;
+                      });
+  }
+  if (it != pending_.end()) {
+    // The replaced notification was never shown, so it is not closed.
+    Notification* replaced = it->notification.get();
+    it->notification = notification->GetWeakPtr();
+    it->options = options;
+    if (replaced != notification)
+      replaced->Destroy();
+  } else {
+    PendingNotification pending;
+    pending.notification = notification->GetWeakPtr();
+    pending.options = options;
+    pending_.push_back(std::move(pending));
+  }
+  ShowPendingNotifications();
+}
+
+void NotificationPresenter::DismissNotification(Notification* notification) {
+  auto it = std::find_if(pending_.begin(), pending_.end(),
+                         [notification](const PendingNotification& pending) {
+                           return pending.notification.get() == notification;
+                         });
+  if (it != pending_.end()) {
+    pending_.erase(it);
+    notification->NotificationDismissed();
+  } else {
+    notification->Dismiss();
+  }
+}
+
+void NotificationPresenter::SetMaxRate(int max_per_minute) {
+  max_per_minute_ = max_per_minute;
+  if (!max_per_minute_)
+    shown_times_.clear();
+  pending_timer_.Stop();
+  ShowPendingNotifications();
+}
+
+void NotificationPresenter::ShowPendingNotifications() {
+  base::TimeTicks now = base::TimeTicks::Now();
+  while (!shown_times_.empty() && now - shown_times_.front() >= kRateInterval)
+    shown_times_.pop_front();
+
+  while (!pending_.empty() &&
+         (!max_per_minute_ ||
+          shown_times_.size() < static_cast<size_t>(max_per_minute_))) {
+    PendingNotification pending = std::move(pending_.front());
+    pending_.pop_front();
+    if (!pending.notification)
+      continue;
+    if (max_per_minute_)
+      shown_times_.push_back(now);
+    // Showing can destroy the notification, or show others.
+    pending.notification->Show(pending.options);
+  }
+
+  if (!pending_.empty() && !pending_timer_.IsRunning()) {
+    pending_timer_.Start(
+        FROM_HERE, shown_times_.front() + kRateInterval - now,
+        base::BindOnce(&NotificationPresenter::ShowPendingNotifications,
+                       base::Unretained(this)));
+  }
 }
 
 }  // namespace electron
@@ -8,11 +8,14 @@
 #include <set>
 #include <string>
 
+#include "base/containers/circular_deque.h"
 #include "base/memory/weak_ptr.h"
+#include "base/time/time.h"
+#include "base/timer/timer.h"
+#include "shell/browser/notifications/notification.h"
 
 namespace electron {
 
-class Notification;
 class NotificationDelegate;
 
 class NotificationPresenter {
@@ -26,6 +29,18 @@ class NotificationPresenter {
       const std::string& notification_id);
   void CloseNotificationWithId(const std::string& notification_id);
 
+  // Shows |notification| now, or once the maximum rate allows it. A held back
+  // notification is replaced by the next one shown with the same tag, which
+  // takes its place in the queue.
+  void ShowNotification(Notification* notification,
+                        const NotificationOptions& options);
+  // Dismisses |notification|, or drops it when it is still held back.
+  void DismissNotification(Notification* notification);
+
+  // At most |max_per_minute| notifications are shown per minute, 0 for no
+  // limit.
+  void SetMaxRate(int max_per_minute);
+
   std::set<Notification*> notifications() const { return notifications_; }
 
  protected:
@@ -36,10 +51,30 @@ class NotificationPresenter {
  private:
   friend class Notification;
 
+  struct PendingNotification {
+    PendingNotification();
+    PendingNotification(PendingNotification&&);
+    PendingNotification& operator=(PendingNotification&&);
+    ~PendingNotification();
+
+    base::WeakPtr<Notification> notification;
+    NotificationOptions options;
+  };
+
   void RemoveNotification(Notification* notification);
 
+  // Shows the held back notifications the rate allows, and schedules the
+  // others.
+  void ShowPendingNotifications();
+
   std::set<Notification*> notifications_;
 
+  int max_per_minute_ = 0;
+  // When the notifications of the last minute were shown, oldest first.
+  base::circular_deque<base::TimeTicks> shown_times_;
+  base::circular_deque<PendingNotification> pending_;
+  base::OneShotTimer pending_timer_;
+
   DISALLOW_COPY_AND_ASSIGN(NotificationPresenter);
 };
 
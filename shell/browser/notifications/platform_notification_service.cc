@@ -20,6 +20,7 @@ namespace electron {
 namespace {
 
 void OnWebNotificationAllowed(base::WeakPtr<Notification> notification,
+                              const GURL& origin,
                               const SkBitmap& icon,
                               const blink::PlatformNotificationData& data,
                               bool audio_muted,
@@ -30,12 +31,15 @@ void OnWebNotificationAllowed(base::WeakPtr<Notification> notification,
     electron::NotificationOptions options;
     options.title = data.title;
     options.msg = data.body;
-    options.tag = data.tag;
+    // The tags are scoped to the origin, so that the notifications of two
+    // origins never replace each other.
+    if (!data.tag.empty())
+      options.tag = origin.spec() + "#" + data.tag;
     options.icon_url = data.icon;
     options.icon = icon;
     options.silent = audio_muted ? true : data.silent;
     options.has_reply = false;
-    notification->Show(options);
+    notification->presenter()->ShowNotification(notification.get(), options);
   } else {
     notification->Destroy();
   }
@@ -92,7 +96,7 @@ void PlatformNotificationService::DisplayNotification(
   if (notification) {
     browser_client_->WebNotificationAllowed(
         render_process_host->GetID(),
-        base::BindRepeating(&OnWebNotificationAllowed, notification,
+        base::BindRepeating(&OnWebNotificationAllowed, notification, origin,
                             notification_resources.notification_icon,
                             notification_data));
   }
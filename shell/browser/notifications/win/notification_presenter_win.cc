@@ -15,7 +15,6 @@
 #include "base/hash/md5.h"
 #include "base/strings/utf_string_conversions.h"
 #include "base/threading/thread_restrictions.h"
-#include "base/time/time.h"
 #include "base/win/windows_version.h"
 #include "shell/browser/notifications/win/notification_presenter_win7.h"
 #include "shell/browser/notifications/win/windows_toast_notification.h"
@@ -79,8 +78,9 @@ base::string16 NotificationPresenterWin::SaveIconToFilesystem(
   if (origin.is_valid()) {
     filename = base::MD5String(origin.spec()) + ".png";
   } else {
-    base::TimeTicks now = base::TimeTicks::Now();
-    filename = std::to_string(now.ToInternalValue()) + ".png";
+    // The icons decoded from the same file share their pixels through the
+    // image cache, so they are only encoded and saved once.
+    filename = "icon-" + std::to_string(icon.getGenerationID()) + ".png";
   }
 
   base::ThreadRestrictions::ScopedAllowIO allow_io;
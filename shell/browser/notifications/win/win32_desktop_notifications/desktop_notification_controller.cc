@@ -12,6 +12,7 @@
 
 #include "shell/browser/notifications/win/win32_desktop_notifications/desktop_notification_controller.h"
 
+#include <uxtheme.h>
 #include <windowsx.h>
 #include <algorithm>
 #include <utility>
@@ -20,6 +21,8 @@
 #include "shell/browser/notifications/win/win32_desktop_notifications/common.h"
 #include "shell/browser/notifications/win/win32_desktop_notifications/toast.h"
 
+#pragma comment(lib, "uxtheme.lib")
+
 namespace electron {
 
 HBITMAP CopyBitmap(HBITMAP bitmap) {
@@ -45,6 +48,41 @@ HBITMAP CopyBitmap(HBITMAP bitmap) {
   return ret;
 }
 
+static COLORREF ReadAccentColor() {
+  bool success = false;
+  if (IsAppThemed()) {
+    HKEY hkey;
+    if (RegOpenKeyEx(HKEY_CURRENT_USER,
+                     TEXT("SOFTWARE\\Microsoft\\Windows\\DWM"), 0,
+                     KEY_QUERY_VALUE, &hkey) == ERROR_SUCCESS) {
+      COLORREF color;
+      DWORD type, size;
+      if (RegQueryValueEx(hkey, TEXT("AccentColor"), nullptr, &type,
+                          reinterpret_cast<BYTE*>(&color),
+                          &(size = sizeof(color))) == ERROR_SUCCESS &&
+          type == REG_DWORD) {
+        // convert from RGBA
+        color = RGB(GetRValue(color), GetGValue(color), GetBValue(color));
+        success = true;
+      } else if (RegQueryValueEx(hkey, TEXT("ColorizationColor"), nullptr,
+                                 &type, reinterpret_cast<BYTE*>(&color),
+                                 &(size = sizeof(color))) == ERROR_SUCCESS &&
+                 type == REG_DWORD) {
+        // convert from BGRA
+        color = RGB(GetBValue(color), GetGValue(color), GetRValue(color));
+        success = true;
+      }
+
+      RegCloseKey(hkey);
+
+      if (success)
+        return color;
+    }
+  }
+
+  return GetSysColor(COLOR_ACTIVECAPTION);
+}
+
 const TCHAR DesktopNotificationController::class_name_[] =
     TEXT("DesktopNotificationController");
 
@@ -115,8 +153,16 @@ LRESULT CALLBACK DesktopNotificationController::WndProc(HWND hwnd,
     case WM_SETTINGCHANGE:
       if (wparam == SPI_SETWORKAREA) {
         Get(hwnd)->AnimateAll();
+      } else if (lparam && lstrcmpi(reinterpret_cast<LPCTSTR>(lparam),
+                                    TEXT("ImmersiveColorSet")) == 0) {
+        Get(hwnd)->OnColorsChanged();
       }
       break;
+
+    case WM_THEMECHANGED:
+    case WM_DWMCOLORIZATIONCOLORCHANGED:
+      Get(hwnd)->OnColorsChanged();
+      break;
   }
 
   return DefWindowProc(hwnd, message, wparam, lparam);
@@ -170,6 +216,27 @@ void DesktopNotificationController::InitializeFonts() {
   }
 }
 
+COLORREF DesktopNotificationController::GetAccentColor() {
+  if (accent_color_ == CLR_INVALID)
+    accent_color_ = ReadAccentColor();
+  return accent_color_;
+}
+
+HDC DesktopNotificationController::GetImageDC() {
+  if (!hdc_image_)
+    hdc_image_ = CreateCompatibleDC(NULL);
+  return hdc_image_;
+}
+
+void DesktopNotificationController::OnColorsChanged() {
+  accent_color_ = CLR_INVALID;
+  for (auto&& inst : instances_) {
+    if (inst.hwnd)
+      Toast::Get(inst.hwnd)->Invalidate();
+  }
+  AnimateAll();
+}
+
 void DesktopNotificationController::ClearAssets() {
   if (caption_font_) {
     DeleteFont(caption_font_);
@@ -179,6 +246,11 @@ void DesktopNotificationController::ClearAssets() {
     DeleteFont(body_font_);
     body_font_ = NULL;
   }
+  if (hdc_image_) {
+    DeleteDC(hdc_image_);
+    hdc_image_ = NULL;
+  }
+  accent_color_ = CLR_INVALID;
 }
 
 void DesktopNotificationController::AnimateAll() {
@@ -51,6 +51,9 @@ class DesktopNotificationController {
   HFONT GetCaptionFont();
   HFONT GetBodyFont();
   void InitializeFonts();
+  COLORREF GetAccentColor();
+  HDC GetImageDC();
+  void OnColorsChanged();
   void ClearAssets();
   void AnimateAll();
   void CheckQueue();
@@ -72,6 +75,11 @@ class DesktopNotificationController {
   enum TimerID { TimerID_Animate = 1 };
   HWND hwnd_controller_ = NULL;
   HFONT caption_font_ = NULL, body_font_ = NULL;
+  // The accent color is read from the registry once, until the colors of
+  // the system change.
+  COLORREF accent_color_ = CLR_INVALID;
+  // Shared by the toasts to blit their images.
+  HDC hdc_image_ = NULL;
   std::vector<ToastInstance> instances_;
   std::deque<std::shared_ptr<NotificationData>> queue_;
   bool is_animating_ = false;
@@ -10,7 +10,6 @@
 #include <combaseapi.h>
 
 #include <UIAutomation.h>
-#include <uxtheme.h>
 #include <windowsx.h>
 #include <algorithm>
 #include <cmath>
@@ -21,48 +20,12 @@
 #include "shell/browser/notifications/win/win32_desktop_notifications/toast_uia.h"
 
 #pragma comment(lib, "msimg32.lib")
-#pragma comment(lib, "uxtheme.lib")
 
 using std::min;
 using std::shared_ptr;
 
 namespace electron {
 
-static COLORREF GetAccentColor() {
-  bool success = false;
-  if (IsAppThemed()) {
-    HKEY hkey;
-    if (RegOpenKeyEx(HKEY_CURRENT_USER,
-                     TEXT("SOFTWARE\\Microsoft\\Windows\\DWM"), 0,
-                     KEY_QUERY_VALUE, &hkey) == ERROR_SUCCESS) {
-      COLORREF color;
-      DWORD type, size;
-      if (RegQueryValueEx(hkey, TEXT("AccentColor"), nullptr, &type,
-                          reinterpret_cast<BYTE*>(&color),
-                          &(size = sizeof(color))) == ERROR_SUCCESS &&
-          type == REG_DWORD) {
-        // convert from RGBA
-        color = RGB(GetRValue(color), GetGValue(color), GetBValue(color));
-        success = true;
-      } else if (RegQueryValueEx(hkey, TEXT("ColorizationColor"), nullptr,
-                                 &type, reinterpret_cast<BYTE*>(&color),
-                                 &(size = sizeof(color))) == ERROR_SUCCESS &&
-                 type == REG_DWORD) {
-        // convert from BGRA
-        color = RGB(GetBValue(color), GetGValue(color), GetRValue(color));
-        success = true;
-      }
-
-      RegCloseKey(hkey);
-
-      if (success)
-        return color;
-    }
-  }
-
-  return GetSysColor(COLOR_ACTIVECAPTION);
-}
-
 // Stretches a bitmap to the specified size, preserves alpha channel
 static HBITMAP StretchBitmap(HBITMAP bitmap, unsigned width, unsigned height) {
   // We use StretchBlt for the scaling, but that discards the alpha channel.
@@ -364,7 +327,7 @@ HWND DesktopNotificationController::Toast::Create(
 }
 
 void DesktopNotificationController::Toast::Draw() {
-  const COLORREF accent = GetAccentColor();
+  const COLORREF accent = data_->controller->GetAccentColor();
 
   COLORREF back_color;
   {
@@ -418,12 +381,11 @@ void DesktopNotificationController::Toast::Draw() {
 
   // Draw background
   {
-    auto* brush = CreateSolidBrush(back_color);
+    // the stock DC brush takes any color without creating a brush per draw
+    SetDCBrushColor(hdc_, back_color);
 
     RECT rc = {0, 0, toast_size_.cx, toast_size_.cy};
-    FillRect(hdc_, &rc, brush);
-
-    DeleteBrush(brush);
+    FillRect(hdc_, &rc, GetStockBrush(DC_BRUSH));
   }
 
   SetBkMode(hdc_, TRANSPARENT);
@@ -463,13 +425,15 @@ void DesktopNotificationController::Toast::Draw() {
 
   // image
   if (scaled_image_) {
-    HDC hdc_image = CreateCompatibleDC(NULL);
-    SelectBitmap(hdc_image, scaled_image_);
+    // the DC is shared by all toasts, so the image is deselected after the
+    // blit to keep it deletable
+    HDC hdc_image = data_->controller->GetImageDC();
+    auto* old_bitmap = SelectBitmap(hdc_image, scaled_image_);
     BLENDFUNCTION blend = {AC_SRC_OVER, 0, 255, AC_SRC_ALPHA};
     AlphaBlend(hdc_, margin_.cx, margin_.cy, image_info.bmWidth,
                image_info.bmHeight, hdc_image, 0, 0, image_info.bmWidth,
                image_info.bmHeight, blend);
-    DeleteDC(hdc_image);
+    SelectBitmap(hdc_image, old_bitmap);
   }
 
   // caption
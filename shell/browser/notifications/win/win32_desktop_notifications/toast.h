@@ -32,6 +32,8 @@ class DesktopNotificationController::Toast {
   }
 
   void ResetContents();
+  // Redraws the toast with the current colors on its next animation frame.
+  void Invalidate();
 
   void Dismiss();
 
@@ -57,7 +59,6 @@ class DesktopNotificationController::Toast {
   void UpdateBufferSize();
   void UpdateScaledImage(const SIZE& size);
   void Draw();
-  void Invalidate();
   bool IsRedrawNeeded() const;
   void UpdateContents();
 
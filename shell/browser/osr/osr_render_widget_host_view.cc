@@ -5,13 +5,18 @@
 #include "shell/browser/osr/osr_render_widget_host_view.h"
 
 #include <algorithm>
+#include <map>
 #include <memory>
 #include <utility>
 #include <vector>
 
+#include "base/bind.h"
 #include "base/callback_helpers.h"
 #include "base/location.h"
 #include "base/memory/ptr_util.h"
+#include "base/no_destructor.h"
+#include "base/observer_list.h"
+#include "base/observer_list_types.h"
 #include "base/optional.h"
 #include "base/single_thread_task_runner.h"
 #include "base/task/post_task.h"
@@ -34,6 +39,7 @@
 #include "media/base/video_frame.h"
 #include "third_party/blink/public/common/input/web_input_event.h"
 #include "third_party/skia/include/core/SkCanvas.h"
+#include "third_party/skia/include/core/SkPixelRef.h"
 #include "ui/compositor/compositor.h"
 #include "ui/compositor/layer.h"
 #include "ui/compositor/layer_type.h"
@@ -53,6 +59,10 @@ namespace {
 
 const float kDefaultScaleFactor = 1.0;
 
+// The number of frames in a row that the paint handlers have to keep up with
+// a higher rate for, before the paced frame rate is raised to it.
+const int kFramesToRaiseFrameRate = 30;
+
 ui::MouseEvent UiMouseEventFromWebMouseEvent(blink::WebMouseEvent event) {
   ui::EventType type = ui::EventType::ET_UNKNOWN;
   switch (event.GetType()) {
@@ -121,11 +131,50 @@ ui::MouseWheelEvent UiMouseWheelEventFromWebMouseEvent(
 
 }  // namespace
 
-class AtomBeginFrameTimer : public viz::DelayBasedTimeSourceClient {
+class SharedBeginFrameSource;
+
+// Sends the begin frames of a view at its frame rate.
+class AtomBeginFrameTimer : public base::CheckedObserver {
  public:
   AtomBeginFrameTimer(int frame_rate_threshold_us,
-                      const base::Closure& callback)
-      : callback_(callback) {
+                      const base::Closure& callback);
+  ~AtomBeginFrameTimer() override;
+
+  void SetActive(bool active);
+
+  bool IsActive() const { return active_; }
+
+  void SetFrameRateThresholdUs(int frame_rate_threshold_us);
+
+  void OnTimerTick() { callback_.Run(); }
+
+ private:
+  const base::Closure callback_;
+  SharedBeginFrameSource* source_;
+  bool active_ = false;
+
+  DISALLOW_COPY_AND_ASSIGN(AtomBeginFrameTimer);
+};
+
+// Ticks the active timers that have the same frame rate together, so that all
+// the offscreen views produce their frames in a single wake up instead of
+// each view running a time source of its own.
+class SharedBeginFrameSource : public viz::DelayBasedTimeSourceClient {
+ public:
+  // The sources are kept for the lifetime of the process, since there is at
+  // most one per frame rate.
+  static SharedBeginFrameSource* Get(int frame_rate_threshold_us) {
+    static base::NoDestructor<
+        std::map<int, std::unique_ptr<SharedBeginFrameSource>>>
+        sources;
+    auto& source = (*sources)[frame_rate_threshold_us];
+    if (!source)
+      source =
+          std::make_unique<SharedBeginFrameSource>(frame_rate_threshold_us);
+    return source.get();
+  }
+
+  explicit SharedBeginFrameSource(int frame_rate_threshold_us) {
     time_source_ = std::make_unique<viz::DelayBasedTimeSource>(
         base::CreateSingleThreadTaskRunner({content::BrowserThread::UI}).get());
     time_source_->SetTimebaseAndInterval(
@@ -134,25 +183,60 @@ class AtomBeginFrameTimer : public viz::DelayBasedTimeSourceClient {
     time_source_->SetClient(this);
   }
 
-  void SetActive(bool active) { time_source_->SetActive(active); }
-
-  bool IsActive() const { return time_source_->Active(); }
+  void AddTimer(AtomBeginFrameTimer* timer) {
+    timers_.AddObserver(timer);
+    time_source_->SetActive(true);
+  }
 
-  void SetFrameRateThresholdUs(int frame_rate_threshold_us) {
-    time_source_->SetTimebaseAndInterval(
-        base::TimeTicks::Now(),
-        base::TimeDelta::FromMicroseconds(frame_rate_threshold_us));
+  void RemoveTimer(AtomBeginFrameTimer* timer) {
+    timers_.RemoveObserver(timer);
+    if (!timers_.might_have_observers())
+      time_source_->SetActive(false);
   }
 
  private:
-  void OnTimerTick() override { callback_.Run(); }
+  void OnTimerTick() override {
+    for (auto& timer : timers_)
+      timer.OnTimerTick();
+  }
 
-  const base::Closure callback_;
+  base::ObserverList<AtomBeginFrameTimer> timers_;
   std::unique_ptr<viz::DelayBasedTimeSource> time_source_;
 
-  DISALLOW_COPY_AND_ASSIGN(AtomBeginFrameTimer);
+  DISALLOW_COPY_AND_ASSIGN(SharedBeginFrameSource);
 };
 
+AtomBeginFrameTimer::AtomBeginFrameTimer(int frame_rate_threshold_us,
+                                         const base::Closure& callback)
+    : callback_(callback),
+      source_(SharedBeginFrameSource::Get(frame_rate_threshold_us)) {}
+
+AtomBeginFrameTimer::~AtomBeginFrameTimer() {
+  SetActive(false);
+}
+
+void AtomBeginFrameTimer::SetActive(bool active) {
+  if (active == active_)
+    return;
+  active_ = active;
+  if (active)
+    source_->AddTimer(this);
+  else
+    source_->RemoveTimer(this);
+}
+
+void AtomBeginFrameTimer::SetFrameRateThresholdUs(int frame_rate_threshold_us) {
+  SharedBeginFrameSource* source =
+      SharedBeginFrameSource::Get(frame_rate_threshold_us);
+  if (source == source_)
+    return;
+  if (active_) {
+    source_->RemoveTimer(this);
+    source->AddTimer(this);
+  }
+  source_ = source;
+}
+
 class AtomDelegatedFrameHostClient : public content::DelegatedFrameHostClient {
  public:
   explicit AtomDelegatedFrameHostClient(OffScreenRenderWidgetHostView* view)
@@ -199,6 +283,7 @@ class AtomDelegatedFrameHostClient : public content::DelegatedFrameHostClient {
 
 OffScreenRenderWidgetHostView::OffScreenRenderWidgetHostView(
     bool transparent,
+    bool zero_copy,
     bool painting,
     int frame_rate,
     const OnPaintCallback& callback,
@@ -209,20 +294,27 @@ OffScreenRenderWidgetHostView::OffScreenRenderWidgetHostView(
       render_widget_host_(content::RenderWidgetHostImpl::From(host)),
       parent_host_view_(parent_host_view),
       transparent_(transparent),
+      zero_copy_(zero_copy),
       callback_(callback),
       frame_rate_(frame_rate),
+      paced_frame_rate_(PowerPolicy::Get()->LimitFrameRate(frame_rate)),
       size_(initial_size),
       painting_(painting),
       is_showing_(false),
       cursor_manager_(new content::CursorManager(this)),
       mouse_wheel_phase_handler_(this),
       backing_(new SkBitmap),
+      memory_pressure_listener_(base::BindRepeating(
+          &OffScreenRenderWidgetHostView::OnMemoryPressure,
+          base::Unretained(this))),
       weak_ptr_factory_(this) {
   DCHECK(render_widget_host_);
   bool is_guest_view_hack = parent_host_view_ != nullptr;
 
   current_device_scale_factor_ = kDefaultScaleFactor;
 
+  PowerPolicy::Get()->AddObserver(this);
+
   delegated_frame_host_allocator_.GenerateId();
   delegated_frame_host_allocation_ =
       delegated_frame_host_allocator_.GetCurrentLocalSurfaceIdAllocation();
@@ -264,14 +356,17 @@ OffScreenRenderWidgetHostView::OffScreenRenderWidgetHostView(
 
   if (content::GpuDataManager::GetInstance()->HardwareAccelerationEnabled()) {
     video_consumer_ = std::make_unique<OffScreenVideoConsumer>(
-        this, base::BindRepeating(&OffScreenRenderWidgetHostView::OnPaint,
-                                  weak_ptr_factory_.GetWeakPtr()));
+        this,
+        base::BindRepeating(&OffScreenRenderWidgetHostView::OnFrameCaptured,
+                            weak_ptr_factory_.GetWeakPtr()));
     video_consumer_->SetActive(IsPainting());
-    video_consumer_->SetFrameRate(GetFrameRate());
+    video_consumer_->SetFrameRate(GetPacedFrameRate());
   }
 }
 
 OffScreenRenderWidgetHostView::~OffScreenRenderWidgetHostView() {
+  PowerPolicy::Get()->RemoveObserver(this);
+
   // Marking the DelegatedFrameHost as removed from the window hierarchy is
   // necessary to remove all connections to its old ui::Compositor.
   if (is_showing_)
@@ -633,8 +728,8 @@ OffScreenRenderWidgetHostView::CreateViewForWidget(
   }
 
   return new OffScreenRenderWidgetHostView(
-      transparent_, true, embedder_host_view->GetFrameRate(), callback_,
-      render_widget_host, embedder_host_view, size());
+      transparent_, zero_copy_, true, embedder_host_view->GetFrameRate(),
+      callback_, render_widget_host, embedder_host_view, size());
 }
 
 const viz::FrameSinkId& OffScreenRenderWidgetHostView::GetFrameSinkId() const {
@@ -751,10 +846,43 @@ bool OffScreenRenderWidgetHostView::UpdateNSViewAndDisplay() {
 
 void OffScreenRenderWidgetHostView::OnPaint(const gfx::Rect& damage_rect,
                                             const SkBitmap& bitmap) {
-  backing_ = std::make_unique<SkBitmap>();
-  backing_->allocN32Pixels(bitmap.width(), bitmap.height(), !transparent_);
+  // The pixels of the previous frame are reused when nothing else holds them,
+  // like the images of the paint events, so that frames of the same size do
+  // not allocate.
+  SkPixelRef* pixels = backing_->pixelRef();
+  if (!pixels || !pixels->unique() || backing_->isImmutable() ||
+      backing_->width() != bitmap.width() ||
+      backing_->height() != bitmap.height()) {
+    backing_ = std::make_unique<SkBitmap>();
+    backing_->allocN32Pixels(bitmap.width(), bitmap.height(), !transparent_);
+  }
   bitmap.readPixels(backing_->pixmap());
+  PaintBacking(damage_rect);
+}
+
+void OffScreenRenderWidgetHostView::OnFrameCaptured(
+    const gfx::Rect& damage_rect,
+    const SkBitmap& bitmap) {
+  if (!zero_copy_) {
+    OnPaint(damage_rect, bitmap);
+    return;
+  }
+
+  // The capturer does not reuse the shared memory of a frame while its bitmap
+  // is alive, so the frame can be painted without being copied.
+  backing_ = std::make_unique<SkBitmap>(bitmap);
+  PaintBacking(damage_rect);
+}
+
+void OffScreenRenderWidgetHostView::OnMemoryPressure(
+    base::MemoryPressureListener::MemoryPressureLevel level) {
+  // The parent composites the backing of its popup into its own frames.
+  if (IsPainting() || IsPopupWidget() || paint_callback_running_)
+    return;
+  backing_ = std::make_unique<SkBitmap>();
+}
 
+void OffScreenRenderWidgetHostView::PaintBacking(const gfx::Rect& damage_rect) {
   if (IsPopupWidget() && parent_callback_) {
     parent_callback_.Run(this->popup_position_);
   } else {
@@ -808,10 +936,12 @@ void OffScreenRenderWidgetHostView::CompositeFrame(
     }
   }
 
+  base::TimeTicks paint_start = base::TimeTicks::Now();
   paint_callback_running_ = true;
   callback_.Run(gfx::IntersectRects(gfx::Rect(size_in_pixels), damage_rect),
                 frame);
   paint_callback_running_ = false;
+  OnFramePainted(base::TimeTicks::Now() - paint_start);
 
   ReleaseResize();
 }
@@ -1014,10 +1144,12 @@ void OffScreenRenderWidgetHostView::SetFrameRate(int frame_rate) {
     frame_rate_ = frame_rate;
   }
 
+  paced_frame_rate_ = GetMaxFrameRate();
+  frames_within_budget_ = 0;
   SetupFrameRate(true);
 
   if (video_consumer_) {
-    video_consumer_->SetFrameRate(GetFrameRate());
+    video_consumer_->SetFrameRate(GetPacedFrameRate());
   }
 
   for (auto* guest_host_view : guest_host_views_)
@@ -1028,6 +1160,75 @@ int OffScreenRenderWidgetHostView::GetFrameRate() const {
   return frame_rate_;
 }
 
+int OffScreenRenderWidgetHostView::GetPacedFrameRate() const {
+  return paced_frame_rate_;
+}
+
+void OffScreenRenderWidgetHostView::OnFrameDropped() {
+  frames_within_budget_ = 0;
+  SetPacedFrameRate(paced_frame_rate_ * 3 / 4);
+}
+
+int OffScreenRenderWidgetHostView::GetDroppedFrames() const {
+  return video_consumer_ ? video_consumer_->dropped_frames() : 0;
+}
+
+int OffScreenRenderWidgetHostView::GetFramesInFlight() const {
+  return video_consumer_ ? video_consumer_->frames_in_flight() : 0;
+}
+
+void OffScreenRenderWidgetHostView::SetPacedFrameRate(int frame_rate) {
+  frame_rate = std::max(1, std::min(frame_rate, GetMaxFrameRate()));
+  if (frame_rate == paced_frame_rate_)
+    return;
+
+  paced_frame_rate_ = frame_rate;
+  SetupFrameRate(true);
+
+  if (video_consumer_)
+    video_consumer_->SetFrameRate(GetPacedFrameRate());
+}
+
+void OffScreenRenderWidgetHostView::OnFramePainted(base::TimeDelta elapsed) {
+  const base::TimeDelta second = base::TimeDelta::FromSeconds(1);
+
+  // A frame that took longer than its budget lowers the rate to the one the
+  // paint handlers keep up with.
+  if (elapsed > second / paced_frame_rate_) {
+    frames_within_budget_ = 0;
+    int frame_rate = static_cast<int>(second / elapsed);
+    SetPacedFrameRate(std::min(frame_rate, paced_frame_rate_ - 1));
+    return;
+  }
+
+  // The rate is raised in steps, once the frames fit the budget of the next
+  // step for a while.
+  int max_frame_rate = GetMaxFrameRate();
+  if (paced_frame_rate_ >= max_frame_rate)
+    return;
+  int next_frame_rate = paced_frame_rate_ + std::max(1, paced_frame_rate_ / 4);
+  if (elapsed > second / std::min(next_frame_rate, max_frame_rate)) {
+    frames_within_budget_ = 0;
+    return;
+  }
+  if (++frames_within_budget_ >= kFramesToRaiseFrameRate) {
+    frames_within_budget_ = 0;
+    SetPacedFrameRate(next_frame_rate);
+  }
+}
+
+int OffScreenRenderWidgetHostView::GetMaxFrameRate() const {
+  return PowerPolicy::Get()->LimitFrameRate(frame_rate_);
+}
+
+void OffScreenRenderWidgetHostView::OnBatterySaverChanged(bool saving) {
+  // The rate is lowered at once, and raised again in steps when the paint
+  // handlers keep up.
+  frames_within_budget_ = 0;
+  if (saving)
+    SetPacedFrameRate(paced_frame_rate_);
+}
+
 ui::Compositor* OffScreenRenderWidgetHostView::GetCompositor() const {
   return compositor_.get();
 }
@@ -1050,7 +1251,7 @@ void OffScreenRenderWidgetHostView::SetupFrameRate(bool force) {
   if (!force && frame_rate_threshold_us_ != 0)
     return;
 
-  frame_rate_threshold_us_ = 1000000 / frame_rate_;
+  frame_rate_threshold_us_ = 1000000 / paced_frame_rate_;
 
   if (begin_frame_timer_.get()) {
     begin_frame_timer_->SetFrameRateThresholdUs(frame_rate_threshold_us_);
@@ -14,6 +14,7 @@
 #include <windows.h>
 #endif
 
+#include "base/memory/memory_pressure_listener.h"
 #include "base/process/kill.h"
 #include "base/threading/thread.h"
 #include "base/time/time.h"
@@ -30,6 +31,7 @@
 #include "shell/browser/osr/osr_host_display_client.h"
 #include "shell/browser/osr/osr_video_consumer.h"
 #include "shell/browser/osr/osr_view_proxy.h"
+#include "shell/browser/power_policy.h"
 #include "third_party/blink/public/platform/web_vector.h"
 #include "third_party/skia/include/core/SkBitmap.h"
 #include "ui/base/ime/text_input_client.h"
@@ -60,9 +62,11 @@ typedef base::Callback<void(const gfx::Rect&)> OnPopupPaintCallback;
 
 class OffScreenRenderWidgetHostView : public content::RenderWidgetHostViewBase,
                                       public ui::CompositorDelegate,
-                                      public OffscreenViewProxyObserver {
+                                      public OffscreenViewProxyObserver,
+                                      public PowerPolicy::Observer {
  public:
   OffScreenRenderWidgetHostView(bool transparent,
+                                bool zero_copy,
                                 bool painting,
                                 int frame_rate,
                                 const OnPaintCallback& callback,
@@ -177,7 +181,11 @@ class OffScreenRenderWidgetHostView : public content::RenderWidgetHostViewBase,
   void RemoveViewProxy(OffscreenViewProxy* proxy);
   void ProxyViewDestroyed(OffscreenViewProxy* proxy) override;
 
+  // PowerPolicy::Observer:
+  void OnBatterySaverChanged(bool saving) override;
+
   void OnPaint(const gfx::Rect& damage_rect, const SkBitmap& bitmap);
+  void OnFrameCaptured(const gfx::Rect& damage_rect, const SkBitmap& bitmap);
   void OnPopupPaint(const gfx::Rect& damage_rect);
   void OnProxyViewPaint(const gfx::Rect& damage_rect) override;
 
@@ -204,6 +212,14 @@ class OffScreenRenderWidgetHostView : public content::RenderWidgetHostViewBase,
   void SetFrameRate(int frame_rate);
   int GetFrameRate() const;
 
+  // The rate frames are produced at, which is lowered below the frame rate
+  // while the paint handlers can not keep up with it.
+  int GetPacedFrameRate() const;
+  // Called by the video consumer when it drops a frame.
+  void OnFrameDropped();
+  int GetDroppedFrames() const;
+  int GetFramesInFlight() const;
+
   ui::Compositor* GetCompositor() const;
   ui::Layer* GetRootLayer() const;
 
@@ -227,7 +243,16 @@ class OffScreenRenderWidgetHostView : public content::RenderWidgetHostViewBase,
   }
 
  private:
+  // Paints the frame after |backing_| has changed.
+  void PaintBacking(const gfx::Rect& damage_rect);
+
   void SetupFrameRate(bool force);
+  void SetPacedFrameRate(int frame_rate);
+  // The highest rate the frames are paced at, lower than the requested one
+  // while saving battery.
+  int GetMaxFrameRate() const;
+  // Adapts the paced frame rate to the time the paint handlers took.
+  void OnFramePainted(base::TimeDelta elapsed);
   void ResizeRootLayer(bool force);
 
   viz::FrameSinkId AllocateFrameSinkId(bool is_guest_view_hack);
@@ -236,6 +261,11 @@ class OffScreenRenderWidgetHostView : public content::RenderWidgetHostViewBase,
   // opaqueness changes.
   void UpdateBackgroundColorFromRenderer(SkColor color);
 
+  // Releases the pixels of the last frame while painting is stopped, they are
+  // allocated again with the next frame.
+  void OnMemoryPressure(
+      base::MemoryPressureListener::MemoryPressureLevel level);
+
   // Weak ptrs.
   content::RenderWidgetHostImpl* render_widget_host_;
 
@@ -246,12 +276,18 @@ class OffScreenRenderWidgetHostView : public content::RenderWidgetHostViewBase,
   std::set<OffscreenViewProxy*> proxy_views_;
 
   const bool transparent_;
+  const bool zero_copy_;
   OnPaintCallback callback_;
   OnPopupPaintCallback parent_callback_;
 
   int frame_rate_ = 0;
   int frame_rate_threshold_us_ = 0;
 
+  int paced_frame_rate_ = 0;
+  // The number of frames in a row that were painted within the budget of a
+  // higher paced frame rate.
+  int frames_within_budget_ = 0;
+
   base::Time last_time_ = base::Time::Now();
 
   gfx::Vector2dF last_scroll_offset_;
@@ -303,6 +339,8 @@ class OffScreenRenderWidgetHostView : public content::RenderWidgetHostViewBase,
 
   std::unique_ptr<SkBitmap> backing_;
 
+  base::MemoryPressureListener memory_pressure_listener_;
+
   base::WeakPtrFactory<OffScreenRenderWidgetHostView> weak_ptr_factory_;
 
   DISALLOW_COPY_AND_ASSIGN(OffScreenRenderWidgetHostView);
@@ -13,6 +13,14 @@
 
 namespace electron {
 
+namespace {
+
+// Frames are dropped once this many are held by the paint handlers, which
+// leaves the capturer buffers for the frames it is producing.
+constexpr int kMaxFramesInFlight = 6;
+
+}  // namespace
+
 OffScreenVideoConsumer::OffScreenVideoConsumer(
     OffScreenRenderWidgetHostView* view,
     OnPaintCallback callback)
@@ -26,7 +34,7 @@ OffScreenVideoConsumer::OffScreenVideoConsumer(
   video_capturer_->SetMinSizeChangePeriod(base::TimeDelta());
   video_capturer_->SetFormat(media::PIXEL_FORMAT_ARGB,
                              gfx::ColorSpace::CreateREC709());
-  SetFrameRate(view_->GetFrameRate());
+  SetFrameRate(view_->GetPacedFrameRate());
 }
 
 OffScreenVideoConsumer::~OffScreenVideoConsumer() = default;
@@ -77,6 +85,27 @@ void OffScreenVideoConsumer::OnFrameCaptured(
     return;
   }
 
+  media::VideoFrameMetadata metadata;
+  metadata.MergeInternalValuesFrom(info->metadata);
+  gfx::Rect damage_rect;
+
+  auto UPDATE_RECT = media::VideoFrameMetadata::CAPTURE_UPDATE_RECT;
+  if (!metadata.GetRect(UPDATE_RECT, &damage_rect)) {
+    damage_rect = content_rect;
+  }
+
+  // When the paint handlers hold on to too many frames, the frame is dropped
+  // and its damage is coalesced into the next frame that is painted.
+  if (frames_in_flight_ >= kMaxFramesInFlight) {
+    ++dropped_frames_;
+    dropped_damage_.Union(damage_rect);
+    callbacks->Done();
+    view_->OnFrameDropped();
+    return;
+  }
+  damage_rect.Union(dropped_damage_);
+  dropped_damage_ = gfx::Rect();
+
   // The SkBitmap's pixels will be marked as immutable, but the installPixels()
   // API requires a non-const pointer. So, cast away the const.
   void* const pixels = const_cast<void*>(mapping.memory());
@@ -90,6 +119,8 @@ void OffScreenVideoConsumer::OnFrameCaptured(
     // Prevents FrameSinkVideoCapturer from recycling the shared memory that
     // backs |frame_|.
     viz::mojom::FrameSinkVideoConsumerFrameCallbacksPtr releaser;
+    // Counts the frame as held until it is released.
+    base::WeakPtr<OffScreenVideoConsumer> consumer;
   };
 
   SkBitmap bitmap;
@@ -100,25 +131,26 @@ void OffScreenVideoConsumer::OnFrameCaptured(
       media::VideoFrame::RowBytes(media::VideoFrame::kARGBPlane,
                                   info->pixel_format, info->coded_size.width()),
       [](void* addr, void* context) {
-        delete static_cast<FramePinner*>(context);
+        auto* pinner = static_cast<FramePinner*>(context);
+        if (pinner->consumer)
+          pinner->consumer->OnFrameReleased();
+        delete pinner;
       },
-      new FramePinner{std::move(mapping), std::move(callbacks)});
+      new FramePinner{std::move(mapping), std::move(callbacks),
+                      weak_ptr_factory_.GetWeakPtr()});
   bitmap.setImmutable();
-
-  media::VideoFrameMetadata metadata;
-  metadata.MergeInternalValuesFrom(info->metadata);
-  gfx::Rect damage_rect;
-
-  auto UPDATE_RECT = media::VideoFrameMetadata::CAPTURE_UPDATE_RECT;
-  if (!metadata.GetRect(UPDATE_RECT, &damage_rect)) {
-    damage_rect = content_rect;
-  }
+  ++frames_in_flight_;
 
   callback_.Run(damage_rect, bitmap);
 }
 
 void OffScreenVideoConsumer::OnStopped() {}
 
+void OffScreenVideoConsumer::OnFrameReleased() {
+  DCHECK_GT(frames_in_flight_, 0);
+  --frames_in_flight_;
+}
+
 bool OffScreenVideoConsumer::CheckContentRect(const gfx::Rect& content_rect) {
   gfx::Size view_size = view_->SizeInPixels();
   gfx::Size content_size = content_rect.size();
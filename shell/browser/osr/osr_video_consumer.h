@@ -28,6 +28,11 @@ class OffScreenVideoConsumer : public viz::mojom::FrameSinkVideoConsumer {
   void SetFrameRate(int frame_rate);
   void SizeChanged();
 
+  // The number of frames that were painted and are still held.
+  int frames_in_flight() const { return frames_in_flight_; }
+  // The number of frames that were dropped because too many were held.
+  int dropped_frames() const { return dropped_frames_; }
+
  private:
   // viz::mojom::FrameSinkVideoConsumer implementation.
   void OnFrameCaptured(
@@ -38,9 +43,15 @@ class OffScreenVideoConsumer : public viz::mojom::FrameSinkVideoConsumer {
   void OnStopped() override;
 
   bool CheckContentRect(const gfx::Rect& content_rect);
+  void OnFrameReleased();
 
   OnPaintCallback callback_;
 
+  int frames_in_flight_ = 0;
+  int dropped_frames_ = 0;
+  // The damage of the dropped frames, which is added to the next frame.
+  gfx::Rect dropped_damage_;
+
   OffScreenRenderWidgetHostView* view_;
   std::unique_ptr<viz::ClientFrameSinkVideoCapturer> video_capturer_;
 
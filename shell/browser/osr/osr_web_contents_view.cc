@@ -13,8 +13,12 @@ namespace electron {
 
 OffScreenWebContentsView::OffScreenWebContentsView(
     bool transparent,
+    bool zero_copy,
     const OnPaintCallback& callback)
-    : native_window_(nullptr), transparent_(transparent), callback_(callback) {
+    : native_window_(nullptr),
+      transparent_(transparent),
+      zero_copy_(zero_copy),
+      callback_(callback) {
 #if defined(OS_MACOSX)
   PlatformCreate();
 #endif
@@ -120,8 +124,8 @@ OffScreenWebContentsView::CreateViewForWidget(
   }
 
   return new OffScreenRenderWidgetHostView(
-      transparent_, painting_, GetFrameRate(), callback_, render_widget_host,
-      nullptr, GetSize());
+      transparent_, zero_copy_, painting_, GetFrameRate(), callback_,
+      render_widget_host, nullptr, GetSize());
 }
 
 content::RenderWidgetHostViewBase*
@@ -137,9 +141,9 @@ OffScreenWebContentsView::CreateViewForChildWidget(
                     ->GetRenderWidgetHostView()
               : web_contents_impl->GetRenderWidgetHostView());
 
-  return new OffScreenRenderWidgetHostView(transparent_, painting_,
-                                           view->GetFrameRate(), callback_,
-                                           render_widget_host, view, GetSize());
+  return new OffScreenRenderWidgetHostView(
+      transparent_, zero_copy_, painting_, view->GetFrameRate(), callback_,
+      render_widget_host, view, GetSize());
 }
 
 void OffScreenWebContentsView::SetPageTitle(const base::string16& title) {}
@@ -27,7 +27,9 @@ class OffScreenWebContentsView : public content::WebContentsView,
                                  public content::RenderViewHostDelegateView,
                                  public NativeWindowObserver {
  public:
-  OffScreenWebContentsView(bool transparent, const OnPaintCallback& callback);
+  OffScreenWebContentsView(bool transparent,
+                           bool zero_copy,
+                           const OnPaintCallback& callback);
   ~OffScreenWebContentsView() override;
 
   void SetWebContents(content::WebContents*);
@@ -93,6 +95,7 @@ class OffScreenWebContentsView : public content::WebContentsView,
   NativeWindow* native_window_;
 
   const bool transparent_;
+  const bool zero_copy_;
   bool painting_ = true;
   int frame_rate_ = 60;
   OnPaintCallback callback_;
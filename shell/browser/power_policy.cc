@@ -0,0 +1,70 @@
+// Copyright (c) 2020 GitHub, Inc.
+// Use of this source code is governed by the MIT license that can be
+// found in the LICENSE file.
+
+#include "shell/browser/power_policy.h"
+
+#include <algorithm>
+
+#include "base/no_destructor.h"
+#include "base/power_monitor/power_monitor.h"
+
+namespace electron {
+
+namespace {
+
+// While saving battery, frames are produced at a fraction of the rate.
+const int kFrameRateDivisor = 2;
+
+}  // namespace
+
+// static
+PowerPolicy* PowerPolicy::Get() {
+  static base::NoDestructor<PowerPolicy> policy;
+  return policy.get();
+}
+
+PowerPolicy::PowerPolicy() {
+  if (base::PowerMonitor::IsInitialized()) {
+    base::PowerMonitor::AddObserver(this);
+    on_battery_power_ = base::PowerMonitor::IsOnBatteryPower();
+  }
+}
+
+PowerPolicy::~PowerPolicy() = default;
+
+void PowerPolicy::SetMode(Mode mode) {
+  mode_ = mode;
+  Update();
+}
+
+int PowerPolicy::LimitFrameRate(int frame_rate) const {
+  if (!saving_)
+    return frame_rate;
+  return std::max(frame_rate / kFrameRateDivisor, 1);
+}
+
+void PowerPolicy::AddObserver(Observer* observer) {
+  observers_.AddObserver(observer);
+}
+
+void PowerPolicy::RemoveObserver(Observer* observer) {
+  observers_.RemoveObserver(observer);
+}
+
+void PowerPolicy::OnPowerStateChange(bool on_battery_power) {
+  on_battery_power_ = on_battery_power;
+  Update();
+}
+
+void PowerPolicy::Update() {
+  bool saving = mode_ == Mode::kAlways ||
+                (mode_ == Mode::kOnBattery && on_battery_power_);
+  if (saving == saving_)
+    return;
+  saving_ = saving;
+  for (Observer& observer : observers_)
+    observer.OnBatterySaverChanged(saving_);
+}
+
+}  // namespace electron
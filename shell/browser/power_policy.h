@@ -0,0 +1,67 @@
+// Copyright (c) 2020 GitHub, Inc.
+// Use of this source code is governed by the MIT license that can be
+// found in the LICENSE file.
+
+#ifndef SHELL_BROWSER_POWER_POLICY_H_
+#define SHELL_BROWSER_POWER_POLICY_H_
+
+#include "base/macros.h"
+#include "base/observer_list.h"
+#include "base/observer_list_types.h"
+#include "base/power_monitor/power_observer.h"
+
+namespace electron {
+
+// Decides whether the app saves battery, which the subsystems doing work
+// nobody waits for consult to do less of it, like rendering offscreen or
+// capturing frames at a lower rate. The background tasks of JavaScript are
+// delayed through powerMonitor.isBatterySaverActive().
+class PowerPolicy : public base::PowerObserver {
+ public:
+  enum class Mode {
+    kOff,
+    // Saves battery while the system runs on it.
+    kOnBattery,
+    kAlways,
+  };
+
+  class Observer : public base::CheckedObserver {
+   public:
+    virtual void OnBatterySaverChanged(bool saving) = 0;
+  };
+
+  // Only used on the UI thread, after the power monitor was initialized.
+  static PowerPolicy* Get();
+
+  void SetMode(Mode mode);
+  Mode mode() const { return mode_; }
+
+  bool IsSaving() const { return saving_; }
+
+  // Returns the frame rate to render or capture at instead of |frame_rate|.
+  int LimitFrameRate(int frame_rate) const;
+
+  void AddObserver(Observer* observer);
+  void RemoveObserver(Observer* observer);
+
+ private:
+  PowerPolicy();
+  ~PowerPolicy() override;
+
+  // base::PowerObserver:
+  void OnPowerStateChange(bool on_battery_power) override;
+
+  void Update();
+
+  Mode mode_ = Mode::kOff;
+  bool on_battery_power_ = false;
+  bool saving_ = false;
+
+  base::ObserverList<Observer> observers_;
+
+  DISALLOW_COPY_AND_ASSIGN(PowerPolicy);
+};
+
+}  // namespace electron
+
+#endif  // SHELL_BROWSER_POWER_POLICY_H_
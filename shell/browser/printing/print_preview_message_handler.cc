@@ -8,6 +8,7 @@
 #include <utility>
 
 #include "base/bind.h"
+#include "base/files/file_util.h"
 #include "base/memory/read_only_shared_memory_region.h"
 #include "base/memory/ref_counted.h"
 #include "base/memory/ref_counted_memory.h"
@@ -48,6 +49,14 @@ void StopWorker(int document_cookie) {
   }
 }
 
+// The mapping of the PDF is written as is, so the document is never copied
+// into the memory of the browser.
+bool WritePdf(const base::FilePath& path,
+              scoped_refptr<base::RefCountedMemory> data_bytes) {
+  int size = static_cast<int>(data_bytes->size());
+  return base::WriteFile(path, data_bytes->front_as<char>(), size) == size;
+}
+
 }  // namespace
 
 PrintPreviewMessageHandler::PrintPreviewMessageHandler(
@@ -145,10 +154,13 @@ void PrintPreviewMessageHandler::OnPrintPreviewCancelled(
 
 void PrintPreviewMessageHandler::PrintToPDF(
     base::DictionaryValue options,
+    const base::FilePath& output_path,
     gin_helper::Promise<v8::Local<v8::Value>> promise) {
   int request_id;
   options.GetInteger(printing::kPreviewRequestID, &request_id);
   promise_map_.emplace(request_id, std::move(promise));
+  if (!output_path.empty())
+    output_path_map_.emplace(request_id, output_path);
 
   auto* focused_frame = web_contents()->GetFocusedFrame();
   auto* rfh = focused_frame && focused_frame->HasSelection()
@@ -171,6 +183,17 @@ PrintPreviewMessageHandler::GetPromise(int request_id) {
   return promise;
 }
 
+base::FilePath PrintPreviewMessageHandler::GetOutputPath(int request_id) {
+  auto it = output_path_map_.find(request_id);
+  if (it == output_path_map_.end())
+    return base::FilePath();
+
+  base::FilePath output_path = std::move(it->second);
+  output_path_map_.erase(it);
+
+  return output_path;
+}
+
 void PrintPreviewMessageHandler::ResolvePromise(
     int request_id,
     scoped_refptr<base::RefCountedMemory> data_bytes) {
@@ -178,6 +201,26 @@ void PrintPreviewMessageHandler::ResolvePromise(
 
   gin_helper::Promise<v8::Local<v8::Value>> promise = GetPromise(request_id);
 
+  base::FilePath output_path = GetOutputPath(request_id);
+  if (!output_path.empty()) {
+    base::PostTaskAndReplyWithResult(
+        FROM_HERE,
+        {base::ThreadPool(), base::MayBlock(),
+         base::TaskPriority::USER_VISIBLE,
+         base::TaskShutdownBehavior::SKIP_ON_SHUTDOWN},
+        base::BindOnce(&WritePdf, output_path, std::move(data_bytes)),
+        base::BindOnce(
+            [](gin_helper::Promise<v8::Local<v8::Value>> promise,
+               bool success) {
+              if (success)
+                promise.Resolve(v8::Undefined(promise.isolate()));
+              else
+                promise.RejectWithErrorMessage("Failed to write PDF");
+            },
+            std::move(promise)));
+    return;
+  }
+
   v8::Isolate* isolate = promise.isolate();
   gin_helper::Locker locker(isolate);
   v8::HandleScope handle_scope(isolate);
@@ -196,6 +239,7 @@ void PrintPreviewMessageHandler::ResolvePromise(
 void PrintPreviewMessageHandler::RejectPromise(int request_id) {
   DCHECK_CURRENTLY_ON(BrowserThread::UI);
 
+  GetOutputPath(request_id);
   gin_helper::Promise<v8::Local<v8::Value>> promise = GetPromise(request_id);
   promise.RejectWithErrorMessage("Failed to generate PDF");
 }
@@ -7,6 +7,7 @@
 
 #include <map>
 
+#include "base/files/file_path.h"
 #include "base/memory/ref_counted_memory.h"
 #include "base/memory/weak_ptr.h"
 #include "components/printing/common/print.mojom.h"
@@ -33,7 +34,10 @@ class PrintPreviewMessageHandler
  public:
   ~PrintPreviewMessageHandler() override;
 
+  // Resolves with the PDF data, or writes it to |output_path| when it is not
+  // empty.
   void PrintToPDF(base::DictionaryValue options,
+                  const base::FilePath& output_path,
                   gin_helper::Promise<v8::Local<v8::Value>> promise);
 
  protected:
@@ -60,6 +64,7 @@ class PrintPreviewMessageHandler
                                const PrintHostMsg_PreviewIds& ids);
 
   gin_helper::Promise<v8::Local<v8::Value>> GetPromise(int request_id);
+  base::FilePath GetOutputPath(int request_id);
 
   void ResolvePromise(int request_id,
                       scoped_refptr<base::RefCountedMemory> data_bytes);
@@ -67,6 +72,7 @@ class PrintPreviewMessageHandler
 
   using PromiseMap = std::map<int, gin_helper::Promise<v8::Local<v8::Value>>>;
   PromiseMap promise_map_;
+  std::map<int, base::FilePath> output_path_map_;
 
   mojo::AssociatedRemote<printing::mojom::PrintRenderFrame> print_render_frame_;
 
@@ -7,8 +7,10 @@
 #include <stdio.h>
 
 #include <string>
+#include <unordered_map>
 #include <vector>
 
+#include "base/no_destructor.h"
 #include "base/stl_util.h"
 #include "base/strings/string_number_conversions.h"
 #include "base/strings/string_split.h"
@@ -17,8 +19,14 @@
 
 namespace accelerator_util {
 
-bool StringToAccelerator(const std::string& shortcut,
-                         ui::Accelerator* accelerator) {
+namespace {
+
+// More accelerators than menus have are not expected, the cache starts over
+// when it is full.
+const size_t kMaxParsedAccelerators = 4096;
+
+bool ParseAccelerator(const std::string& shortcut,
+                      ui::Accelerator* accelerator) {
   if (!base::IsStringASCII(shortcut)) {
     LOG(ERROR) << "The accelerator string can only contain ASCII characters";
     return false;
@@ -67,6 +75,35 @@ bool StringToAccelerator(const std::string& shortcut,
   return true;
 }
 
+}  // namespace
+
+size_t AcceleratorHash::operator()(const ui::Accelerator& accelerator) const {
+  size_t modifiers =
+      ui::Accelerator::MaskOutKeyEventFlags(accelerator.modifiers());
+  return (static_cast<size_t>(accelerator.key_code()) << 24) ^
+         (static_cast<size_t>(accelerator.key_state()) << 23) ^ modifiers;
+}
+
+bool StringToAccelerator(const std::string& shortcut,
+                         ui::Accelerator* accelerator) {
+  // Menus are built again with the same accelerators, and only the UI thread
+  // parses them.
+  static base::NoDestructor<std::unordered_map<std::string, ui::Accelerator>>
+      parsed;
+  auto it = parsed->find(shortcut);
+  if (it != parsed->end()) {
+    *accelerator = it->second;
+    return true;
+  }
+
+  if (!ParseAccelerator(shortcut, accelerator))
+    return false;
+  if (parsed->size() >= kMaxParsedAccelerators)
+    parsed->clear();
+  parsed->emplace(shortcut, *accelerator);
+  return true;
+}
+
 void GenerateAcceleratorTable(AcceleratorTable* table,
                               electron::AtomMenuModel* model) {
   int count = model->GetItemCount();
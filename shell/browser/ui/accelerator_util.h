@@ -5,8 +5,8 @@
 #ifndef SHELL_BROWSER_UI_ACCELERATOR_UTIL_H_
 #define SHELL_BROWSER_UI_ACCELERATOR_UTIL_H_
 
-#include <map>
 #include <string>
+#include <unordered_map>
 
 #include "shell/browser/ui/atom_menu_model.h"
 #include "ui/base/accelerators/accelerator.h"
@@ -17,9 +17,16 @@ typedef struct {
   int position;
   electron::AtomMenuModel* model;
 } MenuItem;
-typedef std::map<ui::Accelerator, MenuItem> AcceleratorTable;
 
-// Parse a string as an accelerator.
+// Hashes the accelerators by what they are compared with.
+struct AcceleratorHash {
+  size_t operator()(const ui::Accelerator& accelerator) const;
+};
+
+typedef std::unordered_map<ui::Accelerator, MenuItem, AcceleratorHash>
+    AcceleratorTable;
+
+// Parse a string as an accelerator. The strings are only parsed once.
 bool StringToAccelerator(const std::string& description,
                          ui::Accelerator* accelerator);
 
@@ -26,4 +26,28 @@ TEST(AcceleratorUtilTest, StringToAccelerator) {
   }
 }
 
+TEST(AcceleratorUtilTest, StringToAcceleratorParsedTwice) {
+  ui::Accelerator first, second;
+  ASSERT_TRUE(StringToAccelerator("Ctrl+Shift+K", &first));
+  ASSERT_TRUE(StringToAccelerator("Ctrl+Shift+K", &second));
+  EXPECT_EQ(first, second);
+  EXPECT_EQ(ui::VKEY_K, second.key_code());
+  EXPECT_EQ(ui::EF_CONTROL_DOWN | ui::EF_SHIFT_DOWN, second.modifiers());
+
+  // Strings which fail to parse keep failing.
+  EXPECT_FALSE(StringToAccelerator("CmdOrCtrl", &first));
+  EXPECT_FALSE(StringToAccelerator("CmdOrCtrl", &first));
+}
+
+TEST(AcceleratorUtilTest, AcceleratorHash) {
+  AcceleratorHash hash;
+  ui::Accelerator accelerator(ui::VKEY_K, ui::EF_CONTROL_DOWN);
+  EXPECT_EQ(hash(accelerator),
+            hash(ui::Accelerator(ui::VKEY_K, ui::EF_CONTROL_DOWN)));
+  // The key event flags are not compared, so they are not hashed either.
+  EXPECT_EQ(hash(accelerator),
+            hash(ui::Accelerator(ui::VKEY_K,
+                                 ui::EF_CONTROL_DOWN | ui::EF_IS_REPEAT)));
+}
+
 }  // namespace accelerator_util
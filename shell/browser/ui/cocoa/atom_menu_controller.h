@@ -43,6 +43,11 @@ class AtomMenuModel;
 // Populate current NSMenu with |model|.
 - (void)populateWithModel:(electron::AtomMenuModel*)model;
 
+// Updates the items of the constructed menu in place from its model. Returns
+// NO when items were added, removed or changed type since it was populated,
+// and the menu must be populated again.
+- (BOOL)updateFromModel;
+
 // Programmatically close the constructed menu.
 - (void)cancel;
 
@@ -320,6 +320,61 @@ static base::scoped_nsobject<NSMenu> recentDocumentsMenuSwap_;
   [menu insertItem:item atIndex:index];
 }
 
+- (BOOL)updateMenu:(NSMenu*)menu withModel:(electron::AtomMenuModel*)model {
+  const int count = model->GetItemCount();
+  if ([menu numberOfItems] != count)
+    return NO;
+
+  for (int index = 0; index < count; index++) {
+    NSMenuItem* item = [menu itemAtIndex:index];
+    electron::AtomMenuModel::ItemType type = model->GetTypeAt(index);
+    bool is_separator = type == electron::AtomMenuModel::TYPE_SEPARATOR;
+    if (is_separator != [item isSeparatorItem])
+      return NO;
+    if (is_separator)
+      continue;
+
+    base::string16 role = model->GetRoleAt(index);
+    // The system fills the services menu.
+    if (role == base::ASCIIToUTF16("services"))
+      continue;
+
+    // Only the visible submenus were built.
+    bool has_submenu = type == electron::AtomMenuModel::TYPE_SUBMENU &&
+                       model->IsVisibleAt(index);
+    if (has_submenu != ([item submenu] != nil))
+      return NO;
+
+    NSString* label =
+        l10n_util::FixUpWindowsStyleLabel(model->GetLabelAt(index));
+    [item setTitle:label];
+    [item setToolTip:base::SysUTF16ToNSString(model->GetToolTipAt(index))];
+
+    if (has_submenu) {
+      // The recent documents menu is shared, and the empty submenus hold an
+      // item which is not in the model.
+      electron::AtomMenuModel* submenuModel = model->GetSubmenuModelAt(index);
+      if (role == base::ASCIIToUTF16("recentdocuments") ||
+          !MenuHasVisibleItems(submenuModel))
+        return NO;
+      [item setEnabled:model->IsEnabledAt(index)];
+      [[item submenu] setTitle:label];
+      if (![self updateMenu:[item submenu] withModel:submenuModel])
+        return NO;
+    } else {
+      [item setState:(model->IsItemCheckedAt(index) ? NSOnState : NSOffState)];
+      [item setHidden:!model->IsVisibleAt(index)];
+    }
+  }
+  return YES;
+}
+
+- (BOOL)updateFromModel {
+  if (!menu_ || !model_)
+    return NO;
+  return [self updateMenu:menu_ withModel:model_];
+}
+
 // Called before the menu is to be displayed to update the state (enabled,
 // radio, etc) of each item in the menu.
 - (BOOL)validateUserInterfaceItem:(id<NSValidatedUserInterfaceItem>)item {
@@ -47,7 +47,11 @@ using TitleBarStyle = electron::NativeWindowMac::TitleBarStyle;
   NSWindow* window = notification.object;
 
   // check occlusion binary flag
-  if (window.occlusionState & NSWindowOcclusionStateVisible) {
+  bool visible = window.occlusionState & NSWindowOcclusionStateVisible;
+  // Distinguishes a window covered by other windows from a hidden one.
+  shell_->NotifyWindowOcclusionChanged(!visible && [window isVisible] &&
+                                       ![window isMiniaturized]);
+  if (visible) {
     // The app is visible
     shell_->NotifyWindowShow();
   } else {
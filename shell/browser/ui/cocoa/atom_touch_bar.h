@@ -8,12 +8,25 @@
 #import <Cocoa/Cocoa.h>
 
 #include <map>
+#include <set>
 #include <string>
 #include <vector>
 
 #include "base/mac/scoped_nsobject.h"
 #include "shell/browser/native_window.h"
 #include "shell/common/gin_helper/persistent_dictionary.h"
+#include "ui/gfx/image/image.h"
+
+namespace electron {
+
+// An item of a scrubber, converted from JavaScript once per update.
+struct TouchBarScrubberItem {
+  bool has_label = false;
+  std::string label;
+  gfx::Image icon;
+};
+
+}  // namespace electron
 
 @interface AtomTouchBar : NSObject <NSScrubberDelegate,
                                     NSScrubberDataSource,
@@ -21,6 +34,9 @@
  @protected
   std::vector<gin_helper::PersistentDictionary> ordered_settings_;
   std::map<std::string, gin_helper::PersistentDictionary> settings_;
+  // The items of the scrubbers, by scrubber id.
+  std::map<std::string, std::vector<electron::TouchBarScrubberItem>>
+      scrubber_items_;
   id<NSTouchBarDelegate> delegate_;
   electron::NativeWindow* window_;
 }
@@ -36,6 +52,7 @@
     (const std::vector<gin_helper::PersistentDictionary>&)settings;
 - (void)refreshTouchBarItem:(NSTouchBar*)touchBar
                          id:(const std::string&)item_id
+                 properties:(const std::set<std::string>&)properties
     API_AVAILABLE(macosx(10.12.2));
 - (void)addNonDefaultTouchBarItems:
     (const std::vector<gin_helper::PersistentDictionary>&)items;
@@ -89,6 +106,7 @@
     API_AVAILABLE(macosx(10.12.2));
 - (void)updateSlider:(NSSliderTouchBarItem*)item
         withSettings:(const gin_helper::PersistentDictionary&)settings
+          properties:(const std::set<std::string>&)properties
     API_AVAILABLE(macosx(10.12.2));
 - (void)updatePopover:(NSPopoverTouchBarItem*)item
          withSettings:(const gin_helper::PersistentDictionary&)settings
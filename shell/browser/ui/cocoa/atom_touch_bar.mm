@@ -133,6 +133,7 @@ static NSString* const ImageScrubberItemIdentifier = @"scrubber.image.item";
                          id:(NSTouchBarItemIdentifier)identifier
                    withType:(const std::string&)item_type
                withSettings:(const gin_helper::PersistentDictionary&)settings
+                 properties:(const std::set<std::string>&)properties
     API_AVAILABLE(macosx(10.12.2)) {
   NSTouchBarItem* item = [touchBar itemForIdentifier:identifier];
   if (!item)
@@ -146,14 +147,18 @@ static NSString* const ImageScrubberItemIdentifier = @"scrubber.image.item";
     [self updateColorPicker:(NSColorPickerTouchBarItem*)item
                withSettings:settings];
   } else if (item_type == "slider") {
-    [self updateSlider:(NSSliderTouchBarItem*)item withSettings:settings];
+    [self updateSlider:(NSSliderTouchBarItem*)item
+          withSettings:settings
+            properties:properties];
   } else if (item_type == "popover") {
     [self updatePopover:(NSPopoverTouchBarItem*)item withSettings:settings];
   } else if (item_type == "segmented_control") {
     [self updateSegmentedControl:(NSCustomTouchBarItem*)item
                     withSettings:settings];
   } else if (item_type == "scrubber") {
-    [self updateScrubber:(NSCustomTouchBarItem*)item withSettings:settings];
+    [self updateScrubber:(NSCustomTouchBarItem*)item
+            withSettings:settings
+              properties:properties];
   } else if (item_type == "group") {
     [self updateGroup:(NSGroupTouchBarItem*)item withSettings:settings];
   }
@@ -184,7 +189,8 @@ static NSString* const ImageScrubberItemIdentifier = @"scrubber.image.item";
 }
 
 - (void)refreshTouchBarItem:(NSTouchBar*)touchBar
-                         id:(const std::string&)item_id {
+                         id:(const std::string&)item_id
+                 properties:(const std::set<std::string>&)properties {
   if (![self hasItemWithID:item_id])
     return;
 
@@ -213,21 +219,24 @@ static NSString* const ImageScrubberItemIdentifier = @"scrubber.image.item";
       [self refreshTouchBarItem:popoverItem.popoverTouchBar
                              id:identifier
                        withType:item_type
-                   withSettings:settings];
+                   withSettings:settings
+                     properties:properties];
     } else if (parent_type == "group") {
       NSGroupTouchBarItem* groupItem =
           [touchBar itemForIdentifier:parentIdentifier];
       [self refreshTouchBarItem:groupItem.groupTouchBar
                              id:identifier
                        withType:item_type
-                   withSettings:settings];
+                   withSettings:settings
+                     properties:properties];
     }
   }
 
   [self refreshTouchBarItem:touchBar
                          id:identifier
                    withType:item_type
-               withSettings:settings];
+               withSettings:settings
+                 properties:properties];
 }
 
 - (void)buttonAction:(id)sender {
@@ -470,12 +479,22 @@ static NSString* const ImageScrubberItemIdentifier = @"scrubber.image.item";
       [[NSSliderTouchBarItem alloc] initWithIdentifier:identifier]);
   [item setTarget:self];
   [item setAction:@selector(sliderAction:)];
-  [self updateSlider:item withSettings:settings];
+  [self updateSlider:item withSettings:settings properties:{}];
   return item.autorelease();
 }
 
 - (void)updateSlider:(NSSliderTouchBarItem*)item
-        withSettings:(const gin_helper::PersistentDictionary&)settings {
+        withSettings:(const gin_helper::PersistentDictionary&)settings
+          properties:(const std::set<std::string>&)properties {
+  // Only the value changes while a slider is animated, which skips the
+  // conversion of its other settings.
+  if (properties.size() == 1 && properties.count("value")) {
+    int value = 50;
+    settings.Get("value", &value);
+    item.slider.doubleValue = value;
+    return;
+  }
+
   std::string label;
   settings.Get("label", &label);
   item.label = base::SysUTF8ToNSString(label);
@@ -681,16 +700,26 @@ static NSString* const ImageScrubberItemIdentifier = @"scrubber.image.item";
   scrubber.identifier = id;
 
   [item setView:scrubber];
-  [self updateScrubber:item withSettings:settings];
+  [self updateScrubber:item withSettings:settings properties:{}];
 
   return item.autorelease();
 }
 
 - (void)updateScrubber:(NSCustomTouchBarItem*)item
           withSettings:(const gin_helper::PersistentDictionary&)settings
+            properties:(const std::set<std::string>&)properties
     API_AVAILABLE(macosx(10.12.2)) {
   NSScrubber* scrubber = item.view;
 
+  if (properties.empty()) {
+    [self setScrubberItems:scrubber withSettings:settings];
+  } else if (properties.count("items")) {
+    [self updateScrubberItems:scrubber withSettings:settings];
+    // The items are reloaded on their own when only they changed.
+    if (properties.size() == 1)
+      return;
+  }
+
   bool showsArrowButtons = false;
   settings.Get("showArrowButtons", &showsArrowButtons);
   scrubber.showsArrowButtons = showsArrowButtons;
@@ -735,50 +764,94 @@ static NSString* const ImageScrubberItemIdentifier = @"scrubber.image.item";
   [scrubber reloadData];
 }
 
-- (NSInteger)numberOfItemsForScrubber:(NSScrubber*)scrubber
+- (void)setScrubberItems:(NSScrubber*)scrubber
+            withSettings:(const gin_helper::PersistentDictionary&)settings
     API_AVAILABLE(macosx(10.12.2)) {
-  std::string s_id([[scrubber identifier] UTF8String]);
-  if (![self hasItemWithID:s_id])
-    return 0;
-
-  gin_helper::PersistentDictionary settings = settings_[s_id];
+  std::vector<electron::TouchBarScrubberItem> scrubber_items;
   std::vector<gin_helper::PersistentDictionary> items;
   settings.Get("items", &items);
-  return items.size();
+  scrubber_items.reserve(items.size());
+  for (const auto& item : items) {
+    electron::TouchBarScrubberItem scrubber_item;
+    scrubber_item.has_label = item.Get("label", &scrubber_item.label);
+    if (!scrubber_item.has_label)
+      item.Get("icon", &scrubber_item.icon);
+    scrubber_items.push_back(std::move(scrubber_item));
+  }
+  scrubber_items_[[[scrubber identifier] UTF8String]] =
+      std::move(scrubber_items);
 }
 
-- (NSScrubberItemView*)scrubber:(NSScrubber*)scrubber
-             viewForItemAtIndex:(NSInteger)index
+- (void)updateScrubberItems:(NSScrubber*)scrubber
+               withSettings:(const gin_helper::PersistentDictionary&)settings
     API_AVAILABLE(macosx(10.12.2)) {
   std::string s_id([[scrubber identifier] UTF8String]);
-  if (![self hasItemWithID:s_id])
-    return nil;
+  std::vector<electron::TouchBarScrubberItem> old_items =
+      std::move(scrubber_items_[s_id]);
+  [self setScrubberItems:scrubber withSettings:settings];
+  const auto& new_items = scrubber_items_[s_id];
 
-  gin_helper::PersistentDictionary settings = settings_[s_id];
-  std::vector<gin_helper::PersistentDictionary> items;
-  if (!settings.Get("items", &items))
-    return nil;
+  if (old_items.size() != new_items.size()) {
+    [scrubber reloadData];
+    return;
+  }
 
-  if (index >= static_cast<NSInteger>(items.size()))
-    return nil;
+  // Only the items which changed are laid out and drawn again. The icons are
+  // compared by their NSImage, which the images converted from the same
+  // NativeImage share.
+  NSMutableIndexSet* changed = [NSMutableIndexSet indexSet];
+  for (size_t i = 0; i < new_items.size(); ++i) {
+    const auto& old_item = old_items[i];
+    const auto& new_item = new_items[i];
+    if (old_item.has_label != new_item.has_label ||
+        old_item.label != new_item.label ||
+        old_item.icon.IsEmpty() != new_item.icon.IsEmpty() ||
+        (!new_item.icon.IsEmpty() &&
+         old_item.icon.AsNSImage() != new_item.icon.AsNSImage()))
+      [changed addIndex:i];
+  }
+  if ([changed count])
+    [scrubber reloadItemsAtIndexes:changed];
+}
 
-  gin_helper::PersistentDictionary item = items[index];
+- (const electron::TouchBarScrubberItem*)scrubberItem:(NSScrubber*)scrubber
+                                              atIndex:(NSInteger)index {
+  auto it = scrubber_items_.find([[scrubber identifier] UTF8String]);
+  if (it == scrubber_items_.end() || index < 0 ||
+      index >= static_cast<NSInteger>(it->second.size()))
+    return nullptr;
+  return &it->second[index];
+}
+
+- (NSInteger)numberOfItemsForScrubber:(NSScrubber*)scrubber
+    API_AVAILABLE(macosx(10.12.2)) {
+  auto it = scrubber_items_.find([[scrubber identifier] UTF8String]);
+  if (it == scrubber_items_.end())
+    return 0;
+  return it->second.size();
+}
+
+- (NSScrubberItemView*)scrubber:(NSScrubber*)scrubber
+             viewForItemAtIndex:(NSInteger)index
+    API_AVAILABLE(macosx(10.12.2)) {
+  const electron::TouchBarScrubberItem* item = [self scrubberItem:scrubber
+                                                          atIndex:index];
+  if (!item)
+    return nil;
 
   NSScrubberItemView* itemView;
-  std::string title;
 
-  if (item.Get("label", &title)) {
+  if (item->has_label) {
     NSScrubberTextItemView* view =
         [scrubber makeItemWithIdentifier:TextScrubberItemIdentifier owner:self];
-    view.title = base::SysUTF8ToNSString(title);
+    view.title = base::SysUTF8ToNSString(item->label);
     itemView = view;
   } else {
     NSScrubberImageItemView* view =
         [scrubber makeItemWithIdentifier:ImageScrubberItemIdentifier
                                    owner:self];
-    gfx::Image image;
-    if (item.Get("icon", &image)) {
-      view.image = image.AsNSImage();
+    if (!item->icon.IsEmpty()) {
+      view.image = item->icon.AsNSImage();
     }
     itemView = view;
   }
@@ -794,24 +867,14 @@ static NSString* const ImageScrubberItemIdentifier = @"scrubber.image.item";
   NSInteger margin = 15;
   NSSize defaultSize = NSMakeSize(width, height);
 
-  std::string s_id([[scrubber identifier] UTF8String]);
-  if (![self hasItemWithID:s_id])
-    return defaultSize;
-
-  gin_helper::PersistentDictionary settings = settings_[s_id];
-  std::vector<gin_helper::PersistentDictionary> items;
-  if (!settings.Get("items", &items))
-    return defaultSize;
-
-  if (itemIndex >= static_cast<NSInteger>(items.size()))
+  const electron::TouchBarScrubberItem* item = [self scrubberItem:scrubber
+                                                          atIndex:itemIndex];
+  if (!item)
     return defaultSize;
 
-  gin_helper::PersistentDictionary item = items[itemIndex];
-  std::string title;
-
-  if (item.Get("label", &title)) {
+  if (item->has_label) {
     NSSize size = NSMakeSize(CGFLOAT_MAX, CGFLOAT_MAX);
-    NSRect textRect = [base::SysUTF8ToNSString(title)
+    NSRect textRect = [base::SysUTF8ToNSString(item->label)
         boundingRectWithSize:size
                      options:NSStringDrawingUsesLineFragmentOrigin |
                              NSStringDrawingUsesFontLeading
@@ -820,11 +883,8 @@ static NSString* const ImageScrubberItemIdentifier = @"scrubber.image.item";
                   }];
 
     width = textRect.size.width + margin;
-  } else {
-    gfx::Image image;
-    if (item.Get("icon", &image)) {
-      width = image.AsNSImage().size.width;
-    }
+  } else if (!item->icon.IsEmpty()) {
+    width = item->icon.AsNSImage().size.width;
   }
 
   return NSMakeSize(width, height);
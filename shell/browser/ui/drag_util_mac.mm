@@ -10,6 +10,35 @@
 #include "base/strings/sys_string_conversions.h"
 #include "shell/browser/ui/drag_util.h"
 
+// Promises the paths of the dragged files to the pasteboard, which only asks
+// for them when they are dropped.
+@interface ElectronDragFilesOwner : NSObject {
+ @private
+  std::vector<base::FilePath> files_;
+}
+- (instancetype)initWithFiles:(const std::vector<base::FilePath>&)files;
+@end
+
+@implementation ElectronDragFilesOwner
+
+- (instancetype)initWithFiles:(const std::vector<base::FilePath>&)files {
+  if ((self = [super init]))
+    files_ = files;
+  return self;
+}
+
+- (void)pasteboard:(NSPasteboard*)pasteboard
+    provideDataForType:(NSString*)type {
+  if (![type isEqualToString:NSFilenamesPboardType])
+    return;
+  NSMutableArray* fileList = [NSMutableArray arrayWithCapacity:files_.size()];
+  for (const base::FilePath& file : files_)
+    [fileList addObject:base::SysUTF8ToNSString(file.value())];
+  [pasteboard setPropertyList:fileList forType:NSFilenamesPboardType];
+}
+
+@end
+
 namespace electron {
 
 namespace {
@@ -17,12 +46,13 @@ namespace {
 // Write information about the file being dragged to the pasteboard.
 void AddFilesToPasteboard(NSPasteboard* pasteboard,
                           const std::vector<base::FilePath>& files) {
-  NSMutableArray* fileList = [NSMutableArray array];
-  for (const base::FilePath& file : files)
-    [fileList addObject:base::SysUTF8ToNSString(file.value())];
+  // The pasteboard does not retain its owner, which is kept until the next
+  // drag replaces it.
+  static ElectronDragFilesOwner* owner = nil;
+  [owner release];
+  owner = [[ElectronDragFilesOwner alloc] initWithFiles:files];
   [pasteboard declareTypes:[NSArray arrayWithObject:NSFilenamesPboardType]
-                     owner:nil];
-  [pasteboard setPropertyList:fileList forType:NSFilenamesPboardType];
+                     owner:owner];
 }
 
 }  // namespace
@@ -4,6 +4,11 @@
 
 #include "shell/browser/ui/drag_util.h"
 
+#include <memory>
+#include <utility>
+
+#include "base/no_destructor.h"
+#include "base/strings/string16.h"
 #include "ui/aura/client/drag_drop_client.h"
 #include "ui/aura/window.h"
 #include "ui/base/dragdrop/drag_drop_types.h"
@@ -17,15 +22,46 @@
 
 namespace electron {
 
+namespace {
+
+// The drag image of the last drag, which rendering a label for is the slowest
+// part of starting one, and which is usually the same for the next drag.
+struct DragImageCache {
+  gfx::ImageSkia icon;
+  base::string16 title;
+  gfx::ImageSkia image;
+  gfx::Vector2d offset;
+};
+
+void SetDragImage(const gfx::ImageSkia& icon,
+                  const base::string16& title,
+                  gfx::NativeView view,
+                  ui::OSExchangeData* data) {
+  static base::NoDestructor<DragImageCache> cache;
+  if (cache->image.isNull() || !cache->icon.BackedBySameObjectAs(icon) ||
+      cache->title != title) {
+    button_drag_utils::SetDragImage(
+        GURL(), title, icon, nullptr,
+        *views::Widget::GetTopLevelWidgetForNativeView(view), data);
+    cache->icon = icon;
+    cache->title = title;
+    cache->image = data->provider().GetDragImage();
+    cache->offset = data->provider().GetDragImageOffset();
+    return;
+  }
+  data->provider().SetDragImage(cache->image, cache->offset);
+}
+
+}  // namespace
+
 void DragFileItems(const std::vector<base::FilePath>& files,
                    const gfx::Image& icon,
                    gfx::NativeView view) {
   // Set up our OLE machinery
   auto data = std::make_unique<ui::OSExchangeData>();
 
-  button_drag_utils::SetDragImage(
-      GURL(), files[0].LossyDisplayName(), icon.AsImageSkia(), nullptr,
-      *views::Widget::GetTopLevelWidgetForNativeView(view), data.get());
+  SetDragImage(icon.AsImageSkia(), files[0].LossyDisplayName(), view,
+               data.get());
 
   std::vector<ui::FileInfo> file_infos;
   file_infos.reserve(files.size());
@@ -325,6 +325,7 @@ void ShowSaveDialog(const DialogSettings& settings,
                     gin_helper::Promise<gin_helper::Dictionary> promise) {
   FileChooserDialog* save_dialog =
       new FileChooserDialog(GTK_FILE_CHOOSER_ACTION_SAVE, settings);
+  save_dialog->SetupSaveProperties(settings.properties);
   save_dialog->RunSaveAsynchronous(std::move(promise));
 }
 
@@ -11,15 +11,17 @@
 #include <shlobj.h>
 #include <shobjidl.h>
 
+#include <utility>
+#include <vector>
+
 #include "base/files/file_util.h"
 #include "base/i18n/case_conversion.h"
 #include "base/strings/string_split.h"
 #include "base/strings/string_util.h"
 #include "base/strings/utf_string_conversions.h"
-#include "base/threading/thread.h"
-#include "base/threading/thread_task_runner_handle.h"
 #include "base/win/registry.h"
 #include "shell/browser/native_window_views.h"
+#include "shell/browser/ui/win/dialog_thread.h"
 #include "shell/browser/unresponsive_suppressor.h"
 #include "shell/common/gin_converters/file_path_converter.h"
 
@@ -63,63 +65,35 @@ void ConvertFilters(const Filters& filters,
   }
 }
 
-struct RunState {
-  base::Thread* dialog_thread;
-  scoped_refptr<base::SingleThreadTaskRunner> ui_task_runner;
-};
-
-bool CreateDialogThread(RunState* run_state) {
-  auto thread =
-      std::make_unique<base::Thread>(ELECTRON_PRODUCT_NAME "FileDialogThread");
-  thread->init_com_with_mta(false);
-  if (!thread->Start())
-    return false;
-
-  run_state->dialog_thread = thread.release();
-  run_state->ui_task_runner = base::ThreadTaskRunnerHandle::Get();
-  return true;
-}
+using OpenDialogResult = std::pair<bool, std::vector<base::FilePath>>;
+using SaveDialogResult = std::pair<bool, base::FilePath>;
 
 void OnDialogOpened(gin_helper::Promise<gin_helper::Dictionary> promise,
-                    bool canceled,
-                    std::vector<base::FilePath> paths) {
+                    OpenDialogResult result) {
   gin_helper::Dictionary dict = gin::Dictionary::CreateEmpty(promise.isolate());
-  dict.Set("canceled", canceled);
-  dict.Set("filePaths", paths);
+  dict.Set("canceled", !result.first);
+  dict.Set("filePaths", result.second);
   promise.Resolve(dict);
 }
 
-void RunOpenDialogInNewThread(
-    const RunState& run_state,
-    const DialogSettings& settings,
-    gin_helper::Promise<gin_helper::Dictionary> promise) {
+OpenDialogResult RunOpenDialogInDialogThread(const DialogSettings& settings) {
   std::vector<base::FilePath> paths;
   bool result = ShowOpenDialogSync(settings, &paths);
-  run_state.ui_task_runner->PostTask(
-      FROM_HERE,
-      base::BindOnce(&OnDialogOpened, std::move(promise), !result, paths));
-  run_state.ui_task_runner->DeleteSoon(FROM_HERE, run_state.dialog_thread);
+  return std::make_pair(result, paths);
 }
 
 void OnSaveDialogDone(gin_helper::Promise<gin_helper::Dictionary> promise,
-                      bool canceled,
-                      const base::FilePath path) {
+                      SaveDialogResult result) {
   gin_helper::Dictionary dict = gin::Dictionary::CreateEmpty(promise.isolate());
-  dict.Set("canceled", canceled);
-  dict.Set("filePath", path);
+  dict.Set("canceled", !result.first);
+  dict.Set("filePath", result.second);
   promise.Resolve(dict);
 }
 
-void RunSaveDialogInNewThread(
-    const RunState& run_state,
-    const DialogSettings& settings,
-    gin_helper::Promise<gin_helper::Dictionary> promise) {
+SaveDialogResult RunSaveDialogInDialogThread(const DialogSettings& settings) {
   base::FilePath path;
   bool result = ShowSaveDialogSync(settings, &path);
-  run_state.ui_task_runner->PostTask(
-      FROM_HERE,
-      base::BindOnce(&OnSaveDialogDone, std::move(promise), !result, path));
-  run_state.ui_task_runner->DeleteSoon(FROM_HERE, run_state.dialog_thread);
+  return std::make_pair(result, path);
 }
 
 }  // namespace
@@ -276,16 +250,13 @@ bool ShowOpenDialogSync(const DialogSettings& settings,
 
 void ShowOpenDialog(const DialogSettings& settings,
                     gin_helper::Promise<gin_helper::Dictionary> promise) {
-  gin_helper::Dictionary dict = gin::Dictionary::CreateEmpty(promise.isolate());
-  RunState run_state;
-  if (!CreateDialogThread(&run_state)) {
-    dict.Set("canceled", true);
-    dict.Set("filePaths", std::vector<base::FilePath>());
-    promise.Resolve(dict);
+  dialog_thread::ThreadPtr thread = dialog_thread::Acquire();
+  if (!thread) {
+    OnDialogOpened(std::move(promise), OpenDialogResult());
   } else {
-    run_state.dialog_thread->task_runner()->PostTask(
-        FROM_HERE, base::BindOnce(&RunOpenDialogInNewThread, run_state,
-                                  settings, std::move(promise)));
+    dialog_thread::Run(std::move(thread),
+                       base::BindOnce(&RunOpenDialogInDialogThread, settings),
+                       base::BindOnce(&OnDialogOpened, std::move(promise)));
   }
 }
 
@@ -326,17 +297,13 @@ bool ShowSaveDialogSync(const DialogSettings& settings, base::FilePath* path) {
 
 void ShowSaveDialog(const DialogSettings& settings,
                     gin_helper::Promise<gin_helper::Dictionary> promise) {
-  RunState run_state;
-  if (!CreateDialogThread(&run_state)) {
-    gin_helper::Dictionary dict =
-        gin::Dictionary::CreateEmpty(promise.isolate());
-    dict.Set("canceled", true);
-    dict.Set("filePath", base::FilePath());
-    promise.Resolve(dict);
+  dialog_thread::ThreadPtr thread = dialog_thread::Acquire();
+  if (!thread) {
+    OnSaveDialogDone(std::move(promise), SaveDialogResult());
   } else {
-    run_state.dialog_thread->task_runner()->PostTask(
-        FROM_HERE, base::BindOnce(&RunSaveDialogInNewThread, run_state,
-                                  settings, std::move(promise)));
+    dialog_thread::Run(std::move(thread),
+                       base::BindOnce(&RunSaveDialogInDialogThread, settings),
+                       base::BindOnce(&OnSaveDialogDone, std::move(promise)));
   }
 }
 
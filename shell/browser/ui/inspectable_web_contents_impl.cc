@@ -5,6 +5,7 @@
 
 #include "shell/browser/ui/inspectable_web_contents_impl.h"
 
+#include <algorithm>
 #include <memory>
 #include <utility>
 
@@ -16,6 +17,7 @@
 #include "base/metrics/histogram.h"
 #include "base/stl_util.h"
 #include "base/strings/pattern.h"
+#include "base/strings/string_number_conversions.h"
 #include "base/strings/string_util.h"
 #include "base/strings/stringprintf.h"
 #include "base/strings/utf_string_conversions.h"
@@ -89,6 +91,24 @@ const char kTitleFormat[] = "Developer Tools - %s";
 
 const size_t kMaxMessageChunkSize = IPC::Channel::kMaximumMessageSize / 4;
 
+// The data of streamed resources is sent to the frontend once this much of it
+// was received, rather than for each of the small chunks the loader reads.
+const size_t kMaxStreamChunkSize = 1024 * 1024;
+
+// Returns the size of |data| without the character it ends with when it is
+// cut off, so that text which is split in chunks stays UTF-8.
+size_t GetCompleteUTF8Size(base::StringPiece data) {
+  for (size_t i = 1; i <= std::min<size_t>(4, data.size()); ++i) {
+    const unsigned char c = data[data.size() - i];
+    // Continuation bytes.
+    if ((c & 0xC0) == 0x80)
+      continue;
+    size_t length = c >= 0xF0 ? 4 : c >= 0xE0 ? 3 : c >= 0xC0 ? 2 : 1;
+    return length > i ? data.size() - i : data.size();
+  }
+  return data.size();
+}
+
 // Stores all instances of InspectableWebContentsImpl.
 InspectableWebContentsImpl::List g_web_contents_instances_;
 
@@ -251,25 +271,36 @@ class InspectableWebContentsImpl::NetworkResourceLoader
 
   void OnDataReceived(base::StringPiece chunk,
                       base::OnceClosure resume) override {
-    base::Value chunkValue;
+    pending_data_.append(chunk.data(), chunk.size());
+    if (pending_data_.size() >= kMaxStreamChunkSize)
+      SendPendingData(false);
+    std::move(resume).Run();
+  }
+
+  // Text is sent as is, and only binary data is base64 encoded.
+  void SendPendingData(bool complete) {
+    size_t size =
+        complete ? pending_data_.size() : GetCompleteUTF8Size(pending_data_);
+    if (size == 0)
+      return;
 
-    bool encoded = !base::IsStringUTF8(chunk);
+    base::StringPiece data(pending_data_.data(), size);
+    bool encoded = !base::IsStringUTF8(data);
+    std::string args = base::NumberToString(stream_id_) + ", ";
     if (encoded) {
       std::string encoded_string;
-      base::Base64Encode(chunk, &encoded_string);
-      chunkValue = base::Value(std::move(encoded_string));
+      base::Base64Encode(data, &encoded_string);
+      args.append("\"").append(encoded_string).append("\", true");
     } else {
-      chunkValue = base::Value(chunk);
+      base::EscapeJSONString(data, true, &args);
+      args.append(", false");
     }
-    base::Value id(stream_id_);
-    base::Value encodedValue(encoded);
-
-    bindings_->CallClientFunction("DevToolsAPI.streamWrite", &id, &chunkValue,
-                                  &encodedValue);
-    std::move(resume).Run();
+    bindings_->CallClientFunctionWithArgs("DevToolsAPI.streamWrite", args);
+    pending_data_.erase(0, size);
   }
 
   void OnComplete(bool success) override {
+    SendPendingData(true);
     if (!success && loader_->NetError() == net::ERR_INSUFFICIENT_RESOURCES &&
         retry_delay_ < kMaxBackoffDelay) {
       const base::TimeDelta delay =
@@ -314,6 +345,8 @@ class InspectableWebContentsImpl::NetworkResourceLoader
   scoped_refptr<net::HttpResponseHeaders> response_headers_;
   base::OneShotTimer timer_;
   base::TimeDelta retry_delay_;
+  // What was received but not sent to the frontend yet.
+  std::string pending_data_;
 };
 
 // Implemented separately on each platform.
@@ -534,6 +567,20 @@ void InspectableWebContentsImpl::CallClientFunction(
       base::UTF8ToUTF16(javascript), base::NullCallback());
 }
 
+void InspectableWebContentsImpl::CallClientFunctionWithArgs(
+    const std::string& function_name,
+    base::StringPiece args) {
+  if (!GetDevToolsWebContents())
+    return;
+
+  std::string javascript;
+  javascript.reserve(function_name.size() + args.size() + 3);
+  javascript.append(function_name).append("(");
+  javascript.append(args.data(), args.size()).append(");");
+  GetDevToolsWebContents()->GetMainFrame()->ExecuteJavaScript(
+      base::UTF8ToUTF16(javascript), base::NullCallback());
+}
+
 gfx::Rect InspectableWebContentsImpl::GetDevToolsBounds() const {
   return devtools_bounds_;
 }
@@ -920,12 +967,14 @@ void InspectableWebContentsImpl::DispatchProtocolMessage(
     return;
   }
 
-  base::Value total_size(static_cast<int>(str_message.length()));
   for (size_t pos = 0; pos < str_message.length();
        pos += kMaxMessageChunkSize) {
-    base::Value message_value(str_message.substr(pos, kMaxMessageChunkSize));
-    CallClientFunction("DevToolsAPI.dispatchMessageChunk", &message_value,
-                       pos ? nullptr : &total_size, nullptr);
+    std::string args;
+    base::EscapeJSONString(str_message.substr(pos, kMaxMessageChunkSize), true,
+                           &args);
+    if (!pos)
+      args.append(", ").append(base::NumberToString(str_message.length()));
+    CallClientFunctionWithArgs("DevToolsAPI.dispatchMessageChunk", args);
   }
 }
 
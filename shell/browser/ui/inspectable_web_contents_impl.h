@@ -16,6 +16,7 @@
 #include "base/containers/span.h"
 #include "base/containers/unique_ptr_adapters.h"
 #include "base/memory/weak_ptr.h"
+#include "base/strings/string_piece.h"
 #include "chrome/browser/devtools/devtools_contents_resizing_strategy.h"
 #include "chrome/browser/devtools/devtools_embedder_message_dispatcher.h"
 #include "content/public/browser/devtools_agent_host.h"
@@ -195,6 +196,11 @@ class InspectableWebContentsImpl
 
   void SendMessageAck(int request_id, const base::Value* arg1);
 
+  // Like CallClientFunction, with the arguments already serialized as the
+  // JavaScript of the call, so that large strings are written only once.
+  void CallClientFunctionWithArgs(const std::string& function_name,
+                                  base::StringPiece args);
+
 #if BUILDFLAG(ENABLE_ELECTRON_EXTENSIONS)
   void AddDevToolsExtensionsToClient();
 #endif
@@ -156,6 +156,19 @@ void SetMenuItemID(DbusmenuMenuitem* item, int id) {
   g_object_set_data(G_OBJECT(item), "menu-id", GINT_TO_POINTER(id + 1));
 }
 
+// The type is saved with 1 added, like the id, so that it is never null.
+bool GetMenuItemType(DbusmenuMenuitem* item, AtomMenuModel::ItemType* type) {
+  gpointer type_ptr = g_object_get_data(G_OBJECT(item), "menu-type");
+  if (type_ptr == nullptr)
+    return false;
+  *type = static_cast<AtomMenuModel::ItemType>(GPOINTER_TO_INT(type_ptr) - 1);
+  return true;
+}
+
+void SetMenuItemType(DbusmenuMenuitem* item, AtomMenuModel::ItemType type) {
+  g_object_set_data(G_OBJECT(item), "menu-type", GINT_TO_POINTER(type + 1));
+}
+
 std::string GetMenuModelStatus(AtomMenuModel* model) {
   std::string ret;
   for (int i = 0; i < model->GetItemCount(); ++i) {
@@ -181,6 +194,8 @@ GlobalMenuBarX11::GlobalMenuBarX11(NativeWindowViews* window)
 }
 
 GlobalMenuBarX11::~GlobalMenuBarX11() {
+  if (root_item_)
+    g_object_unref(root_item_);
   if (IsServerStarted())
     g_object_unref(server_);
 
@@ -196,6 +211,12 @@ void GlobalMenuBarX11::SetMenu(AtomMenuModel* menu_model) {
   if (!IsServerStarted())
     return;
 
+  // Setting the same menu again, after its items changed, only sends the
+  // properties which changed over DBus.
+  if (menu_model && menu_model == menu_model_ && root_item_ &&
+      UpdateMenuFromModel(menu_model, root_item_))
+    return;
+
   DbusmenuMenuitem* root_item = menuitem_new();
   menuitem_property_set(root_item, kPropertyLabel, "Root");
   menuitem_property_set_bool(root_item, kPropertyVisible, true);
@@ -204,7 +225,10 @@ void GlobalMenuBarX11::SetMenu(AtomMenuModel* menu_model) {
   }
 
   server_set_root(server_, root_item);
-  g_object_unref(root_item);
+  if (root_item_)
+    g_object_unref(root_item_);
+  root_item_ = root_item;
+  menu_model_ = menu_model;
 }
 
 bool GlobalMenuBarX11::IsServerStarted() const {
@@ -231,6 +255,7 @@ void GlobalMenuBarX11::BuildMenuFromModel(AtomMenuModel* model,
     menuitem_property_set_bool(item, kPropertyVisible, model->IsVisibleAt(i));
 
     AtomMenuModel::ItemType type = model->GetTypeAt(i);
+    SetMenuItemType(item, type);
     if (type == AtomMenuModel::TYPE_SEPARATOR) {
       menuitem_property_set(item, kPropertyType, kTypeSeparator);
     } else {
@@ -270,6 +295,60 @@ void GlobalMenuBarX11::BuildMenuFromModel(AtomMenuModel* model,
   }
 }
 
+bool GlobalMenuBarX11::UpdateMenuFromModel(AtomMenuModel* model,
+                                           DbusmenuMenuitem* parent) {
+  GList* children = menuitem_get_children(parent);
+  if (static_cast<int>(g_list_length(children)) != model->GetItemCount())
+    return false;
+
+  int i = 0;
+  for (GList* child = children; child; child = child->next, ++i) {
+    auto* item = static_cast<DbusmenuMenuitem*>(child->data);
+    AtomMenuModel::ItemType type = model->GetTypeAt(i);
+    AtomMenuModel::ItemType built_type;
+    if (!GetMenuItemType(item, &built_type) || built_type != type)
+      return false;
+    if (type != AtomMenuModel::TYPE_SEPARATOR &&
+        ModelForMenuItem(item) != model)
+      return false;
+  }
+
+  // The properties which are set again with the same value are not sent.
+  i = 0;
+  for (GList* child = children; child; child = child->next, ++i) {
+    auto* item = static_cast<DbusmenuMenuitem*>(child->data);
+    menuitem_property_set_bool(item, kPropertyVisible, model->IsVisibleAt(i));
+
+    AtomMenuModel::ItemType type = model->GetTypeAt(i);
+    if (type == AtomMenuModel::TYPE_SEPARATOR)
+      continue;
+
+    std::string label = ui::ConvertAcceleratorsFromWindowsStyle(
+        base::UTF16ToUTF8(model->GetLabelAt(i)));
+    menuitem_property_set(item, kPropertyLabel, label.c_str());
+    menuitem_property_set_bool(item, kPropertyEnabled, model->IsEnabledAt(i));
+
+    if (type == AtomMenuModel::TYPE_CHECK ||
+        type == AtomMenuModel::TYPE_RADIO) {
+      menuitem_property_set_int(item, kPropertyToggleState,
+                                model->IsItemCheckedAt(i));
+    } else if (type == AtomMenuModel::TYPE_SUBMENU &&
+               g_object_get_data(G_OBJECT(item), "status")) {
+      // The children of a submenu are only built once it is shown, and are
+      // built again the next time it is shown when they changed too much.
+      AtomMenuModel* submodel = model->GetSubmenuModelAt(i);
+      if (UpdateMenuFromModel(submodel, item)) {
+        g_object_set_data_full(G_OBJECT(item), "status",
+                               g_strdup(GetMenuModelStatus(submodel).c_str()),
+                               g_free);
+      } else {
+        g_object_set_data(G_OBJECT(item), "status", nullptr);
+      }
+    }
+  }
+  return true;
+}
+
 void GlobalMenuBarX11::RegisterAccelerator(DbusmenuMenuitem* item,
                                            const ui::Accelerator& accelerator) {
   // A translation of libdbusmenu-gtk's menuitem_property_set_shortcut()
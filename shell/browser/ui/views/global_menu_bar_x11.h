@@ -57,6 +57,10 @@ class GlobalMenuBarX11 {
   // Create a menu from menu model.
   void BuildMenuFromModel(AtomMenuModel* model, DbusmenuMenuitem* parent);
 
+  // Updates the items built from |model| in place. Returns false when items
+  // were added, removed or changed type, and the menu must be built again.
+  bool UpdateMenuFromModel(AtomMenuModel* model, DbusmenuMenuitem* parent);
+
   // Sets the accelerator for |item|.
   void RegisterAccelerator(DbusmenuMenuitem* item,
                            const ui::Accelerator& accelerator);
@@ -73,6 +77,10 @@ class GlobalMenuBarX11 {
 
   DbusmenuServer* server_ = nullptr;
 
+  // The menu which was built last, and its root item.
+  AtomMenuModel* menu_model_ = nullptr;
+  DbusmenuMenuitem* root_item_ = nullptr;
+
   DISALLOW_COPY_AND_ASSIGN(GlobalMenuBarX11);
 };
 
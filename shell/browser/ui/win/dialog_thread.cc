@@ -0,0 +1,53 @@
+// Copyright (c) 2020 GitHub, Inc.
+// Use of this source code is governed by the MIT license that can be
+// found in the LICENSE file.
+
+#include "shell/browser/ui/win/dialog_thread.h"
+
+#include <vector>
+
+#include "base/no_destructor.h"
+#include "content/public/browser/browser_thread.h"
+
+namespace dialog_thread {
+
+namespace {
+
+// More threads are kept idle than this only while several dialogs are open
+// at once.
+const size_t kMaxIdleThreads = 2;
+
+std::vector<ThreadPtr>* GetIdleThreads() {
+  static base::NoDestructor<std::vector<ThreadPtr>> idle_threads;
+  return idle_threads.get();
+}
+
+}  // namespace
+
+ThreadPtr Acquire() {
+  DCHECK_CURRENTLY_ON(content::BrowserThread::UI);
+  std::vector<ThreadPtr>* idle_threads = GetIdleThreads();
+  if (!idle_threads->empty()) {
+    ThreadPtr thread = std::move(idle_threads->back());
+    idle_threads->pop_back();
+    return thread;
+  }
+
+  auto thread =
+      std::make_unique<base::Thread>(ELECTRON_PRODUCT_NAME "DialogThread");
+  thread->init_com_with_mta(false);
+  if (!thread->Start())
+    return nullptr;
+  return thread;
+}
+
+void Release(ThreadPtr thread) {
+  DCHECK_CURRENTLY_ON(content::BrowserThread::UI);
+  std::vector<ThreadPtr>* idle_threads = GetIdleThreads();
+  if (idle_threads->size() < kMaxIdleThreads)
+    idle_threads->push_back(std::move(thread));
+  // Otherwise |thread| is stopped here, which returns at once since its
+  // dialog is closed.
+}
+
+}  // namespace dialog_thread
@@ -0,0 +1,48 @@
+// Copyright (c) 2020 GitHub, Inc.
+// Use of this source code is governed by the MIT license that can be
+// found in the LICENSE file.
+
+#ifndef SHELL_BROWSER_UI_WIN_DIALOG_THREAD_H_
+#define SHELL_BROWSER_UI_WIN_DIALOG_THREAD_H_
+
+#include <memory>
+#include <utility>
+
+#include "base/bind.h"
+#include "base/callback.h"
+#include "base/task_runner_util.h"
+#include "base/threading/thread.h"
+
+namespace dialog_thread {
+
+// The dialogs are run on threads of their own, since a modal dialog blocks
+// its thread until it is closed. The threads are kept for the next dialogs
+// once they are idle, so opening one does not start a thread each time.
+using ThreadPtr = std::unique_ptr<base::Thread>;
+
+// Returns an idle dialog thread, or starts one. Returns null when no thread
+// could be started. Must be called on the UI thread, like Release.
+ThreadPtr Acquire();
+void Release(ThreadPtr thread);
+
+// Runs |dialog| on |thread|, and |done| with its result on the UI thread, once
+// |thread| is idle again.
+template <typename R>
+void Run(ThreadPtr thread,
+         base::OnceCallback<R()> dialog,
+         base::OnceCallback<void(R)> done) {
+  scoped_refptr<base::SingleThreadTaskRunner> task_runner =
+      thread->task_runner();
+  base::PostTaskAndReplyWithResult(
+      task_runner.get(), FROM_HERE, std::move(dialog),
+      base::BindOnce(
+          [](ThreadPtr thread, base::OnceCallback<void(R)> done, R result) {
+            Release(std::move(thread));
+            std::move(done).Run(std::move(result));
+          },
+          std::move(thread), std::move(done)));
+}
+
+}  // namespace dialog_thread
+
+#endif  // SHELL_BROWSER_UI_WIN_DIALOG_THREAD_H_
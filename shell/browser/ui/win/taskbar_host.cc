@@ -7,9 +7,9 @@
 #include <objbase.h>
 #include <string>
 
+#include "base/bind.h"
 #include "base/stl_util.h"
 #include "base/strings/utf_string_conversions.h"
-#include "base/win/scoped_gdi_object.h"
 #include "shell/browser/native_window.h"
 #include "third_party/skia/include/core/SkBitmap.h"
 #include "ui/display/win/screen_win.h"
@@ -27,6 +27,16 @@ const size_t kMaxButtonsCount = 7;
 // The base id of Thumbar button.
 const int kButtonIdBase = 40001;
 
+// The progress value is updated at most this often, since apps may report it
+// for each chunk of a transfer.
+constexpr base::TimeDelta kProgressInterval =
+    base::TimeDelta::FromMilliseconds(100);
+
+// Identifies the pixels of |image|, 0 when it is empty.
+uint32_t GetImageGeneration(const gfx::Image& image) {
+  return image.IsEmpty() ? 0 : image.AsBitmap().getGenerationID();
+}
+
 bool GetThumbarButtonFlags(const std::vector<std::string>& flags,
                            THUMBBUTTONFLAGS* out) {
   THUMBBUTTONFLAGS result = THBF_ENABLED;  // THBF_ENABLED == 0
@@ -64,12 +74,20 @@ bool TaskbarHost::SetThumbarButtons(HWND window,
   if (buttons.size() > kMaxButtonsCount || !InitializeTaskbar())
     return false;
 
+  // Only the callbacks change when the buttons show the same.
+  if (thumbar_buttons_added_ && ThumbarButtonsEqual(buttons)) {
+    callback_map_.clear();
+    for (size_t i = 0; i < buttons.size(); ++i)
+      callback_map_[kButtonIdBase + i] = buttons[i].clicked_callback;
+    last_buttons_ = buttons;
+    return true;
+  }
+
   callback_map_.clear();
 
   // The number of buttons in thumbar can not be changed once it is created,
   // so we have to claim kMaxButtonsCount buttons initialy in case users add
   // more buttons later.
-  base::win::ScopedHICON icons[kMaxButtonsCount] = {};
   THUMBBUTTON thumb_buttons[kMaxButtonsCount] = {};
 
   for (size_t i = 0; i < kMaxButtonsCount; ++i) {
@@ -97,8 +115,7 @@ bool TaskbarHost::SetThumbarButtons(HWND window,
     // Set icon.
     if (!button.icon.IsEmpty()) {
       thumb_button.dwMask |= THB_ICON;
-      icons[i] = IconUtil::CreateHICONFromSkBitmap(button.icon.AsBitmap());
-      thumb_button.hIcon = icons[i].get();
+      thumb_button.hIcon = GetThumbarButtonIcon(i, button.icon);
     }
 
     // Set tooltip.
@@ -126,6 +143,10 @@ bool TaskbarHost::SetThumbarButtons(HWND window,
 }
 
 void TaskbarHost::RestoreThumbarButtons(HWND window) {
+  // The taskbar button was created again, without the progress and overlay.
+  progress_applied_ = false;
+  overlay_applied_ = false;
+
   if (thumbar_buttons_added_) {
     thumbar_buttons_added_ = false;
     SetThumbarButtons(window, last_buttons_);
@@ -138,43 +159,86 @@ bool TaskbarHost::SetProgressBar(HWND window,
   if (!InitializeTaskbar())
     return false;
 
-  bool success;
+  TBPFLAG flag;
+  int progress_value = -1;
   if (value > 1.0 || state == NativeWindow::ProgressState::kIndeterminate) {
-    success = SUCCEEDED(taskbar_->SetProgressState(window, TBPF_INDETERMINATE));
+    flag = TBPF_INDETERMINATE;
   } else if (value < 0 || state == NativeWindow::ProgressState::kNone) {
-    success = SUCCEEDED(taskbar_->SetProgressState(window, TBPF_NOPROGRESS));
+    flag = TBPF_NOPROGRESS;
   } else {
     // Unless SetProgressState set a blocking state (TBPF_ERROR, TBPF_PAUSED)
     // for the window, a call to SetProgressValue assumes the TBPF_NORMAL
     // state even if it is not explicitly set.
     // SetProgressValue overrides and clears the TBPF_INDETERMINATE state.
-    if (state == NativeWindow::ProgressState::kError) {
-      success = SUCCEEDED(taskbar_->SetProgressState(window, TBPF_ERROR));
-    } else if (state == NativeWindow::ProgressState::kPaused) {
-      success = SUCCEEDED(taskbar_->SetProgressState(window, TBPF_PAUSED));
-    } else {
-      success = SUCCEEDED(taskbar_->SetProgressState(window, TBPF_NORMAL));
+    if (state == NativeWindow::ProgressState::kError)
+      flag = TBPF_ERROR;
+    else if (state == NativeWindow::ProgressState::kPaused)
+      flag = TBPF_PAUSED;
+    else
+      flag = TBPF_NORMAL;
+    progress_value = static_cast<int>(value * 100);
+  }
+
+  if (progress_applied_ && flag == progress_flag_) {
+    if (progress_value == progress_value_) {
+      progress_timer_.Stop();
+      return true;
     }
 
-    if (success) {
-      int val = static_cast<int>(value * 100);
-      success = SUCCEEDED(taskbar_->SetProgressValue(window, val, 100));
+    // A new state is shown at once, but a new value waits for the interval.
+    base::TimeDelta elapsed = base::TimeTicks::Now() - progress_updated_;
+    if (elapsed < kProgressInterval) {
+      pending_progress_value_ = progress_value;
+      if (!progress_timer_.IsRunning()) {
+        progress_timer_.Start(
+            FROM_HERE, kProgressInterval - elapsed,
+            base::BindOnce(&TaskbarHost::ApplyPendingProgress,
+                           base::Unretained(this), window));
+      }
+      return true;
     }
   }
 
+  progress_timer_.Stop();
+  return ApplyProgress(window, flag, progress_value);
+}
+
+bool TaskbarHost::ApplyProgress(HWND window, TBPFLAG flag, int value) {
+  bool success = SUCCEEDED(taskbar_->SetProgressState(window, flag));
+  if (success && value >= 0)
+    success = SUCCEEDED(taskbar_->SetProgressValue(window, value, 100));
+
+  // A progress which failed is set again by the next call.
+  progress_applied_ = success;
+  progress_flag_ = flag;
+  progress_value_ = value;
+  progress_updated_ = base::TimeTicks::Now();
   return success;
 }
 
+void TaskbarHost::ApplyPendingProgress(HWND window) {
+  if (progress_applied_)
+    ApplyProgress(window, progress_flag_, pending_progress_value_);
+}
+
 bool TaskbarHost::SetOverlayIcon(HWND window,
                                  const gfx::Image& overlay,
                                  const std::string& text) {
   if (!InitializeTaskbar())
     return false;
 
+  uint32_t generation = GetImageGeneration(overlay);
+  if (overlay_applied_ && generation == overlay_generation_ &&
+      text == overlay_text_)
+    return true;
+
   base::win::ScopedHICON icon(
       IconUtil::CreateHICONFromSkBitmap(overlay.AsBitmap()));
-  return SUCCEEDED(taskbar_->SetOverlayIcon(window, icon.get(),
-                                            base::UTF8ToUTF16(text).c_str()));
+  overlay_applied_ = SUCCEEDED(taskbar_->SetOverlayIcon(
+      window, icon.get(), base::UTF8ToUTF16(text).c_str()));
+  overlay_generation_ = generation;
+  overlay_text_ = text;
+  return overlay_applied_;
 }
 
 bool TaskbarHost::SetThumbnailClip(HWND window, const gfx::Rect& region) {
@@ -209,6 +273,35 @@ bool TaskbarHost::HandleThumbarButtonEvent(int button_id) {
   return false;
 }
 
+bool TaskbarHost::ThumbarButtonsEqual(
+    const std::vector<ThumbarButton>& buttons) const {
+  if (buttons.size() != last_buttons_.size())
+    return false;
+  for (size_t i = 0; i < buttons.size(); ++i) {
+    const ThumbarButton& button = buttons[i];
+    const ThumbarButton& last_button = last_buttons_[i];
+    if (button.tooltip != last_button.tooltip ||
+        button.flags != last_button.flags ||
+        GetImageGeneration(button.icon) != GetImageGeneration(last_button.icon))
+      return false;
+  }
+  return true;
+}
+
+HICON TaskbarHost::GetThumbarButtonIcon(size_t index, const gfx::Image& image) {
+  if (button_icons_.size() <= index) {
+    button_icons_.resize(index + 1);
+    button_icon_generations_.resize(index + 1, 0);
+  }
+  uint32_t generation = GetImageGeneration(image);
+  if (!button_icons_[index].is_valid() ||
+      button_icon_generations_[index] != generation) {
+    button_icons_[index] = IconUtil::CreateHICONFromSkBitmap(image.AsBitmap());
+    button_icon_generations_[index] = generation;
+  }
+  return button_icons_[index].get();
+}
+
 bool TaskbarHost::InitializeTaskbar() {
   if (taskbar_)
     return true;
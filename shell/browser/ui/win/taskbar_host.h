@@ -13,6 +13,9 @@
 #include <vector>
 
 #include "base/callback.h"
+#include "base/time/time.h"
+#include "base/timer/timer.h"
+#include "base/win/scoped_gdi_object.h"
 #include "shell/browser/native_window.h"
 #include "ui/gfx/geometry/rect.h"
 #include "ui/gfx/image/image.h"
@@ -64,11 +67,42 @@ class TaskbarHost {
   // Initialize the taskbar object.
   bool InitializeTaskbar();
 
+  // Whether |buttons| would show the same as the buttons in thumbar.
+  bool ThumbarButtonsEqual(const std::vector<ThumbarButton>& buttons) const;
+
+  // Returns the icon converted from the image of button |index|, converting
+  // it when the image changed.
+  HICON GetThumbarButtonIcon(size_t index, const gfx::Image& image);
+
+  bool ApplyProgress(HWND window, TBPFLAG flag, int value);
+  void ApplyPendingProgress(HWND window);
+
   using CallbackMap = std::map<int, base::Closure>;
   CallbackMap callback_map_;
 
   std::vector<ThumbarButton> last_buttons_;
 
+  // The icons of the thumbar buttons, and the generation of the bitmaps they
+  // were converted from.
+  std::vector<base::win::ScopedHICON> button_icons_;
+  std::vector<uint32_t> button_icon_generations_;
+
+  // The progress shown in taskbar, with a |progress_value_| of -1 when its
+  // state has no value.
+  bool progress_applied_ = false;
+  TBPFLAG progress_flag_ = TBPF_NOPROGRESS;
+  int progress_value_ = -1;
+  // The value changes at most once per interval, the last one waiting for
+  // the timer.
+  base::TimeTicks progress_updated_;
+  int pending_progress_value_ = -1;
+  base::OneShotTimer progress_timer_;
+
+  // The overlay icon shown in taskbar.
+  bool overlay_applied_ = false;
+  uint32_t overlay_generation_ = 0;
+  std::string overlay_text_;
+
   // The COM object of taskbar.
   Microsoft::WRL::ComPtr<ITaskbarList3> taskbar_;
 
@@ -13,6 +13,14 @@ namespace electron {
 WindowStateWatcher::WindowStateWatcher(NativeWindowViews* window)
     : window_(window), widget_(window->GetAcceleratedWidget()) {
   ui::PlatformEventSource::GetInstance()->AddPlatformEventObserver(this);
+
+  // Also listen for the window getting covered by other windows.
+  XDisplay* xdisplay = gfx::GetXDisplay();
+  XWindowAttributes attributes;
+  if (XGetWindowAttributes(xdisplay, widget_, &attributes)) {
+    XSelectInput(xdisplay, widget_,
+                 attributes.your_event_mask | VisibilityChangeMask);
+  }
 }
 
 WindowStateWatcher::~WindowStateWatcher() {
@@ -27,7 +35,10 @@ void WindowStateWatcher::WillProcessEvent(const ui::PlatformEvent& event) {
 }
 
 void WindowStateWatcher::DidProcessEvent(const ui::PlatformEvent& event) {
-  if (IsWindowStateEvent(event)) {
+  if (IsVisibilityEvent(event)) {
+    window_->NotifyWindowOcclusionChanged(event->xvisibility.state ==
+                                          VisibilityFullyObscured);
+  } else if (IsWindowStateEvent(event)) {
     bool is_minimized = window_->IsMinimized();
     bool is_maximized = window_->IsMaximized();
     bool is_fullscreen = window_->IsFullscreen();
@@ -61,4 +72,9 @@ bool WindowStateWatcher::IsWindowStateEvent(const ui::PlatformEvent& event) {
           event->type == PropertyNotify && event->xproperty.window == widget_);
 }
 
+bool WindowStateWatcher::IsVisibilityEvent(const ui::PlatformEvent& event) {
+  return event->type == VisibilityNotify &&
+         event->xvisibility.window == widget_;
+}
+
 }  // namespace electron
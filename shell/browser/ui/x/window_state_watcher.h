@@ -23,6 +23,7 @@ class WindowStateWatcher : public ui::PlatformEventObserver {
 
  private:
   bool IsWindowStateEvent(const ui::PlatformEvent& event);
+  bool IsVisibilityEvent(const ui::PlatformEvent& event);
 
   NativeWindowViews* window_;
   gfx::AcceleratedWidget widget_;
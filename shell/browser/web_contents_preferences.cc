@@ -4,14 +4,17 @@
 
 #include "shell/browser/web_contents_preferences.h"
 
-#include <algorithm>
 #include <string>
 #include <utility>
 #include <vector>
 
 #include "base/command_line.h"
 #include "base/memory/ptr_util.h"
+#include "base/optional.h"
+#include "base/strings/strcat.h"
 #include "base/strings/string_number_conversions.h"
+#include "base/strings/string_util.h"
+#include "base/strings/stringprintf.h"
 #include "base/strings/utf_string_conversions.h"
 #include "cc/base/switches.h"
 #include "content/public/browser/render_frame_host.h"
@@ -97,12 +100,13 @@ bool GetAsAutoplayPolicy(const base::Value* val,
 namespace electron {
 
 // static
-std::vector<WebContentsPreferences*> WebContentsPreferences::instances_;
+std::multimap<int, WebContentsPreferences*>
+    WebContentsPreferences::instances_;
 
 WebContentsPreferences::WebContentsPreferences(
     content::WebContents* web_contents,
     const gin_helper::Dictionary& web_preferences)
-    : web_contents_(web_contents) {
+    : content::WebContentsObserver(web_contents), web_contents_(web_contents) {
   v8::Isolate* isolate = web_preferences.isolate();
   gin_helper::Dictionary copied(isolate, web_preferences.GetHandle()->Clone());
   // Following fields should not be stored.
@@ -113,7 +117,7 @@ WebContentsPreferences::WebContentsPreferences(
   gin::ConvertFromV8(isolate, copied.GetHandle(), &preference_);
   web_contents->SetUserData(UserDataKey(), base::WrapUnique(this));
 
-  instances_.push_back(this);
+  SetProcessID(web_contents->GetMainFrame()->GetProcess()->GetID());
 
   // Set WebPreferences defaults onto the JS object
   SetDefaultBoolIfUndefined(options::kPlugins, false);
@@ -158,7 +162,7 @@ WebContentsPreferences::WebContentsPreferences(
       if (embedder) {
         auto* embedder_preferences = WebContentsPreferences::From(embedder);
         if (embedder_preferences &&
-            embedder_preferences->IsEnabled(options::kOffscreen)) {
+            embedder_preferences->parsed().offscreen) {
           preference_.SetKey(options::kOffscreen, base::Value(true));
         }
       }
@@ -169,8 +173,7 @@ WebContentsPreferences::WebContentsPreferences(
 }
 
 WebContentsPreferences::~WebContentsPreferences() {
-  instances_.erase(std::remove(instances_.begin(), instances_.end(), this),
-                   instances_.end());
+  SetProcessID(-1);
 }
 
 void WebContentsPreferences::SetDefaults() {
@@ -179,6 +182,46 @@ void WebContentsPreferences::SetDefaults() {
   }
 
   last_preference_ = preference_.Clone();
+  ParsePreferences();
+}
+
+void WebContentsPreferences::ParsePreferences() {
+  parsed_.node_integration = IsEnabled(options::kNodeIntegration);
+  parsed_.node_integration_in_sub_frames =
+      IsEnabled(options::kNodeIntegrationInSubFrames);
+  parsed_.node_integration_in_worker =
+      IsEnabled(options::kNodeIntegrationInWorker);
+  parsed_.sandbox = IsEnabled(options::kSandbox);
+  parsed_.context_isolation = IsEnabled(options::kContextIsolation);
+  parsed_.native_window_open = IsEnabled(options::kNativeWindowOpen);
+  parsed_.webview_tag = IsEnabled(options::kWebviewTag);
+  parsed_.plugins = IsEnabled(options::kPlugins);
+  parsed_.experimental_features = IsEnabled(options::kExperimentalFeatures);
+  parsed_.web_security = IsEnabled(options::kWebSecurity, true);
+  parsed_.disable_popups = IsEnabled("disablePopups");
+  parsed_.offscreen = IsEnabled(options::kOffscreen);
+}
+
+void WebContentsPreferences::SetProcessID(int process_id) {
+  if (process_id_ == process_id)
+    return;
+  auto range = instances_.equal_range(process_id_);
+  for (auto iter = range.first; iter != range.second; ++iter) {
+    if (iter->second == this) {
+      instances_.erase(iter);
+      break;
+    }
+  }
+  process_id_ = process_id;
+  if (process_id_ != -1)
+    instances_.emplace(process_id_, this);
+}
+
+void WebContentsPreferences::RenderFrameHostChanged(
+    content::RenderFrameHost* old_host,
+    content::RenderFrameHost* new_host) {
+  if (!new_host->GetParent())
+    SetProcessID(new_host->GetProcess()->GetID());
 }
 
 bool WebContentsPreferences::SetDefaultBoolIfUndefined(base::StringPiece key,
@@ -216,6 +259,7 @@ void WebContentsPreferences::Merge(const base::DictionaryValue& extend) {
 void WebContentsPreferences::Clear() {
   if (preference_.is_dict())
     static_cast<base::DictionaryValue*>(&preference_)->Clear();
+  ParsePreferences();
 }
 
 bool WebContentsPreferences::GetPreference(base::StringPiece name,
@@ -250,12 +294,12 @@ bool WebContentsPreferences::GetPreloadPath(
 // static
 content::WebContents* WebContentsPreferences::GetWebContentsFromProcessID(
     int process_id) {
-  for (WebContentsPreferences* preferences : instances_) {
-    content::WebContents* web_contents = preferences->web_contents_;
-    if (web_contents->GetMainFrame()->GetProcess()->GetID() == process_id)
-      return web_contents;
-  }
-  return nullptr;
+  auto iter = instances_.find(process_id);
+  if (iter == instances_.end())
+    return nullptr;
+  DCHECK_EQ(iter->second->web_contents_->GetMainFrame()->GetProcess()->GetID(),
+            process_id);
+  return iter->second->web_contents_;
 }
 
 // static
@@ -270,36 +314,36 @@ void WebContentsPreferences::AppendCommandLineSwitches(
     base::CommandLine* command_line,
     bool is_subframe) {
   // Check if plugins are enabled.
-  if (IsEnabled(options::kPlugins))
+  if (parsed_.plugins)
     command_line->AppendSwitch(switches::kEnablePlugins);
 
   // Experimental flags.
-  if (IsEnabled(options::kExperimentalFeatures))
+  if (parsed_.experimental_features)
     command_line->AppendSwitch(
         ::switches::kEnableExperimentalWebPlatformFeatures);
 
   // Check if we have node integration specified.
-  if (IsEnabled(options::kNodeIntegration))
+  if (parsed_.node_integration)
     command_line->AppendSwitch(switches::kNodeIntegration);
 
   // Whether to enable node integration in Worker.
-  if (IsEnabled(options::kNodeIntegrationInWorker))
+  if (parsed_.node_integration_in_worker)
     command_line->AppendSwitch(switches::kNodeIntegrationInWorker);
 
   // Check if webview tag creation is enabled, default to nodeIntegration value.
-  if (IsEnabled(options::kWebviewTag))
+  if (parsed_.webview_tag)
     command_line->AppendSwitch(switches::kWebviewTag);
 
   // Sandbox can be enabled for renderer processes hosting cross-origin frames
   // unless nodeIntegrationInSubFrames is enabled
   bool can_sandbox_frame =
-      is_subframe && !IsEnabled(options::kNodeIntegrationInSubFrames);
+      is_subframe && !parsed_.node_integration_in_sub_frames;
 
   // If the `sandbox` option was passed to the BrowserWindow's webPreferences,
   // pass `--enable-sandbox` to the renderer so it won't have any node.js
   // integration. Otherwise disable Chromium sandbox, unless app.enableSandbox()
   // was called.
-  if (IsEnabled(options::kSandbox) || can_sandbox_frame) {
+  if (parsed_.sandbox || can_sandbox_frame) {
     command_line->AppendSwitch(switches::kEnableSandbox);
   } else if (!command_line->HasSwitch(switches::kEnableSandbox)) {
     command_line->AppendSwitch(service_manager::switches::kNoSandbox);
@@ -307,7 +351,7 @@ void WebContentsPreferences::AppendCommandLineSwitches(
   }
 
   // Check if nativeWindowOpen is enabled.
-  if (IsEnabled(options::kNativeWindowOpen))
+  if (parsed_.native_window_open)
     command_line->AppendSwitch(switches::kNativeWindowOpen);
 
   // The preload script.
@@ -315,6 +359,40 @@ void WebContentsPreferences::AppendCommandLineSwitches(
   if (GetPreloadPath(&preload))
     command_line->AppendSwitchNative(switches::kPreloadScript, preload);
 
+  // Whether the videos keep playing while the page is hidden.
+  base::Optional<bool> suspend_media = preference_.FindBoolPath(
+      base::StrCat({options::kBackgroundThrottlingPolicy, ".media"}));
+  if (suspend_media && !*suspend_media)
+    command_line->AppendSwitch(::switches::kDisableBackgroundMediaSuspend);
+
+  // The heap limits and GC mode of V8, added to the flags V8 is given.
+  std::vector<std::string> js_flags;
+  base::Optional<int> max_old_space_size = preference_.FindIntPath(
+      base::StrCat({options::kV8HeapPolicy, ".maxOldSpaceSize"}));
+  if (max_old_space_size && *max_old_space_size > 0) {
+    js_flags.push_back(
+        base::StringPrintf("--max-old-space-size=%d", *max_old_space_size));
+    command_line->AppendSwitch(switches::kNearHeapLimitEvent);
+  }
+  base::Optional<int> max_semi_space_size = preference_.FindIntPath(
+      base::StrCat({options::kV8HeapPolicy, ".maxSemiSpaceSize"}));
+  if (max_semi_space_size && *max_semi_space_size > 0) {
+    js_flags.push_back(
+        base::StringPrintf("--max-semi-space-size=%d", *max_semi_space_size));
+  }
+  base::Optional<bool> memory_saver = preference_.FindBoolPath(
+      base::StrCat({options::kV8HeapPolicy, ".memorySaver"}));
+  if (memory_saver && *memory_saver)
+    js_flags.push_back("--optimize-for-size");
+  if (!js_flags.empty()) {
+    std::string flags =
+        command_line->GetSwitchValueASCII(::switches::kJavaScriptFlags);
+    if (!flags.empty())
+      js_flags.insert(js_flags.begin(), flags);
+    command_line->AppendSwitchASCII(::switches::kJavaScriptFlags,
+                                    base::JoinString(js_flags, " "));
+  }
+
   // Custom args for renderer process
   auto* customArgs =
       preference_.FindKeyOfType(options::kCustomArgs, base::Value::Type::LIST);
@@ -332,21 +410,21 @@ void WebContentsPreferences::AppendCommandLineSwitches(
 #endif
 
   // Run Electron APIs and preload script in isolated world
-  if (IsEnabled(options::kContextIsolation))
+  if (parsed_.context_isolation)
     command_line->AppendSwitch(switches::kContextIsolation);
 
   // --background-color.
   std::string s;
   if (GetAsString(&preference_, options::kBackgroundColor, &s)) {
     command_line->AppendSwitchASCII(switches::kBackgroundColor, s);
-  } else if (!IsEnabled(options::kOffscreen)) {
+  } else if (!parsed_.offscreen) {
     // For non-OSR WebContents, we expect to have white background, see
     // https://github.com/electron/electron/issues/13764 for more.
     command_line->AppendSwitchASCII(switches::kBackgroundColor, "#fff");
   }
 
   // --offscreen
-  if (IsEnabled(options::kOffscreen)) {
+  if (parsed_.offscreen) {
     command_line->AppendSwitch(options::kOffscreen);
   }
 
@@ -5,10 +5,11 @@
 #ifndef SHELL_BROWSER_WEB_CONTENTS_PREFERENCES_H_
 #define SHELL_BROWSER_WEB_CONTENTS_PREFERENCES_H_
 
+#include <map>
 #include <string>
-#include <vector>
 
 #include "base/values.h"
+#include "content/public/browser/web_contents_observer.h"
 #include "content/public/browser/web_contents_user_data.h"
 
 namespace base {
@@ -27,8 +28,26 @@ namespace electron {
 
 // Stores and applies the preferences of WebContents.
 class WebContentsPreferences
-    : public content::WebContentsUserData<WebContentsPreferences> {
+    : public content::WebContentsObserver,
+      public content::WebContentsUserData<WebContentsPreferences> {
  public:
+  // The preferences read when the renderer processes are started and
+  // configured, parsed each time the preferences are set.
+  struct Parsed {
+    bool node_integration = false;
+    bool node_integration_in_sub_frames = false;
+    bool node_integration_in_worker = false;
+    bool sandbox = false;
+    bool context_isolation = false;
+    bool native_window_open = false;
+    bool webview_tag = false;
+    bool plugins = false;
+    bool experimental_features = false;
+    bool web_security = true;
+    bool disable_popups = false;
+    bool offscreen = false;
+  };
+
   // Get self from WebContents.
   static WebContentsPreferences* From(content::WebContents* web_contents);
 
@@ -65,6 +84,15 @@ class WebContentsPreferences
   base::Value* preference() { return &preference_; }
   base::Value* last_preference() { return &last_preference_; }
 
+  // Returns the parsed preferences, which do not see the changes made through
+  // preference().
+  const Parsed& parsed() const { return parsed_; }
+
+ protected:
+  // content::WebContentsObserver:
+  void RenderFrameHostChanged(content::RenderFrameHost* old_host,
+                              content::RenderFrameHost* new_host) override;
+
  private:
   friend class content::WebContentsUserData<WebContentsPreferences>;
   friend class AtomBrowserClient;
@@ -78,9 +106,18 @@ class WebContentsPreferences
   // Set preference value to given bool
   void SetBool(base::StringPiece key, bool value);
 
-  static std::vector<WebContentsPreferences*> instances_;
+  void ParsePreferences();
+
+  // Indexes this by the process of the main frame.
+  void SetProcessID(int process_id);
+
+  // The instances by the process of their main frame.
+  static std::multimap<int, WebContentsPreferences*> instances_;
 
   content::WebContents* web_contents_;
+  int process_id_ = -1;
+
+  Parsed parsed_;
 
   base::Value preference_ = base::Value(base::Value::Type::DICTIONARY);
   base::Value last_preference_ = base::Value(base::Value::Type::DICTIONARY);
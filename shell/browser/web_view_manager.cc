@@ -19,24 +19,40 @@ void WebViewManager::AddGuest(int guest_instance_id,
                               int element_instance_id,
                               content::WebContents* embedder,
                               content::WebContents* web_contents) {
-  web_contents_embedder_map_[guest_instance_id] = {web_contents, embedder};
-
   // Map the element in embedder to guest.
   int owner_process_id = embedder->GetMainFrame()->GetProcess()->GetID();
   ElementInstanceKey key(owner_process_id, element_instance_id);
+
+  // The guest may be attached again, to another element.
+  RemoveGuest(guest_instance_id);
+
+  web_contents_embedder_map_.emplace(
+      guest_instance_id, WebContentsWithEmbedder{web_contents, embedder, key});
   element_instance_id_to_guest_map_[key] = guest_instance_id;
+  embedder_guests_map_[embedder].insert(guest_instance_id);
 }
 
 void WebViewManager::RemoveGuest(int guest_instance_id) {
-  if (web_contents_embedder_map_.erase(guest_instance_id) == 0)
+  auto iter = web_contents_embedder_map_.find(guest_instance_id);
+  if (iter == web_contents_embedder_map_.end())
     return;
 
-  // Remove the record of element in embedder too.
-  for (const auto& element : element_instance_id_to_guest_map_)
-    if (element.second == guest_instance_id) {
-      element_instance_id_to_guest_map_.erase(element.first);
-      break;
-    }
+  // Remove the record of element in embedder too, unless the element has
+  // been given to another guest since.
+  auto element =
+      element_instance_id_to_guest_map_.find(iter->second.element_key);
+  if (element != element_instance_id_to_guest_map_.end() &&
+      element->second == guest_instance_id)
+    element_instance_id_to_guest_map_.erase(element);
+
+  auto guests = embedder_guests_map_.find(iter->second.embedder);
+  if (guests != embedder_guests_map_.end()) {
+    guests->second.erase(guest_instance_id);
+    if (guests->second.empty())
+      embedder_guests_map_.erase(guests);
+  }
+
+  web_contents_embedder_map_.erase(iter);
 }
 
 content::WebContents* WebViewManager::GetEmbedder(int guest_instance_id) {
@@ -62,11 +78,18 @@ content::WebContents* WebViewManager::GetGuestByInstanceID(
 
 bool WebViewManager::ForEachGuest(content::WebContents* embedder_web_contents,
                                   const GuestCallback& callback) {
-  for (auto& item : web_contents_embedder_map_) {
-    if (item.second.embedder != embedder_web_contents)
+  const auto guests = embedder_guests_map_.find(embedder_web_contents);
+  if (guests == std::end(embedder_guests_map_))
+    return false;
+
+  // The callback may add or remove guests.
+  const base::flat_set<int> guest_instance_ids = guests->second;
+  for (int guest_instance_id : guest_instance_ids) {
+    const auto iter = web_contents_embedder_map_.find(guest_instance_id);
+    if (iter == std::end(web_contents_embedder_map_))
       continue;
 
-    auto* guest_web_contents = item.second.web_contents;
+    auto* guest_web_contents = iter->second.web_contents;
     if (guest_web_contents && callback.Run(guest_web_contents))
       return true;
   }
@@ -5,8 +5,10 @@
 #ifndef SHELL_BROWSER_WEB_VIEW_MANAGER_H_
 #define SHELL_BROWSER_WEB_VIEW_MANAGER_H_
 
-#include <map>
+#include <functional>
+#include <unordered_map>
 
+#include "base/containers/flat_set.h"
 #include "content/public/browser/browser_plugin_guest_manager.h"
 
 namespace electron {
@@ -33,13 +35,6 @@ class WebViewManager : public content::BrowserPluginGuestManager {
                     const GuestCallback& callback) override;
 
  private:
-  struct WebContentsWithEmbedder {
-    content::WebContents* web_contents;
-    content::WebContents* embedder;
-  };
-  // guest_instance_id => (web_contents, embedder)
-  std::map<int, WebContentsWithEmbedder> web_contents_embedder_map_;
-
   struct ElementInstanceKey {
     int embedder_process_id;
     int element_instance_id;
@@ -48,19 +43,36 @@ class WebViewManager : public content::BrowserPluginGuestManager {
         : embedder_process_id(embedder_process_id),
           element_instance_id(element_instance_id) {}
 
-    bool operator<(const ElementInstanceKey& other) const {
-      if (embedder_process_id != other.embedder_process_id)
-        return embedder_process_id < other.embedder_process_id;
-      return element_instance_id < other.element_instance_id;
-    }
-
     bool operator==(const ElementInstanceKey& other) const {
       return (embedder_process_id == other.embedder_process_id) &&
              (element_instance_id == other.element_instance_id);
     }
   };
+
+  struct ElementInstanceKeyHash {
+    size_t operator()(const ElementInstanceKey& key) const {
+      return std::hash<int>()(key.embedder_process_id) ^
+             (std::hash<int>()(key.element_instance_id) << 1);
+    }
+  };
+
+  struct WebContentsWithEmbedder {
+    content::WebContents* web_contents;
+    content::WebContents* embedder;
+    // Kept so the guest's records can be removed without a search.
+    ElementInstanceKey element_key;
+  };
+  // guest_instance_id => (web_contents, embedder, element_key)
+  std::unordered_map<int, WebContentsWithEmbedder> web_contents_embedder_map_;
+
   // (embedder_process_id, element_instance_id) => guest_instance_id
-  std::map<ElementInstanceKey, int> element_instance_id_to_guest_map_;
+  std::unordered_map<ElementInstanceKey, int, ElementInstanceKeyHash>
+      element_instance_id_to_guest_map_;
+
+  // embedder => guest_instance_ids, so the guests of an embedder are found
+  // without visiting those of the other embedders.
+  std::unordered_map<content::WebContents*, base::flat_set<int>>
+      embedder_guests_map_;
 
   DISALLOW_COPY_AND_ASSIGN(WebViewManager);
 };
@@ -27,7 +27,7 @@ WindowList* WindowList::GetInstance() {
 }
 
 // static
-WindowList::WindowVector WindowList::GetWindows() {
+const WindowList::WindowVector& WindowList::GetWindows() {
   return GetInstance()->windows_;
 }
 
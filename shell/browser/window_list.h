@@ -20,7 +20,9 @@ class WindowList {
  public:
   typedef std::vector<NativeWindow*> WindowVector;
 
-  static WindowVector GetWindows();
+  // The list is not copied, so copy it to close or add windows while
+  // iterating.
+  static const WindowVector& GetWindows();
   static bool IsEmpty();
 
   // Adds or removes |window| from the list it is associated with.
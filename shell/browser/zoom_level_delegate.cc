@@ -30,6 +30,10 @@ const char kPartitionDefaultZoomLevel[] = "partition.default_zoom_level";
 // be displayed at the default zoom level.
 const char kPartitionPerHostZoomLevels[] = "partition.per_host_zoom_levels";
 
+// How long after the last change of a per-host zoom level the changes are
+// written to the preferences.
+constexpr base::TimeDelta kCommitDelay = base::TimeDelta::FromSeconds(1);
+
 std::string GetHash(const base::FilePath& partition_path) {
   size_t int_key = std::hash<base::FilePath>()(partition_path);
   return base::NumberToString(int_key);
@@ -50,7 +54,9 @@ ZoomLevelDelegate::ZoomLevelDelegate(PrefService* pref_service,
   partition_key_ = GetHash(partition_path);
 }
 
-ZoomLevelDelegate::~ZoomLevelDelegate() = default;
+ZoomLevelDelegate::~ZoomLevelDelegate() {
+  CommitPendingZoomLevels();
+}
 
 void ZoomLevelDelegate::SetDefaultZoomLevelPref(double level) {
   if (blink::PageZoomValuesEqual(level, host_zoom_map_->GetDefaultZoomLevel()))
@@ -78,13 +84,26 @@ void ZoomLevelDelegate::OnZoomLevelChanged(
     return;
 
   double level = change.zoom_level;
+  bool modification_is_removal =
+      blink::PageZoomValuesEqual(level, host_zoom_map_->GetDefaultZoomLevel());
+  pending_zoom_levels_[change.host] =
+      modification_is_removal ? base::nullopt : base::make_optional(level);
+
+  commit_timer_.Start(
+      FROM_HERE, kCommitDelay,
+      base::BindOnce(&ZoomLevelDelegate::CommitPendingZoomLevels,
+                     base::Unretained(this)));
+}
+
+void ZoomLevelDelegate::CommitPendingZoomLevels() {
+  commit_timer_.Stop();
+  if (pending_zoom_levels_.empty())
+    return;
+
   DictionaryPrefUpdate update(pref_service_, kPartitionPerHostZoomLevels);
   base::DictionaryValue* host_zoom_dictionaries = update.Get();
   DCHECK(host_zoom_dictionaries);
 
-  bool modification_is_removal =
-      blink::PageZoomValuesEqual(level, host_zoom_map_->GetDefaultZoomLevel());
-
   base::DictionaryValue* host_zoom_dictionary = nullptr;
   if (!host_zoom_dictionaries->GetDictionary(partition_key_,
                                              &host_zoom_dictionary)) {
@@ -92,10 +111,13 @@ void ZoomLevelDelegate::OnZoomLevelChanged(
         partition_key_, std::make_unique<base::DictionaryValue>());
   }
 
-  if (modification_is_removal)
-    host_zoom_dictionary->RemoveWithoutPathExpansion(change.host, nullptr);
-  else
-    host_zoom_dictionary->SetKey(change.host, base::Value(level));
+  for (const auto& pending : pending_zoom_levels_) {
+    if (pending.second)
+      host_zoom_dictionary->SetKey(pending.first, base::Value(*pending.second));
+    else
+      host_zoom_dictionary->RemoveWithoutPathExpansion(pending.first, nullptr);
+  }
+  pending_zoom_levels_.clear();
 }
 
 void ZoomLevelDelegate::ExtractPerHostZoomLevels(
@@ -5,11 +5,14 @@
 #ifndef SHELL_BROWSER_ZOOM_LEVEL_DELEGATE_H_
 #define SHELL_BROWSER_ZOOM_LEVEL_DELEGATE_H_
 
+#include <map>
 #include <memory>
 #include <string>
 
 #include "base/files/file_path.h"
 #include "base/macros.h"
+#include "base/optional.h"
+#include "base/timer/timer.h"
 #include "components/prefs/pref_service.h"
 #include "content/public/browser/host_zoom_map.h"
 #include "content/public/browser/zoom_level_delegate.h"
@@ -27,7 +30,8 @@ namespace electron {
 // levels in HostZoomMap and preference system. All changes
 // to the per-partition default zoom levels flow through this
 // class. Any changes to per-host levels are updated when HostZoomMap calls
-// OnZoomLevelChanged.
+// OnZoomLevelChanged, and written to the preferences in batches, so that
+// zooming step by step does not update them for each step.
 class ZoomLevelDelegate : public content::ZoomLevelDelegate {
  public:
   static void RegisterPrefs(PrefRegistrySimple* pref_registry);
@@ -39,6 +43,9 @@ class ZoomLevelDelegate : public content::ZoomLevelDelegate {
   void SetDefaultZoomLevelPref(double level);
   double GetDefaultZoomLevelPref() const;
 
+  // Writes the pending per-host zoom levels to the preferences.
+  void CommitPendingZoomLevels();
+
   // content::ZoomLevelDelegate:
   void InitHostZoomMap(content::HostZoomMap* host_zoom_map) override;
 
@@ -56,6 +63,11 @@ class ZoomLevelDelegate : public content::ZoomLevelDelegate {
   std::unique_ptr<content::HostZoomMap::Subscription> zoom_subscription_;
   std::string partition_key_;
 
+  // The levels of the hosts changed since the last commit, null for the
+  // hosts which are back at the default level.
+  std::map<std::string, base::Optional<double>> pending_zoom_levels_;
+  base::OneShotTimer commit_timer_;
+
   DISALLOW_COPY_AND_ASSIGN(ZoomLevelDelegate);
 };
 
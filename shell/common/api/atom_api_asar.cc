@@ -4,10 +4,15 @@
 
 #include <stddef.h>
 
+#include <memory>
+#include <string>
+#include <utility>
 #include <vector>
 
 #include "shell/common/asar/archive.h"
 #include "shell/common/asar/asar_util.h"
+#include "shell/common/asar/extraction_cache.h"
+#include "shell/common/asar/readahead.h"
 #include "shell/common/gin_converters/callback_converter.h"
 #include "shell/common/gin_converters/file_path_converter.h"
 #include "shell/common/gin_helper/dictionary.h"
@@ -17,12 +22,23 @@
 #include "shell/common/node_util.h"
 namespace {
 
+v8::Local<v8::Value> StatsToV8(v8::Isolate* isolate,
+                               const asar::Archive::Stats& stats) {
+  gin_helper::Dictionary dict(isolate, v8::Object::New(isolate));
+  dict.Set("size", stats.size);
+  dict.Set("offset", stats.offset);
+  dict.Set("isFile", stats.is_file);
+  dict.Set("isDirectory", stats.is_directory);
+  dict.Set("isLink", stats.is_link);
+  return dict.GetHandle();
+}
+
 class Archive : public gin_helper::Wrappable<Archive> {
  public:
   static v8::Local<v8::Value> Create(v8::Isolate* isolate,
                                      const base::FilePath& path) {
-    auto archive = std::make_unique<asar::Archive>(path);
-    if (!archive->Init())
+    std::shared_ptr<asar::Archive> archive = asar::GetOrCreateAsarArchive(path);
+    if (!archive)
       return v8::False(isolate);
     return (new Archive(isolate, std::move(archive)))->GetWrapper();
   }
@@ -34,14 +50,18 @@ class Archive : public gin_helper::Wrappable<Archive> {
         .SetProperty("path", &Archive::GetPath)
         .SetMethod("getFileInfo", &Archive::GetFileInfo)
         .SetMethod("stat", &Archive::Stat)
+        .SetMethod("statBatch", &Archive::StatBatch)
+        .SetMethod("walk", &Archive::Walk)
         .SetMethod("readdir", &Archive::Readdir)
         .SetMethod("realpath", &Archive::Realpath)
         .SetMethod("copyFileOut", &Archive::CopyFileOut)
-        .SetMethod("getFd", &Archive::GetFD);
+        .SetMethod("read", &Archive::Read)
+        .SetMethod("getFd", &Archive::GetFD)
+        .SetMethod("recordRead", &Archive::RecordRead);
   }
 
  protected:
-  Archive(v8::Isolate* isolate, std::unique_ptr<asar::Archive> archive)
+  Archive(v8::Isolate* isolate, std::shared_ptr<asar::Archive> archive)
       : archive_(std::move(archive)) {
     Init(isolate);
   }
@@ -58,6 +78,7 @@ class Archive : public gin_helper::Wrappable<Archive> {
     gin_helper::Dictionary dict(isolate, v8::Object::New(isolate));
     dict.Set("size", info.size);
     dict.Set("unpacked", info.unpacked);
+    dict.Set("compressed", info.compressed);
     dict.Set("offset", info.offset);
     return dict.GetHandle();
   }
@@ -67,13 +88,40 @@ class Archive : public gin_helper::Wrappable<Archive> {
     asar::Archive::Stats stats;
     if (!archive_ || !archive_->Stat(path, &stats))
       return v8::False(isolate);
-    gin_helper::Dictionary dict(isolate, v8::Object::New(isolate));
-    dict.Set("size", stats.size);
-    dict.Set("offset", stats.offset);
-    dict.Set("isFile", stats.is_file);
-    dict.Set("isDirectory", stats.is_directory);
-    dict.Set("isLink", stats.is_link);
-    return dict.GetHandle();
+    return StatsToV8(isolate, stats);
+  }
+
+  // Returns the results of Stat() for all |paths| in one call.
+  v8::Local<v8::Value> StatBatch(v8::Isolate* isolate,
+                                 const std::vector<base::FilePath>& paths) {
+    v8::Local<v8::Context> context = isolate->GetCurrentContext();
+    v8::Local<v8::Array> results = v8::Array::New(isolate, paths.size());
+    for (size_t i = 0; i < paths.size(); ++i) {
+      asar::Archive::Stats stats;
+      v8::Local<v8::Value> result =
+          archive_ && archive_->Stat(paths[i], &stats)
+              ? StatsToV8(isolate, stats)
+              : v8::False(isolate).As<v8::Value>();
+      results->Set(context, i, result).Check();
+    }
+    return results;
+  }
+
+  // Returns the stats of the whole subtree of |path| in one call, as a list of
+  // stats objects that also have the path relative to the archive root.
+  v8::Local<v8::Value> Walk(v8::Isolate* isolate, const base::FilePath& path) {
+    std::vector<std::pair<base::FilePath, asar::Archive::Stats>> entries;
+    if (!archive_ || !archive_->Walk(path, &entries))
+      return v8::False(isolate);
+    v8::Local<v8::Context> context = isolate->GetCurrentContext();
+    v8::Local<v8::Array> results = v8::Array::New(isolate, entries.size());
+    for (size_t i = 0; i < entries.size(); ++i) {
+      v8::Local<v8::Value> stats = StatsToV8(isolate, entries[i].second);
+      gin_helper::Dictionary dict(isolate, stats.As<v8::Object>());
+      dict.Set("path", entries[i].first);
+      results->Set(context, i, stats).Check();
+    }
+    return results;
   }
 
   // Returns all files under a directory.
@@ -103,6 +151,30 @@ class Archive : public gin_helper::Wrappable<Archive> {
     return gin::ConvertToV8(isolate, new_path);
   }
 
+  // Reads a packed file into a new Buffer, either from the memory mapped
+  // archive or by decompressing it.
+  v8::Local<v8::Value> Read(v8::Isolate* isolate, const base::FilePath& path) {
+    asar::Archive::FileInfo info;
+    if (!archive_ || !archive_->GetFileInfo(path, &info))
+      return v8::False(isolate);
+
+    if (info.compressed) {
+      std::string contents;
+      if (!archive_->ReadFile(path, &contents))
+        return v8::False(isolate);
+      return node::Buffer::Copy(isolate, contents.data(), contents.size())
+          .ToLocalChecked();
+    }
+
+    base::span<const uint8_t> view;
+    if (!archive_->ReadView(path, &view))
+      return v8::False(isolate);
+    return node::Buffer::Copy(isolate,
+                              reinterpret_cast<const char*>(view.data()),
+                              view.size())
+        .ToLocalChecked();
+  }
+
   // Return the file descriptor.
   int GetFD() const {
     if (!archive_)
@@ -110,8 +182,14 @@ class Archive : public gin_helper::Wrappable<Archive> {
     return archive_->GetFD();
   }
 
+  // Logs a read made through the file descriptor for the startup readahead.
+  void RecordRead(uint64_t offset, uint64_t size) {
+    if (archive_)
+      asar::RecordArchiveRead(archive_->path(), offset, size);
+  }
+
  private:
-  std::unique_ptr<asar::Archive> archive_;
+  std::shared_ptr<asar::Archive> archive_;
 
   DISALLOW_COPY_AND_ASSIGN(Archive);
 };
@@ -140,6 +218,15 @@ v8::Local<v8::Value> SplitPath(v8::Isolate* isolate,
   return dict.GetHandle();
 }
 
+// The V8 code caches of the modules required from archives are kept next to
+// the extracted files.
+base::FilePath GetCodeCacheDir() {
+  base::FilePath dir = asar::GetExtractionCacheDir();
+  if (dir.empty())
+    return dir;
+  return dir.Append(FILE_PATH_LITERAL("Code Cache"));
+}
+
 void Initialize(v8::Local<v8::Object> exports,
                 v8::Local<v8::Value> unused,
                 v8::Local<v8::Context> context,
@@ -148,6 +235,7 @@ void Initialize(v8::Local<v8::Object> exports,
   dict.SetMethod("createArchive", &Archive::Create);
   dict.SetMethod("splitPath", &SplitPath);
   dict.SetMethod("initAsarSupport", &InitAsarSupport);
+  dict.SetMethod("getCodeCacheDir", &GetCodeCacheDir);
 }
 
 }  // namespace
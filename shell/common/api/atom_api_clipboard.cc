@@ -4,7 +4,11 @@
 
 #include "shell/common/api/atom_api_clipboard.h"
 
+#include <memory>
+#include <utility>
+
 #include "base/strings/utf_string_conversions.h"
+#include "shell/common/gin_converters/callback_converter.h"
 #include "shell/common/gin_converters/image_converter.h"
 #include "shell/common/gin_helper/dictionary.h"
 #include "shell/common/node_includes.h"
@@ -18,6 +22,25 @@ namespace electron {
 
 namespace api {
 
+namespace {
+
+void FreeString(char*, void* hint) {
+  delete static_cast<std::string*>(hint);
+}
+
+// Hands the data read from the clipboard to the Buffer without copying it.
+v8::Local<v8::Value> StringToBuffer(v8::Isolate* isolate, std::string data) {
+  if (data.empty())
+    return node::Buffer::New(isolate, 0).ToLocalChecked();
+  auto owned = std::make_unique<std::string>(std::move(data));
+  char* bytes = &(*owned)[0];
+  size_t size = owned->size();
+  return node::Buffer::New(isolate, bytes, size, &FreeString, owned.release())
+      .ToLocalChecked();
+}
+
+}  // namespace
+
 ui::ClipboardBuffer Clipboard::GetClipboardBuffer(gin_helper::Arguments* args) {
   std::string type;
   if (args->GetNext(&type) && type == "selection")
@@ -56,9 +79,7 @@ std::string Clipboard::Read(const std::string& format_string) {
 
 v8::Local<v8::Value> Clipboard::ReadBuffer(const std::string& format_string,
                                            gin_helper::Arguments* args) {
-  std::string data = Read(format_string);
-  return node::Buffer::Copy(args->isolate(), data.data(), data.length())
-      .ToLocalChecked();
+  return StringToBuffer(args->isolate(), Read(format_string));
 }
 
 void Clipboard::WriteBuffer(const std::string& format,
@@ -237,6 +258,10 @@ void Initialize(v8::Local<v8::Object> exports,
   dict.SetMethod("writeFindText", &electron::api::Clipboard::WriteFindText);
   dict.SetMethod("readBuffer", &electron::api::Clipboard::ReadBuffer);
   dict.SetMethod("writeBuffer", &electron::api::Clipboard::WriteBuffer);
+#if defined(OS_MACOSX)
+  dict.SetMethod("writeBufferLazily",
+                 &electron::api::Clipboard::WriteBufferLazily);
+#endif
   dict.SetMethod("clear", &electron::api::Clipboard::Clear);
 }
 
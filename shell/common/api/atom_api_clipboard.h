@@ -8,6 +8,7 @@
 #include <string>
 #include <vector>
 
+#include "base/callback.h"
 #include "ui/base/clipboard/clipboard.h"
 #include "ui/gfx/image/image.h"
 #include "v8/include/v8.h"
@@ -62,6 +63,13 @@ class Clipboard {
                           const v8::Local<v8::Value> buffer,
                           gin_helper::Arguments* args);
 
+#if defined(OS_MACOSX)
+  using DataProvider = base::RepeatingCallback<v8::Local<v8::Value>()>;
+  static void WriteBufferLazily(const std::string& format_string,
+                                const DataProvider& provider,
+                                gin_helper::Arguments* args);
+#endif
+
  private:
   DISALLOW_COPY_AND_ASSIGN(Clipboard);
 };
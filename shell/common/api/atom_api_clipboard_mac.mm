@@ -2,14 +2,78 @@
 // Use of this source code is governed by the MIT license that can be
 // found in the LICENSE file.
 
+#import <Cocoa/Cocoa.h>
+
 #include "base/strings/sys_string_conversions.h"
 #include "shell/common/api/atom_api_clipboard.h"
+#include "shell/common/gin_helper/arguments.h"
+#include "shell/common/gin_helper/locker.h"
+#include "shell/common/node_includes.h"
 #include "ui/base/cocoa/find_pasteboard.h"
 
+// Runs the provider of a format written lazily to the pasteboard, which only
+// asks for the data when an app reads the format.
+@interface ElectronPasteboardDataOwner : NSObject {
+ @private
+  v8::Isolate* isolate_;
+  electron::api::Clipboard::DataProvider provider_;
+}
+- (instancetype)initWithIsolate:(v8::Isolate*)isolate
+                       provider:(const electron::api::Clipboard::DataProvider&)
+                                    provider;
+@end
+
+@implementation ElectronPasteboardDataOwner
+
+- (instancetype)initWithIsolate:(v8::Isolate*)isolate
+                       provider:(const electron::api::Clipboard::DataProvider&)
+                                    provider {
+  if ((self = [super init])) {
+    isolate_ = isolate;
+    provider_ = provider;
+  }
+  return self;
+}
+
+- (void)pasteboard:(NSPasteboard*)pasteboard
+    provideDataForType:(NSString*)type {
+  if (provider_.is_null())
+    return;
+  gin_helper::Locker locker(isolate_);
+  v8::HandleScope handle_scope(isolate_);
+  v8::Local<v8::Value> buffer = provider_.Run();
+  if (!node::Buffer::HasInstance(buffer))
+    return;
+  [pasteboard setData:[NSData dataWithBytes:node::Buffer::Data(buffer)
+                                     length:node::Buffer::Length(buffer)]
+              forType:type];
+}
+
+// Another write replaced the data, which will not be asked for anymore.
+- (void)pasteboardChangedOwner:(NSPasteboard*)sender {
+  provider_.Reset();
+}
+
+@end
+
 namespace electron {
 
 namespace api {
 
+void Clipboard::WriteBufferLazily(const std::string& format_string,
+                                  const DataProvider& provider,
+                                  gin_helper::Arguments* args) {
+  // Only weakly referenced by the pasteboard, the owner lives until the next
+  // lazy write.
+  static ElectronPasteboardDataOwner* owner = nil;
+  [owner release];
+  owner = [[ElectronPasteboardDataOwner alloc] initWithIsolate:args->isolate()
+                                                      provider:provider];
+  NSString* type = base::SysUTF8ToNSString(format_string);
+  [[NSPasteboard generalPasteboard] declareTypes:[NSArray arrayWithObject:type]
+                                           owner:owner];
+}
+
 void Clipboard::WriteFindText(const base::string16& text) {
   NSString* text_ns = base::SysUTF16ToNSString(text);
   [[FindPasteboard sharedInstance] setFindText:text_ns];
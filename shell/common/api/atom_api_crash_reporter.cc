@@ -54,6 +54,9 @@ void Initialize(v8::Local<v8::Object> exports,
   dict.SetMethod(
       "getUploadedReports",
       base::BindRepeating(&CrashReporter::GetUploadedReports, reporter));
+  dict.SetMethod(
+      "_setDumpOptions",
+      base::BindRepeating(&CrashReporter::SetDumpOptions, reporter));
   dict.SetMethod(
       "setUploadToServer",
       base::BindRepeating(&CrashReporter::SetUploadToServer, reporter));
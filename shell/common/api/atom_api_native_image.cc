@@ -9,10 +9,13 @@
 #include <utility>
 #include <vector>
 
+#include "base/bind.h"
+#include "base/callback_helpers.h"
 #include "base/files/file_util.h"
 #include "base/strings/pattern.h"
 #include "base/strings/string_util.h"
 #include "base/strings/utf_string_conversions.h"
+#include "base/task/post_task.h"
 #include "base/threading/thread_restrictions.h"
 #include "net/base/data_url.h"
 #include "shell/common/asar/asar_util.h"
@@ -21,17 +24,24 @@
 #include "shell/common/gin_converters/gurl_converter.h"
 #include "shell/common/gin_converters/value_converter.h"
 #include "shell/common/gin_helper/dictionary.h"
+#include "shell/common/gin_helper/locker.h"
 #include "shell/common/gin_helper/object_template_builder.h"
+#include "shell/common/gin_helper/promise.h"
+#include "shell/common/native_image_cache.h"
 #include "shell/common/node_includes.h"
 #include "shell/common/skia_util.h"
 #include "third_party/skia/include/core/SkBitmap.h"
 #include "third_party/skia/include/core/SkImageInfo.h"
 #include "third_party/skia/include/core/SkPixelRef.h"
+#include "third_party/skia/include/core/SkPixmap.h"
+#include "third_party/skia/include/core/SkStream.h"
+#include "third_party/skia/include/encode/SkWebpEncoder.h"
 #include "ui/base/layout.h"
 #include "ui/base/webui/web_ui_util.h"
 #include "ui/gfx/codec/jpeg_codec.h"
 #include "ui/gfx/codec/png_codec.h"
 #include "ui/gfx/geometry/size.h"
+#include "ui/gfx/geometry/size_conversions.h"
 #include "ui/gfx/image/image_skia.h"
 #include "ui/gfx/image/image_skia_operations.h"
 #include "ui/gfx/image/image_util.h"
@@ -100,6 +110,207 @@ base::win::ScopedHICON ReadICOFromPath(int size, const base::FilePath& path) {
 
 void Noop(char*, void*) {}
 
+// The smallest mipmap created by default.
+const int kMinMipmapSize = 16;
+
+// Scales each rep with the bilinear filter of Skia, which is much faster than
+// the convolution of skia::ImageOperations, at the cost of some sharpness.
+gfx::ImageSkia CreateFastResizedImage(const gfx::ImageSkia& image,
+                                      const gfx::Size& size) {
+  gfx::ImageSkia resized;
+  for (const gfx::ImageSkiaRep& rep : image.image_reps()) {
+    gfx::Size pixel_size = gfx::ScaleToRoundedSize(size, rep.scale());
+    SkPixmap source;
+    SkBitmap bitmap;
+    SkPixmap destination;
+    if (pixel_size.IsEmpty() || !rep.GetBitmap().peekPixels(&source) ||
+        !bitmap.tryAllocPixels(source.info().makeWH(pixel_size.width(),
+                                                    pixel_size.height())) ||
+        !bitmap.peekPixels(&destination) ||
+        !source.scalePixels(destination, kLow_SkFilterQuality))
+      continue;
+    resized.AddRepresentation(gfx::ImageSkiaRep(bitmap, rep.scale()));
+  }
+  return resized;
+}
+
+int64_t GetImageSkiaSize(const gfx::ImageSkia& image) {
+  int64_t size = 0;
+  for (const gfx::ImageSkiaRep& rep : image.image_reps())
+    size += rep.GetBitmap().computeByteSize();
+  return size;
+}
+
+using ValuePromise = gin_helper::Promise<v8::Local<v8::Value>>;
+using EncodedData = std::vector<unsigned char>;
+
+void FreeEncodedData(char*, void* hint) {
+  delete static_cast<EncodedData*>(hint);
+}
+
+std::unique_ptr<EncodedData> EncodePNG(const SkBitmap& bitmap) {
+  auto output = std::make_unique<EncodedData>();
+  gfx::PNGCodec::EncodeBGRASkBitmap(bitmap, false, output.get());
+  return output;
+}
+
+std::unique_ptr<EncodedData> EncodeJPEG(const SkBitmap& bitmap, int quality) {
+  auto output = std::make_unique<EncodedData>();
+  if (!gfx::JPEGCodec::Encode(bitmap, quality, output.get()))
+    output->clear();
+  return output;
+}
+
+// Encodes straight into the data the Buffer takes.
+class EncodedDataStream : public SkWStream {
+ public:
+  explicit EncodedDataStream(EncodedData* data) : data_(data) {}
+  ~EncodedDataStream() override = default;
+
+  // SkWStream:
+  bool write(const void* buffer, size_t size) override {
+    const auto* bytes = static_cast<const unsigned char*>(buffer);
+    data_->insert(data_->end(), bytes, bytes + size);
+    return true;
+  }
+  size_t bytesWritten() const override { return data_->size(); }
+
+ private:
+  EncodedData* data_;
+
+  DISALLOW_COPY_AND_ASSIGN(EncodedDataStream);
+};
+
+std::unique_ptr<EncodedData> EncodeWebP(const SkBitmap& bitmap,
+                                        SkWebpEncoder::Options options) {
+  auto output = std::make_unique<EncodedData>();
+  SkPixmap pixmap;
+  EncodedDataStream stream(output.get());
+  if (!bitmap.peekPixels(&pixmap) ||
+      !SkWebpEncoder::Encode(&stream, pixmap, options))
+    output->clear();
+  return output;
+}
+
+// Reads the options of toWebP, returns false when they are invalid.
+bool GetWebPOptions(gin::Arguments* args,
+                    SkWebpEncoder::Options* webp_options,
+                    float* scale_factor) {
+  *scale_factor = 1.0f;
+  webp_options->fQuality = 80.0f;
+  gin_helper::Dictionary options;
+  if (!args->GetNext(&options))
+    return true;
+  options.Get("scaleFactor", scale_factor);
+  bool lossless = false;
+  if (options.Get("lossless", &lossless) && lossless)
+    webp_options->fCompression = SkWebpEncoder::Compression::kLossless;
+  double quality;
+  if (options.Get("quality", &quality)) {
+    if (quality < 0 || quality > 100)
+      return false;
+    webp_options->fQuality = static_cast<float>(quality);
+  }
+  return true;
+}
+
+// The Buffer takes the ownership of the encoded data instead of copying it.
+v8::Local<v8::Value> BufferFromEncodedData(v8::Isolate* isolate,
+                                           std::unique_ptr<EncodedData> data) {
+  if (data->empty())
+    return node::Buffer::New(isolate, 0).ToLocalChecked();
+  char* bytes = reinterpret_cast<char*>(data->data());
+  size_t size = data->size();
+  return node::Buffer::New(isolate, bytes, size, &FreeEncodedData,
+                           data.release())
+      .ToLocalChecked();
+}
+
+void ResolveWithEncodedData(ValuePromise promise,
+                            std::unique_ptr<EncodedData> data) {
+  v8::Isolate* isolate = promise.isolate();
+  gin_helper::Locker locker(isolate);
+  v8::HandleScope handle_scope(isolate);
+  v8::Context::Scope context_scope(promise.GetContext());
+  promise.Resolve(BufferFromEncodedData(isolate, std::move(data)));
+}
+
+void PostEncodeTask(ValuePromise promise,
+                    base::OnceCallback<std::unique_ptr<EncodedData>()> task) {
+  base::PostTaskAndReplyWithResult(
+      FROM_HERE, {base::ThreadPool(), base::TaskPriority::USER_VISIBLE},
+      std::move(task),
+      base::BindOnce(&ResolveWithEncodedData, std::move(promise)));
+}
+
+// The reps are decoded off the main thread, so the storage of the image is
+// detached from the decoding sequence before it is handed back.
+gfx::ImageSkia MakeThreadSafe(gfx::ImageSkia image_skia) {
+  if (!image_skia.isNull())
+    image_skia.MakeThreadSafe();
+  return image_skia;
+}
+
+gfx::ImageSkia DecodePath(const base::FilePath& path) {
+  return MakeThreadSafe(NativeImageCache::GetInstance()->GetImage(path));
+}
+
+gfx::ImageSkia DecodeBuffer(std::string data,
+                            int width,
+                            int height,
+                            double scale_factor) {
+  gfx::ImageSkia image_skia;
+  electron::util::AddImageSkiaRepFromBuffer(
+      &image_skia, reinterpret_cast<const unsigned char*>(data.data()),
+      data.size(), width, height, scale_factor);
+  return MakeThreadSafe(std::move(image_skia));
+}
+
+gfx::ImageSkia DecodeDataURL(const GURL& url) {
+  gfx::ImageSkia image_skia;
+  std::string mime_type, charset, data;
+  if (net::DataURL::Parse(url, &mime_type, &charset, &data)) {
+    auto* data_ptr = reinterpret_cast<const unsigned char*>(data.c_str());
+    if (mime_type == "image/png") {
+      electron::util::AddImageSkiaRepFromPNG(&image_skia, data_ptr,
+                                             data.size(), 1.0);
+    } else if (mime_type == "image/jpeg") {
+      electron::util::AddImageSkiaRepFromJPEG(&image_skia, data_ptr,
+                                              data.size(), 1.0);
+    } else if (mime_type == "image/webp") {
+      electron::util::AddImageSkiaRepFromWebP(&image_skia, data_ptr,
+                                              data.size(), 1.0);
+    }
+  }
+  return MakeThreadSafe(std::move(image_skia));
+}
+
+// Runs |task| on the thread pool and resolves |promise| with the image it
+// decodes, |created| is then called with the NativeImage.
+void PostDecodeTask(
+    ValuePromise promise,
+    base::OnceCallback<gfx::ImageSkia()> task,
+    base::OnceCallback<void(NativeImage*)> created = base::DoNothing()) {
+  base::PostTaskAndReplyWithResult(
+      FROM_HERE,
+      {base::ThreadPool(), base::MayBlock(), base::TaskPriority::USER_VISIBLE},
+      std::move(task),
+      base::BindOnce(
+          [](ValuePromise promise,
+             base::OnceCallback<void(NativeImage*)> created,
+             gfx::ImageSkia image_skia) {
+            v8::Isolate* isolate = promise.isolate();
+            gin_helper::Locker locker(isolate);
+            v8::HandleScope handle_scope(isolate);
+            v8::Context::Scope context_scope(promise.GetContext());
+            gin::Handle<NativeImage> handle =
+                NativeImage::Create(isolate, gfx::Image(image_skia));
+            std::move(created).Run(handle.get());
+            promise.Resolve(handle.ToV8());
+          },
+          std::move(promise), std::move(created)));
+}
+
 }  // namespace
 
 NativeImage::NativeImage(v8::Isolate* isolate, const gfx::Image& image)
@@ -127,6 +338,8 @@ NativeImage::NativeImage(v8::Isolate* isolate, const base::FilePath& hicon_path)
 #endif
 
 NativeImage::~NativeImage() {
+  if (mipmaps_size_)
+    isolate()->AdjustAmountOfExternalAllocatedMemory(-mipmaps_size_);
   if (image_.HasRepresentation(gfx::Image::kImageRepSkia)) {
     isolate()->AdjustAmountOfExternalAllocatedMemory(-static_cast<int64_t>(
         image_.ToImageSkia()->bitmap()->computeByteSize()));
@@ -200,6 +413,78 @@ v8::Local<v8::Value> NativeImage::ToJPEG(v8::Isolate* isolate, int quality) {
       .ToLocalChecked();
 }
 
+v8::Local<v8::Promise> NativeImage::ToPNGAsync(gin::Arguments* args) {
+  ValuePromise promise(args->isolate());
+  v8::Local<v8::Promise> handle = promise.GetHandle();
+  float scale_factor = GetScaleFactorFromOptions(args);
+
+  if (scale_factor == 1.0f) {
+    // Use raw 1x PNG bytes when available
+    scoped_refptr<base::RefCountedMemory> png = image_.As1xPNGBytes();
+    if (png->size() > 0) {
+      const char* data = reinterpret_cast<const char*>(png->front());
+      promise.Resolve(
+          node::Buffer::Copy(args->isolate(), data, png->size())
+              .ToLocalChecked());
+      return handle;
+    }
+  }
+
+  // The bitmap shares the pixels of the image instead of copying them.
+  const SkBitmap bitmap =
+      image_.AsImageSkia().GetRepresentation(scale_factor).GetBitmap();
+  PostEncodeTask(std::move(promise), base::BindOnce(&EncodePNG, bitmap));
+  return handle;
+}
+
+v8::Local<v8::Promise> NativeImage::ToJPEGAsync(v8::Isolate* isolate,
+                                                int quality) {
+  ValuePromise promise(isolate);
+  v8::Local<v8::Promise> handle = promise.GetHandle();
+
+  // Like gfx::JPEG1xEncodedDataFromImage, only the 1x rep is encoded.
+  const gfx::ImageSkiaRep& rep = image_.AsImageSkia().GetRepresentation(1.0f);
+  if (rep.scale() != 1.0f || !rep.GetBitmap().readyToDraw()) {
+    promise.Resolve(node::Buffer::New(isolate, 0).ToLocalChecked());
+    return handle;
+  }
+
+  PostEncodeTask(std::move(promise),
+                 base::BindOnce(&EncodeJPEG, rep.GetBitmap(), quality));
+  return handle;
+}
+
+v8::Local<v8::Value> NativeImage::ToWebP(gin::Arguments* args) {
+  SkWebpEncoder::Options options;
+  float scale_factor;
+  if (!GetWebPOptions(args, &options, &scale_factor)) {
+    args->ThrowTypeError("quality must be between 0 and 100");
+    return v8::Undefined(args->isolate());
+  }
+
+  const SkBitmap bitmap =
+      image_.AsImageSkia().GetRepresentation(scale_factor).GetBitmap();
+  return BufferFromEncodedData(args->isolate(), EncodeWebP(bitmap, options));
+}
+
+v8::Local<v8::Promise> NativeImage::ToWebPAsync(gin::Arguments* args) {
+  ValuePromise promise(args->isolate());
+  v8::Local<v8::Promise> handle = promise.GetHandle();
+
+  SkWebpEncoder::Options options;
+  float scale_factor;
+  if (!GetWebPOptions(args, &options, &scale_factor)) {
+    promise.RejectWithErrorMessage("quality must be between 0 and 100");
+    return handle;
+  }
+
+  const SkBitmap bitmap =
+      image_.AsImageSkia().GetRepresentation(scale_factor).GetBitmap();
+  PostEncodeTask(std::move(promise),
+                 base::BindOnce(&EncodeWebP, bitmap, options));
+  return handle;
+}
+
 std::string NativeImage::ToDataURL(gin::Arguments* args) {
   float scale_factor = GetScaleFactorFromOptions(args);
 
@@ -279,14 +564,26 @@ gin::Handle<NativeImage> NativeImage::Resize(v8::Isolate* isolate,
     size = gfx::ScaleToRoundedSize(size, GetAspectRatio(), 1.f);
   }
 
+  // The mipmaps are served whatever the quality, they share their reps.
+  auto mipmap = mipmaps_.find(std::make_pair(size.width(), size.height()));
+  if (mipmap != mipmaps_.end()) {
+    return gin::CreateHandle(
+        isolate, new NativeImage(isolate, gfx::Image(mipmap->second)));
+  }
+
   skia::ImageOperations::ResizeMethod method =
       skia::ImageOperations::ResizeMethod::RESIZE_BEST;
   std::string quality;
   options.GetString("quality", &quality);
-  if (quality == "good")
+  if (quality == "fast") {
+    gfx::ImageSkia resized = CreateFastResizedImage(image_.AsImageSkia(), size);
+    return gin::CreateHandle(isolate,
+                             new NativeImage(isolate, gfx::Image(resized)));
+  } else if (quality == "good") {
     method = skia::ImageOperations::ResizeMethod::RESIZE_GOOD;
-  else if (quality == "better")
+  } else if (quality == "better") {
     method = skia::ImageOperations::ResizeMethod::RESIZE_BETTER;
+  }
 
   gfx::ImageSkia resized = gfx::ImageSkiaOperations::CreateResizedImage(
       image_.AsImageSkia(), method, size);
@@ -294,6 +591,44 @@ gin::Handle<NativeImage> NativeImage::Resize(v8::Isolate* isolate,
                            new NativeImage(isolate, gfx::Image(resized)));
 }
 
+void NativeImage::CreateMipmaps(gin::Arguments* args) {
+  if (IsEmpty())
+    return;
+
+  std::vector<gfx::Size> sizes;
+  if (!args->GetNext(&sizes)) {
+    // Halve the image down to the smallest size.
+    gfx::Size size = GetSize();
+    while (size.width() / 2 >= kMinMipmapSize &&
+           size.height() / 2 >= kMinMipmapSize) {
+      size = gfx::Size(size.width() / 2, size.height() / 2);
+      sizes.push_back(size);
+    }
+  }
+
+  const gfx::ImageSkia& image_skia = image_.AsImageSkia();
+  int64_t mipmaps_size = 0;
+  for (const gfx::Size& size : sizes) {
+    if (size.IsEmpty())
+      continue;
+    gfx::ImageSkia resized = gfx::ImageSkiaOperations::CreateResizedImage(
+        image_skia, skia::ImageOperations::ResizeMethod::RESIZE_BEST, size);
+    // Resize the reps now, at the scales of the image, instead of when they
+    // are first used.
+    for (const gfx::ImageSkiaRep& rep : image_skia.image_reps())
+      resized.GetRepresentation(rep.scale());
+    auto key = std::make_pair(size.width(), size.height());
+    auto it = mipmaps_.find(key);
+    if (it != mipmaps_.end())
+      mipmaps_size -= GetImageSkiaSize(it->second);
+    mipmaps_size += GetImageSkiaSize(resized);
+    mipmaps_[key] = resized;
+  }
+
+  isolate()->AdjustAmountOfExternalAllocatedMemory(mipmaps_size);
+  mipmaps_size_ += mipmaps_size;
+}
+
 gin::Handle<NativeImage> NativeImage::Crop(v8::Isolate* isolate,
                                            const gfx::Rect& rect) {
   gfx::ImageSkia cropped =
@@ -312,6 +647,16 @@ void NativeImage::AddRepresentation(const gin_helper::Dictionary& options) {
 
   bool skia_rep_added = false;
   gfx::ImageSkia image_skia = image_.AsImageSkia();
+  // The images decoded off the main thread, or shared by the cache, are read
+  // only, so the reps are added to a copy.
+  bool copied = false;
+  if (!image_skia.isNull() && !image_skia.CanModify()) {
+    gfx::ImageSkia copy;
+    for (const gfx::ImageSkiaRep& rep : image_skia.image_reps())
+      copy.AddRepresentation(rep);
+    image_skia = copy;
+    copied = true;
+  }
 
   v8::Local<v8::Value> buffer;
   GURL url;
@@ -330,12 +675,22 @@ void NativeImage::AddRepresentation(const gin_helper::Dictionary& options) {
       } else if (mime_type == "image/jpeg") {
         skia_rep_added = electron::util::AddImageSkiaRepFromJPEG(
             &image_skia, data_ptr, data.size(), scale_factor);
+      } else if (mime_type == "image/webp") {
+        skia_rep_added = electron::util::AddImageSkiaRepFromWebP(
+            &image_skia, data_ptr, data.size(), scale_factor);
       }
     }
   }
 
+  // The mipmaps no longer match the reps of the image.
+  if (skia_rep_added && !mipmaps_.empty()) {
+    mipmaps_.clear();
+    isolate()->AdjustAmountOfExternalAllocatedMemory(-mipmaps_size_);
+    mipmaps_size_ = 0;
+  }
+
   // Re-initialize image when first representation is added to an empty image
-  if (skia_rep_added && IsEmpty()) {
+  if (skia_rep_added && (IsEmpty() || copied)) {
     gfx::Image image(image_skia);
     image_ = std::move(image);
   }
@@ -378,6 +733,17 @@ gin::Handle<NativeImage> NativeImage::CreateFromJPEG(v8::Isolate* isolate,
   return Create(isolate, image);
 }
 
+// static
+gin::Handle<NativeImage> NativeImage::CreateFromWebP(v8::Isolate* isolate,
+                                                     const char* buffer,
+                                                     size_t length) {
+  gfx::ImageSkia image_skia;
+  electron::util::AddImageSkiaRepFromWebP(
+      &image_skia, reinterpret_cast<const unsigned char*>(buffer), length,
+      1.0);
+  return Create(isolate, gfx::Image(image_skia));
+}
+
 // static
 gin::Handle<NativeImage> NativeImage::CreateFromPath(
     v8::Isolate* isolate,
@@ -388,8 +754,8 @@ gin::Handle<NativeImage> NativeImage::CreateFromPath(
     return gin::CreateHandle(isolate, new NativeImage(isolate, image_path));
   }
 #endif
-  gfx::ImageSkia image_skia;
-  electron::util::PopulateImageSkiaRepsFromPath(&image_skia, image_path);
+  gfx::ImageSkia image_skia =
+      NativeImageCache::GetInstance()->GetImage(image_path);
   gfx::Image image(image_skia);
   gin::Handle<NativeImage> handle = Create(isolate, image);
 #if defined(OS_MACOSX)
@@ -484,11 +850,23 @@ gin::Handle<NativeImage> NativeImage::CreateFromDataURL(v8::Isolate* isolate,
       return CreateFromPNG(isolate, data.c_str(), data.size());
     else if (mime_type == "image/jpeg")
       return CreateFromJPEG(isolate, data.c_str(), data.size());
+    else if (mime_type == "image/webp")
+      return CreateFromWebP(isolate, data.c_str(), data.size());
   }
 
   return CreateEmpty(isolate);
 }
 
+// static
+void NativeImage::SetCacheSize(uint32_t size) {
+  NativeImageCache::GetInstance()->SetMaxSize(size);
+}
+
+// static
+void NativeImage::ClearCache() {
+  NativeImageCache::GetInstance()->Clear();
+}
+
 #if !defined(OS_MACOSX)
 gin::Handle<NativeImage> NativeImage::CreateFromNamedImage(
     gin::Arguments* args,
@@ -497,6 +875,74 @@ gin::Handle<NativeImage> NativeImage::CreateFromNamedImage(
 }
 #endif
 
+// static
+v8::Local<v8::Promise> NativeImage::CreateFromPathAsync(
+    v8::Isolate* isolate,
+    const base::FilePath& path) {
+  ValuePromise promise(isolate);
+  v8::Local<v8::Promise> handle = promise.GetHandle();
+
+  base::FilePath image_path = NormalizePath(path);
+#if defined(OS_WIN)
+  // The icons are loaded by size when they are used.
+  if (image_path.MatchesExtension(FILE_PATH_LITERAL(".ico"))) {
+    promise.Resolve(CreateFromPath(isolate, image_path).ToV8());
+    return handle;
+  }
+#endif
+  base::OnceCallback<void(NativeImage*)> created = base::DoNothing();
+#if defined(OS_MACOSX)
+  if (IsTemplateFilename(image_path)) {
+    created = base::BindOnce(
+        [](NativeImage* image) { image->SetTemplateImage(true); });
+  }
+#endif
+  PostDecodeTask(std::move(promise), base::BindOnce(&DecodePath, image_path),
+                 std::move(created));
+  return handle;
+}
+
+// static
+v8::Local<v8::Promise> NativeImage::CreateFromBufferAsync(
+    v8::Local<v8::Value> buffer,
+    gin::Arguments* args) {
+  ValuePromise promise(args->isolate());
+  v8::Local<v8::Promise> handle = promise.GetHandle();
+
+  if (!node::Buffer::HasInstance(buffer)) {
+    promise.RejectWithErrorMessage("buffer must be a node Buffer");
+    return handle;
+  }
+
+  int width = 0;
+  int height = 0;
+  double scale_factor = 1.;
+
+  gin_helper::Dictionary options;
+  if (args->GetNext(&options)) {
+    options.Get("width", &width);
+    options.Get("height", &height);
+    options.Get("scaleFactor", &scale_factor);
+  }
+
+  // The Buffer may be changed by JavaScript while the image is decoded.
+  std::string data(node::Buffer::Data(buffer), node::Buffer::Length(buffer));
+  PostDecodeTask(std::move(promise),
+                 base::BindOnce(&DecodeBuffer, std::move(data), width, height,
+                                scale_factor));
+  return handle;
+}
+
+// static
+v8::Local<v8::Promise> NativeImage::CreateFromDataURLAsync(
+    v8::Isolate* isolate,
+    const GURL& url) {
+  ValuePromise promise(isolate);
+  v8::Local<v8::Promise> handle = promise.GetHandle();
+  PostDecodeTask(std::move(promise), base::BindOnce(&DecodeDataURL, url));
+  return handle;
+}
+
 // static
 void NativeImage::BuildPrototype(v8::Isolate* isolate,
                                  v8::Local<v8::FunctionTemplate> prototype) {
@@ -504,6 +950,10 @@ void NativeImage::BuildPrototype(v8::Isolate* isolate,
   gin_helper::ObjectTemplateBuilder(isolate, prototype->PrototypeTemplate())
       .SetMethod("toPNG", &NativeImage::ToPNG)
       .SetMethod("toJPEG", &NativeImage::ToJPEG)
+      .SetMethod("toPNGAsync", &NativeImage::ToPNGAsync)
+      .SetMethod("toJPEGAsync", &NativeImage::ToJPEGAsync)
+      .SetMethod("toWebP", &NativeImage::ToWebP)
+      .SetMethod("toWebPAsync", &NativeImage::ToWebPAsync)
       .SetMethod("toBitmap", &NativeImage::ToBitmap)
       .SetMethod("getBitmap", &NativeImage::GetBitmap)
       .SetMethod("getNativeHandle", &NativeImage::GetNativeHandle)
@@ -516,6 +966,7 @@ void NativeImage::BuildPrototype(v8::Isolate* isolate,
                    &NativeImage::SetTemplateImage)
       .SetMethod("resize", &NativeImage::Resize)
       .SetMethod("crop", &NativeImage::Crop)
+      .SetMethod("createMipmaps", &NativeImage::CreateMipmaps)
       .SetMethod("getAspectRatio", &NativeImage::GetAspectRatio)
       .SetMethod("addRepresentation", &NativeImage::AddRepresentation);
 }
@@ -588,6 +1039,14 @@ void Initialize(v8::Local<v8::Object> exports,
   native_image.SetMethod("createFromDataURL", &NativeImage::CreateFromDataURL);
   native_image.SetMethod("createFromNamedImage",
                          &NativeImage::CreateFromNamedImage);
+  native_image.SetMethod("setCacheSize", &NativeImage::SetCacheSize);
+  native_image.SetMethod("clearCache", &NativeImage::ClearCache);
+  native_image.SetMethod("createFromPathAsync",
+                         &NativeImage::CreateFromPathAsync);
+  native_image.SetMethod("createFromBufferAsync",
+                         &NativeImage::CreateFromBufferAsync);
+  native_image.SetMethod("createFromDataURLAsync",
+                         &NativeImage::CreateFromDataURLAsync);
 }
 
 }  // namespace
@@ -7,6 +7,8 @@
 
 #include <map>
 #include <string>
+#include <utility>
+#include <vector>
 
 #include "base/values.h"
 #include "gin/handle.h"
@@ -49,6 +51,9 @@ class NativeImage : public gin_helper::Wrappable<NativeImage> {
   static gin::Handle<NativeImage> CreateFromJPEG(v8::Isolate* isolate,
                                                  const char* buffer,
                                                  size_t length);
+  static gin::Handle<NativeImage> CreateFromWebP(v8::Isolate* isolate,
+                                                 const char* buffer,
+                                                 size_t length);
   static gin::Handle<NativeImage> CreateFromPath(v8::Isolate* isolate,
                                                  const base::FilePath& path);
   static gin::Handle<NativeImage> CreateFromBitmap(
@@ -64,6 +69,20 @@ class NativeImage : public gin_helper::Wrappable<NativeImage> {
   static gin::Handle<NativeImage> CreateFromNamedImage(gin::Arguments* args,
                                                        const std::string& name);
 
+  // Configure the cache of the images decoded from paths.
+  static void SetCacheSize(uint32_t size);
+  static void ClearCache();
+
+  // Decode the image on the thread pool, and resolve with the NativeImage.
+  static v8::Local<v8::Promise> CreateFromPathAsync(
+      v8::Isolate* isolate,
+      const base::FilePath& path);
+  static v8::Local<v8::Promise> CreateFromBufferAsync(
+      v8::Local<v8::Value> buffer,
+      gin::Arguments* args);
+  static v8::Local<v8::Promise> CreateFromDataURLAsync(v8::Isolate* isolate,
+                                                       const GURL& url);
+
   static void BuildPrototype(v8::Isolate* isolate,
                              v8::Local<v8::FunctionTemplate> prototype);
 
@@ -83,12 +102,18 @@ class NativeImage : public gin_helper::Wrappable<NativeImage> {
  private:
   v8::Local<v8::Value> ToPNG(gin::Arguments* args);
   v8::Local<v8::Value> ToJPEG(v8::Isolate* isolate, int quality);
+  // Encode on the thread pool, and resolve with the Buffer.
+  v8::Local<v8::Promise> ToPNGAsync(gin::Arguments* args);
+  v8::Local<v8::Promise> ToJPEGAsync(v8::Isolate* isolate, int quality);
+  v8::Local<v8::Value> ToWebP(gin::Arguments* args);
+  v8::Local<v8::Promise> ToWebPAsync(gin::Arguments* args);
   v8::Local<v8::Value> ToBitmap(gin::Arguments* args);
   v8::Local<v8::Value> GetBitmap(gin::Arguments* args);
   v8::Local<v8::Value> GetNativeHandle(gin_helper::ErrorThrower thrower);
   gin::Handle<NativeImage> Resize(v8::Isolate* isolate,
                                   base::DictionaryValue options);
   gin::Handle<NativeImage> Crop(v8::Isolate* isolate, const gfx::Rect& rect);
+  void CreateMipmaps(gin::Arguments* args);
   std::string ToDataURL(gin::Arguments* args);
   bool IsEmpty();
   gfx::Size GetSize();
@@ -107,6 +132,11 @@ class NativeImage : public gin_helper::Wrappable<NativeImage> {
 
   gfx::Image image_;
 
+  // The resized images created by CreateMipmaps, by size, which share their
+  // reps with the images Resize returns.
+  std::map<std::pair<int, int>, gfx::ImageSkia> mipmaps_;
+  int64_t mipmaps_size_ = 0;
+
   DISALLOW_COPY_AND_ASSIGN(NativeImage);
 };
 
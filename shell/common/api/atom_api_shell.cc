@@ -3,7 +3,12 @@
 // found in the LICENSE file.
 
 #include <string>
+#include <utility>
+#include <vector>
 
+#include "base/no_destructor.h"
+#include "base/sequenced_task_runner.h"
+#include "base/task/post_task.h"
 #include "shell/common/gin_converters/callback_converter.h"
 #include "shell/common/gin_converters/file_path_converter.h"
 #include "shell/common/gin_converters/gurl_converter.h"
@@ -94,6 +99,44 @@ bool MoveItemToTrash(gin::Arguments* args) {
   return platform_util::MoveItemToTrash(full_path, delete_on_fail);
 }
 
+// The calls which may block on the OS are made one after the other on their
+// own sequence, so that a slow volume delays neither the calling thread nor
+// the other tasks of the thread pool. They may wait for a child process, like
+// the trash command on Linux.
+scoped_refptr<base::SequencedTaskRunner> GetBlockingTaskRunner() {
+  static base::NoDestructor<scoped_refptr<base::SequencedTaskRunner>>
+      task_runner(base::CreateSequencedTaskRunner(
+          {base::ThreadPool(), base::MayBlock(), base::WithBaseSyncPrimitives(),
+           base::TaskPriority::USER_VISIBLE,
+           base::TaskShutdownBehavior::CONTINUE_ON_SHUTDOWN}));
+  return *task_runner;
+}
+
+v8::Local<v8::Promise> TrashItems(gin::Arguments* args) {
+  gin_helper::Promise<std::vector<bool>> promise(args->isolate());
+  v8::Local<v8::Promise> handle = promise.GetHandle();
+
+  std::vector<base::FilePath> paths;
+  if (!args->GetNext(&paths)) {
+    promise.RejectWithErrorMessage("paths must be an array of strings");
+    return handle;
+  }
+  bool delete_on_fail = false;
+  gin::Dictionary options(nullptr);
+  if (args->GetNext(&options))
+    options.Get("deleteOnFail", &delete_on_fail);
+
+  base::PostTaskAndReplyWithResult(
+      GetBlockingTaskRunner().get(), FROM_HERE,
+      base::BindOnce(&platform_util::MoveItemsToTrash, std::move(paths),
+                     delete_on_fail),
+      base::BindOnce(
+          [](gin_helper::Promise<std::vector<bool>> promise,
+             std::vector<bool> trashed) { promise.Resolve(trashed); },
+          std::move(promise)));
+  return handle;
+}
+
 #if defined(OS_WIN)
 bool WriteShortcutLink(const base::FilePath& shortcut_path,
                        gin_helper::Arguments* args) {
@@ -158,6 +201,7 @@ void Initialize(v8::Local<v8::Object> exports,
   dict.SetMethod("openPath", &OpenPath);
   dict.SetMethod("openExternal", &OpenExternal);
   dict.SetMethod("moveItemToTrash", &MoveItemToTrash);
+  dict.SetMethod("trashItems", &TrashItems);
   dict.SetMethod("beep", &platform_util::Beep);
 #if defined(OS_WIN)
   dict.SetMethod("writeShortcutLink", &WriteShortcutLink);
@@ -11,6 +11,7 @@
 #include "shell/common/gin_converters/gurl_converter.h"
 #include "shell/common/gin_helper/dictionary.h"
 #include "shell/common/node_includes.h"
+#include "shell/common/startup_timeline.h"
 #include "url/origin.h"
 #include "v8/include/v8-profiler.h"
 
@@ -135,6 +136,8 @@ void Initialize(v8::Local<v8::Object> exports,
   dict.SetMethod("requestGarbageCollectionForTesting",
                  &RequestGarbageCollectionForTesting);
   dict.SetMethod("isSameOrigin", &IsSameOrigin);
+  dict.SetMethod("beginStartupPhase", &electron::BeginStartupPhase);
+  dict.SetMethod("endStartupPhase", &electron::EndStartupPhase);
 }
 
 }  // namespace
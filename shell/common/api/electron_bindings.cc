@@ -14,6 +14,7 @@
 #include "base/process/process.h"
 #include "base/process/process_handle.h"
 #include "base/process/process_metrics_iocounters.h"
+#include "base/strings/stringprintf.h"
 #include "base/system/sys_info.h"
 #include "base/threading/thread_restrictions.h"
 #include "chrome/common/chrome_version.h"
@@ -27,7 +28,9 @@
 #include "shell/common/gin_helper/locker.h"
 #include "shell/common/gin_helper/promise.h"
 #include "shell/common/heap_snapshot.h"
+#include "shell/common/node_bindings.h"
 #include "shell/common/node_includes.h"
+#include "shell/common/startup_timeline.h"
 #include "third_party/blink/renderer/platform/heap/process_heap.h"  // nogncheck
 
 namespace electron {
@@ -47,6 +50,7 @@ ElectronBindings::ElectronBindings(uv_loop_t* loop) {
   uv_async_init(loop, &call_next_tick_async_, OnCallNextTick);
   call_next_tick_async_.data = this;
   metrics_ = base::ProcessMetrics::CreateCurrentProcessMetrics();
+  last_uv_metrics_time_ = base::TimeTicks::Now();
 }
 
 ElectronBindings::~ElectronBindings() {
@@ -69,9 +73,13 @@ void ElectronBindings::BindProcess(v8::Isolate* isolate,
   process->SetMethod("getSystemVersion",
                      &base::SysInfo::OperatingSystemVersion);
   process->SetMethod("getIOCounters", &GetIOCounters);
+  process->SetMethod("getStartupTimeline", &GetStartupTimeline);
   process->SetMethod("getCPUUsage",
                      base::BindRepeating(&ElectronBindings::GetCPUUsage,
                                          base::Unretained(metrics)));
+  process->SetMethod("writeStatistics",
+                     base::BindRepeating(&ElectronBindings::WriteStatistics,
+                                         base::Unretained(metrics)));
 
 #if defined(MAS_BUILD)
   process->SetReadOnly("mas", true);
@@ -97,6 +105,9 @@ void ElectronBindings::BindTo(v8::Isolate* isolate,
   dict.SetMethod("activateUvLoop",
                  base::BindRepeating(&ElectronBindings::ActivateUVLoop,
                                      base::Unretained(this)));
+  dict.SetMethod("getUvLoopMetrics",
+                 base::BindRepeating(&ElectronBindings::GetUvLoopMetrics,
+                                     base::Unretained(this)));
 
   gin_helper::Dictionary versions;
   if (dict.Get("versions", &versions)) {
@@ -122,6 +133,49 @@ void ElectronBindings::ActivateUVLoop(v8::Isolate* isolate) {
   uv_async_send(&call_next_tick_async_);
 }
 
+v8::Local<v8::Value> ElectronBindings::GetUvLoopMetrics(v8::Isolate* isolate) {
+  NodeBindings* node_bindings = NodeBindings::GetCurrent();
+  if (!node_bindings)
+    return v8::Null(isolate);
+
+  const NodeBindings::UvLoopMetrics& metrics =
+      node_bindings->uv_loop_metrics();
+  base::TimeTicks now = base::TimeTicks::Now();
+  double seconds = (now - last_uv_metrics_time_).InSecondsF();
+  double wakeups_per_second =
+      seconds > 0 ? (metrics.wakeups - last_uv_wakeups_) / seconds : 0;
+  last_uv_metrics_time_ = now;
+  last_uv_wakeups_ = metrics.wakeups;
+
+  gin_helper::Dictionary dict = gin::Dictionary::CreateEmpty(isolate);
+  dict.SetHidden("simple", true);
+  // Doubles, since the counters do not fit in 32-bit integers.
+  dict.Set("wakeups", static_cast<double>(metrics.wakeups));
+  dict.Set("wakeupsPerSecond", wakeups_per_second);
+  dict.Set("iterations", static_cast<double>(metrics.iterations));
+  dict.Set("budgetExhausted", static_cast<double>(metrics.budget_exhausted));
+  dict.Set("uvTime", metrics.uv_time.InMillisecondsF());
+  return dict.GetHandle();
+}
+
+// static
+v8::Local<v8::Value> ElectronBindings::GetStartupTimeline(
+    v8::Isolate* isolate) {
+  std::vector<StartupPhase> phases = electron::GetStartupTimeline();
+  v8::Local<v8::Array> result =
+      v8::Array::New(isolate, static_cast<int>(phases.size()));
+  v8::Local<v8::Context> context = isolate->GetCurrentContext();
+  for (uint32_t i = 0; i < phases.size(); ++i) {
+    gin_helper::Dictionary dict = gin::Dictionary::CreateEmpty(isolate);
+    dict.SetHidden("simple", true);
+    dict.Set("name", phases[i].name);
+    dict.Set("startTime", phases[i].start.ToJsTime());
+    dict.Set("duration", phases[i].duration.InMillisecondsF());
+    result->Set(context, i, dict.GetHandle()).Check();
+  }
+  return result;
+}
+
 // static
 void ElectronBindings::OnCallNextTick(uv_async_t* handle) {
   ElectronBindings* self = static_cast<ElectronBindings*>(handle->data);
@@ -343,6 +397,76 @@ v8::Local<v8::Value> ElectronBindings::GetIOCounters(v8::Isolate* isolate) {
   return dict.GetHandle();
 }
 
+// static
+int ElectronBindings::WriteStatistics(base::ProcessMetrics* metrics,
+                                      gin_helper::Arguments* args,
+                                      v8::Local<v8::Value> value) {
+  // The order of the statistics is documented, and only grows at the end.
+  enum Statistic {
+    kPercentCPUUsage,
+    kIdleWakeupsPerSecond,
+    kTotalHeapSize,
+    kTotalHeapSizeExecutable,
+    kTotalPhysicalSize,
+    kTotalAvailableSize,
+    kUsedHeapSize,
+    kHeapSizeLimit,
+    kMallocedMemory,
+    kPeakMallocedMemory,
+    kReadOperationCount,
+    kWriteOperationCount,
+    kOtherOperationCount,
+    kReadTransferCount,
+    kWriteTransferCount,
+    kOtherTransferCount,
+    kStatisticCount,
+  };
+
+  if (!value->IsFloat64Array() ||
+      value.As<v8::Float64Array>()->Length() < kStatisticCount) {
+    args->ThrowError(base::StringPrintf(
+        "Expected a Float64Array of at least %d elements", kStatisticCount));
+    return 0;
+  }
+
+  // Written in place, so sampling allocates nothing on the JavaScript heap.
+  auto array = value.As<v8::Float64Array>();
+  double* stats = reinterpret_cast<double*>(
+      static_cast<uint8_t*>(array->Buffer()->GetBackingStore()->Data()) +
+      array->ByteOffset());
+
+  stats[kPercentCPUUsage] = metrics->GetPlatformIndependentCPUUsage() /
+                            base::SysInfo::NumberOfProcessors();
+#if !defined(OS_WIN)
+  stats[kIdleWakeupsPerSecond] = metrics->GetIdleWakeupsPerSecond();
+#else
+  stats[kIdleWakeupsPerSecond] = 0;
+#endif
+
+  v8::HeapStatistics v8_heap_stats;
+  args->isolate()->GetHeapStatistics(&v8_heap_stats);
+  stats[kTotalHeapSize] = v8_heap_stats.total_heap_size() >> 10;
+  stats[kTotalHeapSizeExecutable] =
+      v8_heap_stats.total_heap_size_executable() >> 10;
+  stats[kTotalPhysicalSize] = v8_heap_stats.total_physical_size() >> 10;
+  stats[kTotalAvailableSize] = v8_heap_stats.total_available_size() >> 10;
+  stats[kUsedHeapSize] = v8_heap_stats.used_heap_size() >> 10;
+  stats[kHeapSizeLimit] = v8_heap_stats.heap_size_limit() >> 10;
+  stats[kMallocedMemory] = v8_heap_stats.malloced_memory() >> 10;
+  stats[kPeakMallocedMemory] = v8_heap_stats.peak_malloced_memory() >> 10;
+
+  base::IoCounters io_counters = {};
+  metrics->GetIOCounters(&io_counters);
+  stats[kReadOperationCount] = io_counters.ReadOperationCount;
+  stats[kWriteOperationCount] = io_counters.WriteOperationCount;
+  stats[kOtherOperationCount] = io_counters.OtherOperationCount;
+  stats[kReadTransferCount] = io_counters.ReadTransferCount;
+  stats[kWriteTransferCount] = io_counters.WriteTransferCount;
+  stats[kOtherTransferCount] = io_counters.OtherTransferCount;
+
+  return kStatisticCount;
+}
+
 // static
 bool ElectronBindings::TakeHeapSnapshot(v8::Isolate* isolate,
                                         const base::FilePath& file_path) {
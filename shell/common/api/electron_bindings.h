@@ -13,6 +13,7 @@
 #include "base/memory/scoped_refptr.h"
 #include "base/process/process_metrics.h"
 #include "base/strings/string16.h"
+#include "base/time/time.h"
 #include "shell/common/gin_helper/promise.h"
 #include "uv.h"  // NOLINT(build/include)
 
@@ -61,10 +62,15 @@ class ElectronBindings {
   static v8::Local<v8::Value> GetCPUUsage(base::ProcessMetrics* metrics,
                                           v8::Isolate* isolate);
   static v8::Local<v8::Value> GetIOCounters(v8::Isolate* isolate);
+  static int WriteStatistics(base::ProcessMetrics* metrics,
+                             gin_helper::Arguments* args,
+                             v8::Local<v8::Value> value);
+  static v8::Local<v8::Value> GetStartupTimeline(v8::Isolate* isolate);
   static bool TakeHeapSnapshot(v8::Isolate* isolate,
                                const base::FilePath& file_path);
 
   void ActivateUVLoop(v8::Isolate* isolate);
+  v8::Local<v8::Value> GetUvLoopMetrics(v8::Isolate* isolate);
 
   static void OnCallNextTick(uv_async_t* handle);
 
@@ -78,6 +84,10 @@ class ElectronBindings {
   std::list<node::Environment*> pending_next_ticks_;
   std::unique_ptr<base::ProcessMetrics> metrics_;
 
+  // When getUvLoopMetrics was last called and the wakeups it reported.
+  base::TimeTicks last_uv_metrics_time_;
+  uint64_t last_uv_wakeups_ = 0;
+
   DISALLOW_COPY_AND_ASSIGN(ElectronBindings);
 };
 
@@ -4,9 +4,12 @@
 
 #include "shell/common/api/remote/remote_callback_freer.h"
 
+#include "base/bind.h"
 #include "base/strings/utf_string_conversions.h"
+#include "base/threading/thread_task_runner_handle.h"
 #include "base/values.h"
 #include "content/public/browser/render_frame_host.h"
+#include "content/public/browser/render_process_host.h"
 #include "content/public/browser/web_contents.h"
 #include "electron/shell/common/api/api.mojom.h"
 #include "mojo/public/cpp/bindings/associated_remote.h"
@@ -25,6 +28,9 @@ void RemoteCallbackFreer::BindTo(v8::Isolate* isolate,
                           web_contents);
 }
 
+std::map<std::pair<int, int>, std::map<std::string, std::vector<int>>>
+    RemoteCallbackFreer::pending_dereferences_;
+
 RemoteCallbackFreer::RemoteCallbackFreer(v8::Isolate* isolate,
                                          v8::Local<v8::Object> target,
                                          int frame_id,
@@ -46,14 +52,37 @@ void RemoteCallbackFreer::RunDestructor() {
   });
 
   if (iter != frames.end() && (*iter)->IsRenderFrameLive()) {
-    mojo::AssociatedRemote<mojom::ElectronRenderer> electron_renderer;
-    (*iter)->GetRemoteAssociatedInterfaces()->GetInterface(&electron_renderer);
-    electron_renderer->DereferenceRemoteJSCallback(context_id_, object_id_);
+    if (pending_dereferences_.empty()) {
+      base::ThreadTaskRunnerHandle::Get()->PostTask(
+          FROM_HERE,
+          base::BindOnce(&RemoteCallbackFreer::FlushPendingDereferences));
+    }
+    auto frame_key = std::make_pair((*iter)->GetProcess()->GetID(), frame_id_);
+    pending_dereferences_[frame_key][context_id_].push_back(object_id_);
   }
 
   Observe(nullptr);
 }
 
+// static
+void RemoteCallbackFreer::FlushPendingDereferences() {
+  auto pending = std::move(pending_dereferences_);
+  pending_dereferences_.clear();
+  for (const auto& frame_it : pending) {
+    auto* frame = content::RenderFrameHost::FromID(frame_it.first.first,
+                                                   frame_it.first.second);
+    if (!frame || !frame->IsRenderFrameLive())
+      continue;
+
+    mojo::AssociatedRemote<mojom::ElectronRenderer> electron_renderer;
+    frame->GetRemoteAssociatedInterfaces()->GetInterface(&electron_renderer);
+    for (const auto& context_it : frame_it.second) {
+      electron_renderer->DereferenceRemoteJSCallbacks(context_it.first,
+                                                      context_it.second);
+    }
+  }
+}
+
 void RemoteCallbackFreer::RenderViewDeleted(content::RenderViewHost*) {
   delete this;
 }
@@ -5,7 +5,10 @@
 #ifndef SHELL_COMMON_API_REMOTE_REMOTE_CALLBACK_FREER_H_
 #define SHELL_COMMON_API_REMOTE_REMOTE_CALLBACK_FREER_H_
 
+#include <map>
 #include <string>
+#include <utility>
+#include <vector>
 
 #include "content/public/browser/web_contents_observer.h"
 #include "shell/common/api/remote/object_life_monitor.h"
@@ -33,6 +36,16 @@ class RemoteCallbackFreer : public ObjectLifeMonitor,
 
   void RunDestructor() override;
 
+  // Sends the dereferences queued since the last flush, one message per frame
+  // and context.
+  static void FlushPendingDereferences();
+
+  // The callbacks waiting to be released, as
+  // { (process_id, routing_id) => { context_id => [object_id] }}. The
+  // callbacks collected in one GC are released together.
+  static std::map<std::pair<int, int>, std::map<std::string, std::vector<int>>>
+      pending_dereferences_;
+
   // content::WebContentsObserver:
   void RenderViewDeleted(content::RenderViewHost*) override;
 
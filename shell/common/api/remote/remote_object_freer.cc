@@ -4,7 +4,12 @@
 
 #include "shell/common/api/remote/remote_object_freer.h"
 
+#include <utility>
+#include <vector>
+
+#include "base/bind.h"
 #include "base/strings/utf_string_conversions.h"
+#include "base/threading/thread_task_runner_handle.h"
 #include "base/values.h"
 #include "content/public/renderer/render_frame.h"
 #include "services/service_manager/public/cpp/interface_provider.h"
@@ -43,6 +48,9 @@ void RemoteObjectFreer::AddRef(const std::string& context_id, int object_id) {
 // static
 std::map<std::string, std::map<int, int>> RemoteObjectFreer::ref_mapper_;
 
+std::map<int, std::map<std::string, std::map<int, int>>>
+    RemoteObjectFreer::pending_dereferences_;
+
 RemoteObjectFreer::RemoteObjectFreer(v8::Isolate* isolate,
                                      v8::Local<v8::Object> target,
                                      const std::string& context_id,
@@ -80,10 +88,40 @@ void RemoteObjectFreer::RunDestructor() {
       ref_mapper_.erase(objects_it);
   }
 
-  mojom::ElectronBrowserPtr electron_ptr;
-  render_frame->GetRemoteInterfaces()->GetInterface(
-      mojo::MakeRequest(&electron_ptr));
-  electron_ptr->DereferenceRemoteJSObject(context_id_, object_id_, ref_count);
+  // An object whose proxy was collected again before the flush is sent once,
+  // with the references of both.
+  if (pending_dereferences_.empty()) {
+    base::ThreadTaskRunnerHandle::Get()->PostTask(
+        FROM_HERE,
+        base::BindOnce(&RemoteObjectFreer::FlushPendingDereferences));
+  }
+  pending_dereferences_[routing_id_][context_id_][object_id_] += ref_count;
+}
+
+// static
+void RemoteObjectFreer::FlushPendingDereferences() {
+  auto pending = std::move(pending_dereferences_);
+  pending_dereferences_.clear();
+  for (const auto& frame_it : pending) {
+    content::RenderFrame* render_frame =
+        content::RenderFrame::FromRoutingID(frame_it.first);
+    if (!render_frame)
+      continue;
+
+    mojom::ElectronBrowserPtr electron_ptr;
+    render_frame->GetRemoteInterfaces()->GetInterface(
+        mojo::MakeRequest(&electron_ptr));
+    for (const auto& context_it : frame_it.second) {
+      std::vector<mojom::RemoteObjectRefPtr> refs;
+      refs.reserve(context_it.second.size());
+      for (const auto& object_it : context_it.second) {
+        refs.push_back(
+            mojom::RemoteObjectRef::New(object_it.first, object_it.second));
+      }
+      electron_ptr->DereferenceRemoteJSObjects(context_it.first,
+                                               std::move(refs));
+    }
+  }
 }
 
 }  // namespace electron
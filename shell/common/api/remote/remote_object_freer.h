@@ -29,9 +29,19 @@ class RemoteObjectFreer : public ObjectLifeMonitor {
 
   void RunDestructor() override;
 
+  // Sends the dereferences queued since the last flush, one message per frame
+  // and context.
+  static void FlushPendingDereferences();
+
   // { context_id => { object_id => ref_count }}
   static std::map<std::string, std::map<int, int>> ref_mapper_;
 
+  // The dereferences waiting to be sent, as
+  // { routing_id => { context_id => { object_id => ref_count }}}. The objects
+  // collected in one GC are sent together.
+  static std::map<int, std::map<std::string, std::map<int, int>>>
+      pending_dereferences_;
+
  private:
   std::string context_id_;
   int object_id_;
@@ -4,19 +4,27 @@
 
 #include "shell/common/asar/archive.h"
 
+#include <algorithm>
 #include <string>
 #include <utility>
 #include <vector>
 
 #include "base/files/file.h"
 #include "base/files/file_util.h"
+#include "base/files/memory_mapped_file.h"
 #include "base/json/json_reader.h"
 #include "base/logging.h"
 #include "base/pickle.h"
+#include "base/stl_util.h"
 #include "base/strings/string_number_conversions.h"
 #include "base/task/post_task.h"
 #include "base/threading/thread_restrictions.h"
+#include "base/trace_event/trace_event.h"
 #include "base/values.h"
+#include "shell/common/asar/entry_decompressor.h"
+#include "shell/common/asar/extraction_cache.h"
+#include "shell/common/asar/header_index.h"
+#include "shell/common/asar/readahead.h"
 #include "shell/common/asar/scoped_temporary_file.h"
 
 #if defined(OS_WIN)
@@ -112,6 +120,98 @@ bool FillFileInfoWithNode(Archive::FileInfo* info,
 
   node->GetBoolean("executable", &info->executable);
 
+  info->stored_size = info->size;
+  std::string compression;
+  if (node->GetString("compression", &compression)) {
+    int stored_size;
+    if (compression != "brotli" ||
+        !node->GetInteger("storedSize", &stored_size))
+      return false;
+    info->compressed = true;
+    info->stored_size = static_cast<uint32_t>(stored_size);
+  }
+
+  return true;
+}
+
+// Converts |path| to the form used as key in the v2 header.
+std::string ToIndexPath(const base::FilePath& path) {
+  std::string result = path.AsUTF8Unsafe();
+#if defined(OS_WIN)
+  std::replace(result.begin(), result.end(), '\\', '/');
+#endif
+  return result;
+}
+
+void FillFileInfoWithEntry(Archive::FileInfo* info,
+                           uint32_t header_size,
+                           const HeaderIndex::Entry* entry) {
+  info->size = entry->size;
+  info->unpacked = entry->flags & HeaderIndex::kUnpacked;
+  if (info->unpacked)
+    return;
+  info->offset = entry->offset + header_size;
+  info->executable = entry->flags & HeaderIndex::kExecutable;
+  info->compressed = entry->flags & HeaderIndex::kCompressed;
+  info->stored_size = info->compressed ? entry->count : entry->size;
+}
+
+// Fills |stats| for a node, without following links.
+bool FillStatsWithNode(Archive::Stats* stats,
+                       uint32_t header_size,
+                       const base::DictionaryValue* node) {
+  if (node->FindKey("link")) {
+    stats->is_file = false;
+    stats->is_link = true;
+    return true;
+  }
+
+  if (node->FindKey("files")) {
+    stats->is_file = false;
+    stats->is_directory = true;
+    return true;
+  }
+
+  return FillFileInfoWithNode(stats, header_size, node);
+}
+
+void FillStatsWithEntry(Archive::Stats* stats,
+                        uint32_t header_size,
+                        const HeaderIndex::Entry* entry) {
+  if (entry->flags & HeaderIndex::kLink) {
+    stats->is_file = false;
+    stats->is_link = true;
+  } else if (entry->flags & HeaderIndex::kDirectory) {
+    stats->is_file = false;
+    stats->is_directory = true;
+  } else {
+    FillFileInfoWithEntry(stats, header_size, entry);
+  }
+}
+
+// Appends the stats of everything under the "files" of |dir| to |entries|.
+bool WalkNode(const base::DictionaryValue* files,
+              uint32_t header_size,
+              const base::FilePath& prefix,
+              std::vector<std::pair<base::FilePath, Archive::Stats>>* entries) {
+  for (base::DictionaryValue::Iterator iter(*files); !iter.IsAtEnd();
+       iter.Advance()) {
+    const base::DictionaryValue* node;
+    if (!iter.value().GetAsDictionary(&node))
+      return false;
+    base::FilePath path =
+        prefix.Append(base::FilePath::FromUTF8Unsafe(iter.key()));
+    Archive::Stats stats;
+    if (!FillStatsWithNode(&stats, header_size, node))
+      return false;
+    entries->emplace_back(path, stats);
+
+    const base::DictionaryValue* children;
+    if (stats.is_directory &&
+        (!node->GetDictionaryWithoutPathExpansion("files", &children) ||
+         !WalkNode(children, header_size, path, entries)))
+      return false;
+  }
   return true;
 }
 
@@ -137,10 +237,12 @@ Archive::~Archive() {
   }
 #endif
   base::ThreadRestrictions::ScopedAllowIO allow_io;
+  mapped_file_.reset();
   file_.Close();
 }
 
 bool Archive::Init() {
+  TRACE_EVENT1("electron.asar", "Archive::Init", "path", path_.AsUTF8Unsafe());
   if (!file_.IsValid()) {
     if (file_.error_details() != base::File::FILE_ERROR_NOT_FOUND) {
       LOG(WARNING) << "Opening " << path_.value() << ": "
@@ -149,6 +251,16 @@ bool Archive::Init() {
     return false;
   }
 
+  {
+    // Mapping only reserves address space, pages are read on first access.
+    // Failing to map (e.g. lack of address space) is not fatal as all readers
+    // can fall back to reading from the fd.
+    base::ThreadRestrictions::ScopedAllowIO allow_io;
+    auto mapped_file = std::make_unique<base::MemoryMappedFile>();
+    if (mapped_file->Initialize(file_.Duplicate()))
+      mapped_file_ = std::move(mapped_file);
+  }
+
   std::vector<char> buf;
   int len;
 
@@ -179,9 +291,21 @@ bool Archive::Init() {
     return false;
   }
 
+  base::Pickle header_pickle(buf.data(), buf.size());
+  if (HeaderIndex::IsHeaderIndex(header_pickle.payload(),
+                                 header_pickle.payload_size())) {
+    auto index = std::make_unique<HeaderIndex>();
+    if (!index->Init(header_pickle.payload(), header_pickle.payload_size())) {
+      LOG(ERROR) << "Failed to parse header index from " << path_.value();
+      return false;
+    }
+    header_size_ = 8 + size;
+    index_ = std::move(index);
+    return true;
+  }
+
   std::string header;
-  if (!base::PickleIterator(base::Pickle(buf.data(), buf.size()))
-           .ReadString(&header)) {
+  if (!base::PickleIterator(header_pickle).ReadString(&header)) {
     LOG(ERROR) << "Failed to parse header from " << path_.value();
     return false;
   }
@@ -199,6 +323,15 @@ bool Archive::Init() {
 }
 
 bool Archive::GetFileInfo(const base::FilePath& path, FileInfo* info) {
+  if (index_) {
+    const HeaderIndex::Entry* entry =
+        index_->Resolve(index_->Find(ToIndexPath(path)));
+    if (!entry || (entry->flags & HeaderIndex::kDirectory))
+      return false;
+    FillFileInfoWithEntry(info, header_size_, entry);
+    return true;
+  }
+
   if (!header_)
     return false;
 
@@ -214,6 +347,14 @@ bool Archive::GetFileInfo(const base::FilePath& path, FileInfo* info) {
 }
 
 bool Archive::Stat(const base::FilePath& path, Stats* stats) {
+  if (index_) {
+    const HeaderIndex::Entry* entry = index_->Find(ToIndexPath(path));
+    if (!entry)
+      return false;
+    FillStatsWithEntry(stats, header_size_, entry);
+    return true;
+  }
+
   if (!header_)
     return false;
 
@@ -221,23 +362,66 @@ bool Archive::Stat(const base::FilePath& path, Stats* stats) {
   if (!GetNodeFromPath(path.AsUTF8Unsafe(), header_.get(), &node))
     return false;
 
-  if (node->FindKey("link")) {
-    stats->is_file = false;
-    stats->is_link = true;
-    return true;
-  }
+  return FillStatsWithNode(stats, header_size_, node);
+}
 
-  if (node->FindKey("files")) {
-    stats->is_file = false;
-    stats->is_directory = true;
+bool Archive::Walk(
+    const base::FilePath& path,
+    std::vector<std::pair<base::FilePath, Stats>>* entries) {
+  if (index_) {
+    const HeaderIndex::Entry* entry =
+        index_->Resolve(index_->Find(ToIndexPath(path)));
+    if (!entry || !(entry->flags & HeaderIndex::kDirectory))
+      return false;
+    // Depth first, in the same order as Readdir().
+    std::vector<std::pair<base::FilePath, const HeaderIndex::Entry*>> pending;
+    auto push_children = [&](const base::FilePath& prefix,
+                             const HeaderIndex::Entry* dir) {
+      std::vector<const HeaderIndex::Entry*> children = index_->Children(dir);
+      for (auto it = children.rbegin(); it != children.rend(); ++it) {
+        pending.emplace_back(prefix.Append(base::FilePath::FromUTF8Unsafe(
+                                 index_->NameOf(*it).as_string())),
+                             *it);
+      }
+    };
+    push_children(path, entry);
+    while (!pending.empty()) {
+      base::FilePath child_path = std::move(pending.back().first);
+      const HeaderIndex::Entry* child = pending.back().second;
+      pending.pop_back();
+      Stats stats;
+      FillStatsWithEntry(&stats, header_size_, child);
+      entries->emplace_back(child_path, stats);
+      if (stats.is_directory)
+        push_children(child_path, child);
+    }
     return true;
   }
 
-  return FillFileInfoWithNode(stats, header_size_, node);
+  if (!header_)
+    return false;
+
+  const base::DictionaryValue* node;
+  const base::DictionaryValue* files;
+  return GetNodeFromPath(path.AsUTF8Unsafe(), header_.get(), &node) &&
+         GetFilesNode(header_.get(), node, &files) &&
+         WalkNode(files, header_size_, path, entries);
 }
 
 bool Archive::Readdir(const base::FilePath& path,
                       std::vector<base::FilePath>* list) {
+  if (index_) {
+    const HeaderIndex::Entry* entry =
+        index_->Resolve(index_->Find(ToIndexPath(path)));
+    if (!entry || !(entry->flags & HeaderIndex::kDirectory))
+      return false;
+    for (const HeaderIndex::Entry* child : index_->Children(entry)) {
+      list->push_back(
+          base::FilePath::FromUTF8Unsafe(index_->NameOf(child).as_string()));
+    }
+    return true;
+  }
+
   if (!header_)
     return false;
 
@@ -258,6 +442,22 @@ bool Archive::Readdir(const base::FilePath& path,
 }
 
 bool Archive::Realpath(const base::FilePath& path, base::FilePath* realpath) {
+  if (index_) {
+    const HeaderIndex::Entry* entry = index_->Find(ToIndexPath(path));
+    if (!entry)
+      return false;
+    if (!(entry->flags & HeaderIndex::kLink)) {
+      *realpath = path;
+      return true;
+    }
+    const HeaderIndex::Entry* target = index_->Resolve(entry);
+    if (!target)
+      return false;
+    *realpath = base::FilePath::FromUTF8Unsafe(
+        index_->PathOf(target).as_string());
+    return true;
+  }
+
   if (!header_)
     return false;
 
@@ -276,9 +476,12 @@ bool Archive::Realpath(const base::FilePath& path, base::FilePath* realpath) {
 }
 
 bool Archive::CopyFileOut(const base::FilePath& path, base::FilePath* out) {
+  TRACE_EVENT1("electron.asar", "Archive::CopyFileOut", "path",
+               path.AsUTF8Unsafe());
+  base::AutoLock auto_lock(external_files_lock_);
   auto it = external_files_.find(path.value());
   if (it != external_files_.end()) {
-    *out = it->second->path();
+    *out = it->second;
     return true;
   }
 
@@ -291,10 +494,33 @@ bool Archive::CopyFileOut(const base::FilePath& path, base::FilePath* out) {
     return true;
   }
 
+#if defined(OS_LINUX)
+  // Small executables are run from memory and never hit the disk.
+  if (info.executable && info.size <= kMaxMemoryFileSize &&
+      ExtractToMemory(path, out)) {
+    external_files_[path.value()] = *out;
+    return true;
+  }
+#endif
+
+  if (ExtractToCache(path, info, out)) {
+    external_files_[path.value()] = *out;
+    return true;
+  }
+
   auto temp_file = std::make_unique<ScopedTemporaryFile>();
   base::FilePath::StringType ext = path.Extension();
-  if (!temp_file->InitFromFile(&file_, ext, info.offset, info.size))
-    return false;
+  if (info.compressed) {
+    std::string contents;
+    if (!ReadFile(path, &contents) || !temp_file->Init(ext) ||
+        base::WriteFile(temp_file->path(), contents.data(), contents.size()) !=
+            static_cast<int>(contents.size()))
+      return false;
+  } else {
+    RecordArchiveRead(path_, info.offset, info.size);
+    if (!temp_file->InitFromFile(&file_, ext, info.offset, info.size))
+      return false;
+  }
 
 #if defined(OS_POSIX)
   if (info.executable) {
@@ -304,7 +530,98 @@ bool Archive::CopyFileOut(const base::FilePath& path, base::FilePath* out) {
 #endif
 
   *out = temp_file->path();
-  external_files_[path.value()] = std::move(temp_file);
+  external_files_[path.value()] = *out;
+  temp_files_.push_back(std::move(temp_file));
+  return true;
+}
+
+bool Archive::ExtractToCache(const base::FilePath& path,
+                             const FileInfo& info,
+                             base::FilePath* out) {
+  base::FilePath dir = GetExtractionCacheDir();
+  base::File::Info archive_info;
+  {
+    base::ThreadRestrictions::ScopedAllowIO allow_io;
+    if (dir.empty() || !file_.GetInfo(&archive_info))
+      return false;
+  }
+
+  base::FilePath cache_path = dir.Append(GetExtractionCacheName(
+      path_, archive_info, info.offset, info.size, path.Extension()));
+  if (!IsExtractedFileCached(cache_path, info.size)) {
+    std::string contents;
+    if (!ReadFile(path, &contents) ||
+        !WriteExtractedFile(cache_path,
+                            base::as_bytes(base::make_span(contents)),
+                            info.executable))
+      return false;
+  }
+
+  *out = cache_path;
+  return true;
+}
+
+#if defined(OS_LINUX)
+bool Archive::ExtractToMemory(const base::FilePath& path,
+                              base::FilePath* out) {
+  std::string contents;
+  base::ScopedFD fd;
+  if (!ReadFile(path, &contents) ||
+      !WriteMemoryFile(path.BaseName().value(),
+                       base::as_bytes(base::make_span(contents)), &fd, out))
+    return false;
+
+  memory_files_.push_back(std::move(fd));
+  return true;
+}
+#endif
+
+bool Archive::ReadView(const base::FilePath& path,
+                       base::span<const uint8_t>* view) {
+  TRACE_EVENT1("electron.asar", "Archive::ReadView", "path",
+               path.AsUTF8Unsafe());
+  if (!mapped_file_)
+    return false;
+
+  FileInfo info;
+  if (!GetFileInfo(path, &info) || info.unpacked)
+    return false;
+
+  if (info.offset > mapped_file_->length() ||
+      info.stored_size > mapped_file_->length() - info.offset) {
+    LOG(ERROR) << "File " << path.value() << " exceeds the bounds of "
+               << path_.value();
+    return false;
+  }
+
+  RecordArchiveRead(path_, info.offset, info.stored_size);
+  *view = base::make_span(mapped_file_->data() + info.offset, info.stored_size);
+  return true;
+}
+
+bool Archive::ReadFile(const base::FilePath& path, std::string* contents) {
+  TRACE_EVENT1("electron.asar", "Archive::ReadFile", "path",
+               path.AsUTF8Unsafe());
+  FileInfo info;
+  if (!GetFileInfo(path, &info) || info.unpacked)
+    return false;
+
+  std::string stored;
+  base::span<const uint8_t> view;
+  if (!ReadView(path, &view)) {
+    RecordArchiveRead(path_, info.offset, info.stored_size);
+    stored.resize(info.stored_size);
+    base::ThreadRestrictions::ScopedAllowIO allow_io;
+    if (file_.Read(info.offset, base::data(stored), stored.size()) !=
+        static_cast<int>(stored.size()))
+      return false;
+    view = base::as_bytes(base::make_span(stored));
+  }
+
+  if (info.compressed)
+    return DecompressEntry(view, info.size, contents);
+
+  contents->assign(reinterpret_cast<const char*>(view.data()), view.size());
   return true;
 }
 
@@ -6,29 +6,51 @@
 #define SHELL_COMMON_ASAR_ARCHIVE_H_
 
 #include <memory>
+#include <string>
 #include <unordered_map>
+#include <utility>
 #include <vector>
 
+#include "base/containers/span.h"
 #include "base/files/file.h"
 #include "base/files/file_path.h"
+#include "base/synchronization/lock.h"
+#include "build/build_config.h"
+
+#if defined(OS_LINUX)
+#include "base/files/scoped_file.h"
+#endif
 
 namespace base {
 class DictionaryValue;
+class MemoryMappedFile;
 }
 
 namespace asar {
 
+class HeaderIndex;
 class ScopedTemporaryFile;
 
 // This class represents an asar package, and provides methods to read
-// information from it.
+// information from it. After Init() the archive is immutable apart from the
+// internally locked cache of CopyFileOut(), so it can be shared by threads.
 class Archive {
  public:
   struct FileInfo {
-    FileInfo() : unpacked(false), executable(false), size(0), offset(0) {}
+    FileInfo()
+        : unpacked(false),
+          executable(false),
+          compressed(false),
+          size(0),
+          stored_size(0),
+          offset(0) {}
     bool unpacked;
     bool executable;
+    // Compressed files are stored as a brotli stream of |stored_size| bytes
+    // at |offset|, which inflates to |size| bytes.
+    bool compressed;
     uint32_t size;
+    uint32_t stored_size;
     uint64_t offset;
   };
 
@@ -42,7 +64,8 @@ class Archive {
   explicit Archive(const base::FilePath& path);
   virtual ~Archive();
 
-  // Read and parse the header.
+  // Read and parse the header, either the JSON (v1) or the pre-indexed
+  // binary (v2) format.
   bool Init();
 
   // Get the info of a file.
@@ -51,33 +74,72 @@ class Archive {
   // Fs.stat(path).
   bool Stat(const base::FilePath& path, Stats* stats);
 
+  // Returns the stats of everything under the directory |path|, depth first.
+  // Links are reported as links and not followed. The paths are relative to
+  // the root of the archive.
+  bool Walk(const base::FilePath& path,
+            std::vector<std::pair<base::FilePath, Stats>>* entries);
+
   // Fs.readdir(path).
   bool Readdir(const base::FilePath& path, std::vector<base::FilePath>* files);
 
   // Fs.realpath(path).
   bool Realpath(const base::FilePath& path, base::FilePath* realpath);
 
-  // Copy the file into a temporary file, and return the new path.
-  // For unpacked file, this method will return its real path.
+  // Copy the file out of the archive, and return the new path. Files are
+  // extracted into the persistent extraction cache when there is one, and
+  // into temporary files otherwise. For unpacked file, this method will
+  // return its real path.
   bool CopyFileOut(const base::FilePath& path, base::FilePath* out);
 
+  // Points |view| at the stored bytes of a packed file in the memory mapped
+  // archive, the view is valid as long as this object is alive. For compressed
+  // files these are the compressed bytes. Returns false for unpacked files or
+  // when the archive could not be mapped, in which case the content must be
+  // read from GetFD().
+  bool ReadView(const base::FilePath& path, base::span<const uint8_t>* view);
+
+  // Reads the whole content of a packed file, decompressing it if needed.
+  bool ReadFile(const base::FilePath& path, std::string* contents);
+
   // Returns the file's fd.
   int GetFD() const;
 
   base::FilePath path() const { return path_; }
+  // Returns the JSON header, which is null for archives with a v2 header.
   base::DictionaryValue* header() const { return header_.get(); }
 
  private:
+  // Executables up to this size are extracted into memory files on Linux.
+  static constexpr uint32_t kMaxMemoryFileSize = 16 * 1024 * 1024;
+
+  bool ExtractToCache(const base::FilePath& path,
+                      const FileInfo& info,
+                      base::FilePath* out);
+#if defined(OS_LINUX)
+  bool ExtractToMemory(const base::FilePath& path, base::FilePath* out);
+#endif
+
   base::FilePath path_;
   base::File file_;
   int fd_ = -1;
   uint32_t header_size_ = 0;
   std::unique_ptr<base::DictionaryValue> header_;
+  std::unique_ptr<HeaderIndex> index_;
+
+  // The whole archive mapped read-only, pages are shared between all
+  // processes that map the same archive.
+  std::unique_ptr<base::MemoryMappedFile> mapped_file_;
 
-  // Cached external temporary files.
-  std::unordered_map<base::FilePath::StringType,
-                     std::unique_ptr<ScopedTemporaryFile>>
+  // Paths of the files copied out of the archive, and the temporary and
+  // memory files that have to stay alive while they are used.
+  base::Lock external_files_lock_;
+  std::unordered_map<base::FilePath::StringType, base::FilePath>
       external_files_;
+  std::vector<std::unique_ptr<ScopedTemporaryFile>> temp_files_;
+#if defined(OS_LINUX)
+  std::vector<base::ScopedFD> memory_files_;
+#endif
 
   DISALLOW_COPY_AND_ASSIGN(Archive);
 };
@@ -0,0 +1,139 @@
+// Copyright (c) 2020 GitHub, Inc.
+// Use of this source code is governed by the MIT license that can be
+// found in the LICENSE file.
+
+#include <string>
+#include <vector>
+
+#include "base/files/file_path.h"
+#include "base/files/scoped_temp_dir.h"
+#include "base/strings/string_number_conversions.h"
+#include "base/timer/elapsed_timer.h"
+#include "shell/common/asar/archive.h"
+#include "shell/common/asar/asar_util.h"
+#include "shell/common/asar/synthetic_archive.h"
+#include "testing/gtest/include/gtest/gtest.h"
+#include "testing/perf/perf_test.h"
+
+namespace asar {
+
+namespace {
+
+const size_t kEntryCounts[] = {1000, 10000, 100000};
+const int kInitIterations = 5;
+const size_t kLookups = 100000;
+
+// Returns the average time of one call of |function|.
+template <typename Function>
+base::TimeDelta TimePerIteration(size_t iterations, Function function) {
+  base::ElapsedTimer timer;
+  for (size_t i = 0; i < iterations; ++i)
+    function(i);
+  return timer.Elapsed() / iterations;
+}
+
+std::string HeaderName(bool indexed) {
+  return indexed ? "_v2" : "_v1";
+}
+
+std::string EntriesName(size_t count) {
+  return base::NumberToString(count) + "_entries";
+}
+
+class AsarBenchmark : public testing::Test {
+ protected:
+  void SetUp() override { ASSERT_TRUE(temp_dir_.CreateUniqueTempDir()); }
+
+  void TearDown() override { ClearArchives(); }
+
+  base::FilePath WriteArchive(const std::vector<SyntheticFile>& files,
+                              bool indexed) {
+    base::FilePath path = temp_dir_.GetPath().AppendASCII(
+        EntriesName(files.size()) + HeaderName(indexed) + ".asar");
+    EXPECT_TRUE(WriteSyntheticArchive(path, files, indexed));
+    return path;
+  }
+
+  base::ScopedTempDir temp_dir_;
+};
+
+}  // namespace
+
+TEST_F(AsarBenchmark, Init) {
+  for (size_t count : kEntryCounts) {
+    std::vector<SyntheticFile> files = MakeSyntheticFiles(count, 16);
+    for (bool indexed : {false, true}) {
+      base::FilePath path = WriteArchive(files, indexed);
+      base::TimeDelta elapsed = TimePerIteration(kInitIterations, [&](size_t) {
+        Archive archive(path);
+        EXPECT_TRUE(archive.Init());
+      });
+      perf_test::PrintResult("asar_init", HeaderName(indexed),
+                             EntriesName(count), elapsed.InMillisecondsF(),
+                             "ms", true);
+    }
+  }
+}
+
+TEST_F(AsarBenchmark, Lookups) {
+  for (size_t count : kEntryCounts) {
+    std::vector<SyntheticFile> files = MakeSyntheticFiles(count, 16);
+    // Visit the entries in a scattered but reproducible order.
+    std::vector<base::FilePath> paths;
+    for (size_t i = 0; i < count; ++i) {
+      paths.push_back(
+          base::FilePath::FromUTF8Unsafe(files[(i * 7919) % count].path));
+    }
+    std::vector<base::FilePath> dirs;
+    for (const base::FilePath& path : paths)
+      dirs.push_back(path.DirName());
+
+    for (bool indexed : {false, true}) {
+      Archive archive(WriteArchive(files, indexed));
+      ASSERT_TRUE(archive.Init());
+      std::string trace = EntriesName(count);
+
+      base::TimeDelta elapsed = TimePerIteration(kLookups, [&](size_t i) {
+        Archive::FileInfo info;
+        EXPECT_TRUE(archive.GetFileInfo(paths[i % count], &info));
+      });
+      perf_test::PrintResult("asar_get_file_info", HeaderName(indexed), trace,
+                             elapsed.InMicrosecondsF() * 1000, "ns", true);
+
+      elapsed = TimePerIteration(kLookups, [&](size_t i) {
+        Archive::Stats stats;
+        EXPECT_TRUE(archive.Stat(paths[i % count], &stats));
+      });
+      perf_test::PrintResult("asar_stat", HeaderName(indexed), trace,
+                             elapsed.InMicrosecondsF() * 1000, "ns", true);
+
+      elapsed = TimePerIteration(kLookups / 100, [&](size_t i) {
+        std::vector<base::FilePath> list;
+        EXPECT_TRUE(archive.Readdir(dirs[i % count], &list));
+      });
+      perf_test::PrintResult("asar_readdir", HeaderName(indexed), trace,
+                             elapsed.InMicrosecondsF() * 1000, "ns", true);
+    }
+  }
+}
+
+TEST_F(AsarBenchmark, ReadFileToString) {
+  const size_t kFileCount = 64;
+  const size_t kFileSize = 1024 * 1024;
+  std::vector<SyntheticFile> files = MakeSyntheticFiles(kFileCount, kFileSize);
+  for (bool indexed : {false, true}) {
+    base::FilePath archive_path = WriteArchive(files, indexed);
+    base::TimeDelta elapsed = TimePerIteration(kFileCount, [&](size_t i) {
+      std::string contents;
+      EXPECT_TRUE(ReadFileToString(
+          archive_path.Append(base::FilePath::FromUTF8Unsafe(files[i].path)),
+          &contents));
+      EXPECT_EQ(kFileSize, contents.size());
+    });
+    perf_test::PrintResult("asar_read_file_to_string", HeaderName(indexed),
+                           "1MB_files", kFileSize / elapsed.InSecondsF() / 1e6,
+                           "MB/s", true);
+  }
+}
+
+}  // namespace asar
@@ -4,65 +4,213 @@
 
 #include "shell/common/asar/asar_util.h"
 
+#include <atomic>
 #include <map>
+#include <memory>
 #include <string>
 
+#include "base/bind.h"
+#include "base/containers/mru_cache.h"
+#include "base/files/file.h"
 #include "base/files/file_path.h"
 #include "base/files/file_util.h"
 #include "base/lazy_instance.h"
+#include "base/memory/memory_pressure_listener.h"
+#include "base/no_destructor.h"
 #include "base/stl_util.h"
+#include "base/synchronization/lock.h"
 #include "base/threading/thread_local.h"
 #include "base/threading/thread_restrictions.h"
+#include "base/time/time.h"
 #include "shell/common/asar/archive.h"
+#include "shell/common/asar/readahead.h"
 
 namespace asar {
 
 namespace {
 
-// The global instance of ArchiveMap, will be destroyed on exit.
 typedef std::map<base::FilePath, std::shared_ptr<Archive>> ArchiveMap;
-base::LazyInstance<base::ThreadLocalPointer<ArchiveMap>>::Leaky
-    g_archive_map_tls = LAZY_INSTANCE_INITIALIZER;
+
+// The process-wide registry of parsed archives, shared by all threads.
+struct ArchiveRegistry {
+  base::Lock lock;
+  ArchiveMap archives;
+  // Bumped whenever archives are removed, so per-thread caches know that
+  // they have to drop their references.
+  std::atomic<uint32_t> generation{0};
+};
+
+base::LazyInstance<ArchiveRegistry>::Leaky g_archive_registry =
+    LAZY_INSTANCE_INITIALIZER;
+
+// Per-thread references into the registry, which serve lookups without
+// taking the registry lock.
+struct ThreadArchiveCache {
+  uint32_t generation = 0;
+  ArchiveMap archives;
+};
+
+base::LazyInstance<base::ThreadLocalOwnedPointer<ThreadArchiveCache>>::Leaky
+    g_thread_cache_tls = LAZY_INSTANCE_INITIALIZER;
+
+ThreadArchiveCache* GetThreadCache() {
+  ThreadArchiveCache* cache = g_thread_cache_tls.Pointer()->Get();
+  if (!cache) {
+    g_thread_cache_tls.Pointer()->Set(std::make_unique<ThreadArchiveCache>());
+    cache = g_thread_cache_tls.Pointer()->Get();
+  }
+  uint32_t generation =
+      g_archive_registry.Get().generation.load(std::memory_order_acquire);
+  if (cache->generation != generation) {
+    cache->archives.clear();
+    cache->generation = generation;
+  }
+  return cache;
+}
 
 const base::FilePath::CharType kAsarExtension[] = FILE_PATH_LITERAL(".asar");
 
-std::map<base::FilePath, bool> g_is_directory_cache;
+// Missing paths are checked again after this, they may be created later as
+// either an archive or a directory.
+const base::TimeDelta kMissingEntryTTL = base::TimeDelta::FromSeconds(5);
 
-bool IsDirectoryCached(const base::FilePath& path) {
-  auto it = g_is_directory_cache.find(path);
-  if (it != g_is_directory_cache.end()) {
-    return it->second;
+// Remembers whether paths ending in ".asar" are real directories, so that
+// GetAsarArchivePath does not stat them on every call. The cache is split in
+// shards with their own lock and LRU bound, so threads rarely contend and
+// memory stays bounded however many paths the app probes.
+class DirectoryCache {
+ public:
+  DirectoryCache() {
+    for (auto& shard : shards_)
+      shard.entries = std::make_unique<EntryCache>(kEntriesPerShard);
   }
-  base::ThreadRestrictions::ScopedAllowIO allow_io;
-  return g_is_directory_cache[path] = base::DirectoryExists(path);
+
+  bool IsDirectory(const base::FilePath& path) {
+    Shard& shard = GetShard(path);
+    {
+      base::AutoLock auto_lock(shard.lock);
+      auto it = shard.entries->Get(path);
+      if (it != shard.entries->end() &&
+          (it->second.exists ||
+           base::TimeTicks::Now() - it->second.checked < kMissingEntryTTL))
+        return it->second.is_directory;
+    }
+
+    // Stat without holding the lock, racing threads store the same result.
+    Entry entry;
+    {
+      base::ThreadRestrictions::ScopedAllowIO allow_io;
+      base::File::Info info;
+      entry.exists = base::GetFileInfo(path, &info);
+      entry.is_directory = entry.exists && info.is_directory;
+    }
+    entry.checked = base::TimeTicks::Now();
+
+    base::AutoLock auto_lock(shard.lock);
+    shard.entries->Put(path, entry);
+    return entry.is_directory;
+  }
+
+  void Clear() {
+    for (auto& shard : shards_) {
+      base::AutoLock auto_lock(shard.lock);
+      shard.entries->Clear();
+    }
+  }
+
+ private:
+  struct Entry {
+    bool exists = false;
+    bool is_directory = false;
+    base::TimeTicks checked;
+  };
+
+  using EntryCache = base::HashingMRUCache<base::FilePath, Entry>;
+
+  struct Shard {
+    base::Lock lock;
+    std::unique_ptr<EntryCache> entries;
+  };
+
+  static constexpr size_t kShardCount = 16;
+  static constexpr size_t kEntriesPerShard = 256;
+
+  Shard& GetShard(const base::FilePath& path) {
+    return shards_[std::hash<base::FilePath>()(path) % kShardCount];
+  }
+
+  Shard shards_[kShardCount];
+
+  DISALLOW_COPY_AND_ASSIGN(DirectoryCache);
+};
+
+base::LazyInstance<DirectoryCache>::Leaky g_directory_cache =
+    LAZY_INSTANCE_INITIALIZER;
+
+bool IsDirectoryCached(const base::FilePath& path) {
+  // Paths that are open as archives are known to be files.
+  if (base::Contains(GetThreadCache()->archives, path))
+    return false;
+  return g_directory_cache.Get().IsDirectory(path);
 }
 
 }  // namespace
 
 std::shared_ptr<Archive> GetOrCreateAsarArchive(const base::FilePath& path) {
-  if (!g_archive_map_tls.Pointer()->Get())
-    g_archive_map_tls.Pointer()->Set(new ArchiveMap);
-  ArchiveMap& map = *g_archive_map_tls.Pointer()->Get();
+  ThreadArchiveCache* cache = GetThreadCache();
 
-  // if we have it, return it
-  const auto lower = map.lower_bound(path);
-  if (lower != std::end(map) && !map.key_comp()(path, lower->first))
+  // if this thread has seen it, return it
+  const auto lower = cache->archives.lower_bound(path);
+  if (lower != std::end(cache->archives) &&
+      !cache->archives.key_comp()(path, lower->first))
     return lower->second;
 
-  // if we can create it, return it
-  auto archive = std::make_shared<Archive>(path);
-  if (archive->Init()) {
-    base::TryEmplace(map, lower, path, archive);
-    return archive;
+  std::shared_ptr<Archive> archive;
+  {
+    ArchiveRegistry& registry = g_archive_registry.Get();
+    base::AutoLock auto_lock(registry.lock);
+
+    // if another thread has it, share it, otherwise try creating it while
+    // holding the lock so the header is only ever parsed once
+    auto it = registry.archives.find(path);
+    if (it != registry.archives.end()) {
+      archive = it->second;
+    } else {
+      archive = std::make_shared<Archive>(path);
+      if (!archive->Init()) {
+        // didn't have it, couldn't create it
+        return nullptr;
+      }
+      registry.archives[path] = archive;
+      OnArchiveOpened(path);
+    }
   }
 
-  // didn't have it, couldn't create it
-  return nullptr;
+  base::TryEmplace(cache->archives, lower, path, archive);
+  return archive;
 }
 
 void ClearArchives() {
-  if (g_archive_map_tls.Pointer()->Get())
-    delete g_archive_map_tls.Pointer()->Get();
+  ArchiveRegistry& registry = g_archive_registry.Get();
+  {
+    base::AutoLock auto_lock(registry.lock);
+    registry.archives.clear();
+    registry.generation.fetch_add(1, std::memory_order_release);
+  }
+  g_directory_cache.Get().Clear();
+  // Drop this thread's references right away, other threads drop theirs on
+  // their next lookup.
+  GetThreadCache();
+}
+
+void ClearArchivesOnMemoryPressure() {
+  static base::NoDestructor<base::MemoryPressureListener> listener(
+      base::BindRepeating(
+          [](base::MemoryPressureListener::MemoryPressureLevel level) {
+            if (level == base::MemoryPressureListener::
+                             MEMORY_PRESSURE_LEVEL_CRITICAL)
+              ClearArchives();
+          }));
 }
 
 bool GetAsarArchivePath(const base::FilePath& full_path,
@@ -109,14 +257,7 @@ bool ReadFileToString(const base::FilePath& path, std::string* contents) {
     return base::ReadFileToString(real_path, contents);
   }
 
-  base::File src(asar_path, base::File::FLAG_OPEN | base::File::FLAG_READ);
-  if (!src.IsValid())
-    return false;
-
-  contents->resize(info.size);
-  return static_cast<int>(info.size) ==
-         src.Read(info.offset, const_cast<char*>(contents->data()),
-                  contents->size());
+  return archive->ReadFile(relative_path, contents);
 }
 
 }  // namespace asar
@@ -16,12 +16,18 @@ namespace asar {
 
 class Archive;
 
-// Gets or creates a new Archive from the path.
+// Gets or creates a new Archive from the path. Archives are shared by all
+// threads of the process, so the header of an archive is only parsed once.
 std::shared_ptr<Archive> GetOrCreateAsarArchive(const base::FilePath& path);
 
-// Destroy cached Archive objects.
+// Destroy cached Archive objects of all threads.
 void ClearArchives();
 
+// Clears the cached Archive objects when the system is critically low on
+// memory, from the thread this is first called on. Holders of an Archive
+// keep using it, only the lookups have to parse the headers again.
+void ClearArchivesOnMemoryPressure();
+
 // Separates the path to Archive out.
 bool GetAsarArchivePath(const base::FilePath& full_path,
                         base::FilePath* asar_path,
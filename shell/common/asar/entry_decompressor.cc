@@ -0,0 +1,67 @@
+// Copyright (c) 2020 GitHub, Inc.
+// Use of this source code is governed by the MIT license that can be
+// found in the LICENSE file.
+
+#include "shell/common/asar/entry_decompressor.h"
+
+#include <algorithm>
+#include <vector>
+
+#include "base/stl_util.h"
+#include "third_party/brotli/include/brotli/decode.h"
+
+namespace asar {
+
+bool DecompressEntry(base::span<const uint8_t> input,
+                     uint32_t size,
+                     std::string* output) {
+  output->resize(size);
+  size_t decoded_size = size;
+  BrotliDecoderResult result = BrotliDecoderDecompress(
+      input.size(), input.data(), &decoded_size,
+      reinterpret_cast<uint8_t*>(base::data(*output)));
+  return result == BROTLI_DECODER_RESULT_SUCCESS && decoded_size == size;
+}
+
+EntryDecompressor::EntryDecompressor(base::span<const uint8_t> input)
+    : state_(BrotliDecoderCreateInstance(nullptr, nullptr, nullptr)),
+      next_in_(input.data()),
+      available_in_(input.size()) {}
+
+EntryDecompressor::~EntryDecompressor() {
+  if (state_)
+    BrotliDecoderDestroyInstance(state_);
+}
+
+int EntryDecompressor::Read(base::span<char> output) {
+  if (!state_)
+    return -1;
+
+  uint8_t* next_out = reinterpret_cast<uint8_t*>(output.data());
+  size_t available_out = output.size();
+  while (available_out > 0 && !finished_) {
+    BrotliDecoderResult result = BrotliDecoderDecompressStream(
+        state_, &available_in_, &next_in_, &available_out, &next_out, nullptr);
+    // Anything else is either corrupted data or input that ends before the
+    // end of the stream.
+    if (result == BROTLI_DECODER_RESULT_SUCCESS)
+      finished_ = true;
+    else if (result != BROTLI_DECODER_RESULT_NEEDS_MORE_OUTPUT)
+      return -1;
+  }
+  return static_cast<int>(output.size() - available_out);
+}
+
+bool EntryDecompressor::Skip(uint64_t count) {
+  std::vector<char> scratch(std::min<uint64_t>(count, 64 * 1024));
+  while (count > 0) {
+    size_t chunk = std::min<uint64_t>(count, scratch.size());
+    if (Read(base::make_span(scratch.data(), chunk)) !=
+        static_cast<int>(chunk))
+      return false;
+    count -= chunk;
+  }
+  return true;
+}
+
+}  // namespace asar
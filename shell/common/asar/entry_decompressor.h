@@ -0,0 +1,50 @@
+// Copyright (c) 2020 GitHub, Inc.
+// Use of this source code is governed by the MIT license that can be
+// found in the LICENSE file.
+
+#ifndef SHELL_COMMON_ASAR_ENTRY_DECOMPRESSOR_H_
+#define SHELL_COMMON_ASAR_ENTRY_DECOMPRESSOR_H_
+
+#include <string>
+
+#include "base/containers/span.h"
+#include "base/macros.h"
+
+struct BrotliDecoderStateStruct;
+
+namespace asar {
+
+// Decompresses a whole compressed entry of |size| bytes into |output|.
+bool DecompressEntry(base::span<const uint8_t> input,
+                     uint32_t size,
+                     std::string* output);
+
+// Incrementally decompresses a compressed entry, so large entries can be
+// streamed without inflating them in memory. The |input| must outlive the
+// decompressor.
+class EntryDecompressor {
+ public:
+  explicit EntryDecompressor(base::span<const uint8_t> input);
+  ~EntryDecompressor();
+
+  // Fills |output| with the next decompressed bytes. Returns the number of
+  // bytes written, which is only less than |output.size()| at the end of the
+  // entry, or -1 if the entry is corrupted.
+  int Read(base::span<char> output);
+
+  // Decompresses and drops the next |count| bytes, used to seek to the start
+  // of a byte range since compressed entries can not be read at an offset.
+  bool Skip(uint64_t count);
+
+ private:
+  BrotliDecoderStateStruct* state_;
+  const uint8_t* next_in_;
+  size_t available_in_;
+  bool finished_ = false;
+
+  DISALLOW_COPY_AND_ASSIGN(EntryDecompressor);
+};
+
+}  // namespace asar
+
+#endif  // SHELL_COMMON_ASAR_ENTRY_DECOMPRESSOR_H_
@@ -0,0 +1,234 @@
+// Copyright (c) 2020 GitHub, Inc.
+// Use of this source code is governed by the MIT license that can be
+// found in the LICENSE file.
+
+#include "shell/common/asar/extraction_cache.h"
+
+#include <algorithm>
+#include <utility>
+#include <vector>
+
+#include "base/bind.h"
+#include "base/callback.h"
+#include "base/command_line.h"
+#include "base/files/file_enumerator.h"
+#include "base/files/file_util.h"
+#include "base/hash/sha1.h"
+#include "base/lazy_instance.h"
+#include "base/strings/string_number_conversions.h"
+#include "base/strings/string_util.h"
+#include "base/strings/stringprintf.h"
+#include "base/synchronization/lock.h"
+#include "base/task/post_task.h"
+#include "base/threading/scoped_blocking_call.h"
+#include "base/threading/thread_restrictions.h"
+#include "base/time/time.h"
+#include "shell/common/options_switches.h"
+
+#if defined(OS_LINUX)
+#include <fcntl.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+
+#ifndef MFD_CLOEXEC
+#define MFD_CLOEXEC 0x0001U
+#endif
+#endif
+
+namespace asar {
+
+namespace {
+
+// Length of the hex encoded SHA-1 that starts every cache file name.
+const size_t kCacheKeyLength = 2 * base::kSHA1Length;
+
+// The least recently used files are evicted above this size.
+const int64_t kMaxCacheSize = 512 * 1024 * 1024;
+
+// Files used more recently than this are never evicted, they may be in use by
+// another instance of the app.
+const base::TimeDelta kMinEvictionAge = base::TimeDelta::FromDays(1);
+
+// Files that are unused for this long are evicted regardless of the size.
+const base::TimeDelta kMaxUnusedAge = base::TimeDelta::FromDays(30);
+
+// Temporary files of extractions that never finished are removed after this.
+const base::TimeDelta kStaleTemporaryFileAge = base::TimeDelta::FromHours(1);
+
+struct CacheDirGetter {
+  base::Lock lock;
+  base::RepeatingCallback<base::FilePath()> getter;
+};
+
+base::LazyInstance<CacheDirGetter>::Leaky g_cache_dir_getter =
+    LAZY_INSTANCE_INITIALIZER;
+
+bool IsCacheFileName(const base::FilePath& path) {
+  std::string name = path.BaseName().AsUTF8Unsafe();
+  if (name.size() < kCacheKeyLength)
+    return false;
+  return std::all_of(name.begin(), name.begin() + kCacheKeyLength,
+                     base::IsHexDigit<char>);
+}
+
+struct CacheFile {
+  base::FilePath path;
+  int64_t size;
+  base::Time last_used;
+};
+
+void TrimCache(const base::FilePath& dir) {
+  base::ScopedBlockingCall scoped_blocking_call(FROM_HERE,
+                                                base::BlockingType::MAY_BLOCK);
+  base::Time now = base::Time::Now();
+  std::vector<CacheFile> files;
+  base::FileEnumerator enumerator(dir, false, base::FileEnumerator::FILES);
+  for (base::FilePath path = enumerator.Next(); !path.empty();
+       path = enumerator.Next()) {
+    base::FileEnumerator::FileInfo info = enumerator.GetInfo();
+    if (!IsCacheFileName(path)) {
+      if (now - info.GetLastModifiedTime() > kStaleTemporaryFileAge)
+        base::DeleteFile(path, false);
+      continue;
+    }
+    files.push_back({path, info.GetSize(), info.GetLastModifiedTime()});
+  }
+
+  // Keep the most recently used files that fit, deleting fails for files that
+  // are in use on Windows, which is fine.
+  std::sort(files.begin(), files.end(),
+            [](const CacheFile& a, const CacheFile& b) {
+              return a.last_used > b.last_used;
+            });
+  int64_t total_size = 0;
+  for (const CacheFile& file : files) {
+    total_size += file.size;
+    base::TimeDelta unused = now - file.last_used;
+    if (unused > kMaxUnusedAge ||
+        (total_size > kMaxCacheSize && unused > kMinEvictionAge))
+      base::DeleteFile(file.path, false);
+  }
+}
+
+}  // namespace
+
+void SetExtractionCacheDirGetter(
+    base::RepeatingCallback<base::FilePath()> getter) {
+  CacheDirGetter& cache_dir_getter = g_cache_dir_getter.Get();
+  base::AutoLock auto_lock(cache_dir_getter.lock);
+  cache_dir_getter.getter = std::move(getter);
+}
+
+base::FilePath GetExtractionCacheDir() {
+  {
+    CacheDirGetter& cache_dir_getter = g_cache_dir_getter.Get();
+    base::AutoLock auto_lock(cache_dir_getter.lock);
+    if (cache_dir_getter.getter)
+      return cache_dir_getter.getter.Run();
+  }
+  return base::CommandLine::ForCurrentProcess()->GetSwitchValuePath(
+      electron::switches::kAsarCacheDir);
+}
+
+base::FilePath::StringType GetExtractionCacheName(
+    const base::FilePath& archive_path,
+    const base::File::Info& archive_info,
+    uint64_t offset,
+    uint32_t size,
+    const base::FilePath::StringType& extension) {
+  std::string identity = base::StringPrintf(
+      "%s\n%lld\n%lld\n%llu\n%u", archive_path.AsUTF8Unsafe().c_str(),
+      static_cast<long long>(archive_info.size),
+      static_cast<long long>(
+          archive_info.last_modified.ToDeltaSinceWindowsEpoch()
+              .InMicroseconds()),
+      static_cast<unsigned long long>(offset), size);
+  std::string hash = base::SHA1HashString(identity);
+  std::string key =
+      base::ToLowerASCII(base::HexEncode(hash.data(), hash.size()));
+  return base::FilePath::FromUTF8Unsafe(key).value() + extension;
+}
+
+bool IsExtractedFileCached(const base::FilePath& path, uint32_t size) {
+  base::ThreadRestrictions::ScopedAllowIO allow_io;
+  base::File::Info info;
+  if (!base::GetFileInfo(path, &info) || info.is_directory ||
+      info.size != static_cast<int64_t>(size))
+    return false;
+  // The modification time doubles as the last use for the eviction.
+  base::Time now = base::Time::Now();
+  base::TouchFile(path, now, now);
+  return true;
+}
+
+bool WriteExtractedFile(const base::FilePath& path,
+                        base::span<const uint8_t> contents,
+                        bool executable) {
+  base::ThreadRestrictions::ScopedAllowIO allow_io;
+  base::FilePath dir = path.DirName();
+  base::FilePath temp_path;
+  if (!base::CreateDirectory(dir) ||
+      !base::CreateTemporaryFileInDir(dir, &temp_path))
+    return false;
+
+  bool written =
+      base::WriteFile(temp_path, reinterpret_cast<const char*>(contents.data()),
+                      contents.size()) == static_cast<int>(contents.size());
+#if defined(OS_POSIX)
+  if (written && executable)
+    written = base::SetPosixFilePermissions(temp_path, 0755);
+#endif
+  if (written && base::ReplaceFile(temp_path, path, nullptr))
+    return true;
+
+  base::DeleteFile(temp_path, false);
+  // Another process may have won the race, or on Windows be running the file
+  // so that it can not be replaced.
+  return written && IsExtractedFileCached(path, contents.size());
+}
+
+#if defined(OS_LINUX)
+bool WriteMemoryFile(const std::string& name,
+                     base::span<const uint8_t> contents,
+                     base::ScopedFD* fd,
+                     base::FilePath* path) {
+#if defined(__NR_memfd_create)
+  base::ScopedFD writable(
+      static_cast<int>(syscall(__NR_memfd_create, name.c_str(), MFD_CLOEXEC)));
+  if (!writable.is_valid() ||
+      !base::WriteFileDescriptor(
+          writable.get(), reinterpret_cast<const char*>(contents.data()),
+          contents.size()))
+    return false;
+
+  // The kernel refuses to execute files that are open for writing, so only a
+  // read-only descriptor is kept open.
+  std::string writable_path =
+      base::StringPrintf("/proc/self/fd/%d", writable.get());
+  fd->reset(open(writable_path.c_str(), O_RDONLY | O_CLOEXEC));
+  if (!fd->is_valid())
+    return false;
+
+  // Child processes resolve the path in the file table of this process.
+  *path = base::FilePath(
+      base::StringPrintf("/proc/%d/fd/%d", getpid(), fd->get()));
+  return true;
+#else
+  return false;
+#endif
+}
+#endif
+
+void ScheduleExtractionCacheTrim() {
+  base::FilePath dir = GetExtractionCacheDir();
+  if (dir.empty())
+    return;
+
+  base::PostTask(
+      FROM_HERE,
+      {base::ThreadPool(), base::MayBlock(), base::TaskPriority::BEST_EFFORT,
+       base::TaskShutdownBehavior::SKIP_ON_SHUTDOWN},
+      base::BindOnce(&TrimCache, dir));
+}
+
+}  // namespace asar
@@ -0,0 +1,76 @@
+// Copyright (c) 2020 GitHub, Inc.
+// Use of this source code is governed by the MIT license that can be
+// found in the LICENSE file.
+
+#ifndef SHELL_COMMON_ASAR_EXTRACTION_CACHE_H_
+#define SHELL_COMMON_ASAR_EXTRACTION_CACHE_H_
+
+#include <stdint.h>
+
+#include <string>
+
+#include "base/callback_forward.h"
+#include "base/containers/span.h"
+#include "base/files/file.h"
+#include "base/files/file_path.h"
+#include "build/build_config.h"
+
+#if defined(OS_LINUX)
+#include "base/files/scoped_file.h"
+#endif
+
+namespace asar {
+
+// Persistent cache of files extracted from asar archives.
+//
+// Files that must exist on disk, like native modules and executables, are
+// extracted into a directory under the user data directory that is kept
+// between runs, instead of into new temporary files on every launch. Cached
+// files are named after a hash of the archive identity and the location of
+// the entry in it, so a changed archive never reuses stale copies.
+
+// Sets the function returning the cache directory in the browser process. It
+// is called on every extraction so that it follows changes of the user data
+// directory, and can be called from any thread.
+void SetExtractionCacheDirGetter(
+    base::RepeatingCallback<base::FilePath()> getter);
+
+// Returns the cache directory of this process, or an empty path when there is
+// none and files have to be extracted to temporary files. Child processes get
+// it from the --asar-cache-dir switch.
+base::FilePath GetExtractionCacheDir();
+
+// Returns the file name of the cached copy of an entry.
+base::FilePath::StringType GetExtractionCacheName(
+    const base::FilePath& archive_path,
+    const base::File::Info& archive_info,
+    uint64_t offset,
+    uint32_t size,
+    const base::FilePath::StringType& extension);
+
+// Returns true if |path| is a complete cached copy of |size| bytes, and marks
+// it as recently used.
+bool IsExtractedFileCached(const base::FilePath& path, uint32_t size);
+
+// Atomically writes |contents| to |path|, so that other processes extracting
+// the same entry never see a partial file.
+bool WriteExtractedFile(const base::FilePath& path,
+                        base::span<const uint8_t> contents,
+                        bool executable);
+
+#if defined(OS_LINUX)
+// Writes |contents| to an anonymous memory file and returns a path to it that
+// stays valid for child processes while |fd| is open.
+bool WriteMemoryFile(const std::string& name,
+                     base::span<const uint8_t> contents,
+                     base::ScopedFD* fd,
+                     base::FilePath* path);
+#endif
+
+// Evicts the least recently used files once the cache has grown too large,
+// on a background thread.
+void ScheduleExtractionCacheTrim();
+
+}  // namespace asar
+
+#endif  // SHELL_COMMON_ASAR_EXTRACTION_CACHE_H_
@@ -0,0 +1,153 @@
+// Copyright (c) 2020 GitHub, Inc.
+// Use of this source code is governed by the MIT license that can be
+// found in the LICENSE file.
+
+#include "shell/common/asar/header_index.h"
+
+#include <algorithm>
+#include <cstring>
+
+namespace asar {
+
+namespace {
+
+static_assert(sizeof(HeaderIndex::Entry) == 32,
+              "HeaderIndex::Entry must match the on-disk layout");
+
+// Bound the number of links followed for a single lookup, so a cyclic link
+// in a corrupted archive can not hang us.
+const int kMaxLinkDepth = 32;
+
+const size_t kPreambleSize = 4 * sizeof(uint32_t);
+
+uint32_t ReadUInt32(const char* data) {
+  uint32_t value;
+  memcpy(&value, data, sizeof(value));
+  return value;
+}
+
+}  // namespace
+
+HeaderIndex::HeaderIndex() = default;
+
+HeaderIndex::~HeaderIndex() = default;
+
+// static
+bool HeaderIndex::IsHeaderIndex(const char* payload, size_t size) {
+  return size >= kPreambleSize && ReadUInt32(payload) == kMagic;
+}
+
+bool HeaderIndex::Init(const char* payload, size_t size) {
+  if (!IsHeaderIndex(payload, size))
+    return false;
+
+  const uint64_t entry_count = ReadUInt32(payload + 4);
+  const uint64_t child_count = ReadUInt32(payload + 8);
+  const uint64_t string_size = ReadUInt32(payload + 12);
+  const uint64_t expected_size = kPreambleSize + entry_count * sizeof(Entry) +
+                                 child_count * sizeof(uint32_t) + string_size;
+  if (entry_count == 0 || expected_size > size)
+    return false;
+
+  data_.assign(payload, payload + expected_size);
+  entries_ = reinterpret_cast<const Entry*>(data_.data() + kPreambleSize);
+  children_ = reinterpret_cast<const uint32_t*>(entries_ + entry_count);
+  strings_ = reinterpret_cast<const char*>(children_ + child_count);
+  entry_count_ = static_cast<uint32_t>(entry_count);
+  child_count_ = static_cast<uint32_t>(child_count);
+
+  // Validate every reference once here, so lookups never need to.
+  for (uint32_t i = 0; i < entry_count_; ++i) {
+    const Entry& entry = entries_[i];
+    if (uint64_t{entry.path_offset} + entry.path_size > string_size)
+      return false;
+    if ((entry.flags & kLink) && entry.first >= entry_count_)
+      return false;
+    if ((entry.flags & kDirectory) &&
+        uint64_t{entry.first} + entry.count > child_count_)
+      return false;
+  }
+  for (uint32_t i = 0; i < child_count_; ++i) {
+    if (children_[i] >= entry_count_)
+      return false;
+  }
+  return entries_[0].path_size == 0 && (entries_[0].flags & kDirectory);
+}
+
+const HeaderIndex::Entry* HeaderIndex::Find(base::StringPiece path) const {
+  return FindWithDepth(path, 0);
+}
+
+const HeaderIndex::Entry* HeaderIndex::Resolve(const Entry* entry) const {
+  for (int depth = 0; entry && (entry->flags & kLink); ++depth) {
+    if (depth == kMaxLinkDepth)
+      return nullptr;
+    entry = &entries_[entry->first];
+  }
+  return entry;
+}
+
+std::vector<const HeaderIndex::Entry*> HeaderIndex::Children(
+    const Entry* entry) const {
+  std::vector<const Entry*> result;
+  if (!entry || !(entry->flags & kDirectory))
+    return result;
+  result.reserve(entry->count);
+  for (uint32_t i = entry->first; i < entry->first + entry->count; ++i)
+    result.push_back(&entries_[children_[i]]);
+  return result;
+}
+
+base::StringPiece HeaderIndex::PathOf(const Entry* entry) const {
+  return base::StringPiece(strings_ + entry->path_offset, entry->path_size);
+}
+
+base::StringPiece HeaderIndex::NameOf(const Entry* entry) const {
+  base::StringPiece path = PathOf(entry);
+  size_t pos = path.rfind('/');
+  return pos == base::StringPiece::npos ? path : path.substr(pos + 1);
+}
+
+const HeaderIndex::Entry* HeaderIndex::FindExact(
+    base::StringPiece path) const {
+  const Entry* end = entries_ + entry_count_;
+  const Entry* it = std::lower_bound(
+      entries_, end, path, [this](const Entry& entry, base::StringPiece key) {
+        return PathOf(&entry) < key;
+      });
+  if (it == end || PathOf(it) != path)
+    return nullptr;
+  return it;
+}
+
+const HeaderIndex::Entry* HeaderIndex::FindWithDepth(base::StringPiece path,
+                                                     int depth) const {
+  if (depth > kMaxLinkDepth)
+    return nullptr;
+
+  // The common case: the path does not go through a linked directory.
+  const Entry* entry = FindExact(path);
+  if (entry)
+    return entry;
+
+  // Otherwise look for the first linked component and restart from its
+  // target, this only happens on misses and is bounded by the path depth.
+  for (size_t pos = path.find('/'); pos != base::StringPiece::npos;
+       pos = path.find('/', pos + 1)) {
+    const Entry* parent = FindExact(path.substr(0, pos));
+    if (!parent)
+      return nullptr;
+    if (!(parent->flags & kLink))
+      continue;
+
+    base::StringPiece target = PathOf(&entries_[parent->first]);
+    std::string rebased = target.as_string();
+    if (!rebased.empty())
+      rebased.push_back('/');
+    path.substr(pos + 1).AppendToString(&rebased);
+    return FindWithDepth(rebased, depth + 1);
+  }
+  return nullptr;
+}
+
+}  // namespace asar
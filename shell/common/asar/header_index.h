@@ -0,0 +1,101 @@
+// Copyright (c) 2020 GitHub, Inc.
+// Use of this source code is governed by the MIT license that can be
+// found in the LICENSE file.
+
+#ifndef SHELL_COMMON_ASAR_HEADER_INDEX_H_
+#define SHELL_COMMON_ASAR_HEADER_INDEX_H_
+
+#include <string>
+#include <vector>
+
+#include "base/macros.h"
+#include "base/strings/string_piece.h"
+
+namespace asar {
+
+// The "v2" asar header: a flat table of fixed-width entries sorted by their
+// full path, so that lookups are a binary search instead of a JSON parse
+// followed by a walk of the directory tree.
+//
+// The header pickle payload is laid out as (all fields little-endian):
+//
+//   uint32 magic            kMagic
+//   uint32 entry_count
+//   uint32 child_count      number of uint32s in the children table
+//   uint32 string_size      number of bytes in the string table
+//   Entry  entries[entry_count]
+//   uint32 children[child_count]
+//   char   strings[string_size]
+//
+// Entry paths are relative to the archive root, use "/" as separator and are
+// compared bytewise. The root directory is the entry with an empty path.
+class HeaderIndex {
+ public:
+  // "ASR2" when read as a little-endian uint32. In a v1 header this position
+  // holds the length of the JSON string, which can never be this large.
+  static constexpr uint32_t kMagic = 0x32525341;
+
+  enum Flags : uint32_t {
+    kDirectory = 1 << 0,
+    kLink = 1 << 1,
+    kUnpacked = 1 << 2,
+    kExecutable = 1 << 3,
+    kCompressed = 1 << 4,
+  };
+
+  struct Entry {
+    uint32_t path_offset;
+    uint32_t path_size;
+    uint32_t flags;
+    uint32_t size;
+    // Offset of the file content, relative to the end of the header.
+    uint64_t offset;
+    // For directories the range in the children table, for links |first| is
+    // the index of the link target and for compressed files |count| is the
+    // size of the compressed data.
+    uint32_t first;
+    uint32_t count;
+  };
+
+  HeaderIndex();
+  ~HeaderIndex();
+
+  // Returns true if |payload| starts with the v2 magic.
+  static bool IsHeaderIndex(const char* payload, size_t size);
+
+  // Copies and validates the table, returns false if it is malformed.
+  bool Init(const char* payload, size_t size);
+
+  // Finds the entry of |path|, following links in intermediate components.
+  // The final component is not resolved, so links are returned as links.
+  const Entry* Find(base::StringPiece path) const;
+
+  // Follows |entry| while it is a link.
+  const Entry* Resolve(const Entry* entry) const;
+
+  // Returns the children of a directory entry.
+  std::vector<const Entry*> Children(const Entry* entry) const;
+
+  // Returns the full path and the last path component of |entry|.
+  base::StringPiece PathOf(const Entry* entry) const;
+  base::StringPiece NameOf(const Entry* entry) const;
+
+  size_t size() const { return entry_count_; }
+
+ private:
+  const Entry* FindExact(base::StringPiece path) const;
+  const Entry* FindWithDepth(base::StringPiece path, int depth) const;
+
+  std::vector<char> data_;
+  const Entry* entries_ = nullptr;
+  const uint32_t* children_ = nullptr;
+  const char* strings_ = nullptr;
+  uint32_t entry_count_ = 0;
+  uint32_t child_count_ = 0;
+
+  DISALLOW_COPY_AND_ASSIGN(HeaderIndex);
+};
+
+}  // namespace asar
+
+#endif  // SHELL_COMMON_ASAR_HEADER_INDEX_H_
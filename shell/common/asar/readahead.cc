@@ -0,0 +1,217 @@
+// Copyright (c) 2020 GitHub, Inc.
+// Use of this source code is governed by the MIT license that can be
+// found in the LICENSE file.
+
+#include "shell/common/asar/readahead.h"
+
+#include <algorithm>
+#include <atomic>
+#include <limits>
+#include <map>
+#include <set>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "base/bind.h"
+#include "base/environment.h"
+#include "base/files/file.h"
+#include "base/files/file_path.h"
+#include "base/files/file_util.h"
+#include "base/lazy_instance.h"
+#include "base/logging.h"
+#include "base/strings/string_number_conversions.h"
+#include "base/strings/string_split.h"
+#include "base/strings/stringprintf.h"
+#include "base/synchronization/lock.h"
+#include "base/task/post_task.h"
+#include "base/threading/scoped_blocking_call.h"
+#include "build/build_config.h"
+
+#if defined(OS_POSIX)
+#include <fcntl.h>
+#endif
+
+namespace asar {
+
+namespace {
+
+// (offset, size) in bytes from the start of the archive file.
+using Range = std::pair<uint64_t, uint64_t>;
+
+const char kRecordReadaheadEnvVar[] = "ELECTRON_RECORD_ASAR_READAHEAD";
+const char kManifestHeader[] = "# asar readahead manifest";
+const base::FilePath::CharType kManifestExtension[] =
+    FILE_PATH_LITERAL("readahead");
+
+// Ranges closer than this are prefetched as one.
+const uint64_t kCoalesceGap = 64 * 1024;
+
+struct Recording {
+  std::vector<Range> ranges;
+  std::set<Range> seen;
+};
+
+struct ReadaheadState {
+  base::Lock lock;
+  bool enabled = false;
+  std::set<base::FilePath> opened;
+  std::map<base::FilePath, Recording> recordings;
+};
+
+base::LazyInstance<ReadaheadState>::Leaky g_state = LAZY_INSTANCE_INITIALIZER;
+
+// Checked without the lock on every read.
+std::atomic<bool> g_recording{false};
+
+base::FilePath GetManifestPath(const base::FilePath& path) {
+  return path.AddExtension(kManifestExtension);
+}
+
+bool ParseManifest(const std::string& contents, std::vector<Range>* ranges) {
+  std::vector<base::StringPiece> lines = base::SplitStringPiece(
+      contents, "\n", base::TRIM_WHITESPACE, base::SPLIT_WANT_NONEMPTY);
+  if (lines.empty() || lines[0] != kManifestHeader)
+    return false;
+  for (size_t i = 1; i < lines.size(); ++i) {
+    std::vector<base::StringPiece> fields = base::SplitStringPiece(
+        lines[i], " ", base::TRIM_WHITESPACE, base::SPLIT_WANT_NONEMPTY);
+    Range range;
+    if (fields.size() != 2 || !base::StringToUint64(fields[0], &range.first) ||
+        !base::StringToUint64(fields[1], &range.second))
+      return false;
+    ranges->push_back(range);
+  }
+  return true;
+}
+
+void Prefetch(const base::FilePath& path) {
+  base::ScopedBlockingCall scoped_blocking_call(FROM_HERE,
+                                                base::BlockingType::MAY_BLOCK);
+  std::string contents;
+  if (!base::ReadFileToString(GetManifestPath(path), &contents))
+    return;
+
+  std::vector<Range> ranges;
+  if (!ParseManifest(contents, &ranges)) {
+    LOG(WARNING) << "Ignoring invalid readahead manifest of " << path.value();
+    return;
+  }
+
+  base::File file(path, base::File::FLAG_OPEN | base::File::FLAG_READ);
+  if (!file.IsValid())
+    return;
+
+  // The manifest is in access order, prefetch in file order so that the whole
+  // set is read in one sweep.
+  std::sort(ranges.begin(), ranges.end());
+  std::vector<Range> merged;
+  for (const Range& range : ranges) {
+    if (!merged.empty() &&
+        range.first <= merged.back().first + merged.back().second +
+                           kCoalesceGap) {
+      uint64_t end = std::max(merged.back().first + merged.back().second,
+                              range.first + range.second);
+      merged.back().second = end - merged.back().first;
+    } else {
+      merged.push_back(range);
+    }
+  }
+
+#if defined(OS_WIN)
+  std::vector<char> buffer;
+#endif
+  for (const Range& range : merged) {
+#if defined(OS_MACOSX)
+    radvisory advice;
+    advice.ra_offset = range.first;
+    advice.ra_count = static_cast<int>(
+        std::min<uint64_t>(range.second, std::numeric_limits<int>::max()));
+    fcntl(file.GetPlatformFile(), F_RDADVISE, &advice);
+#elif defined(OS_POSIX)
+    posix_fadvise(file.GetPlatformFile(), range.first, range.second,
+                  POSIX_FADV_WILLNEED);
+#else
+    // There is no advisory readahead for plain handles on Windows, reading
+    // the ranges once has the same effect on the system file cache.
+    buffer.resize(std::min<uint64_t>(range.second, 1024 * 1024));
+    for (uint64_t offset = range.first; offset < range.first + range.second;
+         offset += buffer.size()) {
+      if (file.Read(offset, buffer.data(), buffer.size()) <= 0)
+        break;
+    }
+#endif
+  }
+}
+
+void WriteManifests(std::map<base::FilePath, Recording> recordings) {
+  base::ScopedBlockingCall scoped_blocking_call(FROM_HERE,
+                                                base::BlockingType::MAY_BLOCK);
+  for (const auto& it : recordings) {
+    std::string contents = kManifestHeader;
+    contents.push_back('\n');
+    for (const Range& range : it.second.ranges) {
+      base::StringAppendF(&contents, "%llu %llu\n",
+                          static_cast<unsigned long long>(range.first),
+                          static_cast<unsigned long long>(range.second));
+    }
+    base::FilePath manifest = GetManifestPath(it.first);
+    if (base::WriteFile(manifest, contents.data(), contents.size()) !=
+        static_cast<int>(contents.size()))
+      LOG(ERROR) << "Failed to write " << manifest.value();
+  }
+}
+
+}  // namespace
+
+void EnableStartupReadahead() {
+  ReadaheadState& state = g_state.Get();
+  base::AutoLock auto_lock(state.lock);
+  state.enabled = true;
+  g_recording = base::Environment::Create()->HasVar(kRecordReadaheadEnvVar);
+}
+
+void OnArchiveOpened(const base::FilePath& path) {
+  ReadaheadState& state = g_state.Get();
+  base::AutoLock auto_lock(state.lock);
+  if (!state.enabled || g_recording || !state.opened.insert(path).second)
+    return;
+
+  base::PostTask(
+      FROM_HERE,
+      {base::ThreadPool(), base::MayBlock(), base::TaskPriority::USER_VISIBLE,
+       base::TaskShutdownBehavior::CONTINUE_ON_SHUTDOWN},
+      base::BindOnce(&Prefetch, path));
+}
+
+void RecordArchiveRead(const base::FilePath& path,
+                       uint64_t offset,
+                       uint64_t size) {
+  if (!g_recording.load(std::memory_order_relaxed))
+    return;
+
+  ReadaheadState& state = g_state.Get();
+  base::AutoLock auto_lock(state.lock);
+  Recording& recording = state.recordings[path];
+  if (recording.seen.emplace(offset, size).second)
+    recording.ranges.emplace_back(offset, size);
+}
+
+void FinishStartupRecording() {
+  if (!g_recording.exchange(false))
+    return;
+
+  std::map<base::FilePath, Recording> recordings;
+  {
+    ReadaheadState& state = g_state.Get();
+    base::AutoLock auto_lock(state.lock);
+    recordings.swap(state.recordings);
+  }
+  base::PostTask(
+      FROM_HERE,
+      {base::ThreadPool(), base::MayBlock(), base::TaskPriority::BEST_EFFORT,
+       base::TaskShutdownBehavior::BLOCK_SHUTDOWN},
+      base::BindOnce(&WriteManifests, std::move(recordings)));
+}
+
+}  // namespace asar
@@ -0,0 +1,42 @@
+// Copyright (c) 2020 GitHub, Inc.
+// Use of this source code is governed by the MIT license that can be
+// found in the LICENSE file.
+
+#ifndef SHELL_COMMON_ASAR_READAHEAD_H_
+#define SHELL_COMMON_ASAR_READAHEAD_H_
+
+#include <stdint.h>
+
+namespace base {
+class FilePath;
+}
+
+namespace asar {
+
+// Startup readahead for asar archives.
+//
+// When recording, every range read from an archive is logged in the order it
+// was first touched, and once startup has finished the ranges are written to
+// a manifest next to the archive ("app.asar.readahead"). When an archive with
+// a manifest is opened, the recorded ranges are prefetched into the page
+// cache on a background thread in one pass, instead of being faulted in by
+// hundreds of small reads.
+
+// Enables prefetching for archives opened in this process, and recording when
+// the ELECTRON_RECORD_ASAR_READAHEAD environment variable is set.
+void EnableStartupReadahead();
+
+// Called when an archive is opened for the first time in this process.
+void OnArchiveOpened(const base::FilePath& path);
+
+// Logs a read of |size| bytes at |offset| of the archive at |path|.
+void RecordArchiveRead(const base::FilePath& path,
+                       uint64_t offset,
+                       uint64_t size);
+
+// Stops recording and writes the manifests of all archives read so far.
+void FinishStartupRecording();
+
+}  // namespace asar
+
+#endif  // SHELL_COMMON_ASAR_READAHEAD_H_
@@ -0,0 +1,170 @@
+// Copyright (c) 2020 GitHub, Inc.
+// Use of this source code is governed by the MIT license that can be
+// found in the LICENSE file.
+
+#include "shell/common/asar/synthetic_archive.h"
+
+#include <map>
+#include <memory>
+#include <utility>
+
+#include "base/files/file_path.h"
+#include "base/files/file_util.h"
+#include "base/json/json_writer.h"
+#include "base/pickle.h"
+#include "base/strings/string_number_conversions.h"
+#include "base/strings/string_split.h"
+#include "base/strings/stringprintf.h"
+#include "base/values.h"
+#include "shell/common/asar/header_index.h"
+
+namespace asar {
+
+namespace {
+
+const size_t kFilesPerDirectory = 100;
+
+base::DictionaryValue* GetOrCreateFiles(base::DictionaryValue* dir) {
+  base::DictionaryValue* files;
+  if (!dir->GetDictionaryWithoutPathExpansion("files", &files)) {
+    files = dir->SetDictionaryWithoutPathExpansion(
+        "files", std::make_unique<base::DictionaryValue>());
+  }
+  return files;
+}
+
+std::string BuildJSONHeader(const std::vector<SyntheticFile>& files) {
+  base::DictionaryValue root;
+  GetOrCreateFiles(&root);
+  uint64_t offset = 0;
+  for (const SyntheticFile& file : files) {
+    std::vector<std::string> parts = base::SplitString(
+        file.path, "/", base::KEEP_WHITESPACE, base::SPLIT_WANT_NONEMPTY);
+    base::DictionaryValue* dir = &root;
+    for (size_t i = 0; i + 1 < parts.size(); ++i) {
+      base::DictionaryValue* files_node = GetOrCreateFiles(dir);
+      if (!files_node->GetDictionaryWithoutPathExpansion(parts[i], &dir)) {
+        dir = files_node->SetDictionaryWithoutPathExpansion(
+            parts[i], std::make_unique<base::DictionaryValue>());
+      }
+    }
+    auto entry = std::make_unique<base::DictionaryValue>();
+    entry->SetIntKey("size", static_cast<int>(file.contents.size()));
+    entry->SetStringKey("offset", base::NumberToString(offset));
+    GetOrCreateFiles(dir)->SetWithoutPathExpansion(parts.back(),
+                                                   std::move(entry));
+    offset += file.contents.size();
+  }
+
+  std::string json;
+  base::JSONWriter::Write(root, &json);
+  return json;
+}
+
+void AppendUInt32(std::string* out, uint32_t value) {
+  out->append(reinterpret_cast<const char*>(&value), sizeof(value));
+}
+
+std::string BuildHeaderIndex(const std::vector<SyntheticFile>& files) {
+  struct Node {
+    bool is_directory = true;
+    uint32_t size = 0;
+    uint64_t offset = 0;
+    std::vector<std::string> children;
+  };
+
+  // std::map keeps the paths sorted bytewise, like the index requires.
+  std::map<std::string, Node> nodes;
+  nodes[""];
+  uint64_t offset = 0;
+  for (const SyntheticFile& file : files) {
+    Node& node = nodes[file.path];
+    node.is_directory = false;
+    node.size = static_cast<uint32_t>(file.contents.size());
+    node.offset = offset;
+    offset += file.contents.size();
+    for (size_t slash = file.path.find('/'); slash != std::string::npos;
+         slash = file.path.find('/', slash + 1)) {
+      nodes[file.path.substr(0, slash)];
+    }
+  }
+
+  std::map<std::string, uint32_t> indices;
+  for (const auto& it : nodes) {
+    uint32_t index = static_cast<uint32_t>(indices.size());
+    indices[it.first] = index;
+    if (!it.first.empty()) {
+      size_t slash = it.first.rfind('/');
+      std::string parent = slash == std::string::npos
+                               ? std::string()
+                               : it.first.substr(0, slash);
+      nodes[parent].children.push_back(it.first);
+    }
+  }
+
+  std::string entries, children, strings;
+  for (const auto& it : nodes) {
+    HeaderIndex::Entry entry = {};
+    entry.path_offset = static_cast<uint32_t>(strings.size());
+    entry.path_size = static_cast<uint32_t>(it.first.size());
+    if (it.second.is_directory) {
+      entry.flags = HeaderIndex::kDirectory;
+      entry.first = static_cast<uint32_t>(children.size() / sizeof(uint32_t));
+      entry.count = static_cast<uint32_t>(it.second.children.size());
+      for (const std::string& child : it.second.children)
+        AppendUInt32(&children, indices[child]);
+    } else {
+      entry.size = it.second.size;
+      entry.offset = it.second.offset;
+    }
+    entries.append(reinterpret_cast<const char*>(&entry), sizeof(entry));
+    strings.append(it.first);
+  }
+
+  std::string payload;
+  AppendUInt32(&payload, HeaderIndex::kMagic);
+  AppendUInt32(&payload, static_cast<uint32_t>(nodes.size()));
+  AppendUInt32(&payload,
+               static_cast<uint32_t>(children.size() / sizeof(uint32_t)));
+  AppendUInt32(&payload, static_cast<uint32_t>(strings.size()));
+  return payload + entries + children + strings;
+}
+
+}  // namespace
+
+std::vector<SyntheticFile> MakeSyntheticFiles(size_t count, size_t size) {
+  std::vector<SyntheticFile> files(count);
+  for (size_t i = 0; i < count; ++i) {
+    files[i].path = base::StringPrintf("d%zu/f%zu.js", i / kFilesPerDirectory,
+                                       i % kFilesPerDirectory);
+    files[i].contents.assign(size, static_cast<char>('a' + i % 26));
+  }
+  return files;
+}
+
+bool WriteSyntheticArchive(const base::FilePath& path,
+                           const std::vector<SyntheticFile>& files,
+                           bool indexed) {
+  base::Pickle header_pickle;
+  if (indexed) {
+    std::string payload = BuildHeaderIndex(files);
+    header_pickle.WriteBytes(payload.data(), payload.size());
+  } else {
+    header_pickle.WriteString(BuildJSONHeader(files));
+  }
+
+  base::Pickle size_pickle;
+  size_pickle.WriteUInt32(header_pickle.size());
+
+  std::string archive(static_cast<const char*>(size_pickle.data()),
+                      size_pickle.size());
+  archive.append(static_cast<const char*>(header_pickle.data()),
+                 header_pickle.size());
+  for (const SyntheticFile& file : files)
+    archive.append(file.contents);
+
+  return base::WriteFile(path, archive.data(), archive.size()) ==
+         static_cast<int>(archive.size());
+}
+
+}  // namespace asar
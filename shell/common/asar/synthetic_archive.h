@@ -0,0 +1,36 @@
+// Copyright (c) 2020 GitHub, Inc.
+// Use of this source code is governed by the MIT license that can be
+// found in the LICENSE file.
+
+#ifndef SHELL_COMMON_ASAR_SYNTHETIC_ARCHIVE_H_
+#define SHELL_COMMON_ASAR_SYNTHETIC_ARCHIVE_H_
+
+#include <string>
+#include <vector>
+
+namespace base {
+class FilePath;
+}
+
+namespace asar {
+
+// Generated archives for benchmarks and tests.
+
+struct SyntheticFile {
+  // Relative to the archive root, with "/" as separator.
+  std::string path;
+  std::string contents;
+};
+
+// Returns |count| files of |size| bytes, in directories of 100 files each.
+std::vector<SyntheticFile> MakeSyntheticFiles(size_t count, size_t size);
+
+// Writes |files| as an archive with either a JSON (v1) or a pre-indexed (v2)
+// header.
+bool WriteSyntheticArchive(const base::FilePath& path,
+                           const std::vector<SyntheticFile>& files,
+                           bool indexed);
+
+}  // namespace asar
+
+#endif  // SHELL_COMMON_ASAR_SYNTHETIC_ARCHIVE_H_
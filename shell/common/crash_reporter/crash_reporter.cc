@@ -71,6 +71,10 @@ void CrashReporter::SetUploadParameters(const StringMap& parameters) {
   SetUploadParameters();
 }
 
+void CrashReporter::SetDumpOptions(bool compress,
+                                   bool small_dumps,
+                                   bool defer_uploads) {}
+
 void CrashReporter::SetUploadToServer(const bool upload_to_server) {}
 
 bool CrashReporter::GetUploadToServer() {
@@ -118,6 +122,10 @@ std::map<std::string, std::string> CrashReporter::GetParameters() const {
   return upload_parameters_;
 }
 
+bool CrashReporter::DumpWithoutCrashing() {
+  return false;
+}
+
 #if defined(OS_MACOSX) && defined(MAS_BUILD)
 // static
 CrashReporter* CrashReporter::GetInstance() {
@@ -145,6 +153,14 @@ void CrashReporter::StartInstance(const gin_helper::Dictionary& options) {
   extra_parameters["_productName"] = product_name;
   extra_parameters["_companyName"] = company_name;
 
+  bool compress = false;
+  options.Get("compress", &compress);
+  std::string dump_profile;
+  options.Get("dumpProfile", &dump_profile);
+  bool defer_uploads = false;
+  options.Get("deferUploads", &defer_uploads);
+  reporter->SetDumpOptions(compress, dump_profile == "small", defer_uploads);
+
   reporter->Start(product_name, company_name, submit_url, crashes_dir, true,
                   false, extra_parameters);
 }
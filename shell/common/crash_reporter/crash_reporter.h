@@ -45,6 +45,16 @@ class CrashReporter {
   virtual std::vector<CrashReporter::UploadReportResult> GetUploadedReports(
       const base::FilePath& crashes_dir);
 
+  // Sets how the crashes are dumped and uploaded, must be called before
+  // Start. |compress| gzips the uploads on every platform, the Crashpad
+  // handler is started with --no-upload-gzip otherwise. |small_dumps| trades
+  // the stacks of the other threads for a smaller dump, and |defer_uploads|
+  // keeps the dumps in the crashes directory for the main process to upload.
+  // Those two are only supported by the Linux reporter, since Crashpad writes
+  // and uploads the dumps in its own handler.
+  virtual void SetDumpOptions(bool compress,
+                              bool small_dumps,
+                              bool defer_uploads);
   virtual void SetUploadToServer(bool upload_to_server);
   virtual bool GetUploadToServer();
   virtual void AddExtraParameter(const std::string& key,
@@ -52,6 +62,10 @@ class CrashReporter {
   virtual void RemoveExtraParameter(const std::string& key);
   virtual std::map<std::string, std::string> GetParameters() const;
 
+  // Writes a minidump of this process, which keeps running, and reports it
+  // like a crash. Returns false when no dump was written.
+  virtual bool DumpWithoutCrashing();
+
  protected:
   CrashReporter();
   virtual ~CrashReporter();
@@ -13,6 +13,7 @@
 #include "base/strings/sys_string_conversions.h"
 #include "base/threading/thread_restrictions.h"
 #include "third_party/crashpad/crashpad/client/settings.h"
+#include "third_party/crashpad/crashpad/client/simulate_crash.h"
 
 namespace crash_reporter {
 
@@ -76,6 +77,22 @@ std::map<std::string, std::string> CrashReporterCrashpad::GetParameters()
   return upload_parameters_;
 }
 
+bool CrashReporterCrashpad::DumpWithoutCrashing() {
+  if (!database_)
+    return false;
+  // The handler process captures this process while it keeps running.
+  CRASHPAD_SIMULATE_CRASH();
+  return true;
+}
+
+void CrashReporterCrashpad::SetDumpOptions(bool compress,
+                                           bool small_dumps,
+                                           bool defer_uploads) {
+  // The handler writes and uploads the dumps, and already retries the
+  // uploads which failed.
+  compress_uploads_ = compress;
+}
+
 std::vector<CrashReporter::UploadReportResult>
 CrashReporterCrashpad::GetUploadedReports(const base::FilePath& crashes_dir) {
   std::vector<CrashReporter::UploadReportResult> uploaded_reports;
@@ -26,6 +26,10 @@ class CrashReporterCrashpad : public CrashReporter {
                          const std::string& value) override;
   void RemoveExtraParameter(const std::string& key) override;
   std::map<std::string, std::string> GetParameters() const override;
+  bool DumpWithoutCrashing() override;
+  void SetDumpOptions(bool compress,
+                      bool small_dumps,
+                      bool defer_uploads) override;
 
  protected:
   CrashReporterCrashpad();
@@ -41,6 +45,9 @@ class CrashReporterCrashpad : public CrashReporter {
   std::unique_ptr<crashpad::SimpleStringDictionary> simple_string_dictionary_;
   std::unique_ptr<crashpad::CrashReportDatabase> database_;
 
+  // Whether the handler gzips the uploads, not all servers accept it.
+  bool compress_uploads_ = false;
+
   DISALLOW_COPY_AND_ASSIGN(CrashReporterCrashpad);
 };
 
@@ -35,6 +35,10 @@ namespace {
 // no limit.
 static const off_t kMaxMinidumpFileSize = 1258291;
 
+// The limit of the small dumps. Past a limit Breakpad keeps only the start of
+// the stacks of the threads which did not crash.
+static const off_t kMaxSmallMinidumpFileSize = 200 * 1024;
+
 }  // namespace
 
 CrashReporterLinux::CrashReporterLinux() : pid_(getpid()) {
@@ -77,6 +81,14 @@ void CrashReporterLinux::SetUploadParameters() {
   upload_parameters_["platform"] = "linux";
 }
 
+void CrashReporterLinux::SetDumpOptions(bool compress,
+                                        bool small_dumps,
+                                        bool defer_uploads) {
+  compress_uploads_ = compress;
+  small_dumps_ = small_dumps;
+  defer_uploads_ = defer_uploads;
+}
+
 void CrashReporterLinux::SetUploadToServer(const bool upload_to_server) {
   upload_to_server_ = upload_to_server;
 }
@@ -85,6 +97,11 @@ bool CrashReporterLinux::GetUploadToServer() {
   return upload_to_server_;
 }
 
+bool CrashReporterLinux::DumpWithoutCrashing() {
+  // The dump goes through CrashDone(), which reports it like a crash.
+  return breakpad_ && breakpad_->WriteMinidump();
+}
+
 void CrashReporterLinux::EnableCrashDumping(const base::FilePath& crashes_dir) {
   {
     base::ThreadRestrictions::ScopedAllowIO allow_io;
@@ -94,7 +111,14 @@ void CrashReporterLinux::EnableCrashDumping(const base::FilePath& crashes_dir) {
   strncpy(g_crash_log_path, log_file.c_str(), sizeof(g_crash_log_path));
 
   MinidumpDescriptor minidump_descriptor(crashes_dir.value());
-  minidump_descriptor.set_size_limit(kMaxMinidumpFileSize);
+  if (small_dumps_) {
+    minidump_descriptor.set_size_limit(kMaxSmallMinidumpFileSize);
+    // Only the values of the stacks which point into mappings are kept, so
+    // the dumps compress better and leak less of the user's data.
+    minidump_descriptor.set_sanitize_stacks(true);
+  } else {
+    minidump_descriptor.set_size_limit(kMaxMinidumpFileSize);
+  }
 
   breakpad_ = std::make_unique<ExceptionHandler>(minidump_descriptor, nullptr,
                                                  CrashDone, this,
@@ -122,7 +146,10 @@ bool CrashReporterLinux::CrashDone(const MinidumpDescriptor& minidump,
   info.fd = minidump.fd();
   info.distro = base::g_linux_distro;
   info.distro_length = my_strlen(base::g_linux_distro);
-  info.upload = self->upload_to_server_;
+  // Deferred reports are saved to the crashes directory like the ones which
+  // are not uploaded, the main process uploads them later.
+  info.upload = self->upload_to_server_ && !self->defer_uploads_;
+  info.compress = self->compress_uploads_;
   info.process_start_time = self->process_start_time_;
   info.oom_size = base::g_oom_size;
   info.pid = self->pid_;
@@ -34,9 +34,13 @@ class CrashReporterLinux : public CrashReporter {
             const base::FilePath& crashes_dir,
             bool upload_to_server,
             bool skip_system_crash_handler) override;
+  void SetDumpOptions(bool compress,
+                      bool small_dumps,
+                      bool defer_uploads) override;
   void SetUploadToServer(bool upload_to_server) override;
   void SetUploadParameters() override;
   bool GetUploadToServer() override;
+  bool DumpWithoutCrashing() override;
 
  private:
   friend struct base::DefaultSingletonTraits<CrashReporterLinux>;
@@ -57,6 +61,9 @@ class CrashReporterLinux : public CrashReporter {
   pid_t pid_ = 0;
   std::string upload_url_;
   bool upload_to_server_ = true;
+  bool compress_uploads_ = false;
+  bool small_dumps_ = false;
+  bool defer_uploads_ = false;
 
   DISALLOW_COPY_AND_ASSIGN(CrashReporterLinux);
 };
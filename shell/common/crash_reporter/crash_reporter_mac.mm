@@ -41,8 +41,9 @@ void CrashReporterMac::Init(const std::string& product_name,
 
       std::vector<std::string> args = {
           "--no-rate-limit",
-          "--no-upload-gzip",  // not all servers accept gzip
       };
+      if (!compress_uploads_)
+        args.push_back("--no-upload-gzip");
 
       crashpad::CrashpadClient crashpad_client;
       crashpad_client.StartHandler(handler_path, crashes_dir, crashes_dir,
@@ -73,8 +73,9 @@ void CrashReporterWin::Init(const std::string& product_name,
 
     std::vector<std::string> args = {
         "--no-rate-limit",
-        "--no-upload-gzip",  // not all servers accept gzip
     };
+    if (!compress_uploads_)
+      args.push_back("--no-upload-gzip");
     args.push_back(base::StringPrintf("--type=%s", kCrashpadProcess));
     args.push_back(
         base::StringPrintf("--%s=%s", kCrashesDirectoryKey,
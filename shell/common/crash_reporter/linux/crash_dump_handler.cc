@@ -18,6 +18,7 @@
 #include "breakpad/src/common/memory_allocator.h"
 
 #include "third_party/lss/linux_syscall_support.h"
+#include "third_party/zlib/zlib.h"
 
 // Some versions of gcc are prone to warn about unused return values. In cases
 // where we either a) know the call cannot fail, or b) there is nothing we
@@ -316,16 +317,86 @@ void LoadDataFromFile(google_breakpad::PageAllocator* allocator,
   LoadDataFromFD(allocator, *fd, true, file_data, size);
 }
 
+// zlib allocates from the PageAllocator, which frees everything at once.
+voidpf ZlibAlloc(voidpf opaque, uInt items, uInt size) {
+  return static_cast<google_breakpad::PageAllocator*>(opaque)->Alloc(items *
+                                                                     size);
+}
+
+void ZlibFree(voidpf opaque, voidpf address) {}
+
+// Writes the contents of |filename| gzipped to the new file |gzip_filename|.
+// Returns false when that file was not written.
+bool GzipFile(google_breakpad::PageAllocator* allocator,
+              const char* filename,
+              const char* gzip_filename) {
+  // WARNING: this code runs in a compromised context. It may not call into
+  // libc nor allocate memory normally.
+  int fd = -1;
+  uint8_t* data = nullptr;
+  size_t size = 0;
+  LoadDataFromFile(allocator, filename, &fd, &data, &size);
+  if (!data || !size)
+    return false;
+
+  z_stream stream;
+  my_memset(&stream, 0, sizeof(stream));
+  stream.zalloc = ZlibAlloc;
+  stream.zfree = ZlibFree;
+  stream.opaque = allocator;
+  // Windows bits above 15 make zlib write the gzip header and trailer.
+  if (deflateInit2(&stream, Z_DEFAULT_COMPRESSION, Z_DEFLATED, 16 + MAX_WBITS,
+                   8, Z_DEFAULT_STRATEGY) != Z_OK)
+    return false;
+  const uLong capacity = deflateBound(&stream, size);
+  uint8_t* gzip_data = reinterpret_cast<uint8_t*>(allocator->Alloc(capacity));
+  int ret = Z_MEM_ERROR;
+  if (gzip_data) {
+    stream.next_in = data;
+    stream.avail_in = size;
+    stream.next_out = gzip_data;
+    stream.avail_out = capacity;
+    ret = deflate(&stream, Z_FINISH);
+  }
+  const size_t gzip_size = capacity - stream.avail_out;
+  deflateEnd(&stream);
+  if (ret != Z_STREAM_END) {
+    static const char msg[] = "Failed to compress crash dump\n";
+    WriteLog(msg, sizeof(msg) - 1);
+    return false;
+  }
+
+  const int gzip_fd =
+      sys_open(gzip_filename, O_WRONLY | O_CREAT | O_EXCL, 0600);
+  if (gzip_fd < 0)
+    return false;
+  size_t written = 0;
+  while (written < gzip_size) {
+    ssize_t len = HANDLE_EINTR(
+        sys_write(gzip_fd, gzip_data + written, gzip_size - written));
+    if (len <= 0)
+      break;
+    written += len;
+  }
+  IGNORE_RET(sys_close(gzip_fd));
+  if (written == gzip_size)
+    return true;
+  IGNORE_RET(sys_unlink(gzip_filename));
+  return false;
+}
+
 // Spawn the appropriate upload process for the current OS:
 // - generic Linux invokes wget.
 // - ChromeOS invokes crash_reporter.
 // |dumpfile| is the path to the dump data file.
 // |mime_boundary| is only used on Linux.
 // |exe_buf| is only used on CrOS and is the crashing process' name.
+// |compressed| tells whether |dumpfile| is gzipped.
 void ExecUploadProcessOrTerminate(const BreakpadInfo& info,
                                   const char* dumpfile,
                                   const char* mime_boundary,
                                   const char* exe_buf,
+                                  bool compressed,
                                   google_breakpad::PageAllocator* allocator) {
   // The --header argument to wget looks like:
   //   --header=Content-Type: multipart/form-data; boundary=XYZ
@@ -347,6 +418,9 @@ void ExecUploadProcessOrTerminate(const BreakpadInfo& info,
   memcpy(post_file, post_file_msg, sizeof(post_file_msg) - 1);
   memcpy(post_file + sizeof(post_file_msg) - 1, dumpfile, strlen(dumpfile));
 
+  // The whole MIME block is gzipped, wget only sends it as it is.
+  static const char encoding_header[] = "--header=Content-Encoding: gzip";
+
   static const char kWgetBinary[] = "/usr/bin/wget";
   const char* args[] = {
       kWgetBinary,    header,  post_file, info.upload_url,
@@ -354,7 +428,8 @@ void ExecUploadProcessOrTerminate(const BreakpadInfo& info,
       "--tries=1",     // Don't retry if the upload fails.
       "--quiet",       // Be silent.
       "-O",            // output reply to /dev/null.
-      "/dev/fd/3",    nullptr,
+      "/dev/fd/3",    compressed ? encoding_header : nullptr,
+      nullptr,
   };
   static const char msg[] =
       "Cannot upload crash dump: cannot exec "
@@ -700,6 +775,24 @@ void HandleCrashDump(const BreakpadInfo& info) {
 
     IGNORE_RET(sys_setsid());
 
+    // The crashing process waits for this helper before it can exit and the
+    // app be relaunched, so the upload is left to a process of its own which
+    // init adopts. Without it the upload is done here.
+    const pid_t upload_helper = sys_fork();
+    if (upload_helper > 0)
+      sys__exit(0);
+
+    const char* upload_file = temp_file;
+    char gzip_file[sizeof(temp_file) + 3];
+    bool compressed = false;
+    if (info.compress) {
+      memcpy(gzip_file, temp_file, sizeof(temp_file) - 1);
+      memcpy(gzip_file + sizeof(temp_file) - 1, ".gz", 4);
+      compressed = GzipFile(&allocator, temp_file, gzip_file);
+      if (compressed)
+        upload_file = gzip_file;
+    }
+
     // Leave one end of a pipe in the upload process and watch for it getting
     // closed by the upload process exiting.
     int fds[2];
@@ -709,8 +802,8 @@ void HandleCrashDump(const BreakpadInfo& info) {
         // Upload process.
         IGNORE_RET(sys_close(fds[0]));
         IGNORE_RET(sys_dup2(fds[1], 3));
-        ExecUploadProcessOrTerminate(info, temp_file, mime_boundary, exe_buf,
-                                     &allocator);
+        ExecUploadProcessOrTerminate(info, upload_file, mime_boundary, exe_buf,
+                                     compressed, &allocator);
       }
 
       // Helper process.
@@ -733,6 +826,8 @@ void HandleCrashDump(const BreakpadInfo& info) {
     // Helper process.
     IGNORE_RET(sys_unlink(info.filename));
     IGNORE_RET(sys_unlink(temp_file));
+    if (compressed)
+      IGNORE_RET(sys_unlink(gzip_file));
     sys__exit(0);
   }
 
@@ -26,6 +26,7 @@ struct BreakpadInfo {
   const char* distro;           // Linux distro string.
   unsigned distro_length;       // Length of |distro|.
   bool upload;                  // Whether to upload or save crash dump.
+  bool compress;                // Whether to gzip the upload.
   uint64_t process_start_time;  // Uptime of the crashing process.
   size_t oom_size;              // Amount of memory requested if OOM.
   uint64_t pid;                 // PID where applicable.
@@ -5,10 +5,13 @@
 #include "shell/common/gin_converters/blink_converter.h"
 
 #include <algorithm>
+#include <cstring>
+#include <memory>
 #include <string>
 #include <utility>
 #include <vector>
 
+#include "base/no_destructor.h"
 #include "base/strings/string_util.h"
 #include "base/strings/utf_string_conversions.h"
 #include "gin/converter.h"
@@ -507,6 +510,29 @@ class V8Serializer : public v8::ValueSerializer::Delegate {
   ~V8Serializer() override = default;
 
   bool Serialize(v8::Local<v8::Value> value, blink::CloneableMessage* out) {
+    return Serialize(value, {}, out, nullptr);
+  }
+
+  bool Serialize(v8::Local<v8::Value> value,
+                 const std::vector<v8::Local<v8::Value>>& transfer,
+                 blink::CloneableMessage* out,
+                 std::vector<mojo_base::BigBuffer>* array_buffers) {
+    std::vector<v8::Local<v8::ArrayBuffer>> transferred;
+    for (v8::Local<v8::Value> item : transfer) {
+      if (!item->IsArrayBuffer() ||
+          !item.As<v8::ArrayBuffer>()->IsDetachable() ||
+          std::find(transferred.begin(), transferred.end(), item) !=
+              transferred.end()) {
+        isolate_->ThrowException(v8::Exception::Error(StringToV8(
+            isolate_,
+            "Only distinct, detachable ArrayBuffers can be transferred.")));
+        return false;
+      }
+      auto array_buffer = item.As<v8::ArrayBuffer>();
+      serializer_.TransferArrayBuffer(transferred.size(), array_buffer);
+      transferred.push_back(array_buffer);
+    }
+
     serializer_.WriteHeader();
     bool wrote_value;
     if (!serializer_.WriteValue(isolate_->GetCurrentContext(), value)
@@ -522,6 +548,16 @@ class V8Serializer : public v8::ValueSerializer::Delegate {
     out->encoded_message = base::make_span(buffer.first, buffer.second);
     out->owned_encoded_message = std::move(data_);
 
+    // This is the only copy of the contents: BigBuffer puts large ones in
+    // shared memory, which the receiver wraps without copying again.
+    for (v8::Local<v8::ArrayBuffer> array_buffer : transferred) {
+      auto backing_store = array_buffer->GetBackingStore();
+      array_buffers->emplace_back(
+          base::make_span(static_cast<const uint8_t*>(backing_store->Data()),
+                          backing_store->ByteLength()));
+      array_buffer->Detach();
+    }
+
     return true;
   }
 
@@ -550,6 +586,374 @@ class V8Serializer : public v8::ValueSerializer::Delegate {
   v8::ValueSerializer serializer_;
 };
 
+// Writes the arguments of an IPC message in the format of v8::ValueSerializer
+// when they are primitives, typed arrays or flat objects of primitives, which
+// most messages carry, without the per-value dispatch and bookkeeping of the
+// serializer. The receiver deserializes them as usual.
+class FastV8Serializer {
+ public:
+  explicit FastV8Serializer(v8::Isolate* isolate)
+      : isolate_(isolate), context_(isolate->GetCurrentContext()) {}
+
+  // Returns false for any other value, which is then left to V8Serializer.
+  // |*fallback| is then set to what V8Serializer should write instead of
+  // |value|, a copy which holds the values already read, so that no getter
+  // runs twice. It is left empty when a getter threw.
+  bool Serialize(v8::Local<v8::Value> value,
+                 blink::CloneableMessage* out,
+                 v8::Local<v8::Value>* fallback) {
+    *fallback = value;
+    if (!value->IsArray())
+      return false;
+    const std::vector<uint8_t>& header = GetHeader();
+    data_.assign(header.begin(), header.end());
+    if (!WriteArray(value.As<v8::Array>())) {
+      v8::Local<v8::Array> copy;
+      if (threw_ || !CopyArray(value.As<v8::Array>()).ToLocal(&copy))
+        *fallback = v8::Local<v8::Value>();
+      else
+        *fallback = copy;
+      return false;
+    }
+    out->encoded_message = base::make_span(data_.data(), data_.size());
+    out->owned_encoded_message = std::move(data_);
+    return true;
+  }
+
+ private:
+  // The tags of v8::ValueSerializer.
+  enum Tag : uint8_t {
+    kPadding = '\0',
+    kUndefined = '_',
+    kNull = '0',
+    kTrue = 'T',
+    kFalse = 'F',
+    kInt32 = 'I',
+    kDouble = 'N',
+    kOneByteString = '"',
+    kTwoByteString = 'c',
+    kBeginJSObject = 'o',
+    kEndJSObject = '{',
+    kBeginDenseJSArray = 'A',
+    kEndDenseJSArray = '$',
+    kArrayBuffer = 'B',
+    kArrayBufferView = 'V',
+  };
+
+  // The version header of the serializer of this V8, taken from a message it
+  // wrote.
+  const std::vector<uint8_t>& GetHeader() {
+    static const base::NoDestructor<std::vector<uint8_t>> header([this] {
+      blink::CloneableMessage message;
+      V8Serializer(isolate_).Serialize(v8::Undefined(isolate_), &message);
+      // Everything but the tag of undefined.
+      return std::vector<uint8_t>(message.encoded_message.begin(),
+                                  message.encoded_message.end() - 1);
+    }());
+    return *header;
+  }
+
+  bool WriteValue(v8::Local<v8::Value> value, bool top_level) {
+    if (value->IsString()) {
+      WriteString(value.As<v8::String>());
+    } else if (value->IsInt32()) {
+      WriteTag(kInt32);
+      // Zigzag encoded.
+      int32_t number = value.As<v8::Int32>()->Value();
+      WriteVarint((static_cast<uint32_t>(number) << 1) ^ (number >> 31));
+    } else if (value->IsNumber()) {
+      WriteTag(kDouble);
+      double number = value.As<v8::Number>()->Value();
+      WriteRaw(&number, sizeof(number));
+    } else if (value->IsTrue()) {
+      WriteTag(kTrue);
+    } else if (value->IsFalse()) {
+      WriteTag(kFalse);
+    } else if (value->IsUndefined()) {
+      WriteTag(kUndefined);
+    } else if (value->IsNull()) {
+      WriteTag(kNull);
+    } else if (!top_level) {
+      return false;
+    } else if (value->IsArrayBufferView()) {
+      return WriteArrayBufferView(value.As<v8::ArrayBufferView>());
+    } else if (value->IsObject()) {
+      return WriteFlatObject(value.As<v8::Object>());
+    } else {
+      return false;
+    }
+    return true;
+  }
+
+  bool WriteArray(v8::Local<v8::Array> array) {
+    uint32_t length = array->Length();
+    WriteTag(kBeginDenseJSArray);
+    WriteVarint(length);
+    for (uint32_t i = 0; i < length; ++i) {
+      v8::Local<v8::Value> element;
+      // The holes of sparse arrays are not written as undefined.
+      if (!array->HasRealIndexedProperty(context_, i).FromMaybe(false))
+        return false;
+      if (!array->Get(context_, i).ToLocal(&element)) {
+        threw_ = true;
+        return false;
+      }
+      read_values_.push_back(element);
+      if (!WriteValue(element, true))
+        return false;
+    }
+    WriteTag(kEndDenseJSArray);
+    WriteVarint(0);  // The properties which are not elements.
+    WriteVarint(length);
+    return true;
+  }
+
+  void WriteString(v8::Local<v8::String> string) {
+    int length = string->Length();
+    if (string->IsOneByte()) {
+      WriteTag(kOneByteString);
+      WriteVarint(length);
+      string->WriteOneByte(isolate_, Reserve(length), 0, length,
+                           v8::String::NO_NULL_TERMINATION);
+    } else {
+      uint32_t byte_length = length * sizeof(uint16_t);
+      // The serializer aligns the characters.
+      if ((data_.size() + 1 + VarintSize(byte_length)) & 1)
+        WriteTag(kPadding);
+      WriteTag(kTwoByteString);
+      WriteVarint(byte_length);
+      string->Write(isolate_, reinterpret_cast<uint16_t*>(Reserve(byte_length)),
+                    0, length, v8::String::NO_NULL_TERMINATION);
+    }
+  }
+
+  bool WriteArrayBufferView(v8::Local<v8::ArrayBufferView> view) {
+    uint8_t subtag = GetArrayBufferViewTag(view);
+    if (!subtag)
+      return false;
+    v8::Local<v8::ArrayBuffer> buffer = view->Buffer();
+    // An ArrayBuffer shared by several views is written once by the
+    // serializer.
+    if (buffer->IsSharedArrayBuffer() || !Remember(buffer))
+      return false;
+
+    // Like the serializer, writes the whole buffer.
+    auto backing_store = buffer->GetBackingStore();
+    size_t byte_length = backing_store->ByteLength();
+    WriteTag(kArrayBuffer);
+    WriteVarint(byte_length);
+    WriteRaw(backing_store->Data(), byte_length);
+    WriteTag(kArrayBufferView);
+    WriteVarint(subtag);
+    WriteVarint(view->ByteOffset());
+    WriteVarint(view->ByteLength());
+    return true;
+  }
+
+  static uint8_t GetArrayBufferViewTag(v8::Local<v8::ArrayBufferView> view) {
+    if (view->IsUint8Array())
+      return 'B';
+    if (view->IsInt8Array())
+      return 'b';
+    if (view->IsUint8ClampedArray())
+      return 'C';
+    if (view->IsInt16Array())
+      return 'w';
+    if (view->IsUint16Array())
+      return 'W';
+    if (view->IsInt32Array())
+      return 'd';
+    if (view->IsUint32Array())
+      return 'D';
+    if (view->IsFloat32Array())
+      return 'f';
+    if (view->IsFloat64Array())
+      return 'F';
+    if (view->IsBigInt64Array())
+      return 'q';
+    if (view->IsBigUint64Array())
+      return 'Q';
+    if (view->IsDataView())
+      return '?';
+    return 0;
+  }
+
+  // Objects with the prototype of a plain object, and none of the internal
+  // state of the objects the serializer writes differently.
+  bool IsFlatObject(v8::Local<v8::Object> object) {
+    if (object->IsProxy() || object->InternalFieldCount() != 0 ||
+        object->IsArray() || object->IsArrayBuffer() ||
+        object->IsArrayBufferView() || object->IsSharedArrayBuffer() ||
+        object->IsFunction() || object->IsDate() || object->IsRegExp() ||
+        object->IsMap() || object->IsSet() || object->IsWeakMap() ||
+        object->IsWeakSet() || object->IsPromise() || object->IsNativeError() ||
+        object->IsArgumentsObject() || object->IsBooleanObject() ||
+        object->IsNumberObject() || object->IsStringObject() ||
+        object->IsSymbolObject() || object->IsBigIntObject() ||
+        object->IsModuleNamespaceObject() || object->IsWasmModuleObject())
+      return false;
+    if (object_prototype_.IsEmpty())
+      object_prototype_ = v8::Object::New(isolate_)->GetPrototype();
+    v8::Local<v8::Value> prototype = object->GetPrototype();
+    return prototype == object_prototype_ || prototype->IsNull();
+  }
+
+  bool WriteFlatObject(v8::Local<v8::Object> object) {
+    if (!IsFlatObject(object) || !Remember(object))
+      return false;
+    v8::Local<v8::Array> keys;
+    if (!object
+             ->GetOwnPropertyNames(
+                 context_,
+                 static_cast<v8::PropertyFilter>(v8::ONLY_ENUMERABLE |
+                                                 v8::SKIP_SYMBOLS),
+                 v8::KeyConversionMode::kKeepNumbers)
+             .ToLocal(&keys))
+      return false;
+
+    WriteTag(kBeginJSObject);
+    uint32_t length = keys->Length();
+    for (uint32_t i = 0; i < length; ++i) {
+      v8::Local<v8::Value> key;
+      v8::Local<v8::Value> value;
+      // The serializer writes the indices as numbers.
+      if (!keys->Get(context_, i).ToLocal(&key) || !key->IsString())
+        return false;
+      if (!object->Get(context_, key).ToLocal(&value)) {
+        threw_ = true;
+        return false;
+      }
+      read_values_.push_back(value);
+      WriteString(key.As<v8::String>());
+      if (!WriteValue(value, false))
+        return false;
+    }
+    WriteTag(kEndJSObject);
+    WriteVarint(length);
+    return true;
+  }
+
+  // Copies |array| and the flat objects in it in the order they were written,
+  // taking the values which were read before the writing failed from
+  // |read_values_| and reading only the others. Everything else is kept as
+  // is, since its properties were not read.
+  v8::MaybeLocal<v8::Array> CopyArray(v8::Local<v8::Array> array) {
+    size_t next_value = 0;
+    auto read_next = [&](v8::Local<v8::Object> holder,
+                         v8::Local<v8::Value> key) {
+      if (next_value < read_values_.size())
+        return v8::MaybeLocal<v8::Value>(read_values_[next_value++]);
+      return holder->Get(context_, key);
+    };
+
+    std::vector<std::pair<v8::Local<v8::Object>, v8::Local<v8::Object>>>
+        copies;
+    auto copy_element =
+        [&](v8::Local<v8::Value> element) -> v8::MaybeLocal<v8::Value> {
+      if (!element->IsObject() || !IsFlatObject(element.As<v8::Object>()))
+        return element;
+      v8::Local<v8::Object> object = element.As<v8::Object>();
+      // Copied once, so that the serializer still sees the same object.
+      for (const auto& copy : copies) {
+        if (copy.first == object)
+          return copy.second;
+      }
+      v8::Local<v8::Object> copy = v8::Object::New(isolate_);
+      copies.emplace_back(object, copy);
+      v8::Local<v8::Array> keys;
+      if (!object
+               ->GetOwnPropertyNames(
+                   context_,
+                   static_cast<v8::PropertyFilter>(v8::ONLY_ENUMERABLE |
+                                                   v8::SKIP_SYMBOLS),
+                   v8::KeyConversionMode::kKeepNumbers)
+               .ToLocal(&keys))
+        return {};
+      for (uint32_t i = 0; i < keys->Length(); ++i) {
+        v8::Local<v8::Value> key;
+        v8::Local<v8::String> name;
+        v8::Local<v8::Value> value;
+        if (!keys->Get(context_, i).ToLocal(&key) ||
+            !key->ToString(context_).ToLocal(&name) ||
+            !read_next(object, key).ToLocal(&value) ||
+            !copy->CreateDataProperty(context_, name, value).FromMaybe(false))
+          return {};
+      }
+      return copy;
+    };
+
+    uint32_t length = array->Length();
+    v8::Local<v8::Array> copy = v8::Array::New(isolate_, length);
+    for (uint32_t i = 0; i < length; ++i) {
+      // The holes stay holes.
+      if (!array->HasRealIndexedProperty(context_, i).FromMaybe(false))
+        continue;
+      v8::Local<v8::Value> element;
+      if (!read_next(array, v8::Integer::NewFromUnsigned(isolate_, i))
+               .ToLocal(&element) ||
+          !copy_element(element).ToLocal(&element) ||
+          !copy->CreateDataProperty(context_, i, element).FromMaybe(false))
+        return {};
+    }
+    return copy;
+  }
+
+  // The serializer writes an object seen before as a reference to it, which
+  // is left to it.
+  bool Remember(v8::Local<v8::Object> object) {
+    if (std::find(seen_.begin(), seen_.end(), object) != seen_.end())
+      return false;
+    seen_.push_back(object);
+    return true;
+  }
+
+  uint8_t* Reserve(size_t size) {
+    size_t offset = data_.size();
+    data_.resize(offset + size);
+    return data_.data() + offset;
+  }
+
+  void WriteTag(uint8_t tag) { data_.push_back(tag); }
+
+  void WriteRaw(const void* source, size_t size) {
+    if (size)
+      memcpy(Reserve(size), source, size);
+  }
+
+  void WriteVarint(uint64_t value) {
+    do {
+      uint8_t byte = value & 0x7f;
+      value >>= 7;
+      data_.push_back(value ? byte | 0x80 : byte);
+    } while (value);
+  }
+
+  static size_t VarintSize(uint64_t value) {
+    size_t size = 1;
+    while (value >>= 7)
+      ++size;
+    return size;
+  }
+
+  v8::Isolate* isolate_;
+  v8::Local<v8::Context> context_;
+  v8::Local<v8::Value> object_prototype_;
+  std::vector<v8::Local<v8::Object>> seen_;
+  // The values of the array elements and the object properties, in the order
+  // they were read.
+  std::vector<v8::Local<v8::Value>> read_values_;
+  bool threw_ = false;
+  std::vector<uint8_t> data_;
+
+  DISALLOW_COPY_AND_ASSIGN(FastV8Serializer);
+};
+
+// Frees the BigBuffer behind a transferred ArrayBuffer, which V8 can do on
+// any thread.
+void DeleteTransferredBuffer(void* data, size_t length, void* deleter_data) {
+  delete static_cast<mojo_base::BigBuffer*>(deleter_data);
+}
+
 class V8Deserializer : public v8::ValueDeserializer::Delegate {
  public:
   V8Deserializer(v8::Isolate* isolate, const blink::CloneableMessage& message)
@@ -559,8 +963,19 @@ class V8Deserializer : public v8::ValueDeserializer::Delegate {
                       message.encoded_message.size(),
                       this) {}
 
-  v8::Local<v8::Value> Deserialize() {
+  v8::Local<v8::Value> Deserialize() { return Deserialize({}); }
+
+  v8::Local<v8::Value> Deserialize(
+      std::vector<mojo_base::BigBuffer> array_buffers) {
     v8::EscapableHandleScope scope(isolate_);
+    for (size_t i = 0; i < array_buffers.size(); ++i) {
+      auto* buffer = new mojo_base::BigBuffer(std::move(array_buffers[i]));
+      std::unique_ptr<v8::BackingStore> backing_store =
+          v8::ArrayBuffer::NewBackingStore(buffer->data(), buffer->size(),
+                                           &DeleteTransferredBuffer, buffer);
+      deserializer_.TransferArrayBuffer(
+          i, v8::ArrayBuffer::New(isolate_, std::move(backing_store)));
+    }
     auto context = isolate_->GetCurrentContext();
     bool read_header;
     if (!deserializer_.ReadHeader(context).To(&read_header))
@@ -592,4 +1007,28 @@ bool Converter<blink::CloneableMessage>::FromV8(v8::Isolate* isolate,
   return V8Serializer(isolate).Serialize(val, out);
 }
 
+bool SerializeArguments(v8::Isolate* isolate,
+                        v8::Local<v8::Value> val,
+                        blink::CloneableMessage* out) {
+  v8::Local<v8::Value> fallback;
+  if (FastV8Serializer(isolate).Serialize(val, out, &fallback))
+    return true;
+  return !fallback.IsEmpty() && V8Serializer(isolate).Serialize(fallback, out);
+}
+
+bool SerializeWithTransfer(v8::Isolate* isolate,
+                           v8::Local<v8::Value> val,
+                           const std::vector<v8::Local<v8::Value>>& transfer,
+                           blink::CloneableMessage* out,
+                           std::vector<mojo_base::BigBuffer>* array_buffers) {
+  return V8Serializer(isolate).Serialize(val, transfer, out, array_buffers);
+}
+
+v8::Local<v8::Value> DeserializeWithTransfer(
+    v8::Isolate* isolate,
+    const blink::CloneableMessage& in,
+    std::vector<mojo_base::BigBuffer> array_buffers) {
+  return V8Deserializer(isolate, in).Deserialize(std::move(array_buffers));
+}
+
 }  // namespace gin
@@ -5,7 +5,10 @@
 #ifndef SHELL_COMMON_GIN_CONVERTERS_BLINK_CONVERTER_H_
 #define SHELL_COMMON_GIN_CONVERTERS_BLINK_CONVERTER_H_
 
+#include <vector>
+
 #include "gin/converter.h"
+#include "mojo/public/cpp/base/big_buffer.h"
 #include "third_party/blink/public/common/input/web_input_event.h"
 #include "third_party/blink/public/common/messaging/cloneable_message.h"
 #include "third_party/blink/public/common/web_cache/web_cache_resource_type_stats.h"
@@ -118,6 +121,29 @@ struct Converter<blink::CloneableMessage> {
                      blink::CloneableMessage* out);
 };
 
+// Serializes the array of the arguments of an IPC message like
+// Converter<blink::CloneableMessage>::FromV8, but writes the common payloads
+// without going through v8::ValueSerializer.
+bool SerializeArguments(v8::Isolate* isolate,
+                        v8::Local<v8::Value> val,
+                        blink::CloneableMessage* out);
+
+// Serializes |val| like Converter<blink::CloneableMessage>::FromV8, except
+// that the ArrayBuffers in |transfer| are moved into |array_buffers| and
+// detached instead of being copied into the message.
+bool SerializeWithTransfer(v8::Isolate* isolate,
+                           v8::Local<v8::Value> val,
+                           const std::vector<v8::Local<v8::Value>>& transfer,
+                           blink::CloneableMessage* out,
+                           std::vector<mojo_base::BigBuffer>* array_buffers);
+
+// Deserializes a message serialized by SerializeWithTransfer. The transferred
+// ArrayBuffers wrap the memory of |array_buffers| without copying it.
+v8::Local<v8::Value> DeserializeWithTransfer(
+    v8::Isolate* isolate,
+    const blink::CloneableMessage& in,
+    std::vector<mojo_base::BigBuffer> array_buffers);
+
 v8::Local<v8::Value> EditFlagsToV8(v8::Isolate* isolate, int editFlags);
 v8::Local<v8::Value> MediaFlagsToV8(v8::Isolate* isolate, int mediaFlags);
 
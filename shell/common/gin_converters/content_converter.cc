@@ -203,6 +203,40 @@ v8::Local<v8::Value> Converter<content::PermissionType>::ToV8(
   }
 }
 
+// static
+v8::Local<v8::Value>
+Converter<base::MemoryPressureListener::MemoryPressureLevel>::ToV8(
+    v8::Isolate* isolate,
+    base::MemoryPressureListener::MemoryPressureLevel val) {
+  switch (val) {
+    case base::MemoryPressureListener::MEMORY_PRESSURE_LEVEL_MODERATE:
+      return StringToV8(isolate, "moderate");
+    case base::MemoryPressureListener::MEMORY_PRESSURE_LEVEL_CRITICAL:
+      return StringToV8(isolate, "critical");
+    default:
+      return StringToV8(isolate, "none");
+  }
+}
+
+// static
+bool Converter<base::MemoryPressureListener::MemoryPressureLevel>::FromV8(
+    v8::Isolate* isolate,
+    v8::Local<v8::Value> val,
+    base::MemoryPressureListener::MemoryPressureLevel* out) {
+  std::string level;
+  if (!ConvertFromV8(isolate, val, &level))
+    return false;
+
+  if (level == "moderate")
+    *out = base::MemoryPressureListener::MEMORY_PRESSURE_LEVEL_MODERATE;
+  else if (level == "critical")
+    *out = base::MemoryPressureListener::MEMORY_PRESSURE_LEVEL_CRITICAL;
+  else
+    return false;
+
+  return true;
+}
+
 // static
 bool Converter<content::StopFindAction>::FromV8(v8::Isolate* isolate,
                                                 v8::Local<v8::Value> val,
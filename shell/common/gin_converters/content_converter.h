@@ -7,6 +7,7 @@
 
 #include <utility>
 
+#include "base/memory/memory_pressure_listener.h"
 #include "content/public/browser/permission_type.h"
 #include "content/public/common/menu_item.h"
 #include "content/public/common/referrer.h"
@@ -25,6 +26,16 @@ using ContextMenuParamsWithWebContents =
 
 namespace gin {
 
+template <>
+struct Converter<base::MemoryPressureListener::MemoryPressureLevel> {
+  static v8::Local<v8::Value> ToV8(
+      v8::Isolate* isolate,
+      base::MemoryPressureListener::MemoryPressureLevel val);
+  static bool FromV8(v8::Isolate* isolate,
+                     v8::Local<v8::Value> val,
+                     base::MemoryPressureListener::MemoryPressureLevel* out);
+};
+
 template <>
 struct Converter<content::MenuItem::Type> {
   static v8::Local<v8::Value> ToV8(v8::Isolate* isolate,
@@ -0,0 +1,373 @@
+// Copyright (c) 2020 GitHub, Inc.
+// Use of this source code is governed by the MIT license that can be
+// found in the LICENSE file.
+
+#include <algorithm>
+#include <atomic>
+#include <memory>
+#include <string>
+
+#include "base/allocator/buildflags.h"
+#include "base/memory/scoped_refptr.h"
+#include "base/strings/string_number_conversions.h"
+#include "base/strings/stringprintf.h"
+#include "base/timer/elapsed_timer.h"
+#include "base/values.h"
+#include "content/public/browser/native_web_keyboard_event.h"
+#include "gin/converter.h"
+#include "gin/test/v8_test.h"
+#include "net/http/http_request_headers.h"
+#include "net/http/http_response_headers.h"
+#include "services/network/public/cpp/resource_request.h"
+#include "shell/common/gin_converters/blink_converter.h"
+#include "shell/common/gin_converters/content_converter.h"
+#include "shell/common/gin_converters/gfx_converter.h"
+#include "shell/common/gin_converters/net_converter.h"
+#include "shell/common/gin_converters/value_converter.h"
+#include "shell/common/v8_value_converter.h"
+#include "testing/gtest/include/gtest/gtest.h"
+#include "testing/perf/perf_test.h"
+#include "third_party/blink/public/common/input/web_keyboard_event.h"
+#include "third_party/blink/public/common/input/web_mouse_event.h"
+#include "third_party/blink/public/common/input/web_mouse_wheel_event.h"
+#include "ui/gfx/geometry/rect.h"
+#include "url/gurl.h"
+
+#if BUILDFLAG(USE_ALLOCATOR_SHIM)
+#include "base/allocator/allocator_shim.h"
+#endif
+
+namespace electron {
+
+namespace {
+
+const int kWarmupIterations = 1000;
+const int kIterations = 10000;
+// Fewer iterations for the payloads which take milliseconds.
+const int kLargeIterations = 100;
+
+#if BUILDFLAG(USE_ALLOCATOR_SHIM)
+// Counts the allocations of all the threads, which are idle while the
+// benchmarks run.
+std::atomic<size_t> g_allocations{0};
+
+using base::allocator::AllocatorDispatch;
+
+void* CountAlloc(const AllocatorDispatch* self, size_t size, void* context) {
+  g_allocations.fetch_add(1, std::memory_order_relaxed);
+  return self->next->alloc_function(self->next, size, context);
+}
+
+void* CountAllocZeroInitialized(const AllocatorDispatch* self,
+                                size_t n,
+                                size_t size,
+                                void* context) {
+  g_allocations.fetch_add(1, std::memory_order_relaxed);
+  return self->next->alloc_zero_initialized_function(self->next, n, size,
+                                                     context);
+}
+
+void* CountAllocAligned(const AllocatorDispatch* self,
+                        size_t alignment,
+                        size_t size,
+                        void* context) {
+  g_allocations.fetch_add(1, std::memory_order_relaxed);
+  return self->next->alloc_aligned_function(self->next, alignment, size,
+                                            context);
+}
+
+void* CountRealloc(const AllocatorDispatch* self,
+                   void* address,
+                   size_t size,
+                   void* context) {
+  g_allocations.fetch_add(1, std::memory_order_relaxed);
+  return self->next->realloc_function(self->next, address, size, context);
+}
+
+void Free(const AllocatorDispatch* self, void* address, void* context) {
+  self->next->free_function(self->next, address, context);
+}
+
+size_t GetSizeEstimate(const AllocatorDispatch* self,
+                       void* address,
+                       void* context) {
+  return self->next->get_size_estimate_function(self->next, address, context);
+}
+
+unsigned CountBatchMalloc(const AllocatorDispatch* self,
+                          size_t size,
+                          void** results,
+                          unsigned num_requested,
+                          void* context) {
+  g_allocations.fetch_add(num_requested, std::memory_order_relaxed);
+  return self->next->batch_malloc_function(self->next, size, results,
+                                           num_requested, context);
+}
+
+void BatchFree(const AllocatorDispatch* self,
+               void** to_be_freed,
+               unsigned num_to_be_freed,
+               void* context) {
+  self->next->batch_free_function(self->next, to_be_freed, num_to_be_freed,
+                                  context);
+}
+
+void FreeDefiniteSize(const AllocatorDispatch* self,
+                      void* address,
+                      size_t size,
+                      void* context) {
+  self->next->free_definite_size_function(self->next, address, size, context);
+}
+
+void* CountAlignedMalloc(const AllocatorDispatch* self,
+                         size_t size,
+                         size_t alignment,
+                         void* context) {
+  g_allocations.fetch_add(1, std::memory_order_relaxed);
+  return self->next->aligned_malloc_function(self->next, size, alignment,
+                                             context);
+}
+
+void* CountAlignedRealloc(const AllocatorDispatch* self,
+                          void* address,
+                          size_t size,
+                          size_t alignment,
+                          void* context) {
+  g_allocations.fetch_add(1, std::memory_order_relaxed);
+  return self->next->aligned_realloc_function(self->next, address, size,
+                                              alignment, context);
+}
+
+void AlignedFree(const AllocatorDispatch* self, void* address, void* context) {
+  self->next->aligned_free_function(self->next, address, context);
+}
+
+AllocatorDispatch g_counting_dispatch = {
+    &CountAlloc,          &CountAllocZeroInitialized,
+    &CountAllocAligned,   &CountRealloc,
+    &Free,                &GetSizeEstimate,
+    &CountBatchMalloc,    &BatchFree,
+    &FreeDefiniteSize,    &CountAlignedMalloc,
+    &CountAlignedRealloc, &AlignedFree,
+    nullptr,
+};
+
+size_t GetAllocationCount() {
+  // The dispatch can not be removed once inserted, and counts from then on.
+  static bool inserted = false;
+  if (!inserted) {
+    base::allocator::InsertAllocatorDispatch(&g_counting_dispatch);
+    inserted = true;
+  }
+  return g_allocations.load(std::memory_order_relaxed);
+}
+
+bool CanCountAllocations() {
+  return true;
+}
+#else
+size_t GetAllocationCount() {
+  return 0;
+}
+
+bool CanCountAllocations() {
+  return false;
+}
+#endif
+
+class ConverterBenchmark : public gin::V8Test {
+ protected:
+  void SetUp() override {
+    gin::V8Test::SetUp();
+    isolate_ = instance_->isolate();
+  }
+
+  v8::Local<v8::Context> context() {
+    return v8::Local<v8::Context>::New(isolate_, context_);
+  }
+
+  v8::Local<v8::Value> RunScript(const std::string& source) {
+    v8::Local<v8::Script> script =
+        v8::Script::Compile(context(), gin::StringToV8(isolate_, source))
+            .ToLocalChecked();
+    return script->Run(context()).ToLocalChecked();
+  }
+
+  // Prints the time and the allocations of one call of |function|, each call
+  // in its own handle scope.
+  template <typename Function>
+  void Measure(const std::string& payload,
+               const std::string& direction,
+               int iterations,
+               Function function) {
+    for (int i = 0; i < std::min(iterations, kWarmupIterations); ++i) {
+      v8::HandleScope handle_scope(isolate_);
+      function();
+    }
+
+    size_t allocations = GetAllocationCount();
+    base::ElapsedTimer timer;
+    for (int i = 0; i < iterations; ++i) {
+      v8::HandleScope handle_scope(isolate_);
+      function();
+    }
+    base::TimeDelta elapsed = timer.Elapsed();
+    allocations = GetAllocationCount() - allocations;
+
+    perf_test::PrintResult("converter_time", direction, payload,
+                           elapsed.InNanoseconds() /
+                               static_cast<double>(iterations),
+                           "ns/op", true);
+    if (CanCountAllocations()) {
+      perf_test::PrintResult("converter_allocations", direction, payload,
+                             allocations / static_cast<double>(iterations),
+                             "allocations/op", true);
+    }
+  }
+
+  v8::Isolate* isolate_ = nullptr;
+};
+
+// A dictionary with |depth| levels of |width| children, whose leaves hold a
+// string, a number and a boolean.
+std::unique_ptr<base::DictionaryValue> CreateNestedDictionary(int depth,
+                                                              int width) {
+  auto dict = std::make_unique<base::DictionaryValue>();
+  dict->SetString("name", base::StringPrintf("node-%d", depth));
+  dict->SetInteger("id", depth);
+  dict->SetBoolean("enabled", true);
+  if (depth > 0) {
+    for (int i = 0; i < width; ++i) {
+      dict->SetDictionary(base::NumberToString(i),
+                          CreateNestedDictionary(depth - 1, width));
+    }
+  }
+  return dict;
+}
+
+}  // namespace
+
+TEST_F(ConverterBenchmark, InputEvents) {
+  v8::HandleScope handle_scope(isolate_);
+
+  v8::Local<v8::Value> mouse = RunScript(
+      "({ type: 'mouseDown', x: 10, y: 20, button: 'left', clickCount: 1, "
+      "modifiers: ['shift'] })");
+  Measure("mouse_event", "from_v8", kIterations, [&] {
+    blink::WebMouseEvent event;
+    EXPECT_TRUE(gin::ConvertFromV8(isolate_, mouse, &event));
+  });
+
+  v8::Local<v8::Value> wheel = RunScript(
+      "({ type: 'mouseWheel', x: 10, y: 20, deltaX: 0, deltaY: -120, "
+      "canScroll: true })");
+  Measure("mouse_wheel_event", "from_v8", kIterations, [&] {
+    blink::WebMouseWheelEvent event;
+    EXPECT_TRUE(gin::ConvertFromV8(isolate_, wheel, &event));
+  });
+
+  v8::Local<v8::Value> key = RunScript(
+      "({ type: 'keyDown', keyCode: 'A', modifiers: ['control'] })");
+  Measure("keyboard_event", "from_v8", kIterations, [&] {
+    blink::WebKeyboardEvent event;
+    EXPECT_TRUE(gin::ConvertFromV8(isolate_, key, &event));
+  });
+
+  blink::WebKeyboardEvent web_event(blink::WebInputEvent::kRawKeyDown,
+                                    blink::WebInputEvent::kControlKey,
+                                    base::TimeTicks::Now());
+  web_event.windows_key_code = 'A';
+  content::NativeWebKeyboardEvent native_event(web_event, gfx::NativeView());
+  Measure("keyboard_event", "to_v8", kIterations,
+          [&] { gin::ConvertToV8(isolate_, native_event); });
+}
+
+TEST_F(ConverterBenchmark, Geometry) {
+  v8::HandleScope handle_scope(isolate_);
+
+  gfx::Rect rect(10, 20, 300, 400);
+  Measure("rect", "to_v8", kIterations,
+          [&] { gin::ConvertToV8(isolate_, rect); });
+
+  v8::Local<v8::Value> value = gin::ConvertToV8(isolate_, rect);
+  Measure("rect", "from_v8", kIterations, [&] {
+    gfx::Rect out;
+    EXPECT_TRUE(gin::ConvertFromV8(isolate_, value, &out));
+  });
+}
+
+TEST_F(ConverterBenchmark, RequestDetails) {
+  v8::HandleScope handle_scope(isolate_);
+
+  network::ResourceRequest request;
+  request.method = "GET";
+  request.url = GURL("https://example.com/path/to/resource?query=value");
+  request.referrer = GURL("https://example.com/");
+  for (int i = 0; i < 10; ++i) {
+    request.headers.SetHeader(base::StringPrintf("X-Header-%d", i),
+                              "some header value");
+  }
+  Measure("resource_request", "to_v8", kIterations,
+          [&] { gin::ConvertToV8(isolate_, request); });
+
+  v8::Local<v8::Value> headers = gin::ConvertToV8(isolate_, request.headers);
+  Measure("request_headers", "from_v8", kIterations, [&] {
+    net::HttpRequestHeaders out;
+    EXPECT_TRUE(gin::ConvertFromV8(isolate_, headers, &out));
+  });
+}
+
+TEST_F(ConverterBenchmark, ResponseHeaders) {
+  v8::HandleScope handle_scope(isolate_);
+
+  std::string raw_headers = "HTTP/1.1 200 OK";
+  raw_headers.push_back('\0');
+  for (int i = 0; i < 20; ++i) {
+    raw_headers += base::StringPrintf("X-Header-%d: some header value", i);
+    raw_headers.push_back('\0');
+  }
+  raw_headers.push_back('\0');
+  auto response_headers =
+      base::MakeRefCounted<net::HttpResponseHeaders>(raw_headers);
+  Measure("response_headers", "to_v8", kIterations,
+          [&] { gin::ConvertToV8(isolate_, response_headers.get()); });
+
+  v8::Local<v8::Value> value =
+      gin::ConvertToV8(isolate_, response_headers.get());
+  Measure("response_headers", "from_v8", kIterations, [&] {
+    auto out = base::MakeRefCounted<net::HttpResponseHeaders>("HTTP/1.1 200");
+    EXPECT_TRUE(gin::ConvertFromV8(isolate_, value, out.get()));
+  });
+}
+
+TEST_F(ConverterBenchmark, NestedDictionaries) {
+  v8::HandleScope handle_scope(isolate_);
+
+  // 1365 dictionaries.
+  std::unique_ptr<base::DictionaryValue> dict = CreateNestedDictionary(5, 4);
+  Measure("nested_dictionary", "to_v8", kLargeIterations,
+          [&] { gin::ConvertToV8(isolate_, *dict); });
+
+  v8::Local<v8::Value> value = gin::ConvertToV8(isolate_, *dict);
+  Measure("nested_dictionary", "from_v8", kLargeIterations, [&] {
+    base::DictionaryValue out;
+    EXPECT_TRUE(gin::ConvertFromV8(isolate_, value, &out));
+  });
+}
+
+TEST_F(ConverterBenchmark, Buffers) {
+  v8::HandleScope handle_scope(isolate_);
+
+  // The buffers converted to V8 are Node's, which needs a Node environment,
+  // so only the conversion from V8 is measured.
+  V8ValueConverter converter;
+  for (int size : {1024, 1024 * 1024}) {
+    v8::Local<v8::Value> buffer =
+        RunScript(base::StringPrintf("new Uint8Array(%d).fill(1)", size));
+    int iterations = size > 1024 ? kLargeIterations : kIterations;
+    Measure(base::StringPrintf("buffer_%d", size), "from_v8", iterations,
+            [&] { EXPECT_TRUE(converter.FromV8Value(buffer, context())); });
+  }
+}
+
+}  // namespace electron
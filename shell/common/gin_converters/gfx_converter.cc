@@ -4,6 +4,7 @@
 
 #include "shell/common/gin_converters/gfx_converter.h"
 
+#include "base/strings/string_piece.h"
 #include "shell/common/gin_helper/dictionary.h"
 #include "ui/display/display.h"
 #include "ui/display/screen.h"
@@ -14,6 +15,24 @@
 
 namespace gin {
 
+namespace {
+
+// Like gin::Dictionary::Get, but with an internalized key, since geometry is
+// converted on many calls and a new key string would be allocated each time.
+template <typename T>
+bool GetProperty(v8::Isolate* isolate,
+                 v8::Local<v8::Value> object,
+                 base::StringPiece key,
+                 T* out) {
+  v8::Local<v8::Value> value;
+  return object.As<v8::Object>()
+             ->Get(isolate->GetCurrentContext(), StringToSymbol(isolate, key))
+             .ToLocal(&value) &&
+         ConvertFromV8(isolate, value, out);
+}
+
+}  // namespace
+
 v8::Local<v8::Value> Converter<gfx::Point>::ToV8(v8::Isolate* isolate,
                                                  const gfx::Point& val) {
   gin_helper::Dictionary dict = gin::Dictionary::CreateEmpty(isolate);
@@ -26,11 +45,11 @@ v8::Local<v8::Value> Converter<gfx::Point>::ToV8(v8::Isolate* isolate,
 bool Converter<gfx::Point>::FromV8(v8::Isolate* isolate,
                                    v8::Local<v8::Value> val,
                                    gfx::Point* out) {
-  gin::Dictionary dict(isolate);
-  if (!gin::ConvertFromV8(isolate, val, &dict))
+  if (!val->IsObject())
     return false;
   double x, y;
-  if (!dict.Get("x", &x) || !dict.Get("y", &y))
+  if (!GetProperty(isolate, val, "x", &x) ||
+      !GetProperty(isolate, val, "y", &y))
     return false;
   *out = gfx::Point(static_cast<int>(std::round(x)),
                     static_cast<int>(std::round(y)));
@@ -71,11 +90,11 @@ v8::Local<v8::Value> Converter<gfx::Size>::ToV8(v8::Isolate* isolate,
 bool Converter<gfx::Size>::FromV8(v8::Isolate* isolate,
                                   v8::Local<v8::Value> val,
                                   gfx::Size* out) {
-  gin::Dictionary dict(isolate);
-  if (!gin::ConvertFromV8(isolate, val, &dict))
+  if (!val->IsObject())
     return false;
   int width, height;
-  if (!dict.Get("width", &width) || !dict.Get("height", &height))
+  if (!GetProperty(isolate, val, "width", &width) ||
+      !GetProperty(isolate, val, "height", &height))
     return false;
   *out = gfx::Size(width, height);
   return true;
@@ -95,12 +114,13 @@ v8::Local<v8::Value> Converter<gfx::Rect>::ToV8(v8::Isolate* isolate,
 bool Converter<gfx::Rect>::FromV8(v8::Isolate* isolate,
                                   v8::Local<v8::Value> val,
                                   gfx::Rect* out) {
-  gin::Dictionary dict(isolate);
-  if (!gin::ConvertFromV8(isolate, val, &dict))
+  if (!val->IsObject())
     return false;
   int x, y, width, height;
-  if (!dict.Get("x", &x) || !dict.Get("y", &y) || !dict.Get("width", &width) ||
-      !dict.Get("height", &height))
+  if (!GetProperty(isolate, val, "x", &x) ||
+      !GetProperty(isolate, val, "y", &y) ||
+      !GetProperty(isolate, val, "width", &width) ||
+      !GetProperty(isolate, val, "height", &height))
     return false;
   *out = gfx::Rect(x, y, width, height);
   return true;
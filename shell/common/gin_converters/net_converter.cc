@@ -233,14 +233,27 @@ v8::Local<v8::Value> Converter<net::HttpRequestHeaders>::ToV8(
 bool Converter<net::HttpRequestHeaders>::FromV8(v8::Isolate* isolate,
                                                 v8::Local<v8::Value> val,
                                                 net::HttpRequestHeaders* out) {
-  base::DictionaryValue dict;
-  if (!ConvertFromV8(isolate, val, &dict))
+  // This runs for every request with an onBeforeSendHeaders listener, so read
+  // the headers straight from the object instead of through a base::Value.
+  if (!val->IsObject())
     return false;
-  for (base::DictionaryValue::Iterator it(dict); !it.IsAtEnd(); it.Advance()) {
-    if (it.value().is_string()) {
-      std::string value = it.value().GetString();
-      out->SetHeader(it.key(), value);
-    }
+  auto context = isolate->GetCurrentContext();
+  auto headers = val.As<v8::Object>();
+  v8::Local<v8::Array> keys;
+  if (!headers->GetOwnPropertyNames(context).ToLocal(&keys))
+    return false;
+  for (uint32_t i = 0; i < keys->Length(); i++) {
+    v8::Local<v8::Value> key_val;
+    v8::Local<v8::Value> value_val;
+    if (!keys->Get(context, i).ToLocal(&key_val) ||
+        !headers->Get(context, key_val).ToLocal(&value_val))
+      return false;
+    // Only string values are set as headers.
+    std::string key;
+    std::string value;
+    if (value_val->IsString() && ConvertFromV8(isolate, key_val, &key) &&
+        ConvertFromV8(isolate, value_val, &value))
+      out->SetHeader(key, value);
   }
   return true;
 }
@@ -397,4 +410,28 @@ v8::Local<v8::Value> Converter<net::RedirectInfo>::ToV8(
   return ConvertToV8(isolate, dict);
 }
 
+// static
+bool Converter<net::RequestPriority>::FromV8(v8::Isolate* isolate,
+                                             v8::Local<v8::Value> val,
+                                             net::RequestPriority* out) {
+  std::string priority;
+  if (!ConvertFromV8(isolate, val, &priority))
+    return false;
+  if (priority == "throttled")
+    *out = net::THROTTLED;
+  else if (priority == "idle")
+    *out = net::IDLE;
+  else if (priority == "lowest")
+    *out = net::LOWEST;
+  else if (priority == "low")
+    *out = net::LOW;
+  else if (priority == "medium")
+    *out = net::MEDIUM;
+  else if (priority == "highest")
+    *out = net::HIGHEST;
+  else
+    return false;
+  return true;
+}
+
 }  // namespace gin
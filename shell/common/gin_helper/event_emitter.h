@@ -5,9 +5,13 @@
 #ifndef SHELL_COMMON_GIN_HELPER_EVENT_EMITTER_H_
 #define SHELL_COMMON_GIN_HELPER_EVENT_EMITTER_H_
 
+#include <functional>
+#include <set>
+#include <string>
 #include <utility>
 #include <vector>
 
+#include "base/trace_event/trace_event.h"
 #include "content/public/browser/browser_thread.h"
 #include "electron/shell/common/api/api.mojom.h"
 #include "shell/common/gin_helper/event_emitter_caller.h"
@@ -49,11 +53,33 @@ class EventEmitter : public gin_helper::Wrappable<T> {
     return Base::GetWrapper(isolate);
   }
 
+  // Whether JS has listeners for |name|. Emit() does nothing when it does not,
+  // and callers can check it to skip building expensive arguments.
+  //
+  // Every event counts as listened to until the JS side of the object starts
+  // calling _setListening(), see lib/browser/track-listeners.ts.
+  bool HasListeners(base::StringPiece name) const {
+    return !listeners_tracked_ ||
+           listened_events_.find(name) != listened_events_.end();
+  }
+
+  // this._setListening(name, listening), bound by the classes whose JS side
+  // tracks listeners.
+  void SetListening(const std::string& name, bool listening) {
+    listeners_tracked_ = true;
+    if (listening)
+      listened_events_.insert(name);
+    else
+      listened_events_.erase(name);
+  }
+
   // this.emit(name, event, args...);
   template <typename... Args>
   bool EmitCustomEvent(base::StringPiece name,
                        v8::Local<v8::Object> event,
                        Args&&... args) {
+    if (!HasListeners(name))
+      return false;
     return EmitWithEvent(name,
                          internal::CreateEvent(isolate(), GetWrapper(), event),
                          std::forward<Args>(args)...);
@@ -62,6 +88,8 @@ class EventEmitter : public gin_helper::Wrappable<T> {
   // this.emit(name, new Event(flags), args...);
   template <typename... Args>
   bool EmitWithFlags(base::StringPiece name, int flags, Args&&... args) {
+    if (!HasListeners(name))
+      return false;
     return EmitCustomEvent(name,
                            internal::CreateEventFromFlags(isolate(), flags),
                            std::forward<Args>(args)...);
@@ -70,6 +98,8 @@ class EventEmitter : public gin_helper::Wrappable<T> {
   // this.emit(name, new Event(), args...);
   template <typename... Args>
   bool Emit(base::StringPiece name, Args&&... args) {
+    if (!HasListeners(name))
+      return false;
     v8::Locker locker(isolate());
     v8::HandleScope handle_scope(isolate());
     v8::Local<v8::Object> wrapper = GetWrapper();
@@ -80,6 +110,8 @@ class EventEmitter : public gin_helper::Wrappable<T> {
   }
 
   // this.emit(name, new Event(sender, message), args...);
+  //
+  // Always emits, since the event owns the reply callback of the message.
   template <typename... Args>
   bool EmitWithSender(base::StringPiece name,
                       content::RenderFrameHost* sender,
@@ -105,6 +137,8 @@ class EventEmitter : public gin_helper::Wrappable<T> {
   bool EmitWithEvent(base::StringPiece name,
                      v8::Local<v8::Object> event,
                      Args&&... args) {
+    TRACE_EVENT1("electron.events", "EventEmitter::Emit", "name",
+                 name.as_string());
     // It's possible that |this| will be deleted by EmitEvent, so save anything
     // we need from |this| before calling EmitEvent.
     auto* isolate = this->isolate();
@@ -121,6 +155,9 @@ class EventEmitter : public gin_helper::Wrappable<T> {
     return false;
   }
 
+  bool listeners_tracked_ = false;
+  std::set<std::string, std::less<>> listened_events_;
+
   DISALLOW_COPY_AND_ASSIGN(EventEmitter);
 };
 
@@ -5,6 +5,9 @@
 #ifndef SHELL_COMMON_GIN_HELPER_FUNCTION_TEMPLATE_H_
 #define SHELL_COMMON_GIN_HELPER_FUNCTION_TEMPLATE_H_
 
+#include <string>
+#include <tuple>
+#include <type_traits>
 #include <utility>
 
 #include "base/bind.h"
@@ -14,6 +17,7 @@
 #include "shell/common/gin_helper/arguments.h"
 #include "shell/common/gin_helper/destroyable.h"
 #include "shell/common/gin_helper/error_thrower.h"
+#include "shell/common/gin_helper/wrappable_base.h"
 
 // This file is forked from gin/function_template.h with 2 differences:
 // 1. Support for additional types of arguments.
@@ -239,6 +243,137 @@ class Invoker<IndicesHolder<indices...>, ArgTypes...>
   gin::Arguments* args_;
 };
 
+// Argument types that can be converted straight from the
+// FunctionCallbackInfo, because converting them has no side effects.
+template <typename T, typename Enable = void>
+struct IsFastArgument : std::false_type {};
+template <>
+struct IsFastArgument<bool> : std::true_type {};
+template <>
+struct IsFastArgument<int32_t> : std::true_type {};
+template <>
+struct IsFastArgument<uint32_t> : std::true_type {};
+template <>
+struct IsFastArgument<double> : std::true_type {};
+template <>
+struct IsFastArgument<std::string> : std::true_type {};
+template <>
+struct IsFastArgument<v8::Local<v8::Value>> : std::true_type {};
+template <typename T>
+struct IsFastArgument<
+    T*,
+    typename std::enable_if<
+        std::is_convertible<T*, gin_helper::WrappableBase*>::value>::type>
+    : std::true_type {};
+
+template <typename... ArgTypes>
+struct AreFastArguments : std::true_type {};
+template <typename ArgType, typename... ArgTypes>
+struct AreFastArguments<ArgType, ArgTypes...>
+    : std::integral_constant<
+          bool,
+          IsFastArgument<
+              typename CallbackParamTraits<ArgType>::LocalType>::value &&
+              AreFastArguments<ArgTypes...>::value> {};
+
+// Converts the arguments of callbacks whose arguments are all fast, without
+// the per-argument bookkeeping of Invoker. It gives up on the first argument
+// that is missing or does not convert, and leaves throwing the error to
+// Invoker.
+template <typename IndicesType, typename... ArgTypes>
+class FastInvoker {};
+
+template <size_t... indices, typename... ArgTypes>
+class FastInvoker<IndicesHolder<indices...>, ArgTypes...> {
+ public:
+  FastInvoker(const v8::FunctionCallbackInfo<v8::Value>& info,
+              gin::Arguments* args,
+              int create_flags)
+      : info_(info),
+        args_(args),
+        holder_is_first_((create_flags & HolderIsFirstArgument) != 0) {}
+
+  bool Convert() {
+    if (info_.Length() <
+        static_cast<int>(sizeof...(ArgTypes)) - (holder_is_first_ ? 1 : 0))
+      return false;
+    return And(GetArgument(indices, &std::get<indices>(values_))...);
+  }
+
+  template <typename ReturnType>
+  void DispatchToCallback(base::Callback<ReturnType(ArgTypes...)> callback) {
+    v8::MicrotasksScope script_scope(args_->isolate(),
+                                     v8::MicrotasksScope::kRunMicrotasks);
+    args_->Return(callback.Run(std::move(std::get<indices>(values_))...));
+  }
+
+  void DispatchToCallback(base::Callback<void(ArgTypes...)> callback) {
+    v8::MicrotasksScope script_scope(args_->isolate(),
+                                     v8::MicrotasksScope::kRunMicrotasks);
+    callback.Run(std::move(std::get<indices>(values_))...);
+  }
+
+ private:
+  template <typename T>
+  bool GetArgument(size_t index, T* out) {
+    if (holder_is_first_) {
+      if (index == 0)
+        return GetHolder(out);
+      index--;
+    }
+    return gin::ConvertFromV8(args_->isolate(), info_[index], out);
+  }
+
+  template <typename T>
+  bool GetHolder(T** out) {
+    v8::Local<v8::Object> holder = info_.Holder();
+    return !gin_helper::Destroyable::IsDestroyed(holder) &&
+           gin::ConvertFromV8(args_->isolate(), holder, out);
+  }
+
+  template <typename T>
+  bool GetHolder(T* out) {
+    return false;
+  }
+
+  static bool And() { return true; }
+  template <typename... T>
+  static bool And(bool arg1, T... args) {
+    return arg1 && And(args...);
+  }
+
+  const v8::FunctionCallbackInfo<v8::Value>& info_;
+  gin::Arguments* args_;
+  const bool holder_is_first_;
+  std::tuple<typename CallbackParamTraits<ArgTypes>::LocalType...> values_;
+};
+
+// Dispatches the callbacks that take other arguments through Invoker.
+template <bool fast, typename ReturnType, typename... ArgTypes>
+struct FastDispatcher {
+  static bool DispatchToCallback(
+      const v8::FunctionCallbackInfo<v8::Value>& info,
+      gin::Arguments* args,
+      CallbackHolder<ReturnType(ArgTypes...)>* holder) {
+    return false;
+  }
+};
+
+template <typename ReturnType, typename... ArgTypes>
+struct FastDispatcher<true, ReturnType, ArgTypes...> {
+  static bool DispatchToCallback(
+      const v8::FunctionCallbackInfo<v8::Value>& info,
+      gin::Arguments* args,
+      CallbackHolder<ReturnType(ArgTypes...)>* holder) {
+    using Indices = typename IndicesGenerator<sizeof...(ArgTypes)>::type;
+    FastInvoker<Indices, ArgTypes...> invoker(info, args, holder->flags);
+    if (!invoker.Convert())
+      return false;
+    invoker.DispatchToCallback(holder->callback);
+    return true;
+  }
+};
+
 // DispatchToCallback converts all the JavaScript arguments to C++ types and
 // invokes the base::Callback.
 template <typename Sig>
@@ -257,6 +392,12 @@ struct Dispatcher<ReturnType(ArgTypes...)> {
     typedef CallbackHolder<ReturnType(ArgTypes...)> HolderT;
     HolderT* holder = static_cast<HolderT*>(holder_base);
 
+    // Callbacks taking only simple arguments, like most setters, skip
+    // gin::Arguments unless an argument is invalid.
+    if (FastDispatcher<AreFastArguments<ArgTypes...>::value, ReturnType,
+                       ArgTypes...>::DispatchToCallback(info, &args, holder))
+      return;
+
     using Indices = typename IndicesGenerator<sizeof...(ArgTypes)>::type;
     Invoker<Indices, ArgTypes...> invoker(&args, holder->flags);
     if (invoker.IsOK())
@@ -10,7 +10,7 @@
 #include "base/bind.h"
 #include "base/memory/weak_ptr.h"
 #include "shell/common/gin_helper/event_emitter.h"
-#include "shell/common/key_weak_map.h"
+#include "shell/common/id_weak_map.h"
 
 namespace base {
 class SupportsUserData;
@@ -59,6 +59,7 @@ class TrackableObject : public TrackableObjectBase, public EventEmitter<T> {
     if (!wrapper.IsEmpty()) {
       wrapper->SetAlignedPointerInInternalField(0, nullptr);
     }
+    GetWeakMap()->ClearNative(weak_map_id());
   }
 
   bool IsDestroyed() {
@@ -69,16 +70,7 @@ class TrackableObject : public TrackableObjectBase, public EventEmitter<T> {
 
   // Finds out the TrackableObject from its ID in weak map.
   static T* FromWeakMapID(v8::Isolate* isolate, int32_t id) {
-    if (!weak_map_)
-      return nullptr;
-
-    v8::MaybeLocal<v8::Object> object = weak_map_->Get(isolate, id);
-    if (object.IsEmpty())
-      return nullptr;
-
-    T* self = nullptr;
-    gin::ConvertFromV8(isolate, object.ToLocalChecked(), &self);
-    return self;
+    return GetWeakMap()->Get(id);
   }
 
   // Finds out the TrackableObject from the class it wraps.
@@ -92,44 +84,36 @@ class TrackableObject : public TrackableObjectBase, public EventEmitter<T> {
 
   // Returns all objects in this class's weak map.
   static std::vector<v8::Local<v8::Object>> GetAll(v8::Isolate* isolate) {
-    if (weak_map_)
-      return weak_map_->Values(isolate);
-    else
-      return std::vector<v8::Local<v8::Object>>();
+    return GetWeakMap()->Values(isolate);
   }
 
-  // Removes this instance from the weak map.
-  void RemoveFromWeakMap() {
-    if (weak_map_ && weak_map_->Has(weak_map_id()))
-      weak_map_->Remove(weak_map_id());
-  }
+  // Changes only when an object is added or removed, so the result of
+  // GetAll() can be cached until then.
+  static uint32_t GetAllVersion() { return GetWeakMap()->version(); }
+
+  // Removes this instance from the weak map. Stale IDs do not find the
+  // objects that are added later, so this is safe to call more than once.
+  void RemoveFromWeakMap() { GetWeakMap()->Remove(weak_map_id()); }
 
  protected:
-  TrackableObject() { weak_map_id_ = ++next_id_; }
+  TrackableObject() { weak_map_id_ = GetWeakMap()->Add(); }
 
   ~TrackableObject() override { RemoveFromWeakMap(); }
 
   void InitWith(v8::Isolate* isolate, v8::Local<v8::Object> wrapper) override {
     gin_helper::WrappableBase::InitWith(isolate, wrapper);
-    if (!weak_map_) {
-      weak_map_ = new electron::KeyWeakMap<int32_t>;
-    }
-    weak_map_->Set(isolate, weak_map_id_, wrapper);
+    GetWeakMap()->Set(isolate, weak_map_id_, static_cast<T*>(this), wrapper);
   }
 
  private:
-  static int32_t next_id_;
-  static electron::KeyWeakMap<int32_t>* weak_map_;  // leaked on purpose
+  static electron::IDWeakMap<T>* GetWeakMap() {
+    static auto* weak_map = new electron::IDWeakMap<T>;  // leaked on purpose
+    return weak_map;
+  }
 
   DISALLOW_COPY_AND_ASSIGN(TrackableObject);
 };
 
-template <typename T>
-int32_t TrackableObject<T>::next_id_ = 0;
-
-template <typename T>
-electron::KeyWeakMap<int32_t>* TrackableObject<T>::weak_map_ = nullptr;
-
 }  // namespace gin_helper
 
 #endif  // SHELL_COMMON_GIN_HELPER_TRACKABLE_OBJECT_H_
@@ -4,15 +4,21 @@
 
 #include "shell/common/heap_snapshot.h"
 
+#include <string>
+#include <utility>
+
+#include "base/bind.h"
+#include "mojo/public/cpp/system/data_pipe_utils.h"
 #include "v8/include/v8-profiler.h"
 
 namespace {
 
+using WriteChunkCallback = base::RepeatingCallback<bool(const char*, int)>;
+
 class HeapSnapshotOutputStream : public v8::OutputStream {
  public:
-  explicit HeapSnapshotOutputStream(base::File* file) : file_(file) {
-    DCHECK(file_);
-  }
+  explicit HeapSnapshotOutputStream(const WriteChunkCallback& write_chunk)
+      : write_chunk_(write_chunk) {}
 
   bool IsComplete() const { return is_complete_; }
 
@@ -21,15 +27,38 @@ class HeapSnapshotOutputStream : public v8::OutputStream {
   void EndOfStream() override { is_complete_ = true; }
 
   v8::OutputStream::WriteResult WriteAsciiChunk(char* data, int size) override {
-    auto bytes_written = file_->WriteAtCurrentPos(data, size);
-    return bytes_written == size ? kContinue : kAbort;
+    return write_chunk_.Run(data, size) ? kContinue : kAbort;
   }
 
  private:
-  base::File* file_ = nullptr;
+  WriteChunkCallback write_chunk_;
   bool is_complete_ = false;
 };
 
+bool SerializeHeapSnapshot(v8::Isolate* isolate,
+                           const WriteChunkCallback& write_chunk) {
+  auto* snapshot = isolate->GetHeapProfiler()->TakeHeapSnapshot();
+  if (!snapshot)
+    return false;
+
+  HeapSnapshotOutputStream stream(write_chunk);
+  snapshot->Serialize(&stream, v8::HeapSnapshot::kJSON);
+
+  const_cast<v8::HeapSnapshot*>(snapshot)->Delete();
+
+  return stream.IsComplete();
+}
+
+bool WriteChunkToFile(base::File* file, const char* data, int size) {
+  return file->WriteAtCurrentPos(data, size) == size;
+}
+
+bool WriteChunkToPipe(const mojo::ScopedDataPipeProducerHandle* pipe,
+                      const char* data,
+                      int size) {
+  return mojo::BlockingCopyFromString(std::string(data, size), *pipe);
+}
+
 }  // namespace
 
 namespace electron {
@@ -41,16 +70,20 @@ bool TakeHeapSnapshot(v8::Isolate* isolate, base::File* file) {
   if (!file->IsValid())
     return false;
 
-  auto* snapshot = isolate->GetHeapProfiler()->TakeHeapSnapshot();
-  if (!snapshot)
-    return false;
+  return SerializeHeapSnapshot(
+      isolate, base::BindRepeating(&WriteChunkToFile, base::Unretained(file)));
+}
 
-  HeapSnapshotOutputStream stream(file);
-  snapshot->Serialize(&stream, v8::HeapSnapshot::kJSON);
+bool TakeHeapSnapshot(v8::Isolate* isolate,
+                      mojo::ScopedDataPipeProducerHandle pipe) {
+  DCHECK(isolate);
 
-  const_cast<v8::HeapSnapshot*>(snapshot)->Delete();
+  if (!pipe.is_valid())
+    return false;
 
-  return stream.IsComplete();
+  // The pipe is closed when this returns, which ends the reader's stream.
+  return SerializeHeapSnapshot(
+      isolate, base::BindRepeating(&WriteChunkToPipe, base::Unretained(&pipe)));
 }
 
 }  // namespace electron
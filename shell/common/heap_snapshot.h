@@ -6,12 +6,18 @@
 #define SHELL_COMMON_HEAP_SNAPSHOT_H_
 
 #include "base/files/file.h"
+#include "mojo/public/cpp/system/data_pipe.h"
 #include "v8/include/v8.h"
 
 namespace electron {
 
 bool TakeHeapSnapshot(v8::Isolate* isolate, base::File* file);
 
+// Writes the snapshot to |pipe| as it is serialized, waiting for the reader
+// when the pipe is full. Returns false when the reader went away.
+bool TakeHeapSnapshot(v8::Isolate* isolate,
+                      mojo::ScopedDataPipeProducerHandle pipe);
+
 }  // namespace electron
 
 #endif  // SHELL_COMMON_HEAP_SNAPSHOT_H_
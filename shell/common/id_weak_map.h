@@ -0,0 +1,183 @@
+// Copyright (c) 2020 GitHub, Inc.
+// Use of this source code is governed by the MIT license that can be
+// found in the LICENSE file.
+
+#ifndef SHELL_COMMON_ID_WEAK_MAP_H_
+#define SHELL_COMMON_ID_WEAK_MAP_H_
+
+#include <stdint.h>
+
+#include <deque>
+#include <vector>
+
+#include "base/logging.h"
+#include "base/macros.h"
+#include "v8/include/v8.h"
+
+namespace electron {
+
+// Maps the IDs of objects to their native pointers and weak wrappers, so that
+// finding an object from its ID is an index into a vector.
+//
+// The low bits of an ID are the index of its slot plus one, and the high bits
+// are the generation of the slot, which is bumped whenever the slot is freed.
+// IDs are therefore never 0 and stale IDs never find the objects that reuse
+// their slots. A slot whose generation is exhausted is not reused, so IDs are
+// not reused either.
+template <typename T>
+class IDWeakMap {
+ public:
+  IDWeakMap() {}
+  ~IDWeakMap() {
+    for (auto& slot : slots_)
+      slot.wrapper.ClearWeak();
+  }
+
+  // Reserves a slot and returns its ID.
+  int32_t Add() {
+    uint32_t index;
+    if (free_slots_.empty()) {
+      CHECK(slots_.size() < kSlotMask);
+      index = slots_.size();
+      slots_.emplace_back();
+      slots_.back().map = this;
+      slots_.back().index = index;
+    } else {
+      index = free_slots_.back();
+      free_slots_.pop_back();
+    }
+    slots_[index].used = true;
+    return ToID(index);
+  }
+
+  // Sets the |native| object of |id| and its |wrapper|, which is held weakly.
+  // The slot is freed when the wrapper is garbage collected.
+  void Set(v8::Isolate* isolate,
+           int32_t id,
+           T* native,
+           v8::Local<v8::Object> wrapper) {
+    Slot* slot = GetSlot(id);
+    if (!slot)
+      return;
+    slot->native = native;
+    slot->wrapper.Reset(isolate, wrapper);
+    slot->wrapper.SetWeak(slot, OnObjectGC, v8::WeakCallbackType::kParameter);
+    version_++;
+  }
+
+  // Returns the native object of |id|, without touching its wrapper.
+  T* Get(int32_t id) const {
+    const Slot* slot = GetSlot(id);
+    return slot ? slot->native : nullptr;
+  }
+
+  // Returns the wrapper of |id|.
+  v8::MaybeLocal<v8::Object> GetWrapper(v8::Isolate* isolate,
+                                        int32_t id) const {
+    const Slot* slot = GetSlot(id);
+    if (!slot || slot->wrapper.IsEmpty())
+      return v8::MaybeLocal<v8::Object>();
+    return v8::Local<v8::Object>::New(isolate, slot->wrapper);
+  }
+
+  // Forgets the native object of |id| while keeping its wrapper, for objects
+  // that are destroyed before their wrappers are.
+  void ClearNative(int32_t id) {
+    Slot* slot = GetSlot(id);
+    if (slot)
+      slot->native = nullptr;
+  }
+
+  // Whether |id| has a wrapper in this map.
+  bool Has(int32_t id) const {
+    const Slot* slot = GetSlot(id);
+    return slot && !slot->wrapper.IsEmpty();
+  }
+
+  // Returns the wrappers of all objects.
+  std::vector<v8::Local<v8::Object>> Values(v8::Isolate* isolate) const {
+    std::vector<v8::Local<v8::Object>> values;
+    values.reserve(slots_.size() - free_slots_.size());
+    for (const auto& slot : slots_) {
+      if (slot.used && !slot.wrapper.IsEmpty())
+        values.emplace_back(v8::Local<v8::Object>::New(isolate, slot.wrapper));
+    }
+    return values;
+  }
+
+  // Changes whenever a wrapper is added to or removed from the map, so the
+  // callers of Values() can keep its result until then.
+  uint32_t version() const { return version_; }
+
+  // Frees the slot of |id|.
+  void Remove(int32_t id) {
+    Slot* slot = GetSlot(id);
+    if (slot)
+      Free(slot);
+  }
+
+ private:
+  static const int kSlotBits = 20;
+  static const uint32_t kSlotMask = (1u << kSlotBits) - 1;
+  static const uint32_t kMaxGeneration = (1u << (31 - kSlotBits)) - 1;
+
+  struct Slot {
+    IDWeakMap* map = nullptr;
+    uint32_t index = 0;
+    uint32_t generation = 0;
+    bool used = false;
+    T* native = nullptr;
+    v8::Global<v8::Object> wrapper;
+  };
+
+  int32_t ToID(uint32_t index) const {
+    return static_cast<int32_t>((slots_[index].generation << kSlotBits) |
+                                (index + 1));
+  }
+
+  Slot* GetSlot(int32_t id) {
+    return const_cast<Slot*>(static_cast<const IDWeakMap*>(this)->GetSlot(id));
+  }
+
+  const Slot* GetSlot(int32_t id) const {
+    if (id <= 0)
+      return nullptr;
+    uint32_t index = (static_cast<uint32_t>(id) & kSlotMask) - 1;
+    uint32_t generation = static_cast<uint32_t>(id) >> kSlotBits;
+    if (index >= slots_.size())
+      return nullptr;
+    const Slot& slot = slots_[index];
+    if (!slot.used || slot.generation != generation)
+      return nullptr;
+    return &slot;
+  }
+
+  void Free(Slot* slot) {
+    if (!slot->wrapper.IsEmpty())
+      version_++;
+    slot->used = false;
+    slot->native = nullptr;
+    slot->wrapper.Reset();
+    if (slot->generation < kMaxGeneration) {
+      slot->generation++;
+      free_slots_.push_back(slot->index);
+    }
+  }
+
+  static void OnObjectGC(const v8::WeakCallbackInfo<Slot>& data) {
+    Slot* slot = data.GetParameter();
+    slot->map->Free(slot);
+  }
+
+  // A deque keeps the slots in place when it grows, since their addresses are
+  // the parameters of the weak callbacks.
+  std::deque<Slot> slots_;
+  std::vector<uint32_t> free_slots_;
+  uint32_t version_ = 0;
+
+  DISALLOW_COPY_AND_ASSIGN(IDWeakMap);
+};
+
+}  // namespace electron
+
+#endif  // SHELL_COMMON_ID_WEAK_MAP_H_
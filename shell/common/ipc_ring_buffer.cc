@@ -0,0 +1,125 @@
+// Copyright (c) 2020 GitHub, Inc.
+// Use of this source code is governed by the MIT license that can be
+// found in the LICENSE file.
+
+#include "shell/common/ipc_ring_buffer.h"
+
+#include <string.h>
+
+#include <atomic>
+
+#include "base/bits.h"
+#include "base/logging.h"
+
+namespace electron {
+
+namespace {
+
+const uint32_t kRecordHeaderSize = 8;
+const uint32_t kRecordAlignment = 8;
+
+// Marks the unused end of the buffer when a record did not fit there.
+const uint32_t kPaddingMarker = 0xffffffff;
+
+uint32_t GetRecordSize(uint32_t payload_size) {
+  size_t aligned_size = base::bits::Align(payload_size, kRecordAlignment);
+  return kRecordHeaderSize + static_cast<uint32_t>(aligned_size);
+}
+
+}  // namespace
+
+// The two positions are on separate cache lines so that the ends do not
+// invalidate each other's line on every access.
+struct IpcRingBuffer::Header {
+  std::atomic<uint64_t> write_position;
+  uint8_t padding1[56];
+  std::atomic<uint64_t> read_position;
+  uint8_t padding2[56];
+};
+
+static_assert(sizeof(std::atomic<uint64_t>) == sizeof(uint64_t),
+              "positions must be plain integers in shared memory");
+
+// static
+bool IpcRingBuffer::IsValidCapacity(uint32_t capacity) {
+  return capacity >= kMinCapacity && capacity <= kMaxCapacity &&
+         base::bits::IsPowerOfTwo(capacity);
+}
+
+// static
+size_t IpcRingBuffer::GetMemorySize(uint32_t capacity) {
+  return sizeof(Header) + capacity;
+}
+
+IpcRingBuffer::IpcRingBuffer(void* memory, uint32_t capacity)
+    : header_(static_cast<Header*>(memory)),
+      records_(static_cast<uint8_t*>(memory) + sizeof(Header)),
+      capacity_(capacity) {
+  DCHECK(IsValidCapacity(capacity));
+}
+
+IpcRingBuffer::~IpcRingBuffer() = default;
+
+bool IpcRingBuffer::Write(base::span<const uint8_t> record) {
+  if (record.size() > capacity_ - kRecordHeaderSize)
+    return false;
+  uint32_t size = static_cast<uint32_t>(record.size());
+  uint32_t record_size = GetRecordSize(size);
+
+  uint64_t read_position =
+      header_->read_position.load(std::memory_order_acquire);
+  uint32_t index = position_ & (capacity_ - 1);
+  uint32_t tail = capacity_ - index;
+  uint64_t needed = record_size > tail ? tail + record_size : record_size;
+  if (position_ + needed - read_position > capacity_)
+    return false;
+
+  if (record_size > tail) {
+    memcpy(records_ + index, &kPaddingMarker, sizeof(kPaddingMarker));
+    position_ += tail;
+    index = 0;
+  }
+  memcpy(records_ + index, &size, sizeof(size));
+  memcpy(records_ + index + kRecordHeaderSize, record.data(), size);
+  position_ += record_size;
+  header_->write_position.store(position_, std::memory_order_release);
+  return true;
+}
+
+bool IpcRingBuffer::Read(std::vector<uint8_t>* data,
+                         std::vector<uint32_t>* sizes) {
+  uint64_t write_position =
+      header_->write_position.load(std::memory_order_acquire);
+  if (write_position < position_ || write_position - position_ > capacity_)
+    return false;
+
+  while (position_ < write_position) {
+    uint32_t index = position_ & (capacity_ - 1);
+    uint32_t tail = capacity_ - index;
+    uint32_t size;
+    memcpy(&size, records_ + index, sizeof(size));
+    if (size == kPaddingMarker) {
+      position_ += tail;
+      continue;
+    }
+    if (size > capacity_ - kRecordHeaderSize)
+      return false;
+    uint32_t record_size = GetRecordSize(size);
+    if (record_size > tail || record_size > write_position - position_)
+      return false;
+
+    size_t offset = data->size();
+    data->resize(offset + record_size - kRecordHeaderSize);
+    memcpy(data->data() + offset, records_ + index + kRecordHeaderSize, size);
+    sizes->push_back(size);
+    position_ += record_size;
+  }
+  // A padding marker can only be followed by a record at the start.
+  if (position_ != write_position)
+    return false;
+
+  header_->read_position.store(position_, std::memory_order_release);
+  return true;
+}
+
+}  // namespace electron
@@ -0,0 +1,70 @@
+// Copyright (c) 2020 GitHub, Inc.
+// Use of this source code is governed by the MIT license that can be
+// found in the LICENSE file.
+
+#ifndef SHELL_COMMON_IPC_RING_BUFFER_H_
+#define SHELL_COMMON_IPC_RING_BUFFER_H_
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include <vector>
+
+#include "base/containers/span.h"
+#include "base/macros.h"
+
+namespace electron {
+
+// A single-producer/single-consumer queue of variable sized records in shared
+// memory, written by a renderer and read by the browser process.
+//
+// The memory starts with a header holding the producer's and the consumer's
+// positions, followed by |capacity| bytes of records. Every record is an 8 byte
+// header holding its size followed by its payload padded to 8 bytes. A record
+// never wraps around the end; the producer writes a padding marker and starts
+// over at the beginning instead.
+//
+// The consumer must not trust anything it reads from the memory, since the
+// producer can write to it at any time.
+class IpcRingBuffer {
+ public:
+  static const uint32_t kMinCapacity = 4 * 1024;
+  static const uint32_t kMaxCapacity = 64 * 1024 * 1024;
+
+  // Whether |capacity| is a power of two between the two limits above.
+  static bool IsValidCapacity(uint32_t capacity);
+
+  // Returns the size of the shared memory needed for |capacity|.
+  static size_t GetMemorySize(uint32_t capacity);
+
+  // |memory| must be GetMemorySize(capacity) bytes, zeroed before either end
+  // starts using it.
+  IpcRingBuffer(void* memory, uint32_t capacity);
+  ~IpcRingBuffer();
+
+  uint32_t capacity() const { return capacity_; }
+
+  // Producer: appends |record|, returns false if there is no room for it.
+  bool Write(base::span<const uint8_t> record);
+
+  // Consumer: moves the available records to the end of |data|, each one
+  // starting 8 byte aligned, and appends their sizes to |sizes|. Returns false
+  // if the producer corrupted the buffer.
+  bool Read(std::vector<uint8_t>* data, std::vector<uint32_t>* sizes);
+
+ private:
+  struct Header;
+
+  Header* header_;
+  uint8_t* records_;
+  uint32_t capacity_;
+
+  // The position of this end, which is never read back from shared memory.
+  uint64_t position_ = 0;
+
+  DISALLOW_COPY_AND_ASSIGN(IpcRingBuffer);
+};
+
+}  // namespace electron
+
+#endif  // SHELL_COMMON_IPC_RING_BUFFER_H_
@@ -0,0 +1,26 @@
+// Copyright (c) 2020 GitHub, Inc.
+// Use of this source code is governed by the MIT license that can be
+// found in the LICENSE file.
+
+#include "shell/common/ipc_trace.h"
+
+#include "base/atomic_sequence_num.h"
+#include "base/rand_util.h"
+
+namespace electron {
+
+uint64_t NewIpcTraceId() {
+  bool enabled;
+  TRACE_EVENT_CATEGORY_GROUP_ENABLED("electron", &enabled);
+  if (!enabled)
+    return 0;
+
+  // The processes count their messages from a random base, so that their IDs
+  // do not collide in the trace.
+  static const uint64_t process_base = base::RandUint64();
+  static base::AtomicSequenceNumber sequence;
+  uint64_t trace_id = process_base + sequence.GetNext() + 1;
+  return trace_id ? trace_id : 1;
+}
+
+}  // namespace electron
@@ -0,0 +1,30 @@
+// Copyright (c) 2020 GitHub, Inc.
+// Use of this source code is governed by the MIT license that can be
+// found in the LICENSE file.
+
+#ifndef SHELL_COMMON_IPC_TRACE_H_
+#define SHELL_COMMON_IPC_TRACE_H_
+
+#include <stdint.h>
+
+#include "base/trace_event/trace_event.h"
+
+namespace electron {
+
+// The trace events of an IPC message are linked across processes by flow
+// events with the ID its sender passes along with it, so that a trace shows an
+// arrow from the send to its handler, and for invoke and sendSync from the
+// handler's reply back to the sender.
+
+// Returns the ID to send a message with, unique to the whole trace. It is 0,
+// which links nothing, while the "electron" category is not traced.
+uint64_t NewIpcTraceId();
+
+// The flow flags of an event for the message with |trace_id|, none for 0.
+inline unsigned int IpcTraceFlowFlags(uint64_t trace_id, unsigned int flags) {
+  return trace_id ? flags : TRACE_EVENT_FLAG_NONE;
+}
+
+}  // namespace electron
+
+#endif  // SHELL_COMMON_IPC_TRACE_H_
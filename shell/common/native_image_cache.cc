@@ -0,0 +1,145 @@
+// Copyright (c) 2020 GitHub, Inc.
+// Use of this source code is governed by the MIT license that can be
+// found in the LICENSE file.
+
+#include "shell/common/native_image_cache.h"
+
+#include <iterator>
+
+#include "base/bind.h"
+#include "base/files/file.h"
+#include "base/files/file_util.h"
+#include "base/threading/thread_restrictions.h"
+#include "shell/common/asar/asar_util.h"
+#include "shell/common/skia_util.h"
+
+namespace electron {
+
+namespace {
+
+// The files inside of an archive only change with the archive.
+base::Time GetLastModified(const base::FilePath& path) {
+  base::FilePath asar_path, relative_path;
+  const base::FilePath& file =
+      asar::GetAsarArchivePath(path, &asar_path, &relative_path) ? asar_path
+                                                                  : path;
+  base::ThreadRestrictions::ScopedAllowIO allow_io;
+  base::File::Info info;
+  if (!base::GetFileInfo(file, &info))
+    return base::Time();
+  return info.last_modified;
+}
+
+size_t GetImageSize(const gfx::ImageSkia& image) {
+  size_t size = 0;
+  for (const gfx::ImageSkiaRep& rep : image.image_reps())
+    size += rep.GetBitmap().computeByteSize();
+  return size;
+}
+
+}  // namespace
+
+// static
+NativeImageCache* NativeImageCache::GetInstance() {
+  static base::NoDestructor<NativeImageCache> instance;
+  return instance.get();
+}
+
+NativeImageCache::NativeImageCache() : entries_(EntryMap::NO_AUTO_EVICT) {}
+
+NativeImageCache::~NativeImageCache() = default;
+
+gfx::ImageSkia NativeImageCache::GetImage(const base::FilePath& path) {
+  base::Time last_modified;
+  if (max_size() > 0)
+    last_modified = GetLastModified(path);
+  if (!last_modified.is_null()) {
+    base::AutoLock auto_lock(lock_);
+    auto iter = entries_.Get(path);
+    if (iter != entries_.end()) {
+      if (iter->second.last_modified == last_modified)
+        return iter->second.image;
+      size_ -= iter->second.size;
+      entries_.Erase(iter);
+    }
+  }
+
+  gfx::ImageSkia image;
+  util::PopulateImageSkiaRepsFromPath(&image, path);
+  if (image.isNull() || last_modified.is_null())
+    return image;
+
+  // The cached image is shared by the threads using it.
+  image.MakeThreadSafe();
+  size_t size = GetImageSize(image);
+  base::AutoLock auto_lock(lock_);
+  if (size > max_size_)
+    return image;
+  auto iter = entries_.Peek(path);
+  if (iter != entries_.end()) {
+    size_ -= iter->second.size;
+    entries_.Erase(iter);
+  }
+  entries_.Put(path, Entry{last_modified, image, size});
+  size_ += size;
+  EvictTo(max_size_);
+  return image;
+}
+
+gfx::ImageSkia NativeImageCache::GetCachedImage(const base::FilePath& path) {
+  base::AutoLock auto_lock(lock_);
+  auto iter = entries_.Get(path);
+  return iter != entries_.end() ? iter->second.image : gfx::ImageSkia();
+}
+
+void NativeImageCache::SetMaxSize(size_t max_size) {
+  if (max_size > 0 && !memory_pressure_listener_) {
+    memory_pressure_listener_ =
+        std::make_unique<base::MemoryPressureListener>(base::BindRepeating(
+            &NativeImageCache::OnMemoryPressure, base::Unretained(this)));
+  }
+  base::AutoLock auto_lock(lock_);
+  max_size_ = max_size;
+  EvictTo(max_size_);
+}
+
+void NativeImageCache::Clear() {
+  base::AutoLock auto_lock(lock_);
+  EvictTo(0);
+}
+
+size_t NativeImageCache::max_size() {
+  base::AutoLock auto_lock(lock_);
+  return max_size_;
+}
+
+size_t NativeImageCache::size() {
+  base::AutoLock auto_lock(lock_);
+  return size_;
+}
+
+void NativeImageCache::EvictTo(size_t size) {
+  lock_.AssertAcquired();
+  while (size_ > size) {
+    auto iter = std::prev(entries_.end());
+    size_ -= iter->second.size;
+    entries_.Erase(iter);
+  }
+}
+
+void NativeImageCache::OnMemoryPressure(
+    base::MemoryPressureListener::MemoryPressureLevel level) {
+  base::AutoLock auto_lock(lock_);
+  switch (level) {
+    case base::MemoryPressureListener::MEMORY_PRESSURE_LEVEL_MODERATE:
+      EvictTo(max_size_ / 2);
+      break;
+    case base::MemoryPressureListener::MEMORY_PRESSURE_LEVEL_CRITICAL:
+      EvictTo(0);
+      break;
+    default:
+      break;
+  }
+}
+
+}  // namespace electron
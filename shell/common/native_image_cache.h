@@ -0,0 +1,85 @@
+// Copyright (c) 2020 GitHub, Inc.
+// Use of this source code is governed by the MIT license that can be
+// found in the LICENSE file.
+
+#ifndef SHELL_COMMON_NATIVE_IMAGE_CACHE_H_
+#define SHELL_COMMON_NATIVE_IMAGE_CACHE_H_
+
+#include <memory>
+
+#include "base/containers/mru_cache.h"
+#include "base/files/file_path.h"
+#include "base/macros.h"
+#include "base/memory/memory_pressure_listener.h"
+#include "base/no_destructor.h"
+#include "base/synchronization/lock.h"
+#include "base/time/time.h"
+#include "ui/gfx/image/image_skia.h"
+
+namespace electron {
+
+// A process-wide cache of the images decoded from files, so that the icons
+// set again and again from the same files, like the ones of the trays and the
+// menus, are only decoded once. The images are cached by path, with the reps
+// of all their scale factors, and decoded again once their file is modified.
+// The least recently used images are evicted once |max_size| bytes of pixels
+// are stored. The cache is disabled until a maximum size is set.
+class NativeImageCache {
+ public:
+  static NativeImageCache* GetInstance();
+
+  // Returns the image decoded from |path| and the files of its other scale
+  // factors, from the cache when the file was not modified since it was
+  // cached. Can be called on any thread.
+  gfx::ImageSkia GetImage(const base::FilePath& path);
+
+  // Returns the image cached for |path| without checking its file, or a null
+  // image when it is not cached. Can be called on any thread.
+  gfx::ImageSkia GetCachedImage(const base::FilePath& path);
+
+  // Evicts images until at most |max_size| bytes are stored, a size of 0
+  // disabling the cache. Must be called on the main thread.
+  void SetMaxSize(size_t max_size);
+  void Clear();
+
+  size_t max_size();
+  size_t size();
+
+ private:
+  friend class base::NoDestructor<NativeImageCache>;
+
+  struct Entry {
+    base::Time last_modified;
+    gfx::ImageSkia image;
+    size_t size;
+  };
+
+  using EntryMap = base::MRUCache<base::FilePath, Entry>;
+
+  NativeImageCache();
+  ~NativeImageCache();
+
+  // Evicts images until at most |size| bytes are stored, with |lock_| held.
+  void EvictTo(size_t size);
+
+  // Drops the least recently used images until half of the budget is used
+  // under moderate memory pressure, and all of them under critical pressure.
+  // They are decoded from their files again when next loaded, and the budget
+  // set by the app stays the same.
+  void OnMemoryPressure(
+      base::MemoryPressureListener::MemoryPressureLevel level);
+
+  base::Lock lock_;
+  EntryMap entries_;
+  size_t max_size_ = 0;
+  size_t size_ = 0;
+
+  // Created on the main thread once the cache is enabled.
+  std::unique_ptr<base::MemoryPressureListener> memory_pressure_listener_;
+
+  DISALLOW_COPY_AND_ASSIGN(NativeImageCache);
+};
+
+}  // namespace electron
+
+#endif  // SHELL_COMMON_NATIVE_IMAGE_CACHE_H_
@@ -4,6 +4,11 @@
 
 #include "shell/common/node_bindings.h"
 
+#if defined(OS_POSIX)
+#include <errno.h>
+#include <poll.h>
+#endif
+
 #include <algorithm>
 #include <memory>
 #include <set>
@@ -14,10 +19,14 @@
 #include "base/base_paths.h"
 #include "base/command_line.h"
 #include "base/environment.h"
+#include "base/lazy_instance.h"
 #include "base/path_service.h"
 #include "base/run_loop.h"
+#include "base/strings/string_number_conversions.h"
 #include "base/strings/string_split.h"
 #include "base/strings/utf_string_conversions.h"
+#include "base/system/sys_info.h"
+#include "base/threading/thread_local.h"
 #include "base/threading/thread_task_runner_handle.h"
 #include "base/trace_event/trace_event.h"
 #include "content/public/browser/browser_thread.h"
@@ -30,6 +39,8 @@
 #include "shell/common/gin_helper/locker.h"
 #include "shell/common/mac/main_application_bundle.h"
 #include "shell/common/node_includes.h"
+#include "shell/common/options_switches.h"
+#include "shell/common/startup_timeline.h"
 
 #define ELECTRON_BUILTIN_MODULES(V)  \
   V(atom_browser_app)                \
@@ -48,6 +59,7 @@
   V(atom_browser_power_save_blocker) \
   V(atom_browser_protocol)           \
   V(atom_browser_session)            \
+  V(atom_browser_shared_memory)      \
   V(atom_browser_system_preferences) \
   V(atom_browser_top_level_window)   \
   V(atom_browser_tray)               \
@@ -56,6 +68,7 @@
   V(atom_browser_view)               \
   V(atom_browser_web_view_manager)   \
   V(atom_browser_window)             \
+  V(atom_browser_worker_pool)        \
   V(atom_common_asar)                \
   V(atom_common_clipboard)           \
   V(atom_common_command_line)        \
@@ -185,6 +198,12 @@ namespace electron {
 
 namespace {
 
+// How long UvRunOnce keeps running the uv loop while it has pending events.
+const int kUvRunBudgetMs = 4;
+
+base::LazyInstance<base::ThreadLocalPointer<NodeBindings>>::DestructorAtExit
+    lazy_tls = LAZY_INSTANCE_INITIALIZER;
+
 // Convert the given vector to an array of C-strings. The strings in the
 // returned vector are only guaranteed valid so long as the vector of strings
 // is not modified.
@@ -197,6 +216,29 @@ std::unique_ptr<const char* []> StringVectorToArgArray(
   return array;
 }
 
+// Sizes the libuv threadpool from --uv-threadpool-size, unless
+// UV_THREADPOOL_SIZE is already set. "auto" sizes it to the number of cores,
+// and never below libuv's default of 4 threads.
+void SetUvThreadpoolSize(base::Environment* env) {
+  auto* command_line = base::CommandLine::ForCurrentProcess();
+  if (env->HasVar("UV_THREADPOOL_SIZE") ||
+      !command_line->HasSwitch(switches::kUvThreadpoolSize))
+    return;
+
+  std::string value =
+      command_line->GetSwitchValueASCII(switches::kUvThreadpoolSize);
+  int size;
+  if (value == "auto") {
+    size = std::max(4, base::SysInfo::NumberOfProcessors());
+  } else if (!base::StringToInt(value, &size) || size < 1) {
+    LOG(ERROR) << "Invalid --uv-threadpool-size: " << value;
+    return;
+  }
+
+  // libuv does not start more than 128 threads.
+  env->SetVar("UV_THREADPOOL_SIZE", base::NumberToString(std::min(size, 128)));
+}
+
 base::FilePath GetResourcesPath() {
 #if defined(OS_MACOSX)
   return MainApplicationBundlePath().Append("Contents").Append("Resources");
@@ -219,19 +261,25 @@ NodeBindings::NodeBindings(BrowserEnvironment browser_env)
   } else {
     uv_loop_ = uv_default_loop();
   }
+  lazy_tls.Pointer()->Set(this);
 }
 
 NodeBindings::~NodeBindings() {
-  // Quit the embed thread.
-  embed_closed_ = true;
-  uv_sem_post(&embed_sem_);
-  WakeupEmbedThread();
+  if (lazy_tls.Pointer()->Get() == this)
+    lazy_tls.Pointer()->Set(nullptr);
+
+  if (!integrated_) {
+    // Quit the embed thread.
+    embed_closed_ = true;
+    uv_sem_post(&embed_sem_);
+    WakeupEmbedThread();
 
-  // Wait for everything to be done.
-  uv_thread_join(&embed_thread_);
+    // Wait for everything to be done.
+    uv_thread_join(&embed_thread_);
 
-  // Clear uv.
-  uv_sem_destroy(&embed_sem_);
+    // Clear uv.
+    uv_sem_destroy(&embed_sem_);
+  }
   uv_close(reinterpret_cast<uv_handle_t*>(&dummy_uv_handle_), nullptr);
 
   // Clean up worker loop
@@ -255,8 +303,14 @@ bool NodeBindings::IsInitialized() {
   return g_is_initialized;
 }
 
+// static
+NodeBindings* NodeBindings::GetCurrent() {
+  return lazy_tls.Pointer()->Get();
+}
+
 void NodeBindings::Initialize() {
   TRACE_EVENT0("electron", "NodeBindings::Initialize");
+  ScopedStartupPhase startup_phase("NodeBindings::Initialize");
   // Open node's error reporting system for browser process.
   node::g_standalone_mode = browser_env_ == BrowserEnvironment::BROWSER;
   node::g_upstream_node_mode = false;
@@ -280,6 +334,8 @@ void NodeBindings::Initialize() {
 
   std::unique_ptr<base::Environment> env(base::Environment::Create());
   SetNodeOptions(env.get());
+  if (browser_env_ == BrowserEnvironment::BROWSER)
+    SetUvThreadpoolSize(env.get());
 
   // TODO(codebytere): this is going to be deprecated in the near future
   // in favor of Init(std::vector<std::string>* argv,
@@ -301,6 +357,7 @@ node::Environment* NodeBindings::CreateEnvironment(
     v8::Handle<v8::Context> context,
     node::MultiIsolatePlatform* platform,
     bool bootstrap_env) {
+  ScopedStartupPhase startup_phase("NodeBindings::CreateEnvironment");
 #if defined(OS_WIN)
   auto& atom_args = AtomCommandLine::argv();
   std::vector<std::string> args(atom_args.size());
@@ -375,6 +432,7 @@ node::Environment* NodeBindings::CreateEnvironment(
 }
 
 void NodeBindings::LoadEnvironment(node::Environment* env) {
+  ScopedStartupPhase startup_phase("NodeBindings::LoadEnvironment");
   node::LoadEnvironment(env);
   gin_helper::EmitEvent(env->isolate(), env->process_object(), "loaded");
 }
@@ -384,6 +442,16 @@ void NodeBindings::PrepareMessageLoop() {
   // nothing to do.
   uv_async_init(uv_loop_, &dummy_uv_handle_, nullptr);
 
+  // The main process can skip the embed thread and run the uv loop when the
+  // message pump sees its backend fd become readable.
+  if (browser_env_ == BrowserEnvironment::BROWSER &&
+      base::CommandLine::ForCurrentProcess()->HasSwitch(
+          switches::kEnableIntegratedUvLoop) &&
+      WatchBackendFd()) {
+    integrated_ = true;
+    return;
+  }
+
   // Start worker that will interrupt main loop when having uv events.
   uv_sem_init(&embed_sem_, 0);
   uv_thread_create(&embed_thread_, EmbedThreadRunner, this);
@@ -406,6 +474,8 @@ void NodeBindings::UvRunOnce() {
   if (!env)
     return;
 
+  TRACE_EVENT0("electron.node", "NodeBindings::UvRunOnce");
+
   // Use Locker in browser process.
   gin_helper::Locker locker(env->isolate());
   v8::HandleScope handle_scope(env->isolate());
@@ -420,8 +490,24 @@ void NodeBindings::UvRunOnce() {
   if (browser_env_ != BrowserEnvironment::BROWSER)
     TRACE_EVENT_BEGIN0("devtools.timeline", "FunctionCall");
 
-  // Deal with uv events.
-  int r = uv_run(uv_loop_, UV_RUN_NOWAIT);
+  // Deal with uv events, until there are none left or the budget runs out.
+  // The remaining events wake the thread up again after its queued tasks.
+  base::TimeTicks start = base::TimeTicks::Now();
+  base::TimeTicks now;
+  int r;
+  uv_loop_metrics_.wakeups++;
+  while (true) {
+    r = uv_run(uv_loop_, UV_RUN_NOWAIT);
+    uv_loop_metrics_.iterations++;
+    now = base::TimeTicks::Now();
+    if (r == 0 || !HasPendingEvents())
+      break;
+    if (now - start >= base::TimeDelta::FromMilliseconds(kUvRunBudgetMs)) {
+      uv_loop_metrics_.budget_exhausted++;
+      break;
+    }
+  }
+  uv_loop_metrics_.uv_time += now - start;
 
   if (browser_env_ != BrowserEnvironment::BROWSER)
     TRACE_EVENT_END0("devtools.timeline", "FunctionCall");
@@ -429,10 +515,45 @@ void NodeBindings::UvRunOnce() {
   if (r == 0)
     base::RunLoop().QuitWhenIdle();  // Quit from uv.
 
+  if (integrated_) {
+    // Run again when the next timer is due, or right away when libuv has
+    // idle and check handles, which make the timeout 0.
+    int timeout = uv_backend_timeout(uv_loop_);
+    if (timeout < 0)
+      uv_timer_.Stop();
+    else
+      uv_timer_.Start(FROM_HERE, base::TimeDelta::FromMilliseconds(timeout),
+                      base::BindOnce(&NodeBindings::UvRunOnce,
+                                     base::Unretained(this)));
+    return;
+  }
+
   // Tell the worker thread to continue polling.
   uv_sem_post(&embed_sem_);
 }
 
+bool NodeBindings::WatchBackendFd() {
+  return false;
+}
+
+bool NodeBindings::HasPendingEvents() {
+  // Due timers, idle handles and pending callbacks.
+  if (uv_backend_timeout(uv_loop_) == 0)
+    return true;
+
+#if defined(OS_POSIX)
+  // The epoll or kqueue fd of the loop is readable when it has events.
+  struct pollfd backend = {uv_backend_fd(uv_loop_), POLLIN, 0};
+  int r;
+  do {
+    r = poll(&backend, 1, 0);
+  } while (r == -1 && errno == EINTR);
+  return r > 0;
+#else
+  return false;
+#endif
+}
+
 void NodeBindings::WakeupMainThread() {
   DCHECK(task_runner_);
   task_runner_->PostTask(FROM_HERE, base::BindOnce(&NodeBindings::UvRunOnce,
@@ -5,10 +5,14 @@
 #ifndef SHELL_COMMON_NODE_BINDINGS_H_
 #define SHELL_COMMON_NODE_BINDINGS_H_
 
+#include <stdint.h>
+
 #include "base/files/file_path.h"
 #include "base/macros.h"
 #include "base/memory/weak_ptr.h"
 #include "base/single_thread_task_runner.h"
+#include "base/time/time.h"
+#include "base/timer/timer.h"
 #include "uv.h"  // NOLINT(build/include)
 #include "v8/include/v8.h"
 
@@ -32,7 +36,21 @@ class NodeBindings {
     WORKER,
   };
 
+  // How much work the uv loop of a thread has done.
+  struct UvLoopMetrics {
+    // The times the thread woke up to run the uv loop.
+    uint64_t wakeups = 0;
+    // The iterations of the uv loop run in those wakeups.
+    uint64_t iterations = 0;
+    // The wakeups that still had events when their time budget ran out.
+    uint64_t budget_exhausted = 0;
+    // The time spent running the uv loop.
+    base::TimeDelta uv_time;
+  };
+
   static NodeBindings* Create(BrowserEnvironment browser_env);
+  // Returns the NodeBindings whose uv loop runs on the current thread.
+  static NodeBindings* GetCurrent();
   static void RegisterBuiltinModules();
   static bool IsInitialized();
 
@@ -63,13 +81,21 @@ class NodeBindings {
 
   uv_loop_t* uv_loop() const { return uv_loop_; }
 
+  const UvLoopMetrics& uv_loop_metrics() const { return uv_loop_metrics_; }
+
  protected:
   explicit NodeBindings(BrowserEnvironment browser_env);
 
   // Called to poll events in new thread.
   virtual void PollEvents() = 0;
 
-  // Run the libuv loop for once.
+  // Starts calling UvRunOnce() from the message pump of the current thread
+  // whenever the backend fd of |uv_loop_| becomes readable. Returns false when
+  // the platform can not watch it, in which case the embed thread is used.
+  virtual bool WatchBackendFd();
+
+  // Run the libuv loop until it has no pending events, or for at most a time
+  // budget so that the tasks of the thread are not starved.
   void UvRunOnce();
 
   // Make the main thread run libuv loop.
@@ -91,9 +117,22 @@ class NodeBindings {
   // Thread to poll uv events.
   static void EmbedThreadRunner(void* arg);
 
+  // Whether running the uv loop again would handle events right away.
+  bool HasPendingEvents();
+
   // Whether the libuv loop has ended.
   bool embed_closed_ = false;
 
+  // Whether the uv loop is run from the message pump of the main thread
+  // instead of being polled by the embed thread.
+  bool integrated_ = false;
+
+  // Fires the libuv timers when the uv loop is |integrated_|, since nothing
+  // becomes readable when they are due.
+  base::OneShotTimer uv_timer_;
+
+  UvLoopMetrics uv_loop_metrics_;
+
   // Loop used when constructed in WORKER mode
   uv_loop_t worker_loop_;
 
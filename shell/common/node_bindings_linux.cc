@@ -6,6 +6,10 @@
 
 #include <sys/epoll.h>
 
+#if defined(USE_GLIB)
+#include <glib-unix.h>
+#endif
+
 namespace electron {
 
 NodeBindingsLinux::NodeBindingsLinux(BrowserEnvironment browser_env)
@@ -17,7 +21,12 @@ NodeBindingsLinux::NodeBindingsLinux(BrowserEnvironment browser_env)
   epoll_ctl(epoll_, EPOLL_CTL_ADD, backend_fd, &ev);
 }
 
-NodeBindingsLinux::~NodeBindingsLinux() = default;
+NodeBindingsLinux::~NodeBindingsLinux() {
+#if defined(USE_GLIB)
+  if (backend_fd_source_)
+    g_source_remove(backend_fd_source_);
+#endif
+}
 
 void NodeBindingsLinux::RunMessageLoop() {
   // Get notified when libuv's watcher queue changes.
@@ -47,6 +56,28 @@ void NodeBindingsLinux::PollEvents() {
   } while (r == -1 && errno == EINTR);
 }
 
+bool NodeBindingsLinux::WatchBackendFd() {
+#if defined(USE_GLIB)
+  // The UI message pump runs the default glib main context, and so does this
+  // source. The epoll fd stays readable until uv_run() handles its events.
+  backend_fd_source_ = g_unix_fd_add(uv_backend_fd(uv_loop_), G_IO_IN,
+                                     OnBackendFdReadable, this);
+  return backend_fd_source_ != 0;
+#else
+  return false;
+#endif
+}
+
+#if defined(USE_GLIB)
+// static
+gboolean NodeBindingsLinux::OnBackendFdReadable(gint fd,
+                                                GIOCondition condition,
+                                                gpointer data) {
+  static_cast<NodeBindingsLinux*>(data)->UvRunOnce();
+  return G_SOURCE_CONTINUE;
+}
+#endif
+
 // static
 NodeBindings* NodeBindings::Create(BrowserEnvironment browser_env) {
   return new NodeBindingsLinux(browser_env);
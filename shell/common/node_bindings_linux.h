@@ -8,6 +8,10 @@
 #include "base/compiler_specific.h"
 #include "shell/common/node_bindings.h"
 
+#if defined(USE_GLIB)
+#include <glib.h>
+#endif
+
 namespace electron {
 
 class NodeBindingsLinux : public NodeBindings {
@@ -22,6 +26,17 @@ class NodeBindingsLinux : public NodeBindings {
   static void OnWatcherQueueChanged(uv_loop_t* loop);
 
   void PollEvents() override;
+  bool WatchBackendFd() override;
+
+#if defined(USE_GLIB)
+  // Called by glib when uv's backend fd becomes readable.
+  static gboolean OnBackendFdReadable(gint fd,
+                                      GIOCondition condition,
+                                      gpointer data);
+
+  // The glib source watching uv's backend fd, when integrated.
+  guint backend_fd_source_ = 0;
+#endif
 
   // Epoll to poll for uv's backend fd.
   int epoll_;
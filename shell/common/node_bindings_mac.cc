@@ -17,7 +17,10 @@ namespace electron {
 NodeBindingsMac::NodeBindingsMac(BrowserEnvironment browser_env)
     : NodeBindings(browser_env) {}
 
-NodeBindingsMac::~NodeBindingsMac() {}
+NodeBindingsMac::~NodeBindingsMac() {
+  if (backend_fd_)
+    CFFileDescriptorInvalidate(backend_fd_);
+}
 
 void NodeBindingsMac::RunMessageLoop() {
   // Get notified when libuv's watcher queue changes.
@@ -57,6 +60,31 @@ void NodeBindingsMac::PollEvents() {
   } while (r == -1 && errno == EINTR);
 }
 
+bool NodeBindingsMac::WatchBackendFd() {
+  CFFileDescriptorContext context = {0, this, nullptr, nullptr, nullptr};
+  backend_fd_.reset(CFFileDescriptorCreate(kCFAllocatorDefault,
+                                           uv_backend_fd(uv_loop_), false,
+                                           OnBackendFdReadable, &context));
+  if (!backend_fd_)
+    return false;
+
+  base::ScopedCFTypeRef<CFRunLoopSourceRef> source(
+      CFFileDescriptorCreateRunLoopSource(kCFAllocatorDefault, backend_fd_, 0));
+  CFRunLoopAddSource(CFRunLoopGetCurrent(), source, kCFRunLoopCommonModes);
+  CFFileDescriptorEnableCallBacks(backend_fd_, kCFFileDescriptorReadCallBack);
+  return true;
+}
+
+// static
+void NodeBindingsMac::OnBackendFdReadable(CFFileDescriptorRef fd,
+                                          CFOptionFlags callback_types,
+                                          void* info) {
+  static_cast<NodeBindingsMac*>(info)->UvRunOnce();
+
+  // The callbacks of a CFFileDescriptor are disabled once they fire.
+  CFFileDescriptorEnableCallBacks(fd, kCFFileDescriptorReadCallBack);
+}
+
 // static
 NodeBindings* NodeBindings::Create(BrowserEnvironment browser_env) {
   return new NodeBindingsMac(browser_env);
@@ -5,7 +5,10 @@
 #ifndef SHELL_COMMON_NODE_BINDINGS_MAC_H_
 #define SHELL_COMMON_NODE_BINDINGS_MAC_H_
 
+#include <CoreFoundation/CoreFoundation.h>
+
 #include "base/compiler_specific.h"
+#include "base/mac/scoped_cftyperef.h"
 #include "shell/common/node_bindings.h"
 
 namespace electron {
@@ -22,6 +25,15 @@ class NodeBindingsMac : public NodeBindings {
   static void OnWatcherQueueChanged(uv_loop_t* loop);
 
   void PollEvents() override;
+  bool WatchBackendFd() override;
+
+  // Called by the run loop when uv's backend fd becomes readable.
+  static void OnBackendFdReadable(CFFileDescriptorRef fd,
+                                  CFOptionFlags callback_types,
+                                  void* info);
+
+  // Watches uv's backend fd on the main run loop, when integrated.
+  base::ScopedCFTypeRef<CFFileDescriptorRef> backend_fd_;
 
   DISALLOW_COPY_AND_ASSIGN(NodeBindingsMac);
 };
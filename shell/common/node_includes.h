@@ -6,6 +6,7 @@
 #define SHELL_COMMON_NODE_INCLUDES_H_
 
 #include "base/logging.h"
+#include "base/trace_event/trace_event.h"
 
 // Include common headers for using node APIs.
 
@@ -70,8 +71,22 @@
 // Alternative to NODE_MODULE_CONTEXT_AWARE_X.
 // Allows to explicitly register builtin modules instead of using
 // __attribute__((constructor)).
-#define NODE_LINKED_MODULE_CONTEXT_AWARE(modname, regfunc) \
-  NODE_MODULE_CONTEXT_AWARE_CPP(modname, regfunc, nullptr, NM_F_LINKED)
+//
+// Modules are initialized when they are first required, and the time spent
+// there, mostly building the templates of their classes, is traced as
+// "electron" events named after the modules.
+#define NODE_LINKED_MODULE_CONTEXT_AWARE(modname, regfunc)                     \
+  namespace {                                                                  \
+  void modname##_traced_initialize(v8::Local<v8::Object> exports,              \
+                                   v8::Local<v8::Value> module,                \
+                                   v8::Local<v8::Context> context,             \
+                                   void* priv) {                               \
+    TRACE_EVENT0("electron", #modname);                                        \
+    regfunc(exports, module, context, priv);                                   \
+  }                                                                            \
+  }                                                                            \
+  NODE_MODULE_CONTEXT_AWARE_CPP(modname, modname##_traced_initialize, nullptr, \
+                                NM_F_LINKED)
 
 #pragma pop_macro("ASSERT")
 #pragma pop_macro("CHECK")
@@ -98,6 +98,9 @@ const char kWebPreferences[] = "webPreferences";
 // Add a vibrancy effect to the browser window
 const char kVibrancyType[] = "vibrancy";
 
+// Notify the resizes of the window at most once per frame.
+const char kCoalesceResizeEvents[] = "coalesceResizeEvents";
+
 // The factor of which page should be zoomed.
 const char kZoomFactor[] = "zoomFactor";
 
@@ -151,12 +154,25 @@ const char kAllowRunningInsecureContent[] = "allowRunningInsecureContent";
 
 const char kOffscreen[] = "offscreen";
 
+// Whether the images of the paint event share the memory of the captured
+// frames.
+const char kOffscreenZeroCopy[] = "offscreenZeroCopy";
+
+// Whether the images of the paint event only contain the repainted area.
+const char kOffscreenOnlyDirty[] = "offscreenOnlyDirty";
+
 const char kNodeIntegrationInSubFrames[] = "nodeIntegrationInSubFrames";
 
 // Disable window resizing when HTML Fullscreen API is activated.
 const char kDisableHtmlFullscreenWindowResize[] =
     "disableHtmlFullscreenWindowResize";
 
+// The parts of backgroundThrottling to apply, an object of booleans.
+const char kBackgroundThrottlingPolicy[] = "backgroundThrottlingPolicy";
+
+// The heap limits and GC mode of V8 in the renderer process.
+const char kV8HeapPolicy[] = "v8HeapPolicy";
+
 // Enables JavaScript support.
 const char kJavaScript[] = "javascript";
 
@@ -224,8 +240,22 @@ const char kAppUserModelId[] = "app-user-model-id";
 // The application path
 const char kAppPath[] = "app-path";
 
+// The directory of the asar extraction cache.
+const char kAsarCacheDir[] = "asar-cache-dir";
+
 const char kEnableApiFilteringLogging[] = "enable-api-filtering-logging";
 
+// Runs the libuv loop of the main process from the UI message pump instead of
+// polling it from a separate thread.
+const char kEnableIntegratedUvLoop[] = "enable-integrated-uv-loop";
+
+// Sizes the libuv threadpool of the main process, or to the number of cores
+// when it is "auto".
+const char kUvThreadpoolSize[] = "uv-threadpool-size";
+
+// Holds the non-critical startup tasks until the first window has painted.
+const char kEnableDeferredStartup[] = "enable-deferred-startup";
+
 // The command line switch versions of the options.
 const char kBackgroundColor[] = "background-color";
 const char kPreloadScript[] = "preload";
@@ -249,6 +279,13 @@ const char kNodeIntegrationInWorker[] = "node-integration-in-worker";
 // environments will be created in sub-frames.
 const char kNodeIntegrationInSubFrames[] = "node-integration-in-subframes";
 
+// Set once a Chrome extension has content scripts for all frames, which are
+// injected by the Electron APIs of the sub frames.
+const char kContentScriptsInSubFrames[] = "content-scripts-in-subframes";
+
+// Tells the pages of the renderer process when V8 is near its heap limit.
+const char kNearHeapLimitEvent[] = "near-heap-limit-event";
+
 // Widevine options
 // Path to Widevine CDM binaries.
 const char kWidevineCdmPath[] = "widevine-cdm-path";
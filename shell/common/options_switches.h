@@ -54,6 +54,7 @@ extern const char kOpacity[];
 extern const char kFocusable[];
 extern const char kWebPreferences[];
 extern const char kVibrancyType[];
+extern const char kCoalesceResizeEvents[];
 
 // WebPreferences.
 extern const char kZoomFactor[];
@@ -76,8 +77,12 @@ extern const char kSandbox[];
 extern const char kWebSecurity[];
 extern const char kAllowRunningInsecureContent[];
 extern const char kOffscreen[];
+extern const char kOffscreenZeroCopy[];
+extern const char kOffscreenOnlyDirty[];
 extern const char kNodeIntegrationInSubFrames[];
 extern const char kDisableHtmlFullscreenWindowResize[];
+extern const char kBackgroundThrottlingPolicy[];
+extern const char kV8HeapPolicy[];
 extern const char kJavaScript[];
 extern const char kImages[];
 extern const char kTextAreasAreResizable[];
@@ -111,7 +116,11 @@ extern const char kFetchSchemes[];
 extern const char kCORSSchemes[];
 extern const char kAppUserModelId[];
 extern const char kAppPath[];
+extern const char kAsarCacheDir[];
 extern const char kEnableApiFilteringLogging[];
+extern const char kEnableIntegratedUvLoop[];
+extern const char kUvThreadpoolSize[];
+extern const char kEnableDeferredStartup[];
 
 extern const char kBackgroundColor[];
 extern const char kPreloadScript[];
@@ -126,6 +135,8 @@ extern const char kNativeWindowOpen[];
 extern const char kNodeIntegrationInWorker[];
 extern const char kWebviewTag[];
 extern const char kNodeIntegrationInSubFrames[];
+extern const char kContentScriptsInSubFrames[];
+extern const char kNearHeapLimitEvent[];
 extern const char kDisableElectronSiteInstanceOverrides[];
 extern const char kEnableNodeLeakageInRenderers[];
 
@@ -6,6 +6,7 @@
 #define SHELL_COMMON_PLATFORM_UTIL_H_
 
 #include <string>
+#include <vector>
 
 #include "base/callback_forward.h"
 #include "base/files/file_path.h"
@@ -43,6 +44,12 @@ void OpenExternal(const GURL& url,
 // Move a file to trash.
 bool MoveItemToTrash(const base::FilePath& full_path, bool delete_on_fail);
 
+// Moves the files to trash with as few calls to the OS as it allows, and
+// returns whether each of them was moved. Blocks, so it must be called from a
+// thread which may block.
+std::vector<bool> MoveItemsToTrash(const std::vector<base::FilePath>& paths,
+                                   bool delete_on_fail);
+
 void Beep();
 
 #if defined(OS_MACOSX)
@@ -6,12 +6,17 @@
 
 #include <stdio.h>
 
+#include <algorithm>
+
+#include "base/bind.h"
 #include "base/cancelable_callback.h"
 #include "base/environment.h"
 #include "base/files/file_util.h"
 #include "base/nix/xdg_util.h"
 #include "base/process/kill.h"
 #include "base/process/launch.h"
+#include "base/task/post_task.h"
+#include "base/threading/scoped_blocking_call.h"
 #include "chrome/browser/ui/libgtkui/gtk_util.h"
 #include "url/gurl.h"
 
@@ -73,6 +78,57 @@ bool XDGEmail(const std::string& email, const bool wait_for_exit) {
                  platform_util::OpenCallback());
 }
 
+// How many files are passed to one run of the trash tool, which keeps its
+// command line short.
+const size_t kMaxTrashBatchSize = 256;
+
+std::vector<std::string> GetTrashCommand(
+    const std::vector<std::string>& filenames) {
+  std::unique_ptr<base::Environment> env(base::Environment::Create());
+
+  // find the trash method
+  std::string trash;
+  if (!env->GetVar(ELECTRON_TRASH, &trash)) {
+    // Determine desktop environment and set accordingly.
+    const auto desktop_env(base::nix::GetDesktopEnvironment(env.get()));
+    if (desktop_env == base::nix::DESKTOP_ENVIRONMENT_KDE4 ||
+        desktop_env == base::nix::DESKTOP_ENVIRONMENT_KDE5) {
+      trash = "kioclient5";
+    } else if (desktop_env == base::nix::DESKTOP_ENVIRONMENT_KDE3) {
+      trash = "kioclient";
+    }
+  }
+
+  // build the invocation
+  std::vector<std::string> argv;
+  if (trash == "kioclient5" || trash == "kioclient") {
+    argv = {trash, "move"};
+  } else if (trash == "trash-cli") {
+    argv = {"trash-put"};
+  } else if (trash == "gvfs-trash") {
+    argv = {"gvfs-trash"};  // deprecated, but still exists
+  } else {
+    argv = {"gio", "trash"};
+  }
+  argv.insert(argv.end(), filenames.begin(), filenames.end());
+  if (trash == "kioclient5" || trash == "kioclient")
+    argv.push_back("trash:/");
+  return argv;
+}
+
+std::string OpenPathOnThread(const base::FilePath& full_path) {
+  std::string error;
+  bool opened = XDGOpen(full_path.value(), true,
+                        base::BindOnce(
+                            [](std::string* out, const std::string& result) {
+                              *out = result;
+                            },
+                            base::Unretained(&error)));
+  if (!opened && error.empty())
+    return "Failed to open path";
+  return error;
+}
+
 }  // namespace
 
 namespace platform_util {
@@ -86,8 +142,12 @@ void ShowItemInFolder(const base::FilePath& full_path) {
 }
 
 void OpenPath(const base::FilePath& full_path, OpenCallback callback) {
-  // This is async, so we don't care about the return value.
-  XDGOpen(full_path.value(), true, std::move(callback));
+  // xdg-open is waited for, which must not block the calling thread.
+  base::PostTaskAndReplyWithResult(
+      FROM_HERE,
+      {base::ThreadPool(), base::MayBlock(), base::WithBaseSyncPrimitives(),
+       base::TaskPriority::USER_BLOCKING},
+      base::BindOnce(&OpenPathOnThread, full_path), std::move(callback));
 }
 
 void OpenExternal(const GURL& url,
@@ -105,35 +165,35 @@ void OpenExternal(const GURL& url,
 }
 
 bool MoveItemToTrash(const base::FilePath& full_path, bool delete_on_fail) {
-  std::unique_ptr<base::Environment> env(base::Environment::Create());
+  return XDGUtil(GetTrashCommand({full_path.value()}), true,
+                 platform_util::OpenCallback());
+}
 
-  // find the trash method
-  std::string trash;
-  if (!env->GetVar(ELECTRON_TRASH, &trash)) {
-    // Determine desktop environment and set accordingly.
-    const auto desktop_env(base::nix::GetDesktopEnvironment(env.get()));
-    if (desktop_env == base::nix::DESKTOP_ENVIRONMENT_KDE4 ||
-        desktop_env == base::nix::DESKTOP_ENVIRONMENT_KDE5) {
-      trash = "kioclient5";
-    } else if (desktop_env == base::nix::DESKTOP_ENVIRONMENT_KDE3) {
-      trash = "kioclient";
+std::vector<bool> MoveItemsToTrash(const std::vector<base::FilePath>& paths,
+                                   bool delete_on_fail) {
+  base::ScopedBlockingCall scoped_blocking_call(FROM_HERE,
+                                                base::BlockingType::MAY_BLOCK);
+  std::vector<bool> existed(paths.size());
+  for (size_t i = 0; i < paths.size(); ++i)
+    existed[i] = base::PathExists(paths[i]);
+
+  // The trash tools take many files, but fail as a whole, so which files were
+  // moved is found out afterwards.
+  for (size_t begin = 0; begin < paths.size(); begin += kMaxTrashBatchSize) {
+    size_t end = std::min(begin + kMaxTrashBatchSize, paths.size());
+    std::vector<std::string> filenames;
+    for (size_t i = begin; i < end; ++i) {
+      if (existed[i])
+        filenames.push_back(paths[i].value());
     }
+    if (!filenames.empty())
+      XDGUtil(GetTrashCommand(filenames), true, platform_util::OpenCallback());
   }
 
-  // build the invocation
-  std::vector<std::string> argv;
-  const auto& filename = full_path.value();
-  if (trash == "kioclient5" || trash == "kioclient") {
-    argv = {trash, "move", filename, "trash:/"};
-  } else if (trash == "trash-cli") {
-    argv = {"trash-put", filename};
-  } else if (trash == "gvfs-trash") {
-    argv = {"gvfs-trash", filename};  // deprecated, but still exists
-  } else {
-    argv = {"gio", "trash", filename};
-  }
-
-  return XDGUtil(argv, true, platform_util::OpenCallback());
+  std::vector<bool> trashed(paths.size());
+  for (size_t i = 0; i < paths.size(); ++i)
+    trashed[i] = existed[i] && !base::PathExists(paths[i]);
+  return trashed;
 }
 
 void Beep() {
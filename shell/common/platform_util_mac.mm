@@ -18,8 +18,10 @@
 #include "base/mac/foundation_util.h"
 #include "base/mac/mac_logging.h"
 #include "base/mac/scoped_aedesc.h"
+#include "base/mac/scoped_nsautorelease_pool.h"
 #include "base/strings/stringprintf.h"
 #include "base/strings/sys_string_conversions.h"
+#include "base/threading/scoped_blocking_call.h"
 #include "net/base/mac/url_conversions.h"
 #include "url/gurl.h"
 
@@ -148,6 +150,20 @@ bool MoveItemToTrash(const base::FilePath& full_path, bool delete_on_fail) {
   return did_trash;
 }
 
+std::vector<bool> MoveItemsToTrash(const std::vector<base::FilePath>& paths,
+                                   bool delete_on_fail) {
+  base::ScopedBlockingCall scoped_blocking_call(FROM_HERE,
+                                                base::BlockingType::MAY_BLOCK);
+  // NSFileManager has no call for many items, but it is thread safe, so the
+  // items are at least moved off the main thread.
+  base::mac::ScopedNSAutoreleasePool pool;
+  std::vector<bool> trashed;
+  trashed.reserve(paths.size());
+  for (const auto& path : paths)
+    trashed.push_back(MoveItemToTrash(path, delete_on_fail));
+  return trashed;
+}
+
 void Beep() {
   NSBeep();
 }
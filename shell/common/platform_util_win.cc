@@ -312,6 +312,54 @@ std::string OpenPathOnThread(const base::FilePath& full_path) {
   return success ? "" : "Failed to open path";
 }
 
+// Deletes |paths| to the Recycle Bin in one operation, on a thread which
+// initialized COM.
+bool PerformTrashOperation(const std::vector<base::FilePath>& paths) {
+  Microsoft::WRL::ComPtr<IFileOperation> pfo;
+  if (FAILED(::CoCreateInstance(CLSID_FileOperation, nullptr, CLSCTX_ALL,
+                                IID_PPV_ARGS(&pfo))))
+    return false;
+
+  // Elevation prompt enabled for UAC protected files.  This overrides the
+  // SILENT, NO_UI and NOERRORUI flags.
+
+  if (base::win::GetVersion() >= base::win::Version::WIN8) {
+    // Windows 8 introduces the flag RECYCLEONDELETE and deprecates the
+    // ALLOWUNDO in favor of ADDUNDORECORD.
+    if (FAILED(pfo->SetOperationFlags(
+            FOF_NO_UI | FOFX_ADDUNDORECORD | FOF_NOERRORUI | FOF_SILENT |
+            FOFX_SHOWELEVATIONPROMPT | FOFX_RECYCLEONDELETE)))
+      return false;
+  } else {
+    // For Windows 7 and Vista, RecycleOnDelete is the default behavior.
+    if (FAILED(pfo->SetOperationFlags(FOF_NO_UI | FOF_ALLOWUNDO |
+                                      FOF_NOERRORUI | FOF_SILENT |
+                                      FOFX_SHOWELEVATIONPROMPT)))
+      return false;
+  }
+
+  Microsoft::WRL::ComPtr<IFileOperationProgressSink> delete_sink(
+      new DeleteFileProgressSink);
+  if (!delete_sink)
+    return false;
+
+  bool queued = false;
+  for (const auto& path : paths) {
+    // Create an IShellItem from the supplied source path.
+    Microsoft::WRL::ComPtr<IShellItem> delete_item;
+    if (FAILED(SHCreateItemFromParsingName(
+            path.value().c_str(), NULL,
+            IID_PPV_ARGS(delete_item.GetAddressOf()))))
+      continue;
+    // Queues the command DeleteItem. This will trigger the
+    // DeleteFileProgressSink to check for Recycle Bin.
+    if (SUCCEEDED(pfo->DeleteItem(delete_item.Get(), delete_sink.Get())))
+      queued = true;
+  }
+
+  return queued && SUCCEEDED(pfo->PerformOperations());
+}
+
 }  // namespace
 
 namespace platform_util {
@@ -349,46 +397,34 @@ bool MoveItemToTrash(const base::FilePath& path, bool delete_on_fail) {
   base::win::ScopedCOMInitializer com_initializer;
   if (!com_initializer.Succeeded())
     return false;
+  return PerformTrashOperation({path});
+}
 
-  Microsoft::WRL::ComPtr<IFileOperation> pfo;
-  if (FAILED(::CoCreateInstance(CLSID_FileOperation, nullptr, CLSCTX_ALL,
-                                IID_PPV_ARGS(&pfo))))
-    return false;
-
-  // Elevation prompt enabled for UAC protected files.  This overrides the
-  // SILENT, NO_UI and NOERRORUI flags.
-
-  if (base::win::GetVersion() >= base::win::Version::WIN8) {
-    // Windows 8 introduces the flag RECYCLEONDELETE and deprecates the
-    // ALLOWUNDO in favor of ADDUNDORECORD.
-    if (FAILED(pfo->SetOperationFlags(
-            FOF_NO_UI | FOFX_ADDUNDORECORD | FOF_NOERRORUI | FOF_SILENT |
-            FOFX_SHOWELEVATIONPROMPT | FOFX_RECYCLEONDELETE)))
-      return false;
-  } else {
-    // For Windows 7 and Vista, RecycleOnDelete is the default behavior.
-    if (FAILED(pfo->SetOperationFlags(FOF_NO_UI | FOF_ALLOWUNDO |
-                                      FOF_NOERRORUI | FOF_SILENT |
-                                      FOFX_SHOWELEVATIONPROMPT)))
-      return false;
+std::vector<bool> MoveItemsToTrash(const std::vector<base::FilePath>& paths,
+                                   bool delete_on_fail) {
+  base::ScopedBlockingCall scoped_blocking_call(FROM_HERE,
+                                                base::BlockingType::MAY_BLOCK);
+  std::vector<bool> trashed(paths.size(), false);
+  base::win::ScopedCOMInitializer com_initializer;
+  if (!com_initializer.Succeeded())
+    return trashed;
+
+  std::vector<bool> existed(paths.size());
+  for (size_t i = 0; i < paths.size(); ++i)
+    existed[i] = base::PathExists(paths[i]);
+
+  if (!PerformTrashOperation(paths) && paths.size() > 1) {
+    // An item which cannot be recycled aborts the items queued after it, so
+    // those which are left are trashed one by one.
+    for (size_t i = 0; i < paths.size(); ++i) {
+      if (existed[i] && base::PathExists(paths[i]))
+        PerformTrashOperation({paths[i]});
+    }
   }
 
-  // Create an IShellItem from the supplied source path.
-  Microsoft::WRL::ComPtr<IShellItem> delete_item;
-  if (FAILED(SHCreateItemFromParsingName(
-          path.value().c_str(), NULL,
-          IID_PPV_ARGS(delete_item.GetAddressOf()))))
-    return false;
-
-  Microsoft::WRL::ComPtr<IFileOperationProgressSink> delete_sink(
-      new DeleteFileProgressSink);
-  if (!delete_sink)
-    return false;
-
-  // Processes the queued command DeleteItem. This will trigger
-  // the DeleteFileProgressSink to check for Recycle Bin.
-  return SUCCEEDED(pfo->DeleteItem(delete_item.Get(), delete_sink.Get())) &&
-         SUCCEEDED(pfo->PerformOperations());
+  for (size_t i = 0; i < paths.size(); ++i)
+    trashed[i] = existed[i] && !base::PathExists(paths[i]);
+  return trashed;
 }
 
 void Beep() {
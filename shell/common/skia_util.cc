@@ -12,6 +12,7 @@
 #include "shell/common/asar/asar_util.h"
 #include "shell/common/node_includes.h"
 #include "shell/common/skia_util.h"
+#include "third_party/libwebp/src/webp/decode.h"
 #include "third_party/skia/include/core/SkBitmap.h"
 #include "third_party/skia/include/core/SkImageInfo.h"
 #include "third_party/skia/include/core/SkPixelRef.h"
@@ -89,6 +90,40 @@ bool AddImageSkiaRepFromJPEG(gfx::ImageSkia* image,
   return true;
 }
 
+bool AddImageSkiaRepFromWebP(gfx::ImageSkia* image,
+                             const unsigned char* data,
+                             size_t size,
+                             double scale_factor) {
+  WebPDecoderConfig config;
+  if (!WebPInitDecoderConfig(&config) ||
+      WebPGetFeatures(data, size, &config.input) != VP8_STATUS_OK)
+    return false;
+  // Only the still images are decoded.
+  if (config.input.has_animation)
+    return false;
+
+  SkBitmap bitmap;
+  if (!bitmap.tryAllocN32Pixels(config.input.width, config.input.height,
+                                !config.input.has_alpha))
+    return false;
+
+  // Decode straight into the premultiplied pixels of the bitmap.
+#if SK_B32_SHIFT
+  config.output.colorspace = MODE_rgbA;
+#else
+  config.output.colorspace = MODE_bgrA;
+#endif
+  config.output.is_external_memory = 1;
+  config.output.u.RGBA.rgba = static_cast<uint8_t*>(bitmap.getPixels());
+  config.output.u.RGBA.stride = bitmap.rowBytes();
+  config.output.u.RGBA.size = bitmap.computeByteSize();
+  if (WebPDecode(data, size, &config) != VP8_STATUS_OK)
+    return false;
+
+  image->AddRepresentation(gfx::ImageSkiaRep(bitmap, scale_factor));
+  return true;
+}
+
 bool AddImageSkiaRepFromBuffer(gfx::ImageSkia* image,
                                const unsigned char* data,
                                size_t size,
@@ -103,6 +138,10 @@ bool AddImageSkiaRepFromBuffer(gfx::ImageSkia* image,
   if (AddImageSkiaRepFromJPEG(image, data, size, scale_factor))
     return true;
 
+  // Then WebP.
+  if (AddImageSkiaRepFromWebP(image, data, size, scale_factor))
+    return true;
+
   if (width == 0 || height == 0)
     return false;
 
@@ -33,6 +33,11 @@ bool AddImageSkiaRepFromPNG(gfx::ImageSkia* image,
                             size_t size,
                             double scale_factor);
 
+bool AddImageSkiaRepFromWebP(gfx::ImageSkia* image,
+                             const unsigned char* data,
+                             size_t size,
+                             double scale_factor);
+
 #if defined(OS_WIN)
 bool ReadImageSkiaFromICO(gfx::ImageSkia* image, HICON icon);
 #endif
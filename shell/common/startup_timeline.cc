@@ -0,0 +1,88 @@
+// Copyright (c) 2020 GitHub, Inc.
+// Use of this source code is governed by the MIT license that can be
+// found in the LICENSE file.
+
+#include "shell/common/startup_timeline.h"
+
+#include <set>
+
+#include "base/lazy_instance.h"
+#include "base/synchronization/lock.h"
+
+namespace electron {
+
+namespace {
+
+struct Phase {
+  std::string name;
+  base::TimeTicks start;
+  base::TimeTicks end;
+};
+
+struct StartupTimeline {
+  base::Lock lock;
+  std::vector<Phase> phases;
+  std::set<std::string> names;
+};
+
+base::LazyInstance<StartupTimeline>::Leaky g_timeline =
+    LAZY_INSTANCE_INITIALIZER;
+
+}  // namespace
+
+void BeginStartupPhase(const std::string& name) {
+  base::TimeTicks now = base::TimeTicks::Now();
+  StartupTimeline& timeline = g_timeline.Get();
+  base::AutoLock auto_lock(timeline.lock);
+  if (timeline.names.insert(name).second)
+    timeline.phases.push_back({name, now, base::TimeTicks()});
+}
+
+void EndStartupPhase(const std::string& name) {
+  base::TimeTicks now = base::TimeTicks::Now();
+  StartupTimeline& timeline = g_timeline.Get();
+  base::AutoLock auto_lock(timeline.lock);
+  for (auto& phase : timeline.phases) {
+    if (phase.name == name) {
+      if (phase.end.is_null())
+        phase.end = now;
+      return;
+    }
+  }
+}
+
+void MarkStartupPhase(const std::string& name) {
+  base::TimeTicks now = base::TimeTicks::Now();
+  StartupTimeline& timeline = g_timeline.Get();
+  base::AutoLock auto_lock(timeline.lock);
+  if (timeline.names.insert(name).second)
+    timeline.phases.push_back({name, now, now});
+}
+
+std::vector<StartupPhase> GetStartupTimeline() {
+  // The phases are recorded in ticks, which do not jump with the clock, and
+  // are reported in wall time to be comparable across processes.
+  base::Time now = base::Time::Now();
+  base::TimeTicks now_ticks = base::TimeTicks::Now();
+
+  std::vector<StartupPhase> result;
+  StartupTimeline& timeline = g_timeline.Get();
+  base::AutoLock auto_lock(timeline.lock);
+  for (const auto& phase : timeline.phases) {
+    if (phase.end.is_null())
+      continue;
+    result.push_back({phase.name, now - (now_ticks - phase.start),
+                      phase.end - phase.start});
+  }
+  return result;
+}
+
+ScopedStartupPhase::ScopedStartupPhase(const char* name) : name_(name) {
+  BeginStartupPhase(name_);
+}
+
+ScopedStartupPhase::~ScopedStartupPhase() {
+  EndStartupPhase(name_);
+}
+
+}  // namespace electron
@@ -0,0 +1,56 @@
+// Copyright (c) 2020 GitHub, Inc.
+// Use of this source code is governed by the MIT license that can be
+// found in the LICENSE file.
+
+#ifndef SHELL_COMMON_STARTUP_TIMELINE_H_
+#define SHELL_COMMON_STARTUP_TIMELINE_H_
+
+#include <string>
+#include <vector>
+
+#include "base/macros.h"
+#include "base/time/time.h"
+
+namespace electron {
+
+// The startup timeline records when the named phases of starting this process
+// began and how long they took, so that launch time can be broken down in
+// shipped builds without running a trace.
+//
+// Only the first occurrence of a phase is recorded, so phases that repeat,
+// like the creation of script contexts, describe the first one.
+
+struct StartupPhase {
+  std::string name;
+  base::Time start;
+  base::TimeDelta duration;
+};
+
+// Records the beginning of the phase |name|.
+void BeginStartupPhase(const std::string& name);
+
+// Records the end of the phase |name|, if it was begun.
+void EndStartupPhase(const std::string& name);
+
+// Records the instant phase |name|, whose duration is zero.
+void MarkStartupPhase(const std::string& name);
+
+// Returns the recorded phases, in the order they began. Phases that have not
+// ended yet are not included.
+std::vector<StartupPhase> GetStartupTimeline();
+
+// Records the phase |name| for the lifetime of the object.
+class ScopedStartupPhase {
+ public:
+  explicit ScopedStartupPhase(const char* name);
+  ~ScopedStartupPhase();
+
+ private:
+  const char* name_;
+
+  DISALLOW_COPY_AND_ASSIGN(ScopedStartupPhase);
+};
+
+}  // namespace electron
+
+#endif  // SHELL_COMMON_STARTUP_TIMELINE_H_
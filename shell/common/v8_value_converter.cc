@@ -4,12 +4,13 @@
 
 #include "shell/common/v8_value_converter.h"
 
-#include <map>
+#include <algorithm>
 #include <memory>
 #include <string>
 #include <utility>
 #include <vector>
 
+#include "base/containers/span.h"
 #include "base/values.h"
 #include "shell/common/gin_helper/dictionary.h"
 #include "shell/common/node_bindings.h"
@@ -19,110 +20,86 @@ namespace electron {
 
 namespace {
 
-const int kMaxRecursionDepth = 100;
+const int kDefaultMaxRecursionDepth = 100;
+
+// Reserving more than this for a container is left to the container growing,
+// since the length of sparse arrays does not say how much they hold.
+const uint32_t kMaxReservedLength = 1024 * 1024;
+
+std::string V8ToUTF8(v8::Isolate* isolate, v8::Local<v8::Value> value) {
+  v8::Local<v8::String> str;
+  if (!value->ToString(isolate->GetCurrentContext()).ToLocal(&str))
+    return std::string();
+  // Written straight into the result, without going through a temporary
+  // buffer like v8::String::Utf8Value does.
+  std::string result(str->Utf8Length(isolate), '\0');
+  str->WriteUtf8(isolate, &result[0], result.size(), nullptr,
+                 v8::String::NO_NULL_TERMINATION);
+  return result;
+}
 
 }  // namespace
 
-// The state of a call to FromV8Value.
+// The state of a call to FromV8Value, which converts the arrays and objects
+// nested in the value with an explicit stack rather than by recursing.
 class V8ValueConverter::FromV8ValueState {
  public:
-  // Level scope which updates the current depth of some FromV8ValueState.
-  class Level {
-   public:
-    explicit Level(FromV8ValueState* state) : state_(state) {
-      state_->max_recursion_depth_--;
-    }
-    ~Level() { state_->max_recursion_depth_++; }
-
-   private:
-    FromV8ValueState* state_;
+  // An array or object being converted, and the children converted so far.
+  struct Frame {
+    Frame(v8::Local<v8::Object> object, bool is_array)
+        : object(object), hash(object->GetIdentityHash()), is_array(is_array) {}
+    Frame(Frame&&) = default;
+    ~Frame() = default;
+    Frame& operator=(Frame&&) = default;
+
+    v8::Local<v8::Object> object;
+    int hash;
+    bool is_array;
+    // Set when |object| was created in another context than the current one,
+    // that context is entered while |object| is converted.
+    v8::Local<v8::Context> entered_context;
+    // The own property names of objects.
+    v8::Local<v8::Array> keys;
+    uint32_t length = 0;
+    // The next element or key to convert.
+    uint32_t index = 0;
+    // The key of the property being converted, for objects.
+    std::string key;
+    base::Value::ListStorage list;
+    std::vector<std::pair<std::string, std::unique_ptr<base::Value>>> dict;
+
+    DISALLOW_COPY_AND_ASSIGN(Frame);
   };
 
-  FromV8ValueState() : max_recursion_depth_(kMaxRecursionDepth) {}
+  FromV8ValueState() = default;
 
-  // If |handle| is not in |unique_map_|, then add it to |unique_map_| and
-  // return true.
+  // Returns true if |object| is an array or object being converted, in which
+  // case converting it again would be a cycle.
   //
-  // Otherwise do nothing and return false. Here "A is unique" means that no
-  // other handle B in the map points to the same object as A. Note that A can
-  // be unique even if there already is another handle with the same identity
-  // hash (key) in the map, because two objects can have the same hash.
-  bool AddToUniquenessCheck(v8::Local<v8::Object> handle) {
-    int hash;
-    auto iter = GetIteratorInMap(handle, &hash);
-    if (iter != unique_map_.end())
-      return false;
-
-    unique_map_.insert(std::make_pair(hash, handle));
-    return true;
-  }
-
-  bool RemoveFromUniquenessCheck(v8::Local<v8::Object> handle) {
-    int unused_hash;
-    auto iter = GetIteratorInMap(handle, &unused_hash);
-    if (iter == unique_map_.end())
-      return false;
-    unique_map_.erase(iter);
-    return true;
-  }
-
-  bool HasReachedMaxRecursionDepth() { return max_recursion_depth_ < 0; }
-
- private:
-  using HashToHandleMap = std::multimap<int, v8::Local<v8::Object>>;
-  using Iterator = HashToHandleMap::const_iterator;
-
-  Iterator GetIteratorInMap(v8::Local<v8::Object> handle, int* hash) {
-    *hash = handle->GetIdentityHash();
-    // We only compare using == with handles to objects with the same identity
-    // hash. Different hash obviously means different objects, but two objects
-    // in a couple of thousands could have the same identity hash.
-    std::pair<Iterator, Iterator> range = unique_map_.equal_range(*hash);
-    for (auto it = range.first; it != range.second; ++it) {
-      // Operator == for handles actually compares the underlying objects.
-      if (it->second == handle)
-        return it;
-    }
-    // Not found.
-    return unique_map_.end();
-  }
-
-  HashToHandleMap unique_map_;
-
-  int max_recursion_depth_;
-};
-
-// A class to ensure that objects/arrays that are being converted by
-// this V8ValueConverterImpl do not have cycles.
-//
-// An example of cycle: var v = {}; v = {key: v};
-// Not an example of cycle: var v = {}; a = [v, v]; or w = {a: v, b: v};
-class V8ValueConverter::ScopedUniquenessGuard {
- public:
-  ScopedUniquenessGuard(V8ValueConverter::FromV8ValueState* state,
-                        v8::Local<v8::Object> value)
-      : state_(state),
-        value_(value),
-        is_valid_(state_->AddToUniquenessCheck(value_)) {}
-  ~ScopedUniquenessGuard() {
-    if (is_valid_) {
-      bool removed = state_->RemoveFromUniquenessCheck(value_);
-      DCHECK(removed);
+  // An example of cycle: var v = {}; v = {key: v};
+  // Not an example of cycle: var v = {}; a = [v, v]; or w = {a: v, b: v};
+  //
+  // Only the frames are looked at, and they are at most as many as the
+  // maximum depth, so this does not need a map of the objects.
+  bool IsConverting(v8::Local<v8::Object> object) const {
+    int hash = object->GetIdentityHash();
+    for (const Frame& frame : frames) {
+      // Operator == for handles actually compares the underlying objects, but
+      // comparing the identity hashes first is cheaper.
+      if (frame.hash == hash && frame.object == object)
+        return true;
     }
+    return false;
   }
 
-  bool is_valid() const { return is_valid_; }
+  std::vector<Frame> frames;
 
  private:
-  typedef std::multimap<int, v8::Local<v8::Object>> HashToHandleMap;
-  V8ValueConverter::FromV8ValueState* state_;
-  v8::Local<v8::Object> value_;
-  bool is_valid_;
-
-  DISALLOW_COPY_AND_ASSIGN(ScopedUniquenessGuard);
+  DISALLOW_COPY_AND_ASSIGN(FromV8ValueState);
 };
 
-V8ValueConverter::V8ValueConverter() = default;
+V8ValueConverter::V8ValueConverter()
+    : max_recursion_depth_(kDefaultMaxRecursionDepth) {}
 
 void V8ValueConverter::SetRegExpAllowed(bool val) {
   reg_exp_allowed_ = val;
@@ -136,6 +113,10 @@ void V8ValueConverter::SetStripNullFromObjects(bool val) {
   strip_null_from_objects_ = val;
 }
 
+void V8ValueConverter::SetMaxRecursionDepth(int depth) {
+  max_recursion_depth_ = depth;
+}
+
 v8::Local<v8::Value> V8ValueConverter::ToV8Value(
     const base::Value* value,
     v8::Local<v8::Context> context) const {
@@ -147,10 +128,69 @@ v8::Local<v8::Value> V8ValueConverter::ToV8Value(
 std::unique_ptr<base::Value> V8ValueConverter::FromV8Value(
     v8::Local<v8::Value> val,
     v8::Local<v8::Context> context) const {
+  v8::Isolate* isolate = context->GetIsolate();
   v8::Context::Scope context_scope(context);
-  v8::HandleScope handle_scope(context->GetIsolate());
+  v8::HandleScope handle_scope(isolate);
+
   FromV8ValueState state;
-  return FromV8ValueImpl(&state, val, context->GetIsolate());
+  base::Value value;
+  FromV8Result result = FromV8ValueImpl(&state, val, isolate, &value);
+  while (!state.frames.empty()) {
+    FromV8ValueState::Frame& frame = state.frames.back();
+    // Otherwise |result| is for the previous child of |frame|.
+    if (result != FromV8Result::kPushed)
+      AddToFrame(&state, result == FromV8Result::kConverted ? &value : nullptr);
+
+    if (frame.index == frame.length) {
+      value = PopFrame(&state);
+      result = FromV8Result::kConverted;
+      continue;
+    }
+
+    uint32_t index = frame.index++;
+    v8::Local<v8::Context> current_context = isolate->GetCurrentContext();
+    v8::Local<v8::Value> child;
+    if (frame.is_array) {
+      // Only fields with integer keys are carried over to the ListValue.
+      v8::TryCatch try_catch(isolate);
+      if (!frame.object->Get(current_context, index).ToLocal(&child) ||
+          try_catch.HasCaught()) {
+        LOG(ERROR) << "Getter for index " << index << " threw an exception.";
+        child = v8::Null(isolate);
+      }
+      if (!frame.object->HasRealIndexedProperty(current_context, index)
+               .FromMaybe(false)) {
+        value = base::Value();
+        result = FromV8Result::kConverted;
+        continue;
+      }
+    } else {
+      v8::Local<v8::Value> key =
+          frame.keys->Get(current_context, index).ToLocalChecked();
+      // Extend this test to cover more types as necessary and if sensible.
+      if (!key->IsString() && !key->IsNumber()) {
+        NOTREACHED() << "Key \"" << *v8::String::Utf8Value(isolate, key)
+                     << "\" "
+                        "is neither a string nor a number";
+        result = FromV8Result::kSkipped;
+        continue;
+      }
+      frame.key = V8ToUTF8(isolate, key);
+
+      v8::TryCatch try_catch(isolate);
+      if (!frame.object->Get(current_context, key).ToLocal(&child) ||
+          try_catch.HasCaught()) {
+        LOG(ERROR) << "Getter for property " << frame.key
+                   << " threw an exception.";
+        child = v8::Null(isolate);
+      }
+    }
+    result = FromV8ValueImpl(&state, child, isolate, &value);
+  }
+
+  if (result == FromV8Result::kSkipped)
+    return nullptr;
+  return std::make_unique<base::Value>(std::move(value));
 }
 
 v8::Local<v8::Value> V8ValueConverter::ToV8ValueImpl(
@@ -288,43 +328,48 @@ v8::Local<v8::Value> V8ValueConverter::ToArrayBuffer(
   return v8::Uint8Array::New(array_buffer, 0, length);
 }
 
-std::unique_ptr<base::Value> V8ValueConverter::FromV8ValueImpl(
+V8ValueConverter::FromV8Result V8ValueConverter::FromV8ValueImpl(
     FromV8ValueState* state,
     v8::Local<v8::Value> val,
-    v8::Isolate* isolate) const {
-  FromV8ValueState::Level state_level(state);
-  if (state->HasReachedMaxRecursionDepth())
-    return nullptr;
-
-  if (val->IsExternal())
-    return std::make_unique<base::Value>();
-
-  if (val->IsNull())
-    return std::make_unique<base::Value>();
+    v8::Isolate* isolate,
+    base::Value* out) const {
+  // |val| is one level deeper than the innermost frame.
+  if (static_cast<int>(state->frames.size()) >= max_recursion_depth_)
+    return FromV8Result::kSkipped;
+
+  if (val->IsExternal() || val->IsNull()) {
+    *out = base::Value();
+    return FromV8Result::kConverted;
+  }
 
   auto context = isolate->GetCurrentContext();
 
-  if (val->IsBoolean())
-    return std::make_unique<base::Value>(val->ToBoolean(isolate)->Value());
+  if (val->IsBoolean()) {
+    *out = base::Value(val->ToBoolean(isolate)->Value());
+    return FromV8Result::kConverted;
+  }
 
-  if (val->IsInt32())
-    return std::make_unique<base::Value>(val.As<v8::Int32>()->Value());
+  if (val->IsInt32()) {
+    *out = base::Value(val.As<v8::Int32>()->Value());
+    return FromV8Result::kConverted;
+  }
 
   if (val->IsNumber()) {
     double val_as_double = val.As<v8::Number>()->Value();
     if (!std::isfinite(val_as_double))
-      return nullptr;
-    return std::make_unique<base::Value>(val_as_double);
+      return FromV8Result::kSkipped;
+    *out = base::Value(val_as_double);
+    return FromV8Result::kConverted;
   }
 
   if (val->IsString()) {
-    v8::String::Utf8Value utf8(isolate, val);
-    return std::make_unique<base::Value>(std::string(*utf8, utf8.length()));
+    *out = base::Value(V8ToUTF8(isolate, val));
+    return FromV8Result::kConverted;
   }
 
   if (val->IsUndefined())
     // JSON.stringify ignores undefined.
-    return nullptr;
+    return FromV8Result::kSkipped;
 
   if (val->IsDate()) {
     v8::Date* date = v8::Date::Cast(*val);
@@ -337,8 +382,8 @@ std::unique_ptr<base::Value> V8ValueConverter::FromV8ValueImpl(
       v8::MaybeLocal<v8::Value> result =
           toISOString.As<v8::Function>()->Call(context, val, 0, nullptr);
       if (!result.IsEmpty()) {
-        v8::String::Utf8Value utf8(isolate, result.ToLocalChecked());
-        return std::make_unique<base::Value>(std::string(*utf8, utf8.length()));
+        *out = base::Value(V8ToUTF8(isolate, result.ToLocalChecked()));
+        return FromV8Result::kConverted;
       }
     }
   }
@@ -346,170 +391,130 @@ std::unique_ptr<base::Value> V8ValueConverter::FromV8ValueImpl(
   if (val->IsRegExp()) {
     if (!reg_exp_allowed_)
       // JSON.stringify converts to an object.
-      return FromV8Object(val.As<v8::Object>(), state, isolate);
-    return std::make_unique<base::Value>(*v8::String::Utf8Value(isolate, val));
+      return PushFrame(state, val.As<v8::Object>(), false, isolate, out);
+    *out = base::Value(V8ToUTF8(isolate, val));
+    return FromV8Result::kConverted;
   }
 
   // v8::Value doesn't have a ToArray() method for some reason.
   if (val->IsArray())
-    return FromV8Array(val.As<v8::Array>(), state, isolate);
+    return PushFrame(state, val.As<v8::Object>(), true, isolate, out);
 
   if (val->IsFunction()) {
     if (!function_allowed_)
       // JSON.stringify refuses to convert function(){}.
-      return nullptr;
-    return FromV8Object(val.As<v8::Object>(), state, isolate);
+      return FromV8Result::kSkipped;
+    return PushFrame(state, val.As<v8::Object>(), false, isolate, out);
   }
 
   if (node::Buffer::HasInstance(val)) {
-    return FromNodeBuffer(val, state, isolate);
+    *out = FromNodeBuffer(val);
+    return FromV8Result::kConverted;
   }
 
-  if (val->IsObject()) {
-    return FromV8Object(val.As<v8::Object>(), state, isolate);
-  }
+  if (val->IsObject())
+    return PushFrame(state, val.As<v8::Object>(), false, isolate, out);
 
   LOG(ERROR) << "Unexpected v8 value type encountered.";
-  return nullptr;
+  return FromV8Result::kSkipped;
 }
 
-std::unique_ptr<base::Value> V8ValueConverter::FromV8Array(
-    v8::Local<v8::Array> val,
+V8ValueConverter::FromV8Result V8ValueConverter::PushFrame(
     FromV8ValueState* state,
-    v8::Isolate* isolate) const {
-  ScopedUniquenessGuard uniqueness_guard(state, val);
-  if (!uniqueness_guard.is_valid())
-    return std::make_unique<base::Value>();
-
-  std::unique_ptr<v8::Context::Scope> scope;
-  // If val was created in a different context than our current one, change to
-  // that context, but change back after val is converted.
-  if (!val->CreationContext().IsEmpty() &&
-      val->CreationContext() != isolate->GetCurrentContext())
-    scope = std::make_unique<v8::Context::Scope>(val->CreationContext());
-
-  std::unique_ptr<base::ListValue> result(new base::ListValue());
-
-  // Only fields with integer keys are carried over to the ListValue.
-  for (uint32_t i = 0; i < val->Length(); ++i) {
-    v8::TryCatch try_catch(isolate);
-    v8::Local<v8::Value> child_v8;
-    v8::MaybeLocal<v8::Value> maybe_child =
-        val->Get(isolate->GetCurrentContext(), i);
-    if (try_catch.HasCaught() || !maybe_child.ToLocal(&child_v8)) {
-      LOG(ERROR) << "Getter for index " << i << " threw an exception.";
-      child_v8 = v8::Null(isolate);
-    }
+    v8::Local<v8::Object> object,
+    bool is_array,
+    v8::Isolate* isolate,
+    base::Value* out) const {
+  if (state->IsConverting(object)) {
+    *out = base::Value();
+    return FromV8Result::kConverted;
+  }
 
-    if (!val->HasRealIndexedProperty(isolate->GetCurrentContext(), i)
-             .FromMaybe(false)) {
-      result->Append(std::make_unique<base::Value>());
-      continue;
-    }
+  FromV8ValueState::Frame frame(object, is_array);
+  // If |object| was created in a different context than our current one,
+  // change to that context, but change back after it is converted.
+  v8::Local<v8::Context> creation_context = object->CreationContext();
+  if (!creation_context.IsEmpty() &&
+      creation_context != isolate->GetCurrentContext()) {
+    creation_context->Enter();
+    frame.entered_context = creation_context;
+  }
 
-    std::unique_ptr<base::Value> child =
-        FromV8ValueImpl(state, child_v8, isolate);
-    if (child)
-      result->Append(std::move(child));
-    else
-      // JSON.stringify puts null in places where values don't serialize, for
-      // example undefined and functions. Emulate that behavior.
-      result->Append(std::make_unique<base::Value>());
+  if (is_array) {
+    frame.length = object.As<v8::Array>()->Length();
+    frame.list.reserve(std::min(frame.length, kMaxReservedLength));
+  } else if (object->GetOwnPropertyNames(isolate->GetCurrentContext())
+                 .ToLocal(&frame.keys)) {
+    frame.length = frame.keys->Length();
+    frame.dict.reserve(std::min(frame.length, kMaxReservedLength));
   }
-  return std::move(result);
+  state->frames.push_back(std::move(frame));
+  return FromV8Result::kPushed;
 }
 
-std::unique_ptr<base::Value> V8ValueConverter::FromNodeBuffer(
-    v8::Local<v8::Value> value,
-    FromV8ValueState* state,
-    v8::Isolate* isolate) const {
-  std::vector<char> buffer(
-      node::Buffer::Data(value),
-      node::Buffer::Data(value) + node::Buffer::Length(value));
-  return std::make_unique<base::Value>(std::move(buffer));
+base::Value V8ValueConverter::PopFrame(FromV8ValueState* state) const {
+  FromV8ValueState::Frame& frame = state->frames.back();
+  base::Value value;
+  if (frame.is_array) {
+    value = base::Value(std::move(frame.list));
+  } else {
+    // Building the dictionary from all of its items at once sorts them once,
+    // instead of inserting them one by one.
+    value = base::Value(base::Value::DictStorage(std::move(frame.dict)));
+  }
+  if (!frame.entered_context.IsEmpty())
+    frame.entered_context->Exit();
+  state->frames.pop_back();
+  return value;
 }
 
-std::unique_ptr<base::Value> V8ValueConverter::FromV8Object(
-    v8::Local<v8::Object> val,
-    FromV8ValueState* state,
-    v8::Isolate* isolate) const {
-  ScopedUniquenessGuard uniqueness_guard(state, val);
-  if (!uniqueness_guard.is_valid())
-    return std::make_unique<base::Value>();
-
-  std::unique_ptr<v8::Context::Scope> scope;
-  // If val was created in a different context than our current one, change to
-  // that context, but change back after val is converted.
-  if (!val->CreationContext().IsEmpty() &&
-      val->CreationContext() != isolate->GetCurrentContext())
-    scope = std::make_unique<v8::Context::Scope>(val->CreationContext());
-
-  auto result = std::make_unique<base::DictionaryValue>();
-  v8::Local<v8::Array> property_names;
-  if (!val->GetOwnPropertyNames(isolate->GetCurrentContext())
-           .ToLocal(&property_names)) {
-    return std::move(result);
+void V8ValueConverter::AddToFrame(FromV8ValueState* state,
+                                  base::Value* value) const {
+  FromV8ValueState::Frame* frame = &state->frames.back();
+  if (frame->is_array) {
+    // JSON.stringify puts null in places where values don't serialize, for
+    // example undefined and functions. Emulate that behavior.
+    frame->list.push_back(value ? std::move(*value) : base::Value());
+    return;
   }
 
-  for (uint32_t i = 0; i < property_names->Length(); ++i) {
-    v8::Local<v8::Value> key =
-        property_names->Get(isolate->GetCurrentContext(), i).ToLocalChecked();
-
-    // Extend this test to cover more types as necessary and if sensible.
-    if (!key->IsString() && !key->IsNumber()) {
-      NOTREACHED() << "Key \"" << *v8::String::Utf8Value(isolate, key)
-                   << "\" "
-                      "is neither a string nor a number";
-      continue;
-    }
-
-    v8::String::Utf8Value name_utf8(isolate, key);
-
-    v8::TryCatch try_catch(isolate);
-    v8::Local<v8::Value> child_v8;
-    v8::MaybeLocal<v8::Value> maybe_child =
-        val->Get(isolate->GetCurrentContext(), key);
-    if (try_catch.HasCaught() || !maybe_child.ToLocal(&child_v8)) {
-      LOG(ERROR) << "Getter for property " << *name_utf8
-                 << " threw an exception.";
-      child_v8 = v8::Null(isolate);
-    }
-
-    std::unique_ptr<base::Value> child =
-        FromV8ValueImpl(state, child_v8, isolate);
-    if (!child)
-      // JSON.stringify skips properties whose values don't serialize, for
-      // example undefined and functions. Emulate that behavior.
-      continue;
-
-    // Strip null if asked (and since undefined is turned into null, undefined
-    // too). The use case for supporting this is JSON-schema support,
-    // specifically for extensions, where "optional" JSON properties may be
-    // represented as null, yet due to buggy legacy code elsewhere isn't
-    // treated as such (potentially causing crashes). For example, the
-    // "tabs.create" function takes an object as its first argument with an
-    // optional "windowId" property.
-    //
-    // Given just
-    //
-    //   tabs.create({})
-    //
-    // this will work as expected on code that only checks for the existence of
-    // a "windowId" property (such as that legacy code). However given
-    //
-    //   tabs.create({windowId: null})
-    //
-    // there *is* a "windowId" property, but since it should be an int, code
-    // on the browser which doesn't additionally check for null will fail.
-    // We can avoid all bugs related to this by stripping null.
-    if (strip_null_from_objects_ && child->is_none())
-      continue;
-
-    result->SetWithoutPathExpansion(std::string(*name_utf8, name_utf8.length()),
-                                    std::move(child));
-  }
+  if (!value)
+    // JSON.stringify skips properties whose values don't serialize, for
+    // example undefined and functions. Emulate that behavior.
+    return;
+
+  // Strip null if asked (and since undefined is turned into null, undefined
+  // too). The use case for supporting this is JSON-schema support,
+  // specifically for extensions, where "optional" JSON properties may be
+  // represented as null, yet due to buggy legacy code elsewhere isn't
+  // treated as such (potentially causing crashes). For example, the
+  // "tabs.create" function takes an object as its first argument with an
+  // optional "windowId" property.
+  //
+  // Given just
+  //
+  //   tabs.create({})
+  //
+  // this will work as expected on code that only checks for the existence of
+  // a "windowId" property (such as that legacy code). However given
+  //
+  //   tabs.create({windowId: null})
+  //
+  // there *is* a "windowId" property, but since it should be an int, code
+  // on the browser which doesn't additionally check for null will fail.
+  // We can avoid all bugs related to this by stripping null.
+  if (strip_null_from_objects_ && value->is_none())
+    return;
+
+  frame->dict.emplace_back(std::move(frame->key),
+                           std::make_unique<base::Value>(std::move(*value)));
+}
 
-  return std::move(result);
+base::Value V8ValueConverter::FromNodeBuffer(v8::Local<v8::Value> value) const {
+  // Copied straight into the blob, which is the only copy of the data.
+  return base::Value(base::make_span(
+      reinterpret_cast<const uint8_t*>(node::Buffer::Data(value)),
+      node::Buffer::Length(value)));
 }
 
 }  // namespace electron
@@ -26,6 +26,9 @@ class V8ValueConverter {
   void SetRegExpAllowed(bool val);
   void SetFunctionAllowed(bool val);
   void SetStripNullFromObjects(bool val);
+  // Values nested deeper than |depth|, counting the converted value as the
+  // first level, are treated like undefined by FromV8Value. Defaults to 100.
+  void SetMaxRecursionDepth(int depth);
   v8::Local<v8::Value> ToV8Value(const base::Value* value,
                                  v8::Local<v8::Context> context) const;
   std::unique_ptr<base::Value> FromV8Value(
@@ -34,7 +37,15 @@ class V8ValueConverter {
 
  private:
   class FromV8ValueState;
-  class ScopedUniquenessGuard;
+
+  enum class FromV8Result {
+    // The value was converted.
+    kConverted,
+    // The value doesn't convert, like undefined and functions.
+    kSkipped,
+    // The value is an array or object, whose frame was pushed on the stack.
+    kPushed,
+  };
 
   v8::Local<v8::Value> ToV8ValueImpl(v8::Isolate* isolate,
                                      const base::Value* value) const;
@@ -46,18 +57,20 @@ class V8ValueConverter {
   v8::Local<v8::Value> ToArrayBuffer(v8::Isolate* isolate,
                                      const base::Value* value) const;
 
-  std::unique_ptr<base::Value> FromV8ValueImpl(FromV8ValueState* state,
-                                               v8::Local<v8::Value> value,
-                                               v8::Isolate* isolate) const;
-  std::unique_ptr<base::Value> FromV8Array(v8::Local<v8::Array> array,
-                                           FromV8ValueState* state,
-                                           v8::Isolate* isolate) const;
-  std::unique_ptr<base::Value> FromNodeBuffer(v8::Local<v8::Value> value,
-                                              FromV8ValueState* state,
-                                              v8::Isolate* isolate) const;
-  std::unique_ptr<base::Value> FromV8Object(v8::Local<v8::Object> object,
-                                            FromV8ValueState* state,
-                                            v8::Isolate* isolate) const;
+  FromV8Result FromV8ValueImpl(FromV8ValueState* state,
+                               v8::Local<v8::Value> value,
+                               v8::Isolate* isolate,
+                               base::Value* out) const;
+  FromV8Result PushFrame(FromV8ValueState* state,
+                         v8::Local<v8::Object> object,
+                         bool is_array,
+                         v8::Isolate* isolate,
+                         base::Value* out) const;
+  base::Value PopFrame(FromV8ValueState* state) const;
+  // Adds the child that was just converted to the innermost frame, |value| is
+  // null when the child doesn't convert.
+  void AddToFrame(FromV8ValueState* state, base::Value* value) const;
+  base::Value FromNodeBuffer(v8::Local<v8::Value> value) const;
 
   // If true, we will convert RegExp JavaScript objects to string.
   bool reg_exp_allowed_ = false;
@@ -69,6 +82,8 @@ class V8ValueConverter {
   // into Values.
   bool strip_null_from_objects_ = false;
 
+  int max_recursion_depth_;
+
   DISALLOW_COPY_AND_ASSIGN(V8ValueConverter);
 };
 
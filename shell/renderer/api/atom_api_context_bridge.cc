@@ -7,11 +7,13 @@
 #include <map>
 #include <set>
 #include <string>
+#include <unordered_set>
 #include <utility>
 #include <vector>
 
 #include "base/no_destructor.h"
 #include "base/strings/string_number_conversions.h"
+#include "base/trace_event/trace_event.h"
 #include "content/public/renderer/render_frame.h"
 #include "content/public/renderer/render_frame_observer.h"
 #include "shell/common/api/remote/object_life_monitor.h"
@@ -58,11 +60,23 @@ context_bridge::RenderFramePersistenceStore* GetOrCreateStore(
   return it->second;
 }
 
+// Marks the objects created by CreateLazyProxyForAPI.
+v8::Local<v8::Private> GetLazyProxyKey(v8::Isolate* isolate) {
+  return v8::Private::ForApi(
+      isolate, gin::StringToV8(isolate, "electron.contextBridge.lazyProxy"));
+}
+
 // Sourced from "extensions/renderer/v8_schema_registry.cc"
 // Recursively freezes every v8 object on |object|.
 bool DeepFreeze(const v8::Local<v8::Object>& object,
                 const v8::Local<v8::Context>& context,
                 std::set<int> frozen = std::set<int>()) {
+  // Lazy proxies are frozen already, and reading their properties here would
+  // defeat their purpose.
+  if (IsTrue(object->HasPrivate(context,
+                                GetLazyProxyKey(context->GetIsolate()))))
+    return true;
+
   int hash = object->GetIdentityHash();
   if (frozen.find(hash) != frozen.end())
     return true;
@@ -71,9 +85,10 @@ bool DeepFreeze(const v8::Local<v8::Object>& object,
   v8::Local<v8::Array> property_names =
       object->GetOwnPropertyNames(context).ToLocalChecked();
   for (uint32_t i = 0; i < property_names->Length(); ++i) {
-    v8::Local<v8::Value> child =
-        object->Get(context, property_names->Get(context, i).ToLocalChecked())
-            .ToLocalChecked();
+    v8::Local<v8::Value> child;
+    if (!object->Get(context, property_names->Get(context, i).ToLocalChecked())
+             .ToLocal(&child))
+      return false;
     if (child->IsObject() && !child->IsTypedArray()) {
       if (!DeepFreeze(v8::Local<v8::Object>::Cast(child), context, frozen))
         return false;
@@ -109,6 +124,109 @@ bool IsPlainArray(const v8::Local<v8::Value>& arr) {
   return !arr->IsTypedArray();
 }
 
+// Whether |key| of |object| is an accessor, which is checked without running
+// it. Accessors are never treated as plain data, so that a getter only runs
+// once, when the object holding it is proxied.
+bool IsAccessor(const v8::Local<v8::Context>& context,
+                const v8::Local<v8::Object>& object,
+                const v8::Local<v8::Value>& key) {
+  return !key->IsName() ||
+         object
+             ->HasRealNamedCallbackProperty(context,
+                                            v8::Local<v8::Name>::Cast(key))
+             .FromMaybe(true);
+}
+
+// Returns true if |value| holds nothing that PassValueToOtherContext would
+// proxy, like functions, promises and accessors, and is not nested so deeply
+// that it would exceed kMaxRecursion. Other objects, like typed arrays, are
+// left to the serializer.
+bool IsPlainData(const v8::Local<v8::Context>& context,
+                 const v8::Local<v8::Value>& value,
+                 int recursion_depth,
+                 std::unordered_set<int>* visited) {
+  if (recursion_depth >= kMaxRecursion)
+    return false;
+  if (value->IsSymbol() || value->IsFunction() || value->IsPromise() ||
+      value->IsNativeError() || value->IsProxy())
+    return false;
+  bool is_array = IsPlainArray(value);
+  if (!is_array && !IsPlainObject(value))
+    return true;
+
+  // Objects that were seen before are cached by the time they are reached
+  // again, so they do not add to the recursion depth.
+  v8::Local<v8::Object> object = v8::Local<v8::Object>::Cast(value);
+  if (!visited->insert(object->GetIdentityHash()).second)
+    return true;
+
+  v8::Isolate* isolate = context->GetIsolate();
+  v8::HandleScope handle_scope(isolate);
+  if (is_array) {
+    v8::Local<v8::Array> arr = v8::Local<v8::Array>::Cast(value);
+    uint32_t length = arr->Length();
+    for (uint32_t i = 0; i < length; i++) {
+      v8::Local<v8::String> index;
+      v8::Local<v8::Value> element;
+      if (!v8::Integer::NewFromUnsigned(isolate, i)
+               ->ToString(context)
+               .ToLocal(&index) ||
+          IsAccessor(context, arr, index) ||
+          !arr->Get(context, i).ToLocal(&element) ||
+          !IsPlainData(context, element, recursion_depth + 1, visited))
+        return false;
+    }
+    return true;
+  }
+
+  v8::Local<v8::Array> keys;
+  if (!object
+           ->GetOwnPropertyNames(context,
+                                 static_cast<v8::PropertyFilter>(
+                                     v8::ONLY_ENUMERABLE | v8::SKIP_SYMBOLS),
+                                 v8::KeyConversionMode::kConvertToString)
+           .ToLocal(&keys))
+    return false;
+  uint32_t length = keys->Length();
+  for (uint32_t i = 0; i < length; i++) {
+    v8::Local<v8::Value> key;
+    v8::Local<v8::Value> child;
+    // Objects are proxied through CreateProxyForAPI, which adds a level.
+    if (!keys->Get(context, i).ToLocal(&key) ||
+        IsAccessor(context, object, key) ||
+        !object->Get(context, key).ToLocal(&child) ||
+        !IsPlainData(context, child, recursion_depth + 2, visited))
+      return false;
+  }
+  return true;
+}
+
+// Copies |value| to |destination_context| with the structured clone algorithm
+// when it is plain data, which is much faster than proxying large graphs value
+// by value. Returns an empty handle, without throwing, when |value| has to be
+// proxied.
+v8::MaybeLocal<v8::Value> ClonePlainData(
+    const v8::Local<v8::Context>& source_context,
+    const v8::Local<v8::Context>& destination_context,
+    const v8::Local<v8::Value>& value,
+    int recursion_depth) {
+  v8::Isolate* isolate = source_context->GetIsolate();
+  blink::CloneableMessage message;
+  {
+    v8::Context::Scope source_context_scope(source_context);
+    // No getter runs here, so what the serializer rejects is proxied without
+    // reading any value twice.
+    v8::TryCatch try_catch(isolate);
+    std::unordered_set<int> visited;
+    if (!IsPlainData(source_context, value, recursion_depth, &visited) ||
+        !gin::ConvertFromV8(isolate, value, &message))
+      return v8::MaybeLocal<v8::Value>();
+  }
+
+  v8::Context::Scope destination_context_scope(destination_context);
+  return v8::MaybeLocal<v8::Value>(gin::ConvertToV8(isolate, message));
+}
+
 class FunctionLifeMonitor final : public ObjectLifeMonitor {
  public:
   static void BindTo(v8::Isolate* isolate,
@@ -252,6 +370,18 @@ v8::MaybeLocal<v8::Value> PassValueToOtherContext(
             ->Get()));
   }
 
+  // Plain data is cloned in one go, the identity of the values nested in it is
+  // only kept within the clone.
+  if (IsPlainArray(value) || IsPlainObject(value)) {
+    v8::Local<v8::Value> cloned_value;
+    if (ClonePlainData(source_context, destination_context, value,
+                       recursion_depth)
+            .ToLocal(&cloned_value)) {
+      store->CacheProxiedObject(value, cloned_value);
+      return v8::MaybeLocal<v8::Value>(cloned_value);
+    }
+  }
+
   // Manually go through the array and pass each value individually into a new
   // array so that functions deep inside arrays get proxied or arrays of
   // promises are proxied correctly.
@@ -315,6 +445,7 @@ v8::Local<v8::Value> ProxyFunctionWrapper(
     context_bridge::RenderFramePersistenceStore* store,
     size_t func_id,
     gin_helper::Arguments* args) {
+  TRACE_EVENT0("electron.context_bridge", "ContextBridge::CallProxiedFunction");
   // Context the proxy function was called from
   v8::Local<v8::Context> calling_context = args->isolate()->GetCurrentContext();
   // Context the function was created in
@@ -424,35 +555,188 @@ v8::MaybeLocal<v8::Object> CreateProxyForAPI(
   }
 }
 
+namespace {
+
+v8::MaybeLocal<v8::Object> CreateLazyProxyForAPI(
+    const v8::Local<v8::Object>& api_object,
+    const v8::Local<v8::Context>& source_context,
+    const v8::Local<v8::Context>& destination_context,
+    context_bridge::RenderFramePersistenceStore* store);
+
+// Like PassValueToOtherContext, except that objects which are not plain data
+// are proxied lazily too.
+v8::MaybeLocal<v8::Value> PassValueLazily(
+    const v8::Local<v8::Context>& source_context,
+    const v8::Local<v8::Context>& destination_context,
+    const v8::Local<v8::Value>& value,
+    context_bridge::RenderFramePersistenceStore* store) {
+  if (!IsPlainObject(value) || !store->GetCachedProxiedObject(value).IsEmpty())
+    return PassValueToOtherContext(source_context, destination_context, value,
+                                   store, 0);
+
+  v8::Local<v8::Value> cloned_value;
+  if (ClonePlainData(source_context, destination_context, value, 0)
+          .ToLocal(&cloned_value)) {
+    store->CacheProxiedObject(value, cloned_value);
+    return v8::MaybeLocal<v8::Value>(cloned_value);
+  }
+
+  v8::Local<v8::Object> proxy;
+  if (!CreateLazyProxyForAPI(v8::Local<v8::Object>::Cast(value),
+                             source_context, destination_context, store)
+           .ToLocal(&proxy))
+    return v8::MaybeLocal<v8::Value>();
+  return v8::MaybeLocal<v8::Value>(proxy);
+}
+
+// Reads |name| from |api_object| and passes its value, frozen, to
+// |destination_context|.
+v8::MaybeLocal<v8::Value> PassLazyProxyProperty(
+    const v8::Local<v8::Object>& api_object,
+    const v8::Local<v8::Name>& name,
+    const v8::Local<v8::Context>& source_context,
+    const v8::Local<v8::Context>& destination_context,
+    context_bridge::RenderFramePersistenceStore* store) {
+  v8::Local<v8::Value> value;
+  {
+    v8::Context::Scope source_context_scope(source_context);
+    if (!api_object->Get(source_context, name).ToLocal(&value))
+      return v8::MaybeLocal<v8::Value>();
+  }
+
+  v8::Local<v8::Value> passed_value;
+  if (!PassValueLazily(source_context, destination_context, value, store)
+           .ToLocal(&passed_value))
+    return v8::MaybeLocal<v8::Value>();
+
+  v8::Context::Scope destination_context_scope(destination_context);
+  if (passed_value->IsObject() && !passed_value->IsTypedArray() &&
+      !DeepFreeze(v8::Local<v8::Object>::Cast(passed_value),
+                  destination_context))
+    return v8::MaybeLocal<v8::Value>();
+  return v8::MaybeLocal<v8::Value>(passed_value);
+}
+
+// Getter of the properties of lazy proxies, |info.Data()| is the object they
+// proxy. V8 replaces the property with the returned value, so it runs once.
+void GetLazyProxyProperty(v8::Local<v8::Name> name,
+                          const v8::PropertyCallbackInfo<v8::Value>& info) {
+  v8::Isolate* isolate = info.GetIsolate();
+  v8::Local<v8::Object> api_object = v8::Local<v8::Object>::Cast(info.Data());
+  v8::Local<v8::Context> source_context = api_object->CreationContext();
+  v8::Local<v8::Context> destination_context = info.Holder()->CreationContext();
+  auto* render_frame = GetRenderFrame(api_object);
+  if (!render_frame)
+    return;
+  context_bridge::RenderFramePersistenceStore* store =
+      GetOrCreateStore(render_frame);
+
+  // Like with proxied functions, the exception itself stays in the isolated
+  // world and only its message is thrown in the calling context.
+  std::string error_message;
+  {
+    v8::TryCatch try_catch(isolate);
+    v8::Local<v8::Value> passed_value;
+    if (PassLazyProxyProperty(api_object, name, source_context,
+                              destination_context, store)
+            .ToLocal(&passed_value)) {
+      info.GetReturnValue().Set(passed_value);
+      return;
+    }
+    auto message = try_catch.Message();
+    if (message.IsEmpty() ||
+        !gin::ConvertFromV8(isolate, message->Get(), &error_message)) {
+      error_message =
+          "An unknown exception occurred in the isolated context, an error "
+          "occurred but a valid exception was not thrown.";
+    }
+  }
+
+  v8::Context::Scope destination_context_scope(destination_context);
+  isolate->ThrowException(
+      v8::Exception::Error(gin::StringToV8(isolate, error_message)));
+}
+
+// Creates a frozen object with the same keys as |api_object|, whose values are
+// only passed to |destination_context| the first time they are read.
+v8::MaybeLocal<v8::Object> CreateLazyProxyForAPI(
+    const v8::Local<v8::Object>& api_object,
+    const v8::Local<v8::Context>& source_context,
+    const v8::Local<v8::Context>& destination_context,
+    context_bridge::RenderFramePersistenceStore* store) {
+  v8::Isolate* isolate = source_context->GetIsolate();
+  v8::Local<v8::Array> keys;
+  if (!api_object
+           ->GetOwnPropertyNames(source_context,
+                                 static_cast<v8::PropertyFilter>(
+                                     v8::ONLY_ENUMERABLE | v8::SKIP_SYMBOLS),
+                                 v8::KeyConversionMode::kConvertToString)
+           .ToLocal(&keys))
+    return v8::MaybeLocal<v8::Object>();
+
+  v8::Context::Scope destination_context_scope(destination_context);
+  v8::Local<v8::Object> proxy = v8::Object::New(isolate);
+  store->CacheProxiedObject(api_object, proxy);
+
+  // Read-only and non-configurable properties on a non-extensible object are
+  // what freezing the object results in.
+  auto attributes =
+      static_cast<v8::PropertyAttribute>(v8::ReadOnly | v8::DontDelete);
+  uint32_t length = keys->Length();
+  for (uint32_t i = 0; i < length; i++) {
+    v8::Local<v8::Value> key;
+    if (!keys->Get(destination_context, i).ToLocal(&key) || !key->IsName())
+      continue;
+    if (!IsTrue(proxy->SetLazyDataProperty(
+            destination_context, v8::Local<v8::Name>::Cast(key),
+            &GetLazyProxyProperty, api_object, attributes)))
+      return v8::MaybeLocal<v8::Object>();
+  }
+  if (!IsTrue(proxy->SetPrivate(destination_context, GetLazyProxyKey(isolate),
+                                v8::True(isolate))) ||
+      !IsTrue(proxy->SetIntegrityLevel(destination_context,
+                                       v8::IntegrityLevel::kFrozen)))
+    return v8::MaybeLocal<v8::Object>();
+  return v8::MaybeLocal<v8::Object>(proxy);
+}
+
+}  // namespace
+
+// |empty| is an object created in the context whose frame is looked up.
+gin_helper::Dictionary GetStats(gin_helper::Dictionary empty) {
+  auto* render_frame = GetRenderFrame(empty.GetHandle());
+  auto* store = GetOrCreateStore(render_frame);
+  gin_helper::Dictionary ret = gin::Dictionary::CreateEmpty(empty.isolate());
+  ret.Set("functionCount", store->functions().size());
+  ret.Set("proxyCount", store->GetLiveProxyCount());
+  ret.Set("proxyCapacity", store->proxy_capacity());
+  // Doubles, since gin has no converter for 64-bit integers.
+  ret.Set("cacheHits", static_cast<double>(store->cache_hits()));
+  ret.Set("cacheMisses", static_cast<double>(store->cache_misses()));
+  return ret;
+}
+
 #ifdef DCHECK_IS_ON
 gin_helper::Dictionary DebugGC(gin_helper::Dictionary empty) {
   auto* render_frame = GetRenderFrame(empty.GetHandle());
   auto* store = GetOrCreateStore(render_frame);
   gin_helper::Dictionary ret = gin::Dictionary::CreateEmpty(empty.isolate());
   ret.Set("functionCount", store->functions().size());
-  auto* proxy_map = store->proxy_map();
-  ret.Set("objectCount", proxy_map->size() * 2);
-  int live_from = 0;
-  int live_proxy = 0;
-  for (auto iter = proxy_map->begin(); iter != proxy_map->end(); iter++) {
-    auto* node = iter->second;
-    while (node) {
-      if (!std::get<0>(node->pair).IsEmpty())
-        live_from++;
-      if (!std::get<1>(node->pair).IsEmpty())
-        live_proxy++;
-      node = node->next;
-    }
-  }
-  ret.Set("liveFromValues", live_from);
-  ret.Set("liveProxyValues", live_proxy);
+  // Entries whose object or proxy was collected are not counted at all.
+  size_t live_proxies = store->GetLiveProxyCount();
+  ret.Set("objectCount", live_proxies * 2);
+  ret.Set("liveFromValues", live_proxies);
+  ret.Set("liveProxyValues", live_proxies);
   return ret;
 }
 #endif
 
 void ExposeAPIInMainWorld(const std::string& key,
                           v8::Local<v8::Object> api_object,
+                          bool lazy,
                           gin_helper::Arguments* args) {
+  TRACE_EVENT1("electron.context_bridge", "ContextBridge::ExposeAPIInMainWorld",
+               "key", key);
   auto* render_frame = GetRenderFrame(api_object);
   CHECK(render_frame);
   context_bridge::RenderFramePersistenceStore* store =
@@ -476,7 +760,10 @@ void ExposeAPIInMainWorld(const std::string& key,
   v8::Context::Scope main_context_scope(main_context);
   {
     v8::MaybeLocal<v8::Object> maybe_proxy =
-        CreateProxyForAPI(api_object, isolated_context, main_context, store, 0);
+        lazy ? CreateLazyProxyForAPI(api_object, isolated_context,
+                                     main_context, store)
+             : CreateProxyForAPI(api_object, isolated_context, main_context,
+                                 store, 0);
     if (maybe_proxy.IsEmpty())
       return;
     auto proxy = maybe_proxy.ToLocalChecked();
@@ -500,6 +787,7 @@ void Initialize(v8::Local<v8::Object> exports,
   v8::Isolate* isolate = context->GetIsolate();
   gin_helper::Dictionary dict(isolate, exports);
   dict.SetMethod("exposeAPIInMainWorld", &electron::api::ExposeAPIInMainWorld);
+  dict.SetMethod("getStats", &electron::api::GetStats);
 #ifdef DCHECK_IS_ON
   dict.SetMethod("_debugGCMaps", &electron::api::DebugGC);
 #endif
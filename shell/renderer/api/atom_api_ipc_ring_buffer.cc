@@ -0,0 +1,83 @@
+// Copyright (c) 2020 GitHub, Inc.
+// Use of this source code is governed by the MIT license that can be
+// found in the LICENSE file.
+
+#include "shell/renderer/api/atom_api_ipc_ring_buffer.h"
+
+#include <utility>
+
+#include "base/bind.h"
+#include "gin/array_buffer.h"
+#include "gin/object_template_builder.h"
+#include "shell/common/ipc_ring_buffer.h"
+
+namespace electron {
+
+namespace api {
+
+gin::WrapperInfo IpcRingBufferWriter::kWrapperInfo = {gin::kEmbedderNativeGin};
+
+// static
+gin::Handle<IpcRingBufferWriter> IpcRingBufferWriter::Create(
+    v8::Isolate* isolate,
+    uint32_t capacity,
+    base::WritableSharedMemoryMapping mapping,
+    mojo::PendingRemote<mojom::ElectronRingBuffer> doorbell) {
+  return gin::CreateHandle(
+      isolate, new IpcRingBufferWriter(capacity, std::move(mapping),
+                                       std::move(doorbell)));
+}
+
+IpcRingBufferWriter::IpcRingBufferWriter(
+    uint32_t capacity,
+    base::WritableSharedMemoryMapping mapping,
+    mojo::PendingRemote<mojom::ElectronRingBuffer> doorbell)
+    : mapping_(std::move(mapping)),
+      ring_buffer_(
+          std::make_unique<IpcRingBuffer>(mapping_.memory(), capacity)),
+      doorbell_(std::move(doorbell)) {
+  doorbell_.set_disconnect_handler(base::BindOnce(
+      &IpcRingBufferWriter::Close, base::Unretained(this)));
+}
+
+IpcRingBufferWriter::~IpcRingBufferWriter() = default;
+
+gin::ObjectTemplateBuilder IpcRingBufferWriter::GetObjectTemplateBuilder(
+    v8::Isolate* isolate) {
+  return gin::Wrappable<IpcRingBufferWriter>::GetObjectTemplateBuilder(isolate)
+      .SetMethod("write", &IpcRingBufferWriter::Write)
+      .SetMethod("notify", &IpcRingBufferWriter::Notify)
+      .SetMethod("close", &IpcRingBufferWriter::Close)
+      .SetProperty("capacity", &IpcRingBufferWriter::GetCapacity);
+}
+
+const char* IpcRingBufferWriter::GetTypeName() {
+  return "IpcRingBufferWriter";
+}
+
+bool IpcRingBufferWriter::Write(const gin::ArrayBufferView& record) {
+  if (!ring_buffer_)
+    return false;
+  return ring_buffer_->Write(base::make_span(
+      static_cast<const uint8_t*>(record.bytes()), record.num_bytes()));
+}
+
+void IpcRingBufferWriter::Notify() {
+  if (doorbell_.is_bound())
+    doorbell_->Notify();
+}
+
+void IpcRingBufferWriter::Close() {
+  // The browser releases its end when the doorbell goes away.
+  doorbell_.reset();
+  ring_buffer_.reset();
+  mapping_ = base::WritableSharedMemoryMapping();
+}
+
+uint32_t IpcRingBufferWriter::GetCapacity() const {
+  return ring_buffer_ ? ring_buffer_->capacity() : 0;
+}
+
+}  // namespace api
+
+}  // namespace electron
@@ -0,0 +1,65 @@
+// Copyright (c) 2020 GitHub, Inc.
+// Use of this source code is governed by the MIT license that can be
+// found in the LICENSE file.
+
+#ifndef SHELL_RENDERER_API_ATOM_API_IPC_RING_BUFFER_H_
+#define SHELL_RENDERER_API_ATOM_API_IPC_RING_BUFFER_H_
+
+#include <memory>
+
+#include "base/memory/shared_memory_mapping.h"
+#include "gin/handle.h"
+#include "gin/wrappable.h"
+#include "mojo/public/cpp/bindings/pending_remote.h"
+#include "mojo/public/cpp/bindings/remote.h"
+#include "shell/common/api/api.mojom.h"
+
+namespace gin {
+class ArrayBufferView;
+}
+
+namespace electron {
+
+class IpcRingBuffer;
+
+namespace api {
+
+// The producer end of a ring buffer opened by ipcRenderer.openRingBuffer().
+class IpcRingBufferWriter : public gin::Wrappable<IpcRingBufferWriter> {
+ public:
+  static gin::WrapperInfo kWrapperInfo;
+
+  static gin::Handle<IpcRingBufferWriter> Create(
+      v8::Isolate* isolate,
+      uint32_t capacity,
+      base::WritableSharedMemoryMapping mapping,
+      mojo::PendingRemote<mojom::ElectronRingBuffer> doorbell);
+
+  // gin::Wrappable:
+  gin::ObjectTemplateBuilder GetObjectTemplateBuilder(
+      v8::Isolate* isolate) override;
+  const char* GetTypeName() override;
+
+ private:
+  IpcRingBufferWriter(uint32_t capacity,
+                      base::WritableSharedMemoryMapping mapping,
+                      mojo::PendingRemote<mojom::ElectronRingBuffer> doorbell);
+  ~IpcRingBufferWriter() override;
+
+  bool Write(const gin::ArrayBufferView& record);
+  void Notify();
+  void Close();
+  uint32_t GetCapacity() const;
+
+  base::WritableSharedMemoryMapping mapping_;
+  std::unique_ptr<IpcRingBuffer> ring_buffer_;
+  mojo::Remote<mojom::ElectronRingBuffer> doorbell_;
+
+  DISALLOW_COPY_AND_ASSIGN(IpcRingBufferWriter);
+};
+
+}  // namespace api
+
+}  // namespace electron
+
+#endif  // SHELL_RENDERER_API_ATOM_API_IPC_RING_BUFFER_H_
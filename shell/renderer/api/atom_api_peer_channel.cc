@@ -0,0 +1,125 @@
+// Copyright (c) 2020 GitHub, Inc.
+// Use of this source code is governed by the MIT license that can be
+// found in the LICENSE file.
+
+#include "shell/renderer/api/atom_api_peer_channel.h"
+
+#include <memory>
+#include <utility>
+
+#include "base/bind.h"
+#include "base/macros.h"
+#include "gin/object_template_builder.h"
+#include "shell/common/gin_converters/blink_converter.h"
+#include "shell/common/node_includes.h"
+
+namespace electron {
+
+namespace api {
+
+gin::WrapperInfo PeerChannel::kWrapperInfo = {gin::kEmbedderNativeGin};
+
+// static
+gin::Handle<PeerChannel> PeerChannel::Create(
+    v8::Isolate* isolate,
+    mojom::ElectronPeerChannelEndpointPtr endpoint) {
+  return gin::CreateHandle(isolate,
+                           new PeerChannel(isolate, std::move(endpoint)));
+}
+
+PeerChannel::PeerChannel(v8::Isolate* isolate,
+                         mojom::ElectronPeerChannelEndpointPtr endpoint)
+    : isolate_(isolate),
+      remote_(std::move(endpoint->remote)),
+      pending_receiver_(std::move(endpoint->receiver)) {
+  remote_.set_disconnect_handler(
+      base::BindOnce(&PeerChannel::OnDisconnect, base::Unretained(this)));
+}
+
+PeerChannel::~PeerChannel() = default;
+
+gin::ObjectTemplateBuilder PeerChannel::GetObjectTemplateBuilder(
+    v8::Isolate* isolate) {
+  return gin::Wrappable<PeerChannel>::GetObjectTemplateBuilder(isolate)
+      .SetMethod("send", &PeerChannel::Send)
+      .SetMethod("start", &PeerChannel::Start)
+      .SetMethod("close", &PeerChannel::Close);
+}
+
+const char* PeerChannel::GetTypeName() {
+  return "PeerChannel";
+}
+
+void PeerChannel::Message(blink::CloneableMessage arguments) {
+  v8::HandleScope handle_scope(isolate_);
+  CallHandler("_onmessage", {gin::ConvertToV8(isolate_, arguments)});
+}
+
+void PeerChannel::Send(v8::Isolate* isolate, v8::Local<v8::Value> arguments) {
+  blink::CloneableMessage message;
+  if (!gin::ConvertFromV8(isolate, arguments, &message)) {
+    isolate->ThrowException(v8::Exception::Error(
+        gin::StringToV8(isolate, "Failed to serialize arguments")));
+    return;
+  }
+  if (remote_.is_bound())
+    remote_->Message(std::move(message));
+}
+
+void PeerChannel::Start() {
+  if (!pending_receiver_.is_valid())
+    return;
+  v8::Local<v8::Object> wrapper;
+  if (GetWrapper(isolate_).ToLocal(&wrapper))
+    self_.Reset(isolate_, wrapper);
+  receiver_.Bind(std::move(pending_receiver_));
+  receiver_.set_disconnect_handler(
+      base::BindOnce(&PeerChannel::OnDisconnect, base::Unretained(this)));
+}
+
+void PeerChannel::Close() {
+  remote_.reset();
+  receiver_.reset();
+  pending_receiver_.reset();
+  closed_ = true;
+  self_.Reset();
+}
+
+void PeerChannel::OnDisconnect() {
+  if (closed_)
+    return;
+  v8::HandleScope handle_scope(isolate_);
+  CallHandler("_onclose", {});
+  Close();
+}
+
+void PeerChannel::CallHandler(const char* name,
+                              std::vector<v8::Local<v8::Value>> args) {
+  v8::Local<v8::Object> wrapper;
+  if (!GetWrapper(isolate_).ToLocal(&wrapper))
+    return;
+  v8::Local<v8::Context> context = wrapper->CreationContext();
+  v8::Context::Scope context_scope(context);
+  v8::MicrotasksScope script_scope(isolate_,
+                                   v8::MicrotasksScope::kRunMicrotasks);
+
+  v8::Local<v8::Value> handler;
+  if (!wrapper->Get(context, gin::StringToV8(isolate_, name))
+           .ToLocal(&handler) ||
+      !handler->IsFunction())
+    return;
+
+  // Sandboxed renderers don't have a node environment.
+  std::unique_ptr<node::CallbackScope> callback_scope;
+  if (node::Environment::GetCurrent(context)) {
+    callback_scope =
+        std::make_unique<node::CallbackScope>(isolate_, wrapper,
+                                              node::async_context{0, 0});
+  }
+  ignore_result(handler.As<v8::Function>()->Call(context, wrapper, args.size(),
+                                                 args.data()));
+}
+
+}  // namespace api
+
+}  // namespace electron
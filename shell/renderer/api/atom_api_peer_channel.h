@@ -0,0 +1,74 @@
+// Copyright (c) 2020 GitHub, Inc.
+// Use of this source code is governed by the MIT license that can be
+// found in the LICENSE file.
+
+#ifndef SHELL_RENDERER_API_ATOM_API_PEER_CHANNEL_H_
+#define SHELL_RENDERER_API_ATOM_API_PEER_CHANNEL_H_
+
+#include <vector>
+
+#include "gin/handle.h"
+#include "gin/wrappable.h"
+#include "mojo/public/cpp/bindings/pending_receiver.h"
+#include "mojo/public/cpp/bindings/receiver.h"
+#include "mojo/public/cpp/bindings/remote.h"
+#include "shell/common/api/api.mojom.h"
+
+namespace electron {
+
+namespace api {
+
+// The native end of a channel opened by ipcRenderer.openChannel(). Like a
+// MessagePort, incoming messages are queued in the pipe until start() is
+// called, and a started channel stays alive until one of its ends is closed.
+class PeerChannel : public gin::Wrappable<PeerChannel>,
+                    public mojom::ElectronPeerChannel {
+ public:
+  static gin::WrapperInfo kWrapperInfo;
+
+  static gin::Handle<PeerChannel> Create(
+      v8::Isolate* isolate,
+      mojom::ElectronPeerChannelEndpointPtr endpoint);
+
+  // gin::Wrappable:
+  gin::ObjectTemplateBuilder GetObjectTemplateBuilder(
+      v8::Isolate* isolate) override;
+  const char* GetTypeName() override;
+
+  // mojom::ElectronPeerChannel:
+  void Message(blink::CloneableMessage arguments) override;
+
+ private:
+  PeerChannel(v8::Isolate* isolate,
+              mojom::ElectronPeerChannelEndpointPtr endpoint);
+  ~PeerChannel() override;
+
+  void Send(v8::Isolate* isolate, v8::Local<v8::Value> arguments);
+  void Start();
+  void Close();
+
+  void OnDisconnect();
+
+  // Calls the |name| handler that lib/renderer/ipc-renderer-channel.ts set on
+  // the wrapper.
+  void CallHandler(const char* name, std::vector<v8::Local<v8::Value>> args);
+
+  v8::Isolate* isolate_;
+
+  mojo::Remote<mojom::ElectronPeerChannel> remote_;
+  mojo::PendingReceiver<mojom::ElectronPeerChannel> pending_receiver_;
+  mojo::Receiver<mojom::ElectronPeerChannel> receiver_{this};
+
+  // Keeps the wrapper alive while the channel is started.
+  v8::Global<v8::Object> self_;
+
+  bool closed_ = false;
+
+  DISALLOW_COPY_AND_ASSIGN(PeerChannel);
+};
+
+}  // namespace api
+
+}  // namespace electron
+
+#endif  // SHELL_RENDERER_API_ATOM_API_PEER_CHANNEL_H_
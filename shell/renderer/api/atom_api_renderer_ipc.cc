@@ -2,22 +2,36 @@
 // Use of this source code is governed by the MIT license that can be
 // found in the LICENSE file.
 
+#include <memory>
 #include <string>
+#include <utility>
+#include <vector>
 
+#include "base/memory/ref_counted.h"
+#include "base/memory/unsafe_shared_memory_region.h"
+#include "base/strings/string_number_conversions.h"
+#include "base/synchronization/lock.h"
+#include "base/synchronization/waitable_event.h"
 #include "base/task/post_task.h"
+#include "base/threading/thread_restrictions.h"
 #include "base/values.h"
 #include "content/public/renderer/render_frame.h"
 #include "gin/dictionary.h"
 #include "gin/handle.h"
 #include "gin/object_template_builder.h"
 #include "gin/wrappable.h"
+#include "mojo/public/cpp/bindings/remote.h"
+#include "mojo/public/cpp/bindings/self_owned_receiver.h"
 #include "services/service_manager/public/cpp/interface_provider.h"
 #include "shell/common/api/api.mojom.h"
 #include "shell/common/gin_converters/blink_converter.h"
 #include "shell/common/gin_converters/value_converter.h"
 #include "shell/common/gin_helper/promise.h"
+#include "shell/common/ipc_trace.h"
 #include "shell/common/node_bindings.h"
 #include "shell/common/node_includes.h"
+#include "shell/renderer/api/atom_api_ipc_ring_buffer.h"
+#include "shell/renderer/api/atom_api_peer_channel.h"
 #include "third_party/blink/public/web/web_local_frame.h"
 
 using blink::WebLocalFrame;
@@ -33,6 +47,53 @@ RenderFrame* GetCurrentRenderFrame() {
   return RenderFrame::FromWebFrame(frame);
 }
 
+class SendSyncScopedAllowBaseSyncPrimitives
+    : public base::ScopedAllowBaseSyncPrimitivesForTesting {};
+
+// The reply to a sync message with a deadline, shared by the main thread
+// waiting for it and the sequence receiving it.
+class SyncReplyState : public base::RefCountedThreadSafe<SyncReplyState> {
+ public:
+  SyncReplyState() = default;
+
+  // Signaled when the reply was received or will never be.
+  base::WaitableEvent event;
+
+  base::Lock lock;
+  bool replied = false;
+  blink::CloneableMessage result;
+
+ private:
+  friend class base::RefCountedThreadSafe<SyncReplyState>;
+  ~SyncReplyState() = default;
+
+  DISALLOW_COPY_AND_ASSIGN(SyncReplyState);
+};
+
+class SyncReplyReceiver : public electron::mojom::ElectronSyncReply {
+ public:
+  explicit SyncReplyReceiver(scoped_refptr<SyncReplyState> state)
+      : state_(std::move(state)) {}
+
+  // Destroyed when the browser dropped the message without replying.
+  ~SyncReplyReceiver() override { state_->event.Signal(); }
+
+  // electron::mojom::ElectronSyncReply:
+  void Reply(blink::CloneableMessage result) override {
+    {
+      base::AutoLock lock(state_->lock);
+      state_->replied = true;
+      state_->result = std::move(result);
+    }
+    state_->event.Signal();
+  }
+
+ private:
+  scoped_refptr<SyncReplyState> state_;
+
+  DISALLOW_COPY_AND_ASSIGN(SyncReplyReceiver);
+};
+
 class IPCRenderer : public gin::Wrappable<IPCRenderer> {
  public:
   static gin::WrapperInfo kWrapperInfo;
@@ -54,39 +115,150 @@ class IPCRenderer : public gin::Wrappable<IPCRenderer> {
       v8::Isolate* isolate) override {
     return gin::Wrappable<IPCRenderer>::GetObjectTemplateBuilder(isolate)
         .SetMethod("send", &IPCRenderer::Send)
+        .SetMethod("sendBatch", &IPCRenderer::SendBatch)
+        .SetMethod("registerChannel", &IPCRenderer::RegisterChannel)
+        .SetMethod("sendById", &IPCRenderer::SendById)
+        .SetMethod("sendWithTransfer", &IPCRenderer::SendWithTransfer)
         .SetMethod("sendSync", &IPCRenderer::SendSync)
+        .SetMethod("sendSyncWithDeadline", &IPCRenderer::SendSyncWithDeadline)
         .SetMethod("sendTo", &IPCRenderer::SendTo)
         .SetMethod("sendToHost", &IPCRenderer::SendToHost)
-        .SetMethod("invoke", &IPCRenderer::Invoke);
+        .SetMethod("invoke", &IPCRenderer::Invoke)
+        .SetMethod("invokeWithTransfer", &IPCRenderer::InvokeWithTransfer)
+        .SetMethod("bindPriorityLane", &IPCRenderer::BindPriorityLane)
+        .SetMethod("openChannel", &IPCRenderer::OpenChannel)
+        .SetMethod("openRingBuffer", &IPCRenderer::OpenRingBuffer);
   }
 
   const char* GetTypeName() override { return "IPCRenderer"; }
 
  private:
+  // Opens the pipe for high priority messages, see
+  // mojom::ElectronBrowser::BindPriorityLane.
+  void BindPriorityLane() {
+    if (!priority_browser_)
+      electron_browser_ptr_->BindPriorityLane(
+          priority_browser_.BindNewPipeAndPassReceiver());
+  }
+
+  electron::mojom::ElectronBrowser* GetBrowser(bool high_priority) {
+    if (!high_priority)
+      return electron_browser_ptr_.get();
+    BindPriorityLane();
+    return priority_browser_.get();
+  }
+
   void Send(v8::Isolate* isolate,
             bool internal,
             const std::string& channel,
-            v8::Local<v8::Value> arguments) {
+            v8::Local<v8::Value> arguments,
+            bool high_priority) {
+    blink::CloneableMessage message;
+    if (!gin::SerializeArguments(isolate, arguments, &message)) {
+      return;
+    }
+    uint64_t trace_id = electron::NewIpcTraceId();
+    TRACE_EVENT_WITH_FLOW1(
+        "electron", "IPCRenderer::Send", TRACE_ID_GLOBAL(trace_id),
+        electron::IpcTraceFlowFlags(trace_id, TRACE_EVENT_FLAG_FLOW_OUT),
+        "channel", channel);
+    GetBrowser(high_priority)
+        ->Message(internal, channel, std::move(message), trace_id);
+  }
+
+  void SendWithTransfer(v8::Isolate* isolate,
+                        bool internal,
+                        const std::string& channel,
+                        v8::Local<v8::Value> arguments,
+                        const std::vector<v8::Local<v8::Value>>& transfer) {
     blink::CloneableMessage message;
-    if (!gin::ConvertFromV8(isolate, arguments, &message)) {
+    std::vector<mojo_base::BigBuffer> array_buffers;
+    if (!gin::SerializeWithTransfer(isolate, arguments, transfer, &message,
+                                    &array_buffers)) {
       return;
     }
-    electron_browser_ptr_->Message(internal, channel, std::move(message));
+    electron_browser_ptr_->MessageWithTransfer(
+        internal, channel, std::move(message), std::move(array_buffers));
+  }
+
+  void RegisterChannel(uint32_t id, const std::string& channel) {
+    electron_browser_ptr_->RegisterChannel(id, channel);
+  }
+
+  void SendById(v8::Isolate* isolate,
+                uint32_t channel_id,
+                v8::Local<v8::Value> arguments) {
+    blink::CloneableMessage message;
+    if (!gin::SerializeArguments(isolate, arguments, &message)) {
+      return;
+    }
+    electron_browser_ptr_->MessageById(channel_id, std::move(message));
+  }
+
+  void SendBatch(v8::Isolate* isolate,
+                 bool internal,
+                 const std::vector<std::string>& channels,
+                 v8::Local<v8::Value> arguments,
+                 bool as_arrays) {
+    blink::CloneableMessage message;
+    if (!gin::SerializeArguments(isolate, arguments, &message)) {
+      return;
+    }
+    electron_browser_ptr_->MessageBatch(internal, channels, std::move(message),
+                                        as_arrays);
   }
 
   v8::Local<v8::Promise> Invoke(v8::Isolate* isolate,
                                 bool internal,
                                 const std::string& channel,
-                                v8::Local<v8::Value> arguments) {
+                                v8::Local<v8::Value> arguments,
+                                bool high_priority) {
     blink::CloneableMessage message;
-    if (!gin::ConvertFromV8(isolate, arguments, &message)) {
+    if (!gin::SerializeArguments(isolate, arguments, &message)) {
       return v8::Local<v8::Promise>();
     }
     gin_helper::Promise<blink::CloneableMessage> p(isolate);
     auto handle = p.GetHandle();
 
-    electron_browser_ptr_->Invoke(
-        internal, channel, std::move(message),
+    uint64_t trace_id = electron::NewIpcTraceId();
+    TRACE_EVENT_WITH_FLOW1(
+        "electron", "IPCRenderer::Invoke", TRACE_ID_GLOBAL(trace_id),
+        electron::IpcTraceFlowFlags(trace_id, TRACE_EVENT_FLAG_FLOW_OUT),
+        "channel", channel);
+    GetBrowser(high_priority)
+        ->Invoke(internal, channel, std::move(message), trace_id,
+                 base::BindOnce(
+                     [](gin_helper::Promise<blink::CloneableMessage> p,
+                        uint64_t trace_id, blink::CloneableMessage result) {
+                       TRACE_EVENT_WITH_FLOW0(
+                           "electron", "IPCRenderer::InvokeReply",
+                           TRACE_ID_GLOBAL(trace_id),
+                           electron::IpcTraceFlowFlags(
+                               trace_id, TRACE_EVENT_FLAG_FLOW_IN));
+                       p.Resolve(result);
+                     },
+                     std::move(p), trace_id));
+
+    return handle;
+  }
+
+  v8::Local<v8::Promise> InvokeWithTransfer(
+      v8::Isolate* isolate,
+      bool internal,
+      const std::string& channel,
+      v8::Local<v8::Value> arguments,
+      const std::vector<v8::Local<v8::Value>>& transfer) {
+    blink::CloneableMessage message;
+    std::vector<mojo_base::BigBuffer> array_buffers;
+    if (!gin::SerializeWithTransfer(isolate, arguments, transfer, &message,
+                                    &array_buffers)) {
+      return v8::Local<v8::Promise>();
+    }
+    gin_helper::Promise<blink::CloneableMessage> p(isolate);
+    auto handle = p.GetHandle();
+
+    electron_browser_ptr_->InvokeWithTransfer(
+        internal, channel, std::move(message), std::move(array_buffers),
         base::BindOnce(
             [](gin_helper::Promise<blink::CloneableMessage> p,
                blink::CloneableMessage result) { p.Resolve(result); },
@@ -102,7 +274,7 @@ class IPCRenderer : public gin::Wrappable<IPCRenderer> {
               const std::string& channel,
               v8::Local<v8::Value> arguments) {
     blink::CloneableMessage message;
-    if (!gin::ConvertFromV8(isolate, arguments, &message)) {
+    if (!gin::SerializeArguments(isolate, arguments, &message)) {
       return;
     }
     electron_browser_ptr_->MessageTo(internal, send_to_all, web_contents_id,
@@ -113,28 +285,158 @@ class IPCRenderer : public gin::Wrappable<IPCRenderer> {
                   const std::string& channel,
                   v8::Local<v8::Value> arguments) {
     blink::CloneableMessage message;
-    if (!gin::ConvertFromV8(isolate, arguments, &message)) {
+    if (!gin::SerializeArguments(isolate, arguments, &message)) {
       return;
     }
     electron_browser_ptr_->MessageHost(channel, std::move(message));
   }
 
+  v8::Local<v8::Promise> OpenChannel(v8::Isolate* isolate,
+                                     int32_t web_contents_id,
+                                     const std::string& channel) {
+    gin_helper::Promise<v8::Local<v8::Value>> p(isolate);
+    auto handle = p.GetHandle();
+
+    electron_browser_ptr_->OpenPeerChannel(
+        web_contents_id, channel,
+        base::BindOnce(
+            [](gin_helper::Promise<v8::Local<v8::Value>> p,
+               electron::mojom::ElectronPeerChannelEndpointPtr endpoint) {
+              v8::Isolate* isolate = p.isolate();
+              v8::HandleScope handle_scope(isolate);
+              v8::Context::Scope context_scope(p.GetContext());
+              if (!endpoint) {
+                p.Resolve(v8::Null(isolate));
+                return;
+              }
+              p.Resolve(electron::api::PeerChannel::Create(
+                            isolate, std::move(endpoint))
+                            .ToV8());
+            },
+            std::move(p)));
+
+    return handle;
+  }
+
+  v8::Local<v8::Promise> OpenRingBuffer(v8::Isolate* isolate,
+                                        const std::string& channel,
+                                        uint32_t capacity) {
+    gin_helper::Promise<v8::Local<v8::Value>> p(isolate);
+    auto handle = p.GetHandle();
+
+    electron_browser_ptr_->OpenRingBuffer(
+        channel, capacity,
+        base::BindOnce(
+            [](gin_helper::Promise<v8::Local<v8::Value>> p, uint32_t capacity,
+               base::UnsafeSharedMemoryRegion region,
+               mojo::PendingRemote<electron::mojom::ElectronRingBuffer>
+                   doorbell) {
+              v8::Isolate* isolate = p.isolate();
+              v8::HandleScope handle_scope(isolate);
+              v8::Context::Scope context_scope(p.GetContext());
+              base::WritableSharedMemoryMapping mapping = region.Map();
+              if (!mapping.IsValid() || !doorbell) {
+                p.Resolve(v8::Null(isolate));
+                return;
+              }
+              p.Resolve(electron::api::IpcRingBufferWriter::Create(
+                            isolate, capacity, std::move(mapping),
+                            std::move(doorbell))
+                            .ToV8());
+            },
+            std::move(p), capacity));
+
+    return handle;
+  }
+
   blink::CloneableMessage SendSync(v8::Isolate* isolate,
                                    bool internal,
                                    const std::string& channel,
                                    v8::Local<v8::Value> arguments) {
     blink::CloneableMessage message;
-    if (!gin::ConvertFromV8(isolate, arguments, &message)) {
+    if (!gin::SerializeArguments(isolate, arguments, &message)) {
       return blink::CloneableMessage();
     }
 
+    uint64_t trace_id = electron::NewIpcTraceId();
     blink::CloneableMessage result;
-    electron_browser_ptr_->MessageSync(internal, channel, std::move(message),
-                                       &result);
+    {
+      TRACE_EVENT_WITH_FLOW1(
+          "electron", "IPCRenderer::SendSync", TRACE_ID_GLOBAL(trace_id),
+          electron::IpcTraceFlowFlags(trace_id, TRACE_EVENT_FLAG_FLOW_OUT),
+          "channel", channel);
+      electron_browser_ptr_->MessageSync(internal, channel, std::move(message),
+                                         trace_id, &result);
+    }
+    TRACE_EVENT_WITH_FLOW0(
+        "electron", "IPCRenderer::SendSyncReply", TRACE_ID_GLOBAL(trace_id),
+        electron::IpcTraceFlowFlags(trace_id, TRACE_EVENT_FLAG_FLOW_IN));
     return result;
   }
 
+  // Sends the message asynchronously and blocks until the reply arrives on
+  // |sync_reply_task_runner_|, or throws once |deadline_ms| has passed.
+  v8::Local<v8::Value> SendSyncWithDeadline(v8::Isolate* isolate,
+                                            bool internal,
+                                            const std::string& channel,
+                                            v8::Local<v8::Value> arguments,
+                                            double deadline_ms) {
+    blink::CloneableMessage message;
+    if (!gin::SerializeArguments(isolate, arguments, &message)) {
+      return v8::Local<v8::Value>();
+    }
+
+    if (!sync_reply_task_runner_)
+      sync_reply_task_runner_ = base::CreateSequencedTaskRunner(
+          {base::ThreadPool(), base::TaskPriority::USER_BLOCKING});
+    auto state = base::MakeRefCounted<SyncReplyState>();
+    mojo::PendingRemote<electron::mojom::ElectronSyncReply> reply;
+    sync_reply_task_runner_->PostTask(
+        FROM_HERE,
+        base::BindOnce(
+            [](scoped_refptr<SyncReplyState> state,
+               mojo::PendingReceiver<electron::mojom::ElectronSyncReply>
+                   receiver) {
+              mojo::MakeSelfOwnedReceiver(
+                  std::make_unique<SyncReplyReceiver>(std::move(state)),
+                  std::move(receiver));
+            },
+            state, reply.InitWithNewPipeAndPassReceiver()));
+    uint64_t trace_id = electron::NewIpcTraceId();
+    bool signaled;
+    {
+      TRACE_EVENT_WITH_FLOW1(
+          "electron", "IPCRenderer::SendSync", TRACE_ID_GLOBAL(trace_id),
+          electron::IpcTraceFlowFlags(trace_id, TRACE_EVENT_FLAG_FLOW_OUT),
+          "channel", channel);
+      electron_browser_ptr_->MessageSyncWithReply(
+          internal, channel, std::move(message), trace_id, std::move(reply));
+
+      SendSyncScopedAllowBaseSyncPrimitives allow_base_sync_primitives;
+      signaled = state->event.TimedWait(
+          base::TimeDelta::FromMillisecondsD(deadline_ms));
+    }
+    if (!signaled) {
+      isolate->ThrowException(v8::Exception::Error(gin::StringToV8(
+          isolate, "No reply to sendSync on '" + channel + "' within " +
+                       base::NumberToString(deadline_ms) + " ms")));
+      return v8::Local<v8::Value>();
+    }
+
+    TRACE_EVENT_WITH_FLOW0(
+        "electron", "IPCRenderer::SendSyncReply", TRACE_ID_GLOBAL(trace_id),
+        electron::IpcTraceFlowFlags(trace_id, TRACE_EVENT_FLAG_FLOW_IN));
+    base::AutoLock lock(state->lock);
+    if (!state->replied)
+      return gin::ConvertToV8(isolate, blink::CloneableMessage());
+    return gin::ConvertToV8(isolate, state->result);
+  }
+
   electron::mojom::ElectronBrowserPtr electron_browser_ptr_;
+  mojo::Remote<electron::mojom::ElectronBrowser> priority_browser_;
+
+  // Receives the replies of SendSyncWithDeadline while the main thread waits.
+  scoped_refptr<base::SequencedTaskRunner> sync_reply_task_runner_;
 };
 
 gin::WrapperInfo IPCRenderer::kWrapperInfo = {gin::kEmbedderNativeGin};
@@ -41,6 +41,10 @@ bool HasWordCharacters(const base::string16& text, int index) {
   return false;
 }
 
+// The results are forgotten all at once when there are more of them, which
+// keeps the memory of long sessions bounded.
+const size_t kMaxWordResults = 10000;
+
 struct Word {
   blink::WebTextCheckingResult result;
   base::string16 text;
@@ -52,18 +56,24 @@ struct Word {
 class SpellCheckClient::SpellcheckRequest {
  public:
   SpellcheckRequest(
+      int id,
       const base::string16& text,
       std::unique_ptr<blink::WebTextCheckingCompletion> completion)
-      : text_(text), completion_(std::move(completion)) {}
+      : id_(id), text_(text), completion_(std::move(completion)) {}
   ~SpellcheckRequest() = default;
 
+  int id() const { return id_; }
   const base::string16& text() const { return text_; }
   blink::WebTextCheckingCompletion* completion() { return completion_.get(); }
   std::vector<Word>& wordlist() { return word_list_; }
+  std::set<base::string16>& unchecked_words() { return unchecked_words_; }
 
  private:
+  int id_;
   base::string16 text_;          // Text to be checked in this task.
   std::vector<Word> word_list_;  // List of Words found in text
+  // The words sent to the provider, which have no result yet.
+  std::set<base::string16> unchecked_words_;
   // The interface to send the misspelled ranges to WebKit.
   std::unique_ptr<blink::WebTextCheckingCompletion> completion_;
 
@@ -106,8 +116,8 @@ void SpellCheckClient::RequestCheckingOfText(
     pending_request_param_->completion()->DidCancelCheckingText();
   }
 
-  pending_request_param_ =
-      std::make_unique<SpellcheckRequest>(text, std::move(completionCallback));
+  pending_request_param_ = std::make_unique<SpellcheckRequest>(
+      ++next_request_id_, text, std::move(completionCallback));
 
   base::ThreadTaskRunnerHandle::Get()->PostTask(
       FROM_HERE,
@@ -182,26 +192,51 @@ void SpellCheckClient::SpellCheckText() {
     }
   }
 
+  // Only the words without a result are sent to the provider, so editing a
+  // long text does not check all of its words again.
+  if (word_results_.size() > kMaxWordResults)
+    word_results_.clear();
+  auto& unchecked_words = pending_request_param_->unchecked_words();
+  for (const auto& w : words) {
+    if (word_results_.find(w) == word_results_.end())
+      unchecked_words.insert(w);
+  }
+  if (unchecked_words.empty()) {
+    FinishRequest();
+    return;
+  }
+
   // Send out all the words data to the spellchecker to check
-  SpellCheckWords(scope, words);
+  SpellCheckWords(scope, unchecked_words);
 }
 
 void SpellCheckClient::OnSpellCheckDone(
+    int request_id,
     const std::vector<base::string16>& misspelled_words) {
-  std::vector<blink::WebTextCheckingResult> results;
+  // The results of a request which was replaced are ignored.
+  if (!pending_request_param_ || pending_request_param_->id() != request_id)
+    return;
+
   std::unordered_set<base::string16> misspelled(misspelled_words.begin(),
                                                 misspelled_words.end());
+  for (const auto& word : pending_request_param_->unchecked_words())
+    word_results_[word] = misspelled.find(word) != misspelled.end();
+
+  FinishRequest();
+}
 
+void SpellCheckClient::FinishRequest() {
+  std::vector<blink::WebTextCheckingResult> results;
   auto& word_list = pending_request_param_->wordlist();
 
   for (const auto& word : word_list) {
-    if (misspelled.find(word.text) != misspelled.end()) {
+    if (IsMisspelled(word.text)) {
       // If this is a contraction, iterate through parts and accept the word
       // if none of them are misspelled
       if (!word.contraction_words.empty()) {
         auto all_correct = true;
         for (const auto& contraction_word : word.contraction_words) {
-          if (misspelled.find(contraction_word) != misspelled.end()) {
+          if (IsMisspelled(contraction_word)) {
             all_correct = false;
             break;
           }
@@ -216,13 +251,19 @@ void SpellCheckClient::OnSpellCheckDone(
   pending_request_param_ = nullptr;
 }
 
+bool SpellCheckClient::IsMisspelled(const base::string16& word) const {
+  auto it = word_results_.find(word);
+  return it != word_results_.end() && it->second;
+}
+
 void SpellCheckClient::SpellCheckWords(const SpellCheckScope& scope,
                                        const std::set<base::string16>& words) {
   DCHECK(!scope.spell_check_.IsEmpty());
 
   v8::Local<v8::FunctionTemplate> templ = gin_helper::CreateFunctionTemplate(
       isolate_,
-      base::BindRepeating(&SpellCheckClient::OnSpellCheckDone, AsWeakPtr()));
+      base::BindRepeating(&SpellCheckClient::OnSpellCheckDone, AsWeakPtr(),
+                          pending_request_param_->id()));
 
   auto context = isolate_->GetCurrentContext();
   v8::Local<v8::Value> args[] = {gin::ConvertToV8(isolate_, words),
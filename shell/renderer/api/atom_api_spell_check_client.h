@@ -8,6 +8,7 @@
 #include <memory>
 #include <set>
 #include <string>
+#include <unordered_map>
 #include <vector>
 
 #include "base/callback.h"
@@ -79,8 +80,16 @@ class SpellCheckClient : public blink::WebSpellCheckPanelHostClient,
                      const base::string16& word,
                      std::vector<base::string16>* contraction_words);
 
-  // Callback for the JS API which returns the list of misspelled words.
-  void OnSpellCheckDone(const std::vector<base::string16>& misspelled_words);
+  // Callback for the JS API which returns the list of misspelled words of
+  // the request |request_id|.
+  void OnSpellCheckDone(int request_id,
+                        const std::vector<base::string16>& misspelled_words);
+
+  // Reports the misspelled words of the pending request, whose words all have
+  // a result.
+  void FinishRequest();
+
+  bool IsMisspelled(const base::string16& word) const;
 
   // Represents character attributes used for filtering out characters which
   // are not supported by this SpellCheck object.
@@ -98,6 +107,11 @@ class SpellCheckClient : public blink::WebSpellCheckPanelHostClient,
   // (When WebKit sends two or more requests, we cancel the previous
   // requests so we do not have to use vectors.)
   std::unique_ptr<SpellcheckRequest> pending_request_param_;
+  int next_request_id_ = 0;
+
+  // Whether each word the provider checked is misspelled, so that only the
+  // words which changed since are sent to it again.
+  std::unordered_map<base::string16, bool> word_results_;
 
   v8::Isolate* isolate_;
   v8::Global<v8::Context> context_;
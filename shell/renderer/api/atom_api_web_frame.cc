@@ -2,16 +2,22 @@
 // Use of this source code is governed by the MIT license that can be
 // found in the LICENSE file.
 
+#include <map>
 #include <memory>
 #include <string>
 #include <utility>
 #include <vector>
 
+#include "base/macros.h"
 #include "base/memory/memory_pressure_listener.h"
+#include "base/no_destructor.h"
+#include "base/optional.h"
+#include "base/strings/stringprintf.h"
 #include "content/public/renderer/render_frame.h"
 #include "content/public/renderer/render_frame_observer.h"
 #include "content/public/renderer/render_frame_visitor.h"
 #include "content/public/renderer/render_view.h"
+#include "mojo/public/cpp/bindings/receiver.h"
 #include "services/service_manager/public/cpp/interface_provider.h"
 #include "shell/common/api/api.mojom.h"
 #include "shell/common/gin_converters/blink_converter.h"
@@ -220,32 +226,109 @@ class SpellCheckerHolder final : public content::RenderFrameObserver {
   std::unique_ptr<SpellCheckClient> spell_check_client_;
 };
 
+// Keeps one pipe to the browser for the zoom of a frame, and caches the zoom
+// level, which the browser sends again whenever it changes.
+class ZoomLevelHolder final : public content::RenderFrameObserver,
+                              public mojom::ElectronZoomObserver {
+ public:
+  // Find or create the holder for the |render_frame|.
+  static ZoomLevelHolder* FromRenderFrame(content::RenderFrame* render_frame) {
+    for (auto* holder : instances_) {
+      if (holder->render_frame() == render_frame)
+        return holder;
+    }
+    return new ZoomLevelHolder(render_frame);
+  }
+
+  explicit ZoomLevelHolder(content::RenderFrame* render_frame)
+      : content::RenderFrameObserver(render_frame) {
+    instances_.insert(this);
+    render_frame->GetRemoteInterfaces()->GetInterface(
+        mojo::MakeRequest(&browser_ptr_));
+    browser_ptr_->ObserveZoomLevel(receiver_.BindNewPipeAndPassRemote());
+  }
+
+  ~ZoomLevelHolder() final { instances_.erase(this); }
+
+  void SetZoomLevel(double level) {
+    zoom_level_ = level;
+    browser_ptr_->SetTemporaryZoomLevel(level, ++sequence_);
+  }
+
+  // Only asks the browser before the first update arrived.
+  double GetZoomLevel() {
+    if (!zoom_level_) {
+      double result = 0.0;
+      browser_ptr_->DoGetZoomLevel(&result);
+      zoom_level_ = result;
+    }
+    return *zoom_level_;
+  }
+
+  void GetZoomLevel(base::OnceCallback<void(double)> callback) {
+    if (zoom_level_)
+      std::move(callback).Run(*zoom_level_);
+    else
+      browser_ptr_->DoGetZoomLevel(std::move(callback));
+  }
+
+  // mojom::ElectronZoomObserver:
+  void OnZoomLevelChanged(double zoom_level, uint32_t sequence) final {
+    // Sent before the browser got the last level set here, which it replaces.
+    if (sequence != sequence_)
+      return;
+    zoom_level_ = zoom_level;
+  }
+
+  // RenderFrameObserver implementation.
+  void DidCreateNewDocument() final {
+    // The zoom level of the new page may be the one of another host, which
+    // is not sent as a change.
+    zoom_level_.reset();
+  }
+
+  void OnDestruct() final { delete this; }
+
+ private:
+  static std::set<ZoomLevelHolder*> instances_;
+
+  mojom::ElectronBrowserPtr browser_ptr_;
+  mojo::Receiver<mojom::ElectronZoomObserver> receiver_{this};
+  base::Optional<double> zoom_level_;
+  // Numbers the levels set here, so the stale updates can be told apart.
+  uint32_t sequence_ = 0;
+};
+
 }  // namespace
 
 // static
 std::set<SpellCheckerHolder*> SpellCheckerHolder::instances_;
 
+// static
+std::set<ZoomLevelHolder*> ZoomLevelHolder::instances_;
+
 void SetName(v8::Local<v8::Value> window, const std::string& name) {
   GetRenderFrame(window)->GetWebFrame()->SetName(
       blink::WebString::FromUTF8(name));
 }
 
 void SetZoomLevel(v8::Local<v8::Value> window, double level) {
-  content::RenderFrame* render_frame = GetRenderFrame(window);
-  mojom::ElectronBrowserPtr browser_ptr;
-  render_frame->GetRemoteInterfaces()->GetInterface(
-      mojo::MakeRequest(&browser_ptr));
-  browser_ptr->SetTemporaryZoomLevel(level);
+  ZoomLevelHolder::FromRenderFrame(GetRenderFrame(window))->SetZoomLevel(level);
 }
 
 double GetZoomLevel(v8::Local<v8::Value> window) {
-  double result = 0.0;
-  content::RenderFrame* render_frame = GetRenderFrame(window);
-  mojom::ElectronBrowserPtr browser_ptr;
-  render_frame->GetRemoteInterfaces()->GetInterface(
-      mojo::MakeRequest(&browser_ptr));
-  browser_ptr->DoGetZoomLevel(&result);
-  return result;
+  return ZoomLevelHolder::FromRenderFrame(GetRenderFrame(window))
+      ->GetZoomLevel();
+}
+
+v8::Local<v8::Promise> GetZoomLevelAsync(v8::Isolate* isolate,
+                                         v8::Local<v8::Value> window) {
+  gin_helper::Promise<double> promise(isolate);
+  v8::Local<v8::Promise> handle = promise.GetHandle();
+  ZoomLevelHolder::FromRenderFrame(GetRenderFrame(window))
+      ->GetZoomLevel(base::BindOnce(
+          &gin_helper::Promise<double>::ResolvePromise, std::move(promise)));
+  return handle;
 }
 
 void SetZoomFactor(v8::Local<v8::Value> window, double factor) {
@@ -425,6 +508,159 @@ v8::Local<v8::Promise> ExecuteJavaScriptInIsolatedWorld(
   return handle;
 }
 
+// Whether |frame| is |root| or one of its descendants.
+bool IsInFrameTree(blink::WebFrame* root, blink::WebFrame* frame) {
+  for (; frame; frame = frame->Parent()) {
+    if (frame == root)
+      return true;
+  }
+  return false;
+}
+
+// Runs |code| in the main world of each of the frames of |frame_ids|, which
+// must be |window| or its descendants in this process, and resolves with their
+// results in the same order.
+// The script is compiled once and bound to each frame, and the results are
+// structured clones, since the frames may not share an origin with the caller.
+v8::Local<v8::Promise> ExecuteJavaScriptInFrames(
+    gin_helper::Arguments* args,
+    v8::Local<v8::Value> window,
+    const std::vector<int>& frame_ids,
+    const base::string16& code) {
+  v8::Isolate* isolate = args->isolate();
+  gin_helper::Promise<v8::Local<v8::Value>> promise(isolate);
+  v8::Local<v8::Promise> handle = promise.GetHandle();
+
+  blink::WebFrame* root = GetRenderFrame(window)->GetWebFrame();
+  std::vector<blink::CloneableMessage> results;
+  results.reserve(frame_ids.size());
+  v8::Local<v8::UnboundScript> unbound_script;
+  for (int frame_id : frame_ids) {
+    content::RenderFrame* render_frame =
+        content::RenderFrame::FromRoutingID(frame_id);
+    // The frames of other pages hosted by this process are not reachable.
+    if (!render_frame || !IsInFrameTree(root, render_frame->GetWebFrame())) {
+      promise.RejectWithErrorMessage(base::StringPrintf(
+          "The frame %d is not in this frame tree", frame_id));
+      return handle;
+    }
+
+    v8::Local<v8::Context> context =
+        render_frame->GetWebFrame()->MainWorldScriptContext();
+    v8::Context::Scope context_scope(context);
+    v8::MicrotasksScope microtasks_scope(isolate,
+                                         v8::MicrotasksScope::kRunMicrotasks);
+    // Reports the exceptions to the console of the frame.
+    v8::TryCatch try_catch(isolate);
+    try_catch.SetVerbose(true);
+
+    if (unbound_script.IsEmpty()) {
+      v8::ScriptCompiler::Source source(
+          gin::ConvertToV8(isolate, code).As<v8::String>());
+      if (!v8::ScriptCompiler::CompileUnboundScript(isolate, &source)
+               .ToLocal(&unbound_script)) {
+        promise.RejectWithErrorMessage(
+            "Script failed to compile. Check the renderer console for the "
+            "error.");
+        return handle;
+      }
+    }
+
+    v8::Local<v8::Value> result;
+    blink::CloneableMessage message;
+    if (!unbound_script->BindToCurrentContext()->Run(context).ToLocal(
+            &result) ||
+        !gin::ConvertFromV8(isolate, result, &message)) {
+      promise.RejectWithErrorMessage(base::StringPrintf(
+          "Script failed to execute in the frame %d, or its result could not "
+          "be cloned. Check the renderer console for the error.",
+          frame_id));
+      return handle;
+    }
+    results.push_back(std::move(message));
+  }
+
+  v8::Local<v8::Context> context = isolate->GetCurrentContext();
+  v8::Local<v8::Array> values =
+      v8::Array::New(isolate, static_cast<int>(results.size()));
+  for (uint32_t i = 0; i < results.size(); ++i)
+    values->Set(context, i, gin::ConvertToV8(isolate, results[i])).Check();
+  promise.Resolve(values);
+  return handle;
+}
+
+// The code caches of the content scripts of the extensions, by URL, shared by
+// all the frames of the renderer process.
+struct ContentScriptCache {
+  base::string16 code;
+  std::vector<uint8_t> data;
+};
+
+std::map<base::string16, ContentScriptCache>& GetContentScriptCaches() {
+  static base::NoDestructor<std::map<base::string16, ContentScriptCache>>
+      caches;
+  return *caches;
+}
+
+// Runs a content script in the isolated world |world_id| like
+// executeJavaScriptInIsolatedWorld does, but consumes the code cache the first
+// frame which ran the same script created, so it is compiled once per process.
+void ExecuteContentScript(v8::Isolate* isolate,
+                          v8::Local<v8::Value> window,
+                          int world_id,
+                          const base::string16& url,
+                          const base::string16& code) {
+  blink::WebLocalFrame* frame = GetRenderFrame(window)->GetWebFrame();
+  v8::Local<v8::Context> context =
+      frame->GetScriptContextFromWorldId(isolate, world_id);
+  v8::Context::Scope context_scope(context);
+  v8::MicrotasksScope microtasks_scope(isolate,
+                                       v8::MicrotasksScope::kRunMicrotasks);
+  // Reports the exceptions to the console of the frame.
+  v8::TryCatch try_catch(isolate);
+  try_catch.SetVerbose(true);
+
+  auto& caches = GetContentScriptCaches();
+  auto it = caches.find(url);
+  // V8 only checks the length of the source against the cache.
+  if (it != caches.end() && it->second.code != code) {
+    caches.erase(it);
+    it = caches.end();
+  }
+
+  v8::ScriptCompiler::CachedData* cached_data = nullptr;
+  if (it != caches.end()) {
+    cached_data = new v8::ScriptCompiler::CachedData(
+        it->second.data.data(), it->second.data.size(),
+        v8::ScriptCompiler::CachedData::BufferNotOwned);
+  }
+  // Owns |cached_data|.
+  v8::ScriptCompiler::Source source(
+      gin::ConvertToV8(isolate, code).As<v8::String>(),
+      v8::ScriptOrigin(gin::ConvertToV8(isolate, url)), cached_data);
+  v8::Local<v8::Script> script;
+  if (!v8::ScriptCompiler::Compile(
+           context, &source,
+           cached_data ? v8::ScriptCompiler::kConsumeCodeCache
+                       : v8::ScriptCompiler::kNoCompileOptions)
+           .ToLocal(&script))
+    return;
+  bool needs_cache = !cached_data || source.GetCachedData()->rejected;
+
+  ignore_result(script->Run(context));
+
+  // Created after the run, so the cache holds the functions it compiled.
+  if (needs_cache) {
+    std::unique_ptr<v8::ScriptCompiler::CachedData> new_data(
+        v8::ScriptCompiler::CreateCodeCache(script->GetUnboundScript()));
+    if (new_data) {
+      caches[url] = {code, std::vector<uint8_t>(
+                               new_data->data,
+                               new_data->data + new_data->length)};
+    }
+  }
+}
+
 void SetIsolatedWorldInfo(v8::Local<v8::Value> window,
                           int world_id,
                           const gin_helper::Dictionary& options,
@@ -566,6 +802,7 @@ void Initialize(v8::Local<v8::Object> exports,
   dict.SetMethod("setName", &SetName);
   dict.SetMethod("setZoomLevel", &SetZoomLevel);
   dict.SetMethod("getZoomLevel", &GetZoomLevel);
+  dict.SetMethod("getZoomLevelAsync", &GetZoomLevelAsync);
   dict.SetMethod("setZoomFactor", &SetZoomFactor);
   dict.SetMethod("getZoomFactor", &GetZoomFactor);
   dict.SetMethod("setVisualZoomLevelLimits", &SetVisualZoomLevelLimits);
@@ -579,6 +816,8 @@ void Initialize(v8::Local<v8::Object> exports,
   dict.SetMethod("executeJavaScript", &ExecuteJavaScript);
   dict.SetMethod("executeJavaScriptInIsolatedWorld",
                  &ExecuteJavaScriptInIsolatedWorld);
+  dict.SetMethod("executeJavaScriptInFrames", &ExecuteJavaScriptInFrames);
+  dict.SetMethod("_executeContentScript", &ExecuteContentScript);
   dict.SetMethod("setIsolatedWorldInfo", &SetIsolatedWorldInfo);
   dict.SetMethod("getResourceUsage", &GetResourceUsage);
   dict.SetMethod("clearCache", &ClearCache);
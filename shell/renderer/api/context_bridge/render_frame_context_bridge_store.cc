@@ -6,7 +6,8 @@
 
 #include <utility>
 
-#include "shell/common/api/remote/object_life_monitor.h"
+#include "base/bind.h"
+#include "base/no_destructor.h"
 
 namespace electron {
 
@@ -16,55 +17,7 @@ namespace context_bridge {
 
 namespace {
 
-class CachedProxyLifeMonitor final : public ObjectLifeMonitor {
- public:
-  static void BindTo(v8::Isolate* isolate,
-                     v8::Local<v8::Object> target,
-                     base::WeakPtr<RenderFramePersistenceStore> store,
-                     WeakGlobalPairNode* node,
-                     int hash) {
-    new CachedProxyLifeMonitor(isolate, target, store, node, hash);
-  }
-
- protected:
-  CachedProxyLifeMonitor(v8::Isolate* isolate,
-                         v8::Local<v8::Object> target,
-                         base::WeakPtr<RenderFramePersistenceStore> store,
-                         WeakGlobalPairNode* node,
-                         int hash)
-      : ObjectLifeMonitor(isolate, target),
-        store_(store),
-        node_(node),
-        hash_(hash) {}
-
-  void RunDestructor() override {
-    if (!store_)
-      return;
-
-    if (node_->detached) {
-      delete node_;
-      return;
-    }
-    if (node_->prev) {
-      node_->prev->next = node_->next;
-      node_->prev = nullptr;
-    }
-    if (node_->next) {
-      node_->next->prev = node_->prev;
-      node_->next = nullptr;
-    }
-    if (!node_->prev && !node_->next) {
-      // Must be a single length linked list
-      store_->proxy_map()->erase(hash_);
-    }
-    node_->detached = true;
-  }
-
- private:
-  base::WeakPtr<RenderFramePersistenceStore> store_;
-  WeakGlobalPairNode* node_;
-  int hash_;
-};
+const size_t kMinProxyCapacity = 16;
 
 }  // namespace
 
@@ -74,16 +27,22 @@ std::map<int32_t, RenderFramePersistenceStore*>& GetStoreMap() {
   return *store_map;
 }
 
-WeakGlobalPairNode::WeakGlobalPairNode(WeakGlobalPair pair) {
-  this->pair = std::move(pair);
-}
+RenderFramePersistenceStore::ProxyEntry::ProxyEntry() = default;
+
+RenderFramePersistenceStore::ProxyEntry::ProxyEntry(ProxyEntry&&) = default;
 
-WeakGlobalPairNode::~WeakGlobalPairNode() {}
+RenderFramePersistenceStore::ProxyEntry::~ProxyEntry() = default;
+
+RenderFramePersistenceStore::ProxyEntry&
+RenderFramePersistenceStore::ProxyEntry::operator=(ProxyEntry&&) = default;
 
 RenderFramePersistenceStore::RenderFramePersistenceStore(
     content::RenderFrame* render_frame)
     : content::RenderFrameObserver(render_frame),
-      routing_id_(render_frame->GetRoutingID()) {}
+      routing_id_(render_frame->GetRoutingID()),
+      memory_pressure_listener_(base::BindRepeating(
+          &RenderFramePersistenceStore::OnMemoryPressure,
+          base::Unretained(this))) {}
 
 RenderFramePersistenceStore::~RenderFramePersistenceStore() = default;
 
@@ -95,34 +54,44 @@ void RenderFramePersistenceStore::OnDestruct() {
 void RenderFramePersistenceStore::CacheProxiedObject(
     v8::Local<v8::Value> from,
     v8::Local<v8::Value> proxy_value) {
-  if (from->IsObject() && !from->IsNullOrUndefined()) {
-    auto obj = v8::Local<v8::Object>::Cast(from);
-    int hash = obj->GetIdentityHash();
-    auto global_from = v8::Global<v8::Value>(v8::Isolate::GetCurrent(), from);
-    auto global_proxy =
-        v8::Global<v8::Value>(v8::Isolate::GetCurrent(), proxy_value);
-    // Do not retain
-    global_from.SetWeak();
-    global_proxy.SetWeak();
-    auto iter = proxy_map_.find(hash);
-    auto* node = new WeakGlobalPairNode(
-        std::make_tuple(std::move(global_from), std::move(global_proxy)));
-    CachedProxyLifeMonitor::BindTo(v8::Isolate::GetCurrent(), obj,
-                                   weak_factory_.GetWeakPtr(), node, hash);
-    CachedProxyLifeMonitor::BindTo(v8::Isolate::GetCurrent(),
-                                   v8::Local<v8::Object>::Cast(proxy_value),
-                                   weak_factory_.GetWeakPtr(), node, hash);
-    if (iter == proxy_map_.end()) {
-      proxy_map_.emplace(hash, node);
-    } else {
-      WeakGlobalPairNode* target = iter->second;
-      while (target->next) {
-        target = target->next;
+  if (!from->IsObject() || from->IsNullOrUndefined())
+    return;
+
+  // Keep the table at most half full, counting the dead entries.
+  if ((used_proxies_ + 1) * 2 > proxies_.size())
+    Compact(GetLiveProxyCount() + 1);
+
+  v8::Isolate* isolate = v8::Isolate::GetCurrent();
+  int hash = v8::Local<v8::Object>::Cast(from)->GetIdentityHash();
+  size_t mask = proxies_.size() - 1;
+  ProxyEntry* target = nullptr;
+  for (size_t i = hash & mask; proxies_[i].used; i = (i + 1) & mask) {
+    ProxyEntry& entry = proxies_[i];
+    if (entry.hash == hash && !entry.from.IsEmpty() &&
+        entry.from.Get(isolate) == from) {
+      target = &entry;
+      break;
+    }
+    if (!target && !entry.is_live())
+      target = &entry;
+  }
+  if (!target) {
+    for (size_t i = hash & mask;; i = (i + 1) & mask) {
+      if (!proxies_[i].used) {
+        target = &proxies_[i];
+        break;
       }
-      target->next = node;
-      node->prev = target;
     }
+    target->used = true;
+    used_proxies_++;
   }
+
+  target->hash = hash;
+  target->from.Reset(isolate, from);
+  target->proxy.Reset(isolate, proxy_value);
+  // Do not retain
+  target->from.SetWeak();
+  target->proxy.SetWeak();
 }
 
 v8::MaybeLocal<v8::Value> RenderFramePersistenceStore::GetCachedProxiedObject(
@@ -130,24 +99,64 @@ v8::MaybeLocal<v8::Value> RenderFramePersistenceStore::GetCachedProxiedObject(
   if (!from->IsObject() || from->IsNullOrUndefined())
     return v8::MaybeLocal<v8::Value>();
 
-  auto obj = v8::Local<v8::Object>::Cast(from);
-  int hash = obj->GetIdentityHash();
-  auto iter = proxy_map_.find(hash);
-  if (iter == proxy_map_.end())
-    return v8::MaybeLocal<v8::Value>();
-  WeakGlobalPairNode* target = iter->second;
-  while (target) {
-    auto from_cmp = std::get<0>(target->pair).Get(v8::Isolate::GetCurrent());
-    if (from_cmp == from) {
-      if (std::get<1>(target->pair).IsEmpty())
-        return v8::MaybeLocal<v8::Value>();
-      return std::get<1>(target->pair).Get(v8::Isolate::GetCurrent());
+  if (!proxies_.empty()) {
+    v8::Isolate* isolate = v8::Isolate::GetCurrent();
+    int hash = v8::Local<v8::Object>::Cast(from)->GetIdentityHash();
+    size_t mask = proxies_.size() - 1;
+    for (size_t i = hash & mask; proxies_[i].used; i = (i + 1) & mask) {
+      const ProxyEntry& entry = proxies_[i];
+      if (entry.hash != hash || !entry.is_live() ||
+          entry.from.Get(isolate) != from)
+        continue;
+      cache_hits_++;
+      return entry.proxy.Get(isolate);
     }
-    target = target->next;
   }
+  cache_misses_++;
   return v8::MaybeLocal<v8::Value>();
 }
 
+size_t RenderFramePersistenceStore::GetLiveProxyCount() const {
+  size_t count = 0;
+  for (const ProxyEntry& entry : proxies_) {
+    if (entry.is_live())
+      count++;
+  }
+  return count;
+}
+
+void RenderFramePersistenceStore::Compact(size_t min_live) {
+  // Leave room for as many insertions again before the next compaction.
+  size_t capacity = kMinProxyCapacity;
+  while (capacity < min_live * 4)
+    capacity *= 2;
+
+  std::vector<ProxyEntry> old_proxies(capacity);
+  proxies_.swap(old_proxies);
+  used_proxies_ = 0;
+  size_t mask = capacity - 1;
+  for (ProxyEntry& entry : old_proxies) {
+    if (!entry.is_live())
+      continue;
+    size_t i = entry.hash & mask;
+    while (proxies_[i].used)
+      i = (i + 1) & mask;
+    proxies_[i] = std::move(entry);
+    used_proxies_++;
+  }
+}
+
+void RenderFramePersistenceStore::OnMemoryPressure(
+    base::MemoryPressureListener::MemoryPressureLevel level) {
+  size_t live = GetLiveProxyCount();
+  if (live == 0) {
+    std::vector<ProxyEntry>().swap(proxies_);
+    used_proxies_ = 0;
+  } else if (live < used_proxies_) {
+    Compact(live);
+  }
+}
+
 }  // namespace context_bridge
 
 }  // namespace api
@@ -7,7 +7,10 @@
 
 #include <map>
 #include <tuple>
+#include <unordered_map>
+#include <vector>
 
+#include "base/memory/memory_pressure_listener.h"
 #include "content/public/renderer/render_frame.h"
 #include "content/public/renderer/render_frame_observer.h"
 #include "shell/renderer/atom_render_frame_observer.h"
@@ -22,17 +25,6 @@ namespace context_bridge {
 using FunctionContextPair =
     std::tuple<v8::Global<v8::Function>, v8::Global<v8::Context>>;
 
-using WeakGlobalPair = std::tuple<v8::Global<v8::Value>, v8::Global<v8::Value>>;
-
-struct WeakGlobalPairNode {
-  explicit WeakGlobalPairNode(WeakGlobalPair pair_);
-  ~WeakGlobalPairNode();
-  WeakGlobalPair pair;
-  bool detached = false;
-  struct WeakGlobalPairNode* prev = nullptr;
-  struct WeakGlobalPairNode* next = nullptr;
-};
-
 class RenderFramePersistenceStore final : public content::RenderFrameObserver {
  public:
   explicit RenderFramePersistenceStore(content::RenderFrame* render_frame);
@@ -43,26 +35,63 @@ class RenderFramePersistenceStore final : public content::RenderFrameObserver {
 
   size_t take_func_id() { return next_func_id_++; }
 
-  std::map<size_t, FunctionContextPair>& functions() { return functions_; }
-  std::map<int, WeakGlobalPairNode*>* proxy_map() { return &proxy_map_; }
+  std::unordered_map<size_t, FunctionContextPair>& functions() {
+    return functions_;
+  }
 
   void CacheProxiedObject(v8::Local<v8::Value> from,
                           v8::Local<v8::Value> proxy_value);
   v8::MaybeLocal<v8::Value> GetCachedProxiedObject(v8::Local<v8::Value> from);
 
+  // Number of cached proxies whose object and proxy are both alive.
+  size_t GetLiveProxyCount() const;
+  size_t proxy_capacity() const { return proxies_.size(); }
+  uint64_t cache_hits() const { return cache_hits_; }
+  uint64_t cache_misses() const { return cache_misses_; }
+
  private:
+  // Both values are weak, i.e. they are not retained beyond their normal JS
+  // lifetime, and are reset when they are collected. An entry is dead once
+  // either of them is.
+  struct ProxyEntry {
+    ProxyEntry();
+    ProxyEntry(ProxyEntry&&);
+    ~ProxyEntry();
+    ProxyEntry& operator=(ProxyEntry&&);
+
+    bool is_live() const { return !from.IsEmpty() && !proxy.IsEmpty(); }
+
+    // False for slots that never held an entry, which end lookups.
+    bool used = false;
+    int hash = 0;
+    v8::Global<v8::Value> from;
+    v8::Global<v8::Value> proxy;
+  };
+
+  // Rebuilds |proxies_| without the dead entries, with room for at least
+  // |min_live| live ones.
+  void Compact(size_t min_live);
+
+  // Drops the dead entries, and the table with them when none is live.
+  void OnMemoryPressure(
+      base::MemoryPressureListener::MemoryPressureLevel level);
+
   // func_id ==> { function, owning_context }
-  std::map<size_t, FunctionContextPair> functions_;
+  std::unordered_map<size_t, FunctionContextPair> functions_;
   size_t next_func_id_ = 1;
 
-  // proxy maps are weak globals, i.e. these are not retained beyond
-  // there normal JS lifetime.  You must check IsEmpty()
-
   const int32_t routing_id_;
 
-  // object_identity ==> [from_value, proxy_value]
-  std::map<int, WeakGlobalPairNode*> proxy_map_;
-  base::WeakPtrFactory<RenderFramePersistenceStore> weak_factory_{this};
+  // Open addressing table keyed by the identity hash of |from|, its size is
+  // zero or a power of two. Dead entries are kept as tombstones until the
+  // table fills up, rather than being removed when they die.
+  std::vector<ProxyEntry> proxies_;
+  // Slots with |used| set, live or dead.
+  size_t used_proxies_ = 0;
+  uint64_t cache_hits_ = 0;
+  uint64_t cache_misses_ = 0;
+
+  base::MemoryPressureListener memory_pressure_listener_;
 };
 
 std::map<int32_t, RenderFramePersistenceStore*>& GetStoreMap();
@@ -76,8 +76,7 @@ void AtomRenderFrameObserver::DidCreateScriptContext(
   bool is_not_opened =
       !render_frame_->GetWebFrame()->Opener() ||
       command_line->HasSwitch(switches::kEnableNodeLeakageInRenderers);
-  bool allow_node_in_sub_frames =
-      command_line->HasSwitch(switches::kNodeIntegrationInSubFrames);
+  bool allow_node_in_sub_frames = renderer_client_->ShouldLoadNodeInSubFrames();
   bool should_create_isolated_context =
       use_context_isolation && is_main_world &&
       (is_main_frame || allow_node_in_sub_frames) &&
@@ -152,9 +151,7 @@ bool AtomRenderFrameObserver::IsIsolatedWorld(int world_id) {
 }
 
 bool AtomRenderFrameObserver::ShouldNotifyClient(int world_id) {
-  bool allow_node_in_sub_frames =
-      base::CommandLine::ForCurrentProcess()->HasSwitch(
-          switches::kNodeIntegrationInSubFrames);
+  bool allow_node_in_sub_frames = renderer_client_->ShouldLoadNodeInSubFrames();
   if (renderer_client_->isolated_world() &&
       (render_frame_->IsMainFrame() || allow_node_in_sub_frames))
     return IsIsolatedWorld(world_id);
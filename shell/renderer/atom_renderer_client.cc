@@ -18,6 +18,7 @@
 #include "shell/common/node_includes.h"
 #include "shell/common/node_util.h"
 #include "shell/common/options_switches.h"
+#include "shell/common/startup_timeline.h"
 #include "shell/renderer/atom_render_frame_observer.h"
 #include "shell/renderer/web_worker_observer.h"
 #include "third_party/blink/public/web/web_document.h"
@@ -74,6 +75,7 @@ void AtomRendererClient::RunScriptsAtDocumentEnd(
 void AtomRendererClient::DidCreateScriptContext(
     v8::Handle<v8::Context> renderer_context,
     content::RenderFrame* render_frame) {
+  ScopedStartupPhase startup_phase("DidCreateScriptContext");
   RendererClientBase::DidCreateScriptContext(renderer_context, render_frame);
 
   // TODO(zcbenz): Do not create Node environment if node integration is not
@@ -97,8 +99,7 @@ void AtomRendererClient::DidCreateScriptContext(
   bool is_main_frame = render_frame->IsMainFrame() &&
                        (is_not_opened || reuse_renderer_processes_enabled);
   bool is_devtools = IsDevToolsExtension(render_frame);
-  bool allow_node_in_subframes =
-      command_line->HasSwitch(switches::kNodeIntegrationInSubFrames);
+  bool allow_node_in_subframes = ShouldLoadNodeInSubFrames();
   bool should_load_node =
       (is_main_frame || is_devtools || allow_node_in_subframes) &&
       !IsWebViewFrame(renderer_context, render_frame);
@@ -187,6 +188,21 @@ void AtomRendererClient::WillReleaseScriptContext(
   electron_bindings_->EnvironmentDestroyed(env);
 }
 
+bool AtomRendererClient::ShouldLoadNodeInSubFrames() const {
+  if (!RendererClientBase::ShouldLoadNodeInSubFrames())
+    return false;
+  // Without node integration and preload scripts nothing in the sub frames
+  // uses Node, so they are left without the isolated world and the Node
+  // environment, which are the most expensive part of creating a frame.
+  // The <webview> tag is implemented with the Electron APIs of its embedder.
+  auto* command_line = base::CommandLine::ForCurrentProcess();
+  return command_line->HasSwitch(switches::kNodeIntegration) ||
+         command_line->HasSwitch(switches::kPreloadScript) ||
+         command_line->HasSwitch(switches::kPreloadScripts) ||
+         command_line->HasSwitch(switches::kWebviewTag) ||
+         command_line->HasSwitch(switches::kContentScriptsInSubFrames);
+}
+
 bool AtomRendererClient::ShouldFork(blink::WebLocalFrame* frame,
                                     const GURL& url,
                                     const std::string& http_method,
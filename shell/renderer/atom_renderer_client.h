@@ -36,6 +36,7 @@ class AtomRendererClient : public RendererClientBase {
   void SetupExtensionWorldOverrides(v8::Handle<v8::Context> context,
                                     content::RenderFrame* render_frame,
                                     int world_id) override;
+  bool ShouldLoadNodeInSubFrames() const override;
 
  private:
   // content::ContentRendererClient:
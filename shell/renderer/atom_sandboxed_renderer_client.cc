@@ -4,11 +4,20 @@
 
 #include "shell/renderer/atom_sandboxed_renderer_client.h"
 
+#include <string.h>
+
+#include <memory>
+#include <string>
+#include <vector>
+
 #include "base/base_paths.h"
 #include "base/command_line.h"
 #include "base/files/file_path.h"
+#include "base/no_destructor.h"
 #include "base/path_service.h"
 #include "base/process/process_handle.h"
+#include "base/strings/string16.h"
+#include "base/strings/string_util.h"
 #include "content/public/renderer/render_frame.h"
 #include "electron/buildflags/buildflags.h"
 #include "shell/common/api/electron_bindings.h"
@@ -18,6 +27,7 @@
 #include "shell/common/node_includes.h"
 #include "shell/common/node_util.h"
 #include "shell/common/options_switches.h"
+#include "shell/common/startup_timeline.h"
 #include "shell/renderer/atom_render_frame_observer.h"
 #include "third_party/blink/public/web/blink.h"
 #include "third_party/blink/public/web/web_document.h"
@@ -65,7 +75,12 @@ v8::Local<v8::Value> GetBinding(v8::Isolate* isolate,
     return exports;
   }
 
-  auto* mod = node::binding::get_linked_module(module_key.c_str());
+  // The modules of the main process are never initialized here, since they
+  // can not work without it.
+  node::node_module* mod = nullptr;
+  if (!base::StartsWith(module_key, "atom_browser_",
+                        base::CompareCase::SENSITIVE))
+    mod = node::binding::get_linked_module(module_key.c_str());
 
   if (!mod) {
     char errmsg[1024];
@@ -83,10 +98,91 @@ v8::Local<v8::Value> GetBinding(v8::Isolate* isolate,
   return exports;
 }
 
+// Compiles and runs the wrapper of a preload script, consuming |cached_data|
+// when it is a code cache. Returns the wrapper function as "preloadFn", and a
+// new code cache as "codeCache" when |cached_data| was missing or rejected.
 v8::Local<v8::Value> CreatePreloadScript(v8::Isolate* isolate,
-                                         v8::Local<v8::String> preloadSrc) {
-  return RendererClientBase::RunScript(isolate->GetCurrentContext(),
-                                       preloadSrc);
+                                         v8::Local<v8::String> preloadSrc,
+                                         v8::Local<v8::Value> cached_data) {
+  v8::Local<v8::Context> context = isolate->GetCurrentContext();
+
+  // The source owns the CachedData, which does not own |data|.
+  std::vector<uint8_t> data;
+  v8::ScriptCompiler::CachedData* cache = nullptr;
+  if (cached_data->IsArrayBufferView()) {
+    auto view = cached_data.As<v8::ArrayBufferView>();
+    data.resize(view->ByteLength());
+    view->CopyContents(data.data(), data.size());
+    cache = new v8::ScriptCompiler::CachedData(data.data(), data.size());
+  }
+  v8::ScriptCompiler::Source source(preloadSrc, cache);
+
+  auto options = cache ? v8::ScriptCompiler::kConsumeCodeCache
+                       : v8::ScriptCompiler::kNoCompileOptions;
+  v8::Local<v8::Script> script;
+  if (!v8::ScriptCompiler::Compile(context, &source, options).ToLocal(&script))
+    return v8::Local<v8::Value>();
+  v8::Local<v8::Value> preload_fn;
+  if (!script->Run(context).ToLocal(&preload_fn))
+    return v8::Local<v8::Value>();
+
+  gin_helper::Dictionary result = gin::Dictionary::CreateEmpty(isolate);
+  result.Set("preloadFn", preload_fn);
+  if (!cache || source.GetCachedData()->rejected) {
+    std::unique_ptr<v8::ScriptCompiler::CachedData> new_cache(
+        v8::ScriptCompiler::CreateCodeCache(script->GetUnboundScript()));
+    if (new_cache) {
+      auto buffer = v8::ArrayBuffer::New(isolate, new_cache->length);
+      memcpy(buffer->GetContents().Data(), new_cache->data, new_cache->length);
+      result.Set("codeCache",
+                 v8::Uint8Array::New(buffer, 0, new_cache->length));
+    }
+  }
+  return result.GetHandle();
+}
+
+// The preload bundle of the session, shared by all the frames of this
+// process, which all belong to the same session.
+struct PreloadBundle {
+  std::string hash;
+  base::string16 source;
+  std::vector<uint8_t> code_cache;
+};
+
+PreloadBundle* GetPreloadBundleStore() {
+  static base::NoDestructor<PreloadBundle> bundle;
+  return bundle.get();
+}
+
+v8::Local<v8::Value> GetPreloadBundle(v8::Isolate* isolate) {
+  PreloadBundle* bundle = GetPreloadBundleStore();
+  if (bundle->hash.empty())
+    return v8::Undefined(isolate);
+  gin_helper::Dictionary result = gin::Dictionary::CreateEmpty(isolate);
+  result.Set("hash", bundle->hash);
+  result.Set("source", bundle->source);
+  if (!bundle->code_cache.empty()) {
+    auto buffer = v8::ArrayBuffer::New(isolate, bundle->code_cache.size());
+    memcpy(buffer->GetContents().Data(), bundle->code_cache.data(),
+           bundle->code_cache.size());
+    result.Set("cache",
+               v8::Uint8Array::New(buffer, 0, bundle->code_cache.size()));
+  }
+  return result.GetHandle();
+}
+
+void SetPreloadBundle(const std::string& hash,
+                      const base::string16& source,
+                      v8::Local<v8::Value> code_cache) {
+  PreloadBundle* bundle = GetPreloadBundleStore();
+  bundle->hash = hash;
+  bundle->source = source;
+  bundle->code_cache.clear();
+  if (code_cache->IsArrayBufferView()) {
+    auto view = code_cache.As<v8::ArrayBufferView>();
+    bundle->code_cache.resize(view->ByteLength());
+    view->CopyContents(bundle->code_cache.data(), bundle->code_cache.size());
+  }
 }
 
 void InvokeHiddenCallback(v8::Handle<v8::Context> context,
@@ -130,6 +226,8 @@ void AtomSandboxedRendererClient::InitializeBindings(
   gin_helper::Dictionary b(isolate, binding);
   b.SetMethod("get", GetBinding);
   b.SetMethod("createPreloadScript", CreatePreloadScript);
+  b.SetMethod("getPreloadBundle", GetPreloadBundle);
+  b.SetMethod("setPreloadBundle", SetPreloadBundle);
 
   gin_helper::Dictionary process = gin::Dictionary::CreateEmpty(isolate);
   b.Set("process", process);
@@ -189,6 +287,7 @@ void AtomSandboxedRendererClient::RunScriptsAtDocumentEnd(
 void AtomSandboxedRendererClient::DidCreateScriptContext(
     v8::Handle<v8::Context> context,
     content::RenderFrame* render_frame) {
+  ScopedStartupPhase startup_phase("DidCreateScriptContext");
   RendererClientBase::DidCreateScriptContext(context, render_frame);
 
   // Only allow preload for the main frame or
@@ -197,9 +296,7 @@ void AtomSandboxedRendererClient::DidCreateScriptContext(
   bool is_main_frame = render_frame->IsMainFrame();
   bool is_devtools =
       IsDevTools(render_frame) || IsDevToolsExtension(render_frame);
-  bool allow_node_in_sub_frames =
-      base::CommandLine::ForCurrentProcess()->HasSwitch(
-          switches::kNodeIntegrationInSubFrames);
+  bool allow_node_in_sub_frames = ShouldLoadNodeInSubFrames();
   bool should_load_preload =
       (is_main_frame || is_devtools || allow_node_in_sub_frames) &&
       !IsWebViewFrame(context, render_frame);
@@ -8,16 +8,23 @@
 #include <utility>
 #include <vector>
 
+#include "base/bind.h"
 #include "base/environment.h"
 #include "base/macros.h"
+#include "base/memory/read_only_shared_memory_region.h"
+#include "base/memory/shared_memory_mapping.h"
+#include "base/memory/unsafe_shared_memory_region.h"
 #include "base/threading/thread_restrictions.h"
+#include "base/threading/thread_task_runner_handle.h"
 #include "mojo/public/cpp/system/platform_handle.h"
 #include "shell/common/atom_constants.h"
 #include "shell/common/gin_converters/blink_converter.h"
 #include "shell/common/gin_converters/value_converter.h"
 #include "shell/common/heap_snapshot.h"
+#include "shell/common/ipc_trace.h"
 #include "shell/common/node_includes.h"
 #include "shell/common/options_switches.h"
+#include "shell/renderer/api/atom_api_peer_channel.h"
 #include "shell/renderer/atom_render_frame_observer.h"
 #include "shell/renderer/renderer_client_base.h"
 #include "third_party/blink/public/web/blink.h"
@@ -92,6 +99,11 @@ void EmitIPCEvent(v8::Local<v8::Context> context,
 
 }  // namespace
 
+ElectronApiServiceImpl::PendingMessage::PendingMessage() = default;
+ElectronApiServiceImpl::PendingMessage::PendingMessage(PendingMessage&&) =
+    default;
+ElectronApiServiceImpl::PendingMessage::~PendingMessage() = default;
+
 ElectronApiServiceImpl::~ElectronApiServiceImpl() = default;
 
 ElectronApiServiceImpl::ElectronApiServiceImpl(
@@ -113,9 +125,17 @@ void ElectronApiServiceImpl::BindTo(
 }
 
 void ElectronApiServiceImpl::DidCreateDocumentElement() {
+  // The messages still waiting were sent to the previous document.
+  pending_messages_.clear();
   document_created_ = true;
 }
 
+void ElectronApiServiceImpl::ReadyToCommitNavigation(
+    blink::WebDocumentLoader* document_loader) {
+  // Emitted while the document they were sent to is still there.
+  FlushPendingMessages();
+}
+
 void ElectronApiServiceImpl::OnDestruct() {
   delete this;
 }
@@ -129,7 +149,13 @@ void ElectronApiServiceImpl::Message(bool internal,
                                      bool send_to_all,
                                      const std::string& channel,
                                      blink::CloneableMessage arguments,
-                                     int32_t sender_id) {
+                                     int32_t sender_id,
+                                     uint64_t trace_id) {
+  TRACE_EVENT_WITH_FLOW1(
+      "electron", "ElectronApiServiceImpl::Message", TRACE_ID_GLOBAL(trace_id),
+      IpcTraceFlowFlags(trace_id, TRACE_EVENT_FLAG_FLOW_IN), "channel",
+      channel);
+
   // Don't handle browser messages before document element is created.
   //
   // Note: It is probably better to save the message and then replay it after
@@ -149,6 +175,29 @@ void ElectronApiServiceImpl::Message(bool internal,
   if (!document_created_)
     return;
 
+  // The messages which arrive in a burst, one task after the other, are all
+  // emitted by the task posted for the first, which saves entering the page
+  // and running the microtasks once per message.
+  if (pending_messages_.empty()) {
+    base::ThreadTaskRunnerHandle::Get()->PostTask(
+        FROM_HERE, base::BindOnce(&ElectronApiServiceImpl::FlushPendingMessages,
+                                  GetWeakPtr()));
+  }
+  PendingMessage message;
+  message.internal = internal;
+  message.send_to_all = send_to_all;
+  message.channel = channel;
+  message.arguments = std::move(arguments);
+  message.sender_id = sender_id;
+  pending_messages_.push_back(std::move(message));
+}
+
+void ElectronApiServiceImpl::FlushPendingMessages() {
+  if (pending_messages_.empty())
+    return;
+  std::vector<PendingMessage> messages = std::move(pending_messages_);
+  pending_messages_.clear();
+
   blink::WebLocalFrame* frame = render_frame()->GetWebFrame();
   if (!frame)
     return;
@@ -159,28 +208,220 @@ void ElectronApiServiceImpl::Message(bool internal,
   v8::Local<v8::Context> context = renderer_client_->GetContext(frame, isolate);
   v8::Context::Scope context_scope(context);
 
-  v8::Local<v8::Value> args = gin::ConvertToV8(isolate, arguments);
+  std::vector<v8::Local<v8::Value>> internal, channels, args, sender_ids;
+  for (const auto& message : messages) {
+    internal.push_back(gin::ConvertToV8(isolate, message.internal));
+    channels.push_back(gin::ConvertToV8(isolate, message.channel));
+    args.push_back(gin::ConvertToV8(isolate, message.arguments));
+    sender_ids.push_back(gin::ConvertToV8(isolate, message.sender_id));
+  }
 
-  EmitIPCEvent(context, internal, channel, args, sender_id);
+  if (messages.size() == 1) {
+    EmitIPCEvent(context, messages[0].internal, messages[0].channel, args[0],
+                 messages[0].sender_id);
+  } else {
+    v8::MicrotasksScope script_scope(isolate,
+                                     v8::MicrotasksScope::kRunMicrotasks);
+    InvokeIpcCallback(
+        context, "onMessages",
+        {gin::ConvertToV8(isolate, internal),
+         gin::ConvertToV8(isolate, channels), gin::ConvertToV8(isolate, args),
+         gin::ConvertToV8(isolate, sender_ids)});
+  }
 
-  // Also send the message to all sub-frames.
+  // Also send the messages to all sub-frames.
   // TODO(MarshallOfSound): Completely move this logic to the main process
-  if (send_to_all) {
+  for (size_t i = 0; i < messages.size(); ++i) {
+    if (!messages[i].send_to_all)
+      continue;
     for (blink::WebFrame* child = frame->FirstChild(); child;
          child = child->NextSibling())
       if (child->IsWebLocalFrame()) {
         v8::Local<v8::Context> child_context =
             renderer_client_->GetContext(child->ToWebLocalFrame(), isolate);
-        EmitIPCEvent(child_context, internal, channel, args, sender_id);
+        EmitIPCEvent(child_context, messages[i].internal, messages[i].channel,
+                     args[i], messages[i].sender_id);
       }
   }
 }
 
+void ElectronApiServiceImpl::MessageWithTransfer(
+    bool internal,
+    const std::string& channel,
+    blink::CloneableMessage arguments,
+    std::vector<mojo_base::BigBuffer> array_buffers,
+    int32_t sender_id) {
+  FlushPendingMessages();
+  // See the comment in Message about messages sent before the document
+  // element is created.
+  if (!document_created_)
+    return;
+  blink::WebLocalFrame* frame = render_frame()->GetWebFrame();
+  if (!frame)
+    return;
+
+  v8::Isolate* isolate = blink::MainThreadIsolate();
+  v8::HandleScope handle_scope(isolate);
+
+  v8::Local<v8::Context> context = renderer_client_->GetContext(frame, isolate);
+  v8::Context::Scope context_scope(context);
+
+  v8::Local<v8::Value> args = gin::DeserializeWithTransfer(
+      isolate, arguments, std::move(array_buffers));
+
+  EmitIPCEvent(context, internal, channel, args, sender_id);
+}
+
+void ElectronApiServiceImpl::MessageShared(
+    bool internal,
+    const std::string& channel,
+    base::ReadOnlySharedMemoryRegion arguments,
+    int32_t sender_id) {
+  FlushPendingMessages();
+  // See the comment in Message about messages sent before the document
+  // element is created.
+  if (!document_created_)
+    return;
+  blink::WebLocalFrame* frame = render_frame()->GetWebFrame();
+  if (!frame)
+    return;
+
+  base::ReadOnlySharedMemoryMapping mapping = arguments.Map();
+  if (!mapping.IsValid())
+    return;
+
+  v8::Isolate* isolate = blink::MainThreadIsolate();
+  v8::HandleScope handle_scope(isolate);
+
+  v8::Local<v8::Context> context = renderer_client_->GetContext(frame, isolate);
+  v8::Context::Scope context_scope(context);
+
+  // The message is deserialized straight from the mapping.
+  blink::CloneableMessage message;
+  message.encoded_message = mapping.GetMemoryAsSpan<uint8_t>();
+  v8::Local<v8::Value> args = gin::ConvertToV8(isolate, message);
+
+  EmitIPCEvent(context, internal, channel, args, sender_id);
+}
+
+void ElectronApiServiceImpl::ReceiveSharedMemory(
+    const std::string& channel,
+    base::UnsafeSharedMemoryRegion region,
+    bool as_shared_array_buffer,
+    int32_t sender_id) {
+  FlushPendingMessages();
+  // See the comment in Message about messages sent before the document
+  // element is created.
+  if (!document_created_)
+    return;
+  blink::WebLocalFrame* frame = render_frame()->GetWebFrame();
+  if (!frame)
+    return;
+
+  auto mapping =
+      std::make_unique<base::WritableSharedMemoryMapping>(region.Map());
+  if (!mapping->IsValid())
+    return;
+
+  v8::Isolate* isolate = blink::MainThreadIsolate();
+  v8::HandleScope handle_scope(isolate);
+
+  v8::Local<v8::Context> context = renderer_client_->GetContext(frame, isolate);
+  v8::Context::Scope context_scope(context);
+
+  // The buffer owns the mapping, and unmaps it once it is collected.
+  void* data = mapping->memory();
+  size_t size = mapping->size();
+  v8::BackingStore::DeleterCallback deleter = [](void* data, size_t length,
+                                                 void* mapping) {
+    delete static_cast<base::WritableSharedMemoryMapping*>(mapping);
+  };
+  v8::Local<v8::Value> buffer;
+  if (as_shared_array_buffer) {
+    buffer = v8::SharedArrayBuffer::New(
+        isolate, v8::SharedArrayBuffer::NewBackingStore(data, size, deleter,
+                                                        mapping.release()));
+  } else {
+    buffer = v8::ArrayBuffer::New(
+        isolate, v8::ArrayBuffer::NewBackingStore(data, size, deleter,
+                                                  mapping.release()));
+  }
+
+  EmitIPCEvent(context, false, channel, v8::Array::New(isolate, &buffer, 1),
+               sender_id);
+}
+
+void ElectronApiServiceImpl::MessageBatch(
+    bool internal,
+    const std::vector<std::string>& channels,
+    blink::CloneableMessage arguments,
+    bool as_arrays,
+    int32_t sender_id) {
+  FlushPendingMessages();
+  // See the comment in Message about messages sent before the document
+  // element is created.
+  if (!document_created_)
+    return;
+  blink::WebLocalFrame* frame = render_frame()->GetWebFrame();
+  if (!frame)
+    return;
+
+  v8::Isolate* isolate = blink::MainThreadIsolate();
+  v8::HandleScope handle_scope(isolate);
+
+  v8::Local<v8::Context> context = renderer_client_->GetContext(frame, isolate);
+  v8::Context::Scope context_scope(context);
+  v8::MicrotasksScope script_scope(isolate,
+                                   v8::MicrotasksScope::kRunMicrotasks);
+
+  v8::Local<v8::Value> args = gin::ConvertToV8(isolate, arguments);
+  if (!args->IsArray() || args.As<v8::Array>()->Length() != channels.size())
+    return;
+
+  std::vector<v8::Local<v8::Value>> argv = {
+      gin::ConvertToV8(isolate, internal),
+      gin::ConvertToV8(isolate, channels), args,
+      gin::ConvertToV8(isolate, as_arrays),
+      gin::ConvertToV8(isolate, sender_id)};
+
+  InvokeIpcCallback(context, "onMessageBatch", argv);
+}
+
+void ElectronApiServiceImpl::ReceivePeerChannel(
+    const std::string& channel,
+    mojom::ElectronPeerChannelEndpointPtr endpoint,
+    int32_t sender_id) {
+  FlushPendingMessages();
+  // Dropping the endpoint closes the channel, which the opener sees as a
+  // 'close' event.
+  if (!document_created_)
+    return;
+  blink::WebLocalFrame* frame = render_frame()->GetWebFrame();
+  if (!frame)
+    return;
+
+  v8::Isolate* isolate = blink::MainThreadIsolate();
+  v8::HandleScope handle_scope(isolate);
+
+  v8::Local<v8::Context> context = renderer_client_->GetContext(frame, isolate);
+  v8::Context::Scope context_scope(context);
+  v8::MicrotasksScope script_scope(isolate,
+                                   v8::MicrotasksScope::kRunMicrotasks);
+
+  std::vector<v8::Local<v8::Value>> argv = {
+      gin::ConvertToV8(isolate, channel),
+      api::PeerChannel::Create(isolate, std::move(endpoint)).ToV8(),
+      gin::ConvertToV8(isolate, sender_id)};
+
+  InvokeIpcCallback(context, "onPeerChannel", argv);
+}
+
 #if BUILDFLAG(ENABLE_REMOTE_MODULE)
-void ElectronApiServiceImpl::DereferenceRemoteJSCallback(
+void ElectronApiServiceImpl::DereferenceRemoteJSCallbacks(
     const std::string& context_id,
-    int32_t object_id) {
-  const auto* channel = "ELECTRON_RENDERER_RELEASE_CALLBACK";
+    const std::vector<int32_t>& object_ids) {
+  const auto* channel = "ELECTRON_RENDERER_RELEASE_CALLBACKS";
+  FlushPendingMessages();
   if (!document_created_)
     return;
   blink::WebLocalFrame* frame = render_frame()->GetWebFrame();
@@ -195,7 +436,8 @@ void ElectronApiServiceImpl::DereferenceRemoteJSCallback(
 
   base::ListValue args;
   args.AppendString(context_id);
-  args.AppendInteger(object_id);
+  for (int32_t object_id : object_ids)
+    args.AppendInteger(object_id);
 
   v8::Local<v8::Value> v8_args = gin::ConvertToV8(isolate, args);
   EmitIPCEvent(context, true /* internal */, channel, v8_args,
@@ -231,4 +473,18 @@ void ElectronApiServiceImpl::TakeHeapSnapshot(
   std::move(callback).Run(success);
 }
 
+void ElectronApiServiceImpl::TakeHeapSnapshotToPipe(
+    mojo::ScopedDataPipeProducerHandle pipe,
+    TakeHeapSnapshotToPipeCallback callback) {
+  bool success =
+      electron::TakeHeapSnapshot(blink::MainThreadIsolate(), std::move(pipe));
+
+  std::move(callback).Run(success);
+}
+
+void ElectronApiServiceImpl::NotifyMemoryPressure(
+    base::MemoryPressureListener::MemoryPressureLevel level) {
+  base::MemoryPressureListener::NotifyMemoryPressure(level);
+}
+
 }  // namespace electron
@@ -6,7 +6,9 @@
 #define SHELL_RENDERER_ELECTRON_API_SERVICE_IMPL_H_
 
 #include <string>
+#include <vector>
 
+#include "base/memory/memory_pressure_listener.h"
 #include "base/memory/weak_ptr.h"
 #include "content/public/renderer/render_frame.h"
 #include "content/public/renderer/render_frame_observer.h"
@@ -32,24 +34,73 @@ class ElectronApiServiceImpl : public mojom::ElectronRenderer,
                bool send_to_all,
                const std::string& channel,
                blink::CloneableMessage arguments,
-               int32_t sender_id) override;
+               int32_t sender_id,
+               uint64_t trace_id) override;
+  void MessageWithTransfer(
+      bool internal,
+      const std::string& channel,
+      blink::CloneableMessage arguments,
+      std::vector<mojo_base::BigBuffer> array_buffers,
+      int32_t sender_id) override;
+  void MessageShared(bool internal,
+                     const std::string& channel,
+                     base::ReadOnlySharedMemoryRegion arguments,
+                     int32_t sender_id) override;
+  void ReceiveSharedMemory(const std::string& channel,
+                           base::UnsafeSharedMemoryRegion region,
+                           bool as_shared_array_buffer,
+                           int32_t sender_id) override;
+  void MessageBatch(bool internal,
+                    const std::vector<std::string>& channels,
+                    blink::CloneableMessage arguments,
+                    bool as_arrays,
+                    int32_t sender_id) override;
+  void ReceivePeerChannel(const std::string& channel,
+                          mojom::ElectronPeerChannelEndpointPtr endpoint,
+                          int32_t sender_id) override;
 #if BUILDFLAG(ENABLE_REMOTE_MODULE)
-  void DereferenceRemoteJSCallback(const std::string& context_id,
-                                   int32_t object_id) override;
+  void DereferenceRemoteJSCallbacks(
+      const std::string& context_id,
+      const std::vector<int32_t>& object_ids) override;
 #endif
   void UpdateCrashpadPipeName(const std::string& pipe_name) override;
   void TakeHeapSnapshot(mojo::ScopedHandle file,
                         TakeHeapSnapshotCallback callback) override;
+  void TakeHeapSnapshotToPipe(
+      mojo::ScopedDataPipeProducerHandle pipe,
+      TakeHeapSnapshotToPipeCallback callback) override;
+  void NotifyMemoryPressure(
+      base::MemoryPressureListener::MemoryPressureLevel level) override;
 
   base::WeakPtr<ElectronApiServiceImpl> GetWeakPtr() {
     return weak_factory_.GetWeakPtr();
   }
 
  private:
+  // A message received by Message, waiting to be emitted.
+  struct PendingMessage {
+    PendingMessage();
+    PendingMessage(PendingMessage&&);
+    ~PendingMessage();
+
+    bool internal = false;
+    bool send_to_all = false;
+    std::string channel;
+    blink::CloneableMessage arguments;
+    int32_t sender_id = 0;
+  };
+
   ~ElectronApiServiceImpl() override;
 
+  // Emits the messages received by Message since the last flush, with a
+  // single call into the page. The other kinds of messages flush them first,
+  // so they are all emitted in the order they were sent.
+  void FlushPendingMessages();
+
   // RenderFrameObserver implementation.
   void DidCreateDocumentElement() override;
+  void ReadyToCommitNavigation(
+      blink::WebDocumentLoader* document_loader) override;
   void OnDestruct() override;
 
   void OnConnectionError();
@@ -57,6 +108,8 @@ class ElectronApiServiceImpl : public mojom::ElectronRenderer,
   // Whether the DOM document element has been created.
   bool document_created_ = false;
 
+  std::vector<PendingMessage> pending_messages_;
+
   mojo::AssociatedReceiver<mojom::ElectronRenderer> receiver_{this};
 
   RendererClientBase* renderer_client_;
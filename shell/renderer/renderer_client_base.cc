@@ -17,13 +17,18 @@
 #include "content/public/common/content_constants.h"
 #include "content/public/common/content_switches.h"
 #include "content/public/renderer/render_frame.h"
+#include "content/public/renderer/render_frame_visitor.h"
 #include "content/public/renderer/render_thread.h"
 #include "content/public/renderer/render_view.h"
 #include "electron/buildflags/buildflags.h"
 #include "printing/buildflags/buildflags.h"
+#include "services/service_manager/public/cpp/interface_provider.h"
+#include "shell/common/api/api.mojom.h"
+#include "shell/common/asar/asar_util.h"
 #include "shell/common/color_util.h"
 #include "shell/common/gin_helper/dictionary.h"
 #include "shell/common/options_switches.h"
+#include "shell/common/startup_timeline.h"
 #include "shell/renderer/atom_autofill_agent.h"
 #include "shell/renderer/atom_render_frame_observer.h"
 #include "shell/renderer/content_settings_observer.h"
@@ -87,6 +92,41 @@ std::vector<std::string> ParseSchemesCLISwitch(base::CommandLine* command_line,
                            base::SPLIT_WANT_NONEMPTY);
 }
 
+class NearHeapLimitNotifier : public content::RenderFrameVisitor {
+ public:
+  NearHeapLimitNotifier(size_t current_heap_limit, size_t initial_heap_limit)
+      : current_heap_limit_(current_heap_limit),
+        initial_heap_limit_(initial_heap_limit) {}
+
+  bool Visit(content::RenderFrame* render_frame) override {
+    if (render_frame->IsMainFrame()) {
+      mojom::ElectronBrowserPtr browser_ptr;
+      render_frame->GetRemoteInterfaces()->GetInterface(
+          mojo::MakeRequest(&browser_ptr));
+      browser_ptr->NotifyNearHeapLimit(current_heap_limit_,
+                                       initial_heap_limit_);
+    }
+    return true;
+  }
+
+ private:
+  size_t current_heap_limit_;
+  size_t initial_heap_limit_;
+
+  DISALLOW_COPY_AND_ASSIGN(NearHeapLimitNotifier);
+};
+
+// Tells the pages of the process that V8 is about to run out of memory, and
+// raises the limit so they get to react. It is restored once the heap shrinks
+// again, so the pages are told again the next time it grows.
+size_t OnNearHeapLimit(void* data,
+                       size_t current_heap_limit,
+                       size_t initial_heap_limit) {
+  NearHeapLimitNotifier notifier(current_heap_limit, initial_heap_limit);
+  content::RenderFrame::ForEach(&notifier);
+  return current_heap_limit + initial_heap_limit / 4;
+}
+
 }  // namespace
 
 RendererClientBase::RendererClientBase() {
@@ -118,8 +158,16 @@ void RendererClientBase::DidCreateScriptContext(
   gin_helper::Dictionary global(context->GetIsolate(), context->Global());
   global.SetHidden("contextId", context_id);
 
-#if BUILDFLAG(ENABLE_REMOTE_MODULE)
   auto* command_line = base::CommandLine::ForCurrentProcess();
+  if (!near_heap_limit_callback_added_ &&
+      command_line->HasSwitch(switches::kNearHeapLimitEvent)) {
+    near_heap_limit_callback_added_ = true;
+    v8::Isolate* isolate = context->GetIsolate();
+    isolate->AddNearHeapLimitCallback(&OnNearHeapLimit, nullptr);
+    isolate->AutomaticallyRestoreInitialHeapLimit();
+  }
+
+#if BUILDFLAG(ENABLE_REMOTE_MODULE)
   bool enableRemoteModule =
       command_line->HasSwitch(switches::kEnableRemoteModule);
   global.SetHidden("enableRemoteModule", enableRemoteModule);
@@ -131,6 +179,7 @@ void RendererClientBase::AddRenderBindings(
     v8::Local<v8::Object> binding_object) {}
 
 void RendererClientBase::RenderThreadStarted() {
+  ScopedStartupPhase startup_phase("RendererClientBase::RenderThreadStarted");
   auto* command_line = base::CommandLine::ForCurrentProcess();
 
 #if BUILDFLAG(USE_EXTERNAL_POPUP_MENU)
@@ -216,6 +265,8 @@ void RendererClientBase::RenderThreadStarted() {
     SetCurrentProcessExplicitAppUserModelID(app_id.c_str());
   }
 #endif
+
+  asar::ClearArchivesOnMemoryPressure();
 }
 
 void RendererClientBase::RenderFrameCreated(
@@ -391,6 +442,11 @@ extensions::ExtensionsClient* RendererClientBase::CreateExtensionsClient() {
 }
 #endif
 
+bool RendererClientBase::ShouldLoadNodeInSubFrames() const {
+  return base::CommandLine::ForCurrentProcess()->HasSwitch(
+      switches::kNodeIntegrationInSubFrames);
+}
+
 bool RendererClientBase::IsWebViewFrame(
     v8::Handle<v8::Context> context,
     content::RenderFrame* render_frame) const {
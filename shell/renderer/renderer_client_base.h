@@ -82,6 +82,10 @@ class RendererClientBase : public content::ContentRendererClient
   bool IsWebViewFrame(v8::Handle<v8::Context> context,
                       content::RenderFrame* render_frame) const;
 
+  // Whether the sub frames get the isolated world and the Electron APIs of
+  // the main frame.
+  virtual bool ShouldLoadNodeInSubFrames() const;
+
  protected:
   void AddRenderBindings(v8::Isolate* isolate,
                          v8::Local<v8::Object> binding_object);
@@ -122,6 +126,7 @@ class RendererClientBase : public content::ContentRendererClient
   std::string renderer_client_id_;
   // An increasing ID used for indentifying an V8 context in this process.
   int64_t next_context_id_ = 0;
+  bool near_heap_limit_callback_added_ = false;
 
 #if BUILDFLAG(ENABLE_BUILTIN_SPELLCHECKER)
   std::unique_ptr<SpellCheck> spellcheck_;
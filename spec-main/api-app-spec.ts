@@ -290,6 +290,29 @@ describe('app module', () => {
       const appPath = path.join(fixturesPath, 'api', 'relaunch')
       cp.spawn(process.execPath, [appPath])
     })
+
+    it('hands off state to the relaunched app', function (done) {
+      this.timeout(120000)
+
+      let state = 'none'
+      server!.once('error', error => done(error))
+      server!.on('connection', client => {
+        client.once('data', data => {
+          const handoff = JSON.parse(String(data))
+          if (handoff === null && state === 'none') {
+            state = 'first-launch'
+          } else if (state === 'first-launch') {
+            expect(handoff).to.deep.equal({ bounds: { x: 1, y: 2, width: 300, height: 400 } })
+            done()
+          } else {
+            done(`Unexpected state: ${state}`)
+          }
+        })
+      })
+
+      const appPath = path.join(fixturesPath, 'api', 'relaunch-handoff')
+      cp.spawn(process.execPath, [appPath])
+    })
   })
 
   describe('app.setUserActivity(type, userInfo)', () => {
@@ -1012,6 +1035,156 @@ describe('app module', () => {
     })
   })
 
+  describe('startProcessMetricsSampling() API', () => {
+    afterEach(() => {
+      app.stopProcessMetricsSampling()
+    })
+
+    it('throws when the interval is not positive', () => {
+      expect(() => app.startProcessMetricsSampling(0)).to.throw(/interval must be a positive number/)
+    })
+
+    it('emits a sample of every process', async () => {
+      app.startProcessMetricsSampling(100)
+      const [, sample] = await emittedOnce(app, 'process-metrics')
+      const count = sample.pid.length
+      expect(count).to.be.at.least(1)
+      expect(sample.interval).to.be.a('number').that.is.greaterThan(0)
+      expect(sample.pid).to.be.an.instanceOf(Int32Array)
+      for (const key of ['cpuTime', 'privateMemory', 'gpuMemory', 'ioReadBytes', 'ioWriteBytes']) {
+        expect(sample[key]).to.be.an.instanceOf(Float64Array)
+        expect(sample[key]).to.have.lengthOf(count)
+      }
+      expect(sample.webContentsId).to.have.lengthOf(count)
+      expect(sample.handles).to.have.lengthOf(count)
+      expect(sample.type).to.include('Browser')
+
+      const browser = sample.type.indexOf('Browser')
+      expect(sample.pid[browser]).to.equal(process.pid)
+      expect(sample.webContentsId[browser]).to.equal(-1)
+      expect(sample.privateMemory[browser]).to.be.greaterThan(0)
+    })
+
+    it('stops emitting samples', async () => {
+      app.startProcessMetricsSampling(10)
+      await emittedOnce(app, 'process-metrics')
+      app.stopProcessMetricsSampling()
+      let emitted = false
+      const listener = () => { emitted = true }
+      app.on('process-metrics', listener)
+      await new Promise(resolve => setTimeout(resolve, 100))
+      app.removeListener('process-metrics', listener)
+      expect(emitted).to.be.false('emitted')
+    })
+  })
+
+  describe('startHangWatchdog() API', () => {
+    afterEach(() => {
+      app.stopHangWatchdog()
+    })
+
+    it('throws without a threshold', () => {
+      expect(() => app.startHangWatchdog({} as any)).to.throw(/threshold must be a positive number/)
+    })
+
+    it('reports the JavaScript stack of a hang', async () => {
+      app.startHangWatchdog({ threshold: 100 })
+      // Lets the watchdog see the main thread respond once.
+      await new Promise(resolve => setTimeout(resolve, 50))
+      const unresponsive = emittedOnce(app, 'main-process-unresponsive')
+      const blockMainThread = () => {
+        const end = Date.now() + 500
+        while (Date.now() < end) {}
+      }
+      blockMainThread()
+      const [, details] = await unresponsive
+      expect(details.duration).to.be.at.least(100)
+      expect(details.jsStack.some((frame: string) => frame.startsWith('blockMainThread'))).to.be.true('blockMainThread')
+      expect(details.nativeStacks).to.be.an('array')
+      expect(details.minidumpWritten).to.be.false('minidumpWritten')
+    })
+
+    it('does not report a responsive main thread', async () => {
+      app.startHangWatchdog({ threshold: 200 })
+      let emitted = false
+      const listener = () => { emitted = true }
+      app.on('main-process-unresponsive', listener)
+      await new Promise(resolve => setTimeout(resolve, 500))
+      app.removeListener('main-process-unresponsive', listener)
+      expect(emitted).to.be.false('emitted')
+    })
+  })
+
+  describe('startProfiling() API', () => {
+    const profilePath = path.join(app.getPath('temp'), 'electron-main.cpuprofile')
+
+    afterEach(async () => {
+      await app.stopProfiling(profilePath).catch(() => {})
+      fs.unlinkSync(profilePath)
+    })
+
+    it('writes a .cpuprofile of the main process', async () => {
+      app.startProfiling({ intervalUs: 500 })
+      expect(() => app.startProfiling()).to.throw(/already profiled/)
+      const busyFunction = () => {
+        const end = Date.now() + 200
+        while (Date.now() < end) {}
+      }
+      busyFunction()
+      await app.stopProfiling(profilePath)
+
+      const profile = JSON.parse(fs.readFileSync(profilePath, 'utf8'))
+      expect(profile.nodes).to.be.an('array').that.is.not.empty()
+      expect(profile.samples).to.have.lengthOf(profile.timeDeltas.length)
+      expect(profile.endTime).to.be.at.least(profile.startTime)
+      const names = profile.nodes.map((node: any) => node.callFrame.functionName)
+      expect(names).to.include('busyFunction')
+    })
+
+    it('rejects when the main process is not profiled', async () => {
+      fs.writeFileSync(profilePath, '')
+      await expect(app.stopProfiling(profilePath)).to.eventually.be.rejectedWith(/not profiled/)
+    })
+  })
+
+  describe('purgeMemory() API', () => {
+    afterEach(closeAllWindows)
+
+    it('emits memory-pressure with the level', async () => {
+      const w = new BrowserWindow({ show: false })
+      await w.loadURL('about:blank')
+      const memoryPressure = emittedOnce(app, 'memory-pressure')
+      app.purgeMemory('critical')
+      const [, level] = await memoryPressure
+      expect(level).to.equal('critical')
+      // The renderer keeps working after dropping its caches.
+      expect(await w.webContents.executeJavaScript('1 + 1')).to.equal(2)
+    })
+
+    it('throws for an invalid level', () => {
+      expect(() => app.purgeMemory('low' as any)).to.throw(/level must be/)
+    })
+  })
+
+  describe('getStartupTimeline() API', () => {
+    it('returns the finished phases of starting the main process', () => {
+      const timeline = app.getStartupTimeline()
+      const names = timeline.map(phase => phase.name)
+      expect(names).to.include.members([
+        'AtomBrowserMainParts::PreMainMessageLoopRun',
+        'NodeBindings::LoadEnvironment',
+        'browser-init',
+        'ready'
+      ])
+      for (const phase of timeline) {
+        expect(phase.startTime).to.be.a('number').that.is.greaterThan(0)
+        expect(phase.duration).to.be.a('number').and.be.at.least(0)
+      }
+      const startTimes = timeline.map(phase => phase.startTime)
+      expect(startTimes).to.deep.equal([...startTimes].sort((a, b) => a - b))
+    })
+  })
+
   describe('getGPUFeatureStatus() API', () => {
     it('returns the graphic features statuses', () => {
       const features = app.getGPUFeatureStatus()
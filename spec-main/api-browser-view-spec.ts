@@ -175,6 +175,44 @@ describe('BrowserView module', () => {
     })
   })
 
+  describe('BrowserWindow.setBrowserViewBounds()', () => {
+    it('sets the bounds of every view', () => {
+      const view1 = new BrowserView()
+      w.addBrowserView(view1)
+      const view2 = new BrowserView()
+      w.addBrowserView(view2)
+
+      const bounds1 = { x: 0, y: 0, width: 200, height: 400 }
+      const bounds2 = { x: 200, y: 0, width: 200, height: 400 }
+      w.setBrowserViewBounds([
+        { view: view1, bounds: bounds1 },
+        { view: view2, bounds: bounds2 }
+      ])
+      expect(view1.getBounds()).to.deep.equal(bounds1)
+      expect(view2.getBounds()).to.deep.equal(bounds2)
+
+      view1.destroy()
+      view2.destroy()
+    })
+
+    it('changes nothing when an entry is invalid', () => {
+      view = new BrowserView()
+      w.addBrowserView(view)
+      const bounds = { x: 10, y: 20, width: 30, height: 40 }
+      view.setBounds(bounds)
+
+      const detached = new BrowserView()
+      expect(() => {
+        w.setBrowserViewBounds([
+          { view, bounds: { x: 0, y: 0, width: 100, height: 100 } },
+          { view: detached, bounds: { x: 0, y: 0, width: 100, height: 100 } }
+        ])
+      }).to.throw(/not attached/)
+      expect(view.getBounds()).to.deep.equal(bounds)
+      detached.destroy()
+    })
+  })
+
   describe('BrowserView.webContents.getOwnerBrowserWindow()', () => {
     it('points to owning window', () => {
       view = new BrowserView()
@@ -5,10 +5,10 @@ import * as os from 'os'
 import * as qs from 'querystring'
 import * as http from 'http'
 import { AddressInfo } from 'net'
-import { app, BrowserWindow, BrowserView, ipcMain, OnBeforeSendHeadersListenerDetails, protocol, screen, webContents, session, WebContents } from 'electron'
+import { app, BrowserWindow, BrowserView, ipcMain, OnBeforeSendHeadersListenerDetails, powerMonitor, protocol, screen, webContents, session, WebContents } from 'electron'
 
 import { emittedOnce } from './events-helpers'
-import { ifit, ifdescribe } from './spec-helpers'
+import { ifit, ifdescribe, delay } from './spec-helpers'
 import { closeWindow } from './window-helpers'
 
 const fixtures = path.resolve(__dirname, '..', 'spec', 'fixtures')
@@ -731,6 +731,32 @@ describe('BrowserWindow module', () => {
       })
     })
 
+    describe('BrowserWindow.setCoalesceResizeEvents(coalesce)', () => {
+      it('emits one resize event for the last size of a frame', async () => {
+        w.setCoalesceResizeEvents(true)
+        expect(w.isCoalescingResizeEvents()).to.be.true('coalescing')
+        // The first resize is emitted at once, and the others at the end of
+        // the frame.
+        let count = 0
+        w.on('resize', () => { count++ })
+        w.setSize(300, 300)
+        w.setSize(310, 310)
+        w.setSize(320, 320)
+        await emittedOnce(w, 'resize')
+        expect(count).to.be.at.most(2)
+        expectBoundsEqual(w.getSize(), [320, 320])
+        w.setCoalesceResizeEvents(false)
+      })
+    })
+
+    describe('BrowserWindow.getResizeLatency()', () => {
+      it('returns the resize latency', () => {
+        const latency = w.getResizeLatency()
+        expect(latency).to.have.all.keys('count', 'last', 'average', 'max')
+        expect(latency.count).to.be.a('number')
+      })
+    })
+
     describe('BrowserWindow.setMinimum/MaximumSize(width, height)', () => {
       it('sets the maximum and minimum size of the window', () => {
         expect(w.getMinimumSize()).to.deep.equal([0, 0])
@@ -1057,6 +1083,42 @@ describe('BrowserWindow module', () => {
       // Values can be 0,2,3,4, or 6. We want 6, which is RGB + Alpha
       expect(imgBuffer[25]).to.equal(6)
     })
+
+    it('scales the snapshot to the given size', async () => {
+      const w = new BrowserWindow({ show: false, width: 400, height: 400 })
+      w.loadURL('about:blank')
+      await emittedOnce(w, 'ready-to-show')
+      w.show()
+
+      const image = await w.capturePage(undefined, { size: { width: 40, height: 30 } })
+      expect(image.getSize()).to.deep.equal({ width: 40, height: 30 })
+    })
+
+    it('rejects invalid options', async () => {
+      const w = new BrowserWindow({ show: false })
+      await expect(w.webContents.capturePage(undefined, { scale: -1 })).to.eventually.be.rejectedWith('scale must be greater than 0')
+    })
+  })
+
+  describe('webContents.capturePageBuffer()', () => {
+    afterEach(closeAllWindows)
+
+    it('resolves with an encoded snapshot', async () => {
+      const w = new BrowserWindow({ show: false, width: 400, height: 400 })
+      w.loadURL('about:blank')
+      await emittedOnce(w, 'ready-to-show')
+      w.show()
+
+      const png = await w.webContents.capturePageBuffer(undefined, { size: { width: 40, height: 30 } })
+      expect(png.slice(1, 4).toString()).to.equal('PNG')
+
+      const jpeg = await w.webContents.capturePageBuffer(undefined, { size: { width: 40, height: 30 }, format: 'jpeg', quality: 50 })
+      expect(jpeg[0]).to.equal(0xff)
+      expect(jpeg[1]).to.equal(0xd8)
+
+      const raw = await w.webContents.capturePageBuffer(undefined, { size: { width: 40, height: 30 }, format: 'raw' })
+      expect(raw.length).to.equal(40 * 30 * 4)
+    })
   })
 
   describe('BrowserWindow.setProgressBar(progress)', () => {
@@ -1298,6 +1360,48 @@ describe('BrowserWindow module', () => {
       const w = new BrowserWindow({ show: false })
       expect(BrowserWindow.fromId(w.id).id).to.equal(w.id)
     })
+
+    it('does not return a newer window for the id of a destroyed one', () => {
+      const w = new BrowserWindow({ show: false })
+      const { id } = w
+      w.destroy()
+      const w2 = new BrowserWindow({ show: false })
+      expect(w2.id).to.not.equal(id)
+      expect(BrowserWindow.fromId(id)).to.be.null()
+      expect(BrowserWindow.fromId(w2.id)).to.equal(w2)
+    })
+  })
+
+  describe('BrowserWindow.createPool(options)', () => {
+    afterEach(closeAllWindows)
+
+    it('hands out a window with its preload already run', async () => {
+      const preload = path.join(fixtures, 'module', 'set-global.js')
+      const pool = BrowserWindow.createPool({ size: 1, refillDelay: 0, windowOptions: { webPreferences: { preload } } })
+      const [, ready] = await emittedOnce(pool, 'window-ready')
+      expect(pool.readyCount).to.equal(1)
+      const w = pool.acquire()
+      expect(w).to.equal(ready)
+      expect(w.isVisible()).to.be.false('isVisible')
+      expect(w.webContents.getURL()).to.equal('about:blank')
+      expect(await w.webContents.executeJavaScript('window.test')).to.equal('preload')
+      expect(pool.readyCount).to.equal(0)
+      pool.destroy()
+    })
+
+    it('validates the size', () => {
+      expect(() => BrowserWindow.createPool({ size: -1 })).to.throw('size must be a non-negative integer')
+    })
+
+    it('does not keep the app running once the windows created before it are closed', async () => {
+      const w = new BrowserWindow({ show: false })
+      const pool = BrowserWindow.createPool({ size: 1, refillDelay: 0 })
+      await emittedOnce(pool, 'window-ready')
+      const allClosed = emittedOnce(app, 'window-all-closed')
+      w.close()
+      await allClosed
+      expect(BrowserWindow.getAllWindows()).to.be.empty()
+    })
   })
 
   describe('BrowserWindow.fromWebContents(webContents)', () => {
@@ -1717,6 +1821,50 @@ describe('BrowserWindow module', () => {
       })
     })
 
+    describe('"v8HeapPolicy" option', () => {
+      it('passes the heap limits and GC mode to V8 in the renderer process', async () => {
+        const preload = path.join(fixtures, 'module', 'check-arguments.js')
+        const w = new BrowserWindow({
+          show: false,
+          webPreferences: {
+            nodeIntegration: true,
+            preload,
+            v8HeapPolicy: { maxOldSpaceSize: 512, maxSemiSpaceSize: 8, memorySaver: true }
+          }
+        })
+        w.loadFile(path.join(fixtures, 'api', 'blank.html'))
+        const [, argv] = await emittedOnce(ipcMain, 'answer')
+        const jsFlags = (argv as string[]).find(arg => arg.startsWith('--js-flags='))
+        expect(jsFlags).to.be.a('string')
+        expect(jsFlags!.substr('--js-flags='.length).split(' ')).to.include.members([
+          '--max-old-space-size=512', '--max-semi-space-size=8', '--optimize-for-size'
+        ])
+      })
+
+      it('emits near-heap-limit before the renderer runs out of memory', async () => {
+        const w = new BrowserWindow({
+          show: false,
+          webPreferences: { v8HeapPolicy: { maxOldSpaceSize: 64 } }
+        })
+        await w.loadFile(path.join(fixtures, 'api', 'blank.html'))
+        const nearHeapLimit = emittedOnce(w.webContents, 'near-heap-limit')
+        // The page keeps a megabyte more every few milliseconds, and lets it go
+        // once it is told about the limit.
+        w.webContents.executeJavaScript(`
+          window.retained = []
+          window.allocation = setInterval(() => {
+            window.retained.push(new Array(128 * 1024).fill(Math.random()))
+          }, 5)
+          null
+        `)
+        const [, currentHeapLimit, initialHeapLimit] = await nearHeapLimit
+        await w.webContents.executeJavaScript('clearInterval(window.allocation); window.retained = null')
+        expect(initialHeapLimit).to.be.greaterThan(0)
+        expect(currentHeapLimit).to.be.at.least(initialHeapLimit)
+        expect(w.webContents.isCrashed()).to.be.false('crashed')
+      })
+    })
+
     describe('"node-integration" option', () => {
       it('disables node integration by default', async () => {
         const preload = path.join(fixtures, 'module', 'send-later.js')
@@ -1820,6 +1968,29 @@ describe('BrowserWindow module', () => {
         expect(test).to.equal('preload')
       })
 
+      it('stores a code cache for the preload script of persistent sessions', async () => {
+        const ses = session.fromPartition(`persist:preload-code-cache-${Math.random()}`)
+        const cachePath = (ses as any)._getPreloadCodeCachePath()
+        const webPreferences = { sandbox: true, preload, session: ses }
+
+        const w = new BrowserWindow({ show: false, webPreferences })
+        w.loadFile(path.join(fixtures, 'api', 'preload.html'))
+        const [, test] = await emittedOnce(ipcMain, 'answer')
+        expect(test).to.equal('preload')
+
+        // The cache is written in the background.
+        while (!fs.existsSync(cachePath) || fs.readdirSync(cachePath).length === 0) {
+          await delay(50)
+        }
+        expect(fs.readdirSync(cachePath)).to.have.lengthOf(1)
+
+        // Windows opened later consume the cache.
+        const w2 = new BrowserWindow({ show: false, webPreferences })
+        w2.loadFile(path.join(fixtures, 'api', 'preload.html'))
+        const [, test2] = await emittedOnce(ipcMain, 'answer')
+        expect(test2).to.equal('preload')
+      })
+
       it('exposes ipcRenderer to preload script (path has special chars)', async () => {
         const preloadSpecialChars = path.join(fixtures, 'module', 'preload-sandboxæø åü.js')
         const w = new BrowserWindow({
@@ -2797,6 +2968,62 @@ describe('BrowserWindow module', () => {
       w.loadFile(path.join(fixtures, 'api', 'frame-subscriber.html'))
     })
 
+    it('subscribes to I420 frames of a given size', (done) => {
+      const w = new BrowserWindow({ show: false })
+      let called = false
+      w.loadFile(path.join(fixtures, 'api', 'frame-subscriber.html'))
+      w.webContents.on('dom-ready', () => {
+        const options = { pixelFormat: 'i420', size: { width: 64, height: 32 } }
+        w.webContents.beginFrameSubscription(options as any, (frame: any) => {
+          // This callback might be called twice.
+          if (called) return
+          called = true
+
+          expect(frame.format).to.equal('i420')
+          expect(frame.size).to.deep.equal({ width: 64, height: 32 })
+          expect(frame.planes).to.have.lengthOf(3)
+          expect(frame.data).to.be.an.instanceOf(Buffer)
+          expect(frame.data.length).to.be.at.least(64 * 32 * 3 / 2)
+
+          w.webContents.endFrameSubscription()
+          done()
+        })
+      })
+    })
+
+    it('subscribes to an area of the view', (done) => {
+      const w = new BrowserWindow({ show: false })
+      let called = false
+      w.loadFile(path.join(fixtures, 'api', 'frame-subscriber.html'))
+      w.webContents.on('dom-ready', () => {
+        const options = { rect: { x: 10, y: 10, width: 30, height: 20 }, scale: 0.5, zeroCopy: true }
+        w.webContents.beginFrameSubscription(options as any, (image) => {
+          // This callback might be called twice.
+          if (called) return
+          called = true
+
+          const { scaleFactor } = screen.getPrimaryDisplay()
+          const size = image.getSize()
+          expect(size.width).to.be.closeTo(15 * scaleFactor, 2)
+          expect(size.height).to.be.closeTo(10 * scaleFactor, 2)
+
+          w.webContents.endFrameSubscription()
+          done()
+        })
+      })
+    })
+
+    it('throws error when the options are invalid', () => {
+      const w = new BrowserWindow({ show: false })
+      const callback = () => {}
+      expect(() => {
+        w.webContents.beginFrameSubscription({ pixelFormat: 'nv12' } as any, callback)
+      }).to.throw(/pixelFormat must be/)
+      expect(() => {
+        w.webContents.beginFrameSubscription({ size: { width: 0, height: 10 } } as any, callback)
+      }).to.throw(/size must have a positive width and height/)
+    })
+
     it('throws error when subscriber is not well defined', () => {
       const w = new BrowserWindow({ show: false })
       expect(() => {
@@ -2807,6 +3034,30 @@ describe('BrowserWindow module', () => {
     })
   })
 
+  describe('startVideoStream method', () => {
+    it('emits encoded chunks starting with a key frame', (done) => {
+      const w = new BrowserWindow({ show: false })
+      w.loadFile(path.join(fixtures, 'api', 'frame-subscriber.html'))
+      w.webContents.on('dom-ready', () => {
+        w.webContents.startVideoStream({ codec: 'vp8', size: { width: 64, height: 64 } }, (chunk) => {
+          w.webContents.stopVideoStream()
+          expect(chunk.data).to.be.an.instanceOf(Buffer)
+          expect(chunk.data.length).to.be.above(0)
+          expect(chunk.keyFrame).to.be.true('keyFrame')
+          expect(chunk.timestamp).to.equal(0)
+          done()
+        })
+      })
+    })
+
+    it('throws error when the codec is not supported', () => {
+      const w = new BrowserWindow({ show: false })
+      expect(() => {
+        w.webContents.startVideoStream({ codec: 'h264' } as any, () => {})
+      }).to.throw("codec must be 'vp8' or 'vp9'")
+    })
+  })
+
   describe('savePage method', () => {
     const savePageDir = path.join(fixtures, 'save_page')
     const savePageHtmlPath = path.join(savePageDir, 'save_page.html')
@@ -3935,6 +4186,65 @@ describe('BrowserWindow module', () => {
       w.loadFile(path.join(fixtures, 'api', 'offscreen-rendering.html'))
     })
 
+    it('emits paint-buffer with a buffer over the frame', (done) => {
+      let frame: Buffer
+      w.webContents.once('paint-buffer' as any, function (event: any, rect: any, buffer: Buffer, size: any, stride: number) {
+        expect(stride).to.be.at.least(size.width * 4)
+        expect(buffer.length).to.equal(stride * size.height)
+        frame = buffer
+        setImmediate(() => {
+          // The buffer is detached once the listeners return.
+          expect(frame.length).to.equal(0)
+          done()
+        })
+      })
+      w.loadFile(path.join(fixtures, 'api', 'offscreen-rendering.html'))
+    })
+
+    it('only paints the dirty area with offscreenOnlyDirty', (done) => {
+      w.destroy()
+      w = new BrowserWindow({
+        width: 100,
+        height: 100,
+        show: false,
+        webPreferences: {
+          backgroundThrottling: false,
+          offscreen: true,
+          offscreenOnlyDirty: true
+        }
+      })
+      w.webContents.once('paint', function (event, rect, data) {
+        const size = data.getSize()
+        expect(size.width).to.equal(rect.width)
+        expect(size.height).to.equal(rect.height)
+        done()
+      })
+      w.loadFile(path.join(fixtures, 'api', 'offscreen-rendering.html'))
+    })
+
+    it('paints frames without copying them with offscreenZeroCopy', (done) => {
+      w.destroy()
+      w = new BrowserWindow({
+        width: 100,
+        height: 100,
+        show: false,
+        webPreferences: {
+          backgroundThrottling: false,
+          offscreen: true,
+          offscreenZeroCopy: true
+        }
+      })
+      w.webContents.once('paint', function (event, rect, data) {
+        expect(data.isEmpty()).to.be.false('data is empty')
+        const size = data.getSize()
+        const { scaleFactor } = screen.getPrimaryDisplay()
+        expect(data.getBitmap().length).to.be.at.least(Math.round(size.width) * Math.round(size.height) * 4)
+        expect(size.width).to.be.closeTo(100 * scaleFactor, 2)
+        done()
+      })
+      w.loadFile(path.join(fixtures, 'api', 'offscreen-rendering.html'))
+    })
+
     describe('window.webContents.isOffscreen()', () => {
       it('is true for offscreen type', () => {
         w.loadFile(path.join(fixtures, 'api', 'offscreen-rendering.html'))
@@ -4028,5 +4338,47 @@ describe('BrowserWindow module', () => {
         w.loadFile(path.join(fixtures, 'api', 'offscreen-rendering.html'))
       })
     })
+
+    describe('window.webContents.getPaintStats()', () => {
+      it('returns the paint stats', (done) => {
+        w.webContents.once('paint', function () {
+          const stats = w.webContents.getPaintStats()
+          expect(stats.frameRate).to.be.within(1, 60)
+          expect(stats.droppedFrames).to.be.a('number')
+          expect(stats.queueDepth).to.be.a('number')
+          done()
+        })
+        w.loadFile(path.join(fixtures, 'api', 'offscreen-rendering.html'))
+      })
+
+      it('lowers the frame rate when paint handlers overrun', (done) => {
+        let painted = 0
+        w.webContents.on('paint', function () {
+          // Block for longer than a frame at 60 fps.
+          const start = Date.now()
+          while (Date.now() - start < 50);
+          if (++painted === 5) {
+            w.webContents.removeAllListeners('paint')
+            expect(w.webContents.getPaintStats().frameRate).to.be.below(60)
+            expect(w.webContents.frameRate).to.equal(60)
+            done()
+          }
+        })
+        w.loadFile(path.join(fixtures, 'api', 'offscreen-rendering.html'))
+      })
+
+      it('halves the frame rate while saving battery', async () => {
+        const painted = emittedOnce(w.webContents, 'paint')
+        w.loadFile(path.join(fixtures, 'api', 'offscreen-rendering.html'))
+        await painted
+        powerMonitor.setBatterySaverPolicy('always')
+        try {
+          expect(w.webContents.getPaintStats().frameRate).to.be.at.most(30)
+          expect(w.webContents.frameRate).to.equal(60)
+        } finally {
+          powerMonitor.setBatterySaverPolicy('off')
+        }
+      })
+    })
   })
 })
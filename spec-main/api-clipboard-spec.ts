@@ -0,0 +1,18 @@
+import { expect } from 'chai'
+import { clipboard } from 'electron'
+import { ifdescribe } from './spec-helpers'
+
+ifdescribe(process.platform === 'darwin')('clipboard module', () => {
+  describe('clipboard.writeBufferLazily(format, provider)', () => {
+    it('only calls the provider when the format is read', () => {
+      let calls = 0
+      clipboard.writeBufferLazily('public.utf8-plain-text', () => {
+        calls++
+        return Buffer.from('lazy', 'utf8')
+      })
+      expect(calls).to.equal(0)
+      expect(clipboard.readBuffer('public.utf8-plain-text').toString()).to.equal('lazy')
+      expect(calls).to.equal(1)
+    })
+  })
+})
@@ -1,8 +1,9 @@
 import { expect } from 'chai'
-import { app, contentTracing, TraceConfig, TraceCategoriesAndOptions } from 'electron'
+import { app, contentTracing, BrowserWindow, ipcMain, TraceConfig, TraceCategoriesAndOptions } from 'electron'
 import * as fs from 'fs'
 import * as path from 'path'
 import { ifdescribe } from './spec-helpers'
+import { closeAllWindows } from './window-helpers'
 
 const timeout = async (milliseconds: number) => {
   return new Promise((resolve) => {
@@ -126,4 +127,58 @@ ifdescribe(!(process.platform === 'linux' && ['arm', 'arm64'].includes(process.a
       expect(resultFilePath).to.be.a('string').that.is.not.empty('result path')
     })
   })
+
+  describe('stopRecordingToBuffer', function () {
+    this.timeout(5e3)
+
+    afterEach(closeAllWindows)
+
+    it('resolves with the trace data', async () => {
+      await app.whenReady()
+      await contentTracing.startRecording({ included_categories: ['electron.events'] })
+      const w = new BrowserWindow({ show: false })
+      await w.loadURL('about:blank')
+      const data = await contentTracing.stopRecordingToBuffer()
+      expect(data).to.be.an.instanceOf(Buffer)
+
+      const { traceEvents } = JSON.parse(data.toString())
+      const emit = traceEvents.find((e: any) => e.name === 'EventEmitter::Emit' && e.args.name === 'did-finish-load')
+      expect(emit).to.not.be.undefined('did-finish-load emit event')
+    })
+
+    it('rejects when nothing is being recorded', async () => {
+      await app.whenReady()
+      await expect(contentTracing.stopRecordingToBuffer()).to.be.rejectedWith(/no trace in progress/)
+    })
+  })
+
+  describe('IPC flow events', function () {
+    this.timeout(10e3)
+
+    afterEach(closeAllWindows)
+    afterEach(() => {
+      ipcMain.removeHandler('traced-invoke')
+    })
+
+    it('links an invoke to its handler and its reply', async () => {
+      await app.whenReady()
+      const w = new BrowserWindow({ show: false, webPreferences: { nodeIntegration: true } })
+      await w.loadURL('about:blank')
+      ipcMain.handle('traced-invoke', () => 'reply')
+
+      await contentTracing.startRecording({ included_categories: ['electron'] })
+      const reply = await w.webContents.executeJavaScript(`
+        require('electron').ipcRenderer.invoke('traced-invoke')
+      `)
+      expect(reply).to.equal('reply')
+      const resultFilePath = await contentTracing.stopRecording(outputFilePath)
+
+      const { traceEvents } = JSON.parse(fs.readFileSync(resultFilePath, 'utf8'))
+      const send = traceEvents.find((e: any) => e.name === 'IPCRenderer::Invoke' && e.args.channel === 'traced-invoke')
+      expect(send).to.have.property('bind_id')
+      const flow = traceEvents.filter((e: any) => e.bind_id === send.bind_id)
+      const names = flow.map((e: any) => e.name)
+      expect(names).to.include.members(['WebContents::Invoke', 'WebContents::Reply', 'IPCRenderer::InvokeReply'])
+    })
+  })
 })
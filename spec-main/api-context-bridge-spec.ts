@@ -306,6 +306,121 @@ describe('contextBridge', () => {
         expect(result).to.deep.equal([true, true])
       })
 
+      it('should pass large arrays of plain records', async () => {
+        await makeBindingWindow(() => {
+          contextBridge.exposeInMainWorld('example', {
+            getRecords: () => {
+              const records = []
+              for (let i = 0; i < 100000; i++) {
+                records.push({ id: i, name: `record-${i}`, tags: ['a', 'b'], data: new Uint8Array([i % 256]) })
+              }
+              return records
+            }
+          })
+        })
+        const result = await callWithBindings((root: any) => {
+          const records = root.example.getRecords()
+          const last = records[records.length - 1]
+          return [
+            records.length,
+            last.id,
+            last.name,
+            Object.getPrototypeOf(last) === Object.prototype,
+            Object.getPrototypeOf(last.tags) === Array.prototype,
+            Object.getPrototypeOf(last.data) === Uint8Array.prototype,
+            last.data[0]
+          ]
+        })
+        expect(result).to.deep.equal([100000, 99999, 'record-99999', true, true, true, 99999 % 256])
+      })
+
+      it('should proxy functions nested deep inside plain data', async () => {
+        await makeBindingWindow(() => {
+          contextBridge.exposeInMainWorld('example', {
+            records: [{ id: 1 }, { id: 2, nested: { getId: () => 2 } }]
+          })
+        })
+        const result = await callWithBindings((root: any) => {
+          return [root.example.records[0].id, root.example.records[1].nested.getId()]
+        })
+        expect(result).to.deep.equal([1, 2])
+      })
+
+      it('should only run the getters of nested objects once', async () => {
+        await makeBindingWindow(() => {
+          let reads = 0
+          const list: number[] = []
+          Object.defineProperty(list, 0, { get () { reads++; return 2 }, enumerable: true })
+          contextBridge.exposeInMainWorld('example', {
+            data: { get value () { reads++; return 1 } },
+            list,
+            getReads: () => reads
+          })
+        })
+        const result = await callWithBindings((root: any) => {
+          return [root.example.data.value, root.example.list[0], root.example.getReads()]
+        })
+        expect(result).to.deep.equal([1, 2, 2])
+      })
+
+      describe('with lazy: true', () => {
+        it('should only read values when they are accessed', async () => {
+          await makeBindingWindow(() => {
+            let reads = 0
+            contextBridge.exposeInMainWorld('example', {
+              get value () { reads++; return 123 },
+              getReads: () => reads
+            }, { lazy: true })
+          })
+          const result = await callWithBindings((root: any) => {
+            const before = root.example.getReads()
+            return [before, root.example.value, root.example.value, root.example.getReads()]
+          })
+          expect(result).to.deep.equal([0, 123, 123, 1])
+        })
+
+        it('should proxy nested namespaces and keep them frozen', async () => {
+          await makeBindingWindow(() => {
+            contextBridge.exposeInMainWorld('example', {
+              sdk: {
+                math: { add: (a: number, b: number) => a + b },
+                data: { flags: ['a', 'b'] }
+              }
+            }, { lazy: true })
+          })
+          const result = await callWithBindings((root: any) => {
+            const { sdk } = root.example
+            return [
+              Object.keys(sdk),
+              sdk.math.add(1, 2),
+              sdk.math === root.example.sdk.math,
+              sdk.data.flags,
+              Object.isFrozen(root.example),
+              Object.isFrozen(sdk),
+              Object.isFrozen(sdk.data.flags),
+              Object.getPrototypeOf(sdk) === Object.prototype
+            ]
+          })
+          expect(result).to.deep.equal([['math', 'data'], 3, true, ['a', 'b'], true, true, true, true])
+        })
+
+        it('should throw the errors of getters as errors of the main world', async () => {
+          await makeBindingWindow(() => {
+            contextBridge.exposeInMainWorld('example', {
+              get value () { throw new Error('getter-failed') }
+            }, { lazy: true })
+          })
+          const result = await callWithBindings((root: any) => {
+            try {
+              return root.example.value
+            } catch (err) {
+              return [err instanceof root.Error, err.message]
+            }
+          })
+          expect(result).to.deep.equal([true, 'Uncaught Error: getter-failed'])
+        })
+      })
+
       it('it should handle recursive objects', async () => {
         await makeBindingWindow(() => {
           const o: any = { value: 135 }
@@ -506,6 +621,30 @@ describe('contextBridge', () => {
         })
       }
 
+      it('should report the proxy cache stats', async () => {
+        await makeBindingWindow(() => {
+          contextBridge.exposeInMainWorld('example', {
+            getStats: () => contextBridge.getStats(),
+            take: (o: any) => o
+          })
+        })
+        const result = await callWithBindings((root: any) => {
+          const before = root.example.getStats()
+          const o = { value: 1 }
+          root.example.take(o)
+          root.example.take(o)
+          const after = root.example.getStats()
+          return [
+            after.proxyCount > before.proxyCount,
+            after.cacheHits > before.cacheHits,
+            after.cacheMisses > before.cacheMisses,
+            after.proxyCapacity >= after.proxyCount * 2,
+            after.functionCount >= 2
+          ]
+        })
+        expect(result).to.deep.equal([true, true, true, true, true])
+      })
+
       it('it should not let you overwrite existing exposed things', async () => {
         await makeBindingWindow(() => {
           let threw = false
@@ -205,6 +205,23 @@ ifdescribe(!process.mas && !process.env.DISABLE_CRASH_REPORTER_TESTS && process.
         })
       }).to.not.throw()
     })
+    it('accepts the dump options', () => {
+      expect(() => {
+        crashReporter.start({
+          companyName: 'Umbrella Corporation',
+          submitURL: 'http://127.0.0.1/crashes',
+          compress: true,
+          dumpProfile: 'small'
+        })
+      }).to.not.throw()
+      expect(() => {
+        crashReporter.start({
+          companyName: 'Umbrella Corporation',
+          submitURL: 'http://127.0.0.1/crashes',
+          dumpProfile: 'tiny'
+        } as any)
+      }).to.throw(/dumpProfile must be/)
+    })
   })
 
   describe('getCrashesDirectory', () => {
@@ -169,6 +169,17 @@ describe('debugger module', () => {
       w.webContents.debugger.detach()
     })
 
+    it('returns nested results', async () => {
+      w.webContents.loadURL('about:blank')
+      w.webContents.debugger.attach()
+
+      const params = { expression: '({ a: [1, 2.5, "\u00e9"], b: { c: null, d: true } })', returnByValue: true, silent: undefined }
+      const res = await w.webContents.debugger.sendCommand('Runtime.evaluate', params)
+      expect(res.result.value).to.deep.equal({ a: [1, 2.5, '\u00e9'], b: { c: null, d: true } })
+
+      w.webContents.debugger.detach()
+    })
+
     // TODO(deepak1556): Fix and enable with upgrade
     it.skip('handles valid unicode characters in message', (done) => {
       try {
@@ -230,4 +241,49 @@ describe('debugger module', () => {
       })
     })
   })
+
+  describe('debugger.sendCommands', () => {
+    it('resolves with the results in order', async () => {
+      w.webContents.loadURL('about:blank')
+      w.webContents.debugger.attach()
+
+      const results = await w.webContents.debugger.sendCommands([
+        { method: 'Runtime.evaluate', params: { expression: '4+2' } },
+        { method: 'Runtime.evaluate', params: { expression: '"a" + "b"' } }
+      ])
+      expect(results).to.have.lengthOf(2)
+      expect(results[0].result.value).to.equal(6)
+      expect(results[1].result.value).to.equal('ab')
+
+      w.webContents.debugger.detach()
+    })
+
+    it('resolves with an empty array for no commands', async () => {
+      w.webContents.loadURL('about:blank')
+      w.webContents.debugger.attach()
+
+      const results = await w.webContents.debugger.sendCommands([])
+      expect(results).to.deep.equal([])
+
+      w.webContents.debugger.detach()
+    })
+
+    it('rejects when one of the commands fails', async () => {
+      w.webContents.loadURL('about:blank')
+      w.webContents.debugger.attach()
+
+      const promise = w.webContents.debugger.sendCommands([
+        { method: 'Runtime.evaluate', params: { expression: '1' } },
+        { method: 'Test' }
+      ])
+      await expect(promise).to.be.eventually.rejectedWith(Error, "'Test' wasn't found")
+
+      w.webContents.debugger.detach()
+    })
+
+    it('rejects when not attached', async () => {
+      const promise = w.webContents.debugger.sendCommands([{ method: 'Runtime.enable' }])
+      await expect(promise).to.be.eventually.rejectedWith(Error, 'No target available')
+    })
+  })
 })
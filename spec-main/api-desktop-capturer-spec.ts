@@ -70,6 +70,45 @@ ifdescribe(features.isDesktopCapturerEnabled() && !process.arch.includes('arm')
     }
   })
 
+  ifit(process.platform !== 'linux')('streams the sources and their thumbnails', async () => {
+    const { added, thumbnails, sources } = await w.webContents.executeJavaScript(`
+      (async () => {
+        const added = []
+        const thumbnails = {}
+        const sources = await require('electron').desktopCapturer.getSources({
+          types: ['screen'],
+          onSourceAdded: (source) => added.push(source.id),
+          onThumbnailChanged: (id, thumbnail) => { thumbnails[id] = thumbnail.slice(1, 4).toString() }
+        })
+        return { added, thumbnails, sources: sources.map(s => ({ id: s.id, empty: s.thumbnail.isEmpty() })) }
+      })()
+    `)
+    expect(sources).to.be.an('array').that.is.not.empty()
+    for (const source of sources) {
+      expect(added).to.include(source.id)
+      expect(thumbnails[source.id]).to.equal('PNG')
+      expect(source.empty).to.be.true()
+    }
+  })
+
+  ifit(process.platform !== 'linux')('resolves with the thumbnails when only the sources are streamed', async () => {
+    const { added, sources } = await w.webContents.executeJavaScript(`
+      (async () => {
+        const added = []
+        const sources = await require('electron').desktopCapturer.getSources({
+          types: ['screen'],
+          onSourceAdded: (source) => added.push(source.id)
+        })
+        return { added, sources: sources.map(s => ({ id: s.id, empty: s.thumbnail.isEmpty() })) }
+      })()
+    `)
+    expect(sources).to.be.an('array').that.is.not.empty()
+    for (const source of sources) {
+      expect(added).to.include(source.id)
+      expect(source.empty).to.be.false()
+    }
+  })
+
   ifit(process.platform !== 'linux')('returns an empty source list if blocked by the main process', async () => {
     w.webContents.once('desktop-capturer-get-sources', (event) => {
       event.preventDefault()
@@ -60,4 +60,81 @@ describe('ipc main module', () => {
       expect(output).to.deep.equal(['error'])
     })
   })
+
+  describe('ipcMain.getMetrics', () => {
+    afterEach(() => {
+      ipcMain.setMetricsEnabled(false)
+      ipcMain.resetMetrics()
+      ipcMain.removeHandler('metrics-invoke')
+    })
+
+    const getChannel = (channel: string) => {
+      return ipcMain.getMetrics().find(metrics => metrics.channel === channel)
+    }
+
+    it('records nothing while disabled', async () => {
+      const w = new BrowserWindow({ show: false, webPreferences: { nodeIntegration: true } })
+      await w.loadURL('about:blank')
+      w.webContents.executeJavaScript(`require('electron').ipcRenderer.send('metrics-disabled')`)
+      await emittedOnce(ipcMain, 'metrics-disabled')
+      expect(getChannel('metrics-disabled')).to.be.undefined()
+    })
+
+    it('records messages, bytes and handler time per channel', async () => {
+      const w = new BrowserWindow({ show: false, webPreferences: { nodeIntegration: true } })
+      await w.loadURL('about:blank')
+      ipcMain.setMetricsEnabled(true)
+      const received = new Promise(resolve => {
+        let count = 0
+        ipcMain.on('metrics-send', () => { if (++count === 2) resolve() })
+      })
+      w.webContents.executeJavaScript(`{
+        const { ipcRenderer } = require('electron')
+        ipcRenderer.send('metrics-send', 'a'.repeat(1000))
+        ipcRenderer.send('metrics-send')
+      }`)
+      await received
+      ipcMain.removeAllListeners('metrics-send')
+      // The handler time is recorded after the listeners return.
+      await new Promise(resolve => setImmediate(resolve))
+      const metrics = getChannel('metrics-send')!
+      expect(metrics.messages).to.equal(2)
+      expect(metrics.bytes).to.be.greaterThan(1000)
+      expect(metrics.handlerTime.count).to.equal(2)
+      expect(metrics.replyTime.count).to.equal(0)
+    })
+
+    it('records the reply time of invoke', async () => {
+      const w = new BrowserWindow({ show: false, webPreferences: { nodeIntegration: true } })
+      await w.loadURL('about:blank')
+      ipcMain.setMetricsEnabled(true)
+      ipcMain.handle('metrics-invoke', async () => {
+        await new Promise(resolve => setTimeout(resolve, 50))
+        return 'done'
+      })
+      await w.webContents.executeJavaScript(`require('electron').ipcRenderer.invoke('metrics-invoke')`)
+      const metrics = getChannel('metrics-invoke')!
+      expect(metrics.replyTime.count).to.equal(1)
+      expect(metrics.replyTime.max).to.be.at.least(40)
+      expect(metrics.replyTime.p50).to.be.at.most(metrics.replyTime.max)
+      expect(metrics.handlerTime.max).to.be.lessThan(metrics.replyTime.max)
+    })
+  })
+
+  describe('ipcMain.setSyncBudget', () => {
+    afterEach(() => { ipcMain.setSyncBudget(0) })
+
+    it('emits ipc-message-sync-slow for slow sync handlers', async () => {
+      const w = new BrowserWindow({ show: false, webPreferences: { nodeIntegration: true } })
+      await w.loadURL('about:blank')
+      ipcMain.setSyncBudget(20)
+      ipcMain.once('slow-sync', (event) => {
+        setTimeout(() => { event.returnValue = null }, 100)
+      })
+      w.webContents.executeJavaScript(`require('electron').ipcRenderer.sendSync('slow-sync')`)
+      const [, channel, duration] = await emittedOnce(w.webContents, 'ipc-message-sync-slow')
+      expect(channel).to.equal('slow-sync')
+      expect(duration).to.be.at.least(20)
+    })
+  })
 })
@@ -113,6 +113,64 @@ describe('ipcRenderer module', () => {
       expect(childValue.hello).to.equal('world')
       expect(childValue.child).to.equal(childValue)
     })
+
+    it('can send primitives, flat objects and typed arrays', async () => {
+      w.webContents.executeJavaScript(`{
+        const { ipcRenderer } = require('electron')
+        const buffer = new Uint16Array([1, 2, 3, 4]).buffer
+        ipcRenderer.send('message', 'ascii', 'два', '😀', '', 42, -7, 2 ** 40, 0.5, -0, NaN,
+          true, false, null, undefined, { id: 1, name: 'été', nothing: null },
+          Object.assign(Object.create(null), { a: 1 }), new Float64Array([1.5, -2]),
+          new Uint16Array(buffer, 2, 2), new DataView(new ArrayBuffer(3)))
+      }`)
+      const [, ...values] = await emittedOnce(ipcMain, 'message')
+      expect(values.slice(0, 9)).to.deep.equal(['ascii', 'два', '😀', '', 42, -7, 2 ** 40, 0.5, -0])
+      expect(Object.is(values[8], -0)).to.be.true()
+      expect(values[9]).to.be.NaN()
+      expect(values.slice(10, 14)).to.deep.equal([true, false, null, undefined])
+      expect(values[14]).to.deep.equal({ id: 1, name: 'été', nothing: null })
+      expect(values[15]).to.deep.equal({ a: 1 })
+      expect(values[16]).to.be.an.instanceOf(Float64Array)
+      expect([...values[16]]).to.deep.equal([1.5, -2])
+      expect(values[17]).to.be.an.instanceOf(Uint16Array)
+      expect([...values[17]]).to.deep.equal([2, 3])
+      expect(values[17].buffer.byteLength).to.equal(8)
+      expect(values[18]).to.be.an.instanceOf(DataView)
+      expect(values[18].byteLength).to.equal(3)
+    })
+
+    it('keeps the identity of typed arrays sharing a buffer', async () => {
+      w.webContents.executeJavaScript(`{
+        const { ipcRenderer } = require('electron')
+        const buffer = new ArrayBuffer(4)
+        ipcRenderer.send('message', new Uint8Array(buffer, 0, 2), new Uint8Array(buffer, 2, 2))
+      }`)
+      const [, first, second] = await emittedOnce(ipcMain, 'message')
+      expect(first.buffer).to.equal(second.buffer)
+    })
+
+    it('runs the getters once when the arguments are left to the serializer', async () => {
+      w.webContents.executeJavaScript(`{
+        const { ipcRenderer } = require('electron')
+        let calls = 0
+        const flat = { get value () { return ++calls } }
+        ipcRenderer.send('message', flat, flat, new Date(0))
+        ipcRenderer.send('message-calls', calls)
+      }`)
+      const [, calls] = await emittedOnce(ipcMain, 'message-calls')
+      expect(calls).to.equal(1)
+    })
+
+    it('keeps the identity of flat objects left to the serializer', async () => {
+      w.webContents.executeJavaScript(`{
+        const { ipcRenderer } = require('electron')
+        const flat = { a: 1 }
+        ipcRenderer.send('message', flat, flat)
+      }`)
+      const [, first, second] = await emittedOnce(ipcMain, 'message')
+      expect(first).to.deep.equal({ a: 1 })
+      expect(first).to.equal(second)
+    })
   })
 
   describe('sendSync()', () => {
@@ -128,6 +186,51 @@ describe('ipcRenderer module', () => {
     })
   })
 
+  describe('setSyncDeadline()', () => {
+    after(async () => {
+      await w.webContents.executeJavaScript(`require('electron').ipcRenderer.setSyncDeadline(0)`)
+    })
+
+    it('returns replies received before the deadline', async () => {
+      ipcMain.once('echo', (event, msg) => {
+        event.returnValue = msg
+      })
+      const msg = await w.webContents.executeJavaScript(`{
+        const { ipcRenderer } = require('electron')
+        ipcRenderer.setSyncDeadline(5000)
+        ipcRenderer.sendSync('echo', 'test')
+      }`)
+      expect(msg).to.equal('test')
+    })
+
+    it('throws when the reply is late', async () => {
+      ipcMain.once('late-reply', (event) => {
+        setTimeout(() => { event.returnValue = 'late' }, 500)
+      })
+      await expect(w.webContents.executeJavaScript(`{
+        const { ipcRenderer } = require('electron')
+        ipcRenderer.setSyncDeadline(50)
+        ipcRenderer.sendSync('late-reply')
+      }`)).to.eventually.be.rejectedWith(/No reply to sendSync on 'late-reply' within 50 ms/)
+    })
+
+    it('keeps sync messages ordered with asynchronous ones', async () => {
+      const received: string[] = []
+      ipcMain.once('ordered-async', () => received.push('async'))
+      ipcMain.once('ordered-sync', (event) => {
+        received.push('sync')
+        event.returnValue = null
+      })
+      await w.webContents.executeJavaScript(`{
+        const { ipcRenderer } = require('electron')
+        ipcRenderer.setSyncDeadline(5000)
+        ipcRenderer.send('ordered-async')
+        ipcRenderer.sendSync('ordered-sync')
+      }`)
+      expect(received).to.deep.equal(['async', 'sync'])
+    })
+  })
+
   describe('sendTo()', () => {
     const generateSpecs = (description: string, webPreferences: WebPreferences) => {
       describe(description, () => {
@@ -174,6 +277,336 @@ describe('ipcRenderer module', () => {
     generateSpecs('with contextIsolation + sandbox', { contextIsolation: true, sandbox: true })
   })
 
+  describe('sendById()', () => {
+    it('emits the message on the registered channel', async () => {
+      w.webContents.executeJavaScript(`{
+        const { ipcRenderer } = require('electron')
+        const id = ipcRenderer.registerChannel('by-id')
+        ipcRenderer.sendById(id, ipcRenderer.registerChannel('by-id') === id, 'arg')
+      }`)
+      const [, sameId, arg] = await emittedOnce(ipcMain, 'by-id')
+      expect(sameId).to.be.true()
+      expect(arg).to.equal('arg')
+    })
+
+    it('throws for unknown IDs', async () => {
+      await expect(w.webContents.executeJavaScript(`{
+        require('electron').ipcRenderer.sendById(1000)
+      }`)).to.eventually.be.rejectedWith(/Unknown channel ID 1000/)
+    })
+  })
+
+  describe('sendWithTransfer()', () => {
+    it('moves the transferred ArrayBuffers to the main process', async () => {
+      const result = w.webContents.executeJavaScript(`{
+        const { ipcRenderer } = require('electron')
+        const buffer = new Uint8Array(1024 * 1024).fill(7).buffer
+        ipcRenderer.sendWithTransfer('message', [buffer], { buffer })
+        buffer.byteLength
+      }`)
+      const [, received] = await emittedOnce(ipcMain, 'message')
+      expect(await result).to.equal(0)
+      expect(received.buffer).to.be.an.instanceOf(ArrayBuffer)
+      expect(received.buffer.byteLength).to.equal(1024 * 1024)
+      expect(new Uint8Array(received.buffer).every(x => x === 7)).to.be.true()
+    })
+
+    it('throws when the transfer list holds something else', async () => {
+      await expect(w.webContents.executeJavaScript(`{
+        const { ipcRenderer } = require('electron')
+        const buffer = new ArrayBuffer(8)
+        ipcRenderer.sendWithTransfer('message', [buffer, buffer], buffer)
+      }`)).to.eventually.be.rejectedWith(/detachable ArrayBuffers/)
+    })
+  })
+
+  describe('invokeWithTransfer()', () => {
+    it('moves the transferred ArrayBuffers to the main process', async () => {
+      ipcMain.handleOnce('buffer-size', (event, buffer) => buffer.byteLength)
+      const [size, detached] = await w.webContents.executeJavaScript(`(async () => {
+        const { ipcRenderer } = require('electron')
+        const buffer = new ArrayBuffer(4096)
+        const size = await ipcRenderer.invokeWithTransfer('buffer-size', [buffer], buffer)
+        return [size, buffer.byteLength]
+      })()`)
+      expect(size).to.equal(4096)
+      expect(detached).to.equal(0)
+    })
+  })
+
+  describe('setChannelPriority()', () => {
+    after(async () => {
+      await w.webContents.executeJavaScript(`require('electron').ipcRenderer.setChannelPriority('urgent', 'normal')`)
+    })
+
+    it('delivers send() and invoke() on high priority channels', async () => {
+      ipcMain.handleOnce('urgent', (event, value) => value * 2)
+      const result = await w.webContents.executeJavaScript(`(async () => {
+        const { ipcRenderer } = require('electron')
+        ipcRenderer.setChannelPriority('urgent', 'high')
+        ipcRenderer.send('urgent', 'sent')
+        return ipcRenderer.invoke('urgent', 21)
+      })()`)
+      expect(result).to.equal(42)
+    })
+
+    it('keeps high priority messages ordered among themselves', async () => {
+      const received: any[] = []
+      ipcMain.on('urgent', (event, n) => received.push(n))
+      w.webContents.executeJavaScript(`{
+        const { ipcRenderer } = require('electron')
+        ipcRenderer.setChannelPriority('urgent', 'high')
+        for (let i = 0; i < 10; i++) ipcRenderer.send('urgent', i)
+        ipcRenderer.send('urgent', 'done')
+      }`)
+      await new Promise(resolve => ipcMain.on('urgent', (event, n) => { if (n === 'done') resolve() }))
+      ipcMain.removeAllListeners('urgent')
+      expect(received).to.deep.equal([0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 'done'])
+    })
+
+    it('throws for invalid priorities', async () => {
+      await expect(w.webContents.executeJavaScript(`{
+        require('electron').ipcRenderer.setChannelPriority('urgent', 'urgent')
+      }`)).to.eventually.be.rejectedWith(/Invalid priority/)
+    })
+  })
+
+  describe('enableBatching()', () => {
+    after(async () => {
+      await w.webContents.executeJavaScript(`require('electron').ipcRenderer.disableBatching()`)
+    })
+
+    it('delivers the messages of a batch as separate events', async () => {
+      const received: number[] = []
+      ipcMain.on('batched', (event, n) => received.push(n))
+      w.webContents.executeJavaScript(`{
+        const { ipcRenderer } = require('electron')
+        ipcRenderer.enableBatching({ channels: ['batched'] })
+        ipcRenderer.send('batched', 1)
+        ipcRenderer.send('batched', 2)
+        ipcRenderer.send('batched-done')
+      }`)
+      await emittedOnce(ipcMain, 'batched-done')
+      ipcMain.removeAllListeners('batched')
+      expect(received).to.deep.equal([1, 2])
+    })
+
+    it('can deliver the messages of a batch as an array', async () => {
+      w.webContents.executeJavaScript(`{
+        const { ipcRenderer } = require('electron')
+        ipcRenderer.enableBatching({ deliverAs: 'array', flush: 'task' })
+        ipcRenderer.send('batched-array', 1)
+        ipcRenderer.send('batched-array', 2, 3)
+      }`)
+      const [, messages] = await emittedOnce(ipcMain, 'batched-array')
+      expect(messages).to.deep.equal([[1], [2, 3]])
+    })
+
+    it('throws for invalid options', async () => {
+      await expect(w.webContents.executeJavaScript(`{
+        require('electron').ipcRenderer.enableBatching({ flush: 'never' })
+      }`)).to.eventually.be.rejectedWith(/Invalid flush mode/)
+    })
+
+    it('kills the renderer when a batch has the wrong number of messages', async () => {
+      const bad = new BrowserWindow({ show: false, webPreferences: { nodeIntegration: true } })
+      try {
+        await bad.loadURL('about:blank')
+        ipcMain.once('unbalanced', () => { throw new Error('the batch should not be emitted') })
+        bad.webContents.executeJavaScript(`{
+          const { ipc } = process.electronBinding('ipc')
+          ipc.sendBatch(false, ['unbalanced', 'unbalanced'], [[1]], false)
+        }`)
+        await emittedOnce(bad.webContents, 'crashed')
+      } finally {
+        ipcMain.removeAllListeners('unbalanced')
+        await closeWindow(bad)
+      }
+    })
+  })
+
+  describe('openChannel()', () => {
+    const generateSpecs = (description: string, webPreferences: WebPreferences) => {
+      describe(description, () => {
+        let contents: WebContents
+
+        before(async () => {
+          contents = (webContents as any).create({
+            preload: path.join(fixtures, 'module', 'preload-ipc-peer-echo.js'),
+            ...webPreferences
+          })
+
+          await contents.loadURL('about:blank')
+        })
+
+        after(() => {
+          (contents as any).destroy()
+          contents = null as unknown as WebContents
+        })
+
+        it('exchanges messages with the other WebContents', async () => {
+          const data = await w.webContents.executeJavaScript(`(async () => {
+            const { ipcRenderer } = require('electron')
+            const channel = await ipcRenderer.openChannel(${contents.id}, 'echo')
+            const reply = new Promise(resolve => channel.once('message', (event, ...args) => resolve(args)))
+            channel.send('hello', { n: 1 })
+            const args = await reply
+            channel.close()
+            return args
+          })()`)
+          expect(data).to.deep.equal(['hello', { n: 1 }])
+        })
+
+        it('emits close when the other end closes the channel', async () => {
+          const closed = await w.webContents.executeJavaScript(`(async () => {
+            const { ipcRenderer } = require('electron')
+            const channel = await ipcRenderer.openChannel(${contents.id}, 'refuse')
+            await new Promise(resolve => channel.once('close', resolve))
+            return true
+          })()`)
+          expect(closed).to.be.true()
+        })
+      })
+    }
+
+    generateSpecs('without sandbox', {})
+    generateSpecs('with sandbox', { sandbox: true })
+    generateSpecs('with contextIsolation', { contextIsolation: true })
+
+    it('rejects when the WebContents does not exist', async () => {
+      await expect(w.webContents.executeJavaScript(`{
+        const { ipcRenderer } = require('electron')
+        ipcRenderer.openChannel(-1, 'echo')
+      }`)).to.eventually.be.rejectedWith(/Could not open channel/)
+    })
+  })
+
+  describe('openRingBuffer()', () => {
+    it('emits the records in batches on ipcMain', async () => {
+      const received: number[] = []
+      const done = new Promise(resolve => {
+        ipcMain.on('ring-samples', function listener (event, records: Uint8Array[]) {
+          for (const record of records) {
+            received.push(...new Float64Array(record.buffer, record.byteOffset, record.byteLength / 8))
+          }
+          if (received.length === 200) {
+            ipcMain.removeListener('ring-samples', listener)
+            resolve()
+          }
+        })
+      })
+      await w.webContents.executeJavaScript(`(async () => {
+        const { ipcRenderer } = require('electron')
+        const ring = await ipcRenderer.openRingBuffer('ring-samples')
+        for (let i = 0; i < 100; i++) {
+          ring.write(new Float64Array([i, i * 2]))
+        }
+        window.ring = ring
+      })()`)
+      await done
+      expect(received.slice(0, 4)).to.deep.equal([0, 0, 1, 2])
+      expect(received.slice(-2)).to.deep.equal([99, 198])
+      await w.webContents.executeJavaScript('window.ring.close()')
+    })
+
+    it('refuses records when the buffer is full', async () => {
+      const results = await w.webContents.executeJavaScript(`(async () => {
+        const { ipcRenderer } = require('electron')
+        const ring = await ipcRenderer.openRingBuffer('ring-full', { capacity: 4096, doorbell: 'manual' })
+        const results = []
+        for (let i = 0; i < 4; i++) {
+          results.push(ring.write(new Uint8Array(1024)))
+        }
+        ring.close()
+        return results
+      })()`)
+      expect(results).to.deep.equal([true, true, true, false])
+    })
+
+    it('rejects unsupported capacities', async () => {
+      await expect(w.webContents.executeJavaScript(`{
+        const { ipcRenderer } = require('electron')
+        ipcRenderer.openRingBuffer('ring-invalid', { capacity: 1000 })
+      }`)).to.eventually.be.rejectedWith(/Could not open ring buffer/)
+    })
+  })
+
+  describe('onBatch()', () => {
+    it('delivers the messages of a burst to batch listeners in order', async () => {
+      const done = w.webContents.executeJavaScript(`new Promise(resolve => {
+        const { ipcRenderer } = require('electron')
+        const batches = []
+        let single = 0
+        ipcRenderer.on('burst', () => { single++ })
+        const senderIds = []
+        ipcRenderer.onBatch('burst', (event, messages) => {
+          batches.push(messages)
+          senderIds.push(event.senderId)
+          if ([].concat(...batches).length === 3) {
+            ipcRenderer.removeAllListeners('burst')
+            resolve({ batches, single, senderIds })
+          }
+        })
+        ipcRenderer.send('burst-ready')
+      })`)
+      await emittedOnce(ipcMain, 'burst-ready')
+      w.webContents.send('burst', 1)
+      w.webContents.send('burst', 2, 3)
+      w.webContents.send('burst', 4)
+      const { batches, single, senderIds } = await done
+      expect([].concat(...batches)).to.deep.equal([[1], [2, 3], [4]])
+      // The messages sent in one task arrive together, so at least two of
+      // them are delivered in the same batch.
+      expect(batches.length).to.be.lessThan(3)
+      expect(single).to.equal(3)
+      expect(senderIds.every(id => id === 0)).to.equal(true)
+    })
+
+    it('keeps emitting the messages of a burst after a listener throws', async () => {
+      const done = w.webContents.executeJavaScript(`new Promise(resolve => {
+        const { ipcRenderer } = require('electron')
+        const received = []
+        const errors = []
+        window.addEventListener('error', (event) => {
+          event.preventDefault()
+          errors.push(event.error.message)
+        })
+        ipcRenderer.on('burst-throw', (event, value) => {
+          received.push(value)
+          if (received.length === 3) {
+            setTimeout(() => resolve({ received, errors }))
+          }
+        })
+        ipcRenderer.on('burst-throw', (event, value) => {
+          if (value === 1) throw new Error('listener failed')
+        })
+        ipcRenderer.send('burst-throw-ready')
+      })`)
+      await emittedOnce(ipcMain, 'burst-throw-ready')
+      w.webContents.send('burst-throw', 1)
+      w.webContents.send('burst-throw', 2)
+      w.webContents.send('burst-throw', 3)
+      const { received, errors } = await done
+      expect(received).to.deep.equal([1, 2, 3])
+      expect(errors).to.deep.equal(['listener failed'])
+    })
+
+    it('is removed by removeListener()', async () => {
+      const done = w.webContents.executeJavaScript(`new Promise(resolve => {
+        const { ipcRenderer } = require('electron')
+        let calls = 0
+        const listener = () => { calls++ }
+        ipcRenderer.onBatch('removed-batch', listener)
+        ipcRenderer.removeListener('removed-batch', listener)
+        ipcRenderer.once('removed-batch', () => setTimeout(() => resolve(calls)))
+        ipcRenderer.send('removed-batch-ready')
+      })`)
+      await emittedOnce(ipcMain, 'removed-batch-ready')
+      w.webContents.send('removed-batch')
+      expect(await done).to.equal(0)
+    })
+  })
+
   describe('ipcRenderer.on', () => {
     it('is not used for internals', async () => {
       const result = await w.webContents.executeJavaScript(`
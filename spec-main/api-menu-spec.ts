@@ -866,6 +866,29 @@ describe('Menu module', function () {
       expect(Menu.getApplicationMenu()).to.not.be.null('application menu')
     })
 
+    it('updates the items when the same menu is set again', async () => {
+      const w = new BrowserWindow({ show: false })
+      try {
+        const menu = Menu.buildFromTemplate([
+          { label: '1', submenu: [{ label: 'a', type: 'checkbox' }] },
+          { label: '2' }
+        ])
+        Menu.setApplicationMenu(menu)
+
+        menu.items[0].submenu!.items[0].checked = true
+        menu.items[1].label = 'changed'
+        menu.items[1].enabled = false
+        Menu.setApplicationMenu(menu)
+        Menu.setApplicationMenu(menu)
+        expect(Menu.getApplicationMenu()).to.equal(menu)
+
+        await new Promise(resolve => process.nextTick(resolve))
+        expect(Menu.getApplicationMenu()).to.equal(menu)
+      } finally {
+        w.destroy()
+      }
+    })
+
     it('unsets a menu with null', () => {
       Menu.setApplicationMenu(null)
       expect(Menu.getApplicationMenu()).to.be.null('application menu')
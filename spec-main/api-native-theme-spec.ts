@@ -42,18 +42,33 @@ describe('nativeTheme module', () => {
 
     it('should not emit the "updated" event when it is set and the resulting "shouldUseDarkColors" value is the same', async () => {
       nativeTheme.themeSource = 'dark'
-      // Wait a few ticks to allow an async events to flush
-      await delay(20)
+      // Wait for the coalesced events to flush
+      await delay(100)
       let called = false
       nativeTheme.once('updated', () => {
         called = true
       })
       nativeTheme.themeSource = 'dark'
-      // Wait a few ticks to allow an async events to flush
-      await delay(20)
+      // Wait for the coalesced events to flush
+      await delay(100)
       expect(called).to.equal(false)
     })
 
+    it('should emit one "updated" event for a burst of changes', async () => {
+      nativeTheme.themeSource = 'light'
+      await delay(100)
+      let updates = 0
+      const onUpdated = () => { updates++ }
+      nativeTheme.on('updated', onUpdated)
+      nativeTheme.themeSource = 'dark'
+      nativeTheme.themeSource = 'light'
+      nativeTheme.themeSource = 'dark'
+      await delay(100)
+      nativeTheme.removeListener('updated', onUpdated)
+      expect(updates).to.equal(1)
+      expect(nativeTheme.shouldUseDarkColors).to.equal(true)
+    })
+
     ifdescribe(process.platform === 'darwin' && semver.gte(os.release(), '18.0.0'))('on macOS 10.14', () => {
       it('should update appLevelAppearance when set', () => {
         nativeTheme.themeSource = 'dark'
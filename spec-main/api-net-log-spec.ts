@@ -123,6 +123,45 @@ describe('netLog module', () => {
     expect(JSON.parse(dump).events.some((x: any) => x.params && x.params.bytes && Buffer.from(x.params.bytes, 'base64').includes(unique))).to.be.true('uuid present in dump')
   })
 
+  const makeRequest = () => new Promise((resolve) => {
+    const req = net.request(serverUrl)
+    req.on('response', (response) => {
+      response.on('data', () => {})
+      response.on('end', () => resolve())
+    })
+    req.end()
+  })
+
+  it('should only keep the events of the requested source types', async () => {
+    await testNetLog().startLogging(dumpFileDynamic, { sourceTypes: ['URL_REQUEST'] })
+    await makeRequest()
+    await testNetLog().stopLogging()
+    const { constants, events } = JSON.parse(fs.readFileSync(dumpFileDynamic, 'utf8'))
+    expect(events).to.not.be.empty('events')
+    expect(events.every((event: any) => event.source.type === constants.logSourceType.URL_REQUEST)).to.be.true('only URL_REQUEST events')
+  })
+
+  it('should throw an error when .startLogging() is called with invalid filters', () => {
+    expect(() => testNetLog().startLogging('aoeu', { eventTypes: 'URL_REQUEST_START_JOB' as any })).to.throw()
+    expect(() => testNetLog().startLogging('aoeu', { sourceTypes: [1] as any })).to.throw()
+  })
+
+  it('should dump the events so far and keep logging when .dump() is called', async () => {
+    await testNetLog().startLogging(dumpFileDynamic)
+    await makeRequest()
+    await testNetLog().dump(dumpFile)
+    expect(testNetLog().currentlyLogging).to.be.true('currently logging')
+    const { events } = JSON.parse(fs.readFileSync(dumpFile, 'utf8'))
+    expect(events).to.not.be.empty('events')
+    await makeRequest()
+    await testNetLog().stopLogging()
+    expect(JSON.parse(fs.readFileSync(dumpFileDynamic, 'utf8')).events).to.not.be.empty('events')
+  })
+
+  it('should reject .dump() when not logging', async () => {
+    await expect(testNetLog().dump(dumpFile)).to.be.rejectedWith('No net log in progress')
+  })
+
   ifit(process.platform !== 'linux')('should begin and end logging automatically when --log-net-log is passed', async () => {
     const appProcess = ChildProcess.spawn(process.execPath,
       [appPath], {
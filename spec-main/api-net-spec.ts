@@ -1,6 +1,9 @@
 import { expect } from 'chai'
 import { net, session, ClientRequest, BrowserWindow } from 'electron'
+import * as fs from 'fs'
 import * as http from 'http'
+import * as os from 'os'
+import * as path from 'path'
 import * as url from 'url'
 import { AddressInfo, Socket } from 'net'
 import { emittedOnce } from './events-helpers'
@@ -1275,6 +1278,158 @@ describe('net module', () => {
     })
   })
 
+  describe('response metrics', () => {
+    it('are set once the response ends', async () => {
+      const serverUrl = await respondOnce.toSingleURL((request, response) => {
+        response.end('metrics')
+      })
+      const urlRequest = net.request(serverUrl)
+      urlRequest.end()
+      const [response] = await emittedOnce(urlRequest, 'response')
+      response.resume()
+      await emittedOnce(response, 'end')
+      expect(response.metrics.timing.ttfb).to.be.a('number')
+      expect(response.metrics.decodedBodyLength).to.equal('metrics'.length)
+    })
+  })
+
+  describe('file transfers', () => {
+    let tmpDir: string
+    beforeEach(() => { tmpDir = fs.mkdtempSync(path.join(os.tmpdir(), 'electron-net-spec-')) })
+    afterEach(() => { fs.rmdirSync(tmpDir, { recursive: true }) })
+
+    it('uploads a range of a file', async () => {
+      const data = randomBuffer(kOneMegaByte)
+      const filePath = path.join(tmpDir, 'upload')
+      fs.writeFileSync(filePath, data)
+      const serverUrl = await respondOnce.toSingleURL((request, response) => {
+        const chunks: Buffer[] = []
+        request.on('data', (chunk: Buffer) => chunks.push(chunk))
+        request.on('end', () => response.end(Buffer.concat(chunks).toString('hex')))
+      })
+      const urlRequest = net.request({
+        method: 'POST',
+        url: serverUrl,
+        uploadFile: { path: filePath, offset: 1024, length: 4096 }
+      })
+      urlRequest.end()
+      const [response] = await emittedOnce(urlRequest, 'response')
+      let body = ''
+      response.on('data', (chunk: Buffer) => { body += chunk.toString() })
+      await emittedOnce(response, 'end')
+      expect(body).to.equal(data.slice(1024, 1024 + 4096).toString('hex'))
+    })
+
+    it('does not accept writes when uploading a file', async () => {
+      const urlRequest = net.request({ method: 'POST', url: 'http://127.0.0.1', uploadFile: { path: __filename } })
+      urlRequest.write('data')
+      const [error] = await emittedOnce(urlRequest, 'error')
+      expect(error.message).to.match(/uploading a file/)
+    })
+
+    it('downloads the body to a file without emitting data', async () => {
+      const data = randomBuffer(4 * kOneMegaByte)
+      const serverUrl = await respondOnce.toSingleURL((request, response) => {
+        response.end(data)
+      })
+      const downloadPath = path.join(tmpDir, 'download')
+      const urlRequest = net.request({ url: serverUrl, downloadPath })
+      urlRequest.end()
+      const [response] = await emittedOnce(urlRequest, 'response')
+      let received = 0
+      response.on('data', (chunk: Buffer) => { received += chunk.length })
+      await emittedOnce(response, 'end')
+      expect(received).to.equal(0)
+      expect(fs.readFileSync(downloadPath).equals(data)).to.equal(true)
+    })
+
+    it('throttles the progress events', async () => {
+      const serverUrl = await respondOnce.toSingleURL((request, response) => {
+        response.end(randomBuffer(8 * kOneMegaByte))
+      })
+      const urlRequest = net.request({ url: serverUrl, downloadPath: path.join(tmpDir, 'download'), progressInterval: 60 * 1000 })
+      urlRequest.end()
+      const [response] = await emittedOnce(urlRequest, 'response')
+      let progressEvents = 0
+      response.on('download-progress', () => { progressEvents++ })
+      response.resume()
+      await emittedOnce(response, 'end')
+      expect(progressEvents).to.be.at.most(1)
+    })
+  })
+
+  describe('request priority', () => {
+    it('rejects invalid priorities', () => {
+      expect(() => net.request({ url: 'http://127.0.0.1', priority: 'urgent' as any })).to.throw(/priority/)
+      expect(() => net.request({ url: 'http://127.0.0.1', isBackground: 'yes' as any })).to.throw(/isBackground/)
+      const urlRequest = net.request('http://127.0.0.1')
+      expect(() => urlRequest.setPriority('urgent' as any)).to.throw(/priority/)
+    })
+
+    it('can change the priority of a request in flight', async () => {
+      const ses = session.fromPartition('' + Math.random())
+      const logPath = path.join(os.tmpdir(), `net-priority-${Math.random()}.json`)
+      cleanupTasks.push(() => fs.unlinkSync(logPath))
+      await ses.netLog.startLogging(logPath)
+
+      let respond: () => void
+      const serverUrl = await respondOnce.toSingleURL((request, response) => {
+        respond = () => response.end('done')
+      })
+      const urlRequest = net.request({ url: serverUrl, session: ses, priority: 'lowest' })
+      urlRequest.end()
+      await new Promise(resolve => setTimeout(resolve, 100))
+      urlRequest.setPriority('highest')
+      respond!()
+      const [response] = await emittedOnce(urlRequest, 'response')
+      let body = ''
+      response.on('data', (chunk: Buffer) => { body += chunk })
+      await emittedOnce(response, 'end')
+      expect(body).to.equal('done')
+
+      await ses.netLog.stopLogging()
+      const log = JSON.parse(fs.readFileSync(logPath, 'utf8'))
+      const setPriority = log.constants.logEventTypes.URL_REQUEST_SET_PRIORITY
+      const priorities = log.events
+        .filter((event: any) => event.type === setPriority)
+        .map((event: any) => event.params.priority)
+      expect(priorities).to.include('HIGHEST')
+    })
+
+    it('limits the background requests of a session', async () => {
+      const ses = session.fromPartition('' + Math.random())
+      expect(ses.getMaxBackgroundRequests()).to.equal(6)
+      expect(() => ses.setMaxBackgroundRequests(0)).to.throw(/limit/)
+      ses.setMaxBackgroundRequests(1)
+
+      const responses: http.ServerResponse[] = []
+      const requestUrls: string[] = []
+      const server = http.createServer((request, response) => {
+        requestUrls.push(request.url!)
+        responses.push(response)
+      })
+      await new Promise(resolve => server.listen(0, '127.0.0.1', resolve))
+      cleanupTasks.push(() => server.close())
+      const serverUrl = `http://127.0.0.1:${(server.address() as AddressInfo).port}`
+
+      const first = net.request({ url: `${serverUrl}/first`, session: ses, isBackground: true })
+      const second = net.request({ url: `${serverUrl}/second`, session: ses, isBackground: true })
+      first.end()
+      second.end()
+      await emittedOnce(server, 'request')
+      await new Promise(resolve => setTimeout(resolve, 100))
+      expect(requestUrls).to.deep.equal(['/first'])
+
+      responses[0].end()
+      const [response] = await emittedOnce(first, 'response')
+      response.resume()
+      await emittedOnce(server, 'request')
+      expect(requestUrls).to.deep.equal(['/first', '/second'])
+      responses[1].end()
+      await emittedOnce(second, 'response')
+    })
+  })
+
   describe('IncomingMessage API', () => {
     it('response object should implement the IncomingMessage API', async () => {
       const customHeaderName = 'Some-Custom-Header-Name'
@@ -1,5 +1,7 @@
 import { expect } from 'chai'
 import { Notification } from 'electron'
+import { emittedOnce } from './events-helpers'
+import { ifit, delay } from './spec-helpers'
 
 describe('Notification module', () => {
   it('inits, gets and sets basic string properties correctly', () => {
@@ -54,6 +56,62 @@ describe('Notification module', () => {
     expect(n.hasReply).to.be.false('has reply')
   })
 
+  it('throws when setMaxRate() is given a negative rate', () => {
+    expect(() => {
+      Notification.setMaxRate(-1)
+    }).to.throw(/must not be negative/)
+    Notification.setMaxRate(0)
+  })
+
+  // The notifications of the other platforms are only shown when a
+  // notification server is running.
+  ifit(process.platform === 'darwin')('holds back the notifications over the maximum rate', async () => {
+    const first = new Notification({ title: 'first', body: 'body', silent: true })
+    const second = new Notification({ title: 'second', body: 'body', silent: true })
+    let secondShown = false
+    second.on('show', () => { secondShown = true })
+    Notification.setMaxRate(1)
+    try {
+      const firstShown = emittedOnce(first, 'show')
+      first.show()
+      await firstShown
+      second.show()
+      await delay(500)
+      expect(secondShown).to.be.false('second notification shown')
+
+      const secondShownAfterLimit = emittedOnce(second, 'show')
+      Notification.setMaxRate(0)
+      await secondShownAfterLimit
+    } finally {
+      Notification.setMaxRate(0)
+      first.close()
+      second.close()
+    }
+  })
+
+  ifit(process.platform === 'darwin')('closes a held back notification without showing it', async () => {
+    const first = new Notification({ title: 'first', body: 'body', silent: true })
+    const second = new Notification({ title: 'second', body: 'body', silent: true })
+    let secondShown = false
+    second.on('show', () => { secondShown = true })
+    Notification.setMaxRate(1)
+    try {
+      const firstShown = emittedOnce(first, 'show')
+      first.show()
+      await firstShown
+      second.show()
+      const secondClosed = emittedOnce(second, 'close')
+      second.close()
+      await secondClosed
+      Notification.setMaxRate(0)
+      await delay(100)
+      expect(secondShown).to.be.false('second notification shown')
+    } finally {
+      Notification.setMaxRate(0)
+      first.close()
+    }
+  })
+
   it('inits, gets and sets actions correctly', () => {
     const n = new Notification({
       title: 'title',
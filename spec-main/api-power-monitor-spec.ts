@@ -9,6 +9,7 @@
 import { expect } from 'chai'
 import * as dbus from 'dbus-native'
 import { ifdescribe } from './spec-helpers'
+import { emittedOnce } from './events-helpers'
 import { promisify } from 'util'
 
 describe('powerMonitor', () => {
@@ -153,5 +154,32 @@ describe('powerMonitor', () => {
         expect(idleTime).to.be.at.least(0)
       })
     })
+
+    describe('powerMonitor.setBatterySaverPolicy', () => {
+      afterEach(() => {
+        powerMonitor.setBatterySaverPolicy('off')
+      })
+
+      it('saves battery when the policy is always', async () => {
+        const changed = emittedOnce(powerMonitor, 'battery-saver-changed')
+        powerMonitor.setBatterySaverPolicy('always')
+        const [, saving] = await changed
+        expect(saving).to.be.true()
+        expect(powerMonitor.getBatterySaverPolicy()).to.equal('always')
+        expect(powerMonitor.isBatterySaverActive()).to.be.true()
+      })
+
+      it('does not save battery when the policy is off', () => {
+        powerMonitor.setBatterySaverPolicy('off')
+        expect(powerMonitor.getBatterySaverPolicy()).to.equal('off')
+        expect(powerMonitor.isBatterySaverActive()).to.be.false()
+      })
+
+      it('does not accept an unknown policy', () => {
+        expect(() => {
+          powerMonitor.setBatterySaverPolicy('sometimes' as any)
+        }).to.throw(/Invalid battery saver policy/)
+      })
+    })
   })
 })
@@ -285,6 +285,47 @@ describe('protocol module', () => {
       await expect(ajax(protocolName + '://fake-host')).to.be.eventually.rejectedWith(Error, '404')
     })
 
+    it('forwards the body of error responses', async () => {
+      const server = http.createServer((req, res) => {
+        res.statusCode = 404
+        res.end(text)
+      })
+      after(() => server.close())
+      await server.listen(0, '127.0.0.1')
+
+      const url = 'http://127.0.0.1:' + (server.address() as AddressInfo).port
+      await registerHttpProtocol(protocolName, (request, callback) => callback({ url }))
+      await contents.loadURL(protocolName + '://fake-host')
+      expect(await contents.executeJavaScript('document.body.textContent')).to.equal(text)
+    })
+
+    it('sends the request with an independent session when session is null', async () => {
+      const server = http.createServer((req, res) => {
+        res.end(text)
+      })
+      after(() => server.close())
+      await server.listen(0, '127.0.0.1')
+
+      const url = 'http://127.0.0.1:' + (server.address() as AddressInfo).port
+      await registerHttpProtocol(protocolName, (request, callback) => callback({ url, session: null }))
+      const r = await ajax(protocolName + '://fake-host')
+      expect(r.data).to.equal(text)
+    })
+
+    it('uses a new session for each request with a null session', async () => {
+      const server = http.createServer((req, res) => {
+        res.setHeader('Set-Cookie', 'name=value')
+        res.end(req.headers.cookie || 'no cookie')
+      })
+      after(() => server.close())
+      await server.listen(0, '127.0.0.1')
+
+      const url = 'http://127.0.0.1:' + (server.address() as AddressInfo).port
+      await registerHttpProtocol(protocolName, (request, callback) => callback({ url, session: null }))
+      expect((await ajax(protocolName + '://fake-host')).data).to.equal('no cookie')
+      expect((await ajax(protocolName + '://fake-host')).data).to.equal('no cookie')
+    })
+
     it('works when target URL redirects', async () => {
       const server = http.createServer((req, res) => {
         if (req.url === '/serverRedirect') {
@@ -411,6 +452,132 @@ describe('protocol module', () => {
       const r = await ajax(protocolName + '://fake-host')
       expect(r.data).to.have.lengthOf(1024 * 1024 * 2)
     })
+
+    it('can write large chunks into a small pipe', async () => {
+      const data = Buffer.alloc(1024 * 1024, 'a')
+      await registerStreamProtocol(protocolName, (request, callback) => {
+        callback({
+          pipeCapacity: 4096,
+          data: getStream(256 * 1024, data)
+        })
+      })
+      const r = await ajax(protocolName + '://fake-host')
+      expect(r.data).to.equal(data.toString())
+    })
+  })
+
+  describe('protocol.registerNativeProtocol', () => {
+    const pagesPath = path.join(fixturesPath, 'pages')
+    const asarPath = path.join(fixturesPath, 'test.asar', 'a.asar')
+
+    it('serves the files of a directory', async () => {
+      expect(protocol.registerNativeProtocol(protocolName, [{ directory: pagesPath }])).to.equal(true)
+      const r = await ajax(protocolName + '://fake-host/a.html')
+      expect(r.data).to.equal(String(fs.readFileSync(path.join(pagesPath, 'a.html'))))
+    })
+
+    it('serves the files inside an asar archive', async () => {
+      protocol.registerNativeProtocol(protocolName, [{ prefix: '/asar/', directory: asarPath }])
+      const r = await ajax(protocolName + '://fake-host/asar/file1')
+      expect(r.data).to.equal(String(fs.readFileSync(path.join(asarPath, 'file1'))))
+    })
+
+    it('serves data from memory', async () => {
+      protocol.registerNativeProtocol(protocolName, [
+        { directory: pagesPath },
+        { path: '/data.json', data: Buffer.from(text), mimeType: 'application/json' }
+      ])
+      const r = await ajax(protocolName + '://fake-host/data.json')
+      expect(r.data).to.equal(text)
+      expect(r.headers).to.include('content-type: application/json')
+    })
+
+    it('fails for the paths no route matches', async () => {
+      protocol.registerNativeProtocol(protocolName, [{ prefix: '/pages/', directory: pagesPath }])
+      await expect(ajax(protocolName + '://fake-host/a.html')).to.be.eventually.rejectedWith(Error, '404')
+    })
+
+    it('matches the prefixes at path boundaries', async () => {
+      protocol.registerNativeProtocol(protocolName, [{ prefix: '/pages', directory: pagesPath }])
+      const r = await ajax(protocolName + '://fake-host/pages/a.html')
+      expect(r.data).to.equal(String(fs.readFileSync(path.join(pagesPath, 'a.html'))))
+      await expect(ajax(protocolName + '://fake-host/pagesa.html')).to.be.eventually.rejectedWith(Error, '404')
+    })
+
+    it('does not serve files outside of the directory', async () => {
+      protocol.registerNativeProtocol(protocolName, [{ directory: pagesPath }])
+      await expect(ajax(protocolName + '://fake-host/%2E%2E/test.asar/a.asar/file1')).to.be.eventually.rejected()
+    })
+
+    it('returns false when the scheme is already registered', async () => {
+      expect(protocol.registerNativeProtocol(protocolName, [{ directory: pagesPath }])).to.equal(true)
+      expect(protocol.registerNativeProtocol(protocolName, [{ directory: pagesPath }])).to.equal(false)
+    })
+
+    it('throws for invalid routes', () => {
+      expect(() => protocol.registerNativeProtocol(protocolName, [{ directory: 'relative' }])).to.throw(/absolute directory/)
+      expect(() => protocol.registerNativeProtocol(protocolName, [{ path: 'a', data: text }])).to.throw(/path starting with/)
+    })
+  })
+
+  describe('protocol.enableResponseCache', () => {
+    afterEach(() => {
+      protocol.disableResponseCache(protocolName)
+    })
+
+    it('serves fresh responses without calling the handler', async () => {
+      let calls = 0
+      await registerStringProtocol(protocolName, (request, callback) => {
+        calls++
+        callback({ data: text, headers: { 'cache-control': 'max-age=60' } })
+      })
+      protocol.enableResponseCache(protocolName)
+      expect((await ajax(protocolName + '://fake-host')).data).to.equal(text)
+      expect((await ajax(protocolName + '://fake-host')).data).to.equal(text)
+      expect(calls).to.equal(1)
+    })
+
+    it('does not store no-store responses', async () => {
+      let calls = 0
+      await registerBufferProtocol(protocolName, (request, callback) => {
+        calls++
+        callback({ data: Buffer.from(text), headers: { 'cache-control': 'no-store' } })
+      })
+      protocol.enableResponseCache(protocolName)
+      await ajax(protocolName + '://fake-host')
+      await ajax(protocolName + '://fake-host')
+      expect(calls).to.equal(2)
+    })
+
+    it('revalidates stale responses with their ETag', async () => {
+      const requests: any[] = []
+      await registerStringProtocol(protocolName, (request, callback) => {
+        requests.push(request)
+        if (request.headers['If-None-Match'] === '"v1"') {
+          callback({ statusCode: 304, data: '' })
+        } else {
+          callback({ data: text, headers: { 'cache-control': 'no-cache', etag: '"v1"' } })
+        }
+      })
+      protocol.enableResponseCache(protocolName)
+      expect((await ajax(protocolName + '://fake-host')).data).to.equal(text)
+      expect((await ajax(protocolName + '://fake-host')).data).to.equal(text)
+      expect(requests).to.have.lengthOf(2)
+      expect(requests[1].headers['If-None-Match']).to.equal('"v1"')
+    })
+
+    it('calls the handler again once disabled', async () => {
+      let calls = 0
+      await registerStringProtocol(protocolName, (request, callback) => {
+        calls++
+        callback({ data: text, headers: { 'cache-control': 'max-age=60' } })
+      })
+      protocol.enableResponseCache(protocolName)
+      await ajax(protocolName + '://fake-host')
+      protocol.disableResponseCache(protocolName)
+      await ajax(protocolName + '://fake-host')
+      expect(calls).to.equal(2)
+    })
   })
 
   describe('protocol.isProtocolHandled', () => {
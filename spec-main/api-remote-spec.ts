@@ -391,6 +391,62 @@ ifdescribe(features.isRemoteModuleEnabled())('remote module', () => {
     })
   })
 
+  describe('remote.prefetch', () => {
+    const w = makeWindow()
+    const remotely = makeRemotely(w)
+
+    remotely.it(path.join(fixtures, 'module', 'prefetch.js'))('reads the prefetched properties until the code awaits', async (module: string) => {
+      const { remote } = require('electron')
+      const a = remote.require(module)
+      a.setName('app')
+      const config = remote.prefetch(a.config, 3)
+      expect(config).to.equal(a.config)
+      expect(config.nested.deeper.level).to.equal(3)
+
+      a.setName('changed')
+      expect(config.name).to.equal('app')
+      await new Promise(resolve => setTimeout(resolve))
+      expect(config.name).to.equal('changed')
+    })
+
+    remotely.it(path.join(fixtures, 'module', 'prefetch.js'))('reads the properties which can not change', (module: string) => {
+      const a = require('electron').remote.require(module)
+      expect(a.frozen.answer).to.equal(42)
+    })
+
+    remotely.it()('throws for values which are not remote objects', () => {
+      const { remote } = require('electron')
+      expect(() => remote.prefetch({})).to.throw('Expected a remote object')
+      expect(() => remote.prefetch(remote.process, 0)).to.throw('depth must be a positive integer')
+    })
+  })
+
+  describe('remote.batch', () => {
+    const w = makeWindow()
+    const remotely = makeRemotely(w)
+
+    remotely.it(path.join(fixtures, 'module', 'prefetch.js'))('sets the properties in order', (module: string) => {
+      const { remote } = require('electron')
+      const a = remote.require(module)
+      const result = remote.batch(() => {
+        a.config.name = 'first'
+        a.config.name = 'second'
+        return 'done'
+      })
+      expect(result).to.equal('done')
+      expect(a.config.name).to.equal('second')
+    })
+
+    remotely.it(path.join(fixtures, 'module', 'prefetch.js'))('sends the properties set before a call', (module: string) => {
+      const { remote } = require('electron')
+      const a = remote.require(module)
+      remote.batch(() => {
+        a.config.name = 'before-call'
+        expect(a.config.name).to.equal('before-call')
+      })
+    })
+  })
+
   describe('remote.createFunctionWithReturnValue', () => {
     const remotely = makeRemotely(makeWindow())
 
@@ -10,6 +10,29 @@ describe('screen module', () => {
     })
   })
 
+  describe('screen.getDisplaysSnapshot()', () => {
+    it('returns the same frozen snapshot until the displays change', () => {
+      const snapshot = screen.getDisplaysSnapshot()
+      expect(snapshot.version).to.be.a('number')
+      expect(snapshot.displays).to.have.lengthOf(screen.getAllDisplays().length)
+      expect(screen.getDisplaysSnapshot()).to.equal(snapshot)
+      expect(Object.isFrozen(snapshot)).to.be.true()
+      expect(Object.isFrozen(snapshot.displays)).to.be.true()
+      expect(Object.isFrozen(snapshot.displays[0].bounds)).to.be.true()
+    })
+  })
+
+  describe('screen.sampleCursor()', () => {
+    it('returns the cursor position and its display', () => {
+      const sample = screen.sampleCursor()
+      expect(sample.x).to.be.a('number')
+      expect(sample.y).to.be.a('number')
+      const snapshot = screen.getDisplaysSnapshot()
+      expect(sample.displaysVersion).to.equal(snapshot.version)
+      expect(snapshot.displays.map(display => display.id)).to.include(sample.displayId)
+    })
+  })
+
   describe('screen.getPrimaryDisplay()', () => {
     it('returns a display object', () => {
       const display = screen.getPrimaryDisplay()
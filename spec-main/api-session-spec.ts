@@ -4,12 +4,12 @@ import * as https from 'https'
 import * as path from 'path'
 import * as fs from 'fs'
 import * as ChildProcess from 'child_process'
-import { session, BrowserWindow, net, ipcMain, Session } from 'electron'
+import { app, session, BrowserWindow, net, ipcMain, Session } from 'electron'
 import * as send from 'send'
 import * as auth from 'basic-auth'
 import { closeAllWindows } from './window-helpers'
 import { emittedOnce } from './events-helpers'
-import { AddressInfo } from 'net'
+import { AddressInfo, Socket } from 'net'
 
 /* The whole session API doesn't use standard callbacks */
 /* eslint-disable standard/no-callback-literal */
@@ -29,6 +29,17 @@ describe('session module', () => {
       expect(session.fromPartition('test')).to.equal(session.fromPartition('test'))
     })
 
+    it('isolates the cookies of lightweight partitions', async () => {
+      const url = 'http://127.0.0.1'
+      const expirationDate = (+new Date()) / 1000 + 120
+      const ses1 = session.fromPartition('lightweight-1', { lightweight: true })
+      const ses2 = session.fromPartition('lightweight-2', { lightweight: true })
+      await ses1.cookies.set({ url, name: 'lightweight', value: '1', expirationDate })
+      expect(await ses1.cookies.get({ url, name: 'lightweight' })).to.have.lengthOf(1)
+      expect(await ses2.cookies.get({ url, name: 'lightweight' })).to.be.empty()
+      expect(await session.defaultSession.cookies.get({ url, name: 'lightweight' })).to.be.empty()
+    })
+
     // TODO(codebytere): remove in Electron v8.0.0
     it.skip('created session is ref-counted (functions)', () => {
       const partition = 'test2'
@@ -169,6 +180,45 @@ describe('session module', () => {
       expect(list.some(cookie => cookie.name === name && cookie.value === value)).to.equal(false)
     })
 
+    it('filters cookies by name prefix', async () => {
+      const { cookies } = session.defaultSession
+      const expirationDate = (+new Date()) / 1000 + 120
+
+      await cookies.set({ url, name: 'prefix-a', value: '1', expirationDate })
+      await cookies.set({ url, name: 'other', value: '2', expirationDate })
+      const list = await cookies.get({ url, namePrefix: 'prefix-' })
+
+      expect(list.map(cookie => cookie.name)).to.deep.equal(['prefix-a'])
+    })
+
+    it('sets and removes many cookies at once', async () => {
+      const { cookies } = session.defaultSession
+      const expirationDate = (+new Date()) / 1000 + 120
+      const details = []
+      for (let i = 0; i < 20; i++) {
+        details.push({ url, name: `many-${i}`, value: `${i}`, expirationDate })
+      }
+      details.push({ url, name: 'kept', value: '1', expirationDate })
+
+      await cookies.setMany(details)
+      expect(await cookies.get({ url })).to.have.lengthOf(21)
+
+      const count = await cookies.removeMany({ url, namePrefix: 'many-' })
+      expect(count).to.equal(20)
+      const list = await cookies.get({ url })
+      expect(list.map(cookie => cookie.name)).to.deep.equal(['kept'])
+    })
+
+    it('does not set any cookie when one of many is invalid', async () => {
+      const { cookies } = session.defaultSession
+
+      await expect(
+        cookies.setMany([{ url, name: 'valid', value: '1' }, { url: 'asdf', name: 'invalid' }])
+      ).to.eventually.be.rejectedWith('Invalid cookie at index 1: Failed to get cookie domain')
+      const list = await cookies.get({ url, name: 'valid' })
+      expect(list).to.be.empty()
+    })
+
     it.skip('should set cookie for standard scheme', async () => {
       const { cookies } = session.defaultSession
       const domain = 'fake-host'
@@ -209,6 +259,40 @@ describe('session module', () => {
       expect(removeEventRemoved).to.equal(true)
     })
 
+    describe('ses.cookies.setChangedEventOptions()', () => {
+      const { cookies } = session.fromPartition('cookies-changed-batch')
+      const expirationDate = (+new Date()) / 1000 + 120
+      afterEach(() => {
+        cookies.setChangedEventOptions({})
+      })
+
+      it('emits the changes in batches', async () => {
+        cookies.setChangedEventOptions({ batchInterval: 50 })
+        let changedEmitted = false
+        cookies.once('changed', () => { changedEmitted = true })
+        const batch = emittedOnce(cookies, 'changed-batch')
+        await cookies.setMany([
+          { url, name: 'batch-1', value: '1', expirationDate },
+          { url, name: 'batch-2', value: '2', expirationDate }
+        ])
+        const [, changes] = await batch
+        expect(changes.map((change: any) => change.cookie.name)).to.deep.equal(['batch-1', 'batch-2'])
+        expect(changes[0].cause).to.equal('explicit')
+        expect(changes[0].removed).to.equal(false)
+        expect(changedEmitted).to.equal(false)
+        cookies.removeAllListeners('changed')
+      })
+
+      it('filters the changes by name', async () => {
+        cookies.setChangedEventOptions({ name: 'wanted' })
+        const changed = emittedOnce(cookies, 'changed')
+        await cookies.set({ url, name: 'unwanted', value: '1', expirationDate })
+        await cookies.set({ url, name: 'wanted', value: '2', expirationDate })
+        const [, cookie] = await changed
+        expect(cookie.name).to.equal('wanted')
+      })
+    })
+
     describe('ses.cookies.flushStore()', async () => {
       it('flushes the cookies to disk', async () => {
         const name = 'foo'
@@ -263,6 +347,30 @@ describe('session module', () => {
     })
   })
 
+  describe('ses.clearStorageData(options) incrementally', () => {
+    it('clears each storage type of each origin in turn', async () => {
+      const ses = session.fromPartition('clear-storage-incremental')
+      const url = 'http://127.0.0.1'
+      await ses.cookies.set({ url, name: 'incremental', value: '1', expirationDate: (+new Date()) / 1000 + 120 })
+      const progress: any[] = []
+      await ses.clearStorageData({
+        origins: [url, 'http://localhost'],
+        storages: ['cookies', 'localstorage'],
+        incremental: true,
+        onProgress: (p: any) => progress.push(p)
+      })
+      expect(progress.map(p => p.completed)).to.deep.equal([1, 2, 3, 4])
+      expect(progress[0]).to.deep.equal({ completed: 1, total: 4, origin: url, storages: ['cookies'] })
+      expect(await ses.cookies.get({ url })).to.be.empty()
+    })
+
+    it('rejects origins that are not strings', async () => {
+      await expect(
+        session.defaultSession.clearStorageData({ origins: [1] as any })
+      ).to.eventually.be.rejectedWith('origins must be an array of strings')
+    })
+  })
+
   describe('will-download event', () => {
     afterEach(closeAllWindows)
     it('can cancel default download behavior', async () => {
@@ -403,17 +511,246 @@ describe('session module', () => {
       const proxy = await customSession.resolveProxy('http://example/')
       expect(proxy).to.equal('DIRECT')
     })
+
+    it('resolves many URLs at once', async () => {
+      await customSession.setProxy({ proxyRules: 'http=myproxy:80' })
+      const urls = []
+      for (let i = 0; i < 20; i++) {
+        urls.push(`http://host${i % 5}.example.com/${i}`)
+        urls.push(`http://host${i % 5}.example.com/${i}`)
+      }
+      const proxies = await Promise.all(urls.map(url => customSession.resolveProxy(url)))
+      expect(proxies).to.deep.equal(urls.map(() => 'PROXY myproxy:80'))
+    })
+
+    it('does not reuse results resolved before the settings changed', async () => {
+      await customSession.setProxy({ proxyRules: 'http=myproxy:80' })
+      expect(await customSession.resolveProxy('http://example.com/')).to.equal('PROXY myproxy:80')
+      await customSession.setProxy({ proxyRules: 'http=otherproxy:80' })
+      expect(await customSession.resolveProxy('http://example.com/')).to.equal('PROXY otherproxy:80')
+    })
+  })
+
+  describe('ses.setPreferencesCommitInterval(interval)', () => {
+    it('writes the collected changes when flushed', async () => {
+      const partition = 'persist:prefs-commit-interval'
+      const ses = session.fromPartition(partition)
+      ses.setPreferencesCommitInterval(60 * 1000)
+      const downloadPath = path.join(app.getPath('temp'), 'prefs-commit-interval')
+      ses.setDownloadPath(downloadPath)
+      await ses.flushPreferences()
+      const prefsPath = path.join(app.getPath('userData'), 'Partitions', 'prefs-commit-interval', 'Preferences')
+      const prefs = JSON.parse(fs.readFileSync(prefsPath, 'utf8'))
+      expect(prefs.download.default_directory).to.equal(downloadPath)
+      ses.setPreferencesCommitInterval(0)
+    })
+
+    it('writes the zoom levels of the hosts when flushed', async () => {
+      const partition = 'persist:prefs-zoom-levels'
+      const ses = session.fromPartition(partition)
+      const server = http.createServer((req, res) => { res.end('<body>zoom</body>') })
+      await new Promise(resolve => server.listen(0, '127.0.0.1', resolve))
+      const w = new BrowserWindow({ show: false, webPreferences: { session: ses } })
+      try {
+        await w.loadURL(`http://127.0.0.1:${(server.address() as AddressInfo).port}/`)
+        w.webContents.zoomLevel = 2
+        w.webContents.zoomLevel = 3
+        await ses.flushPreferences()
+        const prefsPath = path.join(app.getPath('userData'), 'Partitions', 'prefs-zoom-levels', 'Preferences')
+        const prefs = JSON.parse(fs.readFileSync(prefsPath, 'utf8'))
+        const levels = Object.values(prefs.partition.per_host_zoom_levels) as any[]
+        expect(levels.some(hosts => Object.values(hosts).includes(3))).to.be.true('zoom level written')
+      } finally {
+        w.destroy()
+        server.close()
+      }
+    })
+
+    it('throws for a negative interval', () => {
+      expect(() => {
+        session.defaultSession.setPreferencesCommitInterval(-1)
+      }).to.throw('interval must be a non-negative integer')
+    })
+  })
+
+  describe('ses.setRendererProcessPolicy(policy)', () => {
+    let server: http.Server
+    let serverUrl: string
+    before(async () => {
+      server = http.createServer((req, res) => { res.end('<body>shared</body>') })
+      await new Promise(resolve => server.listen(0, '127.0.0.1', resolve))
+      serverUrl = `http://127.0.0.1:${(server.address() as AddressInfo).port}/`
+    })
+    after(() => {
+      server.close()
+    })
+    afterEach(closeAllWindows)
+
+    it('lets the windows of the same site share a process', async () => {
+      const ses = session.fromPartition('renderer-process-policy')
+      ses.setRendererProcessPolicy({ shareProcesses: true })
+      const w1 = new BrowserWindow({ show: false, webPreferences: { session: ses } })
+      await w1.loadURL(serverUrl)
+      const w2 = new BrowserWindow({ show: false, webPreferences: { session: ses } })
+      await w2.loadURL(serverUrl)
+      const processes = ses.getRendererProcesses()
+      expect(processes).to.have.lengthOf(1)
+      expect(processes[0].pid).to.equal(w1.webContents.getOSProcessId())
+      expect(processes[0].webContentsIds).to.have.members([w1.webContents.id, w2.webContents.id])
+      ses.setRendererProcessPolicy({ shareProcesses: false })
+    })
+
+    it('does not share a process between windows with other process preferences', async () => {
+      const ses = session.fromPartition('renderer-process-policy-preferences')
+      ses.setRendererProcessPolicy({ shareProcesses: true })
+      const w1 = new BrowserWindow({ show: false, webPreferences: { session: ses } })
+      await w1.loadURL(serverUrl)
+      const w2 = new BrowserWindow({
+        show: false,
+        webPreferences: { session: ses, v8HeapPolicy: { memorySaver: true } }
+      })
+      await w2.loadURL(serverUrl)
+      const w3 = new BrowserWindow({
+        show: false,
+        webPreferences: { session: ses, additionalArguments: ['--some-arg'] }
+      })
+      await w3.loadURL(serverUrl)
+      expect(ses.getRendererProcesses()).to.have.lengthOf(3)
+      ses.setRendererProcessPolicy({ shareProcesses: false })
+    })
+
+    it('gives each window its own process by default', async () => {
+      const ses = session.fromPartition('renderer-process-policy-default')
+      const w1 = new BrowserWindow({ show: false, webPreferences: { session: ses } })
+      await w1.loadURL(serverUrl)
+      const w2 = new BrowserWindow({ show: false, webPreferences: { session: ses } })
+      await w2.loadURL(serverUrl)
+      expect(ses.getRendererProcesses()).to.have.lengthOf(2)
+    })
+  })
+
+  describe('ses.setPreconnectPredictorEnabled(enabled)', () => {
+    let pageServer: http.Server
+    let assetServer: http.Server
+    let pageUrl: string
+    before(async () => {
+      assetServer = http.createServer((req, res) => {
+        res.setHeader('Content-Type', 'text/css')
+        res.end('body {}')
+      })
+      await new Promise(resolve => assetServer.listen(0, '127.0.0.1', resolve))
+      const assetUrl = `http://localhost:${(assetServer.address() as AddressInfo).port}/style.css`
+      pageServer = http.createServer((req, res) => {
+        res.setHeader('Content-Type', 'text/html')
+        res.end(`<link rel="stylesheet" href="${assetUrl}">`)
+      })
+      await new Promise(resolve => pageServer.listen(0, '127.0.0.1', resolve))
+      pageUrl = `http://127.0.0.1:${(pageServer.address() as AddressInfo).port}/`
+    })
+    after(() => {
+      pageServer.close()
+      assetServer.close()
+    })
+    afterEach(closeAllWindows)
+
+    it('returns no stats while disabled', () => {
+      expect(session.fromPartition('preconnect-predictor-disabled').getPreconnectPredictorStats()).to.be.null()
+    })
+
+    it('preconnects to the origins learned on a previous visit', async () => {
+      const ses = session.fromPartition('preconnect-predictor')
+      ses.setPreconnectPredictorEnabled(true)
+      const w = new BrowserWindow({ show: false, webPreferences: { session: ses } })
+      await w.loadURL(pageUrl)
+      expect(ses.getPreconnectPredictorStats()).to.deep.equal({ preconnects: 0, hits: 0, misses: 0, hosts: 1 })
+      await w.loadURL(pageUrl)
+      const stats = ses.getPreconnectPredictorStats()!
+      expect(stats.preconnects).to.equal(1)
+      expect(stats.hits).to.equal(1)
+
+      ses.clearPreconnectPredictor()
+      expect(ses.getPreconnectPredictorStats()!.hosts).to.equal(0)
+      ses.setPreconnectPredictorEnabled(false)
+    })
+  })
+
+  describe('ses.getCacheStats()', () => {
+    let server: http.Server
+    let url: string
+    before(async () => {
+      server = http.createServer((req, res) => {
+        res.setHeader('Cache-Control', 'max-age=3600')
+        res.end('cached')
+      })
+      await new Promise(resolve => server.listen(0, '127.0.0.1', resolve))
+      url = `http://127.0.0.1:${(server.address() as AddressInfo).port}/`
+    })
+    after(() => {
+      server.close()
+    })
+
+    const fetchTwice = async (ses: Session) => {
+      for (let i = 0; i < 2; i++) {
+        await new Promise((resolve, reject) => {
+          const request = net.request({ url, session: ses })
+          request.on('response', (response) => {
+            response.on('data', () => {})
+            response.on('end', resolve)
+          })
+          request.on('error', reject)
+          request.end()
+        })
+      }
+    }
+
+    it('counts the requests served from a memory cache', async () => {
+      const ses = session.fromPartition('cache-stats-memory', { cacheType: 'memory' })
+      ses.webRequest.setMetricsEnabled(true)
+      await fetchTwice(ses)
+      const stats = await ses.getCacheStats()
+      expect(stats.hits).to.equal(1)
+      expect(stats.misses).to.equal(1)
+      ses.webRequest.setMetricsEnabled(false)
+    })
+
+    it('does not cache when the cache type is none', async () => {
+      const ses = session.fromPartition('cache-stats-none', { cacheType: 'none' })
+      ses.webRequest.setMetricsEnabled(true)
+      await fetchTwice(ses)
+      const stats = await ses.getCacheStats()
+      expect(stats.hits).to.equal(0)
+      expect(stats.misses).to.equal(2)
+      expect(stats.size).to.equal(0)
+      ses.webRequest.setMetricsEnabled(false)
+    })
   })
 
   describe('ses.getBlobData()', () => {
     const scheme = 'cors-blob'
     const protocol = session.defaultSession.protocol
     const url = `${scheme}://host`
-    after(async () => {
+    afterEach(async () => {
       await protocol.unregisterProtocol(scheme)
     })
     afterEach(closeAllWindows)
 
+    const postBlob = (postData: string, handler: (uuid: string) => void) => {
+      const content = `<html>
+                       <script>
+                       fetch('${url}', {method:'POST', body: new Blob(['${postData}'])});
+                       </script>
+                       </html>`
+      protocol.registerStringProtocol(scheme, (request, callback) => {
+        if (request.method === 'GET') {
+          callback({ data: content, mimeType: 'text/html' })
+        } else if (request.method === 'POST') {
+          handler(request.uploadData[0].blobUUID!)
+        }
+      })
+      const w = new BrowserWindow({ show: false })
+      w.loadURL(url)
+    }
+
     it('returns blob data for uuid', (done) => {
       const postData = JSON.stringify({
         type: 'blob',
@@ -444,6 +781,43 @@ describe('session module', () => {
         w.loadURL(url)
       })
     })
+
+    it('returns a range of the blob data', (done) => {
+      postBlob('0123456789', async (uuid) => {
+        try {
+          const ses = session.defaultSession
+          expect((await ses.getBlobData(uuid, { offset: 2, length: 3 })).toString()).to.equal('234')
+          expect((await ses.getBlobData(uuid, { offset: 8 })).toString()).to.equal('89')
+          expect((await ses.getBlobData(uuid, { offset: 20 })).length).to.equal(0)
+          expect((await ses.getBlobData(uuid)).toString()).to.equal('0123456789')
+          done()
+        } catch (e) {
+          done(e)
+        }
+      })
+    })
+
+    it('streams the blob data in chunks', (done) => {
+      postBlob('0123456789', async (uuid) => {
+        try {
+          const chunks = []
+          for await (const chunk of session.defaultSession.createBlobDataStream(uuid, { offset: 1, chunkSize: 4 })) {
+            expect(chunk.length).to.be.at.most(4)
+            chunks.push(chunk)
+          }
+          expect(Buffer.concat(chunks).toString()).to.equal('123456789')
+          done()
+        } catch (e) {
+          done(e)
+        }
+      })
+    })
+
+    it('throws for an invalid chunk size', () => {
+      expect(() => {
+        session.defaultSession.createBlobDataStream('invalid', { chunkSize: 0 })
+      }).to.throw(/chunkSize must be a positive integer/)
+    })
   })
 
   describe('ses.setCertificateVerifyProc(callback)', () => {
@@ -524,6 +898,55 @@ describe('session module', () => {
       expect(w.webContents.getTitle()).to.equal(url + '/test')
       expect(numVerificationRequests).to.equal(1)
     })
+
+    describe('with cached verdicts', () => {
+      const sockets = new Set<Socket>()
+      let ses: Session
+      beforeEach(() => {
+        server.on('connection', (socket: Socket) => {
+          sockets.add(socket)
+          socket.once('close', () => sockets.delete(socket))
+        })
+        ses = session.fromPartition(`cert-verdicts-${Math.random()}`)
+      })
+      afterEach(() => {
+        ses.setCertificateVerifyProc(null)
+      })
+
+      // Loads the page twice in a fresh session. Before the second load the
+      // connection is dropped, and setting the proc of another session clears
+      // the certificate verifier caches of the network service, so the second
+      // load is answered by the verdicts of |ses| or by its proc.
+      const loadTwice = async () => {
+        const url = `https://127.0.0.1:${(server.address() as AddressInfo).port}`
+        const w = new BrowserWindow({ show: false, webPreferences: { session: ses } })
+        await w.loadURL(url)
+        for (const socket of sockets) socket.destroy()
+        session.fromPartition(`cert-verdicts-other-${Math.random()}`).setCertificateVerifyProc(null)
+        await w.loadURL(url + '/test')
+        expect(w.webContents.getTitle()).to.equal('hello')
+      }
+
+      it('reuses the verdicts it is asked to cache', async () => {
+        let numVerificationRequests = 0
+        ses.setCertificateVerifyProc((e, callback) => {
+          numVerificationRequests++
+          callback(0, { cache: true })
+        })
+        await loadTwice()
+        expect(numVerificationRequests).to.equal(1)
+      })
+
+      it('asks again for the verdicts it is not asked to cache', async () => {
+        let numVerificationRequests = 0
+        ses.setCertificateVerifyProc((e, callback) => {
+          numVerificationRequests++
+          callback(0)
+        })
+        await loadTwice()
+        expect(numVerificationRequests).to.equal(2)
+      })
+    })
   })
 
   describe('ses.clearAuthCache(options)', () => {
@@ -632,6 +1055,23 @@ describe('session module', () => {
       session.defaultSession.downloadURL(`${url}:${port}`)
     })
 
+    it('coalesces the updated events with setUpdatedEventInterval', (done) => {
+      const port = address.port
+      session.defaultSession.once('will-download', function (e, item) {
+        expect(() => item.setUpdatedEventInterval(-1)).to.throw('interval must be a non-negative integer')
+        item.setUpdatedEventInterval(60 * 1000)
+        item.savePath = downloadFilePath
+        let updates = 0
+        item.on('updated', () => { updates++ })
+        item.on('done', function (e, state) {
+          assertDownload(state, item)
+          expect(updates).to.be.at.most(1)
+          done()
+        })
+      })
+      session.defaultSession.downloadURL(`${url}:${port}`)
+    })
+
     it('can download using WebContents.downloadURL', (done) => {
       const port = address.port
       const w = new BrowserWindow({ show: false })
@@ -898,6 +1338,93 @@ describe('session module', () => {
     })
   })
 
+  describe('ses.setPreloadBundle(source)', () => {
+    afterEach(closeAllWindows)
+
+    it('runs the bundle in the frames of sandboxed renderers', async () => {
+      const ses = session.fromPartition('' + Math.random())
+      const source = 'window.bundleRuns = (window.bundleRuns || 0) + 1'
+      ses.setPreloadBundle(source)
+      expect(ses.getPreloadBundle()).to.equal(source)
+      for (let i = 0; i < 2; i++) {
+        // The second window may reuse the renderer process, which keeps the
+        // bundle it got for the first one.
+        const w = new BrowserWindow({ show: false, webPreferences: { sandbox: true, session: ses } })
+        await w.loadFile(path.join(fixtures, 'pages', 'blank.html'))
+        expect(await w.webContents.executeJavaScript('window.bundleRuns')).to.equal(1)
+      }
+    })
+
+    it('can be removed', async () => {
+      const ses = session.fromPartition('' + Math.random())
+      ses.setPreloadBundle('window.bundleRuns = 1')
+      ses.setPreloadBundle(null)
+      expect(ses.getPreloadBundle()).to.be.null()
+      const w = new BrowserWindow({ show: false, webPreferences: { sandbox: true, session: ses } })
+      await w.loadFile(path.join(fixtures, 'pages', 'blank.html'))
+      expect(await w.webContents.executeJavaScript('window.bundleRuns')).to.be.undefined()
+    })
+  })
+
+  describe('ses.setCorsOriginAccessLists(entries)', () => {
+    it('resolves once the lists of many origins are applied', async () => {
+      const ses = session.fromPartition('' + Math.random())
+      const entries = []
+      for (let i = 0; i < 100; i++) {
+        entries.push({
+          origin: `https://app${i}.example.com`,
+          allowList: [{ protocol: 'https', domain: 'example.com', allowSubdomains: true }],
+          blockList: [{ protocol: 'https', domain: 'admin.example.com', port: 443 }]
+        })
+      }
+      await ses.setCorsOriginAccessLists(entries)
+      // Empty lists remove those of the origin.
+      await ses.setCorsOriginAccessLists([{ origin: 'https://app0.example.com' }])
+    })
+
+    it('rejects an entry without a valid origin', async () => {
+      const ses = session.fromPartition('' + Math.random())
+      await expect(ses.setCorsOriginAccessLists([{ origin: 'not an origin' }] as any)).to.eventually.be.rejectedWith(/valid 'origin'/)
+    })
+
+    describe('with a cross-origin server', () => {
+      let pageServer: http.Server
+      let targetServer: http.Server
+      let pageUrl: string
+      let targetPort: number
+      before(async () => {
+        pageServer = http.createServer((req, res) => res.end('<html></html>'))
+        targetServer = http.createServer((req, res) => res.end('ok'))
+        await new Promise(resolve => pageServer.listen(0, '127.0.0.1', resolve))
+        await new Promise(resolve => targetServer.listen(0, '127.0.0.1', resolve))
+        pageUrl = `http://127.0.0.1:${(pageServer.address() as AddressInfo).port}`
+        targetPort = (targetServer.address() as AddressInfo).port
+      })
+      after(() => {
+        pageServer.close()
+        targetServer.close()
+      })
+      afterEach(closeAllWindows)
+
+      it('lets the origin fetch the allowed origins', async () => {
+        const ses = session.fromPartition('' + Math.random())
+        const w = new BrowserWindow({ show: false, webPreferences: { session: ses } })
+        await w.loadURL(pageUrl)
+        const fetchTarget = () => w.webContents.executeJavaScript(`fetch('http://127.0.0.1:${targetPort}/').then(r => r.text())`)
+        await expect(fetchTarget()).to.eventually.be.rejected()
+
+        await ses.setCorsOriginAccessLists([{
+          origin: pageUrl,
+          allowList: [{ protocol: 'http', domain: '127.0.0.1', port: targetPort }]
+        }])
+        expect(await fetchTarget()).to.equal('ok')
+
+        await ses.setCorsOriginAccessLists([{ origin: pageUrl }])
+        await expect(fetchTarget()).to.eventually.be.rejected()
+      })
+    })
+  })
+
   describe('ses.setUserAgent()', () => {
     afterEach(closeAllWindows)
 
@@ -0,0 +1,59 @@
+import { expect } from 'chai'
+import { BrowserWindow, sharedMemory } from 'electron'
+import { closeAllWindows } from './window-helpers'
+
+describe('sharedMemory module', () => {
+  describe('sharedMemory.create()', () => {
+    it('creates a zeroed region of the given size', () => {
+      const memory = sharedMemory.create(4096)
+      expect(memory.size).to.equal(4096)
+      expect(memory.buffer.byteLength).to.equal(4096)
+      expect(new Uint8Array(memory.buffer).every(byte => byte === 0)).to.be.true()
+    })
+
+    it('throws when the size is not positive', () => {
+      expect(() => sharedMemory.create(0)).to.throw(/positive integer/)
+      expect(() => sharedMemory.create(-1)).to.throw(/positive integer/)
+    })
+  })
+
+  describe('webContents.sendSharedMemory()', () => {
+    afterEach(closeAllWindows)
+
+    const receive = (w: BrowserWindow, write: boolean) => w.webContents.executeJavaScript(`new Promise(resolve => {
+      const { ipcRenderer } = require('electron')
+      ipcRenderer.once('memory', (event, buffer) => {
+        const bytes = new Uint8Array(buffer)
+        if (${write}) bytes[1] = 7
+        resolve([buffer.byteLength, bytes[0], buffer instanceof SharedArrayBuffer])
+      })
+    })`)
+
+    it('maps the region in the renderer', async () => {
+      const w = new BrowserWindow({ show: false, webPreferences: { nodeIntegration: true } })
+      await w.loadURL('about:blank')
+      const memory = sharedMemory.create(4096)
+      new Uint8Array(memory.buffer).fill(42)
+      const received = receive(w, true)
+      expect(w.webContents.sendSharedMemory('memory', memory)).to.be.true()
+      expect(await received).to.deep.equal([4096, 42, false])
+      // The renderer wrote to the same pages.
+      expect(new Uint8Array(memory.buffer)[1]).to.equal(7)
+    })
+
+    it('sends a SharedArrayBuffer with the shared option', async () => {
+      const w = new BrowserWindow({ show: false, webPreferences: { nodeIntegration: true } })
+      await w.loadURL('about:blank')
+      const memory = sharedMemory.create(16)
+      const received = receive(w, false)
+      expect(w.webContents.sendSharedMemory('memory', memory, { shared: true })).to.be.true()
+      expect((await received)[2]).to.be.true()
+    })
+
+    it('returns false for a frame which does not exist', () => {
+      const w = new BrowserWindow({ show: false })
+      const memory = sharedMemory.create(16)
+      expect(w.webContents.sendSharedMemory('memory', memory, { frameId: -100 })).to.be.false()
+    })
+  })
+})
@@ -1,8 +1,12 @@
+import { expect } from 'chai'
 import { BrowserWindow, shell } from 'electron'
 import { closeAllWindows } from './window-helpers'
 import { emittedOnce } from './events-helpers'
+import * as fs from 'fs'
 import * as http from 'http'
 import { AddressInfo } from 'net'
+import * as os from 'os'
+import * as path from 'path'
 
 describe('shell module', () => {
   describe('shell.openExternal()', () => {
@@ -56,4 +60,27 @@ describe('shell module', () => {
       ])
     })
   })
+
+  describe('shell.trashItems()', () => {
+    it('moves the items to the trash', async () => {
+      const dir = fs.mkdtempSync(path.join(os.tmpdir(), 'electron-trash-items-'))
+      const paths = ['trash-1', 'trash-2'].map(name => path.join(dir, name))
+      for (const item of paths) fs.writeFileSync(item, 'trash')
+      try {
+        expect(await shell.trashItems(paths)).to.deep.equal([true, true])
+        for (const item of paths) expect(fs.existsSync(item)).to.be.false()
+      } finally {
+        fs.rmdirSync(dir, { recursive: true })
+      }
+    })
+
+    it('resolves with false for the items which do not exist', async () => {
+      const paths = ['does-not-exist-1', 'does-not-exist-2'].map(name => path.join(os.tmpdir(), name))
+      expect(await shell.trashItems(paths)).to.deep.equal([false, false])
+    })
+
+    it('rejects when the paths are not an array', async () => {
+      await expect(shell.trashItems('not-an-array' as any)).to.eventually.be.rejectedWith(/array of strings/)
+    })
+  })
 })
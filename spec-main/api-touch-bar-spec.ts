@@ -106,5 +106,30 @@ describe('TouchBar module', () => {
       window.setTouchBar(touchBar)
       window.emit('-touch-bar-interaction', {}, (button as any).id)
     })
+
+    it('updates each item once with the properties changed in a tick', async () => {
+      const slider = new TouchBarSlider({ value: 5 })
+      const scrubber = new TouchBarScrubber({ items: [{ label: 'foo' }] })
+      window.setTouchBar(new TouchBar({ items: [slider, scrubber] }))
+
+      const updates: [string, string[]][] = []
+      const w = window as any
+      const refreshTouchBarItem = w._refreshTouchBarItem
+      w._refreshTouchBarItem = (itemID: string, properties: string[]) => {
+        updates.push([itemID, properties])
+        refreshTouchBarItem.call(w, itemID, properties)
+      }
+      slider.value = 6
+      slider.value = 7
+      slider.label = 'slide'
+      scrubber.items = [{ label: 'bar' }]
+      expect(updates).to.be.empty()
+
+      await new Promise(resolve => process.nextTick(resolve))
+      expect(updates).to.deep.equal([
+        [(slider as any).id, ['value', 'label']],
+        [(scrubber as any).id, ['items']]
+      ])
+    })
   })
 })
@@ -76,6 +76,31 @@ describe('tray module', () => {
     it('accepts empty image', () => {
       tray.setImage(nativeImage.createEmpty())
     })
+
+    it('can be called many times in a row', () => {
+      for (let i = 0; i < 100; i++) {
+        tray.setImage(nativeImage.createEmpty())
+      }
+    })
+  })
+
+  describe('tray.setAnimation(frames, interval)', () => {
+    it('accepts empty images', async () => {
+      tray.setAnimation([nativeImage.createEmpty(), nativeImage.createEmpty()], 20)
+      await new Promise(resolve => setTimeout(resolve, 100))
+      tray.setImage(nativeImage.createEmpty())
+    })
+
+    it('stops the animation when there are no frames', () => {
+      tray.setAnimation([nativeImage.createEmpty()], 20)
+      tray.setAnimation([], 20)
+    })
+
+    it('throws for invalid intervals', () => {
+      expect(() => {
+        tray.setAnimation([nativeImage.createEmpty()], 0)
+      }).to.throw(/positive number/)
+    })
   })
 
   describe('tray.setPressedImage(image)', () => {
@@ -7,7 +7,7 @@ import * as ChildProcess from 'child_process'
 import { BrowserWindow, ipcMain, webContents, session, WebContents, app, clipboard } from 'electron'
 import { emittedOnce } from './events-helpers'
 import { closeAllWindows } from './window-helpers'
-import { ifdescribe, ifit } from './spec-helpers'
+import { ifdescribe, ifit, delay } from './spec-helpers'
 
 const fixturesPath = path.resolve(__dirname, '..', 'spec', 'fixtures')
 const features = process.electronBinding('features')
@@ -37,6 +37,21 @@ describe('webContents module', () => {
       expect(all[all.length - 2].getType()).to.equal('webview')
       expect(all[all.length - 1].getType()).to.equal('remote')
     })
+
+    it('returns arrays the caller can change, which follow added and removed web contents', async () => {
+      const before = webContents.getAllWebContents()
+      before.length = 0
+      const w = new BrowserWindow({ show: false })
+      const { id } = w.webContents
+      const during = webContents.getAllWebContents()
+      expect(during.map(c => c.id)).to.include(id)
+      during.length = 0
+      expect(webContents.getAllWebContents().map(c => c.id)).to.include(id)
+      const destroyed = emittedOnce(w.webContents, 'destroyed')
+      w.destroy()
+      await destroyed
+      expect(webContents.getAllWebContents().map(c => c.id)).to.not.include(id)
+    })
   })
 
   describe('will-prevent-unload event', () => {
@@ -98,6 +113,99 @@ describe('webContents module', () => {
     })
   })
 
+  describe('webContents.sendWithTransfer()', () => {
+    afterEach(closeAllWindows)
+    it('moves the transferred ArrayBuffers to the renderer', async () => {
+      const w = new BrowserWindow({ show: false, webPreferences: { nodeIntegration: true } })
+      await w.loadURL('about:blank')
+      const received = w.webContents.executeJavaScript(`new Promise(resolve => {
+        const { ipcRenderer } = require('electron')
+        ipcRenderer.once('buffer', (event, buffer) => {
+          resolve([buffer.byteLength, new Uint8Array(buffer)[0]])
+        })
+      })`)
+      const buffer = new Uint8Array(4096).fill(42).buffer
+      w.webContents.sendWithTransfer('buffer', [buffer], buffer)
+      expect(buffer.byteLength).to.equal(0)
+      expect(await received).to.deep.equal([4096, 42])
+    })
+
+    it('throws when the transfer list holds something else', () => {
+      const w = new BrowserWindow({ show: false })
+      expect(() => {
+        w.webContents.sendWithTransfer('buffer', [{} as any], {})
+      }).to.throw(/detachable ArrayBuffers/)
+    })
+  })
+
+  describe('webContents.broadcast()', () => {
+    afterEach(closeAllWindows)
+
+    const listen = (w: BrowserWindow) => w.webContents.executeJavaScript(`new Promise(resolve => {
+      const { ipcRenderer } = require('electron')
+      ipcRenderer.once('broadcast', (event, payload) => resolve(payload.length))
+    })`)
+
+    it('sends a large message to every window', async () => {
+      const windows = [0, 1, 2].map(() => new BrowserWindow({ show: false, webPreferences: { nodeIntegration: true } }))
+      await Promise.all(windows.map(w => w.loadURL('about:blank')))
+      const received = windows.map(listen)
+      expect(webContents.broadcast('broadcast', 'a'.repeat(256 * 1024))).to.be.true()
+      expect(await Promise.all(received)).to.deep.equal([256 * 1024, 256 * 1024, 256 * 1024])
+    })
+
+    it('only sends to the web contents of the session with session.broadcast()', async () => {
+      const ses = session.fromPartition('broadcast')
+      const w1 = new BrowserWindow({ show: false, webPreferences: { nodeIntegration: true, session: ses } })
+      const w2 = new BrowserWindow({ show: false, webPreferences: { nodeIntegration: true } })
+      await Promise.all([w1.loadURL('about:blank'), w2.loadURL('about:blank')])
+      const received = listen(w1)
+      let leaked = false
+      ipcMain.once('leaked', () => { leaked = true })
+      w2.webContents.executeJavaScript(`require('electron').ipcRenderer.once('broadcast', () => {
+        require('electron').ipcRenderer.send('leaked')
+      })`)
+      ses.broadcast('broadcast', 'hello')
+      expect(await received).to.equal(5)
+      await w2.webContents.executeJavaScript('null')
+      expect(leaked).to.be.false()
+      ipcMain.removeAllListeners('leaked')
+    })
+  })
+
+  describe('webContents.enableIpcBatching()', () => {
+    afterEach(closeAllWindows)
+    it('delivers batched messages in order', async () => {
+      const w = new BrowserWindow({ show: false, webPreferences: { nodeIntegration: true } })
+      await w.loadURL('about:blank')
+      const received = w.webContents.executeJavaScript(`new Promise(resolve => {
+        const { ipcRenderer } = require('electron')
+        const messages = []
+        ipcRenderer.on('batched', (event, n) => messages.push(n))
+        ipcRenderer.on('done', () => resolve(messages))
+      })`)
+      w.webContents.enableIpcBatching({ channels: ['batched'] })
+      w.webContents.send('batched', 1)
+      w.webContents.send('batched', 2)
+      w.webContents.send('done')
+      w.webContents.disableIpcBatching()
+      expect(await received).to.deep.equal([1, 2])
+    })
+
+    it('can deliver a batch as an array', async () => {
+      const w = new BrowserWindow({ show: false, webPreferences: { nodeIntegration: true } })
+      await w.loadURL('about:blank')
+      const received = w.webContents.executeJavaScript(`new Promise(resolve => {
+        const { ipcRenderer } = require('electron')
+        ipcRenderer.once('batched', (event, messages) => resolve(messages))
+      })`)
+      w.webContents.enableIpcBatching({ deliverAs: 'array' })
+      w.webContents.send('batched', 1, 'a')
+      w.webContents.send('batched', 2, 'b')
+      expect(await received).to.deep.equal([[1, 'a'], [2, 'b']])
+    })
+  })
+
   ifdescribe(features.isPrintingEnabled())('webContents.print()', () => {
     afterEach(closeAllWindows)
     it('throws when invalid settings are passed', () => {
@@ -121,6 +229,32 @@ describe('webContents module', () => {
     })
   })
 
+  describe('native events', () => {
+    afterEach(closeAllWindows)
+
+    it('are emitted to listeners added after the previous ones were removed', async () => {
+      const w = new BrowserWindow({ show: false })
+      const listener = () => {}
+      w.webContents.on('did-start-navigation', listener)
+      w.webContents.removeListener('did-start-navigation', listener)
+      w.webContents.once('did-start-navigation', listener)
+      w.webContents.removeAllListeners('did-start-navigation')
+      const started = emittedOnce(w.webContents, 'did-start-navigation')
+      await w.loadURL('about:blank')
+      const [, url] = await started
+      expect(url).to.equal('about:blank')
+    })
+
+    it('are emitted to listeners added with prependListener()', async () => {
+      const w = new BrowserWindow({ show: false })
+      const started = new Promise(resolve => {
+        w.webContents.prependListener('did-start-navigation', resolve)
+      })
+      await w.loadURL('about:blank')
+      await started
+    })
+  })
+
   describe('webContents.executeJavaScript', () => {
     describe('in about:blank', () => {
       const expected = 'hello, world!'
@@ -164,6 +298,43 @@ describe('webContents module', () => {
       })
     })
 
+    describe('in several frames', () => {
+      let w: BrowserWindow
+      let frameIds: number[]
+      before(async () => {
+        w = new BrowserWindow({ show: false, webPreferences: { nodeIntegration: true } })
+        await w.loadURL('about:blank')
+        frameIds = await w.webContents.executeJavaScript(`new Promise(resolve => {
+          window.name = 'main'
+          for (const name of ['first', 'second']) {
+            const iframe = document.createElement('iframe')
+            iframe.name = name
+            document.body.appendChild(iframe)
+          }
+          const { webFrame } = require('electron')
+          resolve([webFrame.routingId, webFrame.firstChild.routingId, webFrame.firstChild.nextSibling.routingId])
+        })`)
+      })
+      after(closeAllWindows)
+
+      it('resolves with the results of the frames in order', async () => {
+        const results = await w.webContents.executeJavaScriptInFrames([frameIds[2], frameIds[0], frameIds[1]], '({ name: window.name })')
+        expect(results).to.deep.equal([{ name: 'second' }, { name: 'main' }, { name: 'first' }])
+      })
+      it('rejects when a frame is not found', async () => {
+        await expect(w.webContents.executeJavaScriptInFrames([frameIds[0], -1], 'null')).to.eventually.be.rejected()
+      })
+      it('rejects when the code throws', async () => {
+        await expect(w.webContents.executeJavaScriptInFrames(frameIds, 'throw new Error("woops")')).to.eventually.be.rejected()
+      })
+      it('rejects a frame outside of the frame tree of the caller', async () => {
+        const error = await w.webContents.executeJavaScript(`
+          require('electron').webFrame.firstChild.executeJavaScriptInFrames([${frameIds[0]}], 'null')
+            .then(() => null, error => error.message)`)
+        expect(error).to.match(/is not in this frame tree/)
+      })
+    })
+
     describe('on a real page', () => {
       let w: BrowserWindow
       beforeEach(() => {
@@ -662,6 +833,41 @@ describe('webContents module', () => {
     })
   })
 
+  describe('sendInputEvents(events)', () => {
+    let w: BrowserWindow
+    beforeEach(async () => {
+      w = new BrowserWindow({ show: false, webPreferences: { nodeIntegration: true } })
+      await w.loadFile(path.join(fixturesPath, 'pages', 'key-events.html'))
+    })
+    afterEach(closeAllWindows)
+
+    it('sends the events in order', (done) => {
+      ipcMain.once('keypress', (event, key, code, keyCode, shiftKey) => {
+        expect(key).to.equal('A')
+        expect(shiftKey).to.be.true()
+        done()
+      })
+      w.webContents.sendInputEvents([
+        { type: 'mouseMove', x: 1, y: 1 },
+        { type: 'mouseMove', x: 2, y: 2 },
+        { type: 'keyDown', keyCode: 'A' },
+        { type: 'char', keyCode: 'A', modifiers: ['shift'] }
+      ])
+    })
+
+    it('throws when an event is invalid', () => {
+      expect(() => {
+        w.webContents.sendInputEvents([{ type: 'keyDown', keyCode: 'A' }, { type: 'foo' } as any])
+      }).to.throw(/Invalid event object at index 1/)
+    })
+
+    it('throws when the events are not an array', () => {
+      expect(() => {
+        w.webContents.sendInputEvents({ type: 'keyDown', keyCode: 'A' } as any)
+      }).to.throw(/inputEvents must be an array/)
+    })
+  })
+
   describe('insertCSS', () => {
     afterEach(closeAllWindows)
     it('supports inserting CSS', async () => {
@@ -957,6 +1163,54 @@ describe('webContents module', () => {
       })
       w.loadFile(path.join(fixturesPath, 'pages', 'c.html'))
     })
+
+    it('can get the zoom level asynchronously with webFrame', async () => {
+      const w = new BrowserWindow({ show: false, webPreferences: { nodeIntegration: true } })
+      await w.loadFile(path.join(fixturesPath, 'pages', 'c.html'))
+      const zoomLevel = await w.webContents.executeJavaScript(`
+        const { webFrame } = require('electron')
+        webFrame.setZoomLevel(0.6)
+        webFrame.getZoomLevelAsync()
+      `)
+      expect(zoomLevel).to.equal(0.6)
+      expect(w.webContents.zoomLevel).to.equal(0.6)
+    })
+
+    it('updates the zoom level of webFrame when webContents changes it', async () => {
+      const w = new BrowserWindow({ show: false, webPreferences: { nodeIntegration: true } })
+      await w.loadFile(path.join(fixturesPath, 'pages', 'c.html'))
+      await w.webContents.executeJavaScript(`require('electron').webFrame.getZoomLevelAsync()`)
+      w.webContents.zoomLevel = 1.5
+      // The update is sent to the renderer asynchronously.
+      let zoomLevel = 0
+      for (let i = 0; i < 50 && zoomLevel !== 1.5; i++) {
+        await delay(20)
+        zoomLevel = await w.webContents.executeJavaScript(`require('electron').webFrame.getZoomLevel()`)
+      }
+      expect(zoomLevel).to.equal(1.5)
+    })
+
+    it('does not let stale updates replace the zoom level webFrame set', async () => {
+      const w = new BrowserWindow({ show: false, webPreferences: { nodeIntegration: true } })
+      await w.loadFile(path.join(fixturesPath, 'pages', 'c.html'))
+      const zoomLevels = await w.webContents.executeJavaScript(`new Promise(resolve => {
+        const { webFrame } = require('electron')
+        const zoomLevels = []
+        let level = 0
+        const next = () => {
+          if (level === 10) return resolve(zoomLevels)
+          webFrame.setZoomLevel(++level / 10)
+          // The update of the previous level may arrive in between.
+          setTimeout(() => {
+            zoomLevels.push(webFrame.getZoomLevel() === level / 10)
+            next()
+          })
+        }
+        next()
+      })`)
+      expect(zoomLevels.every((matches: boolean) => matches)).to.equal(true)
+      expect(w.webContents.zoomLevel).to.equal(1)
+    })
   })
 
   describe('webrtc ip policy api', () => {
@@ -1259,6 +1513,62 @@ describe('webContents module', () => {
     })
   })
 
+  describe('setWindowOpenHandler()', () => {
+    afterEach(closeAllWindows)
+
+    it('denies window.open without emitting new-window', async () => {
+      const w = new BrowserWindow({ show: false })
+      await w.loadURL('about:blank')
+      w.webContents.setWindowOpenHandler(() => ({ action: 'deny' }))
+      w.webContents.once('new-window', () => { throw new Error('new-window should not be emitted') })
+      const opened = await w.webContents.executeJavaScript('window.open("about:blank") === null')
+      expect(opened).to.be.true('window.open returned null')
+    })
+
+    it('reuses the decisions it was asked to cache', async () => {
+      const w = new BrowserWindow({ show: false })
+      await w.loadURL('about:blank')
+      let calls = 0
+      w.webContents.setWindowOpenHandler(() => {
+        calls++
+        return {
+          action: 'allow',
+          overrideBrowserWindowOptions: { show: false, width: 321, height: 123 },
+          cacheFor: 'about:*'
+        }
+      })
+      for (let i = 0; i < 2; i++) {
+        const created = emittedOnce(app, 'browser-window-created')
+        w.webContents.executeJavaScript('window.open("about:blank"); null')
+        const [, popup] = await created
+        expect(popup.getSize()).to.deep.equal([321, 123])
+      }
+      expect(calls).to.equal(1)
+
+      w.webContents.clearWindowOpenDecisions()
+      const created = emittedOnce(app, 'browser-window-created')
+      w.webContents.executeJavaScript('window.open("about:blank"); null')
+      await created
+      expect(calls).to.equal(2)
+    })
+
+    it('goes through new-window when the handler returns null', async () => {
+      const w = new BrowserWindow({ show: false })
+      await w.loadURL('about:blank')
+      w.webContents.setWindowOpenHandler(() => null)
+      const newWindow = emittedOnce(w.webContents, 'new-window')
+      w.webContents.executeJavaScript('window.open("about:blank"); null')
+      await newWindow
+    })
+
+    it('throws when the handler is not a function', () => {
+      const w = new BrowserWindow({ show: false })
+      expect(() => {
+        w.webContents.setWindowOpenHandler('handler' as any)
+      }).to.throw('handler must be a function or null')
+    })
+  })
+
   describe('webframe messages in sandboxed contents', () => {
     afterEach(closeAllWindows)
     it('responds to executeJavaScript', async () => {
@@ -1383,6 +1693,90 @@ describe('webContents module', () => {
     })
   })
 
+  describe('takeHeapSnapshotStream()', () => {
+    afterEach(closeAllWindows)
+
+    it('streams the snapshot in chunks', async () => {
+      const w = new BrowserWindow({ show: false })
+      await w.loadURL('about:blank')
+
+      const chunks: Buffer[] = []
+      const stream = w.webContents.takeHeapSnapshotStream({ chunkSize: 4096 })
+      stream.on('data', (chunk: Buffer) => chunks.push(chunk))
+      await emittedOnce(stream, 'end')
+
+      expect(chunks.length).to.be.greaterThan(1)
+      expect(chunks.every(chunk => chunk.length <= 4096)).to.be.true()
+      const snapshot = JSON.parse(Buffer.concat(chunks).toString())
+      expect(snapshot).to.have.property('snapshot')
+      expect(snapshot).to.have.property('nodes')
+    })
+
+    it('rejects an invalid chunk size', () => {
+      const w = new BrowserWindow({ show: false })
+      expect(() => {
+        w.webContents.takeHeapSnapshotStream({ chunkSize: 0 })
+      }).to.throw('chunkSize must be a positive integer')
+    })
+  })
+
+  describe('discard()', () => {
+    afterEach(closeAllWindows)
+
+    it('tears down the renderer and restores the page', async () => {
+      const w = new BrowserWindow({ show: false })
+      await w.loadFile(path.join(fixturesPath, 'pages', 'a.html'))
+      w.webContents.once('crashed', () => { throw new Error('crashed should not be emitted') })
+      const discarded = emittedOnce(w.webContents, 'discarded')
+      expect(await w.webContents.discard()).to.be.true('discarded')
+      await discarded
+      expect(w.webContents.isDiscarded()).to.be.true('isDiscarded')
+      expect(w.webContents.getDiscardSnapshot()).to.not.be.null('snapshot')
+
+      const loaded = emittedOnce(w.webContents, 'did-finish-load')
+      w.webContents.restore()
+      await loaded
+      expect(w.webContents.isDiscarded()).to.be.false('isDiscarded')
+      expect(w.webContents.getURL()).to.match(/a\.html$/)
+      expect(await w.webContents.executeJavaScript('document.wasDiscarded')).to.be.true('wasDiscarded')
+    })
+  })
+
+  describe('setMainFrameNavigationEventsOnly()', () => {
+    afterEach(closeAllWindows)
+
+    it('skips the navigation events of the sub frames', async () => {
+      const w = new BrowserWindow({ show: false })
+      await w.loadFile(path.join(fixturesPath, 'pages', 'a.html'))
+      expect(w.webContents.isMainFrameNavigationEventsOnly()).to.be.false('mainFrameOnly')
+      w.webContents.setMainFrameNavigationEventsOnly(true)
+      expect(w.webContents.isMainFrameNavigationEventsOnly()).to.be.true('mainFrameOnly')
+
+      const subFrameEvents: string[] = []
+      for (const name of ['did-start-navigation', 'did-frame-navigate', 'did-navigate-in-page']) {
+        w.webContents.on(name as any, (event: any, url: string, ...args: any[]) => {
+          // did-frame-navigate passes the response code and status first.
+          const isMainFrame = name === 'did-frame-navigate' ? args[2] : args[name === 'did-start-navigation' ? 1 : 0]
+          if (!isMainFrame) subFrameEvents.push(name)
+        })
+      }
+      const iframeURL = `file://${path.join(fixturesPath, 'pages', 'b.html')}`
+      const frameLoaded = emittedOnce(w.webContents, 'did-frame-finish-load')
+      w.webContents.executeJavaScript(`{
+        const iframe = document.createElement('iframe')
+        iframe.src = ${JSON.stringify(iframeURL)}
+        document.body.appendChild(iframe)
+      }`)
+      await frameLoaded
+      expect(subFrameEvents).to.deep.equal([])
+
+      const mainFrameNavigated = emittedOnce(w.webContents, 'did-start-navigation')
+      await w.loadFile(path.join(fixturesPath, 'pages', 'b.html'))
+      const [, , , isMainFrame] = await mainFrameNavigated
+      expect(isMainFrame).to.be.true('isMainFrame')
+    })
+  })
+
   describe('setBackgroundThrottling()', () => {
     afterEach(closeAllWindows)
     it('does not crash when allowing', () => {
@@ -1403,6 +1797,54 @@ describe('webContents module', () => {
     })
   })
 
+  describe('setBackgroundThrottlingPolicy()', () => {
+    afterEach(closeAllWindows)
+
+    it('resets the fields which are not passed', () => {
+      const w = new BrowserWindow({ show: false })
+      w.webContents.setBackgroundThrottlingPolicy({ timers: false, media: false })
+      const policy = w.webContents.getBackgroundThrottlingPolicy()
+      expect(policy.timers).to.be.false('timers')
+      expect(policy.media).to.be.false('media')
+      expect(policy.animationFrames).to.be.true('animationFrames')
+      expect(policy.occlusion).to.equal(process.platform === 'darwin')
+    })
+
+    it('is set by setBackgroundThrottling()', () => {
+      const w = new BrowserWindow({ show: false })
+      w.webContents.setBackgroundThrottling(false)
+      const policy = w.webContents.getBackgroundThrottlingPolicy()
+      expect(policy.timers).to.be.false('timers')
+      expect(policy.animationFrames).to.be.false('animationFrames')
+    })
+
+    it('can be passed in webPreferences', () => {
+      const w = new BrowserWindow({
+        show: false,
+        webPreferences: {
+          backgroundThrottling: false,
+          backgroundThrottlingPolicy: { timers: true }
+        }
+      })
+      const policy = w.webContents.getBackgroundThrottlingPolicy()
+      expect(policy.timers).to.be.true('timers')
+      expect(policy.animationFrames).to.be.false('animationFrames')
+    })
+
+    it('keeps the timers running at full speed in a hidden page', async () => {
+      const w = new BrowserWindow({ show: false })
+      await w.loadURL('about:blank')
+      w.webContents.setBackgroundThrottlingPolicy({ timers: false })
+      const elapsed = await w.webContents.executeJavaScript(`new Promise(resolve => {
+        const start = performance.now()
+        let ticks = 0
+        const tick = () => ++ticks === 10 ? resolve(performance.now() - start) : setTimeout(tick, 10)
+        setTimeout(tick, 10)
+      })`)
+      expect(elapsed).to.be.below(1000)
+    })
+  })
+
   ifdescribe(features.isPrintingEnabled())('getPrinters()', () => {
     afterEach(closeAllWindows)
     it('can get printer list', async () => {
@@ -1413,6 +1855,40 @@ describe('webContents module', () => {
     })
   })
 
+  ifdescribe(features.isPrintingEnabled())('getPrintersAsync()', () => {
+    afterEach(closeAllWindows)
+    it('resolves with the printer list', async () => {
+      const w = new BrowserWindow({ show: false, webPreferences: { sandbox: true } })
+      await w.loadURL('about:blank')
+      const printers = await w.webContents.getPrintersAsync()
+      expect(printers).to.be.an('array')
+    })
+
+    it('shares the list between calls', async () => {
+      const w1 = new BrowserWindow({ show: false, webPreferences: { sandbox: true } })
+      const w2 = new BrowserWindow({ show: false, webPreferences: { sandbox: true } })
+      await Promise.all([w1.loadURL('about:blank'), w2.loadURL('about:blank')])
+      const expected = await w1.webContents.getPrintersAsync()
+
+      // The list was just enumerated, so no call enumerates it again.
+      let enumerations = 0
+      for (const contents of [w1.webContents, w2.webContents] as any[]) {
+        const getPrinters = contents._getPrintersAsync
+        contents._getPrintersAsync = function (...args: any[]) {
+          enumerations++
+          return getPrinters.apply(this, args)
+        }
+      }
+      const [first, second] = await Promise.all([
+        w1.webContents.getPrintersAsync(),
+        w2.webContents.getPrintersAsync()
+      ])
+      expect(enumerations).to.equal(0)
+      expect(first).to.deep.equal(expected)
+      expect(second).to.deep.equal(expected)
+    })
+  })
+
   ifdescribe(features.isPrintingEnabled())('printToPDF()', () => {
     afterEach(closeAllWindows)
     it('can print to PDF', async () => {
@@ -1434,6 +1910,26 @@ describe('webContents module', () => {
         expect(data).to.be.an.instanceof(Buffer).that.is.not.empty()
       }
     })
+
+    it('writes the PDF to a path', async () => {
+      const w = new BrowserWindow({ show: false, webPreferences: { sandbox: true } })
+      await w.loadURL('data:text/html,<h1>Hello, World!</h1>')
+      const pdfPath = path.join(app.getPath('temp'), 'print-to-pdf-spec.pdf')
+      try {
+        const result = await w.webContents.printToPDF({ path: pdfPath })
+        expect(result).to.be.undefined()
+        const data = fs.readFileSync(pdfPath)
+        expect(data.toString('latin1', 0, 5)).to.equal('%PDF-')
+      } finally {
+        fs.unlinkSync(pdfPath)
+      }
+    })
+
+    it('rejects a path which is not a string', async () => {
+      const w = new BrowserWindow({ show: false, webPreferences: { sandbox: true } })
+      await w.loadURL('data:text/html,<h1>Hello, World!</h1>')
+      await expect(w.webContents.printToPDF({ path: 1 } as any)).to.eventually.be.rejectedWith('path must be a string')
+    })
   })
 
   describe('PictureInPicture video', () => {
@@ -19,13 +19,15 @@ describe('webFrame module', () => {
     w.focus()
     await w.webContents.executeJavaScript('document.querySelector("input").focus()', true)
 
+    const checkedWords: string[] = []
     const spellCheckerFeedback =
       new Promise<[string[], boolean]>(resolve => {
         ipcMain.on('spec-spell-check', (e, words, callbackDefined) => {
-          if (words.length === 5) {
-            // The API calls the provider after every completed word.
-            // The promise is resolved only after this event is received with all words.
-            resolve([words, callbackDefined])
+          // The API calls the provider after every completed word, with the
+          // words which were not checked before.
+          checkedWords.push(...words)
+          if (checkedWords.length >= 5) {
+            resolve([checkedWords, callbackDefined])
           }
         })
       })
@@ -14,6 +14,10 @@ describe('webRequest module', () => {
       res.statusCode = 301
       res.setHeader('Location', 'http://' + req.rawHeaders[1])
       res.end()
+    } else if (req.url === '/nofilter/redirect') {
+      res.statusCode = 302
+      res.setHeader('Location', '/filter/redirected')
+      res.end()
     } else {
       res.setHeader('Custom', ['Header'])
       let content = req.url
@@ -76,6 +80,20 @@ describe('webRequest module', () => {
       await expect(ajax(`${defaultURL}filter/test`)).to.eventually.be.rejectedWith('404')
     })
 
+    it('can filter URLs among many patterns', async () => {
+      const urls = []
+      for (let i = 0; i < 1000; i++) {
+        urls.push(`*://*.example${i}.com/*`, `http://host${i}.test/*`)
+      }
+      urls.push(`*://*.0.0.1/filter/*`)
+      ses.webRequest.onBeforeRequest({ urls }, (details, callback) => {
+        callback({ cancel: true })
+      })
+      const { data } = await ajax(`${defaultURL}nofilter/test`)
+      expect(data).to.equal('/nofilter/test')
+      await expect(ajax(`${defaultURL}filter/test`)).to.eventually.be.rejectedWith('404')
+    })
+
     it('receives details object', async () => {
       ses.webRequest.onBeforeRequest((details, callback) => {
         expect(details.id).to.be.a('number')
@@ -202,6 +220,19 @@ describe('webRequest module', () => {
       expect(data).to.equal('/')
     })
 
+    it('keeps the response headers readable after the listener returned', async () => {
+      let received: any
+      ses.webRequest.onHeadersReceived((details, callback) => {
+        received = details
+        callback({})
+      })
+      await ajax(defaultURL)
+      expect(Object.keys(received)).to.include('responseHeaders')
+      expect(received.responseHeaders['Custom']).to.deep.equal(['Header'])
+      // The converted headers are kept once they were read.
+      expect(received.responseHeaders).to.equal(received.responseHeaders)
+    })
+
     it('can change the response header', async () => {
       ses.webRequest.onHeadersReceived((details, callback) => {
         const responseHeaders = details.responseHeaders!
@@ -340,4 +371,130 @@ describe('webRequest module', () => {
       await expect(ajax(defaultURL)).to.eventually.be.rejectedWith('404')
     })
   })
+
+  describe('webRequest.setRules', () => {
+    afterEach(() => {
+      ses.webRequest.setRules([])
+      ses.webRequest.onBeforeRequest(null)
+    })
+
+    it('can block requests', async () => {
+      ses.webRequest.setRules([{ action: 'block', urls: [defaultURL + 'blocked'] }])
+      await expect(ajax(defaultURL + 'blocked')).to.eventually.be.rejectedWith('404')
+      const { data } = await ajax(defaultURL)
+      expect(data).to.equal('/')
+    })
+
+    it('blocks requests before the listeners are called', async () => {
+      let called = false
+      ses.webRequest.onBeforeRequest((details, callback) => {
+        called = true
+        callback({})
+      })
+      ses.webRequest.setRules([{ action: 'block', urls: [defaultURL + '*'] }])
+      await expect(ajax(defaultURL)).to.eventually.be.rejectedWith('404')
+      expect(called).to.be.false()
+    })
+
+    it('only matches the given resource types', async () => {
+      ses.webRequest.setRules([{ action: 'block', resourceTypes: ['image'] }])
+      const { data } = await ajax(defaultURL)
+      expect(data).to.equal('/')
+    })
+
+    it('can redirect requests', async () => {
+      ses.webRequest.setRules([{ action: 'redirect', urls: [defaultURL + 'nofilter/*'], redirectURL: defaultURL + 'redirected' }])
+      const { data } = await ajax(defaultURL + 'nofilter/test')
+      expect(data).to.equal('/redirected')
+    })
+
+    it('can modify the request headers', async () => {
+      ses.webRequest.setRules([{ action: 'modifyHeaders', setRequestHeaders: { Accept: '*/*;test/header' } }])
+      const { data } = await ajax(defaultURL)
+      expect(data).to.equal('/header/received')
+    })
+
+    it('can modify the response headers', async () => {
+      ses.webRequest.setRules([{ action: 'modifyHeaders', setResponseHeaders: { Custom: 'Changed' } }])
+      const { headers } = await ajax(defaultURL)
+      expect(headers).to.match(/^custom: Changed$/m)
+    })
+
+    it('throws for invalid rules', () => {
+      expect(() => {
+        ses.webRequest.setRules([{ action: 'foo' } as any])
+      }).to.throw(/Rule action must be/)
+      expect(() => {
+        ses.webRequest.setRules([{ action: 'redirect' }])
+      }).to.throw(/valid 'redirectURL'/)
+      expect(() => {
+        ses.webRequest.setRules([{ action: 'block', urls: ['foo'] }])
+      }).to.throw(/Invalid url pattern foo/)
+      expect(() => {
+        ses.webRequest.setRules([{ action: 'block', resourceTypes: ['foo'] }])
+      }).to.throw(/Invalid resource type foo/)
+    })
+  })
+
+  describe('webRequest.getStats', () => {
+    afterEach(() => {
+      ses.webRequest.onBeforeRequest(null)
+    })
+
+    it('counts the requests that bypass the listeners', async () => {
+      ses.webRequest.onBeforeRequest({ urls: [defaultURL + 'filter/*'] }, (details, callback) => {
+        callback({})
+      })
+      const before = ses.webRequest.getStats()
+      await ajax(`${defaultURL}nofilter/test`)
+      await ajax(`${defaultURL}filter/test`)
+      const after = ses.webRequest.getStats()
+      expect(after.bypassedRequests - before.bypassedRequests).to.equal(1)
+      expect(after.proxiedRequests - before.proxiedRequests).to.equal(1)
+    })
+
+    it('calls the listeners when a bypassed request is redirected to a filtered URL', async () => {
+      const urls: string[] = []
+      ses.webRequest.onBeforeRequest({ urls: [defaultURL + 'filter/*'] }, (details, callback) => {
+        urls.push(details.url)
+        callback({})
+      })
+      const before = ses.webRequest.getStats()
+      const { data } = await ajax(`${defaultURL}nofilter/redirect`)
+      expect(data).to.equal('/filter/redirected')
+      expect(urls).to.deep.equal([`${defaultURL}filter/redirected`])
+      const after = ses.webRequest.getStats()
+      expect(after.bypassedRequests - before.bypassedRequests).to.equal(1)
+    })
+  })
+
+  describe('webRequest metrics', () => {
+    afterEach(() => {
+      ses.webRequest.onCompleted(null)
+      ses.webRequest.setMetricsEnabled(false)
+      ses.webRequest.clearMetrics()
+    })
+
+    it('reports the metrics of a request in onCompleted', async () => {
+      let metrics: any
+      ses.webRequest.onCompleted((details: any) => { metrics = details.metrics })
+      await ajax(defaultURL)
+      expect(metrics.timing.total).to.be.a('number')
+      expect(metrics.timing.ttfb).to.be.a('number')
+      expect(metrics.decodedBodyLength).to.be.greaterThan(0)
+      expect(metrics.socketReused).to.be.a('boolean')
+    })
+
+    it('aggregates the requests of the session by resource type', async () => {
+      ses.webRequest.setMetricsEnabled(true)
+      await ajax(defaultURL)
+      await ajax(defaultURL)
+      const { bucketBounds, classes } = ses.webRequest.getMetrics()
+      expect(classes.xhr.requests).to.equal(2)
+      expect(classes.xhr.total).to.have.lengthOf(bucketBounds.length + 1)
+      expect(classes.xhr.total.reduce((a: number, b: number) => a + b)).to.equal(2)
+      ses.webRequest.clearMetrics()
+      expect(ses.webRequest.getMetrics().classes).to.deep.equal({})
+    })
+  })
 })
@@ -0,0 +1,73 @@
+import { expect } from 'chai'
+import * as crypto from 'crypto'
+import * as fs from 'fs'
+import * as path from 'path'
+import * as zlib from 'zlib'
+import { workerPool } from 'electron'
+
+const fixtures = path.resolve(__dirname, '..', 'spec', 'fixtures')
+
+describe('workerPool module', () => {
+  const data = Buffer.from('electron '.repeat(1000))
+
+  describe('workerPool.gzip()', () => {
+    it('compresses a buffer', async () => {
+      const compressed = await workerPool.gzip(data)
+      expect(compressed.length).to.be.lessThan(data.length)
+      expect(zlib.gunzipSync(compressed).equals(data)).to.be.true()
+    })
+
+    it('accepts a priority', async () => {
+      const compressed = await workerPool.gzip(data, { priority: 'background' })
+      expect(zlib.gunzipSync(compressed).equals(data)).to.be.true()
+    })
+
+    it('rejects an invalid priority', async () => {
+      await expect(workerPool.gzip(data, { priority: 'urgent' as any })).to.eventually.be.rejectedWith(/priority must be/)
+    })
+
+    it('rejects when not given a buffer', async () => {
+      await expect(workerPool.gzip('electron' as any)).to.eventually.be.rejectedWith(/buffer must be a node Buffer/)
+    })
+  })
+
+  describe('workerPool.gunzip()', () => {
+    it('decompresses a buffer', async () => {
+      const decompressed = await workerPool.gunzip(zlib.gzipSync(data))
+      expect(decompressed.equals(data)).to.be.true()
+    })
+
+    it('rejects data that is not compressed', async () => {
+      await expect(workerPool.gunzip(data)).to.eventually.be.rejectedWith(/Failed to decompress/)
+    })
+  })
+
+  describe('workerPool.hash()', () => {
+    for (const algorithm of ['md5', 'sha1', 'sha256']) {
+      it(`computes the ${algorithm} digest of a buffer`, async () => {
+        const digest = await workerPool.hash(algorithm, data)
+        expect(digest).to.equal(crypto.createHash(algorithm).update(data).digest('hex'))
+      })
+    }
+
+    it('rejects an unknown algorithm', async () => {
+      await expect(workerPool.hash('crc32', data)).to.eventually.be.rejectedWith(/algorithm must be/)
+    })
+  })
+
+  describe('workerPool.decodeImage()', () => {
+    it('decodes a PNG image', async () => {
+      const image = await workerPool.decodeImage(fs.readFileSync(path.join(fixtures, 'assets', '3x3.png')))
+      expect(image.getSize()).to.deep.equal({ width: 3, height: 3 })
+    })
+
+    it('decodes a JPEG image', async () => {
+      const image = await workerPool.decodeImage(fs.readFileSync(path.join(fixtures, 'assets', '2x2.jpg')))
+      expect(image.getSize()).to.deep.equal({ width: 2, height: 2 })
+    })
+
+    it('rejects data that is not an image', async () => {
+      await expect(workerPool.decodeImage(data)).to.eventually.be.rejectedWith(/Failed to decode image/)
+    })
+  })
+})
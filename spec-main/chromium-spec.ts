@@ -694,6 +694,28 @@ describe('chromium features', () => {
       expect(labels.some((l: any) => l)).to.be.false()
     })
 
+    it('reuses cached answers of the permission check handler', async () => {
+      let checks = 0
+      session.defaultSession.setPermissionCheckHandler(() => {
+        checks++
+        return { granted: false, cache: true }
+      })
+      const w = new BrowserWindow({ show: false })
+      await w.loadFile(path.join(fixturesPath, 'pages', 'blank.html'))
+      const enumerate = () => w.webContents.executeJavaScript(`navigator.mediaDevices.enumerateDevices().then(ds => ds.map(d => d.label))`)
+      const labels = await enumerate()
+      expect(labels.some((l: any) => l)).to.be.false()
+      const firstChecks = checks
+      expect(firstChecks).to.be.greaterThan(0)
+
+      await enumerate()
+      expect(checks).to.equal(firstChecks)
+
+      session.defaultSession.clearPermissionCheckCache()
+      await enumerate()
+      expect(checks).to.equal(firstChecks * 2)
+    })
+
     it('can return new device id when cookie storage is cleared', async () => {
       const ses = session.fromPartition('persist:media-device-id')
       const w = new BrowserWindow({
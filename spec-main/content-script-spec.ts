@@ -67,6 +67,15 @@ describe('chrome extension content scripts', () => {
           expect(result).to.equal('red')
         })
 
+        it('should run the cached content script on the next navigations', async () => {
+          addExtension('content-script-document-idle')
+          for (let i = 0; i < 3; i++) {
+            await w.loadURL('about:blank')
+            const result = await w.webContents.executeJavaScript('document.body.style.backgroundColor')
+            expect(result).to.equal('red')
+          }
+        })
+
         it('should run content script at document_end', () => {
           addExtension('content-script-document-end')
           w.webContents.once('did-finish-load', async () => {
@@ -138,6 +147,27 @@ describe('chrome extension content scripts', () => {
             })
           )
         })
+
+        it('applies matching rules in subframes without a preload script', async () => {
+          const bare = new BrowserWindow({
+            show: false,
+            webPreferences: { nodeIntegrationInSubFrames: true }
+          })
+          try {
+            const detailsPromise = emittedNTimes(bare.webContents, 'did-frame-finish-load', 2)
+            bare.loadFile(path.join(contentScript, 'frame-with-frame.html'))
+            await detailsPromise
+            // There is no preload to run code in the sub frame, the main frame
+            // reads it instead.
+            const color = await bare.webContents.executeJavaScript(`{
+              const frame = document.querySelector('iframe').contentWindow
+              frame.getComputedStyle(frame.document.getElementById('all_frames_enabled')).backgroundColor
+            }`)
+            expect(color).to.equal(COLOR_RED)
+          } finally {
+            await closeWindow(bare)
+          }
+        })
       })
     })
   }
@@ -65,6 +65,28 @@ ifdescribe(process.electronBinding('features').isExtensionsEnabled())('chrome ex
     expect((customSession as any).getAllExtensions()).to.deep.equal([])
   })
 
+  it('loads several extensions at once', async () => {
+    const customSession = session.fromPartition(`persist:${require('uuid').v4()}`)
+    const extensions = await (customSession as any).loadExtensions([
+      path.join(fixtures, 'extensions', 'red-bg'),
+      path.join(fixtures, 'extensions', 'does-not-exist'),
+      path.join(fixtures, 'extensions', 'chrome-storage')
+    ])
+    expect(extensions).to.have.lengthOf(3)
+    expect(extensions[1]).to.be.null()
+    expect((customSession as any).getAllExtensions()).to.have.deep.members([extensions[0], extensions[2]])
+  })
+
+  it('reports no messaging metrics for an extension which sent nothing', async () => {
+    const customSession = session.fromPartition(`persist:${require('uuid').v4()}`)
+    const e = await (customSession as any).loadExtension(path.join(fixtures, 'extensions', 'red-bg'))
+    expect((customSession as any).getExtensionMessageMetrics(e.id)).to.deep.equal({
+      messageCount: 0,
+      byteCount: 0,
+      messagesPerSecond: 0
+    })
+  })
+
   it('gets an extension by id', async () => {
     const customSession = session.fromPartition(`persist:${require('uuid').v4()}`)
     const e = await (customSession as any).loadExtension(path.join(fixtures, 'extensions', 'red-bg'))
@@ -152,6 +174,23 @@ ifdescribe(process.electronBinding('features').isExtensionsEnabled())('chrome ex
       expect(response.message).to.equal('Hello World!')
       expect(response.tabId).to.equal(w.webContents.id)
     })
+
+    it('counts the messages of both runtime and tab channels', async () => {
+      const customSession = session.fromPartition(`persist:${require('uuid').v4()}`)
+      const e = await (customSession as any).loadExtension(path.join(fixtures, 'extensions', 'chrome-api'))
+      const w = new BrowserWindow({ show: false, webPreferences: { session: customSession, nodeIntegration: true } })
+      await w.loadURL(url)
+
+      const message = { method: 'sendMessage', args: ['Hello World!'] }
+      w.webContents.executeJavaScript(`window.postMessage('${JSON.stringify(message)}', '*')`)
+      await emittedOnce(w.webContents, 'console-message')
+
+      // The content script messages the background page, which messages the
+      // tab, and both messages are replied to.
+      const metrics = (customSession as any).getExtensionMessageMetrics(e.id)
+      expect(metrics.messageCount).to.be.at.least(4)
+      expect(metrics.byteCount).to.be.greaterThan(0)
+    })
   })
 
   describe('background pages', () => {
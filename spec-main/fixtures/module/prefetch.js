@@ -0,0 +1,12 @@
+'use strict'
+
+exports.config = {
+  name: 'app',
+  nested: { level: 2, deeper: { level: 3 } }
+}
+
+exports.frozen = Object.freeze({ answer: 42 })
+
+exports.setName = (name) => {
+  exports.config.name = name
+}
@@ -0,0 +1,226 @@
+// Registers hooks with the C interface of electron_addon_api.h and records
+// the calls they get, for the specs to check that the hooks fire.
+
+#include <js_native_api.h>
+#include <node_api.h>
+
+#include <map>
+#include <memory>
+#include <string>
+#include <utility>
+
+#if defined(_WIN32)
+#include <windows.h>
+#else
+#include <dlfcn.h>
+#endif
+
+#include "electron_addon_api.h"
+
+namespace {
+
+struct Hook {
+  bool is_paint_hook = false;
+  uint32_t count = 0;
+  int32_t last_target_id = 0;
+  std::string last_event_name;
+  int32_t last_width = 0;
+  int32_t last_height = 0;
+};
+
+std::map<uint32_t, std::unique_ptr<Hook>> g_hooks;
+
+const electron_addon_api* GetAddonApi() {
+#if defined(_WIN32)
+  auto get_addon_api = reinterpret_cast<electron_get_addon_api_func>(
+      GetProcAddress(GetModuleHandle(NULL), "electron_get_addon_api"));
+#else
+  auto get_addon_api = reinterpret_cast<electron_get_addon_api_func>(
+      dlsym(RTLD_DEFAULT, "electron_get_addon_api"));
+#endif
+  if (!get_addon_api)
+    return NULL;
+  return get_addon_api(ELECTRON_ADDON_API_VERSION);
+}
+
+void OnFrame(const electron_frame* frame, void* user_data) {
+  Hook* hook = static_cast<Hook*>(user_data);
+  hook->count++;
+  hook->last_width = frame->width;
+  hook->last_height = frame->height;
+}
+
+void OnEvent(const char* event_name, int32_t target_id, void* user_data) {
+  Hook* hook = static_cast<Hook*>(user_data);
+  hook->count++;
+  hook->last_target_id = target_id;
+  hook->last_event_name = event_name;
+}
+
+bool GetArgs(napi_env env,
+             napi_callback_info info,
+             size_t expected,
+             napi_value* args) {
+  size_t argc = expected;
+  if (napi_get_cb_info(env, info, &argc, args, NULL, NULL) != napi_ok)
+    return false;
+  if (argc != expected) {
+    napi_throw_error(env, NULL, "Wrong number of arguments");
+    return false;
+  }
+  return true;
+}
+
+bool GetString(napi_env env, napi_value value, std::string* result) {
+  size_t length;
+  if (napi_get_value_string_utf8(env, value, NULL, 0, &length) != napi_ok)
+    return false;
+  result->resize(length + 1);
+  if (napi_get_value_string_utf8(env, value, &(*result)[0], length + 1,
+                                 &length) != napi_ok)
+    return false;
+  result->resize(length);
+  return true;
+}
+
+napi_value HookIdToValue(napi_env env,
+                         uint32_t hook_id,
+                         std::unique_ptr<Hook> hook) {
+  if (hook_id)
+    g_hooks[hook_id] = std::move(hook);
+  napi_value result;
+  napi_create_uint32(env, hook_id, &result);
+  return result;
+}
+
+// addPaintHook(webContentsId)
+napi_value AddPaintHook(napi_env env, napi_callback_info info) {
+  napi_value args[1];
+  if (!GetArgs(env, info, 1, args))
+    return NULL;
+  int32_t web_contents_id;
+  if (napi_get_value_int32(env, args[0], &web_contents_id) != napi_ok)
+    return NULL;
+
+  const electron_addon_api* api = GetAddonApi();
+  if (!api) {
+    napi_throw_error(env, NULL, "The addon API is not available");
+    return NULL;
+  }
+  auto hook = std::make_unique<Hook>();
+  hook->is_paint_hook = true;
+  uint32_t hook_id = api->add_paint_hook(web_contents_id, OnFrame, hook.get());
+  return HookIdToValue(env, hook_id, std::move(hook));
+}
+
+// addEventHook('webContents' | 'window', targetId, eventName)
+napi_value AddEventHook(napi_env env, napi_callback_info info) {
+  napi_value args[3];
+  if (!GetArgs(env, info, 3, args))
+    return NULL;
+  std::string target_name;
+  int32_t target_id;
+  std::string event_name;
+  if (!GetString(env, args[0], &target_name) ||
+      napi_get_value_int32(env, args[1], &target_id) != napi_ok ||
+      !GetString(env, args[2], &event_name))
+    return NULL;
+
+  electron_event_target target;
+  if (target_name == "webContents") {
+    target = ELECTRON_EVENT_TARGET_WEB_CONTENTS;
+  } else if (target_name == "window") {
+    target = ELECTRON_EVENT_TARGET_WINDOW;
+  } else {
+    napi_throw_error(env, NULL, "Unknown event target");
+    return NULL;
+  }
+
+  const electron_addon_api* api = GetAddonApi();
+  if (!api) {
+    napi_throw_error(env, NULL, "The addon API is not available");
+    return NULL;
+  }
+  auto hook = std::make_unique<Hook>();
+  uint32_t hook_id = api->add_event_hook(target, target_id, event_name.c_str(),
+                                         OnEvent, hook.get());
+  return HookIdToValue(env, hook_id, std::move(hook));
+}
+
+// removeHook(hookId)
+napi_value RemoveHook(napi_env env, napi_callback_info info) {
+  napi_value args[1];
+  if (!GetArgs(env, info, 1, args))
+    return NULL;
+  uint32_t hook_id;
+  if (napi_get_value_uint32(env, args[0], &hook_id) != napi_ok)
+    return NULL;
+
+  auto it = g_hooks.find(hook_id);
+  if (it == g_hooks.end())
+    return NULL;
+  const electron_addon_api* api = GetAddonApi();
+  if (it->second->is_paint_hook)
+    api->remove_paint_hook(hook_id);
+  else
+    api->remove_event_hook(hook_id);
+  // The calls are kept, so that the specs can check none were made after the
+  // hook was removed.
+  return NULL;
+}
+
+// getHookCalls(hookId) returns { count, lastTargetId, lastEventName,
+// lastWidth, lastHeight }.
+napi_value GetHookCalls(napi_env env, napi_callback_info info) {
+  napi_value args[1];
+  if (!GetArgs(env, info, 1, args))
+    return NULL;
+  uint32_t hook_id;
+  if (napi_get_value_uint32(env, args[0], &hook_id) != napi_ok)
+    return NULL;
+
+  auto it = g_hooks.find(hook_id);
+  if (it == g_hooks.end()) {
+    napi_throw_error(env, NULL, "Unknown hook");
+    return NULL;
+  }
+  const Hook& hook = *it->second;
+
+  napi_value result, count, last_target_id, last_event_name, last_width,
+      last_height;
+  napi_create_object(env, &result);
+  napi_create_uint32(env, hook.count, &count);
+  napi_create_int32(env, hook.last_target_id, &last_target_id);
+  napi_create_string_utf8(env, hook.last_event_name.c_str(),
+                          hook.last_event_name.size(), &last_event_name);
+  napi_create_int32(env, hook.last_width, &last_width);
+  napi_create_int32(env, hook.last_height, &last_height);
+  napi_set_named_property(env, result, "count", count);
+  napi_set_named_property(env, result, "lastTargetId", last_target_id);
+  napi_set_named_property(env, result, "lastEventName", last_event_name);
+  napi_set_named_property(env, result, "lastWidth", last_width);
+  napi_set_named_property(env, result, "lastHeight", last_height);
+  return result;
+}
+
+napi_value Init(napi_env env, napi_value exports) {
+  napi_property_descriptor descriptors[] = {
+      {"addPaintHook", NULL, AddPaintHook, NULL, NULL, NULL, napi_default,
+       NULL},
+      {"addEventHook", NULL, AddEventHook, NULL, NULL, NULL, napi_default,
+       NULL},
+      {"removeHook", NULL, RemoveHook, NULL, NULL, NULL, napi_default, NULL},
+      {"getHookCalls", NULL, GetHookCalls, NULL, NULL, NULL, napi_default,
+       NULL}};
+
+  if (napi_define_properties(env, exports,
+                             sizeof(descriptors) / sizeof(*descriptors),
+                             descriptors) != napi_ok)
+    return NULL;
+
+  return exports;
+}
+
+}  // namespace
+
+NAPI_MODULE(NODE_GYP_MODULE_NAME, Init)
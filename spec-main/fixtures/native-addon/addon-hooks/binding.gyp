@@ -0,0 +1,15 @@
+{
+  "targets": [
+    {
+      "target_name": "addon_hooks",
+      "sources": [
+        "binding.cc"
+      ],
+      "include_dirs": [
+        # The fixture is built both in place and as a copy in node_modules.
+        "../../../../shell/browser",
+        "../../../shell/browser"
+      ]
+    }
+  ]
+}
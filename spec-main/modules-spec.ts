@@ -2,7 +2,8 @@ import { expect } from 'chai'
 import * as path from 'path'
 import * as fs from 'fs'
 import { BrowserWindow } from 'electron'
-import { ifdescribe, ifit } from './spec-helpers'
+import { ifdescribe, ifit, delay } from './spec-helpers'
+import { emittedOnce } from './events-helpers'
 import { closeAllWindows } from './window-helpers'
 import * as childProcess from 'child_process'
 
@@ -45,6 +46,70 @@ describe('modules support', () => {
       })
     })
 
+    ifdescribe(nativeModulesEnabled)('addon-hooks', () => {
+      afterEach(closeAllWindows)
+
+      it('calls paint hooks with the frames of an offscreen window', async () => {
+        const addonHooks = require('addon-hooks')
+        const w = new BrowserWindow({
+          width: 100,
+          height: 100,
+          show: false,
+          webPreferences: { offscreen: true, backgroundThrottling: false }
+        })
+        const hookId = addonHooks.addPaintHook(w.webContents.id)
+        expect(hookId).to.not.equal(0)
+        w.loadURL('data:text/html,<body style="background: red"></body>')
+        await emittedOnce(w.webContents, 'paint')
+        // The hooks are called after the listeners of the frame.
+        await delay(0)
+        const calls = addonHooks.getHookCalls(hookId)
+        expect(calls.count).to.be.greaterThan(0)
+        expect(calls.lastWidth).to.be.greaterThan(0)
+        expect(calls.lastHeight).to.be.greaterThan(0)
+      })
+
+      it('calls event hooks of a web contents', async () => {
+        const addonHooks = require('addon-hooks')
+        const w = new BrowserWindow({ show: false })
+        const hookId = addonHooks.addEventHook('webContents', w.webContents.id, 'did-finish-load')
+        expect(hookId).to.not.equal(0)
+        await w.loadURL('about:blank')
+        const calls = addonHooks.getHookCalls(hookId)
+        expect(calls.count).to.equal(1)
+        expect(calls.lastTargetId).to.equal(w.webContents.id)
+        expect(calls.lastEventName).to.equal('did-finish-load')
+      })
+
+      it('calls event hooks of a window', async () => {
+        const addonHooks = require('addon-hooks')
+        const w = new BrowserWindow({ show: false })
+        const hookId = addonHooks.addEventHook('window', w.id, 'resize')
+        expect(hookId).to.not.equal(0)
+        await emittedOnce(w, 'resize', () => w.setSize(300, 400))
+        const calls = addonHooks.getHookCalls(hookId)
+        expect(calls.count).to.be.greaterThan(0)
+        expect(calls.lastTargetId).to.equal(w.id)
+        expect(calls.lastEventName).to.equal('resize')
+      })
+
+      it('stops calling removed hooks', async () => {
+        const addonHooks = require('addon-hooks')
+        const w = new BrowserWindow({ show: false })
+        const hookId = addonHooks.addEventHook('webContents', w.webContents.id, 'did-finish-load')
+        addonHooks.removeHook(hookId)
+        await w.loadURL('about:blank')
+        expect(addonHooks.getHookCalls(hookId).count).to.equal(0)
+      })
+
+      it('does not add hooks for unknown targets or events', () => {
+        const addonHooks = require('addon-hooks')
+        const w = new BrowserWindow({ show: false })
+        expect(addonHooks.addEventHook('window', w.id, 'did-finish-load')).to.equal(0)
+        expect(addonHooks.addEventHook('webContents', -1, 'dom-ready')).to.equal(0)
+      })
+    })
+
     describe('q', () => {
       describe('Q.when', () => {
         it('emits the fullfil callback', (done) => {
@@ -180,6 +180,41 @@ describe('node feature', () => {
       child.stdout.on('data', outDataHandler)
     })
 
+    it('supports starting the v8 inspector with NODE_OPTIONS', (done) => {
+      child = childProcess.spawn(process.execPath, [path.join(fixtures, 'module', 'run-as-node.js')], {
+        env: {
+          ELECTRON_RUN_AS_NODE: 'true',
+          NODE_OPTIONS: '--inspect=0'
+        }
+      })
+      exitPromise = emittedOnce(child, 'exit')
+
+      let output = ''
+      function errorDataListener (data: Buffer) {
+        output += data
+        if (/^Debugger listening on ws:/m.test(output)) {
+          child.stderr.removeListener('data', errorDataListener)
+          done()
+        }
+      }
+      child.stderr.on('data', errorDataListener)
+    })
+
+    it('supports inspector sessions without inspector options', () => {
+      const script = `
+        const session = new (require('inspector').Session)()
+        session.connect()
+        session.post('Runtime.evaluate', { expression: '1 + 1' }, (error, { result }) => {
+          console.log(result.value)
+          session.disconnect()
+        })`
+      const result = childProcess.spawnSync(process.execPath, ['-e', script], {
+        env: { ELECTRON_RUN_AS_NODE: 'true' }
+      })
+      expect(result.status).to.equal(0)
+      expect(result.stdout.toString().trim()).to.equal('2')
+    })
+
     it('does not start the v8 inspector when --inspect is after a -- argument', (done) => {
       child = childProcess.spawn(process.execPath, [path.join(fixtures, 'module', 'noop.js'), '--', '--inspect'])
       exitPromise = emittedOnce(child, 'exit')
@@ -2,6 +2,8 @@
 
 const { expect } = require('chai')
 const { nativeImage } = require('electron')
+const fs = require('fs')
+const os = require('os')
 const path = require('path')
 
 describe('nativeImage module', () => {
@@ -328,6 +330,153 @@ describe('nativeImage module', () => {
     })
   })
 
+  describe('toPNGAsync()', () => {
+    it('resolves with the same data as toPNG()', async () => {
+      const imageData = getImage({ filename: 'logo.png' })
+      const image = nativeImage.createFromPath(imageData.path)
+
+      const buffer = await image.toPNGAsync({ scaleFactor: 2.0 })
+      expect(buffer.equals(image.toPNG({ scaleFactor: 2.0 }))).to.be.true()
+    })
+
+    it('resolves with an empty buffer for an empty image', async () => {
+      const buffer = await nativeImage.createEmpty().toPNGAsync()
+      expect(buffer.length).to.equal(0)
+    })
+  })
+
+  describe('toJPEGAsync()', () => {
+    it('resolves with the same data as toJPEG()', async () => {
+      const imageData = getImage({ filename: 'logo.png' })
+      const image = nativeImage.createFromPath(imageData.path)
+
+      const buffer = await image.toJPEGAsync(80)
+      expect(buffer.equals(image.toJPEG(80))).to.be.true()
+    })
+  })
+
+  describe('toWebP()', () => {
+    it('returns data which decodes to the same size', () => {
+      const imageData = getImage({ filename: 'logo.png' })
+      const image = nativeImage.createFromPath(imageData.path)
+
+      const buffer = image.toWebP({ quality: 50 })
+      expect(buffer.toString('latin1', 8, 12)).to.equal('WEBP')
+      const decoded = nativeImage.createFromBuffer(buffer)
+      expect(decoded.getSize()).to.deep.equal({ width: imageData.width, height: imageData.height })
+    })
+
+    it('encodes without loss', () => {
+      const imageData = getImage({ filename: 'logo.png' })
+      const image = nativeImage.createFromPath(imageData.path)
+
+      const lossless = image.toWebP({ lossless: true })
+      expect(lossless.equals(image.toWebP())).to.be.false()
+      const decoded = nativeImage.createFromBuffer(lossless)
+      expect(decoded.getSize()).to.deep.equal({ width: imageData.width, height: imageData.height })
+    })
+
+    it('decodes WebP data URLs', () => {
+      const imageData = getImage({ filename: 'logo.png' })
+      const buffer = nativeImage.createFromPath(imageData.path).toWebP()
+      const image = nativeImage.createFromDataURL(`data:image/webp;base64,${buffer.toString('base64')}`)
+      expect(image.getSize()).to.deep.equal({ width: imageData.width, height: imageData.height })
+    })
+
+    it('throws on an invalid quality', () => {
+      expect(() => nativeImage.createEmpty().toWebP({ quality: 101 })).to.throw(/quality must be between 0 and 100/)
+    })
+  })
+
+  describe('toWebPAsync()', () => {
+    it('resolves with the same data as toWebP()', async () => {
+      const imageData = getImage({ filename: 'logo.png' })
+      const image = nativeImage.createFromPath(imageData.path)
+
+      const buffer = await image.toWebPAsync({ quality: 50 })
+      expect(buffer.equals(image.toWebP({ quality: 50 }))).to.be.true()
+    })
+  })
+
+  describe('setCacheSize(size)', () => {
+    afterEach(() => {
+      nativeImage.setCacheSize(0)
+    })
+
+    it('decodes the image again once its file is modified', () => {
+      nativeImage.setCacheSize(16 * 1024 * 1024)
+      const dir = fs.mkdtempSync(path.join(os.tmpdir(), 'electron-native-image-'))
+      const imagePath = path.join(dir, 'image.png')
+      try {
+        fs.copyFileSync(getImage({ filename: 'logo.png' }).path, imagePath)
+        expect(nativeImage.createFromPath(imagePath).getSize()).to.deep.equal({ width: 538, height: 190 })
+        expect(nativeImage.createFromPath(imagePath).getSize()).to.deep.equal({ width: 538, height: 190 })
+
+        fs.copyFileSync(getImage({ filename: '1x1.png' }).path, imagePath)
+        const later = new Date(Date.now() + 10000)
+        fs.utimesSync(imagePath, later, later)
+        expect(nativeImage.createFromPath(imagePath).getSize()).to.deep.equal({ width: 1, height: 1 })
+      } finally {
+        fs.unlinkSync(imagePath)
+        fs.rmdirSync(dir)
+      }
+    })
+
+    it('returns the same pixels from the cache', () => {
+      nativeImage.setCacheSize(16 * 1024 * 1024)
+      const imagePath = getImage({ filename: 'logo.png' }).path
+      const imageA = nativeImage.createFromPath(imagePath)
+      const imageB = nativeImage.createFromPath(imagePath)
+      expect(imageA.toBitmap().equals(imageB.toBitmap())).to.be.true()
+      nativeImage.clearCache()
+    })
+
+    it('allows adding representations to cached images', () => {
+      nativeImage.setCacheSize(16 * 1024 * 1024)
+      const imagePath = getImage({ filename: 'logo.png' }).path
+      const image = nativeImage.createFromPath(imagePath)
+      image.addRepresentation({ scaleFactor: 2.0, buffer: nativeImage.createFromPath(imagePath).resize({ width: 1076 }).toPNG() })
+      expect(image.toPNG({ scaleFactor: 2.0 })).to.have.lengthOf.above(0)
+      expect(nativeImage.createFromPath(imagePath).getSize()).to.deep.equal({ width: 538, height: 190 })
+    })
+  })
+
+  describe('createFromPathAsync(path)', () => {
+    it('resolves with an empty image for invalid paths', async () => {
+      const image = await nativeImage.createFromPathAsync('does-not-exist.png')
+      expect(image.isEmpty()).to.be.true()
+    })
+
+    it('resolves with the image at the path', async () => {
+      const imageData = getImage({ filename: 'logo.png' })
+      const image = await nativeImage.createFromPathAsync(imageData.path)
+      expect(image.getSize()).to.deep.equal({ width: 538, height: 190 })
+      expect(image.toBitmap().equals(nativeImage.createFromPath(imageData.path).toBitmap())).to.be.true()
+    })
+  })
+
+  describe('createFromBufferAsync(buffer, options)', () => {
+    it('resolves with an image created from the given buffer', async () => {
+      const imageData = getImage({ filename: 'logo.png' })
+      const buffer = nativeImage.createFromPath(imageData.path).toPNG()
+      const image = await nativeImage.createFromBufferAsync(buffer, { scaleFactor: 2.0 })
+      expect(image.getSize()).to.deep.equal(
+        { width: imageData.width / 2, height: imageData.height / 2 })
+    })
+
+    it('rejects on invalid arguments', async () => {
+      await expect(nativeImage.createFromBufferAsync({})).to.be.eventually.rejectedWith(Error, 'buffer must be a node Buffer')
+    })
+  })
+
+  describe('createFromDataURLAsync(dataURL)', () => {
+    it('resolves with an image created from the given string', async () => {
+      const imageData = getImage({ hasDataUrl: true })
+      const image = await nativeImage.createFromDataURLAsync(imageData.dataUrl)
+      expect(image.getSize()).to.deep.equal({ width: imageData.width, height: imageData.height })
+    })
+  })
+
   describe('createFromPath(path)', () => {
     it('returns an empty image for invalid paths', () => {
       expect(nativeImage.createFromPath('').isEmpty()).to.be.true()
@@ -463,6 +612,38 @@ describe('nativeImage module', () => {
       expect(good.toPNG()).to.have.lengthOf.at.most(better.toPNG().length)
       expect(better.toPNG()).to.have.lengthOf.below(best.toPNG().length)
     })
+
+    it('supports a fast quality', () => {
+      const image = nativeImage.createFromPath(path.join(__dirname, 'fixtures', 'assets', 'logo.png'))
+      const fast = image.resize({ width: 100, height: 100, quality: 'fast' })
+      expect(fast.getSize()).to.deep.equal({ width: 100, height: 100 })
+      expect(fast.isEmpty()).to.be.false()
+    })
+  })
+
+  describe('createMipmaps([sizes])', () => {
+    it('serves resize() from the mipmaps', () => {
+      const image = nativeImage.createFromPath(path.join(__dirname, 'fixtures', 'assets', 'logo.png'))
+      const expected = image.resize({ width: 32, height: 32 }).toBitmap()
+      image.createMipmaps([{ width: 32, height: 32 }, { width: 16, height: 16 }])
+
+      const resized = image.resize({ width: 32, height: 32, quality: 'fast' })
+      expect(resized.getSize()).to.deep.equal({ width: 32, height: 32 })
+      expect(resized.toBitmap().equals(expected)).to.be.true()
+    })
+
+    it('creates halved mipmaps by default', () => {
+      const image = nativeImage.createFromPath(path.join(__dirname, 'fixtures', 'assets', 'logo.png'))
+      const expected = image.resize({ width: 269, height: 95 }).toBitmap()
+      image.createMipmaps()
+      expect(image.resize({ width: 269, height: 95, quality: 'good' }).toBitmap().equals(expected)).to.be.true()
+    })
+
+    it('does nothing on an empty image', () => {
+      const image = nativeImage.createEmpty()
+      image.createMipmaps()
+      expect(image.resize({ width: 16 }).isEmpty()).to.be.true()
+    })
   })
 
   describe('crop(bounds)', () => {
@@ -38,6 +38,43 @@ describe('process module', () => {
     })
   })
 
+  describe('process.writeStatistics()', () => {
+    it('writes the statistics into the array', () => {
+      const stats = new Float64Array(16)
+      expect(process.writeStatistics(stats)).to.equal(16)
+      const heapStatistics = process.getHeapStatistics()
+      expect(stats[0]).to.be.a('number')
+      expect(stats[7]).to.equal(heapStatistics.heapSizeLimit)
+    })
+
+    it('throws when the array is too short', () => {
+      expect(() => process.writeStatistics(new Float64Array(4))).to.throw(/Float64Array/)
+      expect(() => process.writeStatistics([])).to.throw(/Float64Array/)
+    })
+  })
+
+  describe('process.getUvLoopMetrics()', () => {
+    it('returns a uv loop metrics object', () => {
+      const metrics = process.getUvLoopMetrics()
+      expect(metrics.wakeups).to.be.a('number').and.be.at.least(1)
+      expect(metrics.wakeupsPerSecond).to.be.a('number')
+      expect(metrics.iterations).to.be.at.least(metrics.wakeups)
+      expect(metrics.budgetExhausted).to.be.at.most(metrics.wakeups)
+      expect(metrics.uvTime).to.be.a('number').and.be.at.least(0)
+    })
+  })
+
+  describe('process.getStartupTimeline()', () => {
+    it('returns the phases of starting the renderer process', () => {
+      const names = process.getStartupTimeline().map(phase => phase.name)
+      expect(names).to.include.members([
+        'RendererClientBase::RenderThreadStarted',
+        'DidCreateScriptContext',
+        'preload'
+      ])
+    })
+  })
+
   describe('process.getBlinkMemoryInfo()', () => {
     it('returns blink memory information object', () => {
       const heapStats = process.getBlinkMemoryInfo()
@@ -1206,6 +1206,127 @@ describe('asar package', function () {
       })
     })
 
+    describe('pre-indexed header', function () {
+      const indexedDir = path.join(asarDir, 'indexed.asar')
+
+      it('reads normal and linked files', function () {
+        expect(fs.readFileSync(path.join(indexedDir, 'file1')).toString().trim()).to.equal('file1')
+        expect(fs.readFileSync(path.join(indexedDir, 'dir3', 'file2')).toString().trim()).to.equal('file2')
+        expect(fs.readFileSync(path.join(indexedDir, 'link1')).toString().trim()).to.equal('file1')
+        expect(fs.readFileSync(path.join(indexedDir, 'link2', 'link2', 'file1')).toString().trim()).to.equal('file1')
+      })
+
+      it('returns the same stats as the JSON header', function () {
+        for (const name of ['file1', 'dir1', 'link1', path.join('dir1', 'link2')]) {
+          const indexed = fs.lstatSync(path.join(indexedDir, name))
+          const json = fs.lstatSync(path.join(asarDir, 'a.asar', name))
+          expect(indexed.size).to.equal(json.size)
+          expect(indexed.isFile()).to.equal(json.isFile())
+          expect(indexed.isDirectory()).to.equal(json.isDirectory())
+          expect(indexed.isSymbolicLink()).to.equal(json.isSymbolicLink())
+        }
+      })
+
+      it('reads dirs in the same order as the JSON header', function () {
+        expect(fs.readdirSync(indexedDir)).to.deep.equal(fs.readdirSync(path.join(asarDir, 'a.asar')))
+        expect(fs.readdirSync(path.join(indexedDir, 'link2'))).to.deep.equal(['file1', 'file2', 'file3', 'link1', 'link2'])
+      })
+
+      it('resolves links in realpath', function () {
+        const parent = fs.realpathSync(asarDir)
+        const r = fs.realpathSync(path.join(parent, 'indexed.asar', 'link2', 'link1'))
+        expect(r).to.equal(path.join(parent, 'indexed.asar', 'file1'))
+      })
+
+      it('throws ENOENT error when can not find file', function () {
+        expect(() => {
+          fs.readFileSync(path.join(indexedDir, 'not-exist'))
+        }).to.throw(/ENOENT/)
+      })
+    })
+
+    describe('compressed files', function () {
+      const compressedDir = path.join(asarDir, 'compressed.asar')
+      const expected = 'Electron can read compressed files from asar archives.\n'.repeat(400)
+
+      it('reports the uncompressed size', function () {
+        expect(fs.statSync(path.join(compressedDir, 'text.txt')).size).to.equal(expected.length)
+      })
+
+      it('reads a compressed file', function () {
+        expect(fs.readFileSync(path.join(compressedDir, 'text.txt'), 'utf8')).to.equal(expected)
+      })
+
+      it('reads a compressed file asynchronously', async function () {
+        const content = await fs.promises.readFile(path.join(compressedDir, 'text.txt'))
+        expect(content.toString()).to.equal(expected)
+      })
+
+      it('reads an uncompressed file next to compressed ones', function () {
+        expect(fs.readFileSync(path.join(compressedDir, 'dir', 'small.txt'), 'utf8')).to.equal('small\n')
+      })
+
+      it('extracts a compressed file for APIs that need a real path', function () {
+        const fd = fs.openSync(path.join(compressedDir, 'text.txt'), 'r')
+        const buffer = Buffer.alloc(expected.length)
+        fs.readSync(fd, buffer, 0, buffer.length, 0)
+        fs.closeSync(fd)
+        expect(buffer.toString()).to.equal(expected)
+      })
+    })
+
+    describe('batched stats', function () {
+      const asar = process._linkedBinding('atom_common_asar')
+      const archive = asar.createArchive(path.join(asarDir, 'a.asar'))
+
+      it('stats many paths in one call', function () {
+        const [file, missing, dir, link] = archive.statBatch(['file1', 'not-exist', 'dir1', 'link1'])
+        expect(file).to.include({ isFile: true, size: 6 })
+        expect(missing).to.be.false()
+        expect(dir).to.include({ isDirectory: true })
+        expect(link).to.include({ isLink: true })
+      })
+
+      it('walks a directory', function () {
+        const entries = archive.walk('dir1')
+        expect(entries.map(entry => entry.path)).to.deep.equal(['file1', 'file2', 'file3', 'link1', 'link2'].map(name => path.join('dir1', name)))
+        expect(entries[0]).to.include({ isFile: true, size: 6 })
+        expect(entries[4]).to.include({ isLink: true })
+      })
+
+      it('walks the whole archive', function () {
+        const entries = archive.walk('')
+        expect(entries.map(entry => entry.path)).to.include(path.join('dir2', 'file1'))
+        const indexed = asar.createArchive(path.join(asarDir, 'indexed.asar')).walk('')
+        const summarize = entries => entries.map(({ path, isFile, isDirectory, isLink }) => ({ path, isFile, isDirectory, isLink }))
+        expect(summarize(indexed)).to.deep.equal(summarize(entries))
+      })
+
+      it('returns false when walking a file', function () {
+        expect(archive.walk('file1')).to.be.false()
+      })
+    })
+
+    describe('extraction cache', function () {
+      const { remote } = require('electron')
+      const asar = process._linkedBinding('atom_common_asar')
+
+      it('copies files out into the cache in the user data directory', function () {
+        const archive = asar.createArchive(path.join(asarDir, 'a.asar'))
+        const copied = archive.copyFileOut(path.join('dir1', 'file2'))
+        const cacheDir = path.join(remote.app.getPath('userData'), 'Asar Cache')
+        expect(path.dirname(copied)).to.equal(cacheDir)
+        expect(fs.readFileSync(copied, 'utf8').trim()).to.equal('file2')
+      })
+
+      it('names cached files after the archive and the entry', function () {
+        const copied = asar.createArchive(path.join(asarDir, 'a.asar')).copyFileOut('file1')
+        const other = asar.createArchive(path.join(asarDir, 'indexed.asar')).copyFileOut('file1')
+        expect(copied).to.not.equal(other)
+        expect(path.basename(copied)).to.match(/^[0-9a-f]{40}$/)
+      })
+    })
+
     describe('util.promisify', function () {
       it('can promisify all fs functions', function () {
         const originalFs = require('original-fs')
@@ -1368,6 +1489,14 @@ describe('asar package', function () {
       })
     })
 
+    it('can request a compressed file in package', async function () {
+      const p = path.resolve(asarDir, 'compressed.asar', 'text.txt')
+      const response = await fetch('file://' + p)
+      const text = await response.text()
+      expect(text).to.have.lengthOf(22000)
+      expect(text.startsWith('Electron can read compressed files')).to.be.true()
+    })
+
     it('can request a file in filesystem', function (done) {
       const p = path.resolve(asarDir, 'file')
       $.get('file://' + p, function (data) {
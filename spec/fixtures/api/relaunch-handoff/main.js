@@ -0,0 +1,23 @@
+const { app } = require('electron')
+const net = require('net')
+
+const socketPath = process.platform === 'win32' ? '\\\\.\\pipe\\electron-app-relaunch' : '/tmp/electron-app-relaunch'
+
+process.on('uncaughtException', () => {
+  app.exit(1)
+})
+
+app.once('ready', () => {
+  const handoff = app.getRelaunchHandoff()
+  const client = net.connect(socketPath)
+  client.once('connect', () => {
+    client.end(JSON.stringify(handoff))
+  })
+  client.once('end', () => {
+    app.exit(0)
+  })
+
+  if (!handoff) {
+    app.relaunch({ handoff: { bounds: { x: 1, y: 2, width: 300, height: 400 } } })
+  }
+})
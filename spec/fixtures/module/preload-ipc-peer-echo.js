@@ -0,0 +1,12 @@
+const { ipcRenderer } = require('electron')
+
+ipcRenderer.on('echo', function (event) {
+  const channel = event.peer
+  channel.on('message', function (event, ...args) {
+    channel.send(...args)
+  })
+})
+
+ipcRenderer.on('refuse', function (event) {
+  event.peer.close()
+})
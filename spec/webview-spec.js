@@ -455,6 +455,38 @@ describe('<webview> tag', function () {
     generateSpecs('with nativeWindowOpen', 'nativeWindowOpen=yes')
   })
 
+  describe('lazy attribute', () => {
+    afterEach(() => {
+      document.body.style.height = ''
+      window.scrollTo(0, 0)
+    })
+
+    it('loads the page when the element is visible', async () => {
+      const message = await startLoadingWebViewAndWaitForMessage(webview, {
+        lazy: 'on',
+        src: `file://${fixtures}/pages/a.html`
+      })
+      expect(message).to.equal('a')
+    })
+
+    it('does not create the guest until the element is scrolled into view', async () => {
+      document.body.style.height = '10000px'
+      webview.style.position = 'absolute'
+      webview.style.top = '9000px'
+      webview.setAttribute('lazy', 'on')
+      webview.setAttribute('src', `file://${fixtures}/pages/a.html`)
+      document.body.appendChild(webview)
+
+      await new Promise(resolve => setTimeout(resolve, 500))
+      expect(() => webview.getWebContentsId()).to.throw()
+
+      const loaded = waitForEvent(webview, 'did-finish-load')
+      webview.scrollIntoView()
+      await loaded
+      expect(webview.getWebContentsId()).to.be.a('number')
+    })
+  })
+
   describe('webpreferences attribute', () => {
     it('can enable nodeintegration', async () => {
       const message = await startLoadingWebViewAndWaitForMessage(webview, {
@@ -17,11 +17,20 @@ declare namespace NodeJS {
   }
 
   interface IpcBinding {
-    send(internal: boolean, channel: string, args: any[]): void;
+    send(internal: boolean, channel: string, args: any[], highPriority: boolean): void;
+    sendWithTransfer(internal: boolean, channel: string, args: any[], transfer: ArrayBuffer[]): void;
+    registerChannel(id: number, channel: string): void;
+    sendById(channelId: number, args: any[]): void;
+    sendBatch(internal: boolean, channels: string[], args: any[][], asArrays: boolean): void;
     sendSync(internal: boolean, channel: string, args: any[]): any;
+    sendSyncWithDeadline(internal: boolean, channel: string, args: any[], deadline: number): any;
     sendToHost(channel: string, args: any[]): void;
     sendTo(internal: boolean, sendToAll: boolean, webContentsId: number, channel: string, args: any[]): void;
-    invoke<T>(internal: boolean, channel: string, args: any[]): Promise<{ error: string, result: T }>;
+    invoke<T>(internal: boolean, channel: string, args: any[], highPriority: boolean): Promise<{ error: string, result: T }>;
+    invokeWithTransfer<T>(internal: boolean, channel: string, args: any[], transfer: ArrayBuffer[]): Promise<{ error: string, result: T }>;
+    bindPriorityLane(): void;
+    openChannel(webContentsId: number, channel: string): Promise<any>;
+    openRingBuffer(channel: string, capacity: number): Promise<any>;
   }
 
   interface V8UtilBinding {
@@ -32,6 +41,8 @@ declare namespace NodeJS {
     createIDWeakMap<V>(): ElectronInternal.KeyWeakMap<number, V>;
     createDoubleIDWeakMap<V>(): ElectronInternal.KeyWeakMap<[string, number], V>;
     setRemoteCallbackFreer(fn: Function, frameId: number, contextId: String, id: number, sender: any): void
+    beginStartupPhase(name: string): void;
+    endStartupPhase(name: string): void;
   }
 
   interface Process {
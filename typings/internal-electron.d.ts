@@ -17,11 +17,17 @@ declare namespace Electron {
     setVersion(version: string): void;
     setDesktopName(name: string): void;
     setAppPath(path: string | null): void;
+    _purgeMemory(level: 'moderate' | 'critical'): void;
+  }
+
+  interface Session {
+    _getPreloadCodeCachePath(): string;
   }
 
   interface WebContents {
     _getURL(): string;
     getOwnerBrowserWindow(): Electron.BrowserWindow;
+    _notifyMemoryPressure(level: 'moderate' | 'critical', notified: number[]): number[];
   }
 
   interface SerializedError {
@@ -93,7 +99,7 @@ declare namespace ElectronInternal {
   }
 
   interface DesktopCapturer {
-    startHandling(captureWindow: boolean, captureScreen: boolean, thumbnailSize: Electron.Size, fetchWindowIcons: boolean): void;
+    startHandling(captureWindow: boolean, captureScreen: boolean, thumbnailSize: Electron.Size, fetchWindowIcons: boolean, streamSources: boolean, streamThumbnails: boolean): void;
     emit: typeof NodeJS.EventEmitter.prototype.emit | null;
   }
 
@@ -102,6 +108,11 @@ declare namespace ElectronInternal {
     captureScreen: boolean;
     thumbnailSize: Electron.Size;
     fetchWindowIcons: boolean;
+    // Set when the sources are streamed to the renderer.
+    streamId?: number;
+    // Whether the thumbnails are streamed too, instead of being resolved with
+    // their sources.
+    streamThumbnails?: boolean;
   }
 
   interface GetSourcesResult {